@@ -313,9 +313,12 @@ extern "C" void pam_driver() {
   // Copy the final CRM state to the host to be saved for next time step
   pam_state_copy_to_host(coupler);
 
+  // The output and statistics are copied to host together, in one transfer
+  PamHostTransfer output_transfer;
+
   // Compute horizontal means of CRM state variables and copy to host
   pam_output_compute_means(coupler);
-  pam_output_copy_to_host(coupler);
+  pam_output_copy_to_host(coupler,output_transfer);
 
   // convert aggregated radiation quantities to means and copy to host
   pam_radiation_compute_means(coupler);
@@ -323,7 +326,8 @@ extern "C" void pam_driver() {
 
   // convert aggregated diagnostic quantities to means and copy to host
   pam_statistics_compute_means(coupler);
-  pam_statistics_copy_to_host(coupler);
+  pam_statistics_copy_to_host(coupler,output_transfer);
+  output_transfer.transfer();
 
   if (use_MMF_VT) {
     pam_variance_transport_compute_feedback(coupler);
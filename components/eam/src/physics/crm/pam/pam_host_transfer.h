@@ -0,0 +1,63 @@
+#pragma once
+
+#include "pam_coupler.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// Collects pairs of device and host arrays of the same size, and copies all the
+// device arrays to their host arrays at once: the device arrays are packed into
+// a single device buffer, which is copied to the host with one transfer and
+// unpacked there. This replaces a blocking device-to-host copy per array with a
+// single one. The arrays are kept alive until transfer() is called.
+class PamHostTransfer {
+public:
+
+  template <class DeviceArray, class HostArray>
+  void add( DeviceArray const &dev , HostArray const &host ) {
+    if (dev.totElems() != host.totElems()) {
+      printf("PamHostTransfer: Error: device and host arrays have different sizes: %s %s\n",
+             dev.label(), host.label());
+      exit(-1);
+    }
+    m_keep.push_back( std::make_shared<DeviceArray>(dev) );
+    m_keep.push_back( std::make_shared<HostArray>(host) );
+    m_dev   .push_back( dev.data() );
+    m_host  .push_back( host.data() );
+    m_offset.push_back( m_total );
+    m_size  .push_back( dev.totElems() );
+    m_total += dev.totElems();
+  }
+
+  void transfer() {
+    using yakl::c::parallel_for;
+    if (m_total > 0) {
+      real1d buffer("host_transfer_buffer",m_total);
+      for (int n=0; n < m_dev.size(); n++) {
+        real const *src = m_dev[n];
+        size_t offset   = m_offset[n];
+        parallel_for("pack host transfer", m_size[n], YAKL_LAMBDA (int i) {
+          buffer(offset+i) = src[i];
+        });
+      }
+      auto buffer_host = buffer.createHostCopy();
+      for (int n=0; n < m_host.size(); n++) {
+        std::copy( buffer_host.data()+m_offset[n] , buffer_host.data()+m_offset[n]+m_size[n] , m_host[n] );
+      }
+    }
+    m_keep.clear();
+    m_dev.clear();
+    m_host.clear();
+    m_offset.clear();
+    m_size.clear();
+    m_total = 0;
+  }
+
+private:
+  std::vector<std::shared_ptr<void>> m_keep;
+  std::vector<real const *>          m_dev;
+  std::vector<real *>                m_host;
+  std::vector<size_t>                m_offset;
+  std::vector<size_t>                m_size;
+  size_t                             m_total = 0;
+};
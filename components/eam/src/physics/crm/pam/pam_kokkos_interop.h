@@ -0,0 +1,76 @@
+#pragma once
+
+#include "pam_coupler.h"
+
+#if defined(P3_CXX) || defined(SHOC_CXX)
+
+#include <Kokkos_Core.hpp>
+#include <utility>
+
+// Zero-copy interoperability between the YAKL arrays used by PAM and the
+// Kokkos views used by the EAMxx physics. Both wrap the same device memory with
+// a C (LayoutRight) ordering, so an array can be handed from one side to the
+// other without allocating or copying; the wrappers are unmanaged, and the
+// owner of the memory must outlive them.
+//
+// YAKL and Kokkos launch on their own streams, so kernels of one are not
+// ordered with respect to the other. Call pam_yakl_to_kokkos_sync() before
+// Kokkos touches data written by YAKL kernels, and pam_kokkos_to_yakl_sync()
+// before YAKL touches data written by Kokkos kernels.
+namespace pam_kokkos {
+
+  using ExeSpace = Kokkos::DefaultExecutionSpace;
+  using MemSpace = ExeSpace::memory_space;
+
+  // T*...* with N pointers, the Kokkos data type of a rank-N runtime-sized view
+  template <class T, int N> struct DataType { typedef typename DataType<T,N-1>::type * type; };
+  template <class T>        struct DataType<T,0> { typedef T type; };
+
+  template <class T, int N>
+  using UnmanagedView = Kokkos::View<typename DataType<T,N>::type, Kokkos::LayoutRight, MemSpace,
+                                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+  template <class T, int N, size_t... I>
+  inline UnmanagedView<T,N> to_kokkos_view( yakl::Array<T,N,yakl::memDevice,yakl::styleC> const &arr ,
+                                            std::index_sequence<I...> ) {
+    return UnmanagedView<T,N>( arr.data() , static_cast<size_t>(arr.extent(I))... );
+  }
+
+  template <class View, size_t... I>
+  inline yakl::Array<typename View::value_type,View::rank,yakl::memDevice,yakl::styleC>
+  to_yakl_array( char const *label , View const &view , std::index_sequence<I...> ) {
+    using T = typename View::value_type;
+    return yakl::Array<T,View::rank,yakl::memDevice,yakl::styleC>( label , view.data() ,
+                                                                   static_cast<int>(view.extent(I))... );
+  }
+
+}
+
+// Wrap a device YAKL array as an unmanaged Kokkos view with the same shape
+template <class T, int N>
+inline pam_kokkos::UnmanagedView<T,N> pam_to_kokkos_view( yakl::Array<T,N,yakl::memDevice,yakl::styleC> const &arr ) {
+  return pam_kokkos::to_kokkos_view( arr , std::make_index_sequence<N>() );
+}
+
+// Wrap a device Kokkos view (LayoutRight) as a non-owning YAKL array with the same shape
+template <class View>
+inline yakl::Array<typename View::value_type,View::rank,yakl::memDevice,yakl::styleC>
+pam_to_yakl_array( char const *label , View const &view ) {
+  static_assert( std::is_same<typename View::array_layout,Kokkos::LayoutRight>::value ,
+                 "pam_to_yakl_array requires a LayoutRight view" );
+  static_assert( Kokkos::SpaceAccessibility<pam_kokkos::ExeSpace,typename View::memory_space>::accessible ,
+                 "pam_to_yakl_array requires a view accessible from the default execution space" );
+  if (! view.span_is_contiguous()) {
+    printf("pam_to_yakl_array: Error: view %s is not contiguous\n",view.label().c_str());
+    exit(-1);
+  }
+  return pam_kokkos::to_yakl_array( label , view , std::make_index_sequence<View::rank>() );
+}
+
+// Order the YAKL kernels launched so far before the Kokkos kernels launched next
+inline void pam_yakl_to_kokkos_sync() { yakl::fence(); }
+
+// Order the Kokkos kernels launched so far before the YAKL kernels launched next
+inline void pam_kokkos_to_yakl_sync() { Kokkos::fence(); }
+
+#endif
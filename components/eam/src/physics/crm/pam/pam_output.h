@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pam_coupler.h"
+#include "pam_host_transfer.h"
 
 // Compute horizontal means for feedback tendencies of variables that are not forced
 inline void pam_output_compute_means( pam::PamCoupler &coupler ) {
@@ -87,7 +88,7 @@ inline void pam_output_compute_means( pam::PamCoupler &coupler ) {
 }
 
 
-inline void pam_output_copy_to_host( pam::PamCoupler &coupler ) {
+inline void pam_output_copy_to_host( pam::PamCoupler &coupler, PamHostTransfer &transfer ) {
   using yakl::c::parallel_for;
   using yakl::c::SimpleBounds;
   using yakl::atomicAdd;
@@ -168,21 +169,20 @@ inline void pam_output_copy_to_host( pam::PamCoupler &coupler ) {
   auto output_qt_ls     = dm_host.get<real,2>("output_qt_ls");
   //------------------------------------------------------------------------------------------------
   // Copy the data to host
-  qv_mean                 .deep_copy_to(output_qv_mean);
-  qc_mean                 .deep_copy_to(output_qc_mean);
-  qi_mean                 .deep_copy_to(output_qi_mean);
-  qr_mean                 .deep_copy_to(output_qr_mean);
-  nc_mean                 .deep_copy_to(output_nc_mean);
-  ni_mean                 .deep_copy_to(output_ni_mean);
-  nr_mean                 .deep_copy_to(output_nr_mean);
-  qm_mean                 .deep_copy_to(output_qm_mean);
-  bm_mean                 .deep_copy_to(output_bm_mean);
-  rho_d_mean              .deep_copy_to(output_rho_d_mean);
-  rho_v_mean              .deep_copy_to(output_rho_v_mean);
-  forcing_tend_out_temp   .deep_copy_to(output_t_ls);
-  forcing_tend_out_rho_d  .deep_copy_to(output_rho_d_ls);
-  forcing_tend_out_qt     .deep_copy_to(output_qt_ls);
-  yakl::fence();
+  transfer.add(qv_mean                 ,output_qv_mean);
+  transfer.add(qc_mean                 ,output_qc_mean);
+  transfer.add(qi_mean                 ,output_qi_mean);
+  transfer.add(qr_mean                 ,output_qr_mean);
+  transfer.add(nc_mean                 ,output_nc_mean);
+  transfer.add(ni_mean                 ,output_ni_mean);
+  transfer.add(nr_mean                 ,output_nr_mean);
+  transfer.add(qm_mean                 ,output_qm_mean);
+  transfer.add(bm_mean                 ,output_bm_mean);
+  transfer.add(rho_d_mean              ,output_rho_d_mean);
+  transfer.add(rho_v_mean              ,output_rho_v_mean);
+  transfer.add(forcing_tend_out_temp   ,output_t_ls);
+  transfer.add(forcing_tend_out_rho_d  ,output_rho_d_ls);
+  transfer.add(forcing_tend_out_qt     ,output_qt_ls);
   //------------------------------------------------------------------------------------------------
 }
 
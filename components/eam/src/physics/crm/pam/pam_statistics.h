@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pam_coupler.h"
+#include "pam_host_transfer.h"
 #include "saturation_adjustment.h"
 
 // These routines are used to encapsulate the aggregation
@@ -492,7 +493,7 @@ inline void pam_statistics_compute_means( pam::PamCoupler &coupler ) {
 
 
 // copy aggregated statistical quantities to host
-inline void pam_statistics_copy_to_host( pam::PamCoupler &coupler ) {
+inline void pam_statistics_copy_to_host( pam::PamCoupler &coupler, PamHostTransfer &transfer ) {
   using yakl::c::parallel_for;
   using yakl::c::SimpleBounds;
   auto &dm_device = coupler.get_data_manager_device_readwrite();
@@ -706,45 +707,44 @@ inline void pam_statistics_copy_to_host( pam::PamCoupler &coupler ) {
   auto phys_tend_sponge_qi_host   = dm_host.get<real,2>("output_dqi_sponge");
   auto phys_tend_sponge_qr_host   = dm_host.get<real,2>("output_dqr_sponge");
 
-  precip_tot_c            .deep_copy_to(precip_tot_c_host);
-  precip_ice_c            .deep_copy_to(precip_ice_c_host);
-  precip_tot_l            .deep_copy_to(precip_tot_l_host);
-  precip_ice_l            .deep_copy_to(precip_ice_l_host);
-  liqwp_gcm               .deep_copy_to(liqwp_host);
-  icewp_gcm               .deep_copy_to(icewp_host);
-  liq_ice_exchange_gcm    .deep_copy_to(liq_ice_exchange_host);
-  vap_liq_exchange_gcm    .deep_copy_to(vap_liq_exchange_host);
-  vap_ice_exchange_gcm    .deep_copy_to(vap_ice_exchange_host);
-  rho_v_forcing_gcm       .deep_copy_to(output_rho_v_ls);
-  rho_l_forcing_gcm       .deep_copy_to(output_rho_l_ls);
-  rho_i_forcing_gcm       .deep_copy_to(output_rho_i_ls);
-  cldfrac_gcm             .deep_copy_to(cldfrac_host);
-  clear_rh                .deep_copy_to(clear_rh_host);
-
-  phys_tend_sgs_temp_gcm  .deep_copy_to(phys_tend_sgs_temp_host);
-  phys_tend_sgs_qv_gcm    .deep_copy_to(phys_tend_sgs_qv_host);
-  phys_tend_sgs_qc_gcm    .deep_copy_to(phys_tend_sgs_qc_host);
-  phys_tend_sgs_qi_gcm    .deep_copy_to(phys_tend_sgs_qi_host);
-  phys_tend_sgs_qr_gcm    .deep_copy_to(phys_tend_sgs_qr_host);
-
-  phys_tend_micro_temp_gcm.deep_copy_to(phys_tend_micro_temp_host);
-  phys_tend_micro_qv_gcm  .deep_copy_to(phys_tend_micro_qv_host);
-  phys_tend_micro_qc_gcm  .deep_copy_to(phys_tend_micro_qc_host);
-  phys_tend_micro_qi_gcm  .deep_copy_to(phys_tend_micro_qi_host);
-  phys_tend_micro_qr_gcm  .deep_copy_to(phys_tend_micro_qr_host);
-
-  phys_tend_dycor_temp_gcm .deep_copy_to(phys_tend_dycor_temp_host);
-  phys_tend_dycor_qv_gcm   .deep_copy_to(phys_tend_dycor_qv_host);
-  phys_tend_dycor_qc_gcm   .deep_copy_to(phys_tend_dycor_qc_host);
-  phys_tend_dycor_qi_gcm   .deep_copy_to(phys_tend_dycor_qi_host);
-  phys_tend_dycor_qr_gcm   .deep_copy_to(phys_tend_dycor_qr_host);
+  transfer.add(precip_tot_c            ,precip_tot_c_host);
+  transfer.add(precip_ice_c            ,precip_ice_c_host);
+  transfer.add(precip_tot_l            ,precip_tot_l_host);
+  transfer.add(precip_ice_l            ,precip_ice_l_host);
+  transfer.add(liqwp_gcm               ,liqwp_host);
+  transfer.add(icewp_gcm               ,icewp_host);
+  transfer.add(liq_ice_exchange_gcm    ,liq_ice_exchange_host);
+  transfer.add(vap_liq_exchange_gcm    ,vap_liq_exchange_host);
+  transfer.add(vap_ice_exchange_gcm    ,vap_ice_exchange_host);
+  transfer.add(rho_v_forcing_gcm       ,output_rho_v_ls);
+  transfer.add(rho_l_forcing_gcm       ,output_rho_l_ls);
+  transfer.add(rho_i_forcing_gcm       ,output_rho_i_ls);
+  transfer.add(cldfrac_gcm             ,cldfrac_host);
+  transfer.add(clear_rh                ,clear_rh_host);
+
+  transfer.add(phys_tend_sgs_temp_gcm  ,phys_tend_sgs_temp_host);
+  transfer.add(phys_tend_sgs_qv_gcm    ,phys_tend_sgs_qv_host);
+  transfer.add(phys_tend_sgs_qc_gcm    ,phys_tend_sgs_qc_host);
+  transfer.add(phys_tend_sgs_qi_gcm    ,phys_tend_sgs_qi_host);
+  transfer.add(phys_tend_sgs_qr_gcm    ,phys_tend_sgs_qr_host);
+
+  transfer.add(phys_tend_micro_temp_gcm,phys_tend_micro_temp_host);
+  transfer.add(phys_tend_micro_qv_gcm  ,phys_tend_micro_qv_host);
+  transfer.add(phys_tend_micro_qc_gcm  ,phys_tend_micro_qc_host);
+  transfer.add(phys_tend_micro_qi_gcm  ,phys_tend_micro_qi_host);
+  transfer.add(phys_tend_micro_qr_gcm  ,phys_tend_micro_qr_host);
+
+  transfer.add(phys_tend_dycor_temp_gcm ,phys_tend_dycor_temp_host);
+  transfer.add(phys_tend_dycor_qv_gcm   ,phys_tend_dycor_qv_host);
+  transfer.add(phys_tend_dycor_qc_gcm   ,phys_tend_dycor_qc_host);
+  transfer.add(phys_tend_dycor_qi_gcm   ,phys_tend_dycor_qi_host);
+  transfer.add(phys_tend_dycor_qr_gcm   ,phys_tend_dycor_qr_host);
   
-  phys_tend_sponge_temp_gcm.deep_copy_to(phys_tend_sponge_temp_host);
-  phys_tend_sponge_qv_gcm  .deep_copy_to(phys_tend_sponge_qv_host);
-  phys_tend_sponge_qc_gcm  .deep_copy_to(phys_tend_sponge_qc_host);
-  phys_tend_sponge_qi_gcm  .deep_copy_to(phys_tend_sponge_qi_host);
-  phys_tend_sponge_qr_gcm  .deep_copy_to(phys_tend_sponge_qr_host);
-  yakl::fence();
+  transfer.add(phys_tend_sponge_temp_gcm,phys_tend_sponge_temp_host);
+  transfer.add(phys_tend_sponge_qv_gcm  ,phys_tend_sponge_qv_host);
+  transfer.add(phys_tend_sponge_qc_gcm  ,phys_tend_sponge_qc_host);
+  transfer.add(phys_tend_sponge_qi_gcm  ,phys_tend_sponge_qi_host);
+  transfer.add(phys_tend_sponge_qr_gcm  ,phys_tend_sponge_qr_host);
   //------------------------------------------------------------------------------------------------
 }
 
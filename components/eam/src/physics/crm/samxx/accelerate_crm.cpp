@@ -1,7 +1,7 @@
 
 #include "accelerate_crm.h"
 
-void accelerate_crm(int nstep, int nstop, bool &ceaseflag) {
+void accelerate_crm(int nstep, int &nstop, bool &ceaseflag) {
   YAKL_SCOPE( t                  , ::t);
   YAKL_SCOPE( qcl                , ::qcl);
   YAKL_SCOPE( qci                , ::qci);
@@ -16,12 +16,19 @@ void accelerate_crm(int nstep, int nstop, bool &ceaseflag) {
   YAKL_SCOPE( use_crm_accel      , ::use_crm_accel);
   YAKL_SCOPE( micro_field        , ::micro_field);
   YAKL_SCOPE( ncrms              , ::ncrms);
-  YAKL_SCOPE( crm_accel_factor   , ::crm_accel_factor);
+  YAKL_SCOPE( crm_accel_factor   , ::crm_accel_factor_now);
+  YAKL_SCOPE( crm_accel_adaptive , ::crm_accel_adaptive);
 
   real ttend_threshold = 5.0;  // 5K, following UP-CAM implementation
   real tmin = 50.0;  // should never get below 50K in crm, following UP-CAM implementation
   int idx_qt = index_water_vapor;
 
+  // Limits of the accelerated change of the horizontal-mean state in one call,
+  // used to adapt crm_accel_factor_now when crm_accel_adaptive is set
+  real ttend_limit = 0.1;     // K
+  real qtend_limit = 1.0e-4;  // kg/kg
+  real utend_limit = 0.5;     // m/s
+
   real2d ubaccel("ubaccel", nzm, ncrms);
   real2d vbaccel("vbaccel", nzm, ncrms);
   real2d tbaccel("tbaccel", nzm, ncrms);
@@ -32,6 +39,7 @@ void accelerate_crm(int nstep, int nstop, bool &ceaseflag) {
   real2d vtend_acc("vtend_acc", nzm, ncrms);
   real2d qpoz("qpoz", nzm, ncrms);
   real2d qneg("qneg", nzm, ncrms);
+  real2d ratio("ratio", nzm, ncrms);
 
   // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
   // Compute the average among horizontal columns for each variable
@@ -80,9 +88,21 @@ void accelerate_crm(int nstep, int nstop, bool &ceaseflag) {
     if (abs(ttend_acc(k,icrm)) > ttend_threshold) {
       ceaseflag_liveout = true;
     }
+    if (crm_accel_adaptive) {
+      real r = max( abs(ttend_acc(k,icrm))/ttend_limit , abs(qtend_acc(k,icrm))/qtend_limit );
+      if (crm_accel_uv) {
+        r = max( r , max( abs(utend_acc(k,icrm)) , abs(vtend_acc(k,icrm)) )/utend_limit );
+      }
+      ratio(k,icrm) = crm_accel_factor * r;
+    }
   });
   ceaseflag = ceaseflag_liveout.hostRead();
 
+  if (crm_accel_adaptive) {
+    yakl::ParallelMax<real,yakl::memDevice> pmax( nzm*ncrms );
+    crm_accel_ratio = max( crm_accel_ratio , pmax(ratio.data()) );
+  }
+
 
   //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
   //!! Make sure it isn't insane
@@ -104,6 +124,11 @@ void accelerate_crm(int nstep, int nstop, bool &ceaseflag) {
     // crm_run_time = nstop * dt_a and working through algebra yields 
     //     updated nstop = nstop + (nstop - nstep + 1) * crm_accel_factor.
     std::cout << "accelerate_crm: mean-state acceleration not applied this step";
+    if (crm_accel_adaptive) {
+      // crm_accel_adapt updates nstop at the end of the step
+      crm_accel_factor_now = 0.0;
+      return;
+    }
     std::cout << "crm: nstop increased from " << nstop << " to " << round(nstop+(nstop-nstep+1)*crm_accel_factor);
     nstop = nstop + (nstop - nstep + 1)*crm_accel_factor; // only can happen once
     return;
@@ -195,6 +220,17 @@ void accelerate_crm(int nstep, int nstop, bool &ceaseflag) {
 
 
 void crm_accel_nstop(int &nstop) {
+  crm_accel_factor_now = crm_accel_factor;
+  if (crm_accel_adaptive) {
+    // Start from the largest factor, up to crm_accel_factor, that splits the
+    // CRM run into a whole number of accelerated steps
+    crm_accel_nstop_full  = nstop;
+    crm_accel_nsteps_done = 0.0;
+    crm_accel_ratio       = 0.0;
+    nstop = static_cast<int>( ceil( nstop/(1+crm_accel_factor) ) );
+    crm_accel_factor_now = static_cast<real>(crm_accel_nstop_full)/nstop - 1;
+    return;
+  }
   if(nstop%static_cast<int>((1+crm_accel_factor)) != 0) {
     std::cout << "CRM acceleration unexpected exception:\n";
     std::cout << "(1+crm_accel_factor) does not divide equally into nstop\n";
@@ -207,3 +243,36 @@ void crm_accel_nstop(int &nstop) {
 }
 
 
+
+// Adaptive mean-state acceleration, called at the end of each CRM step.
+// The factor is lowered when the accelerated change of the horizontal-mean
+// state exceeded its limits during the step, and raised (up to
+// crm_accel_factor) when it stayed well within them. nstop is then reset so
+// that the CRM run still covers crm_run_time exactly.
+void crm_accel_adapt(int nstep, int &nstop) {
+  real constexpr ratio_raise = 0.5;
+
+  // Time covered so far, in unaccelerated CRM steps
+  crm_accel_nsteps_done += 1 + crm_accel_factor_now;
+  real remaining = crm_accel_nstop_full - crm_accel_nsteps_done;
+  if (remaining < 0.5) {
+    nstop = nstep;
+    return;
+  }
+
+  real factor = crm_accel_factor_now;
+  if (crm_accel_ceaseflag) {
+    factor = 0.0;
+  } else if (crm_accel_ratio > 1.0) {
+    factor = 0.5*factor;
+  } else if (crm_accel_ratio < ratio_raise) {
+    factor = min( crm_accel_factor , factor + 1.0 );
+  }
+  crm_accel_ratio = 0.0;
+
+  // Take the remaining steps with the largest factor not exceeding the new
+  // one that covers the remaining time exactly
+  int nleft = max( 1 , static_cast<int>( ceil( remaining/(1+factor) - 1.0e-6 ) ) );
+  crm_accel_factor_now = max( 0.0 , remaining/nleft - 1 );
+  nstop = nstep + nleft;
+}
@@ -4,7 +4,9 @@
 #include "samxx_const.h"
 #include "vars.h"
 
-void accelerate_crm(int nstep, int nstop, bool &ceaseflag);
+void accelerate_crm(int nstep, int &nstop, bool &ceaseflag);
 
 void crm_accel_nstop(int &nstop);
 
+void crm_accel_adapt(int nstep, int &nstop);
+
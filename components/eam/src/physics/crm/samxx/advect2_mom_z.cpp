@@ -18,10 +18,6 @@ void advect2_mom_z() {
   YAKL_SCOPE( adzw           , :: adzw);
   YAKL_SCOPE( ncrms          , :: ncrms);
 
-  real4d fuz("fuz",nz ,ny,nx,ncrms);
-  real4d fvz("fvz",nz ,ny,nx,ncrms);
-  real4d fwz("fwz",nzm,ny,nx,ncrms);
-
   // for (int k=0; k<nzm; k++) {
   //       for (int icrm=0; icrm<ncrms; icrm++) {
   parallel_for( SimpleBounds<2>(nz,ncrms) , YAKL_LAMBDA (int k, int icrm) {
@@ -29,78 +25,51 @@ void advect2_mom_z() {
     vwle(k,icrm) = 0.0;
   });
 
-  // for (int j=0; j<ny; j++) {
-  //  for (int i=0; i<nx; i++) {
-  //    for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<3>(ny,nx,ncrms) , YAKL_LAMBDA (int j, int i, int icrm) {
-    real dz25=1.0/(4.0*dz(icrm));
-    fuz(0,j,i,icrm) = 0.0;
-    fuz(nz-1,j,i,icrm) = 0.0;
-    fvz(0,j,i,icrm) = 0.0;
-    fvz(nz-1,j,i,icrm) = 0.0;
-    fwz(0,j,i,icrm) = 0.0;
-    fwz(nzm-1,j,i,icrm) = 0.0;
-  });
-
-  if (RUN3D) {
-
-    // for (int k=0; k<nzm-1; k++) {
-    //   for (int j=0; j<ny; j++) {
-    //     for (int i=0; i<nx; i++) {
-    //       for (int icrm=0; icrm<ncrms; icrm++) {
-    parallel_for( SimpleBounds<4>(nzm-1,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-      real dz25=1.0/(4.0*dz(icrm));
-      int kb = k-1;
-      real rhoi = dz25 * rhow(k+1,icrm);
-      fuz(k+1,j,i,icrm) = rhoi*(w(k+1,j+offy_w,i+offx_w,icrm)+w(k+1,j+offy_w,i-1+offx_w,icrm))*
-                               (u(k+1,j+offy_u,i+offx_u,icrm)+u(kb+1,j+offy_u,i+offx_u,icrm));
-      fvz(k+1,j,i,icrm) = rhoi*(w(k+1,j+offy_w,i+offx_w,icrm)+w(k+1,j-1+offy_w,i+offx_w,icrm))*
-                               (v(k+1,j+offy_v,i+offx_v,icrm)+v(kb+1,j+offy_v,i+offx_v,icrm));
-      yakl::atomicAdd(uwle(k+1,icrm),fuz(k+1,j,i,icrm));
-      yakl::atomicAdd(vwle(k+1,icrm),fvz(k+1,j,i,icrm));
-    });
-
-  } else {
-
-    // for (int k=0; k<nzm-1; k++) {
-    //   for (int j=0; j<ny; j++) {
-    //     for (int i=0; i<nx; i++) {
-    //       for (int icrm=0; icrm<ncrms; icrm++) {
-    parallel_for( SimpleBounds<4>(nzm-1,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-      real dz25=1.0/(4.0*dz(icrm));
-      int kb = k-1;
-      real rhoi = dz25 * rhow(k+1,icrm);
-      real www = rhoi*(w(k+1,j+offy_w,i+offx_w,icrm)+w(k+1,j+offy_w,i-1+offx_w,icrm));
-      fuz(k+1,j,i,icrm) = www*(u(k+1,j+offy_u,i+offx_u,icrm)+u(kb+1,j+offy_u,i+offx_u,icrm));
-      fvz(k+1,j,i,icrm) = www*(v(k+1,j+offy_v,i+offx_v,icrm)+v(kb+1,j+offy_v,i+offx_v,icrm));
-      yakl::atomicAdd(uwle(k+1,icrm),fuz(k+1,j,i,icrm));
-      yakl::atomicAdd(vwle(k+1,icrm),fvz(k+1,j,i,icrm));
-    });
-
-  }
-
+  // The vertical fluxes are computed where they are needed, rather than stored
+  // in full 3d arrays, so that the tendencies are computed in one pass.
   // for (int k=0; k<nzm; k++) {
   //   for (int j=0; j<ny; j++) {
   //     for (int i=0; i<nx; i++) {
   //       for (int icrm=0; icrm<ncrms; icrm++) {
   parallel_for( SimpleBounds<4>(nzm,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
     real dz25=1.0/(4.0*dz(icrm));
-    int kc = k+1;
+    // Fluxes of u and v at interface kk, in 1:nzm-1 (they are zero at 0 and nz-1)
+    auto flux_uv = [&] (int kk, real &fuz, real &fvz) {
+      real rhoi = dz25 * rhow(kk,icrm);
+      if (RUN3D) {
+        fuz = rhoi*(w(kk,j+offy_w,i+offx_w,icrm)+w(kk,j+offy_w,i-1+offx_w,icrm))*
+                   (u(kk,j+offy_u,i+offx_u,icrm)+u(kk-1,j+offy_u,i+offx_u,icrm));
+        fvz = rhoi*(w(kk,j+offy_w,i+offx_w,icrm)+w(kk,j-1+offy_w,i+offx_w,icrm))*
+                   (v(kk,j+offy_v,i+offx_v,icrm)+v(kk-1,j+offy_v,i+offx_v,icrm));
+      } else {
+        real www = rhoi*(w(kk,j+offy_w,i+offx_w,icrm)+w(kk,j+offy_w,i-1+offx_w,icrm));
+        fuz = www*(u(kk,j+offy_u,i+offx_u,icrm)+u(kk-1,j+offy_u,i+offx_u,icrm));
+        fvz = www*(v(kk,j+offy_v,i+offx_v,icrm)+v(kk-1,j+offy_v,i+offx_v,icrm));
+      }
+    };
+    // Flux of w at level kk, in 0:nzm-1
+    auto flux_w = [&] (int kk) -> real {
+      return dz25*(w(kk+1,j+offy_w,i+offx_w,icrm)*rhow(kk+1,icrm)+w(kk,j+offy_w,i+offx_w,icrm)*
+                   rhow(kk,icrm))*(w(kk+1,j+offy_w,i+offx_w,icrm)+w(kk,j+offy_w,i+offx_w,icrm));
+    };
+
+    real fuz_lo = 0.0, fvz_lo = 0.0, fuz_hi = 0.0, fvz_hi = 0.0;
+    if (k>0) {
+      flux_uv(k,fuz_lo,fvz_lo);
+    }
+    if (k<nzm-1) {
+      flux_uv(k+1,fuz_hi,fvz_hi);
+      yakl::atomicAdd(uwle(k+1,icrm),fuz_hi);
+      yakl::atomicAdd(vwle(k+1,icrm),fvz_hi);
+    }
     real rhoi = 1.0/(rho(k,icrm)*adz(k,icrm));
-    dudt(na-1,k,j,i,icrm)=dudt(na-1,k,j,i,icrm)-(fuz(kc,j,i,icrm)-fuz(k,j,i,icrm))*rhoi;
-    dvdt(na-1,k,j,i,icrm)=dvdt(na-1,k,j,i,icrm)-(fvz(kc,j,i,icrm)-fvz(k,j,i,icrm))*rhoi;
-    fwz(k,j,i,icrm)=dz25*(w(kc,j+offy_w,i+offx_w,icrm)*rhow(kc,icrm)+w(k,j+offy_w,i+offx_w,icrm)*
-                          rhow(k,icrm))*(w(kc,j+offy_w,i+offx_w,icrm)+w(k,j+offy_w,i+offx_w,icrm));
-  });
+    dudt(na-1,k,j,i,icrm)=dudt(na-1,k,j,i,icrm)-(fuz_hi-fuz_lo)*rhoi;
+    dvdt(na-1,k,j,i,icrm)=dvdt(na-1,k,j,i,icrm)-(fvz_hi-fvz_lo)*rhoi;
 
-  // for (int k=0; k<nzm-1; k++) {
-  //   for (int j=0; j<ny; j++) {
-  //     for (int i=0; i<nx; i++) {
-  //       for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<4>(nzm-1,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    int kb=k-1;
-    real rhoi = 1.0/(rhow(k+1,icrm)*adzw(k+1,icrm));
-    dwdt(na-1,k+1,j,i,icrm)=dwdt(na-1,k+1,j,i,icrm)-(fwz(k+1,j,i,icrm)-fwz(kb+1,j,i,icrm))*rhoi;
+    if (k<nzm-1) {
+      real rhoiw = 1.0/(rhow(k+1,icrm)*adzw(k+1,icrm));
+      dwdt(na-1,k+1,j,i,icrm)=dwdt(na-1,k+1,j,i,icrm)-(flux_w(k+1)-flux_w(k))*rhoiw;
+    }
   });
 
 }
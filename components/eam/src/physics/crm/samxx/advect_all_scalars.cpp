@@ -2,23 +2,29 @@
 
 void advect_all_scalars() {
 
-  real2d dummy("dummy",nz,ncrms);
-  real1d esmt_offset("esmt_offset", ncrms);
+  YAKL_SCOPE( dummy      , :: advect_all_scalars_dummy );
+  YAKL_SCOPE( esmt_offset, :: advect_all_scalars_esmt_offset );
   YAKL_SCOPE( u_esmt  , :: u_esmt);
   YAKL_SCOPE( v_esmt  , :: v_esmt);
   YAKL_SCOPE( use_ESMT, :: use_ESMT );
-  real1d esmt_min("esmt_min",ncrms);
+  YAKL_SCOPE( esmt_min   , :: advect_all_scalars_esmt_min );
+  YAKL_SCOPE( micro_ind  , :: advect_all_scalars_micro_ind );
   yakl::memset(esmt_min,1.0e20);
 
   // advection of scalars :
   advect_scalar(t,dummy,dummy);
 
-  // Advection of microphysics prognostics:
+  // Advection of microphysics prognostics, all species in one pass:
+  intHost1d micro_ind_host("micro_ind_host",nmicro_fields);
+  int nmicro_adv = 0;
   for (int k=0; k<nmicro_fields; k++) {
     if ( k==index_water_vapor || (docloud && flag_precip(k)!=1) || (doprecip && flag_precip(k)==1) ) {
-      advect_scalar(micro_field,k,mkadv,k,mkwle,k);  
+      micro_ind_host(nmicro_adv) = k;
+      nmicro_adv++;
     }
   }
+  micro_ind_host.deep_copy_to(micro_ind);
+  advect_scalar(micro_field,nmicro_adv,micro_ind,mkadv,mkwle);
 
   // Advection of sgs prognostics:
   if (dosgs && advect_sgs) {
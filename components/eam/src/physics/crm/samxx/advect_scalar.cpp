@@ -142,3 +142,56 @@ void advect_scalar(real5d &f, int ind_f, real3d &fadv, int ind_fadv, real3d &flu
   }  
 
 }
+
+void advect_scalar(real5d &f, int nadv, int1d &ind_f, real3d &fadv, real3d &flux) {
+  YAKL_SCOPE( ncrms          , :: ncrms);
+
+  if (nadv == 0) { return; }
+
+  real5d f0("f0", nadv, nzm, dimy_s, dimx_s, ncrms);
+
+  // for (int iadv=0; iadv<nadv; iadv++) {
+  //   for (int k=0; k<nzm; k++) {
+  //     for (int icrm=0; icrm<ncrms; icrm++) {
+  if (docolumn) {
+    parallel_for( SimpleBounds<3>(nadv,nz,ncrms) , YAKL_LAMBDA (int iadv, int k, int icrm) {
+      flux(ind_f(iadv),k,icrm) = 0.0;
+    });
+
+  } else {
+
+    // for (int iadv=0; iadv<nadv; iadv++) {
+    //   for (int k=0; k<nzm; k++) {
+    //     for (int j=0; j<dimy_s; j++) {
+    //       for (int i=0; i<dimx_s; i++) {
+    //         for (int icrm=0; icrm<ncrms; icrm++) {
+    parallel_for( SimpleBounds<5>(nadv,nzm,dimy_s,dimx_s,ncrms) , YAKL_LAMBDA (int iadv, int k, int j, int i, int icrm) {
+      f0(iadv,k,j,i,icrm) = f(ind_f(iadv),k,j,i,icrm);
+    });
+
+    if(RUN3D) {
+      advect_scalar3D(f,nadv,ind_f,flux);
+    } else {
+      advect_scalar2D(f,nadv,ind_f,flux);
+    }
+
+    // for (int iadv=0; iadv<nadv; iadv++) {
+    //   for (int k=0; k<nzm; k++) {
+    //     for (int icrm=0; icrm<ncrms; icrm++) {
+    parallel_for( SimpleBounds<3>(nadv,nzm,ncrms) , YAKL_LAMBDA (int iadv, int k, int icrm) {
+      fadv(ind_f(iadv),k,icrm)=0.0;
+    });
+
+    // for (int iadv=0; iadv<nadv; iadv++) {
+    //   for (int k=0; k<nzm; k++) {
+    //     for (int j=0; j<ny; j++) {
+    //       for (int i=0; i<nx; i++) {
+    //         for (int icrm=0; icrm<ncrms; icrm++) {
+    parallel_for( SimpleBounds<5>(nadv,nzm,ny,nx,ncrms) , YAKL_LAMBDA (int iadv, int k, int j, int i, int icrm) {
+      real tmp = f(ind_f(iadv),k,j+offy_s,i+offx_s,icrm)-f0(iadv,k,j+offy_s,i+offx_s,icrm);
+      yakl::atomicAdd(fadv(ind_f(iadv),k,icrm),tmp);
+    });
+
+  }
+
+}
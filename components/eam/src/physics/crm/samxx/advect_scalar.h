@@ -12,3 +12,7 @@ void advect_scalar(real5d &f, int ind_f, real2d &fadv, real2d &flux);
 
 void advect_scalar(real5d &f, int ind_f, real3d &fadv, int ind_fadv, real3d &flux, int ind_flux);
 
+// Advect the nadv fields f(ind_f(iadv),...) in one pass, with the same
+// indices into fadv and flux
+void advect_scalar(real5d &f, int nadv, int1d &ind_f, real3d &fadv, real3d &flux);
+
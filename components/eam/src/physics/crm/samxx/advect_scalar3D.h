@@ -10,6 +10,9 @@ void advect_scalar3D(real5d &f, int ind_f, real2d &flux);
 
 void advect_scalar3D(real5d &f, int ind_f, real3d &flux, int ind_flux);
 
+// Advect the nadv fields f(ind_f(iadv),...) together, with fluxes flux(ind_f(iadv),...)
+void advect_scalar3D(real5d &f, int nadv, int1d &ind_f, real3d &flux);
+
 YAKL_INLINE real andiff(real x1, real x2, real a, real b) {
   return (abs(a)-a*a*b)*0.5*(x2-x1);
 }
@@ -26,10 +26,6 @@ void diffuse_mom3D(real5d &tk) {
   YAKL_SCOPE( adz           , :: adz );
   YAKL_SCOPE( ncrms         , :: ncrms );
 
-  real4d fu("fu",nz,ny+1,nx+1,ncrms);
-  real4d fv("fv",nz,ny+1,nx+1,ncrms);
-  real4d fw("fw",nz,ny+1,nx+1,ncrms);
-
   real rdx2=1.0/(dx*dx);
   real rdy2=1.0/(dy*dy);
   real rdx25=0.25*rdx2;
@@ -38,149 +34,138 @@ void diffuse_mom3D(real5d &tk) {
   real dyx=dy/dx;
 
   // for (int k=0; k<nzm; k++) {
-  //   for (int j=0; j<ny; j++) {
-  //     for (int i=0; i<nx+1; i++) {
-  //       for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<4>(nzm,ny,nx+1,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    int jb=j-1;
-    int kc=k+1;
-    int kcu=min(kc,nzm-1);
-    int ic=i+1;
-    real dxz=dx/(dz(icrm)*adzw(kc,icrm));
-    real rdx21=rdx2    * grdf_x(k,icrm);
-    real rdx251=rdx25  * grdf_x(k,icrm);
-    real tkx=rdx21*tk(0,k,j+offy_d,i-1+offx_d,icrm);
-    fu(k,j+1,i,icrm)=-2.0*tkx*(u(k,j+offy_u,ic-1+offx_u,icrm)-u(k,j+offy_u,i-1+offx_u,icrm));
-    tkx=rdx251*(tk(0,k,j+offy_d,i-1+offx_d,icrm)+tk(0,k,jb+offy_d,i-1+offx_d,icrm)+
-                tk(0,k,j+offy_d,ic-1+offx_d,icrm)+tk(0,k,jb+offy_d,ic-1+offx_d,icrm));
-    fv(k,j+1,i,icrm)=-tkx*(v(k,j+offy_v,ic-1+offx_v,icrm)-v(k,j+offy_v,i-1+offx_v,icrm)+
-                          (u(k,j+offy_u,ic-1+offx_u,icrm)-u(k,jb+offy_u,ic-1+offx_u,icrm))*dxy);
-    tkx=rdx251*(tk(0,k,j+offy_d,i-1+offx_d,icrm)+tk(0,k,j+offy_d,ic-1+offx_d,icrm)+
-                tk(0,kcu,j+offy_d,i-1+offx_d,icrm)+tk(0,kcu,j+offy_d,ic-1+offx_d,icrm));
-    fw(k,j+1,i,icrm)=-tkx*(w(kc,j+offy_w,ic-1+offx_w,icrm)-w(kc,j+offy_w,i-1+offx_w,icrm)+
-                          (u(kcu,j+offy_u,ic-1+offx_u,icrm)-u(k,j+offy_u,ic-1+offx_u,icrm))*dxz);
+  //  for (int icrm=0; icrm<ncrms; icrm++) {
+  parallel_for( SimpleBounds<2>(nz,ncrms) , YAKL_LAMBDA (int k, int icrm) {
+    uwsb(k,icrm)=0.0;
+    vwsb(k,icrm)=0.0;
   });
 
+  // The fluxes are computed on the faces of each cell, rather than stored in
+  // full 3d arrays, so that the tendencies are computed in one pass. The
+  // x, y, and z contributions are added in the same order as separate passes.
   // for (int k=0; k<nzm; k++) {
   //   for (int j=0; j<ny; j++) {
   //     for (int i=0; i<nx; i++) {
   //       for (int icrm=0; icrm<ncrms; icrm++) {
   parallel_for( SimpleBounds<4>(nzm,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    int kc=k+1;
-    int ib=i-1;
-    dudt(na-1,k,j,i,icrm)=dudt(na-1,k,j,i,icrm)-(fu(k,j+1,i+1,icrm)-fu(k,j+1,ib+1,icrm));
-    dvdt(na-1,k,j,i,icrm)=dvdt(na-1,k,j,i,icrm)-(fv(k,j+1,i+1,icrm)-fv(k,j+1,ib+1,icrm));
-    dwdt(na-1,kc,j,i,icrm)=dwdt(na-1,kc,j,i,icrm)-(fw(k,j+1,i+1,icrm)-fw(k,j+1,ib+1,icrm));
-  });
-
-  // for (int k=0; k<nzm; k++) {
-  //   for (int j=0; j<ny+1; j++) {
-  //     for (int i=0; i<nx; i++) {
-  //       for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<4>(nzm,ny+1,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    int jc=j+1;
     int kc=k+1;
     int kcu=min(kc,nzm-1);
-    int ib=i-1;
-    real dyz=dy/(dz(icrm)*adzw(kc,icrm));
-    real rdy21=rdy2    * grdf_y(k,icrm);
-    real rdy251=rdy25  * grdf_y(k,icrm);
-    real tky=rdy21*tk(0,k,j-1+offy_d,i+offx_d,icrm);
-    fv(k,j,i+1,icrm)=-2.0*tky*(v(k,jc-1+offy_v,i+offx_v,icrm)-v(k,j-1+offy_v,i+offx_v,icrm));
-    tky=rdy251*(tk(0,k,j-1+offy_d,i+offx_d,icrm)+tk(0,k,j-1+offy_d,ib+offx_d,icrm)+
-                tk(0,k,jc-1+offy_d,i+offx_d,icrm)+tk(0,k,jc-1+offy_d,ib+offx_d,icrm));
-    fu(k,j,i+1,icrm)=-tky*(u(k,jc-1+offy_u,i+offx_u,icrm)-u(k,j-1+offy_u,i+offx_u,icrm)+
-                          (v(k,jc-1+offy_v,i+offx_v,icrm)-v(k,jc-1+offy_v,ib+offx_v,icrm))*dyx);
-    tky=rdy251*(tk(0,k,j-1+offy_d,i+offx_d,icrm)+tk(0,k,jc-1+offy_d,i+offx_d,icrm)+
-                tk(0,kcu,j-1+offy_d,i+offx_d,icrm)+tk(0,kcu,jc-1+offy_d,i+offx_d,icrm));
-    fw(k,j,i+1,icrm)=-tky*(w(kc,jc-1+offy_w,i+offx_w,icrm)-w(kc,j-1+offy_w,i+offx_w,icrm)+
-                          (v(kcu,jc-1+offy_v,i+offx_v,icrm)-v(k,jc-1+offy_v,i+offx_v,icrm))*dyz);
-  });
 
+    // Fluxes through the x face ii, in 0:nx
+    auto flux_x = [&] (int ii, real &fu, real &fv, real &fw) {
+      int jb=j-1;
+      int ic=ii+1;
+      real dxz=dx/(dz(icrm)*adzw(kc,icrm));
+      real rdx21=rdx2    * grdf_x(k,icrm);
+      real rdx251=rdx25  * grdf_x(k,icrm);
+      real tkx=rdx21*tk(0,k,j+offy_d,ii-1+offx_d,icrm);
+      fu=-2.0*tkx*(u(k,j+offy_u,ic-1+offx_u,icrm)-u(k,j+offy_u,ii-1+offx_u,icrm));
+      tkx=rdx251*(tk(0,k,j+offy_d,ii-1+offx_d,icrm)+tk(0,k,jb+offy_d,ii-1+offx_d,icrm)+
+                  tk(0,k,j+offy_d,ic-1+offx_d,icrm)+tk(0,k,jb+offy_d,ic-1+offx_d,icrm));
+      fv=-tkx*(v(k,j+offy_v,ic-1+offx_v,icrm)-v(k,j+offy_v,ii-1+offx_v,icrm)+
+              (u(k,j+offy_u,ic-1+offx_u,icrm)-u(k,jb+offy_u,ic-1+offx_u,icrm))*dxy);
+      tkx=rdx251*(tk(0,k,j+offy_d,ii-1+offx_d,icrm)+tk(0,k,j+offy_d,ic-1+offx_d,icrm)+
+                  tk(0,kcu,j+offy_d,ii-1+offx_d,icrm)+tk(0,kcu,j+offy_d,ic-1+offx_d,icrm));
+      fw=-tkx*(w(kc,j+offy_w,ic-1+offx_w,icrm)-w(kc,j+offy_w,ii-1+offx_w,icrm)+
+              (u(kcu,j+offy_u,ic-1+offx_u,icrm)-u(k,j+offy_u,ic-1+offx_u,icrm))*dxz);
+    };
 
-  // for (int k=0; k<nzm; k++) {
-  //   for (int j=0; j<ny; j++) {
-  //     for (int i=0; i<nx; i++) {
-  //       for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<4>(nzm,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    int jb=j-1;
-    int kc=k+1;
-    dudt(na-1,k,j,i,icrm)=dudt(na-1,k,j,i,icrm)-(fu(k,j+1,i+1,icrm)-fu(k,jb+1,i+1,icrm));
-    dvdt(na-1,k,j,i,icrm)=dvdt(na-1,k,j,i,icrm)-(fv(k,j+1,i+1,icrm)-fv(k,jb+1,i+1,icrm));
-    dwdt(na-1,kc,j,i,icrm)=dwdt(na-1,kc,j,i,icrm)-(fw(k,j+1,i+1,icrm)-fw(k,jb+1,i+1,icrm));
-  });
+    // Fluxes through the y face jj, in 0:ny
+    auto flux_y = [&] (int jj, real &fu, real &fv, real &fw) {
+      int jc=jj+1;
+      int ib=i-1;
+      real dyz=dy/(dz(icrm)*adzw(kc,icrm));
+      real rdy21=rdy2    * grdf_y(k,icrm);
+      real rdy251=rdy25  * grdf_y(k,icrm);
+      real tky=rdy21*tk(0,k,jj-1+offy_d,i+offx_d,icrm);
+      fv=-2.0*tky*(v(k,jc-1+offy_v,i+offx_v,icrm)-v(k,jj-1+offy_v,i+offx_v,icrm));
+      tky=rdy251*(tk(0,k,jj-1+offy_d,i+offx_d,icrm)+tk(0,k,jj-1+offy_d,ib+offx_d,icrm)+
+                  tk(0,k,jc-1+offy_d,i+offx_d,icrm)+tk(0,k,jc-1+offy_d,ib+offx_d,icrm));
+      fu=-tky*(u(k,jc-1+offy_u,i+offx_u,icrm)-u(k,jj-1+offy_u,i+offx_u,icrm)+
+              (v(k,jc-1+offy_v,i+offx_v,icrm)-v(k,jc-1+offy_v,ib+offx_v,icrm))*dyx);
+      tky=rdy251*(tk(0,k,jj-1+offy_d,i+offx_d,icrm)+tk(0,k,jc-1+offy_d,i+offx_d,icrm)+
+                  tk(0,kcu,jj-1+offy_d,i+offx_d,icrm)+tk(0,kcu,jc-1+offy_d,i+offx_d,icrm));
+      fw=-tky*(w(kc,jc-1+offy_w,i+offx_w,icrm)-w(kc,jj-1+offy_w,i+offx_w,icrm)+
+              (v(kcu,jc-1+offy_v,i+offx_v,icrm)-v(k,jc-1+offy_v,i+offx_v,icrm))*dyz);
+    };
 
-  // for (int k=0; k<nzm; k++) {
-  //  for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<2>(nz,ncrms) , YAKL_LAMBDA (int k, int icrm) {
-    uwsb(k,icrm)=0.0;
-    vwsb(k,icrm)=0.0;
-  });
+    // Fluxes through the z interface kz+1, for kz in 0:nzm-2
+    auto flux_z = [&] (int kz, real &fu, real &fv, real &fw) {
+      int jb=j-1;
+      int kzc=kz+1;
+      int ib=i-1;
+      real rdz=1.0/dz(icrm);
+      real rdz2 = rdz*rdz * grdf_z(kz,icrm);
+      real rdz25 = 0.25*rdz2;
+      real iadz = 1.0/adz(kz,icrm);
+      real iadzw= 1.0/adzw(kzc,icrm);
+      real dzx=dz(icrm)/dx;
+      real dzy=dz(icrm)/dy;
+      real tkz=rdz2*tk(0,kz,j+offy_d,i+offx_d,icrm);
+      fw=-2.0*tkz*(w(kzc,j+offy_w,i+offx_w,icrm)-w(kz,j+offy_w,i+offx_w,icrm))*rho(kz,icrm)*iadz;
+      tkz=rdz25*(tk(0,kz,j+offy_d,i+offx_d,icrm)+tk(0,kz,j+offy_d,ib+offx_d,icrm)+tk(0,kzc,j+offy_d,i+offx_d,icrm)+
+                 tk(0,kzc,j+offy_d,ib+offx_d,icrm));
+      fu=-tkz*( (u(kzc,j+offy_u,i+offx_u,icrm)-u(kz,j+offy_u,i+offx_u,icrm))*iadzw +
+                (w(kzc,j+offy_w,i+offx_w,icrm)-w(kzc,j+offy_w,ib+offx_w,icrm))*dzx)*rhow(kzc,icrm);
+      tkz=rdz25*(tk(0,kz,j+offy_d,i+offx_d,icrm)+tk(0,kz,jb+offy_d,i+offx_d,icrm)+tk(0,kzc,j+offy_d,i+offx_d,icrm)+
+                 tk(0,kzc,jb+offy_d,i+offx_d,icrm));
+      fv=-tkz*( (v(kzc,j+offy_v,i+offx_v,icrm)-v(kz,j+offy_v,i+offx_v,icrm))*iadzw +
+                (w(kzc,j+offy_w,i+offx_w,icrm)-w(kzc,jb+offy_w,i+offx_w,icrm))*dzy)*rhow(kzc,icrm);
+    };
 
-  // for (int k=0; k<nzm-1; k++) {
-  //   for (int j=0; j<ny; j++) {
-  //     for (int i=0; i<nx; i++) {
-  //       for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<4>(nzm-1,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    int jb=j-1;
-    int kc=k+1;
-    int ib=i-1;
-    real rdz=1.0/dz(icrm);
-    real rdz2 = rdz*rdz * grdf_z(k,icrm);
-    real rdz25 = 0.25*rdz2;
-    real iadz = 1.0/adz(k,icrm);
-    real iadzw= 1.0/adzw(kc,icrm);
-    real dzx=dz(icrm)/dx;
-    real dzy=dz(icrm)/dy;
-    real tkz=rdz2*tk(0,k,j+offy_d,i+offx_d,icrm);
-    fw(kc,j+1,i+1,icrm)=-2.0*tkz*(w(kc,j+offy_w,i+offx_w,icrm)-w(k,j+offy_w,i+offx_w,icrm))*rho(k,icrm)*iadz;
-    tkz=rdz25*(tk(0,k,j+offy_d,i+offx_d,icrm)+tk(0,k,j+offy_d,ib+offx_d,icrm)+tk(0,kc,j+offy_d,i+offx_d,icrm)+
-               tk(0,kc,j+offy_d,ib+offx_d,icrm));
-    fu(kc,j+1,i+1,icrm)=-tkz*( (u(kc,j+offy_u,i+offx_u,icrm)-u(k,j+offy_u,i+offx_u,icrm))*iadzw + 
-                               (w(kc,j+offy_w,i+offx_w,icrm)-w(kc,j+offy_w,ib+offx_w,icrm))*dzx)*rhow(kc,icrm);
-    tkz=rdz25*(tk(0,k,j+offy_d,i+offx_d,icrm)+tk(0,k,jb+offy_d,i+offx_d,icrm)+tk(0,kc,j+offy_d,i+offx_d,icrm)+
-               tk(0,kc,jb+offy_d,i+offx_d,icrm));
-    fv(kc,j+1,i+1,icrm)=-tkz*( (v(kc,j+offy_v,i+offx_v,icrm)-v(k,j+offy_v,i+offx_v,icrm))*iadzw + 
-                               (w(kc,j+offy_w,i+offx_w,icrm)-w(kc,jb+offy_w,i+offx_w,icrm))*dzy)*rhow(kc,icrm);
-    yakl::atomicAdd(uwsb(kc,icrm),fu(kc,j+1,i+1,icrm));
-    yakl::atomicAdd(vwsb(kc,icrm),fv(kc,j+1,i+1,icrm));
-  });
+    real fu_lo, fv_lo, fw_lo, fu_hi, fv_hi, fw_hi;
 
-  //   for (int j=0; j<ny; j++) {
-  //     for (int i=0; i<nx; i++) {
-  //       for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<3>(ny,nx,ncrms) , YAKL_LAMBDA (int j, int i, int icrm) {
-    real rdz=1.0/dz(icrm);
-    real rdz2 = rdz*rdz * grdf_z(nzm-2,icrm);
-    real tkz=rdz2*grdf_z(nzm-1,icrm)*tk(0,nzm-1,j+offy_d,i+offx_d,icrm);
-    fw(nz-1,j+1,i+1,icrm)=-2.0*tkz*(w(nz-1,j+offy_d,i+offx_d,icrm)-w(nzm-1,j+offy_w,i+offx_w,icrm))/
-                          adz(nzm-1,icrm)*rho(nzm-1,icrm);
-    fu(0,j+1,i+1,icrm)=fluxbu(j,i,icrm) * rdz * rhow(0,icrm);
-    fv(0,j+1,i+1,icrm)=fluxbv(j,i,icrm) * rdz * rhow(0,icrm);
-    fu(nz-1,j+1,i+1,icrm)=fluxtu(j,i,icrm) * rdz * rhow(nz-1,icrm);
-    fv(nz-1,j+1,i+1,icrm)=fluxtv(j,i,icrm) * rdz * rhow(nz-1,icrm);
-    yakl::atomicAdd(uwsb(0,icrm),fu(0,j+1,i+1,icrm));
-    yakl::atomicAdd(vwsb(0,icrm),fv(0,j+1,i+1,icrm));
-  });
+    // x direction
+    flux_x(i,  fu_lo,fv_lo,fw_lo);
+    flux_x(i+1,fu_hi,fv_hi,fw_hi);
+    dudt(na-1,k,j,i,icrm)=dudt(na-1,k,j,i,icrm)-(fu_hi-fu_lo);
+    dvdt(na-1,k,j,i,icrm)=dvdt(na-1,k,j,i,icrm)-(fv_hi-fv_lo);
+    dwdt(na-1,kc,j,i,icrm)=dwdt(na-1,kc,j,i,icrm)-(fw_hi-fw_lo);
 
-  // for (int k=0; k<nzm; k++) {
-  //   for (int j=0; j<ny; j++) {
-  //     for (int i=0; i<nx; i++) {
-  //       for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<4>(nzm,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    int kc=k+1;
+    // y direction
+    flux_y(j,  fu_lo,fv_lo,fw_lo);
+    flux_y(j+1,fu_hi,fv_hi,fw_hi);
+    dudt(na-1,k,j,i,icrm)=dudt(na-1,k,j,i,icrm)-(fu_hi-fu_lo);
+    dvdt(na-1,k,j,i,icrm)=dvdt(na-1,k,j,i,icrm)-(fv_hi-fv_lo);
+    dwdt(na-1,kc,j,i,icrm)=dwdt(na-1,kc,j,i,icrm)-(fw_hi-fw_lo);
+
+    // z direction: u and v at the interfaces k and k+1, and w at levels k+1 and k+2
+    real rdz=1.0/dz(icrm);
+    if (k==0) {
+      fu_lo=fluxbu(j,i,icrm) * rdz * rhow(0,icrm);
+      fv_lo=fluxbv(j,i,icrm) * rdz * rhow(0,icrm);
+      yakl::atomicAdd(uwsb(0,icrm),fu_lo);
+      yakl::atomicAdd(vwsb(0,icrm),fv_lo);
+    } else {
+      flux_z(k-1,fu_lo,fv_lo,fw_lo);
+    }
+    if (k==nzm-1) {
+      fu_hi=fluxtu(j,i,icrm) * rdz * rhow(nz-1,icrm);
+      fv_hi=fluxtv(j,i,icrm) * rdz * rhow(nz-1,icrm);
+    } else {
+      flux_z(k,fu_hi,fv_hi,fw_hi);
+      yakl::atomicAdd(uwsb(kc,icrm),fu_hi);
+      yakl::atomicAdd(vwsb(kc,icrm),fv_hi);
+    }
     real rhoi = 1.0/(rho(k,icrm)*adz(k,icrm));
-    dudt(na-1,k,j,i,icrm)=dudt(na-1,k,j,i,icrm)-(fu(kc,j+1,i+1,icrm)-fu(k,j+1,i+1,icrm))*rhoi;
-    dvdt(na-1,k,j,i,icrm)=dvdt(na-1,k,j,i,icrm)-(fv(kc,j+1,i+1,icrm)-fv(k,j+1,i+1,icrm))*rhoi;
-  });
+    dudt(na-1,k,j,i,icrm)=dudt(na-1,k,j,i,icrm)-(fu_hi-fu_lo)*rhoi;
+    dvdt(na-1,k,j,i,icrm)=dvdt(na-1,k,j,i,icrm)-(fv_hi-fv_lo)*rhoi;
 
-  // for (int k=0; k<nzm-1; k++) {
-  //   for (int j=0; j<ny; j++) {
-  //     for (int i=0; i<nx; i++) {
-  //       for (int icrm=0; icrm<ncrms; icrm++) {
-  parallel_for( SimpleBounds<4>(nzm-1,ny,nx,ncrms) , YAKL_LAMBDA (int k, int j, int i, int icrm) {
-    real rhoi = 1.0/(rhow(k+1,icrm)*adzw(k+1,icrm));
-    dwdt(na-1,k+1,j,i,icrm)=dwdt(na-1,k+1,j,i,icrm)-(fw(k+2,j+1,i+1,icrm)-fw(k+1,j+1,i+1,icrm))*rhoi;
+    if (k<nzm-1) {
+      // fw_hi is the w flux at level k+1. Get the one at level k+2.
+      real fw_top;
+      if (k==nzm-2) {
+        real rdz2 = rdz*rdz * grdf_z(nzm-2,icrm);
+        real tkz=rdz2*grdf_z(nzm-1,icrm)*tk(0,nzm-1,j+offy_d,i+offx_d,icrm);
+        fw_top=-2.0*tkz*(w(nz-1,j+offy_d,i+offx_d,icrm)-w(nzm-1,j+offy_w,i+offx_w,icrm))/
+               adz(nzm-1,icrm)*rho(nzm-1,icrm);
+      } else {
+        real fu_tmp, fv_tmp;
+        flux_z(k+1,fu_tmp,fv_tmp,fw_top);
+      }
+      real rhoiw = 1.0/(rhow(k+1,icrm)*adzw(k+1,icrm));
+      dwdt(na-1,k+1,j,i,icrm)=dwdt(na-1,k+1,j,i,icrm)-(fw_top-fw_hi)*rhoiw;
+    }
   });
 
 }
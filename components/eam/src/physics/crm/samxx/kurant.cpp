@@ -12,19 +12,24 @@ void kurant () {
   YAKL_SCOPE( dz    , ::dz );
   YAKL_SCOPE( adzw  , ::adzw );
   YAKL_SCOPE( ncrms , ::ncrms );
+  YAKL_SCOPE( crm_ncycle , ::crm_ncycle );
 
   int constexpr max_ncycle = 4;
   real cfl;
 
-  real2d wm    ("wm"   ,nz ,ncrms);
-  real2d uhm   ("uhm"  ,nz ,ncrms);
-  real2d tmpMax("uhMax",nzm,ncrms);
+  YAKL_SCOPE( wm      , ::kurant_wm );
+  YAKL_SCOPE( uhm     , ::kurant_uhm );
+  YAKL_SCOPE( tmpMax  , ::kurant_tmpmax );
+  YAKL_SCOPE( cfl_crm , ::kurant_cfl_crm );
 
   ncycle = 1;
   parallel_for( SimpleBounds<2>(nz,ncrms) , YAKL_LAMBDA (int k, int icrm) {
     wm(k,icrm) = 0.0;
     uhm(k,icrm) = 0.0;
   });
+  parallel_for( ncrms , YAKL_LAMBDA (int icrm) {
+    cfl_crm(icrm) = 0.0;
+  });
 
   // for (int k=0; k<nzm; k++) {
   //   for (int j=0; j<ny; j++) {
@@ -51,6 +56,7 @@ void kurant () {
     real tmp2 = wm(k,icrm)*dt/dztemp;
     real tmp3 = wm(k+1,icrm)*dt/dztemp;
     tmpMax(k,icrm) = max(max(tmp1,tmp2),tmp3);
+    yakl::atomicMax(cfl_crm(icrm),tmpMax(k,icrm));
   });
 
   yakl::ParallelMax<real,yakl::memDevice> pmax( nzm*ncrms );
@@ -64,10 +70,16 @@ void kurant () {
     exit(-1);
   }
 
-  kurant_sgs(cfl);
+  kurant_sgs(cfl,cfl_crm);
 
   ncycle = max(ncycle,max(1,static_cast<int>(ceil(cfl/0.7))));
 
+  // The number of subcycles each CRM would need on its own. All CRMs are
+  // currently subcycled ncycle times, which is the max over the CRMs.
+  parallel_for( ncrms , YAKL_LAMBDA (int icrm) {
+    crm_ncycle(icrm) = max(1,static_cast<int>(ceil(cfl_crm(icrm)/0.7)));
+  });
+
 #ifdef MMF_FIXED_SUBCYCLE
   ncycle = max_ncycle;
 #endif
@@ -20,10 +20,10 @@ void pressure() {
   int constexpr n3j=3*ny_gl/2+1;
   int constexpr fftySize = ny > 4 ? ny : 4;
 
-  real4d f ("f" , nzslab, ny2, nx2, ncrms);
-  real4d ff("ff", nzm,ny2,nx+1,ncrms);
-  real2d a ("a" , nzm, ncrms);
-  real2d c ("c" , nzm, ncrms);
+  YAKL_SCOPE( f             , :: pressure_f );
+  YAKL_SCOPE( ff            , :: pressure_ff );
+  YAKL_SCOPE( a             , :: pressure_a );
+  YAKL_SCOPE( c             , :: pressure_c );
 
   int iwall = 0;
   int nypp, jwall;
@@ -35,7 +35,7 @@ void pressure() {
     nypp = ny+2;
   }
 
-  real2d eign("eign",nypp,nx+1);
+  YAKL_SCOPE( eign          , :: pressure_eign );
 
   press_rhs();
 
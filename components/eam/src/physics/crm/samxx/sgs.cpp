@@ -1,7 +1,7 @@
 
 #include "sgs.h"
 
-void kurant_sgs(real &cfl) {
+void kurant_sgs(real &cfl, real1d &cfl_crm) {
   YAKL_SCOPE( sgs_field_diag , :: sgs_field_diag );
   YAKL_SCOPE( dz             , :: dz );
   YAKL_SCOPE( dy             , :: dy );
@@ -13,7 +13,7 @@ void kurant_sgs(real &cfl) {
   YAKL_SCOPE( grdf_z         , :: grdf_z );
   YAKL_SCOPE( ncrms          , :: ncrms );
 
-  real2d tkhmax("tkhmax",nzm,ncrms);
+  YAKL_SCOPE( tkhmax         , :: kurant_sgs_tkhmax );
 
   // for (int k=0; k<nzm; k++) {
   //   for (int icrm=0; icrm<ncrms; icrm++) {
@@ -37,6 +37,7 @@ void kurant_sgs(real &cfl) {
     real ydir = 0.5*tkhmax(k,icrm)*grdf_y(k,icrm)*dt/(dy*dy)*YES3D;
     real zdir = 0.5*tkhmax(k,icrm)*grdf_z(k,icrm)*dt/(dztmp*dztmp);
     tkhmax(k,icrm) = max( max( xdir , ydir ) , zdir );
+    yakl::atomicMax( cfl_crm(icrm) , tkhmax(k,icrm) );
   });
 
   // Perform a max reduction over tkhmax
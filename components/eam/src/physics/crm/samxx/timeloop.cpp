@@ -188,6 +188,12 @@ void timeloop() {
       nb=nn;
     } // icycle
 
+    //-----------------------------------------------------------
+    //       Adapt the mean-state acceleration factor, and nstop
+    if (use_crm_accel && crm_accel_adaptive) {
+      crm_accel_adapt(nstep, nstop);
+    }
+
     post_icycle();
 
   } while (nstep < nstop);
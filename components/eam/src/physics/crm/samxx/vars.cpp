@@ -193,6 +193,25 @@ void allocate() {
   q_vt_pert        = real4d( "q_vt_pert      "     , nzm , ny         , nx     , ncrms ); 
   u_vt_pert        = real4d( "u_vt_pert      "     , nzm , ny         , nx     , ncrms ); 
 
+  {
+    int constexpr nzslab = nzm/nsubdomains > 1 ? nzm/nsubdomains : 1;
+    int constexpr nypp   = RUN2D ? 1 : ny+2;
+    kurant_wm                      = real2d( "kurant_wm                "           , nz  , ncrms );
+    kurant_uhm                     = real2d( "kurant_uhm               "           , nz  , ncrms );
+    kurant_tmpmax                  = real2d( "kurant_tmpmax            "           , nzm , ncrms );
+    kurant_cfl_crm                 = real1d( "kurant_cfl_crm           "                 , ncrms );
+    kurant_sgs_tkhmax              = real2d( "kurant_sgs_tkhmax        "           , nzm , ncrms );
+    advect_all_scalars_dummy       = real2d( "advect_all_scalars_dummy "           , nz  , ncrms );
+    advect_all_scalars_esmt_offset = real1d( "advect_all_scalars_esmt_offset"            , ncrms );
+    advect_all_scalars_esmt_min    = real1d( "advect_all_scalars_esmt_min"               , ncrms );
+    advect_all_scalars_micro_ind   = int1d ( "advect_all_scalars_micro_ind"      , nmicro_fields );
+    pressure_f                     = real4d( "pressure_f               " , nzslab , ny+2*YES3D , nx+2 , ncrms );
+    pressure_ff                    = real4d( "pressure_ff              " , nzm    , ny+2*YES3D , nx+1 , ncrms );
+    pressure_a                     = real2d( "pressure_a               "           , nzm , ncrms );
+    pressure_c                     = real2d( "pressure_c               "           , nzm , ncrms );
+    pressure_eign                  = real2d( "pressure_eign            "           , nypp , nx+1 );
+  }
+
   yakl::memset(t00               ,0.);
   yakl::memset(tln               ,0.);
   yakl::memset(qln               ,0.);
@@ -382,6 +401,11 @@ void allocate() {
   yakl::memset(t_vt              ,0.);
   yakl::memset(q_vt              ,0.);
   yakl::memset(u_vt              ,0.);
+
+  if (ncrms != fft_plans_ncrms) {
+    cleanup_fft_plans();
+    fft_plans_ncrms = ncrms;
+  }
 }
 
 
@@ -667,13 +691,41 @@ void finalize() {
   q_vt_pert        = real4d();
   u_vt_pert        = real4d();
 
+  kurant_wm                      = real2d();
+  kurant_uhm                     = real2d();
+  kurant_tmpmax                  = real2d();
+  kurant_cfl_crm                 = real1d();
+  kurant_sgs_tkhmax              = real2d();
+  advect_all_scalars_dummy       = real2d();
+  advect_all_scalars_esmt_offset = real1d();
+  advect_all_scalars_esmt_min    = real1d();
+  advect_all_scalars_micro_ind   = int1d();
+  pressure_f                     = real4d();
+  pressure_ff                    = real4d();
+  pressure_a                     = real2d();
+  pressure_c                     = real2d();
+  pressure_eign                  = real2d();
+
   yakl::fence();
+}
+
 
+// The FFT plans are created by the first transform after a cleanup and only
+// depend on ncrms (the other dimensions of the transformed arrays are fixed at
+// compile time), so they are cached across crm() calls and re-created when
+// ncrms changes
+void cleanup_fft_plans() {
   pressure_fftx.cleanup();
   pressure_ffty.cleanup();
   vt_fftx.cleanup();
   vt_ffty.cleanup();
   esmt_fftx.cleanup();
+  fft_plans_ncrms = -1;
+}
+
+
+extern "C" void crm_finalize() {
+  cleanup_fft_plans();
 }
 
 
@@ -836,6 +888,7 @@ void create_and_copy_inputs(real *crm_input_bflxls_p, real *crm_input_wndls_p, r
   ::lat0                      = real1d( "lat0                    "                                , ncrms); 
   ::long0                     = real1d( "long0                   "                                , ncrms); 
   ::gcolp                     = int1d ( "gcolp                   "                                , ncrms); 
+  ::crm_ncycle                = int1d ( "crm_ncycle              "                                , ncrms); 
 
   // Copy inputs from host Array to device Array
   crm_input_bflxls        .deep_copy_to(::crm_input_bflxls        );
@@ -1372,6 +1425,7 @@ void copy_outputs_and_destroy(real *crm_state_u_wind_p, real *crm_state_v_wind_p
   ::lat0                      = real1d();
   ::long0                     = real1d();
   ::gcolp                     = int1d();
+  ::crm_ncycle                = int1d();
 }
 
 
@@ -1627,6 +1681,21 @@ real4d t_vt_pert      ;
 real4d q_vt_pert      ;
 real4d u_vt_pert      ;
 
+real2d kurant_wm                 ;
+real2d kurant_uhm                ;
+real2d kurant_tmpmax             ;
+real1d kurant_cfl_crm            ;
+real2d kurant_sgs_tkhmax         ;
+real2d advect_all_scalars_dummy  ;
+real1d advect_all_scalars_esmt_offset;
+real1d advect_all_scalars_esmt_min   ;
+int1d  advect_all_scalars_micro_ind ;
+real4d pressure_f                ;
+real4d pressure_ff               ;
+real2d pressure_a                ;
+real2d pressure_c                ;
+real2d pressure_eign             ;
+
 real1d fcorz           ;
 real1d fcor            ;
 real1d longitude0      ;
@@ -1827,6 +1896,7 @@ int2d crm_clear_rh_cnt;
 real1d lat0; 
 real1d long0;
 int1d  gcolp;
+int1d  crm_ncycle;
 
 
 int pcols;
@@ -1957,6 +2027,7 @@ bool use_ESMT;
 bool crm_accel_uv;
 bool use_crm_accel;
 real crm_accel_factor;
+bool crm_accel_adaptive;
 
 real factor_xy;
 real factor_xyt;
@@ -1970,6 +2041,10 @@ real dt_glob;
 
 
 bool crm_accel_ceaseflag;
+real crm_accel_factor_now;
+int  crm_accel_nstop_full;
+real crm_accel_nsteps_done;
+real crm_accel_ratio;
 
 int igstep;
 
@@ -1978,6 +2053,7 @@ yakl::RealFFT1D<real> pressure_ffty;
 yakl::RealFFT1D<real> vt_fftx;
 yakl::RealFFT1D<real> vt_ffty;
 yakl::RealFFT1D<real> esmt_fftx;
+int fft_plans_ncrms = -1;
 
 
 
@@ -14,6 +14,13 @@ void init_values();
 void finalize();
 
 
+void cleanup_fft_plans();
+
+
+// Releases the FFT plans cached across crm() calls, before YAKL is finalized
+extern "C" void crm_finalize();
+
+
 inline void perturb(real1d &arr, double mag) {
   for (int i=0; i<arr.get_totElems(); i++) {
     double r = static_cast <double> (rand()) / static_cast <double> (RAND_MAX);
@@ -240,6 +247,7 @@ extern bool use_ESMT;
 extern bool crm_accel_uv;
 extern bool use_crm_accel;
 extern real crm_accel_factor;
+extern bool crm_accel_adaptive;
 
 extern real4d tabs            ;
 extern real4d qv              ;
@@ -337,6 +345,23 @@ extern real4d t_vt_pert      ;
 extern real4d q_vt_pert      ;
 extern real4d u_vt_pert      ;
 
+// Scratch arrays of the routines called in the time loop. They are allocated
+// once, so that the time loop does not allocate any memory.
+extern real2d kurant_wm                 ;
+extern real2d kurant_uhm                ;
+extern real2d kurant_tmpmax             ;
+extern real1d kurant_cfl_crm            ;
+extern real2d kurant_sgs_tkhmax         ;
+extern real2d advect_all_scalars_dummy  ;
+extern real1d advect_all_scalars_esmt_offset;
+extern real1d advect_all_scalars_esmt_min   ;
+extern int1d  advect_all_scalars_micro_ind ;
+extern real4d pressure_f                ;
+extern real4d pressure_ff               ;
+extern real2d pressure_a                ;
+extern real2d pressure_c                ;
+extern real2d pressure_eign             ;
+
 extern real1d fcorz           ;
 extern real1d fcor            ;
 extern real1d longitude0      ;
@@ -536,6 +561,8 @@ extern int2d  crm_clear_rh_cnt;
 extern real1d lat0; 
 extern real1d long0;
 extern int1d  gcolp;
+// Number of subcycles each CRM needs at the current step (see kurant)
+extern int1d  crm_ncycle;
 
 extern real factor_xy;
 extern real factor_xyt;
@@ -549,6 +576,15 @@ extern real dt_glob;
 
 
 extern bool crm_accel_ceaseflag;
+// Mean-state acceleration factor of the current step. It is crm_accel_factor,
+// unless crm_accel_adaptive is set, in which case it varies in [0,crm_accel_factor].
+extern real crm_accel_factor_now;
+// Adaptive mean-state acceleration: number of unaccelerated steps in the CRM
+// run, number of unaccelerated steps covered so far, and largest ratio of the
+// accelerated mean-state changes to their limits during the current step
+extern int  crm_accel_nstop_full;
+extern real crm_accel_nsteps_done;
+extern real crm_accel_ratio;
 
 extern int igstep;
 
@@ -557,4 +593,5 @@ extern yakl::RealFFT1D<real> pressure_ffty;
 extern yakl::RealFFT1D<real> vt_fftx;
 extern yakl::RealFFT1D<real> vt_ffty;
 extern yakl::RealFFT1D<real> esmt_fftx;
+extern int fft_plans_ncrms;
 
@@ -7,6 +7,7 @@
 #include "share/atm_process/atmosphere_process_group.hpp"
 #include "share/atm_process/atmosphere_process_dag.hpp"
 #include "share/field/field_utils.hpp"
+#include "share/field/field_memory_pool.hpp"
 #include "share/util/scream_time_stamp.hpp"
 #include "share/util/scream_timing.hpp"
 #include "share/util/scream_utils.hpp"
@@ -149,6 +150,15 @@ init_scorpio(const int atm_id)
   // not be, depending on what scorpio does.
   init_gptl(m_gptl_externally_handled);
 
+  // Set how timers interact with the device (fences, Kokkos regions, trace file)
+  auto& driver_options_pl = m_atm_params.sublist("driver_options");
+  TimingOptions timing_opts;
+  timing_opts.fence_device   = driver_options_pl.get<bool>("timers_fence_device",false);
+  timing_opts.kokkos_regions = driver_options_pl.get<bool>("timers_kokkos_regions",false);
+  const auto trace_file      = driver_options_pl.get<std::string>("timers_trace_file","none");
+  timing_opts.trace_file     = trace_file=="none" ? "" : trace_file;
+  set_timing_options(m_atm_comm,timing_opts);
+
   m_ad_status |= s_scorpio_inited;
 }
 
@@ -452,6 +462,11 @@ void AtmosphereDriver::setup_column_conservation_checks ()
                                                            vapor_flux, water_flux,
                                                            ice_flux, heat_flux);
 
+  // Optionally, only test the largest errors of a window of checks, to avoid
+  // a host synchronization at every check.
+  conservation_check->set_deferred_window(
+      driver_options_pl.get<int>("column_conservation_checks_window", 1));
+
   //Get fail handling type from driver_option parameters.
   const std::string fail_handling_type_str =
       driver_options_pl.get<std::string>("column_conservation_checks_fail_handling_type", "Warning");
@@ -511,6 +526,17 @@ void AtmosphereDriver::create_fields()
   // Must have grids and procs at this point
   check_ad_status (s_procs_created | s_grids_created);
 
+  // Set the allocation policy of all fields. A default pack size of 0 means
+  // the pack size of this build (tuned for the target architecture)
+  auto& driver_options_pl = m_atm_params.sublist("driver_options");
+  FieldAllocPolicy alloc_policy;
+  alloc_policy.default_pack_size = driver_options_pl.get<int>("field_default_pack_size",1);
+  alloc_policy.row_alignment     = driver_options_pl.get<int>("field_row_alignment",0);
+  if (alloc_policy.default_pack_size==0) {
+    alloc_policy.default_pack_size = SCREAM_PACK_SIZE;
+  }
+  set_field_alloc_policy(alloc_policy);
+
   // By now, the processes should have fully built the ids of their
   // required/computed fields and groups. Let them register them in the FM
   for (auto it : m_grids_manager->get_repo()) {
@@ -1666,6 +1692,9 @@ void AtmosphereDriver::run (const int dt) {
   m_atm_logger->flush();
 
   stop_timer("EAMxx::run");
+
+  // If requested, write the timings of this step to the trace file
+  flush_timers_trace(m_current_ts.get_num_steps());
 }
 
 void AtmosphereDriver::finalize ( /* inputs? */ ) {
@@ -1682,6 +1711,7 @@ void AtmosphereDriver::finalize ( /* inputs? */ ) {
     out_mgr.finalize();
   }
   m_output_managers.clear();
+  FieldMemoryPool::instance().clean_up();
 
   // Finalize, and then destroy all atmosphere processes
   if (m_atm_process_group.get()) {
@@ -1708,6 +1738,7 @@ void AtmosphereDriver::finalize ( /* inputs? */ ) {
   }
 
   // Write all timers to file, and possibly finalize gptl
+  close_timers_trace();
   if (not m_gptl_externally_handled) {
     write_timers_to_file (m_atm_comm,"scream_timing.txt");
     finalize_gptl();
@@ -1800,6 +1831,8 @@ void AtmosphereDriver::report_res_dep_memory_footprint () const {
   }
   // Atm buffer
   my_dev_mem_usage += m_memory_buffer->allocated_bytes();
+  // Pooled fields (e.g., output diagnostics)
+  my_dev_mem_usage += FieldMemoryPool::instance().allocated_bytes();
   // Output
   for (const auto& om : m_output_managers) {
     const auto om_footprint = om.res_dep_memory_footprint ();
@@ -13,7 +13,7 @@ namespace scream
 SurfaceCouplingExporter::SurfaceCouplingExporter (const ekat::Comm& comm, const ekat::ParameterList& params)
   : AtmosphereProcess(comm, params)
 {
-
+  m_cpl_memory_on_device = m_params.get<bool>("use_coupler_memory_on_device",false);
 }
 // =========================================================================================
 void SurfaceCouplingExporter::set_grids(const std::shared_ptr<const GridsManager> grids_manager)
@@ -135,14 +135,27 @@ void SurfaceCouplingExporter::setup_surface_coupling_data(const SCDataManager &s
   // The export data is of size ncols,num_cpl_exports. All other data is of size num_scream_exports
   m_cpl_exports_view_h = decltype(m_cpl_exports_view_h) (sc_data_manager.get_field_data_ptr(),
                                                          m_num_cols, m_num_cpl_exports);
-  m_cpl_exports_view_d = Kokkos::create_mirror_view(DefaultDevice(), m_cpl_exports_view_h);
 
 #ifdef HAVE_MOAB
   // The export data is of size num_cpl_exports,ncols. All other data is of size num_scream_exports
   m_moab_cpl_exports_view_h = decltype(m_moab_cpl_exports_view_h) (sc_data_manager.get_field_data_moab_ptr(),
                                                          m_num_cpl_exports, m_num_cols);
-  m_moab_cpl_exports_view_d = Kokkos::create_mirror_view(DefaultDevice(), m_moab_cpl_exports_view_h);
 #endif
+  if (m_cpl_memory_on_device) {
+    // The cpl arrays can be accessed on device (e.g., on APUs with unified memory),
+    // so view them directly, and skip the copy altogether
+    m_cpl_exports_view_d = decltype(m_cpl_exports_view_d) (m_cpl_exports_view_h.data(),
+                                                           m_num_cols, m_num_cpl_exports);
+#ifdef HAVE_MOAB
+    m_moab_cpl_exports_view_d = decltype(m_moab_cpl_exports_view_d) (m_moab_cpl_exports_view_h.data(),
+                                                                     m_num_cpl_exports, m_num_cols);
+#endif
+  } else {
+    m_cpl_exports_view_d = Kokkos::create_mirror_view(DefaultDevice(), m_cpl_exports_view_h);
+#ifdef HAVE_MOAB
+    m_moab_cpl_exports_view_d = Kokkos::create_mirror_view(DefaultDevice(), m_moab_cpl_exports_view_h);
+#endif
+  }
 
   m_export_field_names = new name_t[m_num_scream_exports];
   std::memcpy(m_export_field_names, sc_data_manager.get_field_name_ptr(), m_num_scream_exports*32*sizeof(char));
@@ -553,7 +566,7 @@ void SurfaceCouplingExporter::do_export_to_cpl(const bool called_during_initiali
   const int  num_exports        = m_num_scream_exports;
   const int  num_cols           = m_num_cols;
   const auto col_info           = m_column_info_d;
-  // Export to cpl data
+  // Export to cpl data (both mct and moab arrays, if needed) in one kernel
   auto export_policy   = policy_type (0,num_exports*num_cols);
   Kokkos::parallel_for(export_policy, KOKKOS_LAMBDA(const int& i) {
     const int ifield = i / num_cols;
@@ -564,29 +577,24 @@ void SurfaceCouplingExporter::do_export_to_cpl(const bool called_during_initiali
     // if this is during initialization, check whether or not the field should be exported
     bool do_export = (not called_during_initialization || info.transfer_during_initialization);
     if (do_export) {
-      cpl_exports_view_d(icol,info.cpl_indx) = info.constant_multiple*info.data[offset];
-    }
-  });
+      const Real val = info.constant_multiple*info.data[offset];
+      cpl_exports_view_d(icol,info.cpl_indx) = val;
 #ifdef HAVE_MOAB
-  Kokkos::parallel_for(export_policy, KOKKOS_LAMBDA(const int& i) {
-    const int ifield = i / num_cols;
-    const int icol   = i % num_cols;
-    const auto& info = col_info(ifield);
-    const auto offset = icol*info.col_stride + info.col_offset;
-
-    // if this is during initialization, check whether or not the field should be exported
-    bool do_export = (not called_during_initialization || info.transfer_during_initialization);
-    if (do_export) {
-      moab_cpl_exports_view_d(info.cpl_indx, icol) = info.constant_multiple*info.data[offset];
+      moab_cpl_exports_view_d(info.cpl_indx, icol) = val;
+#endif
     }
   });
-#endif
-  // Deep copy fields from device to cpl host array
-  Kokkos::deep_copy(m_cpl_exports_view_h,m_cpl_exports_view_d);
+  if (not m_cpl_memory_on_device) {
+    // Deep copy fields from device to cpl host array
+    Kokkos::deep_copy(m_cpl_exports_view_h,m_cpl_exports_view_d);
 #ifdef HAVE_MOAB
-  // Deep copy fields from device to cpl host array
-  Kokkos::deep_copy(m_moab_cpl_exports_view_h,m_moab_cpl_exports_view_d);
+    // Deep copy fields from device to cpl host array
+    Kokkos::deep_copy(m_moab_cpl_exports_view_h,m_moab_cpl_exports_view_d);
 #endif
+  } else {
+    // The cpl arrays are read on host right after we return
+    Kokkos::fence();
+  }
 
 }
 // =========================================================================================
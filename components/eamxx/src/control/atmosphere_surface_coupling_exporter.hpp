@@ -148,6 +148,10 @@ protected:
   view_2d <DefaultDevice, Real> m_moab_cpl_exports_view_d;
   uview_2d<HostDevice,    Real> m_moab_cpl_exports_view_h;
 #endif
+
+  // If true, the *_view_d views alias the cpl arrays, with no host-device copy.
+  // Only valid if the device can access host memory (e.g., unified memory APUs)
+  bool m_cpl_memory_on_device;
   // Array storing the field names for exports
   name_t*                   m_export_field_names;
   std::vector<std::string>  m_export_field_names_vector;
@@ -14,7 +14,7 @@ namespace scream
 SurfaceCouplingImporter::SurfaceCouplingImporter (const ekat::Comm& comm, const ekat::ParameterList& params)
   : AtmosphereProcess(comm, params)
 {
-
+  m_cpl_memory_on_device = m_params.get<bool>("use_coupler_memory_on_device",false);
 }
 // =========================================================================================
 void SurfaceCouplingImporter::set_grids(const std::shared_ptr<const GridsManager> grids_manager)
@@ -72,15 +72,28 @@ void SurfaceCouplingImporter::set_grids(const std::shared_ptr<const GridsManager
   // The import data is of size ncols,num_cpl_imports. All other data is of size num_scream_imports
   m_cpl_imports_view_h = decltype(m_cpl_imports_view_h) (sc_data_manager.get_field_data_ptr(),
                                                          m_num_cols, m_num_cpl_imports);
-  m_cpl_imports_view_d = Kokkos::create_mirror_view_and_copy(DefaultDevice(),
-                                                             m_cpl_imports_view_h);
 #ifdef HAVE_MOAB
   // The import data is of size num_cpl_imports, ncol. All other data is of size num_scream_imports
   m_moab_cpl_imports_view_h = decltype(m_moab_cpl_imports_view_h) (sc_data_manager.get_field_data_moab_ptr(),
                                                          m_num_cpl_imports, m_num_cols);
-  m_moab_cpl_imports_view_d = Kokkos::create_mirror_view_and_copy(DefaultDevice(),
-                                                             m_moab_cpl_imports_view_h);
 #endif
+  if (m_cpl_memory_on_device) {
+    // The cpl arrays can be accessed on device (e.g., on APUs with unified memory),
+    // so view them directly, and skip the copy altogether
+    m_cpl_imports_view_d = decltype(m_cpl_imports_view_d) (m_cpl_imports_view_h.data(),
+                                                           m_num_cols, m_num_cpl_imports);
+#ifdef HAVE_MOAB
+    m_moab_cpl_imports_view_d = decltype(m_moab_cpl_imports_view_d) (m_moab_cpl_imports_view_h.data(),
+                                                                     m_num_cpl_imports, m_num_cols);
+#endif
+  } else {
+    m_cpl_imports_view_d = Kokkos::create_mirror_view_and_copy(DefaultDevice(),
+                                                               m_cpl_imports_view_h);
+#ifdef HAVE_MOAB
+    m_moab_cpl_imports_view_d = Kokkos::create_mirror_view_and_copy(DefaultDevice(),
+                                                                    m_moab_cpl_imports_view_h);
+#endif
+  }
   m_import_field_names = new name_t[m_num_scream_imports];
   std::memcpy(m_import_field_names, sc_data_manager.get_field_name_ptr(), m_num_scream_imports*32*sizeof(char));
 
@@ -158,16 +171,20 @@ void SurfaceCouplingImporter::do_import(const bool called_during_initialization)
   const int  num_cols           = m_num_cols;
   const int  num_imports        = m_num_scream_imports;
 
-  // Deep copy cpl host array to devic
-  Kokkos::deep_copy(m_cpl_imports_view_d,m_cpl_imports_view_h);
+  // Deep copy cpl host array to device (unless the device can access it directly).
+  // Note: with MOAB, the moab array is the one that is imported.
 #ifdef HAVE_MOAB
-  // Deep copy cpl host array to device
   const auto moab_cpl_imports_view_d = m_moab_cpl_imports_view_d;
-  Kokkos::deep_copy(m_moab_cpl_imports_view_d,m_moab_cpl_imports_view_h);
+  if (not m_cpl_memory_on_device) {
+    Kokkos::deep_copy(m_moab_cpl_imports_view_d,m_moab_cpl_imports_view_h);
+  }
+#else
+  if (not m_cpl_memory_on_device) {
+    Kokkos::deep_copy(m_cpl_imports_view_d,m_cpl_imports_view_h);
+  }
 #endif
 
-
-  // Unpack the fields
+  // Unpack the fields, applying the constant multiples, all in one kernel
   auto unpack_policy = policy_type(0,num_imports*num_cols);
   Kokkos::parallel_for(unpack_policy, KOKKOS_LAMBDA(const int& i) {
     const int ifield = i / num_cols;
@@ -180,27 +197,13 @@ void SurfaceCouplingImporter::do_import(const bool called_during_initialization)
     // if this is during initialization, check whether or not the field should be imported
     bool do_import = (not called_during_initialization || info.transfer_during_initialization);
     if (do_import) {
-      info.data[offset] = cpl_imports_view_d(icol,info.cpl_indx)*info.constant_multiple;
-    }
-  });
-
 #ifdef HAVE_MOAB
-  Kokkos::parallel_for(unpack_policy, KOKKOS_LAMBDA(const int& i) {
-
-    const int icol   = i / num_imports;
-    const int ifield = i % num_imports;
-
-    const auto& info = col_info(ifield);
-
-    auto offset = icol*info.col_stride + info.col_offset;
-
-    // if this is during initialization, check whether or not the field should be imported
-    bool do_import = (not called_during_initialization || info.transfer_during_initialization);
-    if (do_import) {
       info.data[offset] = moab_cpl_imports_view_d(info.cpl_indx, icol)*info.constant_multiple;
+#else
+      info.data[offset] = cpl_imports_view_d(icol,info.cpl_indx)*info.constant_multiple;
+#endif
     }
   });
-#endif
 
   if (m_iop) {
     if (m_iop->get_params().get<bool>("iop_srf_prop")) {
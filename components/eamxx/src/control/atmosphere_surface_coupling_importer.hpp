@@ -91,6 +91,10 @@ protected:
   uview_2d<HostDevice,    Real> m_moab_cpl_imports_view_h;
 #endif
 
+  // If true, the *_view_d views alias the cpl arrays, with no host-device copy.
+  // Only valid if the device can access host memory (e.g., unified memory APUs)
+  bool m_cpl_memory_on_device;
+
   // Array storing the field names for imports
   name_t* m_import_field_names;
 
@@ -1,4 +1,5 @@
 #include "diagnostics/atm_backtend.hpp"
+#include "share/field/field_memory_pool.hpp"
 
 #include <ekat/kokkos/ekat_kokkos_utils.hpp>
 
@@ -14,6 +15,7 @@ AtmBackTendDiag::AtmBackTendDiag(const ekat::Comm &comm,
                    "input parameters.\n");
 
   m_name = m_params.get<std::string>("Tendency Name");
+  m_telescoping = m_params.get<bool>("Telescoping",false);
 }
 
 std::string AtmBackTendDiag::name() const { return m_name + "_atm_tend"; }
@@ -52,13 +54,21 @@ void AtmBackTendDiag::initialize_impl(const RunType /*run_type*/) {
   m_diagnostic_output = Field(d_fid);
   m_diagnostic_output.allocate_view();
 
-  // Let's also create the previous field
+  // Let's also create the previous field. It must persist between time steps,
+  // so it cannot share storage with other fields
   FieldIdentifier prev_fid(name() + "_prev", layout.clone(), diag_units, gn);
   m_f_prev = Field(prev_fid);
+  FieldMemoryPool::Suspend no_pool;
   m_f_prev.allocate_view();
 }
 
 void AtmBackTendDiag::init_timestep(const util::TimeStamp &start_of_step) {
+  if (m_telescoping and not m_save_field) {
+    return;
+  }
+  m_save_field = false;
+  m_num_steps  = 0;
+
   const auto &f_curr = get_field_in(m_name);
   m_f_prev.deep_copy(f_curr);
   m_f_prev.get_header().get_tracking().update_time_stamp(start_of_step);
@@ -72,7 +82,19 @@ void AtmBackTendDiag::compute_diagnostic_impl() {
   const auto &curr_ts = f.get_header().get_tracking().get_time_stamp();
   const auto &prev_ts = m_f_prev.get_header().get_tracking().get_time_stamp();
 
-  if(prev_ts.is_valid()) {
+  if(prev_ts.is_valid() and m_telescoping) {
+    // Only write steps contribute, with the sum of the step tendencies since
+    // m_f_prev was saved. m_f_prev is saved again at the next step.
+    ++m_num_steps;
+    if (m_write_step) {
+      dt = curr_ts - prev_ts;
+      m_f_prev.update(f, Real(m_num_steps) / dt, -Real(m_num_steps) / dt);
+      m_diagnostic_output.deep_copy(m_f_prev);
+      m_save_field = true;
+    } else {
+      m_diagnostic_output.deep_copy(0);
+    }
+  } else if(prev_ts.is_valid()) {
     // This diag was called before, so we have a valid value for m_f_prev,
     // and can compute the tendency
     dt = curr_ts - prev_ts;
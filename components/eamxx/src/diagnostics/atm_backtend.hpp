@@ -8,6 +8,14 @@ namespace scream {
 
 /*
  * This diagnostic will back out the atmosphere tendency of a given field.
+ *
+ * By default, the field is saved at the start of each step, and the diag is the
+ * tendency over the step. In telescoping mode (meant for Average output), the field
+ * is only saved at the first step after each write step. The diag is zero at all
+ * other steps, and, at write steps, the sum of the step tendencies since the field
+ * was saved, which telescopes to num_steps*(f-f_saved)/(t-t_saved). The stream average
+ * is then the same as in the default mode (for a constant time step), without a copy
+ * of the field at every step.
  */
 
 class AtmBackTendDiag : public AtmosphereDiagnostic {
@@ -30,6 +38,9 @@ class AtmBackTendDiag : public AtmosphereDiagnostic {
   // Let's override the init time step method
   void init_timestep(const util::TimeStamp &start_of_step) override;
 
+  // In telescoping mode, the tendency is only computed at write steps
+  void set_write_step(const bool is_write_step) override { m_write_step = is_write_step; }
+
   // Let's override the initialize method to set the fields below
   void initialize_impl(const RunType /*run_type*/) override;
 
@@ -43,6 +54,13 @@ class AtmBackTendDiag : public AtmosphereDiagnostic {
   // Store the previous field
   Field m_f_prev;
 
+  // Telescoping mode: whether the next evaluation is written, whether the field must be
+  // saved at the next step, and the number of evaluations since it was saved
+  bool m_telescoping;
+  bool m_write_step   = true;
+  bool m_save_field   = true;
+  int  m_num_steps    = 0;
+
 };  // class AtmBackTendDiag
 
 }  // namespace scream
@@ -0,0 +1,166 @@
+#include "diagnostics/column_integrals.hpp"
+#include "physics/share/physics_constants.hpp"
+
+#include <ekat/kokkos/ekat_kokkos_utils.hpp>
+
+namespace scream
+{
+
+std::shared_ptr<ColumnIntegrals>
+ColumnIntegrals::get (const Field& dp)
+{
+  static std::map<const void*,std::weak_ptr<ColumnIntegrals>> engines;
+
+  const void* key = dp.get_view<const Real**>().data();
+  auto ptr = engines[key].lock();
+  if (ptr==nullptr) {
+    ptr = std::make_shared<ColumnIntegrals>();
+    ptr->m_dp = dp;
+    ptr->m_num_cols = dp.get_header().get_identifier().get_layout().dim(0);
+    ptr->m_num_levs = dp.get_header().get_identifier().get_layout().dim(1);
+    engines[key] = ptr;
+  }
+  return ptr;
+}
+
+int ColumnIntegrals::
+add_term (const Field& q, const Field& n, const Field& out)
+{
+  const auto& q_layout = q.get_header().get_identifier().get_layout();
+  const auto& o_layout = out.get_header().get_identifier().get_layout();
+  EKAT_REQUIRE_MSG (q_layout.rank()==2 and o_layout.rank()==1,
+      "Error! ColumnIntegrals terms must integrate a (col,lev) field into a (col) field.\n"
+      "  - input field : " + q.name() + "\n"
+      "  - output field: " + out.name() + "\n");
+  EKAT_REQUIRE_MSG (o_layout.dim(0)==m_num_cols and q_layout.dim(0)==m_num_cols and
+                    q_layout.dim(1)==m_num_levs,
+      "Error! Incompatible field dimensions in ColumnIntegrals term.\n"
+      "  - input field : " + q.name() + "\n"
+      "  - output field: " + out.name() + "\n");
+
+  auto& t = m_terms[m_next_id];
+  t.q   = q;
+  t.n   = n;
+  t.out = out;
+
+  m_table_dirty = true;
+  return m_next_id++;
+}
+
+void ColumnIntegrals::remove_term (const int id)
+{
+  m_terms.erase(id);
+  m_table_dirty = true;
+}
+
+void ColumnIntegrals::compute (const int id)
+{
+  auto& t = m_terms.at(id);
+  if (t.pending) {
+    t.pending = false;
+    if (t.ts.is_valid() and t.ts==inputs_time_stamp(t)) {
+      // Computed by the last fused kernel, and inputs did not change since then
+      return;
+    }
+  }
+
+  run_fused();
+
+  // The requested term is consumed now
+  t.pending = false;
+}
+
+util::TimeStamp ColumnIntegrals::
+inputs_time_stamp (const Term& t) const
+{
+  util::TimeStamp ts;
+  for (const auto& f : {t.q,t.n,m_dp}) {
+    if (not f.is_allocated()) {
+      continue;
+    }
+    const auto& fts = f.get_header().get_tracking().get_time_stamp();
+    if (not fts.is_valid()) {
+      return util::TimeStamp();
+    }
+    if (not ts.is_valid() or ts<fts) {
+      ts = fts;
+    }
+  }
+  return ts;
+}
+
+void ColumnIntegrals::update_table ()
+{
+  m_table = KT::view_1d<DeviceTerm>("column_integrals_table",m_terms.size());
+  auto table_h = Kokkos::create_mirror_view(m_table);
+  int i = 0;
+  for (const auto& it : m_terms) {
+    const auto& t = it.second;
+    auto& dt = table_h(i++);
+    const auto q  = t.q.get_view<const Real**>();
+    const auto dp = m_dp.get_view<const Real**>();
+    dt.q         = q.data();
+    dt.q_stride  = q.stride(0);
+    dt.dp        = dp.data();
+    dt.dp_stride = dp.stride(0);
+    if (t.n.is_allocated()) {
+      const auto n = t.n.get_view<const Real**>();
+      dt.n        = n.data();
+      dt.n_stride = n.stride(0);
+    } else {
+      dt.n        = nullptr;
+      dt.n_stride = 0;
+    }
+    dt.out = t.out.get_view<Real*>().data();
+  }
+  Kokkos::deep_copy(m_table,table_h);
+  m_table_dirty = false;
+}
+
+void ColumnIntegrals::run_fused ()
+{
+  using PC  = scream::physics::Constants<Real>;
+  using MT  = typename KT::MemberType;
+  using ESU = ekat::ExeSpaceUtils<typename KT::ExeSpace>;
+
+  constexpr Real g = PC::gravit;
+
+  if (m_table_dirty) {
+    update_table();
+  }
+
+  const int nterms   = m_terms.size();
+  const int num_levs = m_num_levs;
+  const auto table   = m_table;
+  const auto policy  = ESU::get_default_team_policy(m_num_cols*nterms, m_num_levs);
+  Kokkos::parallel_for("ColumnIntegrals::run_fused", policy,
+                       KOKKOS_LAMBDA(const MT& team) {
+    const int icol = team.league_rank() / nterms;
+    const auto& t  = table(team.league_rank() % nterms);
+    const Real* q  = t.q  + icol*t.q_stride;
+    const Real* dp = t.dp + icol*t.dp_stride;
+    const Real* n  = t.n==nullptr ? nullptr : t.n + icol*t.n_stride;
+    Real sum = 0;
+    if (n==nullptr) {
+      Kokkos::parallel_reduce(Kokkos::TeamVectorRange(team, num_levs),
+                              [&] (const int& ilev, Real& lsum) {
+        lsum += q[ilev] * dp[ilev] / g;
+      },sum);
+    } else {
+      Kokkos::parallel_reduce(Kokkos::TeamVectorRange(team, num_levs),
+                              [&] (const int& ilev, Real& lsum) {
+        lsum += q[ilev] * n[ilev] * dp[ilev] / g;
+      },sum);
+    }
+    Kokkos::single(Kokkos::PerTeam(team),[&]() {
+      t.out[icol] = sum;
+    });
+  });
+
+  for (auto& it : m_terms) {
+    it.second.pending = true;
+    it.second.ts = inputs_time_stamp(it.second);
+  }
+}
+
+} //namespace scream
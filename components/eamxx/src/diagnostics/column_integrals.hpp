@@ -0,0 +1,89 @@
+#ifndef EAMXX_COLUMN_INTEGRALS_HPP
+#define EAMXX_COLUMN_INTEGRALS_HPP
+
+#include "share/field/field.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace scream
+{
+
+/*
+ * A fused evaluator of vertically integrated diagnostics
+ *
+ * Several diagnostics (e.g., the water and number paths) compute the mass-weighted
+ * vertical integral of one (or the product of two) column fields:
+ *
+ *   out(icol) = sum_k q(icol,k) [*n(icol,k)] * dp(icol,k) / g
+ *
+ * Each diagnostic registers its integral as a 'term' in the engine of its dp field.
+ * When a diagnostic requests its term, all the registered terms are computed
+ * in a single team-policy kernel, with one team per (column,term) pair. The other
+ * terms are then marked as pending, so that, when their diagnostic requests them,
+ * no kernel is launched, provided the inputs time stamps did not change meanwhile.
+ *
+ * Note: the output fields must be persistent (e.g., not from the FieldMemoryPool),
+ *       since they are written also when their diagnostic is not evaluated.
+ */
+
+class ColumnIntegrals
+{
+public:
+  // Get the engine of the given pseudo density field (created on first request).
+  // The engine is destroyed when no diagnostic is holding it anymore.
+  static std::shared_ptr<ColumnIntegrals> get (const Field& dp);
+
+  // Add a term, returning its id. If n is not allocated, the integrand is q*dp/g.
+  int add_term (const Field& q, const Field& n, const Field& out);
+  void remove_term (const int id);
+
+  // Ensure the output of the given term is up to date
+  void compute (const int id);
+
+#ifndef KOKKOS_ENABLE_CUDA
+  // Cuda requires methods enclosing __device__ lambda's to be public
+protected:
+#endif
+  struct Term {
+    Field q;
+    Field n;
+    Field out;
+
+    // Whether the last fused evaluation updated this term, and the inputs
+    // time stamp at that moment
+    bool            pending = false;
+    util::TimeStamp ts;
+  };
+
+  // Raw pointers to the (column-strided) data of a term, for the device table
+  struct DeviceTerm {
+    const Real* q;
+    const Real* n;
+    const Real* dp;
+    Real*       out;
+    int         q_stride;
+    int         n_stride;
+    int         dp_stride;
+  };
+
+  util::TimeStamp inputs_time_stamp (const Term& t) const;
+  void update_table ();
+  void run_fused ();
+
+  using KT = KokkosTypes<DefaultDevice>;
+
+  Field                           m_dp;
+  std::map<int,Term>              m_terms;
+  int                             m_next_id = 0;
+  int                             m_num_cols = -1;
+  int                             m_num_levs = -1;
+
+  bool                            m_table_dirty = true;
+  KT::view_1d<DeviceTerm>         m_table;
+};
+
+} //namespace scream
+
+#endif // EAMXX_COLUMN_INTEGRALS_HPP
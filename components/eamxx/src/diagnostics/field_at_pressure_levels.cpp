@@ -0,0 +1,267 @@
+#include "diagnostics/field_at_pressure_levels.hpp"
+#include "share/util/scream_universal_constants.hpp"
+
+#include "ekat/std_meta/ekat_std_utils.hpp"
+#include "ekat/util/ekat_upper_bound.hpp"
+#include "ekat/util/ekat_string_utils.hpp"
+#include "ekat/util/ekat_units.hpp"
+
+namespace scream
+{
+
+namespace {
+
+// Parse a string Nxyz, with N a number and xyz='mb', 'hPa', or 'Pa', and return the pressure in Pa
+Real parse_pressure_level (const std::string& location)
+{
+  auto chars_start = location.find_first_not_of("0123456789.");
+  EKAT_REQUIRE_MSG (chars_start!=0 && chars_start!=std::string::npos,
+      "Error! Invalid string for pressure value for FieldAtPressureLevels.\n"
+      " - input string   : " + location + "\n"
+      " - expected format: Nxyz, with N a number, and xyz='mb', 'hPa', or 'Pa'\n");
+  Real p = std::stod(location.substr(0,chars_start));
+
+  const auto units = location.substr(chars_start);
+  EKAT_REQUIRE_MSG (units=="mb" or units=="hPa" or units=="Pa",
+      "Error! Invalid string for pressure value for FieldAtPressureLevels.\n"
+      " - input string   : " + location + "\n"
+      " - expected format: Nxyz, with N a number, and xyz='mb', 'hPa', or 'Pa'\n");
+
+  // Convert pressure level to Pa, the units of pressure in the simulation
+  if (units=="mb" || units=="hPa") {
+    p *= 100;
+  }
+  return p;
+}
+
+} // anonymous namespace
+
+// =========================================================================================
+FieldAtPressureLevels::
+FieldAtPressureLevels (const ekat::Comm& comm, const ekat::ParameterList& params)
+ : AtmosphereDiagnostic(comm,params)
+{
+  using vos_t = std::vector<std::string>;
+
+  m_field_names = m_params.get<vos_t>("field_names");
+  EKAT_REQUIRE_MSG (m_field_names.size()>0,
+      "Error! FieldAtPressureLevels requires at least one field name.\n");
+
+  const auto& levels = m_params.get<vos_t>("pressure_levels");
+  EKAT_REQUIRE_MSG (levels.size()>0,
+      "Error! FieldAtPressureLevels requires at least one pressure level.\n");
+  for (const auto& l : levels) {
+    m_pressure_levels.push_back(parse_pressure_level(l));
+  }
+
+  m_mask_val = m_params.get<double>("mask_value",Real(constants::DefaultFillValue<float>::value));
+
+  if (m_params.isParameter("diag_name")) {
+    m_diag_name = m_params.get<std::string>("diag_name");
+  } else {
+    m_diag_name = ekat::join(m_field_names,"_") + "_at_plevs";
+  }
+}
+
+void FieldAtPressureLevels::
+set_grids (const std::shared_ptr<const GridsManager> grids_manager)
+{
+  const auto& gname = m_params.get<std::string>("grid_name");
+  for (const auto& fn : m_field_names) {
+    add_field<Required>(fn,gname);
+  }
+
+  // We don't know yet which one we need
+  add_field<Required>("p_mid",gname);
+  add_field<Required>("p_int",gname);
+}
+
+void FieldAtPressureLevels::
+initialize_impl (const RunType /*run_type*/)
+{
+  using namespace ShortFieldTagsNames;
+
+  // Sanity checks, and count the number of series to interpolate
+  FieldTag vert_tag = INV;
+  m_num_series = 0;
+  for (const auto& fn : m_field_names) {
+    const auto& fid = get_field_in(fn).get_header().get_identifier();
+    const auto& layout = fid.get_layout();
+    EKAT_REQUIRE_MSG (layout.rank()>=2 && layout.rank()<=3,
+        "Error! Field rank not supported by FieldAtPressureLevels.\n"
+        " - field name: " + fid.name() + "\n"
+        " - field layout: " + layout.to_string() + "\n");
+    const auto tag = layout.tags().back();
+    EKAT_REQUIRE_MSG (tag==LEV || tag==ILEV,
+        "Error! FieldAtPressureLevels diagnostic expects a layout ending with 'LEV'/'ILEV' tag.\n"
+        " - field name  : " + fid.name() + "\n"
+        " - field layout: " + layout.to_string() + "\n");
+    EKAT_REQUIRE_MSG (vert_tag==INV || tag==vert_tag,
+        "Error! FieldAtPressureLevels requires all fields to be on the same vertical grid.\n"
+        " - field name  : " + fid.name() + "\n"
+        " - field layout: " + layout.to_string() + "\n");
+    vert_tag = tag;
+    m_num_series += layout.rank()==3 ? layout.dim(1) : 1;
+  }
+
+  const auto& f0  = get_field_in(m_field_names.front());
+  const auto& fid0 = f0.get_header().get_identifier();
+  const auto& layout0 = fid0.get_layout();
+
+  m_pressure_name = vert_tag==LEV ? "p_mid" : "p_int";
+  m_num_levs = layout0.dims().back();
+  const int num_cols = layout0.dims().front();
+  const int num_plevs = m_pressure_levels.size();
+
+  // All good, create the diag output
+  FieldLayout d_layout;
+  if (m_field_names.size()==1 and layout0.rank()==2) {
+    d_layout = FieldLayout({COL,CMP},{num_cols,num_plevs},{layout0.names()[0],"plev"});
+  } else if (m_field_names.size()==1) {
+    d_layout = FieldLayout({COL,CMP,CMP},{num_cols,m_num_series,num_plevs},
+                           {layout0.names()[0],layout0.names()[1],"plev"});
+  } else {
+    d_layout = FieldLayout({COL,CMP,CMP},{num_cols,m_num_series,num_plevs},
+                           {layout0.names()[0],"field","plev"});
+  }
+  // NOTE: with multiple fields, the output is a bundle of fields with different units
+  const auto units = m_field_names.size()==1 ? fid0.get_units() : ekat::units::Units::nondimensional();
+  FieldIdentifier d_fid (m_diag_name,d_layout,units,fid0.get_grid_name());
+  m_diagnostic_output = Field(d_fid);
+  m_diagnostic_output.allocate_view();
+
+  // Add a field representing the mask as extra data to the diagnostic field.
+  // NOTE: the mask only depends on the pressure profile, so it is the same for all fields
+  auto nondim = ekat::units::Units::nondimensional();
+  const auto& gname = fid0.get_grid_name();
+
+  std::string mask_name = name() + " mask";
+  FieldLayout mask_layout({COL,CMP},{num_cols,num_plevs},{layout0.names()[0],"plev"});
+  FieldIdentifier mask_fid (mask_name,mask_layout, nondim, gname);
+  Field diag_mask(mask_fid);
+  diag_mask.allocate_view();
+  m_diagnostic_output.get_header().set_extra_data("mask_data",diag_mask);
+  m_diagnostic_output.get_header().set_extra_data("mask_value",m_mask_val);
+
+  // Store the target pressure levels on device
+  m_p_tgt = KT::view_1d<Real>("p_tgt",num_plevs);
+  auto p_tgt_h = Kokkos::create_mirror_view(m_p_tgt);
+  for (int ip=0; ip<num_plevs; ++ip) {
+    p_tgt_h(ip) = m_pressure_levels[ip];
+  }
+  Kokkos::deep_copy(m_p_tgt,p_tgt_h);
+
+  // Store the columns to interpolate. The fields data does not move, so we can build this once.
+  m_series = KT::view_1d<Series>("series",m_num_series);
+  auto series_h = Kokkos::create_mirror_view(m_series);
+  int is = 0;
+  for (const auto& fn : m_field_names) {
+    const auto& f = get_field_in(fn);
+    if (f.rank()==2) {
+      auto v = f.get_view<const Real**>();
+      series_h(is++) = Series{v.data(),static_cast<int>(v.stride(0))};
+    } else {
+      auto v = f.get_view<const Real***>();
+      for (int idim=0; idim<v.extent_int(1); ++idim) {
+        series_h(is++) = Series{v.data()+idim*v.stride(1),static_cast<int>(v.stride(0))};
+      }
+    }
+  }
+  Kokkos::deep_copy(m_series,series_h);
+
+  using stratts_t = std::map<std::string,std::string>;
+
+  // Propagate any io string attribute from input field to diag field
+  if (m_field_names.size()==1) {
+    const auto& src_atts = f0.get_header().get_extra_data<stratts_t>("io: string attributes");
+          auto& dst_atts = m_diagnostic_output.get_header().get_extra_data<stratts_t>("io: string attributes");
+    for (const auto& [name, val] : src_atts) {
+      dst_atts[name] = val;
+    }
+  }
+}
+
+// =========================================================================================
+void FieldAtPressureLevels::compute_diagnostic_impl()
+{
+  using MemberType = typename KT::MemberType;
+
+  //This is 2D source pressure
+  const Field& p_src = get_field_in(m_pressure_name);
+  const auto p_src_v = p_src.get_view<const Real**>();
+
+  const auto& pl = p_src.get_header().get_identifier().get_layout();
+  const int ncols = pl.dim(0);
+  const int nlevs = pl.dim(1);
+  const int nplevs = m_p_tgt.extent_int(0);
+  const int nseries = m_num_series;
+
+  // Whether the output is (ncol,plev) or (ncol,field,plev), the plev dim is the fastest
+  // striding, so we can use raw pointers with strides for both cases.
+  const auto& diag_f = m_diagnostic_output;
+  Real* diag_data;
+  int diag_col_stride, diag_series_stride;
+  if (diag_f.rank()==2) {
+    auto diag = diag_f.get_view<Real**>();
+    diag_data = diag.data();
+    diag_col_stride = diag.stride(0);
+    diag_series_stride = 0;
+  } else {
+    auto diag = diag_f.get_view<Real***>();
+    diag_data = diag.data();
+    diag_col_stride = diag.stride(0);
+    diag_series_stride = diag.stride(1);
+  }
+  auto mask = diag_f.get_header().get_extra_data<Field>("mask_data").get_view<Real**>();
+
+  auto p_tgt  = m_p_tgt;
+  auto series = m_series;
+  auto mval   = m_mask_val;
+  auto policy = KT::TeamPolicy(ncols,Kokkos::AUTO);
+  Kokkos::parallel_for(policy,KOKKOS_LAMBDA(const MemberType& team) {
+    const int icol = team.league_rank();
+    auto x1 = ekat::subview(p_src_v,icol);
+    auto beg = x1.data();
+    auto end = beg + nlevs;
+    auto last = beg + (nlevs-1);
+    Real* diag_col = diag_data + icol*diag_col_stride;
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team,nplevs),[&](const int ip) {
+      const Real p = p_tgt(ip);
+      if (p<*beg or p>*last) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(team,nseries),[&](const int is) {
+          diag_col[is*diag_series_stride+ip] = mval;
+        });
+        Kokkos::single(Kokkos::PerThread(team),[&]{
+          mask(icol,ip) = 0;
+        });
+        return;
+      }
+
+      // Search the column once, and use the same weights for all series
+      auto ub = ekat::upper_bound(beg,end,p);
+      int k1 = ub - beg;
+      int k0;
+      Real w;
+      if (k1==0) {
+        // Corner case: p==x1(0)
+        k0 = 0; w = 0;
+      } else if (k1==nlevs) {
+        // Corner case: p==x1(nlevs-1)
+        k0 = k1 = nlevs-1; w = 0;
+      } else {
+        // General case: interpolate between k1 and k1-1
+        k0 = k1-1;
+        w = (p-x1(k0)) / (x1(k1)-x1(k0));
+      }
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(team,nseries),[&](const int is) {
+        const Real* y = series(is).data + icol*series(is).col_stride;
+        diag_col[is*diag_series_stride+ip] = y[k0] + (y[k1]-y[k0])*w;
+      });
+      Kokkos::single(Kokkos::PerThread(team),[&]{
+        mask(icol,ip) = 1;
+      });
+    });
+  });
+}
+
+} //namespace scream
@@ -0,0 +1,71 @@
+#ifndef EAMXX_FIELD_AT_PRESSURE_LEVELS_HPP
+#define EAMXX_FIELD_AT_PRESSURE_LEVELS_HPP
+
+#include "share/atm_process/atmosphere_diagnostic.hpp"
+
+namespace scream
+{
+
+/*
+ * This diagnostic interpolates one or more fields at a list of pressure levels.
+ *
+ * Unlike FieldAtPressureLevel, which produces a single level of a single field,
+ * the column search in the pressure profile is done once per (column,target level),
+ * and the result is used to interpolate all the requested fields (and all their
+ * components), in a single kernel.
+ *
+ * The output layout is
+ *  - (ncol,plev): for a single field with layout (ncol,lev)
+ *  - (ncol,dim,plev): for a single field with layout (ncol,dim,lev)
+ *  - (ncol,field,plev): for multiple fields, where the 'field' dim spans all the
+ *    components of all the input fields, in the order they were requested.
+ * All fields must be defined on the same vertical grid (all on LEV or all on ILEV).
+ */
+
+class FieldAtPressureLevels : public AtmosphereDiagnostic
+{
+public:
+  using KT = KokkosTypes<DefaultDevice>;
+
+  // Constructors
+  FieldAtPressureLevels (const ekat::Comm& comm, const ekat::ParameterList& params);
+
+  // The name of the diagnostic
+  std::string name () const { return m_diag_name; }
+
+  // Set the grid
+  void set_grids (const std::shared_ptr<const GridsManager> grids_manager);
+
+  // A single column of one of the interpolated fields
+  struct Series {
+    const Real* data;
+    int col_stride;
+  };
+
+protected:
+#ifdef KOKKOS_ENABLE_CUDA
+public:
+#endif
+  void compute_diagnostic_impl ();
+protected:
+  void initialize_impl (const RunType /*run_type*/);
+
+  std::vector<std::string>  m_field_names;
+  std::string               m_pressure_name;
+  std::string               m_diag_name;
+
+  // Target pressure levels, in Pa
+  std::vector<Real>         m_pressure_levels;
+  KT::view_1d<Real>         m_p_tgt;
+
+  // One entry per component of each input field
+  KT::view_1d<Series>       m_series;
+  int                       m_num_series;
+
+  int                       m_num_levs;
+  Real                      m_mask_val;
+}; // class FieldAtPressureLevels
+
+} //namespace scream
+
+#endif // EAMXX_FIELD_AT_PRESSURE_LEVELS_HPP
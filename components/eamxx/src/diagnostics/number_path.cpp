@@ -3,6 +3,7 @@
 #include <ekat/kokkos/ekat_kokkos_utils.hpp>
 
 #include "physics/share/physics_constants.hpp"
+#include "share/field/field_memory_pool.hpp"
 
 namespace scream {
 
@@ -33,6 +34,12 @@ NumberPathDiagnostic::NumberPathDiagnostic(const ekat::Comm &comm,
   }
 }
 
+NumberPathDiagnostic::~NumberPathDiagnostic() {
+  if(m_term_id >= 0) {
+    m_column_integrals->remove_term(m_term_id);
+  }
+}
+
 std::string NumberPathDiagnostic::name() const { return m_kind + "NumberPath"; }
 
 void NumberPathDiagnostic::set_grids(
@@ -58,9 +65,26 @@ void NumberPathDiagnostic::set_grids(
   FieldIdentifier fid(name(), scalar2d, kg/(kg*m2), grid_name);
   m_diagnostic_output = Field(fid);
   m_diagnostic_output.allocate_view();
+
+  // Pooled storage is reused by other diags, so this diag output can only be
+  // written when this diag is evaluated, and cannot be fused with other diags
+  m_use_column_integrals = not FieldMemoryPool::instance().is_active();
+}
+
+void NumberPathDiagnostic::initialize_impl(const RunType /*run_type*/) {
+  if(m_use_column_integrals) {
+    m_column_integrals = ColumnIntegrals::get(get_field_in("pseudo_density"));
+    m_term_id          = m_column_integrals->add_term(
+        get_field_in(m_qname), get_field_in(m_nname), m_diagnostic_output);
+  }
 }
 
 void NumberPathDiagnostic::compute_diagnostic_impl() {
+  if(m_use_column_integrals) {
+    m_column_integrals->compute(m_term_id);
+    return;
+  }
+
   using PC  = scream::physics::Constants<Real>;
   using KT  = KokkosTypes<DefaultDevice>;
   using MT  = typename KT::MemberType;
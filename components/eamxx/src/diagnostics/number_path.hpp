@@ -2,6 +2,7 @@
 #define EAMXX_NUMBER_PATH_DIAGNOSTIC_HPP
 
 #include "share/atm_process/atmosphere_diagnostic.hpp"
+#include "diagnostics/column_integrals.hpp"
 
 namespace scream {
 
@@ -15,6 +16,8 @@ class NumberPathDiagnostic : public AtmosphereDiagnostic {
   NumberPathDiagnostic(const ekat::Comm &comm,
                        const ekat::ParameterList &params);
 
+  ~NumberPathDiagnostic();
+
   // The name of the diagnostic
   std::string name() const;
 
@@ -28,6 +31,8 @@ class NumberPathDiagnostic : public AtmosphereDiagnostic {
   void compute_diagnostic_impl();
 
  protected:
+  void initialize_impl(const RunType /*run_type*/);
+
   // Keep track of field dimensions
   int m_num_cols;
   int m_num_levs;
@@ -35,6 +40,12 @@ class NumberPathDiagnostic : public AtmosphereDiagnostic {
   std::string m_qname;
   std::string m_nname;
   std::string m_kind;
+
+  // If the diag output is persistent, the path is computed by the ColumnIntegrals
+  // engine of pseudo_density, fused with all other column integrals diagnostics
+  std::shared_ptr<ColumnIntegrals> m_column_integrals;
+  bool                             m_use_column_integrals;
+  int                              m_term_id = -1;
 };  // class NumberPathDiagnostic
 
 }  // namespace scream
@@ -17,6 +17,7 @@
 #include "diagnostics/relative_humidity.hpp"
 #include "diagnostics/vapor_flux.hpp"
 #include "diagnostics/field_at_pressure_level.hpp"
+#include "diagnostics/field_at_pressure_levels.hpp"
 #include "diagnostics/precip_surf_mass_flux.hpp"
 #include "diagnostics/surf_upward_latent_heat_flux.hpp"
 #include "diagnostics/wind_speed.hpp"
@@ -33,6 +34,7 @@ inline void register_diagnostics () {
   diag_factory.register_product("FieldAtLevel",&create_atmosphere_diagnostic<FieldAtLevel>);
   diag_factory.register_product("FieldAtHeight",&create_atmosphere_diagnostic<FieldAtHeight>);
   diag_factory.register_product("FieldAtPressureLevel",&create_atmosphere_diagnostic<FieldAtPressureLevel>);
+  diag_factory.register_product("FieldAtPressureLevels",&create_atmosphere_diagnostic<FieldAtPressureLevels>);
   diag_factory.register_product("AtmosphereDensity",&create_atmosphere_diagnostic<AtmDensityDiagnostic>);
   diag_factory.register_product("Exner",&create_atmosphere_diagnostic<ExnerDiagnostic>);
   diag_factory.register_product("VirtualTemperature",&create_atmosphere_diagnostic<VirtualTemperatureDiagnostic>);
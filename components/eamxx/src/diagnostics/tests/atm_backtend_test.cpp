@@ -109,6 +109,51 @@ TEST_CASE("atm_backtend") {
     // reset t0 to t1 to keep iterating...
     t0 = t1;
   }
+
+  // In telescoping mode, the field is only saved after write steps, and the
+  // average over a window matches the average of the step tendencies
+  params.set("Telescoping", true);
+  auto tdiag = diag_factory.create("AtmBackTendDiag", comm, params);
+  tdiag->set_grids(gm);
+  tdiag->set_required_field(qc);
+  tdiag->initialize(t0, RunType::Initial);
+  auto tdiag_f = tdiag->get_diagnostic();
+
+  constexpr int nsteps = 4;
+  auto sum      = qc.clone();
+  auto tsum     = qc.clone();
+  auto step_tend = qc.clone();
+  for(int iwindow = 0; iwindow < 2; iwindow++) {
+    sum.deep_copy(0);
+    tsum.deep_copy(0);
+    for(int istep = 0; istep < nsteps; istep++) {
+      some_field.deep_copy(qc);
+      tdiag->init_timestep(t0);
+
+      auto t1 = t0;
+      t1 += a_day;
+      qc.get_header().get_tracking().update_time_stamp(t1);
+      randomize(qc, engine, pdf);
+
+      const bool write_step = istep == nsteps - 1;
+      tdiag->set_write_step(write_step);
+      tdiag->compute_diagnostic();
+      if(not write_step) {
+        step_tend.deep_copy(0);
+        REQUIRE(views_are_equal(tdiag_f, step_tend));
+      }
+      step_tend.deep_copy(qc);
+      step_tend.update(some_field, -1.0 / a_day, 1.0 / a_day);
+      sum.update(step_tend, 1.0, 1.0);
+      tsum.update(tdiag_f, 1.0, 1.0);
+      t0 = t1;
+    }
+    // Sums of tendencies are only equal up to round-off
+    auto diff = tsum.clone();
+    diff.update(sum, -1.0, 1.0);
+    REQUIRE(field_max<Real>(diff) <= 1e-10);
+    REQUIRE(field_min<Real>(diff) >= -1e-10);
+  }
 }
 
 }  // namespace scream
@@ -0,0 +1,171 @@
+#include "catch2/catch.hpp"
+
+#include "diagnostics/field_at_pressure_levels.hpp"
+
+#include "share/grid/mesh_free_grids_manager.hpp"
+#include "share/field/field_utils.hpp"
+#include "share/util/scream_universal_constants.hpp"
+
+namespace scream {
+
+std::shared_ptr<GridsManager>
+create_gm (const ekat::Comm& comm, const int ncols, const int nlevs) {
+
+  const int num_global_cols = ncols*comm.size();
+
+  auto gm = create_mesh_free_grids_manager(comm,0,0,nlevs,num_global_cols);
+  gm->build_grids();
+
+  return gm;
+}
+
+// Pressure increases linearly from p_top to p_surf, with a column-dependent top
+Real get_test_pres (const int col, const int lev, const int num_levs) {
+  const Real p_top  = 10000.0 + 1000.0*col;
+  const Real p_surf = 100000.0;
+  return p_top + lev*(p_surf-p_top)/num_levs;
+}
+
+// The data is linear in the pressure, so interpolation is exact
+Real get_test_data (const int ifield, const Real pres) {
+  return 100.0*(ifield+1) + pres;
+}
+
+std::shared_ptr<FieldManager>
+get_test_fm (std::shared_ptr<const AbstractGrid> grid)
+{
+  using namespace ekat::units;
+  using namespace ShortFieldTagsNames;
+  using FL = FieldLayout;
+
+  auto fm = std::make_shared<FieldManager>(grid);
+
+  const int ncols = grid->get_num_local_dofs();
+  const int nlevs = grid->get_num_vertical_levels();
+  const auto& gn = grid->name();
+
+  FieldIdentifier fid_v ("V_mid",FL({COL,LEV},{ncols,nlevs}),m,gn);
+  FieldIdentifier fid_w ("W_mid",FL({COL,LEV},{ncols,nlevs}),kg,gn);
+  FieldIdentifier fid_u ("U_mid",FL({COL,CMP,LEV},{ncols,2,nlevs}),m,gn);
+  FieldIdentifier fid_pm("p_mid",FL({COL,LEV},{ncols,nlevs}),Pa,gn);
+  FieldIdentifier fid_pi("p_int",FL({COL,ILEV},{ncols,nlevs+1}),Pa,gn);
+
+  fm->registration_begins();
+  for (const auto& fid : {fid_v,fid_w,fid_u,fid_pm,fid_pi}) {
+    fm->register_field(FieldRequest(fid,SCREAM_SMALL_PACK_SIZE));
+  }
+  fm->registration_ends();
+
+  auto v  = fm->get_field(fid_v).get_view<Real**,Host>();
+  auto w  = fm->get_field(fid_w).get_view<Real**,Host>();
+  auto u  = fm->get_field(fid_u).get_view<Real***,Host>();
+  auto pm = fm->get_field(fid_pm).get_view<Real**,Host>();
+  auto pi = fm->get_field(fid_pi).get_view<Real**,Host>();
+  for (int icol=0; icol<ncols; ++icol) {
+    for (int ilev=0; ilev<nlevs; ++ilev) {
+      const Real p = (get_test_pres(icol,ilev,nlevs) + get_test_pres(icol,ilev+1,nlevs)) / 2;
+      pm(icol,ilev) = p;
+      v(icol,ilev) = get_test_data(0,p);
+      w(icol,ilev) = get_test_data(1,p);
+      u(icol,0,ilev) = get_test_data(2,p);
+      u(icol,1,ilev) = get_test_data(3,p);
+    }
+    for (int ilev=0; ilev<=nlevs; ++ilev) {
+      pi(icol,ilev) = get_test_pres(icol,ilev,nlevs);
+    }
+  }
+  for (const auto& fn : {"V_mid","W_mid","U_mid","p_mid","p_int"}) {
+    fm->get_field(fn).sync_to_dev();
+  }
+  fm->init_fields_time_stamp(util::TimeStamp({2000,1,1},{0,0,0}));
+
+  return fm;
+}
+
+std::shared_ptr<FieldAtPressureLevels>
+get_test_diag (const ekat::Comm& comm,
+               std::shared_ptr<const FieldManager> fm,
+               std::shared_ptr<const GridsManager> gm,
+               const std::vector<std::string>& fnames,
+               const std::vector<std::string>& plevs)
+{
+  ekat::ParameterList params;
+  params.set("field_names",fnames);
+  params.set("grid_name",fm->get_grid()->name());
+  params.set("pressure_levels",plevs);
+  auto diag = std::make_shared<FieldAtPressureLevels>(comm,params);
+  diag->set_grids(gm);
+  for (const auto& req : diag->get_required_field_requests()) {
+    diag->set_required_field(fm->get_field(req.fid));
+  }
+  diag->initialize(util::TimeStamp({2000,1,1},{0,0,0}),RunType::Initial);
+  return diag;
+}
+
+TEST_CASE("field_at_pressure_levels")
+{
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  const int ncols = 3;
+  const int nlevs = 20;
+  auto gm   = create_gm(comm,ncols,nlevs);
+  auto grid = gm->get_grid("Point Grid");
+  auto fm   = get_test_fm(grid);
+
+  // The last level is below the surface, so it must be masked in all columns
+  const std::vector<std::string> plevs = {"200mb","500hPa","85000Pa","1100mb"};
+  const std::vector<Real> plevs_pa = {20000, 50000, 85000, 110000};
+  const int nplevs = plevs.size();
+
+  auto check = [&](const Real val, const Real mask, const int ifield, const int icol, const int ip) {
+    if (ip==nplevs-1) {
+      REQUIRE (val==constants::DefaultFillValue<float>::value);
+      REQUIRE (mask==0);
+    } else {
+      const Real tgt = get_test_data(ifield,plevs_pa[ip]);
+      REQUIRE (std::abs(val-tgt) <= 1e3*std::numeric_limits<Real>::epsilon()*tgt);
+      REQUIRE (mask==1);
+    }
+  };
+
+  SECTION ("single_field") {
+    auto diag = get_test_diag(comm,fm,gm,{"V_mid"},plevs);
+    diag->compute_diagnostic();
+    auto d = diag->get_diagnostic();
+    REQUIRE (d.name()=="V_mid_at_plevs");
+    REQUIRE (d.rank()==2);
+    d.sync_to_host();
+    auto mask = d.get_header().get_extra_data<Field>("mask_data");
+    mask.sync_to_host();
+    auto d_h = d.get_view<const Real**,Host>();
+    auto m_h = mask.get_view<const Real**,Host>();
+    for (int icol=0; icol<ncols; ++icol) {
+      for (int ip=0; ip<nplevs; ++ip) {
+        check(d_h(icol,ip),m_h(icol,ip),0,icol,ip);
+      }
+    }
+  }
+
+  SECTION ("multiple_fields") {
+    // The output stacks all components of all fields: V, W, U(0), U(1)
+    auto diag = get_test_diag(comm,fm,gm,{"V_mid","W_mid","U_mid"},plevs);
+    diag->compute_diagnostic();
+    auto d = diag->get_diagnostic();
+    REQUIRE (d.rank()==3);
+    REQUIRE (d.get_header().get_identifier().get_layout().dim(1)==4);
+    d.sync_to_host();
+    auto mask = d.get_header().get_extra_data<Field>("mask_data");
+    mask.sync_to_host();
+    auto d_h = d.get_view<const Real***,Host>();
+    auto m_h = mask.get_view<const Real**,Host>();
+    for (int icol=0; icol<ncols; ++icol) {
+      for (int is=0; is<4; ++is) {
+        for (int ip=0; ip<nplevs; ++ip) {
+          check(d_h(icol,is,ip),m_h(icol,ip),is,icol,ip);
+        }
+      }
+    }
+  }
+}
+
+} // namespace scream
@@ -1,5 +1,6 @@
 #include "diagnostics/water_path.hpp"
 #include "physics/share/physics_constants.hpp"
+#include "share/field/field_memory_pool.hpp"
 
 #include <ekat/kokkos/ekat_kokkos_utils.hpp>
 
@@ -32,6 +33,13 @@ WaterPathDiagnostic (const ekat::Comm& comm, const ekat::ParameterList& params)
   }
 }
 
+WaterPathDiagnostic::~WaterPathDiagnostic ()
+{
+  if (m_term_id>=0) {
+    m_column_integrals->remove_term(m_term_id);
+  }
+}
+
 std::string WaterPathDiagnostic::name() const
 {
   return m_kind + "WaterPath";
@@ -60,10 +68,27 @@ set_grids(const std::shared_ptr<const GridsManager> grids_manager)
   FieldIdentifier fid (name(), scalar2d, kg/m2, grid_name);
   m_diagnostic_output = Field(fid);
   m_diagnostic_output.allocate_view();
+
+  // Pooled storage is reused by other diags, so this diag output can only be
+  // written when this diag is evaluated, and cannot be fused with other diags
+  m_use_column_integrals = not FieldMemoryPool::instance().is_active();
+}
+
+void WaterPathDiagnostic::initialize_impl (const RunType /*run_type*/)
+{
+  if (m_use_column_integrals) {
+    m_column_integrals = ColumnIntegrals::get(get_field_in("pseudo_density"));
+    m_term_id = m_column_integrals->add_term(get_field_in(m_qname),Field(),m_diagnostic_output);
+  }
 }
 
 void WaterPathDiagnostic::compute_diagnostic_impl()
 {
+  if (m_use_column_integrals) {
+    m_column_integrals->compute(m_term_id);
+    return;
+  }
+
   using PC  = scream::physics::Constants<Real>;
   using KT  = KokkosTypes<DefaultDevice>;
   using MT  = typename KT::MemberType;
@@ -2,6 +2,7 @@
 #define EAMXX_WATER_PATH_DIAGNOSTIC_HPP
 
 #include "share/atm_process/atmosphere_diagnostic.hpp"
+#include "diagnostics/column_integrals.hpp"
 
 namespace scream
 {
@@ -16,6 +17,8 @@ public:
   // Constructors
   WaterPathDiagnostic (const ekat::Comm& comm, const ekat::ParameterList& params);
 
+  ~WaterPathDiagnostic ();
+
   // The name of the diagnostic
   std::string name () const;
 
@@ -28,6 +31,7 @@ public:
 #endif
   void compute_diagnostic_impl ();
 protected:
+  void initialize_impl (const RunType /*run_type*/);
 
   // Keep track of field dimensions
   int m_num_cols;
@@ -35,6 +39,12 @@ protected:
 
   std::string m_qname;
   std::string m_kind;
+
+  // If the diag output is persistent, the path is computed by the ColumnIntegrals
+  // engine of pseudo_density, fused with all other column integrals diagnostics
+  std::shared_ptr<ColumnIntegrals> m_column_integrals;
+  bool                             m_use_column_integrals;
+  int                              m_term_id = -1;
 }; // class WaterPathDiagnostic
 
 } //namespace scream
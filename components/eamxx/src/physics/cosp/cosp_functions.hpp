@@ -29,70 +29,40 @@ namespace scream {
         inline void finalize() {
             cosp_c2f_final();
         };
+        // Run COSP on ncol columns, whose inputs/outputs are packed (in Fortran order) in
+        // the given buffers. The buffers store, one after the other,
+        //  - inputs : sunlit(ncol), skt(ncol), T_mid, p_mid, z_mid, qv, qc, qi, cldfrac,
+        //             reff_qc, reff_qi, dtau067, dtau105 (all (ncol,nlay)), p_int(ncol,nlay+1)
+        //  - outputs: isccp_cldtot(ncol), isccp_ctptau(ncol,ntau,nctp),
+        //             modis_ctptau(ncol,ntau,nctp), misr_cthtau(ncol,ntau,ncth)
         inline void main(
                 const Int ncol, const Int nsubcol, const Int nlay, const Int ntau, const Int nctp, const Int ncth, const Real emsfc_lw,
-                view_1d<const Real>& sunlit , view_1d<const Real>& skt,
-                view_2d<const Real>& T_mid  , view_2d<const Real>& p_mid  , view_2d<const Real>& p_int,
-                view_2d<const Real>& z_mid  , view_2d<const Real>& qv     , view_2d<const Real>& qc     , view_2d<const Real>& qi,
-                view_2d<const Real>& cldfrac,
-                view_2d<const Real>& reff_qc, view_2d<const Real>& reff_qi,
-                view_2d<const Real>& dtau067, view_2d<const Real>& dtau105,
-                view_1d<Real>& isccp_cldtot , view_3d<Real>& isccp_ctptau, view_3d<Real>& modis_ctptau, view_3d<Real>& misr_cthtau) {
+                const Real* inputs, Real* outputs) {
+            const Real* sunlit  = inputs;
+            const Real* skt     = sunlit + ncol;
+            const Real* T_mid   = skt + ncol;
+            const Real* p_mid   = T_mid + ncol*nlay;
+            const Real* z_mid   = p_mid + ncol*nlay;
+            const Real* qv      = z_mid + ncol*nlay;
+            const Real* qc      = qv + ncol*nlay;
+            const Real* qi      = qc + ncol*nlay;
+            const Real* cldfrac = qi + ncol*nlay;
+            const Real* reff_qc = cldfrac + ncol*nlay;
+            const Real* reff_qi = reff_qc + ncol*nlay;
+            const Real* dtau067 = reff_qi + ncol*nlay;
+            const Real* dtau105 = dtau067 + ncol*nlay;
+            const Real* p_int   = dtau105 + ncol*nlay;
 
-            // Make host copies and permute data as needed
-            lview_host_2d
-                  T_mid_h("T_mid_h", ncol, nlay), p_mid_h("p_mid_h", ncol, nlay), p_int_h("p_int_h", ncol, nlay+1),
-                  z_mid_h("z_mid_h", ncol, nlay), qv_h("qv_h", ncol, nlay), qc_h("qc_h", ncol, nlay), qi_h("qi_h", ncol, nlay),
-                  cldfrac_h("cldfrac_h", ncol, nlay),
-                  reff_qc_h("reff_qc_h", ncol, nlay), reff_qi_h("reff_qi_h", ncol, nlay),
-                  dtau067_h("dtau_067_h", ncol, nlay), dtau105_h("dtau105_h", ncol, nlay);
-            lview_host_3d isccp_ctptau_h("isccp_ctptau_h", ncol, ntau, nctp);
-            lview_host_3d modis_ctptau_h("modis_ctptau_h", ncol, ntau, nctp);
-            lview_host_3d misr_cthtau_h("misr_cthtau_h", ncol, ntau, ncth);
-
-            // Copy to layoutLeft host views
-            for (int i = 0; i < ncol; i++) {
-                for (int j = 0; j < nlay; j++) {
-                    T_mid_h(i,j) = T_mid(i,j);
-                    p_mid_h(i,j) = p_mid(i,j);
-                    z_mid_h(i,j) = z_mid(i,j);
-                    qv_h(i,j) = qv(i,j);
-                    qc_h(i,j) = qc(i,j);
-                    qi_h(i,j) = qi(i,j);
-                    cldfrac_h(i,j) = cldfrac(i,j);
-                    reff_qc_h(i,j) = reff_qc(i,j);
-                    reff_qi_h(i,j) = reff_qi(i,j);
-                    dtau067_h(i,j) = dtau067(i,j);
-                    dtau105_h(i,j) = dtau105(i,j);
-                }
-            }
-            for (int i = 0; i < ncol; i++) {
-                for (int j = 0; j < nlay+1; j++) {
-                    p_int_h(i,j) = p_int(i,j);
-                }
-            }
-
-            // Subsample here?
+            Real* isccp_cldtot = outputs;
+            Real* isccp_ctptau = isccp_cldtot + ncol;
+            Real* modis_ctptau = isccp_ctptau + ncol*ntau*nctp;
+            Real* misr_cthtau  = modis_ctptau + ncol*ntau*nctp;
 
             // Call COSP wrapper
             cosp_c2f_run(ncol, nsubcol, nlay, ntau, nctp, ncth,
-                    emsfc_lw, sunlit.data(), skt.data(), T_mid_h.data(), p_mid_h.data(), p_int_h.data(),
-                    z_mid_h.data(), qv_h.data(), qc_h.data(), qi_h.data(),
-                    cldfrac_h.data(), reff_qc_h.data(), reff_qi_h.data(), dtau067_h.data(), dtau105_h.data(),
-                    isccp_cldtot.data(), isccp_ctptau_h.data(), modis_ctptau_h.data(), misr_cthtau_h.data());
-
-            // Copy outputs back to layoutRight views
-            for (int i = 0; i < ncol; i++) {
-                for (int j = 0; j < ntau; j++) {
-                    for (int k = 0; k < nctp; k++) {
-                        isccp_ctptau(i,j,k) = isccp_ctptau_h(i,j,k);
-                        modis_ctptau(i,j,k) = modis_ctptau_h(i,j,k);
-                    }
-                    for (int k = 0; k < ncth; k++) {
-                        misr_cthtau(i,j,k) = misr_cthtau_h(i,j,k);
-                    }
-                }
-            }
+                    emsfc_lw, sunlit, skt, T_mid, p_mid, p_int, z_mid, qv, qc, qi,
+                    cldfrac, reff_qc, reff_qi, dtau067, dtau105,
+                    isccp_cldtot, isccp_ctptau, modis_ctptau, misr_cthtau);
         }
     }
 }
@@ -7,6 +7,7 @@
 
 #include "share/field/field_utils.hpp"
 
+#include <algorithm>
 #include <array>
 
 namespace scream
@@ -101,6 +102,17 @@ void Cosp::initialize_impl (const RunType /* run_type */)
   // Set property checks for fields in this process
   CospFunc::initialize(m_num_cols, m_num_subcols, m_num_levs);
 
+  // Scratch for the heights and the packed inputs/outputs of the sunlit columns
+  m_col_inputs_size  = 2 + 11*m_num_levs + (m_num_levs+1);
+  m_col_outputs_size = 1 + 2*m_num_tau*m_num_ctp + m_num_tau*m_num_cth;
+  m_z_mid        = KT::view_2d<Real>("z_mid", m_num_cols, m_num_levs);
+  m_z_int        = KT::view_2d<Real>("z_int", m_num_cols, m_num_levs+1);
+  m_sunlit_cols  = KT::view_1d<int>("sunlit_cols", m_num_cols);
+  m_inputs_dev   = KT::view_1d<Real>("cosp_inputs", m_num_cols*m_col_inputs_size);
+  m_outputs_dev  = KT::view_1d<Real>("cosp_outputs", m_num_cols*m_col_outputs_size);
+  m_inputs_host  = view_1d_pinned("cosp_inputs_host", m_inputs_dev.size());
+  m_outputs_host = view_1d_pinned("cosp_outputs_host", m_outputs_dev.size());
+
 
   // Add note to output files about processing ISCCP fields that are only valid during
   // daytime. This can go away once I/O can handle masked time averages.
@@ -134,66 +146,110 @@ void Cosp::run_impl (const double dt)
   auto ts = timestamp();
   auto update_cosp = cosp_do(cosp_freq_in_steps, ts.get_num_steps());
 
-  // Get fields from field manager; note that we get host views because this
-  // interface serves primarily as a wrapper to a c++ to f90 bridge for the COSP
-  // all then need to be copied to layoutLeft views to permute the indices for
-  // F90.
+  auto sunlit       = get_field_in("sunlit").get_view<const Real*>();
+  auto isccp_cldtot = get_field_out("isccp_cldtot").get_view<Real*>();
+  auto isccp_ctptau = get_field_out("isccp_ctptau").get_view<Real***>();
+  auto modis_ctptau = get_field_out("modis_ctptau").get_view<Real***>();
+  auto misr_cthtau  = get_field_out("misr_cthtau").get_view<Real***>();
+  auto cosp_sunlit  = get_field_out("cosp_sunlit").get_view<Real*>();  // Copy of sunlit flag with COSP frequency for proper averaging
+
+  // Night values are ZERO since our I/O does not know how to handle masked/missing values
+  // in temporal averages. If not updating COSP statistics, set these to ZERO as well; this
+  // essentially weights the ISCCP cloud properties by the sunlit mask. What will be output for
+  // time-averages then is the time-average mask-weighted statistics; to get true averages, we
+  // need to divide by the time-average of the mask. I.e., if M is the sunlit mask, and X is the
+  // ISCCP statistic, then
   //
-  // Need to make sure device data is synced to host?
-  get_field_in("qv").sync_to_host();
-  get_field_in("qc").sync_to_host();
-  get_field_in("qi").sync_to_host();
-  get_field_in("sunlit").sync_to_host();
-  get_field_in("surf_radiative_T").sync_to_host();
-  get_field_in("T_mid").sync_to_host();
-  get_field_in("p_mid").sync_to_host();
-  get_field_in("p_int").sync_to_host();
-  get_field_in("cldfrac_rad").sync_to_host();
-  get_field_in("eff_radius_qc").sync_to_host();
-  get_field_in("eff_radius_qi").sync_to_host();
-  get_field_in("dtau067").sync_to_host();
-  get_field_in("dtau105").sync_to_host();
-  get_field_in("phis").sync_to_host();
-  get_field_in("pseudo_density").sync_to_host();
-
-  auto qv      = get_field_in("qv").get_view<const Real**, Host>();
-  auto qc      = get_field_in("qc").get_view<const Real**, Host>();
-  auto qi      = get_field_in("qi").get_view<const Real**, Host>();
-  auto sunlit  = get_field_in("sunlit").get_view<const Real*, Host>();
-  auto skt     = get_field_in("surf_radiative_T").get_view<const Real*, Host>();
-  auto T_mid   = get_field_in("T_mid").get_view<const Real**, Host>();
-  auto p_mid   = get_field_in("p_mid").get_view<const Real**, Host>();
-  auto p_int   = get_field_in("p_int").get_view<const Real**, Host>();
-  auto phis    = get_field_in("phis").get_view<const Real*, Host>();
-  auto pseudo_density = get_field_in("pseudo_density").get_view<const Real**, Host>();
-  auto cldfrac = get_field_in("cldfrac_rad").get_view<const Real**, Host>();
-  auto reff_qc = get_field_in("eff_radius_qc").get_view<const Real**, Host>();
-  auto reff_qi = get_field_in("eff_radius_qi").get_view<const Real**, Host>();
-  auto dtau067 = get_field_in("dtau067").get_view<const Real**, Host>();
-  auto dtau105 = get_field_in("dtau105").get_view<const Real**, Host>();
-  auto isccp_cldtot = get_field_out("isccp_cldtot").get_view<Real*, Host>();
-  auto isccp_ctptau = get_field_out("isccp_ctptau").get_view<Real***, Host>();
-  auto modis_ctptau = get_field_out("modis_ctptau").get_view<Real***, Host>();
-  auto misr_cthtau  = get_field_out("misr_cthtau").get_view<Real***, Host>();
-  auto cosp_sunlit  = get_field_out("cosp_sunlit").get_view<Real*, Host>();  // Copy of sunlit flag with COSP frequency for proper averaging
-
-  // Compute heights
-  const auto z_mid = CospFunc::view_2d<Real>("z_mid", m_num_cols, m_num_levs);
-  const auto z_int = CospFunc::view_2d<Real>("z_int", m_num_cols, m_num_levs+1);
-  const auto dz = z_mid;  // reuse tmp memory for dz
+  //     avg(X) = sum(M * X) / sum(M) = (sum(M * X)/N) / (sum(M)/N) = avg(M * X) / avg(M)
+  //
+  // TODO: mask this when/if the AD ever supports masked averages
+  Kokkos::deep_copy(isccp_cldtot, 0.0);
+  Kokkos::deep_copy(isccp_ctptau, 0.0);
+  Kokkos::deep_copy(modis_ctptau, 0.0);
+  Kokkos::deep_copy(misr_cthtau, 0.0);
+
+  if (not update_cosp) {
+    Kokkos::deep_copy(cosp_sunlit, 0.0);
+    return;
+  }
+
+  // COSP only produces meaningful statistics for sunlit columns, so we only
+  // pass those to the Fortran simulator. Their inputs are packed on device, so
+  // that only one (small) copy to host is needed, rather than a sync of all input fields.
+  Kokkos::deep_copy(cosp_sunlit, sunlit);
+  const int nsun = pack_sunlit_inputs();
+  if (nsun==0) {
+    return;
+  }
+
+  const auto in_range  = std::make_pair(0,nsun*m_col_inputs_size);
+  const auto out_range = std::make_pair(0,nsun*m_col_outputs_size);
+  Kokkos::deep_copy(Kokkos::subview(m_inputs_host,in_range),Kokkos::subview(m_inputs_dev,in_range));
+
+  // Call COSP wrapper routines
+  Real emsfc_lw = 0.99;
+  CospFunc::main(nsun, m_num_subcols, m_num_levs, m_num_tau, m_num_ctp, m_num_cth,
+                 emsfc_lw, m_inputs_host.data(), m_outputs_host.data());
+
+  Kokkos::deep_copy(Kokkos::subview(m_outputs_dev,out_range),Kokkos::subview(m_outputs_host,out_range));
+  unpack_sunlit_outputs(nsun);
+}
+
+// =========================================================================================
+int Cosp::pack_sunlit_inputs ()
+{
+  using RangePolicy = Kokkos::RangePolicy<KT::ExeSpace>;
+
   const auto ncol = m_num_cols;
   const auto nlev = m_num_levs;
+
+  auto qv      = get_field_in("qv").get_view<const Real**>();
+  auto qc      = get_field_in("qc").get_view<const Real**>();
+  auto qi      = get_field_in("qi").get_view<const Real**>();
+  auto sunlit  = get_field_in("sunlit").get_view<const Real*>();
+  auto skt     = get_field_in("surf_radiative_T").get_view<const Real*>();
+  auto T_mid   = get_field_in("T_mid").get_view<const Real**>();
+  auto p_mid   = get_field_in("p_mid").get_view<const Real**>();
+  auto p_int   = get_field_in("p_int").get_view<const Real**>();
+  auto phis    = get_field_in("phis").get_view<const Real*>();
+  auto pseudo_density = get_field_in("pseudo_density").get_view<const Real**>();
+  auto cldfrac = get_field_in("cldfrac_rad").get_view<const Real**>();
+  auto reff_qc = get_field_in("eff_radius_qc").get_view<const Real**>();
+  auto reff_qi = get_field_in("eff_radius_qi").get_view<const Real**>();
+  auto dtau067 = get_field_in("dtau067").get_view<const Real**>();
+  auto dtau105 = get_field_in("dtau105").get_view<const Real**>();
+
+  // Find the sunlit columns
+  const auto sunlit_cols = m_sunlit_cols;
+  int nsun = 0;
+  Kokkos::parallel_scan("Cosp::find_sunlit_cols", RangePolicy(0,ncol),
+                        KOKKOS_LAMBDA(const int i, int& offset, const bool final) {
+    if (sunlit(i)!=0) {
+      if (final) {
+        sunlit_cols(offset) = i;
+      }
+      ++offset;
+    }
+  },nsun);
+  if (nsun==0) {
+    return 0;
+  }
+
+  // Compute heights of the sunlit columns
+  const auto z_mid = m_z_mid;
+  const auto z_int = m_z_int;
+  const auto dz = z_mid;  // reuse tmp memory for dz
   // calculate_z_int contains a team-level parallel_scan, which requires a special policy
-  // TODO: do this on device?
-  const auto scan_policy = ekat::ExeSpaceUtils<KTH::ExeSpace>::get_thread_range_parallel_scan_team_policy(ncol, nlev);
-  Kokkos::parallel_for(scan_policy, KOKKOS_LAMBDA (const KTH::MemberType& team) {
-      const int i = team.league_rank();
-      const auto dz_s    = ekat::subview(dz,    i);
+  const auto scan_policy = ekat::ExeSpaceUtils<KT::ExeSpace>::get_thread_range_parallel_scan_team_policy(nsun, nlev);
+  Kokkos::parallel_for(scan_policy, KOKKOS_LAMBDA (const KT::MemberType& team) {
+      const int s = team.league_rank();
+      const int i = sunlit_cols(s);
+      const auto dz_s    = ekat::subview(dz,    s);
       const auto p_mid_s = ekat::subview(p_mid, i);
       const auto T_mid_s = ekat::subview(T_mid, i);
       const auto qv_s = ekat::subview(qv, i);
-      const auto z_int_s = ekat::subview(z_int, i);
-      const auto z_mid_s = ekat::subview(z_mid, i);
+      const auto z_int_s = ekat::subview(z_int, s);
+      const auto z_mid_s = ekat::subview(z_mid, s);
       const Real z_surf  = phis(i) / 9.81;
       const auto pseudo_density_s = ekat::subview(pseudo_density, i);
       PF::calculate_dz(team, pseudo_density_s, p_mid_s, T_mid_s, qv_s, dz_s);
@@ -204,54 +260,74 @@ void Cosp::run_impl (const double dt)
       team.team_barrier();
   });
 
-  // Call COSP wrapper routines
-  if (update_cosp) {
-    Real emsfc_lw = 0.99;
-    Kokkos::deep_copy(cosp_sunlit, sunlit);
-    CospFunc::view_2d<const Real> z_mid_c = z_mid;  // Need a const version of z_mid for call to CospFunc::main
-    CospFunc::main(
-            m_num_cols, m_num_subcols, m_num_levs, m_num_tau, m_num_ctp, m_num_cth,
-            emsfc_lw, sunlit, skt, T_mid, p_mid, p_int, z_mid_c, qv, qc, qi,
-            cldfrac, reff_qc, reff_qi, dtau067, dtau105,
-            isccp_cldtot, isccp_ctptau, modis_ctptau, misr_cthtau
-    );
-    // Remask night values to ZERO since our I/O does not know how to handle masked/missing values
-    // in temporal averages; this is all host data, so we can just use host loops like its the 1980s
-    for (int i = 0; i < m_num_cols; i++) {
-        if (sunlit(i) == 0) {
-            isccp_cldtot(i) = 0;
-            for (int j = 0; j < m_num_tau; j++) {
-                for (int k = 0; k < m_num_ctp; k++) {
-                    isccp_ctptau(i,j,k) = 0;
-                    modis_ctptau(i,j,k) = 0;
-                }
-                for (int k = 0; k < m_num_cth; k++) {
-                    misr_cthtau (i,j,k) = 0;
-                }
-            }
-        }
+  // Pack the inputs of the sunlit columns, in the order expected by CospFunc::main,
+  // in Fortran order, so that each entry (s,k) of a var is stored at s+k*nsun
+  const auto in = m_inputs_dev;
+  const int nmid = nsun*nlev;
+  Kokkos::parallel_for("Cosp::pack_inputs", RangePolicy(0,nsun*(nlev+1)),
+                       KOKKOS_LAMBDA(const int idx) {
+    const int s = idx % nsun;
+    const int k = idx / nsun;
+    const int i = sunlit_cols(s);
+    if (k==0) {
+      in(s)      = sunlit(i);
+      in(nsun+s) = skt(i);
     }
-  } else {
-    // If not updating COSP statistics, set these to ZERO; this essentially weights
-    // the ISCCP cloud properties by the sunlit mask. What will be output for time-averages
-    // then is the time-average mask-weighted statistics; to get true averages, we need to
-    // divide by the time-average of the mask. I.e., if M is the sunlit mask, and X is the ISCCP
-    // statistic, then
-    //
-    //     avg(X) = sum(M * X) / sum(M) = (sum(M * X)/N) / (sum(M)/N) = avg(M * X) / avg(M)
-    //
-    // TODO: mask this when/if the AD ever supports masked averages
-    Kokkos::deep_copy(isccp_cldtot, 0.0);
-    Kokkos::deep_copy(isccp_ctptau, 0.0);
-    Kokkos::deep_copy(modis_ctptau, 0.0);
-    Kokkos::deep_copy(misr_cthtau, 0.0);
-    Kokkos::deep_copy(cosp_sunlit, 0.0);
-  }
-  get_field_out("isccp_cldtot").sync_to_dev();
-  get_field_out("isccp_ctptau").sync_to_dev();
-  get_field_out("modis_ctptau").sync_to_dev();
-  get_field_out("misr_cthtau").sync_to_dev();
-  get_field_out("cosp_sunlit").sync_to_dev();
+    if (k<nlev) {
+      auto mid = in.data() + 2*nsun + idx;
+      mid[ 0*nmid] = T_mid(i,k);
+      mid[ 1*nmid] = p_mid(i,k);
+      mid[ 2*nmid] = z_mid(s,k);
+      mid[ 3*nmid] = qv(i,k);
+      mid[ 4*nmid] = qc(i,k);
+      mid[ 5*nmid] = qi(i,k);
+      mid[ 6*nmid] = cldfrac(i,k);
+      mid[ 7*nmid] = reff_qc(i,k);
+      mid[ 8*nmid] = reff_qi(i,k);
+      mid[ 9*nmid] = dtau067(i,k);
+      mid[10*nmid] = dtau105(i,k);
+    }
+    in(2*nsun + 11*nmid + idx) = p_int(i,k);
+  });
+
+  return nsun;
+}
+
+// =========================================================================================
+void Cosp::unpack_sunlit_outputs (const int nsun)
+{
+  using RangePolicy = Kokkos::RangePolicy<KT::ExeSpace>;
+
+  auto isccp_cldtot = get_field_out("isccp_cldtot").get_view<Real*>();
+  auto isccp_ctptau = get_field_out("isccp_ctptau").get_view<Real***>();
+  auto modis_ctptau = get_field_out("modis_ctptau").get_view<Real***>();
+  auto misr_cthtau  = get_field_out("misr_cthtau").get_view<Real***>();
+
+  // Outputs are in Fortran order, so entry (s,j,k) of a var is stored at s+nsun*(j+ntau*k)
+  const auto sunlit_cols = m_sunlit_cols;
+  const auto out  = m_outputs_dev;
+  const int ntau  = m_num_tau;
+  const int nctp  = m_num_ctp;
+  const int ncth  = m_num_cth;
+  const int nk    = std::max(nctp,ncth);
+  const int ctptau_size = nsun*ntau*nctp;
+  Kokkos::parallel_for("Cosp::unpack_outputs", RangePolicy(0,nsun*ntau*nk),
+                       KOKKOS_LAMBDA(const int idx) {
+    const int s = idx % nsun;
+    const int j = (idx / nsun) % ntau;
+    const int k = idx / (nsun*ntau);
+    const int i = sunlit_cols(s);
+    if (j==0 and k==0) {
+      isccp_cldtot(i) = out(s);
+    }
+    if (k<nctp) {
+      isccp_ctptau(i,j,k) = out(nsun + idx);
+      modis_ctptau(i,j,k) = out(nsun + ctptau_size + idx);
+    }
+    if (k<ncth) {
+      misr_cthtau(i,j,k) = out(nsun + 2*ctptau_size + idx);
+    }
+  });
 }
 
 // =========================================================================================
@@ -20,10 +20,21 @@ class Cosp : public AtmosphereProcess
 {
 
 public:
-  using PF  = scream::PhysicsFunctions<HostDevice>;
+  using PF  = scream::PhysicsFunctions<DefaultDevice>;
   using KT  = KokkosTypes<DefaultDevice>;
   using KTH = KokkosTypes<HostDevice>;
 
+  // The packed inputs/outputs of COSP are moved between device and host
+  // with a single copy, through buffers in pinned host memory (if any)
+#if defined(KOKKOS_ENABLE_CUDA)
+  using pinned_space = Kokkos::CudaHostPinnedSpace;
+#elif defined(KOKKOS_ENABLE_HIP)
+  using pinned_space = Kokkos::HIPHostPinnedSpace;
+#else
+  using pinned_space = Kokkos::HostSpace;
+#endif
+  using view_1d_pinned = Kokkos::View<Real*,pinned_space>;
+
   // Constructors
   Cosp (const ekat::Comm& comm, const ekat::ParameterList& params);
 
@@ -58,6 +69,11 @@ protected:
 public:
 #endif
   void run_impl        (const double dt);
+
+  // Gather the sunlit columns, in Fortran order, into m_inputs_dev, and return their number
+  int pack_sunlit_inputs ();
+  // Scatter the COSP outputs of the sunlit columns from m_outputs_dev to the output fields
+  void unpack_sunlit_outputs (const int nsun);
 protected:
   void finalize_impl   ();
 
@@ -75,6 +91,20 @@ protected:
 
   std::shared_ptr<const AbstractGrid> m_grid;
 
+  // Number of inputs (outputs) per column in the packed buffers
+  int m_col_inputs_size;
+  int m_col_outputs_size;
+
+  // Device scratch for the heights, the indices of the sunlit columns, and
+  // the packed buffers of the sunlit columns (with their host counterparts)
+  KT::view_2d<Real>   m_z_mid;
+  KT::view_2d<Real>   m_z_int;
+  KT::view_1d<int>    m_sunlit_cols;
+  KT::view_1d<Real>   m_inputs_dev;
+  KT::view_1d<Real>   m_outputs_dev;
+  view_1d_pinned      m_inputs_host;
+  view_1d_pinned      m_outputs_host;
+
 }; // class Cosp
 
 } // namespace scream
@@ -86,6 +86,7 @@ void MAMMicrophysics::set_defaults_() {
 void MAMMicrophysics::configure(const ekat::ParameterList& params) {
   set_defaults_();
   // FIXME: implement "namelist" parsing
+  fused_column_kernel_ = params.get<bool>("fused_column_kernel", false);
 }
 
 void MAMMicrophysics::set_grids(const std::shared_ptr<const GridsManager> grids_manager) {
@@ -257,6 +258,9 @@ void MAMMicrophysics::initialize_impl(const RunType run_type) {
   preprocess_.initialize(ncol_, nlev_, wet_atm_, wet_aero_, dry_atm_, dry_aero_);
   postprocess_.initialize(ncol_, nlev_, wet_atm_, wet_aero_, dry_atm_, dry_aero_);
 
+  // per-column photolysis rates, allocated once and reused at every step
+  photo_rates_ = view_3d("photo_rates", ncol_, nlev_, mam4::mo_photo::phtcnt);
+
   // set field property checks for the fields in this process
   /* e.g.
   using Interval = FieldWithinIntervalCheck;
@@ -278,9 +282,17 @@ void MAMMicrophysics::run_impl(const double dt) {
   const auto scan_policy = ekat::ExeSpaceUtils<KT::ExeSpace>::get_thread_range_parallel_scan_team_policy(ncol_, nlev_);
   const auto policy      = ekat::ExeSpaceUtils<KT::ExeSpace>::get_default_team_policy(ncol_, nlev_);
 
+  // If the column kernel is fused, pre/postprocessing are done within the
+  // main kernel (which then runs with the scan policy), one team per column
+  const bool fused = fused_column_kernel_;
+  const auto preprocess  = preprocess_;
+  const auto postprocess = postprocess_;
+
   // preprocess input -- needs a scan for the calculation of atm height
-  Kokkos::parallel_for("preprocess", scan_policy, preprocess_);
-  Kokkos::fence();
+  if (not fused) {
+    Kokkos::parallel_for("preprocess", scan_policy, preprocess_);
+    Kokkos::fence();
+  }
 
   // reset internal WSM variables
   //workspace_mgr_.reset_internals();
@@ -289,8 +301,7 @@ void MAMMicrophysics::run_impl(const double dt) {
   double t = 0.0;
 
   // here's where we store per-column photolysis rates
-  using View2D = haero::DeviceType::view_2d<Real>;
-  View2D photo_rates("photo_rates", nlev_, mam4::mo_photo::phtcnt);
+  const auto photo_rates_all = photo_rates_;
 
   // climatology data for linear stratospheric chemistry
   auto linoz_o3_clim      = buffer_.scratch[0]; // ozone (climatology) [vmr]
@@ -319,9 +330,15 @@ void MAMMicrophysics::run_impl(const double dt) {
   // loop over atmosphere columns and compute aerosol microphyscs
   auto some_step = step_;
 
-  Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const ThreadTeam& team) {
+  Kokkos::parallel_for(fused ? scan_policy : policy, KOKKOS_LAMBDA(const ThreadTeam& team) {
     const int icol = team.league_rank(); // column index
 
+    if (fused) {
+      preprocess(team);
+    }
+
+    auto photo_rates = ekat::subview(photo_rates_all, icol);
+
     Real col_lat = col_latitudes(icol); // column latitude (degrees?)
 
     // fetch column-specific atmosphere state data
@@ -502,10 +519,17 @@ void MAMMicrophysics::run_impl(const double dt) {
       mam_coupling::convert_work_arrays_to_mmr(vmr, vmrcw, q, qqcw);
       mam_coupling::transfer_work_arrays_to_prognostics(q, qqcw, progs, k);
     });
+
+    if (fused) {
+      team.team_barrier();
+      postprocess(team);
+    }
   });
 
   // postprocess output
-  Kokkos::parallel_for("postprocess", policy, postprocess_);
+  if (not fused) {
+    Kokkos::parallel_for("postprocess", policy, postprocess_);
+  }
   Kokkos::fence();
 }
 
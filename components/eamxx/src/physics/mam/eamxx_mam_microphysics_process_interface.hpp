@@ -34,6 +34,7 @@ class MAMMicrophysics final : public scream::AtmosphereProcess {
   using view_1d_int   = typename KT::template view_1d<int>;
   using view_1d       = typename KT::template view_1d<Real>;
   using view_2d       = typename KT::template view_2d<Real>;
+  using view_3d       = typename KT::template view_3d<Real>;
   using const_view_1d = typename KT::template view_1d<const Real>;
   using const_view_2d = typename KT::template view_2d<const Real>;
 
@@ -207,6 +208,12 @@ private_except_cuda:
   // photolysis rate table (column-independent)
   mam4::mo_photo::PhotoTableData photo_table_;
 
+  // per-column photolysis rates (ncol, nlev, phtcnt)
+  view_3d photo_rates_;
+
+  // if true, pre/postprocessing and microphysics run in a single kernel
+  bool fused_column_kernel_;
+
   // column areas, latitudes, longitudes
   const_view_1d col_areas_, col_latitudes_, col_longitudes_;
 
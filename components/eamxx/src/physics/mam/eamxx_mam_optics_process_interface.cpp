@@ -340,6 +340,10 @@ void MAMOptics::initialize_impl(const RunType run_type) {
           aerosol_optics_device_data_.specrefindex_lw, "long_wave",
           specrefndxlw_host);
     }
+
+    // Now that all tables are read, move them into a single contiguous allocation
+    optics_tables_ = mam_coupling::pack_optics_tables(aerosol_optics_device_data_,
+                                                      ntot_amode);
   }
   //FIXME: We are hard-coding the band ordering in RRTMGP.
   //TODO: We can update optics file using the ordering below (rrtmg_to_rrtmgp_swbands_).
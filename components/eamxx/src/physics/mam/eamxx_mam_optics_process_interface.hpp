@@ -171,6 +171,8 @@ class MAMOptics final : public scream::AtmosphereProcess {
   // long wave extinction in the units of [1/km]
   mam_coupling::view_3d ext_cmip6_lw_;
   mam4::modal_aer_opt::AerosolOpticsDeviceData aerosol_optics_device_data_;
+  // Contiguous storage for all the lookup tables of aerosol_optics_device_data_
+  mam_coupling::view_1d optics_tables_;
   // physics grid for column information
   std::shared_ptr<const AbstractGrid> grid_;
   mam_coupling::view_2d work_;
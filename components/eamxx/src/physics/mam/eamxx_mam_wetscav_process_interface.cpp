@@ -17,6 +17,7 @@ MAMWetscav::MAMWetscav(const ekat::Comm &comm,
   /* Anything that can be initialized without grid information can be
    * initialized here. Like universal constants, mam wetscav options.
    */
+  fused_column_kernel_ = m_params.get<bool>("fused_column_kernel", false);
 }
 
 // ================================================================
@@ -412,10 +413,20 @@ void MAMWetscav::run_impl(const double dt) {
   const auto scan_policy = ekat::ExeSpaceUtils<
       KT::ExeSpace>::get_thread_range_parallel_scan_team_policy(ncol_, nlev_);
 
+  // If the column kernel is fused, pre/postprocessing are done within the
+  // main kernel, one team per column, which saves two kernel launches (and
+  // the round trips through global memory between them). Since the
+  // preprocess needs a scan, the whole kernel then runs with the scan policy.
+  const bool fused = fused_column_kernel_;
+  const auto preprocess  = preprocess_;
+  const auto postprocess = postprocess_;
+
   // preprocess input -- needs a scan for the calculation of all variables
   // needed by this process or setting up MAM4xx classes and their objects
-  Kokkos::parallel_for("preprocess", scan_policy, preprocess_);
-  Kokkos::fence();
+  if(not fused) {
+    Kokkos::parallel_for("preprocess", scan_policy, preprocess_);
+    Kokkos::fence();
+  }
 
   const mam_coupling::DryAtmosphere &dry_atm = dry_atm_;
   const auto &dry_aero                       = dry_aero_;
@@ -483,7 +494,9 @@ void MAMWetscav::run_impl(const double dt) {
   const auto wetdens = get_field_out("wetdens").get_view<Real ***>();
 
   const auto policy =
-      ekat::ExeSpaceUtils<KT::ExeSpace>::get_default_team_policy(ncol_, nlev_);
+      fused ? scan_policy
+            : ekat::ExeSpaceUtils<KT::ExeSpace>::get_default_team_policy(
+                  ncol_, nlev_);
 
   // Making a local copy of 'nlev_' because we cannot use a member of a class
   // inside a parallel_for.
@@ -502,6 +515,10 @@ void MAMWetscav::run_impl(const double dt) {
       policy, KOKKOS_LAMBDA(const ThreadTeam &team) {
         const int icol = team.league_rank();  // column index
 
+        if(fused) {
+          preprocess(team);
+        }
+
         const auto atm = mam_coupling::atmosphere_for_column(dry_atm, icol);
         // set surface state data
         // fetch column-specific subviews into aerosol prognostics
@@ -565,11 +582,18 @@ void MAMWetscav::run_impl(const double dt) {
             }
           }
         });  // parallel_for for update interstitial aerosol state
+
+        if(fused) {
+          team.team_barrier();
+          postprocess(team);
+        }
       });    // icol parallel_for loop
 
   // call post processing to convert dry mixing ratios to wet mixing ratios
   // and update the state
-  Kokkos::parallel_for("postprocess", scan_policy, postprocess_);
+  if(not fused) {
+    Kokkos::parallel_for("postprocess", scan_policy, postprocess_);
+  }
   Kokkos::fence();  // wait before returning to calling function
 }
 
@@ -150,6 +150,9 @@ class MAMWetscav : public scream::AtmosphereProcess {
   // Number of horizontal columns and vertical levels
   int ncol_, nlev_;
 
+  // If true, pre/postprocessing and wet deposition run in a single kernel
+  bool fused_column_kernel_;
+
   // Number of aerosol modes
   static constexpr int ntot_amode_ = mam4::AeroConfig::num_modes();
 
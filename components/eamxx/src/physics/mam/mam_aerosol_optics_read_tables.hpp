@@ -253,6 +253,52 @@ inline void read_rrtmg_table(
   }  // d5
 }
 
+// Pack all the (mode,band) lookup tables of the device data (refractive index
+// tables and Chebyshev coefficients) in a single contiguous device allocation.
+// The tables are stored mode by mode, band by band, and, for each (mode,band),
+// all the tables used by the lw/sw optics are next to each other, so that the
+// lookups done while evaluating a band hit nearby memory. Each table starts at an
+// offset aligned to 32 Reals. The views in the device data are reset to point into
+// the returned allocation, which must be kept alive as long as the device data is used.
+inline view_1d pack_optics_tables(AerosolOpticsDeviceData &data,
+                                  const int ntot_amode) {
+  constexpr size_t alignment = 32;
+  auto padded = [](const size_t n) {
+    return ((n + alignment - 1) / alignment) * alignment;
+  };
+
+  auto for_each_table = [&](auto &&func) {
+    for(int m = 0; m < ntot_amode; ++m) {
+      for(int b = 0; b < nswbands; ++b) {
+        func(data.refrtabsw[m][b]);
+        func(data.refitabsw[m][b]);
+        func(data.extpsw[m][b]);
+        func(data.abspsw[m][b]);
+        func(data.asmpsw[m][b]);
+      }
+      for(int b = 0; b < nlwbands; ++b) {
+        func(data.refrtablw[m][b]);
+        func(data.refitablw[m][b]);
+        func(data.absplw[m][b]);
+      }
+    }
+  };
+
+  size_t total_size = 0;
+  for_each_table([&](const auto &table) { total_size += padded(table.size()); });
+
+  view_1d storage("mam_optics_tables", total_size);
+  size_t offset = 0;
+  for_each_table([&](auto &table) {
+    using table_t = std::remove_reference_t<decltype(table)>;
+    table_t packed(storage.data() + offset, table.layout());
+    Kokkos::deep_copy(packed, table);
+    table = packed;
+    offset += padded(packed.size());
+  });
+  return storage;
+}
+
 inline void read_water_refindex(const std::string &table_filename,
                                 const std::shared_ptr<const AbstractGrid> &grid,
                                 const complex_view_1d &crefwlw,
@@ -6,7 +6,35 @@
 #include "share/property_checks/field_lower_bound_check.hpp"
 #include "share/property_checks/field_within_interval_check.hpp"
 
+#include <ekat/std_meta/ekat_std_utils.hpp>
+
 namespace scream {
+
+namespace {
+
+// Cosine of the solar zenith angle, using the approximations of Spencer (1971) for the
+// solar declination and the equation of time. The inputs are the fractional day of
+// the year (starting from 0), and latitude/longitude in degrees.
+KOKKOS_INLINE_FUNCTION
+Real cos_zenith_angle (const Real day_of_year, const Real lat, const Real lon)
+{
+  using PC = scream::physics::Constants<Real>;
+  const Real g = 2*PC::Pi*day_of_year/365;
+  const Real decl = 0.006918 - 0.399912*std::cos(g) + 0.070257*std::sin(g)
+                  - 0.006758*std::cos(2*g) + 0.000907*std::sin(2*g)
+                  - 0.002697*std::cos(3*g) + 0.00148*std::sin(3*g);
+  // Equation of time, in minutes
+  const Real eqtime = 229.18*(0.000075 + 0.001868*std::cos(g) - 0.032077*std::sin(g)
+                            - 0.014615*std::cos(2*g) - 0.040849*std::sin(2*g));
+  // True solar time (in minutes) and hour angle
+  const Real utc_minutes = (day_of_year - static_cast<int>(day_of_year))*1440;
+  const Real tst = utc_minutes + eqtime + 4*lon;
+  const Real ha  = (tst/4 - 180)*PC::Pi/180;
+  const Real phi = lat*PC::Pi/180;
+  return std::sin(phi)*std::sin(decl) + std::cos(phi)*std::cos(decl)*std::cos(ha);
+}
+
+} // anonymous namespace
 // =========================================================================================
 MLCorrection::MLCorrection(const ekat::Comm &comm,
                            const ekat::ParameterList &params)
@@ -16,6 +44,13 @@ MLCorrection::MLCorrection(const ekat::Comm &comm,
   m_ML_model_path_sfc_fluxes = m_params.get<std::string>("ML_model_path_sfc_fluxes");
   m_fields_ml_output_variables = m_params.get<std::vector<std::string>>("ML_output_fields");
   m_ML_correction_unit_test = m_params.get<bool>("ML_correction_unit_test");
+
+  const auto backend = m_params.get<std::string>("ML_inference_backend","python");
+  EKAT_REQUIRE_MSG (backend=="python" or backend=="native",
+      "Error! Invalid value for ML_inference_backend.\n"
+      " - value : " + backend + "\n"
+      " - valid : python, native\n");
+  m_use_native_inference = backend=="native";
 }
 
 // =========================================================================================
@@ -72,18 +107,64 @@ void MLCorrection::set_grids(
 
 // =========================================================================================
 void MLCorrection::initialize_impl(const RunType /* run_type */) {
-  fpe_mask = ekat::get_enabled_fpes();
-  ekat::disable_all_fpes();  // required for importing numpy  
-  if ( Py_IsInitialized() == 0 ) {
-    pybind11::initialize_interpreter();
+  if (m_use_native_inference) {
+    // Load the networks, and check that we can provide all their inputs/outputs
+    auto load = [&](const std::string& path) {
+      NativeModel nm;
+      if (path=="None" or path=="NONE") {
+        return nm;
+      }
+      auto model = std::make_shared<MLCorrectionMLP>(path);
+      const std::vector<std::string> cols_vars = {
+        "cos_zenith_angle", "lat", "surface_geopotential", "surface_diffused_shortwave_albedo",
+        "total_sky_downward_shortwave_flux_at_top_of_atmosphere",
+        "net_shortwave_sfc_flux_via_transmissivity",
+        "override_for_time_adjusted_total_sky_downward_longwave_flux_at_surface"
+      };
+      const std::vector<std::string> levs_vars = {
+        "T_mid", "qv", "U", "V", "dQ1", "dQ2", "dQu", "dQv", "dQxwind", "dQywind"
+      };
+      for (const auto& vars : {model->get_inputs(),model->get_outputs()}) {
+        for (const auto& var : vars) {
+          const bool is_levs = ekat::contains(levs_vars,var.name);
+          EKAT_REQUIRE_MSG (is_levs or ekat::contains(cols_vars,var.name),
+              "Error! Unsupported variable in MLCorrection network.\n"
+              " - file name: " + path + "\n"
+              " - variable : " + var.name + "\n");
+          EKAT_REQUIRE_MSG (var.size==(is_levs ? m_num_levs : 1),
+              "Error! Wrong size for variable in MLCorrection network.\n"
+              " - file name: " + path + "\n"
+              " - variable : " + var.name + "\n"
+              " - size     : " + std::to_string(var.size) + "\n");
+          EKAT_REQUIRE_MSG (not m_ML_correction_unit_test or is_levs,
+              "Error! Variable not available in MLCorrection unit test mode.\n"
+              " - file name: " + path + "\n"
+              " - variable : " + var.name + "\n");
+        }
+      }
+      nm.mlp = model;
+      nm.x = decltype(nm.x)("ml_x",m_num_cols,model->get_num_inputs());
+      nm.y = decltype(nm.y)("ml_y",m_num_cols,model->get_num_outputs());
+      return nm;
+    };
+    m_native_model_tq = load(m_ML_model_path_tq);
+    m_native_model_uv = load(m_ML_model_path_uv);
+    m_native_model_sfc_fluxes = load(m_ML_model_path_sfc_fluxes);
+    m_cos_zenith = decltype(m_cos_zenith)("cos_zenith",m_num_cols);
+  } else {
+    fpe_mask = ekat::get_enabled_fpes();
+    ekat::disable_all_fpes();  // required for importing numpy
+    if ( Py_IsInitialized() == 0 ) {
+      pybind11::initialize_interpreter();
+    }
+    pybind11::module sys = pybind11::module::import("sys");
+    sys.attr("path").attr("insert")(1, ML_CORRECTION_CUSTOM_PATH);
+    py_correction = pybind11::module::import("ml_correction");
+    ML_model_tq = py_correction.attr("get_ML_model")(m_ML_model_path_tq);
+    ML_model_uv = py_correction.attr("get_ML_model")(m_ML_model_path_uv);
+    ML_model_sfc_fluxes = py_correction.attr("get_ML_model")(m_ML_model_path_sfc_fluxes);
+    ekat::enable_fpes(fpe_mask);
   }
-  pybind11::module sys = pybind11::module::import("sys");
-  sys.attr("path").attr("insert")(1, ML_CORRECTION_CUSTOM_PATH);
-  py_correction = pybind11::module::import("ml_correction");
-  ML_model_tq = py_correction.attr("get_ML_model")(m_ML_model_path_tq);
-  ML_model_uv = py_correction.attr("get_ML_model")(m_ML_model_path_uv);
-  ML_model_sfc_fluxes = py_correction.attr("get_ML_model")(m_ML_model_path_sfc_fluxes);
-  ekat::enable_fpes(fpe_mask);
 
   // Enforce bounds on quantities adjusted by ML using Field Property Checks
   using LowerBound = FieldLowerBoundCheck;
@@ -98,66 +179,17 @@ void MLCorrection::initialize_impl(const RunType /* run_type */) {
 
 // =========================================================================================
 void MLCorrection::run_impl(const double dt) {
-  // use model time to infer solar zenith angle for the ML prediction
-  auto current_ts = timestamp();
-  std::string datetime_str = current_ts.get_date_string() + " " + current_ts.get_time_string();
-
-  const auto &phis            = get_field_in("phis").get_view<const Real *, Host>();
-  const auto &sfc_alb_dif_vis = get_field_in("sfc_alb_dif_vis").get_view<const Real *, Host>();  
-
-  const auto &qv              = get_field_out("qv").get_view<Real **, Host>();
-  const auto &T_mid           = get_field_out("T_mid").get_view<Real **, Host>();
-  const auto &SW_flux_dn      = get_field_out("SW_flux_dn").get_view<Real **, Host>();
-  const auto &sfc_flux_sw_net = get_field_out("sfc_flux_sw_net").get_view<Real *, Host>();
-  const auto &sfc_flux_lw_dn  = get_field_out("sfc_flux_lw_dn").get_view<Real *, Host>();
-  const auto &u               = get_field_out("horiz_winds").get_component(0).get_view<Real **, Host>();
-  const auto &v               = get_field_out("horiz_winds").get_component(1).get_view<Real **, Host>();
-
   // For precipitation adjustment we need to track the change in column integrated 'qv'
   // So we clone the original qv before ML changes the state so we can back out a qv_tend
   // to use with precip adjustment.
   auto qv_src = get_field_in("qv");
   auto qv_in = qv_src.clone();
 
-  auto h_lat  = m_lat.get_view<const Real*,Host>();
-  auto h_lon  = m_lon.get_view<const Real*,Host>();
-
-  const auto& tracers = get_group_out("tracers");
-  const auto& tracers_info = tracers.m_info;
-  Int num_tracers = tracers_info->size();
-
-  ekat::disable_all_fpes();  // required for importing numpy
-  if ( Py_IsInitialized() == 0 ) {
-    pybind11::initialize_interpreter();
+  if (m_use_native_inference) {
+    run_native(dt);
+  } else {
+    run_python(dt);
   }
-  // for qv, we need to stride across number of tracers
-  pybind11::object ob1     = py_correction.attr("update_fields")(
-      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
-          m_num_cols * m_num_levs, T_mid.data(), pybind11::str{}),
-      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
-          m_num_cols * m_num_levs * num_tracers, qv.data(), pybind11::str{}),          
-      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
-          m_num_cols * m_num_levs, u.data(), pybind11::str{}),        
-      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
-          m_num_cols * m_num_levs, v.data(), pybind11::str{}),       
-      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
-          m_num_cols, h_lat.data(), pybind11::str{}),       
-      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
-          m_num_cols, h_lon.data(), pybind11::str{}),
-      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
-          m_num_cols, phis.data(), pybind11::str{}),   
-      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
-          m_num_cols * (m_num_levs+1), SW_flux_dn.data(), pybind11::str{}),
-      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
-          m_num_cols, sfc_alb_dif_vis.data(), pybind11::str{}),
-      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
-          m_num_cols, sfc_flux_sw_net.data(), pybind11::str{}),   
-      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
-          m_num_cols, sfc_flux_lw_dn.data(), pybind11::str{}),                                                                                                   
-      m_num_cols, m_num_levs, num_tracers, dt, 
-      ML_model_tq, ML_model_uv, ML_model_sfc_fluxes, datetime_str);
-  pybind11::gil_scoped_release no_gil;  
-  ekat::enable_fpes(fpe_mask);   
 
   // Now back out the qv change abd apply it to precipitation, only if Tq ML is turned on
   if (m_ML_model_path_tq != "None") {
@@ -168,6 +200,7 @@ void MLCorrection::run_impl(const double dt) {
     const auto &pseudo_density       = get_field_in("pseudo_density").get_view<const Real**>();
     const auto &precip_liq_surf_mass = get_field_out("precip_liq_surf_mass").get_view<Real *>();
     const auto &precip_ice_surf_mass = get_field_out("precip_ice_surf_mass").get_view<Real *>();
+    const auto &T_mid                = get_field_in("T_mid").get_view<const Real**>();
     constexpr Real g = PC::gravit;
     const auto num_levs = m_num_levs;
     const auto policy = ESU::get_default_team_policy(m_num_cols, m_num_levs);
@@ -227,6 +260,181 @@ void MLCorrection::run_impl(const double dt) {
   }
 }
 
+// =========================================================================================
+void MLCorrection::run_python(const double dt) {
+  // use model time to infer solar zenith angle for the ML prediction
+  auto current_ts = timestamp();
+  std::string datetime_str = current_ts.get_date_string() + " " + current_ts.get_time_string();
+
+  const auto &phis            = get_field_in("phis").get_view<const Real *, Host>();
+  const auto &sfc_alb_dif_vis = get_field_in("sfc_alb_dif_vis").get_view<const Real *, Host>();  
+
+  const auto &qv              = get_field_out("qv").get_view<Real **, Host>();
+  const auto &T_mid           = get_field_out("T_mid").get_view<Real **, Host>();
+  const auto &SW_flux_dn      = get_field_out("SW_flux_dn").get_view<Real **, Host>();
+  const auto &sfc_flux_sw_net = get_field_out("sfc_flux_sw_net").get_view<Real *, Host>();
+  const auto &sfc_flux_lw_dn  = get_field_out("sfc_flux_lw_dn").get_view<Real *, Host>();
+  const auto &u               = get_field_out("horiz_winds").get_component(0).get_view<Real **, Host>();
+  const auto &v               = get_field_out("horiz_winds").get_component(1).get_view<Real **, Host>();
+
+  auto h_lat  = m_lat.get_view<const Real*,Host>();
+  auto h_lon  = m_lon.get_view<const Real*,Host>();
+
+  const auto& tracers = get_group_out("tracers");
+  const auto& tracers_info = tracers.m_info;
+  Int num_tracers = tracers_info->size();
+
+  ekat::disable_all_fpes();  // required for importing numpy
+  if ( Py_IsInitialized() == 0 ) {
+    pybind11::initialize_interpreter();
+  }
+  // for qv, we need to stride across number of tracers
+  pybind11::object ob1     = py_correction.attr("update_fields")(
+      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
+          m_num_cols * m_num_levs, T_mid.data(), pybind11::str{}),
+      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
+          m_num_cols * m_num_levs * num_tracers, qv.data(), pybind11::str{}),          
+      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
+          m_num_cols * m_num_levs, u.data(), pybind11::str{}),        
+      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
+          m_num_cols * m_num_levs, v.data(), pybind11::str{}),       
+      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
+          m_num_cols, h_lat.data(), pybind11::str{}),       
+      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
+          m_num_cols, h_lon.data(), pybind11::str{}),
+      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
+          m_num_cols, phis.data(), pybind11::str{}),   
+      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
+          m_num_cols * (m_num_levs+1), SW_flux_dn.data(), pybind11::str{}),
+      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
+          m_num_cols, sfc_alb_dif_vis.data(), pybind11::str{}),
+      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
+          m_num_cols, sfc_flux_sw_net.data(), pybind11::str{}),   
+      pybind11::array_t<Real, pybind11::array::c_style | pybind11::array::forcecast>(
+          m_num_cols, sfc_flux_lw_dn.data(), pybind11::str{}),                                                                                                   
+      m_num_cols, m_num_levs, num_tracers, dt, 
+      ML_model_tq, ML_model_uv, ML_model_sfc_fluxes, datetime_str);
+  pybind11::gil_scoped_release no_gil;  
+  ekat::enable_fpes(fpe_mask);   
+}
+
+// =========================================================================================
+void MLCorrection::run_native(const double dt) {
+  if (not m_ML_correction_unit_test) {
+    const Real day_of_year = timestamp().frac_of_year_in_days();
+    const auto lat = m_lat.get_view<const Real*>();
+    const auto lon = m_lon.get_view<const Real*>();
+    const auto cos_zenith = m_cos_zenith;
+    Kokkos::parallel_for("MLCorrection::cos_zenith",
+                         Kokkos::RangePolicy<KokkosTypes<DefaultDevice>::ExeSpace>(0,m_num_cols),
+                         KOKKOS_LAMBDA(const int icol) {
+      cos_zenith(icol) = cos_zenith_angle(day_of_year,lat(icol),lon(icol));
+    });
+  }
+
+  // Apply the models in the same order as the Python module, so that each model
+  // sees the state already corrected by the previous ones
+  for (auto nm : {m_native_model_tq, m_native_model_uv, m_native_model_sfc_fluxes}) {
+    if (nm.mlp) {
+      run_native_model(*nm.mlp,nm.x,nm.y,dt);
+    }
+  }
+}
+
+// =========================================================================================
+void MLCorrection::run_native_model(MLCorrectionMLP& model,
+                                    const MLCorrectionMLP::view_2d<Real>& x,
+                                    const MLCorrectionMLP::view_2d<Real>& y,
+                                    const double dt)
+{
+  using view_1d  = MLCorrectionMLP::view_1d<Real>;
+  using view_2d  = MLCorrectionMLP::view_2d<Real>;
+  using cview_1d = MLCorrectionMLP::view_1d<const Real>;
+  using cview_2d = MLCorrectionMLP::view_2d<const Real>;
+  using RangePolicy = Kokkos::RangePolicy<KokkosTypes<DefaultDevice>::ExeSpace>;
+
+  const int ncols = m_num_cols;
+  const auto T_mid = get_field_out("T_mid").get_view<Real **>();
+  const auto qv    = get_field_out("qv").get_view<Real **>();
+  const auto u     = get_field_out("horiz_winds").get_component(0).get_view<Real **>();
+  const auto v     = get_field_out("horiz_winds").get_component(1).get_view<Real **>();
+
+  // Gather inputs. Each input is copied from either a (ncols,nlevs) or a (ncols) view.
+  // The TOA downward SW flux is the first entry of the (ncols,nlevs+1) SW_flux_dn.
+  for (const auto& var : model.get_inputs()) {
+    cview_2d src2d;
+    cview_1d src1d;
+    if (var.name=="T_mid") {
+      src2d = T_mid;
+    } else if (var.name=="qv") {
+      src2d = qv;
+    } else if (var.name=="U") {
+      src2d = u;
+    } else if (var.name=="V") {
+      src2d = v;
+    } else if (var.name=="cos_zenith_angle") {
+      src1d = m_cos_zenith;
+    } else if (var.name=="lat") {
+      src1d = m_lat.get_view<const Real*>();
+    } else if (var.name=="surface_geopotential") {
+      src1d = get_field_in("phis").get_view<const Real*>();
+    } else if (var.name=="surface_diffused_shortwave_albedo") {
+      src1d = get_field_in("sfc_alb_dif_vis").get_view<const Real*>();
+    } else if (var.name=="total_sky_downward_shortwave_flux_at_top_of_atmosphere") {
+      src2d = get_field_in("SW_flux_dn").get_view<const Real**>();
+    } else {
+      EKAT_ERROR_MSG ("Error! Unsupported input for MLCorrection native model: " + var.name + "\n");
+    }
+    const int n = var.size;
+    const int offset = var.offset;
+    const bool use_1d = src1d.size()>0;
+    Kokkos::parallel_for("MLCorrection::gather_inputs",RangePolicy(0,ncols*n),
+                         KOKKOS_LAMBDA(const int idx) {
+      const int icol = idx / n;
+      const int k    = idx % n;
+      x(icol,offset+k) = use_1d ? src1d(icol) : src2d(icol,k);
+    });
+  }
+
+  model.evaluate(x,y);
+
+  // Scatter outputs. Tendencies are applied to the state over dt, while the
+  // surface fluxes are overridden.
+  const Real dt_real = dt;
+  for (const auto& var : model.get_outputs()) {
+    view_2d dst2d;
+    view_1d dst1d;
+    if (var.name=="dQ1") {
+      dst2d = T_mid;
+    } else if (var.name=="dQ2") {
+      dst2d = qv;
+    } else if (var.name=="dQu" or var.name=="dQxwind") {
+      dst2d = u;
+    } else if (var.name=="dQv" or var.name=="dQywind") {
+      dst2d = v;
+    } else if (var.name=="net_shortwave_sfc_flux_via_transmissivity") {
+      dst1d = get_field_out("sfc_flux_sw_net").get_view<Real*>();
+    } else if (var.name=="override_for_time_adjusted_total_sky_downward_longwave_flux_at_surface") {
+      dst1d = get_field_out("sfc_flux_lw_dn").get_view<Real*>();
+    } else {
+      EKAT_ERROR_MSG ("Error! Unsupported output for MLCorrection native model: " + var.name + "\n");
+    }
+    const int n = var.size;
+    const int offset = var.offset;
+    const bool use_1d = dst1d.size()>0;
+    Kokkos::parallel_for("MLCorrection::scatter_outputs",RangePolicy(0,ncols*n),
+                         KOKKOS_LAMBDA(const int idx) {
+      const int icol = idx / n;
+      const int k    = idx % n;
+      if (use_1d) {
+        dst1d(icol) = y(icol,offset);
+      } else {
+        dst2d(icol,k) += dt_real*y(icol,offset+k);
+      }
+    });
+  }
+}
+
 // =========================================================================================
 void MLCorrection::finalize_impl() {
   // Do nothing
@@ -16,6 +16,7 @@
 #include "share/grid/mesh_free_grids_manager.hpp"
 #include "share/grid/point_grid.hpp"
 #include "share/util/scream_time_stamp.hpp"
+#include "ml_correction_mlp.hpp"
 
 namespace scream {
 
@@ -49,6 +50,28 @@ class MLCorrection : public AtmosphereProcess {
   void finalize_impl();
   void apply_tendency(Field& base, const Field& next, const int dt);
 
+  // Run the ML models via the Python module
+  void run_python(const double dt);
+
+#ifndef KOKKOS_ENABLE_CUDA
+  // Cuda requires methods enclosing __device__ lambda's to be public
+protected:
+#endif
+  // Run the ML models with the native evaluator, directly on device views
+  void run_native(const double dt);
+  void run_native_model(MLCorrectionMLP& model,
+                        const MLCorrectionMLP::view_2d<Real>& x,
+                        const MLCorrectionMLP::view_2d<Real>& y,
+                        const double dt);
+protected:
+
+  // A network for the native evaluator, with its input/output buffers
+  struct NativeModel {
+    std::shared_ptr<MLCorrectionMLP> mlp;
+    MLCorrectionMLP::view_2d<Real>   x;
+    MLCorrectionMLP::view_2d<Real>   y;
+  };
+
   std::shared_ptr<const AbstractGrid>   m_grid;
   // Keep track of field dimensions and the iteration count
   Int m_num_cols;
@@ -60,10 +83,15 @@ class MLCorrection : public AtmosphereProcess {
   std::string m_ML_model_path_sfc_fluxes;
   std::vector<std::string> m_fields_ml_output_variables;
   bool m_ML_correction_unit_test;
+  bool m_use_native_inference;
   pybind11::module py_correction;
   pybind11::object ML_model_tq;
   pybind11::object ML_model_uv;
   pybind11::object ML_model_sfc_fluxes;
+  NativeModel m_native_model_tq;
+  NativeModel m_native_model_uv;
+  NativeModel m_native_model_sfc_fluxes;
+  MLCorrectionMLP::view_1d<Real> m_cos_zenith;
   int fpe_mask;
 };  // class MLCorrection
 
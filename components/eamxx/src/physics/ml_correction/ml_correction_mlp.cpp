@@ -0,0 +1,221 @@
+#include "ml_correction_mlp.hpp"
+
+#include "ekat/ekat_assert.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+namespace scream {
+
+namespace {
+
+// Read a keyword from the stream, checking it matches the expected one
+void read_keyword (std::istream& is, const std::string& expected, const std::string& filename)
+{
+  std::string kw;
+  is >> kw;
+  EKAT_REQUIRE_MSG (is.good() and kw==expected,
+      "Error! Unexpected content in MLCorrection network file.\n"
+      " - file name: " + filename + "\n"
+      " - expected : " + expected + "\n"
+      " - found    : " + kw + "\n");
+}
+
+// Read n values from the stream into a newly allocated device view
+template<typename ViewT>
+ViewT read_values (std::istream& is, const std::string& name, const int n,
+                   const std::string& filename)
+{
+  ViewT v (name,n);
+  auto v_h = Kokkos::create_mirror_view(v);
+  for (int i=0; i<n; ++i) {
+    is >> v_h(i);
+  }
+  EKAT_REQUIRE_MSG (not is.fail(),
+      "Error! Could not read values from MLCorrection network file.\n"
+      " - file name: " + filename + "\n"
+      " - values   : " + name + "\n");
+  Kokkos::deep_copy(v,v_h);
+  return v;
+}
+
+std::vector<MLCorrectionMLP::Variable>
+read_variables (std::istream& is, const std::string& kw, const std::string& filename)
+{
+  int n;
+  read_keyword(is,kw,filename);
+  is >> n;
+  std::vector<MLCorrectionMLP::Variable> vars(n);
+  int offset = 0;
+  for (auto& var : vars) {
+    is >> var.name >> var.size;
+    EKAT_REQUIRE_MSG (not is.fail() and var.size>0,
+        "Error! Invalid variable in MLCorrection network file.\n"
+        " - file name: " + filename + "\n"
+        " - section  : " + kw + "\n");
+    var.offset = offset;
+    offset += var.size;
+  }
+  return vars;
+}
+
+} // anonymous namespace
+
+MLCorrectionMLP::MLCorrectionMLP (const std::string& filename)
+{
+  std::ifstream ifs (filename);
+  EKAT_REQUIRE_MSG (ifs.good(),
+      "Error! Could not open MLCorrection network file.\n"
+      " - file name: " + filename + "\n");
+
+  read_keyword(ifs,"mlp_v1",filename);
+
+  m_inputs  = read_variables(ifs,"inputs",filename);
+  m_outputs = read_variables(ifs,"outputs",filename);
+  for (const auto& v : m_inputs) {
+    m_num_inputs += v.size;
+  }
+  for (const auto& v : m_outputs) {
+    m_num_outputs += v.size;
+  }
+
+  int nlayers;
+  read_keyword(ifs,"layers",filename);
+  ifs >> nlayers;
+  EKAT_REQUIRE_MSG (nlayers>0,
+      "Error! MLCorrection network must have at least one layer.\n"
+      " - file name: " + filename + "\n");
+
+  int nin_expected = m_num_inputs;
+  for (int l=0; l<nlayers; ++l) {
+    auto& layer = m_layers.emplace_back();
+    std::string act;
+    ifs >> layer.nin >> layer.nout >> act;
+    EKAT_REQUIRE_MSG (layer.nin==nin_expected and layer.nout>0,
+        "Error! Inconsistent layer sizes in MLCorrection network file.\n"
+        " - file name   : " + filename + "\n"
+        " - layer       : " + std::to_string(l) + "\n"
+        " - expected nin: " + std::to_string(nin_expected) + "\n"
+        " - nin         : " + std::to_string(layer.nin) + "\n");
+    if (act=="linear") {
+      layer.activation = Activation::Linear;
+    } else if (act=="relu") {
+      layer.activation = Activation::ReLU;
+    } else if (act=="tanh") {
+      layer.activation = Activation::Tanh;
+    } else {
+      EKAT_ERROR_MSG ("Error! Unsupported activation in MLCorrection network file.\n"
+                      " - file name : " + filename + "\n"
+                      " - activation: " + act + "\n"
+                      " - supported : linear, relu, tanh\n");
+    }
+
+    layer.W = view_2d<Real>("W",layer.nout,layer.nin);
+    auto W_h = Kokkos::create_mirror_view(layer.W);
+    for (int o=0; o<layer.nout; ++o) {
+      for (int i=0; i<layer.nin; ++i) {
+        ifs >> W_h(o,i);
+      }
+    }
+    Kokkos::deep_copy(layer.W,W_h);
+    layer.b = read_values<view_1d<Real>>(ifs,"b",layer.nout,filename);
+
+    m_max_width = std::max(m_max_width,layer.nout);
+    nin_expected = layer.nout;
+  }
+  EKAT_REQUIRE_MSG (nin_expected==m_num_outputs,
+      "Error! The last layer of the MLCorrection network does not match the outputs size.\n"
+      " - file name   : " + filename + "\n"
+      " - outputs size: " + std::to_string(m_num_outputs) + "\n"
+      " - last layer  : " + std::to_string(nin_expected) + "\n");
+  m_max_width = std::max(m_max_width,m_num_inputs);
+
+  read_keyword(ifs,"input_mean",filename);
+  m_input_mean  = read_values<view_1d<Real>>(ifs,"input_mean",m_num_inputs,filename);
+  read_keyword(ifs,"input_std",filename);
+  m_input_std   = read_values<view_1d<Real>>(ifs,"input_std",m_num_inputs,filename);
+  read_keyword(ifs,"output_mean",filename);
+  m_output_mean = read_values<view_1d<Real>>(ifs,"output_mean",m_num_outputs,filename);
+  read_keyword(ifs,"output_std",filename);
+  m_output_std  = read_values<view_1d<Real>>(ifs,"output_std",m_num_outputs,filename);
+}
+
+void MLCorrectionMLP::
+evaluate (const view_2d<const Real>& x, const view_2d<Real>& y)
+{
+  const int ncols = x.extent(0);
+  EKAT_REQUIRE_MSG (x.extent_int(1)==m_num_inputs and y.extent_int(1)==m_num_outputs and
+                    y.extent_int(0)==ncols,
+      "Error! Invalid input/output views for MLCorrectionMLP::evaluate.\n");
+
+  if (m_buf0.extent_int(0)!=ncols) {
+    m_buf0 = view_2d<Real>("mlp_buf0",ncols,m_max_width);
+    m_buf1 = view_2d<Real>("mlp_buf1",ncols,m_max_width);
+  }
+
+  using RangePolicy = Kokkos::RangePolicy<typename KT::ExeSpace>;
+
+  // Normalize inputs
+  const auto nin  = m_num_inputs;
+  const auto mean = m_input_mean;
+  const auto sdev = m_input_std;
+  const auto buf0 = m_buf0;
+  Kokkos::parallel_for("MLCorrectionMLP::normalize",RangePolicy(0,ncols*nin),
+                       KOKKOS_LAMBDA(const int idx) {
+    const int icol = idx / nin;
+    const int j    = idx % nin;
+    buf0(icol,j) = (x(icol,j)-mean(j)) / sdev(j);
+  });
+
+  // Apply layers, ping-ponging between the two buffers
+  auto in  = m_buf0;
+  auto out = m_buf1;
+  for (const auto& layer : m_layers) {
+    apply_layer(layer,in,out);
+    std::swap(in,out);
+  }
+
+  // Denormalize outputs
+  const auto nout     = m_num_outputs;
+  const auto out_mean = m_output_mean;
+  const auto out_std  = m_output_std;
+  const auto res      = in;
+  Kokkos::parallel_for("MLCorrectionMLP::denormalize",RangePolicy(0,ncols*nout),
+                       KOKKOS_LAMBDA(const int idx) {
+    const int icol = idx / nout;
+    const int j    = idx % nout;
+    y(icol,j) = res(icol,j)*out_std(j) + out_mean(j);
+  });
+}
+
+void MLCorrectionMLP::
+apply_layer (const Layer& layer,
+             const view_2d<const Real>& in,
+             const view_2d<Real>& out) const
+{
+  using RangePolicy = Kokkos::RangePolicy<typename KT::ExeSpace>;
+
+  const int ncols = in.extent(0);
+  const int nin   = layer.nin;
+  const int nout  = layer.nout;
+  const auto act  = layer.activation;
+  const auto W    = layer.W;
+  const auto b    = layer.b;
+  Kokkos::parallel_for("MLCorrectionMLP::apply_layer",RangePolicy(0,ncols*nout),
+                       KOKKOS_LAMBDA(const int idx) {
+    const int icol = idx / nout;
+    const int o    = idx % nout;
+    Real val = b(o);
+    for (int i=0; i<nin; ++i) {
+      val += W(o,i)*in(icol,i);
+    }
+    switch (act) {
+      case Activation::ReLU: val = val>0 ? val : 0; break;
+      case Activation::Tanh: val = std::tanh(val); break;
+      default: break;
+    }
+    out(icol,o) = val;
+  });
+}
+
+} // namespace scream
@@ -0,0 +1,106 @@
+#ifndef SCREAM_ML_CORRECTION_MLP_HPP
+#define SCREAM_ML_CORRECTION_MLP_HPP
+
+#include "share/scream_types.hpp"
+
+#include <string>
+#include <vector>
+
+namespace scream {
+
+/*
+ * A native evaluator for (small) dense feed-forward neural networks
+ *
+ * This class allows to run the ML correction models directly on device views,
+ * batched over all columns, without any Python round trip. The network is read
+ * from a text file, containing (white space separated)
+ *
+ *   mlp_v1
+ *   inputs <n>
+ *   <name> <size>        (n lines)
+ *   outputs <m>
+ *   <name> <size>        (m lines)
+ *   layers <l>
+ *   <nin> <nout> <activation>
+ *   <W(0,0) ... W(0,nin-1) ... W(nout-1,nin-1)>
+ *   <b(0) ... b(nout-1)>
+ *   ...                  (l layers)
+ *   input_mean  <values>
+ *   input_std   <values>
+ *   output_mean <values>
+ *   output_std  <values>
+ *
+ * The input (output) vector of each column is the concatenation of the input (output)
+ * variables, in the order they are listed. Inputs are normalized as (x-mean)/std before
+ * entering the first layer, while outputs are denormalized as y*std+mean after the last
+ * layer. Supported activations are: linear, relu, tanh.
+ */
+
+class MLCorrectionMLP {
+public:
+  using KT = KokkosTypes<DefaultDevice>;
+  template<typename T>
+  using view_1d = typename KT::template view_1d<T>;
+  template<typename T>
+  using view_2d = typename KT::template view_2d<T>;
+
+  enum class Activation {
+    Linear,
+    ReLU,
+    Tanh
+  };
+
+  struct Variable {
+    std::string name;
+    int         size;
+    int         offset;   // Offset in the input/output vector
+  };
+
+  MLCorrectionMLP (const std::string& filename);
+
+  const std::vector<Variable>& get_inputs  () const { return m_inputs; }
+  const std::vector<Variable>& get_outputs () const { return m_outputs; }
+  int get_num_inputs  () const { return m_num_inputs; }
+  int get_num_outputs () const { return m_num_outputs; }
+
+  // Evaluate the network on each column.
+  //  - x: the raw (not normalized) inputs, with layout (ncols,num_inputs)
+  //  - y: the (denormalized) outputs, with layout (ncols,num_outputs)
+  void evaluate (const view_2d<const Real>& x, const view_2d<Real>& y);
+
+#ifndef KOKKOS_ENABLE_CUDA
+  // Cuda requires methods enclosing __device__ lambda's to be public
+protected:
+#endif
+  struct Layer {
+    int              nin;
+    int              nout;
+    Activation       activation;
+    view_2d<Real>    W;   // (nout,nin)
+    view_1d<Real>    b;   // (nout)
+  };
+
+  void apply_layer (const Layer& layer,
+                    const view_2d<const Real>& in,
+                    const view_2d<Real>& out) const;
+
+  std::vector<Variable>   m_inputs;
+  std::vector<Variable>   m_outputs;
+  std::vector<Layer>      m_layers;
+  int                     m_num_inputs  = 0;
+  int                     m_num_outputs = 0;
+  int                     m_max_width   = 0;
+
+  view_1d<Real>   m_input_mean;
+  view_1d<Real>   m_input_std;
+  view_1d<Real>   m_output_mean;
+  view_1d<Real>   m_output_std;
+
+  // Buffers for the hidden layers, (re)allocated if the number of columns changes
+  view_2d<Real>   m_buf0;
+  view_2d<Real>   m_buf1;
+};
+
+} // namespace scream
+
+#endif // SCREAM_ML_CORRECTION_MLP_HPP
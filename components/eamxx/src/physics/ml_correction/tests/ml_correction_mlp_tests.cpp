@@ -0,0 +1,106 @@
+#include "catch2/catch.hpp"
+
+#include "physics/ml_correction/ml_correction_mlp.hpp"
+
+#include <cmath>
+#include <fstream>
+
+namespace scream {
+
+TEST_CASE("ml_correction_mlp", "[ml_correction]")
+{
+  // A network with inputs (a,b), of sizes 2 and 1, a tanh hidden layer of width 2,
+  // a relu hidden layer of width 3, and a linear output layer, for the output y of size 2
+  const std::string filename = "ml_correction_mlp_test.txt";
+  {
+    std::ofstream ofs(filename);
+    ofs << "mlp_v1\n"
+        << "inputs 2\n"
+        << "a 2\n"
+        << "b 1\n"
+        << "outputs 1\n"
+        << "y 2\n"
+        << "layers 3\n"
+        << "3 2 tanh\n"
+        << "0.5 -0.25 1.0\n"
+        << "-1.0 0.75 0.5\n"
+        << "0.1 -0.2\n"
+        << "2 3 relu\n"
+        << "1.0 -1.0\n"
+        << "-1.0 1.0\n"
+        << "0.5 0.5\n"
+        << "0.0 0.1 -0.1\n"
+        << "3 2 linear\n"
+        << "1.0 2.0 3.0\n"
+        << "-1.0 0.5 0.25\n"
+        << "0.01 -0.02\n"
+        << "input_mean 1.0 2.0 3.0\n"
+        << "input_std 2.0 4.0 0.5\n"
+        << "output_mean 10.0 -10.0\n"
+        << "output_std 3.0 0.1\n";
+  }
+
+  MLCorrectionMLP mlp(filename);
+  REQUIRE (mlp.get_num_inputs()==3);
+  REQUIRE (mlp.get_num_outputs()==2);
+  REQUIRE (mlp.get_inputs().size()==2);
+  REQUIRE (mlp.get_inputs()[1].name=="b");
+  REQUIRE (mlp.get_inputs()[1].offset==2);
+
+  const int ncols = 5;
+  MLCorrectionMLP::view_2d<Real> x("x",ncols,3), y("y",ncols,2);
+  auto x_h = Kokkos::create_mirror_view(x);
+  for (int icol=0; icol<ncols; ++icol) {
+    for (int j=0; j<3; ++j) {
+      x_h(icol,j) = 0.3*icol - 0.7*j + 1;
+    }
+  }
+  Kokkos::deep_copy(x,x_h);
+
+  mlp.evaluate(x,y);
+  auto y_h = Kokkos::create_mirror_view(y);
+  Kokkos::deep_copy(y_h,y);
+
+  // Compute the expected result on host
+  const Real W0[2][3] = {{0.5,-0.25,1.0},{-1.0,0.75,0.5}};
+  const Real b0[2]    = {0.1,-0.2};
+  const Real W1[3][2] = {{1.0,-1.0},{-1.0,1.0},{0.5,0.5}};
+  const Real b1[3]    = {0.0,0.1,-0.1};
+  const Real W2[2][3] = {{1.0,2.0,3.0},{-1.0,0.5,0.25}};
+  const Real b2[2]    = {0.01,-0.02};
+  const Real in_mean[3]  = {1.0,2.0,3.0};
+  const Real in_std[3]   = {2.0,4.0,0.5};
+  const Real out_mean[2] = {10.0,-10.0};
+  const Real out_std[2]  = {3.0,0.1};
+  const Real tol = std::is_same<Real,float>::value ? 1e-5 : 1e-12;
+  for (int icol=0; icol<ncols; ++icol) {
+    Real z0[3], z1[2], z2[3];
+    for (int j=0; j<3; ++j) {
+      z0[j] = (x_h(icol,j)-in_mean[j])/in_std[j];
+    }
+    for (int o=0; o<2; ++o) {
+      z1[o] = b0[o];
+      for (int i=0; i<3; ++i) {
+        z1[o] += W0[o][i]*z0[i];
+      }
+      z1[o] = std::tanh(z1[o]);
+    }
+    for (int o=0; o<3; ++o) {
+      z2[o] = b1[o];
+      for (int i=0; i<2; ++i) {
+        z2[o] += W1[o][i]*z1[i];
+      }
+      z2[o] = std::max(z2[o],Real(0));
+    }
+    for (int o=0; o<2; ++o) {
+      Real val = b2[o];
+      for (int i=0; i<3; ++i) {
+        val += W2[o][i]*z2[i];
+      }
+      val = val*out_std[o] + out_mean[o];
+      REQUIRE (std::abs(y_h(icol,o)-val) < tol*std::abs(val));
+    }
+  }
+}
+
+} // namespace scream
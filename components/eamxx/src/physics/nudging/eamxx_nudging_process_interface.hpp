@@ -74,6 +74,8 @@ protected:
   int m_timescale;
   bool m_use_weights;
   bool m_skip_vert_interpolation;
+  // Number of fields of the next nudging data snap to read at each step (0: no prefetch)
+  int m_prefetch_fields_per_step;
   std::vector<std::string> m_datafiles;
   std::string              m_static_vertical_pressure_file;
   // add nudging weights for regional nudging update
@@ -2,6 +2,7 @@
 
 #include "p3_functions.hpp" // for ETI only but harmless for GPU
 #include "ekat/kokkos/ekat_subview_utils.hpp"
+#include "physics/share/physics_team_policy_tuner.hpp"
 
 namespace scream {
 namespace p3 {
@@ -13,13 +14,11 @@ void Functions<Real, DefaultDevice>
                const uview_2d<const Scalar>& col_loc, const Int& nj, const Int& nk)
 {
 
-  using ExeSpace = typename KT::ExeSpace;
   const Int nk_pack = ekat::npack<Spack>(nk);
-  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(nj, nk_pack);
   
-  Kokkos::parallel_for(
-    "p3_check_values",
-    policy, KOKKOS_LAMBDA(const MemberType& team) {
+  physics::TeamPolicyTuner::instance().parallel_for(
+    "p3_check_values", nj, nk_pack,
+     KOKKOS_LAMBDA(const MemberType& team) {
 
     const Int i = team.league_rank();
 
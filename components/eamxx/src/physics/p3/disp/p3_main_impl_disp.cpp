@@ -3,6 +3,7 @@
 #include "physics/share/physics_functions.hpp" // also for ETI not on GPUs
 #include "physics/share/physics_saturation_impl.hpp"
 #include "ekat/kokkos/ekat_subview_utils.hpp"
+#include "physics/share/physics_team_policy_tuner.hpp"
 
 namespace scream {
 namespace p3 {
@@ -33,11 +34,8 @@ void Functions<Real,DefaultDevice>
   const uview_2d<Spack>& lamc, const uview_2d<Spack>& rho_qi, const uview_2d<Spack>& qv2qi_depos_tend, const uview_2d<Spack>& precip_total_tend,
   const uview_2d<Spack>& nevapr, const uview_2d<Spack>& precip_liq_flux, const uview_2d<Spack>& precip_ice_flux)
 {
-  using ExeSpace = typename KT::ExeSpace;
-  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(nj, nk_pack);
-
-  Kokkos::parallel_for("p3_main_init",
-         policy, KOKKOS_LAMBDA(const MemberType& team) {
+  physics::TeamPolicyTuner::instance().parallel_for("p3_main_init", nj, nk_pack,
+         KOKKOS_LAMBDA(const MemberType& team) {
 
     const Int i = team.league_rank();
     precip_liq_surf(i) = 0;
@@ -246,6 +244,22 @@ Int Functions<Real,DefaultDevice>
       bm, qc_incld, qr_incld, qi_incld, qm_incld, nc_incld, nr_incld,
       ni_incld, bm_incld, nucleationPossible, hydrometeorsPresent, p3constants);
 
+  // Compact the list of columns where nucleation is possible or hydrometeors are present.
+  // The remaining kernels only launch teams for these columns, and work in place on the
+  // full-size views via the active_cols indirection, so there is nothing to scatter back.
+  // Dry columns are done after part1 (outputs are already set by p3_main_init).
+  view_1d<Int> active_cols("active_cols", nj);
+  Int num_active = 0;
+  Kokkos::parallel_scan("p3_active_columns", Kokkos::RangePolicy<ExeSpace>(0, nj),
+      KOKKOS_LAMBDA(const Int i, Int& count, const bool final) {
+    if (nucleationPossible(i) || hydrometeorsPresent(i)) {
+      if (final) {
+        active_cols(count) = i;
+      }
+      ++count;
+    }
+  }, num_active);
+
   // ------------------------------------------------------------------------------------------
   // main k-loop (for processes):
 
@@ -259,7 +273,7 @@ Int Functions<Real,DefaultDevice>
       nr_incld, ni_incld, bm_incld, mu_c, nu, lamc, cdist, cdist1, cdistr,
       mu_r, lamr, logn0r, qv2qi_depos_tend, precip_total_tend, nevapr, qr_evap_tend,
       vap_liq_exchange, vap_ice_exchange, liq_ice_exchange,
-      pratot, prctot, nucleationPossible, hydrometeorsPresent, p3constants);
+      pratot, prctot, nucleationPossible, hydrometeorsPresent, active_cols, num_active, p3constants);
 
   //NOTE: At this point, it is possible to have negative (but small) nc, nr, ni.  This is not
   //      a problem; those values get clipped to zero in the sedimentation section (if necessary).
@@ -277,7 +291,7 @@ Int Functions<Real,DefaultDevice>
       qc_incld, rho, inv_rho, cld_frac_l, acn, inv_dz, lookup_tables.dnu_table_vals, workspace_mgr,
       nj, nk, ktop, kbot, kdir, infrastructure.dt, inv_dt, infrastructure.predictNc,
       qc, nc, nc_incld, mu_c, lamc, qtend_ignore, ntend_ignore,
-      diagnostic_outputs.precip_liq_surf, nucleationPossible, hydrometeorsPresent);
+      diagnostic_outputs.precip_liq_surf, nucleationPossible, hydrometeorsPresent, active_cols, num_active);
 
 
   // Rain sedimentation:  (adaptive substepping)
@@ -285,19 +299,20 @@ Int Functions<Real,DefaultDevice>
       rho, inv_rho, rhofacr, cld_frac_r, inv_dz, qr_incld, workspace_mgr,
       lookup_tables.vn_table_vals, lookup_tables.vm_table_vals, nj, nk, ktop, kbot, kdir, infrastructure.dt, inv_dt, qr,
       nr, nr_incld, mu_r, lamr, precip_liq_flux, qtend_ignore, ntend_ignore,
-      diagnostic_outputs.precip_liq_surf, nucleationPossible, hydrometeorsPresent, p3constants);
+      diagnostic_outputs.precip_liq_surf, nucleationPossible, hydrometeorsPresent, active_cols, num_active, p3constants);
 
   // Ice sedimentation:  (adaptive substepping)
   ice_sedimentation_disp(
       rho, inv_rho, rhofaci, cld_frac_i, inv_dz, workspace_mgr, nj, nk, ktop, kbot,
       kdir, infrastructure.dt, inv_dt, qi, qi_incld, ni, ni_incld,
       qm, qm_incld, bm, bm_incld, qtend_ignore, ntend_ignore,
-      lookup_tables.ice_table_vals, diagnostic_outputs.precip_ice_surf, nucleationPossible, hydrometeorsPresent, p3constants);
+      lookup_tables.ice_table_vals, diagnostic_outputs.precip_ice_surf, nucleationPossible, hydrometeorsPresent,
+      active_cols, num_active, p3constants);
 
   // homogeneous freezing f cloud and rain
   homogeneous_freezing_disp(
       T_atm, inv_exner, nj, nk, ktop, kbot, kdir, qc, nc, qr, nr, qi,
-      ni, qm, bm, th, nucleationPossible, hydrometeorsPresent);
+      ni, qm, bm, th, nucleationPossible, hydrometeorsPresent, active_cols, num_active);
 
   //
   // final checks to ensure consistency of mass/number
@@ -309,7 +324,7 @@ Int Functions<Real,DefaultDevice>
       qm, bm, mu_c, nu, lamc, mu_r, lamr,
       vap_liq_exchange, ze_rain, ze_ice, diag_vm_qi, diag_eff_radius_qi, diag_diam_qi,
       rho_qi, diag_equiv_reflectivity, diag_eff_radius_qc, diag_eff_radius_qr, nucleationPossible, hydrometeorsPresent,
-      p3constants);
+      active_cols, num_active, p3constants);
 
   //
   // merge ice categories with similar properties
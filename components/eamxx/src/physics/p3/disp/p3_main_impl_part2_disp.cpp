@@ -1,6 +1,7 @@
 
 #include "p3_functions.hpp" // for ETI only but harmless for GPU
 #include "ekat/kokkos/ekat_subview_utils.hpp"
+#include "physics/share/physics_team_policy_tuner.hpp"
 
 namespace scream {
 namespace p3 {
@@ -90,19 +91,19 @@ void Functions<Real,DefaultDevice>
   const uview_2d<Spack>& prctot,
   const uview_1d<bool>& nucleationPossible,
   const uview_1d<bool>& hydrometeorsPresent,
+  const uview_1d<const Int>& active_cols,
+  const Int& num_active,
   const physics::P3_Constants<Real> & p3constants)
 {
-  using ExeSpace = typename KT::ExeSpace;
   const Int nk_pack = ekat::npack<Spack>(nk);
-  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(nj, nk_pack);
 
 
   // p3_cloud_sedimentation loop
-  Kokkos::parallel_for(
-    "p3_main_part2_disp",
-    policy, KOKKOS_LAMBDA(const MemberType& team) {
+  physics::TeamPolicyTuner::instance().parallel_for(
+    "p3_main_part2_disp", num_active, nk_pack,
+     KOKKOS_LAMBDA(const MemberType& team) {
 
-    const Int i = team.league_rank();
+    const Int i = active_cols(team.league_rank());
     if (!(nucleationPossible(i) || hydrometeorsPresent(i))) {
       return;
     }
@@ -4,6 +4,7 @@
 // Needed for p3_init, the only F90 code still used.
 #include "physics/p3/p3_functions.hpp"
 #include "physics/share/physics_constants.hpp"
+#include "physics/share/physics_team_policy_tuner.hpp"
 #include "physics/p3/p3_f90.hpp"
 
 #include "ekat/ekat_assert.hpp"
@@ -129,13 +130,13 @@ size_t P3Microphysics::requested_buffer_size_in_bytes() const
 
   // Number of Reals needed by local views in the interface
   const size_t interface_request =
-      // 1d view scalar, size (ncol)
-      Buffer::num_1d_scalar*m_num_cols*sizeof(Real) +
+      // 1d view scalar, size (ncol), and 2d view scalar, size (ncol, 3),
+      // padded so that the packed views are aligned
+      ATMBufferManager::align_bytes(Buffer::num_1d_scalar*m_num_cols*sizeof(Real) +
+                                    m_num_cols*3*sizeof(Real)) +
       // 2d view packed, size (ncol, nlev_packs)
       Buffer::num_2d_vector*m_num_cols*nk_pack*sizeof(Spack) +
-      Buffer::num_2dp1_vector*m_num_cols*nk_pack_p1*sizeof(Spack) +
-      // 2d view scalar, size (ncol, 3)
-      m_num_cols*3*sizeof(Real);
+      Buffer::num_2dp1_vector*m_num_cols*nk_pack_p1*sizeof(Spack);
 
   // Number of Reals needed by the WorkspaceManager passed to p3_main
   const auto policy       = ekat::ExeSpaceUtils<KT::ExeSpace>::get_default_team_policy(m_num_cols, nk_pack);
@@ -165,7 +166,7 @@ void P3Microphysics::init_buffers(const ATMBufferManager &buffer_manager)
   m_buffer.col_location = decltype(m_buffer.col_location)(mem, m_num_cols, 3);
   mem += m_buffer.col_location.size();
 
-  Spack* s_mem = reinterpret_cast<Spack*>(mem);
+  Spack* s_mem = reinterpret_cast<Spack*>(buffer_manager.align(mem));
 
   // 2d packed views
   const Int nk_pack    = ekat::npack<Spack>(m_num_levs);
@@ -223,6 +224,12 @@ void P3Microphysics::initialize_impl (const RunType /* run_type */)
   // Gather runtime options
   runtime_options.max_total_ni = m_params.get<double>("max_total_ni");
 
+  // Autotuning of the team size of the dispatch kernels (the tuner is shared with SHOC)
+  if (m_params.get<bool>("autotune_team_sizes",false)) {
+    physics::TeamPolicyTuner::instance().enable(m_params.get<std::string>("autotune_cache_file","none"),
+                                                m_params.get<int>("autotune_num_trials",3));
+  }
+
   // setting P3 constants in a struct
   m_p3constants.set_p3_from_namelist(m_params);
   m_p3constants.print_p3constants(m_atm_logger);
@@ -419,8 +426,10 @@ void P3Microphysics::initialize_impl (const RunType /* run_type */)
     p3_postproc.set_mass_and_energy_fluxes(vapor_flux, water_flux, ice_flux, heat_flux);
   }
 
-  // Load tables
-  P3F::init_kokkos_ice_lookup_tables(lookup_tables.ice_table_vals, lookup_tables.collect_table_vals);
+  // Load tables. The ice tables are read once per node, and cached in binary form if requested
+  const auto table_cache_dir = m_params.get<std::string>("lookup_table_cache_dir","none");
+  P3F::init_kokkos_ice_lookup_tables(lookup_tables.ice_table_vals, lookup_tables.collect_table_vals,
+                                     m_comm, table_cache_dir);
   P3F::init_kokkos_tables(lookup_tables.vn_table_vals, lookup_tables.vm_table_vals,
                           lookup_tables.revap_table_vals, lookup_tables.mu_r_table_vals,
                           lookup_tables.dnu_table_vals);
@@ -433,7 +442,11 @@ void P3Microphysics::initialize_impl (const RunType /* run_type */)
 // =========================================================================================
 void P3Microphysics::finalize_impl()
 {
-  // Do nothing
+  // Save the team sizes picked by the tuner, so that later runs can skip tuning
+  auto& tuner = physics::TeamPolicyTuner::instance();
+  if (tuner.enabled() and m_comm.am_i_root()) {
+    tuner.write_cache();
+  }
 }
 // =========================================================================================
 } // namespace scream
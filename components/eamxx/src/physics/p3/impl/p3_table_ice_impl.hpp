@@ -3,6 +3,10 @@
 
 #include "p3_functions.hpp" // for ETI only but harmless for GPU
 
+#include "physics/share/physics_shared_table.hpp"
+#include "share/util/scream_utils.hpp"
+
+#include <cstring>
 #include <fstream>
 
 namespace scream {
@@ -15,20 +19,7 @@ namespace p3 {
 
 template <typename S, typename D>
 void Functions<S,D>
-::init_kokkos_ice_lookup_tables(view_ice_table& ice_table_vals, view_collect_table& collect_table_vals) {
-
-  using DeviceIcetable = typename view_ice_table::non_const_type;
-  using DeviceColtable = typename view_collect_table::non_const_type;
-
-  const auto ice_table_vals_d     = DeviceIcetable("ice_table_vals");
-  const auto collect_table_vals_d = DeviceColtable("collect_table_vals");
-
-  const auto ice_table_vals_h    = Kokkos::create_mirror_view(ice_table_vals_d);
-  const auto collect_table_vals_h = Kokkos::create_mirror_view(collect_table_vals_d);
-
-  //
-  // read in ice microphysics table into host views
-  //
+::read_ice_lookup_tables(const view_ice_table_host& ice_table_vals_h, const view_collect_table_host& collect_table_vals_h) {
 
   std::string filename = std::string(P3C::p3_lookup_base) + std::string(P3C::p3_version);
 
@@ -69,6 +60,23 @@ void Functions<S,D>
       }
     }
   }
+}
+
+template <typename S, typename D>
+void Functions<S,D>
+::init_kokkos_ice_lookup_tables(view_ice_table& ice_table_vals, view_collect_table& collect_table_vals) {
+
+  using DeviceIcetable = typename view_ice_table::non_const_type;
+  using DeviceColtable = typename view_collect_table::non_const_type;
+
+  const auto ice_table_vals_d     = DeviceIcetable("ice_table_vals");
+  const auto collect_table_vals_d = DeviceColtable("collect_table_vals");
+
+  const auto ice_table_vals_h    = Kokkos::create_mirror_view(ice_table_vals_d);
+  const auto collect_table_vals_h = Kokkos::create_mirror_view(collect_table_vals_d);
+
+  // read in ice microphysics table into host views
+  read_ice_lookup_tables(ice_table_vals_h, collect_table_vals_h);
 
   // deep copy to device
   Kokkos::deep_copy(ice_table_vals_d, ice_table_vals_h);
@@ -77,6 +85,52 @@ void Functions<S,D>
   collect_table_vals = collect_table_vals_d;
 }
 
+template <typename S, typename D>
+void Functions<S,D>
+::init_kokkos_ice_lookup_tables(view_ice_table& ice_table_vals, view_collect_table& collect_table_vals,
+                                const ekat::Comm& comm, const std::string& cache_dir) {
+
+  using DeviceIcetable = typename view_ice_table::non_const_type;
+  using DeviceColtable = typename view_collect_table::non_const_type;
+  using physics::NodeSharedTable;
+
+  constexpr std::size_t ice_size     = P3C::densize*P3C::rimsize*P3C::isize*P3C::ice_table_size;
+  constexpr std::size_t collect_size = P3C::densize*P3C::rimsize*P3C::isize*P3C::rcollsize*P3C::collect_table_size;
+
+  // The cache key identifies the content of the table file, the table version and the
+  // layout of the tables in memory, so a stale cache file is never used
+  std::uint64_t key = 0;
+  if (comm.am_i_root()) {
+    const std::string filename = std::string(P3C::p3_lookup_base) + std::string(P3C::p3_version);
+    const int layout[] = {P3C::densize, P3C::rimsize, P3C::isize, P3C::ice_table_size,
+                          P3C::rcollsize, P3C::collect_table_size, static_cast<int>(sizeof(Scalar))};
+    key = NodeSharedTable::file_checksum(filename);
+    key = NodeSharedTable::checksum(P3C::p3_version, std::strlen(P3C::p3_version), key);
+    key = NodeSharedTable::checksum(layout, sizeof(layout), key);
+  }
+  check_mpi_call(MPI_Bcast(&key, 1, MPI_UINT64_T, comm.root_rank(), comm.mpi_comm()),
+                 "P3 ice lookup tables: MPI_Bcast");
+
+  // Both tables are stored one after the other in the node shared memory
+  const NodeSharedTable table(comm, "p3_ice_tables", key, (ice_size+collect_size)*sizeof(Scalar), cache_dir,
+    [&](void* data) {
+      Scalar* vals = static_cast<Scalar*>(data);
+      read_ice_lookup_tables(view_ice_table_host(vals), view_collect_table_host(vals+ice_size));
+    });
+
+  Scalar* vals = static_cast<Scalar*>(const_cast<void*>(table.data()));
+  const auto ice_table_vals_h     = view_ice_table_host(vals);
+  const auto collect_table_vals_h = view_collect_table_host(vals+ice_size);
+
+  // deep copy to device, after which the shared memory is released
+  const auto ice_table_vals_d     = DeviceIcetable("ice_table_vals");
+  const auto collect_table_vals_d = DeviceColtable("collect_table_vals");
+  Kokkos::deep_copy(ice_table_vals_d, ice_table_vals_h);
+  Kokkos::deep_copy(collect_table_vals_d, collect_table_vals_h);
+  ice_table_vals    = ice_table_vals_d;
+  collect_table_vals = collect_table_vals_d;
+}
+
 template <typename S, typename D>
 KOKKOS_FUNCTION
 void Functions<S,D>
@@ -6,6 +6,7 @@
 #include "share/scream_types.hpp"
 
 #include "ekat/ekat_pack_kokkos.hpp"
+#include "ekat/mpi/ekat_comm.hpp"
 #include "ekat/ekat_workspace.hpp"
 
 namespace scream {
@@ -91,6 +92,10 @@ struct Functions
   // ice lookup table values for ice-rain collision/collection
   using view_collect_table = typename KT::template view<const Scalar[P3C::densize][P3C::rimsize][P3C::isize][P3C::rcollsize][P3C::collect_table_size]>;
 
+  // host views of the ice lookup tables
+  using view_ice_table_host     = typename view_ice_table::non_const_type::HostMirror;
+  using view_collect_table_host = typename view_collect_table::non_const_type::HostMirror;
+
   // droplet spectral shape parameter for mass spectra, used for Seifert and Beheng (2001)
   // warm rain autoconversion/accretion option only (iparam = 1)
   using view_dnu_table = typename KT::template view_1d_table<Scalar, P3C::dnusize>;
@@ -314,6 +319,18 @@ struct Functions
   static void init_kokkos_ice_lookup_tables(
     view_ice_table& ice_table_vals, view_collect_table& collect_table_vals);
 
+  // Same as above, but the tables are read once per node into shared memory, and
+  // uploaded to the device from there. If cache_dir is not "none", the tables are
+  // stored in a binary file in cache_dir, keyed by a checksum of the table file,
+  // and read from it in later runs (see physics::NodeSharedTable).
+  static void init_kokkos_ice_lookup_tables(
+    view_ice_table& ice_table_vals, view_collect_table& collect_table_vals,
+    const ekat::Comm& comm, const std::string& cache_dir);
+
+  // Read the ice lookup table file into host views
+  static void read_ice_lookup_tables(
+    const view_ice_table_host& ice_table_vals_h, const view_collect_table_host& collect_table_vals_h);
+
   // Map (mu_r, lamr) to Table3 data.
   KOKKOS_FUNCTION
   static void lookup(const Spack& mu_r, const Spack& lamr,
@@ -480,7 +497,9 @@ struct Functions
     const uview_2d<Spack>& nc_tend,
     const uview_1d<Scalar>& precip_liq_surf,
     const uview_1d<bool>& is_nucleat_possible,
-    const uview_1d<bool>& is_hydromet_present);
+    const uview_1d<bool>& is_hydromet_present,
+    const uview_1d<const Int>& active_cols,
+    const Int& num_active);
 #endif
 
   // TODO: comment
@@ -529,6 +548,8 @@ struct Functions
     const uview_1d<Scalar>& precip_liq_surf,
     const uview_1d<bool>& is_nucleat_possible,
     const uview_1d<bool>& is_hydromet_present,
+    const uview_1d<const Int>& active_cols,
+    const Int& num_active,
     const physics::P3_Constants<ScalarT> & p3constants);
 #endif
 
@@ -580,6 +601,8 @@ struct Functions
     const uview_1d<Scalar>& precip_ice_surf,
     const uview_1d<bool>& is_nucleat_possible,
     const uview_1d<bool>& is_hydromet_present,
+    const uview_1d<const Int>& active_cols,
+    const Int& num_active,
     const physics::P3_Constants<ScalarT> & p3constants);
 #endif
 
@@ -615,7 +638,9 @@ struct Functions
     const uview_2d<Spack>& bm,
     const uview_2d<Spack>& th_atm,
     const uview_1d<bool>& is_nucleat_possible,
-    const uview_1d<bool>& is_hydromet_present);
+    const uview_1d<bool>& is_hydromet_present,
+    const uview_1d<const Int>& active_cols,
+    const Int& num_active);
 #endif
 
   // -- Find layers
@@ -1221,6 +1246,8 @@ struct Functions
     const uview_2d<Spack>& prctot,
     const uview_1d<bool>& is_nucleat_possible,
     const uview_1d<bool>& is_hydromet_present,
+    const uview_1d<const Int>& active_cols,
+    const Int& num_active,
     const physics::P3_Constants<ScalarT> & p3constants);
 #endif
 
@@ -1306,6 +1333,8 @@ struct Functions
     const uview_2d<Spack>& diag_eff_radius_qr,
     const uview_1d<bool>& is_nucleat_possible,
     const uview_1d<bool>& is_hydromet_present,
+    const uview_1d<const Int>& active_cols,
+    const Int& num_active,
     const physics::P3_Constants<ScalarT> & p3constants);
 #endif
 
@@ -2,6 +2,7 @@
 #include "physics/rrtmgp/eamxx_rrtmgp_process_interface.hpp"
 #include "physics/rrtmgp/rrtmgp_utils.hpp"
 #include "physics/rrtmgp/shr_orb_mod_c2f.hpp"
+#include "physics/share/physics_shared_table.hpp"
 #include "physics/share/scream_trcmix.hpp"
 
 #include "share/io/scream_scorpio_interface.hpp"
@@ -23,6 +24,16 @@ using KT = KokkosTypes<DefaultDevice>;
 using ExeSpace = KT::ExeSpace;
 using MemberType = KT::MemberType;
 
+// All kernels in the chunks loop run on the default execution space instance,
+// so they are already ordered, and the host can keep enqueuing kernels of the
+// next chunks while the device works. Fences are only needed when YAKL is
+// used, since YAKL kernels do not run on the Kokkos default instance.
+#ifdef RRTMGP_ENABLE_YAKL
+#define RRTMGP_CHUNK_FENCE() Kokkos::fence()
+#else
+#define RRTMGP_CHUNK_FENCE()
+#endif
+
 namespace {
 
 struct ConvertToRrtmgpSubview
@@ -611,6 +622,14 @@ void RRTMGPRadiation::initialize_impl(const RunType /* run_type */) {
   // Determine rad timestep, specified as number of atm steps
   m_rad_freq_in_steps = m_params.get<Int>("rad_frequency", 1);
 
+  // Determine how many radiation calls it takes to update all column chunks
+  m_chunk_update_stride = m_params.get<int>("column_chunk_update_stride", 1);
+  EKAT_REQUIRE_MSG (m_chunk_update_stride>0,
+      "Error! Invalid column_chunk_update_stride for RRTMGP: " + std::to_string(m_chunk_update_stride) + "\n");
+
+  m_cosine_zenith   = KT::view_1d<Real>("cosine_zenith",m_ncol);
+  m_cosine_zenith_h = Kokkos::create_mirror_view(m_cosine_zenith);
+
   // Determine orbital year. If orbital_year is negative, use current year
   // from timestamp for orbital year; if positive, use provided orbital year
   // for duration of simulation.
@@ -653,10 +672,18 @@ void RRTMGPRadiation::initialize_impl(const RunType /* run_type */) {
   Kokkos::deep_copy(m_gas_mol_weights,gas_mol_w_host);
 
   // Initialize GasConcs object to pass to RRTMGP initializer;
-  std::string coefficients_file_sw = m_params.get<std::string>("rrtmgp_coefficients_file_sw");
-  std::string coefficients_file_lw = m_params.get<std::string>("rrtmgp_coefficients_file_lw");
-  std::string cloud_optics_file_sw = m_params.get<std::string>("rrtmgp_cloud_optics_file_sw");
-  std::string cloud_optics_file_lw = m_params.get<std::string>("rrtmgp_cloud_optics_file_lw");
+  // The data files are read from a node-local copy, if requested, so that
+  // the file system sees one read per node rather than one read per rank
+  using physics::NodeLocalFile;
+  const auto local_dir = m_params.get<std::string>("node_local_dir","none");
+  const NodeLocalFile local_coefficients_sw (m_comm,m_params.get<std::string>("rrtmgp_coefficients_file_sw"),local_dir);
+  const NodeLocalFile local_coefficients_lw (m_comm,m_params.get<std::string>("rrtmgp_coefficients_file_lw"),local_dir);
+  const NodeLocalFile local_cloud_optics_sw (m_comm,m_params.get<std::string>("rrtmgp_cloud_optics_file_sw"),local_dir);
+  const NodeLocalFile local_cloud_optics_lw (m_comm,m_params.get<std::string>("rrtmgp_cloud_optics_file_lw"),local_dir);
+  std::string coefficients_file_sw = local_coefficients_sw.path();
+  std::string coefficients_file_lw = local_coefficients_lw.path();
+  std::string cloud_optics_file_sw = local_cloud_optics_sw.path();
+  std::string cloud_optics_file_lw = local_cloud_optics_lw.path();
 #ifdef RRTMGP_ENABLE_YAKL
   m_gas_concs.init(gas_names_yakl_offset,m_col_chunk_size,m_nlay);
   rrtmgp::rrtmgp_initialize(
@@ -802,6 +829,11 @@ void RRTMGPRadiation::run_impl (const double dt) {
   auto ts = timestamp();
   auto update_rad = scream::rrtmgp::radiation_do(m_rad_freq_in_steps, ts.get_num_steps());
 
+  // Which column chunks are updated this step (if any). The first call updates all chunks,
+  // since the other chunks don't have a previous heating rate to keep
+  const int chunk_stride = m_num_rad_calls==0 ? 1 : m_chunk_update_stride;
+  const int chunk_phase  = m_num_rad_calls % chunk_stride;
+
   if (update_rad) {
     // On each chunk, we internally "reset" the GasConcs object to subview the concs 3d array
     // with the correct ncol dimension. So let's keep a copy of the original (ref-counted)
@@ -884,8 +916,28 @@ void RRTMGPRadiation::run_impl (const double dt) {
       }
     }
 
+    // Determine the cosine zenith angle on all columns
+    // NOTE: Since we are bridging to F90 arrays this must be done on HOST and then
+    //       deep copied to a device view. We do it once for all chunks, so that the
+    //       kernels of all chunks can be enqueued without waiting for the device.
+    if (m_fixed_solar_zenith_angle > 0) {
+      Kokkos::deep_copy(m_cosine_zenith_h,m_fixed_solar_zenith_angle);
+    } else {
+      // Now use solar declination to calculate zenith angle for all points
+      for (int i=0;i<m_ncol;i++) {
+        double lat = h_lat(i)*PC::Pi/180.0;  // Convert lat/lon to radians
+        double lon = h_lon(i)*PC::Pi/180.0;
+        m_cosine_zenith_h(i) = shr_orb_cosz_c2f(calday, lat, lon, delta, m_rad_freq_in_steps * dt);
+      }
+    }
+    Kokkos::deep_copy(m_cosine_zenith,m_cosine_zenith_h);
+    const auto cosine_zenith = m_cosine_zenith;
+
     // Loop over each chunk of columns
     for (int ic=0; ic<m_num_col_chunks; ++ic) {
+      if (ic % chunk_stride != chunk_phase) {
+        continue;
+      }
       const int beg  = m_col_chunk_beg[ic];
       const int ncol = m_col_chunk_beg[ic+1] - beg;
       this->log(LogLevel::debug,
@@ -1043,29 +1095,15 @@ void RRTMGPRadiation::run_impl (const double dt) {
 
       // Copy data from the FieldManager to the YAKL arrays
       {
-        // Determine the cosine zenith angle
-        // NOTE: Since we are bridging to F90 arrays this must be done on HOST and then
-        //       deep copied to a device view.
-        auto h_mu0 = Kokkos::create_mirror_view(d_mu0);
-        if (m_fixed_solar_zenith_angle > 0) {
-          for (int i=0; i<ncol; i++) {
-            h_mu0(i) = m_fixed_solar_zenith_angle;
-          }
-        } else {
-          // Now use solar declination to calculate zenith angle for all points
-          for (int i=0;i<ncol;i++) {
-            double lat = h_lat(i+beg)*PC::Pi/180.0;  // Convert lat/lon to radians
-            double lon = h_lon(i+beg)*PC::Pi/180.0;
-            h_mu0(i) = shr_orb_cosz_c2f(calday, lat, lon, delta, m_rad_freq_in_steps * dt);
-          }
-        }
-        Kokkos::deep_copy(d_mu0,h_mu0);
-
         const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(ncol, m_nlay);
         Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
           const int i = team.league_rank();
           const int icol = i+beg;
 
+          Kokkos::single(Kokkos::PerTeam(team),[&] {
+            d_mu0(i) = cosine_zenith(icol);
+          });
+
           // Calculate dz
           const auto pseudo_density = ekat::subview(d_pdel, icol);
           const auto p_mid          = ekat::subview(d_pmid, icol);
@@ -1206,7 +1244,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
 #endif
         });
       }
-      Kokkos::fence();
+      RRTMGP_CHUNK_FENCE();
 #ifdef RRTMGP_ENABLE_KOKKOS
       COMPARE_ALL_WRAP(std::vector<real3d>({aero_tau_sw, aero_ssa_sw, aero_g_sw, aero_tau_lw}),
                        std::vector<real3dk>({aero_tau_sw_k, aero_ssa_sw_k, aero_g_sw_k, aero_tau_lw_k}));
@@ -1313,7 +1351,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
           });
         });
       }
-      Kokkos::fence();
+      RRTMGP_CHUNK_FENCE();
 #ifdef RRTMGP_ENABLE_KOKKOS
       COMPARE_WRAP(cldfrac_tot, cldfrac_tot_k);
 #endif
@@ -1347,7 +1385,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
         });
       });
       }
-      Kokkos::fence();
+      RRTMGP_CHUNK_FENCE();
 
       // Compute band-by-band surface_albedos. This is needed since
       // the AD passes broadband albedos, but rrtmgp require band-by-band.
@@ -1455,7 +1493,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
           });
         });
       }
-      Kokkos::fence();
+      RRTMGP_CHUNK_FENCE();
 #endif
 #ifdef RRTMGP_ENABLE_KOKKOS
       auto sw_heating_k  = m_buffer.sw_heating_k;
@@ -1478,7 +1516,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
           });
         });
       }
-      Kokkos::fence();
+      RRTMGP_CHUNK_FENCE();
       COMPARE_ALL_WRAP(std::vector<real2d>({sw_heating, lw_heating}),
                        std::vector<real2dk>({sw_heating_k, lw_heating_k}));
 #endif
@@ -1721,19 +1759,23 @@ void RRTMGPRadiation::run_impl (const double dt) {
     m_gas_concs_k.concs = gas_concs_k;
     m_gas_concs_k.ncol = orig_ncol_k;
 #endif
+    ++m_num_rad_calls;
   } // update_rad
 
   // Apply temperature tendency; if we updated radiation this timestep, then d_rad_heating_pdel should
   // contain actual heating rate, not pdel scaled heating rate. Otherwise, if we have NOT updated the
   // radiative heating, then we need to back out the heating from the rad_heating*pdel term that we carry
-  // across timesteps to conserve energy.
+  // across timesteps to conserve energy. With staggered chunk updates, only the columns
+  // of the chunks updated in this step have the actual heating rate.
   const int ncols = m_ncol;
   const int nlays = m_nlay;
+  const int col_chunk_size = m_col_chunk_size;
   const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(ncols, nlays);
   Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
     const int i = team.league_rank();
+    const bool col_updated = update_rad and (i/col_chunk_size) % chunk_stride == chunk_phase;
     Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nlays), [&] (const int& k) {
-      if (update_rad) {
+      if (col_updated) {
         d_tmid(i,k) = d_tmid(i,k) + d_rad_heating_pdel(i,k) * dt;
         d_rad_heating_pdel(i,k) = d_pdel(i,k) * d_rad_heating_pdel(i,k);
       } else {
@@ -129,9 +129,19 @@ public:
   // Rad frequency in number of steps
   int m_rad_freq_in_steps;
 
+  // If >1, each radiation call only updates one every this many column chunks, in
+  // a rotating fashion, while the other chunks keep their last heating and fluxes
+  int m_chunk_update_stride;
+  int m_num_rad_calls = 0;
+
   // Whether or not to do subcolumn sampling of cloud state for MCICA
   bool m_do_subcol_sampling;
 
+  // Cosine of the zenith angle on all columns. It is computed on host for all columns
+  // before the chunks loop, so that the host does not have to wait for each chunk
+  KT::view_1d<Real>               m_cosine_zenith;
+  KT::view_1d<Real>::HostMirror   m_cosine_zenith_h;
+
   // Structure for storing local variables initialized using the ATMBufferManager
   struct Buffer {
     static constexpr int num_1d_ncol        = 10;
@@ -0,0 +1,83 @@
+#ifndef SCREAM_PHYSICS_BATCHED_TRIDIAG_HPP
+#define SCREAM_PHYSICS_BATCHED_TRIDIAG_HPP
+
+#include "share/scream_types.hpp"
+
+namespace scream {
+namespace physics {
+
+/*
+ * Batched solver for independent tridiagonal systems, one per column
+ *
+ * The system of column i reads
+ *
+ *   dl(k,i)*x(k-1,i) + d(k,i)*x(k,i) + du(k,i)*x(k+1,i) = rhs(k,i),  k=0,...,nlev-1
+ *
+ * with dl(0,i) and du(nlev-1,i) ignored. The diagonals are stored as (nlev,ncol)
+ * views, and the right hand sides as (nrhs,nlev,ncol) views, so that the column
+ * index is the fastest. Each system is solved by one thread with the Thomas
+ * algorithm, and consecutive threads handle consecutive columns (the "interleaved"
+ * Thomas algorithm), so that all memory accesses are coalesced on GPU.
+ * Compared to team-level solvers (e.g., ekat::tridiag::cr), this doesn't need any
+ * synchronization within a system, which pays off when there are many small systems,
+ * as in vertical diffusion problems.
+ *
+ * As in ekat::tridiag::thomas, there is no pivoting, so the matrices must be
+ * (e.g.) diagonally dominant. The results are not BFB with ekat::tridiag::bfb.
+ */
+
+template<typename ScalarT, typename DeviceT = DefaultDevice>
+struct BatchedTridiag {
+  using KT       = KokkosTypes<DeviceT>;
+  using ExeSpace = typename KT::ExeSpace;
+
+  using diag_view_t  = typename KT::template view_2d<ScalarT>;
+  using cdiag_view_t = typename KT::template view_2d<const ScalarT>;
+  using rhs_view_t   = typename KT::template view_3d<ScalarT>;
+
+  // Factor the matrices in place: on output, d stores the inverse of the pivots,
+  // and du the modified superdiagonal. dl is not modified.
+  static void factor (const cdiag_view_t& dl, const diag_view_t& d, const diag_view_t& du)
+  {
+    const int nlev = d.extent(0);
+    const int ncol = d.extent(1);
+    Kokkos::parallel_for("BatchedTridiag::factor",
+        Kokkos::RangePolicy<ExeSpace>(0,ncol),
+        KOKKOS_LAMBDA(const int i) {
+      d(0,i)   = 1/d(0,i);
+      du(0,i) *= d(0,i);
+      for (int k=1; k<nlev; ++k) {
+        d(k,i)   = 1/(d(k,i) - dl(k,i)*du(k-1,i));
+        du(k,i) *= d(k,i);
+      }
+    });
+  }
+
+  // Solve the systems, with matrices factored by factor(). On input, x stores
+  // the right hand sides, on output, the solutions.
+  static void solve (const cdiag_view_t& dl, const cdiag_view_t& d, const cdiag_view_t& du,
+                     const rhs_view_t& x)
+  {
+    const int nrhs = x.extent(0);
+    const int nlev = x.extent(1);
+    const int ncol = x.extent(2);
+    Kokkos::parallel_for("BatchedTridiag::solve",
+        Kokkos::RangePolicy<ExeSpace>(0,nrhs*ncol),
+        KOKKOS_LAMBDA(const int idx) {
+      const int r = idx / ncol;
+      const int i = idx % ncol;
+      x(r,0,i) *= d(0,i);
+      for (int k=1; k<nlev; ++k) {
+        x(r,k,i) = (x(r,k,i) - dl(k,i)*x(r,k-1,i))*d(k,i);
+      }
+      for (int k=nlev-2; k>=0; --k) {
+        x(r,k,i) -= du(k,i)*x(r,k+1,i);
+      }
+    });
+  }
+};
+
+} // namespace physics
+} // namespace scream
+
+#endif // SCREAM_PHYSICS_BATCHED_TRIDIAG_HPP
@@ -0,0 +1,263 @@
+#include "physics/share/physics_shared_table.hpp"
+
+#include "share/util/scream_utils.hpp"
+
+#include "ekat/ekat_assert.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace scream {
+namespace physics {
+
+namespace {
+
+// Header of the binary cache files, followed by the table data
+struct CacheHeader {
+  char          magic[8];
+  std::uint64_t key;
+  std::uint64_t nbytes;
+  std::uint64_t data_checksum;
+};
+
+constexpr char cache_magic[8] = {'E','A','M','X','X','T','B','L'};
+
+} // anonymous namespace
+
+NodeSharedTable::
+NodeSharedTable (const ekat::Comm& comm,
+                 const std::string& name,
+                 const std::uint64_t key,
+                 const std::size_t nbytes,
+                 const std::string& cache_dir,
+                 const generator_t& generate)
+ : m_nbytes (nbytes)
+ , m_key (key)
+{
+  EKAT_REQUIRE_MSG (nbytes>0,
+      "Error! Invalid size for NodeSharedTable.\n"
+      "  - table name: " + name + "\n");
+
+  if (cache_dir!="" and cache_dir!="none") {
+    std::stringstream ss;
+    ss << cache_dir << "/" << name << "_" << std::hex << std::setfill('0')
+       << std::setw(16) << key << ".bin";
+    m_cache_file = ss.str();
+  }
+
+  // Allocate the whole table on the first rank of the node, which is the
+  // root rank on the node of the root
+  const int node_key = comm.am_i_root() ? 0 : comm.rank()+1;
+  check_mpi_call (MPI_Comm_split_type(comm.mpi_comm(),MPI_COMM_TYPE_SHARED,node_key,
+                                      MPI_INFO_NULL,&m_node_comm),
+                  "NodeSharedTable: MPI_Comm_split_type");
+  int node_rank;
+  check_mpi_call (MPI_Comm_rank(m_node_comm,&node_rank),
+                  "NodeSharedTable: MPI_Comm_rank");
+
+  const MPI_Aint local_size = node_rank==0 ? nbytes : 0;
+  void* local_data;
+  check_mpi_call (MPI_Win_allocate_shared(local_size,1,MPI_INFO_NULL,m_node_comm,
+                                          &local_data,&m_win),
+                  "NodeSharedTable: MPI_Win_allocate_shared");
+  MPI_Aint size;
+  int disp_unit;
+  check_mpi_call (MPI_Win_shared_query(m_win,0,&size,&disp_unit,&m_data),
+                  "NodeSharedTable: MPI_Win_shared_query");
+
+  // The root rank reads or writes the cache file, then the other nodes try to read it
+  int have_file = 0;
+  if (comm.am_i_root()) {
+    if (m_cache_file!="" and read_cache(m_data)) {
+      m_from_cache = true;
+    } else {
+      generate(m_data);
+      if (m_cache_file!="") {
+        write_cache(m_data);
+      }
+    }
+    have_file = m_cache_file!="";
+  }
+  comm.broadcast(&have_file,1,comm.root_rank());
+
+  if (node_rank==0 and not comm.am_i_root()) {
+    if (have_file and read_cache(m_data)) {
+      m_from_cache = true;
+    } else {
+      generate(m_data);
+    }
+  }
+
+  // Make the data written by the first rank visible to all ranks of the node
+  check_mpi_call (MPI_Win_fence(0,m_win),"NodeSharedTable: MPI_Win_fence");
+
+  int from_cache = m_from_cache;
+  check_mpi_call (MPI_Bcast(&from_cache,1,MPI_INT,0,m_node_comm),
+                  "NodeSharedTable: MPI_Bcast");
+  m_from_cache = from_cache;
+}
+
+NodeSharedTable::~NodeSharedTable ()
+{
+  MPI_Win_free(&m_win);
+  MPI_Comm_free(&m_node_comm);
+}
+
+bool NodeSharedTable::read_cache (void* data) const
+{
+  const int fd = open(m_cache_file.c_str(),O_RDONLY);
+  if (fd<0) {
+    return false;
+  }
+
+  bool valid = false;
+  struct stat st;
+  const std::size_t file_size = sizeof(CacheHeader) + m_nbytes;
+  if (fstat(fd,&st)==0 and static_cast<std::size_t>(st.st_size)==file_size) {
+    void* map = mmap(nullptr,file_size,PROT_READ,MAP_PRIVATE,fd,0);
+    if (map!=MAP_FAILED) {
+      CacheHeader header;
+      std::memcpy(&header,map,sizeof(CacheHeader));
+      const char* table = static_cast<const char*>(map) + sizeof(CacheHeader);
+      valid = std::memcmp(header.magic,cache_magic,sizeof(cache_magic))==0 &&
+              header.key==m_key && header.nbytes==m_nbytes &&
+              header.data_checksum==checksum(table,m_nbytes);
+      if (valid) {
+        std::memcpy(data,table,m_nbytes);
+      }
+      munmap(map,file_size);
+    }
+  }
+  close(fd);
+
+  return valid;
+}
+
+void NodeSharedTable::write_cache (const void* data) const
+{
+  CacheHeader header;
+  std::memcpy(header.magic,cache_magic,sizeof(cache_magic));
+  header.key = m_key;
+  header.nbytes = m_nbytes;
+  header.data_checksum = checksum(data,m_nbytes);
+
+  // Write to a temporary file and rename it, so that an incomplete file is never read
+  const std::string tmp_file = m_cache_file + ".tmp";
+  {
+    std::ofstream ofs (tmp_file,std::ios::binary);
+    EKAT_REQUIRE_MSG (ofs.good(),
+        "Error! Could not open NodeSharedTable cache file for writing.\n"
+        "  - file name: " + tmp_file + "\n");
+    ofs.write(reinterpret_cast<const char*>(&header),sizeof(CacheHeader));
+    ofs.write(static_cast<const char*>(data),m_nbytes);
+    EKAT_REQUIRE_MSG (ofs.good(),
+        "Error! Could not write NodeSharedTable cache file.\n"
+        "  - file name: " + tmp_file + "\n");
+  }
+  EKAT_REQUIRE_MSG (std::rename(tmp_file.c_str(),m_cache_file.c_str())==0,
+      "Error! Could not rename NodeSharedTable cache file.\n"
+      "  - file name: " + m_cache_file + "\n");
+}
+
+std::uint64_t NodeSharedTable::
+checksum (const void* data, const std::size_t nbytes, const std::uint64_t seed)
+{
+  constexpr std::uint64_t prime = 1099511628211ULL;
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  std::uint64_t hash = seed;
+  for (std::size_t i=0; i<nbytes; ++i) {
+    hash = (hash ^ bytes[i]) * prime;
+  }
+  return hash;
+}
+
+std::uint64_t NodeSharedTable::
+file_checksum (const std::string& filename, const std::uint64_t seed)
+{
+  std::ifstream ifs (filename,std::ios::binary);
+  EKAT_REQUIRE_MSG (ifs.good(),
+      "Error! Could not open file for checksum.\n"
+      "  - file name: " + filename + "\n");
+
+  std::uint64_t hash = seed;
+  std::vector<char> buf (1 << 20);
+  while (ifs) {
+    ifs.read(buf.data(),buf.size());
+    hash = checksum(buf.data(),ifs.gcount(),hash);
+  }
+  return hash;
+}
+
+NodeLocalFile::
+NodeLocalFile (const ekat::Comm& comm,
+               const std::string& filename,
+               const std::string& local_dir)
+ : m_path (filename)
+{
+  if (local_dir=="" or local_dir=="none") {
+    return;
+  }
+
+  check_mpi_call (MPI_Comm_split_type(comm.mpi_comm(),MPI_COMM_TYPE_SHARED,comm.rank(),
+                                      MPI_INFO_NULL,&m_node_comm),
+                  "NodeLocalFile: MPI_Comm_split_type");
+  int node_rank;
+  check_mpi_call (MPI_Comm_rank(m_node_comm,&node_rank),
+                  "NodeLocalFile: MPI_Comm_rank");
+  m_owner = node_rank==0;
+
+  // The first rank of the node copies the file, then sends the name of the copy.
+  // The pid makes the name unique among the jobs sharing the node.
+  int len = 0;
+  if (m_owner) {
+    const auto pos = filename.find_last_of('/');
+    const auto basename = pos==std::string::npos ? filename : filename.substr(pos+1);
+    m_path = local_dir + "/" + basename + "." + std::to_string(getpid());
+
+    std::ifstream ifs (filename,std::ios::binary);
+    EKAT_REQUIRE_MSG (ifs.good(),
+        "Error! Could not open input file for NodeLocalFile.\n"
+        "  - file name: " + filename + "\n");
+    std::ofstream ofs (m_path,std::ios::binary);
+    EKAT_REQUIRE_MSG (ofs.good(),
+        "Error! Could not open node-local copy of input file for writing.\n"
+        "  - file name: " + m_path + "\n");
+    ofs << ifs.rdbuf();
+    ofs.close();
+    EKAT_REQUIRE_MSG (ofs.good(),
+        "Error! Could not write node-local copy of input file.\n"
+        "  - file name: " + m_path + "\n");
+    len = m_path.size();
+  }
+  check_mpi_call (MPI_Bcast(&len,1,MPI_INT,0,m_node_comm),
+                  "NodeLocalFile: MPI_Bcast");
+  m_path.resize(len);
+  check_mpi_call (MPI_Bcast(&m_path[0],len,MPI_CHAR,0,m_node_comm),
+                  "NodeLocalFile: MPI_Bcast");
+}
+
+NodeLocalFile::~NodeLocalFile ()
+{
+  if (m_node_comm==MPI_COMM_NULL) {
+    return;
+  }
+
+  // Wait for all ranks of the node to be done with the copy
+  MPI_Barrier(m_node_comm);
+  if (m_owner) {
+    std::remove(m_path.c_str());
+  }
+  MPI_Comm_free(&m_node_comm);
+}
+
+} // namespace physics
+} // namespace scream
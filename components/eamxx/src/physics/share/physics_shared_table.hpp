@@ -0,0 +1,123 @@
+#ifndef SCREAM_PHYSICS_SHARED_TABLE_HPP
+#define SCREAM_PHYSICS_SHARED_TABLE_HPP
+
+#include "ekat/mpi/ekat_comm.hpp"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace scream {
+namespace physics {
+
+/*
+ * Lookup table data shared by all the ranks of a node
+ *
+ * Physics lookup tables are identical on all ranks, but are usually read (or computed)
+ * by each of them at init. NodeSharedTable stores nbytes of table data in an MPI shared
+ * memory window (MPI_Win_allocate_shared), allocated on the first rank of each node, so
+ * that the data is produced once per node, and all ranks of the node can upload it to
+ * their device from the same host memory.
+ *
+ * If a cache directory is given, the data is also stored in a binary file, named after the
+ * table and a 64 bit key. The key must identify the table content (e.g., a checksum of the
+ * source file, combined with the table version and dimensions), so that a stale file is never
+ * used. If a valid file is found, the first rank of each node memory maps it and copies it
+ * into the window. Otherwise, the root rank generates the table and writes the file, which is
+ * then read by the other nodes, so that the table is generated only once per key. Without
+ * cache directory (or if a node cannot read the file), each node generates the table.
+ *
+ * The constructor and destructor are collective over the input comm. The data must be
+ * treated as read-only, and it is valid only during the lifetime of the object, so that
+ * the window can be released as soon as the tables have been copied to the device.
+ */
+
+class NodeSharedTable {
+public:
+  // Fills the nbytes of table data at the input address
+  using generator_t = std::function<void(void* data)>;
+
+  NodeSharedTable (const ekat::Comm& comm,
+                   const std::string& name,
+                   const std::uint64_t key,
+                   const std::size_t nbytes,
+                   const std::string& cache_dir,
+                   const generator_t& generate);
+
+  NodeSharedTable (const NodeSharedTable&) = delete;
+  NodeSharedTable& operator= (const NodeSharedTable&) = delete;
+
+  ~NodeSharedTable ();
+
+  const void* data () const { return m_data; }
+  std::size_t size () const { return m_nbytes; }
+
+  // Whether this node read the table from the cache file
+  bool from_cache () const { return m_from_cache; }
+
+  // The cache file (empty if no cache directory was given)
+  const std::string& cache_file () const { return m_cache_file; }
+
+  // 64 bit FNV-1a checksum of a buffer, or of the content of a file. Passing the
+  // checksum of a previous call as seed allows to combine several items in one key.
+  static constexpr std::uint64_t checksum_seed = 14695981039346656037ULL;
+  static std::uint64_t checksum (const void* data, const std::size_t nbytes,
+                                 const std::uint64_t seed = checksum_seed);
+  static std::uint64_t file_checksum (const std::string& filename,
+                                      const std::uint64_t seed = checksum_seed);
+
+private:
+  bool read_cache  (void* data) const;
+  void write_cache (const void* data) const;
+
+  std::size_t   m_nbytes;
+  std::uint64_t m_key;
+  std::string   m_cache_file;
+  bool          m_from_cache = false;
+
+  MPI_Comm      m_node_comm = MPI_COMM_NULL;
+  MPI_Win       m_win       = MPI_WIN_NULL;
+  void*         m_data      = nullptr;
+};
+
+/*
+ * Node-local copy of a read-only input file
+ *
+ * Some input files (e.g., the RRTMGP k-distribution and cloud optics NetCDF files) can only
+ * be read via third party loaders that take a file name, so their data cannot be shared via
+ * a NodeSharedTable. In that case, NodeLocalFile copies the file once per node, on the first
+ * rank of the node, into a node-local directory (e.g., /dev/shm, a RAM file system), and all
+ * ranks of the node read the copy, so that the parallel file system sees one read per node,
+ * rather than one read per rank. The copy is removed by the destructor.
+ *
+ * The constructor and destructor are collective over the input comm. If local_dir is empty
+ * or "none", nothing is copied, and path() is the input file.
+ */
+
+class NodeLocalFile {
+public:
+  NodeLocalFile (const ekat::Comm& comm,
+                 const std::string& filename,
+                 const std::string& local_dir);
+
+  NodeLocalFile (const NodeLocalFile&) = delete;
+  NodeLocalFile& operator= (const NodeLocalFile&) = delete;
+
+  ~NodeLocalFile ();
+
+  // The file to read
+  const std::string& path () const { return m_path; }
+
+private:
+  std::string   m_path;
+  bool          m_owner     = false;
+  MPI_Comm      m_node_comm = MPI_COMM_NULL;
+};
+
+} // namespace physics
+} // namespace scream
+
+#endif // SCREAM_PHYSICS_SHARED_TABLE_HPP
@@ -0,0 +1,111 @@
+#include "physics/share/physics_team_policy_tuner.hpp"
+
+#include "ekat/ekat_assert.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace scream {
+namespace physics {
+
+void TeamPolicyTuner::enable (const std::string& cache_file, const int num_trials)
+{
+  EKAT_REQUIRE_MSG (num_trials>0,
+      "Error! Invalid number of trials for TeamPolicyTuner.\n"
+      "  - num trials: " + std::to_string(num_trials) + "\n");
+
+  m_enabled = true;
+  m_num_trials = num_trials;
+  m_cache_file = cache_file;
+  if (m_cache_file=="" or m_cache_file=="none") {
+    m_cache_file = "";
+    return;
+  }
+
+  // Each line of the cache is "kernel_name ni nk team_size"
+  std::ifstream ifs (m_cache_file);
+  std::string line;
+  while (std::getline(ifs,line)) {
+    std::istringstream iss(line);
+    std::string name;
+    int ni, nk, team_size;
+    if (iss >> name >> ni >> nk >> team_size and team_size>0) {
+      m_entries[key(name,ni,nk)].choice = team_size;
+    }
+  }
+}
+
+void TeamPolicyTuner::write_cache () const
+{
+  if (m_cache_file=="") {
+    return;
+  }
+
+  std::ofstream ofs (m_cache_file);
+  EKAT_REQUIRE_MSG (ofs.good(),
+      "Error! Could not open TeamPolicyTuner cache file for writing.\n"
+      "  - file name: " + m_cache_file + "\n");
+  for (const auto& it : m_entries) {
+    if (it.second.choice>0) {
+      ofs << it.first << " " << it.second.choice << "\n";
+    }
+  }
+}
+
+int TeamPolicyTuner::get_choice (const std::string& name, const int ni, const int nk) const
+{
+  auto it = m_entries.find(key(name,ni,nk));
+  return it==m_entries.end() ? -1 : it->second.choice;
+}
+
+std::string TeamPolicyTuner::key (const std::string& name, const int ni, const int nk) const
+{
+  // Kernel names contain no spaces, so the key can be stored as is in the cache file.
+  // The number of teams is rounded up to a power of 2, so that kernels launched on
+  // a varying number of columns (e.g., P3 active columns) share their entries.
+  int ni_bucket = 1;
+  while (ni_bucket<ni) {
+    ni_bucket *= 2;
+  }
+  return name + " " + std::to_string(ni_bucket) + " " + std::to_string(nk);
+}
+
+int TeamPolicyTuner::
+next_team_size (Entry& e, const int max_team_size, const int default_team_size) const
+{
+  if (e.choice>0) {
+    // A cached choice may exceed the max team size, if the kernel changed
+    return std::min(e.choice,max_team_size);
+  }
+
+  if (e.candidates.empty()) {
+    e.candidates.push_back(std::min(default_team_size,max_team_size));
+    for (int ts : {64, 128, 256, 512}) {
+      if (ts>e.candidates.front() and ts<=max_team_size) {
+        e.candidates.push_back(ts);
+      }
+    }
+    e.times.resize(e.candidates.size(),0);
+  }
+
+  return e.candidates[e.num_calls / m_num_trials];
+}
+
+void TeamPolicyTuner::
+record_time (Entry& e, const int team_size, const double time) const
+{
+  const int icand = e.num_calls / m_num_trials;
+  EKAT_REQUIRE_MSG (e.candidates[icand]==team_size,
+      "Error! Something went wrong while tuning team sizes.\n");
+
+  e.times[icand] += time;
+  ++e.num_calls;
+  if (e.num_calls==static_cast<int>(e.candidates.size())*m_num_trials) {
+    const auto best = std::min_element(e.times.begin(),e.times.end()) - e.times.begin();
+    e.choice = e.candidates[best];
+  }
+}
+
+} // namespace physics
+} // namespace scream
@@ -0,0 +1,118 @@
+#ifndef SCREAM_PHYSICS_TEAM_POLICY_TUNER_HPP
+#define SCREAM_PHYSICS_TEAM_POLICY_TUNER_HPP
+
+#include "share/scream_types.hpp"
+
+#include "ekat/kokkos/ekat_kokkos_utils.hpp"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace scream {
+namespace physics {
+
+/*
+ * Autotuning of the team size of the column kernels of the physics dispatch functions
+ *
+ * Kernels launched via TeamPolicyTuner::parallel_for run with ni teams (one per column),
+ * working on nk packs. By default, the tuner simply uses the default policy of
+ * ekat::ExeSpaceUtils. If enabled, for each (kernel,ni,nk), with ni rounded up to a
+ * power of 2, the first calls cycle through a few candidate team sizes (up to the max
+ * team size supported by the kernel), timing each of them. Only team sizes not smaller
+ * than the default one are tried, since the workspace managers of the physics are sized
+ * for the number of concurrent teams of the default policy. Once all candidates have
+ * been timed, the fastest one is used in all subsequent calls. The choices can be saved to a cache file, and loaded in later
+ * runs, so that tuning happens only once per machine/resolution.
+ *
+ * Tuning uses the actual calls of the model, so no extra work is done. However, while
+ * tuning, the kernels are fenced before/after the launch, in order to time them.
+ * On host execution spaces there is nothing to tune, so the default policy is used.
+ *
+ * NOTE: kernels that use team-level reductions may not be BFB across different
+ *       team sizes. Do not enable tuning if BFB across runs with different caches
+ *       is required.
+ */
+
+class TeamPolicyTuner {
+public:
+  using KT          = KokkosTypes<DefaultDevice>;
+  using ExeSpace    = typename KT::ExeSpace;
+  using TeamPolicy  = typename KT::TeamPolicy;
+
+  static TeamPolicyTuner& instance () {
+    static TeamPolicyTuner tuner;
+    return tuner;
+  }
+
+  // Enable tuning, loading previous choices from the cache file (if it exists).
+  // Each candidate is timed over num_trials calls. If called more than once
+  // (e.g., by different processes), the last call sets the cache file.
+  void enable (const std::string& cache_file, const int num_trials);
+  bool enabled () const { return m_enabled; }
+
+  // Write the choices made so far to the cache file (if any)
+  void write_cache () const;
+
+  // Same as Kokkos::parallel_for(name,policy,f), with policy a team policy with ni
+  // teams, each working on nk packs, and team size picked by the tuner.
+  template<typename F>
+  void parallel_for (const std::string& name, const int ni, const int nk, const F& f);
+
+  // The team size chosen for this kernel (-1 if still tuning or never called)
+  int get_choice (const std::string& name, const int ni, const int nk) const;
+
+private:
+  TeamPolicyTuner () = default;
+
+  struct Entry {
+    std::vector<int>    candidates;
+    std::vector<double> times;
+    int                 num_calls = 0;
+    int                 choice = -1;
+  };
+
+  std::string key (const std::string& name, const int ni, const int nk) const;
+
+  // Pick the team size for the next call, and record the time of the last one
+  int  next_team_size (Entry& e, const int max_team_size, const int default_team_size) const;
+  void record_time (Entry& e, const int team_size, const double time) const;
+
+  std::map<std::string,Entry>   m_entries;
+  std::string                   m_cache_file;
+  int                           m_num_trials = 1;
+  bool                          m_enabled = false;
+};
+
+template<typename F>
+void TeamPolicyTuner::
+parallel_for (const std::string& name, const int ni, const int nk, const F& f)
+{
+  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(ni, nk);
+  if (not m_enabled or not ekat::OnGpu<ExeSpace>::value) {
+    Kokkos::parallel_for(name, policy, f);
+    return;
+  }
+
+  auto& e = m_entries[key(name,ni,nk)];
+  const int max_team_size = policy.team_size_max(f,Kokkos::ParallelForTag());
+  const int team_size = next_team_size(e,max_team_size,policy.team_size());
+  const TeamPolicy tuned_policy (ni,team_size,policy.impl_vector_length());
+  if (e.choice>0) {
+    Kokkos::parallel_for(name, tuned_policy, f);
+    return;
+  }
+
+  Kokkos::fence();
+  const auto start = std::chrono::steady_clock::now();
+  Kokkos::parallel_for(name, tuned_policy, f);
+  Kokkos::fence();
+  const auto finish = std::chrono::steady_clock::now();
+  record_time(e,team_size,std::chrono::duration<double>(finish-start).count());
+}
+
+} // namespace physics
+} // namespace scream
+
+#endif // SCREAM_PHYSICS_TEAM_POLICY_TUNER_HPP
@@ -0,0 +1,78 @@
+#include "catch2/catch.hpp"
+
+#include "physics/share/physics_batched_tridiag.hpp"
+#include "share/scream_types.hpp"
+#include "share/util/scream_setup_random_test.hpp"
+
+#include <random>
+
+namespace scream {
+namespace physics {
+namespace unit_test {
+
+TEST_CASE("batched_tridiag", "physics")
+{
+  using BT = BatchedTridiag<Real>;
+
+  const int ncol = 37;
+  const int nlev = 72;
+  const int nrhs = 3;
+
+  auto engine = setup_random_test();
+  std::uniform_real_distribution<Real> pdf(-1,1);
+
+  // Diagonally dominant matrices, and random solutions
+  BT::diag_view_t dl("dl",nlev,ncol), d("d",nlev,ncol), du("du",nlev,ncol);
+  BT::rhs_view_t x("x",nrhs,nlev,ncol), xtrue("xtrue",nrhs,nlev,ncol);
+  auto dl_h = Kokkos::create_mirror_view(dl);
+  auto d_h  = Kokkos::create_mirror_view(d);
+  auto du_h = Kokkos::create_mirror_view(du);
+  auto x_h  = Kokkos::create_mirror_view(x);
+  auto xtrue_h = Kokkos::create_mirror_view(xtrue);
+  for (int k=0; k<nlev; ++k) {
+    for (int i=0; i<ncol; ++i) {
+      dl_h(k,i) = k==0 ? 0 : pdf(engine);
+      du_h(k,i) = k==nlev-1 ? 0 : pdf(engine);
+      d_h(k,i)  = 2.5 + pdf(engine);
+      for (int r=0; r<nrhs; ++r) {
+        xtrue_h(r,k,i) = pdf(engine);
+      }
+    }
+  }
+
+  // Compute rhs=A*xtrue
+  for (int r=0; r<nrhs; ++r) {
+    for (int k=0; k<nlev; ++k) {
+      for (int i=0; i<ncol; ++i) {
+        x_h(r,k,i) = d_h(k,i)*xtrue_h(r,k,i);
+        if (k>0) {
+          x_h(r,k,i) += dl_h(k,i)*xtrue_h(r,k-1,i);
+        }
+        if (k<nlev-1) {
+          x_h(r,k,i) += du_h(k,i)*xtrue_h(r,k+1,i);
+        }
+      }
+    }
+  }
+  Kokkos::deep_copy(dl,dl_h);
+  Kokkos::deep_copy(d,d_h);
+  Kokkos::deep_copy(du,du_h);
+  Kokkos::deep_copy(x,x_h);
+
+  BT::factor(dl,d,du);
+  BT::solve(dl,d,du,x);
+  Kokkos::deep_copy(x_h,x);
+
+  const Real tol = std::is_same<Real,float>::value ? 1e-4 : 1e-12;
+  for (int r=0; r<nrhs; ++r) {
+    for (int k=0; k<nlev; ++k) {
+      for (int i=0; i<ncol; ++i) {
+        REQUIRE (std::abs(x_h(r,k,i)-xtrue_h(r,k,i))<tol);
+      }
+    }
+  }
+}
+
+} // namespace unit_test
+} // namespace physics
+} // namespace scream
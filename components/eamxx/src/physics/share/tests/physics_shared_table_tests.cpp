@@ -0,0 +1,123 @@
+#include "catch2/catch.hpp"
+
+#include "physics/share/physics_shared_table.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace scream {
+namespace physics {
+namespace unit_test {
+
+TEST_CASE("node_shared_table", "physics")
+{
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  const int n = 1000;
+  const std::uint64_t key = NodeSharedTable::checksum(&n,sizeof(n));
+  int num_generated = 0;
+  auto generate = [&](void* data) {
+    int* vals = static_cast<int*>(data);
+    for (int i=0; i<n; ++i) {
+      vals[i] = 3*i+1;
+    }
+    ++num_generated;
+  };
+  auto check = [&](const NodeSharedTable& table) {
+    REQUIRE (table.size()==n*sizeof(int));
+    const int* vals = static_cast<const int*>(table.data());
+    for (int i=0; i<n; ++i) {
+      REQUIRE (vals[i]==3*i+1);
+    }
+  };
+
+  // The checksum depends on the content and on the seed
+  std::vector<int> a(n,1), b(n,1);
+  b[n/2] = 2;
+  REQUIRE (NodeSharedTable::checksum(a.data(),n*sizeof(int))==NodeSharedTable::checksum(a.data(),n*sizeof(int)));
+  REQUIRE (NodeSharedTable::checksum(a.data(),n*sizeof(int))!=NodeSharedTable::checksum(b.data(),n*sizeof(int)));
+  REQUIRE (NodeSharedTable::checksum(a.data(),n*sizeof(int))!=NodeSharedTable::checksum(a.data(),n*sizeof(int),key));
+
+  // Without cache, the table is generated by one rank per node
+  {
+    NodeSharedTable table(comm,"test_table",key,n*sizeof(int),"none",generate);
+    check(table);
+    REQUIRE (not table.from_cache());
+    REQUIRE (table.cache_file()=="");
+  }
+
+  // With cache, the root generates the table and writes the file, which is read afterwards
+  std::string cache_file;
+  {
+    NodeSharedTable table(comm,"test_table",key,n*sizeof(int),".",generate);
+    check(table);
+    cache_file = table.cache_file();
+  }
+  num_generated = 0;
+  {
+    NodeSharedTable table(comm,"test_table",key,n*sizeof(int),".",generate);
+    check(table);
+    REQUIRE (table.from_cache());
+    REQUIRE (num_generated==0);
+  }
+
+  // A different key does not use the cached file
+  {
+    NodeSharedTable table(comm,"test_table",key+1,n*sizeof(int),".",generate);
+    check(table);
+    REQUIRE (table.cache_file()!=cache_file);
+    if (comm.am_i_root()) {
+      REQUIRE (num_generated==1);
+      std::remove(table.cache_file().c_str());
+    }
+  }
+
+  comm.barrier();
+  if (comm.am_i_root()) {
+    std::remove(cache_file.c_str());
+  }
+}
+
+TEST_CASE("node_local_file", "physics")
+{
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  const std::string filename = "node_local_file_input.txt";
+  if (comm.am_i_root()) {
+    std::ofstream ofs(filename);
+    ofs << "rrtmgp 112 128\n";
+  }
+  comm.barrier();
+
+  // Without local dir, the input file is read
+  {
+    NodeLocalFile file(comm,filename,"none");
+    REQUIRE (file.path()==filename);
+  }
+
+  // The copy has the same content, and is removed once all ranks are done
+  std::string local_path;
+  {
+    NodeLocalFile file(comm,filename,".");
+    local_path = file.path();
+    REQUIRE (local_path!=filename);
+    std::ifstream ifs(local_path);
+    std::string name;
+    int nsw, nlw;
+    ifs >> name >> nsw >> nlw;
+    REQUIRE (name=="rrtmgp");
+    REQUIRE (nsw==112);
+    REQUIRE (nlw==128);
+  }
+
+  comm.barrier();
+  if (comm.am_i_root()) {
+    REQUIRE (not std::ifstream(local_path).good());
+    std::remove(filename.c_str());
+  }
+}
+
+} // namespace unit_test
+} // namespace physics
+} // namespace scream
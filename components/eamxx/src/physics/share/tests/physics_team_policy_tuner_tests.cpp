@@ -0,0 +1,64 @@
+#include "catch2/catch.hpp"
+
+#include "physics/share/physics_team_policy_tuner.hpp"
+#include "share/scream_types.hpp"
+
+#include <fstream>
+
+namespace scream {
+namespace physics {
+namespace unit_test {
+
+TEST_CASE("team_policy_tuner", "physics")
+{
+  using KT = KokkosTypes<DefaultDevice>;
+  using MemberType = typename KT::MemberType;
+
+  const std::string cache_file = "team_policy_tuner_cache.txt";
+  {
+    std::ofstream ofs(cache_file);
+    ofs << "cached_kernel 10 4 128\n";
+  }
+
+  auto& tuner = TeamPolicyTuner::instance();
+  tuner.enable(cache_file,2);
+  REQUIRE (tuner.enabled());
+  REQUIRE (tuner.get_choice("cached_kernel",10,4)==128);
+  REQUIRE (tuner.get_choice("cached_kernel",10,5)==-1);
+
+  // The number of columns is bucketed by powers of 2
+  REQUIRE (tuner.get_choice("cached_kernel",9,4)==128);
+  REQUIRE (tuner.get_choice("cached_kernel",17,4)==-1);
+
+  // Results must not depend on the team size used (and on the tuning status)
+  const int ni = 10;
+  const int nk = 7;
+  KT::view_2d<Real> v("v",ni,nk);
+  for (int n=0; n<10; ++n) {
+    Kokkos::deep_copy(v,0);
+    tuner.parallel_for("tuned_kernel", ni, nk, KOKKOS_LAMBDA(const MemberType& team) {
+      const int i = team.league_rank();
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(team,nk),[&](const int k) {
+        v(i,k) = i*nk+k;
+      });
+    });
+    auto v_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),v);
+    for (int i=0; i<ni; ++i) {
+      for (int k=0; k<nk; ++k) {
+        REQUIRE (v_h(i,k)==i*nk+k);
+      }
+    }
+  }
+
+  // Choices (cached or tuned) survive a write/read cycle
+  tuner.write_cache();
+  tuner.enable(cache_file,2);
+  REQUIRE (tuner.get_choice("cached_kernel",10,4)==128);
+  if (ekat::OnGpu<KT::ExeSpace>::value) {
+    REQUIRE (tuner.get_choice("tuned_kernel",ni,nk)>0);
+  }
+}
+
+} // namespace unit_test
+} // namespace physics
+} // namespace scream
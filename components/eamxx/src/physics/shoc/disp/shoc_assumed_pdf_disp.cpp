@@ -1,6 +1,7 @@
 #include "shoc_functions.hpp"
 
 #include "ekat/kokkos/ekat_subview_utils.hpp"
+#include "physics/share/physics_team_policy_tuner.hpp"
 
 namespace scream {
 namespace shoc {
@@ -31,11 +32,9 @@ void Functions<Real,DefaultDevice>
   const view_2d<Spack>&       wthv_sec,
   const view_2d<Spack>&       shoc_ql2)
 {
-  using ExeSpace = typename KT::ExeSpace;
 
   const auto nlev_packs = ekat::npack<Spack>(nlev);
-  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(shcol, nlev_packs);
-  Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
+  physics::TeamPolicyTuner::instance().parallel_for("shoc_assumed_pdf", shcol, nlev_packs, KOKKOS_LAMBDA(const MemberType& team) {
     const Int i = team.league_rank();
 
     auto workspace = workspace_mgr.get_workspace(team);
@@ -1,6 +1,7 @@
 #include "shoc_functions.hpp"
 
 #include "ekat/kokkos/ekat_subview_utils.hpp"
+#include "physics/share/physics_team_policy_tuner.hpp"
 
 namespace scream {
 namespace shoc {
@@ -12,11 +13,9 @@ void Functions<Real,DefaultDevice>
   const Int& nlev,
   const view_2d<Spack>& tke)
 {
-  using ExeSpace = typename KT::ExeSpace;
 
   const auto nlev_packs = ekat::npack<Spack>(nlev);
-  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(shcol, nlev_packs);
-  Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
+  physics::TeamPolicyTuner::instance().parallel_for("shoc_check_tke", shcol, nlev_packs, KOKKOS_LAMBDA(const MemberType& team) {
     const Int i = team.league_rank();
 
     check_tke(team, nlev, ekat::subview(tke, i));
@@ -1,6 +1,7 @@
 #include "shoc_functions.hpp"
 
 #include "ekat/kokkos/ekat_subview_utils.hpp"
+#include "physics/share/physics_team_policy_tuner.hpp"
 
 namespace scream {
 namespace shoc {
@@ -15,11 +16,9 @@ void Functions<Real,DefaultDevice>
   const view_2d<const Spack>& inv_exner,
   const view_2d<Spack>&       tabs)
 {
-  using ExeSpace = typename KT::ExeSpace;
 
   const auto nlev_packs = ekat::npack<Spack>(nlev);
-  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(shcol, nlev_packs);
-  Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
+  physics::TeamPolicyTuner::instance().parallel_for("shoc_compute_shoc_temperature", shcol, nlev_packs, KOKKOS_LAMBDA(const MemberType& team) {
     const Int i = team.league_rank();
 
     compute_shoc_temperature(team, nlev,
@@ -1,6 +1,7 @@
 #include "shoc_functions.hpp"
 
 #include "ekat/kokkos/ekat_subview_utils.hpp"
+#include "physics/share/physics_team_policy_tuner.hpp"
 
 namespace scream {
 namespace shoc {
@@ -14,11 +15,9 @@ void Functions<Real,DefaultDevice>
   const view_2d<const Spack>& ql,
   const view_2d<Spack>&       qv)
 {
-  using ExeSpace = typename KT::ExeSpace;
 
   const auto nlev_packs = ekat::npack<Spack>(nlev);
-  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(shcol, nlev_packs);
-  Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
+  physics::TeamPolicyTuner::instance().parallel_for("shoc_compute_shoc_vapor", shcol, nlev_packs, KOKKOS_LAMBDA(const MemberType& team) {
     const Int i = team.league_rank();
 
     compute_shoc_vapor(team, nlev,
@@ -1,6 +1,7 @@
 #include "shoc_functions.hpp"
 
 #include "ekat/kokkos/ekat_subview_utils.hpp"
+#include "physics/share/physics_team_policy_tuner.hpp"
 
 namespace scream {
 namespace shoc {
@@ -39,11 +40,9 @@ void Functions<Real,DefaultDevice>
   const view_2d<Spack>& wtke_sec,
   const view_2d<Spack>& w_sec)
 {
-  using ExeSpace = typename KT::ExeSpace;
 
   const auto nlev_packs = ekat::npack<Spack>(nlev);
-  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(shcol, nlev_packs);
-  Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
+  physics::TeamPolicyTuner::instance().parallel_for("shoc_diag_second_shoc_moments", shcol, nlev_packs, KOKKOS_LAMBDA(const MemberType& team) {
     const Int i = team.league_rank();
 
     auto workspace = workspace_mgr.get_workspace(team);
@@ -1,6 +1,8 @@
 #include "shoc_functions.hpp"
 
 #include "ekat/kokkos/ekat_subview_utils.hpp"
+#include "physics/share/physics_team_policy_tuner.hpp"
+#include "physics/share/physics_batched_tridiag.hpp"
 
 namespace scream {
 namespace shoc {
@@ -26,6 +28,8 @@ void Functions<Real,DefaultDevice>
   const view_1d<const Scalar>& wqw_sfc,
   const view_2d<const Spack>&  wtracer_sfc,
   const WorkspaceMgr&          workspace_mgr,
+  const view_3d<Scalar>&       tridiag_diags,
+  const view_3d<Scalar>&       tridiag_rhs,
   const view_2d<Spack>&        thetal,
   const view_2d<Spack>&        qw,
   const view_3d<Spack>&        tracer,
@@ -33,11 +37,133 @@ void Functions<Real,DefaultDevice>
   const view_2d<Spack>&        u_wind,
   const view_2d<Spack>&        v_wind)
 {
-  using ExeSpace = typename KT::ExeSpace;
-
   const auto nlev_packs = ekat::npack<Spack>(nlev);
-  const auto policy = ekat::ExeSpaceUtils<ExeSpace>::get_default_team_policy(shcol, nlev_packs);
-  Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
+
+#ifndef EKAT_DEFAULT_BFB
+  // Rather than solving the tridiagonal systems within each team, set up all the
+  // systems first, and solve them with the batched solver, where consecutive
+  // threads handle consecutive columns.
+  using BT = physics::BatchedTridiag<Scalar>;
+  using Kokkos::ALL;
+
+  const auto wind_range = Kokkos::make_pair(0,2);
+  const auto trac_range = Kokkos::make_pair(2,num_tracer+5);
+  const typename BT::diag_view_t dl_wind = Kokkos::subview(tridiag_diags,0,ALL,ALL);
+  const typename BT::diag_view_t d_wind  = Kokkos::subview(tridiag_diags,1,ALL,ALL);
+  const typename BT::diag_view_t du_wind = Kokkos::subview(tridiag_diags,2,ALL,ALL);
+  const typename BT::diag_view_t dl_trac = Kokkos::subview(tridiag_diags,3,ALL,ALL);
+  const typename BT::diag_view_t d_trac  = Kokkos::subview(tridiag_diags,4,ALL,ALL);
+  const typename BT::diag_view_t du_trac = Kokkos::subview(tridiag_diags,5,ALL,ALL);
+  const typename BT::rhs_view_t  x_wind  = Kokkos::subview(tridiag_rhs,wind_range,ALL,ALL);
+  const typename BT::rhs_view_t  x_trac  = Kokkos::subview(tridiag_rhs,trac_range,ALL,ALL);
+
+  // Compute the matrices and the rhs
+  physics::TeamPolicyTuner::instance().parallel_for("shoc_update_prognostics_implicit_setup", shcol, nlev_packs, KOKKOS_LAMBDA(const MemberType& team) {
+    const Int i = team.league_rank();
+
+    auto workspace  = workspace_mgr.get_workspace(team);
+
+    uview_1d<Spack> tmpi, tkh_zi, tk_zi, rho_zi, rdp_zt;
+    uview_1d<Scalar> du_workspace, dl_workspace, d_workspace;
+    workspace.template take_many_contiguous_unsafe<5>(
+      {"tmpi", "tkh_zi", "tk_zi", "rho_zi", "rdp_zt"},
+      {&tmpi, &tkh_zi, &tk_zi, &rho_zi, &rdp_zt});
+    workspace.template take_many_contiguous_unsafe<3, Scalar>(
+      {"du_workspace", "dl_workspace", "d_workspace"},
+      {&du_workspace, &dl_workspace, &d_workspace});
+    auto du = Kokkos::subview(du_workspace, Kokkos::make_pair(0,nlev));
+    auto dl = Kokkos::subview(dl_workspace, Kokkos::make_pair(0,nlev));
+    auto d  = Kokkos::subview(d_workspace,  Kokkos::make_pair(0,nlev));
+
+    const auto thetal_i = ekat::subview(thetal, i);
+    const auto qw_i     = ekat::subview(qw, i);
+    const auto tracer_i = ekat::subview(tracer, i);
+    const auto tke_i    = ekat::subview(tke, i);
+    const auto u_wind_i = ekat::subview(u_wind, i);
+    const auto v_wind_i = ekat::subview(v_wind, i);
+
+    Scalar ksrf;
+    update_prognostics_implicit_setup(team, nlev, nlevi, num_tracer, dtime,
+                                      ekat::subview(dz_zt, i), ekat::subview(dz_zi, i),
+                                      ekat::subview(rho_zt, i), ekat::subview(zt_grid, i),
+                                      ekat::subview(zi_grid, i), ekat::subview(tk, i),
+                                      ekat::subview(tkh, i), uw_sfc(i), vw_sfc(i),
+                                      wthl_sfc(i), wqw_sfc(i), ekat::subview(wtracer_sfc, i),
+                                      tmpi, tkh_zi, tk_zi, rho_zi, rdp_zt,
+                                      thetal_i, qw_i, tracer_i, tke_i, u_wind_i, v_wind_i, ksrf);
+    team.team_barrier();
+
+    // Store the rhs
+    const auto u_wind_s = ekat::scalarize(u_wind_i);
+    const auto v_wind_s = ekat::scalarize(v_wind_i);
+    const auto thetal_s = ekat::scalarize(thetal_i);
+    const auto qw_s     = ekat::scalarize(qw_i);
+    const auto tke_s    = ekat::scalarize(tke_i);
+    const auto tracer_s = ekat::scalarize(tracer_i);
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nlev), [&] (const Int& k) {
+      x_wind(0,k,i) = u_wind_s(k);
+      x_wind(1,k,i) = v_wind_s(k);
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, num_tracer), [&] (const Int& q) {
+        x_trac(q,k,i) = tracer_s(q,k);
+      });
+      x_trac(num_tracer,  k,i) = thetal_s(k);
+      x_trac(num_tracer+1,k,i) = qw_s(k);
+      x_trac(num_tracer+2,k,i) = tke_s(k);
+    });
+
+    // Store the matrices
+    vd_shoc_decomp(team, nlev, tk_zi, tmpi, rdp_zt, dtime, ksrf, du, dl, d);
+    team.team_barrier();
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nlev), [&] (const Int& k) {
+      dl_wind(k,i) = dl(k);
+      d_wind(k,i)  = d(k);
+      du_wind(k,i) = du(k);
+    });
+    team.team_barrier();
+    vd_shoc_decomp(team, nlev, tkh_zi, tmpi, rdp_zt, dtime, 0, du, dl, d);
+    team.team_barrier();
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nlev), [&] (const Int& k) {
+      dl_trac(k,i) = dl(k);
+      d_trac(k,i)  = d(k);
+      du_trac(k,i) = du(k);
+    });
+
+    team.team_barrier();
+    workspace.template release_many_contiguous<3,Scalar>(
+      {&du_workspace, &dl_workspace, &d_workspace});
+    workspace.template release_many_contiguous<5>(
+      {&tmpi, &tkh_zi, &tk_zi, &rho_zi, &rdp_zt});
+  });
+
+  // Solve
+  BT::factor(dl_wind, d_wind, du_wind);
+  BT::factor(dl_trac, d_trac, du_trac);
+  BT::solve(dl_wind, d_wind, du_wind, x_wind);
+  BT::solve(dl_trac, d_trac, du_trac, x_trac);
+
+  // Copy the solutions back into the output variables
+  physics::TeamPolicyTuner::instance().parallel_for("shoc_update_prognostics_implicit_copy", shcol, nlev_packs, KOKKOS_LAMBDA(const MemberType& team) {
+    const Int i = team.league_rank();
+
+    const auto u_wind_s = ekat::scalarize(ekat::subview(u_wind, i));
+    const auto v_wind_s = ekat::scalarize(ekat::subview(v_wind, i));
+    const auto thetal_s = ekat::scalarize(ekat::subview(thetal, i));
+    const auto qw_s     = ekat::scalarize(ekat::subview(qw, i));
+    const auto tke_s    = ekat::scalarize(ekat::subview(tke, i));
+    const auto tracer_s = ekat::scalarize(ekat::subview(tracer, i));
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nlev), [&] (const Int& k) {
+      u_wind_s(k) = x_wind(0,k,i);
+      v_wind_s(k) = x_wind(1,k,i);
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, num_tracer), [&] (const Int& q) {
+        tracer_s(q,k) = x_trac(q,k,i);
+      });
+      thetal_s(k) = x_trac(num_tracer,  k,i);
+      qw_s(k)     = x_trac(num_tracer+1,k,i);
+      tke_s(k)    = x_trac(num_tracer+2,k,i);
+    });
+  });
+#else
+  physics::TeamPolicyTuner::instance().parallel_for("shoc_update_prognostics_implicit", shcol, nlev_packs, KOKKOS_LAMBDA(const MemberType& team) {
     const Int i = team.league_rank();
 
     auto workspace  = workspace_mgr.get_workspace(team);
@@ -63,6 +189,7 @@ void Functions<Real,DefaultDevice>
                                 ekat::subview(u_wind, i),
                                 ekat::subview(v_wind, i));
   });
+#endif
 }
 
 } // namespace shoc
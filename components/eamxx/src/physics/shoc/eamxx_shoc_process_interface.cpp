@@ -1,5 +1,6 @@
 #include "ekat/ekat_assert.hpp"
 #include "physics/shoc/eamxx_shoc_process_interface.hpp"
+#include "physics/share/physics_team_policy_tuner.hpp"
 
 #include "share/property_checks/field_lower_bound_check.hpp"
 #include "share/property_checks/field_within_interval_check.hpp"
@@ -149,7 +150,8 @@ size_t SHOCMacrophysics::requested_buffer_size_in_bytes() const
   const int num_tracer_packs = ekat::npack<Spack>(m_num_tracers);
 
   // Number of Reals needed by local views in the interface
-  const size_t interface_request = Buffer::num_1d_scalar_ncol*m_num_cols*sizeof(Real) +
+  // NOTE: the scalar views are padded, so that the packed views are aligned
+  const size_t interface_request = ATMBufferManager::align_bytes(Buffer::num_1d_scalar_ncol*m_num_cols*sizeof(Real)) +
                                    Buffer::num_1d_scalar_nlev*nlev_packs*sizeof(Spack) +
                                    Buffer::num_2d_vector_mid*m_num_cols*nlev_packs*sizeof(Spack) +
                                    Buffer::num_2d_vector_int*m_num_cols*nlevi_packs*sizeof(Spack) +
@@ -186,7 +188,7 @@ void SHOCMacrophysics::init_buffers(const ATMBufferManager &buffer_manager)
     mem += _1d_scalar_view_ptrs[i]->size();
   }
 
-  Spack* s_mem = reinterpret_cast<Spack*>(mem);
+  Spack* s_mem = reinterpret_cast<Spack*>(buffer_manager.align(mem));
 
   // 2d packed views
   const int nlev_packs       = ekat::npack<Spack>(m_num_levs);
@@ -258,6 +260,12 @@ void SHOCMacrophysics::initialize_impl (const RunType run_type)
   runtime_options.c_diag_3rd_mom = m_params.get<double>("c_diag_3rd_mom");
   runtime_options.Ckh           = m_params.get<double>("Ckh");
   runtime_options.Ckm           = m_params.get<double>("Ckm");
+
+  // Autotuning of the team size of the dispatch kernels (the tuner is shared with P3)
+  if (m_params.get<bool>("autotune_team_sizes",false)) {
+    physics::TeamPolicyTuner::instance().enable(m_params.get<std::string>("autotune_cache_file","none"),
+                                                m_params.get<int>("autotune_num_trials",3));
+  }
   // Initialize all of the structures that are passed to shoc_main in run_impl.
   // Note: Some variables in the structures are not stored in the field manager.  For these
   //       variables a local view is constructed.
@@ -390,6 +398,8 @@ void SHOCMacrophysics::initialize_impl (const RunType run_type)
   temporaries.tabs = m_buffer.tabs;
   temporaries.dz_zt = m_buffer.dz_zt;
   temporaries.dz_zi = m_buffer.dz_zi;
+  temporaries.tridiag_diags = SHF::view_3d<Real>("shoc_tridiag_diags", 6, m_num_levs, m_num_cols);
+  temporaries.tridiag_rhs   = SHF::view_3d<Real>("shoc_tridiag_rhs", m_num_tracers+5, m_num_levs, m_num_cols);
 #endif
 
   shoc_postprocess.set_variables(m_num_cols,m_num_levs,m_num_tracers,
@@ -553,7 +563,11 @@ void SHOCMacrophysics::run_impl (const double dt)
 // =========================================================================================
 void SHOCMacrophysics::finalize_impl()
 {
-  // Do nothing
+  // Save the team sizes picked by the tuner, so that later runs can skip tuning
+  auto& tuner = physics::TeamPolicyTuner::instance();
+  if (tuner.enabled() and m_comm.am_i_root()) {
+    tuner.write_cache();
+  }
 }
 // =========================================================================================
 void SHOCMacrophysics::apply_turbulent_mountain_stress()
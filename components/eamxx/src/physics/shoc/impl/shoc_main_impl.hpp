@@ -408,7 +408,9 @@ void Functions<S,D>::shoc_main_internal(
   const view_2d<Spack>& shoc_qv,
   const view_2d<Spack>& shoc_tabs,
   const view_2d<Spack>& dz_zt,
-  const view_2d<Spack>& dz_zi)
+  const view_2d<Spack>& dz_zi,
+  const view_3d<Scalar>& tridiag_diags,
+  const view_3d<Scalar>& tridiag_rhs)
 {
   // Scalarize some views for single entry access
   const auto s_thetal  = ekat::scalarize(thetal);
@@ -491,6 +493,7 @@ void Functions<S,D>::shoc_main_internal(
                                      dz_zi,rho_zt,zt_grid,zi_grid,tk,tkh,uw_sfc, // Input
                                      vw_sfc,wthl_sfc,wqw_sfc,wtracer_sfc,        // Input
                                      workspace_mgr,                              // Workspace mgr
+                                     tridiag_diags,tridiag_rhs,                  // Solver storage
                                      thetal,qw,qtracers,tke,u_wind,v_wind);      // Input/Output
 
     // Diagnose the second order moments
@@ -715,7 +718,8 @@ Int Functions<S,D>::shoc_main(
     shoc_temporaries.se_a, shoc_temporaries.ke_a, shoc_temporaries.wv_a, shoc_temporaries.wl_a,
     shoc_temporaries.kbfs, shoc_temporaries.ustar2,
     shoc_temporaries.wstar, shoc_temporaries.rho_zt, shoc_temporaries.shoc_qv,
-    shoc_temporaries.tabs, shoc_temporaries.dz_zt, shoc_temporaries.dz_zi);
+    shoc_temporaries.tabs, shoc_temporaries.dz_zt, shoc_temporaries.dz_zi,
+    shoc_temporaries.tridiag_diags, shoc_temporaries.tridiag_rhs);
 #endif
 
   auto finish = std::chrono::steady_clock::now();
@@ -13,7 +13,7 @@ namespace shoc {
 
 template<typename S, typename D>
 KOKKOS_FUNCTION
-void Functions<S,D>::update_prognostics_implicit(
+void Functions<S,D>::update_prognostics_implicit_setup(
   const MemberType&            team,
   const Int&                   nlev,
   const Int&                   nlevi,
@@ -31,60 +31,28 @@ void Functions<S,D>::update_prognostics_implicit(
   const Scalar&                wthl_sfc,
   const Scalar&                wqw_sfc,
   const uview_1d<const Spack>& wtracer_sfc,
-  const Workspace&             workspace,
+  const uview_1d<Spack>&       tmpi,
+  const uview_1d<Spack>&       tkh_zi,
+  const uview_1d<Spack>&       tk_zi,
+  const uview_1d<Spack>&       rho_zi,
+  const uview_1d<Spack>&       rdp_zt,
   const uview_1d<Spack>&       thetal,
   const uview_1d<Spack>&       qw,
   const uview_2d<Spack>&       qtracers,
   const uview_1d<Spack>&       tke,
   const uview_1d<Spack>&       u_wind,
-  const uview_1d<Spack>&       v_wind)
+  const uview_1d<Spack>&       v_wind,
+  Scalar&                      ksrf)
 {
-  // Define temporary variables via the WorkspaceManager
-
-  // 1d allocations
-  uview_1d<Spack> tmpi, tkh_zi,
-                  tk_zi, rho_zi,
-                  rdp_zt;
-  uview_1d<Scalar> du_workspace, dl_workspace, d_workspace;
-
-  workspace.template take_many_contiguous_unsafe<5>(
-    {"tmpi", "tkh_zi", "tk_zi", "rho_zi", "rdp_zt"},
-    {&tmpi, &tkh_zi, &tk_zi, &rho_zi, &rdp_zt});
-
-  workspace.template take_many_contiguous_unsafe<3, Scalar>(
-    {"du_workspace", "dl_workspace", "d_workspace"},
-    {&du_workspace, &dl_workspace, &d_workspace});
-  auto du = Kokkos::subview(du_workspace, Kokkos::make_pair(0,nlev));
-  auto dl = Kokkos::subview(dl_workspace, Kokkos::make_pair(0,nlev));
-  auto d  = Kokkos::subview(d_workspace,  Kokkos::make_pair(0,nlev));
-
-  // 2d allocations for solver RHS
-  const int num_wind_transpose_packs = ekat::npack<Spack>(2);
-  const int num_qtracers_transpose_packs = ekat::npack<Spack>(num_qtracers+3);
-
-  const int n_wind_slots = num_wind_transpose_packs*Spack::n;
-  const int n_trac_slots = num_qtracers_transpose_packs*Spack::n;
-
-  const auto wind_slot    = workspace.template take_macro_block<Scalar>("wind_slot",n_wind_slots);
-  const auto tracers_slot = workspace.template take_macro_block<Scalar>("tracers_slot",n_trac_slots);
-
-  // Reshape 2d views
-  const auto wind_rhs     = uview_2d<Spack>(reinterpret_cast<Spack*>(wind_slot.data()),
-                                            nlev, num_wind_transpose_packs);
-  const auto qtracers_rhs  = uview_2d<Spack>(reinterpret_cast<Spack*>(tracers_slot.data()),
-                                            nlev, num_qtracers_transpose_packs);
-
   // scalarized versions of some views will be needed
   const auto rdp_zt_s       = ekat::scalarize(rdp_zt);
   const auto rho_zi_s       = ekat::scalarize(rho_zi);
   const auto u_wind_s       = ekat::scalarize(u_wind);
   const auto v_wind_s       = ekat::scalarize(v_wind);
-  const auto wind_rhs_s     = ekat::scalarize(wind_rhs);
   const auto thetal_s       = ekat::scalarize(thetal);
   const auto qw_s           = ekat::scalarize(qw);
   const auto tke_s          = ekat::scalarize(tke);
   const auto qtracers_s     = ekat::scalarize(qtracers);
-  const auto qtracers_rhs_s = ekat::scalarize(qtracers_rhs);
   const auto wtracer_sfc_s  = ekat::scalarize(wtracer_sfc);
 
   // linearly interpolate tkh, tk, and air density onto the interface grids
@@ -107,7 +75,7 @@ void Functions<S,D>::update_prognostics_implicit(
 
   // compute terms needed for the implicit surface stress (ksrf)
   // and tke flux calc (wtke_sfc)
-  Scalar ksrf, wtke_sfc;
+  Scalar wtke_sfc;
   {
     const Scalar wsmin = 1;
     const Scalar ksrfmin = 1e-4;
@@ -144,6 +112,88 @@ void Functions<S,D>::update_prognostics_implicit(
       qtracers_s(q, nlev-1) += cmnfac*wtracer_sfc_s(q);
     });
   }
+}
+
+template<typename S, typename D>
+KOKKOS_FUNCTION
+void Functions<S,D>::update_prognostics_implicit(
+  const MemberType&            team,
+  const Int&                   nlev,
+  const Int&                   nlevi,
+  const Int&                   num_qtracers,
+  const Scalar&                dtime,
+  const uview_1d<const Spack>& dz_zt,
+  const uview_1d<const Spack>& dz_zi,
+  const uview_1d<const Spack>& rho_zt,
+  const uview_1d<const Spack>& zt_grid,
+  const uview_1d<const Spack>& zi_grid,
+  const uview_1d<const Spack>& tk,
+  const uview_1d<const Spack>& tkh,
+  const Scalar&                uw_sfc,
+  const Scalar&                vw_sfc,
+  const Scalar&                wthl_sfc,
+  const Scalar&                wqw_sfc,
+  const uview_1d<const Spack>& wtracer_sfc,
+  const Workspace&             workspace,
+  const uview_1d<Spack>&       thetal,
+  const uview_1d<Spack>&       qw,
+  const uview_2d<Spack>&       qtracers,
+  const uview_1d<Spack>&       tke,
+  const uview_1d<Spack>&       u_wind,
+  const uview_1d<Spack>&       v_wind)
+{
+  // Define temporary variables via the WorkspaceManager
+
+  // 1d allocations
+  uview_1d<Spack> tmpi, tkh_zi,
+                  tk_zi, rho_zi,
+                  rdp_zt;
+  uview_1d<Scalar> du_workspace, dl_workspace, d_workspace;
+
+  workspace.template take_many_contiguous_unsafe<5>(
+    {"tmpi", "tkh_zi", "tk_zi", "rho_zi", "rdp_zt"},
+    {&tmpi, &tkh_zi, &tk_zi, &rho_zi, &rdp_zt});
+
+  workspace.template take_many_contiguous_unsafe<3, Scalar>(
+    {"du_workspace", "dl_workspace", "d_workspace"},
+    {&du_workspace, &dl_workspace, &d_workspace});
+  auto du = Kokkos::subview(du_workspace, Kokkos::make_pair(0,nlev));
+  auto dl = Kokkos::subview(dl_workspace, Kokkos::make_pair(0,nlev));
+  auto d  = Kokkos::subview(d_workspace,  Kokkos::make_pair(0,nlev));
+
+  // 2d allocations for solver RHS
+  const int num_wind_transpose_packs = ekat::npack<Spack>(2);
+  const int num_qtracers_transpose_packs = ekat::npack<Spack>(num_qtracers+3);
+
+  const int n_wind_slots = num_wind_transpose_packs*Spack::n;
+  const int n_trac_slots = num_qtracers_transpose_packs*Spack::n;
+
+  const auto wind_slot    = workspace.template take_macro_block<Scalar>("wind_slot",n_wind_slots);
+  const auto tracers_slot = workspace.template take_macro_block<Scalar>("tracers_slot",n_trac_slots);
+
+  // Reshape 2d views
+  const auto wind_rhs     = uview_2d<Spack>(reinterpret_cast<Spack*>(wind_slot.data()),
+                                            nlev, num_wind_transpose_packs);
+  const auto qtracers_rhs  = uview_2d<Spack>(reinterpret_cast<Spack*>(tracers_slot.data()),
+                                            nlev, num_qtracers_transpose_packs);
+
+  // scalarized versions of some views will be needed
+  const auto u_wind_s       = ekat::scalarize(u_wind);
+  const auto v_wind_s       = ekat::scalarize(v_wind);
+  const auto wind_rhs_s     = ekat::scalarize(wind_rhs);
+  const auto thetal_s       = ekat::scalarize(thetal);
+  const auto qw_s           = ekat::scalarize(qw);
+  const auto tke_s          = ekat::scalarize(tke);
+  const auto qtracers_s     = ekat::scalarize(qtracers);
+  const auto qtracers_rhs_s = ekat::scalarize(qtracers_rhs);
+
+  // Compute the terms of the implicit solves, and apply the surface fluxes
+  Scalar ksrf;
+  update_prognostics_implicit_setup(team, nlev, nlevi, num_qtracers, dtime,
+                                    dz_zt, dz_zi, rho_zt, zt_grid, zi_grid, tk, tkh,
+                                    uw_sfc, vw_sfc, wthl_sfc, wqw_sfc, wtracer_sfc,
+                                    tmpi, tkh_zi, tk_zi, rho_zi, rdp_zt,
+                                    thetal, qw, qtracers, tke, u_wind, v_wind, ksrf);
 
   // Store RHS values in wind_rhs and qtracers_rhs for 1st and 2nd solve respectively
   team.team_barrier();
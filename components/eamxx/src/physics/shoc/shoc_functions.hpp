@@ -225,6 +225,12 @@ struct Functions
     view_2d<Spack> dz_zt;
     view_2d<Spack> dz_zi;
     view_2d<Spack> tkh;
+
+    // Storage for the batched implicit solves of update_prognostics_implicit_disp:
+    // the diagonals of the momentum and thermo systems, (6,nlev,shcol), and the
+    // rhs (u, v, tracers, thetal, qw, tke), (num_qtracers+5,nlev,shcol).
+    view_3d<Scalar> tridiag_diags;
+    view_3d<Scalar> tridiag_rhs;
   };
 #endif
 
@@ -624,6 +630,41 @@ struct Functions
     const view_2d<Spack>&       tabs);
 #endif
 
+  // The part of update_prognostics_implicit preceding the solves: computes the
+  // interface quantities needed by vd_shoc_decomp, and the implicit surface
+  // stress (ksrf), and applies the explicit surface fluxes.
+  KOKKOS_FUNCTION
+  static void update_prognostics_implicit_setup(
+    const MemberType&            team,
+    const Int&                   nlev,
+    const Int&                   nlevi,
+    const Int&                   num_tracer,
+    const Scalar&                dtime,
+    const uview_1d<const Spack>& dz_zt,
+    const uview_1d<const Spack>& dz_zi,
+    const uview_1d<const Spack>& rho_zt,
+    const uview_1d<const Spack>& zt_grid,
+    const uview_1d<const Spack>& zi_grid,
+    const uview_1d<const Spack>& tk,
+    const uview_1d<const Spack>& tkh,
+    const Scalar&                uw_sfc,
+    const Scalar&                vw_sfc,
+    const Scalar&                wthl_sfc,
+    const Scalar&                wqw_sfc,
+    const uview_1d<const Spack>& wtracer_sfc,
+    const uview_1d<Spack>&       tmpi,
+    const uview_1d<Spack>&       tkh_zi,
+    const uview_1d<Spack>&       tk_zi,
+    const uview_1d<Spack>&       rho_zi,
+    const uview_1d<Spack>&       rdp_zt,
+    const uview_1d<Spack>&       thetal,
+    const uview_1d<Spack>&       qw,
+    const uview_2d<Spack>&       tracer,
+    const uview_1d<Spack>&       tke,
+    const uview_1d<Spack>&       u_wind,
+    const uview_1d<Spack>&       v_wind,
+    Scalar&                      ksrf);
+
   KOKKOS_FUNCTION
   static void update_prognostics_implicit(
     const MemberType&            team,
@@ -670,6 +711,8 @@ struct Functions
     const view_1d<const Scalar>& wqw_sfc,
     const view_2d<const Spack>&  wtracer_sfc,
     const WorkspaceMgr&          workspace_mgr,
+    const view_3d<Scalar>&       tridiag_diags,
+    const view_3d<Scalar>&       tridiag_rhs,
     const view_2d<Spack>&        thetal,
     const view_2d<Spack>&        qw,
     const view_3d<Spack>&        tracer,
@@ -1148,7 +1191,9 @@ struct Functions
     const view_2d<Spack>& shoc_qv,
     const view_2d<Spack>& tabs,
     const view_2d<Spack>& dz_zt,
-    const view_2d<Spack>& dz_zi);
+    const view_2d<Spack>& dz_zi,
+    const view_3d<Scalar>& tridiag_diags,
+    const view_3d<Scalar>& tridiag_rhs);
 #endif
 
   // Return microseconds elapsed
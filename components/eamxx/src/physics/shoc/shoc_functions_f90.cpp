@@ -2913,6 +2913,8 @@ Int shoc_main_f(Int shcol, Int nlev, Int nlevi, Real dtime, Int nadv, Int npbl,
   SHF::SHOCTemporaries shoc_temporaries{
     se_b, ke_b, wv_b, wl_b, se_a, ke_a, wv_a, wl_a, kbfs, ustar2, wstar,
     rho_zt, shoc_qv, tabs, dz_zt, dz_zi};
+  shoc_temporaries.tridiag_diags = SHF::view_3d<Real>("tridiag_diags", 6, nlev, shcol);
+  shoc_temporaries.tridiag_rhs   = SHF::view_3d<Real>("tridiag_rhs", num_qtracers+5, nlev, shcol);
 #endif
 
   // Create local workspace
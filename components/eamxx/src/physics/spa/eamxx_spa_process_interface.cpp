@@ -18,6 +18,15 @@ SPA::SPA (const ekat::Comm& comm, const ekat::ParameterList& params)
 {
   EKAT_REQUIRE_MSG(m_params.isParameter("spa_data_file"),
       "ERROR: spa_data_file is missing from SPA parameter list.");
+
+  m_update_frequency = m_params.get<int>("spa_update_frequency",1);
+  m_p_mid_tolerance  = m_params.get<double>("spa_p_mid_tolerance",0);
+  EKAT_REQUIRE_MSG(m_update_frequency>0,
+      "Error! Invalid value for spa_update_frequency (must be positive).\n"
+      " - spa_update_frequency: " + std::to_string(m_update_frequency) + "\n");
+  EKAT_REQUIRE_MSG(m_p_mid_tolerance>=0,
+      "Error! Invalid value for spa_p_mid_tolerance (must be non-negative).\n"
+      " - spa_p_mid_tolerance: " + std::to_string(m_p_mid_tolerance) + "\n");
 }
 
 // =========================================================================================
@@ -226,6 +235,10 @@ void SPA::initialize_impl (const RunType /* run_type */)
   const int curr_month = timestamp().get_month()-1; // 0-based
   SPAFunc::update_spa_data_from_file(SPADataReader,SPAIOPDataReader,timestamp(),curr_month,*SPAHorizInterp,SPAData_end);
 
+  if (m_p_mid_tolerance>0) {
+    m_p_mid_last = view_2d("p_mid_last",m_num_cols,ekat::npack<Spack>(m_num_levs));
+  }
+
   // 6. Set property checks for fields in this process
   using Interval = FieldWithinIntervalCheck;
   const auto eps = std::numeric_limits<double>::epsilon();
@@ -249,9 +262,50 @@ void SPA::run_impl (const double dt)
     SPAFunc::update_spa_timestate(SPADataReader,SPAIOPDataReader,ts,*SPAHorizInterp,SPATimeState,SPAData_start,SPAData_end);
 
   // Call the main SPA routine to get interpolated aerosol forcings.
+  // Note: the horizontally remapped data of the two months is already stored in
+  //       SPAData_start/SPAData_end, so we only need to interpolate in time and in
+  //       the vertical, and even that can be skipped if the outputs are still good.
   const auto& pmid_tgt = get_field_in("p_mid").get_view<const Spack**>();
+  if (not needs_update(pmid_tgt)) {
+    return;
+  }
   SPAFunc::spa_main(SPATimeState, pmid_tgt, m_buffer.p_mid_src,
                     SPAData_start,SPAData_end,m_buffer.spa_temp,SPAData_out);
+  if (m_p_mid_tolerance>0) {
+    Kokkos::deep_copy(m_p_mid_last,pmid_tgt);
+  }
+  ++m_num_updates;
+}
+
+// =========================================================================================
+bool SPA::needs_update (const SPAFunc::view_2d<const Spack>& p_mid) const
+{
+  // Always compute at the first call, and then every m_update_frequency steps.
+  // Note: this is the same criterion used by RRTMGP for its rad_frequency, so that
+  //       with spa_update_frequency=rad_frequency, SPA outputs are fresh at every
+  //       step where they are actually used.
+  const int nstep = timestamp().get_num_steps();
+  if (m_num_updates==0 or nstep % m_update_frequency == 0) {
+    return true;
+  }
+  if (m_p_mid_tolerance<=0) {
+    return false;
+  }
+
+  // Check the max relative change of p_mid since the last update
+  const int nlevs = m_num_levs;
+  const auto p_new = ekat::scalarize(p_mid);
+  const auto p_old = ekat::scalarize(m_p_mid_last);
+  Real max_change = 0;
+  Kokkos::parallel_reduce("SPA::p_mid_change",
+                          Kokkos::RangePolicy<typename KT::ExeSpace>(0,m_num_cols*nlevs),
+                          KOKKOS_LAMBDA(const int idx, Real& lmax) {
+    const int icol = idx / nlevs;
+    const int ilev = idx % nlevs;
+    const Real change = std::abs(p_new(icol,ilev)-p_old(icol,ilev)) / p_old(icol,ilev);
+    lmax = change>lmax ? change : lmax;
+  },Kokkos::Max<Real>(max_change));
+  return max_change>m_p_mid_tolerance;
 }
 
 // =========================================================================================
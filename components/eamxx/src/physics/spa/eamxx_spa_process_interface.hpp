@@ -52,6 +52,14 @@ public:
     // Temporary to use
     uview_2d<Spack> p_mid_src;
   };
+
+#ifndef KOKKOS_ENABLE_CUDA
+  // Cuda requires methods enclosing __device__ lambda's to be public
+protected:
+#endif
+  // Whether the SPA outputs need to be recomputed at this step
+  bool needs_update (const SPAFunc::view_2d<const Spack>& p_mid) const;
+
 protected:
 
   // The three main overrides for the subcomponent
@@ -74,6 +82,14 @@ protected:
   int m_nswbands = 14;
   int m_nlwbands = 16;
 
+  // The time/vertical interpolation is recomputed every m_update_frequency steps, and,
+  // if m_p_mid_tolerance>0, also whenever the max relative change of p_mid since
+  // the last update exceeds the tolerance. Between updates, the outputs are not changed.
+  int  m_update_frequency;
+  Real m_p_mid_tolerance;
+  int  m_num_updates = 0;
+  view_2d m_p_mid_last;   // The p_mid used at the last update (if m_p_mid_tolerance>0)
+
   // Struct which contains temporary variables used during spa_main
   Buffer m_buffer;
 
@@ -13,12 +13,36 @@ struct ATMBufferManager {
   template <typename S>
   using view_1d = typename KokkosTypes<DefaultDevice>::template view_1d<S>;
 
+  // Alignment (in bytes) of the regions given to each process, and of the sub-buffers
+  // obtained with align(). This matches the alignment of Kokkos allocations.
+  static constexpr size_t alignment = 64;
+
   ATMBufferManager()
   {
     m_size      = 0;
     m_allocated = false;
   }
 
+  // A manager exposing only the bytes [offset,offset+num_bytes) of the input one.
+  // Groups use this to give disjoint memory to processes that may run concurrently.
+  ATMBufferManager (const ATMBufferManager& parent, const size_t offset, const size_t num_bytes)
+  {
+    EKAT_REQUIRE_MSG (parent.allocated(),
+        "Error! Cannot create a sub-buffer of a buffer that is not allocated.\n");
+    EKAT_REQUIRE_MSG (offset%alignment==0 and num_bytes%sizeof(Real)==0,
+        "Error! Sub-buffer offset must be aligned, and its size divisible by sizeof(Real).\n");
+    EKAT_REQUIRE_MSG (offset+num_bytes<=parent.allocated_bytes(),
+        "Error! Sub-buffer exceeds the parent buffer size.\n"
+        "  - offset     : " + std::to_string(offset) + "\n"
+        "  - num bytes  : " + std::to_string(num_bytes) + "\n"
+        "  - parent size: " + std::to_string(parent.allocated_bytes()) + "\n");
+
+    const size_t beg = offset/sizeof(Real);
+    m_size      = num_bytes/sizeof(Real);
+    m_buffer    = Kokkos::subview(parent.m_buffer,Kokkos::make_pair(beg,beg+m_size));
+    m_allocated = true;
+  }
+
   ~ATMBufferManager() = default;
 
   // Each ATM process should request the number of bytes
@@ -35,6 +59,21 @@ struct ATMBufferManager {
 
   Real* get_memory () const { return m_buffer.data(); }
 
+  // Round up the input number of bytes to a multiple of the alignment
+  static size_t align_bytes (const size_t num_bytes) {
+    return ((num_bytes+alignment-1)/alignment)*alignment;
+  }
+
+  // Advance a pointer inside the buffer to the next aligned position. Processes
+  // can use this to start packed views after scalar ones (accounting for the
+  // padding with align_bytes when computing their request).
+  template<typename T>
+  T* align (T* ptr) const {
+    const auto beg = reinterpret_cast<const char*>(get_memory());
+    const size_t pos = reinterpret_cast<const char*>(ptr) - beg;
+    return reinterpret_cast<T*>(const_cast<char*>(beg) + align_bytes(pos));
+  }
+
   size_t allocated_bytes () const { return m_size*sizeof(Real); }
 
   void allocate () {
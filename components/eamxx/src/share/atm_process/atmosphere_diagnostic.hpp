@@ -55,6 +55,11 @@ public:
   // we need to compute tendencies, or accumulated stuff)
   virtual void init_timestep (const util::TimeStamp& /* start_of_step */) {}
 
+  // Output streams that accumulate the diagnostic over several steps call this before
+  // each evaluation, with is_write_step=true if this evaluation is written (as output
+  // or checkpoint). Allows diags to only produce their accumulated value at write steps.
+  virtual void set_write_step (const bool /* is_write_step */) {}
+
   void compute_diagnostic (const double dt = 0);
 protected:
 
@@ -5,6 +5,7 @@
 
 #include "ekat/ekat_assert.hpp"
 
+#include <fstream>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -59,11 +60,29 @@ AtmosphereProcess (const ekat::Comm& comm, const ekat::ParameterList& params)
 
   m_repair_log_level = str2LogLevel(m_params.get<std::string>("repair_log_level","warn"));
 
+  m_batch_property_checks = m_params.get<bool>("batch_property_checks",false);
+
+  auto& pcp = m_property_check_policy;
+  pcp.frequency        = m_params.get<int>("property_checks_frequency",pcp.frequency);
+  pcp.column_stride    = m_params.get<int>("property_checks_column_stride",pcp.column_stride);
+  pcp.escalation_steps = m_params.get<int>("property_checks_escalation_steps",pcp.escalation_steps);
+  pcp.json_log_file    = m_params.get<std::string>("property_checks_json_log",pcp.json_log_file);
+  EKAT_REQUIRE_MSG (pcp.frequency>0 and pcp.column_stride>0 and pcp.escalation_steps>=0,
+      "Error! Invalid property checks policy in param list " + m_params.name() + ".\n"
+      "  - property_checks_frequency       : " + std::to_string(pcp.frequency) + "\n"
+      "  - property_checks_column_stride   : " + std::to_string(pcp.column_stride) + "\n"
+      "  - property_checks_escalation_steps: " + std::to_string(pcp.escalation_steps) + "\n");
+
   // Info for mass and energy conservation checks
   m_column_conservation_check_data.has_check =
       m_params.get<bool>("enable_column_conservation_checks", false);
 
   m_internal_diagnostics_level = m_params.get<int>("internal_diagnostics_level", 0);
+
+  m_bfb_hash_frequency = m_params.get<int>("bfb_hash_frequency", 0);
+  EKAT_REQUIRE_MSG (m_bfb_hash_frequency>=0,
+      "Error! Invalid bfb_hash_frequency in param list " + m_params.name() + ".\n"
+      "  - bfb_hash_frequency: " + std::to_string(m_bfb_hash_frequency) + "\n");
 }
 
 void AtmosphereProcess::initialize (const TimeStamp& t0, const RunType run_type) {
@@ -89,7 +108,19 @@ void AtmosphereProcess::initialize (const TimeStamp& t0, const RunType run_type)
 void AtmosphereProcess::run (const double dt) {
   m_atm_logger->debug("[EAMxx::" + this->name() + "] run...");
   start_timer (m_timer_prefix + this->name() + "::run");
-  if (m_params.get("enable_precondition_checks", true)) {
+
+  // Establish whether property checks run at this step, and on which columns.
+  // After a failure, we run full checks for a few steps.
+  const auto& pcp = m_property_check_policy;
+  const bool escalated_checks = m_property_checks_escalation_left>0;
+  if (escalated_checks) {
+    --m_property_checks_escalation_left;
+  }
+  const bool run_checks = escalated_checks or m_property_checks_step%pcp.frequency==0;
+  m_property_checks_col_stride = escalated_checks ? 1 : pcp.column_stride;
+  m_property_checks_col_phase  = (m_property_checks_step/pcp.frequency) % m_property_checks_col_stride;
+
+  if (run_checks and m_params.get("enable_precondition_checks", true)) {
     // Run 'pre-condition' property checks stored in this AP
     run_precondition_checks();
   }
@@ -129,16 +160,23 @@ void AtmosphereProcess::run (const double dt) {
   // Complete tendency calculations (if any)
   compute_step_tendencies(dt);
 
-  if (m_params.get("enable_postcondition_checks", true)) {
+  if (run_checks and m_params.get("enable_postcondition_checks", true)) {
     // Run 'post-condition' property checks stored in this AP
     run_postcondition_checks();
   }
+  ++m_property_checks_step;
 
   m_time_stamp += dt;
   if (m_update_time_stamps) {
     // Update all output fields time stamps
     update_time_stamps ();
   }
+
+  // Groups only dispatch to their procs, which log their own hashes
+  if (m_bfb_hash_frequency>0 and this->type()!=AtmosphereProcessType::Group and
+      m_time_stamp.get_num_steps()%m_bfb_hash_frequency==0) {
+    log_output_fields_hash();
+  }
   stop_timer (m_timer_prefix + this->name() + "::run");
 }
 
@@ -362,6 +400,53 @@ void AtmosphereProcess::set_computed_group (const FieldGroup& group) {
   set_computed_group_impl(group);
 }
 
+void AtmosphereProcess::
+log_property_check_failure (const PropertyCheck& property_check,
+                            const PropertyCheck::ResultAndMsg& res_and_msg,
+                            const std::string& pre_post_str) const
+{
+  const auto& fname = m_property_check_policy.json_log_file;
+  if (fname=="" or fname=="none") {
+    return;
+  }
+
+  auto json_str = [](const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+      switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n";  break;
+        case '\t': out += "\\t";  break;
+        default:   out += c;
+      }
+    }
+    return out + "\"";
+  };
+
+  std::ostringstream ss;
+  ss << "{\"process\": " << json_str(name())
+     << ", \"check\": " << json_str(property_check.name())
+     << ", \"category\": " << json_str(pre_post_str)
+     << ", \"result\": " << json_str(res_and_msg.result==CheckResult::Fail ? "Fail" : "Repairable")
+     << ", \"timestamp\": " << json_str(m_time_stamp.to_string())
+     << ", \"step\": " << m_property_checks_step
+     << ", \"rank\": " << m_comm.rank()
+     << ", \"fail_loc_tags\": [";
+  for (size_t i=0; i<res_and_msg.fail_loc_tags.size(); ++i) {
+    ss << (i>0 ? ", " : "") << json_str(e2str(res_and_msg.fail_loc_tags[i]));
+  }
+  ss << "], \"fail_loc_indices\": [";
+  for (size_t i=0; i<res_and_msg.fail_loc_indices.size(); ++i) {
+    ss << (i>0 ? ", " : "") << res_and_msg.fail_loc_indices[i];
+  }
+  ss << "], \"message\": " << json_str(res_and_msg.msg) << "}\n";
+
+  // One file per rank, so that ranks do not need to coordinate
+  std::ofstream ofs (fname + "." + std::to_string(m_comm.rank()), std::ios::app);
+  ofs << ss.str();
+}
+
 void AtmosphereProcess::run_property_check (const prop_check_ptr&       property_check,
                                             const CheckFailHandling     check_fail_handling,
                                             const PropertyCheckCategory property_check_category) const {
@@ -373,6 +458,12 @@ void AtmosphereProcess::run_property_check (const prop_check_ptr&       property
   if (property_check_category == PropertyCheckCategory::Precondition)  pre_post_str = "pre-condition";
   if (property_check_category == PropertyCheckCategory::Postcondition) pre_post_str = "post-condition";
 
+  if (res_and_msg.result!=CheckResult::Pass) {
+    // Run full checks for the next few steps, and keep a record of the failure
+    m_property_checks_escalation_left = m_property_check_policy.escalation_steps;
+    log_property_check_failure(*property_check,res_and_msg,pre_post_str);
+  }
+
   if (res_and_msg.result==CheckResult::Pass) {
     // Do nothing
   } else if (res_and_msg.result==CheckResult::Repairable) {
@@ -457,14 +548,36 @@ void AtmosphereProcess::run_property_check (const prop_check_ptr&       property
   }
 }
 
+void AtmosphereProcess::
+run_property_checks (const std::list<std::pair<CheckFailHandling,prop_check_ptr>>& checks,
+                     std::shared_ptr<PropertyCheckBatch>& batch,
+                     const PropertyCheckCategory property_check_category) const
+{
+  if (m_batch_property_checks) {
+    if (batch==nullptr) {
+      batch = std::make_shared<PropertyCheckBatch>();
+      for (const auto& it : checks) {
+        batch->add(it.second);
+      }
+    }
+    batch->run(m_property_checks_col_stride,m_property_checks_col_phase);
+  }
+
+  // Checks that passed in the batch need not be run again. The others
+  // are run individually, to get the failure info and/or repair the fields.
+  for (const auto& it : checks) {
+    if (batch==nullptr or not batch->passed(*it.second)) {
+      run_property_check(it.second, it.first, property_check_category);
+    }
+  }
+}
+
 void AtmosphereProcess::run_precondition_checks () const {
   m_atm_logger->debug("[" + this->name() + "] run_precondition_checks...");
   start_timer(m_timer_prefix + this->name() + "::run-precondition-checks");
   // Run all pre-condition property checks
-  for (const auto& it : m_precondition_checks) {
-    run_property_check(it.second, it.first,
-                       PropertyCheckCategory::Precondition);
-  }
+  run_property_checks(m_precondition_checks,m_precondition_checks_batch,
+                      PropertyCheckCategory::Precondition);
   stop_timer(m_timer_prefix + this->name() + "::run-precondition-checks");
   m_atm_logger->debug("[" + this->name() + "] run_precondition_checks...done!");
 }
@@ -473,10 +586,8 @@ void AtmosphereProcess::run_postcondition_checks () const {
   m_atm_logger->debug("[" + this->name() + "] run_postcondition_checks...");
   start_timer(m_timer_prefix + this->name() + "::run-postcondition-checks");
   // Run all post-condition property checks
-  for (const auto& it : m_postcondition_checks) {
-    run_property_check(it.second, it.first,
-                       PropertyCheckCategory::Postcondition);
-  }
+  run_property_checks(m_postcondition_checks,m_postcondition_checks_batch,
+                      PropertyCheckCategory::Postcondition);
   stop_timer(m_timer_prefix + this->name() + "::run-postcondition-checks");
   m_atm_logger->debug("[" + this->name() + "] run_postcondition_checks...done!");
 }
@@ -733,6 +844,7 @@ add_precondition_check (const prop_check_ptr& pc, const CheckFailHandling cfh)
         "  - Property check name: " + pc->name() + "\n");
   }
   m_precondition_checks.push_back(std::make_pair(cfh,pc));
+  m_precondition_checks_batch = nullptr;
 }
 
 void AtmosphereProcess::
@@ -780,6 +892,7 @@ add_postcondition_check (const prop_check_ptr& pc, const CheckFailHandling cfh)
         "  - Property check name: " + pc->name() + "\n");
   }
   m_postcondition_checks.push_back(std::make_pair(cfh,pc));
+  m_postcondition_checks_batch = nullptr;
 }
 
 void AtmosphereProcess::
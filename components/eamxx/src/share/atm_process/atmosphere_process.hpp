@@ -8,6 +8,7 @@
 #include "share/field/field_identifier.hpp"
 #include "share/field/field_manager.hpp"
 #include "share/property_checks/property_check.hpp"
+#include "share/property_checks/property_check_batch.hpp"
 #include "share/field/field_request.hpp"
 #include "share/field/field.hpp"
 #include "share/field/field_group.hpp"
@@ -77,6 +78,7 @@ public:
   using ci_string = ekat::CaseInsensitiveString;
   using logger_t  = ekat::logger::LoggerBase;
   using LogLevel  = ekat::logger::LogLevel;
+  using exec_space = KokkosTypes<DefaultDevice>::ExeSpace;
 
   template<typename T>
   using strmap_t = std::map<std::string,T>;
@@ -277,12 +279,23 @@ public:
                                const bool out = true, const bool internal = true) const;
   // For BFB tracking in production simulations.
   void print_fast_global_state_hash(const std::string& label) const;
+  // Log a global hash of all output fields (see 'bfb_hash_frequency' param).
+  // The hash is computed in a single kernel, and does not change if the MPI
+  // decomposition changes.
+  void log_output_fields_hash() const;
 
   // Set IOP object
   virtual void set_iop(const iop_ptr& iop) {
     m_iop = iop;
   }
 
+  // The execution space instance on which this process should launch its kernels.
+  // It is the default instance, unless the process is run concurrently with other
+  // processes by a group with Parallel schedule, in which case each process of the
+  // group gets its own instance (e.g., its own CUDA/HIP stream).
+  void set_execution_space (const exec_space& es) { m_exec_space = es; }
+  const exec_space& get_execution_space () const { return m_exec_space; }
+
   std::shared_ptr<logger_t> get_logger () const {
     return m_atm_logger;
   }
@@ -510,6 +523,17 @@ private:
   // check: dt, tolerance, current mass and energy value per column.
   void compute_column_conservation_checks_data (const int dt);
 
+  // Run a list of property checks. If batching is enabled, the checks that can be batched
+  // are first evaluated all at once, and only those that did not pass are run individually.
+  void run_property_checks (const std::list<std::pair<CheckFailHandling,prop_check_ptr>>& checks,
+                            std::shared_ptr<PropertyCheckBatch>& batch,
+                            const PropertyCheckCategory property_check_category) const;
+
+  // Append a record of a failed/repaired property check to the JSON log (if any)
+  void log_property_check_failure (const PropertyCheck& property_check,
+                                   const PropertyCheck::ResultAndMsg& res_and_msg,
+                                   const std::string& pre_post_str) const;
+
   // Run an individual property check. The input property_check_category_name
   void run_property_check (const prop_check_ptr&       property_check,
                            const CheckFailHandling     check_fail_handling,
@@ -551,6 +575,20 @@ private:
   std::list<std::pair<CheckFailHandling,prop_check_ptr>> m_precondition_checks;
   std::list<std::pair<CheckFailHandling,prop_check_ptr>> m_postcondition_checks;
 
+  // If enabled, batches of the pre/postcondition checks above, built on first use
+  bool                                        m_batch_property_checks;
+  mutable std::shared_ptr<PropertyCheckBatch> m_precondition_checks_batch;
+  mutable std::shared_ptr<PropertyCheckBatch> m_postcondition_checks_batch;
+
+  // How often pre/postcondition checks are run, and the current state of the policy:
+  // number of calls to run(), number of steps left with escalated (full) checks,
+  // and the column subset inspected by batched checks in the current step.
+  PropertyCheckPolicy                         m_property_check_policy;
+  int                                         m_property_checks_step = 0;
+  mutable int                                 m_property_checks_escalation_left = 0;
+  int                                         m_property_checks_col_stride = 1;
+  int                                         m_property_checks_col_phase = 0;
+
   // Column local mass and energy conservation check
   std::pair<CheckFailHandling,prop_check_ptr> m_column_conservation_check;
 
@@ -578,6 +616,9 @@ private:
   // Whether we need to update time stamps at the end of the run method
   bool m_update_time_stamps = true;
 
+  // The execution space instance for the kernels of this process
+  exec_space m_exec_space;
+
   // Whether this atm proc should compute tendencies for any of its updated fields
   bool m_compute_proc_tendencies = false;
 
@@ -587,6 +628,9 @@ private:
   // Controls global hashing output for debugging non-BFBness.
   int m_internal_diagnostics_level;
 
+  // Frequency (in steps) of the output fields hash logging (0 means never)
+  int m_bfb_hash_frequency;
+
 protected:
 
   // IOP object
@@ -347,9 +347,9 @@ void AtmProcDAG::
 add_nodes (const group_type& atm_procs)
 {
   const int num_procs = atm_procs.get_num_processes();
-  const bool sequential = (atm_procs.get_schedule_type()==ScheduleType::Sequential);
-
-  EKAT_REQUIRE_MSG (sequential, "Error! Parallel splitting dag not yet supported.\n");
+  // NOTE: the processes of a group with Parallel schedule are independent
+  //       (no process computes what another requires or computes), so their
+  //       nodes can be added in the order of the group, like sequential ones.
 
   for (int i=0; i<num_procs; ++i) {
     const auto proc = atm_procs.get_process(i);
@@ -6,7 +6,9 @@
 #include "ekat/std_meta/ekat_std_utils.hpp"
 #include "ekat/util/ekat_string_utils.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
 
 namespace scream {
 
@@ -24,7 +26,6 @@ AtmosphereProcessGroup (const ekat::Comm& comm, const ekat::ParameterList& param
       m_group_schedule_type = ScheduleType::Sequential;
     } else if (m_params.get<std::string>("schedule_type") == "Parallel") {
       m_group_schedule_type = ScheduleType::Parallel;
-      ekat::error::runtime_abort("Error! Parallel schedule not yet implemented.\n");
     } else {
       ekat::error::runtime_abort("Error! Invalid 'schedule_type'. Available choices are 'Parallel' and 'Sequential'.\n");
     }
@@ -33,6 +34,13 @@ AtmosphereProcessGroup (const ekat::Comm& comm, const ekat::ParameterList& param
     m_group_schedule_type = ScheduleType::Sequential;
   }
 
+  if (m_group_schedule_type==ScheduleType::Sequential && m_group_size>1) {
+    m_async_scheduling = m_params.get<bool>("enable_async_scheduling",false);
+  }
+  if (m_group_schedule_type==ScheduleType::Parallel) {
+    m_lagged_coupling = m_params.get<bool>("lagged_coupling",false);
+  }
+
   // Create the individual atmosphere processes
   m_group_name = params.name();
 
@@ -46,25 +54,10 @@ AtmosphereProcessGroup (const ekat::Comm& comm, const ekat::ParameterList& param
   // so we don't expect users to register the APG in the factory.
   apf.register_product("group",&create_atmosphere_process<AtmosphereProcessGroup>);
   for (const auto& ap_name : group_list) {
-    // The comm to be passed to the processes construction is
-    //  - the same as the comm of this APG, if num_entries=1 or sched_type=Sequential
-    //  - a sub-comm of this APG's comm otherwise
+    // All processes use the comm of this APG. In parallel scheduling, the
+    // processes run concurrently on separate execution space instances of
+    // each rank, rather than on separate sub-comms.
     ekat::Comm proc_comm = m_comm;
-    if (m_group_schedule_type==ScheduleType::Parallel) {
-      // This is what's going to happen when we implment this:
-      //  - the processes in the group are going to be run in parallel
-      //  - each rank is assigned ONE atm process
-      //  - all the atm processes not assigned to this rank will be filled with
-      //    an instance of "RemoteProcessStub" (to be implemented),
-      //    which is a do-nothing class, only responsible to keep track of dependencies
-      //  - the input parameter list should specify for each atm process the number
-      //    of mpi ranks dedicated to it. Obviously, these numbers should add up
-      //    to the size of the input communicator.
-      //  - this class is then responsible of 'combining' the results togehter,
-      //    including remapping input/output fields to/from the sub-comm
-      //    distribution.
-      EKAT_ERROR_MSG("Error! Parallel schedule type not yet implemented.\n");
-    }
 
     // Get the params of this atm proc
     auto& params_i = m_params.sublist(ap_name);
@@ -365,6 +358,28 @@ void AtmosphereProcessGroup::add_additional_data_fields_to_property_checks (cons
 }
 
 void AtmosphereProcessGroup::initialize_impl (const RunType run_type) {
+  if (m_group_schedule_type==ScheduleType::Parallel) {
+    if (m_lagged_coupling) {
+      setup_lagged_coupling();
+    } else {
+      check_parallel_independence();
+    }
+
+    // Give each non-group process its own execution space instance. Nested
+    // groups keep the default instance, so that their processes, which run
+    // in sequence, are ordered on the same instance.
+    std::vector<int> weights(m_group_size,1);
+    m_proc_exec_spaces = Kokkos::Experimental::partition_space(exec_space(),weights);
+    for (int iproc=0; iproc<m_group_size; ++iproc) {
+      auto& atm_proc = m_atm_processes[iproc];
+      if (atm_proc->type()!=AtmosphereProcessType::Group) {
+        atm_proc->set_execution_space(m_proc_exec_spaces[iproc]);
+      }
+    }
+  } else if (m_async_scheduling) {
+    setup_async_schedule();
+  }
+
   for (auto& atm_proc : m_atm_processes) {
     atm_proc->initialize(timestamp(),run_type);
 #ifdef SCREAM_HAS_MEMORY_USAGE
@@ -374,6 +389,179 @@ void AtmosphereProcessGroup::initialize_impl (const RunType run_type) {
     m_atm_logger->debug("[EAMxx::initialize::"+atm_proc->name()+"] memory usage: " + std::to_string(max_mem_usage) + "MB");
 #endif
   }
+
+  if (m_lagged_coupling) {
+    // Processes may set their outputs during initialization. As in sequential
+    // scheduling, the values set by later processes take precedence.
+    Kokkos::fence();
+    for (const auto& copies : m_lagged_copies) {
+      for (const auto& it : copies) {
+        if (it.second.computed) {
+          it.second.orig.deep_copy(it.second.priv);
+        }
+      }
+    }
+  }
+}
+
+void AtmosphereProcessGroup::setup_lagged_coupling () {
+  // The id of the field that owns the allocation of f
+  auto root_id = [](const Field& f) -> std::string {
+    auto fh = f.get_header_ptr();
+    while (fh->get_parent().lock()) {
+      fh = fh->get_parent().lock();
+    }
+    return fh->get_identifier().get_id_string();
+  };
+  auto group_root_ids = [&](const FieldGroup& g) {
+    strset_t ids;
+    if (g.m_info->m_bundled) {
+      ids.insert(root_id(*g.m_bundle));
+    } else {
+      for (const auto& it : g.m_fields) {
+        ids.insert(root_id(*it.second));
+      }
+    }
+    return ids;
+  };
+
+  // Find the allocations that are used by more than one process, and
+  // computed by at least one. Only those need private copies.
+  strmap_t<int> num_users, num_providers;
+  for (const auto& atm_proc : m_atm_processes) {
+    strset_t used, computed;
+    auto add_field = [&](const Field& f, const bool can_be_computed) {
+      const auto& fid = f.get_header().get_identifier();
+      const bool comp = can_be_computed and atm_proc->has_computed_field(fid);
+      if (comp or atm_proc->has_required_field(fid)) {
+        used.insert(root_id(f));
+        if (comp) {
+          computed.insert(root_id(f));
+        }
+      }
+    };
+    auto add_group = [&](const FieldGroup& g, const bool can_be_computed) {
+      const auto& gname = g.m_info->m_group_name;
+      const bool comp = can_be_computed and atm_proc->has_computed_group(gname,g.grid_name());
+      if (comp or atm_proc->has_required_group(gname,g.grid_name())) {
+        for (const auto& id : group_root_ids(g)) {
+          used.insert(id);
+          if (comp) {
+            computed.insert(id);
+          }
+        }
+      }
+    };
+    for (const auto& f : m_lagged_fields_out) { add_field(f,true);  }
+    for (const auto& f : m_lagged_fields_in)  { add_field(f,false); }
+    for (const auto& g : m_lagged_groups_out) { add_group(g,true);  }
+    for (const auto& g : m_lagged_groups_in)  { add_group(g,false); }
+    for (const auto& id : used)     { ++num_users[id];     }
+    for (const auto& id : computed) { ++num_providers[id]; }
+  }
+  auto is_shared = [&](const std::string& id) {
+    return num_users[id]>1 and num_providers[id]>0;
+  };
+
+  // Get the private copy of f for process iproc, creating it if needed
+  m_lagged_copies.resize(m_group_size);
+  auto get_copy = [&](const int iproc, const Field& f, const bool computed) -> LaggedCopy& {
+    auto& c = m_lagged_copies[iproc][f.get_header().get_identifier().get_id_string()];
+    if (not c.priv.is_allocated()) {
+      c.orig = f;
+      c.priv = f.clone();
+    }
+    if (computed and not c.computed) {
+      EKAT_REQUIRE_MSG (not c.orig.is_read_only() or not f.is_read_only(),
+          "Error! Cannot merge the output of a process into a read-only field.\n"
+          "   group name: " + this->name() + "\n"
+          "   field     : " + f.name() + "\n");
+      if (c.orig.is_read_only()) {
+        c.orig = f;
+      }
+      c.computed = true;
+      c.start = f.clone();
+    }
+    return c;
+  };
+  auto private_field = [&](const int iproc, const Field& f, const bool computed) -> Field {
+    const auto rid = root_id(f);
+    if (iproc==0 or not is_shared(rid)) {
+      return f;
+    }
+    // If the allocation of f was already copied (as the bundle of a group),
+    // alias the private copy, so that the process sees consistent data
+    auto& copies = m_lagged_copies[iproc];
+    const auto parent = f.get_header().get_parent().lock();
+    const auto& si = f.get_header().get_alloc_properties().get_subview_info();
+    if (parent and parent->get_identifier().get_id_string()==rid and copies.count(rid)==1 and
+        not si.dynamic and
+        f.rank()==static_cast<int>(parent->get_identifier().get_layout().rank())-1) {
+      auto& c = get_copy(iproc,copies.at(rid).orig,computed);
+      return c.priv.subfield(f.name(),si.dim_idx,si.slice_idx);
+    }
+    return get_copy(iproc,f,computed).priv;
+  };
+  auto private_group = [&](const int iproc, const FieldGroup& g, const bool computed) -> FieldGroup {
+    if (iproc==0) {
+      return g;
+    }
+    FieldGroup pg(*g.m_info);
+    if (g.m_info->m_bundled and is_shared(root_id(*g.m_bundle))) {
+      const auto& bundle = get_copy(iproc,*g.m_bundle,computed).priv;
+      pg.m_bundle = std::make_shared<Field>(bundle);
+      for (const auto& it : g.m_fields) {
+        const auto idx = g.m_info->m_subview_idx.at(it.first);
+        pg.m_fields[it.first] = std::make_shared<Field>(
+            bundle.subfield(it.second->name(),g.m_info->m_subview_dim,idx));
+      }
+    } else {
+      pg.m_bundle = g.m_bundle;
+      for (const auto& it : g.m_fields) {
+        pg.m_fields[it.first] = std::make_shared<Field>(private_field(iproc,*it.second,computed));
+      }
+    }
+    return pg;
+  };
+
+  // Set fields and groups in the processes. Groups go first, so that the private
+  // copies of a bundle are available for the copies of its individual members.
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    auto& atm_proc = m_atm_processes[iproc];
+    for (const auto& g : m_lagged_groups_out) {
+      const auto& gname = g.m_info->m_group_name;
+      if (atm_proc->has_computed_group(gname,g.grid_name())) {
+        atm_proc->set_computed_group(private_group(iproc,g,true));
+      }
+      if (atm_proc->has_required_group(gname,g.grid_name())) {
+        atm_proc->set_required_group(private_group(iproc,g,false).get_const());
+      }
+    }
+    for (const auto& g : m_lagged_groups_in) {
+      if (atm_proc->has_required_group(g.m_info->m_group_name,g.grid_name())) {
+        atm_proc->set_required_group(private_group(iproc,g,false).get_const());
+      }
+    }
+    for (const auto& f : m_lagged_fields_out) {
+      const auto& fid = f.get_header().get_identifier();
+      if (atm_proc->has_computed_field(fid)) {
+        atm_proc->set_computed_field(private_field(iproc,f,true));
+      }
+      if (atm_proc->has_required_field(fid)) {
+        atm_proc->set_required_field(private_field(iproc,f,false).get_const());
+      }
+    }
+    for (const auto& f : m_lagged_fields_in) {
+      if (atm_proc->has_required_field(f.get_header().get_identifier())) {
+        atm_proc->set_required_field(private_field(iproc,f,false).get_const());
+      }
+    }
+  }
+
+  m_lagged_fields_in.clear();
+  m_lagged_fields_out.clear();
+  m_lagged_groups_in.clear();
+  m_lagged_groups_out.clear();
 }
 
 void AtmosphereProcessGroup::run_impl (const double dt) {
@@ -394,7 +582,20 @@ void AtmosphereProcessGroup::run_sequential (const double dt) {
   //  - nobody from outside told this APG to not update timestamps
   const bool do_update = do_update_time_stamp() &&
                       (get_subcycle_iter()==get_num_subcycles()-1);
-  for (auto atm_proc : m_atm_processes) {
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    auto atm_proc = m_atm_processes[iproc];
+    if (m_async_scheduling) {
+      // Wait for the processes this one depends on. Work on the same instance
+      // is already ordered. Processes may also launch on the default instance,
+      // so that one is always waited for.
+      for (int parent : m_proc_parents[iproc]) {
+        if (m_proc_instance[parent]!=m_proc_instance[iproc]) {
+          m_proc_exec_spaces[m_proc_instance[parent]].fence();
+        }
+      }
+      exec_space().fence();
+    }
+
     atm_proc->set_update_time_stamps(do_update);
     // Run the process
     atm_proc->run(dt);
@@ -405,10 +606,195 @@ void AtmosphereProcessGroup::run_sequential (const double dt) {
     m_atm_logger->debug("[EAMxx::run_sequential::"+atm_proc->name()+"] memory usage: " + std::to_string(max_mem_usage) + "MB");
 #endif
   }
+
+  if (m_async_scheduling) {
+    // The outputs of the group may be used by anyone after this call
+    for (const auto& es : m_proc_exec_spaces) {
+      es.fence();
+    }
+    exec_space().fence();
+  }
+}
+
+void AtmosphereProcessGroup::run_parallel (const double dt) {
+  // The inputs of the processes may have been computed on any instance, so
+  // make sure all work is done before the processes start on their instances
+  Kokkos::fence();
+
+  if (m_lagged_coupling) {
+    // All processes start from the state at the beginning of the step
+    for (const auto& copies : m_lagged_copies) {
+      for (const auto& it : copies) {
+        const auto& c = it.second;
+        c.priv.deep_copy(c.orig);
+        if (c.computed) {
+          c.start.deep_copy(c.orig);
+        }
+      }
+    }
+    Kokkos::fence();
+  }
+
+  // The processes are independent, so their kernels can run concurrently.
+  // The host only launches them, in the order of the group.
+  const bool do_update = do_update_time_stamp() &&
+                      (get_subcycle_iter()==get_num_subcycles()-1);
+  for (auto atm_proc : m_atm_processes) {
+    atm_proc->set_update_time_stamps(do_update);
+    atm_proc->run(dt);
+  }
+
+  // Wait for all the processes, since the next process may use any output
+  for (const auto& es : m_proc_exec_spaces) {
+    es.fence();
+  }
+  Kokkos::fence();
+
+  if (m_lagged_coupling) {
+    // The first process updated the group fields in place. Add the
+    // increments computed by the other processes during the step.
+    for (auto& copies : m_lagged_copies) {
+      for (auto& it : copies) {
+        auto& c = it.second;
+        if (not c.computed) {
+          continue;
+        }
+        if (c.orig.data_type()==DataType::IntType) {
+          c.orig.update(c.priv,1,1);
+          c.orig.update(c.start,-1,1);
+        } else {
+          c.orig.update(c.priv,Real(1),Real(1));
+          c.orig.update(c.start,Real(-1),Real(1));
+        }
+        if (do_update) {
+          c.orig.get_header().get_tracking().update_time_stamp(
+              c.priv.get_header().get_tracking().get_time_stamp());
+        }
+      }
+    }
+    Kokkos::fence();
+  }
+#ifdef SCREAM_HAS_MEMORY_USAGE
+  long long my_mem_usage = get_mem_usage(MB);
+  long long max_mem_usage;
+  m_comm.all_reduce(&my_mem_usage,&max_mem_usage,1,MPI_MAX);
+  m_atm_logger->debug("[EAMxx::run_parallel::"+name()+"] memory usage: " + std::to_string(max_mem_usage) + "MB");
+#endif
+}
+
+void AtmosphereProcessGroup::
+gather_fields_names (std::vector<strset_t>& ins,
+                     std::vector<strset_t>& outs) const {
+  auto add_fid = [](strset_t& names, const Field& f) {
+    const auto& fid = f.get_header().get_identifier();
+    names.insert(fid.name() + " (" + fid.get_grid_name() + ")");
+  };
+  auto add_groups = [&](strset_t& names, const std::list<FieldGroup>& groups) {
+    for (const auto& g : groups) {
+      for (const auto& it : g.m_fields) {
+        add_fid(names,*it.second);
+      }
+    }
+  };
+
+  ins.assign(m_group_size,strset_t());
+  outs.assign(m_group_size,strset_t());
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    const auto& atm_proc = m_atm_processes[iproc];
+    for (const auto& f : atm_proc->get_fields_in()) {
+      add_fid(ins[iproc],f);
+    }
+    for (const auto& f : atm_proc->get_fields_out()) {
+      add_fid(outs[iproc],f);
+    }
+    add_groups(ins[iproc],atm_proc->get_groups_in());
+    add_groups(outs[iproc],atm_proc->get_groups_out());
+  }
+}
+
+void AtmosphereProcessGroup::check_parallel_independence () const {
+  std::vector<strset_t> ins, outs;
+  gather_fields_names(ins,outs);
+
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    for (int jproc=0; jproc<m_group_size; ++jproc) {
+      if (jproc==iproc) {
+        continue;
+      }
+      for (const auto& name : outs[iproc]) {
+        const bool read = ins[jproc].count(name)==1;
+        EKAT_REQUIRE_MSG (not read and (jproc<iproc or outs[jproc].count(name)==0),
+            "Error! The processes of a group with Parallel schedule must be independent.\n"
+            "   group name: " + this->name() + "\n"
+            "   field     : " + name + "\n"
+            "   computed by " + m_atm_processes[iproc]->name() + " and " +
+            (read ? "required" : "computed") + " by " + m_atm_processes[jproc]->name() + "\n"
+            "Use a Sequential schedule for dependent processes.\n");
+      }
+    }
+  }
+}
+
+void AtmosphereProcessGroup::
+compute_async_schedule (std::vector<std::vector<int>>& parents,
+                        std::vector<int>& instances) const
+{
+  std::vector<strset_t> ins, outs;
+  gather_fields_names(ins,outs);
+
+  auto intersect = [](const strset_t& lhs, const strset_t& rhs) {
+    for (const auto& name : lhs) {
+      if (rhs.count(name)==1) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // A process depends on a previous one if it reads its outputs, or if it
+  // overwrites its inputs or outputs. The level of a process is the length
+  // of the longest chain of dependencies leading to it, so processes on the
+  // same level are independent and can run at the same time.
+  parents.assign(m_group_size,std::vector<int>());
+  std::vector<int> level(m_group_size,0);
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    for (int jproc=0; jproc<iproc; ++jproc) {
+      if (intersect(outs[jproc],ins[iproc]) or
+          intersect(outs[iproc],ins[jproc]) or
+          intersect(outs[iproc],outs[jproc])) {
+        parents[iproc].push_back(jproc);
+        level[iproc] = std::max(level[iproc],level[jproc]+1);
+      }
+    }
+  }
+
+  // Processes on the same level get separate instances
+  std::map<int,int> level_size;
+  instances.resize(m_group_size);
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    instances[iproc] = level_size[level[iproc]]++;
+  }
 }
 
-void AtmosphereProcessGroup::run_parallel (const double /* dt */) {
-  EKAT_REQUIRE_MSG (false,"Error! Parallel splitting not yet implemented.\n");
+void AtmosphereProcessGroup::setup_async_schedule () {
+  compute_async_schedule(m_proc_parents,m_proc_instance);
+
+  int num_instances = 1;
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    num_instances = std::max(num_instances,m_proc_instance[iproc]+1);
+  }
+
+  std::vector<int> weights(num_instances,1);
+  m_proc_exec_spaces = Kokkos::Experimental::partition_space(exec_space(),weights);
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    auto& atm_proc = m_atm_processes[iproc];
+    if (atm_proc->type()!=AtmosphereProcessType::Group) {
+      atm_proc->set_execution_space(m_proc_exec_spaces[m_proc_instance[iproc]]);
+    }
+    m_atm_logger->debug("[EAMxx::" + name() + "] async schedule: " + atm_proc->name() +
+                        " on instance " + std::to_string(m_proc_instance[iproc]) +
+                        " after " + std::to_string(m_proc_parents[iproc].size()) + " process(es)");
+  }
 }
 
 void AtmosphereProcessGroup::finalize_impl (/* what inputs? */) {
@@ -429,6 +815,7 @@ set_required_field (const Field& f) {
     // In parallel splitting, all required fields are *actual* inputs,
     // and the base class impl is fine.
     AtmosphereProcess::set_required_field(f);
+    return;
   }
 
   // Find the first process that requires this group
@@ -497,6 +884,7 @@ set_required_group (const FieldGroup& group) {
     // In parallel splitting, all required group are *actual* inputs,
     // and the base class impl is fine.
     AtmosphereProcess::set_required_group(group);
+    return;
   }
 
   // Find the first process that requires this group
@@ -572,6 +960,11 @@ endloop:
 void AtmosphereProcessGroup::
 set_required_group_impl (const FieldGroup& group)
 {
+  if (m_lagged_coupling) {
+    // The processes get their fields and groups in setup_lagged_coupling
+    m_lagged_groups_in.push_back(group);
+    return;
+  }
   for (auto atm_proc : m_atm_processes) {
     if (atm_proc->has_required_group(group.m_info->m_group_name,group.grid_name())) {
       atm_proc->set_required_group(group);
@@ -582,6 +975,10 @@ set_required_group_impl (const FieldGroup& group)
 void AtmosphereProcessGroup::
 set_computed_group_impl (const FieldGroup& group)
 {
+  if (m_lagged_coupling) {
+    m_lagged_groups_out.push_back(group);
+    return;
+  }
   for (auto atm_proc : m_atm_processes) {
     if (atm_proc->has_computed_group(group.m_info->m_group_name,group.grid_name())) {
       atm_proc->set_computed_group(group);
@@ -597,6 +994,10 @@ set_computed_group_impl (const FieldGroup& group)
 }
 
 void AtmosphereProcessGroup::set_required_field_impl (const Field& f) {
+  if (m_lagged_coupling) {
+    m_lagged_fields_in.push_back(f);
+    return;
+  }
   const auto& fid = f.get_header().get_identifier();
   for (auto atm_proc : m_atm_processes) {
     if (atm_proc->has_required_field(fid)) {
@@ -606,6 +1007,10 @@ void AtmosphereProcessGroup::set_required_field_impl (const Field& f) {
 }
 
 void AtmosphereProcessGroup::set_computed_field_impl (const Field& f) {
+  if (m_lagged_coupling) {
+    m_lagged_fields_out.push_back(f);
+    return;
+  }
   const auto& fid = f.get_header().get_identifier();
   for (auto atm_proc : m_atm_processes) {
     if (atm_proc->has_computed_field(fid)) {
@@ -664,20 +1069,57 @@ process_required_field (const FieldRequest& req) {
   }
 }
 
-size_t AtmosphereProcessGroup::requested_buffer_size_in_bytes () const
+std::vector<int> AtmosphereProcessGroup::
+get_buffer_regions (std::vector<size_t>& regions_sizes) const
 {
-  size_t buf_size = 0;
-  for (const auto& proc : m_atm_processes) {
-    buf_size = std::max(buf_size,proc->requested_buffer_size_in_bytes());
+  // - sequential: processes run one after the other, and share a single region
+  // - parallel: processes may all run at the same time, so each has its own region
+  // - async: processes on the same instance are ordered, so we need one region per instance
+  std::vector<int> regions(m_group_size,0);
+  if (m_group_schedule_type==ScheduleType::Parallel) {
+    std::iota(regions.begin(),regions.end(),0);
+  } else if (m_async_scheduling) {
+    std::vector<std::vector<int>> parents;
+    compute_async_schedule(parents,regions);
+  }
+
+  const int num_regions = m_group_size==0 ? 0 : *std::max_element(regions.begin(),regions.end())+1;
+  regions_sizes.assign(num_regions,0);
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    auto& s = regions_sizes[regions[iproc]];
+    s = std::max(s,ATMBufferManager::align_bytes(m_atm_processes[iproc]->requested_buffer_size_in_bytes()));
   }
+  return regions;
+}
 
-  return buf_size;
+size_t AtmosphereProcessGroup::requested_buffer_size_in_bytes () const
+{
+  std::vector<size_t> regions_sizes;
+  get_buffer_regions(regions_sizes);
+
+  return std::accumulate(regions_sizes.begin(),regions_sizes.end(),size_t(0));
 }
 
 void AtmosphereProcessGroup::
 init_buffers(const ATMBufferManager& buffer_manager) {
-  for (auto& atm_proc : m_atm_processes) {
-    atm_proc->init_buffers(buffer_manager);
+  std::vector<size_t> regions_sizes;
+  const auto regions = get_buffer_regions(regions_sizes);
+  if (regions_sizes.size()==1) {
+    // All processes share the whole buffer
+    for (auto& atm_proc : m_atm_processes) {
+      atm_proc->init_buffers(buffer_manager);
+    }
+    return;
+  }
+
+  std::vector<size_t> regions_offsets(regions_sizes.size(),0);
+  for (size_t r=1; r<regions_sizes.size(); ++r) {
+    regions_offsets[r] = regions_offsets[r-1] + regions_sizes[r-1];
+  }
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    const int r = regions[iproc];
+    ATMBufferManager region (buffer_manager,regions_offsets[r],regions_sizes[r]);
+    m_atm_processes[iproc]->init_buffers(region);
   }
 }
 
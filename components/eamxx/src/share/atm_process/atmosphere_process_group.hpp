@@ -24,6 +24,22 @@ namespace scream
  *  The only caveat is required fields in sequential scheduling: if an atm proc
  *  requires a field that is computed by a previous atm proc in the group,
  *  that field is not exposed as a required field of the group.
+ *
+ *  In parallel scheduling, the processes of the group must be independent:
+ *  no process can compute a field that another process of the group requires
+ *  or computes. The processes are then run concurrently, each launching its
+ *  kernels on its own partition of the default execution space (see
+ *  AtmosphereProcess::get_execution_space), so that several small processes
+ *  can fill the device together. Processes that launch on the default
+ *  instance are still correct, but do not overlap with the others.
+ *
+ *  In sequential scheduling, setting 'enable_async_scheduling' to true turns
+ *  the group into a task graph: each process depends on the previous
+ *  processes whose outputs it reads, or whose inputs or outputs it
+ *  overwrites. A process waits (with fences on individual instances, not
+ *  device-wide fences) only for those processes, so it can overlap with
+ *  earlier processes it does not depend on, e.g., diagnostics or property
+ *  checks of a process that is not needed by the next one.
  */
 
 class AtmosphereProcessGroup : public AtmosphereProcess
@@ -68,7 +84,9 @@ public:
 
   ScheduleType get_schedule_type () const { return m_group_schedule_type; }
 
-  // Computes total number of bytes needed for local variables
+  // Computes total number of bytes needed for local variables. Processes that
+  // never run concurrently share the same buffer region, so that only the max
+  // of their requests is needed; concurrent processes get disjoint regions.
   size_t requested_buffer_size_in_bytes () const;
 
   // Set local variables using memory provided by
@@ -127,6 +145,33 @@ protected:
   void run_sequential (const double dt);
   void run_parallel   (const double dt);
 
+  // Gather the grid-qualified names of the fields required and computed by
+  // each process of the group, including the members of its field groups
+  using strset_t = std::set<std::string>;
+  void gather_fields_names (std::vector<strset_t>& ins,
+                            std::vector<strset_t>& outs) const;
+
+  // Check that no process of a parallel group computes a field required or
+  // computed by another process of the group
+  void check_parallel_independence () const;
+
+  // In parallel scheduling with lagged coupling, give the processes their
+  // fields and groups, using private copies for the fields they share
+  void setup_lagged_coupling ();
+
+  // In sequential scheduling with async execution, find the previous
+  // processes each process depends on, and the instance each process runs on
+  void compute_async_schedule (std::vector<std::vector<int>>& parents,
+                               std::vector<int>& instances) const;
+
+  // In sequential scheduling with async execution, give independent
+  // processes separate execution space instances
+  void setup_async_schedule ();
+
+  // The buffer region of each process, and the size of each region. Processes
+  // in the same region never run concurrently.
+  std::vector<int> get_buffer_regions (std::vector<size_t>& regions_sizes) const;
+
   // The methods to set the fields/groups in the right processes of the group
   void set_required_field_impl (const Field& f);
   void set_computed_field_impl (const Field& f);
@@ -143,6 +188,38 @@ protected:
   // The schedule type: Parallel vs Sequential
   ScheduleType   m_group_schedule_type;
 
+  // In parallel scheduling, or sequential scheduling with async execution,
+  // the execution space instances of the processes
+  std::vector<exec_space>   m_proc_exec_spaces;
+
+  // In sequential scheduling with async execution, the previous processes
+  // that each process must wait for, and the index of its instance
+  bool                          m_async_scheduling = false;
+  std::vector<std::vector<int>> m_proc_parents;
+  std::vector<int>              m_proc_instance;
+
+  // In parallel scheduling with lagged coupling, processes need not be independent.
+  // All processes but the first work on private copies of the fields they share
+  // with other processes, refreshed from the group fields at the start of each step.
+  // Hence, they see the state at the beginning of the step, rather than the outputs
+  // of the other processes. At the end of the step, the increments of the copies
+  // computed by each process are added to the group fields, which the first
+  // process updates in place.
+  struct LaggedCopy {
+    Field orig;   // The field of the group
+    Field priv;   // The private copy used by the process
+    Field start;  // The value at the beginning of the step (computed copies only)
+    bool  computed = false;
+  };
+  bool                            m_lagged_coupling = false;
+  std::vector<strmap_t<LaggedCopy>> m_lagged_copies;
+
+  // The fields/groups of the group, until setup_lagged_coupling sets them in the processes
+  std::list<Field>      m_lagged_fields_in;
+  std::list<Field>      m_lagged_fields_out;
+  std::list<FieldGroup> m_lagged_groups_in;
+  std::list<FieldGroup> m_lagged_groups_out;
+
   // This is only needed to be able to access grids objects later on
   std::shared_ptr<const GridsManager>   m_grids_mgr;
 };
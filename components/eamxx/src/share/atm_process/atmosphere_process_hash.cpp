@@ -111,6 +111,74 @@ void hash (const std::list<FieldGroup>& fgs, HashType& accum) {
       hash(*e.second, accum);
 }
 
+// Where to find the entries of a field in the fused hash kernel below:
+// the field is seen as a (nrows,last_dim) array, with row stride last_alloc.
+struct HashFieldInfo {
+  const Real* data;
+  int offset;     // Index of the 1st entry of this field in the flattened range
+  int last_dim;
+  int last_alloc;
+};
+
+// Hash all the entries of the given fields in a single kernel. Since
+// bfbhash::hash is commutative, this is equivalent to hashing the fields
+// one at a time. Fields that are subviews of another field are not at a
+// fixed stride in memory, so they are hashed separately.
+void fused_hash (const std::vector<Field>& fs, HashType& accum_out) {
+  std::vector<HashFieldInfo> infos;
+  int size = 0;
+  for (const auto& f : fs) {
+    const auto& hd = f.get_header();
+    const auto& id = hd.get_identifier();
+    if (id.data_type() != DataType::DoubleType) continue;
+    if (hd.get_parent().lock()) {
+      hash(f, accum_out);
+      continue;
+    }
+    const auto& lo = id.get_layout();
+    if (lo.size()==0) continue;
+
+    auto& info = infos.emplace_back();
+    info.data       = f.get_internal_view_data<const Real>();
+    info.offset     = size;
+    info.last_dim   = lo.rank()==0 ? 1 : lo.dims().back();
+    info.last_alloc = lo.rank()==0 ? 1 : hd.get_alloc_properties().get_last_extent();
+    size += lo.size();
+  }
+  if (infos.size()==0) return;
+
+  const int nfields = infos.size();
+  Kokkos::View<HashFieldInfo*> infos_d ("hash_infos",nfields);
+  auto infos_h = Kokkos::create_mirror_view(infos_d);
+  for (int i=0; i<nfields; ++i) {
+    infos_h(i) = infos[i];
+  }
+  Kokkos::deep_copy(infos_d,infos_h);
+
+  HashType accum = 0;
+  Kokkos::parallel_reduce(
+    Kokkos::RangePolicy<ExeSpace>(0, size),
+    KOKKOS_LAMBDA(const int idx, HashType& accum) {
+      // Binary search for the field that contains this entry
+      int beg = 0, end = nfields;
+      while (end-beg>1) {
+        const int mid = (beg+end)/2;
+        if (infos_d(mid).offset<=idx) {
+          beg = mid;
+        } else {
+          end = mid;
+        }
+      }
+      const auto& info = infos_d(beg);
+      const int i = idx - info.offset;
+      const int row = i / info.last_dim;
+      const int col = i % info.last_dim;
+      bfbhash::hash(info.data[row*info.last_alloc+col], accum);
+    }, bfbhash::HashReducer<>(accum));
+  Kokkos::fence();
+  bfbhash::hash(accum, accum_out);
+}
+
 } // namespace anon
 
 void AtmosphereProcess
@@ -134,6 +202,26 @@ void AtmosphereProcess
                 i, gaccum[i], label.c_str());
 }
 
+void AtmosphereProcess::log_output_fields_hash () const {
+  std::vector<Field> fields;
+  for (const auto& f : m_fields_out)
+    fields.push_back(f);
+  for (const auto& g : m_groups_out)
+    for (const auto& e : g.m_fields)
+      fields.push_back(*e.second);
+
+  HashType laccum = 0;
+  fused_hash(fields, laccum);
+  HashType gaccum;
+  bfbhash::all_reduce_HashType(m_comm.mpi_comm(), &laccum, &gaccum, 1);
+  if (m_comm.am_i_root()) {
+    char line[128];
+    snprintf(line, sizeof(line), "bfbhash> %9d %16" PRIx64 " ",
+             timestamp().get_num_steps(), gaccum);
+    m_atm_logger->info(line + name());
+  }
+}
+
 void AtmosphereProcess::print_fast_global_state_hash (const std::string& label) const {
   HashType laccum = 0;
   hash(m_fields_in, laccum);
@@ -1,4 +1,5 @@
 #include "share/field/field.hpp"
+#include "share/field/field_memory_pool.hpp"
 #include "share/util/scream_utils.hpp"
 
 namespace scream
@@ -278,7 +279,12 @@ void Field::allocate_view ()
   // Create the view, by quering allocation properties for the allocation size
   const auto view_dim = alloc_prop.get_alloc_size();
 
-  m_data.d_view = decltype(m_data.d_view)(id.name(),view_dim);
+  auto& pool = FieldMemoryPool::instance();
+  if (pool.is_active()) {
+    m_data.d_view = pool.get_storage(view_dim);
+  } else {
+    m_data.d_view = decltype(m_data.d_view)(id.name(),view_dim);
+  }
   m_data.h_view = Kokkos::create_mirror_view(m_data.d_view);
 }
 
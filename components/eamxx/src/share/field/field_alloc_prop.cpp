@@ -1,7 +1,30 @@
 #include "field_alloc_prop.hpp"
 
+#include <numeric>
+
 namespace scream {
 
+namespace {
+FieldAllocPolicy& alloc_policy () {
+  static FieldAllocPolicy p;
+  return p;
+}
+} // anonymous namespace
+
+void set_field_alloc_policy (const FieldAllocPolicy& policy) {
+  EKAT_REQUIRE_MSG (policy.default_pack_size>0,
+      "Error! Invalid default pack size in FieldAllocPolicy.\n"
+      "  - default pack size: " + std::to_string(policy.default_pack_size) + "\n");
+  EKAT_REQUIRE_MSG (policy.row_alignment>=0,
+      "Error! Invalid row alignment in FieldAllocPolicy.\n"
+      "  - row alignment: " + std::to_string(policy.row_alignment) + "\n");
+  alloc_policy() = policy;
+}
+
+const FieldAllocPolicy& get_field_alloc_policy () {
+  return alloc_policy();
+}
+
 FieldAllocProp::FieldAllocProp (const int scalar_size)
  : m_layout           (FieldLayout::invalid())
  , m_value_type_sizes (1,scalar_size)
@@ -184,8 +207,12 @@ void FieldAllocProp::commit (const layout_type& layout)
     m_pack_size_max = 1;
     m_last_extent = 0;
   } else {
-    // Loop on all value type sizes.
-    m_last_extent = 0;
+    using namespace ShortFieldTagsNames;
+    const auto& policy = get_field_alloc_policy();
+
+    // The last extent must be a multiple of all value type lengths, so that
+    // the field can be viewed with any of them (not just with the largest)
+    int len_lcm = 1;
     int last_phys_extent = m_layout.dims().back();
     for (auto vts : m_value_type_sizes) {
       // The number of scalar_type in a value_type
@@ -194,16 +221,22 @@ void FieldAllocProp::commit (const layout_type& layout)
       // Update the max pack size
       m_pack_size_max = std::max(m_pack_size_max,vt_len);
 
-      // The number of value_type's needed in the fast-striding dimension
-      const int num_vt = (last_phys_extent + vt_len - 1) / vt_len;
-
-      // The total number of scalars with num_vt value_type entries
-      const int num_st = num_vt*vt_len;
+      len_lcm = std::lcm(len_lcm,vt_len);
+    }
 
-      // The size of such allocation (along the last dim only)
-      m_last_extent = std::max(m_last_extent, num_st);
+    const auto last_tag = m_layout.tags().back();
+    if (policy.default_pack_size>1 and (last_tag==LEV or last_tag==ILEV)) {
+      m_pack_size_max = std::max(m_pack_size_max,policy.default_pack_size);
+      len_lcm = std::lcm(len_lcm,policy.default_pack_size);
+    }
+    if (policy.row_alignment>0 and m_layout.rank()>1) {
+      const int align_len = std::max(policy.row_alignment / m_scalar_type_size, 1);
+      len_lcm = std::lcm(len_lcm,align_len);
     }
 
+    // The number of scalars along the fast-striding dimension
+    m_last_extent = (last_phys_extent + len_lcm - 1) / len_lcm * len_lcm;
+
     if (m_layout.size()>0) {
       m_alloc_size = m_layout.size() / last_phys_extent  // All except the last dimension
                    * m_last_extent * m_scalar_type_size; // Last dimension must account for padding (if any)
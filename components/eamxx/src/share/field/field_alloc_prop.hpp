@@ -87,6 +87,22 @@ struct SubviewInfo {
   bool dynamic = false;
 };
 
+// Global policy applied to all allocations, on top of the customers requests.
+// It must be set before any field allocation properties are committed.
+struct FieldAllocPolicy {
+  // Pack size that every field whose last dimension is LEV/ILEV can be used with,
+  // even if no customer requested it (1: only use the requested pack sizes).
+  int default_pack_size = 1;
+
+  // If positive, pad the last extent of fields with rank>1 so that the start of
+  // each row is a multiple of this many bytes (e.g., a cache line) from the start of
+  // the allocation (which is itself aligned), allowing aligned accesses to each column.
+  int row_alignment = 0;
+};
+
+void set_field_alloc_policy (const FieldAllocPolicy& policy);
+const FieldAllocPolicy& get_field_alloc_policy ();
+
 inline bool operator== (const SubviewInfo& lhs, const SubviewInfo& rhs) {
   return lhs.dim_idx==rhs.dim_idx &&
          lhs.slice_idx==rhs.slice_idx &&
@@ -0,0 +1,80 @@
+#include "share/field/field_memory_pool.hpp"
+
+#include "ekat/ekat_assert.hpp"
+
+namespace scream
+{
+
+namespace {
+
+// Round up the input size to 2^k*{1,1.25,1.5,1.75}, so that
+// the waste is at most 25% of the request.
+size_t bucket_size (const size_t num_bytes)
+{
+  constexpr size_t min_bucket = 256;
+  size_t p = min_bucket;
+  while (p<num_bytes) {
+    p *= 2;
+  }
+  if (p==min_bucket) {
+    return p;
+  }
+  const size_t q = p/8;
+  return ((num_bytes+q-1)/q)*q;
+}
+
+} // anonymous namespace
+
+void FieldMemoryPool::open_group ()
+{
+  EKAT_REQUIRE_MSG (m_curr_group<0,
+      "Error! Cannot open a FieldMemoryPool group while another one is open.\n");
+  m_curr_group = m_num_groups++;
+}
+
+void FieldMemoryPool::close_group ()
+{
+  EKAT_REQUIRE_MSG (m_curr_group>=0,
+      "Error! Cannot close a FieldMemoryPool group, since none is open.\n");
+  m_curr_group = -1;
+}
+
+FieldMemoryPool::storage_t
+FieldMemoryPool::get_storage (const size_t num_bytes)
+{
+  EKAT_REQUIRE_MSG (is_active(),
+      "Error! Cannot get storage from the FieldMemoryPool outside of a group.\n");
+
+  const auto bs = bucket_size(num_bytes);
+  auto& blocks = m_blocks[bs];
+
+  // Look for a block of this bucket that the current group is not using yet
+  Block* block = nullptr;
+  for (auto& b : blocks) {
+    if (b.groups.count(m_curr_group)==0) {
+      block = &b;
+      break;
+    }
+  }
+  if (block==nullptr) {
+    block = &blocks.emplace_back();
+    block->data = storage_t("field_memory_pool_block",bs);
+    m_allocated_bytes += bs;
+  }
+  block->groups.insert(m_curr_group);
+  m_requested_bytes += num_bytes;
+
+  return Kokkos::subview(block->data,Kokkos::make_pair(size_t(0),num_bytes));
+}
+
+void FieldMemoryPool::clean_up ()
+{
+  EKAT_REQUIRE_MSG (m_curr_group<0,
+      "Error! Cannot clean up the FieldMemoryPool while a group is open.\n");
+
+  m_blocks.clear();
+  m_num_groups = 0;
+  m_allocated_bytes = m_requested_bytes = 0;
+}
+
+} // namespace scream
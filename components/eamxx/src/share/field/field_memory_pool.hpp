@@ -0,0 +1,88 @@
+#ifndef SCREAM_FIELD_MEMORY_POOL_HPP
+#define SCREAM_FIELD_MEMORY_POOL_HPP
+
+#include "share/scream_types.hpp"
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace scream
+{
+
+/*
+ * A process-wide pool of device memory for fields with non-overlapping lifetimes
+ *
+ * Fields are allocated in 'groups'. The fields of a group may be alive at the same
+ * time, but fields of different groups are assumed to never be (this is the caller's
+ * responsibility). E.g., the diagnostics of an output stream are only used while
+ * that stream is running, so the diagnostics of different streams can share storage.
+ *
+ * While a group is open, Field::allocate_view gets its storage from the pool.
+ * Requests are rounded up to a bucket size (at most 25% larger than the request),
+ * and served by a block of that bucket not yet used by the current group, if any,
+ * or by a newly allocated block otherwise. The memory used by the pool is therefore
+ * the max over all groups, rather than the sum.
+ *
+ * NOTE: pooled storage is not zero-initialized, since it may contain data
+ *       written by fields of other groups.
+ */
+
+class FieldMemoryPool {
+public:
+  using KT = KokkosTypes<DefaultDevice>;
+  using storage_t = KT::view_1d<char>;
+
+  static FieldMemoryPool& instance () {
+    static FieldMemoryPool pool;
+    return pool;
+  }
+
+  // Open/close a group of allocations. Groups cannot be nested.
+  void open_group ();
+  void close_group ();
+
+  // Whether Field::allocate_view should get its storage from the pool
+  bool is_active () const { return m_curr_group>=0 and m_suspended==0; }
+
+  // Allocations performed while a Suspend object is alive do not use the pool.
+  // Useful for fields that must persist across the lifetime of the group
+  // (e.g., internal state of a diagnostic that is updated at every time step).
+  struct Suspend {
+    Suspend  () { ++instance().m_suspended; }
+    ~Suspend () { --instance().m_suspended; }
+  };
+
+  // Get storage of (at least) the given size for the current group
+  storage_t get_storage (const size_t num_bytes);
+
+  // The memory allocated by the pool, and the memory that would have
+  // been allocated if every request had used its own storage
+  size_t allocated_bytes () const { return m_allocated_bytes; }
+  size_t requested_bytes () const { return m_requested_bytes; }
+
+  // Release all blocks. Storage still used by some field is not freed until the field is destroyed.
+  void clean_up ();
+
+private:
+  FieldMemoryPool () = default;
+
+  struct Block {
+    storage_t     data;
+    std::set<int> groups;
+  };
+
+  // Blocks, organized by bucket size
+  std::map<size_t,std::vector<Block>>   m_blocks;
+
+  int     m_num_groups = 0;
+  int     m_curr_group = -1;
+  int     m_suspended  = 0;
+
+  size_t  m_allocated_bytes = 0;
+  size_t  m_requested_bytes = 0;
+};
+
+} // namespace scream
+
+#endif // SCREAM_FIELD_MEMORY_POOL_HPP
@@ -169,6 +169,31 @@ GridImportExport (const std::shared_ptr<const AbstractGrid>& unique,
     }
     Kokkos::deep_copy(m_num_imports_per_pid,m_num_imports_per_pid_h);
   }
+
+  // Create the neighbors graph (no reordering, so ranks are the same as in m_comm)
+  for (int pid=0; pid<m_comm.size(); ++pid) {
+    if (m_num_imports_per_pid_h[pid]>0) {
+      m_import_neighbors.push_back(pid);
+    }
+    if (m_num_exports_per_pid_h[pid]>0) {
+      m_export_neighbors.push_back(pid);
+    }
+  }
+  check_mpi_call(MPI_Dist_graph_create_adjacent(m_comm.mpi_comm(),
+                     m_import_neighbors.size(),m_import_neighbors.data(),MPI_UNWEIGHTED,
+                     m_export_neighbors.size(),m_export_neighbors.data(),MPI_UNWEIGHTED,
+                     MPI_INFO_NULL,0,&m_neighbor_comm),
+                 "GridImportExport, creating the dist graph communicator");
+}
+
+GridImportExport::~GridImportExport ()
+{
+  // The import/export may be stored in some cache that outlives MPI
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (m_neighbor_comm!=MPI_COMM_NULL and not finalized) {
+    MPI_Comm_free(&m_neighbor_comm);
+  }
 }
 
 } // namespace scream
@@ -38,6 +38,9 @@ namespace scream
  * for ease of use in non-performance critical code.
  * On the other hand, the import/export data (pids/lids) can
  * be used both on host and device, for more efficient pack/unpack methods.
+ * For the same purpose, the class also builds a distributed graph
+ * communicator, whose sources (destinations) are the pids we import from
+ * (export to), which can be used with MPI neighborhood collectives.
  */
 
 class GridImportExport {
@@ -48,7 +51,10 @@ public:
 
   GridImportExport (const std::shared_ptr<const AbstractGrid>& unique,
                     const std::shared_ptr<const AbstractGrid>& overlapped);
-  ~GridImportExport () = default;
+  GridImportExport (const GridImportExport&) = delete;
+  ~GridImportExport ();
+
+  GridImportExport& operator= (const GridImportExport&) = delete;
 
   template<typename T>
   void scatter (const MPI_Datatype mpi_data_t,
@@ -76,6 +82,12 @@ public:
   view_1d<int>::HostMirror export_pids_h () const { return m_export_pids_h; }
   view_1d<int>::HostMirror export_lids_h () const { return m_export_lids_h; }
 
+  // The pids we import from (sources) and export to (destinations), sorted,
+  // and the dist graph comm with those neighbors (same rank ids as the grid comm)
+  const std::vector<int>& import_neighbors () const { return m_import_neighbors; }
+  const std::vector<int>& export_neighbors () const { return m_export_neighbors; }
+  MPI_Comm neighbor_comm () const { return m_neighbor_comm; }
+
 protected:
 
   std::shared_ptr<const AbstractGrid>   m_unique;
@@ -99,6 +111,10 @@ protected:
   view_1d<int>::HostMirror  m_num_imports_per_pid_h;
   view_1d<int>::HostMirror  m_num_exports_per_pid_h;
 
+  std::vector<int>  m_import_neighbors;
+  std::vector<int>  m_export_neighbors;
+  MPI_Comm          m_neighbor_comm = MPI_COMM_NULL;
+
   ekat::Comm    m_comm;
 };
 
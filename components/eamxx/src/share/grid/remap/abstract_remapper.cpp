@@ -1,5 +1,7 @@
 #include "share/grid/remap/abstract_remapper.hpp"
 
+#include "share/util/scream_timing.hpp"
+
 namespace scream
 {
 
@@ -153,12 +155,16 @@ void AbstractRemapper::remap (const bool forward) {
       EKAT_REQUIRE_MSG (m_fwd_allowed,
           "Error! Forward remap is not allowed by this remapper.\n"
           "       This means that some fields on the target grid are read-only.\n");
+      start_timer("EAMxx::Remap::fwd");
       do_remap_fwd ();
+      stop_timer("EAMxx::Remap::fwd");
     } else {
       EKAT_REQUIRE_MSG (m_bwd_allowed,
           "Error! Backward remap is not allowed by this remapper.\n"
           "       This means that some fields on the source grid are read-only.\n");
+      start_timer("EAMxx::Remap::bwd");
       do_remap_bwd ();
+      stop_timer("EAMxx::Remap::bwd");
     }
   }
 }
@@ -13,6 +13,56 @@
 namespace scream
 {
 
+namespace {
+
+// Finds the entry of a fused remap table that contains the input index of the
+// flattened index space of the table. Entries are sorted by offset, and have non-zero size.
+template<typename TableView>
+KOKKOS_INLINE_FUNCTION
+int find_fused_entry (const TableView& table, const int idx)
+{
+  int lo = 0;
+  int hi = table.extent_int(0)-1;
+  while (lo<hi) {
+    const int mid = (lo+hi+1)/2;
+    if (table(mid).offset<=idx) {
+      lo = mid;
+    } else {
+      hi = mid-1;
+    }
+  }
+  return lo;
+}
+
+// Returns the pointer to the field data, and fills the strides of the field view
+template<typename ST>
+ST* get_data_and_strides (const Field& f, int* strides)
+{
+  const int rank = f.rank();
+  auto set_strides = [&](const auto& v) {
+    for (int d=0; d<rank; ++d) {
+      strides[d] = v.stride(d);
+    }
+    return v.data();
+  };
+  switch (rank) {
+    // Unlike get_view, get_strided_view returns a LayoutStride view,
+    // therefore allowing the 1d field to be a subfield of a 2d field
+    // along the 2nd dimension.
+    case 1: return set_strides(f.get_strided_view<ST*>());
+    case 2: return set_strides(f.get_view<ST**>());
+    case 3: return set_strides(f.get_view<ST***>());
+    case 4: return set_strides(f.get_view<ST****>());
+    default:
+      EKAT_ERROR_MSG ("Unexpected field rank in CoarseningRemapper fused remap.\n"
+          "  - field name: " + f.name() + "\n"
+          "  - field rank: " + std::to_string(rank) + "\n");
+  }
+  return nullptr;
+}
+
+} // anonymous namespace
+
 CoarseningRemapper::
 CoarseningRemapper (const grid_ptr_type& src_grid,
                     const std::string& map_file,
@@ -167,6 +217,11 @@ void CoarseningRemapper::do_remap_fwd ()
 
   // Loop over each field
   for (int i=0; i<m_num_fields; ++i) {
+    // Fused fields are handled in a single mat-vec+pack kernel, in pack_and_send
+    if (is_fused_field(i)) {
+      continue;
+    }
+
     // First, perform the local mat-vec. Recall that in these y=Ax products,
     // x is the src field, and y is the overlapped tgt field.
     const auto& f_src = m_src_fields[i];
@@ -576,7 +631,15 @@ void CoarseningRemapper::pack_and_send ()
   const auto lids_pids = m_send_lids_pids;
   const auto buf = m_send_buffer;
 
+  // Fused fields are packed directly by the mat-vec kernel
+  if (m_fused_remap) {
+    fused_mat_vec_and_pack ();
+  }
+
   for (int ifield=0; ifield<m_num_fields; ++ifield) {
+    if (is_fused_field(ifield)) {
+      continue;
+    }
     const auto& f  = m_ov_fields[ifield];
     const auto& fl = f.get_header().get_identifier().get_layout();
     const auto f_pid_offsets = ekat::subview(m_send_f_pid_offsets,ifield);
@@ -701,6 +764,11 @@ void CoarseningRemapper::recv_and_unpack ()
     Kokkos::deep_copy (m_recv_buffer,m_mpi_recv_buffer);
   }
 
+  if (m_fused_remap) {
+    fused_unpack ();
+    return;
+  }
+
   using RangePolicy = typename KT::RangePolicy;
   using MemberType  = typename KT::MemberType;
   using ESU         = ekat::ExeSpaceUtils<typename KT::ExeSpace>;
@@ -819,6 +887,104 @@ void CoarseningRemapper::recv_and_unpack ()
   }
 }
 
+bool CoarseningRemapper::is_fused_field (const int ifield) const
+{
+  // Masked fields need the mask in the mat-vec, so they go through the regular path
+  return m_fused_remap and m_field_idx_to_mask_idx.at(ifield)<=0;
+}
+
+void CoarseningRemapper::fused_mat_vec_and_pack ()
+{
+  using MemberType  = typename KT::MemberType;
+  using ESU         = ekat::ExeSpaceUtils<typename KT::ExeSpace>;
+
+  const int fused_size = m_fused_pack_size;
+  if (fused_size==0) {
+    return;
+  }
+
+  const int num_send_gids = m_ov_coarse_grid->get_num_local_dofs();
+  const auto pid_lid_start = m_send_pid_lids_start;
+  const auto lids_pids = m_send_lids_pids;
+  const auto f_pid_offsets = m_send_f_pid_offsets;
+  const auto buf = m_send_buffer;
+  const auto table = m_fused_pack_table;
+
+  auto row_offsets = m_row_offsets;
+  auto col_lids    = m_col_lids;
+  auto weights     = m_weights;
+
+  // Each row of the matrix is a dof of the ov tgt grid, and each dof is sent to exactly
+  // one PID, so we can loop over the send dofs, and do the mat-vec for all fields at once.
+  auto policy = ESU::get_default_team_policy(num_send_gids,fused_size);
+  Kokkos::parallel_for(policy,
+                       KOKKOS_LAMBDA(const MemberType& team){
+    const int i = team.league_rank();
+    const int lid = lids_pids(i,0);
+    const int pid = lids_pids(i,1);
+    const int lidpos = i - pid_lid_start(pid);
+
+    const auto beg = row_offsets(lid);
+    const auto end = row_offsets(lid+1);
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(team,fused_size),
+                         [&](const int idx) {
+      const auto& e = table(find_fused_entry(table,idx));
+      const int j = idx - e.offset;
+      const Real* x = e.src + e.col_offset(j);
+      const int col_stride = e.strides[0];
+
+      Real y = weights(beg)*x[col_lids(beg)*col_stride];
+      for (int icol=beg+1; icol<end; ++icol) {
+        y += weights(icol)*x[col_lids(icol)*col_stride];
+      }
+      buf(f_pid_offsets(e.ifield,pid) + lidpos*e.col_size + j) = y;
+    });
+  });
+}
+
+void CoarseningRemapper::fused_unpack ()
+{
+  using MemberType  = typename KT::MemberType;
+  using ESU         = ekat::ExeSpaceUtils<typename KT::ExeSpace>;
+
+  const int fused_size = m_fused_unpack_size;
+  if (fused_size==0) {
+    return;
+  }
+
+  const int num_tgt_dofs = m_tgt_grid->get_num_local_dofs();
+
+  const auto buf = m_recv_buffer;
+  const auto recv_lids_beg = m_recv_lids_beg;
+  const auto recv_lids_end = m_recv_lids_end;
+  const auto recv_lids_pidpos = m_recv_lids_pidpos;
+  const auto f_pid_offsets = m_recv_f_pid_offsets;
+  const auto table = m_fused_unpack_table;
+
+  // Each thread accumulates all contributions for one entry, so there is no need
+  // to zero out the tgt fields beforehand.
+  auto policy = ESU::get_default_team_policy(num_tgt_dofs,fused_size);
+  Kokkos::parallel_for(policy,
+                       KOKKOS_LAMBDA(const MemberType& team){
+    const int lid = team.league_rank();
+    const int recv_beg = recv_lids_beg(lid);
+    const int recv_end = recv_lids_end(lid);
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(team,fused_size),
+                         [&](const int idx) {
+      const auto& e = table(find_fused_entry(table,idx));
+      const int j = idx - e.offset;
+
+      Real y = 0;
+      for (int irecv=recv_beg; irecv<recv_end; ++irecv) {
+        const int pid = recv_lids_pidpos(irecv,0);
+        const int lidpos = recv_lids_pidpos(irecv,1);
+        y += buf(f_pid_offsets(e.ifield,pid) + lidpos*e.col_size + j);
+      }
+      e.tgt[lid*e.strides[0] + e.col_offset(j)] = y;
+    });
+  });
+}
+
 std::vector<int>
 CoarseningRemapper::get_pids_for_recv (const std::vector<int>& send_to_pids) const
 {
@@ -912,28 +1078,15 @@ recv_gids_from_pids (const std::map<int,std::vector<int>>& pid2gids_send) const
   return pid2gids_recv;
 }
 
-void CoarseningRemapper::setup_mpi_data_structures ()
+void CoarseningRemapper::build_mpi_plan ()
 {
-  using namespace ShortFieldTagsNames;
   using gid_type = AbstractGrid::gid_type;
 
-  const auto mpi_comm  = m_comm.mpi_comm();
-  const auto mpi_real  = ekat::get_mpi_type<Real>();
-
-  const int last_rank = m_comm.size()-1;
-
-  // Pre-compute the amount of data stored in each field on each dof
-  std::vector<int> field_col_size (m_num_fields);
-  int sum_fields_col_sizes = 0;
-  for (int i=0; i<m_num_fields; ++i) {
-    const auto& f  = m_src_fields[i];
-    const auto& fl = f.get_header().get_identifier().get_layout();
-    field_col_size[i] = fl.clone().strip_dim(COL).size();
-    sum_fields_col_sizes += field_col_size[i];
-  }
+  auto plan = std::make_shared<CoarseningMpiPlan>();
+  const int nranks = m_comm.size();
 
   // --------------------------------------------------------- //
-  //                   Setup SEND structures                   //
+  //                      SEND structures                      //
   // --------------------------------------------------------- //
 
   // 1. Retrieve pid (and associated lid) of all ov gids
@@ -950,70 +1103,30 @@ void CoarseningRemapper::setup_mpi_data_structures ()
     pid2lids_send[pid].push_back(i);
     pid2gids_send[pid].push_back(ov_gids(i));
   }
-  const int num_send_pids = pid2lids_send.size();
-  m_send_lids_pids = view_2d<int>("",num_ov_gids,2);
-  m_send_pid_lids_start = view_1d<int>("",m_comm.size());
-  auto send_lids_pids_h = Kokkos::create_mirror_view(m_send_lids_pids);
-  auto send_pid_lids_start_h = Kokkos::create_mirror_view(m_send_pid_lids_start);
-  for (int pid=0,pos=0; pid<m_comm.size(); ++pid) {
+  plan->send_lids_pids = view_2d<int>("",num_ov_gids,2);
+  plan->send_pid_lids_start = view_1d<int>("",nranks);
+  auto send_lids_pids_h = Kokkos::create_mirror_view(plan->send_lids_pids);
+  auto send_pid_lids_start_h = Kokkos::create_mirror_view(plan->send_pid_lids_start);
+  plan->num_send_gids.resize(nranks);
+  for (int pid=0,pos=0; pid<nranks; ++pid) {
     send_pid_lids_start_h(pid) = pos;
     for (auto lid : pid2lids_send[pid]) {
       send_lids_pids_h(pos,0) = lid;
       send_lids_pids_h(pos++,1) = pid;
     }
+    plan->num_send_gids[pid] = pid2lids_send[pid].size();
   }
-  Kokkos::deep_copy(m_send_lids_pids,send_lids_pids_h);
-  Kokkos::deep_copy(m_send_pid_lids_start,send_pid_lids_start_h);
-
-  // 3. Compute offsets in send buffer for each pid/field pair
-  m_send_f_pid_offsets = view_2d<int>("",m_num_fields,m_comm.size());
-  auto send_f_pid_offsets_h = Kokkos::create_mirror_view(m_send_f_pid_offsets);
-  std::vector<int> send_pid_offsets(m_comm.size());
-  for (int pid=0,pos=0; pid<m_comm.size(); ++pid) {
-    send_pid_offsets[pid] = pos;
-    for (int i=0; i<m_num_fields; ++i) {
-      send_f_pid_offsets_h(i,pid) = pos;
-      pos += field_col_size[i]*pid2lids_send[pid].size();
-    }
-
-    // At the end, pos must match the total amount of data in the overlapped fields
-    if (pid==last_rank) {
-      EKAT_REQUIRE_MSG (pos==num_ov_gids*sum_fields_col_sizes,
-          "Error! Something went wrong in CoarseningRemapper::setup_mpi_structures.\n");
-    }
-  }
-  Kokkos::deep_copy (m_send_f_pid_offsets,send_f_pid_offsets_h);
-
-  // 4. Allocate send buffers
-  m_send_buffer = view_1d<Real>("",sum_fields_col_sizes*num_ov_gids);
-  m_mpi_send_buffer = Kokkos::create_mirror_view(decltype(m_mpi_send_buffer)::execution_space(),m_send_buffer);
-
-  // 5. Setup send requests
-  m_send_req.reserve(num_send_pids);
-  for (const auto& it : pid2lids_send) {
-    const int n = it.second.size()*sum_fields_col_sizes;
-    if (n==0) {
-      continue;
-    }
-
-    const int pid = it.first;
-    const auto send_ptr = m_mpi_send_buffer.data() + send_pid_offsets[pid];
-
-    m_send_req.emplace_back();
-    auto& req = m_send_req.back();
-    MPI_Send_init (send_ptr, n, mpi_real, pid,
-                   0, mpi_comm, &req);
-  }
+  Kokkos::deep_copy(plan->send_lids_pids,send_lids_pids_h);
+  Kokkos::deep_copy(plan->send_pid_lids_start,send_pid_lids_start_h);
 
   // --------------------------------------------------------- //
-  //                   Setup RECV structures                   //
+  //                      RECV structures                      //
   // --------------------------------------------------------- //
 
   // 1. Obtain the dual map of send_gids: a list of gids we need to
   //    receive, grouped by the pid we recv them from
   const int num_tgt_dofs = m_tgt_grid->get_num_local_dofs();
   auto pid2gids_recv = recv_gids_from_pids(pid2gids_send);
-  const int num_recv_pids = pid2gids_recv.size();
 
   // 2. Convert the gids to lids, and arrange them by lid
   std::vector<std::vector<int>> lid2pids_recv(num_tgt_dofs);
@@ -1030,12 +1143,12 @@ void CoarseningRemapper::setup_mpi_data_structures ()
 
   // 3. Splice the vector-of-vectors above in a 1d view,
   //    keeping track of where each lid starts/ends
-  m_recv_lids_pidpos = view_2d<int>("",num_total_recv_gids,2);
-  m_recv_lids_beg = view_1d<int>("",num_tgt_dofs);
-  m_recv_lids_end = view_1d<int>("",num_tgt_dofs);
-  auto recv_lids_pidpos_h = Kokkos::create_mirror_view(m_recv_lids_pidpos);
-  auto recv_lids_beg_h  = Kokkos::create_mirror_view(m_recv_lids_beg);
-  auto recv_lids_end_h  = Kokkos::create_mirror_view(m_recv_lids_end);
+  plan->recv_lids_pidpos = view_2d<int>("",num_total_recv_gids,2);
+  plan->recv_lids_beg = view_1d<int>("",num_tgt_dofs);
+  plan->recv_lids_end = view_1d<int>("",num_tgt_dofs);
+  auto recv_lids_pidpos_h = Kokkos::create_mirror_view(plan->recv_lids_pidpos);
+  auto recv_lids_beg_h  = Kokkos::create_mirror_view(plan->recv_lids_beg);
+  auto recv_lids_end_h  = Kokkos::create_mirror_view(plan->recv_lids_end);
 
   auto tgt_dofs_h = m_tgt_grid->get_dofs_gids().get_view<const gid_type*,Host>();
   for (int i=0,pos=0; i<num_tgt_dofs; ++i) {
@@ -1044,34 +1157,116 @@ void CoarseningRemapper::setup_mpi_data_structures ()
     for (auto pid : lid2pids_recv[i]) {
       auto it = std::find(pid2gids_recv.at(pid).begin(),pid2gids_recv.at(pid).end(),gid);
       EKAT_REQUIRE_MSG (it!=pid2gids_recv.at(pid).end(),
-          "Error! Something went wrong in CoarseningRemapper::setup_mpi_structures.\n");
+          "Error! Something went wrong in CoarseningRemapper::build_mpi_plan.\n");
       recv_lids_pidpos_h(pos,0) = pid;
       recv_lids_pidpos_h(pos++,1) = std::distance(pid2gids_recv.at(pid).begin(),it);
     }
     recv_lids_end_h(i) = pos;
   }
-  Kokkos::deep_copy(m_recv_lids_pidpos,recv_lids_pidpos_h);
-  Kokkos::deep_copy(m_recv_lids_beg,recv_lids_beg_h);
-  Kokkos::deep_copy(m_recv_lids_end,recv_lids_end_h);
-
-  // 3. Splice gids from all pids, and convert to lid, and compute the offset of each pid
-  //    in the spliced list of gids.
-  std::vector<int> recv_pid_start(m_comm.size()+1);
-  for (int pid=0,pos=0; pid<=m_comm.size(); ++pid) {
-    recv_pid_start[pid] = pos;
-    pos += pid2gids_recv[pid].size();
+  Kokkos::deep_copy(plan->recv_lids_pidpos,recv_lids_pidpos_h);
+  Kokkos::deep_copy(plan->recv_lids_beg,recv_lids_beg_h);
+  Kokkos::deep_copy(plan->recv_lids_end,recv_lids_end_h);
+
+  // 4. Store the number of gids received from each pid
+  plan->num_recv_gids.resize(nranks);
+  for (int pid=0; pid<nranks; ++pid) {
+    auto it = pid2gids_recv.find(pid);
+    plan->num_recv_gids[pid] = it==pid2gids_recv.end() ? 0 : it->second.size();
+  }
+
+  m_data->coarsening_plan = plan;
+}
+
+void CoarseningRemapper::setup_mpi_data_structures ()
+{
+  using namespace ShortFieldTagsNames;
+
+  const auto mpi_comm  = m_comm.mpi_comm();
+  const auto mpi_real  = ekat::get_mpi_type<Real>();
+
+  const int last_rank = m_comm.size()-1;
+
+  // The plan does not depend on the fields, so it is built only once for all
+  // the remappers sharing the remap data (this is where all the setup collectives are)
+  if (m_data->coarsening_plan==nullptr) {
+    build_mpi_plan ();
+  }
+  const auto& plan = *m_data->coarsening_plan;
+  m_send_lids_pids      = plan.send_lids_pids;
+  m_send_pid_lids_start = plan.send_pid_lids_start;
+  m_recv_lids_pidpos    = plan.recv_lids_pidpos;
+  m_recv_lids_beg       = plan.recv_lids_beg;
+  m_recv_lids_end       = plan.recv_lids_end;
+
+  // Pre-compute the amount of data stored in each field on each dof
+  std::vector<int> field_col_size (m_num_fields);
+  int sum_fields_col_sizes = 0;
+  for (int i=0; i<m_num_fields; ++i) {
+    const auto& f  = m_src_fields[i];
+    const auto& fl = f.get_header().get_identifier().get_layout();
+    field_col_size[i] = fl.clone().strip_dim(COL).size();
+    sum_fields_col_sizes += field_col_size[i];
+  }
+
+  // --------------------------------------------------------- //
+  //                   Setup SEND structures                   //
+  // --------------------------------------------------------- //
+
+  const int num_ov_gids = m_ov_coarse_grid->get_num_local_dofs();
+
+  // 1. Compute offsets in send buffer for each pid/field pair
+  m_send_f_pid_offsets = view_2d<int>("",m_num_fields,m_comm.size());
+  auto send_f_pid_offsets_h = Kokkos::create_mirror_view(m_send_f_pid_offsets);
+  std::vector<int> send_pid_offsets(m_comm.size());
+  for (int pid=0,pos=0; pid<m_comm.size(); ++pid) {
+    send_pid_offsets[pid] = pos;
+    for (int i=0; i<m_num_fields; ++i) {
+      send_f_pid_offsets_h(i,pid) = pos;
+      pos += field_col_size[i]*plan.num_send_gids[pid];
+    }
+
+    // At the end, pos must match the total amount of data in the overlapped fields
+    if (pid==last_rank) {
+      EKAT_REQUIRE_MSG (pos==num_ov_gids*sum_fields_col_sizes,
+          "Error! Something went wrong in CoarseningRemapper::setup_mpi_structures.\n");
+    }
+  }
+  Kokkos::deep_copy (m_send_f_pid_offsets,send_f_pid_offsets_h);
+
+  // 2. Allocate send buffers
+  m_send_buffer = view_1d<Real>("",sum_fields_col_sizes*num_ov_gids);
+  m_mpi_send_buffer = Kokkos::create_mirror_view(decltype(m_mpi_send_buffer)::execution_space(),m_send_buffer);
+
+  // 3. Setup send requests
+  for (int pid=0; pid<m_comm.size(); ++pid) {
+    const int n = plan.num_send_gids[pid]*sum_fields_col_sizes;
+    if (n==0) {
+      continue;
+    }
+
+    const auto send_ptr = m_mpi_send_buffer.data() + send_pid_offsets[pid];
+
+    m_send_req.emplace_back();
+    auto& req = m_send_req.back();
+    MPI_Send_init (send_ptr, n, mpi_real, pid,
+                   0, mpi_comm, &req);
   }
 
-  // 4. Compute offsets in recv buffer for each pid/field pair
+  // --------------------------------------------------------- //
+  //                   Setup RECV structures                   //
+  // --------------------------------------------------------- //
+
+  const int num_total_recv_gids = plan.recv_lids_pidpos.extent_int(0);
+
+  // 1. Compute offsets in recv buffer for each pid/field pair
   m_recv_f_pid_offsets = view_2d<int>("",m_num_fields,m_comm.size());
   auto recv_f_pid_offsets_h = Kokkos::create_mirror_view(m_recv_f_pid_offsets);
   std::vector<int> recv_pid_offsets(m_comm.size());
   for (int pid=0,pos=0; pid<m_comm.size(); ++pid) {
     recv_pid_offsets[pid] = pos;
-    const int num_recv_gids = recv_pid_start[pid+1] - recv_pid_start[pid];
     for (int i=0; i<m_num_fields; ++i) {
       recv_f_pid_offsets_h(i,pid) = pos;
-      pos += field_col_size[i]*num_recv_gids;
+      pos += field_col_size[i]*plan.num_recv_gids[pid];
     }
 
     // // At the end, pos must match the total amount of data received
@@ -1082,15 +1277,13 @@ void CoarseningRemapper::setup_mpi_data_structures ()
   }
   Kokkos::deep_copy (m_recv_f_pid_offsets,recv_f_pid_offsets_h);
 
-  // 5. Allocate recv buffers
+  // 2. Allocate recv buffers
   m_recv_buffer = view_1d<Real>("",sum_fields_col_sizes*num_total_recv_gids);
   m_mpi_recv_buffer = Kokkos::create_mirror_view(decltype(m_mpi_recv_buffer)::execution_space(),m_recv_buffer);
 
-  // 6. Setup recv requests
-  m_recv_req.reserve(num_recv_pids);
+  // 3. Setup recv requests
   for (int pid=0; pid<m_comm.size(); ++pid) {
-    const int num_recv_gids = recv_pid_start[pid+1] - recv_pid_start[pid];
-    const int n = num_recv_gids*sum_fields_col_sizes;
+    const int n = plan.num_recv_gids[pid]*sum_fields_col_sizes;
     if (n==0) {
       continue;
     }
@@ -1102,6 +1295,53 @@ void CoarseningRemapper::setup_mpi_data_structures ()
     MPI_Recv_init (recv_ptr, n, mpi_real, pid,
                    0, mpi_comm, &req);
   }
+
+  setup_fused_tables ();
+}
+
+void CoarseningRemapper::setup_fused_tables ()
+{
+  using namespace ShortFieldTagsNames;
+
+  auto fill_entry = [&](FusedRemapEntry& e, const int ifield, const Field& f, const int offset) {
+    const auto& fl = f.get_header().get_identifier().get_layout();
+    e.ifield = ifield;
+    e.offset = offset;
+    e.col_size = fl.clone().strip_dim(COL).size();
+    e.rank = fl.rank();
+    for (int d=0; d<e.rank; ++d) {
+      e.extents[d] = fl.dim(d);
+    }
+  };
+
+  // The mat-vec+pack table only contains the fields that do not track a mask
+  int num_pack_entries = 0;
+  for (int i=0; i<m_num_fields; ++i) {
+    num_pack_entries += m_field_idx_to_mask_idx.at(i)<=0 ? 1 : 0;
+  }
+  m_fused_pack_table   = fused_table_type("fused_pack_table",num_pack_entries);
+  m_fused_unpack_table = fused_table_type("fused_unpack_table",m_num_fields);
+  auto pack_table_h   = Kokkos::create_mirror_view(m_fused_pack_table);
+  auto unpack_table_h = Kokkos::create_mirror_view(m_fused_unpack_table);
+
+  m_fused_pack_size = m_fused_unpack_size = 0;
+  for (int i=0, ipack=0; i<m_num_fields; ++i) {
+    if (m_field_idx_to_mask_idx.at(i)<=0) {
+      auto& e = pack_table_h(ipack++);
+      fill_entry(e,i,m_src_fields[i],m_fused_pack_size);
+      e.src = get_data_and_strides<const Real>(m_src_fields[i],e.strides);
+      e.tgt = nullptr;
+      m_fused_pack_size += e.col_size;
+    }
+
+    auto& e = unpack_table_h(i);
+    fill_entry(e,i,m_tgt_fields[i],m_fused_unpack_size);
+    e.src = nullptr;
+    e.tgt = get_data_and_strides<Real>(m_tgt_fields[i],e.strides);
+    m_fused_unpack_size += e.col_size;
+  }
+  Kokkos::deep_copy(m_fused_pack_table,pack_table_h);
+  Kokkos::deep_copy(m_fused_unpack_table,unpack_table_h);
 }
 
 void CoarseningRemapper::clean_up ()
@@ -1120,6 +1360,10 @@ void CoarseningRemapper::clean_up ()
   m_recv_lids_end       = view_1d<int>();
   m_send_req.clear();
   m_recv_req.clear();
+  m_fused_pack_table    = fused_table_type();
+  m_fused_unpack_table  = fused_table_type();
+  m_fused_pack_size     = 0;
+  m_fused_unpack_size   = 0;
 
   HorizInterpRemapperBase::clean_up();
 }
@@ -36,6 +36,12 @@ namespace scream
  * The setup as well as the runtime operations use classic send/recv
  * MPI calls, where data is packed in a buffer and sent to the recv rank,
  * where it is then unpacked and accumulated into the result.
+ *
+ * Optionally (see set_fused_remap), stages 1 and 2 can be fused across fields:
+ * the mat-vec of all the fields not tracking a mask is done in a single kernel,
+ * over the packed (nfields x col_size) rhs, which writes directly in the send
+ * buffer, and the unpack of all fields is also done in a single kernel. In either
+ * case, the data of all fields is sent to each PID with a single message.
  */
 
 class CoarseningRemapper : public HorizInterpRemapperBase
@@ -49,6 +55,37 @@ public:
 
   ~CoarseningRemapper ();
 
+  // If true, remap all fields (except those tracking a mask) with a single
+  // mat-vec+pack kernel, and unpack all fields with a single kernel.
+  // This greatly reduces the number of kernel launches when remapping many fields.
+  void set_fused_remap (const bool fused) { m_fused_remap = fused; }
+  bool get_fused_remap () const { return m_fused_remap; }
+
+  // An entry in the tables used by the fused kernels. Each entry is a field,
+  // and the entries span the flattened (nfields x col_size) index space.
+  struct FusedRemapEntry {
+    const Real* src;        // Src field data (used during mat-vec+pack)
+    Real*       tgt;        // Tgt field data (used during unpack)
+    int         ifield;     // Index of the field in the remapper
+    int         offset;     // Offset of this field in the flattened index space
+    int         col_size;   // Number of entries of the field in each column
+    int         rank;
+    int         extents[Field::MaxRank];
+    int         strides[Field::MaxRank];
+
+    // Offset in the field data of the i-th entry of the column (in LayoutRight order)
+    KOKKOS_INLINE_FUNCTION
+    int col_offset (int i) const {
+      int off = 0;
+      for (int d=rank-1; d>0; --d) {
+        off += (i % extents[d])*strides[d];
+        i /= extents[d];
+      }
+      return off;
+    }
+  };
+  using fused_table_type = typename KT::template view_1d<FusedRemapEntry>;
+
 protected:
 
   void do_bind_field (const int ifield, const field_type& src, const field_type& tgt) override;
@@ -62,6 +99,15 @@ protected:
 
   void setup_mpi_data_structures () override;
 
+  // Build the field-independent part of the MPI structures, stored in the remap data
+  void build_mpi_plan ();
+
+  // Build the tables for the fused mat-vec+pack and unpack kernels
+  void setup_fused_tables ();
+
+  // Whether the i-th field is handled by the fused mat-vec+pack kernel
+  bool is_fused_field (const int ifield) const;
+
   std::vector<int> get_pids_for_recv (const std::vector<int>& send_to_pids) const;
 
   std::map<int,std::vector<int>>
@@ -81,6 +127,8 @@ public:
   void rescale_masked_fields (const Field& f_tgt, const Field& f_mask) const;
   void pack_and_send ();
   void recv_and_unpack ();
+  void fused_mat_vec_and_pack ();
+  void fused_unpack ();
   // Overload, not hide
   using HorizInterpRemapperBase::local_mat_vec;
 
@@ -148,6 +196,18 @@ protected:
   // Send/recv requests
   std::vector<MPI_Request>  m_recv_req;
   std::vector<MPI_Request>  m_send_req;
+
+  // ------- Fused remap data structures -------- //
+
+  bool                  m_fused_remap = false;
+
+  // Src fields for the mat-vec+pack kernel (only fields without mask), and
+  // tgt fields for the unpack kernel (all fields). Each table comes with the
+  // total size of its flattened index space.
+  fused_table_type      m_fused_pack_table;
+  fused_table_type      m_fused_unpack_table;
+  int                   m_fused_pack_size   = 0;
+  int                   m_fused_unpack_size = 0;
 };
 
 } // namespace scream
@@ -32,21 +32,17 @@ HorizInterpRemapperBase (const grid_ptr_type& fine_grid,
   m_bwd_allowed = false;
 
   // Get the remap data (if not already present, it will be built)
-  auto& data = s_remapper_data[m_map_file];
-  if (data.num_customers==0) {
-    data.build(m_map_file,m_fine_grid,m_comm,m_type);
-  }
-  ++data.num_customers;
+  m_data = HorizRemapperDataRepo::instance().get_data(m_map_file,m_fine_grid,m_comm,m_type);
 
-  m_row_offsets = data.row_offsets;
-  m_col_lids = data.col_lids;
-  m_weights = data.weights;
+  m_row_offsets = m_data->row_offsets;
+  m_col_lids = m_data->col_lids;
+  m_weights = m_data->weights;
 
   // The grids really only matter for the horiz part. We may have 2+ remappers with
   // fine grids that only differ in terms of number of levs. Such remappers cannot
   // store the same coarse grid. So we soft-clone the grid, and reset the number of levels
-  auto coarse_grid = data.coarse_grid->clone(data.coarse_grid->name(),true);
-  auto ov_coarse_grid = data.ov_coarse_grid->clone(data.ov_coarse_grid->name(),true);
+  auto coarse_grid = m_data->coarse_grid->clone(m_data->coarse_grid->name(),true);
+  auto ov_coarse_grid = m_data->ov_coarse_grid->clone(m_data->ov_coarse_grid->name(),true);
 
   // Reset num levs, and remove any geo data that depends on levs
   using namespace ShortFieldTagsNames;
@@ -73,19 +69,9 @@ HorizInterpRemapperBase (const grid_ptr_type& fine_grid,
 HorizInterpRemapperBase::
 ~HorizInterpRemapperBase ()
 {
-  auto it = s_remapper_data.find(m_map_file);
-  if (it==s_remapper_data.end()) {
-    // This would be very suspicious. But since the error is "benign",
-    // and since we want to avoid throwing inside a destructor, just issue a warning.
-    std::cerr << "WARNING! Remapper data for this map file was already deleted!\n"
-                 " - map file: " << m_map_file << "\n";
-    return;
-  }
-
-  --it->second.num_customers;
-  if (it->second.num_customers==0) {
-    s_remapper_data.erase(it);
-  }
+  // Drop our reference to the data, so the repo knows if we were the last customer
+  m_data = nullptr;
+  HorizRemapperDataRepo::instance().release_data(m_map_file,m_fine_grid,m_type);
 }
 
 FieldLayout HorizInterpRemapperBase::
@@ -372,8 +358,6 @@ void HorizInterpRemapperBase::clean_up ()
   m_num_bound_fields = 0;
 }
 
-std::map<std::string,HorizRemapperData> HorizInterpRemapperBase::s_remapper_data;
-
 // ETI, so derived classes can call this method
 template
 void HorizInterpRemapperBase::
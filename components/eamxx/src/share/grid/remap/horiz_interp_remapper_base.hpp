@@ -102,6 +102,9 @@ public:
   std::vector<Field>    m_ov_fields;
   std::vector<Field>    m_tgt_fields;
 
+  // The (possibly shared) remap data for our map file
+  std::shared_ptr<HorizRemapperData>  m_data;
+
   // ----- Sparse matrix CRS representation ---- //
   view_1d<int>    m_row_offsets;
   view_1d<int>    m_col_lids;
@@ -114,8 +117,6 @@ public:
   InterpType      m_type;
 
   ekat::Comm      m_comm;
-
-  static std::map<std::string,HorizRemapperData> s_remapper_data;
 };
 
 } // namespace scream
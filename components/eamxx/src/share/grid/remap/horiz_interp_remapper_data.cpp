@@ -4,10 +4,60 @@
 #include "share/grid/grid_import_export.hpp"
 #include "share/io/scream_scorpio_interface.hpp"
 
+#include <iostream>
 #include <numeric>
 
 namespace scream {
 
+// --------------- HorizRemapperDataRepo ---------------- //
+
+std::shared_ptr<HorizRemapperData>
+HorizRemapperDataRepo::
+get_data (const std::string& map_file,
+          const std::shared_ptr<const AbstractGrid>& fine_grid,
+          const ekat::Comm& comm,
+          const InterpType type)
+{
+  auto& data = m_data[key(map_file,fine_grid,type)];
+  if (data==nullptr) {
+    data = std::make_shared<HorizRemapperData>();
+    data->build(map_file,fine_grid,comm,type);
+  }
+  return data;
+}
+
+void HorizRemapperDataRepo::
+release_data (const std::string& map_file,
+              const std::shared_ptr<const AbstractGrid>& fine_grid,
+              const InterpType type)
+{
+  auto it = m_data.find(key(map_file,fine_grid,type));
+  if (it==m_data.end()) {
+    // This would be very suspicious. But since the error is "benign",
+    // and since this is called inside destructors, just issue a warning.
+    std::cerr << "WARNING! Remapper data for this map file was already deleted!\n"
+                 " - map file: " << map_file << "\n";
+    return;
+  }
+
+  // If the repo is the only owner, nobody needs this data anymore
+  if (it->second.use_count()==1) {
+    m_data.erase(it);
+  }
+}
+
+std::string HorizRemapperDataRepo::
+key (const std::string& map_file,
+     const std::shared_ptr<const AbstractGrid>& fine_grid,
+     const InterpType type) const
+{
+  // The number of levels is irrelevant for horiz remap, so only use the grid
+  // name and its global number of dofs
+  return map_file + "-" + fine_grid->name() + "<"
+       + std::to_string(fine_grid->get_num_global_dofs()) + ">-"
+       + (type==InterpType::Refine ? "refine" : "coarsen");
+}
+
 // --------------- HorizRemapperData ---------------- //
 
 void HorizRemapperData::
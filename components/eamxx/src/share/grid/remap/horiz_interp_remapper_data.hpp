@@ -12,11 +12,35 @@
 
 namespace scream {
 
+class GridImportExport;
+
 enum class InterpType {
   Refine,
   Coarsen
 };
 
+// The MPI plan of a CoarseningRemapper: which ov coarse dofs are sent to which
+// pid, and how the contributions received from other pids are accumulated.
+// It only depends on the coarse grids, not on the fields being remapped.
+// See CoarseningRemapper for a description of the views.
+struct CoarseningMpiPlan {
+  using KT = KokkosTypes<DefaultDevice>;
+  template<typename T>
+  using view_1d = typename KT::template view_1d<T>;
+  template<typename T>
+  using view_2d = typename KT::template view_2d<T>;
+
+  // Number of ov dofs to send to/recv from each pid
+  std::vector<int>  num_send_gids;
+  std::vector<int>  num_recv_gids;
+
+  view_2d<int>      send_lids_pids;
+  view_1d<int>      send_pid_lids_start;
+  view_2d<int>      recv_lids_pidpos;
+  view_1d<int>      recv_lids_beg;
+  view_1d<int>      recv_lids_end;
+};
+
 // A small struct to hold horiz remap data, which can
 // be shared across multiple horiz remappers
 struct HorizRemapperData {
@@ -38,7 +62,11 @@ struct HorizRemapperData {
   view_1d<int>    col_lids;
   view_1d<Real>   weights;
 
-  int num_customers = 0;
+  // The MPI plans, which do not depend on the fields. They are built by the
+  // first remapper that needs them, and reused by all the others.
+  std::shared_ptr<CoarseningMpiPlan>  coarsening_plan;
+  std::shared_ptr<GridImportExport>   refining_imp_exp;   // (coarse_grid,ov_coarse_grid)
+
 private:
   using gid_type = AbstractGrid::gid_type;
 
@@ -67,6 +95,42 @@ private:
   void create_crs_matrix_structures (std::vector<Triplet>& triplets);
 };
 
+// A process-wide cache of horiz remap data. Remappers using the same map file on the
+// same fine grid with the same interp type share the data, so that the map file is
+// read (and the MPI plans are built) only once. The data is kept as long as at least
+// one remapper uses it.
+class HorizRemapperDataRepo {
+public:
+  static HorizRemapperDataRepo& instance () {
+    static HorizRemapperDataRepo repo;
+    return repo;
+  }
+
+  // Get the data for this map file and fine grid (building it, if not present)
+  std::shared_ptr<HorizRemapperData>
+  get_data (const std::string& map_file,
+            const std::shared_ptr<const AbstractGrid>& fine_grid,
+            const ekat::Comm& comm,
+            const InterpType type);
+
+  // Tell the repo a remapper no longer needs the data. If no other
+  // remapper uses it, the data is removed from the repo.
+  void release_data (const std::string& map_file,
+                     const std::shared_ptr<const AbstractGrid>& fine_grid,
+                     const InterpType type);
+
+  int num_entries () const { return m_data.size(); }
+
+private:
+  HorizRemapperDataRepo () = default;
+
+  std::string key (const std::string& map_file,
+                   const std::shared_ptr<const AbstractGrid>& fine_grid,
+                   const InterpType type) const;
+
+  std::map<std::string,std::shared_ptr<HorizRemapperData>> m_data;
+};
+
 } // namespace scream
 
 #endif // EAMXX_HORIZ_INTERP_REMAP_DATA_HPP
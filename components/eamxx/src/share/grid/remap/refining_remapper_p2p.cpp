@@ -31,6 +31,7 @@ void RefiningRemapperP2P::do_remap_fwd ()
 {
   // Fire the recv requests right away, so that if some other ranks
   // is done packing before us, we can start receiving their data
+  // Note: the neighborhood collective recvs are started with the sends
   if (not m_recv_req.empty()) {
     check_mpi_call(MPI_Startall(m_recv_req.size(),m_recv_req.data()),
                    "[RefiningRemapperP2P] starting persistent recv requests.\n");
@@ -99,7 +100,12 @@ void RefiningRemapperP2P::setup_mpi_data_structures ()
   // Figure out where ov_src cols are received from
   const int ncols_recv = m_ov_coarse_grid->get_num_local_dofs();
 
-  m_imp_exp = std::make_shared<GridImportExport>(m_src_grid,m_ov_coarse_grid);
+  // The import/export only depends on the grids dofs, so it is built only once
+  // for all the remappers sharing the remap data
+  if (m_data->refining_imp_exp==nullptr) {
+    m_data->refining_imp_exp = std::make_shared<GridImportExport>(m_src_grid,m_ov_coarse_grid);
+  }
+  m_imp_exp = m_data->refining_imp_exp;
 
   // We can now compute the offset of each pid in the recv buffer
   m_pids_recv_offsets = view_1d<int>("",nranks+1);
@@ -138,6 +144,26 @@ void RefiningRemapperP2P::setup_mpi_data_structures ()
 
   const auto mpi_comm = m_comm.mpi_comm();
   const auto mpi_real = ekat::get_mpi_type<Real>();
+  if (m_use_neighbor_collectives) {
+    // Counts/displacements must follow the order of the neighbors in the graph comm
+    for (int pid : m_imp_exp->export_neighbors()) {
+      m_neigh_send_counts.push_back(ncols_send_h(pid)*total_col_size);
+      m_neigh_send_displs.push_back(pids_send_offsets_h(pid)*total_col_size);
+    }
+    for (int pid : m_imp_exp->import_neighbors()) {
+      m_neigh_recv_counts.push_back(ncols_recv_h(pid)*total_col_size);
+      m_neigh_recv_displs.push_back(pids_recv_offsets_h(pid)*total_col_size);
+    }
+#if MPI_VERSION>=4
+    check_mpi_call(MPI_Neighbor_alltoallv_init(
+                       m_mpi_send_buffer.data(),m_neigh_send_counts.data(),m_neigh_send_displs.data(),mpi_real,
+                       m_mpi_recv_buffer.data(),m_neigh_recv_counts.data(),m_neigh_recv_displs.data(),mpi_real,
+                       m_imp_exp->neighbor_comm(),MPI_INFO_NULL,&m_neigh_req),
+                   "[RefiningRemapperP2P] creating persistent neighbor alltoallv request.\n");
+#endif
+    return;
+  }
+
   for (int pid=0; pid<nranks; ++pid) {
     // Send request
     if (ncols_send_h(pid)>0) {
@@ -287,7 +313,19 @@ void RefiningRemapperP2P::pack_and_send ()
     Kokkos::deep_copy (m_mpi_send_buffer,m_send_buffer);
   }
 
-  if (not m_send_req.empty()) {
+  if (m_use_neighbor_collectives) {
+#if MPI_VERSION>=4
+    check_mpi_call(MPI_Start(&m_neigh_req),
+                   "[RefiningRemapperP2P] start persistent neighbor alltoallv request.\n");
+#else
+    const auto mpi_real = ekat::get_mpi_type<Real>();
+    check_mpi_call(MPI_Ineighbor_alltoallv(
+                       m_mpi_send_buffer.data(),m_neigh_send_counts.data(),m_neigh_send_displs.data(),mpi_real,
+                       m_mpi_recv_buffer.data(),m_neigh_recv_counts.data(),m_neigh_recv_displs.data(),mpi_real,
+                       m_imp_exp->neighbor_comm(),&m_neigh_req),
+                   "[RefiningRemapperP2P] start neighbor alltoallv.\n");
+#endif
+  } else if (not m_send_req.empty()) {
     check_mpi_call(MPI_Startall(m_send_req.size(),m_send_req.data()),
                    "[RefiningRemapperP2P] start persistent send requests.\n");
   }
@@ -295,7 +333,10 @@ void RefiningRemapperP2P::pack_and_send ()
 
 void RefiningRemapperP2P::recv_and_unpack ()
 {
-  if (not m_recv_req.empty()) {
+  if (m_use_neighbor_collectives) {
+    check_mpi_call(MPI_Wait(&m_neigh_req, MPI_STATUS_IGNORE),
+                   "[RefiningRemapperP2P] waiting on neighbor alltoallv request.\n");
+  } else if (not m_recv_req.empty()) {
     check_mpi_call(MPI_Waitall(m_recv_req.size(),m_recv_req.data(), MPI_STATUSES_IGNORE),
                    "[RefiningRemapperP2P] waiting on persistent recv requests.\n");
   }
@@ -433,6 +474,18 @@ void RefiningRemapperP2P::clean_up ()
   m_mpi_recv_buffer     = mpi_view_1d<Real>();
   m_send_req.clear();
   m_recv_req.clear();
+#if MPI_VERSION>=4
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (m_neigh_req!=MPI_REQUEST_NULL and not finalized) {
+    MPI_Request_free(&m_neigh_req);
+  }
+#endif
+  m_neigh_req = MPI_REQUEST_NULL;
+  m_neigh_send_counts.clear();
+  m_neigh_send_displs.clear();
+  m_neigh_recv_counts.clear();
+  m_neigh_recv_displs.clear();
   m_imp_exp = nullptr;
 
   HorizInterpRemapperBase::clean_up();
@@ -55,6 +55,14 @@ public:
 
   ~RefiningRemapperP2P ();
 
+  // If true, use a (persistent, if MPI>=4) neighborhood alltoallv over the
+  // import/export graph, rather than persistent p2p send/recv requests.
+  // Must be called before the MPI structures are set up (i.e., before
+  // registration ends).
+  void set_use_neighbor_collectives (const bool use_neighbor_collectives) {
+    m_use_neighbor_collectives = use_neighbor_collectives;
+  }
+
 protected:
 
   void do_remap_fwd () override;
@@ -114,6 +122,15 @@ protected:
   // Send/recv persistent requests
   std::vector<MPI_Request>  m_send_req;
   std::vector<MPI_Request>  m_recv_req;
+
+  // Neighborhood collective counts/displacements (one entry per neighbor)
+  // and request. With MPI>=4, the request is persistent.
+  bool                      m_use_neighbor_collectives = false;
+  std::vector<int>          m_neigh_send_counts;
+  std::vector<int>          m_neigh_send_displs;
+  std::vector<int>          m_neigh_recv_counts;
+  std::vector<int>          m_neigh_recv_displs;
+  MPI_Request               m_neigh_req = MPI_REQUEST_NULL;
 };
 
 } // namespace scream
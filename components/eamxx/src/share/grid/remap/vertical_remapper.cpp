@@ -8,6 +8,7 @@
 #include "share/io/scream_scorpio_interface.hpp"
 
 #include <ekat/util/ekat_units.hpp>
+#include <ekat/util/ekat_upper_bound.hpp>
 #include <ekat/kokkos/ekat_kokkos_utils.hpp>
 #include <ekat/ekat_pack_utils.hpp>
 #include <ekat/ekat_pack_kokkos.hpp>
@@ -301,6 +302,7 @@ do_bind_field (const int ifield, const field_type& src, const field_type& tgt)
 
   if (this->m_num_bound_fields==this->m_num_registered_fields) {
     create_lin_interp ();
+    create_fused_series ();
   }
 }
 
@@ -308,6 +310,7 @@ void VerticalRemapper::do_registration_ends ()
 {
   if (this->m_num_bound_fields==this->m_num_registered_fields) {
     create_lin_interp ();
+    create_fused_series ();
   }
 }
 
@@ -361,30 +364,108 @@ void VerticalRemapper::create_lin_interp()
   }
 }
 
-void VerticalRemapper::do_remap_fwd ()
+void VerticalRemapper::
+create_fused_series ()
 {
-  // 1. Setup any interp object that was created (if nullptr, no fields need it)
-  if (m_lin_interp_mid_packed) {
-    setup_lin_interp(*m_lin_interp_mid_packed,m_src_pmid);
+  using namespace ShortFieldTagsNames;
+
+  std::vector<Series> series;
+  bool has_mid = false;
+  bool has_int = false;
+  auto add_series = [&](const Field& f_src, const Field& f_tgt, const Real mask_val) {
+    const auto& type = m_field2type.at(f_src.name());
+    has_mid |= type.midpoints;
+    has_int |= not type.midpoints;
+    switch (f_src.rank()) {
+      case 2:
+      {
+        auto src = f_src.get_view<const Real**>();
+        auto tgt = f_tgt.get_view<      Real**>();
+        series.push_back(Series{src.data(),tgt.data(),
+                                static_cast<int>(src.stride(0)),static_cast<int>(tgt.stride(0)),
+                                type.midpoints,mask_val});
+      } break;
+      case 3:
+      {
+        auto src = f_src.get_view<const Real***>();
+        auto tgt = f_tgt.get_view<      Real***>();
+        for (int icmp=0; icmp<src.extent_int(1); ++icmp) {
+          series.push_back(Series{src.data()+icmp*src.stride(1),tgt.data()+icmp*tgt.stride(1),
+                                  static_cast<int>(src.stride(0)),static_cast<int>(tgt.stride(0)),
+                                  type.midpoints,mask_val});
+        }
+      } break;
+      default:
+        EKAT_ERROR_MSG (
+            "[VerticalRemapper::create_fused_series] Error! Unsupported field rank.\n"
+            " - src field name: " + f_src.name() + "\n"
+            " - src field rank: " + std::to_string(f_src.rank()) + "\n");
+    }
+  };
+
+  for (int i=0; i<m_num_fields; ++i) {
+    const auto& tgt_layout = m_tgt_fields[i].get_header().get_identifier().get_layout();
+    if (tgt_layout.has_tag(LEV)) {
+      add_series(m_src_fields[i],m_tgt_fields[i],m_mask_val);
+    }
   }
-  if (m_lin_interp_int_packed) {
-    setup_lin_interp(*m_lin_interp_int_packed,m_src_pint);
+  for (size_t i=0; i<m_tgt_masks.size(); ++i) {
+    add_series(m_src_masks[i],m_tgt_masks[i],0);
+  }
+
+  m_series = view_1d<Series>("vremap_series",series.size());
+  auto series_h = Kokkos::create_mirror_view(m_series);
+  std::copy(series.begin(),series.end(),series_h.data());
+  Kokkos::deep_copy(m_series,series_h);
+
+  const auto ncols     = m_src_grid->get_num_local_dofs();
+  const auto nlevs_tgt = m_tgt_grid->get_num_vertical_levels();
+  if (has_mid) {
+    m_stencils_mid = view_2d<Stencil>("vremap_stencils_mid",ncols,nlevs_tgt);
   }
-  if (m_lin_interp_mid_scalar) {
-    setup_lin_interp(*m_lin_interp_mid_scalar,m_src_pmid);
+  if (has_int) {
+    m_stencils_int = view_2d<Stencil>("vremap_stencils_int",ncols,nlevs_tgt);
   }
-  if (m_lin_interp_int_scalar) {
-    setup_lin_interp(*m_lin_interp_int_scalar,m_src_pint);
+}
+
+void VerticalRemapper::do_remap_fwd ()
+{
+  // 1. Setup any interp object that was created (if nullptr, no fields need it),
+  //    or the stencils for the fused interpolation, and perform the fused interpolation
+  if (m_fused_remap) {
+    if (m_stencils_mid.size()>0) {
+      setup_stencils(m_stencils_mid,m_src_pmid);
+    }
+    if (m_stencils_int.size()>0) {
+      setup_stencils(m_stencils_int,m_src_pint);
+    }
+    apply_fused_interpolation();
+  } else {
+    if (m_lin_interp_mid_packed) {
+      setup_lin_interp(*m_lin_interp_mid_packed,m_src_pmid);
+    }
+    if (m_lin_interp_int_packed) {
+      setup_lin_interp(*m_lin_interp_int_packed,m_src_pint);
+    }
+    if (m_lin_interp_mid_scalar) {
+      setup_lin_interp(*m_lin_interp_mid_scalar,m_src_pmid);
+    }
+    if (m_lin_interp_int_scalar) {
+      setup_lin_interp(*m_lin_interp_int_scalar,m_src_pint);
+    }
   }
 
   using namespace ShortFieldTagsNames;
 
-  // 2. Interpolate the fields
+  // 2. Interpolate the fields (unless already done by the fused interpolation)
   for (int i=0; i<m_num_fields; ++i) {
     const auto& f_src    = m_src_fields[i];
           auto& f_tgt    = m_tgt_fields[i];
     const auto& tgt_layout   = f_tgt.get_header().get_identifier().get_layout();
     if (tgt_layout.has_tag(LEV)) {
+      if (m_fused_remap) {
+        continue;
+      }
       const auto& type = m_field2type.at(f_src.name());
       // Dispatch interpolation to the proper lin interp object
       if (type.midpoints) {
@@ -413,7 +494,10 @@ void VerticalRemapper::do_remap_fwd ()
     }
   }
 
-  // 3. Interpolate the mask fields
+  // 3. Interpolate the mask fields (unless already done by the fused interpolation)
+  if (m_fused_remap) {
+    return;
+  }
   for (unsigned i=0; i<m_tgt_masks.size(); ++i) {
           auto& f_src = m_src_masks[i];
           auto& f_tgt = m_tgt_masks[i];
@@ -436,6 +520,95 @@ void VerticalRemapper::do_remap_fwd ()
   }
 }
 
+void VerticalRemapper::
+setup_stencils (const view_2d<Stencil>& stencils, const Field& p_src) const
+{
+  using MemberType = typename KT::MemberType;
+  using ESU = ekat::ExeSpaceUtils<DefaultDevice::execution_space>;
+
+  auto p_src_v = p_src.get_view<const Real**>();
+  auto p_tgt_v = m_tgt_pressure.get_view<const Real*>();
+
+  const int ncols = m_src_grid->get_num_local_dofs();
+  const int nlevs_tgt = m_tgt_grid->get_num_vertical_levels();
+  const int nlevs_src = p_src.get_header().get_identifier().get_layout().dims().back();
+
+  auto lambda = KOKKOS_LAMBDA(const MemberType& team) {
+    const int icol = team.league_rank();
+    auto x_src = ekat::subview(p_src_v,icol);
+    auto beg = x_src.data();
+    auto end = beg + nlevs_src;
+    const Real x_min = x_src(0);
+    const Real x_max = x_src(nlevs_src-1);
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(team,nlevs_tgt),[&](const int k) {
+      auto& s = stencils(icol,k);
+      const Real x = p_tgt_v(k);
+      if (x<x_min or x>x_max) {
+        // Out of bounds: this entry will be masked
+        s.k0 = s.k1 = -1;
+        s.dx = 0;
+        s.den = 1;
+        return;
+      }
+
+      // Since x>=x_min, k1>0. Store dx and den separately (rather than their ratio),
+      // so that we perform the same arithmetic as ekat::LinInterp.
+      const int k1 = ekat::upper_bound(beg,end,x) - beg;
+      if (k1==nlevs_src) {
+        // Corner case: x==x_max
+        s.k0 = s.k1 = nlevs_src-1;
+        s.dx = 0;
+        s.den = 1;
+      } else {
+        s.k0 = k1-1;
+        s.k1 = k1;
+        s.dx  = x - x_src(k1-1);
+        s.den = x_src(k1) - x_src(k1-1);
+      }
+    });
+  };
+
+  auto policy = ESU::get_default_team_policy(ncols,nlevs_tgt);
+  Kokkos::parallel_for("VerticalRemapper::setup_stencils",policy,lambda);
+}
+
+void VerticalRemapper::
+apply_fused_interpolation () const
+{
+  using MemberType = typename KT::MemberType;
+
+  const int nseries = m_series.extent_int(0);
+  if (nseries==0) {
+    return;
+  }
+
+  const int ncols = m_src_grid->get_num_local_dofs();
+  const int nlevs_tgt = m_tgt_grid->get_num_vertical_levels();
+
+  auto series = m_series;
+  auto stencils_mid = m_stencils_mid;
+  auto stencils_int = m_stencils_int;
+  auto lambda = KOKKOS_LAMBDA(const MemberType& team) {
+    const int icol = team.league_rank();
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team,nlevs_tgt),[&](const int k) {
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(team,nseries),[&](const int is) {
+        const auto& sr = series(is);
+        const auto& st = sr.midpoints ? stencils_mid(icol,k) : stencils_int(icol,k);
+        Real* y_tgt = sr.tgt + icol*sr.tgt_col_stride;
+        if (st.k0<0) {
+          y_tgt[k] = sr.mask_val;
+        } else {
+          const Real* y_src = sr.src + icol*sr.src_col_stride;
+          y_tgt[k] = y_src[st.k0] + (y_src[st.k1]-y_src[st.k0])*st.dx/st.den;
+        }
+      });
+    });
+  };
+
+  auto policy = KT::TeamPolicy(ncols,Kokkos::AUTO);
+  Kokkos::parallel_for("VerticalRemapper::apply_fused_interpolation",policy,lambda);
+}
+
 template<int Packsize>
 void VerticalRemapper::
 setup_lin_interp (const ekat::LinInterp<Real,Packsize>& lin_interp,
@@ -10,6 +10,13 @@ namespace scream
 
 /*
  * A remapper to interpolate fields on a separate vertical grid
+ *
+ * By default, each field is interpolated with its own kernel, using the
+ * ekat::LinInterp object matching its vertical grid (midpoints/interfaces)
+ * and packing. Optionally (see set_fused_remap), the interpolation stencils
+ * (bracketing src levels and weights) are computed once per remap for the
+ * midpoints and interfaces src profiles, and then applied to all the fields
+ * (and their masks) in a single kernel.
  */
 
 class VerticalRemapper : public AbstractRemapper
@@ -30,6 +37,30 @@ public:
 
   ~VerticalRemapper () = default;
 
+  // If true, compute the interpolation stencils once, and apply them to all fields in one kernel
+  void set_fused_remap (const bool fused) { m_fused_remap = fused; }
+  bool get_fused_remap () const { return m_fused_remap; }
+
+  // The interpolation stencil for a tgt level in a column: the output is
+  //   y = y(k0) + (y(k1)-y(k0))*dx/den
+  // If k0<0, the tgt level is outside the bounds of the src profile, and must be masked.
+  struct Stencil {
+    int  k0;
+    int  k1;
+    Real dx;
+    Real den;
+  };
+
+  // A single component of one of the interpolated fields (or masks)
+  struct Series {
+    const Real* src;
+    Real*       tgt;
+    int         src_col_stride;
+    int         tgt_col_stride;
+    bool        midpoints;
+    Real        mask_val;
+  };
+
   FieldLayout create_src_layout (const FieldLayout& tgt_layout) const override;
   FieldLayout create_tgt_layout (const FieldLayout& src_layout) const override;
 
@@ -105,11 +136,7 @@ public:
   template<int N>
   void setup_lin_interp (const ekat::LinInterp<Real,N>& lin_interp,
                          const Field& p_src) const;
-protected:
 
-  void set_source_pressure_fields(const Field& pmid, const Field& pint);
-  void create_lin_interp ();
-  
   using KT = KokkosTypes<DefaultDevice>;
 
   template<typename T>
@@ -117,6 +144,14 @@ protected:
   template<typename T>
   using view_2d = typename KT::template view_2d<T>;
 
+  void setup_stencils (const view_2d<Stencil>& stencils, const Field& p_src) const;
+  void apply_fused_interpolation () const;
+protected:
+
+  void set_source_pressure_fields(const Field& pmid, const Field& pint);
+  void create_lin_interp ();
+  void create_fused_series ();
+
   ekat::Comm            m_comm;
 
   // Source and target fields
@@ -145,6 +180,13 @@ protected:
   std::shared_ptr<ekat::LinInterp<Real,SCREAM_PACK_SIZE>> m_lin_interp_int_packed;
   std::shared_ptr<ekat::LinInterp<Real,1>>                m_lin_interp_mid_scalar;
   std::shared_ptr<ekat::LinInterp<Real,1>>                m_lin_interp_int_scalar;
+
+  // Data structures for the fused interpolation. Stencils are only allocated
+  // if there is at least one series on the corresponding src vertical grid.
+  bool                  m_fused_remap = false;
+  view_1d<Series>       m_series;
+  view_2d<Stencil>      m_stencils_mid;
+  view_2d<Stencil>      m_stencils_int;
 };
 
 } // namespace scream
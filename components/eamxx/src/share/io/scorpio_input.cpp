@@ -3,6 +3,7 @@
 #include "share/io/scream_scorpio_interface.hpp"
 
 #include <ekat/util/ekat_string_utils.hpp>
+#include <ekat/std_meta/ekat_std_utils.hpp>
 
 #include <memory>
 #include <numeric>
@@ -203,12 +204,18 @@ set_grid (const std::shared_ptr<const AbstractGrid>& grid)
 //       provided the routine will read input at the last time level set by
 //       running eam_update_timesnap.
 void AtmosphereInput::read_variables (const int time_index)
+{
+  read_variables(time_index,m_fields_names);
+}
+
+void AtmosphereInput::
+read_variables (const int time_index, const std::vector<std::string>& var_names)
 {
   auto func_start = std::chrono::steady_clock::now();
   if (m_atm_logger) {
     m_atm_logger->info("[EAMxx::scorpio_input] Reading variables from file");
     m_atm_logger->info("  file name: " + m_filename);
-    m_atm_logger->info("  var names: " + ekat::join(m_fields_names,", "));
+    m_atm_logger->info("  var names: " + ekat::join(var_names,", "));
     if (time_index!=-1) {
       m_atm_logger->info("  time idx : " + std::to_string(time_index));
     }
@@ -216,7 +223,11 @@ void AtmosphereInput::read_variables (const int time_index)
   EKAT_REQUIRE_MSG (m_inited_with_views || m_inited_with_fields,
       "Error! Scorpio structures not inited yet. Did you forget to call 'init(..)'?\n");
 
-  for (auto const& name : m_fields_names) {
+  for (auto const& name : var_names) {
+    EKAT_REQUIRE_MSG (ekat::contains(m_fields_names,name),
+        "Error! Cannot read a variable that was not requested at initialization.\n"
+        " - file name: " + m_filename + "\n"
+        " - var name : " + name + "\n");
 
     // Read the data
     auto v1d = m_host_views_1d.at(name);
@@ -321,10 +332,14 @@ void AtmosphereInput::read_variables (const int time_index)
         }
       }
 
-      // Sync to device
-      f.sync_to_dev();
+      // Sync to device. Do not fence, so that the copy overlaps with
+      // reading the next variable (each var has its own host buffer)
+      f.sync_to_dev(false);
     }
   }
+  if (m_field_mgr) {
+    Kokkos::fence();
+  }
   auto func_finish = std::chrono::steady_clock::now();
   if (m_atm_logger) {
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start)/1000.0;
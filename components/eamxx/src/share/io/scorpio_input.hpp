@@ -92,6 +92,10 @@ public:
   // Read fields that were required via parameter list.
   void read_variables (const int time_index = -1);
 
+  // Read only a subset of the fields that were required via parameter list.
+  // Useful to spread the reading of a time snap across multiple calls.
+  void read_variables (const int time_index, const std::vector<std::string>& var_names);
+
   // Cleans up the class
   void finalize();
 
@@ -5,6 +5,7 @@
 #include "share/grid/remap/vertical_remapper.hpp"
 #include "share/util/scream_timing.hpp"
 #include "share/field/field_utils.hpp"
+#include "share/field/field_memory_pool.hpp"
 
 #include "ekat/util/ekat_units.hpp"
 #include "ekat/util/ekat_string_utils.hpp"
@@ -12,10 +13,25 @@
 
 #include <numeric>
 #include <fstream>
+#include <set>
+#include <sstream>
 
 namespace scream
 {
 
+namespace {
+
+// Registry of the diagnostics created by all output streams, so that streams
+// requesting the same diagnostic (same name, same params, same input fields)
+// share a single instance, which is then evaluated at most once per time step.
+// We only hold weak pointers, so that diags die with the last stream using them.
+std::map<std::string,std::weak_ptr<AtmosphereDiagnostic>>& diags_registry () {
+  static std::map<std::string,std::weak_ptr<AtmosphereDiagnostic>> r;
+  return r;
+}
+
+} // anonymous namespace
+
 // This helper function updates the current output val with a new one,
 // according to the "averaging" type, and according to the number of
 // model time steps since the last output step.
@@ -71,6 +87,26 @@ void combine_and_fill (const Real& new_val, Real& curr_val, const OutputAvgType
   }
 }
 
+// This helper function finds the entry of the fused update table that contains
+// the input index of the flattened index space of the table. Entries are sorted
+// by offset, and have non-zero size.
+template<typename TableView>
+KOKKOS_INLINE_FUNCTION
+int find_fused_entry (const TableView& table, const int idx)
+{
+  int lo = 0;
+  int hi = table.extent_int(0)-1;
+  while (lo<hi) {
+    const int mid = (lo+hi+1)/2;
+    if (table(mid).offset<=idx) {
+      lo = mid;
+    } else {
+      hi = mid-1;
+    }
+  }
+  return lo;
+}
+
 // This helper function is used to make sure that the list of fields in
 // m_fields_names is a list of unique strings, otherwise throw an error.
 void sort_and_check(std::vector<std::string>& fields)
@@ -185,8 +221,27 @@ AtmosphereOutput (const ekat::Comm& comm, const ekat::ParameterList& params,
   // Try to set the IO grid (checks will be performed)
   set_grid (io_grid);
 
-  // Register any diagnostics needed by this output stream
+  // Pressure levels for the *_at_plevs diagnostics (if any), needed to create the diagnostics
+  if (params.isParameter("pressure_levels")) {
+    m_pressure_levels = params.get<vos_t>("pressure_levels");
+  }
+
+  // Register any diagnostics needed by this output stream. If requested, the diagnostics
+  // get their storage from the global pool, sharing it with the diagnostics of other
+  // streams: they are only used during the run call of this stream.
+  m_pool_diags = params.get<bool>("pool_diagnostics_memory",false);
+  // If requested, back tendencies in averaged streams only save their field once per
+  // output window (see AtmBackTendDiag)
+  m_telescoping_backtend = m_avg_type==OutputAvgType::Average and
+                           params.get<bool>("telescoping_backtend",false);
+  auto& pool = FieldMemoryPool::instance();
+  if (m_pool_diags) {
+    pool.open_group();
+  }
   set_diagnostics();
+  if (m_pool_diags) {
+    pool.close_group();
+  }
 
   // Avg count only makes sense if we have
   //  - non-instant output
@@ -210,6 +265,36 @@ AtmosphereOutput (const ekat::Comm& comm, const ekat::ParameterList& params,
   if (params.isParameter("fill_threshold")) {
     m_avg_coeff_threshold = params.get<Real>("fill_threshold");
   }
+  m_async_write = params.get("async_write",false);
+
+  // Compression options, which can be overridden for each field
+  if (params.isSublist("compression")) {
+    const auto& c_pl = params.sublist("compression");
+    auto read_opts = [](const ekat::ParameterList& pl, CompressionOpts& opts) {
+      opts.deflate_level      = pl.get("deflate_level",opts.deflate_level);
+      opts.shuffle            = pl.get("shuffle",opts.shuffle);
+      opts.significant_digits = pl.get("significant_digits",opts.significant_digits);
+      EKAT_REQUIRE_MSG (opts.deflate_level>=0 and opts.deflate_level<=9,
+          "Error! Invalid value for 'deflate_level' (must be in [0,9]).\n");
+      EKAT_REQUIRE_MSG (opts.significant_digits>=0,
+          "Error! Invalid value for 'significant_digits' (must be non-negative).\n");
+    };
+    read_opts(c_pl,m_compression);
+    if (c_pl.isSublist("fields")) {
+      const auto& fields_pl = c_pl.sublist("fields");
+      for (auto it=fields_pl.sublists_names_cbegin(); it!=fields_pl.sublists_names_cend(); ++it) {
+        auto opts = m_compression;
+        read_opts(fields_pl.sublist(*it),opts);
+        m_fields_compression[*it] = opts;
+      }
+    }
+    if (c_pl.isSublist("chunk_sizes")) {
+      const auto& chunks_pl = c_pl.sublist("chunk_sizes");
+      for (auto it=chunks_pl.params_names_cbegin(); it!=chunks_pl.params_names_cend(); ++it) {
+        m_chunk_sizes[*it] = chunks_pl.get<int>(*it);
+      }
+    }
+  }
 
   // Helper lambda, to copy io string attributes. This will be used if any
   // remapper is created, to ensure atts set by atm_procs are not lost
@@ -229,7 +314,11 @@ AtmosphereOutput (const ekat::Comm& comm, const ekat::ParameterList& params,
     auto vert_remap_file   = params.get<std::string>("vertical_remap_file");
     auto f_lev = get_field("p_mid","sim");
     auto f_ilev = get_field("p_int","sim");
-    m_vert_remapper = std::make_shared<VerticalRemapper>(io_grid,vert_remap_file,f_lev,f_ilev,m_fill_value);
+    auto vert_remapper = std::make_shared<VerticalRemapper>(io_grid,vert_remap_file,f_lev,f_ilev,m_fill_value);
+    if (params.isParameter("fused_vertical_remap")) {
+      vert_remapper->set_fused_remap(params.get<bool>("fused_vertical_remap"));
+    }
+    m_vert_remapper = vert_remapper;
     io_grid = m_vert_remapper->get_tgt_grid();
     set_grid(io_grid);
 
@@ -283,7 +372,11 @@ AtmosphereOutput (const ekat::Comm& comm, const ekat::ParameterList& params,
     if (use_horiz_remap_from_file) {
       // Construct the coarsening remapper
       auto horiz_remap_file   = params.get<std::string>("horiz_remap_file");
-      m_horiz_remapper = std::make_shared<CoarseningRemapper>(io_grid,horiz_remap_file,true);
+      auto coarsening_remapper = std::make_shared<CoarseningRemapper>(io_grid,horiz_remap_file,true);
+      if (params.isParameter("fused_horiz_remap")) {
+        coarsening_remapper->set_fused_remap(params.get<bool>("fused_horiz_remap"));
+      }
+      m_horiz_remapper = coarsening_remapper;
       io_grid = m_horiz_remapper->get_tgt_grid();
       set_grid(io_grid);
     } else {
@@ -383,7 +476,10 @@ run (const std::string& filename,
   }
   Real duration_write = 0.0;  // Record of time spent writing output
   if (is_write_step) {
-    if (m_atm_logger) {
+    if (m_async_write) {
+      // Stage in the buffer that is not being written
+      m_staged_buffer = 1 - m_staged_buffer;
+    } else if (m_atm_logger) {
       m_atm_logger->info("[EAMxx::scorpio_output] Writing variables to file");
       m_atm_logger->info("  file name: " + filename);
     }
@@ -391,10 +487,32 @@ run (const std::string& filename,
 
   using namespace scream::scorpio;
 
+  // Bring data to host, and write it to file (or stage it, for async writes)
+  auto write_or_stage = [&](const std::string& name, const view_1d_dev& view_dev) {
+    if (m_async_write) {
+      auto& staged = m_staged_views_1d[m_staged_buffer];
+      if (staged.count(name)==0) {
+        staged.emplace(name,view_1d_pinned(name,view_dev.size()));
+      }
+      Kokkos::deep_copy (staged.at(name),view_dev);
+      return;
+    }
+    auto view_host = m_host_views_1d.at(name);
+    Kokkos::deep_copy (view_host,view_dev);
+    auto func_start = std::chrono::steady_clock::now();
+    scorpio::write_var(filename,name,view_host.data());
+    auto func_finish = std::chrono::steady_clock::now();
+    auto duration_loc = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start);
+    duration_write += duration_loc.count();
+  };
+
   // Update all diagnostics, we need to do this before applying the remapper
   // to make sure that the remapped fields are the most up to date.
   // First we reset the diag computed map so that all diags are recomputed.
   m_diag_computed.clear();
+  for (const auto& name : m_telescoping_diags) {
+    m_diagnostics.at(name)->set_write_step(is_write_step);
+  }
   for (auto& it : m_diagnostics) {
     compute_diagnostic(it.first,allow_invalid_fields);
   }
@@ -427,36 +545,59 @@ run (const std::string& filename,
     stop_timer("EAMxx::IO::horiz_remap");
   }
 
-  // Update all of the averaging count views (if needed)
-  // The strategy is as follows:
+  // Update the running tallies of all fields, as well as the averaging count views (if needed),
+  // in a single kernel. The kernel is driven by a device table, storing data pointer and
+  // strides of each field, so that we don't pay one kernel launch per field at every step.
+  // The table is refilled at every run, since the fields data may change (e.g., dynamic subfields).
+  // For the averaging count views the strategy is as follows:
   // For the update to the averaged value for this timestep we need to track if
-  // a point in a specific layout is "filled" or not.  So we create a set of local
-  // temporary views for each layout that are either 0 or 1 depending on if the
-  // value is filled or unfilled.
-  // We then use these values to update the overall average count views for that layout.
-  if (m_track_avg_cnt) {
-    // Note, we assume that all fields that share a layout are also masked/filled in the same
-    // way. If we need to handle a case where only a subset of output variables are expected to
-    // be masked/filled then the recommendation is to request those variables in a separate output
-    // stream.
-    // We cycle through all fields and we
-    //  1. Find the avg_cnt view for this field.
-    //  2. If we already processed the avg_cnt view, go to next field, and start from 1 again.
-    //  3. Add 1 to all entries of avg_cnt where field!=fill_value
-    std::set<std::string> avg_updated;
-    for (const auto& name : m_fields_names) {
-      auto avg_cnt_name = m_field_to_avg_cnt_map.at(name);
-      if (avg_updated.count(avg_cnt_name)==1) {
-        // We updated this avg_cnt by checking another field
-        continue;
+  // a point in a specific layout is "filled" or not.  So we add 1 to the avg count
+  // of each point in that layout where the value is not filled.
+  // Note, we assume that all fields that share a layout are also masked/filled in the same
+  // way. If we need to handle a case where only a subset of output variables are expected to
+  // be masked/filled then the recommendation is to request those variables in a separate output
+  // stream.
+  const int max_entries = m_fields_names.size() + m_avg_cnt_names.size();
+  if (m_fused_table.extent_int(0)<max_entries) {
+    m_fused_table   = fused_table_type("fused_table",max_entries);
+    m_fused_table_h = Kokkos::create_mirror_view(m_fused_table);
+  }
+  int num_entries = 0;
+  int fused_size  = 0;
+  auto add_entry = [&](const Field& src, Real* tgt, Real* avg_cnt, const bool is_avg_cnt) {
+    const auto& layout = m_layouts.at(src.name());
+    if (layout.size()==0) {
+      return;
+    }
+    auto& e = m_fused_table_h(num_entries++);
+    e.tgt = tgt;
+    e.avg_cnt = avg_cnt;
+    e.is_avg_cnt = is_avg_cnt;
+    e.offset = fused_size;
+    e.rank = layout.rank();
+    for (int d=0; d<e.rank; ++d) {
+      e.extents[d] = layout.dim(d);
+    }
+    auto set_src = [&](const auto& v) {
+      e.src = v.data();
+      for (int d=0; d<e.rank; ++d) {
+        e.strides[d] = v.stride(d);
       }
-      auto field = get_field(name,"io");
-      update_avg_cnt_view(field,m_dev_views_1d.at(avg_cnt_name));
-
-      // Make sure we don't double update this avg cnt
-      avg_updated.insert(avg_cnt_name);
+    };
+    switch (e.rank) {
+      // For rank-1 views, we use strided layout, since it helps us
+      // handling a few more scenarios
+      case 1: set_src(src.get_strided_view<const Real*,Device>());      break;
+      case 2: set_src(src.get_view<const Real**,Device>());             break;
+      case 3: set_src(src.get_view<const Real***,Device>());            break;
+      case 4: set_src(src.get_view<const Real****,Device>());           break;
+      case 5: set_src(src.get_view<const Real*****,Device>());          break;
+      case 6: set_src(src.get_view<const Real******,Device>());         break;
+      default:
+        EKAT_ERROR_MSG ("Error! Field rank (" + std::to_string(e.rank) + ") not supported by AtmosphereOutput.\n");
     }
-  }
+    fused_size += layout.size();
+  };
 
   // Take care of updating and possibly writing fields.
   // These are needed inside kernels, so crate local copies
@@ -464,12 +605,10 @@ run (const std::string& filename,
   auto avg_type = m_avg_type;
   auto fill_value = m_fill_value;
   auto avg_coeff_threshold = m_avg_coeff_threshold;
+  std::set<std::string> avg_updated;
   for (auto const& name : m_fields_names) {
     // Get all the info for this field.
-          auto  field = get_field(name,"io");
-    const auto& layout = m_layouts.at(field.name());
-    const auto& dims = layout.dims();
-    const auto  rank = layout.rank();
+    auto field = get_field(name,"io");
 
     if (not field.get_header().get_tracking().get_time_stamp().is_valid()) {
       // Safety check: make sure that the user is ok with this
@@ -481,6 +620,18 @@ run (const std::string& filename,
       }
     }
 
+    Real* avg_cnt = nullptr;
+    if (m_track_avg_cnt) {
+      // Add 1 to all entries of avg_cnt where field!=fill_value, unless we already
+      // updated this avg_cnt by checking another field
+      const auto& avg_cnt_name = m_field_to_avg_cnt_map.at(name);
+      avg_cnt = m_dev_views_1d.at(avg_cnt_name).data();
+      if (avg_updated.count(avg_cnt_name)==0) {
+        add_entry(field,avg_cnt,nullptr,true);
+        avg_updated.insert(avg_cnt_name);
+      }
+    }
+
     const bool is_diagnostic = (m_diagnostics.find(name) != m_diagnostics.end());
     const bool is_aliasing_field_view =
         m_avg_type==OutputAvgType::Instant &&
@@ -490,164 +641,82 @@ run (const std::string& filename,
 
     // Manually update the 'running-tally' views with data from the field,
     // by combining new data with current avg values.
-    // NOTE: this is skipped for instant output, if IO view is aliasing Field view.
-    auto view_dev = m_dev_views_1d.at(name);
-    auto data = view_dev.data();
-    KT::RangePolicy policy(0,layout.size());
-    const auto extents = layout.extents();
-
-    // If the dev_view_1d is aliasing the field device view (must be Instant output),
-    // then there's no point in copying from the field's view to dev_view
+    // NOTE: if the dev_view_1d is aliasing the field device view (must be Instant output),
+    //       then there's no point in copying from the field's view to dev_view
     if (not is_aliasing_field_view) {
-      switch (rank) {
-        case 1:
-        {
-          // For rank-1 views, we use strided layout, since it helps us
-          // handling a few more scenarios
-          auto new_view_1d = field.get_strided_view<const Real*,Device>();
-          auto avg_view_1d = view_Nd_dev<1>(data,dims[0]);
-          Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int i) {
-            if (do_avg_cnt) {
-              combine_and_fill(new_view_1d(i),avg_view_1d(i),avg_type,fill_value);
-            } else {
-              combine(new_view_1d(i),avg_view_1d(i),avg_type);
-            }
-          });
-          break;
-        }
-        case 2:
-        {
-          auto new_view_2d = field.get_view<const Real**,Device>();
-          auto avg_view_2d = view_Nd_dev<2>(data,dims[0],dims[1]);
-          Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
-            int i,j;
-            unflatten_idx(idx,extents,i,j);
-            if (do_avg_cnt) {
-              combine_and_fill(new_view_2d(i,j),avg_view_2d(i,j),avg_type,fill_value);
-            } else {
-              combine(new_view_2d(i,j), avg_view_2d(i,j),avg_type);
-            }
-          });
-          break;
-        }
-        case 3:
-        {
-          auto new_view_3d = field.get_view<const Real***,Device>();
-          auto avg_view_3d = view_Nd_dev<3>(data,dims[0],dims[1],dims[2]);
-          Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
-            int i,j,k;
-            unflatten_idx(idx,extents,i,j,k);
-            if (do_avg_cnt) {
-              combine_and_fill(new_view_3d(i,j,k),avg_view_3d(i,j,k),avg_type,fill_value);
-            } else {
-              combine(new_view_3d(i,j,k), avg_view_3d(i,j,k),avg_type);
-            }
-          });
-          break;
-        }
-        case 4:
-        {
-          auto new_view_4d = field.get_view<const Real****,Device>();
-          auto avg_view_4d = view_Nd_dev<4>(data,dims[0],dims[1],dims[2],dims[3]);
-          Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
-            int i,j,k,l;
-            unflatten_idx(idx,extents,i,j,k,l);
-            if (do_avg_cnt) {
-              combine_and_fill(new_view_4d(i,j,k,l), avg_view_4d(i,j,k,l),avg_type,fill_value);
-            } else {
-              combine(new_view_4d(i,j,k,l), avg_view_4d(i,j,k,l),avg_type);
-            }
-          });
-          break;
-        }
-        case 5:
-        {
-          auto new_view_5d = field.get_view<const Real*****,Device>();
-          auto avg_view_5d = view_Nd_dev<5>(data,dims[0],dims[1],dims[2],dims[3],dims[4]);
-          Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
-            int i,j,k,l,m;
-            unflatten_idx(idx,extents,i,j,k,l,m);
-            if (do_avg_cnt) {
-              combine_and_fill(new_view_5d(i,j,k,l,m), avg_view_5d(i,j,k,l,m),avg_type,fill_value);
-            } else {
-              combine(new_view_5d(i,j,k,l,m), avg_view_5d(i,j,k,l,m),avg_type);
-            }
-          });
-          break;
-        }
-        case 6:
-        {
-          auto new_view_6d = field.get_view<const Real******,Device>();
-          auto avg_view_6d = view_Nd_dev<6>(data,dims[0],dims[1],dims[2],dims[3],dims[4],dims[5]);
-          Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
-            int i,j,k,l,m,n;
-            unflatten_idx(idx,extents,i,j,k,l,m,n);
-            if (do_avg_cnt) {
-              combine_and_fill(new_view_6d(i,j,k,l,m,n), avg_view_6d(i,j,k,l,m,n), avg_type,fill_value);
-            } else {
-              combine(new_view_6d(i,j,k,l,m,n), avg_view_6d(i,j,k,l,m,n),avg_type);
-            }
-          });
-          break;
+      add_entry(field,m_dev_views_1d.at(name).data(),avg_cnt,false);
+    }
+  }
+
+  if (num_entries>0) {
+    start_timer("EAMxx::IO::fused_update");
+    const auto table_d = Kokkos::subview(m_fused_table,std::make_pair(0,num_entries));
+    const auto table_h = Kokkos::subview(m_fused_table_h,std::make_pair(0,num_entries));
+    Kokkos::deep_copy(table_d,table_h);
+    KT::RangePolicy policy(0,fused_size);
+    Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
+      const auto& e = table_d(find_fused_entry(table_d,idx));
+      const int i = idx - e.offset;
+      const Real new_val = e.src[e.src_offset(i)];
+      if (e.is_avg_cnt) {
+        if (new_val!=fill_value) {
+          e.tgt[i] += 1;
         }
-        default:
-          EKAT_ERROR_MSG ("Error! Field rank (" + std::to_string(rank) + ") not supported by AtmosphereOutput.\n");
+      } else if (do_avg_cnt) {
+        combine_and_fill(new_val,e.tgt[i],avg_type,fill_value);
+      } else {
+        combine(new_val,e.tgt[i],avg_type);
       }
-    }
+    });
 
-    if (is_write_step) {
-      if (output_step and avg_type==OutputAvgType::Average) {
+    if (output_step and avg_type==OutputAvgType::Average) {
+      // Divide by steps count only when the summation is complete
+      Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
+        const auto& e = table_d(find_fused_entry(table_d,idx));
+        if (e.is_avg_cnt) {
+          return;
+        }
+        const int i = idx - e.offset;
+        auto& val = e.tgt[i];
         if (do_avg_cnt) {
-          const auto avg_cnt_lookup = m_field_to_avg_cnt_map.at(name);
-          const auto avg_cnt_view = m_dev_views_1d.at(avg_cnt_lookup);
-          const auto avg_nsteps = avg_cnt_view.data();
-          // Divide by steps count only when the summation is complete
-          Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int i) {
-            Real coeff_percentage = Real(avg_nsteps[i])/nsteps_since_last_output;
-            if (data[i] != fill_value && coeff_percentage > avg_coeff_threshold) {
-              data[i] /= avg_nsteps[i];
-            } else {
-              data[i] = fill_value;
-            }
-          });
+          Real coeff_percentage = Real(e.avg_cnt[i])/nsteps_since_last_output;
+          if (val != fill_value && coeff_percentage > avg_coeff_threshold) {
+            val /= e.avg_cnt[i];
+          } else {
+            val = fill_value;
+          }
         } else {
-          // Divide by steps count only when the summation is complete
-          Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int i) {
-            data[i] /= nsteps_since_last_output;
-          });
+          val /= nsteps_since_last_output;
         }
-      }
-      // Bring data to host
-      auto view_host = m_host_views_1d.at(name);
-      Kokkos::deep_copy (view_host,view_dev);
-      auto func_start = std::chrono::steady_clock::now();
-      scorpio::write_var(filename,name,view_host.data());
-      auto func_finish = std::chrono::steady_clock::now();
-      auto duration_loc = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start);
-      duration_write += duration_loc.count();
+      });
     }
+    stop_timer("EAMxx::IO::fused_update");
   }
-  // Handle writing the average count variables to file
+
   if (is_write_step) {
+    for (auto const& name : m_fields_names) {
+      write_or_stage(name,m_dev_views_1d.at(name));
+    }
+    // Handle writing the average count variables to file
     for (const auto& name : m_avg_cnt_names) {
-      auto& view_dev = m_dev_views_1d.at(name);
-      // Bring data to host
-      auto view_host = m_host_views_1d.at(name);
-      Kokkos::deep_copy (view_host,view_dev);
-      auto func_start = std::chrono::steady_clock::now();
-      scorpio::write_var(filename,name,view_host.data());
-      auto func_finish = std::chrono::steady_clock::now();
-      auto duration_loc = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start);
-      duration_write += duration_loc.count();
+      write_or_stage(name,m_dev_views_1d.at(name));
     }
   }
-  if (is_write_step) {
+  if (is_write_step and not m_async_write) {
     if (m_atm_logger) {
       m_atm_logger->info("  Done! Elapsed time: " + std::to_string(duration_write/1000.0) +" seconds");
     }
   }
 } // run
 
+void AtmosphereOutput::
+write_staged_vars (const std::string& filename, const int buffer) const
+{
+  for (const auto& it : m_staged_views_1d[buffer]) {
+    scorpio::write_var(filename,it.first,it.second.data());
+  }
+}
+
 long long AtmosphereOutput::
 res_dep_memory_footprint () const {
   long long rdmf = 0;
@@ -915,7 +984,8 @@ reset_dev_views()
 void AtmosphereOutput::
 register_variables(const std::string& filename,
                    const std::string& fp_precision,
-                   const scorpio::FileMode mode)
+                   const scorpio::FileMode mode,
+                   const bool allow_quantization)
 {
   using namespace ShortFieldTagsNames;
   using strvec_t = std::vector<std::string>;
@@ -955,6 +1025,9 @@ register_variables(const std::string& filename,
     auto vec_of_dims   = set_vec_of_dims(layout);
     std::string units = fid.get_units().to_string();
 
+    auto c_it = m_fields_compression.find(name);
+    const auto& compression = c_it==m_fields_compression.end() ? m_compression : c_it->second;
+
     // TODO  Need to change dtype to allow for other variables.
     // Currently the field_manager only stores Real variables so it is not an issue,
     // but in the future if non-Real variables are added we will want to accomodate that.
@@ -988,6 +1061,18 @@ register_variables(const std::string& filename,
       scorpio::define_var (filename, name, units, vec_of_dims,
                             "real",fp_precision, m_add_time_dim);
 
+      // Set chunking/compression (if any). Dims without a chunk size are not split.
+      if (compression.deflate_level>0 or m_chunk_sizes.size()>0) {
+        std::vector<int> chunk_sizes;
+        if (m_chunk_sizes.size()>0) {
+          for (const auto& d : vec_of_dims) {
+            auto it = m_chunk_sizes.find(d);
+            chunk_sizes.push_back(it==m_chunk_sizes.end() ? m_dims.at(d) : it->second);
+          }
+        }
+        scorpio::define_var_compression(filename,name,compression.deflate_level,compression.shuffle,chunk_sizes);
+      }
+
       // Add FillValue as an attribute of each variable
       // FillValue is a protected metadata, do not add it if it already existed
       if (fp_precision=="double" or
@@ -1034,6 +1119,15 @@ register_variables(const std::string& filename,
         auto longname = m_longnames.get_longname(name);
         scorpio::set_attribute(filename, name, "long_name", longname);
       }
+
+      if (allow_quantization and compression.significant_digits>0) {
+        scorpio::set_attribute(filename,name,"quantization_significant_digits",compression.significant_digits);
+      }
+    }
+
+    // Quantization is not stored in the file, so set it for appended files too
+    if (allow_quantization and compression.significant_digits>0) {
+      scorpio::set_var_quantization(filename,name,compression.significant_digits,m_fill_value);
     }
   }
   // Now register the average count variables
@@ -1199,7 +1293,8 @@ void AtmosphereOutput::set_decompositions(const std::string& filename)
 void AtmosphereOutput::
 setup_output_file(const std::string& filename,
                   const std::string& fp_precision,
-                  const scorpio::FileMode mode)
+                  const scorpio::FileMode mode,
+                  const bool allow_quantization)
 {
   // Register dimensions with netCDF file.
   for (auto it : m_dims) {
@@ -1221,7 +1316,7 @@ setup_output_file(const std::string& filename,
   }
 
   // Register variables with netCDF file.  Must come after dimensions are registered.
-  register_variables(filename,fp_precision,mode);
+  register_variables(filename,fp_precision,mode,allow_quantization);
 
   // Set the offsets of the local dofs in the global vector.
   set_decompositions(filename);
@@ -1246,6 +1341,26 @@ compute_diagnostic(const std::string& name, const bool allow_invalid_fields)
   }
 
   m_diag_computed[name] = true;
+
+  // If none of the inputs was updated since the diag was last evaluated (possibly
+  // by another stream sharing this diag), the diag is already up to date.
+  // Pooled diags cannot do this, since their storage is reused by other streams,
+  // and neither can telescoping diags, since their value depends on the step.
+  const auto& diag_ts = diag->get_diagnostic().get_header().get_tracking().get_time_stamp();
+  if (not m_pool_diags and m_telescoping_diags.count(name)==0 and diag_ts.is_valid()) {
+    bool up_to_date = true;
+    for (const auto& f : diag->get_fields_in()) {
+      const auto& fts = f.get_header().get_tracking().get_time_stamp();
+      if (not fts.is_valid() or diag_ts<fts) {
+        up_to_date = false;
+        break;
+      }
+    }
+    if (up_to_date) {
+      return;
+    }
+  }
+
   if (allow_invalid_fields) {
     // If any input is invalid, fill the diagnostic with invalid data
     for (auto f : diag->get_fields_in()) {
@@ -1325,6 +1440,7 @@ AtmosphereOutput::create_diagnostic (const std::string& diag_field_name) {
     //  - ${field_name}_at_model_bot
     //  - ${field_name}_at_model_top
     //  - ${field_name}_at_${M}X
+    //  - ${field_name}_at_plevs        <- all levels in the 'pressure_levels' stream option
     // where M/N are numbers (N integer), X=Pa, hPa, mb, or m
     auto tokens = ekat::split(diag_field_name,"_at_");
     EKAT_REQUIRE_MSG (tokens.size()==2,
@@ -1341,7 +1457,18 @@ AtmosphereOutput::create_diagnostic (const std::string& diag_field_name) {
     // FieldAtLevel        : var_at_lev_N, var_at_model_top, var_at_model_bot
     // FieldAtPressureLevel: var_at_Nx, with x=mb,Pa,hPa
     // FieldAtHeight       : var_at_Nm_above_Y (Y=sealevel or surface)
-    if (tokens[1].find_first_of("0123456789.")==0) {
+    // FieldAtPressureLevels: var_at_plevs
+    if (tokens[1]=="plevs") {
+      EKAT_REQUIRE_MSG (m_pressure_levels.size()>0,
+          "Error! Output field request for " + diag_field_name + " requires the 'pressure_levels' option.\n");
+      diag_name = "FieldAtPressureLevels";
+      params.set("field_names",std::vector<std::string>{fname});
+      params.set("pressure_levels",m_pressure_levels);
+      diag_avg_cnt_name = "_plevs"; // Set avg_cnt tracking for the pressure levels
+      // The slices may be masked, so we need to be tracking the average count,
+      // if m_avg_type is not Instant
+      m_track_avg_cnt = m_track_avg_cnt || m_avg_type!=OutputAvgType::Instant;
+    } else if (tokens[1].find_first_of("0123456789.")==0) {
       auto units_start = tokens[1].find_first_not_of("0123456789.");
       auto units = tokens[1].substr(units_start);
       if (units.find("_above_") != std::string::npos) {
@@ -1415,6 +1542,10 @@ AtmosphereOutput::create_diagnostic (const std::string& diag_field_name) {
     params.set("grid_name",get_field_manager("sim")->get_grid()->name());
     // split will return [X, ''], with X being whatever is before '_atm_tend'
     params.set<std::string>("Tendency Name",ekat::split(diag_field_name,"_atm_backtend").front());
+    if (m_telescoping_backtend) {
+      params.set("Telescoping",true);
+      m_telescoping_diags.insert(diag_field_name);
+    }
   } else if (diag_field_name=="PotentialTemperature" or
              diag_field_name=="LiqPotentialTemperature") {
     diag_name = "PotentialTemperature";
@@ -1436,15 +1567,36 @@ AtmosphereOutput::create_diagnostic (const std::string& diag_field_name) {
     params.set<std::string>("diag_name", diag_name);
   }
 
+  // If another stream already created an identical diagnostic on the same
+  // fields, reuse it. Diags that store state across evaluations (the back
+  // tendencies) are not shared, since their value depends on the output frequency.
+  // Neither are pooled diags, since their storage is not persistent.
+  const auto sim_field_mgr = get_field_manager("sim");
+  std::string registry_key;
+  std::shared_ptr<AtmosphereDiagnostic> diag;
+  if (not m_pool_diags and diag_name!="AtmBackTendDiag") {
+    std::stringstream ss;
+    ss << sim_field_mgr.get() << "|" << diag_field_name << "|" << diag_name << "|";
+    params.print(ss);
+    registry_key = ss.str();
+    auto it = diags_registry().find(registry_key);
+    if (it!=diags_registry().end()) {
+      diag = it->second.lock();
+    }
+  }
+  const bool shared = diag!=nullptr;
+
   // Create the diagnostic
-  auto diag = diag_factory.create(diag_name,m_comm,params);
-  diag->set_grids(m_grids_manager);
+  if (not shared) {
+    diag = diag_factory.create(diag_name,m_comm,params);
+    diag->set_grids(m_grids_manager);
+  }
 
   // Ensure there's an entry in the map for this diag, so .at(diag_name) always works
   auto& deps = m_diag_depends_on_diags[diag->name()];
 
-  // Initialize the diagnostic
-  const auto sim_field_mgr = get_field_manager("sim");
+  // Initialize the diagnostic (if shared, it was already initialized, but we still
+  // need to create the diags it depends on, so that this stream can evaluate them)
   for (const auto& freq : diag->get_required_field_requests()) {
     const auto& fname = freq.fid.name();
     if (!sim_field_mgr->has_field(fname)) {
@@ -1455,9 +1607,16 @@ AtmosphereOutput::create_diagnostic (const std::string& diag_field_name) {
       auto dep = m_diagnostics.at(fname);
       deps.push_back(fname);
     }
-    diag->set_required_field (get_field(fname,"sim"));
+    if (not shared) {
+      diag->set_required_field (get_field(fname,"sim"));
+    }
+  }
+  if (not shared) {
+    diag->initialize(util::TimeStamp(),RunType::Initial);
+    if (registry_key!="") {
+      diags_registry()[registry_key] = diag;
+    }
   }
-  diag->initialize(util::TimeStamp(),RunType::Initial);
   // If specified, set avg_cnt tracking for this diagnostic.
   if (m_track_avg_cnt) {
     const auto diag_field = diag->get_diagnostic();
@@ -1468,102 +1627,4 @@ AtmosphereOutput::create_diagnostic (const std::string& diag_field_name) {
   return diag;
 }
 
-// Helper function to mark filled points in a specific layout
-void AtmosphereOutput::
-update_avg_cnt_view(const Field& field, view_1d_dev& dev_view) {
-  const auto& name   = field.name();
-  const auto& layout = m_layouts.at(name);
-  const auto& dims   = layout.dims();
-        auto  data   = dev_view.data();
-  const auto fill_value = m_fill_value;
-
-  KT::RangePolicy policy(0,layout.size());
-  const auto extents = layout.extents();
-  switch (layout.rank()) {
-    case 1:
-    {
-      // For rank-1 views, we use strided layout, since it helps us
-      // handling a few more scenarios
-      auto src_view_1d = field.get_strided_view<const Real*,Device>();
-      auto tgt_view_1d = view_Nd_dev<1>(data,dims[0]);
-      Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int i) {
-        if (src_view_1d(i)!=fill_value) {
-          tgt_view_1d(i) += 1;
-        }
-      });
-      break;
-    }
-    case 2:
-    {
-      auto src_view_2d = field.get_view<const Real**,Device>();
-      auto tgt_view_2d = view_Nd_dev<2>(data,dims[0],dims[1]);
-      Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
-        int i,j;
-        unflatten_idx(idx,extents,i,j);
-        if (src_view_2d(i,j)!=fill_value) {
-          tgt_view_2d(i,j) += 1;
-        }
-      });
-      break;
-    }
-    case 3:
-    {
-      auto src_view_3d = field.get_view<const Real***,Device>();
-      auto tgt_view_3d = view_Nd_dev<3>(data,dims[0],dims[1],dims[2]);
-      Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
-        int i,j,k;
-        unflatten_idx(idx,extents,i,j,k);
-        if (src_view_3d(i,j,k)!=fill_value) {
-          tgt_view_3d(i,j,k) += 1;
-        }
-      });
-      break;
-    }
-    case 4:
-    {
-      auto src_view_4d = field.get_view<const Real****,Device>();
-      auto tgt_view_4d = view_Nd_dev<4>(data,dims[0],dims[1],dims[2],dims[3]);
-      Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
-        int i,j,k,l;
-        unflatten_idx(idx,extents,i,j,k,l);
-        if (src_view_4d(i,j,k,l)!=fill_value) {
-          tgt_view_4d(i,j,k,l) += 1;
-        }
-      });
-      break;
-    }
-    case 5:
-    {
-      auto src_view_5d = field.get_view<const Real*****,Device>();
-      auto tgt_view_5d = view_Nd_dev<5>(data,dims[0],dims[1],dims[2],dims[3],dims[4]);
-      Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
-        int i,j,k,l,m;
-        unflatten_idx(idx,extents,i,j,k,l,m);
-        if (src_view_5d(i,j,k,l,m)!=fill_value) {
-          tgt_view_5d(i,j,k,l,m) += 1;
-        }
-      });
-      break;
-    }
-    case 6:
-    {
-      auto src_view_6d = field.get_view<const Real******,Device>();
-      auto tgt_view_6d = view_Nd_dev<6>(data,dims[0],dims[1],dims[2],dims[3],dims[4],dims[5]);
-      Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int idx) {
-        int i,j,k,l,m,n;
-        unflatten_idx(idx,extents,i,j,k,l,m,n);
-        if (src_view_6d(i,j,k,l,m,n)!=fill_value) {
-          tgt_view_6d(i,j,k,l,m,n) += 1;
-        }
-      });
-      break;
-    }
-    default:
-      EKAT_ERROR_MSG (
-            "Error! Field rank not not supported by AtmosphereOutput.\n"
-          "  - field name:   " + field.name() + "\n"
-          "  - field layout: " + layout.to_string() + "\n");
-  }
-}
-
 } // namespace scream
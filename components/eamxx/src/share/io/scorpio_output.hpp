@@ -11,6 +11,10 @@
 
 #include "ekat/ekat_parameter_list.hpp"
 #include "ekat/mpi/ekat_comm.hpp"
+
+#include <array>
+#include <set>
+
 /*  The AtmosphereOutput class handles an output stream in SCREAM.
  *  Typical usage is to register an AtmosphereOutput object with the OutputManager (see scream_output_manager.hpp
  *
@@ -121,6 +125,43 @@ public:
   using view_1d_dev  = view_Nd_dev<1>;
   using view_1d_host = view_Nd_host<1>;
 
+  // Buffers for async writes live in pinned host memory (if any), to speed up
+  // the copy of the snapshot from device
+#if defined(KOKKOS_ENABLE_CUDA)
+  using pinned_space = Kokkos::CudaHostPinnedSpace;
+#elif defined(KOKKOS_ENABLE_HIP)
+  using pinned_space = Kokkos::HIPHostPinnedSpace;
+#else
+  using pinned_space = Kokkos::HostSpace;
+#endif
+  using view_1d_pinned = Kokkos::View<Real*,pinned_space>;
+
+  // Entry of the device table driving the fused update of the running tallies (and
+  // avg counts) of all the fields of the stream in run. The entry of a field covers
+  // the indices [offset,offset+size) of the flattened index space of the table.
+  struct FusedUpdateEntry {
+    const Real* src;        // Field data (possibly padded/strided)
+    Real*       tgt;        // Running tally, or avg count if is_avg_cnt=true (contiguous)
+    Real*       avg_cnt;    // Avg count of the field layout (if tracking avg counts)
+    bool        is_avg_cnt;
+    int         offset;
+    int         rank;
+    int         extents[Field::MaxRank];
+    int         strides[Field::MaxRank];
+
+    // Offset in src of the i-th entry of the field (in LayoutRight order)
+    KOKKOS_INLINE_FUNCTION
+    int src_offset (int i) const {
+      int off = 0;
+      for (int d=rank-1; d>=0; --d) {
+        off += (i % extents[d])*strides[d];
+        i /= extents[d];
+      }
+      return off;
+    }
+  };
+  using fused_table_type = typename KT::template view_1d<FusedUpdateEntry>;
+
   virtual ~AtmosphereOutput () = default;
 
   // Constructor
@@ -137,8 +178,9 @@ public:
   void restart (const std::string& filename);
   void init();
   void reset_dev_views();
-  void update_avg_cnt_view(const Field&, view_1d_dev& dev_view);
-  void setup_output_file (const std::string& filename, const std::string& fp_precision, const scorpio::FileMode mode);
+  // If allow_quantization=false, the 'significant_digits' compression option is ignored (e.g., for restart files)
+  void setup_output_file (const std::string& filename, const std::string& fp_precision, const scorpio::FileMode mode,
+                          const bool allow_quantization = true);
 
   void init_timestep (const util::TimeStamp& start_of_step);
   void run (const std::string& filename,
@@ -146,6 +188,14 @@ public:
             const int nsteps_since_last_output,
             const bool allow_invalid_fields = false);
 
+  // If async writes are enabled (see 'async_write' parameter), on write steps run
+  // does not write the variables, but stages them in one of two host buffers,
+  // alternating buffers at each write step. The content of a buffer can then be
+  // written with write_staged_vars, while the next snapshot is staged in the other.
+  bool is_async_write () const { return m_async_write; }
+  int  get_staged_buffer () const { return m_staged_buffer; }
+  void write_staged_vars (const std::string& filename, const int buffer) const;
+
   long long res_dep_memory_footprint () const;
 
   std::shared_ptr<const AbstractGrid> get_io_grid () const {
@@ -166,7 +216,8 @@ protected:
   std::shared_ptr<const fm_type> get_field_manager (const std::string& mode) const;
 
   void register_dimensions(const std::string& name);
-  void register_variables(const std::string& filename, const std::string& fp_precision, const scorpio::FileMode mode);
+  void register_variables(const std::string& filename, const std::string& fp_precision, const scorpio::FileMode mode,
+                          const bool allow_quantization);
   void set_decompositions(const std::string& filename);
   std::vector<scorpio::offset_t> get_var_dof_offsets (const FieldLayout& layout);
   void register_views();
@@ -206,6 +257,9 @@ protected:
   std::map<std::string,std::shared_ptr<atm_diag_type>>  m_diagnostics;
   std::map<std::string,std::vector<std::string>>        m_diag_depends_on_diags;
   std::map<std::string,bool>                            m_diag_computed;
+  bool                                                  m_pool_diags = false;
+  bool                                                  m_telescoping_backtend = false;
+  std::set<std::string>                                 m_telescoping_diags;
   LongNames                                             m_longnames;
 
   // Use float, so that if output fp_precision=float, this is a representable value.
@@ -215,10 +269,33 @@ protected:
   // is used inside other calculation and/or remap.
   float m_fill_value = constants::DefaultFillValue<float>().value;
 
+  // Target pressure levels for ${field}_at_plevs diagnostics (e.g., "500mb")
+  std::vector<std::string>                m_pressure_levels;
+
+  // Compression options of the output vars (see 'compression' sublist in the output yaml file).
+  // The stream options can be overridden for each field, while chunk sizes are set per dimension.
+  struct CompressionOpts {
+    int  deflate_level      = 0;
+    bool shuffle            = true;
+    int  significant_digits = 0;
+  };
+  CompressionOpts                         m_compression;
+  std::map<std::string,CompressionOpts>   m_fields_compression;
+  std::map<std::string,int>               m_chunk_sizes;
+
   // Local views of each field to be used for "averaging" output and writing to file.
   std::map<std::string,view_1d_host>    m_host_views_1d;
   std::map<std::string,view_1d_dev>     m_dev_views_1d;
 
+  // Device table for the fused update of the running tallies, and its host mirror
+  fused_table_type                        m_fused_table;
+  typename fused_table_type::HostMirror   m_fused_table_h;
+
+  // Double buffered host copies of the variables staged for async writes
+  bool m_async_write   = false;
+  int  m_staged_buffer = 1;
+  std::array<std::map<std::string,view_1d_pinned>,2>  m_staged_views_1d;
+
   bool m_add_time_dim;
   bool m_track_avg_cnt = false;
 
@@ -3,9 +3,12 @@
 
 #include "share/io/scream_scorpio_interface.hpp"
 #include "share/grid/point_grid.hpp"
+#include "share/util/scream_utils.hpp"
 
 #include <ekat/util/ekat_string_utils.hpp>
+#include <ekat/kokkos/ekat_kokkos_utils.hpp>
 
+#include <algorithm>
 #include <memory>
 
 namespace scream
@@ -18,6 +21,45 @@ SCMInput (const std::string& filename,
           const ekat::Comm& comm)
  : m_comm(comm)
  , m_filename (filename)
+{
+  // All columns read the same target
+  const int ncols = fields.size()>0 ? fields[0].get_header().get_identifier().get_layout().dim(0) : 0;
+  m_col_target.resize(ncols,0);
+
+  init ({lat},{lon},fields);
+}
+
+SCMInput::
+SCMInput (const std::string& filename,
+          const std::vector<double>& lats,
+          const std::vector<double>& lons,
+          const std::vector<Field>& fields,
+          const std::shared_ptr<const AbstractGrid>& grid)
+ : m_comm(grid->get_comm())
+ , m_filename (filename)
+{
+  const int ntargets = grid->get_partitioned_dim_global_size();
+  EKAT_REQUIRE_MSG (static_cast<int>(lats.size())==ntargets and static_cast<int>(lons.size())==ntargets,
+      "Error! SCMInput requires one target lat/lon pair per grid column.\n"
+      "  - grid name: " + grid->name() + "\n"
+      "  - num grid columns: " + std::to_string(ntargets) + "\n"
+      "  - num target lats : " + std::to_string(lats.size()) + "\n"
+      "  - num target lons : " + std::to_string(lons.size()) + "\n");
+
+  // Each column reads the target of its global index
+  const auto gids = grid->get_partitioned_dim_gids().get_view<const AbstractGrid::gid_type*,Host>();
+  const auto min_gid = grid->get_global_min_partitioned_dim_gid();
+  for (size_t icol=0; icol<gids.size(); ++icol) {
+    m_col_target.push_back(gids[icol]-min_gid);
+  }
+
+  init (lats,lons,fields);
+}
+
+void SCMInput::
+init (const std::vector<double>& target_lats,
+      const std::vector<double>& target_lons,
+      const std::vector<Field>& fields)
 {
   auto iotype = scorpio::str2iotype("default");
   scorpio::register_file(m_filename,scorpio::Read,iotype);
@@ -32,7 +74,7 @@ SCMInput (const std::string& filename,
   create_io_grid ();
   auto ncols = m_io_grid->get_num_local_dofs();
 
-  create_closest_col_info (lat, lon);
+  create_closest_col_info (target_lats, target_lons);
 
   // Init fields specs
   for (const auto& f : fields) {
@@ -44,8 +86,13 @@ SCMInput (const std::string& filename,
       "Error! SCMInput only works for physics-type layouts.\n"
       "  - field name: " + f.name() + "\n"
       "  - field layout: " + fl.to_string() + "\n");
+    EKAT_REQUIRE_MSG (fl.dim(0)==static_cast<int>(m_col_target.size()),
+      "Error! All fields read by SCMInput must have the same number of columns.\n"
+      "  - field name: " + f.name() + "\n"
+      "  - field layout: " + fl.to_string() + "\n"
+      "  - expected num columns: " + std::to_string(m_col_target.size()) + "\n");
 
-    m_fields.push_back(f.subfield(0,0));
+    m_fields.push_back(f);
     FieldIdentifier fid_io(f.name(),fl.clone().reset_dim(0,ncols),fid.get_units(),m_io_grid->name());
     auto& f_io = m_io_fields.emplace_back(fid_io);
     f_io.allocate_view();
@@ -72,10 +119,15 @@ void SCMInput::create_io_grid ()
   m_io_grid = create_point_grid("scm_io_grid",ncols,nlevs,m_comm);
 }
 
-void SCMInput::create_closest_col_info (double target_lat, double target_lon)
+void SCMInput::create_closest_col_info (const std::vector<double>& target_lats,
+                                        const std::vector<double>& target_lons)
 {
+  using KT = KokkosTypes<DefaultDevice>;
+  using ESU = ekat::ExeSpaceUtils<KT::ExeSpace>;
+
   // Read lat/lon fields
   const auto ncols = m_io_grid->get_num_local_dofs();
+  const int ntargets = target_lats.size();
 
   auto nondim = ekat::units::Units::nondimensional();
   auto lat = m_io_grid->create_geometry_data("lat",m_io_grid->get_2d_scalar_layout(),nondim);
@@ -86,28 +138,69 @@ void SCMInput::create_closest_col_info (double target_lat, double target_lon)
   file_reader.read_variables();
   file_reader.finalize();
 
-  // Find column index of closest lat/lon to target_lat/lon params
+  KT::view_1d<Real> tgt_lat ("tgt_lat",ntargets);
+  KT::view_1d<Real> tgt_lon ("tgt_lon",ntargets);
+  auto tgt_lat_h = Kokkos::create_mirror_view(tgt_lat);
+  auto tgt_lon_h = Kokkos::create_mirror_view(tgt_lon);
+  for (int t=0; t<ntargets; ++t) {
+    tgt_lat_h(t) = target_lats[t];
+    tgt_lon_h(t) = target_lons[t];
+  }
+  Kokkos::deep_copy(tgt_lat,tgt_lat_h);
+  Kokkos::deep_copy(tgt_lon,tgt_lon_h);
+
+  // Find local column index of closest lat/lon to each target, with one team per target
   auto lat_d = lat.get_view<Real*>();
   auto lon_d = lon.get_view<Real*>();
   using minloc_t = Kokkos::MinLoc<Real,int>;
   using minloc_value_t = typename minloc_t::value_type;
-  minloc_value_t minloc;
-  Kokkos::parallel_reduce(ncols, KOKKOS_LAMBDA (int icol, minloc_value_t& result) {
-    auto dist = std::abs(lat_d(icol)-target_lat)+std::abs(lon_d(icol)-target_lon);
-    if(dist<result.val) {
-      result.val = dist;
-      result.loc = icol;
-    }
-  }, minloc_t(minloc));
-
-  // Find processor with closest lat/lon match
+  Kokkos::View<minloc_value_t*> minlocs ("minlocs",ntargets);
+  const auto policy = ESU::get_default_team_policy(ntargets,ncols);
+  Kokkos::parallel_for(policy, KOKKOS_LAMBDA (const KT::MemberType& team) {
+    const int t = team.league_rank();
+    minloc_value_t minloc;
+    Kokkos::parallel_reduce(Kokkos::TeamThreadRange(team,ncols),
+                            [&] (int icol, minloc_value_t& result) {
+      auto dist = std::abs(lat_d(icol)-tgt_lat(t))+std::abs(lon_d(icol)-tgt_lon(t));
+      if(dist<result.val) {
+        result.val = dist;
+        result.loc = icol;
+      }
+    }, minloc_t(minloc));
+    Kokkos::single(Kokkos::PerTeam(team),[&]() {
+      minlocs(t) = minloc;
+    });
+  });
+  auto minlocs_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),minlocs);
+
+  // Find processor with closest lat/lon match for all targets at once
   const auto my_rank = m_comm.rank();
-  std::pair<Real, int> min_dist_and_rank = {minloc.val, my_rank};
-  m_comm.all_reduce<std::pair<Real, int>>(&min_dist_and_rank, 1, MPI_MINLOC);
+  std::vector<std::pair<Real, int>> min_dist_and_rank (ntargets);
+  for (int t=0; t<ntargets; ++t) {
+    min_dist_and_rank[t] = {minlocs_h(t).val, my_rank};
+  }
+  m_comm.all_reduce<std::pair<Real, int>>(min_dist_and_rank.data(), ntargets, MPI_MINLOC);
 
   // Set local col idx to -1 for mpi ranks not containing minimum lat/lon distance
-  m_closest_col_info.mpi_rank = min_dist_and_rank.second;
-  m_closest_col_info.col_lid  = my_rank==min_dist_and_rank.second ? minloc.loc : -1;
+  m_closest_col_info.resize(ntargets);
+  for (int t=0; t<ntargets; ++t) {
+    m_closest_col_info[t].mpi_rank = min_dist_and_rank[t].second;
+    m_closest_col_info[t].col_lid  = my_rank==min_dist_and_rank[t].second ? minlocs_h(t).loc : -1;
+  }
+
+  // Position of each target in the gathered columns
+  m_rank_ncols.assign(m_comm.size(),0);
+  m_rank_offset.assign(m_comm.size(),0);
+  m_target_pos.resize(ntargets);
+  for (int t=0; t<ntargets; ++t) {
+    m_target_pos[t] = m_rank_ncols[m_closest_col_info[t].mpi_rank]++;
+  }
+  for (int r=1; r<m_comm.size(); ++r) {
+    m_rank_offset[r] = m_rank_offset[r-1] + m_rank_ncols[r-1];
+  }
+  for (int t=0; t<ntargets; ++t) {
+    m_target_pos[t] += m_rank_offset[m_closest_col_info[t].mpi_rank];
+  }
 }
 
 void SCMInput::read_variables (const int time_index)
@@ -123,8 +216,11 @@ void SCMInput::read_variables (const int time_index)
     }
   }
 
-  // MPI rank with closest column index store column data
+  // MPI ranks with closest column index store column data. The io fields are not
+  // padded, so each column is a contiguous chunk of col_size entries.
   const int n = m_fields.size();
+  const int ntargets = m_closest_col_info.size();
+  const int my_rank = m_comm.rank();
   for (int i=0; i<n; ++i) {
     auto& f_io = m_io_fields[i];
     const auto& name = f_io.name();
@@ -132,15 +228,38 @@ void SCMInput::read_variables (const int time_index)
     // Read the data
     scorpio::read_var(m_filename,name,f_io.get_internal_view_data<Real,Host>(),time_index);
 
-    auto& f = m_fields[i];
-    if (m_comm.rank() == m_closest_col_info.mpi_rank) {
-      // This rank read the column we need, so copy it in the output field
-      f.deep_copy<Host>(f_io.subfield(0,m_closest_col_info.col_lid));
+    // Pack the columns read by this rank, ordered by target
+    const auto& fl_io = f_io.get_header().get_identifier().get_layout();
+    const int col_size = fl_io.size() / fl_io.dim(0);
+    const Real* data_io = f_io.get_internal_view_data<Real,Host>();
+    std::vector<Real> send (m_rank_ncols[my_rank]*col_size);
+    for (int t=0, pos=0; t<ntargets; ++t) {
+      if (m_closest_col_info[t].mpi_rank==my_rank) {
+        std::copy_n(data_io+m_closest_col_info[t].col_lid*col_size,col_size,send.data()+pos*col_size);
+        ++pos;
+      }
     }
 
-    // Broadcast column data to all other ranks
-    const auto col_size = f.get_header().get_identifier().get_layout().size();
-    m_comm.broadcast(f.get_internal_view_data<Real,Host>(), col_size, m_closest_col_info.mpi_rank);
+    // Gather the columns of all targets on all ranks
+    std::vector<int> counts (m_comm.size()), displs (m_comm.size());
+    for (int r=0; r<m_comm.size(); ++r) {
+      counts[r] = m_rank_ncols[r]*col_size;
+      displs[r] = m_rank_offset[r]*col_size;
+    }
+    FieldIdentifier fid_all(name,fl_io.clone().reset_dim(0,ntargets),f_io.get_header().get_identifier().get_units(),m_io_grid->name());
+    Field f_all(fid_all);
+    f_all.allocate_view();
+    const auto mpi_real = ekat::get_mpi_type<Real>();
+    check_mpi_call (MPI_Allgatherv(send.data(),counts[my_rank],mpi_real,
+                                   f_all.get_internal_view_data<Real,Host>(),counts.data(),displs.data(),
+                                   mpi_real,m_comm.mpi_comm()),
+                    "SCMInput: MPI_Allgatherv");
+
+    // Copy the column of its target in each column of the output field
+    auto& f = m_fields[i];
+    for (size_t icol=0; icol<m_col_target.size(); ++icol) {
+      f.subfield(0,icol).deep_copy<Host>(f_all.subfield(0,m_target_pos[m_col_target[icol]]));
+    }
 
     // Sync fields to device
     f.sync_to_dev();
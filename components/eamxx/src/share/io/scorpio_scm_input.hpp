@@ -12,15 +12,31 @@ namespace scream
 // a file with N columns. A few assumptions:
 //  - lat and lon variables are present in the file
 //  - fields have layout <COL [, ...]>
+// For ensembles of single column runs, the reader can also fill each column of
+// the fields with a different column of the file: the i-th column of the grid
+// (in the global ordering of the column gids) gets the file column closest to
+// the i-th target lat/lon pair. This allows to run N independent SCM cases as
+// the N columns of one PointGrid.
 class SCMInput
 {
 public:
   // --- Constructor(s) & Destructor --- //
+
+  // All columns of the fields get the file column closest to lat/lon
   SCMInput (const std::string& filename,
             const double lat, const double lon,
             const std::vector<Field>& fields,
             const ekat::Comm& comm);
 
+  // The fields are defined on grid, and the column with global index i (i.e.,
+  // gid minus the min gid of the grid) gets the file column closest to lats[i]/lons[i].
+  // The target lists must be the same on all ranks, and have one entry per grid column.
+  SCMInput (const std::string& filename,
+            const std::vector<double>& lats,
+            const std::vector<double>& lons,
+            const std::vector<Field>& fields,
+            const std::shared_ptr<const AbstractGrid>& grid);
+
   ~SCMInput ();
 
   // Due to resource acquisition (in scorpio), avoid copies
@@ -39,7 +55,8 @@ public:
   // Cuda requires methods enclosing __device__ lambda's to be public
 protected:
 #endif
-  void create_closest_col_info (double target_lat, double target_lon);
+  void create_closest_col_info (const std::vector<double>& target_lats,
+                                const std::vector<double>& target_lons);
 protected:
 
   struct ClosestColInfo {
@@ -49,6 +66,9 @@ protected:
     int col_lid;
   };
 
+  void init (const std::vector<double>& target_lats,
+             const std::vector<double>& target_lons,
+             const std::vector<Field>& fields);
   void create_io_grid ();
   void init_scorpio_structures ();
   void set_decompositions();
@@ -62,7 +82,18 @@ protected:
   std::vector<Field>        m_fields;
   std::vector<Field>        m_io_fields;
 
-  ClosestColInfo            m_closest_col_info;
+  // One entry per target lat/lon pair
+  std::vector<ClosestColInfo> m_closest_col_info;
+
+  // For each local column of the fields, the index of its target
+  std::vector<int>          m_col_target;
+
+  // The columns of all targets are gathered on all ranks, ordered by the rank
+  // that read them: for each target, its position in the gathered columns, and
+  // for each rank, the number of gathered columns and the position of the first one
+  std::vector<int>          m_target_pos;
+  std::vector<int>          m_rank_ncols;
+  std::vector<int>          m_rank_offset;
 
   // The logger to be used throughout the ATM to log message
   std::shared_ptr<ekat::logger::LoggerBase> m_atm_logger;
@@ -9,6 +9,7 @@
 #include "ekat/mpi/ekat_comm.hpp"
 #include "ekat/util/ekat_string_utils.hpp"
 
+#include <cstdio>
 #include <fstream>
 #include <memory>
 #include <chrono>
@@ -360,6 +361,21 @@ void OutputManager::run(const util::TimeStamp& timestamp)
   const bool has_checkpoint_data     = m_avg_type!=OutputAvgType::Instant && not output_every_step;
   const bool is_full_checkpoint_step = is_checkpoint_step && has_checkpoint_data && not is_output_step;
   const bool is_write_step           = is_output_step || is_checkpoint_step;
+  const bool is_async_write_step     = m_async_write && is_write_step;
+
+  // For async writes, the streams stage the snapshot before we touch any file, since the
+  // files may still be in use by the pending write of the previous write step.
+  if (is_async_write_step) {
+    start_timer(timer_root+"::run_output_streams");
+    for (auto& it : m_output_streams) {
+      it->run("",is_output_step,is_full_checkpoint_step,m_output_control.nsamples_since_last_write,is_t0_output);
+    }
+    stop_timer(timer_root+"::run_output_streams");
+
+    start_timer(timer_root+"::wait_pending_write");
+    wait_for_pending_write();
+    stop_timer(timer_root+"::wait_pending_write");
+  }
 
   // Create and setup output/checkpoint file(s), if necessary
   start_timer(timer_root+"::get_new_file");
@@ -396,15 +412,28 @@ void OutputManager::run(const util::TimeStamp& timestamp)
     // If we are going to write an output checkpoint file, or a model restart file,
     // we need to append to the filename ".rhist" or ".r" respectively, and add
     // the filename to the rpointer.atm file.
+    // With async writes of the model restart, the new content is written to rpointer.atm.tmp,
+    // which replaces rpointer.atm once the restart file is complete (in wait_for_pending_write),
+    // so that a job failing during the write restarts from the previous restart files.
+    // The history restart files of the same step are appended to the pending file.
+    if (m_is_model_restart_output and filespecs.is_restart_file()) {
+      m_pending_rpointer = is_async_write_step;
+    }
     if (m_io_comm.am_i_root() and filespecs.is_restart_file()) {
       std::ofstream rpointer;
       if (m_is_model_restart_output) {
-        rpointer.open("rpointer.atm");  // Open rpointer and nuke its content
+        if (is_async_write_step) {
+          rpointer.open("rpointer.atm.tmp");  // Open pending rpointer and nuke its content
+        } else {
+          std::remove("rpointer.atm.tmp");  // Left over by a job that failed during an async write
+          rpointer.open("rpointer.atm");  // Open rpointer and nuke its content
+        }
       } else if (is_checkpoint_step) {
         // Output restart unit tests do not have a model-output stream that generates rpointer.atm,
         // so allow to skip the next check for them.
         auto is_unit_testing = m_params.sublist("Checkpoint Control").get("is_unit_testing",false);
-        EKAT_REQUIRE_MSG (is_unit_testing || std::ifstream("rpointer.atm").good(),
+        const bool rpointer_pending = std::ifstream("rpointer.atm.tmp").good();
+        EKAT_REQUIRE_MSG (is_unit_testing || rpointer_pending || std::ifstream("rpointer.atm").good(),
             "Error! Cannot find rpointer.atm file to append history restart file in.\n"
             " Model restart output is supposed to be in charge of creating rpointer.atm.\n"
             " There are two possible causes:\n"
@@ -413,7 +442,8 @@ void OutputManager::run(const util::TimeStamp& timestamp)
             "   2. The current implementation assumes that the model restart OutputManager runs\n"
             "      *before* any other output stream (so it can nuke rpointer.atm if already existing).\n"
             "      If this has changed, we need to revisit this piece of the code.\n");
-        rpointer.open("rpointer.atm",std::ofstream::app);  // Open rpointer file and append to it
+        // Open rpointer file (or the pending one, if the model restart write is still running) and append to it
+        rpointer.open(rpointer_pending ? "rpointer.atm.tmp" : "rpointer.atm",std::ofstream::app);
       }
       rpointer << filespecs.filename << std::endl;
     }
@@ -441,16 +471,18 @@ void OutputManager::run(const util::TimeStamp& timestamp)
   stop_timer(timer_root+"::get_new_file");
 
   // Run the output streams
-  start_timer(timer_root+"::run_output_streams");
   const auto& fields_write_filename = is_output_step ? m_output_file_specs.filename : m_checkpoint_file_specs.filename;
-  for (auto& it : m_output_streams) {
-    // Note: filename only matters if is_output_step || is_full_checkpoint_step=true. In that case, it will definitely point to a valid file name.
-    if (m_atm_logger) {
-      m_atm_logger->debug("[OutputManager]: writing fields from grid " + it->get_io_grid()->name() + "...\n");
+  if (not is_async_write_step) {
+    start_timer(timer_root+"::run_output_streams");
+    for (auto& it : m_output_streams) {
+      // Note: filename only matters if is_output_step || is_full_checkpoint_step=true. In that case, it will definitely point to a valid file name.
+      if (m_atm_logger) {
+        m_atm_logger->debug("[OutputManager]: writing fields from grid " + it->get_io_grid()->name() + "...\n");
+      }
+      it->run(fields_write_filename,is_output_step,is_full_checkpoint_step,m_output_control.nsamples_since_last_write,is_t0_output);
     }
-    it->run(fields_write_filename,is_output_step,is_full_checkpoint_step,m_output_control.nsamples_since_last_write,is_t0_output);
+    stop_timer(timer_root+"::run_output_streams");
   }
-  stop_timer(timer_root+"::run_output_streams");
 
   if (is_write_step) {
     if (m_time_bnds.size()>0) {
@@ -464,91 +496,62 @@ void OutputManager::run(const util::TimeStamp& timestamp)
       }
     }
 
-    auto write_global_data = [&](IOControl& control, IOFileSpecs& filespecs) {
-      if (m_atm_logger) {
-        m_atm_logger->debug("[OutputManager]: writing globals...\n");
-      }
-
-      // Since we wrote to file we need to reset the timestamps
+    // Since we wrote to file we need to reset the timestamps
+    auto update_control = [&](IOControl& control) {
       control.last_write_ts = timestamp;
       control.compute_next_write_ts();
       control.nsamples_since_last_write = 0;
+    };
+    // Important! Process output control first, and hist restart (if any) second.
+    // That's b/c the updated m_output_control.last_write_ts is later written
+    // as global data in the hist restart file
+    if (is_output_step) {
+      update_control(m_output_control);
+    }
+    if (is_checkpoint_step) {
+      update_control(m_checkpoint_control);
+    }
 
-      if (m_is_model_restart_output) {
-        // Only write nsteps on model restart
-        set_attribute(filespecs.filename,"GLOBAL","nsteps",timestamp.get_num_steps());
-      } else {
-        if (filespecs.ftype==FileType::HistoryRestart) {
-          // Update the date of last write and sample size
-          write_timestamp (filespecs.filename,"last_write",m_output_control.last_write_ts,true);
-          scorpio::set_attribute (filespecs.filename,"GLOBAL","last_output_filename",m_output_file_specs.filename);
-          scorpio::set_attribute (filespecs.filename,"GLOBAL","num_snapshots_since_last_write",m_output_control.nsamples_since_last_write);
-
-          int nsnaps = m_output_file_specs.is_open
-                     ? scorpio::get_dimlen(m_output_file_specs.filename,"time") : 0;
-          scorpio::set_attribute (filespecs.filename,"GLOBAL","last_output_file_num_snaps",nsnaps);
-        }
-        // Write these in both output and rhist file. The former, b/c we need these info when we postprocess
-        // output, and the latter b/c we want to make sure these params don't change across restarts
-        set_attribute(filespecs.filename,"GLOBAL","averaging_type",e2str(m_avg_type));
-        set_attribute(filespecs.filename,"GLOBAL","averaging_frequency_units",m_output_control.frequency_units);
-        set_attribute(filespecs.filename,"GLOBAL","averaging_frequency",m_output_control.frequency);
-        set_attribute(filespecs.filename,"GLOBAL","file_max_storage_type",e2str(m_output_file_specs.storage.type));
-        if (m_output_file_specs.storage.type==NumSnaps) {
-          set_attribute(filespecs.filename,"GLOBAL","max_snapshots_per_file",m_output_file_specs.storage.max_snapshots_in_file);
-        }
-        const auto& fp_precision = m_params.get<std::string>("Floating Point Precision");
-        set_attribute(filespecs.filename,"GLOBAL","fp_precision",fp_precision);
+    // The file operations of this write step. Everything that may change before an
+    // async write completes is captured by value.
+    std::vector<int> staged_buffers;
+    if (is_async_write_step) {
+      for (const auto& it : m_output_streams) {
+        staged_buffers.push_back(it->get_staged_buffer());
       }
-
-      // Write all stored globals
-      for (const auto& it : m_globals) {
-        const auto& name = it.first;
-        const auto& any = it.second;
-        if (any.isType<int>()) {
-          set_attribute(filespecs.filename,"GLOBAL",name,ekat::any_cast<int>(any));
-        } else if (any.isType<std::int64_t>()) {
-          set_attribute(filespecs.filename,"GLOBAL",name,ekat::any_cast<std::int64_t>(any));
-        } else if (any.isType<float>()) {
-          set_attribute(filespecs.filename,"GLOBAL",name,ekat::any_cast<float>(any));
-        } else if (any.isType<double>()) {
-          set_attribute(filespecs.filename,"GLOBAL",name,ekat::any_cast<double>(any));
-        } else if (any.isType<std::string>()) {
-          set_attribute(filespecs.filename,"GLOBAL",name,ekat::any_cast<std::string>(any));
-        } else {
-          EKAT_ERROR_MSG (
-              "Error! Invalid concrete type for IO global.\n"
-              " - global name: " + it.first + "\n"
-              " - type id    : " + any.content().type().name() + "\n");
-        }
+    }
+    auto write_files = [this,timestamp,is_output_step,is_checkpoint_step,is_full_checkpoint_step,
+                        fields_filename=fields_write_filename,staged_buffers,
+                        last_output_write_ts=m_output_control.last_write_ts,
+                        output_nsamples=m_output_control.nsamples_since_last_write,
+                        time_bnds=m_time_bnds,globals=m_globals] () {
+      for (size_t i=0; i<staged_buffers.size(); ++i) {
+        m_output_streams[i]->write_staged_vars(fields_filename,staged_buffers[i]);
       }
-
-      // We're adding one snapshot to the file
-      filespecs.storage.update_storage(timestamp);
-
-      // NOTE: for checkpoint files, unless we write restart data, we did not update time,
-      //       which means we cannot write any variable (the check var.num_records==time.length
-      //       would fail)
-      if (m_time_bnds.size()>0 and
-          (filespecs.ftype!=FileType::HistoryRestart or is_full_checkpoint_step)) {
-        scorpio::write_var(filespecs.filename, "time_bnds", m_time_bnds.data());
+      // Process output file first, and hist restart (if any) second
+      if (is_output_step) {
+        write_global_data(m_output_file_specs,timestamp,last_output_write_ts,output_nsamples,
+                          time_bnds,globals,is_full_checkpoint_step);
       }
-
-      // Check if we need to flush the output file
-      if (filespecs.file_needs_flush()) {
-        flush_file (filespecs.filename);
+      if (is_checkpoint_step) {
+        write_global_data(m_checkpoint_file_specs,timestamp,last_output_write_ts,output_nsamples,
+                          time_bnds,globals,is_full_checkpoint_step);
       }
     };
 
-    start_timer(timer_root+"::update_snapshot_tally");
-    // Important! Process output file first, and hist restart (if any) second.
-    // That's b/c write_global_data will update m_output_control.last_write_ts,
-    // which is later written as global data in the hist restart file
-    if (is_output_step) {
-      write_global_data(m_output_control,m_output_file_specs);
+    if (m_atm_logger) {
+      m_atm_logger->debug("[OutputManager]: writing globals...\n");
     }
-    if (is_checkpoint_step) {
-      write_global_data(m_checkpoint_control,m_checkpoint_file_specs);
+    start_timer(timer_root+"::update_snapshot_tally");
+    if (is_async_write_step) {
+      // Write on a separate thread, while the atm keeps stepping. The next write step
+      // (or finalize) waits for it to complete before touching the files.
+      if (m_atm_logger) {
+        m_atm_logger->info("[EAMxx::output_manager]      (write deferred to async task)");
+      }
+      m_pending_write = std::async(std::launch::async,write_files);
+    } else {
+      write_files();
     }
     stop_timer(timer_root+"::update_snapshot_tally");
     if (is_output_step && m_time_bnds.size()>0) {
@@ -560,8 +563,88 @@ void OutputManager::run(const util::TimeStamp& timestamp)
   stop_timer(timer_root);
 }
 /*===============================================================================================*/
+void OutputManager::
+write_global_data (      IOFileSpecs& filespecs,
+                   const util::TimeStamp& timestamp,
+                   const util::TimeStamp& last_output_write_ts,
+                   const int output_nsamples_since_last_write,
+                   const std::vector<double>& time_bnds,
+                   const globals_map_t& globals,
+                   const bool is_full_checkpoint_step)
+{
+  using namespace scorpio;
+
+  if (m_is_model_restart_output) {
+    // Only write nsteps on model restart
+    set_attribute(filespecs.filename,"GLOBAL","nsteps",timestamp.get_num_steps());
+  } else {
+    if (filespecs.ftype==FileType::HistoryRestart) {
+      // Update the date of last write and sample size
+      write_timestamp (filespecs.filename,"last_write",last_output_write_ts,true);
+      scorpio::set_attribute (filespecs.filename,"GLOBAL","last_output_filename",m_output_file_specs.filename);
+      scorpio::set_attribute (filespecs.filename,"GLOBAL","num_snapshots_since_last_write",output_nsamples_since_last_write);
+
+      int nsnaps = m_output_file_specs.is_open
+                 ? scorpio::get_dimlen(m_output_file_specs.filename,"time") : 0;
+      scorpio::set_attribute (filespecs.filename,"GLOBAL","last_output_file_num_snaps",nsnaps);
+    }
+    // Write these in both output and rhist file. The former, b/c we need these info when we postprocess
+    // output, and the latter b/c we want to make sure these params don't change across restarts
+    set_attribute(filespecs.filename,"GLOBAL","averaging_type",e2str(m_avg_type));
+    set_attribute(filespecs.filename,"GLOBAL","averaging_frequency_units",m_output_control.frequency_units);
+    set_attribute(filespecs.filename,"GLOBAL","averaging_frequency",m_output_control.frequency);
+    set_attribute(filespecs.filename,"GLOBAL","file_max_storage_type",e2str(m_output_file_specs.storage.type));
+    if (m_output_file_specs.storage.type==NumSnaps) {
+      set_attribute(filespecs.filename,"GLOBAL","max_snapshots_per_file",m_output_file_specs.storage.max_snapshots_in_file);
+    }
+    const auto& fp_precision = m_params.get<std::string>("Floating Point Precision");
+    set_attribute(filespecs.filename,"GLOBAL","fp_precision",fp_precision);
+  }
+
+  // Write all stored globals
+  for (const auto& it : globals) {
+    const auto& name = it.first;
+    const auto& any = it.second;
+    if (any.isType<int>()) {
+      set_attribute(filespecs.filename,"GLOBAL",name,ekat::any_cast<int>(any));
+    } else if (any.isType<std::int64_t>()) {
+      set_attribute(filespecs.filename,"GLOBAL",name,ekat::any_cast<std::int64_t>(any));
+    } else if (any.isType<float>()) {
+      set_attribute(filespecs.filename,"GLOBAL",name,ekat::any_cast<float>(any));
+    } else if (any.isType<double>()) {
+      set_attribute(filespecs.filename,"GLOBAL",name,ekat::any_cast<double>(any));
+    } else if (any.isType<std::string>()) {
+      set_attribute(filespecs.filename,"GLOBAL",name,ekat::any_cast<std::string>(any));
+    } else {
+      EKAT_ERROR_MSG (
+          "Error! Invalid concrete type for IO global.\n"
+          " - global name: " + it.first + "\n"
+          " - type id    : " + any.content().type().name() + "\n");
+    }
+  }
+
+  // We're adding one snapshot to the file
+  filespecs.storage.update_storage(timestamp);
+
+  // NOTE: for checkpoint files, unless we write restart data, we did not update time,
+  //       which means we cannot write any variable (the check var.num_records==time.length
+  //       would fail)
+  if (time_bnds.size()>0 and
+      (filespecs.ftype!=FileType::HistoryRestart or is_full_checkpoint_step)) {
+    scorpio::write_var(filespecs.filename, "time_bnds", time_bnds.data());
+  }
+
+  // Check if we need to flush the output file
+  if (filespecs.file_needs_flush()) {
+    flush_file (filespecs.filename);
+  }
+}
+/*===============================================================================================*/
 void OutputManager::finalize()
 {
+  // Complete any pending async write before closing the files
+  wait_for_pending_write();
+
   // Close any output file still open
   if (m_output_file_specs.is_open) {
     scorpio::release_file (m_output_file_specs.filename);
@@ -591,6 +674,26 @@ void OutputManager::finalize()
   m_atm_logger = {};
 }
 
+void OutputManager::wait_for_pending_write ()
+{
+  // Note: get() rethrows any exception thrown during the write, in which case
+  //       rpointer.atm keeps pointing to the previous restart files
+  if (m_pending_write.valid()) {
+    m_pending_write.get();
+  }
+
+  // The restart file is complete (model restart files are flushed at every write),
+  // so it is now safe to point rpointer.atm to it
+  if (m_pending_rpointer) {
+    if (m_io_comm.am_i_root()) {
+      EKAT_REQUIRE_MSG (std::rename("rpointer.atm.tmp","rpointer.atm")==0,
+          "Error! Could not rename rpointer.atm.tmp to rpointer.atm.\n"
+          " - filename prefix: " + m_filename_prefix + "\n");
+    }
+    m_pending_rpointer = false;
+  }
+}
+
 long long OutputManager::res_dep_memory_footprint () const {
   long long mf = 0;
   for (const auto& os : m_output_streams) {
@@ -706,6 +809,26 @@ set_params (const ekat::ParameterList& params,
         "  - supported values: float, single, double, real\n");
   }
 
+  // With async writes, the IO library is called from a separate thread, while the
+  // model (possibly including other IO) keeps running. That requires full MPI thread
+  // support, so fall back to regular writes if MPI does not provide it. This holds for
+  // model restart output too: the restart fields are staged in host memory, and the
+  // restart file is written while the atm keeps stepping.
+  m_async_write = m_params.get("async_write",false);
+  if (m_async_write) {
+    int thread_level;
+    MPI_Query_thread(&thread_level);
+    if (thread_level<MPI_THREAD_MULTIPLE) {
+      if (m_atm_logger) {
+        m_atm_logger->warn("[EAMxx::output_manager] Warning! 'async_write' requires MPI_THREAD_MULTIPLE.\n"
+                           "  Falling back to synchronous writes for stream '" + m_filename_prefix + "'.\n");
+      }
+      m_async_write = false;
+    }
+  }
+  // The streams read this parameter too
+  m_params.set("async_write",m_async_write);
+
   // Output control
   EKAT_REQUIRE_MSG(m_params.isSublist("output_control"),
       "Error! The output control YAML file for " + m_filename_prefix + " is missing the sublist 'output_control'");
@@ -833,9 +956,10 @@ setup_file (      IOFileSpecs& filespecs,
     set_file_header(filespecs);
   }
 
-  // Make all output streams register their dims/vars
+  // Make all output streams register their dims/vars. Restart files must store
+  // the exact values, so don't quantize their data.
   for (auto& it : m_output_streams) {
-    it->setup_output_file(filename,fp_precision,mode);
+    it->setup_output_file(filename,fp_precision,mode,not filespecs.is_restart_file());
   }
 
   // If grid data is needed,  also register geo data fields. Skip if file is resumed,
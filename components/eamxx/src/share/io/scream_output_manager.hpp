@@ -16,6 +16,8 @@
 #include "ekat/ekat_parameter_list.hpp"
 #include "ekat/ekat_parse_yaml_file.hpp"
 
+#include <future>
+
 namespace scream
 {
 
@@ -132,6 +134,20 @@ protected:
   void setup_file (      IOFileSpecs& filespecs,
                    const IOControl& control);
 
+  // Write the global attributes (and time_bnds) of a write step, and flush the file if needed.
+  // All inputs that can change before an async write completes are passed in.
+  void write_global_data (      IOFileSpecs& filespecs,
+                          const util::TimeStamp& timestamp,
+                          const util::TimeStamp& last_output_write_ts,
+                          const int output_nsamples_since_last_write,
+                          const std::vector<double>& time_bnds,
+                          const globals_map_t& globals,
+                          const bool is_full_checkpoint_step);
+
+  // Complete the async write of the last write step (if any), and then point
+  // rpointer.atm to the restart files of that step
+  void wait_for_pending_write ();
+
   // Manage logging of info to atm.log
   void push_to_logger();
 
@@ -185,6 +201,16 @@ protected:
 
   // If true, we save grid data in output file
   bool m_save_grid_data;
+
+  // If true, the file operations of each write step run on a separate thread,
+  // overlapping with the following atm steps, until the next write step
+  bool m_async_write = false;
+  std::future<void> m_pending_write;
+
+  // If true, the model restart file of the pending write is listed in rpointer.atm.tmp,
+  // which replaces rpointer.atm once the write completes. Until then, rpointer.atm
+  // points to the previous (complete) restart files.
+  bool m_pending_rpointer = false;
 };
 
 } // namespace scream
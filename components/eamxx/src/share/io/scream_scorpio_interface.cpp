@@ -8,6 +8,10 @@
 
 #include <pio.h>
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <numeric>
 
 namespace scream {
@@ -31,17 +35,18 @@ public:
   strmap_t<PIOFile>                     files;
   strmap_t<std::shared_ptr<PIODecomp>>  decomps;
 
-  // In the above map, we would like to label decomps as dtype_dim1$N1_dim2$N2...
-  // where N$i is the global length of dim$i. However, it *may* happen that we use
-  // two different decompositions for the same global layout, which would clash
-  // the names. For this reason, we append at the end an increasing counter,
-  // which disambiguate between globally-equivalent partitions.
-  // When adding a new decomp, we check this map to see if another decomp
-  // already exists with the same global layout. If so, we first check to see
-  // if that decomp is equivalent to the new one *on all ranks*. If yes, we
-  // recycle it, otherwise we create a new PIO decomp.
-  // strmap_t<std::list<std::string>>    decomp_global_layout_to_decomp_name;
-  // strmap_t<int>                       decomp_global_layout_to_counter;
+  // In the above map, we label decomps as dtype-dim1<N1>_dim2<N2>..._dimk<Nk>-$counter,
+  // where N$i is the global length of dim$i. It *may* happen that we use two
+  // different decompositions for the same global layout (e.g., two grids with
+  // the same number of dofs, or a dim whose decomp was reset), so the counter
+  // disambiguates between globally-equivalent layouts.
+  // When a var needs a decomp, we check this map to see if other decomps
+  // already exist with the same global layout. If so, we check if any of them
+  // is equivalent to the new one *on all ranks*. If yes, we recycle it, otherwise
+  // we create a new PIO decomp. Decomps are never released before finalize,
+  // so that files opened at different times (output streams, restarts, ...)
+  // share the same PIO decomps, with no need to rebuild them.
+  strmap_t<std::vector<std::string>>    decomp_global_layout_to_decomp_name;
 
   int         pio_sysid        = -1;
   int         pio_type_default = -1;
@@ -64,6 +69,35 @@ void copy_data (const S* src, D* dst, int n) {
   }
 }
 
+// Round src to nsd significant digits into dst, using BitRound: the mantissa is rounded
+// (to nearest, ties to even) to the number of bits needed to represent nsd decimal digits.
+// Entries equal to fill_value, as well as inf/nan, are copied unchanged.
+template<typename T>
+void bit_round (const T* src, T* dst, const int n, const int nsd, const double fill_value) {
+  using uint_t = typename std::conditional<sizeof(T)==4,std::uint32_t,std::uint64_t>::type;
+  constexpr int mantissa_bits = std::numeric_limits<T>::digits - 1;
+  const int keep_bits = std::ceil(nsd*std::log2(10.0));
+  if (keep_bits>=mantissa_bits) {
+    copy_data(src,dst,n);
+    return;
+  }
+  const int drop_bits = mantissa_bits - keep_bits;
+  const uint_t half_m1 = (uint_t(1) << (drop_bits-1)) - 1;
+  const uint_t mask = ~((uint_t(1) << drop_bits) - 1);
+  const T fill = fill_value;
+  for (int i=0; i<n; ++i) {
+    if (src[i]==fill or not std::isfinite(src[i])) {
+      dst[i] = src[i];
+      continue;
+    }
+    uint_t bits;
+    std::memcpy(&bits,&src[i],sizeof(T));
+    bits += half_m1 + ((bits >> drop_bits) & 1);
+    bits &= mask;
+    std::memcpy(&dst[i],&bits,sizeof(T));
+  }
+}
+
 // Utility for common IO operation failure
 void check_scorpio_noerr (const int err,
                           const std::string& func_name,
@@ -216,6 +250,8 @@ int pio_iotype (IOType iotype) {
     case IOType::PnetCDF:       iotype_int = static_cast<int>(PIO_IOTYPE_PNETCDF);  break;
     case IOType::Adios:         iotype_int = static_cast<int>(PIO_IOTYPE_ADIOS);    break;
     case IOType::Hdf5:          iotype_int = static_cast<int>(PIO_IOTYPE_HDF5);     break;
+    case IOType::NetCDF4C:      iotype_int = static_cast<int>(PIO_IOTYPE_NETCDF4C); break;
+    case IOType::NetCDF4P:      iotype_int = static_cast<int>(PIO_IOTYPE_NETCDF4P); break;
     default:
       EKAT_ERROR_MSG ("Unrecognized/unsupported iotype.\n");
   }
@@ -376,6 +412,7 @@ void finalize_subsystem ()
     check_scorpio_noerr(err,"finalize_subsystem","freedecomp");
   }
   s.decomps.clear();
+  s.decomp_global_layout_to_decomp_name.clear();
 
 #ifndef SCREAM_CIME_BUILD
   // Don't finalize in CIME builds, since the coupler will take care of it
@@ -769,38 +806,54 @@ void set_var_decomp (PIOVar& var,
       " - varname   : " + var.name  + "\n"
       " - var decomp: " + var.decomp->name  + "\n");
 
-  // Create decomp name: dtype-dim1<len1>_dim2<len2>_..._dimk<lenN>
-  std::shared_ptr<const PIODim> decomp_dim;
-  std::string decomp_tag = var.dtype + "-";
+  // Create decomp global layout tag: dtype-dim1<len1>_dim2<len2>_..._dimk<lenN>
+  std::string layout_tag = var.dtype + "-";
   for (auto d : var.dims) {
-    decomp_tag += d->name + "<" + std::to_string(d->length) + ">_";
+    layout_tag += d->name + "<" + std::to_string(d->length) + ">_";
   }
-  decomp_tag.pop_back(); // remove trailing underscore
+  layout_tag.pop_back(); // remove trailing underscore
 
-  // Check if a decomp with this name already exists
+  // Check if a decomp with this global layout and the same dofs distribution already exists
   auto& s = ScorpioSession::instance();
-  auto& decomp = s.decomps[decomp_tag];
+  const auto& comm = s.comm;
+  auto& decomp_names = s.decomp_global_layout_to_decomp_name[layout_tag];
 #ifndef NDEBUG
-  // Extra check: all ranks must agree on whether they have the decomposition!
-  // If they don't agree, some rank will be stuck in a PIO call, waiting for others
-  int found = decomp==nullptr ? 0 : 1;
+  // Extra check: all ranks must agree on the decomps they have for this layout!
+  // If they don't agree, some rank will be stuck in a collective call, waiting for others
+  int num_found = decomp_names.size();
   int min_found, max_found;
-  const auto& comm = ScorpioSession::instance().comm;
-  comm.all_reduce(&found,&min_found,1,MPI_MIN);
-  comm.all_reduce(&found,&max_found,1,MPI_MAX);
+  comm.all_reduce(&num_found,&min_found,1,MPI_MIN);
+  comm.all_reduce(&num_found,&max_found,1,MPI_MAX);
   EKAT_REQUIRE_MSG(min_found==max_found,
-      "Error! Decomposition already present on some ranks but not all.\n"
+      "Error! Decompositions for this layout already present on some ranks but not all.\n"
       " - filename: " + filename + "\n"
       " - varname : " + var.name + "\n"
       " - var dims: " + ekat::join(var.dims,get_entity_name,",") + "\n"
-      " - decopm tag: " + decomp_tag + "\n");
+      " - layout tag: " + layout_tag + "\n");
 #endif
 
-  if (decomp==nullptr) {
-    // We haven't create this decomp yet. Go ahead and create one
+  const auto& var_offsets = var.dims[0]->offsets;
+  for (const auto& dn : decomp_names) {
+    const auto& candidate = s.decomps.at(dn);
+    const auto& cand_offsets = candidate->dim_offsets;
+    int same = cand_offsets==var_offsets or *cand_offsets==*var_offsets;
+    comm.all_reduce(&same,1,MPI_MIN);
+    if (same==1) {
+      // Recycle the existing decomp
+      var.decomp = candidate;
+      return;
+    }
+  }
+
+  // We haven't create this decomp yet. Go ahead and create one
+  const std::string decomp_tag = layout_tag + "-" + std::to_string(decomp_names.size());
+  auto& decomp = s.decomps[decomp_tag];
+  decomp_names.push_back(decomp_tag);
+  {
     decomp = std::make_shared<PIODecomp>();
     decomp->name = decomp_tag;
     decomp->dim = var.dims[0];
+    decomp->dim_offsets = var_offsets;
 
     int ndims = var.dims.size();
 
@@ -814,7 +867,7 @@ void set_var_decomp (PIOVar& var,
     }
 
     // Create offsets list
-    const auto& dim_offsets = *decomp->dim->offsets;
+    const auto& dim_offsets = *decomp->dim_offsets;
     int dim_loc_len = dim_offsets.size();
     decomp->offsets.resize (non_decomp_dim_prod*dim_loc_len);
     for (int idof=0; idof<dim_loc_len; ++idof) {
@@ -843,7 +896,6 @@ void set_dim_decomp (const std::string& filename,
                      const std::vector<offset_t>& my_offsets,
                      const bool allow_reset)
 {
-  auto& s = ScorpioSession::instance();
   auto& f = impl::get_file(filename,"scorpio::set_decomp");
   auto& dim = impl::get_dim(filename,dimname,"scorpio::set_dim_decomp");
 
@@ -854,26 +906,15 @@ void set_dim_decomp (const std::string& filename,
 
   if (dim.offsets!=nullptr) {
     if (allow_reset) {
-      // We likely won't need the previously created decomps that included this dimension.
-      // So, as we remove decomps from vars that have this dim, keep track of their name,
-      // so that we can free them later *if no other users of them remain*.
-      std::set<std::string> decomps_to_remove;
+      // Detach the vars with this dimension from their current decomp. We do not free
+      // the decomps though: they stay in the session cache, since other files (or this
+      // one, at a later time) may go back to the same dofs distribution.
       for (auto it : f.vars) {
         auto v = it.second;
         if (v->decomp!=nullptr and v->decomp->dim->name==dimname) {
-          decomps_to_remove.insert(v->decomp->name);
           v->decomp = nullptr;
         }
       }
-      for (const auto& dn : decomps_to_remove) {
-        if (s.decomps.at(dn).use_count()==1) {
-          auto decomp = s.decomps.at(dn);
-          // There is no other customer of this decomposition, so we can safely free it
-          int err = PIOc_freedecomp(s.pio_sysid,decomp->ncid);
-          check_scorpio_noerr(err,filename,"decomp",dn,"set_dim_decomp","freedecomp");
-          s.decomps.erase(dn);
-        }
-      }
     } else {
       // Check that the offsets are (globally) the same
       int same = *dim.offsets==my_offsets;
@@ -1049,6 +1090,73 @@ void define_var (const std::string& filename, const std::string& varname,
   define_var(filename,varname,"",dimensions,dtype,dtype,time_dependent);
 }
 
+void define_var_compression (const std::string& filename, const std::string& varname,
+                             const int deflate_level, const bool shuffle,
+                             const std::vector<int>& chunk_sizes)
+{
+  const auto& f = impl::get_file(filename,"scorpio::define_var_compression");
+  const auto& var = impl::get_var(filename,varname,"scorpio::define_var_compression");
+
+  EKAT_REQUIRE_MSG (f.mode==Write and not f.enddef,
+      "Error! Variable compression can only be set in define mode of files open in Write mode.\n"
+      " - filename: " + filename + "\n"
+      " - varname : " + varname + "\n");
+  EKAT_REQUIRE_MSG (deflate_level>=0 and deflate_level<=9,
+      "Error! Invalid deflate level (must be in [0,9]).\n"
+      " - filename: " + filename + "\n"
+      " - varname : " + varname + "\n"
+      " - deflate level: " + std::to_string(deflate_level) + "\n");
+  EKAT_REQUIRE_MSG (chunk_sizes.size()==0 or chunk_sizes.size()==var.dims.size(),
+      "Error! Chunk sizes must be specified for all the variable dimensions.\n"
+      " - filename : " + filename + "\n"
+      " - varname  : " + varname + "\n"
+      " - var dims : " + ekat::join(var.dim_names(),",") + "\n"
+      " - num chunk sizes: " + std::to_string(chunk_sizes.size()) + "\n");
+
+  // Only NetCDF4 files support chunking and compression
+  const int iotype = pio_iotype(f.iotype);
+  if (iotype!=PIO_IOTYPE_NETCDF4C and iotype!=PIO_IOTYPE_NETCDF4P) {
+    return;
+  }
+
+  int err;
+  if (chunk_sizes.size()>0) {
+    std::vector<PIO_Offset> chunks;
+    if (var.time_dep) {
+      chunks.push_back(1);
+    }
+    for (size_t i=0; i<chunk_sizes.size(); ++i) {
+      EKAT_REQUIRE_MSG (chunk_sizes[i]>0,
+          "Error! Chunk sizes must be positive.\n"
+          " - filename : " + filename + "\n"
+          " - varname  : " + varname + "\n"
+          " - dimname  : " + var.dims[i]->name + "\n");
+      chunks.push_back(std::min(chunk_sizes[i],var.dims[i]->length));
+    }
+    err = PIOc_def_var_chunking(f.ncid,var.ncid,NC_CHUNKED,chunks.data());
+    check_scorpio_noerr(err,f.name,"variable",varname,"define_var_compression","def_var_chunking");
+  }
+  if (deflate_level>0) {
+    err = PIOc_def_var_deflate(f.ncid,var.ncid,shuffle ? 1 : 0,1,deflate_level);
+    check_scorpio_noerr(err,f.name,"variable",varname,"define_var_compression","def_var_deflate");
+  }
+}
+
+void set_var_quantization (const std::string& filename, const std::string& varname,
+                           const int nsd, const double fill_value)
+{
+  auto& var = impl::get_var(filename,varname,"scorpio::set_var_quantization");
+
+  EKAT_REQUIRE_MSG (nsd>=0,
+      "Error! Invalid number of significant digits for quantization.\n"
+      " - filename: " + filename + "\n"
+      " - varname : " + varname + "\n"
+      " - nsd     : " + std::to_string(nsd) + "\n");
+
+  var.nsd = nsd;
+  var.quantize_fill_value = fill_value;
+}
+
 // This overload is not exposed externally. Also, filename is only
 // used to print it in case there are errors
 void change_var_dtype (PIOVar& var,
@@ -1288,6 +1396,24 @@ void write_var (const std::string &filename, const std::string &varname, const T
 
   int err;
 
+  // If requested, write a copy of the data rounded to the desired significant digits
+  if constexpr (std::is_floating_point<T>::value) {
+    if (var.nsd>0) {
+      int n = 1;
+      if (var.decomp) {
+        n = var.decomp->offsets.size();
+      } else {
+        for (auto d : var.dims) {
+          n *= d->length;
+        }
+      }
+      var.quantize_buf.resize(n*sizeof(T));
+      auto qbuf = reinterpret_cast<T*>(var.quantize_buf.data());
+      bit_round(buf,qbuf,n,var.nsd,var.quantize_fill_value);
+      buf = qbuf;
+    }
+  }
+
   if (var.time_dep) {
     ++var.num_records;
     EKAT_REQUIRE_MSG (var.num_records==f.time_dim->length,
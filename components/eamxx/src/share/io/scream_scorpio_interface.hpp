@@ -125,6 +125,10 @@ void reset_unlimited_dim_len(const std::string& filename, const int new_length);
 //   in the ScorpioInstance. The return value is the local length of the dimension
 // - if allow_reset=true, we simply reset the decomposition (if present).
 // - if allow_reset=false, if a decomposition for this dim is already set, we error out
+// - the PIO decompositions built for the vars are cached in the scorpio session, keyed by
+//   dtype, global layout, and dofs distribution, and are only freed at finalize. Hence,
+//   files opened at different times (output streams, restarts, inputs) with the same
+//   layout and partition recycle the same PIO decomposition.
 
 void set_dim_decomp (const std::string& filename,
                      const std::string& dimname,
@@ -154,6 +158,25 @@ void define_var (const std::string& filename, const std::string& varname,
                  const std::string& dtype,
                  const bool time_dependent = false);
 
+// Set chunking and deflate compression of a var (call after define_var, before enddef).
+// Notes:
+//  - this is only supported for NetCDF4 file types (netcdf4c and netcdf4p). For other
+//    file types, the call is a no-op, so that the same settings can be used for any file type.
+//  - deflate_level=0 means no compression. Otherwise, it must be in [1,9].
+//  - chunk_sizes must be empty (use library default chunking) or have one entry per var dim.
+//    For time-dependent vars, the chunk size along the time dim is 1.
+void define_var_compression (const std::string& filename, const std::string& varname,
+                             const int deflate_level, const bool shuffle,
+                             const std::vector<int>& chunk_sizes = {});
+
+// Round floating point data of a var to nsd significant digits (BitRound) when it is written.
+// This makes the data much more compressible (e.g., with define_var_compression), at the price
+// of a controlled loss of precision. Entries equal to fill_value are not modified.
+// nsd=0 disables the quantization. This setting is not stored in the file, so it can be set
+// on files open in Append mode too.
+void set_var_quantization (const std::string& filename, const std::string& varname,
+                           const int nsd, const double fill_value);
+
 // This is useful when reading data sets. E.g., if the pio file is storing
 // a var as float, but we need to read it as double, we need to call this.
 // NOTE: read_var/write_var automatically change the dtype if the input
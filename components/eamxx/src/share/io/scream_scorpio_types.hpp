@@ -27,6 +27,8 @@ enum IOType {
   PnetCDF,
   Adios,
   Hdf5,
+  NetCDF4C,   // NetCDF4 (HDF5 based), compressed serial writes
+  NetCDF4P,   // NetCDF4 (HDF5 based), parallel writes
   Invalid
 };
 
@@ -82,6 +84,11 @@ struct PIODim : public PIOFileEntity {
 struct PIODecomp : public PIOEntity {
   std::vector<offset_t>           offsets;  // Owned offsets
   std::shared_ptr<const PIODim>   dim; 
+
+  // The offsets of the decomposed dim at the time this decomp was created.
+  // Since dim offsets can be reset, we store them separately, so that the
+  // decomp can be safely recycled by vars/files with the same dofs distribution
+  std::shared_ptr<const std::vector<offset_t>> dim_offsets;
 };
 
 // A variable
@@ -113,6 +120,13 @@ struct PIOVar : public PIOFileEntity {
   // Used only if a) var is not decomposed, and b) dtype!=nc_dtype
   int size = -1; // Product of all dims
   std::vector<char> buf;
+
+  // If nsd>0, floating point data is rounded to nsd significant digits before
+  // being written (see set_var_quantization). Entries equal to the fill value are
+  // not modified. The buffer stores the rounded copy of the data.
+  int nsd = 0;
+  double quantize_fill_value;
+  std::vector<char> quantize_buf;
 };
 
 // A file, which is basically a container for dims and vars
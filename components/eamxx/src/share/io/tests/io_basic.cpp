@@ -126,7 +126,8 @@ get_fm (const std::shared_ptr<const AbstractGrid>& grid,
 
 // Returns fields after initialization
 void write (const std::string& avg_type, const std::string& freq_units,
-            const int freq, const int seed, const ekat::Comm& comm)
+            const int freq, const int seed, const ekat::Comm& comm,
+            const bool async_write = false)
 {
   // Create grid
   auto gm = get_gm(comm);
@@ -153,6 +154,7 @@ void write (const std::string& avg_type, const std::string& freq_units,
   ctrl_pl.set("frequency_units",freq_units);
   ctrl_pl.set("Frequency",freq);
   ctrl_pl.set("save_grid_data",false);
+  om_pl.set("async_write",async_write);
 
   // Create Output manager
   OutputManager om;
@@ -310,4 +312,26 @@ TEST_CASE ("io_basic") {
   scorpio::finalize_subsystem();
 }
 
+TEST_CASE ("io_basic_async") {
+  // With async writes, the output files must be identical to the sync ones.
+  // Note: if MPI does not provide MPI_THREAD_MULTIPLE, the output manager
+  //       falls back to sync writes, so this test still checks the results.
+  std::vector<std::string> avg_type = {
+    "INSTANT",
+    "AVERAGE"
+  };
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+  scorpio::init_subsystem(comm);
+
+  auto seed = get_random_test_seed(&comm);
+
+  const int freq = 5;
+  for (const auto& avg : avg_type) {
+    write(avg,"nsteps",freq,seed,comm,true);
+    read (avg,"nsteps",freq,seed,comm);
+  }
+  scorpio::finalize_subsystem();
+}
+
 } // anonymous namespace
@@ -112,6 +112,62 @@ void read (const int seed, const int nlevs, const ekat::Comm& comm)
   }
 }
 
+void read_ensemble (const int seed, const int nlevs, const ekat::Comm& comm)
+{
+  using ekat::units::Units;
+  using IPDF = std::uniform_int_distribution<int>;
+  using Engine = std::mt19937_64;
+
+  Engine engine(seed);
+
+  // Read lat/lon/var from file
+  auto filename = "io_scm_np" + std::to_string(comm.size()) + ".nc";
+  scorpio::register_file(filename,scorpio::Read,scorpio::DefaultIOType);
+  int ncols = scorpio::get_dimlen(filename,"ncol");
+
+  std::vector<Real> lat(ncols), lon(ncols), var(ncols*nlevs);
+  scorpio::read_var(filename,"lat",lat.data());
+  scorpio::read_var(filename,"lon",lon.data());
+  scorpio::read_var(filename,"var",var.data());
+
+  scorpio::release_file(filename);
+
+  // Pick a random file column for each ensemble member, with repetitions
+  const int nens = 2*comm.size()+1;
+  std::vector<int> tgt_cols(nens);
+  for (auto& c : tgt_cols) {
+    c = IPDF(0,ncols-1)(engine);
+  }
+  comm.broadcast(tgt_cols.data(),nens,comm.root_rank());
+
+  std::vector<double> tgt_lats, tgt_lons;
+  for (auto c : tgt_cols) {
+    tgt_lats.push_back(lat[c]);
+    tgt_lons.push_back(lon[c]);
+  }
+
+  // Create field to read, with one column per ensemble member
+  auto grid = create_point_grid("ens_grid",nens,nlevs,comm);
+  FieldIdentifier fid("var",grid->get_3d_scalar_layout(true),Units::nondimensional(),grid->name());
+  Field var_f(fid);
+  var_f.allocate_view();
+
+  // Read field
+  SCMInput reader(filename,tgt_lats,tgt_lons,{var_f},grid);
+  reader.read_variables();
+
+  // Check
+  auto gids = grid->get_dofs_gids().get_view<const AbstractGrid::gid_type*,Host>();
+  auto min_gid = grid->get_global_min_dof_gid();
+  auto var_h = var_f.get_view<const Real**,Host>();
+  for (int icol=0; icol<grid->get_num_local_dofs(); ++icol) {
+    const int tgt_col = tgt_cols[gids[icol]-min_gid];
+    for (int ilev=0; ilev<nlevs; ++ilev) {
+      REQUIRE (var_h(icol,ilev)==var[tgt_col*nlevs+ilev]);
+    }
+  }
+}
+
 TEST_CASE ("scm_io") {
   using IPDF = std::uniform_int_distribution<int>;
   using Engine = std::mt19937_64;
@@ -129,6 +185,7 @@ TEST_CASE ("scm_io") {
 
   write(seed,ncols,nlevs,comm);
   read(seed,nlevs,comm);
+  read_ensemble(seed,nlevs,comm);
 
   scorpio::finalize_subsystem();
 }
@@ -4,6 +4,7 @@
 #include "share/io/scorpio_output.hpp"
 #include "share/io/scorpio_input.hpp"
 #include "share/io/scream_scorpio_interface.hpp"
+#include "share/io/scream_io_utils.hpp"
 
 #include "share/grid/mesh_free_grids_manager.hpp"
 #include "share/grid/point_grid.hpp"
@@ -22,8 +23,10 @@
 #include "ekat/util/ekat_test_utils.hpp"
 
 #include <iostream>
+#include <cstdio>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 
 namespace scream {
 
@@ -153,6 +156,112 @@ TEST_CASE("output_restart","io")
   scorpio::finalize_subsystem();
 } 
 
+TEST_CASE("async_model_restart","io")
+{
+  // With async writes, the model restart file is written while the atm keeps stepping.
+  // rpointer.atm must only point to it once the write is complete, and the file must
+  // round-trip. Note: if MPI does not provide MPI_THREAD_MULTIPLE, the output manager
+  //       falls back to sync writes, so this test still checks the results.
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  int num_gcols = std::max(comm.size()-1,1);
+  int num_levs = 3;
+  int dt = 1;
+
+  auto engine = setup_random_test(&comm);
+
+  auto gm = get_test_gm(comm,num_gcols,num_levs);
+  auto grid = gm->get_grid("Point Grid");
+
+  auto fm = get_test_fm(grid);
+  randomize_fields(*fm,engine);
+  const auto& restart_fields = fm->get_groups_info().at("RESTART")->m_fields_names;
+
+  scorpio::init_subsystem(comm);
+
+  util::TimeStamp t0 ({2000,1,1},{0,0,0});
+
+  const std::string prefix = "async_model_restart";
+  ekat::ParameterList restart_params;
+  restart_params.set<std::string>("filename_prefix",prefix);
+  restart_params.set<std::string>("Averaging Type","Instant");
+  restart_params.set<bool>("async_write",true);
+  restart_params.sublist("output_control").set<std::string>("frequency_units","nsteps");
+  restart_params.sublist("output_control").set<int>("Frequency",5);
+
+  // The model restart OM is in charge of creating rpointer.atm
+  if (comm.am_i_root()) {
+    std::remove("rpointer.atm");
+    std::remove("rpointer.atm.tmp");
+  }
+  comm.barrier();
+
+  int thread_level;
+  MPI_Query_thread(&thread_level);
+  const bool async = thread_level>=MPI_THREAD_MULTIPLE;
+
+  // Returns the content of a file (empty if the file does not exist)
+  auto read_file = [](const std::string& fname) {
+    std::ifstream ifs(fname);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+  };
+
+  OutputManager om;
+  om.setup(comm,restart_params,fm,gm,t0,t0,true);
+
+  auto time = t0;
+  for (int i=0; i<10; ++i) {
+    om.init_timestep(time,dt);
+    time_advance(*fm,restart_fields,dt);
+    time += dt;
+    om.run(time);
+
+    // After the first restart step, the write may still be pending, so the restart
+    // file must only be listed in the pending rpointer file. The second restart step
+    // waits for the first write, so rpointer.atm then points to the first file.
+    if (comm.am_i_root() and async and (i==4 or i==9)) {
+      const auto rpointer = read_file("rpointer.atm");
+      const auto pending  = read_file("rpointer.atm.tmp");
+      const auto step_5  = (t0+5*dt).to_string() + ".nc";
+      const auto step_10 = (t0+10*dt).to_string() + ".nc";
+      if (i==4) {
+        REQUIRE (rpointer.find(".r.")==std::string::npos);
+        REQUIRE (pending.find(step_5)!=std::string::npos);
+      } else {
+        REQUIRE (rpointer.find(step_5)!=std::string::npos);
+        REQUIRE (pending.find(step_10)!=std::string::npos);
+      }
+    }
+  }
+  om.finalize();
+
+  // Once the write completed, rpointer.atm points to the last restart file
+  if (comm.am_i_root()) {
+    REQUIRE (not std::ifstream("rpointer.atm.tmp").good());
+  }
+  auto filename = find_filename_in_rpointer(prefix,true,comm,t0+10*dt);
+
+  // Read the restart fields back, and compare with the state at the last restart step
+  std::vector<Field> fields;
+  for (const auto& fn : restart_fields) {
+    fields.push_back(fm->get_field(fn).clone());
+    fields.back().deep_copy(0);
+  }
+  {
+    // The reader releases the file when it goes out of scope
+    AtmosphereInput reader(filename,grid,fields);
+    reader.read_variables();
+  }
+  for (const auto& f : fields) {
+    REQUIRE (views_are_equal(f,fm->get_field(f.name())));
+  }
+  REQUIRE (scorpio::get_attribute<int>(filename,"GLOBAL","nsteps")==10);
+
+  scorpio::finalize_subsystem();
+}
+
 /*=============================================================================================*/
 std::shared_ptr<FieldManager>
 get_test_fm(const std::shared_ptr<const AbstractGrid>& grid)
@@ -182,11 +291,11 @@ get_test_fm(const std::shared_ptr<const AbstractGrid>& grid)
 
   // Register fields with fm
   fm->registration_begins();
-  fm->register_field(FR{fid1,SL{"output"}});
-  fm->register_field(FR{fid2,SL{"output"}});
-  fm->register_field(FR{fid3,SL{"output"}});
-  fm->register_field(FR{fid4,SL{"output"}});
-  fm->register_field(FR{fid5,SL{"output"}});
+  fm->register_field(FR{fid1,SL{"output","RESTART"}});
+  fm->register_field(FR{fid2,SL{"output","RESTART"}});
+  fm->register_field(FR{fid3,SL{"output","RESTART"}});
+  fm->register_field(FR{fid4,SL{"output","RESTART"}});
+  fm->register_field(FR{fid5,SL{"output","RESTART"}});
   fm->registration_ends();
 
   // Initialize fields to -1.0, and set initial time stamp
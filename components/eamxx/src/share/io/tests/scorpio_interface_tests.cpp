@@ -3,6 +3,8 @@
 #include "share/io/scream_scorpio_interface.hpp"
 #include <ekat/util/ekat_string_utils.hpp>
 
+#include <cmath>
+
 namespace scream {
 
 using namespace scorpio;
@@ -210,4 +212,60 @@ TEST_CASE ("write_and_read") {
   finalize_subsystem ();
 }
 
+TEST_CASE ("quantization") {
+  ekat::Comm comm (MPI_COMM_WORLD);
+
+  init_subsystem (comm);
+
+  std::string filename = "scorpio_interface_quantization_test_np" + std::to_string(comm.size()) + ".nc";
+
+  const int dim1 = 100;
+  const int nsd  = 3;
+  const double fill_value = -999;
+
+  std::vector<double> data (dim1);
+  for (int i=0; i<dim1; ++i) {
+    data[i] = std::sqrt(i+1.0)*1000.0/3.0;
+  }
+  data[dim1/2] = fill_value;
+
+  // Write phase
+  {
+    register_file (filename,Write);
+    define_dim (filename,"dim1",dim1);
+    define_var (filename,"var_q",{"dim1"},"double",false);
+    define_var (filename,"var_d",{"dim1"},"double",false);
+    REQUIRE_THROWS (define_var_compression (filename,"var_d",10,true)); // ERROR: invalid deflate level
+    REQUIRE_THROWS (define_var_compression (filename,"var_d",1,true,{1,2})); // ERROR: chunk sizes mismatch var dims
+    define_var_compression (filename,"var_d",1,true,{dim1/2}); // No-op for non-NetCDF4 files
+    REQUIRE_THROWS (set_var_quantization (filename,"var_q",-1,fill_value)); // ERROR: negative nsd
+    set_var_quantization (filename,"var_q",nsd,fill_value);
+    enddef (filename);
+
+    write_var (filename,"var_q",data.data());
+    write_var (filename,"var_d",data.data());
+    release_file (filename);
+  }
+
+  // Read phase
+  {
+    std::vector<double> var_q (dim1), var_d (dim1);
+    read_var (filename,"var_q",var_q.data());
+    read_var (filename,"var_d",var_d.data());
+
+    // Non quantized data is exact, quantized data is within the precision
+    // of nsd digits, and fill values are preserved
+    REQUIRE (var_d==data);
+    REQUIRE (var_q[dim1/2]==fill_value);
+    bool any_rounded = false;
+    for (int i=0; i<dim1; ++i) {
+      REQUIRE (std::abs(var_q[i]-data[i])<=std::pow(10.0,-nsd)*std::abs(data[i]));
+      any_rounded |= var_q[i]!=data[i];
+    }
+    REQUIRE (any_rounded);
+  }
+
+  finalize_subsystem ();
+}
+
 } // namespace scream
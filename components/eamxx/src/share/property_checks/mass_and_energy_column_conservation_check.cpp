@@ -34,6 +34,8 @@ MassAndEnergyColumnConservationCheck (const std::shared_ptr<const AbstractGrid>&
 
   m_current_mass   = view_1d<Real> ("current_total_water",  m_num_cols);
   m_current_energy = view_1d<Real> ("current_total_energy", m_num_cols);
+  m_mass_error     = view_1d<Real> ("mass_relative_error",   m_num_cols);
+  m_energy_error   = view_1d<Real> ("energy_relative_error", m_num_cols);
 
   m_fields["pseudo_density"] = pseudo_density;
   m_fields["ps"]             = ps;
@@ -107,10 +109,21 @@ void MassAndEnergyColumnConservationCheck::compute_current_energy ()
   });
 }
 
-PropertyCheck::ResultAndMsg MassAndEnergyColumnConservationCheck::check() const
+void MassAndEnergyColumnConservationCheck::set_deferred_window (const int num_checks)
+{
+  EKAT_REQUIRE_MSG (num_checks>0,
+      "Error! Invalid window for deferred MassAndEnergyConservationCheck.\n"
+      "  - num checks: " + std::to_string(num_checks) + "\n");
+  m_deferred_window = num_checks;
+  m_num_deferred = 0;
+}
+
+void MassAndEnergyColumnConservationCheck::compute_column_errors (const bool reset) const
 {
   auto mass   = m_current_mass;
   auto energy = m_current_energy;
+  auto mass_error   = m_mass_error;
+  auto energy_error = m_energy_error;
   const auto ncols = m_num_cols;
   const auto nlevs = m_num_levs;
 
@@ -133,19 +146,13 @@ PropertyCheck::ResultAndMsg MassAndEnergyColumnConservationCheck::check() const
   const auto ice_flux   = m_fields.at("ice_flux"  ).get_view<const Real*>();
   const auto heat_flux  = m_fields.at("heat_flux" ).get_view<const Real*>();
 
-  // Use Kokkos::MaxLoc to find the largest error for both mass and energy
-  using maxloc_t = Kokkos::MaxLoc<Real, int>;
-  using maxloc_value_t = typename maxloc_t::value_type;
-  maxloc_value_t maxloc_mass;
-  maxloc_value_t maxloc_energy;
-
-  // Mass error calculation
   const auto policy = ExeSpaceUtils::get_default_team_policy(ncols, nlevs);
-  Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA (const KT::MemberType& team,
-                                                 maxloc_value_t&       result) {
+  Kokkos::parallel_for(policy, KOKKOS_LAMBDA (const KT::MemberType& team) {
     const int i = team.league_rank();
 
     const auto pseudo_density_i = ekat::subview(pseudo_density, i);
+    const auto T_mid_i          = ekat::subview(T_mid, i);
+    const auto horiz_winds_i    = ekat::subview(horiz_winds, i);
     const auto qv_i             = ekat::subview(qv, i);
     const auto qc_i             = ekat::subview(qc, i);
     const auto qi_i             = ekat::subview(qi, i);
@@ -162,29 +169,6 @@ PropertyCheck::ResultAndMsg MassAndEnergyColumnConservationCheck::check() const
     const Real tm_exp = previous_tm +
                         compute_mass_boundary_flux_on_column(vapor_flux(i), water_flux(i))*dt;
 
-    // Calculate relative error of total mass
-    const Real rel_err_mass = std::abs(tm-tm_exp)/previous_tm;
-
-    // Test relative error against current max value
-    if (rel_err_mass > result.val) {
-      result.val = rel_err_mass;
-      result.loc = i;
-    }
-  }, maxloc_t(maxloc_mass));
-
-  // Energy error calculation
-  Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA (const KT::MemberType& team,
-                                                 maxloc_value_t&       result) {
-
-    const int i = team.league_rank();
-
-    const auto pseudo_density_i = ekat::subview(pseudo_density, i);
-    const auto T_mid_i          = ekat::subview(T_mid, i);
-    const auto horiz_winds_i    = ekat::subview(horiz_winds, i);
-    const auto qv_i             = ekat::subview(qv, i);
-    const auto qc_i             = ekat::subview(qc, i);
-    const auto qr_i             = ekat::subview(qr, i);
-
     // Calculate total energy
     const Real te = compute_total_energy_on_column(team, nlevs, pseudo_density_i, T_mid_i, horiz_winds_i,
                                                    qv_i, qc_i, qr_i, ps(i), phis(i));
@@ -194,21 +178,64 @@ PropertyCheck::ResultAndMsg MassAndEnergyColumnConservationCheck::check() const
     const Real te_exp = previous_te +
                         compute_energy_boundary_flux_on_column(vapor_flux(i), water_flux(i), ice_flux(i), heat_flux(i))*dt;
 
-    // Calculate relative error of total energy
+    // Calculate relative errors, and keep the largest ones of the window
+    const Real rel_err_mass   = std::abs(tm-tm_exp)/previous_tm;
     const Real rel_err_energy = std::abs(te-te_exp)/previous_te;
+    Kokkos::single(Kokkos::PerTeam(team), [&] {
+      mass_error(i)   = reset ? rel_err_mass   : ekat::impl::max(mass_error(i),   rel_err_mass);
+      energy_error(i) = reset ? rel_err_energy : ekat::impl::max(energy_error(i), rel_err_energy);
+    });
+  });
+}
+
+PropertyCheck::ResultAndMsg MassAndEnergyColumnConservationCheck::check() const
+{
+  // The errors of each column are accumulated on device, and only looked at
+  // on host (with a global reduction) at the end of the window
+  compute_column_errors(m_num_deferred==0);
+  ++m_num_deferred;
 
-    // Test relative error against current max value
-    if (rel_err_energy > result.val) {
-      result.val = rel_err_energy;
+  PropertyCheck::ResultAndMsg res_and_msg;
+  if (m_num_deferred<m_deferred_window) {
+    res_and_msg.result = CheckResult::Pass;
+    return res_and_msg;
+  }
+  m_num_deferred = 0;
+
+  // Use Kokkos::MaxLoc to find the largest error for both mass and energy
+  using maxloc_t = Kokkos::MaxLoc<Real, int>;
+  using maxloc_value_t = typename maxloc_t::value_type;
+  maxloc_value_t maxloc_mass;
+  maxloc_value_t maxloc_energy;
+
+  const auto mass_error   = m_mass_error;
+  const auto energy_error = m_energy_error;
+  const auto policy = KT::RangePolicy(0, m_num_cols);
+  Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA (const int i, maxloc_value_t& result) {
+    if (mass_error(i) > result.val) {
+      result.val = mass_error(i);
+      result.loc = i;
+    }
+  }, maxloc_t(maxloc_mass));
+  Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA (const int i, maxloc_value_t& result) {
+    if (energy_error(i) > result.val) {
+      result.val = energy_error(i);
       result.loc = i;
     }
   }, maxloc_t(maxloc_energy));
 
+  // In deferred mode, also get the largest errors over all ranks, so that
+  // every rank can report them
+  Real global_max[2] = {maxloc_mass.val, maxloc_energy.val};
+  if (m_deferred_window>1) {
+    const Real local_max[2] = {maxloc_mass.val, maxloc_energy.val};
+    m_grid->get_comm().all_reduce(local_max,global_max,2,MPI_MAX);
+  }
+
   // Check if mass and/or energy values were below tolerance.
   const bool mass_below_tol   = (maxloc_mass.val   < m_mass_tol);
   const bool energy_below_tol = (maxloc_energy.val < m_energy_tol);
 
-  PropertyCheck::ResultAndMsg res_and_msg;
   if (mass_below_tol && energy_below_tol) {
     // If both vals are below the tolerance, the check passes.
     res_and_msg.result = CheckResult::Pass;
@@ -233,6 +260,11 @@ PropertyCheck::ResultAndMsg MassAndEnergyColumnConservationCheck::check() const
   std::stringstream msg;
   msg << "Check failed.\n"
       << "  - check name: " << this->name() << "\n";
+  if (m_deferred_window>1) {
+    msg << "  - largest errors over the last " << m_deferred_window << " checks\n"
+        << "  - mass relative error over all ranks: " << global_max[0] << "\n"
+        << "  - energy relative error over all ranks: " << global_max[1] << "\n";
+  }
   if (not mass_below_tol) {
     msg << "  - mass error tolerance: " << m_mass_tol << "\n";
     msg << "  - mass relative error: " << maxloc_mass.val << "\n"
@@ -52,8 +52,17 @@ public:
   PropertyType type () const override { return PropertyType::ColumnWise; }
 
   // Computes mass and energy and tests against a tolerance.
+  // In deferred mode, only every num_checks-th call looks at the errors (see below).
   ResultAndMsg check () const override;
 
+  // Defer the test over a window of num_checks calls to check(). The largest error
+  // of each column is accumulated on device, and tested (with a global reduction)
+  // only on the last call of the window, so that the other calls do not need to
+  // synchronize with the host. Failures report the largest errors of the window.
+  // num_checks=1 (the default) tests every call.
+  void set_deferred_window (const int num_checks);
+  int get_deferred_window () const { return m_deferred_window; }
+
   std::shared_ptr<const AbstractGrid> get_grid () const { return m_grid; }
 
   // Set the timestep for the process running the check. This
@@ -78,6 +87,10 @@ public:
   protected:
 #endif
 
+  // Compute the relative errors of each column, and store them (if reset=true),
+  // or their max with the stored errors (if reset=false).
+  void compute_column_errors (const bool reset) const;
+
   KOKKOS_INLINE_FUNCTION
   static Real compute_total_mass_on_column (const KT::MemberType&       team,
                                             const int                   nlevs,
@@ -124,6 +137,14 @@ protected:
   // should be updated before a process is run.
   view_1d<Real> m_current_energy;
   view_1d<Real> m_current_mass;
+
+  // Largest relative errors of each column over the current window
+  view_1d<Real> m_mass_error;
+  view_1d<Real> m_energy_error;
+
+  // Number of checks in a window, and number of checks done in the current one
+  int         m_deferred_window = 1;
+  mutable int m_num_deferred    = 0;
 }; // class EnergyConservationCheck
 
 } // namespace scream
@@ -49,6 +49,20 @@ enum class PropertyType {
   Global        // The property is computed globally
 };
 
+// Policy for how often the property checks of an atm process are run.
+// Checks run every 'frequency' steps. Batched checks (see PropertyCheckBatch)
+// only inspect one every 'column_stride' columns, rotating the subset each
+// time, so that all columns are inspected over 'column_stride' checks.
+// After a failure (or repair), checks run at every step on all columns
+// for the following 'escalation_steps' steps. If 'json_log_file' is not empty (or "none"),
+// failures are appended to that file (one JSON object per line, one file per rank).
+struct PropertyCheckPolicy {
+  int         frequency        = 1;
+  int         column_stride    = 1;
+  int         escalation_steps = 10;
+  std::string json_log_file;
+};
+
 class PropertyCheck {
 public:
 
@@ -0,0 +1,169 @@
+#include "share/property_checks/property_check_batch.hpp"
+#include "share/property_checks/field_nan_check.hpp"
+#include "share/property_checks/field_within_interval_check.hpp"
+
+#include <ekat/util/ekat_math_utils.hpp>
+
+namespace scream
+{
+
+namespace {
+
+// Finds the entry of the batch table that contains the input index of the
+// flattened index space of the table. Entries are sorted by offset, and have non-zero size.
+template<typename TableView>
+KOKKOS_INLINE_FUNCTION
+int find_batch_entry (const TableView& table, const int idx)
+{
+  int lo = 0;
+  int hi = table.extent_int(0)-1;
+  while (lo<hi) {
+    const int mid = (lo+hi+1)/2;
+    if (table(mid).offset<=idx) {
+      lo = mid;
+    } else {
+      hi = mid-1;
+    }
+  }
+  return lo;
+}
+
+} // anonymous namespace
+
+bool PropertyCheckBatch::add (const std::shared_ptr<PropertyCheck>& pc)
+{
+  const auto nan_check = std::dynamic_pointer_cast<const FieldNaNCheck>(pc);
+  const auto interval_check = std::dynamic_pointer_cast<const FieldWithinIntervalCheck>(pc);
+  if (nan_check==nullptr and interval_check==nullptr) {
+    return false;
+  }
+
+  const auto& f = pc->fields().front();
+  if (f.data_type()!=get_data_type<Real>()) {
+    return false;
+  }
+
+  EKAT_REQUIRE_MSG (m_check_pos.count(pc.get())==0,
+      "Error! Property check was already added to this batch.\n"
+      "  - PropertyCheck name: " + pc->name() + "\n");
+
+  const int pos = m_checks.size();
+  m_checks.push_back(pc);
+  m_check_pos[pc.get()] = pos;
+  m_passed.push_back(true);
+
+  const auto& layout = f.get_header().get_identifier().get_layout();
+  if (layout.size()>0) {
+    // Fuse this check with the entry of a previous check on the same field, if possible
+    int ientry = -1;
+    for (size_t i=0; i<m_entries.size(); ++i) {
+      if (m_entries_fields[i]==f) {
+        const auto& e = m_entries[i];
+        if ((nan_check and e.nan_check<0) or (interval_check and e.interval_check<0)) {
+          ientry = i;
+          break;
+        }
+      }
+    }
+
+    if (ientry==-1) {
+      ientry = m_entries.size();
+      auto& e = m_entries.emplace_back();
+      m_entries_fields.push_back(f);
+      e.offset = m_size;
+      e.rank = layout.rank();
+      e.col_size = layout.tag(0)==FieldTag::Column ? layout.size()/layout.dim(0) : -1;
+      e.nan_check = e.interval_check = -1;
+      e.lb = e.ub = 0;
+      for (int d=0; d<e.rank; ++d) {
+        e.extents[d] = layout.dim(d);
+      }
+      auto set_data = [&](const auto& v) {
+        e.data = v.data();
+        for (int d=0; d<e.rank; ++d) {
+          e.strides[d] = v.stride(d);
+        }
+      };
+      // We can't be sure the field has a contiguous allocation, so we use get_strided_view()
+      switch (e.rank) {
+        case 1: set_data(f.get_strided_view<const Real*>());      break;
+        case 2: set_data(f.get_strided_view<const Real**>());     break;
+        case 3: set_data(f.get_strided_view<const Real***>());    break;
+        case 4: set_data(f.get_strided_view<const Real****>());   break;
+        case 5: set_data(f.get_strided_view<const Real*****>());  break;
+        case 6: set_data(f.get_strided_view<const Real******>()); break;
+        default:
+          EKAT_ERROR_MSG ("Error! Field rank (" + std::to_string(e.rank) + ") not supported by PropertyCheckBatch.\n");
+      }
+      m_size += layout.size();
+    }
+
+    auto& e = m_entries[ientry];
+    if (nan_check) {
+      e.nan_check = pos;
+    } else {
+      e.interval_check = pos;
+      e.lb = interval_check->lower_bound();
+      e.ub = interval_check->upper_bound();
+    }
+  }
+
+  // Update device structures
+  m_table = KT::view_1d<Entry>("property_check_batch_table",m_entries.size());
+  auto table_h = Kokkos::create_mirror_view(m_table);
+  std::copy(m_entries.begin(),m_entries.end(),table_h.data());
+  Kokkos::deep_copy(m_table,table_h);
+
+  m_fail_bitmap = KT::view_1d<unsigned>("property_check_batch_fail_bitmap",(m_checks.size()+31)/32);
+
+  return true;
+}
+
+void PropertyCheckBatch::run (const int col_stride, const int col_phase)
+{
+  EKAT_REQUIRE_MSG (col_stride>0 and col_phase>=0 and col_phase<col_stride,
+      "Error! Invalid column sampling for PropertyCheckBatch.\n"
+      "  - column stride: " + std::to_string(col_stride) + "\n"
+      "  - column phase : " + std::to_string(col_phase) + "\n");
+
+  if (m_size==0) {
+    return;
+  }
+
+  Kokkos::deep_copy(m_fail_bitmap,0);
+
+  auto table  = m_table;
+  auto bitmap = m_fail_bitmap;
+  auto set_fail = KOKKOS_LAMBDA (const int pos) {
+    Kokkos::atomic_fetch_or(&bitmap(pos/32),1u<<(pos%32));
+  };
+  KT::RangePolicy policy(0,m_size);
+  Kokkos::parallel_for("PropertyCheckBatch::run",policy,KOKKOS_LAMBDA(const int idx) {
+    const auto& e = table(find_batch_entry(table,idx));
+    const int i = idx-e.offset;
+    if (col_stride>1 and e.col_size>0 and (i/e.col_size)%col_stride!=col_phase) {
+      return;
+    }
+    const Real v = e.data[e.data_offset(i)];
+    if (e.nan_check>=0 and ekat::is_invalid(v)) {
+      set_fail(e.nan_check);
+    }
+    if (e.interval_check>=0 and (v<e.lb or v>e.ub)) {
+      set_fail(e.interval_check);
+    }
+  });
+
+  auto bitmap_h = Kokkos::create_mirror_view(m_fail_bitmap);
+  Kokkos::deep_copy(bitmap_h,m_fail_bitmap);
+  for (size_t pos=0; pos<m_checks.size(); ++pos) {
+    m_passed[pos] = ((bitmap_h(pos/32) >> (pos%32)) & 1u)==0;
+  }
+}
+
+bool PropertyCheckBatch::passed (const PropertyCheck& pc) const
+{
+  auto it = m_check_pos.find(&pc);
+  return it!=m_check_pos.end() and m_passed[it->second];
+}
+
+} // namespace scream
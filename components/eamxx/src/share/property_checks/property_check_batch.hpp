@@ -0,0 +1,87 @@
+#ifndef SCREAM_PROPERTY_CHECK_BATCH_HPP
+#define SCREAM_PROPERTY_CHECK_BATCH_HPP
+
+#include "share/property_checks/property_check.hpp"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace scream
+{
+
+/*
+ * A batch of pointwise property checks, evaluated in a single kernel
+ *
+ * The batch accepts NaN checks and interval checks (including lower/upper
+ * bound checks) on Real fields. All the accepted checks are evaluated at once,
+ * over the flattened index space of all the fields involved. If a field has
+ * both a NaN and an interval check, the two are fused, so that each entry
+ * of the field is read only once.
+ *
+ * The kernel only produces a (device) bitmap of the checks that did not pass,
+ * which is copied to host. Checks that did not pass must then be run individually
+ * by the caller, via PropertyCheck::check(), to establish whether they are
+ * repairable, and to get the failure location and diagnostic message. This way,
+ * in the (common) case where all checks pass, we only launch one kernel.
+ */
+
+class PropertyCheckBatch {
+public:
+  using KT = KokkosTypes<DefaultDevice>;
+
+  // Add a check to the batch. Returns false if the check cannot be batched,
+  // in which case the caller must run it separately.
+  bool add (const std::shared_ptr<PropertyCheck>& pc);
+
+  int num_checks () const { return m_checks.size(); }
+
+  // Evaluate all checks in the batch. For fields with a COL dimension, only
+  // the columns icol with icol%col_stride==col_phase are inspected.
+  void run (const int col_stride = 1, const int col_phase = 0);
+
+  // Whether the input check is in the batch and passed during the last call to run()
+  bool passed (const PropertyCheck& pc) const;
+
+  // An entry of the batch table: a field, with the checks to run on it
+  struct Entry {
+    const Real* data;
+    int         offset;
+    int         col_size;         // Size of a column of the field (-1 if the field has no COL dim)
+    int         rank;
+    int         extents[Field::MaxRank];
+    int         strides[Field::MaxRank];
+    int         nan_check;        // Position of the NaN check in the batch (-1 if none)
+    int         interval_check;   // Position of the interval check in the batch (-1 if none)
+    double      lb, ub;
+
+    // Offset in data of the i-th entry of the field (in LayoutRight order)
+    KOKKOS_INLINE_FUNCTION
+    int data_offset (int i) const {
+      int off = 0;
+      for (int d=rank-1; d>=0; --d) {
+        off += (i % extents[d])*strides[d];
+        i /= extents[d];
+      }
+      return off;
+    }
+  };
+
+protected:
+
+  std::vector<std::shared_ptr<PropertyCheck>>   m_checks;
+  std::map<const PropertyCheck*,int>            m_check_pos;
+  std::vector<bool>                             m_passed;
+
+  // Host copy of the table, and the fields of each entry
+  std::vector<Entry>                            m_entries;
+  std::vector<Field>                            m_entries_fields;
+  int                                           m_size = 0;
+
+  KT::view_1d<Entry>                            m_table;
+  KT::view_1d<unsigned>                         m_fail_bitmap;
+};
+
+} // namespace scream
+
+#endif // SCREAM_PROPERTY_CHECK_BATCH_HPP
@@ -310,7 +310,8 @@ public:
   AddOne (const ekat::Comm& comm,const ekat::ParameterList& params)
    : DummyProcess(comm,params)
   {
-    // Nothing to do here
+    m_field_name = params.get<std::string>("Field Name","Field A");
+    m_buffer_bytes = params.get<int>("Buffer Bytes",0);
   }
 
   // The type of the atm proc
@@ -322,16 +323,30 @@ public:
     const auto grid = gm->get_grid(m_grid_name);
     const auto lt = grid->get_2d_scalar_layout ();
 
-    add_field<Updated>("Field A",lt,K,m_grid_name);
+    add_field<Updated>(m_field_name,lt,K,m_grid_name);
+  }
+
+  size_t requested_buffer_size_in_bytes () const { return m_buffer_bytes; }
+  void init_buffers (const ATMBufferManager& buffer_manager) {
+    REQUIRE (buffer_manager.allocated_bytes()>=requested_buffer_size_in_bytes());
+    m_buffer = buffer_manager.get_memory();
   }
+  const Real* get_buffer () const { return m_buffer; }
 protected:
     void run_impl (const double /* dt */) {
-    auto v = get_field_out("Field A", m_grid_name).get_view<Real*,Host>();
+    auto f = get_field_out(m_field_name, m_grid_name);
+    auto v = f.get_view<Real*,Host>();
 
+    f.sync_to_host();
     for (int i=0; i<v.extent_int(0); ++i) {
       v[i] += Real(1.0);
     }
+    f.sync_to_dev();
   }
+
+  std::string m_field_name;
+  size_t      m_buffer_bytes;
+  const Real* m_buffer = nullptr;
 };
 
 // ================================ TESTS ============================== //
@@ -582,6 +597,163 @@ TEST_CASE ("subcycling") {
   }
 }
 
+TEST_CASE ("group_schedules") {
+  using namespace scream;
+  using strvec_t = std::vector<std::string>;
+
+  // A world comm
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  // A time stamp
+  util::TimeStamp t0 ({2022,1,1},{0,0,0});
+
+  // Create a grids manager
+  auto gm = create_gm(comm);
+
+  auto& factory = AtmosphereProcessFactory::instance();
+  factory.register_product("AddOne",&create_atmosphere_process<AddOne>);
+
+  // A group of processes, each adding one to a field. The processes are
+  // independent if they update different fields.
+  auto create_group = [&](const std::string& schedule_type,
+                          const strvec_t& field_names,
+                          const bool async = false,
+                          const bool lagged = false) {
+    ekat::ParameterList params ("Test Group");
+    params.set<std::string>("schedule_type",schedule_type);
+    params.set<bool>("enable_async_scheduling",async);
+    params.set<bool>("lagged_coupling",lagged);
+    strvec_t procs;
+    for (size_t i=0; i<field_names.size(); ++i) {
+      procs.push_back("AddOne" + std::to_string(i));
+      auto& p = params.sublist(procs.back());
+      p.set<std::string>("Type", "AddOne");
+      p.set<std::string>("Grid Name", "Point Grid");
+      p.set<std::string>("Field Name", field_names[i]);
+      p.set<int>("Buffer Bytes", 96);
+    }
+    params.set<strvec_t>("atm_procs_list",procs);
+
+    auto group = std::make_shared<AtmosphereProcessGroup>(comm,params);
+    group->set_grids(gm);
+
+    // Create the fields and set them in the group
+    std::map<std::string,Field> fields;
+    for (const auto& req : group->get_required_field_requests()) {
+      auto& f = fields[req.fid.name()];
+      if (not f.is_allocated()) {
+        f = Field(req.fid);
+        f.allocate_view();
+        f.deep_copy(0);
+        f.get_header().get_tracking().update_time_stamp(t0);
+      }
+      group->set_required_field(f.get_const());
+    }
+    for (const auto& req : group->get_computed_field_requests()) {
+      group->set_computed_field(fields.at(req.fid.name()));
+    }
+    return std::make_pair(group,fields);
+  };
+
+  SECTION ("independent") {
+    auto group_and_fields = create_group("Parallel",{"Field A","Field B"});
+    auto group  = group_and_fields.first;
+    auto fields = group_and_fields.second;
+    REQUIRE (group->get_schedule_type()==ScheduleType::Parallel);
+
+    group->initialize(t0,RunType::Initial);
+    group->run(1);
+    group->run(1);
+
+    // Each process must have run once per step on its own field
+    for (const auto& name : {"Field A", "Field B"}) {
+      auto v = fields.at(name).get_view<const Real*,Host>();
+      for (size_t i=0; i<v.size(); ++i) {
+        REQUIRE (v[i]==2);
+      }
+    }
+  }
+
+  SECTION ("dependent") {
+    // Both processes update Field A, which a parallel group cannot do
+    auto group = create_group("Parallel",{"Field A","Field A"}).first;
+    REQUIRE_THROWS (group->initialize(t0,RunType::Initial));
+  }
+
+  SECTION ("lagged") {
+    // With lagged coupling, both processes start from the same state,
+    // and both increments end up in Field A
+    auto group_and_fields = create_group("Parallel",{"Field A","Field A","Field B"},false,true);
+    auto group  = group_and_fields.first;
+    auto fields = group_and_fields.second;
+
+    group->initialize(t0,RunType::Initial);
+    group->run(1);
+    group->run(1);
+
+    fields.at("Field A").sync_to_host();
+    fields.at("Field B").sync_to_host();
+    auto v_A = fields.at("Field A").get_view<const Real*,Host>();
+    auto v_B = fields.at("Field B").get_view<const Real*,Host>();
+    for (size_t i=0; i<v_A.size(); ++i) {
+      REQUIRE (v_A[i]==4);
+      REQUIRE (v_B[i]==2);
+    }
+  }
+
+  SECTION ("buffers") {
+    // Processes that may run concurrently must get disjoint buffer regions,
+    // while the others share the same region
+    const size_t region_size = ATMBufferManager::align_bytes(96);
+    auto get_buffer = [](const std::shared_ptr<AtmosphereProcessGroup>& group, const int i) {
+      return std::dynamic_pointer_cast<const AddOne>(group->get_process(i))->get_buffer();
+    };
+    auto init_buffers = [](const std::shared_ptr<AtmosphereProcessGroup>& group) {
+      ATMBufferManager buffer_manager;
+      buffer_manager.request_bytes(group->requested_buffer_size_in_bytes());
+      buffer_manager.allocate();
+      group->init_buffers(buffer_manager);
+      return buffer_manager;
+    };
+
+    auto seq = create_group("Sequential",{"Field A","Field B"}).first;
+    REQUIRE (seq->requested_buffer_size_in_bytes()==region_size);
+    auto seq_bm = init_buffers(seq);
+    REQUIRE (get_buffer(seq,0)==get_buffer(seq,1));
+
+    auto par = create_group("Parallel",{"Field A","Field B"}).first;
+    REQUIRE (par->requested_buffer_size_in_bytes()==2*region_size);
+    auto par_bm = init_buffers(par);
+    REQUIRE (get_buffer(par,1)-get_buffer(par,0)==static_cast<long>(region_size/sizeof(Real)));
+
+    // The first and last processes run on the same instance, the second one on its own
+    auto async = create_group("Sequential",{"Field A","Field B","Field A"},true).first;
+    REQUIRE (async->requested_buffer_size_in_bytes()==2*region_size);
+    auto async_bm = init_buffers(async);
+    REQUIRE (get_buffer(async,0)==get_buffer(async,2));
+    REQUIRE (get_buffer(async,0)!=get_buffer(async,1));
+  }
+
+  SECTION ("async_sequential") {
+    // The second process is independent of the first one, while the third
+    // one updates the field of the first one after it
+    auto group_and_fields = create_group("Sequential",{"Field A","Field B","Field A"},true);
+    auto group  = group_and_fields.first;
+    auto fields = group_and_fields.second;
+    REQUIRE (group->get_schedule_type()==ScheduleType::Sequential);
+
+    group->initialize(t0,RunType::Initial);
+    group->run(1);
+
+    auto v_A = fields.at("Field A").get_view<const Real*,Host>();
+    auto v_B = fields.at("Field B").get_view<const Real*,Host>();
+    for (size_t i=0; i<v_A.size(); ++i) {
+      REQUIRE (v_A[i]==2);
+      REQUIRE (v_B[i]==1);
+    }
+  }
+}
+
 TEST_CASE ("diagnostics") {
 
   //TODO: This test needs a field manager so that changes in Field A are seen everywhere.
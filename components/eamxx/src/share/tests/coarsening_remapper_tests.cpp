@@ -498,6 +498,38 @@ TEST_CASE("coarsening_remap")
     }
   }
 
+  // The fused remap must give the same results as the field-by-field one
+  {
+    root_print (" -> Checking fused remap ...\n",comm);
+    std::vector<Field> tgt_f_ref;
+    for (const auto& f : tgt_f) {
+      tgt_f_ref.push_back(f.clone());
+      f.deep_copy(Real(-1));
+    }
+    remap->set_fused_remap(true);
+    remap->remap(true);
+    for (size_t ifield=0; ifield<tgt_f.size(); ++ifield) {
+      REQUIRE (views_are_equal(tgt_f[ifield],tgt_f_ref[ifield]));
+    }
+    remap->set_fused_remap(false);
+    root_print (" -> Checking fused remap ... PASS\n",comm);
+  }
+
+  // A remapper with the same map file and fine grid reuses the remap data
+  {
+    auto& repo = HorizRemapperDataRepo::instance();
+    auto remap2 = std::make_shared<CoarseningRemapperTester>(src_grid,filename);
+    REQUIRE (repo.num_entries()==1);
+    REQUIRE (remap2->get_weights().data()==remap->get_weights().data());
+    REQUIRE (remap2->get_ov_tgt_grid()->get_num_local_dofs()==remap->get_ov_tgt_grid()->get_num_local_dofs());
+
+    // The data is released when the last remapper using it is destroyed
+    remap2 = nullptr;
+    REQUIRE (repo.num_entries()==1);
+    remap = nullptr;
+    REQUIRE (repo.num_entries()==0);
+  }
+
   // Clean up scorpio stuff
   scorpio::finalize_subsystem();
 }
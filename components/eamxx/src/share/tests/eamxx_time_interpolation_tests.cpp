@@ -171,14 +171,19 @@ TEST_CASE ("eamxx_time_interpolation_data_from_file") {
   printf(  "Constructing a time interpolation object ...\n");
   util::TimeInterpolation time_interpolator(grid,list_of_files);
   util::TimeInterpolation time_interpolator_deep(grid,list_of_files);
+  // An interpolator prefetching one field at a time, which should give the same answers
+  util::TimeInterpolation time_interpolator_prefetch(grid,list_of_files);
+  time_interpolator_prefetch.set_prefetch(1);
   for (auto name : fnames) {
     auto ff      = fields_man_t0->get_field(name);
     auto ff_deep = fields_man_deep->get_field(name);
     time_interpolator.add_field(ff);
     time_interpolator_deep.add_field(ff_deep,true);
+    time_interpolator_prefetch.add_field(ff);
   }
   time_interpolator.initialize_data_from_files();
   time_interpolator_deep.initialize_data_from_files();
+  time_interpolator_prefetch.initialize_data_from_files();
   printf(  "Constructing a time interpolation object ... DONE\n");
 
   // Now check that the interpolator is working as expected.  Should be able to
@@ -209,6 +214,7 @@ TEST_CASE ("eamxx_time_interpolation_data_from_file") {
     }
     time_interpolator.perform_time_interpolation(ts);
     time_interpolator_deep.perform_time_interpolation(ts);
+    time_interpolator_prefetch.perform_time_interpolation(ts);
     // Now compare the interp_fields to the fields in the field manager which should be updated.
     for (auto name : fnames) {
       auto field      = fields_man_t0->get_field(name);
@@ -219,6 +225,8 @@ TEST_CASE ("eamxx_time_interpolation_data_from_file") {
       REQUIRE(views_are_equal(field_deep,time_interpolator_deep.get_field(name)));
       // Check that the deep and shallow fields match showing that both approaches got the correct answer.
       REQUIRE(views_are_equal(field,field_deep));
+      // Check that prefetching data does not change the answers
+      REQUIRE(views_are_equal(time_interpolator.get_field(name),time_interpolator_prefetch.get_field(name)));
     }
 
   }
@@ -226,6 +234,7 @@ TEST_CASE ("eamxx_time_interpolation_data_from_file") {
 
   time_interpolator.finalize();
   time_interpolator_deep.finalize();
+  time_interpolator_prefetch.finalize();
   printf("                        ... DONE\n");
 
   // All done with IO
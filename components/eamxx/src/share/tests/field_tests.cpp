@@ -6,6 +6,7 @@
 #include "share/field/field_header.hpp"
 #include "share/field/field.hpp"
 #include "share/field/field_manager.hpp"
+#include "share/field/field_memory_pool.hpp"
 #include "share/field/field_utils.hpp"
 #include "share/util/scream_setup_random_test.hpp"
 
@@ -886,4 +887,121 @@ TEST_CASE ("sync_subfields") {
   }
 }
 
+TEST_CASE ("field_memory_pool") {
+  using namespace scream;
+  using namespace ekat::units;
+  using namespace ShortFieldTagsNames;
+  using FID = FieldIdentifier;
+  using FL  = FieldLayout;
+
+  constexpr int ncols = 10;
+  constexpr int nlevs = 8;
+
+  FID fid1 ("f1",FL({COL,LEV},{ncols,nlevs}),m,"some_grid");
+  FID fid2 ("f2",FL({COL,LEV},{ncols,nlevs}),m,"some_grid");
+  FID fid3 ("f3",FL({COL},{ncols}),m,"some_grid");
+
+  auto& pool = FieldMemoryPool::instance();
+  REQUIRE_THROWS (pool.close_group());
+
+  // Fields in the same group do not share storage
+  pool.open_group();
+  REQUIRE_THROWS (pool.open_group());
+  Field f1(fid1), f3(fid3);
+  f1.allocate_view();
+  f3.allocate_view();
+  Field f4(fid1);
+  {
+    FieldMemoryPool::Suspend no_pool;
+    f4.allocate_view();
+  }
+  pool.close_group();
+  REQUIRE (f1.get_internal_view_data<Real>()!=f3.get_internal_view_data<Real>());
+  const auto alloc_bytes = pool.allocated_bytes();
+
+  // Fields in different groups share storage, if they land in the same bucket
+  pool.open_group();
+  Field f2(fid2);
+  f2.allocate_view();
+  pool.close_group();
+  REQUIRE (f1.get_internal_view_data<Real>()==f2.get_internal_view_data<Real>());
+  REQUIRE (pool.allocated_bytes()==alloc_bytes);
+  REQUIRE (pool.requested_bytes()>alloc_bytes);
+
+  // Suspended allocations do not use the pool
+  REQUIRE (f4.get_internal_view_data<Real>()!=f1.get_internal_view_data<Real>());
+
+  // Outside of groups, fields get their own storage
+  Field f5(fid1);
+  f5.allocate_view();
+  REQUIRE (f5.get_internal_view_data<Real>()!=f1.get_internal_view_data<Real>());
+
+  // Pooled fields are usable as any other field
+  f1.deep_copy(1.0);
+  f5.deep_copy(1.0);
+  REQUIRE (views_are_equal(f2,f5));
+
+  pool.clean_up();
+  REQUIRE (pool.allocated_bytes()==0);
+}
+
+TEST_CASE ("field_alloc_policy") {
+  using namespace scream;
+  using namespace ekat::units;
+  using namespace ShortFieldTagsNames;
+  using FID = FieldIdentifier;
+  using FL  = FieldLayout;
+
+  constexpr int ncols = 3;
+  constexpr int nlevs = 13;
+
+  FID fid_mid ("f_mid",FL({COL,LEV},{ncols,nlevs}),m,"some_grid");
+  FID fid_cmp ("f_cmp",FL({COL,CMP},{ncols,nlevs}),m,"some_grid");
+
+  // The last extent accommodates all requested pack sizes, not just the largest
+  {
+    Field f(fid_mid);
+    f.get_header().get_alloc_properties().request_allocation(4);
+    f.get_header().get_alloc_properties().request_allocation(6);
+    f.allocate_view();
+    const auto& fap = f.get_header().get_alloc_properties();
+    REQUIRE (fap.get_last_extent()==24);
+    REQUIRE (fap.is_compatible<ekat::Pack<Real,4>>());
+    REQUIRE (fap.is_compatible<ekat::Pack<Real,6>>());
+  }
+
+  // The default pack size only applies to fields with a vertical last dimension
+  FieldAllocPolicy policy;
+  policy.default_pack_size = 8;
+  set_field_alloc_policy(policy);
+  {
+    Field f_mid(fid_mid), f_cmp(fid_cmp);
+    f_mid.allocate_view();
+    f_cmp.allocate_view();
+    REQUIRE (f_mid.get_header().get_alloc_properties().get_last_extent()==16);
+    REQUIRE (f_mid.get_header().get_alloc_properties().get_largest_pack_size()==8);
+    REQUIRE (f_cmp.get_header().get_alloc_properties().get_last_extent()==nlevs);
+    REQUIRE_NOTHROW (f_mid.get_view<ekat::Pack<Real,8>**>());
+  }
+
+  // Rows are padded to start on the requested alignment
+  policy.default_pack_size = 1;
+  policy.row_alignment = 64;
+  set_field_alloc_policy(policy);
+  {
+    Field f(fid_cmp);
+    f.allocate_view();
+    const int align_len = 64/sizeof(Real);
+    const auto last_extent = f.get_header().get_alloc_properties().get_last_extent();
+    REQUIRE (last_extent%align_len==0);
+    REQUIRE (last_extent>=nlevs);
+  }
+
+  policy.default_pack_size = 0;
+  REQUIRE_THROWS (set_field_alloc_policy(policy));
+
+  // Restore the default policy
+  set_field_alloc_policy(FieldAllocPolicy());
+}
+
 } // anonymous namespace
@@ -5,6 +5,8 @@
 #include "share/property_checks/field_lower_bound_check.hpp"
 #include "share/property_checks/field_upper_bound_check.hpp"
 #include "share/property_checks/field_nan_check.hpp"
+#include "share/property_checks/property_check_batch.hpp"
+#include "share/property_checks/mass_and_energy_column_conservation_check.hpp"
 #include "share/util/scream_setup_random_test.hpp"
 #include "share/grid/point_grid.hpp"
 #include "share/field/field_utils.hpp"
@@ -311,6 +313,129 @@ TEST_CASE("property_checks", "") {
       REQUIRE(f_data[i] == 1.0);
     }
   }
+
+  // Check that a batch of checks flags exactly the checks that do not pass
+  SECTION ("property_check_batch") {
+    FieldIdentifier fid2 ("field_2", {{COL},{num_lcols}}, m/s,"some_grid");
+    Field f2(fid2);
+    f2.allocate_view();
+
+    auto nan_check   = std::make_shared<FieldNaNCheck>(f,grid);
+    auto lb_check    = std::make_shared<FieldLowerBoundCheck>(f,grid,-1.0);
+    auto ub_check2   = std::make_shared<FieldUpperBoundCheck>(f2,grid,1.0);
+    auto nan_check2  = std::make_shared<FieldNaNCheck>(f2,grid);
+
+    PropertyCheckBatch batch;
+    REQUIRE (batch.add(nan_check));
+    REQUIRE (batch.add(lb_check));
+    REQUIRE (batch.add(ub_check2));
+    REQUIRE (batch.add(nan_check2));
+    REQUIRE (batch.num_checks()==4);
+    REQUIRE_THROWS (batch.add(nan_check));
+
+    f.deep_copy(0.5);
+    f2.deep_copy(0.5);
+    batch.run();
+    for (auto pc : {nan_check,nan_check2}) {
+      REQUIRE (batch.passed(*pc));
+    }
+    REQUIRE (batch.passed(*lb_check));
+    REQUIRE (batch.passed(*ub_check2));
+
+    // Break the lower bound of f and the upper bound of f2
+    auto f_view  = f.get_strided_view<Real***,Host>();
+    auto f2_view = f2.get_strided_view<Real*,Host>();
+    f_view(1,2,3) = -2.0;
+    f2_view(0) = 2.0;
+    f.sync_to_dev();
+    f2.sync_to_dev();
+    batch.run();
+    REQUIRE (batch.passed(*nan_check));
+    REQUIRE (batch.passed(*nan_check2));
+    REQUIRE (not batch.passed(*lb_check));
+    REQUIRE (not batch.passed(*ub_check2));
+
+    // Results must match the individual checks
+    REQUIRE (lb_check->check().result==CheckResult::Fail);
+    REQUIRE (ub_check2->check().result==CheckResult::Fail);
+
+    // With column sampling, only the selected columns of f2 are inspected,
+    // while f (which has no COL dim) is always inspected entirely
+    REQUIRE_THROWS (batch.run(2,2));
+    batch.run(2,1);
+    REQUIRE (not batch.passed(*lb_check));
+    REQUIRE (batch.passed(*ub_check2));
+    batch.run(2,0);
+    REQUIRE (not batch.passed(*lb_check));
+    REQUIRE (not batch.passed(*ub_check2));
+
+    // Now put a NaN in f
+    f_view(0,0,0) = std::numeric_limits<Real>::quiet_NaN();
+    f.sync_to_dev();
+    batch.run();
+    REQUIRE (not batch.passed(*nan_check));
+    REQUIRE (batch.passed(*nan_check2));
+    REQUIRE (nan_check->check().result==CheckResult::Fail);
+  }
+
+  SECTION ("mass_and_energy_column_conservation_check_deferred") {
+    auto create_field = [&](const std::string& name, const FieldLayout& fl, const Real val) {
+      Field fld(FieldIdentifier(name,fl,units,grid->name()));
+      fld.allocate_view();
+      fld.deep_copy(val);
+      return fld;
+    };
+    const auto layout_mid = grid->get_3d_scalar_layout(true);
+    auto qv = create_field("qv",layout_mid,1e-3);
+    auto check = std::make_shared<MassAndEnergyColumnConservationCheck>(
+        grid, 1e-10, 1e-14,
+        create_field("pseudo_density",layout_mid,1.0),
+        create_field("ps",layout,1e5),
+        create_field("phis",layout,0),
+        create_field("horiz_winds",grid->get_3d_vector_layout(true,2),0),
+        create_field("T_mid",layout_mid,300),
+        qv,
+        create_field("qc",layout_mid,1e-4),
+        create_field("qr",layout_mid,1e-4),
+        create_field("qi",layout_mid,1e-4),
+        create_field("vapor_flux",layout,0),
+        create_field("water_flux",layout,0),
+        create_field("ice_flux",layout,0),
+        create_field("heat_flux",layout,0));
+    check->set_dt(1);
+    REQUIRE_THROWS (check->set_deferred_window(0));
+
+    auto qv_view = qv.get_view<Real**,Host>();
+    auto run_check = [&](const bool perturb) {
+      check->compute_current_mass();
+      check->compute_current_energy();
+      if (perturb) {
+        qv_view(1,0) = 2e-3;
+        qv.sync_to_dev();
+      }
+      auto res = check->check();
+      if (perturb) {
+        qv_view(1,0) = 1e-3;
+        qv.sync_to_dev();
+      }
+      return res.result;
+    };
+
+    // Without deferral, every check is tested
+    REQUIRE (run_check(false)==CheckResult::Pass);
+    REQUIRE (run_check(true)==CheckResult::Fail);
+
+    // With deferral, a failure is only reported at the end of the window
+    check->set_deferred_window(3);
+    REQUIRE (run_check(true)==CheckResult::Pass);
+    REQUIRE (run_check(false)==CheckResult::Pass);
+    REQUIRE (run_check(false)==CheckResult::Fail);
+
+    // The errors are reset after each window
+    for (int i=0; i<3; ++i) {
+      REQUIRE (run_check(false)==CheckResult::Pass);
+    }
+  }
 }
 
 } // anonymous namespace
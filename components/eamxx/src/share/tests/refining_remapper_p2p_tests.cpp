@@ -229,6 +229,29 @@ TEST_CASE ("refining_remapper") {
   CHECK_THROWS (r->remap(false)); // No backward remap
   r->remap(true);
 
+  // Remapping with neighborhood collectives must give the same result
+  {
+    auto rn = std::make_shared<RefiningRemapperP2PTester>(tgt_grid,filename);
+    rn->set_use_neighbor_collectives(true);
+
+    auto s2d_tgt_n = s2d_tgt.clone();
+    auto v2d_tgt_n = v2d_tgt.clone();
+    auto s3d_tgt_n = s3d_tgt.clone();
+    auto v3d_tgt_n = v3d_tgt.clone();
+    rn->registration_begins();
+    rn->register_field(s2d_src,s2d_tgt_n);
+    rn->register_field(v2d_src,v2d_tgt_n);
+    rn->register_field(s3d_src,s3d_tgt_n);
+    rn->register_field(v3d_src,v3d_tgt_n);
+    rn->registration_ends();
+    rn->remap(true);
+
+    REQUIRE (views_are_equal(s2d_tgt,s2d_tgt_n));
+    REQUIRE (views_are_equal(v2d_tgt,v2d_tgt_n));
+    REQUIRE (views_are_equal(s3d_tgt,s3d_tgt_n));
+    REQUIRE (views_are_equal(v3d_tgt,v3d_tgt_n));
+  }
+
   // Gather global copies (to make checks easier) and check src/tgt fields
   auto gs2d_src = all_gather_field(s2d_src,comm);
   auto gv2d_src = all_gather_field(v2d_src,comm);
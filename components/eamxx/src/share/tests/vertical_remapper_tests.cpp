@@ -277,8 +277,14 @@ TEST_CASE ("vertical_remap") {
   // No bwd remap
   REQUIRE_THROWS(remap->remap(false));
 
-  for (int irun=0; irun<5; ++irun) {
-    print (" -> run remap ...\n",comm);
+  // Run both the per-field and the fused interpolation
+  for (int irun=0; irun<6; ++irun) {
+    const bool fused = irun%2==1;
+    remap->set_fused_remap(fused);
+    for (const auto& f : tgt_f) {
+      f.deep_copy(0);
+    }
+    print (std::string(" -> run remap") + (fused ? " (fused)" : "") + " ...\n",comm);
     remap->remap(true);
     print (" -> run remap ... done!\n",comm);
 
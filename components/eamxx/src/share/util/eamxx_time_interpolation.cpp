@@ -1,6 +1,11 @@
 #include "share/util/eamxx_time_interpolation.hpp"
 #include "share/io/scream_scorpio_interface.hpp"
 #include "share/io/scream_io_utils.hpp"
+#include "share/util/scream_universal_constants.hpp"
+
+#include <ekat/std_meta/ekat_std_utils.hpp>
+
+#include <algorithm>
 
 namespace scream{
 namespace util {
@@ -14,10 +19,13 @@ TimeInterpolation::TimeInterpolation(
   // Given the grid initialize field managers to store interpolation data
   m_fm_time0 = std::make_shared<FieldManager>(grid);
   m_fm_time1 = std::make_shared<FieldManager>(grid);
+  m_fm_time2 = std::make_shared<FieldManager>(grid);
   m_fm_time0->registration_begins();
   m_fm_time0->registration_ends();
   m_fm_time1->registration_begins();
   m_fm_time1->registration_ends();
+  m_fm_time2->registration_begins();
+  m_fm_time2->registration_ends();
 }
 /*-----------------------------------------------------------------------------------------------*/
 TimeInterpolation::TimeInterpolation(
@@ -33,6 +41,7 @@ void TimeInterpolation::finalize()
 {
   if (m_is_data_from_file) {
     m_file_data_atm_input = nullptr;
+    m_prefetch_atm_input = nullptr;
     m_is_data_from_file = false;
   }
 }
@@ -56,6 +65,9 @@ void TimeInterpolation::perform_time_interpolation(const TimeStamp& time_in)
   // If data is handled by files we need to check that the timestamps are still relevant
   if (m_file_data_triplets.size()>0) {
     check_and_update_data(time_in);
+    if (m_prefetch_fields_per_call>0) {
+      advance_prefetch(m_prefetch_fields_per_call);
+    }
   }
 
   // Gather weights for interpolation.  Note, timestamp differences are integers and we need a
@@ -65,9 +77,18 @@ void TimeInterpolation::perform_time_interpolation(const TimeStamp& time_in)
   const Real weight0 = w_num/w_den;
   const Real weight1 = 1.0-weight0;
 
-  // Cycle through all stored fields and conduct the time interpolation
+  // Interpolate all the fused fields at once
+  if (m_fused_names.size()>0) {
+    update_fused_table();
+    interpolate_fused_fields(weight0,weight1);
+  }
+
+  // Cycle through all remaining fields and conduct the time interpolation
   for (auto name : m_field_names)
   {
+    if (ekat::contains(m_fused_names,name)) {
+      continue;
+    }
     const auto& field0   = m_fm_time0->get_field(name);
     const auto& field1   = m_fm_time1->get_field(name);
           auto field_out = m_interp_fields.at(name);
@@ -76,6 +97,79 @@ void TimeInterpolation::perform_time_interpolation(const TimeStamp& time_in)
   }
 }
 /*-----------------------------------------------------------------------------------------------*/
+/* Function which interpolates all fused fields with a single kernel, computing
+ *        y* = w0*y0 + w1*y1
+ * with the same fill value treatment of Field::update.
+ */
+void TimeInterpolation::interpolate_fused_fields(const Real weight0, const Real weight1)
+{
+  using RangePolicy = Kokkos::RangePolicy<Field::device_t::execution_space>;
+
+  const auto table = m_fused_table;
+  const int nfields = table.size();
+  Kokkos::parallel_for("TimeInterpolation::interpolate_fused_fields",
+                       RangePolicy(0,m_fused_size),
+                       KOKKOS_LAMBDA(const int idx) {
+    // Find the field containing idx (the entries are sorted by offset)
+    int beg = 0, end = nfields;
+    while (end-beg>1) {
+      const int mid = (beg+end)/2;
+      if (table(mid).offset<=idx) {
+        beg = mid;
+      } else {
+        end = mid;
+      }
+    }
+    const auto& e = table(beg);
+    const int i = idx - e.offset;
+    const Real y0 = e.data0[i];
+    const Real y1 = e.data1[i];
+    if (y0==e.fill_val or y1==e.fill_val) {
+      e.out[i] = e.fill_val;
+    } else {
+      e.out[i] = weight0*y0 + weight1*y1;
+    }
+  });
+}
+/*-----------------------------------------------------------------------------------------------*/
+void TimeInterpolation::update_fused_table()
+{
+  const int nfields = m_fused_names.size();
+  bool changed = m_fused_table.extent_int(0)!=nfields;
+  if (changed) {
+    m_fused_table   = decltype(m_fused_table)("fused_table",nfields);
+    m_fused_table_h = Kokkos::create_mirror_view(m_fused_table);
+  }
+
+  int offset = 0;
+  for (int i=0; i<nfields; ++i) {
+    const auto& name = m_fused_names[i];
+    const auto& f0 = m_fm_time0->get_field(name);
+    const auto& f1 = m_fm_time1->get_field(name);
+    const auto& fo = m_interp_fields.at(name);
+    auto& e = m_fused_table_h(i);
+
+    const Real* data0 = f0.get_internal_view_data<const Real>();
+    const Real* data1 = f1.get_internal_view_data<const Real>();
+    Real*       out   = fo.get_internal_view_data<Real>();
+    changed |= e.data0!=data0 or e.data1!=data1 or e.out!=out;
+    e.data0  = data0;
+    e.data1  = data1;
+    e.out    = out;
+    e.offset = offset;
+    e.fill_val = constants::DefaultFillValue<Real>().value;
+    if (f1.get_header().has_extra_data("mask_value")) {
+      e.fill_val = f1.get_header().get_extra_data<Real>("mask_value");
+    }
+    offset += f0.get_header().get_identifier().get_layout().size();
+  }
+  m_fused_size = offset;
+
+  if (changed) {
+    Kokkos::deep_copy(m_fused_table,m_fused_table_h);
+  }
+}
+/*-----------------------------------------------------------------------------------------------*/
 /* Function which registers a field in the local field managers.
  * Input:
  *   field_in - Is a field with the appropriate dimensions and metadata to match the interpolation
@@ -98,6 +192,9 @@ void TimeInterpolation::add_field(const Field& field_in, const bool store_shallo
   auto field1 = field_in.clone();
   m_fm_time0->add_field(field0);
   m_fm_time1->add_field(field1);
+  if (m_prefetch_fields_per_call>0) {
+    m_fm_time2->add_field(field_in.clone());
+  }
   if (store_shallow_copy) {
     // Then we want to store the actual field_in and override it when interpolating
     m_interp_fields.emplace(name,field_in);
@@ -107,6 +204,32 @@ void TimeInterpolation::add_field(const Field& field_in, const bool store_shallo
     m_interp_fields.emplace(name,field_out);
   }
   m_field_names.push_back(name);
+
+  // Check if the field can be interpolated by the fused kernel. The time0/time1
+  // clones share the same alloc props (and get swapped), so check one of them
+  auto can_fuse = [](const Field& f) {
+    const auto& fap = f.get_header().get_alloc_properties();
+    return f.data_type()==get_data_type<Real>() and fap.contiguous() and fap.get_padding()==0;
+  };
+  if (can_fuse(field0) and can_fuse(m_interp_fields.at(name))) {
+    m_fused_names.push_back(name);
+  }
+}
+/*-----------------------------------------------------------------------------------------------*/
+/* Function which enables prefetching of data from files.
+ * Input:
+ *   num_fields_per_call - The max number of fields to read at each call to perform_time_interpolation.
+ *
+ * Since the staging buffer must contain all the fields, this must be called before add_field.
+ */
+void TimeInterpolation::set_prefetch(const int num_fields_per_call)
+{
+  EKAT_REQUIRE_MSG(num_fields_per_call>=0,
+      "Error! TimeInterpolation::set_prefetch - invalid number of fields per call.\n"
+      " - num fields per call: " << num_fields_per_call << "\n");
+  EKAT_REQUIRE_MSG(m_field_names.size()==0,
+      "Error! TimeInterpolation::set_prefetch must be called before adding any field.\n");
+  m_prefetch_fields_per_call = num_fields_per_call;
 }
 /*-----------------------------------------------------------------------------------------------*/
 /* Function to shift all data from time1 to time0, update timestamp for time0
@@ -181,10 +304,16 @@ void TimeInterpolation::initialize_data_from_files()
         field0.get_header().set_extra_data("mask_value",static_cast<float>(var_fill_value));
         field1.get_header().set_extra_data("mask_value",static_cast<float>(var_fill_value));
         field_out.get_header().set_extra_data("mask_value",static_cast<float>(var_fill_value));
+        if (m_prefetch_fields_per_call>0) {
+          m_fm_time2->get_field(name).get_header().set_extra_data("mask_value",static_cast<float>(var_fill_value));
+        }
       } else if (dt==DataType::DoubleType) {
         field0.get_header().set_extra_data("mask_value",static_cast<double>(var_fill_value));
         field1.get_header().set_extra_data("mask_value",static_cast<double>(var_fill_value));
         field_out.get_header().set_extra_data("mask_value",static_cast<double>(var_fill_value));
+        if (m_prefetch_fields_per_call>0) {
+          m_fm_time2->get_field(name).get_header().set_extra_data("mask_value",static_cast<double>(var_fill_value));
+        }
       } else {
         EKAT_ERROR_MSG (
             "[TimeInterpolation] Unexpected/unsupported field data type.\n"
@@ -216,6 +345,10 @@ void TimeInterpolation::initialize_data_from_files()
   // Advance the iterator and read the next set of data for time1
   ++m_triplet_idx;
   read_data();
+  // Start prefetching the snap after time1
+  if (m_prefetch_fields_per_call>0) {
+    start_prefetch();
+  }
 }
 /*-----------------------------------------------------------------------------------------------*/
 /* Function which will update the timestamps by shifting time1 to time0 and setting time1.
@@ -350,29 +483,7 @@ void TimeInterpolation::read_data()
   const auto triplet_curr = m_file_data_triplets[m_triplet_idx];
   if (not m_file_data_atm_input or triplet_curr.filename != m_file_data_atm_input->get_filename()) {
     // Then we need to close this input stream and open a new one
-    ekat::ParameterList input_params;
-    input_params.set("Field Names",m_field_names);
-    input_params.set("Filename",triplet_curr.filename);
-    m_file_data_atm_input = std::make_shared<AtmosphereInput>(input_params,m_fm_time1);
-    m_file_data_atm_input->set_logger(m_logger);
-    // Also determine the FillValue, if used
-    // TODO: Should we make it possible to check if FillValue is in the metadata and only assign mask_value if it is?
-    for (auto& name : m_field_names) {
-      auto& field = m_fm_time1->get_field(name);
-      const auto dt = field.data_type();
-      if (dt==DataType::FloatType) {
-        auto var_fill_value = scorpio::get_attribute<float>(triplet_curr.filename,name,"_FillValue");
-        field.get_header().set_extra_data("mask_value",var_fill_value);
-      } else if (dt==DataType::DoubleType) {
-        auto var_fill_value = scorpio::get_attribute<double>(triplet_curr.filename,name,"_FillValue");
-        field.get_header().set_extra_data("mask_value",var_fill_value);
-      } else {
-        EKAT_ERROR_MSG (
-            "[TimeInterpolation] Unexpected/unsupported field data type.\n"
-            " - field name: " + field.name() + "\n"
-            " - data type : " + e2str(dt) + "\n");
-      }
-    }
+    m_file_data_atm_input = create_input(triplet_curr.filename,m_fm_time1);
   }
 
   if (m_logger) {
@@ -383,6 +494,76 @@ void TimeInterpolation::read_data()
   m_time1 = triplet_curr.timestamp;
 }
 /*-----------------------------------------------------------------------------------------------*/
+/* Function to create an input stream reading data from a file into the fields of a field manager.
+ * Input:
+ *   filename - The file to read data from.
+ *   fm       - The field manager storing the fields where data will be read into.
+ */
+std::shared_ptr<AtmosphereInput>
+TimeInterpolation::create_input(const std::string& filename, const fm_type& fm)
+{
+  ekat::ParameterList input_params;
+  input_params.set("Field Names",m_field_names);
+  input_params.set("Filename",filename);
+  auto input = std::make_shared<AtmosphereInput>(input_params,fm);
+  input->set_logger(m_logger);
+  // Also determine the FillValue, if used
+  // TODO: Should we make it possible to check if FillValue is in the metadata and only assign mask_value if it is?
+  for (auto& name : m_field_names) {
+    auto& field = fm->get_field(name);
+    const auto dt = field.data_type();
+    if (dt==DataType::FloatType) {
+      auto var_fill_value = scorpio::get_attribute<float>(filename,name,"_FillValue");
+      field.get_header().set_extra_data("mask_value",var_fill_value);
+    } else if (dt==DataType::DoubleType) {
+      auto var_fill_value = scorpio::get_attribute<double>(filename,name,"_FillValue");
+      field.get_header().set_extra_data("mask_value",var_fill_value);
+    } else {
+      EKAT_ERROR_MSG (
+          "[TimeInterpolation] Unexpected/unsupported field data type.\n"
+          " - field name: " + field.name() + "\n"
+          " - data type : " + e2str(dt) + "\n");
+    }
+  }
+  return input;
+}
+/*-----------------------------------------------------------------------------------------------*/
+/* Function to start prefetching the snap following the one at time1 (if any) into the staging
+ * field manager.
+ */
+void TimeInterpolation::start_prefetch()
+{
+  const int next_idx = m_triplet_idx+1;
+  m_prefetch_idx = next_idx<static_cast<int>(m_file_data_triplets.size()) ? next_idx : -1;
+  m_prefetch_num_read = 0;
+}
+/*-----------------------------------------------------------------------------------------------*/
+/* Function to read some of the fields of the snap being prefetched.
+ * Input:
+ *   max_num_fields - The max number of fields to read.
+ */
+void TimeInterpolation::advance_prefetch(const int max_num_fields)
+{
+  const int num_fields = m_field_names.size();
+  if (m_prefetch_idx<0 or m_prefetch_num_read==num_fields) {
+    return;
+  }
+
+  const auto& triplet = m_file_data_triplets[m_prefetch_idx];
+  if (not m_prefetch_atm_input or triplet.filename != m_prefetch_atm_input->get_filename()) {
+    m_prefetch_atm_input = create_input(triplet.filename,m_fm_time2);
+  }
+
+  const int end = std::min(num_fields,m_prefetch_num_read+max_num_fields);
+  const vos_type names (m_field_names.begin()+m_prefetch_num_read,m_field_names.begin()+end);
+  if (m_logger and m_prefetch_num_read==0) {
+    m_logger->info(m_header);
+    m_logger->info("[EAMxx:time_interpolation] Prefetching data at time " + triplet.timestamp.to_string());
+  }
+  m_prefetch_atm_input->read_variables(triplet.time_idx,names);
+  m_prefetch_num_read = end;
+}
+/*-----------------------------------------------------------------------------------------------*/
 /* Function to check the current set of interpolation data against a timestamp and, if needed,
  * update the set of interpolation data to ensure the passed timestamp is within the bounds of
  * the interpolation data.
@@ -412,18 +593,36 @@ void TimeInterpolation::check_and_update_data(const TimeStamp& ts_in)
     EKAT_REQUIRE_MSG(found,"ERROR!! TimeInterpolation::check_and_update_data - timestamp " << ts_in.to_string() << "is outside the bounds of the set of data files." << "\n"
 		   <<  "     TimeStamp time0: " << m_time0.to_string() << "\n"
 		   <<  "     TimeStamp time1: " << m_time1.to_string() << "\n");
-    // Now we need to make sure we didn't jump more than one triplet, if we did then the data at time0 is
-    // incorrect.
-    if (step_cnt>1) {
-      // Then we need to populate data for time1 as the previous triplet before shifting data to time0
-      --m_triplet_idx;
+    if (step_cnt==1 and m_prefetch_idx==m_triplet_idx) {
+      // The new data is in the staging buffer: finish reading it (if needed), then shift the
+      // time1 data to time0, and swap the staging buffer with time1.
+      advance_prefetch(m_field_names.size());
+      shift_data();
+      for (auto name : m_field_names) {
+        auto& field1 = m_fm_time1->get_field(name);
+        auto& field2 = m_fm_time2->get_field(name);
+        std::swap(field1,field2);
+      }
+      m_file_data_atm_input->set_field_manager(m_fm_time1);
+      m_prefetch_atm_input->set_field_manager(m_fm_time2);
+      update_timestamp(m_file_data_triplets[m_triplet_idx].timestamp);
+    } else {
+      // Now we need to make sure we didn't jump more than one triplet, if we did then the data at time0 is
+      // incorrect.
+      if (step_cnt>1) {
+        // Then we need to populate data for time1 as the previous triplet before shifting data to time0
+        --m_triplet_idx;
+        read_data();
+        ++m_triplet_idx;
+      }
+      // We shift the time1 data to time0 and read the new data.
+      shift_data();
+      update_timestamp(m_file_data_triplets[m_triplet_idx].timestamp);
       read_data();
-      ++m_triplet_idx;
     }
-    // We shift the time1 data to time0 and read the new data.
-    shift_data();
-    update_timestamp(m_file_data_triplets[m_triplet_idx].timestamp);
-    read_data();
+    if (m_prefetch_fields_per_call>0) {
+      start_prefetch();
+    }
     // Sanity Check
     bool current_data_check = (ts_in.seconds_from(m_time0) >= 0) and (m_time1.seconds_from(ts_in) >= 0);
     EKAT_REQUIRE_MSG(current_data_check,"ERROR!! TimeInterpolation::check_and_update_data - Something went wrong in updating data:\n"
@@ -37,6 +37,13 @@ public:
   // Build interpolator
   void add_field(const Field& field_in, const bool store_shallow_copy=false);
 
+  // Prefetch the snap following time1 into a staging buffer, reading (at most)
+  // num_fields_per_call fields at each call to perform_time_interpolation.
+  // When the data needs to be updated, time1 and the staging buffer are simply
+  // swapped, so that the cost of reading a snap is spread across multiple steps.
+  // Must be called before any call to add_field. A value of 0 disables prefetching.
+  void set_prefetch(const int num_fields_per_call);
+
   // Getters
   Field get_field(const std::string& name) {
     return m_interp_fields.at(name);
@@ -52,6 +59,25 @@ public:
       m_header = header;
   }
 
+#ifndef KOKKOS_ENABLE_CUDA
+  // Cuda requires methods enclosing __device__ lambda's to be public
+protected:
+#endif
+
+  // Entry of the device table used to interpolate all the fused fields with a single
+  // kernel. The entry of a field covers the indices [offset,offset+size) of the
+  // flattened index space of the table.
+  struct FusedEntry {
+    const Real* data0;
+    const Real* data1;
+    Real*       out;
+    int         offset;
+    Real        fill_val;
+  };
+
+  // Interpolate all fused fields with the given weights
+  void interpolate_fused_fields (const Real weight0, const Real weight1);
+
 protected:
 
   // Internal structure to store data source triplets (when using data from file)
@@ -71,17 +97,34 @@ protected:
   // Helper functions to shift data
   void shift_data();
 
+  // Update the device table of the fused fields, since the time0/time1 storage is swapped over time
+  void update_fused_table();
+
   // For the case where forcing data comes from files
   void set_file_data_triplets(const vos_type& list_of_files);
   void read_data();
   void check_and_update_data(const TimeStamp& ts_in);
+  std::shared_ptr<AtmosphereInput> create_input(const std::string& filename, const fm_type& fm);
+
+  // For the case where data from files is prefetched
+  void start_prefetch();
+  void advance_prefetch(const int max_num_fields);
 
   // Local field managers used to store two time snaps of data for interpolation
   fm_type  m_fm_time0;
   fm_type  m_fm_time1;
+  // Staging field manager, storing the prefetched snap after time1 (if prefetching)
+  fm_type  m_fm_time2;
   vos_type m_field_names;
   std::map<std::string,Field> m_interp_fields;
 
+  // Fields that are contiguous, unpadded, and of type Real, are interpolated with a
+  // single kernel, rather than with two kernels per field
+  vos_type                                   m_fused_names;
+  int                                        m_fused_size = 0;
+  Kokkos::View<FusedEntry*>                  m_fused_table;
+  Kokkos::View<FusedEntry*>::HostMirror      m_fused_table_h;
+
   // Store the timestamps associated with the two time snaps
   TimeStamp m_time0;
   TimeStamp m_time1;
@@ -92,6 +135,12 @@ protected:
   std::shared_ptr<AtmosphereInput>           m_file_data_atm_input;
   bool                                       m_is_data_from_file=false;
 
+  // Variables related to prefetching data from file
+  std::shared_ptr<AtmosphereInput>           m_prefetch_atm_input;
+  int                                        m_prefetch_fields_per_call=0;
+  int                                        m_prefetch_idx=-1;  // Triplet being prefetched (-1 if none)
+  int                                        m_prefetch_num_read=0;
+
   std::shared_ptr<ekat::logger::LoggerBase>  m_logger;
   std::string                                m_header;
 }; // class TimeInterpolation
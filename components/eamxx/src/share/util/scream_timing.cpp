@@ -1,9 +1,38 @@
 #include "share/util/scream_timing.hpp"
 
+#include <ekat/ekat_assert.hpp>
+
+#include <Kokkos_Core.hpp>
 #include <gptl.h>
 
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <vector>
+
 namespace scream {
 
+namespace {
+
+struct TimingState {
+  using clock_t = std::chrono::steady_clock;
+
+  TimingOptions opts;
+
+  // Trace file, with the start time of the active timers, and the elapsed
+  // times of the timers stopped since the last flush
+  std::ofstream trace;
+  std::map<std::string,clock_t::time_point> active;
+  std::vector<std::pair<std::string,double>> records;
+};
+
+TimingState& timing_state () {
+  static TimingState s;
+  return s;
+}
+
+} // anonymous namespace
+
 void init_gptl (bool& was_already_inited) {
 #ifdef SCREAM_CIME_BUILD
   was_already_inited = true;
@@ -17,15 +46,79 @@ void finalize_gptl () {
 }
 
 void start_timer (const std::string& name) {
+  auto& s = timing_state();
+  if (s.opts.fence_device) {
+    Kokkos::fence();
+  }
+  if (s.opts.kokkos_regions) {
+    Kokkos::Profiling::pushRegion(name);
+  }
+  if (s.trace.is_open()) {
+    s.active[name] = TimingState::clock_t::now();
+  }
   GPTLstart(name.c_str());
 }
 
 void stop_timer (const std::string& name) {
+  auto& s = timing_state();
+  if (s.opts.fence_device) {
+    Kokkos::fence();
+  }
   GPTLstop(name.c_str());
+  if (s.trace.is_open()) {
+    auto it = s.active.find(name);
+    if (it!=s.active.end()) {
+      std::chrono::duration<double> elapsed = TimingState::clock_t::now() - it->second;
+      s.records.emplace_back(name,elapsed.count());
+      s.active.erase(it);
+    }
+  }
+  if (s.opts.kokkos_regions) {
+    Kokkos::Profiling::popRegion();
+  }
 }
 
 void write_timers_to_file (const ekat::Comm& comm, const std::string& fname) {
   GPTLpr_summary_file (comm.mpi_comm(),fname.c_str());
 }
 
+void set_timing_options (const ekat::Comm& comm, const TimingOptions& opts) {
+  auto& s = timing_state();
+  close_timers_trace();
+
+  s.opts = opts;
+  if (opts.trace_file!="" and comm.am_i_root()) {
+    s.trace.open(opts.trace_file);
+    EKAT_REQUIRE_MSG (s.trace.good(),
+        "Error! Could not open timers trace file.\n"
+        " - file name: " + opts.trace_file + "\n");
+    s.trace << "step,timer,time[s]\n";
+  }
+}
+
+const TimingOptions& get_timing_options () {
+  return timing_state().opts;
+}
+
+void flush_timers_trace (const int nstep) {
+  auto& s = timing_state();
+  if (not s.trace.is_open()) {
+    return;
+  }
+  for (const auto& r : s.records) {
+    s.trace << nstep << "," << r.first << "," << r.second << "\n";
+  }
+  s.trace.flush();
+  s.records.clear();
+}
+
+void close_timers_trace () {
+  auto& s = timing_state();
+  if (s.trace.is_open()) {
+    s.trace.close();
+  }
+  s.active.clear();
+  s.records.clear();
+}
+
 } // namespace scream
@@ -7,6 +7,24 @@
 
 namespace scream {
 
+// Options controlling how timers interact with Kokkos.
+// By default, timers are host-only, so the cost of asynchronous kernels is
+// attributed to whichever timer is running when the host eventually blocks.
+struct TimingOptions {
+  // Fence the device when starting/stopping a timer. Timings (GPTL and trace)
+  // are then accurate device times, at the price of serializing the run.
+  bool fence_device = false;
+
+  // Push/pop a Kokkos profiling region for each timer. This does not sync the
+  // device, and allows Kokkos Tools (e.g., nsys/rocprof connectors) to report
+  // accurate per-region device times. Timers must be properly nested.
+  bool kokkos_regions = false;
+
+  // If not empty, the root rank writes the (host) elapsed time of each timer
+  // stopped during a time step to this CSV file, one row per timer.
+  std::string trace_file;
+};
+
 // The following simply wrap GPTL calls. We encourage using
 // these (rather than raw GPTL calls), to make SCREAM insensitive
 // to any future refactor that might change how we do timing.
@@ -17,6 +35,15 @@ void stop_timer (const std::string& name);
 
 void write_timers_to_file (const ekat::Comm& comm, const std::string& fname);
 
+// Set the options for all timers (see TimingOptions above)
+void set_timing_options (const ekat::Comm& comm, const TimingOptions& opts);
+const TimingOptions& get_timing_options ();
+
+// Write the records of the timers stopped since the last call to the trace
+// file (if any), tagging them with the given time step number.
+void flush_timers_trace (const int nstep);
+void close_timers_trace ();
+
 } // namespace scream
 
 #endif // SCREAM_TIMING_HPP
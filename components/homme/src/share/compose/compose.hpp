@@ -45,6 +45,17 @@ typedef Kokkos::Experimental::SYCL ComposeGpuSpace;
 // Look for MPI-related memory leaks.
 //#define COMPOSE_DEBUG_MPI
 
+// In the IslMpi step, compute q at the departure points in my own elements
+// while the departure point requests are in flight, and copy the q data from
+// each remote as soon as its message arrives. q for remote requests is then
+// computed from qdp/dp, which is BFB with computing it from q.
+#define COMPOSE_PIPELINED_STEP
+
+// In CAAS, reduce the (tracer, level) sums with the BFB tree all-reduce rather
+// than the Fortran repro sum. All 4*qsize*nsuplev sums travel in one message
+// per tree node.
+//#define COMPOSE_CAAS_TREE_REDUCE
+
 #if ! defined COMPOSE_PORT
 # if defined HORIZ_OPENMP
 #  define COMPOSE_HORIZ_OPENMP
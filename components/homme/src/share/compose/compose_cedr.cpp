@@ -447,9 +447,14 @@ CDR<MT>::CDR (Int cdr_alg_, Int ngblcell_, Int nlclcell_, Int nlev_, Int qsize_,
     const Int n_accum_in_place = n_id_in_suplev*(cdr_over_super_levels ?
                                                  nsuplev : 1);
     typename CAAST::UserAllReducer::Ptr reducer;
-    //todo Measure perf on CPU and GPU of TreeReducer vs
-    // ReproSumReducer. For now, I'll continue to use ReproSumReducer.
-    if (false && ko::OnGpu<ko::MachineTraits::DES>::value) {
+    // The TreeReducer packs all the (tracer, level) sums into one message per
+    // tree node and so avoids the repro sum's host staging on GPU.
+#ifdef COMPOSE_CAAS_TREE_REDUCE
+    const bool use_tree_reducer = true;
+#else
+    const bool use_tree_reducer = false;
+#endif
+    if (use_tree_reducer) {
       tree = make_tree(p, ncell, gid_data, rank_data, 1, use_sgi, false, false);
       const Int nfield = 4*qsize*(cdr_over_super_levels ? 1 : nsuplev);
       reducer = std::make_shared<TreeReducer<MT> >(p, tree, ncell, nfield,
@@ -634,6 +634,10 @@ template <typename MT>
 void wait_on_send (IslMpi<MT>& cm, const bool skip_if_empty = false);
 template <typename MT>
 void recv(IslMpi<MT>& cm, const bool skip_if_empty = false);
+// Wait for any one of the pending receives; return its index into the list of
+// ranks. The caller must call this exactly once per pending receive.
+template <typename MT>
+Int wait_on_recv_any(IslMpi<MT>& cm);
 
 const int nreal_per_2int = (2*sizeof(Int) + sizeof(Real) - 1) / sizeof(Real);
 
@@ -651,9 +655,15 @@ template <typename MT>
 void calc_own_q(IslMpi<MT>& cm, const Int& nets, const Int& nete,
                 const DepPoints<MT>& dep_points,
                 const QExtrema<MT>& q_min, const QExtrema<MT>& q_max);
+// If ri >= 0, copy only the data received from rank index ri.
 template <typename MT>
 void copy_q(IslMpi<MT>& cm, const Int& nets,
-            const QExtrema<MT>& q_min, const QExtrema<MT>& q_max);
+            const QExtrema<MT>& q_min, const QExtrema<MT>& q_max,
+            const Int ri = -1);
+// Receive q data from remotes, copying each message's data as it arrives.
+template <typename MT>
+void recv_and_copy_q(IslMpi<MT>& cm, const Int& nets,
+                     const QExtrema<MT>& q_min, const QExtrema<MT>& q_max);
 
 /* Take a semi-Lagrangian step, excluding property preservation.
      dep_points is const in principle, but if
@@ -104,21 +104,28 @@ void wait_on_send (IslMpi<MT>& cm, const bool skip_if_empty) {
 }
 
 template <typename MT>
-void wait_on_recv (IslMpi<MT>& cm) {
+Int wait_on_recv_any (IslMpi<MT>& cm) {
+  Int reqi;
+  MPI_Status stat;
+  mpi::waitany(cm.recvreq.n(), cm.recvreq.data(), &reqi, &stat);
+  const Int ri = cm.recvreq_ri(reqi);
 #ifdef COMPOSE_MPI_ON_HOST
   typedef typename IslMpi<MT>::template ArrayH<Real*> ArrayH;
   typedef typename IslMpi<MT>::template ArrayD<Real*> ArrayD;
+  int count;
+  MPI_Get_count(&stat, mpi::get_type<Real>(), &count);
+  Kokkos::deep_copy(ArrayD(cm.recvbuf.get_h(ri).data(), count),
+                    ArrayH(cm.recvbuf_h(ri).data(), count));
+#endif
+  return ri;
+}
+
+template <typename MT>
+void wait_on_recv (IslMpi<MT>& cm) {
+#ifdef COMPOSE_MPI_ON_HOST
   const int nreq = cm.recvreq.n();
-  for (Int i = 0; i < nreq; ++i) {
-    Int reqi;
-    MPI_Status stat;
-    mpi::waitany(nreq, cm.recvreq.data(), &reqi, &stat);
-    const Int ri = cm.recvreq_ri(reqi);
-    int count;
-    MPI_Get_count(&stat, mpi::get_type<Real>(), &count);
-    Kokkos::deep_copy(ArrayD(cm.recvbuf.get_h(ri).data(), count),
-                      ArrayH(cm.recvbuf_h(ri).data(), count));
-  }
+  for (Int i = 0; i < nreq; ++i)
+    wait_on_recv_any(cm);
 #else
   mpi::waitall(cm.recvreq.n(), cm.recvreq.data());
 #endif
@@ -159,6 +166,7 @@ template void isend(IslMpi<ko::MachineTraits>& cm, const bool want_req,
 template void recv_and_wait_on_send(IslMpi<ko::MachineTraits>& cm);
 template void wait_on_send(IslMpi<ko::MachineTraits>& cm, const bool skip_if_empty);
 template void recv(IslMpi<ko::MachineTraits>& cm, const bool skip_if_empty);
+template Int wait_on_recv_any(IslMpi<ko::MachineTraits>& cm);
 
 } // namespace islmpi
 } // namespace homme
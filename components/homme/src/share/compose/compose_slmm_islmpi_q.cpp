@@ -288,7 +288,8 @@ void calc_own_q (IslMpi<MT>& cm, const Int& nets, const Int& nete,
 
 template <typename MT>
 void copy_q (IslMpi<MT>& cm, const Int& nets,
-             const QExtrema<MT>& q_min, const QExtrema<MT>& q_max) {
+             const QExtrema<MT>& q_min, const QExtrema<MT>& q_max,
+             const Int ri_only) {
   const auto myrank = cm.p->rank();
   const int tid = get_tid();
   for (Int ptr = cm.mylid_with_comm_tid_ptr_h(tid),
@@ -300,6 +301,7 @@ void copy_q (IslMpi<MT>& cm, const Int& nets,
     for (const auto& e: ed.rmt) {
       slmm_assert(ed.nbrs(ed.src(e.lev, e.k)).rank != myrank);
       const Int ri = ed.nbrs(ed.src(e.lev, e.k)).rank_idx;
+      if (ri_only >= 0 && ri != ri_only) continue;
       const auto&& recvbuf = cm.recvbuf(ri);
       for (Int iq = 0; iq < cm.qsize; ++iq) {
         idx_qext(q_min, tci, iq, e.k, e.lev) = recvbuf(e.q_extrema_ptr + 2*iq    );
@@ -340,7 +342,12 @@ void calc_rmt_q_pass2 (IslMpi<MT>& cm) {
       xos = cm.rmt_xs_h(5*it + 3), qos = qsize*cm.rmt_xs_h(5*it + 4);
     const auto&& xs = cm.recvbuf(ri);
     auto&& qs = cm.sendbuf(ri);
+#ifdef COMPOSE_PIPELINED_STEP
+    // q may have been overwritten already by calc_own_q.
+    calc_q<np>(cm, lid, lev, &xs(xos), &qs(qos), false);
+#else
     calc_q<np>(cm, lid, lev, &xs(xos), &qs(qos), true);
+#endif
   }
 }
 
@@ -418,7 +425,8 @@ void calc_own_q (IslMpi<MT>& cm, const Int& nets, const Int& nete,
 
 template <typename MT>
 void copy_q (IslMpi<MT>& cm, const Int& nets,
-             const QExtrema<MT>& q_min, const QExtrema<MT>& q_max) {
+             const QExtrema<MT>& q_min, const QExtrema<MT>& q_max,
+             const Int ri_only) {
   slmm_assert(cm.mylid_with_comm_tid_ptr_h.size() == 2);
   const auto myrank = cm.p->rank();
   const auto& q_tgt = cm.tracer_arrays->q;
@@ -435,6 +443,7 @@ void copy_q (IslMpi<MT>& cm, const Int& nets,
     const auto& e = ed.rmt(rmt_id);
     slmm_kernel_assert(ed.nbrs(ed.src(e.lev, e.k)).rank != myrank);
     const Int ri = ed.nbrs(ed.src(e.lev, e.k)).rank_idx;
+    if (ri_only >= 0 && ri != ri_only) return;
     const auto&& recvbuf = recvbufs(ri);
     for (Int iq = 0; iq < qsize; ++iq) {
       idx_qext(q_min, tci, iq, e.k, e.lev) = recvbuf(e.q_extrema_ptr + 2*iq    );
@@ -531,7 +540,14 @@ void calc_rmt_q_pass1_scan (IslMpi<MT>& cm) {
 
 template <Int np, typename MT>
 void calc_rmt_q_pass2 (IslMpi<MT>& cm) {
+#ifdef COMPOSE_PIPELINED_STEP
+  // q may have been overwritten already by calc_own_q, so have to use qdp/dp.
+  const auto& dp_src = cm.tracer_arrays->dp;
+  const auto& qdp_src = cm.tracer_arrays->qdp;
+  const auto& qtl = cm.tracer_arrays->n0_qdp;
+#else
   const auto& q_src = cm.tracer_arrays->q;
+#endif
   const auto& rmt_qs_extrema = cm.rmt_qs_extrema;
   const auto& rmt_xs = cm.rmt_xs;
   const auto& ed_d = cm.ed_d;
@@ -566,6 +582,10 @@ void calc_rmt_q_pass2 (IslMpi<MT>& cm) {
     Real rx[4], ry[4];
     calc_coefs<np,MT>(s2r, local_meshes(lid), alg, lid, lev, &xs(xos), rx, ry);
     Real* const q_tgt = &qs(qos);
+#ifdef COMPOSE_PIPELINED_STEP
+    Real dp[16];
+    for (Int k = 0; k < 16; ++k) dp[k] = dp_src(lid, k, lev);
+#endif
     // Block for auto-vectorization.
     for (Int iqo = 0; iqo < qsize; iqo += blocksize) {
       if (iqo + blocksize <= qsize) {
@@ -573,16 +593,26 @@ void calc_rmt_q_pass2 (IslMpi<MT>& cm) {
         for (Int iqi = 0; iqi < blocksize; ++iqi) {
           const Int iq = iqo + iqi;
           Real qsrc[16];
+#ifdef COMPOSE_PIPELINED_STEP
+          for (Int k = 0; k < 16; ++k) qsrc[k] = qdp_src(lid, qtl, iq, k, lev);
+          tmp[iqi] = calc_q_tgt(rx, ry, qsrc, dp);
+#else
           for (Int k = 0; k < 16; ++k) qsrc[k] = q_src(lid, iq, k, lev);
           tmp[iqi] = calc_q_tgt(rx, ry, qsrc);
+#endif
         }
         for (Int iqi = 0; iqi < blocksize; ++iqi)
           q_tgt[iqo + iqi] = tmp[iqi];
       } else {
         for (Int iq = iqo; iq < qsize; ++iq) {
           Real qsrc[16];
+#ifdef COMPOSE_PIPELINED_STEP
+          for (Int k = 0; k < 16; ++k) qsrc[k] = qdp_src(lid, qtl, iq, k, lev);
+          q_tgt[iq] = calc_q_tgt(rx, ry, qsrc, dp);
+#else
           for (Int k = 0; k < 16; ++k) qsrc[k] = q_src(lid, iq, k, lev);
           q_tgt[iq] = calc_q_tgt(rx, ry, qsrc);
+#endif
         }
       }
     }
@@ -689,6 +719,24 @@ void calc_own_q (IslMpi<MT>& cm, const Int& nets, const Int& nete,
   }
 }
 
+template <typename MT>
+void recv_and_copy_q (IslMpi<MT>& cm, const Int& nets,
+                      const QExtrema<MT>& q_min, const QExtrema<MT>& q_max) {
+#ifdef COMPOSE_HORIZ_OPENMP
+  // Only the master thread communicates, so with threads, don't interleave.
+  if (cm.horiz_openmp) {
+    recv(cm, true /* skip_if_empty */);
+    copy_q(cm, nets, q_min, q_max);
+    return;
+  }
+#endif
+  const Int nreq = cm.recvreq.n();
+  for (Int i = 0; i < nreq; ++i) {
+    const Int ri = wait_on_recv_any(cm);
+    copy_q(cm, nets, q_min, q_max, ri);
+  }
+}
+
 template <typename MT>
 void calc_rmt_q (IslMpi<MT>& cm) {
   switch (cm.np) {
@@ -705,7 +753,11 @@ template void calc_own_q(IslMpi<ko::MachineTraits>& cm,
                          const QExtrema<ko::MachineTraits>& q_max);
 template void copy_q(IslMpi<ko::MachineTraits>& cm, const Int& nets,
                      const QExtrema<ko::MachineTraits>& q_min,
-                     const QExtrema<ko::MachineTraits>& q_max);
+                     const QExtrema<ko::MachineTraits>& q_max,
+                     const Int ri_only);
+template void recv_and_copy_q(IslMpi<ko::MachineTraits>& cm, const Int& nets,
+                              const QExtrema<ko::MachineTraits>& q_min,
+                              const QExtrema<ko::MachineTraits>& q_max);
 
 } // namespace islmpi
 } // namespace homme
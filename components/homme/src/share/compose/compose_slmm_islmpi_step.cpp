@@ -52,6 +52,15 @@ void step (
   // While waiting, compute q extrema in each of my elements.
   { Timer t("07_q_extrema");
     calc_q_extrema(cm, nets, nete); }
+#ifdef COMPOSE_PIPELINED_STEP
+  // Still while waiting, compute q for departure points that have remained in
+  // my elements. This needs the q extrema of neighboring elements.
+# ifdef COMPOSE_HORIZ_OPENMP
+# pragma omp barrier
+# endif
+  { Timer t("07_own_q");
+    calc_own_q(cm, nets, nete, dep_points, q_min, q_max); }
+#endif
   // Wait for the departure point requests. Since this requires a thread
   // barrier, at the same time make sure the send buffer is free for use.
   { Timer t("08_recv_and_wait");
@@ -66,6 +75,12 @@ void step (
   // all threads are done with the receive buffer's departure points.
   { Timer t("11_setup_irecv");
     setup_irecv(cm, true /* skip_if_empty */); }
+#ifdef COMPOSE_PIPELINED_STEP
+  // Receive remote q data and use each message to fill in the rest of my
+  // fields as soon as it arrives.
+  { Timer t("13_recv_copy_q");
+    recv_and_copy_q(cm, nets, q_min, q_max); }
+#else
   // While waiting to get my data from remotes, compute q for departure points
   // that have remained in my elements.
   { Timer t("12_own_q");
@@ -75,6 +90,7 @@ void step (
     recv(cm, true /* skip_if_empty */); }
   { Timer t("14_copy_q");
     copy_q(cm, nets, q_min, q_max); }
+#endif
   // Wait on send buffer so it's free to be used by others.
   { Timer t("15_wait_on_send");
     wait_on_send(cm, true /* skip_if_empty */); }
@@ -65,10 +65,16 @@ struct ComposeTransportImpl {
 
     DeparturePoints dep_pts;
 
+    // Key of the flow for which dep_pts was computed. calc_trajectory
+    // overwrites vstar with the midpoint velocity, so it can't be run twice on
+    // the same flow; instead, later runs in the same tracer step reuse dep_pts.
+    int traj_nstep, traj_np1;
+    Real traj_dt;
+
     Data ()
       : nelemd(-1), qsize(-1), limiter_option(9), cdr_check(0), hv_q(0),
         hv_subcycle_q(0), geometry_type(0), nu_q(0), hv_scaling(0), dp_tol(-1),
-        independent_time_steps(false)
+        independent_time_steps(false), traj_nstep(-1), traj_np1(-1), traj_dt(0)
     {}
   };
 
@@ -108,6 +114,8 @@ struct ComposeTransportImpl {
   void remap_q(const TimeLevel& tl);
 
   void calc_trajectory(const int np1, const Real dt);
+  bool trajectory_is_cached(const TimeLevel& tl, const Real dt) const;
+  void invalidate_trajectory_cache() { m_data.traj_nstep = -1; }
   void remap_v(const ExecViewUnmanaged<const Scalar*[NUM_TIME_LEVELS][NP][NP][NUM_LEV]>& dp3d,
                const int np1, const ExecViewUnmanaged<const Scalar*[NP][NP][NUM_LEV]>& dp,
                const ExecViewUnmanaged<Scalar*[2][NP][NP][NUM_LEV]>& v);
@@ -62,6 +62,7 @@ void ComposeTransportImpl::reset (const SimulationParams& params) {
     const auto nel = num_elems;
     const auto nlev = NUM_LEV*packn;
     m_data.dep_pts = DeparturePoints("dep_pts", nel);
+    invalidate_trajectory_cache();
     homme::compose::set_views(
       g.m_spheremp,
       homme::compose::SetView<Real****>  (reinterpret_cast<Real*>(d.m_dp.data()),
@@ -113,8 +114,10 @@ void ComposeTransportImpl::reset (const SimulationParams& params) {
 
 int ComposeTransportImpl::requested_buffer_size () const {
   // FunctorsBuffersManager wants the size in terms of sizeof(Real).
+  // qtens_biharmonic is only needed within a transport step, so it is part of the buffers
   return (3*Buf1::shmem_size(nslot) +
-          2*Buf2::shmem_size(nslot))/sizeof(Real);
+          2*Buf2::shmem_size(nslot))/sizeof(Real) +
+    m_geometry.num_elems()*QSIZE_D*NP*NP*NUM_LEV*VECTOR_SIZE;
 }
 
 void ComposeTransportImpl::init_buffers (const FunctorsBuffersManager& fbm) {
@@ -127,6 +130,8 @@ void ComposeTransportImpl::init_buffers (const FunctorsBuffersManager& fbm) {
     m_data.buf2[i] = Buf2(mem, nslot);
     mem += Buf2::shmem_size(nslot)/sizeof(Scalar);
   }
+  m_tracers.qtens_biharmonic = ExecViewUnmanaged<Scalar*[QSIZE_D][NP][NP][NUM_LEV]>(
+    mem, m_geometry.num_elems());
 }
 
 void ComposeTransportImpl::init_boundary_exchanges () {
@@ -178,10 +183,22 @@ void ComposeTransportImpl::init_boundary_exchanges () {
   }
 }
 
+bool ComposeTransportImpl::trajectory_is_cached (const TimeLevel& tl, const Real dt) const {
+  return (m_data.traj_nstep >= 0 && m_data.traj_nstep == tl.nstep &&
+          m_data.traj_np1 == tl.np1 && m_data.traj_dt == dt);
+}
+
 void ComposeTransportImpl::run (const TimeLevel& tl, const Real dt) {
   GPTLstart("compose_transport");
 
-  calc_trajectory(tl.np1, dt);
+  // If this is not the first run in this tracer step, e.g. for another tracer
+  // group, the departure points and derived dp are already set up.
+  if ( ! trajectory_is_cached(tl, dt)) {
+    calc_trajectory(tl.np1, dt);
+    m_data.traj_nstep = tl.nstep;
+    m_data.traj_np1 = tl.np1;
+    m_data.traj_dt = dt;
+  }
   
   GPTLstart("compose_isl");
   homme::compose::advect(tl.np1, tl.n0_qdp, tl.np1_qdp);
@@ -156,6 +156,7 @@ void ComposeTransportImpl::test_2d (const bool bfb, const int nstep, std::vector
 
   TimeLevel& tl = Context::singleton().get<TimeLevel>();
   tl.nstep = 0;
+  invalidate_trajectory_cache();
   tl.update_tracers_levels(params.qsplit);
   const Real twelve_days = 3600 * 24 * 12, dt = twelve_days/nstep;
 
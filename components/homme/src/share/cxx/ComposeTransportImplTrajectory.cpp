@@ -347,6 +347,7 @@ KOKKOS_FUNCTION static void calc_vertically_lagrangian_levels (
  */
 void ComposeTransportImpl::calc_trajectory (const int np1, const Real dt) {
   GPTLstart("compose_calc_trajectory");
+  invalidate_trajectory_cache();
   const auto sphere_ops = m_sphere_ops;
   const auto geo = m_geometry;
   const auto m_vec_sph2cart = geo.m_vec_sph2cart;
@@ -29,6 +29,10 @@
 # define HOMMEXX_MPI_ON_DEVICE 1
 #endif
 
+#ifndef HOMMEXX_DIRK_ELEM_BATCH
+# define HOMMEXX_DIRK_ELEM_BATCH 1
+#endif
+
 #include <Kokkos_Core.hpp>
 
 #ifdef HOMMEXX_ENABLE_GPU 
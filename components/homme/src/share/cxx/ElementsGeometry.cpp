@@ -37,7 +37,9 @@ void ElementsGeometry::init(const int num_elems, const bool consthv, const bool
   m_rspheremp = ExecViewManaged<Real * [NP][NP]>("RSPHEREMP", m_num_elems);
 
   // Metric
+#ifndef HOMMEXX_COMPACT_METRIC
   m_metinv = ExecViewManaged<Real * [2][2][NP][NP]>("METINV", m_num_elems);
+#endif
   m_metdet = ExecViewManaged<Real * [NP][NP]>("METDET", m_num_elems);
 
   if(!consthv){
@@ -49,7 +51,9 @@ void ElementsGeometry::init(const int num_elems, const bool consthv, const bool
 
   //matrix D and its derivatives 
   m_d    = ExecViewManaged<Real * [2][2][NP][NP]>("matrix D",                   m_num_elems);
+#ifndef HOMMEXX_COMPACT_METRIC
   m_dinv = ExecViewManaged<Real * [2][2][NP][NP]>("DInv - inverse of matrix D", m_num_elems);
+#endif
 
   if (alloc_gradphis) {
     m_gradphis = decltype(m_gradphis) ("gradient of geopotential at surface", m_num_elems);
@@ -86,9 +90,11 @@ set_elem_data (const int ie,
   ScalarView::HostMirror h_metdet    = Kokkos::create_mirror_view(Homme::subview(m_metdet,ie));
   ScalarView::HostMirror h_spheremp  = Kokkos::create_mirror_view(Homme::subview(m_spheremp,ie));
   ScalarView::HostMirror h_rspheremp = Kokkos::create_mirror_view(Homme::subview(m_rspheremp,ie));
-  TensorView::HostMirror h_metinv    = Kokkos::create_mirror_view(Homme::subview(m_metinv,ie));
   TensorView::HostMirror h_d         = Kokkos::create_mirror_view(Homme::subview(m_d,ie));
+#ifndef HOMMEXX_COMPACT_METRIC
+  TensorView::HostMirror h_metinv    = Kokkos::create_mirror_view(Homme::subview(m_metinv,ie));
   TensorView::HostMirror h_dinv      = Kokkos::create_mirror_view(Homme::subview(m_dinv,ie));
+#endif
 
   TensorView::HostMirror h_tensorvisc;
   Tensor23View::HostMirror h_vec_sph2cart;
@@ -123,8 +129,10 @@ set_elem_data (const int ie,
       for (int igp = 0; igp < NP; ++igp) {
         for (int jgp = 0; jgp < NP; ++jgp) {
           h_d      (idim,jdim,igp,jgp) = h_d_f90      (idim,jdim,igp,jgp);
+#ifndef HOMMEXX_COMPACT_METRIC
           h_dinv   (idim,jdim,igp,jgp) = h_dinv_f90   (idim,jdim,igp,jgp);
           h_metinv (idim,jdim,igp,jgp) = h_metinv_f90 (idim,jdim,igp,jgp);
+#endif
         }
       }
     }
@@ -152,12 +160,14 @@ set_elem_data (const int ie,
   }
 
   Kokkos::deep_copy(Homme::subview(m_fcor,ie), h_fcor);
+#ifndef HOMMEXX_COMPACT_METRIC
   Kokkos::deep_copy(Homme::subview(m_metinv,ie), h_metinv);
+  Kokkos::deep_copy(Homme::subview(m_dinv,ie), h_dinv);
+#endif
   Kokkos::deep_copy(Homme::subview(m_metdet,ie), h_metdet);
   Kokkos::deep_copy(Homme::subview(m_spheremp,ie), h_spheremp);
   Kokkos::deep_copy(Homme::subview(m_rspheremp,ie), h_rspheremp);
   Kokkos::deep_copy(Homme::subview(m_d,ie), h_d);
-  Kokkos::deep_copy(Homme::subview(m_dinv,ie), h_dinv);
   if( !consthv ) {
     Kokkos::deep_copy(Homme::subview(m_tensorvisc,ie), h_tensorvisc);
   }
@@ -227,6 +237,8 @@ void ElementsGeometry::randomize(const int seed) {
   // generate them one at a time, verifying them individually
   HostViewManaged<Real[2][2]> h_matrix("single host metric matrix");
 
+  // With a compact metric, h_dinv and h_metinv are empty, and not set
+  constexpr bool store_dinv = !compact_metric();
   auto h_d    = Kokkos::create_mirror_view(m_d);
   auto h_dinv = Kokkos::create_mirror_view(m_dinv);
   auto h_metinv = Kokkos::create_mirror_view(m_metinv);
@@ -259,19 +271,23 @@ void ElementsGeometry::randomize(const int seed) {
           }
         }
         const Real determinant = compute_det(h_matrix);
-        h_dinv(ie, 0, 0, igp, jgp) =  h_matrix(1, 1) / determinant;
-        h_dinv(ie, 1, 0, igp, jgp) = -h_matrix(1, 0) / determinant;
-        h_dinv(ie, 0, 1, igp, jgp) = -h_matrix(0, 1) / determinant;
-        h_dinv(ie, 1, 1, igp, jgp) =  h_matrix(0, 0) / determinant;
+        if (store_dinv) {
+          h_dinv(ie, 0, 0, igp, jgp) =  h_matrix(1, 1) / determinant;
+          h_dinv(ie, 1, 0, igp, jgp) = -h_matrix(1, 0) / determinant;
+          h_dinv(ie, 0, 1, igp, jgp) = -h_matrix(0, 1) / determinant;
+          h_dinv(ie, 1, 1, igp, jgp) =  h_matrix(0, 0) / determinant;
+        }
 
         do {
           genRandArray(h_matrix, engine, random_dist);
         } while (compute_det(h_matrix)<=0.0);
         h_metdet(ie,igp,jgp) = compute_det(h_matrix);
-        h_metinv(ie, 0, 0, igp, jgp) = h_matrix(1, 1);
-        h_metinv(ie, 1, 0, igp, jgp) = h_matrix(1, 0);
-        h_metinv(ie, 0, 1, igp, jgp) = h_matrix(0, 1);
-        h_metinv(ie, 1, 1, igp, jgp) = h_matrix(0, 0);
+        if (store_dinv) {
+          h_metinv(ie, 0, 0, igp, jgp) = h_matrix(1, 1);
+          h_metinv(ie, 1, 0, igp, jgp) = h_matrix(1, 0);
+          h_metinv(ie, 0, 1, igp, jgp) = h_matrix(0, 1);
+          h_metinv(ie, 1, 1, igp, jgp) = h_matrix(0, 0);
+        }
       }
     }
   }
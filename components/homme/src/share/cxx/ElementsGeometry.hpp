@@ -37,7 +37,9 @@ public:
   ExecViewManaged<Real *    [NP][NP]> m_phis;
   ExecViewManaged<Real * [2][NP][NP]> m_gradphis;
 
-  // D (map for covariant coordinates) and D^{-1}
+  // D (map for covariant coordinates) and D^{-1}.
+  // If HOMMEXX_COMPACT_METRIC is defined, m_dinv and m_metinv are not allocated,
+  // and SphereOperators recomputes them from m_d when needed.
   ExecViewManaged<Real * [2][2][NP][NP]> m_d;
   ExecViewManaged<Real * [2][2][NP][NP]> m_dinv;
 
@@ -64,6 +66,15 @@ public:
   KOKKOS_INLINE_FUNCTION
   int num_elems() const { return m_num_elems; }
 
+  // Whether m_dinv and m_metinv are recomputed from m_d rather than stored
+  static constexpr bool compact_metric () {
+#ifdef HOMMEXX_COMPACT_METRIC
+    return true;
+#else
+    return false;
+#endif
+  }
+
   // Fill the exec space views with data coming from F90 pointers
   void set_elem_data (const int ie,
                       CF90Ptr& D, CF90Ptr& Dinv, CF90Ptr& fcor,
@@ -112,6 +112,10 @@ class EulerStepFunctorImpl {
 
   std::shared_ptr<BoundaryExchange> m_mm_be, m_mmqb_be;
   Kokkos::Array<std::shared_ptr<BoundaryExchange>, 3*Q_NUM_TIME_LEVELS> m_bes;
+#ifdef HOMMEXX_EULER_FUSED_DSS_PACK
+  // Packs qdp(np1_qdp) in the send buffers of the DSS exchange at the end of the tracer phase
+  BoundaryExchange::FieldPacker m_dss_packer;
+#endif
 
   enum { m_mem_per_team = 2 * NP * NP * sizeof(Real) };
 
@@ -204,7 +208,9 @@ public:
     constexpr int num_scalars = Buffers::num_3d_scalar_mid_buf;
     constexpr int num_vectors = Buffers::num_3d_vector_mid_buf;
 
-    return m_geometry.num_elems() * (num_scalars*size_scalar + num_vectors*size_vector);
+    // qtens_biharmonic is only needed within an Euler step, so it is part of the buffers
+    return m_geometry.num_elems() * (num_scalars*size_scalar + num_vectors*size_vector +
+                                     QSIZE_D*size_scalar);
   }
 
   void init_buffers (const FunctorsBuffersManager& fbm) {
@@ -222,6 +228,9 @@ public:
     mem += size_scalar*ne;
 
     m_buffers.vstar   = decltype(m_buffers.vstar)(mem,ne);
+    mem += 2*size_scalar*ne;
+
+    m_tracers.qtens_biharmonic = ExecViewUnmanaged<Scalar*[QSIZE_D][NP][NP][NUM_LEV]>(mem,ne);
   }
 
   void init_boundary_exchanges () {
@@ -258,6 +267,11 @@ public:
       m_mmqb_be = std::make_shared<BoundaryExchange>();
       m_mmqb_be->set_buffers_manager(bm_exchange);
       m_mmqb_be->set_num_fields(0, 0, m_data.qsize);
+#ifdef HOMMEXX_TRACER_HV_FP32_EXCHANGE
+      // The laplacian is an intermediate result, and can tolerate single
+      // precision. The biharmonic tendency still accumulates in full precision.
+      m_mmqb_be->set_register_as_fp32(true);
+#endif
       m_mmqb_be->register_field(m_tracers.qtens_biharmonic, m_data.qsize, 0);
       m_mmqb_be->registration_completed();
     }
@@ -422,6 +436,9 @@ public:
         m_geometry.num_elems(), m_tpref),
       *this);
     Kokkos::fence();
+#ifdef HOMMEXX_EULER_FUSED_DSS_PACK
+    m_dss_packer = m_bes[dss_be_idx()]->get_field_packer();
+#endif
     m_kernel_will_run_limiters = true;
     Kokkos::parallel_for(
       //to play with launch bounds
@@ -600,10 +617,18 @@ public:
     m_mm_be->exchange_min_max();
   }
 
+  int dss_be_idx () const {
+    return 3*m_data.np1_qdp + static_cast<int>(m_data.DSSopt);
+  }
+
   void exchange_qdp_dss_var () {
     GPTLstart("eus_bexch");
-    const int idx = 3*m_data.np1_qdp + static_cast<int>(m_data.DSSopt);
-    m_bes[idx]->exchange(m_geometry.m_rspheremp);
+#ifdef HOMMEXX_EULER_FUSED_DSS_PACK
+    // The tracers were packed by advect_and_limit; only the DSS var is left
+    m_bes[dss_be_idx()]->exchange_prepacked(m_data.qsize, m_geometry.m_rspheremp);
+#else
+    m_bes[dss_be_idx()]->exchange(m_geometry.m_rspheremp);
+#endif
     GPTLstop("eus_bexch");
   }
 
@@ -680,6 +705,15 @@ private:
     }
 
     apply_spheremp(kv);
+
+#ifdef HOMMEXX_EULER_FUSED_DSS_PACK
+    // qdp(np1) is still in cache right now, so pack it for the DSS here
+    // rather than in a separate pass of the exchange. The tracers are the
+    // first qsize 3d fields of the DSS boundary exchanges.
+    kv.team_barrier();
+    m_dss_packer(kv.team, kv.ie, kv.iq,
+                 Homme::subview(m_tracers.qdp, kv.ie, m_data.np1_qdp, kv.iq));
+#endif
   }
 
   KOKKOS_INLINE_FUNCTION
@@ -176,7 +176,21 @@ void GllFvRemapImpl
   const auto D_f = create_mirror_view(d.D_f);
   const auto Dinv_f = create_mirror_view(d.Dinv_f);
   const auto cD = create_mirror_view(m_geometry.m_d); deep_copy(cD, m_geometry.m_d);
-  const auto cDinv = create_mirror_view(m_geometry.m_dinv); deep_copy(cDinv, m_geometry.m_dinv);
+  // With a compact metric, Dinv is not stored, and we compute it from D
+  const auto cDinv = decltype(cD)("Dinv", d.nelemd);
+  if (ElementsGeometry::compact_metric()) {
+    for (int ie = 0; ie < d.nelemd; ++ie)
+      for (int i = 0; i < np; ++i)
+        for (int j = 0; j < np; ++j) {
+          const Real det = cD(ie,0,0,i,j)*cD(ie,1,1,i,j) - cD(ie,0,1,i,j)*cD(ie,1,0,i,j);
+          cDinv(ie,0,0,i,j) =  cD(ie,1,1,i,j)/det;
+          cDinv(ie,0,1,i,j) = -cD(ie,0,1,i,j)/det;
+          cDinv(ie,1,0,i,j) = -cD(ie,1,0,i,j)/det;
+          cDinv(ie,1,1,i,j) =  cD(ie,0,0,i,j)/det;
+        }
+  } else {
+    deep_copy(cDinv, m_geometry.m_dinv);
+  }
   for (int i = 0; i < nf2; ++i)
     for (int j = 0; j < np2; ++j)
       g2f_remapd(i,j) = fg2f_remapd(j,i);
@@ -317,6 +331,54 @@ g2f_mixing_ratio (const KernelVariables& kv, const int np2, const int nf2, const
   g::loop_ik(ttrf, tvr, [&] (int i, int k) { qf(i,iqf,k) = w2(i,k); });
 }
 
+#ifdef HOMMEXX_GFR_FUSED_TRACERS
+// g2f_mixing_ratio for tracers 0:nq-1 at once. The remap operator is applied
+// once to the right-hand side (np2, nq*nlev) formed by all the tracers, and
+// then the limiter runs on all (tracer, level) pairs in parallel. No work slot
+// is needed, and the result is BFB with calling g2f_mixing_ratio per tracer.
+template <typename RT, typename GS, typename GT, typename DS, typename DT,
+          typename QS, typename QT>
+static KOKKOS_FUNCTION void
+g2f_mixing_ratios (const KernelVariables& kv, const int np2, const int nf2, const int nlev,
+                   const int nq, const RT& g2f_remap, const GS& geog, const Real sf,
+                   const GT& geof, const DS& dpg, const DT& dpf, const QS& qg,
+                   const QT& qf) {
+  using g = GllFvRemapImpl;
+  const auto ttrfq = Kokkos::TeamThreadRange(kv.team, nf2*nq);
+  const auto tvr   = Kokkos::ThreadVectorRange(kv.team, nlev);
+
+  // Linearly remap qdp GLL->FV and divide by dp_fv.
+  g::loop_ik(ttrfq, tvr, [&] (int idx, int k) {
+    const int i = idx / nq, iq = idx % nq;
+    Scalar y(0);
+    for (int j = 0; j < np2; ++j)
+      y += g2f_remap(i,j) * ((dpg(j,k)*qg(iq,j,k)) * geog(j));
+    y /= sf * geof(i);
+    qf(i,iq,k) = y / dpf(i,k);
+  });
+  kv.team_barrier();
+
+  // Apply CAAS to the provisional q_f values, with bounds from the GLL values.
+  const g::MassWeights<GT,DT> c(sf, geof, dpf);
+  const int packn = g::packn;
+  g::team_parallel_for_with_linear_index(
+    kv.team, nq*nlev,
+    [&] (const int idx) {
+      const int iq = idx / nlev, k = idx % nlev;
+      Scalar qmink = qg(iq,0,k), qmaxk = qmink;
+      for (int i = 1; i < np2; ++i) {
+        const auto qik = qg(iq,i,k);
+        VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s)
+          qmink[s] = min(qmink[s], qik[s]);
+        VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s)
+          qmaxk[s] = max(qmaxk[s], qik[s]);
+      }
+      g::limiter_clip_and_sum_lev(nf2, k, c, qmink, qmaxk,
+                                  Kokkos::subview(qf, Kokkos::ALL(), iq, Kokkos::ALL()));
+    });
+}
+#endif
+
 template <typename RT, typename GS, typename GT, typename DS, typename DT, typename WT,
           typename QFT, typename QGT>
 static KOKKOS_FUNCTION void
@@ -527,10 +589,21 @@ void GllFvRemapImpl
     remapd(team, nf2, np2, nlevpk, g2f_remapd, gll_metdet_ie, w_ff, fv_metdet_ie,
            evucs_np2_nlev(&omega_g(ie,0,0,0)), evus_np2_nlev(rw1.data()),
            evus2(&omega(ie,0,0), nf2, nlevpk));
+
+#ifdef HOMMEXX_GFR_FUSED_TRACERS
+    // q
+    g2f_mixing_ratios(
+      kv, np2, nf2, nlevpk, qsize, g2f_remapd, gll_metdet_ie, w_ff, fv_metdet_ie,
+      evucs_np2_nlev(&dp3d(ie,timeidx,0,0,0)), dp_fv_ie,
+      ExecViewUnmanaged<const Scalar*[NP*NP][NUM_LEV]>(&q_g(ie,0,0,0,0), qsize),
+      evus3(&q(ie,0,0,0), q.extent_int(1), q.extent_int(2), q.extent_int(3)));
+#endif
   };
   Kokkos::fence();
   Kokkos::parallel_for(m_tp_ne, fe);
 
+#ifndef HOMMEXX_GFR_FUSED_TRACERS
+
   const auto dp_g = m_state.m_dp3d;
   const auto tu_ne_qsize = m_tu_ne_qsize;
   const auto feq = KOKKOS_LAMBDA (const MT& team) {
@@ -555,6 +628,7 @@ void GllFvRemapImpl
   Kokkos::fence();
   Kokkos::parallel_for(m_tp_ne_qsize, feq);
 #endif
+#endif
 }
 
 void GllFvRemapImpl::
@@ -873,10 +947,20 @@ void GllFvRemapImpl
       calc_dp_fv(team, hvcoord, nf2, nlevpk, EVU<Real*>(ps_v_fv_ie.data(), nf2),
                  dp_fv_ie);
     }
+
+#ifdef HOMMEXX_GFR_FUSED_TRACERS
+    kv.team_barrier();
+    g2f_mixing_ratios(
+      kv, np2, nf2, nlevpk, nq, g2f_remapd, gll_metdet_ie, w_ff, fv_metdet_ie,
+      evucs_np2_nlev(&dp3d(ie,timeidx,0,0,0)), dp_fv_ie,
+      Kokkos::subview(q_dyn, ie, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()),
+      evus3(&q_fv(ie,0,0,0), q_fv.extent_int(1), q_fv.extent_int(2), q_fv.extent_int(3)));
+#endif
   };
   Kokkos::fence();
   Kokkos::parallel_for(m_tp_ne, fe);
 
+#ifndef HOMMEXX_GFR_FUSED_TRACERS
   // q
   const auto dp_g = m_state.m_dp3d;
   const auto tp_ne_nq = Homme::get_default_team_policy<ExecSpace>(m_data.nelemd * nq);
@@ -901,6 +985,7 @@ void GllFvRemapImpl
   };
   Kokkos::fence();
   Kokkos::parallel_for(tp_ne_nq, feq);
+#endif
 #endif  
 }
 
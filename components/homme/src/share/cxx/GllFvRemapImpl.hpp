@@ -263,66 +263,92 @@ struct GllFvRemapImpl {
     assert(q  .extent_int(0) >= n && q  .extent_int(1) >= nlev);
     static_assert(Scalar::vector_length == packn, "vector_length == packn");
     const auto f = [&] (const int k) {
-      auto& c = wrk;
-      { // In the case of an infeasible problem, prefer to conserve mass and
-        // violate a bound.
-        Scalar mass(0), qmass(0);
-        for (int i = 0; i < n; ++i) {
-          c(i,k) = (s*geo(i))*dp(i,k);
-          mass  += c(i,k);
-          qmass += c(i,k)*q(i,k);
+      for (int i = 0; i < n; ++i)
+        wrk(i,k) = (s*geo(i))*dp(i,k);
+      limiter_clip_and_sum_lev(n, k, wrk, qmin(k), qmax(k), q);
+    };
+    team_parallel_for_with_linear_index(team, nlev, f);
+  }
+
+  // Level k of limiter_clip_and_sum given the mass weights c(i,k) = s geo(i)
+  // dp(i,k). c can be a view or a functor computing the weights on the fly.
+  template <typename CT, typename VQ>
+  static KOKKOS_INLINE_FUNCTION void
+  limiter_clip_and_sum_lev (const int n, const int k, const CT& c,
+                            Scalar& qmink, Scalar& qmaxk, const VQ& q) {
+    { // In the case of an infeasible problem, prefer to conserve mass and
+      // violate a bound.
+      Scalar mass(0), qmass(0);
+      for (int i = 0; i < n; ++i) {
+        const Scalar cik = c(i,k);
+        mass  += cik;
+        qmass += cik*q(i,k);
+      }
+      VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s)
+        if (qmass[s] < qmink[s]*mass[s])
+          qmink[s] = qmass[s]/mass[s];
+      VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s)
+        if (qmass[s] > qmaxk[s]*mass[s])
+          qmaxk[s] = qmass[s]/mass[s];
+    }
+
+    Scalar addmass(0);
+    bool modified[packn] = {0};
+    // Clip.
+    for (int i = 0; i < n; ++i) {
+      const Scalar cik = c(i,k);
+      VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s) {
+        auto& x = q(i,k)[s];
+        const auto xmin = qmink[s];
+        const auto xmax = qmaxk[s];
+        if (x > xmax) {
+          modified[s] = true;
+          addmass[s] += (x - xmax)*cik[s];
+          x = xmax;
+        } else if (x < xmin) {
+          modified[s] = true;
+          addmass[s] += (x - xmin)*cik[s];
+          x = xmin;
         }
-        VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s)
-          if (qmass[s] < qmin(k)[s]*mass[s])
-            qmin(k)[s] = qmass[s]/mass[s];
-        VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s)
-          if (qmass[s] > qmax(k)[s]*mass[s])
-            qmax(k)[s] = qmass[s]/mass[s];
       }
+    }
 
-      Scalar addmass(0);
-      bool modified[packn] = {0};
-      // Clip.
-      for (int i = 0; i < n; ++i)
-        VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s) {
-          auto& x = q(i,k)[s];
-          const auto xmin = qmin(k)[s];
-          const auto xmax = qmax(k)[s];
-          if (x > xmax) {
-            modified[s] = true;
-            addmass[s] += (x - xmax)*c(i,k)[s];
-            x = xmax;
-          } else if (x < xmin) {
-            modified[s] = true;
-            addmass[s] += (x - xmin)*c(i,k)[s];
-            x = xmin;
+    {
+      // Compute weights normalization.
+      Scalar den(0);
+      for (int i = 0; i < n; ++i) {
+        const Scalar cik = c(i,k);
+        VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s)
+          if (modified[s]) {
+            if (addmass[s] > 0)
+              den[s] += (qmaxk[s] - q(i,k)[s])*cik[s];
+            else
+              den[s] += (q(i,k)[s] - qmink[s])*cik[s];
           }
-        }
-
-      {
-        // Compute weights normalization.
-        Scalar den(0);
-        for (int i = 0; i < n; ++i)
-          VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s)
-            if (modified[s]) {
-              if (addmass[s] > 0)
-                den[s] += (qmax(k)[s] - q(i,k)[s])*c(i,k)[s];
-              else
-                den[s] += (q(i,k)[s] - qmin(k)[s])*c(i,k)[s];
-            }
-        // Redistribute mass.
-        for (int i = 0; i < n; ++i)
-          VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s)
-            if (modified[s] && den[s] > 0) {
-              auto& x = q(i,k)[s];
-              const auto v = addmass[s] > 0 ? qmax(k)[s] - x : x - qmin(k)[s];
-              x += addmass[s]*(v/den[s]);
-            }
       }
-    };
-    team_parallel_for_with_linear_index(team, nlev, f);
+      // Redistribute mass.
+      for (int i = 0; i < n; ++i)
+        VECTOR_SIMD_LOOP for (int s = 0; s < packn; ++s)
+          if (modified[s] && den[s] > 0) {
+            auto& x = q(i,k)[s];
+            const auto v = addmass[s] > 0 ? qmaxk[s] - x : x - qmink[s];
+            x += addmass[s]*(v/den[s]);
+          }
+    }
   }
 
+  // Mass weights s geo(i) dp(i,k) for limiter_clip_and_sum_lev, computed on
+  // the fly so that all tracers can share them without a work slot.
+  template <typename CR1, typename CV2>
+  struct MassWeights {
+    Real s; CR1 geo; CV2 dp;
+    KOKKOS_INLINE_FUNCTION MassWeights (const Real s_, const CR1& geo_, const CV2& dp_)
+      : s(s_), geo(geo_), dp(dp_) {}
+    KOKKOS_INLINE_FUNCTION Scalar operator() (const int i, const int k) const {
+      return (s*geo(i))*dp(i,k);
+    }
+  };
+
   template <typename CR1, typename VW, typename VQ>
   static KOKKOS_FUNCTION void
   limiter_clip_and_sum_real1 (const MT& team, const int n, const Real s, const CR1& geo,
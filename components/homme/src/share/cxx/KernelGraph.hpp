@@ -0,0 +1,85 @@
+/********************************************************************************
+ * HOMMEXX 1.0: Copyright of Sandia Corporation
+ * This software is released under the BSD license
+ * See the file 'COPYRIGHT' in the HOMMEXX/src/share/cxx directory
+ *******************************************************************************/
+
+#ifndef HOMMEXX_KERNEL_GRAPH_HPP
+#define HOMMEXX_KERNEL_GRAPH_HPP
+
+#include "Types.hpp"
+
+#include <Kokkos_Graph.hpp>
+
+#include <optional>
+#include <string>
+
+namespace Homme {
+
+/*
+ * KernelGraph records a fixed sequence of kernels into a Kokkos graph once,
+ * and then launches the whole sequence at once (as a CUDA/HIP graph on GPU),
+ * which removes the launch latency of the single kernels.
+ *
+ * While a graph is being captured, the kernels launched via
+ * KernelGraph::parallel_for are added to the graph in launch order, rather
+ * than being executed, and KernelGraph::fence does nothing. Outside of a
+ * capture, they are just Kokkos::parallel_for and Kokkos::fence.
+ *
+ * The graph holds copies of the functors, so it can only be replayed as long
+ * as the views and scalars stored in the functors are still the right ones.
+ * The captured sequence must not contain MPI calls, reductions, or host
+ * accesses to the results of the kernels.
+ */
+
+class KernelGraph {
+public:
+  // Records the kernels launched by the input callable, without running them
+  template<typename Kernels>
+  void capture (const Kernels& kernels) {
+    m_graph.reset();
+    auto graph = Kokkos::Experimental::create_graph(ExecSpace(),
+      [&](const auto& root) {
+        s_tail.emplace(root);
+        kernels();
+        s_tail.reset();
+      });
+    m_graph.emplace(std::move(graph));
+  }
+
+  bool is_captured () const { return m_graph.has_value(); }
+
+  // Launches the captured kernels. Like a kernel launch, it does not fence.
+  void submit () const { m_graph->submit(); }
+
+  void reset () { m_graph.reset(); }
+
+  static bool is_capturing () { return s_tail.has_value(); }
+
+  template<typename Policy, typename Functor>
+  static void parallel_for (const std::string& label, const Policy& policy, const Functor& functor) {
+    if (is_capturing()) {
+      s_tail = Node(s_tail->then_parallel_for(label,policy,functor));
+    } else {
+      Kokkos::parallel_for(label,policy,functor);
+    }
+  }
+
+  static void fence () {
+    if (!is_capturing()) {
+      Kokkos::fence();
+    }
+  }
+
+private:
+  using Node = Kokkos::Experimental::GraphNodeRef<ExecSpace>;
+
+  std::optional<Kokkos::Experimental::Graph<ExecSpace>> m_graph;
+
+  // The last kernel added to the graph being captured
+  inline static std::optional<Node> s_tail;
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_KERNEL_GRAPH_HPP
@@ -170,6 +170,10 @@ struct PpmVertRemap : public VertRemapAlg {
                 "boundary condition");
   const int gs = _ppm_consts::gs;
 
+  // Number of variables whose integration on the target grid is vectorized
+  // across in compute_remap_phase_batch.
+  enum : int { nvar_batch = 8 };
+
   explicit PpmVertRemap(const int num_elems, const int num_remap)
       : m_dpo("dpo", num_elems)
       , m_pio("pio", num_elems)
@@ -183,6 +187,10 @@ struct PpmVertRemap : public VertRemapAlg {
       , m_dma("dma", m_ppm_tu.get_num_ws_slots())
       , m_ai("ai", m_ppm_tu.get_num_ws_slots())
       , m_parabola_coeffs("Coefficients for the interpolating parabola", m_ppm_tu.get_num_ws_slots())
+      // The batched remap phase runs only on non-GPU architectures.
+      , m_mass_o_b("mass_o_b", OnGpu<ExecSpace>::value ? 0 : m_ppm_tu.get_num_ws_slots())
+      , m_parabola_coeffs_b("parabola_coeffs_b", OnGpu<ExecSpace>::value ? 0 : m_ppm_tu.get_num_ws_slots())
+      , m_remap_var_b("remap_var_b", OnGpu<ExecSpace>::value ? 0 : m_ppm_tu.get_num_ws_slots())
   {
     // Nothing to do here
   }
@@ -209,40 +217,7 @@ struct PpmVertRemap : public VertRemapAlg {
       const int igp = loop_idx / NP;
       const int jgp = loop_idx % NP;
 
-      Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_PHYSICAL_LEV),
-                           [&](const int k) {
-        const int ilevel = k / VECTOR_SIZE;
-        const int ivector = k % VECTOR_SIZE;
-        m_ao(kv.team_idx, igp, jgp, k + _ppm_consts::INITIAL_PADDING) =
-            remap_var(igp, jgp, ilevel)[ivector] /
-            m_dpo(kv.ie, igp, jgp, k + _ppm_consts::INITIAL_PADDING);
-      });
-
-      boundaries::fill_cell_means_gs(kv, Homme::subview(m_dpo, kv.ie, igp, jgp),
-                                     Homme::subview(m_ao, kv.team_idx, igp, jgp));
-
-      Dispatch<ExecSpace>::parallel_scan(
-          kv.team, NUM_PHYSICAL_LEV,
-          [=](const int &k, Real &accumulator, const bool last) {
-            // Accumulate the old mass up to old grid cell interface locations
-            // to simplify integration during remapping. Also, divide out the
-            // grid spacing so we're working with actual tracer values and can
-            // conserve mass.
-            const int ilevel = k / VECTOR_SIZE;
-            const int ivector = k % VECTOR_SIZE;
-            accumulator += remap_var(igp, jgp, ilevel)[ivector];
-            if (last) {
-              m_mass_o(kv.team_idx, igp, jgp, k + 1) = accumulator;
-            }
-      });
-
-      // Computes a monotonic and conservative PPM reconstruction
-      compute_ppm(kv,
-                  Homme::subview(m_ao, kv.team_idx, igp, jgp),
-                  Homme::subview(m_ppmdx, kv.ie, igp, jgp),
-                  Homme::subview(m_dma, kv.team_idx, igp, jgp),
-                  Homme::subview(m_ai, kv.team_idx, igp, jgp),
-                  Homme::subview(m_parabola_coeffs, kv.team_idx, igp, jgp));
+      compute_column_ppm(kv, igp, jgp, remap_var);
 
       compute_remap(kv,
                     Homme::subview(m_kid, kv.ie, igp, jgp),
@@ -255,6 +230,96 @@ struct PpmVertRemap : public VertRemapAlg {
     kv.team_barrier();
   }
 
+  // Remap variables 0:nvar-1, nvar <= nvar_batch, of element kv.ie, where
+  // get_var(v) returns the view of variable v. The PPM reconstruction is
+  // computed one variable at a time, as in compute_remap_phase. Then the mass
+  // integration on the target grid, whose cell indices and bounds are the same
+  // for all variables, runs once per column vectorized across the
+  // variables. The result is BFB with compute_remap_phase. This is meant for
+  // non-GPU architectures, where compute_remap is a serial loop over levels.
+  template <typename GetVar>
+  KOKKOS_INLINE_FUNCTION
+  void compute_remap_phase_batch(KernelVariables &kv, const int nvar,
+                                 const GetVar& get_var) const {
+    assert(nvar <= nvar_batch);
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int &loop_idx) {
+      const int igp = loop_idx / NP;
+      const int jgp = loop_idx % NP;
+
+      for (int v = 0; v < nvar; ++v) {
+        const ExecViewUnmanaged<Scalar[NP][NP][NUM_LEV]> remap_var = get_var(v);
+        compute_column_ppm(kv, igp, jgp, remap_var);
+        // Interleave this variable's mass and coefficients in the lanes.
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_PHYSICAL_LEV + 1),
+                             [&](const int k) {
+          m_mass_o_b(kv.team_idx, igp, jgp, k, v) = m_mass_o(kv.team_idx, igp, jgp, k);
+        });
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_PHYSICAL_LEV),
+                             [&](const int k) {
+          for (int c = 0; c < 3; ++c)
+            m_parabola_coeffs_b(kv.team_idx, igp, jgp, c, k, v) =
+              m_parabola_coeffs(kv.team_idx, igp, jgp, c, k);
+        });
+      }
+
+      compute_remap_batch(kv.team_idx, kv.ie, igp, jgp, nvar);
+
+      for (int v = 0; v < nvar; ++v) {
+        const ExecViewUnmanaged<Scalar[NP][NP][NUM_LEV]> remap_var = get_var(v);
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_PHYSICAL_LEV),
+                             [&](const int k) {
+          const int ilevel = k / VECTOR_SIZE;
+          const int ivector = k % VECTOR_SIZE;
+          remap_var(igp, jgp, ilevel)[ivector] = m_remap_var_b(kv.team_idx, igp, jgp, k, v);
+        });
+      }
+    }); // End team thread range
+    kv.team_barrier();
+  }
+
+  // Cell means, ghost cells, source mass accumulation, and PPM coefficients of
+  // remap_var in column (igp,jgp), stored in the workspace of team kv.team_idx.
+  KOKKOS_INLINE_FUNCTION
+  void compute_column_ppm(KernelVariables &kv, const int igp, const int jgp,
+                          ExecViewUnmanaged<Scalar[NP][NP][NUM_LEV]> remap_var)
+      const {
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_PHYSICAL_LEV),
+                         [&](const int k) {
+      const int ilevel = k / VECTOR_SIZE;
+      const int ivector = k % VECTOR_SIZE;
+      m_ao(kv.team_idx, igp, jgp, k + _ppm_consts::INITIAL_PADDING) =
+          remap_var(igp, jgp, ilevel)[ivector] /
+          m_dpo(kv.ie, igp, jgp, k + _ppm_consts::INITIAL_PADDING);
+    });
+
+    boundaries::fill_cell_means_gs(kv, Homme::subview(m_dpo, kv.ie, igp, jgp),
+                                   Homme::subview(m_ao, kv.team_idx, igp, jgp));
+
+    Dispatch<ExecSpace>::parallel_scan(
+        kv.team, NUM_PHYSICAL_LEV,
+        [=](const int &k, Real &accumulator, const bool last) {
+          // Accumulate the old mass up to old grid cell interface locations
+          // to simplify integration during remapping. Also, divide out the
+          // grid spacing so we're working with actual tracer values and can
+          // conserve mass.
+          const int ilevel = k / VECTOR_SIZE;
+          const int ivector = k % VECTOR_SIZE;
+          accumulator += remap_var(igp, jgp, ilevel)[ivector];
+          if (last) {
+            m_mass_o(kv.team_idx, igp, jgp, k + 1) = accumulator;
+          }
+    });
+
+    // Computes a monotonic and conservative PPM reconstruction
+    compute_ppm(kv,
+                Homme::subview(m_ao, kv.team_idx, igp, jgp),
+                Homme::subview(m_ppmdx, kv.ie, igp, jgp),
+                Homme::subview(m_dma, kv.team_idx, igp, jgp),
+                Homme::subview(m_ai, kv.team_idx, igp, jgp),
+                Homme::subview(m_parabola_coeffs, kv.team_idx, igp, jgp));
+  }
+
   KOKKOS_FORCEINLINE_FUNCTION
   Real compute_mass(const Real sq_coeff, const Real lin_coeff,
                     const Real const_coeff, const Real prev_mass,
@@ -344,6 +409,31 @@ struct PpmVertRemap : public VertRemapAlg {
     }); // k loop
   }
 
+  // compute_remap for the nvar variables interleaved in the lanes of the
+  // batched workspace of team team_idx.
+  KOKKOS_INLINE_FUNCTION
+  void compute_remap_batch(const int team_idx, const int ie, const int igp,
+                           const int jgp, const int nvar) const {
+    Real mass1[nvar_batch];
+    for (int v = 0; v < nvar_batch; ++v) mass1[v] = 0;
+    for (int k = 0; k < NUM_PHYSICAL_LEV; ++k) {
+      const int kk_cur_lev = m_kid(ie, igp, jgp, k);
+      assert(kk_cur_lev < NUM_PHYSICAL_LEV);
+      const Real x2_cur_lev = m_z2(ie, igp, jgp, k);
+      const Real prev_dp = m_dpo(ie, igp, jgp, kk_cur_lev + _ppm_consts::INITIAL_PADDING);
+      VECTOR_SIMD_LOOP
+      for (int v = 0; v < nvar; ++v) {
+        const Real mass2 = compute_mass(
+            m_parabola_coeffs_b(team_idx, igp, jgp, 2, kk_cur_lev, v),
+            m_parabola_coeffs_b(team_idx, igp, jgp, 1, kk_cur_lev, v),
+            m_parabola_coeffs_b(team_idx, igp, jgp, 0, kk_cur_lev, v),
+            m_mass_o_b(team_idx, igp, jgp, kk_cur_lev, v), prev_dp, x2_cur_lev);
+        m_remap_var_b(team_idx, igp, jgp, k, v) = mass2 - mass1[v];
+        mass1[v] = mass2;
+      }
+    }
+  }
+
   KOKKOS_INLINE_FUNCTION
   void compute_grids(KernelVariables &kv,
       const ExecViewUnmanaged<const Real[_ppm_consts::DPO_PHYSICAL_LEV]> dx,
@@ -666,6 +756,11 @@ struct PpmVertRemap : public VertRemapAlg {
   ExecViewManaged<Real * [NP][NP][_ppm_consts::DMA_PHYSICAL_LEV]> m_dma;
   ExecViewManaged<Real * [NP][NP][_ppm_consts::AI_PHYSICAL_LEV]> m_ai;
   ExecViewManaged<Real * [NP][NP][3][NUM_PHYSICAL_LEV]> m_parabola_coeffs;
+
+  // Workspace of compute_remap_phase_batch, with the variables in the lanes
+  ExecViewManaged<Real * [NP][NP][_ppm_consts::MASS_O_PHYSICAL_LEV][nvar_batch]> m_mass_o_b;
+  ExecViewManaged<Real * [NP][NP][3][NUM_PHYSICAL_LEV][nvar_batch]> m_parabola_coeffs_b;
+  ExecViewManaged<Real * [NP][NP][NUM_PHYSICAL_LEV][nvar_batch]> m_remap_var_b;
 };
 
 } // namespace Ppm
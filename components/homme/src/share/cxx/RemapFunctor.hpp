@@ -15,6 +15,7 @@
 #include "Elements.hpp"
 #include "Tracers.hpp"
 #include "HybridVCoord.hpp"
+#include "KernelGraph.hpp"
 #include "KernelVariables.hpp"
 #include "ColumnOps.hpp"
 #include "Types.hpp"
@@ -184,8 +185,8 @@ RemapStateAndThicknessProvider<true> {
   void preprocess_states (const int np1) {
     if (m_state_provider.num_states_preprocess()>0) {
       m_np1 = np1;
-      Kokkos::parallel_for("Pre-process states",m_policy_pre,*this);
-      Kokkos::fence();
+      KernelGraph::parallel_for("Pre-process states",m_policy_pre,*this);
+      KernelGraph::fence();
     }
   }
 
@@ -202,8 +203,8 @@ RemapStateAndThicknessProvider<true> {
   void postprocess_states (const int np1) {
     if (m_state_provider.num_states_postprocess()>0) {
       m_np1 = np1;
-      Kokkos::parallel_for("Post-process states",m_policy_post,*this);
-      Kokkos::fence();
+      KernelGraph::parallel_for("Post-process states",m_policy_post,*this);
+      KernelGraph::fence();
     }
   }
 
@@ -243,6 +244,10 @@ RemapStateAndThicknessProvider<true> {
 struct Remapper {
   virtual ~Remapper() {}
   virtual void run_remap(int np1, int np1_qdp, double dt) = 0;
+  // Same as above, but the kernels following the layer thickness check are
+  // recorded in the graph if it is empty, and the graph is replayed otherwise.
+  // The graph must only be reused for the same time levels and dt.
+  virtual void run_remap(int np1, int np1_qdp, double dt, KernelGraph& graph) = 0;
   virtual int requested_buffer_size () const = 0;
   virtual void init_buffers(const FunctorsBuffersManager& fbm) = 0;
 
@@ -345,6 +350,12 @@ struct RemapFunctor : public Remapper {
   KOKKOS_INLINE_FUNCTION
   int num_to_remap() const { return m_fields_provider.num_states_remap() + m_data.qsize; }
 
+  // Number of batches of variables in the batched remap phase.
+  KOKKOS_INLINE_FUNCTION
+  int num_remap_batches() const {
+    return (num_to_remap() + RemapType::nvar_batch - 1) / RemapType::nvar_batch;
+  }
+
   KOKKOS_INLINE_FUNCTION
   ExecViewUnmanaged<Scalar[NP][NP][NUM_LEV]>
   get_remap_val(const KernelVariables &kv, int var) const {
@@ -360,6 +371,8 @@ struct RemapFunctor : public Remapper {
   struct ComputeThicknessTag {};
   struct ComputeGridsTag {};
   struct ComputeRemapTag {};
+  // Remaps a batch of variables per team, on non-GPU architectures
+  struct ComputeRemapBatchTag {};
   // Computes the extrinsic values of the states in the initial map
   // i.e. velocity -> momentum
   struct ComputeExtrinsicsTag {};
@@ -421,6 +434,21 @@ struct RemapFunctor : public Remapper {
     this->m_remap.compute_remap_phase(kv, get_remap_val(kv, var));
   }
 
+  KOKKOS_INLINE_FUNCTION
+  void operator()(ComputeRemapBatchTag, const TeamMember &team) const {
+    KernelVariables kv(team, m_tu_ne_ntr);
+    assert(num_to_remap() != 0);
+    const int nbatch = num_remap_batches();
+    const int var0 = (kv.ie % nbatch) * RemapType::nvar_batch;
+    kv.ie /= nbatch;
+    assert(kv.ie < m_state.num_elems());
+
+    const int nvar = num_to_remap() - var0;
+    this->m_remap.compute_remap_phase_batch(
+        kv, nvar < RemapType::nvar_batch ? nvar : int(RemapType::nvar_batch),
+        [&](const int v) { return get_remap_val(kv, var0 + v); });
+  }
+
   KOKKOS_INLINE_FUNCTION
   void operator()(ComputeIntrinsicsTag, const TeamMember &team) const {
     KernelVariables kv(team, m_tu_ne_nsr);
@@ -455,6 +483,25 @@ struct RemapFunctor : public Remapper {
     run_remap();
   }
 
+  void run_remap(int np1, int np1_qdp, double dt, KernelGraph& graph) override {
+    m_data.np1 = np1;
+    m_data.np1_qdp = np1_qdp;
+    m_data.dt = dt;
+
+    run_functor<ComputeThicknessTag>("Remap Thickness Functor",
+                                     this->m_state.num_elems());
+    this->input_valid_assert();
+    if (!graph.is_captured()) {
+      graph.capture([&]() { run_remap_states(); });
+    }
+    GPTLstart("Remap Graph");
+    profiling_resume();
+    graph.submit();
+    Kokkos::fence();
+    profiling_pause();
+    GPTLstop("Remap Graph");
+  }
+
   void run_remap() {
     // This runs the remap algorithm after determining it needs to
     // It also verifies the state of the simulation is valid
@@ -462,6 +509,12 @@ struct RemapFunctor : public Remapper {
     run_functor<ComputeThicknessTag>("Remap Thickness Functor",
                                      this->m_state.num_elems());
     this->input_valid_assert();
+    run_remap_states();
+  }
+
+  // The kernels following the layer thickness check, which only depend on
+  // the time levels and dt
+  void run_remap_states() {
     if (num_to_remap() > 0) {
       // We don't want the latency of launching an empty kernel
       if (nonzero_rsplit) {
@@ -473,8 +526,12 @@ struct RemapFunctor : public Remapper {
       }
       run_functor<ComputeGridsTag>("Remap Compute Grids Functor",
                                    m_state.num_elems());
-      run_functor<ComputeRemapTag>("Remap Compute Remap Functor",
-                                   m_state.num_elems() * num_to_remap());
+      if (OnGpu<ExecSpace>::value)
+        run_functor<ComputeRemapTag>("Remap Compute Remap Functor",
+                                     m_state.num_elems() * num_to_remap());
+      else
+        run_functor<ComputeRemapBatchTag>("Remap Compute Remap Functor",
+                                          m_state.num_elems() * num_remap_batches());
       if (nonzero_rsplit) {
         run_functor<ComputeIntrinsicsTag>("Remap Rescale States Functor",
                                           m_state.num_elems() * m_fields_provider.num_states_remap());
@@ -483,7 +540,7 @@ struct RemapFunctor : public Remapper {
     }
 
     auto update_dp_policy = Kokkos::RangePolicy<ExecSpace,UpdateThicknessTag>(0,m_state.num_elems()*NP*NP*NUM_LEV);
-    Kokkos::parallel_for(update_dp_policy, *this);
+    KernelGraph::parallel_for("Remap Update Thickness", update_dp_policy, *this);
   }
 
   void remap1 (
@@ -504,12 +561,25 @@ struct RemapFunctor : public Remapper {
     };
     Kokkos::parallel_for(get_default_team_policy<ExecSpace>(ne), g);
     const auto tu_ne_ntr = m_tu_ne_ntr;
-    const auto r = KOKKOS_LAMBDA (const TeamMember& team) {
-      KernelVariables kv(team, nv, tu_ne_ntr);
-      remap.compute_remap_phase(kv, Kokkos::subview(v, kv.ie, kv.iq, ALL(), ALL(), ALL()));
-    };
     Kokkos::fence();
-    Kokkos::parallel_for(get_default_team_policy<ExecSpace>(ne*nv), r);
+    if (OnGpu<ExecSpace>::value) {
+      const auto r = KOKKOS_LAMBDA (const TeamMember& team) {
+        KernelVariables kv(team, nv, tu_ne_ntr);
+        remap.compute_remap_phase(kv, Kokkos::subview(v, kv.ie, kv.iq, ALL(), ALL(), ALL()));
+      };
+      Kokkos::parallel_for(get_default_team_policy<ExecSpace>(ne*nv), r);
+    } else {
+      const int nvb = RemapType::nvar_batch, nb = (nv + nvb - 1)/nvb;
+      const auto r = KOKKOS_LAMBDA (const TeamMember& team) {
+        KernelVariables kv(team, nb, tu_ne_ntr);
+        const int var0 = kv.iq*nvb;
+        remap.compute_remap_phase_batch(
+          kv, nv - var0 < nvb ? nv - var0 : nvb,
+          [&] (const int iv) -> ExecViewUnmanaged<Scalar[NP][NP][NUM_LEV]> {
+            return Kokkos::subview(v, kv.ie, var0 + iv, ALL(), ALL(), ALL()); });
+      };
+      Kokkos::parallel_for(get_default_team_policy<ExecSpace>(ne*nb), r);
+    }
   }
 
   void remap1 (
@@ -530,12 +600,25 @@ struct RemapFunctor : public Remapper {
     };
     Kokkos::parallel_for(get_default_team_policy<ExecSpace>(ne), g);
     const auto tu_ne_ntr = m_tu_ne_ntr;
-    const auto r = KOKKOS_LAMBDA (const TeamMember& team) {
-      KernelVariables kv(team, nv, tu_ne_ntr);
-      remap.compute_remap_phase(kv, Kokkos::subview(v, kv.ie, n_v, kv.iq, ALL(), ALL(), ALL()));
-    };
     Kokkos::fence();
-    Kokkos::parallel_for(get_default_team_policy<ExecSpace>(ne*nv), r);
+    if (OnGpu<ExecSpace>::value) {
+      const auto r = KOKKOS_LAMBDA (const TeamMember& team) {
+        KernelVariables kv(team, nv, tu_ne_ntr);
+        remap.compute_remap_phase(kv, Kokkos::subview(v, kv.ie, n_v, kv.iq, ALL(), ALL(), ALL()));
+      };
+      Kokkos::parallel_for(get_default_team_policy<ExecSpace>(ne*nv), r);
+    } else {
+      const int nvb = RemapType::nvar_batch, nb = (nv + nvb - 1)/nvb;
+      const auto r = KOKKOS_LAMBDA (const TeamMember& team) {
+        KernelVariables kv(team, nb, tu_ne_ntr);
+        const int var0 = kv.iq*nvb;
+        remap.compute_remap_phase_batch(
+          kv, nv - var0 < nvb ? nv - var0 : nvb,
+          [&] (const int iv) -> ExecViewUnmanaged<Scalar[NP][NP][NUM_LEV]> {
+            return Kokkos::subview(v, kv.ie, n_v, var0 + iv, ALL(), ALL(), ALL()); });
+      };
+      Kokkos::parallel_for(get_default_team_policy<ExecSpace>(ne*nb), r);
+    }
   }
 
   int requested_buffer_size () const override {
@@ -568,6 +651,10 @@ private:
   template <typename FunctorTag>
   void run_functor(const std::string functor_name, int num_exec) {
     const auto policy = remap_team_policy<FunctorTag>(num_exec);
+    if (KernelGraph::is_capturing()) {
+      KernelGraph::parallel_for("vertical remap", policy, *this);
+      return;
+    }
     // Timers don't work on CUDA, so place them here
     GPTLstart(functor_name.c_str());
     profiling_resume();
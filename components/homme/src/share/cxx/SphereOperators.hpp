@@ -48,6 +48,31 @@ class SphereOperators
     static constexpr int value = M > N ? N : M;
   };
 
+#ifdef HOMMEXX_COMPACT_METRIC
+  // With a compact metric, ElementsGeometry does not store D^{-1} and metinv,
+  // which are recomputed at each access from D: D^{-1} is the adjugate of D
+  // over det(D), and metinv = (D^T D)^{-1} = D^{-1} D^{-T}. With the transposed
+  // storage of the tensors in the C++ views, metinv(i,j) = sum_c Dinv(c,i)*Dinv(c,j).
+  struct ElemDinv {
+    ExecViewUnmanaged<const Real [2][2][NP][NP]> D;
+
+    KOKKOS_INLINE_FUNCTION
+    Real operator() (const int i, const int j, const int igp, const int jgp) const {
+      const Real det = D(0,0,igp,jgp)*D(1,1,igp,jgp) - D(0,1,igp,jgp)*D(1,0,igp,jgp);
+      return (i==j ? D(1-i,1-j,igp,jgp) : -D(i,j,igp,jgp)) / det;
+    }
+  };
+
+  struct ElemMetinv {
+    ElemDinv Dinv;
+
+    KOKKOS_INLINE_FUNCTION
+    Real operator() (const int i, const int j, const int igp, const int jgp) const {
+      return Dinv(0,i,igp,jgp)*Dinv(0,j,igp,jgp) + Dinv(1,i,igp,jgp)*Dinv(1,j,igp,jgp);
+    }
+  };
+#endif
+
   template<int NUM_LEVELS>
   using DefaultProvider = ExecViewUnmanaged<const Scalar [NP][NP][NUM_LEVELS]>;
 public:
@@ -137,7 +162,7 @@ public:
     // Make sure the buffers have been created
     assert (vector_buf_sl.size()>0);
 
-    const auto& D_inv = Homme::subview(m_dinv,kv.ie);
+    const auto D_inv = elem_dinv(kv.ie);
     const auto& temp_v_buf = Homme::subview(vector_buf_sl,kv.team_idx,0);
     constexpr int np_squared = NP * NP;
     // TODO: Use scratch space for this
@@ -176,7 +201,7 @@ public:
     assert (vector_buf_sl.size()>0);
 
     constexpr int np_squared = NP * NP;
-    const auto& D_inv = Homme::subview(m_dinv,kv.ie);
+    const auto D_inv = elem_dinv(kv.ie);
     const auto& temp_v_buf = Homme::subview(vector_buf_sl,kv.team_idx,0);
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, np_squared),
                          [&](const int loop_idx) {
@@ -214,7 +239,7 @@ public:
     assert (vector_buf_sl.size()>0);
 
     const auto& metdet = Homme::subview(m_metdet,kv.ie);
-    const auto& D_inv = Homme::subview(m_dinv,kv.ie);
+    const auto D_inv = elem_dinv(kv.ie);
     const auto& gv_buf = Homme::subview(vector_buf_sl,kv.team_idx,0);
     constexpr int np_squared = NP * NP;
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, np_squared),
@@ -252,7 +277,7 @@ public:
     // Make sure the buffers have been created
     assert (vector_buf_sl.size()>0);
 
-    const auto& D_inv = Homme::subview(m_dinv,kv.ie);
+    const auto D_inv = elem_dinv(kv.ie);
     const auto& spheremp = Homme::subview(m_spheremp,kv.ie);
     const auto& gv_buf = Homme::subview(vector_buf_sl,kv.team_idx,0);
 
@@ -389,7 +414,7 @@ public:
     // Make sure the buffers have been created
     assert (vector_buf_ml.size()>0);
 
-    const auto& D_inv = Homme::subview(m_dinv, kv.ie);
+    const auto D_inv = elem_dinv(kv.ie);
 
     constexpr int np_squared = NP * NP;
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, np_squared),
@@ -436,7 +461,7 @@ public:
     // Make sure the buffers have been created
     assert (vector_buf_ml.size()>0);
 
-    const auto& D_inv = Homme::subview(m_dinv, kv.ie);
+    const auto D_inv = elem_dinv(kv.ie);
     constexpr int np_squared = NP * NP;
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, np_squared),
                          [&](const int loop_idx) {
@@ -499,7 +524,7 @@ public:
     // Make sure the buffers have been created
     assert (vector_buf_ml.size()>0);
 
-    const auto& D_inv = Homme::subview(m_dinv, kv.ie);
+    const auto D_inv = elem_dinv(kv.ie);
     const auto& metdet = Homme::subview(m_metdet, kv.ie);
     vector_buf<NUM_LEV_OUT> gv_buf(Homme::subview(vector_buf_ml,kv.team_idx, 0).data());
     constexpr int np_squared = NP * NP;
@@ -566,7 +591,7 @@ public:
     // Make sure the buffers have been created
     assert (vector_buf_ml.size()>0);
 
-    const auto& D_inv = Homme::subview(m_dinv, kv.ie);
+    const auto D_inv = elem_dinv(kv.ie);
     const auto& metdet = Homme::subview(m_metdet, kv.ie);
     vector_buf<NUM_LEV_REQUEST> gv(Homme::subview(vector_buf_ml,kv.team_idx,0).data());
     constexpr int np_squared = NP * NP;
@@ -731,7 +756,7 @@ public:
     // Make sure the buffers have been created
     assert (vector_buf_ml.size()>0);
 
-    const auto& D_inv = Homme::subview(m_dinv, kv.ie);
+    const auto D_inv = elem_dinv(kv.ie);
     const auto& spheremp = Homme::subview(m_spheremp, kv.ie);
     constexpr int np_squared = NP * NP;
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, np_squared),
@@ -974,12 +999,17 @@ public:
     assert (vector_buf_ml.size()>0);
 
     const auto& D = Homme::subview(m_d, kv.ie);
-    const auto& metinv = Homme::subview(m_metinv, kv.ie);
+    const auto metinv = elem_metinv(kv.ie);
     const auto& metdet = Homme::subview(m_metdet, kv.ie);
     constexpr int np_squared = NP * NP;
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, np_squared), [&](const int loop_idx) {
       const int ngp = loop_idx / NP;
       const int mgp = loop_idx % NP;
+      // The metric terms do not depend on jgp and ilev
+      const Real mi00 = metinv(0,0,ngp,mgp);
+      const Real mi01 = metinv(0,1,ngp,mgp);
+      const Real mi10 = metinv(1,0,ngp,mgp);
+      const Real mi11 = metinv(1,1,ngp,mgp);
       Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_LEV_REQUEST), [&] (const int& ilev) {
         Scalar b0, b1;
         for (int jgp = 0; jgp < NP; ++jgp) {
@@ -990,10 +1020,10 @@ public:
           const auto& sjm = scalar(jgp,mgp,ilev);
           const auto& djm = dvv(jgp,mgp);
           const auto& djn = dvv(jgp,ngp);
-          b0 -= (mpnj * metinv(0,0,ngp,mgp) * md * snj * djm +
-                 mpjm * metinv(0,1,ngp,mgp) * md * sjm * djn);
-          b1 -= (mpnj * metinv(1,0,ngp,mgp) * md * snj * djm +
-                 mpjm * metinv(1,1,ngp,mgp) * md * sjm * djn);
+          b0 -= (mpnj * mi00 * md * snj * djm +
+                 mpjm * mi01 * md * sjm * djn);
+          b1 -= (mpnj * mi10 * md * snj * djm +
+                 mpjm * mi11 * md * sjm * djn);
         }
         grads(0,ngp,mgp,ilev) = (D(0,0,ngp,mgp) * b0 + D(1,0,ngp,mgp) * b1) * m_scale_factor_inv;
         grads(1,ngp,mgp,ilev) = (D(0,1,ngp,mgp) * b0 + D(1,1,ngp,mgp) * b1) * m_scale_factor_inv;
@@ -1173,6 +1203,25 @@ public:
   ExecViewManaged<const Real * [2][2][NP][NP]>  m_d;
   ExecViewManaged<const Real * [2][2][NP][NP]>  m_dinv;
 
+  // D^{-1} and metinv of an element, either stored or recomputed from D
+  KOKKOS_INLINE_FUNCTION
+  auto elem_dinv (const int ie) const {
+#ifdef HOMMEXX_COMPACT_METRIC
+    return ElemDinv{Homme::subview(m_d,ie)};
+#else
+    return Homme::subview(m_dinv,ie);
+#endif
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  auto elem_metinv (const int ie) const {
+#ifdef HOMMEXX_COMPACT_METRIC
+    return ElemMetinv{elem_dinv(ie)};
+#else
+    return Homme::subview(m_metinv,ie);
+#endif
+  }
+
   Real m_scale_factor_inv, m_laplacian_rigid_factor;
 };
 
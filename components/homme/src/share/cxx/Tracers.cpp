@@ -32,7 +32,8 @@ void Tracers::init(const int num_elems, const int num_tracers)
   nt = num_tracers;
 
   qdp = decltype(qdp)("tracers mass", num_elems);
-  qtens_biharmonic = decltype(qtens_biharmonic)("qtens(_biharmonic)", num_elems);
+  // qtens_biharmonic is not allocated here: it is scratch memory of the tracer
+  // transport functors, which set it in their copy of the tracers in init_buffers.
   qlim = decltype(qlim)("qlim", num_elems);
 
   Q = decltype(Q)("tracers concentration", num_elems,num_tracers);
@@ -49,7 +50,9 @@ void Tracers::randomize(const int seed, const Real min, const Real max) {
   std::uniform_real_distribution<Real> random_dist(min, max);
 
   genRandArray(qdp, engine, random_dist);
-  genRandArray(qtens_biharmonic, engine, random_dist);
+  if (qtens_biharmonic.size()>0) {
+    genRandArray(qtens_biharmonic, engine, random_dist);
+  }
   genRandArray(qlim, engine, random_dist);
   genRandArray(fq, engine, random_dist);
   genRandArray(Q, engine, random_dist);
@@ -35,7 +35,9 @@ struct Tracers {
   bool inited () const { return m_inited; }
 
   ExecViewManaged<Scalar*[Q_NUM_TIME_LEVELS][QSIZE_D][NP][NP][NUM_LEV]> qdp;
-  ExecViewManaged<Scalar*[QSIZE_D][NP][NP][NUM_LEV]>                    qtens_biharmonic; // Also doubles as just qtens.
+  // Also doubles as just qtens. Only the transport functors use it, as part of their
+  // FunctorsBuffersManager buffers, so it is not allocated in the context tracers.
+  ExecViewManaged<Scalar*[QSIZE_D][NP][NP][NUM_LEV]>                    qtens_biharmonic;
   ExecViewManaged<Scalar*[QSIZE_D][2][NUM_LEV]>                         qlim;
   ExecViewManaged<Scalar**[NP][NP][NUM_LEV]>                    Q;
   ExecViewManaged<Scalar**[NP][NP][NUM_LEV]>                    fq;
@@ -173,6 +173,9 @@ namespace Remap {
 // previously computed in compute_grids_phase.
 // It is also expected to have a large amount of parallelism, specifically
 // qsize * num_elems
+//
+// compute_remap_phase_batch remaps up to nvar_batch variables of an element
+// at once; it is used on non-GPU architectures.
 struct VertRemapAlg {};
 } // namespace Remap
 
@@ -11,9 +11,12 @@
 #include "Tracers.hpp"
 #include "HybridVCoord.hpp"
 #include "HommexxEnums.hpp"
+#include "KernelGraph.hpp"
 #include "RemapFunctor.hpp"
 #include "PpmRemap.hpp"
 
+#include <vector>
+
 namespace Homme {
 
 struct VerticalRemapManager::Impl {
@@ -66,6 +69,11 @@ struct VerticalRemapManager::Impl {
           "Error in VerticalRemapManager: unknown remap algorithm.\n",
           Errors::err_unknown_option);
     }
+
+#ifdef HOMMEXX_KERNEL_GRAPH
+    // The graphs hold copies of the remapper, so they must be recorded again
+    m_graphs = std::vector<KernelGraph>(NUM_TIME_LEVELS*Q_NUM_TIME_LEVELS);
+#endif
   }
 
   void setup (const Elements &e, const Tracers &t)
@@ -83,6 +91,13 @@ struct VerticalRemapManager::Impl {
   Elements         m_elements;
   Tracers          m_tracers;
   bool             m_remap_tracers;
+
+#ifdef HOMMEXX_KERNEL_GRAPH
+  // The remap kernels for each pair of dynamics and tracers np1 time levels,
+  // recorded the first time they are run with the time step m_graphs_dt
+  std::vector<KernelGraph> m_graphs;
+  double                   m_graphs_dt = 0;
+#endif
 };
 
 VerticalRemapManager::VerticalRemapManager(const bool remap_tracers)
@@ -125,7 +140,18 @@ void VerticalRemapManager::run_remap(int np1, int np1_qdp, double dt) const {
 
   assert(p_);
   assert(p_->remapper);
+#ifdef HOMMEXX_KERNEL_GRAPH
+  auto& graphs = p_->m_graphs;
+  if (dt != p_->m_graphs_dt) {
+    for (auto& graph : graphs) {
+      graph.reset();
+    }
+    p_->m_graphs_dt = dt;
+  }
+  p_->remapper->run_remap(np1, np1_qdp, dt, graphs[np1*Q_NUM_TIME_LEVELS + np1_qdp]);
+#else
   p_->remapper->run_remap(np1, np1_qdp, dt);
+#endif
 }
 
 struct TempTagStruct  {};
@@ -12,6 +12,10 @@
 
 #include "utilities/VectorUtils.hpp"
 
+#include <algorithm>
+#include <map>
+#include <set>
+
 #ifndef HOMME_BE_NO_HASHER
 // It's convenient and clean to use boundary exchanges as the place to hash
 // state. However, this interferes with the BoundaryExchange unit test's
@@ -42,6 +46,7 @@ BoundaryExchange::BoundaryExchange()
   m_num_2d_fields = 0;
   m_num_3d_fields = 0;
   m_num_3d_int_fields = 0;
+  m_num_3d_prepacked = 0;
 
   m_connectivity    = std::shared_ptr<Connectivity>();
   m_buffers_manager = std::shared_ptr<MpiBuffersManager>();
@@ -61,6 +66,21 @@ BoundaryExchange::BoundaryExchange()
   m_recv_pending = false;
 
   m_diagnostics_level = 0;
+
+#ifdef HOMMEXX_BE_UNPACK_ON_ARRIVAL
+  m_unpack_on_arrival = true;
+#else
+  m_unpack_on_arrival = false;
+#endif
+  m_num_arrival_boundary_elems = 0;
+
+  m_register_fp32 = false;
+
+#ifdef HOMMEXX_MPI_PIPELINED_STAGING
+  m_pipelined_staging = true;
+#else
+  m_pipelined_staging = false;
+#endif
 }
 
 BoundaryExchange::BoundaryExchange(std::shared_ptr<Connectivity> connectivity, std::shared_ptr<MpiBuffersManager> buffers_manager)
@@ -90,6 +110,28 @@ void BoundaryExchange::set_label (const std::string& label) { m_label = label; }
 const std::string& BoundaryExchange::get_label () const { return m_label; }
 void BoundaryExchange::set_diagnostics_level (const int level) { m_diagnostics_level = level; }
 
+void BoundaryExchange::set_register_as_fp32 (const bool fp32) {
+  assert (m_registration_started && !m_registration_completed);
+  m_register_fp32 = fp32;
+}
+
+int BoundaryExchange::get_3d_buf_nlev (const int ifield, const int nlev) const {
+  // Two floats fit in the space of one double
+  return (!m_3d_fp32.empty() && m_3d_fp32[ifield]) ? (nlev+1)/2 : nlev;
+}
+
+void BoundaryExchange::set_unpack_on_arrival (const bool unpack_on_arrival) {
+  // Don't change the strategy in the middle of an exchange
+  assert (!m_send_pending && !m_recv_pending);
+
+  if (unpack_on_arrival!=m_unpack_on_arrival) {
+    m_unpack_on_arrival = unpack_on_arrival;
+
+    // The unpack order is built together with the requests
+    m_buffer_views_and_requests_built = false;
+  }
+}
+
 void BoundaryExchange::set_connectivity (std::shared_ptr<Connectivity> connectivity)
 {
   // Functionality only available before registration starts
@@ -195,6 +237,7 @@ void BoundaryExchange::clean_up()
   m_num_2d_fields = 0;
   m_num_3d_fields = 0;
   m_num_3d_int_fields = 0;
+  m_num_3d_prepacked = 0;
 
   // If we clean up, we need to reset the number of fields
   m_registration_started   = false;
@@ -229,7 +272,7 @@ void BoundaryExchange::registration_completed()
 
   int single_ptr_buf_size = m_num_2d_fields + m_num_3d_int_fields*NUM_LEV_P*VECTOR_SIZE;
   for (int i = 0; i < m_num_3d_fields; ++i)
-    single_ptr_buf_size += m_3d_nlev_pack[i]*VECTOR_SIZE;
+    single_ptr_buf_size += get_3d_buf_nlev(i,m_3d_nlev_pack[i])*VECTOR_SIZE;
   m_elem_buf_size[etoi(ConnectionKind::CORNER)] = m_num_1d_fields*2*NUM_LEV*VECTOR_SIZE + single_ptr_buf_size * 1;
   m_elem_buf_size[etoi(ConnectionKind::EDGE)]   = m_num_1d_fields*2*NUM_LEV*VECTOR_SIZE + single_ptr_buf_size * NP;
 
@@ -258,6 +301,16 @@ void BoundaryExchange::registration_completed()
     if ( ! need_nlev_pack) m_3d_nlev_pack = decltype(m_3d_nlev_pack)();
   }
 
+  // Same for single precision fields
+  if (std::find(m_3d_fp32.begin(),m_3d_fp32.end(),1)!=m_3d_fp32.end()) {
+    m_3d_fp32_d = ExecViewManaged<int*>("m_3d_fp32_d", m_num_3d_fields);
+    const auto h = Kokkos::create_mirror_view(m_3d_fp32_d);
+    for (int i = 0; i < m_num_3d_fields; ++i) h(i) = m_3d_fp32[i];
+    Kokkos::deep_copy(m_3d_fp32_d, h);
+  } else {
+    m_3d_fp32 = decltype(m_3d_fp32)();
+  }
+
   // Prohibit further registration of fields, and allow exchange
   m_registration_started   = false;
   m_registration_completed = true;
@@ -318,6 +371,39 @@ void BoundaryExchange::exchange (const ExecViewUnmanaged<const Real * [NP][NP]>*
 #endif
 }
 
+BoundaryExchange::FieldPacker BoundaryExchange::get_field_packer ()
+{
+  assert (m_registration_completed);
+  assert (m_exchange_type==MPI_EXCHANGE);
+  Errors::runtime_check(m_3d_nlev_pack_d.size() == 0 && m_3d_fp32_d.size() == 0,
+                        "BoundaryExchange::get_field_packer: partial-column and FP32 fields are not supported");
+
+  // The kernel writes the send buffers right away, so nobody else can be using them
+  assert (!m_buffers_manager->are_buffers_busy());
+  if (!m_buffer_views_and_requests_built) {
+    build_buffer_views_and_requests();
+  }
+
+  FieldPacker packer;
+  packer.ucon = m_connectivity->get_d_ucon();
+  packer.ucon_ptr = m_connectivity->get_d_ucon_ptr();
+  packer.send_3d_buffers = m_send_3d_buffers;
+  return packer;
+}
+
+void BoundaryExchange::exchange_prepacked (const int num_3d_prepacked,
+                                           ExecViewUnmanaged<const Real * [NP][NP]> rspheremp)
+{
+  assert (num_3d_prepacked >= 0 && num_3d_prepacked <= m_num_3d_fields);
+  // If the buffers have been reallocated since get_field_packer, the packed data is lost
+  Errors::runtime_check(m_buffer_views_and_requests_built,
+                        "BoundaryExchange::exchange_prepacked: buffers were reallocated after get_field_packer");
+
+  m_num_3d_prepacked = num_3d_prepacked;
+  exchange(&rspheremp);
+  m_num_3d_prepacked = 0;
+}
+
 void BoundaryExchange::exchange_min_max ()
 {
   // Check that the registration has completed first
@@ -365,15 +451,18 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
       const ExecViewUnmanaged<const int*> ucon_ptr,
       const ExecViewUnmanaged<ExecViewManaged<Real[NP][NP]>**> fields_2d,
       const ExecViewUnmanaged<ExecViewUnmanaged<Real*>**> send_2d_buffers,
-      const int num_elems, const int num_2d_fields) {
+      const int num_elems, const int num_2d_fields, const int sharing) {
   HOMMEXX_STATIC const ConnectionHelpers helpers;
   const int nconn = ucon.extent_int(0);
+  const bool all = sharing == etoi(ConnectionSharing::ANY);
   Kokkos::parallel_for(
     Kokkos::RangePolicy<ExecSpace>(0, num_2d_fields*nconn),
     KOKKOS_LAMBDA(const int it) {
       const int iconn = it / num_2d_fields;
       const int ifield = it % num_2d_fields;
       const auto& info = ucon(iconn);
+      if (!all && info.sharing != sharing)
+        return;
       const int buffer_iconn = (info.sharing == etoi(ConnectionSharing::LOCAL) ?
                                 info.sharing_local_remote_iconn :
                                 iconn);
@@ -385,43 +474,76 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
     });
 }
 
+// Fields exchanged in single precision are stored in the buffers as contiguous floats:
+// level pack ilev of the k-th connection point occupies the floats
+// [ilev*VECTOR_SIZE,(ilev+1)*VECTOR_SIZE) of the k-th buffer row.
+KOKKOS_INLINE_FUNCTION
+static bool is_fp32 (const ExecViewUnmanaged<const int*>& fp32, const int ifield) {
+  return fp32.size()>0 && fp32(ifield)!=0;
+}
+
+KOKKOS_INLINE_FUNCTION
+static void store_fp32 (Scalar* const row, const int ilev, const Scalar& val) {
+  float* const dst = reinterpret_cast<float*>(row) + ilev*VECTOR_SIZE;
+  for (int i = 0; i < VECTOR_SIZE; ++i) dst[i] = val[i];
+}
+
+KOKKOS_INLINE_FUNCTION
+static void add_fp32 (Scalar& val, const Scalar* const row, const int ilev) {
+  const float* const src = reinterpret_cast<const float*>(row) + ilev*VECTOR_SIZE;
+  for (int i = 0; i < VECTOR_SIZE; ++i) val[i] += src[i];
+}
+
 template <int NUM_LEV_PACKS, bool partial_column=false>
 static void
 pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> ucon,
       const ExecViewUnmanaged<const int*> ucon_ptr,
       const ExecViewUnmanaged<ExecViewManaged<Scalar[NP][NP][NUM_LEV_PACKS]>**> fields_3d,
       const ExecViewUnmanaged<ExecViewUnmanaged<Scalar**>**> send_3d_buffers,
-      const int num_elems, const int num_3d_fields,
-      ExecViewManaged<int*>* nlev_packs_ = nullptr) {
+      const int num_elems, const int num_3d_fields, const int sharing,
+      const ExecViewUnmanaged<const int*> fp32,
+      ExecViewManaged<int*>* nlev_packs_ = nullptr,
+      const int ifield_beg = 0) {
   assert(partial_column == (nlev_packs_ != nullptr));
   if (partial_column) assert(nlev_packs_->extent_int(0) == num_3d_fields);
   ExecViewUnmanaged<const int*> nlev_packs;
   if (partial_column) nlev_packs = *nlev_packs_;
+  const bool all = sharing == etoi(ConnectionSharing::ANY);
+  // Only fields [ifield_beg,num_3d_fields) are packed
+  const int nfields = num_3d_fields - ifield_beg;
+  if (nfields == 0) return;
   if (OnGpu<ExecSpace>::value) {
     const ConnectionHelpers helpers;
     const int nconn = ucon.extent_int(0);
     Kokkos::parallel_for(
-      Kokkos::RangePolicy<ExecSpace>(0, num_3d_fields*nconn*NUM_LEV_PACKS),
+      Kokkos::RangePolicy<ExecSpace>(0, nfields*nconn*NUM_LEV_PACKS),
       KOKKOS_LAMBDA(const int it) {
         const int ilev = it % NUM_LEV_PACKS;
-        const int ifield = (it / NUM_LEV_PACKS) % num_3d_fields;
+        const int ifield = ifield_beg + (it / NUM_LEV_PACKS) % nfields;
         if (partial_column) { // compile out if !partial_column
           if (ilev >= nlev_packs(ifield))
             return;
         }
-        const int iconn = it / (num_3d_fields*NUM_LEV_PACKS);
+        const int iconn = it / (nfields*NUM_LEV_PACKS);
         const auto& info = ucon(iconn);
+        if (!all && info.sharing != sharing)
+          return;
         const int buffer_iconn = (info.sharing == etoi(ConnectionSharing::LOCAL) ?
                                   info.sharing_local_remote_iconn :
                                   iconn);
         const auto& pts = helpers.CONNECTION_PTS[info.direction][info.local_dir];
         const auto& sb = send_3d_buffers(ifield, buffer_iconn);
         const auto& f3 = fields_3d(info.local_lid, ifield);
-        for (int k = 0; k < helpers.CONNECTION_SIZE[info.kind]; ++k)
-          sb(k, ilev) = f3(pts[k].ip, pts[k].jp, ilev);
+        if (is_fp32(fp32, ifield)) {
+          for (int k = 0; k < helpers.CONNECTION_SIZE[info.kind]; ++k)
+            store_fp32(&sb(k, 0), ilev, f3(pts[k].ip, pts[k].jp, ilev));
+        } else {
+          for (int k = 0; k < helpers.CONNECTION_SIZE[info.kind]; ++k)
+            sb(k, ilev) = f3(pts[k].ip, pts[k].jp, ilev);
+        }
       });
   } else {
-    const auto num_parallel_iterations = num_elems*num_3d_fields;
+    const auto num_parallel_iterations = num_elems*nfields;
     ThreadPreferences tp;
     tp.max_threads_usable = NP;
     tp.max_vectors_usable = NUM_LEV_PACKS;
@@ -433,15 +555,17 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
     HOMMEXX_STATIC const ConnectionHelpers helpers;
     Kokkos::parallel_for(policy,
       KOKKOS_LAMBDA(const TeamMember& team) {
-        Homme::KernelVariables kv(team, num_3d_fields);
+        Homme::KernelVariables kv(team, nfields);
         const int ie = kv.ie;
-        const int ifield = kv.iq;
+        const int ifield = ifield_beg + kv.iq;
         const auto tvr = Kokkos::ThreadVectorRange(
           kv.team, partial_column ? nlev_packs(ifield) : NUM_LEV_PACKS);
         const int iconn_end = ucon_ptr(ie+1);
         for (int iconn = ucon_ptr(ie); iconn < iconn_end; ++iconn) {
           const auto& info = ucon(iconn);
           assert(info.kind != etoi(ConnectionSharing::MISSING));
+          if (!all && info.sharing != sharing)
+            continue;
           const int buffer_iconn = (info.sharing == etoi(ConnectionSharing::LOCAL) ?
                                     info.sharing_local_remote_iconn :
                                     iconn);
@@ -449,19 +573,114 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
           const auto& sb = send_3d_buffers(ifield, buffer_iconn);
           assert(info.local_lid == ie);
           const auto& f3 = fields_3d(ie, ifield);
+          const bool single = is_fp32(fp32, ifield);
           Kokkos::parallel_for(
             Kokkos::TeamThreadRange(kv.team, helpers.CONNECTION_SIZE[info.kind]),
             [&] (const int& k) {
               auto* const sbp = &sb(k, 0);
               const auto* const f3p = &f3(pts[k].ip, pts[k].jp, 0);
-              Kokkos::parallel_for(tvr, [&] (const int& ilev) { sbp[ilev] = f3p[ilev]; });
+              if (single)
+                Kokkos::parallel_for(tvr, [&] (const int& ilev) { store_fp32(sbp, ilev, f3p[ilev]); });
+              else
+                Kokkos::parallel_for(tvr, [&] (const int& ilev) { sbp[ilev] = f3p[ilev]; });
             });
         }
       });
   }
 }
 
+void BoundaryExchange::exchange_begin ()
+{
+  // Check that the registration has completed first
+  assert (m_registration_completed);
+
+  // Check that this object is setup to perform exchange and not exchange_min_max
+  assert (m_exchange_type==MPI_EXCHANGE);
+
+  if (m_num_2d_fields+m_num_3d_fields+m_num_3d_int_fields==0) {
+    return;
+  }
+
+  if (!m_buffer_views_and_requests_built) {
+    build_buffer_views_and_requests();
+  }
+
+  // Start receiving right away, like in exchange
+  if ( ! m_recv_requests.empty())
+    HOMMEXX_MPI_CHECK_ERROR(MPI_Startall(m_recv_requests.size(), m_recv_requests.data()),
+                            m_connectivity->get_comm().mpi_comm());
+  m_recv_pending = true;
+
+  // Local connections are packed in exchange_end, once all elements are up to date
+  pack_and_send (ConnectionSharing::SHARED);
+}
+
+void BoundaryExchange::exchange_end () {
+  exchange_end(nullptr);
+}
+
+void BoundaryExchange::exchange_end (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp) {
+  exchange_end(&rspheremp);
+}
+
+void BoundaryExchange::exchange_end (const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp)
+{
+  if (m_num_2d_fields+m_num_3d_fields+m_num_3d_int_fields==0) {
+    return;
+  }
+
+  // exchange_begin must have been called first
+  assert (m_send_pending);
+
+#ifndef HOMME_BE_NO_HASHER
+  if (m_diagnostics_level > 1)
+    Homme::print_global_state_hash(std::string("BE-pre-") + m_label);
+#endif
+
+  tstart("be pack local");
+  pack_fields (ConnectionSharing::LOCAL);
+  Kokkos::fence();
+  tstop("be pack local");
+
+  recv_and_unpack (rspheremp);
+
+#ifndef HOMME_BE_NO_HASHER
+  if (m_diagnostics_level > 0)
+    Homme::print_global_state_hash(std::string("BE-post-") + m_label);
+#endif
+}
+
+void BoundaryExchange::pack_fields (const ConnectionSharing sharing)
+{
+  const auto& ucon = m_connectivity->get_d_ucon();
+  const auto& ucon_ptr = m_connectivity->get_d_ucon_ptr();
+  const int isharing = etoi(sharing);
+  // First, pack 2d fields (if any)...
+  if (m_num_2d_fields > 0)
+    pack(ucon, ucon_ptr, m_2d_fields, m_send_2d_buffers, m_num_elems,
+         m_num_2d_fields, isharing);
+  // ...then pack 3d fields (if any), except those already packed by the caller...
+  if (m_num_3d_fields > m_num_3d_prepacked) {
+    if (m_3d_nlev_pack_d.size() > 0)
+      pack<NUM_LEV, true>(ucon, ucon_ptr, m_3d_fields, m_send_3d_buffers,
+                          m_num_elems, m_num_3d_fields, isharing, m_3d_fp32_d, &m_3d_nlev_pack_d);
+    else
+      pack<NUM_LEV>(ucon, ucon_ptr, m_3d_fields, m_send_3d_buffers,
+                    m_num_elems, m_num_3d_fields, isharing, m_3d_fp32_d, nullptr,
+                    m_num_3d_prepacked);
+  }
+  // ...then pack 3d interface fields (if any)
+  if (m_num_3d_int_fields > 0)
+    pack<NUM_LEV_P>(ucon, ucon_ptr, m_3d_int_fields, m_send_3d_int_buffers,
+                    m_num_elems, m_num_3d_int_fields, isharing, ExecViewUnmanaged<const int*>());
+}
+
 void BoundaryExchange::pack_and_send ()
+{
+  pack_and_send (ConnectionSharing::ANY);
+}
+
+void BoundaryExchange::pack_and_send (const ConnectionSharing sharing)
 {
   tstart("be pack_and_send");
   // The registration MUST be completed by now
@@ -490,35 +709,22 @@ void BoundaryExchange::pack_and_send ()
   }
 
   // ---- Pack ---- //
-  const auto& ucon = m_connectivity->get_d_ucon();
-  const auto& ucon_ptr = m_connectivity->get_d_ucon_ptr();
-  // First, pack 2d fields (if any)...
-  if (m_num_2d_fields > 0)
-    pack(ucon, ucon_ptr, m_2d_fields, m_send_2d_buffers, m_num_elems,
-         m_num_2d_fields);
-  // ...then pack 3d fields (if any)...
-  if (m_num_3d_fields > 0) {
-    if (m_3d_nlev_pack_d.size() > 0)
-      pack<NUM_LEV, true>(ucon, ucon_ptr, m_3d_fields, m_send_3d_buffers,
-                          m_num_elems, m_num_3d_fields, &m_3d_nlev_pack_d);
-    else
-      pack<NUM_LEV>(ucon, ucon_ptr, m_3d_fields, m_send_3d_buffers,
-                    m_num_elems, m_num_3d_fields);
-  }
-  // ...then pack 3d interface fields (if any)
-  if (m_num_3d_int_fields > 0)
-    pack<NUM_LEV_P>(ucon, ucon_ptr, m_3d_int_fields, m_send_3d_int_buffers,
-                    m_num_elems, m_num_3d_int_fields);
+  pack_fields (sharing);
   Kokkos::fence();
 
   // ---- Send ---- //
-  tstart("be sync_send_buffer");
-  m_buffers_manager->sync_send_buffer(this); // Deep copy send_buffer into mpi_send_buffer (no op if MPI is on device)
-  tstop("be sync_send_buffer");
-  tstart("be send");
-  if ( ! m_send_requests.empty())
-    HOMMEXX_MPI_CHECK_ERROR(MPI_Startall(m_send_requests.size(), m_send_requests.data()),
-                            m_connectivity->get_comm().mpi_comm());
+  if (use_pipelined_staging()) {
+    tstart("be send");
+    send_pipelined();
+  } else {
+    tstart("be sync_send_buffer");
+    m_buffers_manager->sync_send_buffer(this); // Deep copy send_buffer into mpi_send_buffer (no op if MPI is on device)
+    tstop("be sync_send_buffer");
+    tstart("be send");
+    if ( ! m_send_requests.empty())
+      HOMMEXX_MPI_CHECK_ERROR(MPI_Startall(m_send_requests.size(), m_send_requests.data()),
+                              m_connectivity->get_comm().mpi_comm());
+  }
 
   // Notify a send is ongoing
   m_send_pending = true;
@@ -529,6 +735,13 @@ void BoundaryExchange::recv_and_unpack () {
   recv_and_unpack(nullptr);
 }
 
+// If elems is not empty, it contains the local ids of the elements to unpack,
+// otherwise all elements are unpacked, in order.
+KOKKOS_INLINE_FUNCTION
+static int elem_id (const ExecViewUnmanaged<const int*>& elems, const int i) {
+  return elems.size()>0 ? elems(i) : i;
+}
+
 // assume:conn-edges-snwe
 static void
 unpack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> ucon,
@@ -536,12 +749,13 @@ unpack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> u
         const ExecViewUnmanaged<ExecViewManaged<Real[NP][NP]>**> fields_2d,
         const ExecViewUnmanaged<ExecViewUnmanaged<Real*>**> recv_2d_buffers,
         const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp,
-        const int num_elems, const int num_2d_fields) {
+        const int num_elems, const int num_2d_fields,
+        const ExecViewUnmanaged<const int*> elems) {
   HOMMEXX_STATIC const ConnectionHelpers helpers;
   Kokkos::parallel_for(
     Kokkos::RangePolicy<ExecSpace>(0, num_elems*num_2d_fields),
     KOKKOS_LAMBDA(const int it) {
-      const int ie = it / num_2d_fields;
+      const int ie = elem_id(elems, it / num_2d_fields);
       const int ifield = it % num_2d_fields;
       const auto iconn_beg = ucon_ptr(ie), iconn_end = ucon_ptr(ie+1);
       const auto& f2 = fields_2d(ie, ifield);
@@ -565,7 +779,7 @@ unpack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> u
     Kokkos::parallel_for(
       Kokkos::RangePolicy<ExecSpace>(0, num_elems*num_2d_fields*NP*NP),
       KOKKOS_LAMBDA(const int it) {
-        const int ie = it / (num_2d_fields*NP*NP);
+        const int ie = elem_id(elems, it / (num_2d_fields*NP*NP));
         const int ifield = (it / (NP*NP)) % num_2d_fields;
         const int i = (it / NP) % NP;
         const int j = it % NP;
@@ -583,6 +797,8 @@ unpack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> u
         const ExecViewUnmanaged<ExecViewUnmanaged<Scalar**>**> recv_3d_buffers,
         const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp,
         const int num_elems, const int num_3d_fields,
+        const ExecViewUnmanaged<const int*> elems,
+        const ExecViewUnmanaged<const int*> fp32,
         ExecViewManaged<int*>* nlev_packs_ = nullptr) {
   assert(partial_column == (nlev_packs_ != nullptr));
   if (partial_column) assert(nlev_packs_->extent_int(0) == num_3d_fields);
@@ -599,9 +815,25 @@ unpack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> u
           if (ilev >= nlev_packs(ifield))
             return;
         }
-        const int ie = it / (num_3d_fields*NUM_LEV_PACKS);
+        const int ie = elem_id(elems, it / (num_3d_fields*NUM_LEV_PACKS));
         const auto iconn_beg = ucon_ptr(ie);
         const auto& f3 = fields_3d(ie, ifield);
+        const auto iconn_end = ucon_ptr(ie+1);
+        if (is_fp32(fp32, ifield)) {
+          for (int k = 0; k < NP; ++k) {
+            for (const int iedge : helpers.UNPACK_EDGES_ORDER) {
+              const auto& pts = helpers.CONNECTION_PTS_FWD[iedge][k];
+              add_fp32(f3(pts.ip, pts.jp, ilev),
+                       &recv_3d_buffers(ifield, iconn_beg + iedge)(k, 0), ilev);
+            }
+          }
+          for (int iconn = iconn_beg + 4; iconn < iconn_end; ++iconn) {
+            const auto& pts = helpers.CONNECTION_PTS_FWD[ucon(iconn).local_dir][0];
+            add_fp32(f3(pts.ip, pts.jp, ilev),
+                     &recv_3d_buffers(ifield, iconn)(0, 0), ilev);
+          }
+          return;
+        }
         for (int k = 0; k < NP; ++k) {
           for (const int iedge : helpers.UNPACK_EDGES_ORDER) {
             const auto& pts = helpers.CONNECTION_PTS_FWD[iedge][k];
@@ -609,7 +841,6 @@ unpack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> u
               recv_3d_buffers(ifield, iconn_beg + iedge)(k, ilev);
           }
         }
-        const auto iconn_end = ucon_ptr(ie+1);
         for (int iconn = iconn_beg + 4; iconn < iconn_end; ++iconn) {
           const auto& pts = helpers.CONNECTION_PTS_FWD[ucon(iconn).local_dir][0];
           f3(pts.ip, pts.jp, ilev) +=
@@ -622,7 +853,7 @@ unpack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> u
       Kokkos::parallel_for(
         Kokkos::RangePolicy<ExecSpace>(0, num_elems*num_3d_fields*NP*NP*NUM_LEV_PACKS),
         KOKKOS_LAMBDA(const int it) {
-          const int ie = it / (num_3d_fields*NUM_LEV_PACKS*NP*NP);
+          const int ie = elem_id(elems, it / (num_3d_fields*NUM_LEV_PACKS*NP*NP));
           const int ifield = (it / (NP*NP*NUM_LEV_PACKS)) % num_3d_fields;
           const int i = (it / (NP*NUM_LEV_PACKS)) % NP;
           const int j = (it / NUM_LEV_PACKS) % NP;
@@ -637,17 +868,24 @@ unpack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> u
       Kokkos::TeamPolicy<ExecSpace>(num_parallel_iterations, 1, NUM_LEV_PACKS),
       KOKKOS_LAMBDA(const TeamMember& team) {
         Homme::KernelVariables kv(team, num_3d_fields);
-        const int ie = kv.ie;
+        const int ie = elem_id(elems, kv.ie);
         const int ifield = kv.iq;
         const auto tvr = Kokkos::ThreadVectorRange(
           kv.team, partial_column ? nlev_packs(ifield) : NUM_LEV_PACKS);
         const auto& f3 = fields_3d(ie, ifield);
         const auto iconn_beg = ucon_ptr(ie), iconn_end = ucon_ptr(ie+1);
+        const bool single = is_fp32(fp32, ifield);
+        const auto add = [&] (Scalar* const f3p, const Scalar* const r3p) {
+          if (single)
+            Kokkos::parallel_for(tvr, [&] (const int& ilev) { add_fp32(f3p[ilev], r3p, ilev); });
+          else
+            Kokkos::parallel_for(tvr, [&] (const int& ilev) { f3p[ilev] += r3p[ilev]; });
+        };
         const auto ef = [&] (const int& iedge, const int& k, const int& ip, const int& jp) {
           const auto& r3 = recv_3d_buffers(ifield, iconn_beg + iedge);
           auto* const f3p = &f3(ip, jp, 0);
           const auto* const r3p = &r3(k, 0);
-          Kokkos::parallel_for(tvr, [&] (const int& ilev) { f3p[ilev] += r3p[ilev]; });
+          add(f3p, r3p);
         };
         for (int k = 0; k < NP; ++k) {
           ef(0, k, 0,    k   );
@@ -662,7 +900,7 @@ unpack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> u
                                 helpers.CONNECTION_PTS_FWD[dir][0].jp, 0);
           assert(r3.size() > 0);
           const auto* const r3p = &r3(0, 0);
-          Kokkos::parallel_for(tvr, [&] (const int& ilev) { f3p[ilev] += r3p[ilev]; });
+          add(f3p, r3p);
         }
         if (rspheremp) {
           for (int i = 0; i < NP; ++i)
@@ -708,39 +946,28 @@ void BoundaryExchange::recv_and_unpack (const ExecViewUnmanaged<const Real * [NP
   }
   tstop("be recv_and_unpack book");
 
-  // ---- Recv ---- //
-  tstart("be recv waitall");
-  if ( ! m_recv_requests.empty())
-    HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(m_recv_requests.size(), m_recv_requests.data(), MPI_STATUSES_IGNORE),
-                            m_connectivity->get_comm().mpi_comm()); // Wait for all data to arrive
-  m_recv_pending = false;
-  tstop("be recv waitall");
+  if (m_unpack_on_arrival && !m_recv_requests.empty()) {
+    recv_and_unpack_on_arrival (rspheremp);
+  } else if (use_pipelined_staging() && !m_recv_requests.empty()) {
+    recv_pipelined();
+    unpack_elems (rspheremp, ExecViewUnmanaged<const int*>(), m_num_elems);
+  } else {
+    // ---- Recv ---- //
+    tstart("be recv waitall");
+    if ( ! m_recv_requests.empty())
+      HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(m_recv_requests.size(), m_recv_requests.data(), MPI_STATUSES_IGNORE),
+                              m_connectivity->get_comm().mpi_comm()); // Wait for all data to arrive
+    m_recv_pending = false;
+    tstop("be recv waitall");
 
-  tstart("be recv_and_unpack book");
-  m_buffers_manager->sync_recv_buffer(this);
+    tstart("be recv_and_unpack book");
+    m_buffers_manager->sync_recv_buffer(this);
 
-  tstop("be recv_and_unpack book");
+    tstop("be recv_and_unpack book");
 
-  // --- Unpack --- //
-  const auto& ucon = m_connectivity->get_d_ucon();
-  const auto& ucon_ptr = m_connectivity->get_d_ucon_ptr();
-  // First, unpack 2d fields (if any)...
-  if (m_num_2d_fields>0)
-    unpack(ucon, ucon_ptr, m_2d_fields, m_recv_2d_buffers, rspheremp, m_num_elems,
-           m_num_2d_fields);
-  // ...then unpack 3d fields (if any)...
-  if (m_num_3d_fields>0) {
-    if (m_3d_nlev_pack_d.size() > 0)
-      unpack<NUM_LEV, true>(ucon, ucon_ptr, m_3d_fields, m_recv_3d_buffers, rspheremp,
-                            m_num_elems, m_num_3d_fields, &m_3d_nlev_pack_d);
-    else
-      unpack<NUM_LEV>(ucon, ucon_ptr, m_3d_fields, m_recv_3d_buffers, rspheremp,
-                      m_num_elems, m_num_3d_fields);
+    // --- Unpack --- //
+    unpack_elems (rspheremp, ExecViewUnmanaged<const int*>(), m_num_elems);
   }
-  // ...then unpack 3d interface fields (if any).
-  if (m_num_3d_int_fields > 0)
-    unpack<NUM_LEV_P>(ucon, ucon_ptr, m_3d_int_fields, m_recv_3d_int_buffers, rspheremp,
-                      m_num_elems, m_num_3d_int_fields);
   Kokkos::fence();
 
   // If another BE structure starts an exchange, it has no way to check that
@@ -764,6 +991,169 @@ void BoundaryExchange::recv_and_unpack (const ExecViewUnmanaged<const Real * [NP
   tstop("be recv_and_unpack");
 }
 
+void BoundaryExchange::unpack_elems (const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp,
+                                      const ExecViewUnmanaged<const int*> elems,
+                                      const int num_elems)
+{
+  const auto& ucon = m_connectivity->get_d_ucon();
+  const auto& ucon_ptr = m_connectivity->get_d_ucon_ptr();
+  // First, unpack 2d fields (if any)...
+  if (m_num_2d_fields>0)
+    unpack(ucon, ucon_ptr, m_2d_fields, m_recv_2d_buffers, rspheremp, num_elems,
+           m_num_2d_fields, elems);
+  // ...then unpack 3d fields (if any)...
+  if (m_num_3d_fields>0) {
+    if (m_3d_nlev_pack_d.size() > 0)
+      unpack<NUM_LEV, true>(ucon, ucon_ptr, m_3d_fields, m_recv_3d_buffers, rspheremp,
+                            num_elems, m_num_3d_fields, elems, m_3d_fp32_d, &m_3d_nlev_pack_d);
+    else
+      unpack<NUM_LEV>(ucon, ucon_ptr, m_3d_fields, m_recv_3d_buffers, rspheremp,
+                      num_elems, m_num_3d_fields, elems, m_3d_fp32_d);
+  }
+  // ...then unpack 3d interface fields (if any).
+  if (m_num_3d_int_fields > 0)
+    unpack<NUM_LEV_P>(ucon, ucon_ptr, m_3d_int_fields, m_recv_3d_int_buffers, rspheremp,
+                      num_elems, m_num_3d_int_fields, elems, ExecViewUnmanaged<const int*>());
+}
+
+void BoundaryExchange::recv_and_unpack_on_arrival (const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp)
+{
+  // Each element is unpacked as soon as all the messages it depends on have arrived.
+  // Since each element still sums all its contributions at once, in the usual order,
+  // the result is BFB with the Waitall version.
+  // The elements with only local connections go first, while messages are in flight.
+  const int num_interior = m_num_elems - m_num_arrival_boundary_elems;
+  if (num_interior>0) {
+    unpack_elems (rspheremp, Kokkos::subview(m_arrival_elems,Kokkos::make_pair(0,num_interior)),
+                  num_interior);
+  }
+
+  const int nreqs = m_recv_requests.size();
+  const bool staging = !std::is_same<MPIMemSpace,ExecMemSpace>::value;
+  if (staging && !m_pipelined_staging) {
+    // The MPI buffers need to be copied to device, and we are not allowed to read
+    // the buffers of a pending recv, so, unless we stage one message at a time,
+    // we must wait for all the messages.
+    tstart("be recv waitall");
+    HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(nreqs, m_recv_requests.data(), MPI_STATUSES_IGNORE),
+                            m_connectivity->get_comm().mpi_comm());
+    m_recv_pending = false;
+    tstop("be recv waitall");
+
+    tstart("be recv_and_unpack book");
+    m_buffers_manager->sync_recv_buffer(this);
+    tstop("be recv_and_unpack book");
+
+    unpack_elems (rspheremp, Kokkos::subview(m_arrival_elems,Kokkos::make_pair(num_interior,m_num_elems)),
+                  m_num_arrival_boundary_elems);
+    return;
+  }
+
+  // The order in which the boundary elements become ready is only known at run time,
+  // so we fill the (device) list of elements to unpack on the fly.
+  auto num_deps = m_arrival_elem_num_deps;
+  std::vector<int> indices(nreqs);
+  int num_ready = num_interior;
+  int num_done  = 0;
+  while (num_done<nreqs) {
+    int outcount;
+    tstart("be recv waitsome");
+    HOMMEXX_MPI_CHECK_ERROR(MPI_Waitsome(nreqs, m_recv_requests.data(), &outcount,
+                                         indices.data(), MPI_STATUSES_IGNORE),
+                            m_connectivity->get_comm().mpi_comm());
+    tstop("be recv waitsome");
+    if (outcount==MPI_UNDEFINED) {
+      break;
+    }
+    num_done += outcount;
+    if (staging) {
+      // Bring the new messages to device before unpacking them
+      stage_recv (indices.data(), outcount);
+      for (const auto& space : m_buffers_manager->get_staging_spaces()) {
+        space.fence();
+      }
+    }
+
+    const int beg = num_ready;
+    for (int i=0; i<outcount; ++i) {
+      for (const int ie : m_arrival_req_elems[indices[i]]) {
+        if (--num_deps[ie]==0) {
+          m_arrival_elems_h(num_ready++) = ie;
+        }
+      }
+    }
+    if (num_ready>beg) {
+      const auto range = Kokkos::make_pair(beg,num_ready);
+      Kokkos::deep_copy(Kokkos::subview(m_arrival_elems,range),
+                        Kokkos::subview(m_arrival_elems_h,range));
+      unpack_elems (rspheremp, Kokkos::subview(m_arrival_elems,range), num_ready-beg);
+    }
+  }
+  m_recv_pending = false;
+  assert (num_ready==m_num_elems);
+}
+
+bool BoundaryExchange::use_pipelined_staging () const {
+  return m_pipelined_staging && !std::is_same<MPIMemSpace,ExecMemSpace>::value;
+}
+
+void BoundaryExchange::send_pipelined ()
+{
+  // Enqueue all the copies first, round robin on the staging streams, then start
+  // each send as soon as its copy is done. Since copies on a stream complete in
+  // order, waiting on the stream of request ip only waits for copies enqueued before it.
+  const auto& spaces = m_buffers_manager->get_staging_spaces();
+  const int nspaces = spaces.size();
+  const int nreqs = m_send_requests.size();
+  for (int ip = 0; ip < nreqs; ++ip) {
+    m_buffers_manager->sync_send_buffer(spaces[ip % nspaces],
+                                        m_req_buf_offset[ip], m_req_buf_count[ip]);
+  }
+  for (int ip = 0; ip < nreqs; ++ip) {
+    spaces[ip % nspaces].fence();
+    HOMMEXX_MPI_CHECK_ERROR(MPI_Start(&m_send_requests[ip]),
+                            m_connectivity->get_comm().mpi_comm());
+  }
+}
+
+void BoundaryExchange::stage_recv (const int* reqs, const int num_reqs)
+{
+  const auto& spaces = m_buffers_manager->get_staging_spaces();
+  const int nspaces = spaces.size();
+  for (int i = 0; i < num_reqs; ++i) {
+    const int ip = reqs[i];
+    m_buffers_manager->sync_recv_buffer(spaces[ip % nspaces],
+                                        m_req_buf_offset[ip], m_req_buf_count[ip]);
+  }
+}
+
+void BoundaryExchange::recv_pipelined ()
+{
+  const int nreqs = m_recv_requests.size();
+  std::vector<int> indices(nreqs);
+  int num_done = 0;
+  tstart("be recv waitsome");
+  while (num_done<nreqs) {
+    int outcount;
+    HOMMEXX_MPI_CHECK_ERROR(MPI_Waitsome(nreqs, m_recv_requests.data(), &outcount,
+                                         indices.data(), MPI_STATUSES_IGNORE),
+                            m_connectivity->get_comm().mpi_comm());
+    if (outcount==MPI_UNDEFINED) {
+      break;
+    }
+    num_done += outcount;
+
+    // Copy to device while we wait for the remaining messages
+    stage_recv (indices.data(), outcount);
+  }
+  m_recv_pending = false;
+  tstop("be recv waitsome");
+
+  for (const auto& space : m_buffers_manager->get_staging_spaces()) {
+    space.fence();
+  }
+}
+
 static void pack_min_max (
   const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> ucon,
   const ExecViewUnmanaged<const int*> ucon_ptr,
@@ -1094,7 +1484,7 @@ void BoundaryExchange::build_buffer_views_and_requests()
       h_buf_offset[info.sharing] += h_increment_2d[info.kind];
     }
     for (int f = 0; f < m_num_3d_fields; ++f) {
-      const auto nlev_3d = m_3d_nlev_pack.empty() ? NUM_LEV : m_3d_nlev_pack[f];
+      const auto nlev_3d = get_3d_buf_nlev(f, m_3d_nlev_pack.empty() ? NUM_LEV : m_3d_nlev_pack[f]);
       h_send_3d_buffers(f, i) = ExecViewUnmanaged<Scalar**>(
         reinterpret_cast<Scalar*>(send_buffer.get() + h_buf_offset[info.sharing]),
         helpers.CONNECTION_SIZE[info.kind], nlev_3d);
@@ -1151,6 +1541,8 @@ void BoundaryExchange::build_buffer_views_and_requests()
     MPIViewManaged<Real*>::pointer_type send_ptr = buffers_manager->get_mpi_send_buffer().data();
     MPIViewManaged<Real*>::pointer_type recv_ptr = buffers_manager->get_mpi_recv_buffer().data();
     int offset = 0;
+    m_req_buf_offset.resize(npids);
+    m_req_buf_count.resize(npids);
     for (size_t ip = 0; ip < npids; ++ip) {
       int count = 0;
       for (int k = pid_offsets[ip]; k < pid_offsets[ip+1]; ++k) {
@@ -1166,8 +1558,43 @@ void BoundaryExchange::build_buffer_views_and_requests()
                                             pids[ip], m_exchange_type, mpi_comm,
                                             &m_recv_requests[ip]),
                               m_connectivity->get_comm().mpi_comm());
+      m_req_buf_offset[ip] = offset;
+      m_req_buf_count[ip] = count;
       offset += count;
     }
+
+    if (m_unpack_on_arrival) {
+      // For each recv request, store the elements receiving data from it, and for each
+      // element the number of requests it depends on. Elements that depend on no request
+      // are stored at the front of the list of elements to unpack.
+      std::map<int,int> pid_to_req;
+      for (size_t ip = 0; ip < npids; ++ip) {
+        pid_to_req[pids[ip]] = ip;
+      }
+      const auto& ucon_ptr = m_connectivity->get_h_ucon_ptr();
+      m_arrival_req_elems.assign(npids,std::vector<int>());
+      m_arrival_elem_num_deps.assign(m_num_elems,0);
+      m_arrival_elems = decltype(m_arrival_elems)("elems unpack order",m_num_elems);
+      m_arrival_elems_h = Kokkos::create_mirror_view(m_arrival_elems);
+      int num_interior = 0;
+      for (int ie = 0; ie < m_num_elems; ++ie) {
+        std::set<int> reqs;
+        for (int k = ucon_ptr(ie); k < ucon_ptr(ie+1); ++k) {
+          if (ucon(k).sharing == etoi(ConnectionSharing::SHARED)) {
+            reqs.insert(pid_to_req.at(ucon(k).remote_pid));
+          }
+        }
+        for (const int ir : reqs) {
+          m_arrival_req_elems[ir].push_back(ie);
+        }
+        m_arrival_elem_num_deps[ie] = reqs.size();
+        if (reqs.empty()) {
+          m_arrival_elems_h(num_interior++) = ie;
+        }
+      }
+      m_num_arrival_boundary_elems = m_num_elems - num_interior;
+      Kokkos::deep_copy(m_arrival_elems,m_arrival_elems_h);
+    }
   }
 
   // Now the buffer views and the requests are built
@@ -192,6 +192,39 @@ public:
   void exchange ();
   void exchange (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp);
 
+  // Split version of exchange, allowing to overlap the halo exchange with computation.
+  // exchange_begin packs and sends only the shared (off-process) connections, so it
+  // only needs the fields on the boundary elements (see Connectivity::get_d_elems_by_sharing)
+  // to be up to date. exchange_end packs the local connections, then receives and unpacks.
+  // Calling exchange_begin followed by exchange_end gives the same (BFB) result as exchange.
+  void exchange_begin ();
+  void exchange_end ();
+  void exchange_end (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp);
+
+  // Device-side packer of the registered 3d (midpoint) fields. It allows a kernel
+  // that computes one of these fields to write it directly in the send buffers,
+  // saving the separate pack pass (which reads the field back from memory).
+  // Get the packer right before the kernel, and, once the kernel has completed,
+  // call exchange_prepacked(n) to exchange all registered fields, skipping the
+  // pack of the 3d fields [0,n) (which must ALL have been packed by the kernel).
+  // Only full-column, full-precision 3d fields are supported.
+  struct FieldPacker {
+    ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> ucon;
+    ExecViewUnmanaged<const int*>                                    ucon_ptr;
+    ExecViewUnmanaged<ExecViewUnmanaged<Scalar**>**>                 send_3d_buffers;
+    ConnectionHelpers                                                helpers;
+
+    // Pack field f, i.e., the 3d field ifield of element ie. Must be called by the
+    // whole team, after the team has finished writing f.
+    template<typename FieldView>
+    KOKKOS_INLINE_FUNCTION
+    void operator() (const TeamMember& team, const int ie, const int ifield,
+                     const FieldView& f) const;
+  };
+  FieldPacker get_field_packer ();
+  void exchange_prepacked (const int num_3d_prepacked,
+                           ExecViewUnmanaged<const Real * [NP][NP]> rspheremp);
+
   // Exchange all registered 1d fields, performing min/max operations with neighbors
   void exchange_min_max ();
 
@@ -234,6 +267,26 @@ public:
   // 0, corresponding to none.
   void set_diagnostics_level (const int level);
 
+  // If true, recv_and_unpack uses MPI_Waitsome, and unpacks each element as soon as
+  // all the messages it needs have arrived, starting with the elements that only
+  // have local connections. Results are BFB with the default (MPI_Waitall) strategy.
+  // Default: true if HOMMEXX_BE_UNPACK_ON_ARRIVAL is defined, false otherwise.
+  void set_unpack_on_arrival (const bool unpack_on_arrival);
+
+  // The 3d (midpoint) fields registered while this is true are packed as FP32 in
+  // the buffers, and expanded back to FP64 on unpack. This halves the message size
+  // of error-tolerant exchanges (e.g., intermediate laplacians). Note that local
+  // connections use the same buffers, so results do not depend on the decomposition.
+  // Can only be called between registration_started and registration_completed.
+  void set_register_as_fp32 (const bool fp32);
+
+  // If MPI buffers are on host (non GPU-aware MPI), stage them one neighbor at a
+  // time: each neighbor's slice of the send buffer is copied to host on its own
+  // stream, and sent as soon as its copy is done; each received message is copied
+  // to device as soon as it arrives. No-op if MPI buffers are on device.
+  // Default: true if HOMMEXX_MPI_PIPELINED_STAGING is defined, false otherwise.
+  void set_pipelined_staging (const bool pipelined) { m_pipelined_staging = pipelined; }
+
 private:
 
   short int m_exchange_type;
@@ -287,12 +340,38 @@ private:
   std::vector<int> m_3d_nlev_pack;        // during registration
   ExecViewManaged<int*> m_3d_nlev_pack_d; //  after registration
 
+  // Whether each 3d field is exchanged in single precision (empty if none is)
+  bool                  m_register_fp32;
+  std::vector<int>      m_3d_fp32;
+  ExecViewManaged<int*> m_3d_fp32_d;
+  // Number of packs (of Real's) taken by a 3d field with nlev packs in the buffers
+  int get_3d_buf_nlev (const int ifield, const int nlev) const;
+
+  // Data for the unpack-on-arrival strategy (built with the requests):
+  //  - the elements receiving data from each recv request;
+  //  - the number of recv requests each element depends on;
+  //  - the element unpack order, starting with elements depending on no request
+  //    (the remainder is filled at run time, following the arrival order).
+  bool                            m_unpack_on_arrival;
+  bool                            m_pipelined_staging;
+  // The offset and size (in Real's) of each request's slice of the MPI buffers
+  std::vector<size_t>             m_req_buf_offset;
+  std::vector<size_t>             m_req_buf_count;
+  int                             m_num_arrival_boundary_elems;
+  std::vector<std::vector<int>>   m_arrival_req_elems;
+  std::vector<int>                m_arrival_elem_num_deps;
+  ExecViewManaged<int*>             m_arrival_elems;
+  ExecViewManaged<int*>::HostMirror m_arrival_elems_h;
+
   // The number of registered fields
   int         m_num_1d_fields;    // Without counting the 2x factor due to min/max fields
   int         m_num_2d_fields;
   int         m_num_3d_fields;
   int         m_num_3d_int_fields;
 
+  // The number of 3d fields already packed by the caller (see exchange_prepacked)
+  int         m_num_3d_prepacked;
+
   // The following flags are used to ensure that a bad user does not call setup/cleanup/registration
   // methods of this class in an order that generate errors. And if he/she does, we try to avoid errors.
   bool        m_registration_started;
@@ -313,10 +392,57 @@ private:
   void free_requests();
   // Only the impl knows about the raw pointer.
   void exchange(const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp);
+  void exchange_end(const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp);
+  // Pack only the connections with the given sharing (ANY packs all of them),
+  // and send the MPI buffers.
+  void pack_and_send (const ConnectionSharing sharing);
+  void pack_fields (const ConnectionSharing sharing);
+  // Whether MPI buffers need staging, and we do it one neighbor at a time
+  bool use_pipelined_staging () const;
+  // Start the sends, after copying each request's slice to host
+  void send_pipelined ();
+  // Copy the slices of the given (completed) recv requests to device (asynchronously)
+  void stage_recv (const int* reqs, const int num_reqs);
+  // Wait for all recv requests, staging each message as soon as it arrives
+  void recv_pipelined ();
 public: // This is semantically private but must be public for nvcc.
   void recv_and_unpack(const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp);
+  void recv_and_unpack_on_arrival(const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp);
+  // Unpack the given elements (all of them if elems is empty)
+  void unpack_elems(const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp,
+                    const ExecViewUnmanaged<const int*> elems, const int num_elems);
 };
 
+template<typename FieldView>
+KOKKOS_INLINE_FUNCTION
+void BoundaryExchange::FieldPacker::
+operator() (const TeamMember& team, const int ie, const int ifield, const FieldView& f) const
+{
+  // Same as the pack in exchange, but with the connections of the element
+  // and their points spread over the team threads.
+  const int iconn_beg = ucon_ptr(ie);
+  const int nconn = ucon_ptr(ie+1) - iconn_beg;
+  Kokkos::parallel_for(
+    Kokkos::TeamThreadRange(team, nconn*NP),
+    [&] (const int idx) {
+      const int iconn = iconn_beg + idx / NP;
+      const int k = idx % NP;
+      const auto& info = ucon(iconn);
+      if (k >= helpers.CONNECTION_SIZE[info.kind])
+        return;
+      const int buffer_iconn = (info.sharing == etoi(ConnectionSharing::LOCAL) ?
+                                info.sharing_local_remote_iconn :
+                                iconn);
+      const auto& pt = helpers.CONNECTION_PTS[info.direction][info.local_dir][k];
+      const auto& sb = send_3d_buffers(ifield, buffer_iconn);
+      Kokkos::parallel_for(
+        Kokkos::ThreadVectorRange(team, NUM_LEV),
+        [&] (const int& ilev) {
+          sb(k, ilev) = f(pt.ip, pt.jp, ilev);
+        });
+    });
+}
+
 // ============================ REGISTER METHODS ========================= //
 
 // --- 2d fields --- //
@@ -440,6 +566,7 @@ void BoundaryExchange::register_field (ExecView<Scalar*[OUTER_DIM][DIM][NP][NP][
   }
 
   for (int i = 0; i < num_dims; ++i) m_3d_nlev_pack.push_back(nlev);
+  for (int i = 0; i < num_dims; ++i) m_3d_fp32.push_back(m_register_fp32);
   m_num_3d_fields += num_dims;
 }
 
@@ -465,6 +592,7 @@ void BoundaryExchange::register_field (ExecView<Scalar***[NP][NP][NUM_LEV], Prop
   }
 
   for (int i = 0; i < num_dims; ++i) m_3d_nlev_pack.push_back(nlev);
+  for (int i = 0; i < num_dims; ++i) m_3d_fp32.push_back(m_register_fp32);
   m_num_3d_fields += num_dims;
 }
 
@@ -492,6 +620,7 @@ void BoundaryExchange::register_field_impl (
   }
 
   m_3d_nlev_pack.push_back(nlev);
+  m_3d_fp32.push_back(m_register_fp32);
   ++m_num_3d_fields;
 }
 
@@ -507,6 +636,7 @@ void BoundaryExchange::register_field_impl (
   // Sanity checks
   assert (m_registration_started && !m_registration_completed);
   assert (m_num_3d_int_fields+1<=m_3d_int_fields.extent_int(1));
+  assert (!m_register_fp32); // FP32 exchange is only supported for midpoint fields
   assert (m_num_1d_fields==0);
 
   Errors::runtime_check(
@@ -569,6 +699,7 @@ void BoundaryExchange::register_field_impl (
   }
 
   for (int i = 0; i < num_dims; ++i) m_3d_nlev_pack.push_back(nlev);
+  for (int i = 0; i < num_dims; ++i) m_3d_fp32.push_back(m_register_fp32);
   m_num_3d_fields += num_dims;
 }
 
@@ -586,6 +717,7 @@ void BoundaryExchange::register_field_impl (
   assert (num_dims>0 && start_dim>=0);
   assert (start_dim+num_dims<=field.extent_int(1));
   assert (m_num_3d_int_fields+1<=m_3d_int_fields.extent_int(1));
+  assert (!m_register_fp32); // FP32 exchange is only supported for midpoint fields
   assert (m_num_1d_fields==0);
 
   Errors::runtime_check(
@@ -6,18 +6,44 @@
 
 #include "Connectivity.hpp"
 #include "ErrorDefs.hpp"
+#include "Hommexx_Debug.hpp"
 
 #include <array>
 #include <algorithm>
+#include <cmath>
 
 namespace Homme
 {
 
+namespace {
+
+// Index of cell (x,y) along the Hilbert curve filling an n x n grid, with n a power of 2.
+long hilbert_index (const int n, int x, int y) {
+  long d = 0;
+  for (int s = n/2; s > 0; s /= 2) {
+    const int rx = (x & s) > 0;
+    const int ry = (y & s) > 0;
+    d += static_cast<long>(s)*s*((3*rx) ^ ry);
+    // Rotate the quadrant, so that the curve is continuous
+    if (ry == 0) {
+      if (rx == 1) {
+        x = n-1 - x;
+        y = n-1 - y;
+      }
+      std::swap(x,y);
+    }
+  }
+  return d;
+}
+
+} // anonymous namespace
+
 Connectivity::Connectivity ()
  : m_finalized    (false)
  , m_initialized  (false)
  , m_num_local_elements (-1)
  , m_max_corner_elements(-1)
+ , m_num_boundary_elements(0)
 {
   // Nothing to be done here
 }
@@ -136,6 +162,7 @@ void Connectivity::finalize(const bool sanity_check)
   }
 
   setup_ucon();
+  setup_elems_by_sharing();
 
   m_finalized = true;
 }
@@ -313,6 +340,71 @@ void Connectivity::setup_ucon () {
   }
 }
 
+void Connectivity::setup_elems_by_sharing () {
+  d_elems_by_sharing = decltype(d_elems_by_sharing)("Elements by sharing",
+                                                    m_num_local_elements);
+  h_elems_by_sharing = Kokkos::create_mirror_view(d_elems_by_sharing);
+
+  // Local elements are numbered in increasing gid order, which, on the cubed
+  // sphere, is row-major within each face. Teams working on consecutive entries
+  // of elems_by_sharing are more likely to share neighbor data in cache if the
+  // entries follow a space filling curve instead, so, if the grid is a cubed
+  // sphere, order the elements along a Hilbert curve on each face.
+  // NOTE: this only affects the order in which elements are processed, not
+  //       where their data is stored, so results do not change.
+  std::vector<long> key(m_num_local_elements);
+  for (int ie = 0; ie < m_num_local_elements; ++ie) {
+    key[ie] = ie;
+  }
+  int num_global_elements = m_num_local_elements;
+  HOMMEXX_MPI_CHECK_ERROR(MPI_Allreduce(&m_num_local_elements, &num_global_elements, 1, MPI_INT,
+                                        MPI_SUM, m_comm.mpi_comm()),
+                          m_comm.mpi_comm());
+  const int ne = std::lround(std::sqrt(num_global_elements/6.0));
+  if (6*ne*ne == num_global_elements && h_ucon.extent_int(0) > 0) {
+    int n = 1;
+    while (n < ne) n *= 2;
+    for (int ie = 0; ie < m_num_local_elements; ++ie) {
+      // Inverse of gid = (face*ne + j)*ne + i
+      const int gid = h_ucon(h_ucon_ptr(ie)).local.gid;
+      const int face = gid / (ne*ne);
+      const int j = (gid / ne) % ne;
+      const int i = gid % ne;
+      key[ie] = face*static_cast<long>(n)*n + hilbert_index(n,i,j);
+    }
+  }
+  std::vector<int> order(m_num_local_elements);
+  for (int ie = 0; ie < m_num_local_elements; ++ie) {
+    order[ie] = ie;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&](const int a, const int b) { return key[a] < key[b]; });
+
+  // Boundary elements are stored from the front, interior ones from the back.
+  // Elements in each group are stored in the order computed above.
+  std::vector<int> interior;
+  m_num_boundary_elements = 0;
+  for (const int ie : order) {
+    bool shared = false;
+    for (int k = h_ucon_ptr(ie); k < h_ucon_ptr(ie+1); ++k) {
+      if (h_ucon(k).sharing == etoi(ConnectionSharing::SHARED)) {
+        shared = true;
+        break;
+      }
+    }
+    if (shared) {
+      h_elems_by_sharing(m_num_boundary_elements++) = ie;
+    } else {
+      interior.push_back(ie);
+    }
+  }
+  for (size_t i = 0; i < interior.size(); ++i) {
+    h_elems_by_sharing(m_num_boundary_elements+i) = interior[i];
+  }
+
+  Kokkos::deep_copy(d_elems_by_sharing, h_elems_by_sharing);
+}
+
 void Connectivity::clean_up()
 {
   // Cleaning the elements counter
@@ -322,6 +414,9 @@ void Connectivity::clean_up()
   h_ucon = decltype(h_ucon)("", 0);
   d_ucon_ptr = decltype(d_ucon_ptr)("", 0);
   h_ucon_ptr = decltype(h_ucon_ptr)("", 0);
+  d_elems_by_sharing = decltype(d_elems_by_sharing)("", 0);
+  h_elems_by_sharing = decltype(h_elems_by_sharing)("", 0);
+  m_num_boundary_elements = 0;
 
   m_initialized = false;
   m_finalized   = false;
@@ -100,6 +100,15 @@ public:
   HostViewUnmanaged<const ConnectionInfo*> get_h_ucon () const { return h_ucon; }
   HostViewUnmanaged<const int*> get_h_ucon_ptr () const { return h_ucon_ptr; }
 
+  // Local ids of the elements, sorted so that the elements with at least one
+  // shared connection ("boundary" elements) come first, followed by the elements
+  // whose connections are all local ("interior" elements). This allows to compute
+  // the boundary elements first, and overlap halo exchange with interior work.
+  // On cubed-sphere grids, the elements in each group follow a space filling curve.
+  ExecViewUnmanaged<const int*> get_d_elems_by_sharing () const { return d_elems_by_sharing; }
+  HostViewUnmanaged<const int*> get_h_elems_by_sharing () const { return h_elems_by_sharing; }
+  int get_num_boundary_elements () const { return m_num_boundary_elements; }
+
   // Get number of connections with given kind and sharing
   template<typename MemSpace>
   KOKKOS_INLINE_FUNCTION
@@ -143,6 +152,7 @@ private:
   bool    m_initialized;
 
   int     m_num_local_elements, m_max_corner_elements;
+  int     m_num_boundary_elements;
 
   ConnectionHelpers m_helpers;
 
@@ -156,6 +166,8 @@ private:
   ExecViewManaged<int*>::HostMirror h_ucon_ptr;
   ExecViewManaged<int*>             d_ucon_dir_ptr;
   ExecViewManaged<int*>::HostMirror h_ucon_dir_ptr;
+  ExecViewManaged<int*>             d_elems_by_sharing;
+  ExecViewManaged<int*>::HostMirror h_elems_by_sharing;
   // Helper used to accumulate connections during add_connection phase. Emptied
   // in finalize. l_ is local; r_ is remote.
   struct UConInfo {
@@ -167,6 +179,8 @@ private:
   // In finalize call, construct the unstructured connectivity data using
   // ucon_info.
   void setup_ucon();
+  // Once ucon is set up, sort the elements into boundary and interior ones.
+  void setup_elems_by_sharing();
 };
 
 } // namespace Homme
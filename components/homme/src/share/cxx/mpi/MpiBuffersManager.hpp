@@ -130,6 +130,15 @@ private:
   // Note: these are no-ops if MPIMemSpace=ExecMemSpace
   void sync_send_buffer (BoundaryExchange* customer);
   void sync_recv_buffer (BoundaryExchange* customer);
+  // Same as above, but only for the slice [offset,offset+count) of the buffers, and
+  // asynchronously on the given execution space instance (see get_staging_spaces).
+  void sync_send_buffer (const ExecSpace& space, const size_t offset, const size_t count);
+  void sync_recv_buffer (const ExecSpace& space, const size_t offset, const size_t count);
+
+  // Execution space instances used to stage the MPI buffers one neighbor at a time.
+  // They are created on first use.
+  const std::vector<ExecSpace>& get_staging_spaces ();
+  static constexpr int num_staging_spaces = 4;
 
   // Small struct, to hold customer's needs. We could use an std::pair, but this is more verbose
   struct CustomerNeeds {
@@ -181,6 +190,8 @@ private:
   // The blackhole send/recv buffers (used for missing connections)
   ExecViewManaged<Real*>  m_blackhole_send_buffer;
   ExecViewManaged<Real*>  m_blackhole_recv_buffer;
+
+  std::vector<ExecSpace>  m_staging_spaces;
 };
 
 inline void MpiBuffersManager::sync_send_buffer (BoundaryExchange* customer)
@@ -215,6 +226,33 @@ inline void MpiBuffersManager::sync_recv_buffer (BoundaryExchange* customer)
   }
 }
 
+inline void MpiBuffersManager::
+sync_send_buffer (const ExecSpace& space, const size_t offset, const size_t count)
+{
+  assert (offset+count<=m_mpi_buffer_size);
+  MPIViewUnmanaged<Real*>  mpi_send_view(m_mpi_send_buffer.data()+offset,count);
+  ExecViewUnmanaged<const Real*> send_view(m_send_buffer.data()+offset,count);
+  Kokkos::deep_copy(space, mpi_send_view, send_view);
+}
+
+inline void MpiBuffersManager::
+sync_recv_buffer (const ExecSpace& space, const size_t offset, const size_t count)
+{
+  assert (offset+count<=m_mpi_buffer_size);
+  MPIViewUnmanaged<const Real*>  mpi_recv_view(m_mpi_recv_buffer.data()+offset,count);
+  ExecViewUnmanaged<Real*> recv_view(m_recv_buffer.data()+offset,count);
+  Kokkos::deep_copy(space, recv_view, mpi_recv_view);
+}
+
+inline const std::vector<ExecSpace>& MpiBuffersManager::get_staging_spaces ()
+{
+  if (m_staging_spaces.empty()) {
+    const std::vector<int> weights(num_staging_spaces,1);
+    m_staging_spaces = Kokkos::Experimental::partition_space(ExecSpace(),weights);
+  }
+  return m_staging_spaces;
+}
+
 inline ExecViewUnmanaged<Real*>
 MpiBuffersManager::get_send_buffer () const
 {
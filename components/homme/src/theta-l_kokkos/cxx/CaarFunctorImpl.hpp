@@ -117,6 +117,18 @@ struct CaarFunctorImpl {
 
   TeamPolicyType<TagPreExchange>   m_policy_pre;
 
+  // If HOMMEXX_OVERLAP_BEXCHANGE is defined, the pre-exchange loop is split in two:
+  // the boundary elements (with at least one off-process neighbor) are computed first,
+  // then their data is sent while the interior elements are being computed.
+  // The two policies have the same team configuration as m_policy_pre, and the
+  // element processed by team t is m_elems_by_sharing(m_elems_offset+t).
+  bool                             m_overlap_bexchange = false;
+  int                              m_num_boundary_elems = 0;
+  int                              m_elems_offset = 0;
+  ExecViewUnmanaged<const int*>    m_elems_by_sharing;
+  TeamPolicyType<TagPreExchange>   m_policy_pre_boundary;
+  TeamPolicyType<TagPreExchange>   m_policy_pre_interior;
+
   Kokkos::RangePolicy<ExecSpace, TagPostExchange> m_policy_post;
 
   TeamUtils<ExecSpace> m_tu;
@@ -323,6 +335,22 @@ struct CaarFunctorImpl {
       }
       be.registration_completed();
     }
+
+#ifdef HOMMEXX_OVERLAP_BEXCHANGE
+    // Splitting only pays off if there is something to overlap with
+    const auto& connectivity = *bm_exchange->get_connectivity();
+    m_num_boundary_elems = connectivity.get_num_boundary_elements();
+    m_overlap_bexchange = m_num_boundary_elems>0 && m_num_boundary_elems<m_num_elems;
+    if (m_overlap_bexchange) {
+      m_elems_by_sharing = connectivity.get_d_elems_by_sharing();
+      const int team_size = m_policy_pre.team_size();
+      const int vec_len   = m_policy_pre.impl_vector_length();
+      m_policy_pre_boundary = TeamPolicyType<TagPreExchange>(m_num_boundary_elems,team_size,vec_len);
+      m_policy_pre_interior = TeamPolicyType<TagPreExchange>(m_num_elems-m_num_boundary_elems,team_size,vec_len);
+      m_policy_pre_boundary.set_chunk_size(1);
+      m_policy_pre_interior.set_chunk_size(1);
+    }
+#endif
   }
 
   void set_rk_stage_data (const RKStageData& data) {
@@ -345,18 +373,22 @@ struct CaarFunctorImpl {
 
     profiling_resume();
 
-    GPTLstart("caar compute");
-    int nerr;
-    Kokkos::parallel_reduce("caar loop pre-boundary exchange", m_policy_pre, *this, nerr);
-    Kokkos::fence();
-    GPTLstop("caar compute");
-    if (nerr > 0)
-      check_print_abort_on_bad_elems("CaarFunctorImpl::run TagPreExchange", data.n0);
+    if (m_overlap_bexchange) {
+      run_pre_exchange_overlapped(data);
+    } else {
+      GPTLstart("caar compute");
+      int nerr;
+      Kokkos::parallel_reduce("caar loop pre-boundary exchange", m_policy_pre, *this, nerr);
+      Kokkos::fence();
+      GPTLstop("caar compute");
+      if (nerr > 0)
+        check_print_abort_on_bad_elems("CaarFunctorImpl::run TagPreExchange", data.n0);
 
-    GPTLstart("caar_bexchV");
-    m_bes[data.np1]->exchange(m_geometry.m_rspheremp);
-    Kokkos::fence();
-    GPTLstop("caar_bexchV");
+      GPTLstart("caar_bexchV");
+      m_bes[data.np1]->exchange(m_geometry.m_rspheremp);
+      Kokkos::fence();
+      GPTLstop("caar_bexchV");
+    }
 
     if (!m_theta_hydrostatic_mode) {
       GPTLstart("caar compute");
@@ -370,12 +402,49 @@ struct CaarFunctorImpl {
     profiling_pause();
   }
 
+  // Same as the pre-exchange loop + exchange in run, but computing the boundary
+  // elements first, so that the halo exchange of their data overlaps with the
+  // computation on the interior elements. The result is BFB with the unsplit version.
+  void run_pre_exchange_overlapped (const RKStageData& data)
+  {
+    int nerr;
+    GPTLstart("caar compute");
+    m_elems_offset = 0;
+    Kokkos::parallel_reduce("caar loop pre-boundary exchange (boundary elems)",
+                            m_policy_pre_boundary, *this, nerr);
+    Kokkos::fence();
+    GPTLstop("caar compute");
+    if (nerr > 0)
+      check_print_abort_on_bad_elems("CaarFunctorImpl::run TagPreExchange", data.n0);
+
+    GPTLstart("caar_bexchV");
+    m_bes[data.np1]->exchange_begin();
+    GPTLstop("caar_bexchV");
+
+    GPTLstart("caar compute");
+    m_elems_offset = m_num_boundary_elems;
+    Kokkos::parallel_reduce("caar loop pre-boundary exchange (interior elems)",
+                            m_policy_pre_interior, *this, nerr);
+    Kokkos::fence();
+    GPTLstop("caar compute");
+    if (nerr > 0)
+      check_print_abort_on_bad_elems("CaarFunctorImpl::run TagPreExchange", data.n0);
+
+    GPTLstart("caar_bexchV");
+    m_bes[data.np1]->exchange_end(m_geometry.m_rspheremp);
+    Kokkos::fence();
+    GPTLstop("caar_bexchV");
+  }
+
   KOKKOS_INLINE_FUNCTION
   void operator()(const TagPreExchange&, const TeamMember &team, int& nerr) const {
     // In this body, we use '====' to separate sync epochs (delimited by barriers)
     // Note: make sure the same temp is not used within each epoch!
 
     KernelVariables kv(team, m_tu);
+    if (m_overlap_bexchange) {
+      kv.ie = m_elems_by_sharing(m_elems_offset + kv.ie);
+    }
 
     // =========== EPOCH 1 =========== //
     compute_div_vdp(kv);
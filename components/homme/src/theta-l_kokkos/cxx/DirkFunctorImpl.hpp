@@ -25,7 +25,11 @@ namespace Homme {
 
 struct DirkFunctorImpl {
   enum : int { packn = VECTOR_SIZE };
-  enum : int { scaln = NP*NP };
+  // Number of elements whose columns are interleaved in the lanes of one team:
+  // lane idx holds column idx % ncol_elem of element ie0 + idx / ncol_elem.
+  enum : int { nelem_batch = HOMMEXX_DIRK_ELEM_BATCH };
+  enum : int { ncol_elem = NP*NP };
+  enum : int { scaln = nelem_batch*ncol_elem };
   enum : int { npack = (scaln + packn - 1)/packn };
   enum : int { max_num_lev_pack = NUM_LEV_P };
   enum : int { num_lev_aligned = max_num_lev_pack*packn };
@@ -43,6 +47,9 @@ struct DirkFunctorImpl {
 
   static_assert(num_lev_aligned >= 3,
                 "We use wrk(0:2,:) and so need num_lev_aligned >= 3");
+  static_assert(nelem_batch >= 1, "HOMMEXX_DIRK_ELEM_BATCH must be positive");
+  static_assert(nelem_batch == 1 || ncol_elem % packn == 0,
+                "With HOMMEXX_DIRK_ELEM_BATCH > 1, a pack cannot span two elements");
 
   using TeamPolicy = Kokkos::TeamPolicy<ExecSpace>;
   using MT = typename TeamPolicy::member_type;
@@ -83,6 +90,39 @@ struct DirkFunctorImpl {
     return subview(w, wi, si, a, a);
   }
 
+  // Index of the element (within the batch) owning the lanes of pack i.
+  KOKKOS_INLINE_FUNCTION
+  static int batch_elem (const int i) {
+    return nelem_batch == 1 ? 0 : (i*packn) / ncol_elem;
+  }
+
+  // Element and GLL point of lane idx. In a ragged last batch, the lanes past the
+  // last element read the last element; they are never written back.
+  KOKKOS_INLINE_FUNCTION
+  static void get_col (const int idx, const int ie0, const int nelem,
+                       int& ie, int& gi, int& gj) {
+    const int ib = ie0 + idx / ncol_elem, c = idx % ncol_elem;
+    ie = ib < nelem ? ib : nelem - 1;
+    gi = c / NP;
+    gj = c % NP;
+  }
+
+  // Wrap a view of one element, so that it can be used where a view over
+  // elements, with the element index first, is expected.
+  template <typename View>
+  struct OneElem {
+    View v;
+    KOKKOS_INLINE_FUNCTION OneElem (const View& v_) : v(v_) {}
+    template <typename... Args>
+    KOKKOS_INLINE_FUNCTION
+    auto operator() (const int, Args... args) const -> decltype(v(args...)) { return v(args...); }
+    KOKKOS_INLINE_FUNCTION int extent_int (const int r) const { return v.extent_int(r-1); }
+  };
+
+  template <typename View>
+  KOKKOS_INLINE_FUNCTION
+  static OneElem<View> one_elem (const View& v) { return OneElem<View>(v); }
+
   Work m_work;
   LinearSystem m_ls;
   TeamPolicy m_policy, m_ig_policy;
@@ -96,30 +136,32 @@ struct DirkFunctorImpl {
   }
 
   void init (const int nelem) {
+    // The Newton kernel has one team per batch of elements.
+    const int nbatch = (nelem + nelem_batch - 1) / nelem_batch;
     if (OnGpu<ExecSpace>::value) {
       ThreadPreferences tp;
       tp.max_threads_usable = NUM_PHYSICAL_LEV;
-      tp.max_vectors_usable = NP*NP;
+      tp.max_vectors_usable = scaln;
       tp.prefer_threads = false;
       tp.prefer_larger_team = true;
       const auto p = DefaultThreadsDistribution<ExecSpace>
-        ::team_num_threads_vectors(nelem, tp);
+        ::team_num_threads_vectors(nbatch, tp);
       const auto
         nhwthr = p.first*p.second,
-        nvec = std::min(NP*NP, nhwthr),
+        nvec = std::min(static_cast<int>(scaln), nhwthr),
         nthr = nhwthr/nvec;
-      m_policy = TeamPolicy(nelem, nthr, nvec);
+      m_policy = TeamPolicy(nbatch, nthr, nvec);
     } else {
       ThreadPreferences tp;
       tp.max_threads_usable = NUM_PHYSICAL_LEV;
       tp.max_vectors_usable = 1;
       tp.prefer_threads = true;
       const auto p = DefaultThreadsDistribution<ExecSpace>
-        ::team_num_threads_vectors(nelem, tp);
-      m_policy = TeamPolicy(nelem, p.first, 1);
+        ::team_num_threads_vectors(nbatch, tp);
+      m_policy = TeamPolicy(nbatch, p.first, 1);
     }
     m_tu = TeamUtils<ExecSpace>(m_policy);
-    nslot = std::min(nelem, m_tu.get_num_ws_slots());
+    nslot = std::min(nbatch, m_tu.get_num_ws_slots());
     m_ig_policy = Homme::get_default_team_policy<ExecSpace>(nelem);
     m_tu_ig = TeamUtils<ExecSpace>(m_ig_policy);
   }
@@ -226,10 +268,12 @@ struct DirkFunctorImpl {
     const auto e_initial_guess = e.m_derived.m_divdp_proj;
     const auto hybi = hvcoord.hybrid_bi;
     const auto tu   = m_tu;
+    const int nelem = e.num_elems();
 
     const auto toplevel = KOKKOS_LAMBDA (const MT& team, int& nerr) {
       KernelVariables kv(team, tu);
-      const auto ie = kv.ie;
+      // First element of this team's batch
+      const int ie0 = kv.ie*nelem_batch;
       const int nlev = num_phys_lev;
 
       const auto
@@ -257,11 +301,11 @@ struct DirkFunctorImpl {
       xfull(nlev,0)[0] = 0.0;
 
       const auto transpose4 = [&] (const int nt, const bool transpose_phi_np1 = true) {
-        transpose(kv, nlev+1, subview(e_w_i      ,ie,nt,a,a,a), w_np1    );
-        transpose(kv, nlev,   subview(e_vtheta_dp,ie,nt,a,a,a), vtheta_dp);
-        transpose(kv, nlev,   subview(e_dp3d     ,ie,nt,a,a,a), dp3d     );
+        transpose(kv, nlev+1, subview(e_w_i      ,a,nt,a,a,a), ie0, nelem, w_np1    );
+        transpose(kv, nlev,   subview(e_vtheta_dp,a,nt,a,a,a), ie0, nelem, vtheta_dp);
+        transpose(kv, nlev,   subview(e_dp3d     ,a,nt,a,a,a), ie0, nelem, dp3d     );
         if ( ! transpose_phi_np1) return;
-        transpose(kv, nlev+1, subview(e_phinh_i  ,ie,nt,a,a,a), phi_np1  );
+        transpose(kv, nlev+1, subview(e_phinh_i  ,a,nt,a,a,a), ie0, nelem, phi_np1  );
       };
 
       const auto accum_n0 = [&] (const Real dt3, const int nt) {
@@ -271,8 +315,8 @@ struct DirkFunctorImpl {
         // Newton iteration. (Also, tbc, transpose and pnh_and_exner_from_eos
         // are parallel efficient.)
         transpose4(nt);
-        calc_gwphis(kv, subview(e_dp3d,ie,nt,a,a,a), subview(e_v,ie,nt,a,a,a,a),
-                    subview(e_gradphis,ie,a,a,a), hybi, gwh_i);
+        calc_gwphis(kv, subview(e_dp3d,a,nt,a,a,a), subview(e_v,a,nt,a,a,a,a),
+                    e_gradphis, hybi, ie0, nelem, gwh_i);
         kv.team_barrier();
         loop_ki(kv, nlev, nvec, [&] (int k, int i) {
           dphi(k,i) = phi_np1(k+1,i) - phi_np1(k,i);
@@ -291,11 +335,12 @@ struct DirkFunctorImpl {
       };
 
       // Compute w_n0, phi_n0.
-      transpose(kv, nlev+1, subview(e_phinh_i,ie,np1,a,a,a), phi_n0);
-      transpose(kv, nlev+1, subview(e_w_i    ,ie,np1,a,a,a), w_n0  );
+      transpose(kv, nlev+1, subview(e_phinh_i,a,np1,a,a,a), ie0, nelem, phi_n0);
+      transpose(kv, nlev+1, subview(e_w_i    ,a,np1,a,a,a), ie0, nelem, w_n0  );
       kv.team_barrier();
       // wmax is computed before optional updates to w_n0.
-      const auto wmax = calc_wmax(kv, nlev+1, nvec, w_n0);
+      Real wmax[nelem_batch];
+      calc_wmax(kv, nlev+1, w_n0, wmax);
       // Computed only in some cases.
       if (alphadt_n0 != 0) {
         accum_n0(alphadt_n0, n0);
@@ -308,19 +353,19 @@ struct DirkFunctorImpl {
       }
       // Always computed.
       transpose4(np1, false);
-      calc_gwphis(kv, subview(e_dp3d,ie,np1,a,a,a), subview(e_v,ie,np1,a,a,a,a),
-                  subview(e_gradphis,ie,a,a,a), hybi, gwh_i);
+      calc_gwphis(kv, subview(e_dp3d,a,np1,a,a,a), subview(e_v,a,np1,a,a,a,a),
+                  e_gradphis, hybi, ie0, nelem, gwh_i);
       kv.team_barrier();
       loop_ki(kv, nlev, nvec, [&] (int k, int i) { phi_n0(k,i) -= dt2*gwh_i(k,i); });
 
       // Initial guess for phi_np1.
       if (calc_initial_guess_in_newton_kernel) {
         // Use hydrostatic phi.
-        phi_from_eos(kv, nlev, nvec, hvcoord, subview(e_phis,ie,a,a), vtheta_dp, dp3d, phi_np1);
+        phi_from_eos(kv, nlev, nvec, hvcoord, e_phis, ie0, nelem, vtheta_dp, dp3d, phi_np1);
       } else {
         // Copy initial guess from where run_initial_guess stashed it.
-        transpose(kv, nlev, subview(e_initial_guess,ie,a,a,a), phi_np1);
-        loop_ki(kv, 1, nvec, [&] (int, int i) { set_phis(i, subview(e_phis,ie,a,a), phi_np1); });
+        transpose(kv, nlev, e_initial_guess, ie0, nelem, phi_np1);
+        loop_ki(kv, 1, nvec, [&] (int, int i) { set_phis(i, e_phis, ie0, nelem, phi_np1); });
       }
       kv.team_barrier();
       loop_ki(kv, nlev, nvec, [&] (int k, int i) { dphi(k,i) = phi_np1(k+1,i) - phi_np1(k,i); });
@@ -339,6 +384,12 @@ struct DirkFunctorImpl {
 
       loop_ki(kv, nlev, nvec, [&] (int k, int i) { dphi_n0(k,i) = phi_n0(k+1,i) - phi_n0(k,i); });
 
+      // Elements of the batch still iterating. Once an element has converged,
+      // its Newton increment is masked to 0, so that its solution is the same
+      // as if it had exited the loop, as in the unbatched case.
+      bool active[nelem_batch];
+      for (int b = 0; b < nelem_batch; ++b) active[b] = true;
+
       int it = 0;
       Real deltaerr;
       for (; it < maxiter; ++it) { // Newton iteration
@@ -354,6 +405,10 @@ struct DirkFunctorImpl {
         kv.team_barrier();
         if (bfb_solver) solvebfb(kv, dl, d, du, x); else solve(kv, dl, d, du, x);
         kv.team_barrier();
+        if (nelem_batch > 1) {
+          loop_ki(kv, nlev, nvec, [&] (int k, int i) { if ( ! active[batch_elem(i)]) x(k,i) = 0; });
+          kv.team_barrier();
+        }
 
         loop_ki(kv, 1, nvec, [&] (int k, int i) { wrk(2,i) = 1; });
         kv.team_barrier();
@@ -377,7 +432,7 @@ struct DirkFunctorImpl {
 
         loop_ki(kv, nlev, nvec, [&] (int k, int i) { w_np1(k,i) += wrk(2,i)*x(k,i); });
 
-        if (exit_on_step(kv, nlev, nvec, wmax, deltatol, x, deltaerr)) break;
+        if (exit_on_step(kv, nlev, wmax, deltatol, x, active, deltaerr)) break;
       } // Newton iteration
       kv.team_barrier();
 
@@ -391,8 +446,8 @@ struct DirkFunctorImpl {
       loop_ki(kv, nlev, nvec, [&] (int k, int i) { phi_np1(k,i) = phi_n0(k,i) + dt2*grav*w_np1(k,i); });
 
       kv.team_barrier();
-      transpose(kv, nlev+1, phi_np1, subview(e_phinh_i,ie,np1,a,a,a));
-      transpose(kv, nlev+1, w_np1,   subview(e_w_i    ,ie,np1,a,a,a));
+      transpose(kv, nlev+1, phi_np1, subview(e_phinh_i,a,np1,a,a,a), ie0, nelem);
+      transpose(kv, nlev+1, w_np1,   subview(e_w_i    ,a,np1,a,a,a), ie0, nelem);
     };
 
     int nerr;
@@ -435,14 +490,34 @@ struct DirkFunctorImpl {
     }
   }
 
-  // Format of rest of Hxx -> DIRK Newton iteration format.
+  // Format of rest of Hxx -> DIRK Newton iteration format, for a single
+  // element. If nelem_batch > 1, all the elements of the batch get its data.
   template <typename View>
   KOKKOS_INLINE_FUNCTION
   static void transpose (const KernelVariables& kv, const int nlev,
                          const View& src, const WorkSlot& dst,
                          typename std::enable_if<View::rank == 3>::type* = 0) {
-    assert(src.extent_int(2)*packn >= nlev);
-    assert(src.extent_int(0) == NP && src.extent_int(1) == NP);
+    transpose(kv, nlev, one_elem(src), 0, 1, dst);
+  }
+
+  // DIRK Newton iteration format -> format of rest of Hxx, for a single element.
+  template <typename View>
+  KOKKOS_INLINE_FUNCTION
+  static void transpose (const KernelVariables& kv, const int nlev,
+                         const WorkSlot& src, const View& dst,
+                         typename std::enable_if<View::rank == 3>::type* = 0) {
+    transpose(kv, nlev, src, one_elem(dst), 0, 1);
+  }
+
+  // Format of rest of Hxx -> DIRK Newton iteration format, for the batch of
+  // elements starting at ie0.
+  template <typename View>
+  KOKKOS_INLINE_FUNCTION
+  static void transpose (const KernelVariables& kv, const int nlev,
+                         const View& src, const int ie0, const int nelem,
+                         const WorkSlot& dst) {
+    assert(src.extent_int(3)*packn >= nlev);
+    assert(src.extent_int(1) == NP && src.extent_int(2) == NP);
     const auto f = [&] (const int k) {
       const auto
       pk = k / packn,
@@ -450,13 +525,12 @@ struct DirkFunctorImpl {
       const auto g = [&] (const int i) {
         const auto gk0 = packn*i;
         for (int s = 0; s < packn; ++s) {
-          const auto
-          gk = gk0 + s,
-          gi = gk / NP,
-          gj = gk % NP;
+          const auto gk = gk0 + s;
           if (scaln % packn != 0 && // try to compile out this conditional when possible
               gk >= scaln) break;
-          dst(k,i)[s] = src(gi,gj,pk)[sk];
+          int ie, gi, gj;
+          get_col(gk, ie0, nelem, ie, gi, gj);
+          dst(k,i)[s] = src(ie,gi,gj,pk)[sk];
         }
       };
       const int n = npack;
@@ -466,18 +540,20 @@ struct DirkFunctorImpl {
     Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, nlev), f);
   }
 
-  // DIRK Newton iteration format -> format of rest of Hxx.
+  // DIRK Newton iteration format -> format of rest of Hxx, for the batch of
+  // elements starting at ie0.
   template <typename View>
   KOKKOS_INLINE_FUNCTION
   static void transpose (const KernelVariables& kv, const int nlev,
                          const WorkSlot& src, const View& dst,
-                         typename std::enable_if<View::rank == 3>::type* = 0) {
-    assert(dst.extent_int(2)*packn >= nlev);
-    assert(dst.extent_int(0) == NP && dst.extent_int(1) == NP);
+                         const int ie0, const int nelem) {
+    assert(dst.extent_int(3)*packn >= nlev);
+    assert(dst.extent_int(1) == NP && dst.extent_int(2) == NP);
     const auto f = [&] (const int idx) {
+      if (ie0 + idx / ncol_elem >= nelem) return;
+      int ie, gi, gj;
+      get_col(idx, ie0, nelem, ie, gi, gj);
       const auto
-      gi = idx / NP,
-      gj = idx % NP,
       pi = idx / packn,
       si = idx % packn;
       const auto g = [&] (const int pk) {
@@ -485,12 +561,12 @@ struct DirkFunctorImpl {
         // If there is a remainder at the end, we nonetheless transfer these
         // unused data to avoid a conditional and runtime loop limit.
         for (int sk = 0; sk < packn; ++sk)
-          dst(gi,gj,pk)[sk] = src(k0+sk,pi)[si];
+          dst(ie,gi,gj,pk)[sk] = src(k0+sk,pi)[si];
       };
-      const auto p = Kokkos::ThreadVectorRange(kv.team, dst.extent_int(2));
+      const auto p = Kokkos::ThreadVectorRange(kv.team, dst.extent_int(3));
       Kokkos::parallel_for(p, g);
     };    
-    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP*NP), f);
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, static_cast<int>(scaln)), f);
   }
 
   // Compute a vertical velocity induced by surface topography:
@@ -499,12 +575,29 @@ struct DirkFunctorImpl {
   KOKKOS_INLINE_FUNCTION
   static void calc_gwphis (
     const KernelVariables& kv,
-    // All in arrays are in Hxx format.
+    // All in arrays are in Hxx format, for a single element.
     const R& dp3d, const Rv& v, const Rgphis& gradphis, const Rhybi& hybi,
     // Out array is in DIRK format. gwh_i(nlevp,:) is not written since it is
     // not used.
     const W& gwh_i,
     const int nlev = NUM_PHYSICAL_LEV)
+  {
+    calc_gwphis(kv, one_elem(dp3d), one_elem(v), one_elem(gradphis), hybi, 0, 1,
+                gwh_i, nlev);
+  }
+
+  template <typename R, typename Rv, typename Rgphis, typename Rhybi, typename W>
+  KOKKOS_INLINE_FUNCTION
+  static void calc_gwphis (
+    const KernelVariables& kv,
+    // All in arrays are in Hxx format, with the element index first.
+    const R& dp3d, const Rv& v, const Rgphis& gradphis, const Rhybi& hybi,
+    // The batch of elements starting at ie0.
+    const int ie0, const int nelem,
+    // Out array is in DIRK format. gwh_i(nlevp,:) is not written since it is
+    // not used.
+    const W& gwh_i,
+    const int nlev = NUM_PHYSICAL_LEV)
   {
     using Kokkos::parallel_for;
     using Kokkos::TeamThreadRange;
@@ -529,19 +622,18 @@ struct DirkFunctorImpl {
       const auto g = [&] (const int i) {
         Scalar dp3dk, dp3dkm1, v1k, v2k, v1km1, v2km1, gphis1, gphis2;
         for (int s = 0; s < packn; ++s) {
-          const auto
-          idx = packn*i + s,
-          gi = idx / NP,
-          gj = idx % NP;
+          const auto idx = packn*i + s;
           if (scaln % packn != 0 && idx >= scaln) break;
-          dp3dkm1[s] = dp3d(gi,gj,pkm1)[skm1];
-          dp3dk  [s] = dp3d(gi,gj,pk  )[sk];
-          v1km1  [s] = v (0,gi,gj,pkm1)[skm1];
-          v2km1  [s] = v (1,gi,gj,pkm1)[skm1];
-          v1k    [s] = v (0,gi,gj,pk  )[sk];
-          v2k    [s] = v (1,gi,gj,pk  )[sk];
-          gphis1 [s] = gradphis(0,gi,gj);
-          gphis2 [s] = gradphis(1,gi,gj);
+          int ie, gi, gj;
+          get_col(idx, ie0, nelem, ie, gi, gj);
+          dp3dkm1[s] = dp3d(ie,gi,gj,pkm1)[skm1];
+          dp3dk  [s] = dp3d(ie,gi,gj,pk  )[sk];
+          v1km1  [s] = v (ie,0,gi,gj,pkm1)[skm1];
+          v2km1  [s] = v (ie,1,gi,gj,pkm1)[skm1];
+          v1k    [s] = v (ie,0,gi,gj,pk  )[sk];
+          v2k    [s] = v (ie,1,gi,gj,pk  )[sk];
+          gphis1 [s] = gradphis(ie,0,gi,gj);
+          gphis2 [s] = gradphis(ie,1,gi,gj);
         }
         const auto den = dp3dkm1 + dp3dk;
         const auto v1_i = (dp3dk*v1k + dp3dkm1*v1km1) / den;
@@ -618,6 +710,18 @@ struct DirkFunctorImpl {
                 const HybridVCoord& hvcoord, const Rphis& phis, const R& vtheta_dp, const R& dp,
                 // phi_i on output
                 const W& wrk)
+  {
+    phi_from_eos(kv, nlev, nvec, hvcoord, one_elem(phis), 0, 1, vtheta_dp, dp, wrk);
+  }
+
+  // Same as above, with phis(ie,:,:) for the batch of elements starting at ie0.
+  template <typename Rphis, typename R, typename W>
+  KOKKOS_INLINE_FUNCTION static void
+  phi_from_eos (const KernelVariables& kv, const int nlev, const int nvec,
+                const HybridVCoord& hvcoord, const Rphis& phis,
+                const int ie0, const int nelem, const R& vtheta_dp, const R& dp,
+                // phi_i on output
+                const W& wrk)
   {
     // Scan to compute pressure.
     loop_ki(kv, 1, nvec, [&] (int, int i) {
@@ -635,7 +739,7 @@ struct DirkFunctorImpl {
     kv.team_barrier();
     // Scan to compute phi_i.
     loop_ki(kv, 1, nvec, [&] (int, int i) {
-      set_phis(i, phis, wrk);
+      set_phis(i, phis, ie0, nelem, wrk);
       for (int k = nlev-1; k >= 0; --k)
         wrk(k,i) = wrk(k+1,i) + wrk(k,i); // phi_i below + dphi
     });
@@ -644,22 +748,37 @@ struct DirkFunctorImpl {
   template <typename Rphis, typename W>
   KOKKOS_INLINE_FUNCTION static void
   set_phis (const int i, const Rphis& phis, const W& phi_i) {
+    set_phis(i, one_elem(phis), 0, 1, phi_i);
+  }
+
+  template <typename Rphis, typename W>
+  KOKKOS_INLINE_FUNCTION static void
+  set_phis (const int i, const Rphis& phis, const int ie0, const int nelem,
+            const W& phi_i) {
     for (int s = 0; s < packn; ++s) {
-      const int idx = i*packn + s, gi = idx / NP, gj = idx % NP;
+      const int idx = i*packn + s;
       if (scaln % packn != 0 && idx >= scaln) break;
-      phi_i(num_phys_lev,i)[s] = phis(gi,gj);
+      int ie, gi, gj;
+      get_col(idx, ie0, nelem, ie, gi, gj);
+      phi_i(num_phys_lev,i)[s] = phis(ie,gi,gj);
     }    
   }
 
+  // maxval(abs(w(0:nlev-1,:))) over the lanes of element b of the batch.
+  template <typename W>
   KOKKOS_INLINE_FUNCTION
-  static Real calc_wmax (const KernelVariables& kv, const int nlev, const int nvec,
-                         const WorkSlot& w) {
+  static Real calc_elem_maxabs (const KernelVariables& kv, const int nlev, const int b,
+                                const W& w) {
     using Kokkos::parallel_reduce;
     using Kokkos::TeamThreadRange;
     using Kokkos::ThreadVectorRange;
 
+    const int
+      nvec = nelem_batch == 1 ? static_cast<int>(npack) : ncol_elem/packn,
+      i0 = b*nvec;
     const auto f = [&] (int k, Real& maxval) {
-      const auto g = [&] (int i, Real& lmaxval) {
+      const auto g = [&] (int iv, Real& lmaxval) {
+        const int i = i0 + iv;
         const auto v = w(k,i);
         for (int s = 0; s < packn; ++s) {
           if (scaln % packn != 0 && i*packn + s >= scaln) break;
@@ -671,37 +790,52 @@ struct DirkFunctorImpl {
       parallel_reduce(vr, g, Kokkos::Max<Real>(lmaxval));
       maxval = max(maxval, lmaxval); // benign write race
     };
-    Real wmax;
+    Real val;
     const auto tr = TeamThreadRange(kv.team, nlev);
-    parallel_reduce(tr, f, Kokkos::Max<Real>(wmax));
-    return max(1.0, wmax);
+    parallel_reduce(tr, f, Kokkos::Max<Real>(val));
+    return val;
   }
 
+  // wmax(b) = max(1, maxval(abs(w))) for each element b of the batch.
   KOKKOS_INLINE_FUNCTION
-  static bool exit_on_step (const KernelVariables& kv, const int nlev, const int nvec,
-                            const Real& wmax, const Real& deltatol,
-                            const LinearSystemSlot& x, Real& deltaerr) {
-    using Kokkos::parallel_reduce;
-    using Kokkos::TeamThreadRange;
-    using Kokkos::ThreadVectorRange;
+  static void calc_wmax (const KernelVariables& kv, const int nlev,
+                         const WorkSlot& w, Real* wmax) {
+    for (int b = 0; b < nelem_batch; ++b)
+      wmax[b] = max(1.0, calc_elem_maxabs(kv, nlev, b, w));
+  }
 
-    // deltaerr = maxval(abs(x) / wmax
-    const auto f = [&] (int k, Real& maxval) {
-      const auto g = [&] (int i, Real& lmaxval) {
-        const auto v = x(k,i);
-        for (int s = 0; s < packn; ++s) {
-          if (scaln % packn != 0 && i*packn + s >= scaln) break;
-          lmaxval = max(lmaxval, std::abs(v[s]));
-        }
-      };
-      Real lmaxval;
-      const auto vr = ThreadVectorRange(kv.team, nvec);
-      parallel_reduce(vr, g, Kokkos::Max<Real>(lmaxval));
-      maxval = max(maxval, lmaxval); // benign write race
-    };
-    const auto tr = TeamThreadRange(kv.team, nlev);
-    parallel_reduce(tr, f, Kokkos::Max<Real>(deltaerr));
-    return deltaerr/wmax < deltatol;
+  // Deactivate the elements of the batch whose Newton increment is small enough.
+  // Return true if no element is active anymore. On output, deltaerr is the max
+  // error of the elements that were active on input.
+  KOKKOS_INLINE_FUNCTION
+  static bool exit_on_step (const KernelVariables& kv, const int nlev,
+                            const Real* wmax, const Real& deltatol,
+                            const LinearSystemSlot& x, bool* active, Real& deltaerr) {
+    bool done = true;
+    deltaerr = 0;
+    for (int b = 0; b < nelem_batch; ++b) {
+      if ( ! active[b]) continue;
+      // deltaerr = maxval(abs(x) / wmax
+      const Real err = calc_elem_maxabs(kv, nlev, b, x);
+      deltaerr = max(deltaerr, err);
+      if (err/wmax[b] < deltatol)
+        active[b] = false;
+      else
+        done = false;
+    }
+    return done;
+  }
+
+  // Whether any column of the element owning pack i is flagged in wrk(0,:). With
+  // a single element per team, this is the flag wrk(1,0).
+  KOKKOS_INLINE_FUNCTION
+  static bool elem_any_flagged (const WorkSlot& wrk, const int i) {
+    if (nelem_batch == 1) return wrk(1,0)[0] != 0;
+    const int nvec = ncol_elem/packn, i0 = batch_elem(i)*nvec;
+    for (int j = i0; j < i0 + nvec; ++j)
+      for (int s = 0; s < packn; ++s)
+        if (wrk(0,j)[s] != 0) return true;
+    return false;
   }
 
   /* Compute Jacobian of F(phi) = sum(dphi) + const + (dt*g)^2 *(1-dp/dpi)
@@ -800,7 +934,8 @@ struct DirkFunctorImpl {
     using Kokkos::TeamThreadRange;
     using Kokkos::ThreadVectorRange;
     // Set all alpha_k to 1 except row 0. Include row nlev for use as a flag.
-    loop_ki(kv, nlev, nvec, [&] (int k, int i) { wrk(k+1,i) = 1; });
+    // Elements with no flagged column keep their step length.
+    loop_ki(kv, nlev, nvec, [&] (int k, int i) { if (elem_any_flagged(wrk,i)) wrk(k+1,i) = 1; });
     kv.team_barrier();
     loop_ki(kv, nlev, nvec, [&] (int k, int i) {
       for (int s = 0; s < packn; ++s) {
@@ -899,8 +1034,9 @@ struct DirkFunctorImpl {
     // suboptimal, but it's much better to do it like this than have separate
     // kernels just b/c of a safety scan. All scans except the initial guess,
     // which we do indeed handle in a separate kernel, are triggered only very
-    // occasionally.
+    // occasionally. With batched elements, scan only the elements with a bad col.
     loop_ki(kv, 1, nvec, [&] (int, int i) {
+      if ( ! elem_any_flagged(wrk,i)) return;
       for (int k = nlev-1; k >= 0; --k)
         phi_i(k,i) = phi_i(k+1,i) - dphi(k,i);
     });
@@ -202,9 +202,18 @@ void HyperviscosityFunctorImpl::init_boundary_exchanges () {
   m_be_tom = std::make_shared<BoundaryExchange>();
   m_be->set_label("Hyperviscosity-std");
   m_be_tom->set_label("Hyperviscosity-TOM");
-  std::shared_ptr<BoundaryExchange> bes[] = {m_be, m_be_tom};
-  const int nlevs[] = {NUM_LEV, m_nu_scale_top_ilev_pack_lim};
-  for (int i = 0; i < 2; ++i) {
+#ifdef HOMMEXX_HV_FP32_EXCHANGE
+  // The laplacian is an intermediate result, and can tolerate single precision
+  m_be_lap = std::make_shared<BoundaryExchange>();
+  m_be_lap->set_label("Hyperviscosity-lap");
+  const int nbes = 3;
+#else
+  m_be_lap = m_be;
+  const int nbes = 2;
+#endif
+  std::shared_ptr<BoundaryExchange> bes[] = {m_be, m_be_tom, m_be_lap};
+  const int nlevs[] = {NUM_LEV, m_nu_scale_top_ilev_pack_lim, NUM_LEV};
+  for (int i = 0; i < nbes; ++i) {
     if (i == 1 && m_data.nu_top <= 0) continue;
     auto be = bes[i];
     be->set_diagnostics_level(sp.internal_diagnostics_level);
@@ -215,6 +224,7 @@ void HyperviscosityFunctorImpl::init_boundary_exchanges () {
     } else {
       be->set_num_fields(0, 0, 4);
     }
+    be->set_register_as_fp32(i == 2);
     be->register_field(m_buffers.dptens, nlev);
     be->register_field(m_buffers.ttens, nlev);
     if (m_process_nh_vars) {
@@ -266,6 +276,9 @@ void HyperviscosityFunctorImpl::run (const int np1, const Real dt, const Real et
   });
   Kokkos::fence();
 
+#ifdef HOMMEXX_HV_FUSED_SUBCYCLE
+  run_fused_subcycles();
+#else
   for (int icycle = 0; icycle < m_data.hypervis_subcycle; ++icycle) {
     GPTLstart("hvf-bhwk");
     biharmonic_wk_theta ();
@@ -284,6 +297,7 @@ void HyperviscosityFunctorImpl::run (const int np1, const Real dt, const Real et
     Kokkos::parallel_for(m_policy_update_states, *this);
     Kokkos::fence();
   } //subcycle
+#endif
 
   // Convert theta back to vtheta, and adjust w at surface
   auto geo = m_geometry;
@@ -359,9 +373,9 @@ void HyperviscosityFunctorImpl::biharmonic_wk_theta() const
   Kokkos::fence();
 
   // Exchange
-  assert (m_be->is_registration_completed());
+  assert (m_be_lap->is_registration_completed());
   GPTLstart("hvf-bexch");
-  m_be->exchange(m_geometry.m_rspheremp);
+  m_be_lap->exchange(m_geometry.m_rspheremp);
   GPTLstop("hvf-bexch");
 
   // Compute second laplacian, tensor or const hv
@@ -376,6 +390,62 @@ void HyperviscosityFunctorImpl::biharmonic_wk_theta() const
   Kokkos::fence();
 } //biharmonic
 
+void HyperviscosityFunctorImpl::run_fused_subcycles() const
+{
+  // The two exchanges of each subcycle are the only points where elements need
+  // data from their neighbors, so all the stages in between can be done by the
+  // same team, without going back to global memory and relaunching:
+  //   first laplace          (first subcycle only)
+  //   exchange(rspheremp)
+  //   second laplace + pre-exchange
+  //   exchange
+  //   update states + first laplace of the next subcycle (or just update states)
+  // The element-local work is the same as in the unfused loop, so this is BFB.
+  if (m_data.hypervis_subcycle <= 0) {
+    return;
+  }
+
+  assert (m_be_lap->is_registration_completed());
+  assert (m_be->is_registration_completed());
+
+  const int ne = m_geometry.num_elems();
+  const auto policy_update_laplace =
+    Homme::get_default_team_policy<ExecSpace,TagUpdateStatesFirstLaplaceHV>(ne);
+
+  GPTLstart("hvf-bhwk");
+  Kokkos::parallel_for(m_policy_first_laplace, *this);
+  Kokkos::fence();
+  GPTLstop("hvf-bhwk");
+
+  for (int icycle = 0; icycle < m_data.hypervis_subcycle; ++icycle) {
+    GPTLstart("hvf-bexch");
+    m_be_lap->exchange(m_geometry.m_rspheremp);
+    GPTLstop("hvf-bexch");
+
+    GPTLstart("hvf-bhwk");
+    if ( m_data.consthv ) {
+      auto policy = Homme::get_default_team_policy<ExecSpace,TagSecondLaplaceConstHVPreExchange>(ne);
+      Kokkos::parallel_for(policy, *this);
+    }else{
+      auto policy = Homme::get_default_team_policy<ExecSpace,TagSecondLaplaceTensorHVPreExchange>(ne);
+      Kokkos::parallel_for(policy, *this);
+    }
+    Kokkos::fence();
+    GPTLstop("hvf-bhwk");
+
+    GPTLstart("hvf-bexch");
+    m_be->exchange();
+    GPTLstop("hvf-bexch");
+
+    if (icycle < m_data.hypervis_subcycle-1) {
+      Kokkos::parallel_for(policy_update_laplace, *this);
+    } else {
+      Kokkos::parallel_for(m_policy_update_states, *this);
+    }
+    Kokkos::fence();
+  } //subcycle
+}
+
 // Laplace for nu_top
 KOKKOS_INLINE_FUNCTION
 void HyperviscosityFunctorImpl::operator() (const TagNutopLaplace&, const TeamMember& team) const {
@@ -86,6 +86,12 @@ public:
   struct TagNutopUpdateStates {};
   struct TagNutopLaplace {};
 
+  // Fused kernels, used if HOMMEXX_HV_FUSED_SUBCYCLE is defined. They chain the
+  // element-local stages between two consecutive exchanges in a single launch.
+  struct TagSecondLaplaceConstHVPreExchange {};
+  struct TagSecondLaplaceTensorHVPreExchange {};
+  struct TagUpdateStatesFirstLaplaceHV {};
+
   HyperviscosityFunctorImpl (const SimulationParams&     params,
                              const ElementsGeometry&     geometry,
                              const ElementsState&        state,
@@ -107,6 +113,9 @@ public:
 
   void biharmonic_wk_theta () const;
 
+  // Same as the subcycle loop in run, but launching one kernel between two exchanges
+  void run_fused_subcycles () const;
+
   // first iter of laplace, const hv
   KOKKOS_INLINE_FUNCTION
   void operator() (const TagFirstLaplaceHV&, const TeamMember& team) const {
@@ -311,6 +320,29 @@ public:
     });
   }  //tagupdatestates
 
+  // Second laplacian followed by the pre-exchange stage, for the same element
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const TagSecondLaplaceConstHVPreExchange&, const TeamMember& team) const {
+    (*this)(TagSecondLaplaceConstHV(), team);
+    team.team_barrier();
+    (*this)(TagHyperPreExchange(), team);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const TagSecondLaplaceTensorHVPreExchange&, const TeamMember& team) const {
+    (*this)(TagSecondLaplaceTensorHV(), team);
+    team.team_barrier();
+    (*this)(TagHyperPreExchange(), team);
+  }
+
+  // States update followed by the first laplacian of the next subcycle
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const TagUpdateStatesFirstLaplaceHV&, const TeamMember& team) const {
+    (*this)(TagUpdateStates(), team);
+    team.team_barrier();
+    (*this)(TagFirstLaplaceHV(), team);
+  }
+
   KOKKOS_INLINE_FUNCTION
   void operator()(const TagHyperPreExchange, const TeamMember &team) const {
     using IntColumn = decltype(Homme::subview(m_state.m_w_i,0,0,0,0));
@@ -410,6 +442,9 @@ protected:
   TeamUtils<ExecSpace> m_tu; // If the policies only differ by tag, just need one tu
 
   std::shared_ptr<BoundaryExchange> m_be, m_be_tom;
+  // Used for the laplacian exchange in biharmonic_wk_theta. Unless HOMMEXX_HV_FP32_EXCHANGE
+  // is defined, this is the same as m_be, otherwise it exchanges the fields in FP32.
+  std::shared_ptr<BoundaryExchange> m_be_lap;
 
   ExecViewManaged<Scalar[NUM_LEV]> m_nu_scale_top;
   int m_nu_scale_top_ilev_pack_lim;
@@ -0,0 +1,448 @@
+#include <catch2/catch.hpp>
+
+#include "Types.hpp"
+#include "Context.hpp"
+#include "CaarFunctorImpl.hpp"
+#include "DirkFunctor.hpp"
+#include "EulerStepFunctor.hpp"
+#include "HyperviscosityFunctorImpl.hpp"
+#include "LimiterFunctor.hpp"
+#include "VerticalRemapManager.hpp"
+#include "FunctorsBuffersManager.hpp"
+#include "SimulationParams.hpp"
+#include "Tracers.hpp"
+#include "PhysicalConstants.hpp"
+#include "mpi/BoundaryExchange.hpp"
+#include "mpi/Comm.hpp"
+#include "mpi/Connectivity.hpp"
+#include "mpi/MpiBuffersManager.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <random>
+
+using namespace Homme;
+
+extern int hommexx_catch2_argc;
+extern char** hommexx_catch2_argv;
+
+extern "C" {
+void init_caar_f90 (const int& ne,
+               const Real* hyai_ptr, const Real* hybi_ptr,
+               const Real* hyam_ptr, const Real* hybm_ptr,
+               Real* dvv, Real* mp,
+               const Real& ps0);
+void init_geo_views_f90 (Real*& d_ptr,Real*& dinv_ptr,
+               const Real*& phis_ptr, const Real*& gradphis_ptr,
+               Real*& fcor_ptr,
+               Real*& sphmp_ptr, Real*& rspmp_ptr,
+               Real*& tVisc_ptr, Real*& sph2c_ptr,
+               Real*& metdet_ptr, Real*& metinv_ptr);
+void cleanup_f90();
+} // extern "C"
+
+// Standalone timings of the HOMMEXX functors, on a cubed sphere with ne elements
+// per face edge (i.e., 6*ne^2/nranks elements per rank). Usage:
+//   perf_bench hommexx [-ne NE] [-nrep NREP] [-qsize QSIZE] [-json FILE]
+//                      [-peak-bw GBs] [-only NAME]
+// Each functor is timed NREP times (after one warmup call), fencing the device
+// around each call; the time of a call is the max over the ranks.
+//
+// The reported bandwidth is based on a model of the compulsory memory traffic
+// of a call, i.e., the bytes of all the arrays it reads or writes, each counted
+// once per read and once per write. Most of these kernels are memory bound, so
+// the fraction of the peak bandwidth (if -peak-bw is given, e.g. from STREAM) is
+// their position against the memory roof of the roofline. The model is a lower
+// bound of the actual traffic, so a fraction well below 1 points to cache
+// misses, (lack of) occupancy, or latency, rather than to the kernel's arithmetic.
+
+namespace {
+
+struct BenchOptions {
+  int ne = 2;
+  int nrep = 10;
+  int qsize = QSIZE_D;
+  Real peak_bw = 0;      // GB/s, 0 if unknown
+  std::string json_file;
+  std::string only;
+
+  void parse (const Comm& comm) {
+    bool ok = true;
+    int i;
+    for (i = 0; i < hommexx_catch2_argc; ++i) {
+      const std::string tok(hommexx_catch2_argv[i]);
+      const bool has_val = i+1 < hommexx_catch2_argc;
+      if (tok == "-ne" && has_val) {
+        ne = std::atoi(hommexx_catch2_argv[++i]);
+      } else if (tok == "-nrep" && has_val) {
+        nrep = std::atoi(hommexx_catch2_argv[++i]);
+      } else if (tok == "-qsize" && has_val) {
+        qsize = std::atoi(hommexx_catch2_argv[++i]);
+      } else if (tok == "-peak-bw" && has_val) {
+        peak_bw = std::atof(hommexx_catch2_argv[++i]);
+      } else if (tok == "-json" && has_val) {
+        json_file = hommexx_catch2_argv[++i];
+      } else if (tok == "-only" && has_val) {
+        only = hommexx_catch2_argv[++i];
+      } else {
+        ok = false;
+        break;
+      }
+    }
+    ne = std::max(1, ne);
+    nrep = std::max(1, nrep);
+    qsize = std::max(1, std::min(QSIZE_D, qsize));
+    if ( ! ok && comm.root())
+      printf("perf_bench> Failed to parse command line, starting with: %s\n",
+             hommexx_catch2_argv[i]);
+  }
+};
+
+struct BenchResult {
+  std::string name;
+  int    nrep;
+  double time_min; // s
+  double time_avg; // s
+  double bytes;    // Modeled traffic of one call
+};
+
+template <typename V>
+double nbytes (const V& v) {
+  return static_cast<double>(v.span())*sizeof(typename V::value_type);
+}
+
+// Run pre (untimed) and f nrep times, after one warmup call
+BenchResult time_functor (const Comm& comm, const std::string& name, const int nrep,
+                          const double bytes, const std::function<void()>& pre,
+                          const std::function<void()>& f) {
+  using clock = std::chrono::steady_clock;
+  BenchResult r;
+  r.name = name;
+  r.nrep = nrep;
+  r.bytes = bytes;
+  r.time_min = std::numeric_limits<double>::max();
+  r.time_avg = 0;
+  for (int irep = -1; irep < nrep; ++irep) {
+    pre();
+    Kokkos::fence();
+    MPI_Barrier(comm.mpi_comm());
+    const auto t0 = clock::now();
+    f();
+    Kokkos::fence();
+    double t = std::chrono::duration<double>(clock::now() - t0).count();
+    MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, comm.mpi_comm());
+    if (irep < 0) continue;
+    r.time_min = std::min(r.time_min, t);
+    r.time_avg += t/nrep;
+  }
+  return r;
+}
+
+void write_json (const std::string& fname, const BenchOptions& opts,
+                 const int nranks, const int nelemd,
+                 const std::vector<BenchResult>& results) {
+  std::ofstream ofs(fname);
+  Errors::runtime_check(ofs.good(), "perf_bench: could not open " + fname);
+  ofs << "{\n"
+      << "  \"config\": {\n"
+      << "    \"exec_space\": \"" << ExecSpace::name() << "\",\n"
+      << "    \"concurrency\": " << ExecSpace().concurrency() << ",\n"
+      << "    \"vector_size\": " << VECTOR_SIZE << ",\n"
+      << "    \"num_physical_lev\": " << NUM_PHYSICAL_LEV << ",\n"
+      << "    \"qsize\": " << opts.qsize << ",\n"
+      << "    \"ne\": " << opts.ne << ",\n"
+      << "    \"num_ranks\": " << nranks << ",\n"
+      << "    \"num_elems_per_rank\": " << nelemd << ",\n"
+      << "    \"peak_bw_GBs\": " << opts.peak_bw << "\n"
+      << "  },\n"
+      << "  \"results\": [\n";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto& r = results[i];
+    const double gbs = r.bytes/r.time_min*1e-9;
+    ofs << "    { \"name\": \"" << r.name << "\""
+        << ", \"nrep\": " << r.nrep
+        << ", \"time_min_s\": " << r.time_min
+        << ", \"time_avg_s\": " << r.time_avg
+        << ", \"bytes\": " << r.bytes
+        << ", \"GBs\": " << gbs
+        << ", \"frac_peak_bw\": " << (opts.peak_bw > 0 ? gbs/opts.peak_bw : 0)
+        << " }" << (i+1 < results.size() ? "," : "") << "\n";
+  }
+  ofs << "  ]\n}\n";
+}
+
+} // anonymous namespace
+
+TEST_CASE("perf_bench", "[perf]") {
+  auto& c = Context::singleton();
+  const auto& comm = c.get<Comm>();
+
+  BenchOptions opts;
+  opts.parse(comm);
+  const auto run_it = [&] (const std::string& name) {
+    return opts.only.empty() || opts.only == name;
+  };
+
+  const unsigned int seed = 42;
+  std::mt19937_64 engine(seed);
+
+  // Params of a typical nonhydrostatic run
+  auto& params = c.create<SimulationParams>();
+  params.params_set = true;
+  params.theta_hydrostatic_mode = false;
+  params.theta_adv_form = AdvectionForm::NonConservative;
+  params.rsplit = 3;
+  params.qsplit = 1;
+  params.qsize = opts.qsize;
+  params.transport_alg = 0;
+  params.limiter_option = 9;
+  params.remap_alg = RemapAlg::PPM_LIMITED_EXTRAP;
+  params.nu = params.nu_div = 1e15;
+  params.nu_p = params.nu_s = 1e15;
+  params.nu_q = 1e15;
+  params.nu_top = 0;
+  params.hypervis_order = 2;
+  params.hypervis_scaling = 0;
+  params.hypervis_subcycle = 1;
+  params.hypervis_subcycle_tom = 0;
+  params.nu_ratio1 = params.nu_ratio2 = 1;
+  params.dp3d_thresh = 0.125;
+  params.vtheta_thresh = 100.0;
+  params.scale_factor = PhysicalConstants::rearth0;
+  params.laplacian_rigid_factor = 1/params.scale_factor;
+
+  auto& hvcoord = c.create<HybridVCoord>();
+  auto& ref_FE  = c.create<ReferenceElement>();
+  hvcoord.random_init(seed);
+
+  auto hyai = Kokkos::create_mirror_view(hvcoord.hybrid_ai);
+  auto hybi = Kokkos::create_mirror_view(hvcoord.hybrid_bi);
+  auto hyam = Kokkos::create_mirror_view(hvcoord.hybrid_am);
+  auto hybm = Kokkos::create_mirror_view(hvcoord.hybrid_bm);
+  Kokkos::deep_copy(hyai,hvcoord.hybrid_ai);
+  Kokkos::deep_copy(hybi,hvcoord.hybrid_bi);
+  Kokkos::deep_copy(hyam,hvcoord.hybrid_am);
+  Kokkos::deep_copy(hybm,hvcoord.hybrid_bm);
+
+  std::vector<Real> dvv(NP*NP), mp(NP*NP);
+
+  // This will also init the c connectivity.
+  init_caar_f90(opts.ne,hyai.data(),hybi.data(),
+                reinterpret_cast<Real*>(hyam.data()),reinterpret_cast<Real*>(hybm.data()),
+                dvv.data(),mp.data(),hvcoord.ps0);
+  ref_FE.init_mass(mp.data());
+  ref_FE.init_deriv(dvv.data());
+
+  const int nelemd = c.get<Connectivity>().get_num_local_elements();
+  if (comm.root())
+    printf("perf_bench> ne %d nranks %d nelemd %d qsize %d nrep %d vector_size %d\n",
+           opts.ne, comm.size(), nelemd, opts.qsize, opts.nrep, VECTOR_SIZE);
+
+  // Elements and tracers, also registered piecewise in the context, as in a run
+  auto& elems = c.create<Elements>();
+  elems.init(nelemd,true,true,params.scale_factor,params.laplacian_rigid_factor);
+  c.create_ref<ElementsGeometry>(elems.m_geometry);
+  c.create_ref<ElementsState>(elems.m_state);
+  c.create_ref<ElementsDerivedState>(elems.m_derived);
+  auto& tracers = c.create<Tracers>();
+  tracers.init(nelemd,params.qsize);
+
+  auto& geo = elems.m_geometry;
+  geo.randomize(seed);
+  {
+    auto d        = Kokkos::create_mirror_view(geo.m_d);
+    auto dinv     = Kokkos::create_mirror_view(geo.m_dinv);
+    auto phis     = Kokkos::create_mirror_view(geo.m_phis);
+    auto gradphis = Kokkos::create_mirror_view(geo.m_gradphis);
+    auto fcor     = Kokkos::create_mirror_view(geo.m_fcor);
+    auto spmp     = Kokkos::create_mirror_view(geo.m_spheremp);
+    auto rspmp    = Kokkos::create_mirror_view(geo.m_rspheremp);
+    auto tVisc    = Kokkos::create_mirror_view(geo.m_tensorvisc);
+    auto sph2c    = Kokkos::create_mirror_view(geo.m_vec_sph2cart);
+    auto mdet     = Kokkos::create_mirror_view(geo.m_metdet);
+    auto minv     = Kokkos::create_mirror_view(geo.m_metinv);
+    Kokkos::deep_copy(phis,geo.m_phis);
+    Kokkos::deep_copy(gradphis,geo.m_gradphis);
+
+    Real* d_ptr     = d.data();
+    Real* dinv_ptr  = dinv.data();
+    Real* fcor_ptr  = fcor.data();
+    Real* spmp_ptr  = spmp.data();
+    Real* rspmp_ptr = rspmp.data();
+    Real* tVisc_ptr = tVisc.data();
+    Real* sph2c_ptr = sph2c.data();
+    Real* mdet_ptr  = mdet.data();
+    Real* minv_ptr  = minv.data();
+    const Real* phis_ptr     = phis.data();
+    const Real* gradphis_ptr = gradphis.data();
+    init_geo_views_f90(d_ptr,dinv_ptr,phis_ptr,gradphis_ptr,fcor_ptr,
+                       spmp_ptr,rspmp_ptr,tVisc_ptr,
+                       sph2c_ptr,mdet_ptr,minv_ptr);
+
+    Kokkos::deep_copy(geo.m_d,d);
+    Kokkos::deep_copy(geo.m_dinv,dinv);
+    Kokkos::deep_copy(geo.m_spheremp,spmp);
+    Kokkos::deep_copy(geo.m_rspheremp,rspmp);
+    Kokkos::deep_copy(geo.m_tensorvisc,tVisc);
+    Kokkos::deep_copy(geo.m_vec_sph2cart,sph2c);
+    Kokkos::deep_copy(geo.m_metdet,mdet);
+    Kokkos::deep_copy(geo.m_metinv,minv);
+    Kokkos::deep_copy(geo.m_fcor,fcor);
+  }
+
+  auto& bmm = c.create<MpiBuffersManagerMap>();
+  bmm.set_connectivity(c.get_ptr<Connectivity>());
+  auto& sphop = c.create<SphereOperators>();
+  sphop.setup(geo,ref_FE);
+  auto& limiter = c.create<LimiterFunctor>(elems,hvcoord,params);
+
+  // Initial state. Each call is fed the same state, so that it does the
+  // same work (e.g., the same number of Newton iterations in DIRK) each time.
+  auto& state = elems.m_state;
+  auto& derived = elems.m_derived;
+  const auto max_pressure = 1000.0 + hvcoord.ps0;
+  state.randomize(seed,max_pressure,hvcoord.ps0,hvcoord.hybrid_ai0,geo.m_phis);
+  derived.randomize(seed,std::uniform_real_distribution<Real>(0.1,1.0)(engine));
+  tracers.randomize(seed,0.1,1.0);
+
+  const auto copy_of = [] (const auto& v) {
+    typename std::decay<decltype(v)>::type cv(std::string(v.label()) + "_0", v.extent(0));
+    Kokkos::deep_copy(cv, v);
+    return cv;
+  };
+  const auto v0 = copy_of(state.m_v);
+  const auto w_i0 = copy_of(state.m_w_i);
+  const auto vtheta_dp0 = copy_of(state.m_vtheta_dp);
+  const auto phinh_i0 = copy_of(state.m_phinh_i);
+  const auto dp3d0 = copy_of(state.m_dp3d);
+  const auto ps_v0 = copy_of(state.m_ps_v);
+  const auto qdp0 = copy_of(tracers.qdp);
+  const auto restore = [&] () {
+    Kokkos::deep_copy(state.m_v, v0);
+    Kokkos::deep_copy(state.m_w_i, w_i0);
+    Kokkos::deep_copy(state.m_vtheta_dp, vtheta_dp0);
+    Kokkos::deep_copy(state.m_phinh_i, phinh_i0);
+    Kokkos::deep_copy(state.m_dp3d, dp3d0);
+    Kokkos::deep_copy(state.m_ps_v, ps_v0);
+    Kokkos::deep_copy(tracers.qdp, qdp0);
+  };
+
+  // Functors
+  CaarFunctorImpl caar(elems,tracers,ref_FE,hvcoord,sphop,params);
+  HyperviscosityFunctorImpl hvf(params,geo,state,derived);
+  EulerStepFunctor esf;
+  esf.reset(params);
+  VerticalRemapManager vrm(nelemd);
+  vrm.setup();
+  DirkFunctor dirk(nelemd);
+
+  FunctorsBuffersManager fbm;
+  fbm.request_size(caar.requested_buffer_size());
+  fbm.request_size(limiter.requested_buffer_size());
+  fbm.request_size(hvf.requested_buffer_size());
+  fbm.request_size(esf.requested_buffer_size());
+  fbm.request_size(vrm.requested_buffer_size());
+  fbm.request_size(dirk.requested_buffer_size());
+  fbm.allocate();
+  caar.init_buffers(fbm);
+  limiter.init_buffers(fbm);
+  hvf.init_buffers(fbm);
+  esf.init_buffers(fbm);
+  vrm.init_buffers(fbm);
+  dirk.init_buffers(fbm);
+
+  caar.init_boundary_exchanges(bmm[MPI_EXCHANGE]);
+  hvf.init_boundary_exchanges();
+  esf.init_boundary_exchanges();
+
+  // Standalone exchange of the dynamics state, as done at the end of each RK stage
+  const int nm1 = 0, n0 = 1, np1 = 2;
+  BoundaryExchange be;
+  be.set_buffers_manager(bmm[MPI_EXCHANGE]);
+  be.set_num_fields(0,0,4,2);
+  be.register_field(state.m_v,np1,2,0);
+  be.register_field(state.m_vtheta_dp,1,np1);
+  be.register_field(state.m_dp3d,1,np1);
+  be.register_field(state.m_w_i,1,np1);
+  be.register_field(state.m_phinh_i,1,np1);
+  be.registration_completed();
+
+  // Memory traffic model (see top of file)
+  const int ntl = NUM_TIME_LEVELS;
+  const double state_tl = (nbytes(state.m_dp3d) + nbytes(state.m_vtheta_dp) + nbytes(state.m_v) +
+                           nbytes(state.m_w_i) + nbytes(state.m_phinh_i))/ntl;
+  const double geo_bytes = nbytes(geo.m_d) + nbytes(geo.m_dinv) + nbytes(geo.m_metdet) +
+                           nbytes(geo.m_spheremp) + nbytes(geo.m_fcor) + nbytes(geo.m_phis) +
+                           nbytes(geo.m_gradphis);
+  const double qdp_tl = nbytes(tracers.qdp)/Q_NUM_TIME_LEVELS;
+  const double dp_tl = nbytes(state.m_dp3d)/ntl;
+  const double nh_tl = (nbytes(state.m_w_i) + nbytes(state.m_phinh_i))/ntl;
+  const double vth_tl = nbytes(state.m_vtheta_dp)/ntl;
+
+  std::vector<BenchResult> results;
+  const auto nrep = opts.nrep;
+
+  if (run_it("caar")) {
+    // Read nm1, n0, write np1; read/update the derived quantities
+    const RKStageData data(nm1, n0, np1, 0, 1.0, 1.0, 1.0, 1.0, 1.0);
+    const double bytes = 3*state_tl + geo_bytes +
+      2*(nbytes(derived.m_vn0) + nbytes(derived.m_omega_p) + nbytes(derived.m_eta_dot_dpdn));
+    results.push_back(time_functor(comm, "caar", nrep, bytes, restore,
+                                   [&] () { caar.run(data); }));
+  }
+  if (run_it("hyperviscosity")) {
+    // Read and write np1 in each subcycle, plus the geometry
+    const double bytes = params.hypervis_subcycle*(2*state_tl + geo_bytes +
+                                                   nbytes(geo.m_tensorvisc));
+    results.push_back(time_functor(comm, "hyperviscosity", nrep, bytes, restore,
+                                   [&] () { hvf.run(np1, 1.0, 1.0); }));
+  }
+  if (run_it("euler_step")) {
+    // Read qdp(n0), write qdp(np1), read the advecting velocity and dp
+    const double bytes = 2*qdp_tl + nbytes(derived.m_vn0) + dp_tl + geo_bytes;
+    results.push_back(time_functor(comm, "euler_step", nrep, bytes, restore,
+                                   [&] () { esf.euler_step(1, 0, 1.0, 0.0, DSSOption::ETA); }));
+  }
+  if (run_it("vertical_remap")) {
+    // Read and write the np1 state and qdp
+    const double bytes = 2*state_tl + 2*qdp_tl;
+    results.push_back(time_functor(comm, "vertical_remap", nrep, bytes, restore,
+                                   [&] () { vrm.run_remap(np1, 0, 1.0); }));
+  }
+  if (run_it("dirk")) {
+    // Read and write w_i and phinh_i at np1, read dp3d, vtheta_dp at np1
+    const double bytes = 2*nh_tl + dp_tl + vth_tl + nbytes(geo.m_phis);
+    results.push_back(time_functor(comm, "dirk", nrep, bytes, restore,
+                                   [&] () { dirk.run(-1, 0, n0, 0, np1, 0.15, elems, hvcoord); }));
+  }
+  if (run_it("boundary_exchange")) {
+    // Unpack reads and writes the whole element fields
+    const double bytes = 2*state_tl;
+    results.push_back(time_functor(comm, "boundary_exchange", nrep, bytes, restore,
+                                   [&] () { be.exchange(geo.m_rspheremp); }));
+  }
+
+  if (comm.root()) {
+    printf("perf_bench> %-20s %12s %12s %10s %10s\n",
+           "functor", "min [s]", "avg [s]", "GB/s", "frac peak");
+    for (const auto& r : results) {
+      const double gbs = r.bytes/r.time_min*1e-9;
+      printf("perf_bench> %-20s %12.5e %12.5e %10.2f %10.3f\n",
+             r.name.c_str(), r.time_min, r.time_avg, gbs,
+             opts.peak_bw > 0 ? gbs/opts.peak_bw : 0.0);
+    }
+    if ( ! opts.json_file.empty())
+      write_json(opts.json_file, opts, comm.size(), nelemd, results);
+  }
+  REQUIRE(results.size() > 0);
+
+  // Cleanup (see caar_ut for the treatment of Comm)
+  be.clean_up();
+  auto old_comm = c.get_ptr<Comm>();
+  c.finalize_singleton();
+  auto& new_comm = c.create<Comm>();
+  new_comm = *old_comm;
+
+  cleanup_f90();
+}
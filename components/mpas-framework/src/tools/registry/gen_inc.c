@@ -1655,6 +1655,162 @@ int parse_var_array(FILE *fd, ezxml_t registry, ezxml_t superStruct, ezxml_t var
 }/*}}}*/
 
 
+int write_var_attributes(FILE *fd, ezxml_t var_xml, const char *pointer_name_arr, const char *spacing, const char *missing_value)/*{{{*/
+{
+	const char *varunits, *vardesc, *varmissingval, *varmissing_value_mask;
+	const char *varbounds, *varcellmeasures, *varcellmethod, *varcoords, *varstdname;
+	char *string, *tofree, *token;
+	char temp_str[1024];
+
+	varunits = ezxml_attr(var_xml, "units");
+	varbounds = ezxml_attr(var_xml, "bounds");
+	varcellmeasures = ezxml_attr(var_xml, "cell_measures");
+	varcellmethod = ezxml_attr(var_xml, "cell_method");
+	varcoords = ezxml_attr(var_xml, "coordinates");
+	varstdname = ezxml_attr(var_xml, "standard_name");
+	vardesc = ezxml_attr(var_xml, "description");
+	varmissingval = ezxml_attr(var_xml, "missing_value");
+	varmissing_value_mask = ezxml_attr(var_xml, "missing_value_mask");
+
+	fortprintf(fd, "      %sallocate(%s %% attLists(1))\n", spacing, pointer_name_arr);
+	fortprintf(fd, "      %sallocate(%s %% attLists(1) %% attList)\n", spacing, pointer_name_arr);
+
+	if ( varunits != NULL ) {
+		string = strdup(varunits);
+		tofree = string;
+		token = strsep(&string, "'");
+
+		sprintf(temp_str, "%s", token);
+
+		while ( ( token = strsep(&string, "'") ) != NULL ) {
+			sprintf(temp_str, "%s''%s", temp_str, token);
+		}
+
+		free(tofree);
+
+		fortprintf(fd, "      %scall mpas_add_att(%s %% attLists(1) %% attList, 'units', '%s')\n", spacing, pointer_name_arr, temp_str);
+	}
+
+	if ( varbounds != NULL ) {
+		string = strdup(varbounds);
+		tofree = string;
+		token = strsep(&string, "'");
+
+		sprintf(temp_str, "%s", token);
+
+		while ( ( token = strsep(&string, "'") ) != NULL ) {
+			sprintf(temp_str, "%s''%s", temp_str, token);
+		}
+
+		free(tofree);
+
+		fortprintf(fd, "      %scall mpas_add_att(%s %% attLists(1) %% attList, 'bounds', '%s')\n", spacing, pointer_name_arr, temp_str);
+	}
+
+	if ( varcellmeasures != NULL ) {
+		string = strdup(varcellmeasures);
+		tofree = string;
+		token = strsep(&string, "'");
+
+		sprintf(temp_str, "%s", token);
+
+		while ( ( token = strsep(&string, "'") ) != NULL ) {
+			sprintf(temp_str, "%s''%s", temp_str, token);
+		}
+
+		free(tofree);
+
+		fortprintf(fd, "      %scall mpas_add_att(%s %% attLists(1) %% attList, 'cell_measures', '%s')\n", spacing, pointer_name_arr, temp_str);
+	}
+
+	if ( varcellmethod != NULL ) {
+		string = strdup(varcellmethod);
+		tofree = string;
+		token = strsep(&string, "'");
+
+		sprintf(temp_str, "%s", token);
+
+		while ( ( token = strsep(&string, "'") ) != NULL ) {
+			sprintf(temp_str, "%s''%s", temp_str, token);
+		}
+
+		free(tofree);
+
+		fortprintf(fd, "      %scall mpas_add_att(%s %% attLists(1) %% attList, 'cell_method', '%s')\n", spacing, pointer_name_arr, temp_str);
+	}
+
+	if ( varcoords != NULL ) {
+		string = strdup(varcoords);
+		tofree = string;
+		token = strsep(&string, "'");
+
+		sprintf(temp_str, "%s", token);
+
+		while ( ( token = strsep(&string, "'") ) != NULL ) {
+			sprintf(temp_str, "%s''%s", temp_str, token);
+		}
+
+		free(tofree);
+
+		fortprintf(fd, "      %scall mpas_add_att(%s %% attLists(1) %% attList, 'coordinates', '%s')\n", spacing, pointer_name_arr, temp_str);
+	}
+
+	if ( varstdname != NULL ) {
+		string = strdup(varstdname);
+		tofree = string;
+		token = strsep(&string, "'");
+
+		sprintf(temp_str, "%s", token);
+
+		while ( ( token = strsep(&string, "'") ) != NULL ) {
+			sprintf(temp_str, "%s''%s", temp_str, token);
+		}
+
+		free(tofree);
+
+		fortprintf(fd, "      %scall mpas_add_att(%s %% attLists(1) %% attList, 'standard_name', '%s')\n", spacing, pointer_name_arr, temp_str);
+	}
+
+	if ( vardesc != NULL ) {
+		string = strdup(vardesc);
+		tofree = string;
+		token = strsep(&string, "'");
+
+		sprintf(temp_str, "%s", token);
+
+		while ( ( token = strsep(&string, "'") ) != NULL ) {
+			sprintf(temp_str, "%s''%s", temp_str, token);
+		}
+
+		free(tofree);
+
+		fortprintf(fd, "      %scall mpas_add_att(%s %% attLists(1) %% attList, 'long_name', '%s')\n", spacing, pointer_name_arr, temp_str);
+	}
+
+	if ( varmissing_value_mask != NULL && varmissingval != NULL ) {
+		string = strdup(varmissing_value_mask);
+		tofree = string;
+
+		token = strsep(&string, "'");
+		sprintf(temp_str, "%s", token);
+
+		while ( ( token = strsep(&string, "'") ) != NULL ) {
+			sprintf(temp_str, "%s''%s", temp_str, token);
+		}
+
+		free(tofree);
+
+		fortprintf(fd, "      %scall mpas_add_att(%s %% attLists(1) %% attList, 'missing_value_mask', '%s')\n", spacing, pointer_name_arr, temp_str);
+	}
+
+	if ( varmissingval != NULL ) {
+		fortprintf(fd, "      %scall mpas_add_att(%s %% attLists(1) %% attList, '_FillValue', %s)\n", spacing, pointer_name_arr, missing_value);
+	}
+
+	return 0;
+}/*}}}*/
+
+
 int parse_var(FILE *fd, ezxml_t registry, ezxml_t superStruct, ezxml_t currentVar, const char * corename)/*{{{*/
 {
 	ezxml_t struct_xml, var_xml, var_xml2;
@@ -1664,8 +1820,7 @@ int parse_var(FILE *fd, ezxml_t registry, ezxml_t superStruct, ezxml_t currentVa
 	const char *structtimelevs, *vartimelevs;
 	const char *structname, *structlevs, *structpackages;
 	const char *substructname;
-	const char *varname, *varpersistence, *vartype, *vardims, *varunits, *vardesc, *vararrgroup, *varstreams, *vardefaultval, *varpackages, *varmissingval, *varmissing_value_mask;
-	const char *varbounds, *varcellmeasures, *varcellmethod, *varcoords, *varstdname;
+	const char *varname, *varpersistence, *vartype, *vardims, *vararrgroup, *varstreams, *vardefaultval, *varpackages, *varmissingval, *varmissing_value_mask;
 	const char *varname2, *vararrgroup2;
 	const char *varname_in_code;
 	const char *varname_in_output;
@@ -1684,6 +1839,7 @@ int parse_var(FILE *fd, ezxml_t registry, ezxml_t superStruct, ezxml_t currentVa
 	char pointer_name[1024];
 	char pointer_name_arr[1024];
 	char package_spacing[1024];
+	char att_spacing[1024];
 	char default_value[1024];
 	char missing_value[1024];
 	char config_name[1024];
@@ -1703,13 +1859,6 @@ int parse_var(FILE *fd, ezxml_t registry, ezxml_t superStruct, ezxml_t currentVa
 	vardefaultval = ezxml_attr(var_xml, "default_value");
 	vartimelevs = ezxml_attr(var_xml, "time_levs");
 	varname_in_code = ezxml_attr(var_xml, "name_in_code");
-	varunits = ezxml_attr(var_xml, "units");
-	varbounds = ezxml_attr(var_xml, "bounds");
-	varcellmeasures = ezxml_attr(var_xml, "cell_measures");
-	varcellmethod = ezxml_attr(var_xml, "cell_method");
-	varcoords = ezxml_attr(var_xml, "coordinates");
-	varstdname = ezxml_attr(var_xml, "standard_name");
-	vardesc = ezxml_attr(var_xml, "description");
 	varmissingval = ezxml_attr(var_xml, "missing_value");
 	varmissing_value_mask = ezxml_attr(var_xml, "missing_value_mask");
 
@@ -1823,121 +1972,6 @@ int parse_var(FILE *fd, ezxml_t registry, ezxml_t superStruct, ezxml_t currentVa
 	if ( ndims == 0 ) {
 		fortprintf(fd, "      %s %% scalar = %s\n", pointer_name_arr, default_value);
 	}
-	fortprintf(fd, "      allocate(%s %% attLists(1))\n", pointer_name_arr);
-	fortprintf(fd, "      allocate(%s %% attLists(1) %% attList)\n", pointer_name_arr);
-
-	if ( varunits != NULL ) {
-		string = strdup(varunits);
-		tofree = string;
-		token = strsep(&string, "'");
-
-		sprintf(temp_str, "%s", token);
-
-		while ( ( token = strsep(&string, "'") ) != NULL ) {
-			sprintf(temp_str, "%s''%s", temp_str, token);
-		}
-
-		free(tofree);
-
-		fortprintf(fd, "      call mpas_add_att(%s %% attLists(1) %% attList, 'units', '%s')\n", pointer_name_arr, temp_str);
-	}
-
-	if ( varbounds != NULL ) {
-		string = strdup(varbounds);
-		tofree = string;
-		token = strsep(&string, "'");
-
-		sprintf(temp_str, "%s", token);
-
-		while ( ( token = strsep(&string, "'") ) != NULL ) {
-			sprintf(temp_str, "%s''%s", temp_str, token);
-		}
-
-		free(tofree);
-
-		fortprintf(fd, "      call mpas_add_att(%s %% attLists(1) %% attList, 'bounds', '%s')\n", pointer_name_arr, temp_str);
-	}
-
-	if ( varcellmeasures != NULL ) {
-		string = strdup(varcellmeasures);
-		tofree = string;
-		token = strsep(&string, "'");
-
-		sprintf(temp_str, "%s", token);
-
-		while ( ( token = strsep(&string, "'") ) != NULL ) {
-			sprintf(temp_str, "%s''%s", temp_str, token);
-		}
-
-		free(tofree);
-
-		fortprintf(fd, "      call mpas_add_att(%s %% attLists(1) %% attList, 'cell_measures', '%s')\n", pointer_name_arr, temp_str);
-	}
-
-	if ( varcellmethod != NULL ) {
-		string = strdup(varcellmethod);
-		tofree = string;
-		token = strsep(&string, "'");
-
-		sprintf(temp_str, "%s", token);
-
-		while ( ( token = strsep(&string, "'") ) != NULL ) {
-			sprintf(temp_str, "%s''%s", temp_str, token);
-		}
-
-		free(tofree);
-
-		fortprintf(fd, "      call mpas_add_att(%s %% attLists(1) %% attList, 'cell_method', '%s')\n", pointer_name_arr, temp_str);
-	}
-
-	if ( varcoords != NULL ) {
-		string = strdup(varcoords);
-		tofree = string;
-		token = strsep(&string, "'");
-
-		sprintf(temp_str, "%s", token);
-
-		while ( ( token = strsep(&string, "'") ) != NULL ) {
-			sprintf(temp_str, "%s''%s", temp_str, token);
-		}
-
-		free(tofree);
-
-		fortprintf(fd, "      call mpas_add_att(%s %% attLists(1) %% attList, 'coordinates', '%s')\n", pointer_name_arr, temp_str);
-	}
-
-	if ( varstdname != NULL ) {
-		string = strdup(varstdname);
-		tofree = string;
-		token = strsep(&string, "'");
-
-		sprintf(temp_str, "%s", token);
-
-		while ( ( token = strsep(&string, "'") ) != NULL ) {
-			sprintf(temp_str, "%s''%s", temp_str, token);
-		}
-
-		free(tofree);
-
-		fortprintf(fd, "      call mpas_add_att(%s %% attLists(1) %% attList, 'standard_name', '%s')\n", pointer_name_arr, temp_str);
-	}
-
-	if ( vardesc != NULL ) {
-		string = strdup(vardesc);
-		tofree = string;
-		token = strsep(&string, "'");
-
-		sprintf(temp_str, "%s", token);
-
-		while ( ( token = strsep(&string, "'") ) != NULL ) {
-			sprintf(temp_str, "%s''%s", temp_str, token);
-		}
-
-		free(tofree);
-
-		fortprintf(fd, "      call mpas_add_att(%s %% attLists(1) %% attList, 'long_name', '%s')\n", pointer_name_arr, temp_str);
-	}
-
 	if ( varmissing_value_mask != NULL && varmissingval != NULL ) {
 		string = strdup(varmissing_value_mask);
 		tofree = string;
@@ -1952,13 +1986,8 @@ int parse_var(FILE *fd, ezxml_t registry, ezxml_t superStruct, ezxml_t currentVa
 		free(tofree);
 
 		fortprintf(fd, "      %s %% maskName = '%s'\n", pointer_name_arr , temp_str);
-		fortprintf(fd, "      call mpas_add_att(%s %% attLists(1) %% attList, 'missing_value_mask', '%s')\n", pointer_name_arr, temp_str);
 	} else {
-		fortprintf(fd, "      %s %% maskName = 'none'\n", pointer_name_arr , temp_str);
-	}
-
-	if ( varmissingval != NULL ) {
-		fortprintf(fd, "      call mpas_add_att(%s %% attLists(1) %% attList, '_FillValue', %s)\n", pointer_name_arr, missing_value);
+		fortprintf(fd, "      %s %% maskName = 'none'\n", pointer_name_arr);
 	}
 	fortprintf(fd, "      %s %% missingValue = %s\n", pointer_name_arr, missing_value);
 
@@ -1997,6 +2026,8 @@ int parse_var(FILE *fd, ezxml_t registry, ezxml_t superStruct, ezxml_t currentVa
 		snprintf(pointer_name_arr, 1024, "%s", pointer_name);
 	}
 	fortprintf(fd, "         %s%s %% isActive = .true.\n", package_spacing, pointer_name_arr);
+	snprintf(att_spacing, 1024, "   %s", package_spacing);
+	write_var_attributes(fd, var_xml, pointer_name_arr, att_spacing, missing_value);
 	if (time_levs_from_config || time_levs > 1) {
 		fortprintf(fd, "      enddo\n");
 	}
@@ -24,6 +24,7 @@ int parse_packages_from_registry(ezxml_t registry);
 int parse_namelist_records_from_registry(ezxml_t registry);
 int parse_dimensions_from_registry(ezxml_t registry);
 int parse_var_array(FILE *fd, ezxml_t registry, ezxml_t superStruct, ezxml_t varArray, const char * corename);
+int write_var_attributes(FILE *fd, ezxml_t var_xml, const char *pointer_name_arr, const char *spacing, const char *missing_value);
 int parse_var(FILE *fd, ezxml_t registry, ezxml_t superStruct, ezxml_t currentVar, const char * corename);
 int parse_struct(FILE *fd, ezxml_t registry, ezxml_t superStruct, int subpool, const char *parentname, const char * corename);
 int determine_struct_depth(int curLevel, ezxml_t superStruct);
@@ -28,6 +28,21 @@ macro(common)
 
   option(OMEGA_DEBUG "Turn on error message throwing (default OFF)." OFF)
   option(OMEGA_LOG_FLUSH "Turn on unbuffered logging (default OFF)." OFF)
+  option(OMEGA_LOG_ASYNC "Turn on asynchronous logging (default OFF)." OFF)
+  option(OMEGA_USE_GPTL "Forward the Omega timers to GPTL (default OFF)." OFF)
+  option(OMEGA_UNIFIED_MEMORY
+         "Share host and device arrays in unified memory (default OFF)." OFF)
+  option(OMEGA_PERF_WARN_ONLY
+         "Only warn about performance regressions (default OFF)." OFF)
+
+  # Machine name of the performance baselines and allowed relative slowdown
+  if(NOT DEFINED OMEGA_PERF_MACHINE)
+    set(OMEGA_PERF_MACHINE "${OMEGA_CIME_MACHINE}")
+  endif()
+
+  if(NOT DEFINED OMEGA_PERF_TOLERANCE)
+    set(OMEGA_PERF_TOLERANCE "0.2")
+  endif()
 
   if(NOT DEFINED OMEGA_CXX_FLAGS)
     set(OMEGA_CXX_FLAGS "")
@@ -498,6 +513,10 @@ macro(setup_e3sm_build)
   set(OMEGA_ARCH "")
   set(OMEGA_BUILD_MODE "E3SM")
 
+  # the E3SM timing summaries are collected with GPTL, which is built and
+  # initialized by the E3SM driver
+  set(OMEGA_USE_GPTL ON)
+
   message(STATUS "OMEGA_CXX_COMPILER = ${OMEGA_CXX_COMPILER}")
 
 endmacro()
@@ -553,6 +572,18 @@ macro(update_variables)
     add_definitions(-DOMEGA_LOG_TASKS=${_LOG_TASKS})
   endif()
 
+  if(OMEGA_LOG_ASYNC)
+    add_definitions(-DOMEGA_LOG_ASYNC)
+  endif()
+
+  if(OMEGA_LOG_QUEUE_SIZE)
+    add_definitions(-DOMEGA_LOG_QUEUE_SIZE=${OMEGA_LOG_QUEUE_SIZE})
+  endif()
+
+  if(OMEGA_LOG_FLUSH_INTERVAL)
+    add_definitions(-DOMEGA_LOG_FLUSH_INTERVAL=${OMEGA_LOG_FLUSH_INTERVAL})
+  endif()
+
   if(OMEGA_MEMORY_LAYOUT)
     string(TOUPPER "${OMEGA_MEMORY_LAYOUT}" _LAYOUT)
     add_definitions(-DOMEGA_LAYOUT_${_LAYOUT})
@@ -564,6 +595,25 @@ macro(update_variables)
     add_definitions(-DOMEGA_TILE_LENGTH=${OMEGA_TILE_LENGTH})
   endif()
 
+  if(OMEGA_MIXED_PRECISION)
+    add_definitions(-DOMEGA_MIXED_PRECISION)
+  endif()
+
+  # Host and device arrays are the same arrays in the Kokkos shared space,
+  # which is only useful on devices with memory shared with the host
+  if(OMEGA_UNIFIED_MEMORY)
+    add_definitions(-DOMEGA_UNIFIED_MEMORY)
+  endif()
+
+  # In standalone builds Omega initializes GPTL and writes its summary,
+  # in E3SM builds the driver does
+  if(OMEGA_USE_GPTL)
+    add_definitions(-DOMEGA_USE_GPTL)
+    if("${OMEGA_BUILD_MODE}" STREQUAL "STANDALONE")
+      add_definitions(-DOMEGA_GPTL_INIT)
+    endif()
+  endif()
+
   message(STATUS "OMEGA_LINK_OPTIONS     = ${OMEGA_LINK_OPTIONS}")
 
   # check if MPI is supported
@@ -621,6 +671,7 @@ macro(update_variables)
 
   elseif("${OMEGA_ARCH}" STREQUAL "OPENMP")
     option(Kokkos_ENABLE_OPENMP "" ON)
+    add_definitions(-DOMEGA_THREADED)
 
   elseif("${OMEGA_ARCH}" STREQUAL "THREADS")
     option(Kokkos_ENABLE_THREADS "" ON)
@@ -0,0 +1,674 @@
+//===-- Benchmark driver for OMEGA -------------------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Benchmark driver timing the main OMEGA kernels
+///
+/// This driver generates a doubly periodic planar hexagonal mesh of a
+/// configurable size, initializes the default OMEGA modules on it from the
+/// omega.yml config file and times each tendency term, the computation of
+/// the auxiliary state, halo exchanges, global reductions and a full time
+/// step. Every timed call is followed by a Kokkos fence, so the times include
+/// the completion of all kernels on the device. The timings are written as
+/// JSON so that they can be compared across commits, machines and builds.
+/// The minimum times can also be compared with a baseline file recorded on
+/// the same machine, in which case the driver fails if a benchmark is slower
+/// than its baseline by more than a tolerance, and written as a new baseline.
+///
+/// Usage: omegaBenchmark.exe [-nx NX] [-ny NY] [-dc DcEdge] [-niter N]
+///                           [-nwarmup N] [-mesh MeshFile] [-o JsonFile]
+///                           [-baseline File] [-writebaseline File]
+///                           [-tolerance Fraction] [-warnonly 0|1]
+//
+//===-----------------------------------------------------------------------===/
+
+#include "AuxiliaryState.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Dimension.h"
+#include "Field.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "PlanarHexMesh.h"
+#include "Reductions.h"
+#include "TendencyTerms.h"
+#include "TimeMgr.h"
+#include "TimeStepper.h"
+#include "Timer.h"
+#include "Tracers.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace OMEGA;
+
+// Benchmark options, set from the command line
+struct BenchOptions {
+   I4 NX          = 64;      // number of cells in the x direction
+   I4 NY          = 64;      // number of cells in the y direction
+   R8 DcEdge      = 100.0e3; // distance between cell centers (m)
+   I4 NIterations = 20;      // number of timed calls of each benchmark
+   I4 NWarmup     = 2;       // number of untimed calls before timing
+   R8 BottomDepth = 100.0;   // depth of the ocean (m)
+   R8 Coriolis    = 1.0e-4;  // Coriolis parameter (radians s^-1)
+
+   std::string MeshFile = "BenchmarkMesh.nc";    // generated mesh file
+   std::string JsonFile = "OmegaBenchmark.json"; // output file
+
+   std::string BaselineFile;      // baseline to compare with, if any
+   std::string WriteBaselineFile; // baseline to write, if any
+   R8 Tolerance  = 0.2;           // allowed relative slowdown
+   R8 TimeSlack  = 1.0e-5;        // allowed absolute slowdown (s)
+   bool WarnOnly = false;         // only warn about regressions
+};
+
+// Timing statistics of one benchmark in seconds. Each statistic is the
+// maximum over all tasks, so that the slowest task determines the result.
+struct BenchResult {
+   std::string Name;
+   R8 Mean;
+   R8 Min;
+   R8 Max;
+};
+
+//------------------------------------------------------------------------------
+// Read the options from the command line
+
+int parseOptions(int argc, char *argv[], BenchOptions &Opts) {
+
+   for (int I = 1; I < argc; ++I) {
+      const std::string Arg = argv[I];
+      if (I + 1 >= argc) {
+         LOG_ERROR("OmegaBenchmark: missing value for option {}", Arg);
+         return -1;
+      }
+      const std::string Value = argv[++I];
+      if (Arg == "-nx") {
+         Opts.NX = std::stoi(Value);
+      } else if (Arg == "-ny") {
+         Opts.NY = std::stoi(Value);
+      } else if (Arg == "-dc") {
+         Opts.DcEdge = std::stod(Value);
+      } else if (Arg == "-niter") {
+         Opts.NIterations = std::stoi(Value);
+      } else if (Arg == "-nwarmup") {
+         Opts.NWarmup = std::stoi(Value);
+      } else if (Arg == "-mesh") {
+         Opts.MeshFile = Value;
+      } else if (Arg == "-o") {
+         Opts.JsonFile = Value;
+      } else if (Arg == "-baseline") {
+         Opts.BaselineFile = Value;
+      } else if (Arg == "-writebaseline") {
+         Opts.WriteBaselineFile = Value;
+      } else if (Arg == "-tolerance") {
+         Opts.Tolerance = std::stod(Value);
+      } else if (Arg == "-warnonly") {
+         Opts.WarnOnly = std::stoi(Value) != 0;
+      } else {
+         LOG_ERROR("OmegaBenchmark: unknown option {}", Arg);
+         return -1;
+      }
+   }
+
+   if (Opts.NIterations < 1 or Opts.NWarmup < 0 or Opts.DcEdge <= 0 or
+       Opts.Tolerance < 0) {
+      LOG_ERROR("OmegaBenchmark: invalid options, niter {} nwarmup {} dc {} "
+                "tolerance {}",
+                Opts.NIterations, Opts.NWarmup, Opts.DcEdge, Opts.Tolerance);
+      return -1;
+   }
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Read the options, generate the mesh and initialize the default OMEGA
+// modules on it
+
+int initBenchmark(int argc, char *argv[], BenchOptions &Opts) {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefault();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   initLogging(DefEnv);
+
+   Err = parseOptions(argc, argv, Opts);
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error reading command line options");
+      return Err;
+   }
+
+   OMEGA::Config("Omega");
+   Err = OMEGA::Config::readAll("omega.yml");
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: Error reading config file");
+      return Err;
+   }
+
+   // The benchmarks do their own fenced timing, so the internal timers are
+   // disabled to leave the timed code unchanged by the timer options
+   Err = Timer::init();
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error initializing timers");
+      return Err;
+   }
+   Timer::setEnabled(false);
+
+   Err = IO::init(DefComm);
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error initializing parallel IO");
+      return Err;
+   }
+
+   Err = Field::init();
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error initializing Fields");
+      return Err;
+   }
+
+   PlanarHexMesh BenchMesh(Opts.NX, Opts.NY, Opts.DcEdge);
+   Err = BenchMesh.write(Opts.MeshFile, DefEnv, Opts.BottomDepth,
+                         Opts.Coriolis);
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error generating mesh");
+      return Err;
+   }
+
+   Err = Decomp::init(Opts.MeshFile);
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error initializing default decomposition");
+      return Err;
+   }
+
+   Err = Halo::init();
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error initializing default halo");
+      return Err;
+   }
+
+   Err = HorzMesh::init();
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error initializing default mesh");
+      return Err;
+   }
+
+   Err = AuxiliaryState::init();
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error initializing default aux state");
+      return Err;
+   }
+
+   Err = Tendencies::init();
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error initializing default tendencies");
+      return Err;
+   }
+
+   Err = TimeStepper::init();
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error initializing default time stepper");
+      return Err;
+   }
+
+   Err = Tracers::init();
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error initializing tracers");
+      return Err;
+   }
+
+   Err = OceanState::init();
+   if (Err != 0) {
+      LOG_CRITICAL("OmegaBenchmark: error initializing default state");
+      return Err;
+   }
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Set a smooth initial state with a small perturbation of the layer
+// thickness around the bottom depth and a rotational and divergent velocity
+
+void initState(const BenchOptions &Opts) {
+
+   auto *Mesh  = HorzMesh::getDefault();
+   auto *State = OceanState::getDefault();
+
+   const R8 Pi = std::acos(-1.0);
+   const R8 Lx = Opts.NX * Opts.DcEdge;
+   const R8 Ly = Opts.NY * Opts.DcEdge * std::sqrt(3.0) / 2;
+   const R8 U0 = 0.1;
+
+   const int NVertLevels = State->NVertLevels;
+
+   auto LayerThickH = createHostMirrorCopy(State->LayerThickness[0]);
+   auto NormalVelH  = createHostMirrorCopy(State->NormalVelocity[0]);
+
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell) {
+      const R8 X = 2 * Pi * Mesh->XCellH(ICell) / Lx;
+      const R8 Y = 2 * Pi * Mesh->YCellH(ICell) / Ly;
+      for (int K = 0; K < NVertLevels; ++K) {
+         LayerThickH(ICell, K) =
+             Opts.BottomDepth * (1 + 0.01 * std::sin(X) * std::cos(Y));
+      }
+   }
+
+   for (int IEdge = 0; IEdge < Mesh->NEdgesAll; ++IEdge) {
+      const R8 X     = 2 * Pi * Mesh->XEdgeH(IEdge) / Lx;
+      const R8 Y     = 2 * Pi * Mesh->YEdgeH(IEdge) / Ly;
+      const R8 Angle = Mesh->AngleEdgeH(IEdge);
+      for (int K = 0; K < NVertLevels; ++K) {
+         const R8 Scale       = U0 * (1 - 0.5 * K / NVertLevels);
+         NormalVelH(IEdge, K) = Scale * (std::cos(Y) * std::cos(Angle) +
+                                         std::sin(X) * std::sin(Angle));
+      }
+   }
+
+   deepCopy(State->LayerThickness[0], LayerThickH);
+   deepCopy(State->NormalVelocity[0], NormalVelH);
+
+   if (Tracers::getNumTracers() > 0) {
+      Array3DReal TracerArray;
+      Tracers::getAll(TracerArray, 0);
+      deepCopy(TracerArray, 1);
+      AuxiliaryState::getDefault()->initTracerAux(Tracers::getNumTracers());
+   }
+}
+
+//------------------------------------------------------------------------------
+// Time NIterations calls of a benchmark after NWarmup untimed calls. The
+// tasks are synchronized before and the device is fenced after each call.
+
+template <class F>
+void timeBenchmark(std::vector<BenchResult> &Results, // [inout] all results
+                   const std::string &Name,           // [in] benchmark name
+                   const BenchOptions &Opts,          // [in] options
+                   F &&Func                           // [in] code to time
+) {
+
+   MPI_Comm Comm = MachEnv::getDefault()->getComm();
+
+   for (int Iter = 0; Iter < Opts.NWarmup; ++Iter) {
+      Func();
+   }
+   Kokkos::fence();
+
+   R8 SumTime = 0;
+   R8 MinTime = std::numeric_limits<R8>::max();
+   R8 MaxTime = 0;
+   for (int Iter = 0; Iter < Opts.NIterations; ++Iter) {
+      MPI_Barrier(Comm);
+      const R8 StartTime = MPI_Wtime();
+      Func();
+      Kokkos::fence();
+      const R8 Time = MPI_Wtime() - StartTime;
+
+      SumTime += Time;
+      MinTime = std::min(MinTime, Time);
+      MaxTime = std::max(MaxTime, Time);
+   }
+
+   R8 LocTimes[3] = {SumTime / Opts.NIterations, MinTime, MaxTime};
+   R8 Times[3];
+   MPI_Allreduce(LocTimes, Times, 3, MPI_DOUBLE, MPI_MAX, Comm);
+
+   Results.push_back({Name, Times[0], Times[1], Times[2]});
+   LOG_INFO("OmegaBenchmark: {:<40} mean {:.6e} s min {:.6e} s max {:.6e} s",
+            Name, Times[0], Times[1], Times[2]);
+}
+
+//------------------------------------------------------------------------------
+// Run all benchmarks
+
+void runBenchmarks(const BenchOptions &Opts,
+                   std::vector<BenchResult> &Results) {
+
+   auto *Mesh     = HorzMesh::getDefault();
+   auto *MeshHalo = Halo::getDefault();
+   auto *AuxState = AuxiliaryState::getDefault();
+   auto *Tend     = Tendencies::getDefault();
+   auto *Stepper  = TimeStepper::getDefault();
+   auto *State    = OceanState::getDefault();
+   MPI_Comm Comm  = MachEnv::getDefault()->getComm();
+
+   Calendar BenchCalendar("BenchmarkCalendar", CalendarNoCalendar);
+   const TimeInstant Time(&BenchCalendar, 0, 0, 0, 0, 0, 0);
+
+   Array3DReal TracerArray;
+   const bool HasTracers = Tracers::getNumTracers() > 0;
+   if (HasTracers) {
+      Tracers::getAll(TracerArray, 0);
+   }
+
+   // Auxiliary state
+   timeBenchmark(Results, "AuxiliaryState:computeAll", Opts,
+                 [&]() { AuxState->computeAll(State, 0); });
+
+   // Each tendency term on its own, by disabling all other terms. The times
+   // include the zeroing of the tendency arrays, which is timed separately
+   // with all terms disabled.
+   struct TermInfo {
+      std::string Name;
+      bool *Enabled;
+      int Group; // 0 thickness, 1 velocity, 2 tracer tendencies
+   };
+   std::vector<TermInfo> Terms{
+       {"ThicknessFluxDiv", &Tend->ThicknessFluxDiv.Enabled, 0},
+       {"PotentialVortHAdv", &Tend->PotientialVortHAdv.Enabled, 1},
+       {"KEGrad", &Tend->KEGrad.Enabled, 1},
+       {"SSHGrad", &Tend->SSHGrad.Enabled, 1},
+       {"VelocityDiffusion", &Tend->VelocityDiffusion.Enabled, 1},
+       {"VelocityHyperDiff", &Tend->VelocityHyperDiff.Enabled, 1},
+       {"TracerHorzAdv", &Tend->TracerHorzAdv.Enabled, 2},
+       {"TracerDiffusion", &Tend->TracerDiffusion.Enabled, 2},
+       {"TracerHyperDiff", &Tend->TracerHyperDiff.Enabled, 2}};
+
+   std::vector<bool> SavedEnabled;
+   for (auto &Term : Terms) {
+      SavedEnabled.push_back(*Term.Enabled);
+      *Term.Enabled = false;
+   }
+
+   timeBenchmark(Results, "Tendencies:NoTerms", Opts, [&]() {
+      Tend->computeAllTendencies(State, AuxState, 0, 0, Time);
+   });
+
+   for (auto &Term : Terms) {
+      if (Term.Group == 2 and not HasTracers)
+         continue;
+      *Term.Enabled = true;
+      timeBenchmark(Results, "Tendencies:" + Term.Name, Opts, [&]() {
+         if (Term.Group == 0) {
+            Tend->computeThicknessTendencies(State, AuxState, 0, 0, Time);
+         } else if (Term.Group == 1) {
+            Tend->computeVelocityTendencies(State, AuxState, 0, 0, Time);
+         } else {
+            Tend->computeTracerTendencies(State, AuxState, TracerArray, 0, 0,
+                                          Time);
+         }
+      });
+      *Term.Enabled = false;
+   }
+
+   for (std::size_t I = 0; I < Terms.size(); ++I) {
+      *Terms[I].Enabled = SavedEnabled[I];
+   }
+
+   // All enabled tendency terms as configured
+   timeBenchmark(Results, "Tendencies:computeAllTendencies", Opts, [&]() {
+      Tend->computeAllTendencies(State, AuxState, 0, 0, Time);
+   });
+   if (HasTracers) {
+      timeBenchmark(Results, "Tendencies:computeTracerTendencies", Opts, [&]() {
+         Tend->computeTracerTendencies(State, AuxState, TracerArray, 0, 0,
+                                       Time);
+      });
+   }
+
+   // Halo exchanges of the state variables
+   timeBenchmark(Results, "Halo:LayerThickness", Opts, [&]() {
+      MeshHalo->exchangeFullArrayHalo(State->LayerThickness[0], OnCell);
+   });
+   timeBenchmark(Results, "Halo:NormalVelocity", Opts, [&]() {
+      MeshHalo->exchangeFullArrayHalo(State->NormalVelocity[0], OnEdge);
+   });
+   if (HasTracers) {
+      timeBenchmark(Results, "Halo:Tracers", Opts, [&]() {
+         MeshHalo->exchangeFullArrayHalo(TracerArray, OnCell);
+      });
+   }
+
+   // Global reductions of a scalar, which measures the MPI latency, and of
+   // the owned layer thickness
+   timeBenchmark(Results, "Reductions:globalSumScalar", Opts, [&]() {
+      R8 LocalValue = 1.0;
+      R8 GlobalValue;
+      globalSum(&LocalValue, Comm, &GlobalValue);
+   });
+   timeBenchmark(Results, "Reductions:globalSumBatch", Opts, [&]() {
+      std::vector<Array2DReal> Arrays{State->LayerThickness[0]};
+      std::vector<R8> Sums(1);
+      globalSumBatch(Arrays, Mesh->NCellsOwned, Comm, Sums);
+   });
+
+   // Full time step, which advances the state
+   timeBenchmark(Results, "TimeStepper:doStep", Opts,
+                 [&]() { Stepper->doStep(State, Time); });
+}
+
+//------------------------------------------------------------------------------
+// Write the results as JSON from the master task
+
+int writeResults(const BenchOptions &Opts,
+                 const std::vector<BenchResult> &Results) {
+
+   MachEnv *DefEnv = MachEnv::getDefault();
+   if (not DefEnv->isMasterTask())
+      return 0;
+
+   std::ofstream Out(Opts.JsonFile);
+   if (not Out) {
+      LOG_ERROR("OmegaBenchmark: error opening output file {}", Opts.JsonFile);
+      return -1;
+   }
+
+   auto *Mesh = HorzMesh::getDefault();
+
+   Out << std::setprecision(9);
+   Out << "{\n";
+   Out << "  \"ExecSpace\": \"" << Kokkos::DefaultExecutionSpace::name()
+       << "\",\n";
+   Out << "  \"NumTasks\": " << DefEnv->getNumTasks() << ",\n";
+   Out << "  \"VecWidth\": " << Tendencies::getDefault()->getVecWidth()
+       << ",\n";
+   Out << "  \"RealBytes\": " << sizeof(Real) << ",\n";
+   Out << "  \"AuxRealBytes\": " << sizeof(AuxReal) << ",\n";
+   Out << "  \"Mesh\": {\n";
+   Out << "    \"Type\": \"PlanarHex\",\n";
+   Out << "    \"NX\": " << Opts.NX << ",\n";
+   Out << "    \"NY\": " << Opts.NY << ",\n";
+   Out << "    \"DcEdge\": " << Opts.DcEdge << ",\n";
+   Out << "    \"NCells\": " << Opts.NX * Opts.NY << ",\n";
+   Out << "    \"NVertLevels\": " << Mesh->NVertLevels << "\n";
+   Out << "  },\n";
+   Out << "  \"Iterations\": " << Opts.NIterations << ",\n";
+   Out << "  \"Warmup\": " << Opts.NWarmup << ",\n";
+   Out << "  \"Timings\": [\n";
+   for (std::size_t I = 0; I < Results.size(); ++I) {
+      const BenchResult &Result = Results[I];
+      Out << "    {\"Name\": \"" << Result.Name << "\", \"Mean\": "
+          << Result.Mean << ", \"Min\": " << Result.Min
+          << ", \"Max\": " << Result.Max << "}"
+          << (I + 1 < Results.size() ? ",\n" : "\n");
+   }
+   Out << "  ]\n";
+   Out << "}\n";
+
+   LOG_INFO("OmegaBenchmark: wrote results to {}", Opts.JsonFile);
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Baseline files hold the minimum time of each benchmark, which is the least
+// sensitive to other jobs on the machine. The header records the setup that
+// the times depend on, and a baseline with a different setup is not used.
+
+std::string baselineHeader(const BenchOptions &Opts) {
+   std::ostringstream Header;
+   Header << "# OmegaBenchmark " << Kokkos::DefaultExecutionSpace::name()
+          << " tasks " << MachEnv::getDefault()->getNumTasks() << " mesh "
+          << Opts.NX << "x" << Opts.NY << "x"
+          << HorzMesh::getDefault()->NVertLevels << " real " << sizeof(Real)
+          << " auxreal " << sizeof(AuxReal);
+   return Header.str();
+}
+
+int writeBaseline(const BenchOptions &Opts,
+                  const std::vector<BenchResult> &Results) {
+
+   if (not MachEnv::getDefault()->isMasterTask())
+      return 0;
+
+   std::ofstream Out(Opts.WriteBaselineFile);
+   if (not Out) {
+      LOG_ERROR("OmegaBenchmark: error opening baseline file {}",
+                Opts.WriteBaselineFile);
+      return -1;
+   }
+
+   Out << baselineHeader(Opts) << "\n" << std::setprecision(9);
+   for (const BenchResult &Result : Results) {
+      Out << Result.Name << " " << Result.Min << "\n";
+   }
+
+   LOG_INFO("OmegaBenchmark: wrote baseline to {}", Opts.WriteBaselineFile);
+
+   return 0;
+}
+
+// Compare the minimum times with the baseline on the master task and return
+// the number of regressions on all tasks. A missing baseline file, or one
+// recorded with another setup, is not an error, so that a new machine can
+// run the benchmarks before its baseline is added.
+int checkBaseline(const BenchOptions &Opts,
+                  const std::vector<BenchResult> &Results) {
+
+   MachEnv *DefEnv = MachEnv::getDefault();
+   I4 NRegress     = 0;
+
+   if (DefEnv->isMasterTask()) {
+      std::ifstream In(Opts.BaselineFile);
+      std::string Line;
+      if (not In) {
+         LOG_WARN("OmegaBenchmark: no baseline file {}, not comparing times",
+                  Opts.BaselineFile);
+      } else if (not std::getline(In, Line) or Line != baselineHeader(Opts)) {
+         LOG_WARN("OmegaBenchmark: baseline file {} was recorded with "
+                  "another setup ({}), not comparing times",
+                  Opts.BaselineFile, Line);
+      } else {
+         std::map<std::string, R8> Baseline;
+         while (std::getline(In, Line)) {
+            std::istringstream Fields(Line);
+            std::string Name;
+            R8 Time;
+            if (Line.empty() or Line[0] == '#')
+               continue;
+            if (Fields >> Name >> Time)
+               Baseline[Name] = Time;
+         }
+
+         for (const BenchResult &Result : Results) {
+            auto Iter = Baseline.find(Result.Name);
+            if (Iter == Baseline.end()) {
+               LOG_INFO("OmegaBenchmark: {} has no baseline", Result.Name);
+               continue;
+            }
+            const R8 Base  = Iter->second;
+            const R8 Ratio = Base > 0 ? Result.Min / Base : 1;
+            if (Result.Min > Base * (1 + Opts.Tolerance) + Opts.TimeSlack) {
+               ++NRegress;
+               LOG_WARN("OmegaBenchmark: {} regressed, {:.6e} s for a "
+                        "baseline of {:.6e} s ({:+.1f}%)",
+                        Result.Name, Result.Min, Base, 100 * (Ratio - 1));
+            } else if (Result.Min < Base * (1 - Opts.Tolerance)) {
+               LOG_INFO("OmegaBenchmark: {} improved, {:.6e} s for a "
+                        "baseline of {:.6e} s ({:+.1f}%), consider updating "
+                        "the baseline",
+                        Result.Name, Result.Min, Base, 100 * (Ratio - 1));
+            }
+         }
+         LOG_INFO("OmegaBenchmark: {} of {} benchmarks slower than the "
+                  "baseline by more than {:.0f}%",
+                  NRegress, Results.size(), 100 * Opts.Tolerance);
+      }
+   }
+
+   MPI_Bcast(&NRegress, 1, MPI_INT32_T, 0, DefEnv->getComm());
+
+   return NRegress;
+}
+
+//------------------------------------------------------------------------------
+// Remove all OMEGA objects
+
+void finalizeBenchmark() {
+
+   TimeStepper::clear();
+   Tendencies::clear();
+   AuxiliaryState::clear();
+   Tracers::clear();
+   OceanState::clear();
+   Dimension::clear();
+   Field::clear();
+   HorzMesh::clear();
+   Halo::clear();
+   Decomp::clear();
+   Timer::clear();
+   MachEnv::removeAll();
+}
+
+//------------------------------------------------------------------------------
+// The benchmark driver
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   {
+      BenchOptions Opts;
+      RetVal = initBenchmark(argc, argv, Opts);
+
+      if (RetVal == 0) {
+         initState(Opts);
+
+         std::vector<BenchResult> Results;
+         runBenchmarks(Opts, Results);
+         RetVal = writeResults(Opts, Results);
+
+         if (not Opts.WriteBaselineFile.empty())
+            RetVal += writeBaseline(Opts, Results);
+
+         if (not Opts.BaselineFile.empty()) {
+            const int NRegress = checkBaseline(Opts, Results);
+            if (NRegress > 0 and not Opts.WarnOnly) {
+               LOG_ERROR("OmegaBenchmark: performance regression in {} "
+                         "benchmarks",
+                         NRegress);
+               RetVal += 1;
+            }
+         }
+      }
+
+      finalizeBenchmark();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal != 0)
+      RetVal = 1;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,405 @@
+//===-- benchmarks/PlanarHexMesh.cpp - synthetic hexagonal mesh -*- C++ -*-===//
+//
+// Implementation of the doubly periodic planar hexagonal mesh generator used
+// by the Omega benchmarks. Each task computes the connectivity and geometry
+// of its block of a linear distribution of the mesh elements, the same
+// distribution Decomp uses to read the mesh, and writes it with parallel IO.
+// The TRiSK weights are those of a regular hexagon, which reconstruct the
+// tangential velocity of a uniform flow exactly.
+//
+//===----------------------------------------------------------------------===//
+
+#include "PlanarHexMesh.h"
+#include "IO.h"
+#include "Logging.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Construct the mesh description
+
+PlanarHexMesh::PlanarHexMesh(I4 NX_,    // [in] number of cells in x
+                             I4 NY_,    // [in] number of cells in y
+                             R8 DcEdge_ // [in] distance between cells (m)
+                             )
+    : NX(NX_), NY(NY_), DcEdge(DcEdge_) {
+
+   NCells    = NX * NY;
+   NEdges    = 3 * NCells;
+   NVertices = 2 * NCells;
+
+} // end constructor
+
+//------------------------------------------------------------------------------
+// Connectivity. Rows of cells with odd J are shifted by half a cell in the x
+// direction, so the offsets to the neighbors depend on the parity of the row.
+
+I4 PlanarHexMesh::cellOnCell(I4 ICell, I4 J) const {
+
+   static constexpr I4 OffsetXEven[MaxEdges] = {1, 0, -1, -1, -1, 0};
+   static constexpr I4 OffsetXOdd[MaxEdges]  = {1, 1, 0, -1, 0, 1};
+   static constexpr I4 OffsetY[MaxEdges]     = {0, 1, 1, 0, -1, -1};
+
+   const I4 IX = ICell % NX;
+   const I4 IY = ICell / NX;
+   const I4 DX = IY % 2 == 0 ? OffsetXEven[J] : OffsetXOdd[J];
+
+   const I4 NbrX = (IX + DX + NX) % NX;
+   const I4 NbrY = (IY + OffsetY[J] + NY) % NY;
+   return NbrY * NX + NbrX;
+}
+
+I4 PlanarHexMesh::edgeOnCell(I4 ICell, I4 J) const {
+   // The edges to the last three neighbors are owned by the neighbors, where
+   // they are the edge in the opposite direction
+   return J < 3 ? 3 * ICell + J : 3 * cellOnCell(ICell, J) + J - 3;
+}
+
+I4 PlanarHexMesh::vertexOnCell(I4 ICell, I4 J) const {
+   switch (J) {
+   case 0:
+      return 2 * ICell;
+   case 1:
+      return 2 * ICell + 1;
+   case 2:
+      return 2 * cellOnCell(ICell, 3);
+   case 3:
+      return 2 * cellOnCell(ICell, 4) + 1;
+   case 4:
+      return 2 * cellOnCell(ICell, 4);
+   default:
+      return 2 * cellOnCell(ICell, 5) + 1;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Local utilities for writing the mesh
+
+namespace {
+
+// Block of a linear distribution of NGlobal elements over the tasks
+struct LinearBlock {
+   I4 Start;
+   I4 Size;
+};
+
+LinearBlock linearBlock(I4 NGlobal, const MachEnv *Env) {
+   const I4 NumTasks = Env->getNumTasks();
+   const I4 Chunk    = (NGlobal - 1) / NumTasks + 1;
+   const I4 Start    = std::min(Env->getMyTask() * Chunk, NGlobal);
+   return {Start, std::min(Chunk, NGlobal - Start)};
+}
+
+// Write the values of a variable with NPerElem values for each element of
+// the local block
+template <typename T>
+int writeBlock(std::vector<T> &Values,   // [in] values of the local block
+               IO::IODataType Type,      // [in] data type of the variable
+               I4 NGlobal,               // [in] global number of elements
+               I4 NPerElem,              // [in] values for each element
+               const LinearBlock &Block, // [in] local block of elements
+               int FileID,               // [in] ID of the open mesh file
+               int VarID                 // [in] ID of the variable
+) {
+
+   std::vector<I4> DimLengths{NGlobal};
+   if (NPerElem > 1)
+      DimLengths.push_back(NPerElem);
+
+   const I4 Size = Block.Size * NPerElem;
+   std::vector<I4> Offsets(Size);
+   for (int I = 0; I < Size; ++I) {
+      Offsets[I] = Block.Start * NPerElem + I;
+   }
+
+   int DecompID;
+   int Err = IO::createDecomp(DecompID, Type, DimLengths.size(), DimLengths,
+                              Size, Offsets, IO::RearrBox);
+   if (Err != 0) {
+      LOG_ERROR("PlanarHexMesh: error creating IO decomposition");
+      return Err;
+   }
+
+   T FillValue = 0;
+   Err = IO::writeArray(Values.data(), Size, &FillValue, FileID, DecompID,
+                        VarID);
+   if (Err != 0) {
+      LOG_ERROR("PlanarHexMesh: error writing mesh variable");
+   }
+
+   IO::destroyDecomp(DecompID);
+   return Err;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Write the mesh to a file in the MPAS mesh format
+
+int PlanarHexMesh::write(const std::string &FileName, // [in] mesh file
+                         const MachEnv *Env, // [in] environment for IO
+                         R8 BottomDepth,     // [in] depth of the ocean (m)
+                         R8 Coriolis         // [in] Coriolis parameter
+) const {
+
+   int Err = 0;
+
+   if (NX < 3 or NY < 4 or NY % 2 != 0) {
+      LOG_ERROR("PlanarHexMesh: mesh of {} by {} cells is not periodic, NX "
+                "must be at least 3 and NY an even number of at least 4",
+                NX, NY);
+      return -1;
+   }
+
+   const R8 Pi           = std::acos(-1.0);
+   const R8 DvEdge       = DcEdge / std::sqrt(3.0);
+   const R8 AreaCell     = 0.5 * std::sqrt(3.0) * DcEdge * DcEdge;
+   const R8 AreaTri      = 0.25 * std::sqrt(3.0) * DcEdge * DcEdge;
+   const I4 MaxEdges2    = 2 * MaxEdges;
+   const I4 NEdgesOnEdge = 2 * (MaxEdges - 1);
+
+   const LinearBlock CellBlock   = linearBlock(NCells, Env);
+   const LinearBlock EdgeBlock   = linearBlock(NEdges, Env);
+   const LinearBlock VertexBlock = linearBlock(NVertices, Env);
+
+   // Cell center coordinates from the global cell index
+   auto cellX = [&](I4 ICell) {
+      return DcEdge * (ICell % NX + 0.5 * ((ICell / NX) % 2));
+   };
+   auto cellY = [&](I4 ICell) {
+      return 0.5 * std::sqrt(3.0) * DcEdge * (ICell / NX);
+   };
+
+   // Open the file and define the dimensions and variables
+   int FileID;
+   Err = IO::openFile(FileID, FileName, IO::ModeWrite, IO::FmtDefault,
+                      IO::IfExists::Replace);
+   if (Err != 0) {
+      LOG_ERROR("PlanarHexMesh: error opening mesh file {}", FileName);
+      return Err;
+   }
+
+   std::map<std::string, int> DimIDs;
+   const std::map<std::string, I4> DimLengths{
+       {"nCells", NCells},       {"nEdges", NEdges},
+       {"nVertices", NVertices}, {"maxEdges", MaxEdges},
+       {"maxEdges2", MaxEdges2}, {"TWO", 2},
+       {"vertexDegree", VertexDegree}};
+   for (const auto &[Name, Length] : DimLengths) {
+      Err += IO::defineDim(FileID, Name, Length, DimIDs[Name]);
+   }
+
+   // Variable names with their type and dimension names
+   struct VarInfo {
+      IO::IODataType Type;
+      std::vector<std::string> Dims;
+   };
+   const std::map<std::string, VarInfo> VarInfos{
+       {"nEdgesOnCell", {IO::IOTypeI4, {"nCells"}}},
+       {"cellsOnCell", {IO::IOTypeI4, {"nCells", "maxEdges"}}},
+       {"edgesOnCell", {IO::IOTypeI4, {"nCells", "maxEdges"}}},
+       {"verticesOnCell", {IO::IOTypeI4, {"nCells", "maxEdges"}}},
+       {"nEdgesOnEdge", {IO::IOTypeI4, {"nEdges"}}},
+       {"cellsOnEdge", {IO::IOTypeI4, {"nEdges", "TWO"}}},
+       {"verticesOnEdge", {IO::IOTypeI4, {"nEdges", "TWO"}}},
+       {"edgesOnEdge", {IO::IOTypeI4, {"nEdges", "maxEdges2"}}},
+       {"cellsOnVertex", {IO::IOTypeI4, {"nVertices", "vertexDegree"}}},
+       {"edgesOnVertex", {IO::IOTypeI4, {"nVertices", "vertexDegree"}}},
+       {"xCell", {IO::IOTypeR8, {"nCells"}}},
+       {"yCell", {IO::IOTypeR8, {"nCells"}}},
+       {"zCell", {IO::IOTypeR8, {"nCells"}}},
+       {"lonCell", {IO::IOTypeR8, {"nCells"}}},
+       {"latCell", {IO::IOTypeR8, {"nCells"}}},
+       {"areaCell", {IO::IOTypeR8, {"nCells"}}},
+       {"meshDensity", {IO::IOTypeR8, {"nCells"}}},
+       {"bottomDepth", {IO::IOTypeR8, {"nCells"}}},
+       {"fCell", {IO::IOTypeR8, {"nCells"}}},
+       {"xEdge", {IO::IOTypeR8, {"nEdges"}}},
+       {"yEdge", {IO::IOTypeR8, {"nEdges"}}},
+       {"zEdge", {IO::IOTypeR8, {"nEdges"}}},
+       {"lonEdge", {IO::IOTypeR8, {"nEdges"}}},
+       {"latEdge", {IO::IOTypeR8, {"nEdges"}}},
+       {"dcEdge", {IO::IOTypeR8, {"nEdges"}}},
+       {"dvEdge", {IO::IOTypeR8, {"nEdges"}}},
+       {"angleEdge", {IO::IOTypeR8, {"nEdges"}}},
+       {"fEdge", {IO::IOTypeR8, {"nEdges"}}},
+       {"weightsOnEdge", {IO::IOTypeR8, {"nEdges", "maxEdges2"}}},
+       {"xVertex", {IO::IOTypeR8, {"nVertices"}}},
+       {"yVertex", {IO::IOTypeR8, {"nVertices"}}},
+       {"zVertex", {IO::IOTypeR8, {"nVertices"}}},
+       {"lonVertex", {IO::IOTypeR8, {"nVertices"}}},
+       {"latVertex", {IO::IOTypeR8, {"nVertices"}}},
+       {"areaTriangle", {IO::IOTypeR8, {"nVertices"}}},
+       {"fVertex", {IO::IOTypeR8, {"nVertices"}}},
+       {"kiteAreasOnVertex", {IO::IOTypeR8, {"nVertices", "vertexDegree"}}}};
+
+   std::map<std::string, int> VarIDs;
+   for (const auto &[Name, Info] : VarInfos) {
+      std::vector<int> VarDimIDs;
+      for (const auto &Dim : Info.Dims) {
+         VarDimIDs.push_back(DimIDs[Dim]);
+      }
+      Err += IO::defineVar(FileID, Name, Info.Type, VarDimIDs.size(),
+                           VarDimIDs.data(), VarIDs[Name]);
+   }
+
+   Err += IO::endDefinePhase(FileID);
+   if (Err != 0) {
+      LOG_ERROR("PlanarHexMesh: error defining mesh file {}", FileName);
+      IO::closeFile(FileID);
+      return Err;
+   }
+
+   // Write a variable from a function of the global element index and the
+   // index of the value within the element. The connectivity is written as
+   // 1-based indices as in MPAS mesh files.
+   auto writeVar = [&](const std::string &Name, const LinearBlock &Block,
+                       I4 NGlobal, I4 NPerElem, auto &&Value) {
+      using T = decltype(Value(0, 0));
+      std::vector<T> Values(Block.Size * NPerElem);
+      for (int I = 0; I < Block.Size; ++I) {
+         for (int J = 0; J < NPerElem; ++J) {
+            Values[I * NPerElem + J] = Value(Block.Start + I, J);
+         }
+      }
+      return writeBlock(Values, VarInfos.at(Name).Type, NGlobal, NPerElem,
+                        Block, FileID, VarIDs[Name]);
+   };
+   auto writeCellVar = [&](const std::string &Name, I4 NPerElem,
+                           auto &&Value) {
+      return writeVar(Name, CellBlock, NCells, NPerElem, Value);
+   };
+   auto writeEdgeVar = [&](const std::string &Name, I4 NPerElem,
+                           auto &&Value) {
+      return writeVar(Name, EdgeBlock, NEdges, NPerElem, Value);
+   };
+   auto writeVertexVar = [&](const std::string &Name, I4 NPerElem,
+                             auto &&Value) {
+      return writeVar(Name, VertexBlock, NVertices, NPerElem, Value);
+   };
+   auto zero = [](I4, I4) { return 0.0; };
+
+   // Cell variables
+   Err += writeCellVar("nEdgesOnCell", 1, [&](I4, I4) { return MaxEdges; });
+   Err += writeCellVar("cellsOnCell", MaxEdges, [&](I4 ICell, I4 J) {
+      return cellOnCell(ICell, J) + 1;
+   });
+   Err += writeCellVar("edgesOnCell", MaxEdges, [&](I4 ICell, I4 J) {
+      return edgeOnCell(ICell, J) + 1;
+   });
+   Err += writeCellVar("verticesOnCell", MaxEdges, [&](I4 ICell, I4 J) {
+      return vertexOnCell(ICell, J) + 1;
+   });
+   Err += writeCellVar("xCell", 1, [&](I4 ICell, I4) { return cellX(ICell); });
+   Err += writeCellVar("yCell", 1, [&](I4 ICell, I4) { return cellY(ICell); });
+   Err += writeCellVar("zCell", 1, zero);
+   Err += writeCellVar("lonCell", 1, zero);
+   Err += writeCellVar("latCell", 1, zero);
+   Err += writeCellVar("areaCell", 1, [&](I4, I4) { return AreaCell; });
+   Err += writeCellVar("meshDensity", 1, [](I4, I4) { return 1.0; });
+   Err += writeCellVar("bottomDepth", 1, [&](I4, I4) { return BottomDepth; });
+   Err += writeCellVar("fCell", 1, [&](I4, I4) { return Coriolis; });
+
+   // Edge variables. Edge J of the owning cell connects it to its neighbor J,
+   // the normal points from the owning cell to the neighbor and the tangent
+   // from the first to the second vertex is the normal rotated by 90 degrees
+   // counterclockwise.
+   Err += writeEdgeVar("nEdgesOnEdge", 1, [&](I4, I4) { return NEdgesOnEdge; });
+   Err += writeEdgeVar("cellsOnEdge", 2, [&](I4 IEdge, I4 J) {
+      const I4 ICell = IEdge / 3;
+      return (J == 0 ? ICell : cellOnCell(ICell, IEdge % 3)) + 1;
+   });
+   Err += writeEdgeVar("verticesOnEdge", 2, [&](I4 IEdge, I4 J) {
+      const I4 ICell = IEdge / 3;
+      const I4 K     = IEdge % 3;
+      return vertexOnCell(ICell, J == 0 ? (K + 5) % 6 : K) + 1;
+   });
+
+   // The edges on an edge are the other edges of the first cell followed by
+   // the other edges of the second cell, both counterclockwise starting after
+   // the edge itself
+   Err += writeEdgeVar("edgesOnEdge", MaxEdges2, [&](I4 IEdge, I4 J) {
+      const I4 ICell = IEdge / 3;
+      const I4 K     = IEdge % 3;
+      if (J < MaxEdges - 1)
+         return edgeOnCell(ICell, (K + 1 + J) % 6) + 1;
+      if (J < NEdgesOnEdge)
+         return edgeOnCell(cellOnCell(ICell, K), (K + J - 1) % 6) + 1;
+      return 0;
+   });
+   Err += writeEdgeVar("weightsOnEdge", MaxEdges2, [&](I4 IEdge, I4 J) {
+      const I4 K = IEdge % 3;
+      if (J < MaxEdges - 1)
+         return (0.5 - (J + 1) / 6.0) * edgeSignOnCell((K + 1 + J) % 6) *
+                DvEdge / DcEdge;
+      if (J < NEdgesOnEdge)
+         return -(0.5 - (J - 4) / 6.0) * edgeSignOnCell((K + J - 1) % 6) *
+                DvEdge / DcEdge;
+      return 0.0;
+   });
+   Err += writeEdgeVar("xEdge", 1, [&](I4 IEdge, I4) {
+      return cellX(IEdge / 3) + 0.5 * DcEdge * std::cos(IEdge % 3 * Pi / 3);
+   });
+   Err += writeEdgeVar("yEdge", 1, [&](I4 IEdge, I4) {
+      return cellY(IEdge / 3) + 0.5 * DcEdge * std::sin(IEdge % 3 * Pi / 3);
+   });
+   Err += writeEdgeVar("zEdge", 1, zero);
+   Err += writeEdgeVar("lonEdge", 1, zero);
+   Err += writeEdgeVar("latEdge", 1, zero);
+   Err += writeEdgeVar("dcEdge", 1, [&](I4, I4) { return DcEdge; });
+   Err += writeEdgeVar("dvEdge", 1, [&](I4, I4) { return DvEdge; });
+   Err += writeEdgeVar("angleEdge", 1,
+                       [&](I4 IEdge, I4) { return IEdge % 3 * Pi / 3; });
+   Err += writeEdgeVar("fEdge", 1, [&](I4, I4) { return Coriolis; });
+
+   // Vertex variables. Vertex T of the owning cell lies between its
+   // neighbors T and T + 1, the cells and edges of the vertex are ordered
+   // counterclockwise starting from the owning cell.
+   Err += writeVertexVar("cellsOnVertex", VertexDegree, [&](I4 IVertex, I4 J) {
+      const I4 ICell = IVertex / 2;
+      return (J == 0 ? ICell : cellOnCell(ICell, IVertex % 2 + J - 1)) + 1;
+   });
+   Err += writeVertexVar("edgesOnVertex", VertexDegree, [&](I4 IVertex, I4 J) {
+      const I4 ICell = IVertex / 2;
+      const I4 T     = IVertex % 2;
+      if (J == 1)
+         return T == 0 ? 3 * cellOnCell(ICell, 0) + 3
+                       : 3 * cellOnCell(ICell, 2) + 1;
+      return 3 * ICell + T + J / 2 + 1;
+   });
+   Err += writeVertexVar("xVertex", 1, [&](I4 IVertex, I4) {
+      return cellX(IVertex / 2) +
+             DvEdge * std::cos(Pi / 6 + IVertex % 2 * Pi / 3);
+   });
+   Err += writeVertexVar("yVertex", 1, [&](I4 IVertex, I4) {
+      return cellY(IVertex / 2) +
+             DvEdge * std::sin(Pi / 6 + IVertex % 2 * Pi / 3);
+   });
+   Err += writeVertexVar("zVertex", 1, zero);
+   Err += writeVertexVar("lonVertex", 1, zero);
+   Err += writeVertexVar("latVertex", 1, zero);
+   Err += writeVertexVar("areaTriangle", 1, [&](I4, I4) { return AreaTri; });
+   Err += writeVertexVar("fVertex", 1, [&](I4, I4) { return Coriolis; });
+   Err += writeVertexVar("kiteAreasOnVertex", VertexDegree,
+                         [&](I4, I4) { return AreaTri / 3; });
+
+   Err += IO::closeFile(FileID);
+   if (Err != 0) {
+      LOG_ERROR("PlanarHexMesh: error writing mesh file {}", FileName);
+      return Err;
+   }
+
+   LOG_INFO("PlanarHexMesh: wrote {} by {} cell mesh with spacing {} m to {}",
+            NX, NY, DcEdge, FileName);
+
+   return Err;
+}
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,77 @@
+#ifndef OMEGA_PLANARHEXMESH_H
+#define OMEGA_PLANARHEXMESH_H
+//===-- benchmarks/PlanarHexMesh.h - synthetic hexagonal mesh ---*- C++ -*-===//
+//
+/// \file
+/// \brief Generates doubly periodic planar meshes of regular hexagons
+///
+/// The PlanarHexMesh class describes a doubly periodic planar mesh of NX by
+/// NY regular hexagons with a uniform distance between cell centers. All
+/// connectivity and geometry is computed from the global index of each mesh
+/// element, so every MPI task only evaluates the elements it writes. The
+/// mesh is written in the MPAS mesh format so that it can be read with the
+/// regular Decomp and HorzMesh initialization, which gives the benchmarks
+/// the same partitioning, halos and local ordering as a production mesh.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "MachEnv.h"
+
+#include <string>
+
+namespace OMEGA {
+
+class PlanarHexMesh {
+
+ public:
+   /// Construct a mesh of NX by NY cells, NY must be even for the rows of
+   /// cells to be periodic in the y direction
+   PlanarHexMesh(I4 NX_,     ///< [in] number of cells in the x direction
+                 I4 NY_,     ///< [in] number of cells in the y direction
+                 R8 DcEdge_  ///< [in] distance between cell centers (m)
+   );
+
+   /// Write the mesh to a new file in the MPAS mesh format, with a uniform
+   /// bottom depth and Coriolis parameter. Returns an error code.
+   int write(const std::string &FileName, ///< [in] name of mesh file
+             const MachEnv *Env,          ///< [in] environment for parallel IO
+             R8 BottomDepth,              ///< [in] depth of the ocean (m)
+             R8 Coriolis ///< [in] Coriolis parameter (radians s^-1)
+   ) const;
+
+   I4 NX;          ///< Number of cells in the x direction
+   I4 NY;          ///< Number of cells in the y direction
+   R8 DcEdge;      ///< Distance between cell centers (m)
+   I4 NCells;      ///< Total number of cells
+   I4 NEdges;      ///< Total number of edges
+   I4 NVertices;   ///< Total number of vertices
+
+   static constexpr I4 MaxEdges     = 6; ///< Edges of each hexagon
+   static constexpr I4 VertexDegree = 3; ///< Cells meeting at each vertex
+
+ private:
+   // The neighbors, edges and vertices of each cell are numbered
+   // counterclockwise starting from the eastern neighbor, so that neighbor J
+   // lies in the direction J * 60 degrees. Each cell owns the edges to its
+   // first three neighbors and the vertices at 30 and 90 degrees, so that
+   // edge 3 * ICell + J and vertex 2 * ICell + J belong to cell ICell. All
+   // indices below are 0-based.
+
+   /// Neighbor J of a cell
+   I4 cellOnCell(I4 ICell, I4 J) const;
+
+   /// Edge shared with neighbor J of a cell
+   I4 edgeOnCell(I4 ICell, I4 J) const;
+
+   /// Vertex between the edges J and J + 1 of a cell
+   I4 vertexOnCell(I4 ICell, I4 J) const;
+
+   /// Sign of the normal of edge J relative to the outward normal of a cell
+   static R8 edgeSignOnCell(I4 J) { return J < 3 ? 1.0 : -1.0; }
+};
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // defined OMEGA_PLANARHEXMESH_H
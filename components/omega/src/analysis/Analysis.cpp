@@ -0,0 +1,673 @@
+//===-- analysis/Analysis.cpp - in-situ analysis members --------*- C++ -*-===//
+//
+// Analysis members accumulate the running time-mean, variance, minimum,
+// maximum and time integral of a list of fields in device memory over an
+// averaging interval. The statistics are stored in Fields that are written
+// by an IOStream at the end of each interval.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Analysis.h"
+#include "Config.h"
+#include "IOStream.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <any>
+#include <cctype>
+#include <limits>
+
+namespace OMEGA {
+
+// All defined analysis members
+std::map<std::string, std::unique_ptr<AnalysisMember>>
+    AnalysisMember::AllMembers;
+
+namespace {
+
+// Retrieves a flat view of the data of a contiguous array along with the
+// array extents. Returns an error code if the array is not contiguous.
+template <class ArrayType, class T>
+int flattenArray(
+    const ArrayType &Arr, // [in] array to flatten
+    Kokkos::View<const T *, MemSpace, Kokkos::MemoryUnmanaged> &Flat, // [out]
+    std::vector<I8> &Extents // [out] extent of each dimension
+) {
+   if (!Arr.span_is_contiguous()) {
+      LOG_ERROR("Analysis: field data array {} is not contiguous",
+                Arr.label());
+      return 1;
+   }
+
+   Flat = Kokkos::View<const T *, MemSpace, Kokkos::MemoryUnmanaged>(
+       Arr.data(), Arr.size());
+
+   Extents.resize(ArrayType::rank);
+   for (int IDim = 0; IDim < ArrayType::rank; ++IDim)
+      Extents[IDim] = Arr.extent(IDim);
+
+   return 0;
+}
+
+// Retrieves a flat view of the current data of a device field of type T
+// along with the extents of the field array. Returns an error code.
+template <class T>
+int getFlatData(
+    const std::shared_ptr<Field> &InField, // [in] field to retrieve
+    Kokkos::View<const T *, MemSpace, Kokkos::MemoryUnmanaged> &Flat, // [out]
+    std::vector<I8> &Extents // [out] extent of each dimension
+) {
+   switch (InField->getNumDims()) {
+   case 1:
+      return flattenArray(
+          InField->getDataArray<Kokkos::View<T *, MemLayout, MemSpace>>(),
+          Flat, Extents);
+   case 2:
+      return flattenArray(
+          InField->getDataArray<Kokkos::View<T **, MemLayout, MemSpace>>(),
+          Flat, Extents);
+   case 3:
+      return flattenArray(
+          InField->getDataArray<Kokkos::View<T ***, MemLayout, MemSpace>>(),
+          Flat, Extents);
+   case 4:
+      return flattenArray(
+          InField->getDataArray<Kokkos::View<T ****, MemLayout, MemSpace>>(),
+          Flat, Extents);
+   case 5:
+      return flattenArray(
+          InField->getDataArray<Kokkos::View<T *****, MemLayout, MemSpace>>(),
+          Flat, Extents);
+   default:
+      LOG_ERROR("Analysis: unsupported number of dimensions for field {}",
+                InField->getName());
+      return 1;
+   }
+}
+
+// Creates a double precision array with the input extents, attaches it to
+// the input field and returns a flat view of the array. The array is owned
+// by the field.
+Kokkos::View<R8 *, MemSpace, Kokkos::MemoryUnmanaged>
+attachStatArray(const std::shared_ptr<Field> &StatField, // [in] stat field
+                const std::vector<I8> &Extents // [in] extent of each dim
+) {
+   const std::string Label = StatField->getName();
+   R8 *Data                = nullptr;
+   I8 Size                 = 0;
+
+   switch (Extents.size()) {
+   case 1: {
+      Array1DR8 Arr(Label, Extents[0]);
+      StatField->attachData<Array1DR8>(Arr);
+      Data = Arr.data();
+      Size = Arr.size();
+      break;
+   }
+   case 2: {
+      Array2DR8 Arr(Label, Extents[0], Extents[1]);
+      StatField->attachData<Array2DR8>(Arr);
+      Data = Arr.data();
+      Size = Arr.size();
+      break;
+   }
+   case 3: {
+      Array3DR8 Arr(Label, Extents[0], Extents[1], Extents[2]);
+      StatField->attachData<Array3DR8>(Arr);
+      Data = Arr.data();
+      Size = Arr.size();
+      break;
+   }
+   case 4: {
+      Array4DR8 Arr(Label, Extents[0], Extents[1], Extents[2], Extents[3]);
+      StatField->attachData<Array4DR8>(Arr);
+      Data = Arr.data();
+      Size = Arr.size();
+      break;
+   }
+   case 5: {
+      Array5DR8 Arr(Label, Extents[0], Extents[1], Extents[2], Extents[3],
+                    Extents[4]);
+      StatField->attachData<Array5DR8>(Arr);
+      Data = Arr.data();
+      Size = Arr.size();
+      break;
+   }
+   }
+
+   return Kokkos::View<R8 *, MemSpace, Kokkos::MemoryUnmanaged>(Data, Size);
+}
+
+// Converts a fill value of a real field to double precision so that it
+// matches the type of the statistics fields
+std::any toR8Fill(const std::any &FillValue) {
+   if (FillValue.type() == typeid(R4))
+      return std::any(static_cast<R8>(std::any_cast<R4>(FillValue)));
+   return FillValue;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Private constructor, use create to define an analysis member
+AnalysisMember::AnalysisMember(const std::string &InName,
+                               const Alarm &InAlarm,
+                               const std::string &InStreamName)
+    : Name(InName), IntervalAlarm(InAlarm), StreamName(InStreamName),
+      TotalWeight(0.0), NumSamples(0), NeedsReset(true) {
+   for (int IStat = 0; IStat < NumAnalysisStats; ++IStat)
+      UseStat[IStat] = false;
+}
+
+//------------------------------------------------------------------------------
+// Destructor, removes the statistics fields and the field group of the member
+AnalysisMember::~AnalysisMember() {
+   for (auto &AField : Fields) {
+      for (int IStat = 0; IStat < NumAnalysisStats; ++IStat) {
+         if (AField.StatField[IStat] != nullptr and
+             Field::exists(AField.StatField[IStat]->getName()))
+            Field::destroy(AField.StatField[IStat]->getName());
+      }
+   }
+   if (FieldGroup::exists(Name))
+      FieldGroup::destroy(Name);
+}
+
+//------------------------------------------------------------------------------
+// Creates all analysis members defined in the Analysis group of the input
+// configuration
+int AnalysisMember::init(const TimeInstant &StartTime // [in] start of intervals
+) {
+   int Err = 0;
+
+   // The Analysis group is optional
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("Analysis"))
+      return Err;
+
+   Config AnalysisConfig("Analysis");
+   Err = OmegaConfig->get(AnalysisConfig);
+   if (Err != 0) {
+      LOG_ERROR("Analysis: error retrieving Analysis group from Config");
+      return Err;
+   }
+
+   for (auto It = AnalysisConfig.begin(); It != AnalysisConfig.end(); ++It) {
+
+      std::string MemberName;
+      Err = Config::getName(It, MemberName);
+      if (Err != 0) {
+         LOG_ERROR("Analysis: error retrieving analysis member name");
+         return Err;
+      }
+
+      Config MemberConfig(MemberName);
+      Err = AnalysisConfig.get(MemberConfig);
+      if (Err != 0) {
+         LOG_ERROR("Analysis: error retrieving Config for member {}",
+                   MemberName);
+         return Err;
+      }
+
+      // Averaging interval, with the same options as the stream frequency
+      I4 Freq;
+      Err = MemberConfig.get("Freq", Freq);
+      if (Err != 0 or Freq < 1) {
+         LOG_ERROR("Analysis: missing or invalid Freq for member {}",
+                   MemberName);
+         return 1;
+      }
+
+      std::string FreqUnits;
+      Err = MemberConfig.get("FreqUnits", FreqUnits);
+      if (Err != 0) {
+         LOG_ERROR("Analysis: FreqUnits missing for member {}", MemberName);
+         return Err;
+      }
+      std::transform(FreqUnits.begin(), FreqUnits.end(), FreqUnits.begin(),
+                     [](unsigned char C) { return std::tolower(C); });
+
+      TimeUnits Units = TimeUnits::None;
+      if (FreqUnits == "years") {
+         Units = TimeUnits::Years;
+      } else if (FreqUnits == "months") {
+         Units = TimeUnits::Months;
+      } else if (FreqUnits == "days") {
+         Units = TimeUnits::Days;
+      } else if (FreqUnits == "hours") {
+         Units = TimeUnits::Hours;
+      } else if (FreqUnits == "minutes") {
+         Units = TimeUnits::Minutes;
+      } else if (FreqUnits == "seconds") {
+         Units = TimeUnits::Seconds;
+      } else {
+         LOG_ERROR("Analysis: unknown FreqUnits {} for member {}", FreqUnits,
+                   MemberName);
+         return 1;
+      }
+      TimeInterval Interval(Freq, Units);
+
+      // Accumulated fields and statistics
+      std::vector<std::string> Contents;
+      Err = MemberConfig.get("Contents", Contents);
+      if (Err != 0) {
+         LOG_ERROR("Analysis: Contents missing for member {}", MemberName);
+         return Err;
+      }
+
+      std::vector<std::string> StatNames;
+      Err = MemberConfig.get("Statistics", StatNames);
+      if (Err != 0) {
+         LOG_ERROR("Analysis: Statistics missing for member {}", MemberName);
+         return Err;
+      }
+      std::vector<AnalysisStat> Stats(StatNames.size());
+      for (size_t I = 0; I < StatNames.size(); ++I) {
+         Err = statFromString(StatNames[I], Stats[I]);
+         if (Err != 0) {
+            LOG_ERROR("Analysis: unknown statistic {} for member {}",
+                      StatNames[I], MemberName);
+            return Err;
+         }
+      }
+
+      // Optional stream written at the end of each interval
+      std::string MemberStream;
+      if (MemberConfig.existsVar("Stream")) {
+         Err = MemberConfig.get("Stream", MemberStream);
+         if (Err != 0) {
+            LOG_ERROR("Analysis: error reading Stream for member {}",
+                      MemberName);
+            return Err;
+         }
+      }
+
+      AnalysisMember *NewMember = create(MemberName, Interval, StartTime,
+                                         Contents, Stats, MemberStream);
+      if (NewMember == nullptr) {
+         LOG_ERROR("Analysis: error creating analysis member {}", MemberName);
+         return 1;
+      }
+   }
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Creates an analysis member that accumulates the statistics of the listed
+// fields or field groups over periodic intervals
+AnalysisMember *AnalysisMember::create(
+    const std::string &Name,                  // [in] name of member
+    const TimeInterval &Interval,             // [in] averaging interval
+    const TimeInstant &StartTime,             // [in] start of intervals
+    const std::vector<std::string> &Contents, // [in] fields or groups
+    const std::vector<AnalysisStat> &Stats,   // [in] statistics
+    const std::string &StreamName             // [in] opt output stream
+) {
+
+   if (AllMembers.find(Name) != AllMembers.end()) {
+      LOG_ERROR("Analysis: attempt to create member {} that already exists",
+                Name);
+      return nullptr;
+   }
+
+   if (Stats.empty()) {
+      LOG_ERROR("Analysis: no statistics requested for member {}", Name);
+      return nullptr;
+   }
+
+   // The field group of the member is created first so that its statistics
+   // fields can be added as they are defined
+   if (FieldGroup::create(Name) == nullptr) {
+      LOG_ERROR("Analysis: unable to create field group for member {}", Name);
+      return nullptr;
+   }
+
+   Alarm MemberAlarm(Name, Interval, StartTime);
+   auto NewMember = std::unique_ptr<AnalysisMember>(
+       new AnalysisMember(Name, MemberAlarm, StreamName));
+
+   for (AnalysisStat Stat : Stats)
+      NewMember->UseStat[static_cast<int>(Stat)] = true;
+
+   // Expand any field groups into their member fields
+   for (const std::string &Entry : Contents) {
+      int Err = 0;
+      if (Field::exists(Entry)) {
+         Err = NewMember->addField(Entry);
+      } else if (FieldGroup::exists(Entry)) {
+         for (const std::string &FieldName :
+              FieldGroup::getFieldListFromGroup(Entry)) {
+            Err += NewMember->addField(FieldName);
+         }
+      } else {
+         LOG_ERROR("Analysis: field or group {} for member {} not defined",
+                   Entry, Name);
+         Err = 1;
+      }
+      if (Err != 0)
+         return nullptr;
+   }
+
+   AnalysisMember *MemberPtr = NewMember.get();
+   AllMembers[Name]          = std::move(NewMember);
+   return MemberPtr;
+}
+
+//------------------------------------------------------------------------------
+// Adds a field to the accumulated fields and creates its statistics fields
+int AnalysisMember::addField(const std::string &FieldName // [in] field
+) {
+   int Err = 0;
+
+   std::shared_ptr<Field> InField = Field::get(FieldName);
+
+   // Only real fields in device memory are accumulated
+   FieldType InType = InField->getType();
+   if (InType != FieldType::R4 and InType != FieldType::R8) {
+      LOG_ERROR("Analysis: field {} must be a real field with attached data",
+                FieldName);
+      return 1;
+   }
+   if (InField->getMemoryLocation() == FieldMemLoc::Host) {
+      LOG_ERROR("Analysis: field {} must be in device memory", FieldName);
+      return 1;
+   }
+
+   std::vector<I8> Extents;
+   if (InType == FieldType::R4) {
+      ConstFlatArray<R4> InData;
+      Err = getFlatData<R4>(InField, InData, Extents);
+   } else {
+      ConstFlatArray<R8> InData;
+      Err = getFlatData<R8>(InField, InData, Extents);
+   }
+   if (Err != 0) {
+      LOG_ERROR("Analysis: unable to retrieve data for field {}", FieldName);
+      return Err;
+   }
+
+   // The field is added before its statistics fields are created so that
+   // they are removed with the member if an error occurs
+   Fields.emplace_back();
+   AnalysisField &AField = Fields.back();
+   AField.InField        = InField;
+   AField.Size           = 1;
+   for (I8 Extent : Extents)
+      AField.Size *= Extent;
+
+   // Statistics fields share the metadata and dimensions of the field
+   std::string Description;
+   std::string Units;
+   InField->getMetadata("Description", Description);
+   InField->getMetadata("Units", Units);
+   std::shared_ptr<Metadata> InMeta = InField->getAllMetadata();
+   std::any FillValue = toR8Fill((*InMeta)["FillValue"]);
+
+   std::vector<std::string> DimNames;
+   Err = InField->getDimNames(DimNames);
+   if (Err != 0) {
+      LOG_ERROR("Analysis: unable to retrieve dimensions of field {}",
+                FieldName);
+      return Err;
+   }
+
+   for (int IStat = 0; IStat < NumAnalysisStats; ++IStat) {
+      if (!UseStat[IStat])
+         continue;
+
+      const AnalysisStat Stat = static_cast<AnalysisStat>(IStat);
+      std::string StatUnits   = Units;
+      if (Stat == AnalysisStat::Variance)
+         StatUnits = "(" + Units + ")^2";
+      else if (Stat == AnalysisStat::Integral)
+         StatUnits = Units + " s";
+
+      const std::string StatName = getStatFieldName(FieldName, Stat);
+      AField.StatField[IStat]    = Field::create(
+          StatName, AnalysisStatName[IStat] + " of " + Description, StatUnits,
+          "", 0.0, 0.0, FillValue, InField->getNumDims(), DimNames);
+      if (AField.StatField[IStat] == nullptr) {
+         LOG_ERROR("Analysis: unable to create field {}", StatName);
+         return 1;
+      }
+      AField.StatData[IStat] =
+          attachStatArray(AField.StatField[IStat], Extents);
+
+      Err = FieldGroup::addFieldToGroup(StatName, Name);
+      if (Err != 0) {
+         LOG_ERROR("Analysis: unable to add field {} to group {}", StatName,
+                   Name);
+         return Err;
+      }
+   }
+
+   if (UseStat[static_cast<int>(AnalysisStat::Variance)])
+      AField.SumSqDev = Array1DR8(FieldName + "SumSqDev", AField.Size);
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Restarts the statistics of all fields
+void AnalysisMember::reset() {
+   const R8 HugeVal = std::numeric_limits<R8>::max();
+
+   for (auto &AField : Fields) {
+      for (int IStat = 0; IStat < NumAnalysisStats; ++IStat) {
+         if (!UseStat[IStat])
+            continue;
+         const AnalysisStat Stat = static_cast<AnalysisStat>(IStat);
+         if (Stat == AnalysisStat::Min)
+            deepCopy(AField.StatData[IStat], HugeVal);
+         else if (Stat == AnalysisStat::Max)
+            deepCopy(AField.StatData[IStat], -HugeVal);
+         else
+            deepCopy(AField.StatData[IStat], 0.0);
+      }
+      if (AField.SumSqDev.size() > 0)
+         deepCopy(AField.SumSqDev, 0.0);
+   }
+
+   TotalWeight = 0.0;
+   NumSamples  = 0;
+   NeedsReset  = false;
+}
+
+//------------------------------------------------------------------------------
+// Updates the statistics of one field of type T with the current values of
+// the field. The mean and variance use the weighted incremental update of
+// West (1979), which avoids the loss of precision of accumulating sums of
+// squares for fields with a large mean.
+template <class T>
+int AnalysisMember::accumulateField(AnalysisField &AField, // [inout] stats
+                                    R8 Weight // [in] weight of current step
+) {
+   ConstFlatArray<T> InData;
+   std::vector<I8> Extents;
+   int Err = getFlatData<T>(AField.InField, InData, Extents);
+   if (Err != 0 or static_cast<I8>(InData.size()) != AField.Size) {
+      LOG_ERROR("Analysis: data of field {} changed size",
+                AField.InField->getName());
+      return 1;
+   }
+
+   const R8 Frac = Weight / TotalWeight;
+
+   const bool UseMean     = UseStat[static_cast<int>(AnalysisStat::Mean)];
+   const bool UseVariance = UseStat[static_cast<int>(AnalysisStat::Variance)];
+   const bool UseMin      = UseStat[static_cast<int>(AnalysisStat::Min)];
+   const bool UseMax      = UseStat[static_cast<int>(AnalysisStat::Max)];
+   const bool UseIntegral = UseStat[static_cast<int>(AnalysisStat::Integral)];
+
+   // The variance needs the running mean even if the mean is not output,
+   // so the variance array holds it in that case until the interval ends
+   const FlatArrayR8 Mean =
+       UseMean ? AField.StatData[static_cast<int>(AnalysisStat::Mean)]
+               : AField.StatData[static_cast<int>(AnalysisStat::Variance)];
+   const FlatArrayR8 Min = AField.StatData[static_cast<int>(AnalysisStat::Min)];
+   const FlatArrayR8 Max = AField.StatData[static_cast<int>(AnalysisStat::Max)];
+   const FlatArrayR8 Integral =
+       AField.StatData[static_cast<int>(AnalysisStat::Integral)];
+   const Array1DR8 SumSqDev = AField.SumSqDev;
+
+   parallelFor(
+       "accumulateField", {static_cast<int>(AField.Size)},
+       KOKKOS_LAMBDA(int I) {
+          const R8 Val = InData(I);
+          if (UseMean or UseVariance) {
+             const R8 Delta = Val - Mean(I);
+             Mean(I) += Frac * Delta;
+             if (UseVariance)
+                SumSqDev(I) += Weight * Delta * (Val - Mean(I));
+          }
+          if (UseMin)
+             Min(I) = Kokkos::min(Min(I), Val);
+          if (UseMax)
+             Max(I) = Kokkos::max(Max(I), Val);
+          if (UseIntegral)
+             Integral(I) += Weight * Val;
+       });
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Completes the statistics at the end of an interval
+void AnalysisMember::complete() {
+   const int IVar = static_cast<int>(AnalysisStat::Variance);
+   if (!UseStat[IVar])
+      return;
+
+   if (TotalWeight <= 0.0) {
+      LOG_WARN("Analysis: no time accumulated in interval of member {}", Name);
+      return;
+   }
+
+   const R8 InvWeight = 1.0 / TotalWeight;
+   for (auto &AField : Fields) {
+      const FlatArrayR8 Variance = AField.StatData[IVar];
+      const Array1DR8 SumSqDev   = AField.SumSqDev;
+      parallelFor(
+          "completeVariance", {static_cast<int>(AField.Size)},
+          KOKKOS_LAMBDA(int I) { Variance(I) = SumSqDev(I) * InvWeight; });
+   }
+}
+
+//------------------------------------------------------------------------------
+// Updates the statistics with the fields at the current time of the model
+// clock and writes them at the end of an interval
+int AnalysisMember::accumulate(const Clock &ModelClock // [in] model clock
+) {
+   int Err = 0;
+
+   TimerRegion AnalysisTimer("Analysis");
+
+   if (NeedsReset)
+      reset();
+
+   // Each step is weighted by its length so that the statistics are time
+   // averages also when the time step changes
+   const TimeInstant CurrTime = ModelClock.getCurrentTime();
+   const R8 Weight = (CurrTime - ModelClock.getPreviousTime()).getSeconds();
+   TotalWeight += Weight;
+   ++NumSamples;
+
+   if (TotalWeight > 0.0) {
+      for (auto &AField : Fields) {
+         if (AField.InField->getType() == FieldType::R4)
+            Err += accumulateField<R4>(AField, Weight);
+         else
+            Err += accumulateField<R8>(AField, Weight);
+      }
+   }
+   if (Err != 0) {
+      LOG_ERROR("Analysis: error accumulating fields for member {}", Name);
+      return Err;
+   }
+
+   // Complete the statistics and write them at the end of the interval
+   IntervalAlarm.updateStatus(CurrTime);
+   if (IntervalAlarm.isRinging()) {
+      complete();
+
+      if (!StreamName.empty()) {
+         Err = IOStream::write(StreamName, ModelClock, true);
+         if (Err != 0)
+            LOG_ERROR("Analysis: error writing stream {} for member {}",
+                      StreamName, Name);
+      }
+
+      IntervalAlarm.reset(CurrTime);
+      NeedsReset = true;
+   }
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Updates all analysis members
+int AnalysisMember::accumulateAll(const Clock &ModelClock // [in] model clock
+) {
+   int Err = 0;
+   for (auto &Member : AllMembers)
+      Err += Member.second->accumulate(ModelClock);
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Retrieves an analysis member by name
+AnalysisMember *AnalysisMember::get(const std::string &Name // [in] name
+) {
+   auto It = AllMembers.find(Name);
+   if (It != AllMembers.end()) {
+      return It->second.get();
+   } else {
+      LOG_ERROR("Analysis: attempt to retrieve undefined member {}", Name);
+      return nullptr;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Converts a statistic name to its enum
+int AnalysisMember::statFromString(const std::string &StatStr, // [in] name
+                                   AnalysisStat &Stat          // [out] stat
+) {
+   for (int IStat = 0; IStat < NumAnalysisStats; ++IStat) {
+      if (StatStr == AnalysisStatName[IStat]) {
+         Stat = static_cast<AnalysisStat>(IStat);
+         return 0;
+      }
+   }
+   return 1;
+}
+
+//------------------------------------------------------------------------------
+// Returns the name of the field holding a statistic of a field
+std::string
+AnalysisMember::getStatFieldName(const std::string &FieldName, // [in] field
+                                 AnalysisStat Stat             // [in] stat
+) const {
+   return Name + "_" + AnalysisStatName[static_cast<int>(Stat)] + "_" +
+          FieldName;
+}
+
+//------------------------------------------------------------------------------
+// Returns the number of steps accumulated in the current interval
+I4 AnalysisMember::getNumSamples() const { return NumSamples; }
+
+//------------------------------------------------------------------------------
+// Removes an analysis member and its statistics fields
+void AnalysisMember::erase(const std::string &Name // [in] name of member
+) {
+   AllMembers.erase(Name);
+}
+
+//------------------------------------------------------------------------------
+// Removes all analysis members and their statistics fields
+void AnalysisMember::clear() { AllMembers.clear(); }
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,191 @@
+#ifndef OMEGA_ANALYSIS_H
+#define OMEGA_ANALYSIS_H
+//===-- analysis/Analysis.h - in-situ analysis members ----------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines in-situ analysis members that accumulate field statistics
+///
+/// An analysis member accumulates statistics of a list of Fields over an
+/// averaging interval while the model runs. Every time step, the running
+/// time-mean, variance, minimum, maximum and time integral of each field are
+/// updated in device memory, so no high-frequency output is needed to compute
+/// them. The statistics are stored in new Fields that can be added to the
+/// contents of an IOStream and, at the end of each interval, an optional
+/// stream is written and the statistics restart for the next interval.
+/// This replaces the output of instantaneous fields at every few steps with
+/// one output per interval.
+///
+/// Analysis members are defined in the optional Analysis group of the input
+/// configuration. They are created by init after all Fields are defined and
+/// are updated with accumulateAll at the end of each time step.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "Field.h"
+#include "TimeMgr.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// Statistics that can be accumulated by an analysis member
+enum class AnalysisStat {
+   Mean,     ///< time-weighted mean
+   Variance, ///< time-weighted variance about the mean
+   Min,      ///< minimum over the interval
+   Max,      ///< maximum over the interval
+   Integral  ///< integral over time, in field units times seconds
+};
+
+/// Number of supported analysis statistics
+constexpr int NumAnalysisStats = 5;
+
+/// Names of the analysis statistics, used in the configuration and in the
+/// names of the statistics fields
+static const std::string AnalysisStatName[NumAnalysisStats] = {
+    "Mean", "Variance", "Min", "Max", "Integral"};
+
+/// The AnalysisMember class accumulates statistics of a list of fields over
+/// a periodic averaging interval
+class AnalysisMember {
+
+ private:
+   /// Flat views of the field and statistics data used in the kernels
+   using FlatArrayR8 = Kokkos::View<R8 *, MemSpace, Kokkos::MemoryUnmanaged>;
+   template <class T>
+   using ConstFlatArray =
+       Kokkos::View<const T *, MemSpace, Kokkos::MemoryUnmanaged>;
+
+   /// Statistics of one accumulated field
+   struct AnalysisField {
+      std::shared_ptr<Field> InField; ///< field being accumulated
+      I8 Size;                        ///< number of field elements
+
+      /// Fields holding each requested statistic and flat views of their
+      /// data. The fields own the data arrays.
+      std::shared_ptr<Field> StatField[NumAnalysisStats];
+      FlatArrayR8 StatData[NumAnalysisStats];
+
+      /// Running sum of squared deviations for the variance
+      Array1DR8 SumSqDev;
+   };
+
+   /// All defined analysis members
+   static std::map<std::string, std::unique_ptr<AnalysisMember>> AllMembers;
+
+   std::string Name;       ///< name of analysis member
+   Alarm IntervalAlarm;    ///< alarm ringing at the end of each interval
+   std::string StreamName; ///< stream written at the end of each interval
+
+   bool UseStat[NumAnalysisStats];    ///< flags for requested statistics
+   std::vector<AnalysisField> Fields; ///< accumulated fields
+
+   R8 TotalWeight;  ///< time in seconds accumulated in current interval
+   I4 NumSamples;   ///< number of steps accumulated in current interval
+   bool NeedsReset; ///< restart the statistics on the next accumulation
+
+   /// Private constructor, use create to define an analysis member
+   AnalysisMember(const std::string &InName, const Alarm &InAlarm,
+                  const std::string &InStreamName);
+
+   /// Adds a field to the accumulated fields and creates its statistics
+   /// fields. Returns an error code.
+   int addField(const std::string &FieldName ///< [in] field to accumulate
+   );
+
+   /// Updates the statistics of one field of type T with the current values
+   /// of the field and the weight of the current step
+   template <class T>
+   int accumulateField(AnalysisField &AField, ///< [inout] field statistics
+                       R8 Weight                ///< [in] weight of step
+   );
+
+   /// Restarts the statistics of all fields
+   void reset();
+
+   /// Completes the statistics at the end of an interval
+   void complete();
+
+ public:
+   //---------------------------------------------------------------------------
+   /// Creates all analysis members defined in the Analysis group of the
+   /// input configuration, with the averaging intervals starting at the
+   /// input start time. All accumulated fields must have been defined.
+   static int init(const TimeInstant &StartTime ///< [in] start of intervals
+   );
+
+   //---------------------------------------------------------------------------
+   /// Creates an analysis member that accumulates the statistics of the
+   /// listed fields or field groups over periodic intervals. The statistics
+   /// of each field are stored in new fields named
+   /// MemberName_Statistic_FieldName with the same dimensions as the field.
+   /// If a stream name is supplied, that stream is written at the end of
+   /// each interval. Returns a pointer to the new member or a null pointer
+   /// if an error occurred.
+   static AnalysisMember *
+   create(const std::string &Name,                  ///< [in] name of member
+          const TimeInterval &Interval,             ///< [in] averaging interval
+          const TimeInstant &StartTime,             ///< [in] start of intervals
+          const std::vector<std::string> &Contents, ///< [in] fields or groups
+          const std::vector<AnalysisStat> &Stats,   ///< [in] statistics
+          const std::string &StreamName = ""        ///< [in] opt output stream
+   );
+
+   //---------------------------------------------------------------------------
+   /// Retrieves an analysis member by name
+   static AnalysisMember *get(const std::string &Name ///< [in] name of member
+   );
+
+   //---------------------------------------------------------------------------
+   /// Converts a statistic name to its enum, returning an error code if the
+   /// name is not a supported statistic
+   static int statFromString(const std::string &StatStr, ///< [in] name
+                             AnalysisStat &Stat          ///< [out] statistic
+   );
+
+   //---------------------------------------------------------------------------
+   /// Returns the name of the field holding a statistic of a field
+   std::string getStatFieldName(const std::string &FieldName, ///< [in] field
+                                AnalysisStat Stat ///< [in] statistic
+   ) const;
+
+   //---------------------------------------------------------------------------
+   /// Updates the statistics with the fields at the current time of the
+   /// model clock, weighted by the length of the last step. At the end of an
+   /// interval, the statistics are completed and the output stream written.
+   /// The completed statistics remain in the statistics fields until the
+   /// next accumulation. Returns an error code.
+   int accumulate(const Clock &ModelClock ///< [in] model clock
+   );
+
+   //---------------------------------------------------------------------------
+   /// Updates all analysis members. Returns an error code.
+   static int accumulateAll(const Clock &ModelClock ///< [in] model clock
+   );
+
+   //---------------------------------------------------------------------------
+   /// Returns the number of steps accumulated in the current interval
+   I4 getNumSamples() const;
+
+   //---------------------------------------------------------------------------
+   /// Removes an analysis member and its statistics fields
+   static void erase(const std::string &Name ///< [in] name of member
+   );
+
+   //---------------------------------------------------------------------------
+   /// Removes all analysis members and their statistics fields
+   static void clear();
+
+   /// Destructor, removes the statistics fields
+   ~AnalysisMember();
+
+}; // end class AnalysisMember
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_ANALYSIS_H
@@ -12,6 +12,8 @@
 
 #include "Broadcast.h"
 
+#include <algorithm>
+
 namespace OMEGA {
 
 //------------------------------------------------------------------------------
@@ -104,9 +106,9 @@ int Broadcast(std::string &Value, const MachEnv *InEnv, const int RankBcast) {
    if (MyTask != Root)
       Value.resize(StrSize);
 
-   // Now broadcast the string
-   RetVal =
-       MPI_Bcast((void *)Value.c_str(), Value.size(), MPI_CHAR, Root, Comm);
+   // Now broadcast the string, in chunks for large strings like the
+   // contents of the config file
+   RetVal = broadcastBuffer(Value.data(), Value.size(), InEnv, Root);
 
    return RetVal;
 } // end Broadcast
@@ -115,6 +117,47 @@ int Broadcast(std::string &Value, const int RankBcast) {
    return Broadcast(Value, MachEnv::getDefault(), RankBcast);
 } // end Broadcast
 
+//------------------------------------------------------------------------------
+// Broadcast a raw buffer in chunks using non-blocking broadcasts. Up to
+// BcastMaxPending chunks are in flight at once so that the broadcast of one
+// chunk overlaps with the forwarding of the previous ones.
+int broadcastBuffer(void *Buffer, std::size_t NumBytes, const MachEnv *InEnv,
+                    const int RankBcast) {
+   int RetVal    = MPI_SUCCESS;
+   int Root      = (RankBcast < 0) ? InEnv->getMasterTask() : RankBcast;
+   MPI_Comm Comm = InEnv->getComm();
+   char *Bytes   = static_cast<char *>(Buffer);
+
+   std::vector<MPI_Request> Requests;
+   Requests.reserve(BcastMaxPending);
+
+   std::size_t Offset = 0;
+   while (Offset < NumBytes) {
+      std::size_t ChunkSize = std::min(BcastChunkBytes, NumBytes - Offset);
+      Requests.emplace_back();
+      RetVal = MPI_Ibcast(Bytes + Offset, static_cast<int>(ChunkSize), MPI_BYTE,
+                          Root, Comm, &Requests.back());
+      if (RetVal != MPI_SUCCESS)
+         return RetVal;
+      Offset += ChunkSize;
+
+      // wait for the current window of chunks before starting the next
+      int NumPending = static_cast<int>(Requests.size());
+      if (NumPending == BcastMaxPending or Offset >= NumBytes) {
+         RetVal = MPI_Waitall(NumPending, Requests.data(), MPI_STATUSES_IGNORE);
+         if (RetVal != MPI_SUCCESS)
+            return RetVal;
+         Requests.clear();
+      }
+   }
+
+   return RetVal;
+} // end broadcastBuffer
+
+int broadcastBuffer(void *Buffer, std::size_t NumBytes, const int RankBcast) {
+   return broadcastBuffer(Buffer, NumBytes, MachEnv::getDefault(), RankBcast);
+} // end broadcastBuffer
+
 //------------------------------------------------------------------------------
 // Broadcast I4 array
 int Broadcast(std::vector<I4> &Value, const MachEnv *InEnv,
@@ -14,6 +14,11 @@
 #include "MachEnv.h"
 #include "mpi.h"
 
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
 namespace OMEGA {
 
 // blocking broadcast scalar
@@ -62,6 +67,71 @@ int Broadcast(std::vector<R8> &Value,
               const int RankBcast  = -1);
 int Broadcast(std::vector<R8> &Value, const int RankBcast);
 
+// chunked broadcast of a raw buffer
+
+/// Size in bytes of the chunks of a buffer broadcast
+constexpr std::size_t BcastChunkBytes = 4 * 1024 * 1024;
+
+/// Maximum number of chunk broadcasts in flight at once
+constexpr int BcastMaxPending = 8;
+
+/// Broadcasts NumBytes of contiguous memory. The buffer is sent in chunks of
+/// BcastChunkBytes with non-blocking broadcasts, so buffers larger than the
+/// MPI count limit can be sent and the transfer of consecutive chunks is
+/// pipelined through the broadcast tree.
+int broadcastBuffer(void *Buffer, std::size_t NumBytes,
+                    const MachEnv *InEnv = MachEnv::getDefault(),
+                    const int RankBcast  = -1);
+int broadcastBuffer(void *Buffer, std::size_t NumBytes, const int RankBcast);
+
+// blocking broadcast of plain structs
+
+/// Broadcasts any trivially copyable struct (eg a table of coefficients)
+/// as raw bytes. Scalars use the typed overloads above.
+template <class T, std::enable_if_t<std::is_trivially_copyable_v<T> &&
+                                        std::is_class_v<T>,
+                                    int> = 0>
+int Broadcast(T &Value, const MachEnv *InEnv = MachEnv::getDefault(),
+              const int RankBcast = -1) {
+   return broadcastBuffer(&Value, sizeof(T), InEnv, RankBcast);
+}
+template <class T, std::enable_if_t<std::is_trivially_copyable_v<T> &&
+                                        std::is_class_v<T>,
+                                    int> = 0>
+int Broadcast(T &Value, const int RankBcast) {
+   return broadcastBuffer(&Value, sizeof(T), MachEnv::getDefault(), RankBcast);
+}
+
+// blocking broadcast of host arrays
+
+/// Broadcasts the contents of a contiguous host Kokkos array of any rank and
+/// type. The array must already have the same extents on all tasks.
+template <class T, class... Props>
+int Broadcast(const Kokkos::View<T, Props...> &Array,
+              const MachEnv *InEnv = MachEnv::getDefault(),
+              const int RankBcast  = -1) {
+   using ViewType = Kokkos::View<T, Props...>;
+   static_assert(Kokkos::SpaceAccessibility<
+                     Kokkos::HostSpace,
+                     typename ViewType::memory_space>::accessible,
+                 "Broadcast requires a host-accessible array");
+   static_assert(std::is_trivially_copyable_v<typename ViewType::value_type>,
+                 "Broadcast requires an array of trivially copyable type");
+
+   if (not Array.span_is_contiguous()) {
+      LOG_ERROR("Broadcast: array {} is not contiguous", Array.label());
+      return -1;
+   }
+
+   return broadcastBuffer(Array.data(),
+                          Array.span() * sizeof(typename ViewType::value_type),
+                          InEnv, RankBcast);
+}
+template <class T, class... Props>
+int Broadcast(const Kokkos::View<T, Props...> &Array, const int RankBcast) {
+   return Broadcast(Array, MachEnv::getDefault(), RankBcast);
+}
+
 // NOTE: Elements of vector<bool> seem to be non-addressable
 // int Broadcast(std::vector<bool> &Value,
 //              const MachEnv *InEnv = MachEnv::getDefault(),
@@ -8,7 +8,9 @@
 /// This header defines fixed-length data types to enforce levels of precision
 /// where needed. In addition, it supplies a generic real type that is double
 /// precision by default but can be switched throughout using a preprocessor
-/// definition SINGLE_PRECISION. Finally, all arrays in OMEGA are defined
+/// definition SINGLE_PRECISION. A separate real type for tendencies and
+/// auxiliary variables can be reduced to single precision alone with
+/// OMEGA_MIXED_PRECISION. Finally, all arrays in OMEGA are defined
 /// as Kokkos arrays to enable allocation and kernel launching on accelerator
 /// devices. Because the Kokkos definitions can be lengthy, this header defines
 /// useful aliases for up to 5D arrays in all supported types on either the
@@ -33,13 +35,30 @@ using Real = float;
 using Real = double;
 #endif
 
+/// real type used to store tendencies and auxiliary variables. In the
+/// mixed-precision mode (-DOMEGA_MIXED_PRECISION) these are stored in 32-bit
+/// reals while the prognostic state and all reductions remain generic reals.
+#ifdef OMEGA_MIXED_PRECISION
+using AuxReal = R4;
+#else
+using AuxReal = Real;
+#endif
+
 // user-defined literal for generic reals
 KOKKOS_INLINE_FUNCTION constexpr Real operator""_Real(long double x) {
    return x;
 }
 
-// Aliases for Kokkos memory spaces
-#ifdef OMEGA_ENABLE_CUDA
+// Aliases for Kokkos memory spaces. In unified memory builds (eg for APUs
+// with memory shared by the host and the device), the device arrays are
+// allocated in the Kokkos shared space and the host arrays are the same
+// arrays, so that host mirrors alias the device arrays and copies between
+// them only wait for the device.
+#ifdef OMEGA_UNIFIED_MEMORY
+static_assert(Kokkos::has_shared_space,
+              "OMEGA_UNIFIED_MEMORY requires a Kokkos build with SharedSpace");
+using MemSpace = Kokkos::SharedSpace;
+#elif OMEGA_ENABLE_CUDA
 using MemSpace = Kokkos::CudaSpace;
 #elif OMEGA_ENABLE_HIP
 using MemSpace = Kokkos::Experimental::HIPSpace;
@@ -118,10 +137,27 @@ template <> struct DefaultTile<5> {
 #error "OMEGA Memory Layout is not defined."
 #endif
 
-using HostMemSpace     = Kokkos::HostSpace;
+#ifdef OMEGA_UNIFIED_MEMORY
+using HostMemSpace = MemSpace;
+#else
+using HostMemSpace = Kokkos::HostSpace;
+#endif
 using HostMemLayout    = MemLayout;
 using HostMemInvLayout = MemInvLayout;
 
+// Host memory space for staging transfers between host and device. On GPUs
+// this is pinned (page-locked) memory so transfers run at full bandwidth.
+// No transfers are needed with unified memory.
+#ifdef OMEGA_UNIFIED_MEMORY
+using HostStagingSpace = MemSpace;
+#elif OMEGA_ENABLE_CUDA
+using HostStagingSpace = Kokkos::CudaHostPinnedSpace;
+#elif OMEGA_ENABLE_HIP
+using HostStagingSpace = Kokkos::Experimental::HIPHostPinnedSpace;
+#else
+using HostStagingSpace = Kokkos::HostSpace;
+#endif
+
 #define MAKE_OMEGA_VIEW_DIMS(N, V, T, ML, MS)  \
    using N##1D##T = Kokkos::V<T *, ML, MS>;    \
    using N##2D##T = Kokkos::V<T **, ML, MS>;   \
@@ -134,7 +170,8 @@ using HostMemInvLayout = MemInvLayout;
    MAKE_OMEGA_VIEW_DIMS(N, V, I8, ML, MS)   \
    MAKE_OMEGA_VIEW_DIMS(N, V, R4, ML, MS)   \
    MAKE_OMEGA_VIEW_DIMS(N, V, R8, ML, MS)   \
-   MAKE_OMEGA_VIEW_DIMS(N, V, Real, ML, MS)
+   MAKE_OMEGA_VIEW_DIMS(N, V, Real, ML, MS) \
+   MAKE_OMEGA_VIEW_DIMS(N, V, AuxReal, ML, MS)
 
 // Aliases for Kokkos device arrays of various dimensions and types
 MAKE_OMEGA_VIEW_TYPES(Array, View, MemLayout, MemSpace)
@@ -25,7 +25,13 @@
 #include "parmetis.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <map>
 #include <set>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -325,6 +331,141 @@ int readMesh(const int MeshFileID, // file ID for open mesh file
 
 } // end readMesh
 
+//------------------------------------------------------------------------------
+// Reads the cell center coordinates from a mesh file in the same uniform
+// linear distribution across MPI tasks used by readMesh. These are only
+// needed by the space-filling curve partitioning methods.
+
+int readCellCoords(const int MeshFileID, // file ID for open mesh file
+                   const MachEnv *InEnv, // machine environment for MPI layout
+                   I4 NCellsGlobal,      // total number of cells
+                   std::vector<R8> &XCellInit, // x coordinate of cell centers
+                   std::vector<R8> &YCellInit, // y coordinate of cell centers
+                   std::vector<R8> &ZCellInit  // z coordinate of cell centers
+) {
+
+   int Err = 0;
+
+   I4 NumTasks    = InEnv->getNumTasks();
+   I4 MyTask      = InEnv->getMyTask();
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   I4 ChunkStart  = MyTask * NCellsChunk;
+
+   std::vector<I4> CellDims{NCellsGlobal};
+   std::vector<I4> CellOffset(NCellsChunk, -1);
+   for (int Cell = 0; Cell < NCellsChunk; ++Cell) {
+      if (ChunkStart + Cell < NCellsGlobal)
+         CellOffset[Cell] = ChunkStart + Cell;
+   }
+
+   I4 CellDecomp;
+   Err = IO::createDecomp(CellDecomp, IO::IOTypeR8, 1, CellDims, NCellsChunk,
+                          CellOffset, IO::RearrBox);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error creating cell coordinate IO decomposition");
+      return Err;
+   }
+
+   XCellInit.resize(NCellsChunk);
+   YCellInit.resize(NCellsChunk);
+   ZCellInit.resize(NCellsChunk);
+
+   int XCellID;
+   int YCellID;
+   int ZCellID;
+   Err = IO::readArray(&XCellInit[0], NCellsChunk, "xCell", MeshFileID,
+                       CellDecomp, XCellID);
+   Err += IO::readArray(&YCellInit[0], NCellsChunk, "yCell", MeshFileID,
+                        CellDecomp, YCellID);
+   Err += IO::readArray(&ZCellInit[0], NCellsChunk, "zCell", MeshFileID,
+                        CellDecomp, ZCellID);
+   if (Err != 0)
+      LOG_ERROR("Decomp: error reading cell center coordinates");
+
+   IO::destroyDecomp(CellDecomp);
+
+   return Err;
+
+} // end readCellCoords
+
+//------------------------------------------------------------------------------
+// Reads the bottom depth from a mesh file in the same uniform linear
+// distribution used by readMesh and computes the number of active levels of
+// each cell as in HorzMesh: the reference levels divide the maximum bottom
+// depth of the mesh into NVertLevels layers of equal thickness and every cell
+// has at least one active level. These are only needed by weighted
+// partitions.
+
+int readCellLevels(const int MeshFileID, // file ID for open mesh file
+                   const MachEnv *InEnv, // machine environment for MPI layout
+                   I4 NCellsGlobal,      // total number of cells
+                   I4 NVertLevels,       // number of vertical levels
+                   std::vector<I4> &LevelsInit // active levels of each cell
+) {
+
+   int Err = 0;
+
+   I4 NumTasks    = InEnv->getNumTasks();
+   I4 MyTask      = InEnv->getMyTask();
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   I4 ChunkStart  = MyTask * NCellsChunk;
+
+   std::vector<I4> CellDims{NCellsGlobal};
+   std::vector<I4> CellOffset(NCellsChunk, -1);
+   for (int Cell = 0; Cell < NCellsChunk; ++Cell) {
+      if (ChunkStart + Cell < NCellsGlobal)
+         CellOffset[Cell] = ChunkStart + Cell;
+   }
+
+   I4 CellDecomp;
+   Err = IO::createDecomp(CellDecomp, IO::IOTypeR8, 1, CellDims, NCellsChunk,
+                          CellOffset, IO::RearrBox);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error creating bottom depth IO decomposition");
+      return Err;
+   }
+
+   std::vector<R8> BottomDepthInit(NCellsChunk, 0.0);
+   int BottomDepthID;
+   Err = IO::readArray(&BottomDepthInit[0], NCellsChunk, "bottomDepth",
+                       MeshFileID, CellDecomp, BottomDepthID);
+   IO::destroyDecomp(CellDecomp);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error reading bottom depth");
+      return Err;
+   }
+
+   R8 LocMaxDepth = 0.0;
+   for (int Cell = 0; Cell < NCellsChunk; ++Cell) {
+      if (CellOffset[Cell] >= 0)
+         LocMaxDepth = std::max(LocMaxDepth, BottomDepthInit[Cell]);
+   }
+   R8 MaxDepth = 0.0;
+   Err = MPI_Allreduce(&LocMaxDepth, &MaxDepth, 1, MPI_DOUBLE, MPI_MAX,
+                       InEnv->getComm());
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error computing maximum bottom depth");
+      return Err;
+   }
+   R8 RefLayerThick = MaxDepth / NVertLevels;
+
+   LevelsInit.assign(NCellsChunk, 0);
+   for (int Cell = 0; Cell < NCellsChunk; ++Cell) {
+      if (CellOffset[Cell] < 0)
+         continue;
+      if (RefLayerThick > 0) {
+         I4 NActive = static_cast<I4>(
+             std::ceil(BottomDepthInit[Cell] / RefLayerThick));
+         LevelsInit[Cell] = std::clamp(NActive, 1, NVertLevels);
+      } else {
+         LevelsInit[Cell] = NVertLevels;
+      }
+   }
+
+   return Err;
+
+} // end readCellLevels
+
 //------------------------------------------------------------------------------
 // Initialize the decomposition and create the default decomposition with
 // (currently) one partition per MPI task using a ParMetis KWay method.
@@ -360,6 +501,64 @@ int Decomp::init(const std::string &MeshFileName) {
 
    PartMethod Method = getPartMethodFromStr(DecompMethodStr);
 
+   // An optional partition file can be used to read a precomputed
+   // partition or to save the computed partition for later runs
+   std::string PartFileName;
+   if (DecompConfig.existsVar("PartitionFile")) {
+      Err = DecompConfig.get("PartitionFile", PartFileName);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: error reading PartitionFile from Config");
+         return Err;
+      }
+   }
+
+   // Local cells can optionally be reordered for better cache locality
+   bool ReorderLocal = false;
+   if (DecompConfig.existsVar("ReorderLocal")) {
+      Err = DecompConfig.get("ReorderLocal", ReorderLocal);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: error reading ReorderLocal from Config");
+         return Err;
+      }
+   }
+
+   // The partition can optionally be weighted by the work of each cell,
+   // which grows with its active levels. The costs of a cell and a level
+   // can be measured in a run and written to a cost file, so that the next
+   // run (eg a restart) is partitioned with the measured costs.
+   PartWeights Weights;
+   if (DecompConfig.existsVar("WeightByLevels")) {
+      Err = DecompConfig.get("WeightByLevels", Weights.ByLevels);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: error reading WeightByLevels from Config");
+         return Err;
+      }
+   }
+   if (DecompConfig.existsVar("WeightEdges")) {
+      Err = DecompConfig.get("WeightEdges", Weights.Edges);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: error reading WeightEdges from Config");
+         return Err;
+      }
+   }
+   if (DecompConfig.existsVar("CostFile")) {
+      Err = DecompConfig.get("CostFile", Weights.CostFile);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: error reading CostFile from Config");
+         return Err;
+      }
+   }
+   if (Weights.ByLevels or Weights.Edges or !Weights.CostFile.empty()) {
+      Config DimConfig("Dimension");
+      Err = OmegaConfig->get(DimConfig);
+      if (Err == 0)
+         Err = DimConfig.get("NVertLevels", Weights.NVertLevels);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: NVertLevels not found in Dimension Config");
+         return Err;
+      }
+   }
+
    // Retrieve the default machine environment
    MachEnv *DefEnv = MachEnv::getDefault();
 
@@ -367,8 +566,9 @@ int Decomp::init(const std::string &MeshFileName) {
    I4 NParts = DefEnv->getNumTasks();
 
    // Create the default decomposition and set pointer to it
-   Decomp::DefaultDecomp = Decomp::create("Default", DefEnv, NParts, Method,
-                                          InHaloWidth, MeshFileName);
+   Decomp::DefaultDecomp = Decomp::create(
+       "Default", DefEnv, NParts, Method, InHaloWidth, MeshFileName,
+       PartFileName, ReorderLocal, Weights);
 
    return Err;
 
@@ -379,12 +579,15 @@ int Decomp::init(const std::string &MeshFileName) {
 // NPart partitions of the mesh.
 
 Decomp::Decomp(
-    const std::string &Name,         //< [in] Name for new decomposition
-    const MachEnv *InEnv,            //< [in] MachEnv for the new partition
-    I4 NParts,                       //< [in] num of partitions for new decomp
-    PartMethod Method,               //< [in] method for partitioning
-    I4 InHaloWidth,                  //< [in] width of halo in new decomp
-    const std::string &MeshFileName_ //< [in] name of file with mesh info
+    const std::string &Name,          //< [in] Name for new decomposition
+    const MachEnv *InEnv,             //< [in] MachEnv for the new partition
+    I4 NParts,                        //< [in] num of partitions for new decomp
+    PartMethod Method,                //< [in] method for partitioning
+    I4 InHaloWidth,                   //< [in] width of halo in new decomp
+    const std::string &MeshFileName_, //< [in] name of file with mesh info
+    const std::string &PartFileName_, //< [in] name of partition file
+    bool InReorderLocal,              //< [in] reorder local cells
+    const PartWeights &InWeights      //< [in] partition weights
 ) {
 
    int Err = 0; // internal error code
@@ -412,7 +615,9 @@ Decomp::Decomp(
    std::vector<I4> VerticesOnEdgeInit;
    std::vector<I4> CellsOnVertexInit;
    std::vector<I4> EdgesOnVertexInit;
-   HaloWidth = InHaloWidth;
+   HaloWidth    = InHaloWidth;
+   ReorderLocal = InReorderLocal;
+   Weights      = InWeights;
 
    Err = readMesh(FileID, InEnv, NCellsGlobal, NEdgesGlobal, NVerticesGlobal,
                   MaxEdges, MaxCellsOnEdge, VertexDegree, CellsOnCellInit,
@@ -422,6 +627,37 @@ Decomp::Decomp(
    if (Err != 0)
       LOG_CRITICAL("Decomp: Error reading mesh connectivity");
 
+   // The space-filling curve methods partition the cells using the cell
+   // center coordinates, which are read in the same linear distribution
+   std::vector<R8> XCellInit;
+   std::vector<R8> YCellInit;
+   std::vector<R8> ZCellInit;
+   if (NumTasks > 1 and
+       (Method == PartMethodSFCHilbert or Method == PartMethodSFCMorton)) {
+      Err = readCellCoords(FileID, InEnv, NCellsGlobal, XCellInit, YCellInit,
+                           ZCellInit);
+      if (Err != 0)
+         LOG_CRITICAL("Decomp: Error reading cell coordinates");
+   }
+
+   // Weighted partitions and the measurement of the cell costs need the
+   // active levels of each cell, read in the same linear distribution. The
+   // measured costs are only used if the cost file exists.
+   bool NeedLevels =
+       Weights.ByLevels or Weights.Edges or !Weights.CostFile.empty();
+   if (NeedLevels) {
+      Err = readCellLevels(FileID, InEnv, NCellsGlobal, Weights.NVertLevels,
+                           CellLevelsInit);
+      if (Err != 0)
+         LOG_CRITICAL("Decomp: Error reading cell levels");
+      if (Weights.ByLevels) {
+         Err = readCost(InEnv);
+         if (Err != 0)
+            LOG_CRITICAL("Decomp: Error reading cost file {}",
+                         Weights.CostFile);
+      }
+   }
+
    // Close file
    Err = IO::closeFile(FileID);
 
@@ -429,8 +665,34 @@ Decomp::Decomp(
    // just set the needed variables directly. This is done because some METIS
    // functions can raise SIGFPE when numparts == 1 due to division by zero
    // See: https://github.com/KarypisLab/METIS/issues/67
+   // If a partition file is requested and already exists, the partition is
+   // read from the file. Otherwise, the partition is computed and then
+   // written to the file for use in later runs.
+   PartFileName       = PartFileName_;
+   int PartFileExists = 0;
+   if (not PartFileName.empty()) {
+      if (IsMaster)
+         PartFileExists = std::ifstream(PartFileName).good();
+      MPI_Bcast(&PartFileExists, 1, MPI_INT, MasterTask, Comm);
+   }
+
+   // Measured costs replace a partition file so that the cells are
+   // rebalanced, the new partition is written to the file
+   if (PartFileExists and CostFileRead) {
+      LOG_INFO("Decomp: rebalancing with the costs in {} instead of reading "
+               "partition file {}",
+               Weights.CostFile, PartFileName);
+      PartFileExists = 0;
+   }
+
    if (NumTasks == 1) {
       partCellsSingleTask();
+   } else if (PartFileExists) {
+      Err = readPartition(InEnv, CellsOnCellInit);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error reading partition file {}", PartFileName);
+         return;
+      }
    } else {
       // Use the mesh adjacency information to create a partition of cells
       switch (Method) { // branch depending on method chosen
@@ -439,7 +701,7 @@ Decomp::Decomp(
       // ParMetis KWay method
       case PartMethodMetisKWay: {
 
-         Err = partCellsKWay(InEnv, CellsOnCellInit);
+         Err = partCellsMetis(InEnv, CellsOnCellInit, Method);
          if (Err != 0) {
             LOG_CRITICAL("Decomp: Error partitioning cells KWay");
             return;
@@ -447,6 +709,44 @@ Decomp::Decomp(
          break;
       } // end case MethodKWay
 
+      //---------------------------------------------------------------------------
+      // Metis recursive bisection method
+      case PartMethodMetisRB: {
+
+         Err = partCellsMetis(InEnv, CellsOnCellInit, Method);
+         if (Err != 0) {
+            LOG_CRITICAL("Decomp: Error partitioning cells RB");
+            return;
+         }
+         break;
+      } // end case MethodRB
+
+      //---------------------------------------------------------------------------
+      // Space-filling curve methods
+      case PartMethodSFCHilbert:
+      case PartMethodSFCMorton: {
+
+         Err = partCellsSFC(InEnv, CellsOnCellInit, Method, XCellInit,
+                            YCellInit, ZCellInit);
+         if (Err != 0) {
+            LOG_CRITICAL("Decomp: Error partitioning cells SFC");
+            return;
+         }
+         break;
+      } // end case SFC
+
+      //---------------------------------------------------------------------------
+      // Distributed ParMetis KWay method
+      case PartMethodParMetisKWay: {
+
+         Err = partCellsParMetis(InEnv, CellsOnCellInit);
+         if (Err != 0) {
+            LOG_CRITICAL("Decomp: Error partitioning cells with ParMETIS");
+            return;
+         }
+         break;
+      } // end case ParMetisKWay
+
          //---------------------------------------------------------------------------
          // Unknown partitioning method
 
@@ -455,10 +755,27 @@ Decomp::Decomp(
          return;
 
       } // End switch on Method
+
+      if (not PartFileName.empty()) {
+         Err = writePartition(InEnv);
+         if (Err != 0)
+            LOG_ERROR("Decomp: Error writing partition file {}", PartFileName);
+      }
    }
 
    //---------------------------------------------------------------------------
 
+   // Sum the active levels of the owned cells for the cost measurement and
+   // release the levels of the linear distribution
+   if (NeedLevels) {
+      Err = sumOwnedLevels(InEnv, CellLevelsInit);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error summing active levels of owned cells");
+         return;
+      }
+      std::vector<I4>().swap(CellLevelsInit);
+   }
+
    // Cell partitioning complete. Redistribute the initial XXOnCell arrays
    // to their final locations.
    Err = rearrangeCellArrays(InEnv, CellsOnCellInit, EdgesOnCellInit,
@@ -468,6 +785,17 @@ Decomp::Decomp(
       return;
    }
 
+   // Optionally reorder the local cells for better cache locality. The
+   // edges and vertices are ordered as they are encountered around the local
+   // cells, so they follow the new cell ordering.
+   if (ReorderLocal) {
+      Err = reorderCells(InEnv);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error reordering local cells");
+         return;
+      }
+   }
+
    // Partition the edges
    Err = partEdges(InEnv, CellsOnEdgeInit);
    if (Err != 0) {
@@ -691,12 +1019,15 @@ Decomp::Decomp(
 // Creates a new decomposition using the constructor and puts it in the
 // AllDecomps map
 Decomp *Decomp::create(
-    const std::string &Name,        //< [in] Name for new decomposition
-    const MachEnv *Env,             //< [in] MachEnv for the new partition
-    I4 NParts,                      //< [in] num of partitions for new decomp
-    PartMethod Method,              //< [in] method for partitioning
-    I4 HaloWidth,                   //< [in] width of halo in new decomp
-    const std::string &MeshFileName //< [in] name of file with mesh info
+    const std::string &Name,         //< [in] Name for new decomposition
+    const MachEnv *Env,              //< [in] MachEnv for the new partition
+    I4 NParts,                       //< [in] num of partitions for new decomp
+    PartMethod Method,               //< [in] method for partitioning
+    I4 HaloWidth,                    //< [in] width of halo in new decomp
+    const std::string &MeshFileName, //< [in] name of file with mesh info
+    const std::string &PartFileName, //< [in] name of partition file
+    bool ReorderLocal,               //< [in] reorder local cells
+    const PartWeights &Weights       //< [in] partition weights
 ) {
 
    // Check to see if a decomposition of the same name already exists and
@@ -711,7 +1042,8 @@ Decomp *Decomp::create(
    // create a new decomp on the heap and put it in a map of
    // unique_ptrs, which will manage its lifetime
    auto *NewDecomp =
-       new Decomp(Name, Env, NParts, Method, HaloWidth, MeshFileName);
+       new Decomp(Name, Env, NParts, Method, HaloWidth, MeshFileName,
+                  PartFileName, ReorderLocal, Weights);
    AllDecomps.emplace(Name, NewDecomp);
 
    return NewDecomp;
@@ -801,14 +1133,16 @@ void Decomp::partCellsSingleTask() {
 } // end function partCellsSingleTask
 
 //------------------------------------------------------------------------------
-// Partition the cells using the Metis/ParMetis KWay method
+// Partition the cells using the Metis KWay or recursive bisection method
 // After this partitioning, the decomposition class member CellID and
 // CellLocator arrays have been set as well as the class NCells size variables
 // (owned, halo, all).
 
-int Decomp::partCellsKWay(
+int Decomp::partCellsMetis(
     const MachEnv *InEnv, // [in] input machine environment with MPI info
-    const std::vector<I4> &CellsOnCellInit // [in] cell nbrs in linear distrb
+    const std::vector<I4> &CellsOnCellInit, // [in] cell nbrs in linear distrb
+    PartMethod Method,                      // [in] METIS method to use
+    const std::vector<I4> *CellTaskIn       // [in] (optional) known partition
 ) {
 
    int Err = 0; // initialize return code
@@ -834,6 +1168,16 @@ int Decomp::partCellsKWay(
    I4 CellsOnCellSize = NCellsChunk * MaxEdges;
    std::vector<I4> CellsOnCellBuf(CellsOnCellSize, 0);
 
+   // The active levels of all cells are also needed for weighted partitions
+   bool Weighted =
+       CellTaskIn == nullptr and (Weights.ByLevels or Weights.Edges);
+   std::vector<I4> CellLevels;
+   std::vector<I4> LevelsBuf;
+   if (Weighted) {
+      CellLevels.resize(NCellsGlobal);
+      LevelsBuf.resize(NCellsChunk);
+   }
+
    // This is an address counter needed to keep track of the starting
    // address for each cell in the packed adjacency array.
    I4 Add = 0;
@@ -856,6 +1200,15 @@ int Decomp::partCellsKWay(
          LOG_CRITICAL("Decomp: Error communicating CellsOnCell info");
          return Err;
       }
+      if (Weighted) {
+         if (MyTask == Task)
+            LevelsBuf = CellLevelsInit;
+         Err = MPI_Bcast(&LevelsBuf[0], NCellsChunk, MPI_INT32_T, Task, Comm);
+         if (Err != 0) {
+            LOG_CRITICAL("Decomp: Error communicating cell levels");
+            return Err;
+         }
+      }
 
       // Create the adjacency graph by aggregating the individual
       // chunks. Prune edges that don't have neighbors.
@@ -868,6 +1221,8 @@ int Decomp::partCellsKWay(
             break;
 
          AdjAdd[CellGlob] = Add; // start add for cell in Adjacency array
+         if (Weighted)
+            CellLevels[CellGlob] = LevelsBuf[Cell];
          for (int Edge = 0; Edge < MaxEdges; ++Edge) {
             I4 BufAdd  = Cell * MaxEdges + Edge;
             I4 NbrCell = CellsOnCellBuf[BufAdd];
@@ -887,177 +1242,1399 @@ int Decomp::partCellsKWay(
 
    // NConstraints is the number of balancing constraints, mostly for
    // use when multiple vertex weights are assigned. Must be at least 1.
-   // We do not yet support weighted partitions
+   // Weighted partitions use a single constraint, the work of each cell.
    idx_t NConstraints = 1;
 
-   // Arrays needed for weighted decompositions. If no weighting used
-   // set pointers to null.
+   // Arrays needed for weighted decompositions. The vertex weight is the
+   // work of each cell and the edge weight is the number of levels
+   // exchanged across the edge in a halo update, the active levels of the
+   // shallower cell. If no weighting used set pointers to null.
    idx_t *VrtxWgtPtr{nullptr};
    idx_t *EdgeWgtPtr{nullptr};
    idx_t *VrtxSize{nullptr};
+   std::vector<idx_t> VrtxWgt;
+   std::vector<idx_t> EdgeWgt;
+   if (Weighted and Weights.ByLevels) {
+      VrtxWgt.resize(NCellsGlobal);
+      for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
+         VrtxWgt[Cell] = cellWeight(CellLevels[Cell]);
+      }
+      VrtxWgtPtr = &VrtxWgt[0];
+   }
+   if (Weighted and Weights.Edges) {
+      EdgeWgt.resize(std::max(Add, 1));
+      for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
+         for (int Nbr = AdjAdd[Cell]; Nbr < AdjAdd[Cell + 1]; ++Nbr) {
+            EdgeWgt[Nbr] =
+                std::min(CellLevels[Cell], CellLevels[Adjacency[Nbr]]);
+         }
+      }
+      EdgeWgtPtr = &EdgeWgt[0];
+   }
+
+   // Use default metis options
+   idx_t *Options{nullptr};
+
+   // These are for multi-constraint partitions where the vertex weight
+   // has to be distributed among the multiple constraints.
+   // We do not use them so set them to null
+   real_t *TpWgts{nullptr};
+   real_t *Ubvec{nullptr};
+
+   // Results are stored in a new partition array which returns
+   // the processor (partition) assigned to the cell (vrtx)
+   // The routine also returns the number of edge cuts in the partition
+   std::vector<idx_t> CellTask(NCellsGlobal);
+   idx_t Edgecut = 0;
+
+   // Convert to idx_t from Omega::I4, in case these aren't the same
+   idx_t NCellsMetis   = NCellsGlobal;
+   idx_t NumTasksMetis = NumTasks;
+
+   // Call METIS routine to partition the mesh unless a precomputed
+   // partition has been supplied
+   // METIS routines are C code that expect pointers, so we use the
+   // idiom &Var[0] to extract the pointer to the data in std::vector
+   if (CellTaskIn != nullptr) {
+      std::copy(CellTaskIn->begin(), CellTaskIn->end(), CellTask.begin());
+   } else {
+      int MetisErr;
+      if (Method == PartMethodMetisRB) {
+         MetisErr = METIS_PartGraphRecursive(
+             &NCellsMetis, &NConstraints, &AdjAdd[0], &Adjacency[0],
+             VrtxWgtPtr, VrtxSize, EdgeWgtPtr, &NumTasksMetis, TpWgts, Ubvec,
+             Options, &Edgecut, &CellTask[0]);
+      } else {
+         MetisErr = METIS_PartGraphKway(
+             &NCellsMetis, &NConstraints, &AdjAdd[0], &Adjacency[0],
+             VrtxWgtPtr, VrtxSize, EdgeWgtPtr, &NumTasksMetis, TpWgts, Ubvec,
+             Options, &Edgecut, &CellTask[0]);
+      }
+
+      if (MetisErr != METIS_OK) {
+         LOG_CRITICAL("Decomp: Error in ParMETIS");
+         Err = -1;
+         return Err;
+      }
+   }
+
+   // Determine the initial sizes needed by address arrays
+
+   std::vector<I4> TaskCount(NumTasks, 0);
+   for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
+      I4 TaskLoc  = CellTask[Cell];
+      I4 LocalAdd = TaskCount[TaskLoc];
+      ++TaskCount[TaskLoc]; // increment number of cells assigned to task
+   }
+   NCellsOwned = TaskCount[MyTask];
+
+   // Assign the full address (TaskID, local index) for each cell. These
+   // are implicity sorted in CellID order.
+   // During this process we also create an ordered list of all local
+   // (owned+halo) cells using std::set for later use in halo setup
+
+   std::vector<I4> CellLocAll(2 * NCellsGlobal);
+   std::vector<I4> CellIDTmp(NCellsOwned,
+                             NCellsGlobal + 1);    // initial size only
+   std::vector<I4> CellLocTmp(2 * NCellsOwned, 0); // will grow when halo added
+   std::set<I4> CellsInList; // list of unique cells in local owned, halo
+
+   // reset local address counter
+   for (int Task = 0; Task < NumTasks; ++Task)
+      TaskCount[Task] = 0;
+
+   for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
+      I4 TaskLoc  = CellTask[Cell];
+      I4 LocalAdd = TaskCount[TaskLoc];
+      ++TaskCount[TaskLoc]; // increment number of cells assigned to task
+      CellLocAll[2 * Cell]     = TaskLoc;  // Task location
+      CellLocAll[2 * Cell + 1] = LocalAdd; // local address within task
+      // If this cell is on the local task, store as a local cell
+      if (TaskLoc == MyTask) {
+         CellIDTmp[LocalAdd] = Cell + 1; // IDs are 1-based
+         CellsInList.insert(Cell + 1);
+         CellLocTmp[2 * LocalAdd]     = TaskLoc;
+         CellLocTmp[2 * LocalAdd + 1] = LocalAdd;
+      } // end if my task
+   } // end loop over all cells
+
+   // Find and add the halo cells to the cell list. Here we use the
+   // adjacency array to find the active neighbor cells and store if they
+   // are not already owned by the task. We use the std::set container
+   // to automatically sort each halo layer by cellID.
+   I4 CellLocStart = 0;
+   I4 CellLocEnd   = NCellsOwned - 1;
+   I4 CurSize      = NCellsOwned;
+   HostArray1DI4 NCellsHaloTmp("NCellsHalo", HaloWidth);
+   std::set<I4> HaloList;
+   // Loop over each halo layer
+   for (int Halo = 0; Halo < HaloWidth; ++Halo) {
+      // For each of the local cells in the previous level, retrieve
+      // the GlobalID
+      HaloList.clear(); // reset list for this halo layer
+      I4 NbrGlob;       // use for global address of each neighbor
+      I4 NbrID;         // global cell ID of each neighbor
+      for (int CellLoc = CellLocStart; CellLoc <= CellLocEnd; ++CellLoc) {
+         I4 CellGlob = CellIDTmp[CellLoc] - 1;
+         // Loop through the neighbor cells (stored in the adjacency arrays)
+         // to see if they are remote or local
+         I4 NbrStart = AdjAdd[CellGlob];     // start add in adjacency array
+         I4 NbrEnd   = AdjAdd[CellGlob + 1]; // end+1 add in adjacency array
+         for (int NbrCell = NbrStart; NbrCell < NbrEnd; ++NbrCell) {
+            // Get global ID for each neighbor cell
+            NbrGlob = Adjacency[NbrCell];
+            NbrID   = NbrGlob + 1; // Cell IDs are 1-based
+
+            // Check to see if this cell is on a remote task and has not
+            // already been added
+            I4 NbrTask = CellLocAll[2 * NbrGlob];
+            if (NbrTask != MyTask) {
+               // only add to the list if the cell is not already listed
+               // (the find function will return the end iterator if not found)
+               if (CellsInList.find(NbrID) == CellsInList.end()) {
+                  HaloList.insert(NbrID);
+                  CellsInList.insert(NbrID);
+               } // end search for existing entry
+            } // end if not on task
+
+         } // end loop over neighbors
+
+      } // end loop over previous layer
+
+      // Extract the values from the Halo list into the ID and location
+      // vectors. Extend size of ID, Loc arrays.
+      I4 HaloAdd = CellLocEnd;
+      CurSize += HaloList.size();
+      NCellsHaloTmp(Halo) = CurSize;
+      CellIDTmp.resize(CurSize);
+      CellLocTmp.resize(2 * CurSize);
+
+      for (auto IHalo = HaloList.begin(); IHalo != HaloList.end(); IHalo++) {
+         ++HaloAdd;
+         NbrID              = *IHalo; // the neighbor cell id from the HaloList
+         NbrGlob            = NbrID - 1; // global address of this neighbor
+         CellIDTmp[HaloAdd] = NbrID;
+         CellLocTmp[2 * HaloAdd]     = CellLocAll[2 * NbrGlob];
+         CellLocTmp[2 * HaloAdd + 1] = CellLocAll[2 * NbrGlob + 1];
+      }
+
+      // Reset for next halo layer
+      CellLocStart = CellLocEnd + 1;
+      CellLocEnd   = NCellsHaloTmp(Halo) - 1;
+   }
+   NCellsAll  = NCellsHaloTmp(HaloWidth - 1);
+   NCellsSize = NCellsAll + 1; // extra entry to store boundary/undefined value
+
+   // The cell decomposition is now complete, copy the information
+   // into the final locations as class members on host (copy to device later)
+
+   NCellsHaloH = NCellsHaloTmp;
+
+   // Copy global ID for each cell, both owned and halo.
+   // Copy cell location (task, local add) for each cell, both owned and halo
+
+   HostArray1DI4 CellIDHTmp("CellID", NCellsSize);
+   HostArray2DI4 CellLocHTmp("CellLoc", NCellsSize, 2);
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      CellIDHTmp(Cell)     = CellIDTmp[Cell];
+      CellLocHTmp(Cell, 0) = CellLocTmp[2 * Cell];     // task owning this cell
+      CellLocHTmp(Cell, 1) = CellLocTmp[2 * Cell + 1]; // local address on task
+   }
+   CellIDH  = CellIDHTmp;
+   CellLocH = CellLocHTmp;
+
+   // All done
+   return Err;
+
+} // end function partCellsMetis
+
+//------------------------------------------------------------------------------
+// Computes the index of a point along a space-filling curve in three
+// dimensions. Each input coordinate is an integer with SFCBits bits. For the
+// Hilbert curve, the coordinates are first transformed using the algorithm
+// of Skilling (2004, AIP Conf. Proc. 707) so that interleaving the bits of
+// the transformed coordinates gives the Hilbert index. For the Morton
+// (Z-order) curve, the bits are interleaved directly.
+
+constexpr int SFCBits = 21; // bits per coordinate, 3*SFCBits must fit in I8
+
+I8 sfcIndex(uint32_t Coord[3], // integer coordinates (modified on output)
+            bool Hilbert       // true for Hilbert, false for Morton curve
+) {
+
+   const int NDims = 3;
+
+   if (Hilbert) {
+      uint32_t M = 1u << (SFCBits - 1);
+
+      // Inverse undo excess work
+      for (uint32_t Q = M; Q > 1; Q >>= 1) {
+         uint32_t P = Q - 1;
+         for (int Dim = 0; Dim < NDims; ++Dim) {
+            if (Coord[Dim] & Q) { // invert low bits of first coordinate
+               Coord[0] ^= P;
+            } else { // exchange low bits with first coordinate
+               uint32_t T = (Coord[0] ^ Coord[Dim]) & P;
+               Coord[0] ^= T;
+               Coord[Dim] ^= T;
+            }
+         }
+      }
+
+      // Gray encode
+      for (int Dim = 1; Dim < NDims; ++Dim) {
+         Coord[Dim] ^= Coord[Dim - 1];
+      }
+      uint32_t T = 0;
+      for (uint32_t Q = M; Q > 1; Q >>= 1) {
+         if (Coord[NDims - 1] & Q)
+            T ^= Q - 1;
+      }
+      for (int Dim = 0; Dim < NDims; ++Dim) {
+         Coord[Dim] ^= T;
+      }
+   }
+
+   // Interleave the bits, most significant first
+   uint64_t Index = 0;
+   for (int Bit = SFCBits - 1; Bit >= 0; --Bit) {
+      for (int Dim = 0; Dim < NDims; ++Dim) {
+         Index = (Index << 1) | ((Coord[Dim] >> Bit) & 1u);
+      }
+   }
+
+   return static_cast<I8>(Index);
+
+} // end function sfcIndex
+
+//------------------------------------------------------------------------------
+// Partition the cells along a Hilbert or Morton space-filling curve through
+// the cell centers. The coordinates are scaled to the global bounding box of
+// the mesh and each cell is assigned an index along the curve. The cells are
+// then sorted by this index and divided into contiguous segments of nearly
+// equal size, one per task. The halos are built by partCellsMetis using this
+// partition.
+
+int Decomp::partCellsSFC(
+    const MachEnv *InEnv, // [in] input machine environment with MPI info
+    const std::vector<I4> &CellsOnCellInit, // [in] cell nbrs in linear distrb
+    PartMethod Method,                      // [in] SFC method to use
+    const std::vector<R8> &XCellInit,       // [in] x coord of cell centers
+    const std::vector<R8> &YCellInit,       // [in] y coord of cell centers
+    const std::vector<R8> &ZCellInit        // [in] z coord of cell centers
+) {
+
+   int Err = 0; // initialize return code
+
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+
+   // Determine the cells in the local chunk of the linear distribution
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   std::vector<I4> ChunkCounts(NumTasks);
+   std::vector<I4> ChunkDispls(NumTasks);
+   for (int Task = 0; Task < NumTasks; ++Task) {
+      ChunkDispls[Task] = std::min(Task * NCellsChunk, NCellsGlobal);
+      ChunkCounts[Task] =
+          std::min(ChunkDispls[Task] + NCellsChunk, NCellsGlobal) -
+          ChunkDispls[Task];
+   }
+   I4 NCellsLocal = ChunkCounts[MyTask];
+
+   // Determine the global bounding box of the cell centers
+   const std::vector<R8> *Coords[3] = {&XCellInit, &YCellInit, &ZCellInit};
+   R8 LocMin[3];
+   R8 LocMax[3];
+   R8 GlobMin[3];
+   R8 GlobMax[3];
+   for (int Dim = 0; Dim < 3; ++Dim) {
+      LocMin[Dim] = std::numeric_limits<R8>::max();
+      LocMax[Dim] = std::numeric_limits<R8>::lowest();
+      for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+         LocMin[Dim] = std::min(LocMin[Dim], (*Coords[Dim])[Cell]);
+         LocMax[Dim] = std::max(LocMax[Dim], (*Coords[Dim])[Cell]);
+      }
+   }
+   Err = MPI_Allreduce(LocMin, GlobMin, 3, MPI_DOUBLE, MPI_MIN, Comm);
+   Err += MPI_Allreduce(LocMax, GlobMax, 3, MPI_DOUBLE, MPI_MAX, Comm);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error computing mesh bounding box");
+      return Err;
+   }
+
+   // Compute the curve index of each local cell. Dimensions with no extent
+   // (eg z on a planar mesh) are mapped to zero.
+   const R8 MaxCoord = static_cast<R8>((1u << SFCBits) - 1);
+   bool Hilbert      = Method == PartMethodSFCHilbert;
+   std::vector<I8> LocIndex(std::max(NCellsLocal, 1));
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      uint32_t Coord[3];
+      for (int Dim = 0; Dim < 3; ++Dim) {
+         R8 Extent = GlobMax[Dim] - GlobMin[Dim];
+         R8 Scaled = 0.0;
+         if (Extent > 0.0)
+            Scaled = ((*Coords[Dim])[Cell] - GlobMin[Dim]) / Extent;
+         Coord[Dim] = static_cast<uint32_t>(Scaled * MaxCoord);
+      }
+      LocIndex[Cell] = sfcIndex(Coord, Hilbert);
+   }
+
+   // Gather the indices of all cells, sort the cells along the curve and
+   // assign contiguous segments to each task
+   std::vector<I8> CurveIndex(NCellsGlobal);
+   Err = MPI_Allgatherv(LocIndex.data(), NCellsLocal, MPI_INT64_T,
+                        CurveIndex.data(), ChunkCounts.data(),
+                        ChunkDispls.data(), MPI_INT64_T, Comm);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error gathering space-filling curve indices");
+      return Err;
+   }
+
+   std::vector<I4> CurveOrder(NCellsGlobal);
+   for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
+      CurveOrder[Cell] = Cell;
+   }
+   std::stable_sort(CurveOrder.begin(), CurveOrder.end(), [&](I4 A, I4 B) {
+      return CurveIndex[A] < CurveIndex[B];
+   });
+
+   // For weighted partitions, the segments have nearly equal total weight
+   // instead, each cell going to the task that holds the midpoint of its
+   // weight along the curve
+   std::vector<I4> CellTask(NCellsGlobal);
+   if (Weights.ByLevels) {
+      std::vector<I4> LocWgt(std::max(NCellsLocal, 1));
+      for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+         LocWgt[Cell] = cellWeight(CellLevelsInit[Cell]);
+      }
+      std::vector<I4> CellWgt(NCellsGlobal);
+      Err = MPI_Allgatherv(LocWgt.data(), NCellsLocal, MPI_INT32_T,
+                           CellWgt.data(), ChunkCounts.data(),
+                           ChunkDispls.data(), MPI_INT32_T, Comm);
+      if (Err != 0) {
+         LOG_ERROR("Decomp: error gathering cell weights");
+         return Err;
+      }
+      I8 TotalWgt = 0;
+      for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
+         TotalWgt += CellWgt[Cell];
+      }
+      I8 CumWgt = 0;
+      for (int N = 0; N < NCellsGlobal; ++N) {
+         I4 Cell  = CurveOrder[N];
+         I8 MidPt = 2 * CumWgt + CellWgt[Cell];
+         CellTask[Cell] = std::min<I8>(MidPt * NumTasks / (2 * TotalWgt),
+                                       NumTasks - 1);
+         CumWgt += CellWgt[Cell];
+      }
+   } else {
+      for (int N = 0; N < NCellsGlobal; ++N) {
+         CellTask[CurveOrder[N]] =
+             static_cast<I8>(N) * NumTasks / NCellsGlobal;
+      }
+   }
+
+   // Build the halos and cell arrays from this partition
+   return partCellsMetis(InEnv, CellsOnCellInit, Method, &CellTask);
+
+} // end function partCellsSFC
+
+//------------------------------------------------------------------------------
+// Exchanges variable-length lists of integers among all tasks in a
+// communicator. On input, SendBuf holds the values destined for each task in
+// task order with SendCounts values for each task. On output, RecvBuf holds
+// the values received from each task in task order and RecvCounts is the
+// number of values received from each task.
+
+int exchangeLists(const std::vector<I4> &SendBuf,    // values to send
+                  const std::vector<I4> &SendCounts, // num values per task
+                  std::vector<I4> &RecvBuf,          // values received
+                  std::vector<I4> &RecvCounts,       // num recvd per task
+                  MPI_Comm Comm                      // MPI communicator
+) {
+
+   int Err     = 0;
+   I4 NumTasks = SendCounts.size();
+   RecvCounts.resize(NumTasks);
+
+   Err = MPI_Alltoall(SendCounts.data(), 1, MPI_INT32_T, RecvCounts.data(), 1,
+                      MPI_INT32_T, Comm);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("Decomp: error exchanging list sizes");
+      return Err;
+   }
+
+   std::vector<I4> SendDispls(NumTasks, 0);
+   std::vector<I4> RecvDispls(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task) {
+      SendDispls[Task] = SendDispls[Task - 1] + SendCounts[Task - 1];
+      RecvDispls[Task] = RecvDispls[Task - 1] + RecvCounts[Task - 1];
+   }
+   RecvBuf.resize(RecvDispls[NumTasks - 1] + RecvCounts[NumTasks - 1]);
+
+   Err = MPI_Alltoallv(SendBuf.data(), SendCounts.data(), SendDispls.data(),
+                       MPI_INT32_T, RecvBuf.data(), RecvCounts.data(),
+                       RecvDispls.data(), MPI_INT32_T, Comm);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("Decomp: error exchanging lists");
+      return Err;
+   }
+
+   return Err;
+
+} // end function exchangeLists
+
+//------------------------------------------------------------------------------
+// Retrieves the partition location and neighbor cells for a list of cells.
+// The information for each cell is stored on the task that read the cell in
+// the initial linear distribution, so this acts as a distributed directory
+// that avoids storing any global-sized arrays. The input list of cell IDs must
+// be sorted in increasing order. On output, CellInfo contains for each cell
+// in the list the owning task, the local address on that task and the
+// MaxEdges neighbor cell IDs.
+
+int queryCellInfo(
+    const std::vector<I4> &CellIDs,         // sorted 1-based cell IDs
+    const std::vector<I4> &CellLocInit,     // task, local add in linear dstrb
+    const std::vector<I4> &CellsOnCellInit, // cell nbrs in linear dstrb
+    I4 NCellsChunk,                         // cells per task in linear dstrb
+    I4 MaxEdges,                            // max number of edges on a cell
+    I4 NumTasks,                            // number of tasks
+    MPI_Comm Comm,                          // MPI communicator
+    std::vector<I4> &CellInfo               // location and nbrs of each cell
+) {
+
+   int Err     = 0;
+   I4 MyTask   = 0;
+   I4 InfoSize = MaxEdges + 2;
+   MPI_Comm_rank(Comm, &MyTask);
+
+   // Send each requested ID to the task holding it in the linear
+   // distribution. Because the IDs are sorted, they are already in task order.
+   std::vector<I4> SendCounts(NumTasks, 0);
+   for (I4 CellID : CellIDs) {
+      ++SendCounts[(CellID - 1) / NCellsChunk];
+   }
+   std::vector<I4> Requests;
+   std::vector<I4> RequestCounts;
+   Err = exchangeLists(CellIDs, SendCounts, Requests, RequestCounts, Comm);
+   if (Err != 0)
+      return Err;
+
+   // Fill the response for each request from the local chunk
+   std::vector<I4> Replies(InfoSize * Requests.size());
+   I4 ChunkStart = MyTask * NCellsChunk;
+   for (size_t N = 0; N < Requests.size(); ++N) {
+      I4 Cell                   = Requests[N] - 1 - ChunkStart;
+      Replies[InfoSize * N]     = CellLocInit[2 * Cell];
+      Replies[InfoSize * N + 1] = CellLocInit[2 * Cell + 1];
+      for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+         Replies[InfoSize * N + 2 + Edge] =
+             CellsOnCellInit[Cell * MaxEdges + Edge];
+      }
+   }
+   for (int Task = 0; Task < NumTasks; ++Task) {
+      RequestCounts[Task] *= InfoSize;
+   }
+
+   // The replies are returned in the order of the requests
+   std::vector<I4> ReplyCounts;
+   Err = exchangeLists(Replies, RequestCounts, CellInfo, ReplyCounts, Comm);
+
+   return Err;
+
+} // end function queryCellInfo
+
+//------------------------------------------------------------------------------
+// Sums the active levels of the owned cells. The levels of each owned cell
+// are requested from the task holding the cell in the linear distribution,
+// so this works for any partition method.
+
+int Decomp::sumOwnedLevels(
+    const MachEnv *InEnv, // [in] input machine environment with MPI info
+    const std::vector<I4> &LevelsInit // [in] cell levels in linear distrb
+) {
+
+   int Err = 0;
+
+   MPI_Comm Comm  = InEnv->getComm();
+   I4 NumTasks    = InEnv->getNumTasks();
+   I4 MyTask      = InEnv->getMyTask();
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   I4 ChunkStart  = MyTask * NCellsChunk;
+
+   // The requests must be grouped by the task they are sent to
+   std::vector<I4> OwnedIDs(NCellsOwned);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      OwnedIDs[Cell] = CellIDH(Cell);
+   }
+   std::sort(OwnedIDs.begin(), OwnedIDs.end());
+   std::vector<I4> SendCounts(NumTasks, 0);
+   for (I4 ID : OwnedIDs) {
+      ++SendCounts[(ID - 1) / NCellsChunk];
+   }
+
+   std::vector<I4> Requests;
+   std::vector<I4> RequestCounts;
+   Err = exchangeLists(OwnedIDs, SendCounts, Requests, RequestCounts, Comm);
+   if (Err != 0)
+      return Err;
+
+   std::vector<I4> Replies(Requests.size());
+   for (size_t N = 0; N < Requests.size(); ++N) {
+      Replies[N] = LevelsInit[Requests[N] - 1 - ChunkStart];
+   }
+   std::vector<I4> Levels;
+   std::vector<I4> ReplyCounts;
+   Err = exchangeLists(Replies, RequestCounts, Levels, ReplyCounts, Comm);
+   if (Err != 0)
+      return Err;
+
+   NLevelsOwned = 0;
+   for (I4 NLevels : Levels) {
+      NLevelsOwned += NLevels;
+   }
+
+   return Err;
+
+} // end function sumOwnedLevels
+
+//------------------------------------------------------------------------------
+// Partition the cells using the ParMetis KWay method on the linear
+// distribution of the mesh, without creating any global-sized arrays.
+// After this partitioning, the decomposition class member CellID and
+// CellLocator arrays have been set as well as the class NCells size variables
+// (owned, halo, all) and are identical in form to those from partCellsMetis.
+
+int Decomp::partCellsParMetis(
+    const MachEnv *InEnv, // [in] input machine environment with MPI info
+    const std::vector<I4> &CellsOnCellInit // [in] cell nbrs in linear distrb
+) {
+
+   int Err = 0; // initialize return code
+
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+
+   // Determine the cells in the local chunk of the linear distribution
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   I4 ChunkStart  = std::min(MyTask * NCellsChunk, NCellsGlobal);
+   I4 ChunkEnd    = std::min(ChunkStart + NCellsChunk, NCellsGlobal);
+   I4 NCellsLocal = ChunkEnd - ChunkStart;
+
+   // The distribution of cells across tasks (VtxDist) and the local adjacency
+   // graph in the packed form needed by ParMETIS. Edges that don't have
+   // neighbors are pruned.
+   std::vector<idx_t> VtxDist(NumTasks + 1);
+   for (int Task = 0; Task <= NumTasks; ++Task) {
+      VtxDist[Task] = std::min(Task * NCellsChunk, NCellsGlobal);
+   }
+   std::vector<idx_t> AdjAdd(NCellsLocal + 1, 0);
+   std::vector<idx_t> Adjacency;
+   Adjacency.reserve(NCellsLocal * MaxEdges);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      AdjAdd[Cell] = Adjacency.size();
+      for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+         I4 NbrCell = CellsOnCellInit[Cell * MaxEdges + Edge];
+         if (NbrCell > 0 && NbrCell <= NCellsGlobal)
+            Adjacency.push_back(NbrCell - 1); // switch to 0-based indx
+      }
+   }
+   AdjAdd[NCellsLocal] = Adjacency.size();
+
+   // Weighted partitions use the work of each cell as vertex weight. Edge
+   // weights would need the levels of the neighbor cells, which are not
+   // stored on this task, so they are only supported by the serial methods.
+   std::vector<idx_t> VrtxWgt;
+   idx_t *VrtxWgtPtr{nullptr};
+   if (Weights.ByLevels) {
+      VrtxWgt.resize(std::max(NCellsLocal, 1));
+      for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+         VrtxWgt[Cell] = cellWeight(CellLevelsInit[Cell]);
+      }
+      VrtxWgtPtr = VrtxWgt.data();
+   }
+
+   // Set up remaining partitioning variables. A single constraint with
+   // equal target weights for each partition and the ParMETIS recommended
+   // imbalance tolerance are used.
+   idx_t WgtFlag       = Weights.ByLevels ? 2 : 0; // 2: vertex weights only
+   idx_t NumFlag       = 0;
+   idx_t NConstraints  = 1;
+   idx_t NumTasksMetis = NumTasks;
+   idx_t Edgecut       = 0;
+   idx_t Options[3]    = {0, 0, 0}; // use default options
+   std::vector<real_t> TpWgts(NumTasks, 1.0 / NumTasks);
+   real_t Ubvec = 1.05;
+
+   // Results are stored in a partition array which returns the processor
+   // (partition) assigned to each cell in the local chunk
+   std::vector<idx_t> CellTask(std::max(NCellsLocal, 1));
+
+   int MetisErr = ParMETIS_V3_PartKway(
+       VtxDist.data(), AdjAdd.data(), Adjacency.data(), VrtxWgtPtr, nullptr,
+       &WgtFlag, &NumFlag, &NConstraints, &NumTasksMetis, TpWgts.data(), &Ubvec,
+       Options, &Edgecut, CellTask.data(), &Comm);
+
+   if (MetisErr != METIS_OK) {
+      LOG_CRITICAL("Decomp: Error in ParMETIS");
+      Err = -1;
+      return Err;
+   }
+
+   // Send the ID of each cell in the chunk to its new owner. The chunks are
+   // ordered by cell ID, so each task receives its owned cells sorted by
+   // cell ID and the local address is the position in the received list.
+   std::vector<I4> SendCounts(NumTasks, 0);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      ++SendCounts[CellTask[Cell]];
+   }
+   std::vector<I4> SendDispls(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task) {
+      SendDispls[Task] = SendDispls[Task - 1] + SendCounts[Task - 1];
+   }
+   std::vector<I4> SendIDs(NCellsLocal);
+   std::vector<I4> SendAdd(NCellsLocal); // location of cell in send buffer
+   std::vector<I4> TaskCount(SendDispls);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      I4 BufAdd       = TaskCount[CellTask[Cell]]++;
+      SendIDs[BufAdd] = ChunkStart + Cell + 1; // IDs are 1-based
+      SendAdd[Cell]   = BufAdd;
+   }
+
+   std::vector<I4> OwnedIDs;
+   std::vector<I4> RecvCounts;
+   Err = exchangeLists(SendIDs, SendCounts, OwnedIDs, RecvCounts, Comm);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating owned cells");
+      return Err;
+   }
+   NCellsOwned = OwnedIDs.size();
+
+   // Return the local address of each owned cell to the task holding the
+   // cell in the linear distribution so that it can act as a directory
+   // for the (task, local address) location of each cell
+   std::vector<I4> OwnedAdd(NCellsOwned);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      OwnedAdd[Cell] = Cell;
+   }
+   std::vector<I4> LocalAdd;
+   std::vector<I4> AddCounts;
+   Err = exchangeLists(OwnedAdd, RecvCounts, LocalAdd, AddCounts, Comm);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating cell locations");
+      return Err;
+   }
+   std::vector<I4> CellLocInit(2 * NCellsLocal);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      CellLocInit[2 * Cell]     = CellTask[Cell];
+      CellLocInit[2 * Cell + 1] = LocalAdd[SendAdd[Cell]];
+   }
+
+   // Store the owned cells and retrieve their neighbors from the directory
+   std::vector<I4> CellIDTmp(OwnedIDs);
+   std::vector<I4> CellLocTmp(2 * NCellsOwned, 0); // will grow when halo added
+   std::set<I4> CellsInList(OwnedIDs.begin(), OwnedIDs.end());
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      CellLocTmp[2 * Cell]     = MyTask;
+      CellLocTmp[2 * Cell + 1] = Cell;
+   }
+
+   I4 InfoSize = MaxEdges + 2;
+   std::vector<I4> LayerInfo;
+   Err = queryCellInfo(OwnedIDs, CellLocInit, CellsOnCellInit, NCellsChunk,
+                       MaxEdges, NumTasks, Comm, LayerInfo);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error retrieving owned cell neighbors");
+      return Err;
+   }
+
+   // Find and add the halo cells to the cell list one layer at a time using
+   // the neighbors of the previous layer. We use the std::set container to
+   // automatically sort each halo layer by cellID and then retrieve the
+   // location and neighbors of the new layer from the directory.
+   I4 CurSize = NCellsOwned;
+   HostArray1DI4 NCellsHaloTmp("NCellsHalo", HaloWidth);
+   std::set<I4> HaloList;
+   for (int Halo = 0; Halo < HaloWidth; ++Halo) {
+      HaloList.clear(); // reset list for this halo layer
+      I4 LayerSize = LayerInfo.size() / InfoSize;
+      for (int Cell = 0; Cell < LayerSize; ++Cell) {
+         for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+            I4 NbrID = LayerInfo[InfoSize * Cell + 2 + Edge];
+            // Skip edges with no neighbors and cells already listed
+            if (NbrID > 0 && NbrID <= NCellsGlobal &&
+                CellsInList.find(NbrID) == CellsInList.end()) {
+               HaloList.insert(NbrID);
+               CellsInList.insert(NbrID);
+            }
+         }
+      }
+
+      std::vector<I4> HaloIDs(HaloList.begin(), HaloList.end());
+      Err = queryCellInfo(HaloIDs, CellLocInit, CellsOnCellInit, NCellsChunk,
+                          MaxEdges, NumTasks, Comm, LayerInfo);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error retrieving halo cell locations");
+         return Err;
+      }
+
+      // Extend size of ID, Loc arrays and add the new layer
+      I4 HaloAdd = CurSize;
+      CurSize += HaloIDs.size();
+      NCellsHaloTmp(Halo) = CurSize;
+      CellIDTmp.resize(CurSize);
+      CellLocTmp.resize(2 * CurSize);
+      for (size_t N = 0; N < HaloIDs.size(); ++N, ++HaloAdd) {
+         CellIDTmp[HaloAdd]          = HaloIDs[N];
+         CellLocTmp[2 * HaloAdd]     = LayerInfo[InfoSize * N];
+         CellLocTmp[2 * HaloAdd + 1] = LayerInfo[InfoSize * N + 1];
+      }
+   }
+   NCellsAll  = NCellsHaloTmp(HaloWidth - 1);
+   NCellsSize = NCellsAll + 1; // extra entry to store boundary/undefined value
+
+   // The cell decomposition is now complete, copy the information
+   // into the final locations as class members on host (copy to device later)
+
+   NCellsHaloH = NCellsHaloTmp;
+
+   HostArray1DI4 CellIDHTmp("CellID", NCellsSize);
+   HostArray2DI4 CellLocHTmp("CellLoc", NCellsSize, 2);
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      CellIDHTmp(Cell)     = CellIDTmp[Cell];
+      CellLocHTmp(Cell, 0) = CellLocTmp[2 * Cell];     // task owning this cell
+      CellLocHTmp(Cell, 1) = CellLocTmp[2 * Cell + 1]; // local address on task
+   }
+   CellIDH  = CellIDHTmp;
+   CellLocH = CellLocHTmp;
+
+   // All done
+   return Err;
+
+} // end function partCellsParMetis
+
+//------------------------------------------------------------------------------
+// Reads a 1D integer array from a partition file. Each task reads the entries
+// at the input global offsets into Data, which is resized to match. PIO
+// requires a non-empty local array so an unused entry is added if needed.
+
+int readPartArray(int FileID,                  // ID of open partition file
+                  const std::string &VarName,  // name of variable to read
+                  I4 GlobalLength,             // global length of variable
+                  std::vector<I4> Offsets,     // global offset of each entry
+                  std::vector<I4> &Data        // data read from file
+) {
+
+   int Err   = 0;
+   I4 NLocal = Offsets.size();
+   if (NLocal == 0)
+      Offsets.push_back(-1);
+   I4 Size = Offsets.size();
+
+   I4 DecompID;
+   std::vector<I4> Dims{GlobalLength};
+   Err = IO::createDecomp(DecompID, IO::IOTypeI4, 1, Dims, Size, Offsets,
+                          IO::RearrBox);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error creating IO decomposition for {}", VarName);
+      return Err;
+   }
+
+   int VarID;
+   Data.resize(Size);
+   Err = IO::readArray(Data.data(), Size, VarName, FileID, DecompID, VarID);
+   if (Err != 0)
+      LOG_ERROR("Decomp: error reading {} from partition file", VarName);
+   Data.resize(NLocal);
+
+   IO::destroyDecomp(DecompID);
+
+   return Err;
+
+} // end function readPartArray
+
+//------------------------------------------------------------------------------
+// Writes a 1D integer array to a partition file. Each task writes the entries
+// in Data to the input global offsets.
+
+int writePartArray(int FileID,              // ID of open partition file
+                   int VarID,               // ID of variable to write
+                   I4 GlobalLength,         // global length of variable
+                   std::vector<I4> Offsets, // global offset of each entry
+                   std::vector<I4> Data     // data to write
+) {
+
+   int Err = 0;
+   if (Offsets.empty()) {
+      Offsets.push_back(-1);
+      Data.push_back(-1);
+   }
+   I4 Size = Offsets.size();
+
+   I4 DecompID;
+   std::vector<I4> Dims{GlobalLength};
+   Err = IO::createDecomp(DecompID, IO::IOTypeI4, 1, Dims, Size, Offsets,
+                          IO::RearrBox);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error creating IO decomposition for partition file");
+      return Err;
+   }
+
+   I4 FillValue = -1;
+   Err = IO::writeArray(Data.data(), Size, &FillValue, FileID, DecompID, VarID);
+   if (Err != 0)
+      LOG_ERROR("Decomp: error writing array to partition file");
+
+   IO::destroyDecomp(DecompID);
+
+   return Err;
+
+} // end function writePartArray
+
+//------------------------------------------------------------------------------
+// Returns true if the partition file is an Omega NetCDF partition file rather
+// than an MPAS-style graph.info.part.N text file
+
+bool isNetCDFPartFile(const std::string &PartFileName // partition file name
+) {
+   return PartFileName.size() > 3 and
+          PartFileName.compare(PartFileName.size() - 3, 3, ".nc") == 0;
+}
+
+//------------------------------------------------------------------------------
+// Reads a precomputed cell partition from either an MPAS-style
+// graph.info.part.N file or an Omega NetCDF partition file. If the NetCDF
+// file contains halo lists for the same number of tasks and halo width, the
+// cell arrays are read directly. Otherwise, the halos are built from the
+// partition using partCellsMetis without calling METIS.
+
+int Decomp::readPartition(
+    const MachEnv *InEnv, // [in] input machine environment with MPI info
+    const std::vector<I4> &CellsOnCellInit // [in] cell nbrs in linear distrb
+) {
+
+   int Err = 0; // initialize return code
+
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+   I4 MasterTask = InEnv->getMasterTask();
+   bool IsMaster = InEnv->isMasterTask();
+
+   std::vector<I4> CellTask(NCellsGlobal, -1);
+   bool HaloFromFile = false;
+   int FileID        = -1;
+
+   if (not isNetCDFPartFile(PartFileName)) {
+
+      // The MPAS partition file contains the 0-based task for each cell on a
+      // separate line. It is read by the master task and broadcast.
+      I4 NRead = 0;
+      if (IsMaster) {
+         std::ifstream PartFile(PartFileName);
+         I4 Task;
+         while (NRead < NCellsGlobal and PartFile >> Task) {
+            CellTask[NRead] = Task;
+            ++NRead;
+         }
+      }
+      Err = MPI_Bcast(&NRead, 1, MPI_INT32_T, MasterTask, Comm);
+      if (NRead != NCellsGlobal) {
+         LOG_ERROR("Decomp: partition file {} has {} entries, expected {}",
+                   PartFileName, NRead, NCellsGlobal);
+         return -1;
+      }
+      Err = MPI_Bcast(&CellTask[0], NCellsGlobal, MPI_INT32_T, MasterTask,
+                      Comm);
+      if (Err != 0) {
+         LOG_ERROR("Decomp: error broadcasting partition");
+         return Err;
+      }
+
+   } else {
+
+      Err = IO::openFile(FileID, PartFileName, IO::ModeRead);
+      if (Err != 0) {
+         LOG_ERROR("Decomp: error opening partition file {}", PartFileName);
+         return Err;
+      }
+
+      // Check that the partition matches this mesh and environment
+      I4 DimID;
+      I4 NCellsFile;
+      I4 NTasksFile;
+      I4 HaloWidthFile;
+      Err = IO::getDimFromFile(FileID, "NCells", DimID, NCellsFile);
+      Err += IO::getDimFromFile(FileID, "NTasks", DimID, NTasksFile);
+      Err += IO::readMeta("HaloWidth", HaloWidthFile, FileID, IO::GlobalID);
+      if (Err != 0 or NCellsFile != NCellsGlobal or NTasksFile != NumTasks) {
+         LOG_ERROR("Decomp: partition file {} does not match the mesh and "
+                   "number of tasks",
+                   PartFileName);
+         IO::closeFile(FileID);
+         return -1;
+      }
+
+      // Read the task of each cell in the linear distribution and gather
+      // the full partition on all tasks
+      I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+      std::vector<I4> ChunkCounts(NumTasks);
+      std::vector<I4> ChunkDispls(NumTasks);
+      for (int Task = 0; Task < NumTasks; ++Task) {
+         ChunkDispls[Task] = std::min(Task * NCellsChunk, NCellsGlobal);
+         ChunkCounts[Task] =
+             std::min(ChunkDispls[Task] + NCellsChunk, NCellsGlobal) -
+             ChunkDispls[Task];
+      }
+      std::vector<I4> Offsets(ChunkCounts[MyTask]);
+      for (int Cell = 0; Cell < ChunkCounts[MyTask]; ++Cell) {
+         Offsets[Cell] = ChunkDispls[MyTask] + Cell;
+      }
+      std::vector<I4> TaskChunk;
+      Err = readPartArray(FileID, "cellTask", NCellsGlobal, Offsets, TaskChunk);
+      if (Err != 0) {
+         IO::closeFile(FileID);
+         return Err;
+      }
+      Err = MPI_Allgatherv(TaskChunk.data(), ChunkCounts[MyTask], MPI_INT32_T,
+                           &CellTask[0], ChunkCounts.data(), ChunkDispls.data(),
+                           MPI_INT32_T, Comm);
+      if (Err != 0) {
+         LOG_ERROR("Decomp: error gathering partition");
+         IO::closeFile(FileID);
+         return Err;
+      }
+
+      HaloFromFile = HaloWidthFile == HaloWidth;
+   }
+
+   // Check the validity of the partition
+   for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
+      if (CellTask[Cell] < 0 or CellTask[Cell] >= NumTasks) {
+         LOG_ERROR("Decomp: invalid task {} for cell {} in partition file {}",
+                   CellTask[Cell], Cell + 1, PartFileName);
+         if (FileID >= 0)
+            IO::closeFile(FileID);
+         return -1;
+      }
+   }
+
+   // If the halo lists are not available, build them from the partition
+   if (not HaloFromFile) {
+      if (FileID >= 0)
+         IO::closeFile(FileID);
+      return partCellsMetis(InEnv, CellsOnCellInit, PartMethodMetisKWay,
+                            &CellTask);
+   }
+
+   // Otherwise the owned cells are the cells assigned to this task in
+   // CellID order and the halo cells are read from the file
+   std::vector<I4> CellIDTmp;
+   for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
+      if (CellTask[Cell] == MyTask)
+         CellIDTmp.push_back(Cell + 1); // IDs are 1-based
+   }
+   NCellsOwned = CellIDTmp.size();
+
+   std::vector<I4> Offsets(HaloWidth);
+   for (int Halo = 0; Halo < HaloWidth; ++Halo) {
+      Offsets[Halo] = MyTask * HaloWidth + Halo;
+   }
+   std::vector<I4> NCellsHaloTmp;
+   Err = readPartArray(FileID, "nCellsHalo", NumTasks * HaloWidth, Offsets,
+                       NCellsHaloTmp);
+   I4 NHaloLocal = NCellsHaloTmp[HaloWidth - 1] - NCellsOwned;
+   I4 HaloStart  = 0;
+   I4 NHaloCells = 0;
+   I4 HaloDimID;
+   Err += IO::getDimFromFile(FileID, "NHaloCells", HaloDimID, NHaloCells);
+   Err += MPI_Exscan(&NHaloLocal, &HaloStart, 1, MPI_INT32_T, MPI_SUM, Comm);
+   if (MyTask == 0)
+      HaloStart = 0;
+
+   Offsets.resize(NHaloLocal);
+   for (int Cell = 0; Cell < NHaloLocal; ++Cell) {
+      Offsets[Cell] = HaloStart + Cell;
+   }
+   std::vector<I4> HaloIDs;
+   std::vector<I4> HaloTasks;
+   std::vector<I4> HaloAdds;
+   Err += readPartArray(FileID, "haloCellID", NHaloCells, Offsets, HaloIDs);
+   Err += readPartArray(FileID, "haloCellTask", NHaloCells, Offsets, HaloTasks);
+   Err += readPartArray(FileID, "haloCellAdd", NHaloCells, Offsets, HaloAdds);
+   IO::closeFile(FileID);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error reading halo lists from partition file");
+      return -1;
+   }
+
+   // Copy the information into the final locations as class members
+   NCellsAll  = NCellsOwned + NHaloLocal;
+   NCellsSize = NCellsAll + 1; // extra entry to store boundary/undefined value
+
+   NCellsHaloH = HostArray1DI4("NCellsHalo", HaloWidth);
+   for (int Halo = 0; Halo < HaloWidth; ++Halo) {
+      NCellsHaloH(Halo) = NCellsHaloTmp[Halo];
+   }
+
+   CellIDH  = HostArray1DI4("CellID", NCellsSize);
+   CellLocH = HostArray2DI4("CellLoc", NCellsSize, 2);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      CellIDH(Cell)     = CellIDTmp[Cell];
+      CellLocH(Cell, 0) = MyTask;
+      CellLocH(Cell, 1) = Cell;
+   }
+   for (int Cell = 0; Cell < NHaloLocal; ++Cell) {
+      CellIDH(NCellsOwned + Cell)     = HaloIDs[Cell];
+      CellLocH(NCellsOwned + Cell, 0) = HaloTasks[Cell];
+      CellLocH(NCellsOwned + Cell, 1) = HaloAdds[Cell];
+   }
+
+   return Err;
+
+} // end function readPartition
+
+//------------------------------------------------------------------------------
+// Writes the cell partition to a partition file. MPAS-style files only
+// contain the task for each cell while Omega NetCDF files also contain the
+// halo lists for each task so that the halo setup can be skipped on read.
+
+int Decomp::writePartition(
+    const MachEnv *InEnv // [in] input machine environment with MPI info
+) const {
+
+   int Err = 0; // initialize return code
+
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+   I4 MasterTask = InEnv->getMasterTask();
+   bool IsMaster = InEnv->isMasterTask();
+
+   std::vector<I4> OwnedIDs(NCellsOwned);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      OwnedIDs[Cell] = CellIDH(Cell);
+   }
+
+   if (not isNetCDFPartFile(PartFileName)) {
+
+      // Gather the owned cells of every task on the master task, which
+      // writes the task of each cell on a separate line
+      std::vector<I4> OwnedCounts(NumTasks, 0);
+      std::vector<I4> OwnedDispls(NumTasks, 0);
+      Err = MPI_Gather(&NCellsOwned, 1, MPI_INT32_T, OwnedCounts.data(), 1,
+                       MPI_INT32_T, MasterTask, Comm);
+      for (int Task = 1; Task < NumTasks; ++Task) {
+         OwnedDispls[Task] = OwnedDispls[Task - 1] + OwnedCounts[Task - 1];
+      }
+      std::vector<I4> AllIDs(IsMaster ? NCellsGlobal : 0);
+      Err += MPI_Gatherv(OwnedIDs.data(), NCellsOwned, MPI_INT32_T,
+                         AllIDs.data(), OwnedCounts.data(), OwnedDispls.data(),
+                         MPI_INT32_T, MasterTask, Comm);
+      if (Err != 0) {
+         LOG_ERROR("Decomp: error gathering partition");
+         return Err;
+      }
+
+      if (IsMaster) {
+         std::vector<I4> CellTask(NCellsGlobal, -1);
+         for (int Task = 0; Task < NumTasks; ++Task) {
+            for (int N = 0; N < OwnedCounts[Task]; ++N) {
+               CellTask[AllIDs[OwnedDispls[Task] + N] - 1] = Task;
+            }
+         }
+         std::ofstream PartFile(PartFileName);
+         for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
+            PartFile << CellTask[Cell] << "\n";
+         }
+         if (not PartFile) {
+            LOG_ERROR("Decomp: error writing partition file {}", PartFileName);
+            Err = -1;
+         }
+      }
+      MPI_Bcast(&Err, 1, MPI_INT, MasterTask, Comm);
 
-   // Use default metis options
-   idx_t *Options{nullptr};
+      return Err;
+   }
 
-   // These are for multi-constraint partitions where the vertex weight
-   // has to be distributed among the multiple constraints.
-   // We do not use them so set them to null
-   real_t *TpWgts{nullptr};
-   real_t *Ubvec{nullptr};
+   // Determine the location of the local halo cells in the halo lists
+   I4 NHaloLocal = NCellsAll - NCellsOwned;
+   I4 HaloStart  = 0;
+   I4 NHaloCells = 0;
+   Err = MPI_Exscan(&NHaloLocal, &HaloStart, 1, MPI_INT32_T, MPI_SUM, Comm);
+   Err += MPI_Allreduce(&NHaloLocal, &NHaloCells, 1, MPI_INT32_T, MPI_SUM,
+                        Comm);
+   if (MyTask == 0)
+      HaloStart = 0;
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error computing halo list sizes");
+      return Err;
+   }
 
-   // Results are stored in a new partition array which returns
-   // the processor (partition) assigned to the cell (vrtx)
-   // The routine also returns the number of edge cuts in the partition
-   std::vector<idx_t> CellTask(NCellsGlobal);
-   idx_t Edgecut = 0;
+   // Open the file and define the dimensions and variables
+   int FileID;
+   Err = IO::openFile(FileID, PartFileName, IO::ModeWrite, IO::FmtDefault,
+                      IO::IfExists::Replace);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error opening partition file {}", PartFileName);
+      return Err;
+   }
 
-   // Convert to idx_t from Omega::I4, in case these aren't the same
-   idx_t NCellsMetis   = NCellsGlobal;
-   idx_t NumTasksMetis = NumTasks;
+   int CellDimID;
+   int TaskDimID;
+   int HaloDimID;
+   int LayerDimID;
+   Err = IO::defineDim(FileID, "NCells", NCellsGlobal, CellDimID);
+   Err += IO::defineDim(FileID, "NTasks", NumTasks, TaskDimID);
+   Err += IO::defineDim(FileID, "NHaloLayers", HaloWidth, LayerDimID);
+   Err += IO::defineDim(FileID, "NHaloCells", NHaloCells, HaloDimID);
+
+   int CellTaskID;
+   int NCellsHaloID;
+   int HaloCellIDID;
+   int HaloCellTaskID;
+   int HaloCellAddID;
+   int LayerDims[2] = {TaskDimID, LayerDimID};
+   Err += IO::defineVar(FileID, "cellTask", IO::IOTypeI4, 1, &CellDimID,
+                        CellTaskID);
+   Err += IO::defineVar(FileID, "nCellsHalo", IO::IOTypeI4, 2, LayerDims,
+                        NCellsHaloID);
+   Err += IO::defineVar(FileID, "haloCellID", IO::IOTypeI4, 1, &HaloDimID,
+                        HaloCellIDID);
+   Err += IO::defineVar(FileID, "haloCellTask", IO::IOTypeI4, 1, &HaloDimID,
+                        HaloCellTaskID);
+   Err += IO::defineVar(FileID, "haloCellAdd", IO::IOTypeI4, 1, &HaloDimID,
+                        HaloCellAddID);
+   Err += IO::writeMeta("HaloWidth", HaloWidth, FileID, IO::GlobalID);
+   Err += IO::endDefinePhase(FileID);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error defining partition file contents");
+      IO::closeFile(FileID);
+      return -1;
+   }
 
-   // Call METIS routine to partition the mesh
-   // METIS routines are C code that expect pointers, so we use the
-   // idiom &Var[0] to extract the pointer to the data in std::vector
-   int MetisErr = METIS_PartGraphKway(&NCellsMetis, &NConstraints, &AdjAdd[0],
-                                      &Adjacency[0], VrtxWgtPtr, VrtxSize,
-                                      EdgeWgtPtr, &NumTasksMetis, TpWgts, Ubvec,
-                                      Options, &Edgecut, &CellTask[0]);
+   // Each task writes the task of its owned cells and its halo lists
+   std::vector<I4> Offsets(NCellsOwned);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      Offsets[Cell] = OwnedIDs[Cell] - 1;
+   }
+   Err = writePartArray(FileID, CellTaskID, NCellsGlobal, Offsets,
+                        std::vector<I4>(NCellsOwned, MyTask));
 
-   if (MetisErr != METIS_OK) {
-      LOG_CRITICAL("Decomp: Error in ParMETIS");
-      Err = -1;
-      return Err;
+   Offsets.resize(HaloWidth);
+   std::vector<I4> Data(HaloWidth);
+   for (int Halo = 0; Halo < HaloWidth; ++Halo) {
+      Offsets[Halo] = MyTask * HaloWidth + Halo;
+      Data[Halo]    = NCellsHaloH(Halo);
    }
+   Err += writePartArray(FileID, NCellsHaloID, NumTasks * HaloWidth, Offsets,
+                         Data);
 
-   // Determine the initial sizes needed by address arrays
+   Offsets.resize(NHaloLocal);
+   for (int Cell = 0; Cell < NHaloLocal; ++Cell) {
+      Offsets[Cell] = HaloStart + Cell;
+   }
+   Data.resize(NHaloLocal);
+   for (int Cell = 0; Cell < NHaloLocal; ++Cell) {
+      Data[Cell] = CellIDH(NCellsOwned + Cell);
+   }
+   Err += writePartArray(FileID, HaloCellIDID, NHaloCells, Offsets, Data);
+   for (int Cell = 0; Cell < NHaloLocal; ++Cell) {
+      Data[Cell] = CellLocH(NCellsOwned + Cell, 0);
+   }
+   Err += writePartArray(FileID, HaloCellTaskID, NHaloCells, Offsets, Data);
+   for (int Cell = 0; Cell < NHaloLocal; ++Cell) {
+      Data[Cell] = CellLocH(NCellsOwned + Cell, 1);
+   }
+   Err += writePartArray(FileID, HaloCellAddID, NHaloCells, Offsets, Data);
 
-   std::vector<I4> TaskCount(NumTasks, 0);
-   for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
-      I4 TaskLoc  = CellTask[Cell];
-      I4 LocalAdd = TaskCount[TaskLoc];
-      ++TaskCount[TaskLoc]; // increment number of cells assigned to task
+   Err += IO::closeFile(FileID);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error writing partition file {}", PartFileName);
+      return -1;
    }
-   NCellsOwned = TaskCount[MyTask];
 
-   // Assign the full address (TaskID, local index) for each cell. These
-   // are implicity sorted in CellID order.
-   // During this process we also create an ordered list of all local
-   // (owned+halo) cells using std::set for later use in halo setup
+   return Err;
 
-   std::vector<I4> CellLocAll(2 * NCellsGlobal);
-   std::vector<I4> CellIDTmp(NCellsOwned,
-                             NCellsGlobal + 1);    // initial size only
-   std::vector<I4> CellLocTmp(2 * NCellsOwned, 0); // will grow when halo added
-   std::set<I4> CellsInList; // list of unique cells in local owned, halo
+} // end function writePartition
 
-   // reset local address counter
-   for (int Task = 0; Task < NumTasks; ++Task)
-      TaskCount[Task] = 0;
+//------------------------------------------------------------------------------
+// Computes the partition weight of a cell from its active levels
 
-   for (int Cell = 0; Cell < NCellsGlobal; ++Cell) {
-      I4 TaskLoc  = CellTask[Cell];
-      I4 LocalAdd = TaskCount[TaskLoc];
-      ++TaskCount[TaskLoc]; // increment number of cells assigned to task
-      CellLocAll[2 * Cell]     = TaskLoc;  // Task location
-      CellLocAll[2 * Cell + 1] = LocalAdd; // local address within task
-      // If this cell is on the local task, store as a local cell
-      if (TaskLoc == MyTask) {
-         CellIDTmp[LocalAdd] = Cell + 1; // IDs are 1-based
-         CellsInList.insert(Cell + 1);
-         CellLocTmp[2 * LocalAdd]     = TaskLoc;
-         CellLocTmp[2 * LocalAdd + 1] = LocalAdd;
-      } // end if my task
-   } // end loop over all cells
+I4 Decomp::cellWeight(I4 NLevels // [in] number of active levels of the cell
+) const {
 
-   // Find and add the halo cells to the cell list. Here we use the
-   // adjacency array to find the active neighbor cells and store if they
-   // are not already owned by the task. We use the std::set container
-   // to automatically sort each halo layer by cellID.
-   I4 CellLocStart = 0;
-   I4 CellLocEnd   = NCellsOwned - 1;
-   I4 CurSize      = NCellsOwned;
-   HostArray1DI4 NCellsHaloTmp("NCellsHalo", HaloWidth);
-   std::set<I4> HaloList;
-   // Loop over each halo layer
-   for (int Halo = 0; Halo < HaloWidth; ++Halo) {
-      // For each of the local cells in the previous level, retrieve
-      // the GlobalID
-      HaloList.clear(); // reset list for this halo layer
-      I4 NbrGlob;       // use for global address of each neighbor
-      I4 NbrID;         // global cell ID of each neighbor
-      for (int CellLoc = CellLocStart; CellLoc <= CellLocEnd; ++CellLoc) {
-         I4 CellGlob = CellIDTmp[CellLoc] - 1;
-         // Loop through the neighbor cells (stored in the adjacency arrays)
-         // to see if they are remote or local
-         I4 NbrStart = AdjAdd[CellGlob];     // start add in adjacency array
-         I4 NbrEnd   = AdjAdd[CellGlob + 1]; // end+1 add in adjacency array
-         for (int NbrCell = NbrStart; NbrCell < NbrEnd; ++NbrCell) {
-            // Get global ID for each neighbor cell
-            NbrGlob = Adjacency[NbrCell];
-            NbrID   = NbrGlob + 1; // Cell IDs are 1-based
+   R8 MaxCost = CellCost + LevelCost * Weights.NVertLevels;
+   if (MaxCost <= 0)
+      return 1;
+   R8 Cost = CellCost + LevelCost * NLevels;
+   return std::max(1,
+                   static_cast<I4>(std::lround(WeightScale * Cost / MaxCost)));
 
-            // Check to see if this cell is on a remote task and has not
-            // already been added
-            I4 NbrTask = CellLocAll[2 * NbrGlob];
-            if (NbrTask != MyTask) {
-               // only add to the list if the cell is not already listed
-               // (the find function will return the end iterator if not found)
-               if (CellsInList.find(NbrID) == CellsInList.end()) {
-                  HaloList.insert(NbrID);
-                  CellsInList.insert(NbrID);
-               } // end search for existing entry
-            } // end if not on task
+} // end function cellWeight
 
-         } // end loop over neighbors
+//------------------------------------------------------------------------------
+// Reads the cell and level costs from the cost file on the master task and
+// broadcasts them. A missing file is not an error, the partition is then
+// weighted by the active levels only.
 
-      } // end loop over previous layer
+int Decomp::readCost(const MachEnv *InEnv // [in] MachEnv with MPI info
+) {
 
-      // Extract the values from the Halo list into the ID and location
-      // vectors. Extend size of ID, Loc arrays.
-      I4 HaloAdd = CellLocEnd;
-      CurSize += HaloList.size();
-      NCellsHaloTmp(Halo) = CurSize;
-      CellIDTmp.resize(CurSize);
-      CellLocTmp.resize(2 * CurSize);
+   int Err = 0;
 
-      for (auto IHalo = HaloList.begin(); IHalo != HaloList.end(); IHalo++) {
-         ++HaloAdd;
-         NbrID              = *IHalo; // the neighbor cell id from the HaloList
-         NbrGlob            = NbrID - 1; // global address of this neighbor
-         CellIDTmp[HaloAdd] = NbrID;
-         CellLocTmp[2 * HaloAdd]     = CellLocAll[2 * NbrGlob];
-         CellLocTmp[2 * HaloAdd + 1] = CellLocAll[2 * NbrGlob + 1];
+   if (Weights.CostFile.empty())
+      return Err;
+
+   // Status is 0 for a missing file, 1 for valid costs and -1 for an error
+   R8 CostData[3] = {0.0, CellCost, LevelCost};
+   if (InEnv->isMasterTask()) {
+      std::ifstream Costs(Weights.CostFile);
+      if (Costs.is_open()) {
+         std::string Line;
+         CostData[0] = -1.0;
+         while (std::getline(Costs, Line)) {
+            if (Line.empty() or Line[0] == '#')
+               continue;
+            std::istringstream Fields(Line);
+            R8 InCellCost  = -1.0;
+            R8 InLevelCost = -1.0;
+            Fields >> InCellCost >> InLevelCost;
+            if (!Fields.fail() and InCellCost >= 0 and InLevelCost >= 0 and
+                InCellCost + InLevelCost > 0) {
+               CostData[0] = 1.0;
+               CostData[1] = InCellCost;
+               CostData[2] = InLevelCost;
+            }
+            break;
+         }
       }
+   }
+   Err = MPI_Bcast(CostData, 3, MPI_DOUBLE, InEnv->getMasterTask(),
+                   InEnv->getComm());
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error broadcasting costs");
+      return Err;
+   }
 
-      // Reset for next halo layer
-      CellLocStart = CellLocEnd + 1;
-      CellLocEnd   = NCellsHaloTmp(Halo) - 1;
+   if (CostData[0] < 0) {
+      LOG_ERROR("Decomp: invalid costs in cost file {}", Weights.CostFile);
+      return -1;
+   }
+   if (CostData[0] == 0) {
+      LOG_INFO("Decomp: no cost file {}, weighting cells by active levels",
+               Weights.CostFile);
+      return Err;
    }
-   NCellsAll  = NCellsHaloTmp(HaloWidth - 1);
-   NCellsSize = NCellsAll + 1; // extra entry to store boundary/undefined value
 
-   // The cell decomposition is now complete, copy the information
-   // into the final locations as class members on host (copy to device later)
+   CellCost     = CostData[1];
+   LevelCost    = CostData[2];
+   CostFileRead = true;
+   LOG_INFO("Decomp: weighting cells with cell cost {:.3e} s and level cost "
+            "{:.3e} s from {}",
+            CellCost, LevelCost, Weights.CostFile);
 
-   NCellsHaloH = NCellsHaloTmp;
+   return Err;
 
-   // Copy global ID for each cell, both owned and halo.
-   // Copy cell location (task, local add) for each cell, both owned and halo
+} // end function readCost
 
-   HostArray1DI4 CellIDHTmp("CellID", NCellsSize);
-   HostArray2DI4 CellLocHTmp("CellLoc", NCellsSize, 2);
-   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
-      CellIDHTmp(Cell)     = CellIDTmp[Cell];
-      CellLocHTmp(Cell, 0) = CellLocTmp[2 * Cell];     // task owning this cell
-      CellLocHTmp(Cell, 1) = CellLocTmp[2 * Cell + 1]; // local address on task
+//------------------------------------------------------------------------------
+// Fits the cost of a cell and of an active level to the work time of every
+// task by least squares, WorkTime = CellCost * NCellsOwned +
+// LevelCost * NLevelsOwned, and writes them to the cost file. If the fit is
+// ill-conditioned (eg all cells have the same levels) or gives a negative
+// cost, a single cost is fit instead.
+
+int Decomp::writeCost(const MachEnv *InEnv, // [in] MachEnv with MPI info
+                      R8 WorkTime           // [in] local time of the work
+) const {
+
+   int Err = 0;
+
+   if (Weights.CostFile.empty())
+      return Err;
+
+   I4 NumTasks    = InEnv->getNumTasks();
+   R8 LocData[3]  = {static_cast<R8>(NCellsOwned),
+                     static_cast<R8>(NLevelsOwned), WorkTime};
+   std::vector<R8> AllData(3 * NumTasks);
+   Err = MPI_Gather(LocData, 3, MPI_DOUBLE, AllData.data(), 3, MPI_DOUBLE,
+                    InEnv->getMasterTask(), InEnv->getComm());
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error gathering work times");
+      return Err;
    }
-   CellIDH  = CellIDHTmp;
-   CellLocH = CellLocHTmp;
+   if (not InEnv->isMasterTask())
+      return Err;
+
+   R8 SumCC = 0, SumCL = 0, SumLL = 0, SumCT = 0, SumLT = 0;
+   R8 MaxTime = 0, SumTime = 0;
+   for (int Task = 0; Task < NumTasks; ++Task) {
+      R8 C = AllData[3 * Task];
+      R8 L = AllData[3 * Task + 1];
+      R8 T = AllData[3 * Task + 2];
+      SumCC += C * C;
+      SumCL += C * L;
+      SumLL += L * L;
+      SumCT += C * T;
+      SumLT += L * T;
+      MaxTime = std::max(MaxTime, T);
+      SumTime += T;
+   }
+   if (SumTime <= 0) {
+      LOG_WARN("Decomp: no work time measured, cost file {} not written",
+               Weights.CostFile);
+      return Err;
+   }
+
+   R8 FitCellCost  = -1.0;
+   R8 FitLevelCost = -1.0;
+   R8 Det          = SumCC * SumLL - SumCL * SumCL;
+   if (Det > 1.0e-12 * SumCC * SumLL) {
+      FitCellCost  = (SumCT * SumLL - SumLT * SumCL) / Det;
+      FitLevelCost = (SumCC * SumLT - SumCL * SumCT) / Det;
+   }
+   if (FitLevelCost < 0 and FitCellCost > 0) {
+      FitCellCost  = SumCT / SumCC;
+      FitLevelCost = 0.0;
+   } else if (FitCellCost < 0 or FitLevelCost < 0) {
+      FitCellCost  = 0.0;
+      FitLevelCost = SumLL > 0 ? SumLT / SumLL : 0.0;
+   }
+   if (FitCellCost + FitLevelCost <= 0) {
+      LOG_WARN("Decomp: unable to fit costs, cost file {} not written",
+               Weights.CostFile);
+      return Err;
+   }
+
+   std::ofstream Costs(Weights.CostFile);
+   if (!Costs.is_open()) {
+      LOG_ERROR("Decomp: unable to open cost file {}", Weights.CostFile);
+      return -1;
+   }
+   Costs << "# Omega Decomp costs in seconds: CellCost LevelCost\n";
+   Costs.precision(9);
+   Costs << FitCellCost << " " << FitLevelCost << "\n";
+   if (Costs.fail()) {
+      LOG_ERROR("Decomp: error writing cost file {}", Weights.CostFile);
+      return -1;
+   }
+
+   LOG_INFO("Decomp: work time imbalance (max/mean) {:.3f}, wrote cell cost "
+            "{:.3e} s and level cost {:.3e} s to {}",
+            MaxTime * NumTasks / SumTime, FitCellCost, FitLevelCost,
+            Weights.CostFile);
 
-   // All done
    return Err;
 
-} // end function partCellsKWay
+} // end function writeCost
 
 //------------------------------------------------------------------------------
 // Partition the edges based on the cell decomposition. The first cell ID in
@@ -1657,6 +3234,191 @@ int Decomp::rearrangeCellArrays(
 
 } // end function rearrangeCellArrays
 
+//------------------------------------------------------------------------------
+// Reorder the local cells to improve the cache locality of indirect accesses
+// through the connectivity arrays. The owned cells are reordered with the
+// reverse Cuthill-McKee (RCM) algorithm applied to the graph of owned cells.
+// Each halo layer is then ordered by a breadth-first traversal from the
+// previous layer so that halo cells are stored near their owned neighbors.
+// The layer boundaries are unchanged. Because the local address of an owned
+// cell changes, the location of each halo cell is updated by its owner. This
+// must be called after rearrangeCellArrays and before the edges and vertices
+// are partitioned so that their ordering follows the new cell ordering.
+
+int Decomp::reorderCells(
+    const MachEnv *InEnv // [in] input machine environment with MPI info
+) {
+
+   int Err = 0; // default return code
+
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+
+   // Map from global ID to current local address of all local cells
+   std::map<I4, I4> GlobToLoc;
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      GlobToLoc[CellIDH(Cell)] = Cell;
+   }
+
+   // Retrieves the unplaced local neighbors of a cell within an address range
+   std::vector<bool> Placed(NCellsAll, false);
+   auto findNbrs = [&](I4 Cell, I4 Start, I4 End, std::vector<I4> &Nbrs) {
+      Nbrs.clear();
+      for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+         auto It = GlobToLoc.find(CellsOnCellH(Cell, Edge));
+         if (It != GlobToLoc.end() and It->second >= Start and
+             It->second < End and not Placed[It->second])
+            Nbrs.push_back(It->second);
+      }
+   };
+
+   // Compute the degree of each owned cell in the graph of owned cells
+   std::vector<I4> Nbrs;
+   std::vector<I4> Degree(NCellsOwned);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      findNbrs(Cell, 0, NCellsOwned, Nbrs);
+      Degree[Cell] = Nbrs.size();
+   }
+
+   // Cuthill-McKee ordering of the owned cells. Each connected component is
+   // traversed breadth-first starting from an unplaced cell of minimum
+   // degree, with neighbors visited in order of increasing degree. The
+   // resulting order is then reversed.
+   std::vector<I4> NewToOld;
+   NewToOld.reserve(NCellsSize);
+   size_t Head = 0;
+   while (static_cast<I4>(NewToOld.size()) < NCellsOwned) {
+      I4 Start = -1;
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+         if (not Placed[Cell] and (Start < 0 or Degree[Cell] < Degree[Start]))
+            Start = Cell;
+      }
+      Placed[Start] = true;
+      NewToOld.push_back(Start);
+
+      while (Head < NewToOld.size()) {
+         findNbrs(NewToOld[Head], 0, NCellsOwned, Nbrs);
+         ++Head;
+         std::stable_sort(Nbrs.begin(), Nbrs.end(),
+                          [&](I4 A, I4 B) { return Degree[A] < Degree[B]; });
+         for (I4 Nbr : Nbrs) {
+            if (not Placed[Nbr]) {
+               Placed[Nbr] = true;
+               NewToOld.push_back(Nbr);
+            }
+         }
+      }
+   }
+   std::reverse(NewToOld.begin(), NewToOld.end());
+
+   // Order each halo layer by traversing the previous layer in the new order
+   // and adding its unplaced neighbors in the layer. Any remaining cells in
+   // the layer are added in their current order.
+   I4 PrevStart  = 0;
+   I4 LayerStart = NCellsOwned;
+   for (int Halo = 0; Halo < HaloWidth; ++Halo) {
+      I4 LayerEnd = NCellsHaloH(Halo);
+      I4 PrevEnd  = NewToOld.size();
+      for (int N = PrevStart; N < PrevEnd; ++N) {
+         findNbrs(NewToOld[N], LayerStart, LayerEnd, Nbrs);
+         for (I4 Nbr : Nbrs) {
+            if (not Placed[Nbr]) {
+               Placed[Nbr] = true;
+               NewToOld.push_back(Nbr);
+            }
+         }
+      }
+      for (int Cell = LayerStart; Cell < LayerEnd; ++Cell) {
+         if (not Placed[Cell]) {
+            Placed[Cell] = true;
+            NewToOld.push_back(Cell);
+         }
+      }
+      PrevStart  = PrevEnd;
+      LayerStart = LayerEnd;
+   }
+   NewToOld.push_back(NCellsAll); // boundary/undefined entry is unchanged
+
+   std::vector<I4> OldToNew(NCellsOwned);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      OldToNew[NewToOld[Cell]] = Cell;
+   }
+
+   // Send the current local address of each halo cell to its owner, which
+   // returns the new local address
+   I4 NHalo = NCellsAll - NCellsOwned;
+   std::vector<I4> SendCounts(NumTasks, 0);
+   for (int Cell = NCellsOwned; Cell < NCellsAll; ++Cell) {
+      ++SendCounts[CellLocH(Cell, 0)];
+   }
+   std::vector<I4> TaskStart(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task) {
+      TaskStart[Task] = TaskStart[Task - 1] + SendCounts[Task - 1];
+   }
+   std::vector<I4> SendAdds(NHalo);
+   std::vector<I4> SendPos(NHalo); // location of halo cell in send buffer
+   for (int Cell = NCellsOwned; Cell < NCellsAll; ++Cell) {
+      I4 BufAdd                   = TaskStart[CellLocH(Cell, 0)]++;
+      SendAdds[BufAdd]            = CellLocH(Cell, 1);
+      SendPos[Cell - NCellsOwned] = BufAdd;
+   }
+
+   std::vector<I4> RecvAdds;
+   std::vector<I4> RecvCounts;
+   Err = exchangeLists(SendAdds, SendCounts, RecvAdds, RecvCounts, Comm);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error sending halo cell addresses");
+      return Err;
+   }
+   for (size_t N = 0; N < RecvAdds.size(); ++N) {
+      RecvAdds[N] = OldToNew[RecvAdds[N]];
+   }
+   std::vector<I4> NewAdds;
+   std::vector<I4> NewCounts;
+   Err = exchangeLists(RecvAdds, RecvCounts, NewAdds, NewCounts, Comm);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error returning halo cell addresses");
+      return Err;
+   }
+
+   // Permute the cell arrays into the new order
+   HostArray1DI4 CellIDTmp("CellID", NCellsSize);
+   HostArray2DI4 CellLocTmp("CellLoc", NCellsSize, 2);
+   HostArray2DI4 CellsOnCellTmp("CellsOnCell", NCellsSize, MaxEdges);
+   HostArray2DI4 EdgesOnCellTmp("EdgesOnCell", NCellsSize, MaxEdges);
+   HostArray2DI4 VerticesOnCellTmp("VerticesOnCell", NCellsSize, MaxEdges);
+   HostArray1DI4 NEdgesOnCellTmp("NEdgesOnCell", NCellsSize);
+   for (int Cell = 0; Cell < NCellsSize; ++Cell) {
+      I4 OldCell            = NewToOld[Cell];
+      CellIDTmp(Cell)       = CellIDH(OldCell);
+      NEdgesOnCellTmp(Cell) = NEdgesOnCellH(OldCell);
+      CellLocTmp(Cell, 0)   = CellLocH(OldCell, 0);
+      CellLocTmp(Cell, 1)   = CellLocH(OldCell, 1);
+      if (Cell < NCellsOwned) {
+         CellLocTmp(Cell, 1) = Cell;
+      } else if (Cell < NCellsAll) {
+         CellLocTmp(Cell, 1) = NewAdds[SendPos[OldCell - NCellsOwned]];
+      }
+      for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+         CellsOnCellTmp(Cell, Edge)    = CellsOnCellH(OldCell, Edge);
+         EdgesOnCellTmp(Cell, Edge)    = EdgesOnCellH(OldCell, Edge);
+         VerticesOnCellTmp(Cell, Edge) = VerticesOnCellH(OldCell, Edge);
+      }
+   }
+
+   CellIDH         = CellIDTmp;
+   CellLocH        = CellLocTmp;
+   CellsOnCellH    = CellsOnCellTmp;
+   EdgesOnCellH    = EdgesOnCellTmp;
+   VerticesOnCellH = VerticesOnCellTmp;
+   NEdgesOnCellH   = NEdgesOnCellTmp;
+
+   return Err;
+
+} // end function reorderCells
+
 //------------------------------------------------------------------------------
 // Redistribute the various XxOnEdge index arrays to the final edge
 // decomposition. The inputs are the various XxOnEdge arrays in the
@@ -1911,10 +3673,21 @@ PartMethod getPartMethodFromStr(const std::string &InMethod) {
                   [](unsigned char c) { return std::tolower(c); });
 
    // Check supported methods and return appropriate enum
-   // Currently, only the METIS/ParMETIS KWay option is supported
    if (MethodComp == "metiskway") {
       return PartMethodMetisKWay;
 
+   } else if (MethodComp == "metisrb") {
+      return PartMethodMetisRB;
+
+   } else if (MethodComp == "parmetiskway") {
+      return PartMethodParMetisKWay;
+
+   } else if (MethodComp == "sfchilbert") {
+      return PartMethodSFCHilbert;
+
+   } else if (MethodComp == "sfcmorton") {
+      return PartMethodSFCMorton;
+
    } else {
       return PartMethodUnknown;
 
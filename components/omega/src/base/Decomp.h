@@ -26,6 +26,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace OMEGA {
 
@@ -35,9 +36,12 @@ namespace OMEGA {
 
 /// Supported partitioning methods
 enum PartMethod {
-   PartMethodUnknown,   ///< Unknown or undefined method
-   PartMethodMetisKWay, ///< Metis K-way partitioning (default)
-   PartMethodMetisRB    ///< Metis recursive bisection (not yet supported)
+   PartMethodUnknown,      ///< Unknown or undefined method
+   PartMethodMetisKWay,    ///< Metis K-way partitioning (default)
+   PartMethodMetisRB,      ///< Metis recursive bisection
+   PartMethodParMetisKWay, ///< distributed ParMetis K-way partitioning
+   PartMethodSFCHilbert,   ///< Hilbert space-filling curve partitioning
+   PartMethodSFCMorton     ///< Morton space-filling curve partitioning
 };
 
 /// Translates an input string for partition method option to the
@@ -46,6 +50,17 @@ PartMethod getPartMethodFromStr(
     const std::string &InMethod ///< [in] choice of partition method
 );
 
+/// Options to weight the partition by the work of each cell. The work of a
+/// cell is modeled as a fixed cost plus a cost per active vertical level,
+/// with the active levels computed from the bottom depth in the mesh file as
+/// in HorzMesh. Without a cost file, only the per-level cost is used.
+struct PartWeights {
+   bool ByLevels  = false; ///< weight cells by their work
+   bool Edges     = false; ///< weight edges by the levels exchanged across
+   I4 NVertLevels = 1;     ///< number of vertical levels in the mesh
+   std::string CostFile;   ///< file with the measured cell and level costs
+};
+
 /// The Decomp class creates and maintains most of the information related
 /// to the mesh index space and its distribution across partitions or processors
 /// in a parallel domain decomposition. This information includes the location
@@ -64,23 +79,99 @@ class Decomp {
    /// map paired with a name for later retrieval.
    static std::map<std::string, std::unique_ptr<Decomp>> AllDecomps;
 
-   /// Partition cells by calling the METIS/ParMETIS KWay routine
+   /// Partition cells by calling the METIS KWay or recursive bisection
+   /// routine, depending on the input method.
    /// It starts with the CellsOnCell array from the input mesh file
    /// distributed across tasks in linear contiguous chunks
    /// On output, it has defined all the NCells sizes (NCellsOwned,
    /// NCellsHalo array, NCellsAll and NCellsSize) and the final CellID
-   /// and CellLoc arrays
-   int partCellsKWay(
+   /// and CellLoc arrays. If the task of each cell is supplied from a
+   /// precomputed partition, METIS is not called and only the halo is built.
+   /// Weighted partitions pass the work of each cell and the levels
+   /// exchanged across each edge to METIS.
+   int partCellsMetis(
+       const MachEnv *InEnv,                   ///< [in] MachEnv with MPI info
+       const std::vector<I4> &CellsOnCellInit, ///< [in] cell nbrs in init dstrb
+       PartMethod Method,                      ///< [in] METIS method to use
+       const std::vector<I4> *CellTaskIn = nullptr ///< [in] task for each cell
+   );
+
+   /// Partition cells along a Hilbert or Morton space-filling curve through
+   /// the cell centers. The cells are sorted by their position along the
+   /// curve and divided into NumTasks contiguous segments of nearly equal
+   /// size, or nearly equal weight for weighted partitions. No METIS call
+   /// is needed and the halos are then built as in
+   /// partCellsMetis. The cell center coordinates are input in the same
+   /// linear distribution as the CellsOnCell array.
+   int partCellsSFC(
+       const MachEnv *InEnv,                   ///< [in] MachEnv with MPI info
+       const std::vector<I4> &CellsOnCellInit, ///< [in] cell nbrs in init dstrb
+       PartMethod Method,                      ///< [in] SFC method to use
+       const std::vector<R8> &XCellInit,       ///< [in] x coord of cell center
+       const std::vector<R8> &YCellInit,       ///< [in] y coord of cell center
+       const std::vector<R8> &ZCellInit        ///< [in] z coord of cell center
+   );
+
+   /// Partition cells by calling the distributed ParMETIS KWay routine
+   /// directly on the CellsOnCell array in its initial linear distribution.
+   /// Unlike partCellsMetis, no task stores the global adjacency graph or
+   /// any other global-sized array: cell locations and neighbors are
+   /// retrieved from the task holding each cell in the linear distribution
+   /// when building the halo. The outputs are the same as partCellsMetis.
+   int partCellsParMetis(
+       const MachEnv *InEnv,                  ///< [in] MachEnv with MPI info
+       const std::vector<I4> &CellsOnCellInit ///< [in] cell nbrs in init dstrb
+   );
+
+   /// Reads a precomputed cell partition from the partition file, either
+   /// an MPAS-style graph.info.part.N text file with the task of each cell
+   /// or an Omega NetCDF partition file (*.nc) written by writePartition.
+   /// If the NetCDF file also contains halo lists for the same halo width,
+   /// they are used directly and the halo setup is skipped. On output, it
+   /// has defined the same NCells sizes and cell arrays as partCellsMetis.
+   int readPartition(
        const MachEnv *InEnv,                  ///< [in] MachEnv with MPI info
        const std::vector<I4> &CellsOnCellInit ///< [in] cell nbrs in init dstrb
    );
 
+   /// Writes the cell partition to the partition file in the format implied
+   /// by the file name. NetCDF partition files also contain the halo lists
+   /// of each task.
+   int writePartition(const MachEnv *InEnv ///< [in] MachEnv with MPI info
+   ) const;
+
+   /// Returns the partition weight of a cell with the input number of
+   /// active levels from the cell and level costs, scaled so that a cell
+   /// with all levels active has a weight of WeightScale
+   I4 cellWeight(I4 NLevels ///< [in] number of active levels of the cell
+   ) const;
+
+   /// Reads the cell and level costs from the cost file if it exists,
+   /// setting CostFileRead to true
+   int readCost(const MachEnv *InEnv ///< [in] MachEnv with MPI info
+   );
+
+   /// Sums the active levels of the owned cells into NLevelsOwned from the
+   /// active levels of the cells in the initial linear distribution
+   int sumOwnedLevels(
+       const MachEnv *InEnv,              ///< [in] MachEnv with MPI info
+       const std::vector<I4> &LevelsInit ///< [in] active levels of cells
+   );
+
    /// Trivially partition cells in the case of single task
    /// It sets the NCells sizes (NCellsOwned,
    /// NCellsHalo array, NCellsAll and NCellsSize) and the final CellID
    /// and CellLoc arrays
    void partCellsSingleTask();
 
+   /// Reorders the owned cells with the reverse Cuthill-McKee algorithm and
+   /// each halo layer by a breadth-first traversal from the previous layer
+   /// to improve the cache locality of indirect accesses. The cell ID,
+   /// location and XxOnCell arrays are permuted and the locations of halo
+   /// cells are updated to the new addresses on their owning tasks.
+   int reorderCells(const MachEnv *InEnv ///< [in] MachEnv with MPI info
+   );
+
    /// Partition the edges given the cell partition and edge connectivity
    /// The first cell ID associated with an edge in the CellsOnEdge array
    /// is assumed to own the edge. The inputs are the edge-cell connectivity
@@ -144,9 +235,28 @@ class Decomp {
           I4 NParts,               ///< [in] num of partitions for new decomp
           PartMethod Method,       ///< [in] method for partitioning
           I4 InHaloWidth,          ///< [in] width of halo in new decomp
-          const std::string &MeshFileName_ ///< [in] name of file with mesh info
+          const std::string &MeshFileName_, ///< [in] name of file with mesh
+          const std::string &PartFileName_, ///< [in] name of partition file
+          bool InReorderLocal,              ///< [in] reorder local cells
+          const PartWeights &InWeights      ///< [in] partition weights
    );
 
+   /// Weight of a cell with all levels active
+   static constexpr I4 WeightScale = 1000;
+
+   /// Partition weight options
+   PartWeights Weights;
+
+   /// Active levels of the cells in the initial linear distribution, only
+   /// stored while partitioning a weighted decomposition
+   std::vector<I4> CellLevelsInit;
+
+   /// Cost of a cell and of each of its active levels, in seconds of the
+   /// measured run when read from the cost file
+   R8 CellCost{0};
+   R8 LevelCost{1};
+   bool CostFileRead{false}; ///< true if the costs were read from CostFile
+
    // forbid copy and move construction
    Decomp(const Decomp &) = delete;
    Decomp(Decomp &&)      = delete;
@@ -157,6 +267,9 @@ class Decomp {
    // number of retrievals required.
 
    std::string MeshFileName; ///< The name of the file with mesh info
+   std::string PartFileName; ///< The name of the partition file (optional)
+   bool ReorderLocal;        ///< Local cells reordered for cache locality
+   I8 NLevelsOwned{0}; ///< Active levels of owned cells, 0 if not computed
 
    // Sizes and global IDs
    // Note that all sizes are actual counts (1-based) so that loop extents
@@ -250,9 +363,23 @@ class Decomp {
           I4 NParts,               ///< [in] num of partitions for new decomp
           PartMethod Method,       ///< [in] method for partitioning
           I4 HaloWidth,            ///< [in] width of halo in new decomp
-          const std::string &MeshFileName ///< [in] name of file with mesh info
+          const std::string &MeshFileName, ///< [in] name of file with mesh
+          const std::string &PartFileName = "", ///< [in] name of partition file
+          bool ReorderLocal               = false, ///< [in] reorder local cells
+          const PartWeights &Weights = PartWeights() ///< [in] partition weights
    );
 
+   /// Fits the cell and level costs to the input time of the work of every
+   /// task in the time steps, excluding the halo exchanges, and writes them
+   /// to the cost file from the master task. The next decomposition created
+   /// with the same cost file is weighted by the measured costs.
+   int writeCost(const MachEnv *InEnv, ///< [in] MachEnv with MPI info
+                 R8 WorkTime           ///< [in] local time of the work
+   ) const;
+
+   /// Returns the name of the cost file, empty if not used
+   const std::string &getCostFile() const { return Weights.CostFile; }
+
    /// Destructor - deallocates all memory and deletes a Decomp.
    ~Decomp();
 
@@ -8,15 +8,18 @@
 // functions are defined here. The Halo class public member function
 // exchangeFullArrayHalo which is called by the user to perform halo
 // exchanges on a given array is a template function and thus is defined
-// in the associated header file, Halo.h.
+// in the associated header file, Halo.h, along with the device buffer
+// pack and unpack functions.
 //
 //===----------------------------------------------------------------------===//
 
 #include "Halo.h"
+#include "Config.h"
 #include "mpi.h"
 #include <algorithm>
 #include <iterator>
 #include <numeric>
+#include <utility>
 
 namespace OMEGA {
 
@@ -53,9 +56,10 @@ Halo::ExchList::ExchList(
    // First dimension of List is the number of halo layers
    I4 HaloLayers = List.size();
 
-   // Set member vector sizes to number of halo layers
+   // Set member vector sizes to number of halo layers, Offsets has an extra
+   // entry so that Offsets[N] is the number of elements in the first N layers
    NList.resize(HaloLayers);
-   Offsets.resize(HaloLayers);
+   Offsets.resize(HaloLayers + 1);
 
    // Copy List into member 2D vector Ind which holds the indices
    Ind = List;
@@ -70,10 +74,20 @@ Halo::ExchList::ExchList(
 
    // Set the index offsets for each halo layer
    Offsets[0] = 0;
-   for (int I = 0; I < HaloLayers - 1; ++I) {
+   for (int I = 0; I < HaloLayers; ++I) {
       Offsets[I + 1] = Offsets[I] + NList[I];
    }
 
+   // Flatten the index lists for all halo layers into a single array and
+   // copy it to the device for packing and unpacking device arrays
+   HostArray1DI4 IndHost("HaloExchListInd", NTot);
+   for (int I = 0; I < HaloLayers; ++I) {
+      for (int J = 0; J < NList[I]; ++J) {
+         IndHost(Offsets[I] + J) = List[I][J];
+      }
+   }
+   IndDevice = createDeviceMirrorCopy(IndHost);
+
 } // end ExchList constructor
 
 // Empty constructor for ExchList class
@@ -109,7 +123,9 @@ Halo::Neighbor::Neighbor(
 
 //------------------------------------------------------------------------------
 // Initialize and construct the default Halo. MachEnv and Decomp must already
-// be initialized
+// be initialized. The optional Halo config group selects whether device
+// arrays are exchanged directly from device buffers and whether persistent
+// MPI requests are used.
 
 int Halo::init() {
 
@@ -120,6 +136,50 @@ int Halo::init() {
 
    Halo::DefaultHalo = create("Default", DefEnv, DefDecomp);
 
+   // Retrieve options from Config if available, otherwise device arrays are
+   // exchanged through host copies
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("Halo")) {
+      Config HaloConfig("Halo");
+      IErr = OmegaConfig->get(HaloConfig);
+      if (IErr != 0) {
+         LOG_ERROR("Halo: error retrieving Halo group from Config");
+         return IErr;
+      }
+      if (HaloConfig.existsVar("DeviceExchange")) {
+         bool InDeviceExchange{false};
+         IErr = HaloConfig.get("DeviceExchange", InDeviceExchange);
+         if (IErr != 0) {
+            LOG_ERROR("Halo: error reading DeviceExchange from Halo Config");
+            return IErr;
+         }
+         DefaultHalo->setDeviceExchange(InDeviceExchange);
+      }
+      if (HaloConfig.existsVar("PersistentComm")) {
+         bool InPersistentComm{false};
+         IErr = HaloConfig.get("PersistentComm", InPersistentComm);
+         if (IErr != 0) {
+            LOG_ERROR("Halo: error reading PersistentComm from Halo Config");
+            return IErr;
+         }
+         DefaultHalo->setPersistentComm(InPersistentComm);
+      }
+      if (HaloConfig.existsVar("NeighborCollective")) {
+         bool InNeighborCollective{false};
+         IErr = HaloConfig.get("NeighborCollective", InNeighborCollective);
+         if (IErr != 0) {
+            LOG_ERROR(
+                "Halo: error reading NeighborCollective from Halo Config");
+            return IErr;
+         }
+         IErr = DefaultHalo->setNeighborCollective(InNeighborCollective);
+         if (IErr != 0) {
+            LOG_ERROR("Halo: error enabling neighborhood collective");
+            return IErr;
+         }
+      }
+   }
+
    return IErr;
 
 } // End Halo init
@@ -208,7 +268,16 @@ Halo *Halo::create(const std::string &Name, const MachEnv *Env,
 
 Halo::~Halo() {
 
-   // No operations necessary
+   // Free any cached persistent requests and the neighborhood graph
+   // communicator, buffers are removed when no longer in scope
+   freePersistentComms();
+
+   if (GraphComm != MPI_COMM_NULL) {
+      int Finalized{0};
+      MPI_Finalized(&Finalized);
+      if (not Finalized)
+         MPI_Comm_free(&GraphComm);
+   }
 
 } // end destructor
 
@@ -259,6 +328,480 @@ Halo *Halo::get(const std::string Name // name of Halo to retrieve
    }
 } // end Halo get
 
+//------------------------------------------------------------------------------
+// Query and set whether device arrays are exchanged directly from device
+// buffers
+
+bool Halo::isDeviceExchange() const { return UseDeviceExchange; }
+
+void Halo::setDeviceExchange(const bool InDeviceExchange // [in] new setting
+) {
+   UseDeviceExchange = InDeviceExchange;
+}
+
+//------------------------------------------------------------------------------
+// Query and set whether persistent MPI requests are used for exchanges
+
+bool Halo::isPersistentComm() const { return UsePersistentComm; }
+
+void Halo::setPersistentComm(const bool InPersistentComm // [in] new setting
+) {
+   UsePersistentComm = InPersistentComm;
+   if (not UsePersistentComm) {
+      freePersistentComms();
+   }
+}
+
+//------------------------------------------------------------------------------
+// Query and set whether exchanges use the neighborhood collective backend.
+// The distributed graph communicator is created the first time the backend is
+// selected. Every task lists its neighboring tasks as both sources and
+// destinations, since the halo relationship is symmetric (a task that sends
+// to a neighbor also receives from it). For a particular index space, a
+// neighbor may have nothing to send or receive, in which case a zero count
+// is used.
+
+bool Halo::isNeighborCollective() const { return UseNeighborCollective; }
+
+int Halo::setNeighborCollective(
+    const bool InNeighborCollective // [in] new setting
+) {
+
+   if (InNeighborCollective and GraphComm == MPI_COMM_NULL) {
+      I4 Err = MPI_Dist_graph_create_adjacent(
+          MyComm, NNghbr, NeighborList.data(), MPI_UNWEIGHTED, NNghbr,
+          NeighborList.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &GraphComm);
+      if (Err != MPI_SUCCESS) {
+         LOG_ERROR("MPI error {} on task {} creating neighborhood graph "
+                   "communicator",
+                   Err, MyTask);
+         GraphComm             = MPI_COMM_NULL;
+         UseNeighborCollective = false;
+         return -1;
+      }
+   }
+
+   UseNeighborCollective = InNeighborCollective;
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Save the index space of the current exchange and set the number of halo
+// layers to exchange. For cell-based quantities, the number of halo layers
+// equals HaloWidth, edge- and vertex-based quantities have an extra layer.
+// If a HaloDepth between 1 and HaloWidth is requested, only HaloDepth cell
+// layers (HaloDepth + 1 edge or vertex layers) are exchanged.
+
+void Halo::setExchangeElem(const MeshElement ThisElem, // [in] index space
+                           const I4 HaloDepth // [in] cell halo layers, 0 all
+) {
+   I4 CellLayers = HaloWidth;
+   if (HaloDepth > 0 and HaloDepth < HaloWidth) {
+      CellLayers = HaloDepth;
+   }
+
+   MyElem = ThisElem;
+   if (MyElem == OnCell) {
+      NumLayers = CellLayers;
+   } else {
+      NumLayers = CellLayers + 1;
+   }
+} // end setExchangeElem
+
+//------------------------------------------------------------------------------
+// Perform a halo exchange of all arrays in a HaloGroup. For each neighboring
+// task, the halo elements of every array in the group are packed one after
+// another into a single buffer using the packBuffer functions, so only one
+// message is sent to and received from each neighbor regardless of the
+// number of arrays in the group. Device arrays are copied to their host
+// copies before packing and back to the device after unpacking.
+
+int Halo::exchangeGroupHalo(HaloGroup &Group,  // [inout] group of arrays
+                            const I4 HaloDepth // [in] cell halo layers
+) {
+
+   I4 IErr{0}; // error code
+
+   I4 NFields = Group.Fields.size();
+   if (NFields == 0)
+      return IErr;
+
+   TimerRegion HaloTimer("Halo");
+
+   // Tag for group messages, distinct from the index space tags of single
+   // array exchanges
+   const I4 GroupTag = 3;
+
+   OnDevice = false;
+   for (auto &Field : Group.Fields) {
+      if (Field.CopyToHost)
+         Field.CopyToHost();
+   }
+
+   // Determine the total message size to and from each neighbor
+   std::vector<I4> SendSize(NNghbr, 0);
+   std::vector<I4> RecvSize(NNghbr, 0);
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      for (auto &Field : Group.Fields) {
+         setExchangeElem(Field.Elem, HaloDepth);
+         SendSize[INghbr] +=
+             Field.TotSize *
+             Neighbors[INghbr].SendLists[Field.Elem].Offsets[NumLayers];
+         RecvSize[INghbr] +=
+             Field.TotSize *
+             Neighbors[INghbr].RecvLists[Field.Elem].Offsets[NumLayers];
+      }
+   }
+
+   std::vector<MPI_Request> RReqs(NNghbr, MPI_REQUEST_NULL);
+   std::vector<MPI_Request> SReqs(NNghbr, MPI_REQUEST_NULL);
+
+   // Post receives for each neighbor with elements to receive
+   I4 NMessages{0};
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      if (RecvSize[INghbr] > 0) {
+         MyNeighbor = &Neighbors[INghbr];
+         MyNeighbor->GroupRecvBuffer.resize(RecvSize[INghbr]);
+         I4 Err = MPI_Irecv(&MyNeighbor->GroupRecvBuffer[0], RecvSize[INghbr],
+                            MPI_RealKind, MyNeighbor->TaskID, GroupTag, MyComm,
+                            &RReqs[INghbr]);
+         if (Err != 0) {
+            LOG_ERROR("MPI error {} on task {} receive from task {}", Err,
+                      MyTask, MyNeighbor->TaskID);
+            IErr = -1;
+         }
+         ++NMessages;
+      }
+   }
+
+   // Pack the arrays for each neighbor into one buffer and send it
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      if (SendSize[INghbr] > 0) {
+         MyNeighbor = &Neighbors[INghbr];
+         MyNeighbor->GroupSendBuffer.resize(SendSize[INghbr]);
+         I4 Pos{0};
+         for (auto &Field : Group.Fields) {
+            setExchangeElem(Field.Elem, HaloDepth);
+            I4 NSend = Field.TotSize *
+                       MyNeighbor->SendLists[Field.Elem].Offsets[NumLayers];
+            if (NSend > 0) {
+               TotSize = Field.TotSize;
+               Field.Pack(this);
+               std::copy(MyNeighbor->SendBuffer.begin(),
+                         MyNeighbor->SendBuffer.begin() + NSend,
+                         MyNeighbor->GroupSendBuffer.begin() + Pos);
+               Pos += NSend;
+            }
+         }
+         I4 Err = MPI_Isend(&MyNeighbor->GroupSendBuffer[0], SendSize[INghbr],
+                            MPI_RealKind, MyNeighbor->TaskID, GroupTag, MyComm,
+                            &SReqs[INghbr]);
+         if (Err != 0) {
+            LOG_ERROR("MPI error {} on task {} send to task {}", Err, MyTask,
+                      MyNeighbor->TaskID);
+            IErr = -1;
+         }
+      }
+   }
+
+   // Unpack each message as it arrives
+   for (int IMsg = 0; IMsg < NMessages; ++IMsg) {
+      int INghbr;
+      MPI_Waitany(NNghbr, RReqs.data(), &INghbr, MPI_STATUS_IGNORE);
+      if (INghbr == MPI_UNDEFINED)
+         break;
+      MyNeighbor = &Neighbors[INghbr];
+      I4 Pos{0};
+      for (auto &Field : Group.Fields) {
+         setExchangeElem(Field.Elem, HaloDepth);
+         I4 NRecv = Field.TotSize *
+                    MyNeighbor->RecvLists[Field.Elem].Offsets[NumLayers];
+         if (NRecv > 0) {
+            TotSize = Field.TotSize;
+            MyNeighbor->RecvBuffer.assign(
+                MyNeighbor->GroupRecvBuffer.begin() + Pos,
+                MyNeighbor->GroupRecvBuffer.begin() + Pos + NRecv);
+            Field.Unpack(this);
+            Pos += NRecv;
+         }
+      }
+   }
+
+   // Wait for all sends to complete before the send buffers can be reused
+   MPI_Waitall(NNghbr, SReqs.data(), MPI_STATUSES_IGNORE);
+
+   for (auto &Field : Group.Fields) {
+      if (Field.CopyToDevice)
+         Field.CopyToDevice();
+   }
+
+   return IErr;
+
+} // end exchangeGroupHalo
+
+//------------------------------------------------------------------------------
+// Swap the buffers and MPI request handles of each Neighbor with those stored
+// in a CommBuffers object. Called when a split-phase exchange is started to set
+// aside its communication state, and again when it is finished to restore it,
+// as well as to swap cached persistent buffers in and out of the Neighbors.
+// Swapping vectors and views exchanges their ownership without moving the
+// buffer memory, so persistent requests remain valid.
+
+void Halo::swapCommBuffers(CommBuffers &Buffers // [inout] buffers to swap
+) {
+
+   Buffers.SendBuffers.resize(NNghbr);
+   Buffers.RecvBuffers.resize(NNghbr);
+   Buffers.SendBuffersDevice.resize(NNghbr);
+   Buffers.RecvBuffersDevice.resize(NNghbr);
+   Buffers.SReqs.resize(NNghbr, MPI_REQUEST_NULL);
+   Buffers.RReqs.resize(NNghbr, MPI_REQUEST_NULL);
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      Neighbor &ThisNghbr = Neighbors[INghbr];
+      std::swap(ThisNghbr.SendBuffer, Buffers.SendBuffers[INghbr]);
+      std::swap(ThisNghbr.RecvBuffer, Buffers.RecvBuffers[INghbr]);
+      std::swap(ThisNghbr.SendBufferDevice, Buffers.SendBuffersDevice[INghbr]);
+      std::swap(ThisNghbr.RecvBufferDevice, Buffers.RecvBuffersDevice[INghbr]);
+      std::swap(ThisNghbr.SReq, Buffers.SReqs[INghbr]);
+      std::swap(ThisNghbr.RReq, Buffers.RReqs[INghbr]);
+   }
+
+   std::swap(CollSendBuffer, Buffers.CollSendBuffer);
+   std::swap(CollRecvBuffer, Buffers.CollRecvBuffer);
+   std::swap(CollSendCounts, Buffers.CollSendCounts);
+   std::swap(CollSendDispls, Buffers.CollSendDispls);
+   std::swap(CollRecvCounts, Buffers.CollRecvCounts);
+   std::swap(CollRecvDispls, Buffers.CollRecvDispls);
+   std::swap(CollReq, Buffers.CollReq);
+
+} // end swapCommBuffers
+
+//------------------------------------------------------------------------------
+// Start the persistent receives for the current exchange. The first time an
+// exchange signature (index space, NumLayers, TotSize, OnDevice) is seen,
+// buffers of the exact message size are allocated for each Neighbor and
+// persistent requests are created for them with MPI_Recv_init and
+// MPI_Send_init. The cached buffers are then swapped into the Neighbor
+// objects, so the pack and unpack functions operate on them without
+// reallocating, and the receives are started with MPI_Start.
+
+int Halo::startPersistentReceives() {
+
+   I4 IErr{0}; // error code
+
+   // Find the cached buffers for this signature or create a new entry
+   auto Key = std::make_tuple(static_cast<I4>(MyElem), NumLayers, TotSize,
+                              OnDevice);
+
+   auto [Iter, New]     = PersistentComms.try_emplace(Key);
+   CommBuffers &Buffers = Iter->second;
+
+   if (New) {
+      Buffers.SendBuffers.resize(NNghbr);
+      Buffers.RecvBuffers.resize(NNghbr);
+      Buffers.SendBuffersDevice.resize(NNghbr);
+      Buffers.RecvBuffersDevice.resize(NNghbr);
+      Buffers.SReqs.resize(NNghbr, MPI_REQUEST_NULL);
+      Buffers.RReqs.resize(NNghbr, MPI_REQUEST_NULL);
+
+      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+         Neighbor &ThisNghbr = Neighbors[INghbr];
+         I4 Err{0};
+
+         if (RecvFlags[MyElem][INghbr]) {
+            I4 BufferSize =
+                TotSize * ThisNghbr.RecvLists[MyElem].Offsets[NumLayers];
+            Real *RecvPtr;
+            if (OnDevice) {
+               MemoryRegion HaloMemory("Halo");
+               Buffers.RecvBuffersDevice[INghbr] =
+                   Array1DReal("HaloRecvBuffer", BufferSize);
+               RecvPtr = Buffers.RecvBuffersDevice[INghbr].data();
+            } else {
+               Buffers.RecvBuffers[INghbr].resize(BufferSize);
+               RecvPtr = &Buffers.RecvBuffers[INghbr][0];
+            }
+            Err = MPI_Recv_init(RecvPtr, BufferSize, MPI_RealKind,
+                                ThisNghbr.TaskID, MyElem, MyComm,
+                                &Buffers.RReqs[INghbr]);
+         }
+
+         if (SendFlags[MyElem][INghbr]) {
+            I4 BufferSize =
+                TotSize * ThisNghbr.SendLists[MyElem].Offsets[NumLayers];
+            Real *SendPtr;
+            if (OnDevice) {
+               MemoryRegion HaloMemory("Halo");
+               Buffers.SendBuffersDevice[INghbr] =
+                   Array1DReal("HaloSendBuffer", BufferSize);
+               SendPtr = Buffers.SendBuffersDevice[INghbr].data();
+            } else {
+               Buffers.SendBuffers[INghbr].resize(BufferSize);
+               SendPtr = &Buffers.SendBuffers[INghbr][0];
+            }
+            Err += MPI_Send_init(SendPtr, BufferSize, MPI_RealKind,
+                                 ThisNghbr.TaskID, MyElem, MyComm,
+                                 &Buffers.SReqs[INghbr]);
+         }
+
+         if (Err != 0) {
+            LOG_ERROR("MPI error {} on task {} creating persistent requests "
+                      "with task {}",
+                      Err, MyTask, ThisNghbr.TaskID);
+            IErr = -1;
+         }
+      }
+   }
+
+   // Swap the cached buffers and requests into the Neighbor objects
+   swapCommBuffers(Buffers);
+   CurPersistent = &Buffers;
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      if (RecvFlags[MyElem][INghbr]) {
+         I4 Err = MPI_Start(&Neighbors[INghbr].RReq);
+         if (Err != 0) {
+            LOG_ERROR("MPI error {} on task {} receive from task {}", Err,
+                      MyTask, Neighbors[INghbr].TaskID);
+            IErr = -1;
+         }
+      }
+   }
+
+   return IErr;
+
+} // end startPersistentReceives
+
+//------------------------------------------------------------------------------
+// Start the persistent sends of the packed buffers for the current exchange
+
+int Halo::startPersistentSends() {
+
+   I4 IErr{0}; // error code
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      if (SendFlags[MyElem][INghbr]) {
+         I4 Err = MPI_Start(&Neighbors[INghbr].SReq);
+         if (Err != 0) {
+            LOG_ERROR("MPI error {} on task {} send to task {}", Err, MyTask,
+                      Neighbors[INghbr].TaskID);
+            IErr = -1;
+         }
+      }
+   }
+
+   return IErr;
+
+} // end startPersistentSends
+
+//------------------------------------------------------------------------------
+// Free all cached persistent requests and their buffers. Requests can only be
+// freed while MPI is still active.
+
+void Halo::freePersistentComms() {
+
+   int Finalized{0};
+   MPI_Finalized(&Finalized);
+
+   if (not Finalized) {
+      for (auto &[Key, Buffers] : PersistentComms) {
+         for (auto &Req : Buffers.SReqs) {
+            if (Req != MPI_REQUEST_NULL)
+               MPI_Request_free(&Req);
+         }
+         for (auto &Req : Buffers.RReqs) {
+            if (Req != MPI_REQUEST_NULL)
+               MPI_Request_free(&Req);
+         }
+      }
+   }
+
+   PersistentComms.clear();
+
+} // end freePersistentComms
+
+//------------------------------------------------------------------------------
+// Start a neighborhood collective exchange. The send buffers packed for each
+// Neighbor are copied into one contiguous buffer, ordered as NeighborList, and
+// the exchange of all messages is started with a single
+// MPI_Ineighbor_alltoallv on the graph communicator.
+
+int Halo::startNeighborCollective() {
+
+   CollSendCounts.assign(NNghbr, 0);
+   CollSendDispls.assign(NNghbr, 0);
+   CollRecvCounts.assign(NNghbr, 0);
+   CollRecvDispls.assign(NNghbr, 0);
+
+   int SendTot{0};
+   int RecvTot{0};
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      Neighbor &ThisNghbr = Neighbors[INghbr];
+      if (SendFlags[MyElem][INghbr])
+         CollSendCounts[INghbr] =
+             TotSize * ThisNghbr.SendLists[MyElem].Offsets[NumLayers];
+      if (RecvFlags[MyElem][INghbr])
+         CollRecvCounts[INghbr] =
+             TotSize * ThisNghbr.RecvLists[MyElem].Offsets[NumLayers];
+      CollSendDispls[INghbr] = SendTot;
+      CollRecvDispls[INghbr] = RecvTot;
+      SendTot += CollSendCounts[INghbr];
+      RecvTot += CollRecvCounts[INghbr];
+   }
+
+   // Keep at least one element so data() is valid on tasks with no messages
+   CollSendBuffer.resize(std::max(SendTot, 1));
+   CollRecvBuffer.resize(std::max(RecvTot, 1));
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      if (CollSendCounts[INghbr] > 0) {
+         const std::vector<Real> &Buff = Neighbors[INghbr].SendBuffer;
+         std::copy(Buff.begin(), Buff.begin() + CollSendCounts[INghbr],
+                   CollSendBuffer.begin() + CollSendDispls[INghbr]);
+      }
+   }
+
+   I4 Err = MPI_Ineighbor_alltoallv(
+       CollSendBuffer.data(), CollSendCounts.data(), CollSendDispls.data(),
+       MPI_RealKind, CollRecvBuffer.data(), CollRecvCounts.data(),
+       CollRecvDispls.data(), MPI_RealKind, GraphComm, &CollReq);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("MPI error {} on task {} starting neighborhood collective",
+                Err, MyTask);
+      return -1;
+   }
+
+   return 0;
+
+} // end startNeighborCollective
+
+//------------------------------------------------------------------------------
+// Complete a neighborhood collective exchange and copy each received block
+// into the receive buffer of the corresponding Neighbor for unpacking
+
+int Halo::finishNeighborCollective() {
+
+   I4 Err = MPI_Wait(&CollReq, MPI_STATUS_IGNORE);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("MPI error {} on task {} completing neighborhood collective",
+                Err, MyTask);
+      return -1;
+   }
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      if (CollRecvCounts[INghbr] > 0) {
+         auto Start = CollRecvBuffer.begin() + CollRecvDispls[INghbr];
+         Neighbors[INghbr].RecvBuffer.assign(Start,
+                                             Start + CollRecvCounts[INghbr]);
+      }
+   }
+
+   return 0;
+
+} // end finishNeighborCollective
+
 //------------------------------------------------------------------------------
 // Sets Halo class members NeighborList, NNghbr, SendFlags, and RecvFlags during
 // Halo construction
@@ -632,7 +1175,10 @@ int Halo::exchangeVectorInt(
 
 //------------------------------------------------------------------------------
 // Allocate RecvBuffer and prepare for MPI communication by calling MPI_Irecv
-// for each Neighbor
+// for each Neighbor. If the current exchange is on the device, the device
+// receive buffer is allocated (if not already large enough) and passed to MPI.
+// Messages are tagged with the index space so that exchanges in different
+// index spaces can be in flight at the same time.
 
 int Halo::startReceives() {
 
@@ -644,11 +1190,23 @@ int Halo::startReceives() {
    for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
       if (RecvFlags[MyElem][INghbr]) {
          MyNeighbor    = &Neighbors[INghbr];
-         I4 BufferSize = TotSize * MyNeighbor->RecvLists[MyElem].NTot;
-         MyNeighbor->RecvBuffer.resize(BufferSize);
-         IErr[INghbr] = MPI_Irecv(&MyNeighbor->RecvBuffer[0], BufferSize,
-                                  MPI_RealKind, MyNeighbor->TaskID, MPI_ANY_TAG,
-                                  MyComm, &MyNeighbor->RReq);
+         I4 BufferSize =
+             TotSize * MyNeighbor->RecvLists[MyElem].Offsets[NumLayers];
+         Real *RecvPtr;
+         if (OnDevice) {
+            if (MyNeighbor->RecvBufferDevice.extent_int(0) < BufferSize) {
+               MemoryRegion HaloMemory("Halo");
+               MyNeighbor->RecvBufferDevice =
+                   Array1DReal("HaloRecvBuffer", BufferSize);
+            }
+            RecvPtr = MyNeighbor->RecvBufferDevice.data();
+         } else {
+            MyNeighbor->RecvBuffer.resize(BufferSize);
+            RecvPtr = &MyNeighbor->RecvBuffer[0];
+         }
+         IErr[INghbr] =
+             MPI_Irecv(RecvPtr, BufferSize, MPI_RealKind, MyNeighbor->TaskID,
+                       MyElem, MyComm, &MyNeighbor->RReq);
          if (IErr[INghbr] != 0) {
             LOG_ERROR("MPI error {} on task {} receive from task {}",
                       IErr[INghbr], MyTask, MyNeighbor->TaskID);
@@ -662,7 +1220,7 @@ int Halo::startReceives() {
 
 //------------------------------------------------------------------------------
 // Initiate MPI communication by calling MPI_Isend for each Neighbor to send
-// the packed buffers to each task
+// the packed buffers (host or device, depending on OnDevice) to each task
 
 int Halo::startSends() {
 
@@ -674,10 +1232,14 @@ int Halo::startSends() {
    for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
       if (SendFlags[MyElem][INghbr]) {
          MyNeighbor    = &Neighbors[INghbr];
-         I4 BufferSize = TotSize * MyNeighbor->SendLists[MyElem].NTot;
-         IErr[INghbr] =
-             MPI_Isend(&MyNeighbor->SendBuffer[0], BufferSize, MPI_RealKind,
-                       MyNeighbor->TaskID, 0, MyComm, &MyNeighbor->SReq);
+         I4 BufferSize =
+             TotSize * MyNeighbor->SendLists[MyElem].Offsets[NumLayers];
+         Real *SendPtr = OnDevice ? MyNeighbor->SendBufferDevice.data()
+                                  : &MyNeighbor->SendBuffer[0];
+
+         IErr[INghbr] = MPI_Isend(SendPtr, BufferSize, MPI_RealKind,
+                                  MyNeighbor->TaskID, MyElem, MyComm,
+                                  &MyNeighbor->SReq);
          if (IErr[INghbr] != 0) {
             LOG_ERROR("MPI error {} on task {} send to task {}", IErr[INghbr],
                       MyTask, MyNeighbor->TaskID);
@@ -702,8 +1264,9 @@ int Halo::startSends() {
 int Halo::packBuffer(const HostArray1DI4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot);
+   MyNeighbor->SendBuffer.resize(NTot);
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
@@ -719,8 +1282,9 @@ int Halo::packBuffer(const HostArray1DI4 Array) {
 int Halo::packBuffer(const HostArray1DI8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot);
+   MyNeighbor->SendBuffer.resize(NTot);
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
@@ -736,8 +1300,9 @@ int Halo::packBuffer(const HostArray1DI8 Array) {
 int Halo::packBuffer(const HostArray1DR4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot);
+   MyNeighbor->SendBuffer.resize(NTot);
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
@@ -752,8 +1317,9 @@ int Halo::packBuffer(const HostArray1DR4 Array) {
 int Halo::packBuffer(const HostArray1DR8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot);
+   MyNeighbor->SendBuffer.resize(NTot);
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
@@ -768,9 +1334,10 @@ int Halo::packBuffer(const HostArray1DR8 Array) {
 int Halo::packBuffer(const HostArray2DI4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NJ           = Array.extent(1);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
@@ -788,9 +1355,10 @@ int Halo::packBuffer(const HostArray2DI4 Array) {
 int Halo::packBuffer(const HostArray2DI8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NJ           = Array.extent(1);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
@@ -808,9 +1376,10 @@ int Halo::packBuffer(const HostArray2DI8 Array) {
 int Halo::packBuffer(const HostArray2DR4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NJ           = Array.extent(1);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
@@ -828,9 +1397,10 @@ int Halo::packBuffer(const HostArray2DR4 Array) {
 int Halo::packBuffer(const HostArray2DR8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NJ           = Array.extent(1);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
@@ -848,18 +1418,17 @@ int Halo::packBuffer(const HostArray2DR8 Array) {
 int Halo::packBuffer(const HostArray3DI4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
-               I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
+               I4 IBuff = (K * NTot + MyList->Offsets[ILayer] + IExch) * NJ + J;
                MyNeighbor->SendBuffer[IBuff] = reinterpret_cast<Real &>(
                    Array(K, MyList->Ind[ILayer][IExch], J));
             }
@@ -873,18 +1442,17 @@ int Halo::packBuffer(const HostArray3DI4 Array) {
 int Halo::packBuffer(const HostArray3DI8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
-               I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
+               I4 IBuff = (K * NTot + MyList->Offsets[ILayer] + IExch) * NJ + J;
                MyNeighbor->SendBuffer[IBuff] = reinterpret_cast<Real &>(
                    Array(K, MyList->Ind[ILayer][IExch], J));
             }
@@ -898,18 +1466,17 @@ int Halo::packBuffer(const HostArray3DI8 Array) {
 int Halo::packBuffer(const HostArray3DR4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
-               I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
+               I4 IBuff = (K * NTot + MyList->Offsets[ILayer] + IExch) * NJ + J;
                MyNeighbor->SendBuffer[IBuff] =
                    Array(K, MyList->Ind[ILayer][IExch], J);
             }
@@ -923,18 +1490,17 @@ int Halo::packBuffer(const HostArray3DR4 Array) {
 int Halo::packBuffer(const HostArray3DR8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int K = 0; K < NK; ++K) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
-               I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
+               I4 IBuff = (K * NTot + MyList->Offsets[ILayer] + IExch) * NJ + J;
                MyNeighbor->SendBuffer[IBuff] =
                    Array(K, MyList->Ind[ILayer][IExch], J);
             }
@@ -948,18 +1514,19 @@ int Halo::packBuffer(const HostArray3DR8 Array) {
 int Halo::packBuffer(const HostArray4DI4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NTot +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
@@ -977,18 +1544,19 @@ int Halo::packBuffer(const HostArray4DI4 Array) {
 int Halo::packBuffer(const HostArray4DI8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NTot +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
@@ -1006,18 +1574,19 @@ int Halo::packBuffer(const HostArray4DI8 Array) {
 int Halo::packBuffer(const HostArray4DR4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NTot +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
@@ -1035,18 +1604,19 @@ int Halo::packBuffer(const HostArray4DR4 Array) {
 int Halo::packBuffer(const HostArray4DR8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int L = 0; L < NL; ++L) {
       for (int K = 0; K < NK; ++K) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NTot +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
@@ -1064,12 +1634,13 @@ int Halo::packBuffer(const HostArray4DR8 Array) {
 int Halo::packBuffer(const HostArray5DI4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
       for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
@@ -1077,7 +1648,7 @@ int Halo::packBuffer(const HostArray5DI4 Array) {
             for (int K = 0; K < NK; ++K) {
                for (int L = 0; L < NL; ++L) {
                   for (int M = 0; M < NM; ++M) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NTot +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
@@ -1096,12 +1667,13 @@ int Halo::packBuffer(const HostArray5DI4 Array) {
 int Halo::packBuffer(const HostArray5DI8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int M = 0; M < NM; ++M) {
       for (int L = 0; L < NL; ++L) {
@@ -1109,7 +1681,7 @@ int Halo::packBuffer(const HostArray5DI8 Array) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NTot +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
@@ -1128,12 +1700,13 @@ int Halo::packBuffer(const HostArray5DI8 Array) {
 int Halo::packBuffer(const HostArray5DR4 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int M = 0; M < NM; ++M) {
       for (int L = 0; L < NL; ++L) {
@@ -1141,7 +1714,7 @@ int Halo::packBuffer(const HostArray5DR4 Array) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NTot +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
@@ -1160,12 +1733,13 @@ int Halo::packBuffer(const HostArray5DR4 Array) {
 int Halo::packBuffer(const HostArray5DR8 Array) {
 
    ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
    int NJ           = Array.extent(4);
 
-   MyNeighbor->SendBuffer.resize(MyList->NTot * TotSize);
+   MyNeighbor->SendBuffer.resize(NTot * TotSize);
 
    for (int M = 0; M < NM; ++M) {
       for (int L = 0; L < NL; ++L) {
@@ -1173,7 +1747,7 @@ int Halo::packBuffer(const HostArray5DR8 Array) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NTot +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
@@ -1333,6 +1907,7 @@ int Halo::unpackBuffer(HostArray2DR8 &Array) {
 int Halo::unpackBuffer(HostArray3DI4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
@@ -1340,9 +1915,7 @@ int Halo::unpackBuffer(HostArray3DI4 &Array) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
-               I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
+               I4 IBuff = (K * NTot + MyList->Offsets[ILayer] + IExch) * NJ + J;
                Array(K, MyList->Ind[ILayer][IExch], J) =
                    reinterpret_cast<I4 &>(MyNeighbor->RecvBuffer[IBuff]);
             }
@@ -1356,6 +1929,7 @@ int Halo::unpackBuffer(HostArray3DI4 &Array) {
 int Halo::unpackBuffer(HostArray3DI8 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
@@ -1363,9 +1937,7 @@ int Halo::unpackBuffer(HostArray3DI8 &Array) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
-               I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
+               I4 IBuff = (K * NTot + MyList->Offsets[ILayer] + IExch) * NJ + J;
                Array(K, MyList->Ind[ILayer][IExch], J) =
                    reinterpret_cast<I8 &>(MyNeighbor->RecvBuffer[IBuff]);
             }
@@ -1379,6 +1951,7 @@ int Halo::unpackBuffer(HostArray3DI8 &Array) {
 int Halo::unpackBuffer(HostArray3DR4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
@@ -1386,9 +1959,7 @@ int Halo::unpackBuffer(HostArray3DR4 &Array) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
-               I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
+               I4 IBuff = (K * NTot + MyList->Offsets[ILayer] + IExch) * NJ + J;
                Array(K, MyList->Ind[ILayer][IExch], J) =
                    MyNeighbor->RecvBuffer[IBuff];
             }
@@ -1402,6 +1973,7 @@ int Halo::unpackBuffer(HostArray3DR4 &Array) {
 int Halo::unpackBuffer(HostArray3DR8 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NK           = Array.extent(0);
    int NJ           = Array.extent(2);
 
@@ -1409,9 +1981,7 @@ int Halo::unpackBuffer(HostArray3DR8 &Array) {
       for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
          for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
-               I4 IBuff =
-                   (K * MyList->NTot + MyList->Offsets[ILayer] + IExch) * NJ +
-                   J;
+               I4 IBuff = (K * NTot + MyList->Offsets[ILayer] + IExch) * NJ + J;
                Array(K, MyList->Ind[ILayer][IExch], J) =
                    MyNeighbor->RecvBuffer[IBuff];
             }
@@ -1425,6 +1995,7 @@ int Halo::unpackBuffer(HostArray3DR8 &Array) {
 int Halo::unpackBuffer(HostArray4DI4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
@@ -1434,7 +2005,7 @@ int Halo::unpackBuffer(HostArray4DI4 &Array) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NTot +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
@@ -1452,6 +2023,7 @@ int Halo::unpackBuffer(HostArray4DI4 &Array) {
 int Halo::unpackBuffer(HostArray4DI8 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
@@ -1461,7 +2033,7 @@ int Halo::unpackBuffer(HostArray4DI8 &Array) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NTot +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
@@ -1479,6 +2051,7 @@ int Halo::unpackBuffer(HostArray4DI8 &Array) {
 int Halo::unpackBuffer(HostArray4DR4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
@@ -1488,7 +2061,7 @@ int Halo::unpackBuffer(HostArray4DR4 &Array) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NTot +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
@@ -1506,6 +2079,7 @@ int Halo::unpackBuffer(HostArray4DR4 &Array) {
 int Halo::unpackBuffer(HostArray4DR8 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NL           = Array.extent(0);
    int NK           = Array.extent(1);
    int NJ           = Array.extent(3);
@@ -1515,7 +2089,7 @@ int Halo::unpackBuffer(HostArray4DR8 &Array) {
          for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
             for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                for (int J = 0; J < NJ; ++J) {
-                  I4 IBuff = ((L * NK + K) * MyList->NTot +
+                  I4 IBuff = ((L * NK + K) * NTot +
                               MyList->Offsets[ILayer] + IExch) *
                                  NJ +
                              J;
@@ -1533,6 +2107,7 @@ int Halo::unpackBuffer(HostArray4DR8 &Array) {
 int Halo::unpackBuffer(HostArray5DI4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
@@ -1544,7 +2119,7 @@ int Halo::unpackBuffer(HostArray5DI4 &Array) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NTot +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
@@ -1563,6 +2138,7 @@ int Halo::unpackBuffer(HostArray5DI4 &Array) {
 int Halo::unpackBuffer(HostArray5DI8 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
@@ -1574,7 +2150,7 @@ int Halo::unpackBuffer(HostArray5DI8 &Array) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NTot +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
@@ -1593,6 +2169,7 @@ int Halo::unpackBuffer(HostArray5DI8 &Array) {
 int Halo::unpackBuffer(HostArray5DR4 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
@@ -1604,7 +2181,7 @@ int Halo::unpackBuffer(HostArray5DR4 &Array) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NTot +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
@@ -1623,6 +2200,7 @@ int Halo::unpackBuffer(HostArray5DR4 &Array) {
 int Halo::unpackBuffer(HostArray5DR8 &Array) {
 
    ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+   I4 NTot          = MyList->Offsets[NumLayers];
    int NM           = Array.extent(0);
    int NL           = Array.extent(1);
    int NK           = Array.extent(2);
@@ -1634,7 +2212,7 @@ int Halo::unpackBuffer(HostArray5DR8 &Array) {
             for (int ILayer = 0; ILayer < NumLayers; ++ILayer) {
                for (int IExch = 0; IExch < MyList->NList[ILayer]; ++IExch) {
                   for (int J = 0; J < NJ; ++J) {
-                     I4 IBuff = (((M * NL + L) * NK + K) * MyList->NTot +
+                     I4 IBuff = (((M * NL + L) * NK + K) * NTot +
                                  MyList->Offsets[ILayer] + IExch) *
                                     NJ +
                                 J;
@@ -13,7 +13,10 @@
 /// exchange The halo exchanges are carried out via non-blocking MPI library
 /// routines. The Halo class public member function exchangeFullArrayHalo
 /// which is called by the user to perform halo exchanges is a template
-/// function and thus is fully defined in this header.
+/// function and thus is fully defined in this header. Device arrays can either
+/// be exchanged through host copies or, if the DeviceExchange option is
+/// enabled, packed and unpacked directly on the device with the device
+/// buffers passed to a GPU-aware MPI library.
 ///
 //
 //===----------------------------------------------------------------------===//
@@ -22,12 +25,21 @@
 #include "Decomp.h"
 #include "Logging.h"
 #include "MachEnv.h"
+#include "MemoryTracker.h"
+#include "OmegaKokkos.h"
+#include "Timer.h"
 #include "mpi.h"
+#include <functional>
 #include <memory>
 #include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace OMEGA {
 
+class HaloGroup; // forward declaration, defined below
+
 // Set the default MPI real data type as single or double precision based on
 // the default real data type used by OMEGA.
 #ifdef SINGLE_PRECISION
@@ -43,9 +55,9 @@ enum MeshElement { OnCell, OnEdge, OnVertex };
 /// defined below. The Halo class holds all the Neighbor objects needed by a
 /// task to perform a full halo exchange with each of its neighboring tasks for
 /// any array defined on the mesh. The local task ID and the MPI communicator
-/// handle are also stored here. NumLayers, MyElem, TotSize, and MyNeighbor are
-/// temporary variables utilized by the current halo exchange which are stored
-/// here for easy accesibility by the Halo methods.
+/// handle are also stored here. NumLayers, MyElem, TotSize, OnDevice and
+/// MyNeighbor are temporary variables utilized by the current halo exchange
+/// which are stored here for easy accesibility by the Halo methods.
 class Halo {
  private:
    /// The default Halo handles halo exchanges for arrays defined on the mesh
@@ -67,6 +79,12 @@ class Halo {
    MPI_Comm MyComm;    /// MPI communicator handle
    MeshElement MyElem; /// index space of current array
 
+   /// Flag to exchange device arrays directly from device buffers using a
+   /// GPU-aware MPI library rather than through host copies of the arrays
+   bool UseDeviceExchange{false};
+   /// True if the current exchange is using the device buffers
+   bool OnDevice{false};
+
    /// Forward Declaration of Neighbor class, defined below
    class Neighbor;
 
@@ -104,6 +122,9 @@ class Halo {
       /// indices of elements to be packed into the send buffer, or the local
       /// indices of elements unpacked from the receive buffer
       std::vector<std::vector<I4>> Ind;
+      /// Device copy of Ind with all halo layers flattened into a single
+      /// list, used to pack and unpack device arrays with Kokkos kernels
+      Array1DI4 IndDevice;
 
       /// The constructor for the ExchList class takes as input an array of
       /// vectors, each containing a list of indices to be sent or received for
@@ -133,6 +154,12 @@ class Halo {
       ExchList SendLists[3], RecvLists[3];
       /// Buffers for MPI communication
       std::vector<Real> SendBuffer, RecvBuffer;
+      /// Device buffers for MPI communication of device arrays, only
+      /// allocated when a device exchange is performed
+      Array1DReal SendBufferDevice, RecvBufferDevice;
+      /// Buffers for aggregated exchanges of a HaloGroup, holding the
+      /// packed elements of all arrays in the group in a single message
+      std::vector<Real> GroupSendBuffer, GroupRecvBuffer;
       /// MPI request handles for non-blocking MPI communication
       MPI_Request RReq, SReq;
 
@@ -159,8 +186,125 @@ class Halo {
 
    }; // end class Neighbor
 
+   /// The CommBuffers class holds a set of MPI buffers and request handles
+   /// for each Neighbor. It is used to set aside the communication state of a
+   /// split-phase exchange and to cache the buffers and persistent requests
+   /// of persistent-communication exchanges. Contents are swapped with the
+   /// Neighbor members, which preserves the buffer memory addresses.
+   class CommBuffers {
+    private:
+      std::vector<std::vector<Real>> SendBuffers, RecvBuffers;
+      std::vector<Array1DReal> SendBuffersDevice, RecvBuffersDevice;
+      std::vector<MPI_Request> RReqs, SReqs;
+
+      /// Contiguous buffers, counts, displacements and request handle for
+      /// the neighborhood collective backend
+      std::vector<Real> CollSendBuffer, CollRecvBuffer;
+      std::vector<int> CollSendCounts, CollSendDispls;
+      std::vector<int> CollRecvCounts, CollRecvDispls;
+      MPI_Request CollReq{MPI_REQUEST_NULL};
+
+      /// Halo is a friend class to allow access to private members
+      /// of the class
+      friend class Halo;
+
+   }; // end class CommBuffers
+
+   /// The PendingExchange class holds the state of a split-phase halo
+   /// exchange that has been initiated by startExchange but not yet completed
+   /// by finishExchange. One pending exchange is allowed for each index
+   /// space. While the exchange is in flight, the Neighbor buffers and MPI
+   /// request handles are swapped into this object so that other exchanges
+   /// can be carried out before the pending exchange is finished.
+   class PendingExchange {
+    private:
+      bool Active{false};       /// true if an exchange is in flight
+      I4 NumLayers{0};          /// number of halo layers being exchanged
+      I4 TotSize{0};            /// number of array elements per mesh element
+      bool OnDevice{false};     /// true if exchanging device buffers
+      bool OnCollective{false}; /// true if using the neighborhood collective
+
+      /// Buffers and MPI request handles for each Neighbor and for the
+      /// neighborhood collective
+      CommBuffers Buffers;
+
+      /// Persistent communication buffers in use by the exchange, if any
+      CommBuffers *Persistent{nullptr};
+
+      /// Halo is a friend class to allow access to private members
+      /// of the class
+      friend class Halo;
+
+   }; // end class PendingExchange
+
+   /// Pending split-phase exchanges for each index space.
+   /// 0 = OnCell, 1 = OnEdge, 2 = OnVertex
+   PendingExchange Pending[3];
+
+   /// Flag to use persistent MPI requests (MPI_Send_init/MPI_Recv_init) with
+   /// preallocated buffers that are cached for each exchange signature
+   bool UsePersistentComm{false};
+
+   /// Cached persistent communication buffers and requests, keyed by the
+   /// exchange signature (index space, number of halo layers, array elements
+   /// per mesh element and whether device buffers are used)
+   std::map<std::tuple<I4, I4, I4, bool>, CommBuffers> PersistentComms;
+
+   /// Persistent communication buffers swapped into the Neighbor objects for
+   /// the current exchange, nullptr if persistent requests are not used
+   CommBuffers *CurPersistent{nullptr};
+
+   /// Flag to exchange host buffers with MPI_Ineighbor_alltoallv on a
+   /// distributed graph communicator built from NeighborList instead of
+   /// point-to-point messages
+   bool UseNeighborCollective{false};
+   /// True if the current exchange is using the neighborhood collective
+   bool OnCollective{false};
+   /// Distributed graph communicator with the neighboring tasks, created
+   /// when the neighborhood collective backend is first selected
+   MPI_Comm GraphComm{MPI_COMM_NULL};
+
+   /// Contiguous buffers, counts, displacements and request handle of the
+   /// current neighborhood collective exchange. Blocks are ordered as the
+   /// tasks in NeighborList, which are the sources and destinations of
+   /// GraphComm.
+   std::vector<Real> CollSendBuffer, CollRecvBuffer;
+   std::vector<int> CollSendCounts, CollSendDispls;
+   std::vector<int> CollRecvCounts, CollRecvDispls;
+   MPI_Request CollReq{MPI_REQUEST_NULL};
+
    // Private methods
 
+   /// Save the index space of the current exchange in MyElem and set
+   /// NumLayers to the number of halo layers to exchange in that index space
+   /// for the requested halo depth
+   void setExchangeElem(const MeshElement ThisElem, const I4 HaloDepth);
+
+   /// Swap the buffers and MPI request handles of each Neighbor with those
+   /// stored in the input CommBuffers, used to set aside and restore the
+   /// communication state of a split-phase exchange and to swap in the
+   /// cached buffers of persistent exchanges
+   void swapCommBuffers(CommBuffers &Buffers);
+
+   /// Retrieve (creating on first use) the persistent buffers and requests
+   /// for the current exchange signature, swap them into the Neighbor
+   /// objects and start the persistent receives
+   int startPersistentReceives();
+
+   /// Start the persistent sends of the current exchange
+   int startPersistentSends();
+
+   /// Free all cached persistent requests and buffers
+   void freePersistentComms();
+
+   /// Copy the packed send buffers of all Neighbors into one contiguous
+   /// buffer and start the exchange with MPI_Ineighbor_alltoallv
+   int startNeighborCollective();
+
+   /// Wait for the neighborhood collective exchange to complete and copy the
+   /// received blocks into the receive buffer of each Neighbor
+   int finishNeighborCollective();
+
    /// Uses info from Decomp to generate a sorted list of tasks that own
    /// elements in the the Halo of the local task for a particular index space.
    /// Utilized only during halo construction
@@ -197,7 +341,8 @@ class Halo {
                          std::vector<std::vector<std::vector<I4>>> &RecvLists,
                          const MeshElement IndexSpace);
 
-   /// Allocate the recieve buffers and call MPI_Irecv for each Neighbor
+   /// Allocate the recieve buffers (host or device, depending on OnDevice) and
+   /// call MPI_Irecv for each Neighbor
    int startReceives();
 
    /// Call MPI_Isend for each Neighbor to send the packed buffers to
@@ -287,64 +432,415 @@ class Halo {
    /// Retrieves a pointer to a Halo object by Name
    static Halo *get(std::string Name);
 
+   /// Returns true if device arrays are exchanged directly from device
+   /// buffers rather than through host copies
+   bool isDeviceExchange() const;
+
+   /// Enable or disable exchanging device arrays directly from device
+   /// buffers. This requires an MPI library that is GPU-aware.
+   void setDeviceExchange(const bool InDeviceExchange ///< [in] new setting
+   );
+
+   /// Returns true if persistent MPI requests are used for exchanges
+   bool isPersistentComm() const;
+
+   /// Enable or disable the use of persistent MPI requests and cached
+   /// buffers. Disabling frees all cached requests.
+   void setPersistentComm(const bool InPersistentComm ///< [in] new setting
+   );
+
+   /// Returns true if exchanges use the neighborhood collective backend
+   bool isNeighborCollective() const;
+
+   /// Select the neighborhood collective backend (true) or the default
+   /// point-to-point backend (false). Collective on the tasks of the Halo
+   /// the first time the collective backend is selected, since the
+   /// distributed graph communicator is created then.
+   int setNeighborCollective(const bool InNeighborCollective ///< [in] setting
+   );
+
+   /// Perform a halo exchange of all arrays registered in the input
+   /// HaloGroup, packing the halo elements of every array into a single
+   /// message for each neighboring task. The optional HaloDepth is the number
+   /// of cell halo layers to exchange as described for exchangeFullArrayHalo.
+   int exchangeGroupHalo(HaloGroup &Group,      ///< [inout] group of arrays
+                         const I4 HaloDepth = 0 ///< [in] halo depth, 0 for all
+   );
+
    //---------------------------------------------------------------------------
    // Function template to perform a full halo exchange on the input Kokkos
-   // array of any supported type defined on the input index space ThisElem
+   // array of any supported type defined on the input index space ThisElem.
+   // Host arrays are exchanged using the host buffers. Device arrays of type
+   // Real are exchanged using device buffers if the device exchange option is
+   // enabled, otherwise the exchange is performed on a host copy of the array.
+   // By default all halo layers are exchanged. If a HaloDepth between 1 and
+   // HaloWidth is given, only the first HaloDepth cell layers are exchanged
+   // (HaloDepth + 1 layers for edges and vertices), which is sufficient when
+   // the computations that follow only need part of the halo.
    template <typename T>
    int
-   exchangeFullArrayHalo(T &Array,            // Kokkos array of any type
-                         MeshElement ThisElem // index space Array is defined on
+   exchangeFullArrayHalo(T &Array,              // Kokkos array of any type
+                         MeshElement ThisElem,  // index space of Array
+                         const I4 HaloDepth = 0 // halo depth, 0 for all layers
    ) {
 
-      I4 IErr{0}; // error code
+      if (Pending[ThisElem].Active) {
+         LOG_ERROR("Halo: cannot exchange an array while a split-phase "
+                   "exchange is pending in the same index space");
+         return -1;
+      }
 
-      // Logical flag to track if all messages have been received
-      bool AllReceived{false};
+      TimerRegion HaloTimer("Halo");
 
-      // Save the index space the input array is defined on
-      MyElem = ThisElem;
+      // Arrays accessible from the host (all arrays in CPU-only and unified
+      // memory builds) are exchanged directly using the host buffers, once
+      // the device kernels working on shared arrays have completed
+      if constexpr (IsHostArray<T>) {
+         fenceSharedArrays();
+         OnDevice = false;
+         return exchangeArrayHalo(Array, ThisElem, HaloDepth);
 
-      // For cell-based quantities, the number of halo layers equals HaloWidth,
-      // edge- and vertex-based quantities have an extra layer.
-      if (MyElem == OnCell) {
-         NumLayers = HaloWidth;
       } else {
-         NumLayers = HaloWidth + 1;
+         // Real device arrays up to 3D can be packed and unpacked on the
+         // device and the device buffers handed directly to MPI
+         if constexpr (IsDeviceExchangeArray<T>) {
+            if (UseDeviceExchange) {
+               OnDevice = true;
+               return exchangeArrayHalo(Array, ThisElem, HaloDepth);
+            }
+         }
+
+         // Otherwise fall back to exchanging a host copy of the array
+         auto ArrayH = createHostMirrorCopy(Array);
+         I4 IErr     = exchangeFullArrayHalo(ArrayH, ThisElem, HaloDepth);
+         deepCopy(Array, ArrayH);
+         return IErr;
       }
+   } // end exchangeFullArrayHalo
 
-      // Determine the number of array elements per cell, edge, or vertex
-      // in the input array
-      I4 NDims = Array.Rank;
-      if (NDims == 1) {
-         TotSize = 1;
-      } else if (NDims == 2) {
-         TotSize = Array.extent(1);
+   //---------------------------------------------------------------------------
+   // Function templates for a split-phase halo exchange. startExchange posts
+   // the receives, packs and sends the halo elements of the input array and
+   // returns without waiting for the messages to arrive. After computations
+   // that do not depend on the halo values of the array, finishExchange must
+   // be called with the same array and index space to wait for the messages
+   // and unpack them into the halo. One split-phase exchange may be pending
+   // for each index space at a time. Arrays that can only be exchanged
+   // through a host copy (device arrays when the device exchange is not
+   // enabled, or types not supported by the device path) are fully exchanged
+   // in startExchange, in which case finishExchange returns immediately.
+   // The optional HaloDepth is as described for exchangeFullArrayHalo.
+   template <typename T>
+   int startExchange(T &Array,              // Kokkos array of any type
+                     MeshElement ThisElem,  // index space Array is defined on
+                     const I4 HaloDepth = 0 // halo depth, 0 for all layers
+   ) {
+
+      if (Pending[ThisElem].Active) {
+         LOG_ERROR("Halo: startExchange called while another exchange is "
+                   "pending in the same index space");
+         return -1;
+      }
+
+      TimerRegion HaloTimer("Halo");
+
+      bool Direct{false};
+      if constexpr (IsHostArray<T>) {
+         fenceSharedArrays();
+         OnDevice = false;
+         Direct   = true;
+      } else if constexpr (IsDeviceExchangeArray<T>) {
+         OnDevice = true;
+         Direct   = UseDeviceExchange;
+      }
+
+      if (!Direct) {
+         return exchangeFullArrayHalo(Array, ThisElem, HaloDepth);
+      }
+
+      if constexpr (IsHostArray<T> or IsDeviceExchangeArray<T>) {
+         I4 IErr = startArrayExchange(Array, ThisElem, HaloDepth);
+
+         // Set aside the communication state so other exchanges can proceed
+         PendingExchange &ThisPending = Pending[ThisElem];
+         ThisPending.Active           = true;
+         ThisPending.NumLayers        = NumLayers;
+         ThisPending.TotSize          = TotSize;
+         ThisPending.OnDevice         = OnDevice;
+         ThisPending.OnCollective     = OnCollective;
+         ThisPending.Persistent       = CurPersistent;
+         CurPersistent                = nullptr;
+         swapCommBuffers(ThisPending.Buffers);
+
+         return IErr;
+      }
+
+      return 0;
+   } // end startExchange
+
+   template <typename T>
+   int finishExchange(T &Array,            // Kokkos array of any type
+                      MeshElement ThisElem // index space Array is defined on
+   ) {
+
+      PendingExchange &ThisPending = Pending[ThisElem];
+
+      // Nothing to do if the exchange was completed in startExchange
+      if (not ThisPending.Active) {
+         return 0;
+      }
+
+      TimerRegion HaloTimer("Halo");
+
+      if constexpr (IsHostArray<T> or IsDeviceExchangeArray<T>) {
+         // Restore the communication state of the pending exchange
+         swapCommBuffers(ThisPending.Buffers);
+         ThisPending.Active     = false;
+         MyElem                 = ThisElem;
+         NumLayers              = ThisPending.NumLayers;
+         TotSize                = ThisPending.TotSize;
+         OnDevice               = ThisPending.OnDevice;
+         OnCollective           = ThisPending.OnCollective;
+         CurPersistent          = ThisPending.Persistent;
+         ThisPending.Persistent = nullptr;
+
+         return finishArrayExchange(Array);
       } else {
-         TotSize = 1;
+         LOG_ERROR("Halo: finishExchange called with an array type that "
+                   "does not match the pending exchange");
+         return -1;
+      }
+   } // end finishExchange
+
+   //---------------------------------------------------------------------------
+   // Device buffer pack and unpack functions. These select the elements of
+   // a device array to send to (or receive from) the current neighbor using
+   // the flattened device exchange lists and are executed as Kokkos kernels.
+   // The buffer layout is the same as for the corresponding host arrays.
+   // KOKKOS_LAMBDA does not allow parallel_* functions inside of a private
+   // function, so these are public but are only intended for use within the
+   // exchange functions.
+   template <typename T> int packBufferDevice(const T &Array) {
+
+      ExchList *MyList = &MyNeighbor->SendLists[MyElem];
+      const I4 NTot    = MyList->Offsets[NumLayers];
+
+      // Allocate the device send buffer if it is not yet large enough
+      if (MyNeighbor->SendBufferDevice.extent_int(0) < NTot * TotSize) {
+         MemoryRegion HaloMemory("Halo");
+         MyNeighbor->SendBufferDevice =
+             Array1DReal("HaloSendBuffer", NTot * TotSize);
+      }
+
+      const Array1DI4 &Ind    = MyList->IndDevice;
+      const Array1DReal &Buff = MyNeighbor->SendBufferDevice;
+
+      if constexpr (T::rank == 1) {
+         parallelFor(
+             "haloPackBuffer1D", {NTot},
+             KOKKOS_LAMBDA(int IExch) { Buff(IExch) = Array(Ind(IExch)); });
+      } else if constexpr (T::rank == 2) {
+         const int NJ = Array.extent_int(1);
+         parallelFor(
+             "haloPackBuffer2D", {NTot, NJ},
+             KOKKOS_LAMBDA(int IExch, int J) {
+                Buff(IExch * NJ + J) = Array(Ind(IExch), J);
+             });
+      } else {
+         const int NK = Array.extent_int(0);
+         const int NJ = Array.extent_int(2);
+         parallelFor(
+             "haloPackBuffer3D", {NK, NTot, NJ},
+             KOKKOS_LAMBDA(int K, int IExch, int J) {
+                Buff((K * NTot + IExch) * NJ + J) = Array(K, Ind(IExch), J);
+             });
+      }
+
+      return 0;
+   } // end packBufferDevice
+
+   template <typename T> int unpackBufferDevice(const T &Array) {
+
+      ExchList *MyList = &MyNeighbor->RecvLists[MyElem];
+      const I4 NTot    = MyList->Offsets[NumLayers];
+
+      const Array1DI4 &Ind    = MyList->IndDevice;
+      const Array1DReal &Buff = MyNeighbor->RecvBufferDevice;
+
+      if constexpr (T::rank == 1) {
+         parallelFor(
+             "haloUnpackBuffer1D", {NTot},
+             KOKKOS_LAMBDA(int IExch) { Array(Ind(IExch)) = Buff(IExch); });
+      } else if constexpr (T::rank == 2) {
+         const int NJ = Array.extent_int(1);
+         parallelFor(
+             "haloUnpackBuffer2D", {NTot, NJ},
+             KOKKOS_LAMBDA(int IExch, int J) {
+                Array(Ind(IExch), J) = Buff(IExch * NJ + J);
+             });
+      } else {
+         const int NK = Array.extent_int(0);
+         const int NJ = Array.extent_int(2);
+         parallelFor(
+             "haloUnpackBuffer3D", {NK, NTot, NJ},
+             KOKKOS_LAMBDA(int K, int IExch, int J) {
+                Array(K, Ind(IExch), J) = Buff((K * NTot + IExch) * NJ + J);
+             });
+      }
+
+      return 0;
+   } // end unpackBufferDevice
+
+ private:
+   // Array types that are host-accessible and exchanged directly from the
+   // host buffers, and device array types that can be packed and unpacked on
+   // the device if the device exchange is enabled
+   template <typename T>
+   static constexpr bool IsHostArray =
+       Kokkos::SpaceAccessibility<HostExecSpace,
+                                  typename T::memory_space>::accessible;
+   template <typename T>
+   static constexpr bool IsDeviceExchangeArray =
+       std::is_same_v<typename T::non_const_value_type, Real> and T::rank <= 3;
+
+   //---------------------------------------------------------------------------
+   // Function template that returns the number of array elements for each
+   // cell, edge, or vertex in the input array, i.e. the product of the
+   // extents of all dimensions other than the mesh element dimension
+   template <typename T> static I4 arrayTotSize(const T &Array) {
+      I4 NDims = Array.Rank;
+      I4 Size{1};
+      if (NDims == 2) {
+         Size = Array.extent(1);
+      } else if (NDims > 2) {
          for (int I = 0; I < NDims - 2; ++I) {
-            TotSize *= Array.extent(I);
+            Size *= Array.extent(I);
          }
-         TotSize *= Array.extent(NDims - 1);
+         Size *= Array.extent(NDims - 1);
+      }
+      return Size;
+   } // end arrayTotSize
+
+   //---------------------------------------------------------------------------
+   // Function template that carries out a halo exchange of the input array
+   // using either the host buffers or, if OnDevice is true, the device
+   // buffers.
+   template <typename T>
+   int exchangeArrayHalo(T &Array,             // Kokkos array of any type
+                         MeshElement ThisElem, // index space of Array
+                         const I4 HaloDepth    // number of cell halo layers
+   ) {
+
+      I4 IErr = startArrayExchange(Array, ThisElem, HaloDepth);
+      if (IErr != 0) {
+         return IErr;
       }
 
+      return finishArrayExchange(Array);
+   } // end exchangeArrayHalo
+
+   //---------------------------------------------------------------------------
+   // Function template that initiates a halo exchange of the input array by
+   // posting the receives, packing the send buffers and starting the sends
+   template <typename T>
+   int startArrayExchange(T &Array,             // Kokkos array of any type
+                          MeshElement ThisElem, // index space of Array
+                          const I4 HaloDepth    // number of cell halo layers
+   ) {
+
+      I4 IErr{0}; // error code
+
+      // Save the index space the input array is defined on and set the
+      // number of halo layers to exchange
+      setExchangeElem(ThisElem, HaloDepth);
+
+      // Determine the number of array elements per cell, edge, or vertex
+      // in the input array
+      TotSize = arrayTotSize(Array);
+
       // Allocate the receive buffers and Call MPI_Irecv for each Neighbor
       // so the local task is ready to accept messages from each
-      // neighboring task
-      startReceives();
+      // neighboring task. With persistent communication, the cached buffers
+      // are swapped in and the persistent receives are started instead. The
+      // neighborhood collective backend (host buffers only) posts its
+      // receives together with the sends below.
+      OnCollective = UseNeighborCollective and not OnDevice;
+      if (not OnCollective) {
+         if (UsePersistentComm) {
+            IErr = startPersistentReceives();
+         } else {
+            IErr = startReceives();
+         }
+      }
 
-      // Loop through each Neighbor, resetting communication flags and packing
-      // buffers if there are elements to be sent to the neighboring task
+      // Loop through each Neighbor, packing buffers if there are elements to
+      // be sent to the neighboring task
       for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-         MyNeighbor           = &Neighbors[INghbr];
-         MyNeighbor->Received = false;
-         MyNeighbor->Unpacked = false;
+         MyNeighbor = &Neighbors[INghbr];
          if (SendFlags[MyElem][INghbr]) {
-            packBuffer(Array);
+            if constexpr (IsHostArray<T>) {
+               packBuffer(Array);
+            } else {
+               packBufferDevice(Array);
+            }
+         }
+      }
+
+      // Device pack kernels must be complete before the buffers are sent
+      if (OnDevice)
+         Kokkos::fence();
+
+      // Call MPI_Isend (or start the persistent sends or the neighborhood
+      // collective) for each Neighbor to send the packed buffers
+      I4 SendErr{0};
+      if (OnCollective) {
+         SendErr = startNeighborCollective();
+      } else if (UsePersistentComm) {
+         SendErr = startPersistentSends();
+      } else {
+         SendErr = startSends();
+      }
+      if (SendErr != 0) {
+         IErr = SendErr;
+      }
+
+      return IErr;
+   } // end startArrayExchange
+
+   //---------------------------------------------------------------------------
+   // Function template that completes a halo exchange initiated by
+   // startArrayExchange, waiting for the sends to complete and unpacking
+   // each message into the input array as it is received
+   template <typename T>
+   int finishArrayExchange(T &Array // Kokkos array of any type
+   ) {
+
+      I4 IErr{0}; // error code
+
+      // Logical flag to track if all messages have been received
+      bool AllReceived{false};
+
+      // With the neighborhood collective, wait for the single collective
+      // request and then unpack the buffers of all Neighbors
+      if constexpr (IsHostArray<T>) {
+         if (OnCollective) {
+            IErr = finishNeighborCollective();
+            for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+               if (RecvFlags[MyElem][INghbr]) {
+                  MyNeighbor = &Neighbors[INghbr];
+                  unpackBuffer(Array);
+               }
+            }
+            OnCollective = false;
+            return IErr;
          }
       }
 
-      // Call MPI_Isend for each Neighbor to send the packed buffers
-      startSends();
+      // Reset communication flags for each Neighbor
+      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+         Neighbors[INghbr].Received = false;
+         Neighbors[INghbr].Unpacked = false;
+      }
 
       // Wait for all sends to complete before proceeding
       for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
@@ -377,7 +873,11 @@ class Halo {
                   }
                }
                if (MyNeighbor->Received and not MyNeighbor->Unpacked) {
-                  unpackBuffer(Array);
+                  if constexpr (IsHostArray<T>) {
+                     unpackBuffer(Array);
+                  } else {
+                     unpackBufferDevice(Array);
+                  }
                   MyNeighbor->Unpacked = true;
                }
             }
@@ -394,11 +894,90 @@ class Halo {
          }
       }
 
+      // Device unpack kernels must be complete before the receive buffers
+      // can be reused by another exchange
+      if (OnDevice)
+         Kokkos::fence();
+
+      // Return persistent buffers and requests to the cache
+      if (CurPersistent != nullptr) {
+         swapCommBuffers(*CurPersistent);
+         CurPersistent = nullptr;
+      }
+
       return IErr;
-   } // end exchangeFullArrayHalo
+   } // end finishArrayExchange
+
+   /// HaloGroup is a friend class to allow access to the buffer packing and
+   /// unpacking functions
+   friend class HaloGroup;
 
 }; // end class Halo
 
+/// The HaloGroup class collects several arrays, possibly defined on different
+/// index spaces and of different types and dimensionality, so that their
+/// halos can be exchanged together with Halo::exchangeGroupHalo using one
+/// message per neighboring task instead of one per array. Arrays are
+/// registered by reference to their data (Kokkos views are shallow copies),
+/// so a group must be rebuilt if the arrays are reallocated or swapped.
+/// Device arrays are exchanged through host copies.
+class HaloGroup {
+ private:
+   /// Information needed to pack and unpack one registered array
+   struct GroupField {
+      MeshElement Elem; /// index space the array is defined on
+      I4 TotSize;       /// array elements per mesh element
+      /// Pack the array into (unpack from) the host buffers of the current
+      /// Neighbor of the input Halo
+      std::function<void(Halo *)> Pack, Unpack;
+      /// Copy device arrays to and from their host copies, empty for
+      /// host arrays
+      std::function<void()> CopyToHost, CopyToDevice;
+   };
+
+   std::vector<GroupField> Fields; /// arrays registered in this group
+
+ public:
+   /// Register an array defined on index space ThisElem with the group
+   template <typename T>
+   void add(const T &Array,      ///< [in] Kokkos array of any supported type
+            MeshElement ThisElem ///< [in] index space Array is defined on
+   ) {
+      GroupField NewField;
+      NewField.Elem    = ThisElem;
+      NewField.TotSize = Halo::arrayTotSize(Array);
+
+      if constexpr (Halo::IsHostArray<T>) {
+         NewField.Pack   = [Array](Halo *MyHalo) { MyHalo->packBuffer(Array); };
+         NewField.Unpack = [Array](Halo *MyHalo) mutable {
+            MyHalo->unpackBuffer(Array);
+         };
+      } else {
+         auto ArrayH     = createHostMirrorCopy(Array);
+         NewField.Pack   = [ArrayH](Halo *MyHalo) {
+            MyHalo->packBuffer(ArrayH);
+         };
+         NewField.Unpack = [ArrayH](Halo *MyHalo) mutable {
+            MyHalo->unpackBuffer(ArrayH);
+         };
+         NewField.CopyToHost   = [Array, ArrayH]() { deepCopy(ArrayH, Array); };
+         NewField.CopyToDevice = [Array, ArrayH]() { deepCopy(Array, ArrayH); };
+      }
+
+      Fields.push_back(std::move(NewField));
+   }
+
+   /// Remove all arrays from the group
+   void clear() { Fields.clear(); }
+
+   /// Number of arrays registered in the group
+   I4 size() const { return Fields.size(); }
+
+   /// Halo is a friend class to allow access to the registered arrays
+   friend class Halo;
+
+}; // end class HaloGroup
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
@@ -14,8 +14,11 @@
 #include "mpi.h"
 #include "pio.h"
 
+#include <algorithm>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace OMEGA {
 namespace IO {
@@ -25,6 +28,13 @@ namespace IO {
 int SysID               = 0;
 FileFmt DefaultFileFmt  = FmtDefault;
 Rearranger DefaultRearr = RearrDefault;
+int NodeSysID           = -1;
+MPI_Comm NodeComm       = MPI_COMM_NULL;
+int NodeID              = 0;
+int NumNodes            = 1;
+
+// Decompositions defined on the node IO system, which must be freed there
+static std::set<int> NodeDecomps;
 
 // Utilities
 //------------------------------------------------------------------------------
@@ -84,8 +94,12 @@ FileFmtFromString(const std::string &Format // [in] choice of IO file format
    if (FmtCompare == "netcdf4") {
       ReturnFileFmt = FmtNetCDF4;
 
-      // Check for ADIOS
-   } else if (FmtCompare == "adios") {
+      // Check for ADIOS, which uses the ADIOS2 library underneath. The ADIOS2
+      // engine (eg BP5 or SST) is configured through the ADIOS2 runtime
+      // configuration so all engine names map to the same format
+   } else if (FmtCompare == "adios" or FmtCompare == "adios2" or
+              FmtCompare == "adios2-bp5" or FmtCompare == "bp5" or
+              FmtCompare == "adios2-sst") {
       ReturnFileFmt = FmtADIOS;
 
       // Check specific netcdf4 variants - compressed
@@ -207,13 +221,70 @@ int init(const MPI_Comm &InComm // [in] MPI communicator to use
    DefaultRearr = Rearrange;
    Err          = PIOc_Init_Intracomm(InComm, NumIOTasks, IOStride, IOBaseTask,
                                       Rearrange, &SysID);
-   if (Err != 0)
+   if (Err != 0) {
       LOG_ERROR("IO::init: Error initializing SCORPIO");
+      return Err;
+   }
+
+   // Group the tasks sharing memory on each node for node subfiles. The
+   // nodes are numbered in the order of their first task, which is the
+   // number of first tasks before it.
+   if (NodeComm != MPI_COMM_NULL)
+      MPI_Comm_free(&NodeComm);
+   Err = MPI_Comm_split_type(InComm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                             &NodeComm);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("IO::init: Error creating node communicator");
+      return Err;
+   }
+   int MyTask;
+   int NodeTask;
+   MPI_Comm_rank(InComm, &MyTask);
+   MPI_Comm_rank(NodeComm, &NodeTask);
+   int IsFirst = NodeTask == 0 ? 1 : 0;
+   NodeID      = 0;
+   MPI_Exscan(&IsFirst, &NodeID, 1, MPI_INT, MPI_SUM, InComm);
+   if (MyTask == 0)
+      NodeID = 0; // result of exscan undefined on first task
+   MPI_Bcast(&NodeID, 1, MPI_INT, 0, NodeComm);
+   MPI_Allreduce(&IsFirst, &NumNodes, 1, MPI_INT, MPI_SUM, InComm);
+   NodeSysID = -1;
 
    return Err;
 
 } // end init
 
+//------------------------------------------------------------------------------
+// Initializes the IO system for node subfiles if not yet defined. The first
+// task on the node is the only IO task and the default rearranger gathers
+// the data of the other tasks to it within the node.
+int initNodeIO() {
+
+   int Err = 0;
+
+   if (NodeSysID >= 0)
+      return Err;
+
+   if (NodeComm == MPI_COMM_NULL) {
+      LOG_ERROR("IO::initNodeIO: IO must be initialized first");
+      return 1;
+   }
+
+   int NumIOTasks = 1;
+   int IOStride   = 1;
+   int IOBaseTask = 0;
+   Err = PIOc_Init_Intracomm(NodeComm, NumIOTasks, IOStride, IOBaseTask,
+                             DefaultRearr, &NodeSysID);
+   if (Err != 0) {
+      LOG_ERROR("IO::initNodeIO: Error initializing SCORPIO for node {}",
+                NodeID);
+      NodeSysID = -1;
+   }
+
+   return Err;
+
+} // end initNodeIO
+
 //------------------------------------------------------------------------------
 // This routine opens a file for reading or writing, depending on the
 // Mode argument. The filename with full path must be supplied and
@@ -228,17 +299,30 @@ int openFile(
     const std::string &Filename, // [in] name (incl path) of file to open
     Mode InMode,                 // [in] mode (read or write)
     FileFmt InFormat,            // [in] (optional) file format
-    IfExists InIfExists          // [in] (for writes) behavior if file exists
+    IfExists InIfExists,         // [in] (for writes) behavior if file exists
+    bool NodeSubfile             // [in] open a node subfile
 ) {
 
    int Err    = 0;        // default success return code
    int Format = InFormat; // coerce to integer for PIO calls
 
+   // Node subfiles are opened on the node IO system
+   int FileSysID = SysID;
+   if (NodeSubfile) {
+      if (NodeSysID < 0) {
+         LOG_ERROR("IO::openFile: node IO not initialized for file {}",
+                   Filename);
+         return 1;
+      }
+      FileSysID = NodeSysID;
+   }
+
    switch (InMode) {
 
    // If reading, open the file for read-only
    case ModeRead:
-      Err = PIOc_openfile(SysID, &FileID, &Format, Filename.c_str(), InMode);
+      Err = PIOc_openfile(FileSysID, &FileID, &Format, Filename.c_str(),
+                          InMode);
       if (Err != PIO_NOERR)
          LOG_ERROR("IO::openFile: PIO error opening file {} for read",
                    Filename);
@@ -252,7 +336,7 @@ int openFile(
       // If the write should be a new file and fail if the
       // file exists, we use create and fail with an error
       case IfExists::Fail:
-         Err = PIOc_createfile(SysID, &FileID, &Format, Filename.c_str(),
+         Err = PIOc_createfile(FileSysID, &FileID, &Format, Filename.c_str(),
                                NC_NOCLOBBER | InMode);
          if (Err != PIO_NOERR)
             LOG_ERROR("IO::openFile: PIO error opening file {} for writing",
@@ -262,7 +346,7 @@ int openFile(
       // If the write should replace any existing file
       // we use create with the CLOBBER option
       case IfExists::Replace:
-         Err = PIOc_createfile(SysID, &FileID, &Format, Filename.c_str(),
+         Err = PIOc_createfile(FileSysID, &FileID, &Format, Filename.c_str(),
                                NC_CLOBBER | InMode);
          if (Err != PIO_NOERR)
             LOG_ERROR("IO::openFile: PIO error opening file {} for writing",
@@ -272,7 +356,8 @@ int openFile(
       // If the write should append or add to an existing file
       // we open the file for writing
       case IfExists::Append:
-         Err = PIOc_openfile(SysID, &FileID, &Format, Filename.c_str(), InMode);
+         Err = PIOc_openfile(FileSysID, &FileID, &Format, Filename.c_str(),
+                             InMode);
          if (Err != PIO_NOERR)
             LOG_ERROR("IO::openFile: PIO error opening file {} for writing",
                       Filename);
@@ -620,6 +705,46 @@ int defineVar(int FileID,                 // [in] ID of the file containing dim
 
 } // End defineVar
 
+//------------------------------------------------------------------------------
+// Defines the chunk sizes used to store a variable in a NetCDF4/HDF5 file
+int defineVarChunking(int FileID, // [in] ID of the file containing var
+                      int VarID,  // [in] ID of the variable
+                      const std::vector<int> &ChunkSizes // [in] chunk sizes
+) {
+
+   int Err = 0;
+
+   std::vector<PIO_Offset> Chunks(ChunkSizes.begin(), ChunkSizes.end());
+   Err = PIOc_def_var_chunking(FileID, VarID, NC_CHUNKED, Chunks.data());
+   if (Err != PIO_NOERR) {
+      LOG_ERROR("IO::defineVarChunking: PIO error while defining chunks");
+      Err = -1;
+   }
+
+   return Err;
+
+} // End defineVarChunking
+
+//------------------------------------------------------------------------------
+// Enables deflate compression for a variable in a NetCDF4/HDF5 file
+int defineVarDeflate(int FileID,       // [in] ID of the file containing var
+                     int VarID,        // [in] ID of the variable
+                     int DeflateLevel, // [in] compression level (1-9)
+                     bool Shuffle      // [in] flag to use shuffle filter
+) {
+
+   int Err = 0;
+
+   Err = PIOc_def_var_deflate(FileID, VarID, Shuffle ? 1 : 0, 1, DeflateLevel);
+   if (Err != PIO_NOERR) {
+      LOG_ERROR("IO::defineVarDeflate: PIO error while defining compression");
+      Err = -1;
+   }
+
+   return Err;
+
+} // End defineVarDeflate
+
 //------------------------------------------------------------------------------
 /// Ends define phase signifying all field definitions and metadata
 /// have been written and the larger data sets can now be written
@@ -647,11 +772,18 @@ int createDecomp(
     const std::vector<int> &DimLengths, // [in] global dimension lengths
     int Size,                           // [in] local size of array
     const std::vector<int> &GlobalIndx, // [in] global indx for each local indx
-    Rearranger Rearr                    // [in] rearranger method to use
+    Rearranger Rearr,                   // [in] rearranger method to use
+    bool NodeSubfile                    // [in] decomp for a node subfile
 ) {
 
    int Err = 0; // default return code
 
+   int DecompSysID = NodeSubfile ? NodeSysID : SysID;
+   if (DecompSysID < 0) {
+      LOG_ERROR("IO::createDecomp: node IO not initialized");
+      return 1;
+   }
+
    // Convert global index array into an offset array expected by PIO
    std::vector<PIO_Offset> CompMap;
    CompMap.resize(Size);
@@ -663,10 +795,12 @@ int createDecomp(
    // int TmpRearr = Rearr; // needed for type compliance across interface
    // Err = PIOc_InitDecomp(SysID, VarType, NDims, DimLengths, Size, CompMap,
    //                      &DecompID, &TmpRearr, nullptr, nullptr);
-   Err = PIOc_init_decomp(SysID, VarType, NDims, &DimLengths[0], Size,
+   Err = PIOc_init_decomp(DecompSysID, VarType, NDims, &DimLengths[0], Size,
                           &CompMap[0], &DecompID, Rearr, nullptr, nullptr);
    if (Err != PIO_NOERR)
       LOG_ERROR("IO::createDecomp: PIO error defining decomposition");
+   else if (NodeSubfile)
+      NodeDecomps.insert(DecompID);
 
    return Err;
 
@@ -677,7 +811,11 @@ int createDecomp(
 int destroyDecomp(int &DecompID // [inout] ID for decomposition to be removed
 ) {
 
-   int Err = PIOc_freedecomp(SysID, DecompID);
+   int DecompSysID = SysID;
+   if (NodeDecomps.erase(DecompID) > 0)
+      DecompSysID = NodeSysID;
+
+   int Err = PIOc_freedecomp(DecompSysID, DecompID);
    if (Err != PIO_NOERR)
       LOG_ERROR("IO::destroyDecomp: PIO error freeing decomposition");
 
@@ -716,6 +854,51 @@ int readArray(void *Array,                // [out] array to be read
 
 } // End IOReadArray
 
+//------------------------------------------------------------------------------
+// Reads a batch of distributed arrays from an open file. The variable IDs
+// are all looked up first and the reads are issued grouped by decomposition.
+
+int readArrays(std::vector<ReadRequest> &Requests, // [inout] reads to do
+               int FileID // [in] ID of open file to read from
+) {
+
+   int Err = 0; // default return code
+
+   // Find all variable IDs before starting any collective read
+   for (ReadRequest &Req : Requests) {
+      Err = PIOc_inq_varid(FileID, Req.VarName.c_str(), &Req.VarID);
+      if (Err != PIO_NOERR) {
+         LOG_ERROR("IO::readArrays: Error finding varid for variable {}",
+                   Req.VarName);
+         return Err;
+      }
+   }
+
+   // Order the reads by decomposition, keeping the requested order within
+   // each decomposition
+   std::vector<int> Order(Requests.size());
+   for (int I = 0; I < Order.size(); ++I)
+      Order[I] = I;
+   std::stable_sort(Order.begin(), Order.end(), [&Requests](int A, int B) {
+      return Requests[A].DecompID < Requests[B].DecompID;
+   });
+
+   for (int I : Order) {
+      ReadRequest &Req = Requests[I];
+      PIO_Offset ASize = Req.Size;
+      Err = PIOc_read_darray(FileID, Req.VarID, Req.DecompID, ASize, Req.Array);
+      if (Err != PIO_NOERR) {
+         LOG_ERROR("IO::readArrays: Error in SCORPIO read array for "
+                   "variable {}",
+                   Req.VarName);
+         return Err;
+      }
+   }
+
+   return Err;
+
+} // end readArrays
+
 //------------------------------------------------------------------------------
 // Writes a distributed array. This generic interface uses void pointers.
 // All arrays are assumed to be in contiguous storage and the variable
@@ -33,6 +33,11 @@
 ///    #  netCDF file formats as well as the ADIOS format.
 ///    IODefaultFormat: NetCDF4
 /// \EndConfigInput
+///
+/// The tasks sharing memory on a node are also grouped on initialization so
+/// that streams can be written as one subfile per node. Node subfiles use a
+/// separate IO system with one IO task per node, which aggregates the data of
+/// the other tasks on the node and is the only task writing the subfile.
 //
 //===----------------------------------------------------------------------===//
 
@@ -42,6 +47,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace OMEGA {
 namespace IO {
@@ -107,6 +113,19 @@ extern FileFmt DefaultFileFmt;
 /// be assumed if not overridden during file open.
 extern Rearranger DefaultRearr;
 
+/// The IO system id for node subfiles, with one IO task per node. It is
+/// negative until defined by initNodeIO.
+extern int NodeSysID;
+
+/// Communicator of the MPI tasks sharing memory on this node, defined on IO
+/// initialization
+extern MPI_Comm NodeComm;
+
+/// Index of this node, ordered by the first MPI task on each node, and the
+/// number of nodes
+extern int NodeID;
+extern int NumNodes;
+
 // Utilities
 
 /// Converts string choice for PIO rearranger to an enum
@@ -133,6 +152,10 @@ IfExists IfExistsFromString(
 int init(const MPI_Comm &InComm ///< [in] MPI communicator to use
 );
 
+/// Initializes the IO system for node subfiles if not yet defined. Must be
+/// called by all tasks on the node.
+int initNodeIO();
+
 /// This routine opens a file for reading or writing, depending on the
 /// Mode argument. The filename with full path must be supplied and
 /// a FileID is returned to be used by other IO functions.
@@ -140,13 +163,15 @@ int init(const MPI_Comm &InComm ///< [in] MPI communicator to use
 /// but can be optionally changed through this open function.
 /// For files to be written, optional arguments govern the behavior to be
 /// used if the file already exists, and the precision of any floating point
-/// variables. Returns an error code.
+/// variables. If NodeSubfile is true, the file is opened by the tasks of
+/// this node only using the node IO system. Returns an error code.
 int openFile(
     int &FileID,                    ///< [out] returned fileID for this file
     const std::string &Filename,    ///< [in] name (incl path) of file to open
     Mode Mode,                      ///< [in] mode (read or write)
     FileFmt Format    = FmtDefault, ///< [in] (optional) file format
-    IfExists IfExists = IfExists::Fail ///< [in] behavior if file exists
+    IfExists IfExists = IfExists::Fail, ///< [in] behavior if file exists
+    bool NodeSubfile  = false ///< [in] (optional) open a node subfile
 );
 
 /// Closes an open file using the fileID, returns an error code
@@ -241,13 +266,32 @@ int defineVar(int FileID, ///< [in] ID of the file containing dim
               int &VarID   ///< [out] id assigned to this variable
 );
 
+/// Defines the chunk sizes (one per dimension) used to store a variable in
+/// a NetCDF4/HDF5 output file. Must be called after the variable is defined
+/// and before the define phase ends.
+int defineVarChunking(int FileID, ///< [in] ID of the file containing var
+                      int VarID,  ///< [in] ID of the variable
+                      const std::vector<int> &ChunkSizes ///< [in] chunk sizes
+);
+
+/// Enables deflate compression with the given level (1-9) for a variable in
+/// a NetCDF4/HDF5 output file, optionally with the byte shuffle filter that
+/// improves compression of floating point data. Must be called after the
+/// variable is defined and before the define phase ends.
+int defineVarDeflate(int FileID,       ///< [in] ID of the file containing var
+                     int VarID,        ///< [in] ID of the variable
+                     int DeflateLevel, ///< [in] compression level (1-9)
+                     bool Shuffle      ///< [in] flag to use shuffle filter
+);
+
 /// Ends define mode signifying all field definitions and metadata
 /// have been written and the larger data sets can now be written
 int endDefinePhase(int FileID ///< [in] ID of the file being written
 );
 
 /// Creates a PIO decomposition description to describe the layout of
-/// a distributed array of given type.
+/// a distributed array of given type. Decompositions for node subfiles are
+/// defined on the node IO system, with lengths and indices in the subfile.
 int createDecomp(
     int &DecompID,                      ///< [out] ID for the new decomposition
     IODataType VarType,                 ///< [in] data type of array
@@ -255,7 +299,8 @@ int createDecomp(
     const std::vector<int> &DimLengths, ///< [in] global dimension lengths
     int Size,                           ///< [in] local size of array
     const std::vector<int> &GlobalIndx, ///< [in] global indx for each loc indx
-    Rearranger Rearr                    ///< [in] rearranger method to use
+    Rearranger Rearr,                   ///< [in] rearranger method to use
+    bool NodeSubfile = false ///< [in] (optional) decomp for a node subfile
 );
 
 /// Removes a PIO decomposition to free memory.
@@ -275,6 +320,24 @@ int readArray(void *Array,                ///< [out] array to be read
               int &VarID    ///< [out] variable ID in case metadata needed
 );
 
+/// A single distributed array read, used to batch the reads of several
+/// variables from the same file in readArrays
+struct ReadRequest {
+   void *Array;         ///< [out] array to be read
+   int Size;            ///< [in] local size of array
+   std::string VarName; ///< [in] name of variable to read
+   int DecompID;        ///< [in] decomposition ID for this var
+   int VarID = -1;      ///< [out] variable ID in case metadata needed
+};
+
+/// Reads a batch of distributed arrays from an open file. All variable IDs
+/// are looked up before any data is read, so a missing variable is reported
+/// before the collective reads begin, and the reads are then issued grouped
+/// by decomposition so that consecutive reads share the same rearrangement.
+int readArrays(std::vector<ReadRequest> &Requests, ///< [inout] reads to do
+               int FileID ///< [in] ID of open file to read from
+);
+
 /// Writes a distributed array. A void pointer is used to create a generic
 /// interface. Arrays are assumed to be in contiguous storage and the variable
 /// must have a valid ID assigned by the defineVar function. A void pointer
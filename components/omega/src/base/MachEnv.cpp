@@ -15,8 +15,14 @@
 #include "MachEnv.h"
 #include "mpi.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
+#include <vector>
+
+#ifdef OMEGA_THREADED
+#include <omp.h>
+#endif
 
 namespace OMEGA {
 
@@ -55,8 +61,9 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
    MemberFlag = true;
 
 #ifdef OMEGA_THREADED
-   // total number of OpenMP threads
-   NumThreads = omp_get_num_threads();
+   // total number of OpenMP threads available to parallel regions; the
+   // thread count inside the current (serial) region is always one
+   NumThreads = omp_get_max_threads();
 #else
    NumThreads = 1;
 #endif
@@ -142,8 +149,9 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
    }
 
 #ifdef OMEGA_THREADED
-   // total number of OpenMP threads
-   NumThreads = omp_get_num_threads();
+   // total number of OpenMP threads available to parallel regions; the
+   // thread count inside the current (serial) region is always one
+   NumThreads = omp_get_max_threads();
 #else
    NumThreads = 1;
 #endif
@@ -230,8 +238,9 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
    }
 
 #ifdef OMEGA_THREADED
-   // total number of OpenMP threads
-   NumThreads = omp_get_num_threads();
+   // total number of OpenMP threads available to parallel regions; the
+   // thread count inside the current (serial) region is always one
+   NumThreads = omp_get_max_threads();
 #else
    NumThreads = 1;
 #endif
@@ -317,8 +326,9 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
    }
 
 #ifdef OMEGA_THREADED
-   // total number of OpenMP threads
-   NumThreads = omp_get_num_threads();
+   // total number of OpenMP threads available to parallel regions; the
+   // thread count inside the current (serial) region is always one
+   NumThreads = omp_get_max_threads();
 #else
    NumThreads = 1;
 #endif
@@ -437,6 +447,22 @@ int MachEnv::setMasterTask(const int TaskID) {
 
 } // end setMasterTask
 
+//------------------------------------------------------------------------------
+// Select the vertical chunk width from the instantiated widths
+
+int selectVecWidth(int NVertLevels // [in] number of vertical levels
+) {
+
+   const int MaxWidth = std::min(MaxVecWidth, NVertLevels);
+
+   for (int Width : {32, 16, 8, 4}) {
+      if (Width <= MaxWidth)
+         return Width;
+   }
+   return 1;
+
+} // end selectVecWidth
+
 //------------------------------------------------------------------------------
 // Print all members of a MachEnv
 
@@ -449,6 +475,33 @@ void MachEnv::print() const {
    LOG_INFO("  MemberFlag     = {}", MemberFlag);
    LOG_INFO("  NumThreads     = {}", NumThreads);
    LOG_INFO("  VecLength      = {}", VecLength);
+   LOG_INFO("  MaxVecWidth    = {}", MaxVecWidth);
+   LOG_INFO("  HostThreads    = {}",
+            Kokkos::DefaultHostExecutionSpace().concurrency());
+
+#ifdef OMEGA_THREADED
+   // Report the thread binding so that NUMA placement of first-touch
+   // allocations can be checked against the intended affinity
+   const char *BindNames[] = {"false", "true", "primary", "close", "spread"};
+   int ProcBind            = static_cast<int>(omp_get_proc_bind());
+   if (ProcBind >= 0 and ProcBind < 5) {
+      LOG_INFO("  ProcBind       = {}", BindNames[ProcBind]);
+   } else {
+      LOG_INFO("  ProcBind       = {}", ProcBind);
+   }
+   LOG_INFO("  NumPlaces      = {}", omp_get_num_places());
+
+   std::vector<int> ThreadPlaces(NumThreads, -1);
+#pragma omp parallel num_threads(NumThreads)
+   {
+      int Thread = omp_get_thread_num();
+      if (Thread < NumThreads)
+         ThreadPlaces[Thread] = omp_get_place_num();
+   }
+   for (int Thread = 0; Thread < NumThreads; ++Thread) {
+      LOG_INFO("  Thread {:4d} on place {}", Thread, ThreadPlaces[Thread]);
+   }
+#endif
 
 } // end print
 
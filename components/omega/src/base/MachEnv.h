@@ -19,6 +19,7 @@
 
 #include "mpi.h"
 
+#include "DataTypes.h"
 #include "Logging.h"
 #include <map>
 #include <memory>
@@ -35,6 +36,84 @@ constexpr int VecLength = OMEGA_VECTOR_LENGTH;
 constexpr int VecLength = 1;
 #endif
 
+// The vertical loops of the tendency and auxiliary kernels are blocked in
+// chunks whose width is a template parameter of the kernels. The kernels are
+// instantiated for each of the widths below and the width used at run time
+// is chosen by selectVecWidth from the target architecture and the number of
+// vertical levels. GPU builds only use a width of one. When the width does
+// not divide the number of levels, the last chunk is a shorter tail chunk.
+#if defined(OMEGA_ENABLE_CUDA) || defined(OMEGA_ENABLE_HIP)
+constexpr int MaxVecWidth = 1;
+#elif defined(OMEGA_VECTOR_LENGTH)
+constexpr int MaxVecWidth = OMEGA_VECTOR_LENGTH;
+#elif defined(__AVX512F__)
+constexpr int MaxVecWidth = 16;
+#elif defined(__AVX__)
+constexpr int MaxVecWidth = 8;
+#else
+constexpr int MaxVecWidth = 4;
+#endif
+
+/// Select the vertical chunk width for a number of vertical levels. This is
+/// the largest instantiated width that does not exceed MaxVecWidth or the
+/// number of levels.
+int selectVecWidth(int NVertLevels ///< [in] number of vertical levels
+);
+
+/// Number of vertical chunks of the input width needed to cover all levels,
+/// including a tail chunk if the width does not divide the number of levels
+KOKKOS_INLINE_FUNCTION int numVertChunks(int Width, int NVertLevels) {
+   return (NVertLevels + Width - 1) / Width;
+}
+
+/// Number of levels in the vertical chunk of width W starting at level
+/// KStart, which is W for all chunks but the tail chunk
+template <int W>
+KOKKOS_INLINE_FUNCTION int chunkLength(int KStart, int NVertLevels) {
+   return Kokkos::min(W, NVertLevels - KStart);
+}
+
+/// Number of levels in the vertical chunk of width W starting at level
+/// KStart of an array whose last dimension is the vertical dimension
+template <int W, class ArrayType>
+KOKKOS_INLINE_FUNCTION int chunkLength(int KStart, const ArrayType &Array) {
+   return chunkLength<W>(KStart, Array.extent_int(ArrayType::rank - 1));
+}
+
+/// True if the vertical chunk of width W with index KChunk contains any of
+/// the active levels MinLevel to MaxLevel (inclusive) of a mesh element.
+/// Kernels skip the chunks that lie entirely above or below the active levels.
+template <int W>
+KOKKOS_INLINE_FUNCTION bool isActiveChunk(int KChunk, int MinLevel,
+                                          int MaxLevel) {
+   return KChunk * W <= MaxLevel && (KChunk + 1) * W > MinLevel;
+}
+
+/// Call the template Func<W>(...) with the compile-time chunk width W equal
+/// to the runtime width Width returned by selectVecWidth
+#if defined(OMEGA_ENABLE_CUDA) || defined(OMEGA_ENABLE_HIP)
+#define OMEGA_DISPATCH_VEC_WIDTH(Width, Func, ...) Func<1>(__VA_ARGS__)
+#else
+#define OMEGA_DISPATCH_VEC_WIDTH(Width, Func, ...) \
+   switch (Width) {                                \
+   case 32:                                        \
+      Func<32>(__VA_ARGS__);                       \
+      break;                                       \
+   case 16:                                        \
+      Func<16>(__VA_ARGS__);                       \
+      break;                                       \
+   case 8:                                         \
+      Func<8>(__VA_ARGS__);                        \
+      break;                                       \
+   case 4:                                         \
+      Func<4>(__VA_ARGS__);                        \
+      break;                                       \
+   default:                                        \
+      Func<1>(__VA_ARGS__);                        \
+      break;                                       \
+   }
+#endif
+
 /// The MachEnv class is a container that holds information on
 /// the message passing, threading and node environment.
 class MachEnv {
@@ -0,0 +1,222 @@
+#ifndef OMEGA_PACK_H
+#define OMEGA_PACK_H
+//===-- base/Pack.h - packs of vertical levels ------------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines a pack type for the vertical chunks of Omega kernels
+///
+/// The tendency and auxiliary variable kernels work on vertical chunks of W
+/// levels. A Pack holds one value for each level of a chunk and supplies
+/// element-wise arithmetic, comparison and selection, so that a functor can be
+/// written as a sequence of whole-chunk operations. Every operation is a loop
+/// of fixed length W with a vectorization hint, which the compiler turns into
+/// vector instructions without having to analyze the surrounding loop nest.
+/// The chunk width is one in GPU builds, where a Pack reduces to a scalar.
+///
+/// Packs are loaded from and stored to arrays whose last dimension is the
+/// vertical dimension with loadPack and storePack. The tail chunk, which is
+/// shorter than W when W does not divide the number of levels, is loaded with
+/// zeros in the lanes past the last level and only its valid lanes are
+/// stored, so results in the unused lanes (including divisions by zero) are
+/// discarded.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+
+namespace OMEGA {
+
+/// Hint that the fixed-length loops over the lanes of a pack should be
+/// vectorized. Device code is compiled with a chunk width of one.
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+#define OMEGA_SIMD_LOOP
+#elif defined(__INTEL_LLVM_COMPILER) || defined(__INTEL_COMPILER)
+#define OMEGA_SIMD_LOOP _Pragma("omp simd")
+#elif defined(__clang__)
+#define OMEGA_SIMD_LOOP _Pragma("clang loop vectorize(enable)")
+#elif defined(__GNUC__)
+#define OMEGA_SIMD_LOOP _Pragma("GCC ivdep")
+#else
+#define OMEGA_SIMD_LOOP
+#endif
+
+/// A pack of W values of type T, one for each level of a vertical chunk
+template <class T, int W> class Pack {
+ public:
+   T V[W]; ///< values of the lanes
+
+   /// Default constructor initializes all lanes to zero
+   KOKKOS_INLINE_FUNCTION Pack() {
+      OMEGA_SIMD_LOOP
+      for (int I = 0; I < W; ++I)
+         V[I] = T(0);
+   }
+
+   /// Constructs a pack with the input value in all lanes
+   KOKKOS_INLINE_FUNCTION Pack(const T &Val) {
+      OMEGA_SIMD_LOOP
+      for (int I = 0; I < W; ++I)
+         V[I] = Val;
+   }
+
+   /// Access to a single lane
+   KOKKOS_INLINE_FUNCTION T &operator[](int I) { return V[I]; }
+   KOKKOS_INLINE_FUNCTION const T &operator[](int I) const { return V[I]; }
+
+#define OMEGA_PACK_ASSIGN_OP(OP)                                    \
+   KOKKOS_INLINE_FUNCTION Pack &operator OP(const Pack &Other) {  \
+      OMEGA_SIMD_LOOP                                               \
+      for (int I = 0; I < W; ++I)                                   \
+         V[I] OP Other.V[I];                                        \
+      return *this;                                                 \
+   }                                                                \
+   KOKKOS_INLINE_FUNCTION Pack &operator OP(const T &Val) {       \
+      OMEGA_SIMD_LOOP                                               \
+      for (int I = 0; I < W; ++I)                                   \
+         V[I] OP Val;                                               \
+      return *this;                                                 \
+   }
+
+   OMEGA_PACK_ASSIGN_OP(+=)
+   OMEGA_PACK_ASSIGN_OP(-=)
+   OMEGA_PACK_ASSIGN_OP(*=)
+   OMEGA_PACK_ASSIGN_OP(/=)
+
+#undef OMEGA_PACK_ASSIGN_OP
+
+}; // end class Pack
+
+/// Pack of the default real type
+template <int W> using RealPack = Pack<Real, W>;
+
+/// Pack of flags, the result of comparing packs
+template <int W> using MaskPack = Pack<bool, W>;
+
+// Element-wise arithmetic between packs and between a pack and a scalar
+
+#define OMEGA_PACK_BINARY_OP(OP)                                             \
+   template <class T, int W>                                                 \
+   KOKKOS_INLINE_FUNCTION Pack<T, W> operator OP(const Pack<T, W> &A,        \
+                                                 const Pack<T, W> &B) {      \
+      Pack<T, W> Res;                                                        \
+      OMEGA_SIMD_LOOP                                                        \
+      for (int I = 0; I < W; ++I)                                            \
+         Res.V[I] = A.V[I] OP B.V[I];                                        \
+      return Res;                                                            \
+   }                                                                         \
+   template <class T, int W>                                                 \
+   KOKKOS_INLINE_FUNCTION Pack<T, W> operator OP(const Pack<T, W> &A,        \
+                                                 const T &B) {               \
+      Pack<T, W> Res;                                                        \
+      OMEGA_SIMD_LOOP                                                        \
+      for (int I = 0; I < W; ++I)                                            \
+         Res.V[I] = A.V[I] OP B;                                             \
+      return Res;                                                            \
+   }                                                                         \
+   template <class T, int W>                                                 \
+   KOKKOS_INLINE_FUNCTION Pack<T, W> operator OP(const T &A,                 \
+                                                 const Pack<T, W> &B) {      \
+      Pack<T, W> Res;                                                        \
+      OMEGA_SIMD_LOOP                                                        \
+      for (int I = 0; I < W; ++I)                                            \
+         Res.V[I] = A OP B.V[I];                                             \
+      return Res;                                                            \
+   }
+
+OMEGA_PACK_BINARY_OP(+)
+OMEGA_PACK_BINARY_OP(-)
+OMEGA_PACK_BINARY_OP(*)
+OMEGA_PACK_BINARY_OP(/)
+
+#undef OMEGA_PACK_BINARY_OP
+
+/// Element-wise negation
+template <class T, int W>
+KOKKOS_INLINE_FUNCTION Pack<T, W> operator-(const Pack<T, W> &A) {
+   Pack<T, W> Res;
+   OMEGA_SIMD_LOOP
+   for (int I = 0; I < W; ++I)
+      Res.V[I] = -A.V[I];
+   return Res;
+}
+
+// Element-wise comparison of a pack with a scalar
+
+#define OMEGA_PACK_COMPARE_OP(OP)                                            \
+   template <class T, int W>                                                 \
+   KOKKOS_INLINE_FUNCTION MaskPack<W> operator OP(const Pack<T, W> &A,       \
+                                                  const T &B) {              \
+      MaskPack<W> Res;                                                       \
+      OMEGA_SIMD_LOOP                                                        \
+      for (int I = 0; I < W; ++I)                                            \
+         Res.V[I] = A.V[I] OP B;                                             \
+      return Res;                                                            \
+   }
+
+OMEGA_PACK_COMPARE_OP(>)
+OMEGA_PACK_COMPARE_OP(<)
+
+#undef OMEGA_PACK_COMPARE_OP
+
+/// Element-wise selection of A where the mask is set and B elsewhere
+template <class T, int W>
+KOKKOS_INLINE_FUNCTION Pack<T, W>
+select(const MaskPack<W> &Mask, const Pack<T, W> &A, const Pack<T, W> &B) {
+   Pack<T, W> Res;
+   OMEGA_SIMD_LOOP
+   for (int I = 0; I < W; ++I)
+      Res.V[I] = Mask.V[I] ? A.V[I] : B.V[I];
+   return Res;
+}
+
+/// Element-wise maximum of two packs
+template <class T, int W>
+KOKKOS_INLINE_FUNCTION Pack<T, W> max(const Pack<T, W> &A,
+                                      const Pack<T, W> &B) {
+   Pack<T, W> Res;
+   OMEGA_SIMD_LOOP
+   for (int I = 0; I < W; ++I)
+      Res.V[I] = Kokkos::max(A.V[I], B.V[I]);
+   return Res;
+}
+
+/// Loads the chunk of KLen levels starting at level KStart of the input array
+/// into a real pack, with Indices selecting all but the last (vertical)
+/// dimension of the array. Lanes past KLen are set to zero.
+template <int W, class ArrayType, class... Indices>
+KOKKOS_INLINE_FUNCTION RealPack<W> loadPack(const ArrayType &Arr, int KStart,
+                                            int KLen, Indices... Idx) {
+   RealPack<W> Res;
+   if (KLen == W) {
+      OMEGA_SIMD_LOOP
+      for (int KVec = 0; KVec < W; ++KVec)
+         Res.V[KVec] = Arr(Idx..., KStart + KVec);
+   } else {
+      for (int KVec = 0; KVec < KLen; ++KVec)
+         Res.V[KVec] = Arr(Idx..., KStart + KVec);
+   }
+   return Res;
+}
+
+/// Stores the first KLen lanes of a pack to the chunk starting at level
+/// KStart of the input array, with Indices selecting all but the last
+/// (vertical) dimension of the array
+template <int W, class ArrayType, class T, class... Indices>
+KOKKOS_INLINE_FUNCTION void storePack(const ArrayType &Arr,
+                                      const Pack<T, W> &Val, int KStart,
+                                      int KLen, Indices... Idx) {
+   using ValueType = typename ArrayType::non_const_value_type;
+   if (KLen == W) {
+      OMEGA_SIMD_LOOP
+      for (int KVec = 0; KVec < W; ++KVec)
+         Arr(Idx..., KStart + KVec) = static_cast<ValueType>(Val.V[KVec]);
+   } else {
+      for (int KVec = 0; KVec < KLen; ++KVec)
+         Arr(Idx..., KStart + KVec) = static_cast<ValueType>(Val.V[KVec]);
+   }
+}
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_PACK_H
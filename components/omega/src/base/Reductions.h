@@ -8,7 +8,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <cmath>
 #include <complex>
+#include <type_traits>
+#include <vector>
 using std::complex;
 
 #include "DataTypes.h"
@@ -108,7 +111,8 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const MPI_Comm Comm, IT *GlobalSum,
       }
    } else { // on device
       parallelReduce(
-          {imax}, KOKKOS_LAMBDA(int i, IT &Accum) { Accum += arr.data()[i]; },
+          {imax - imin},
+          KOKKOS_LAMBDA(int i, IT &Accum) { Accum += arr.data()[imin + i]; },
           LocalSum);
    }
    if (typeid(IT) == typeid(I4)) {
@@ -140,7 +144,8 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const MPI_Comm Comm, R4 *GlobalSum,
       }
    } else {
       parallelReduce(
-          {imax}, KOKKOS_LAMBDA(int i, R8 &Accum) { Accum += arr.data()[i]; },
+          {imax - imin},
+          KOKKOS_LAMBDA(int i, R8 &Accum) { Accum += arr.data()[imin + i]; },
           LocalSum);
    }
    ierr = MPI_Allreduce(&LocalSum, &GlobalTmp, 1, MPI_DOUBLE, MPI_SUM, Comm);
@@ -184,7 +189,8 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const MPI_Comm Comm, R8 *GlobalSum,
    } else {
       R8 LocalSum = 0.0, GlobalTmp = 0.0;
       parallelReduce(
-          {imax}, KOKKOS_LAMBDA(int i, R8 &Accum) { Accum += arr.data()[i]; },
+          {imax - imin},
+          KOKKOS_LAMBDA(int i, R8 &Accum) { Accum += arr.data()[imin + i]; },
           LocalSum);
       ierr = MPI_Allreduce(&LocalSum, &GlobalTmp, 1, MPI_DOUBLE, MPI_SUM, Comm);
       *GlobalSum = GlobalTmp;
@@ -218,9 +224,9 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const Kokkos::View<T, ML, MS> arr2,
       }
    } else { // on device
       parallelReduce(
-          {imax},
+          {imax - imin},
           KOKKOS_LAMBDA(int i, IT &Accum) {
-             Accum += arr.data()[i] * arr2.data()[i];
+             Accum += arr.data()[imin + i] * arr2.data()[imin + i];
           },
           LocalSum);
    }
@@ -254,9 +260,9 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const Kokkos::View<T, ML, MS> arr2,
       }
    } else {
       parallelReduce(
-          {imax},
+          {imax - imin},
           KOKKOS_LAMBDA(int i, R8 &Accum) {
-             Accum += arr.data()[i] * arr2.data()[i];
+             Accum += arr.data()[imin + i] * arr2.data()[imin + i];
           },
           LocalSum);
    }
@@ -302,9 +308,9 @@ globalSum(const Kokkos::View<T, ML, MS> arr, const Kokkos::View<T, ML, MS> arr2,
    } else {
       R8 LocalSum = 0.0, GlobalTmp = 0.0;
       parallelReduce(
-          {imax},
+          {imax - imin},
           KOKKOS_LAMBDA(int i, R8 &Accum) {
-             Accum += arr.data()[i] * arr2.data()[i];
+             Accum += arr.data()[imin + i] * arr2.data()[imin + i];
           },
           LocalSum);
       ierr = MPI_Allreduce(&LocalSum, &GlobalTmp, 1, MPI_DOUBLE, MPI_SUM, Comm);
@@ -628,6 +634,415 @@ globalSum(const std::vector<Kokkos::View<T, ML, MS>> arrays,
    return ierr;
 }
 
+//////////
+// Global sum batched
+//////////
+// Pointer to the data of one field in a batched sum. Fields are passed to
+// the reduction kernel through a view of these so that all fields can be
+// summed in the same kernel.
+template <typename VT> struct BatchField {
+   const VT *Data;
+};
+
+// Array reduction functor for globalSumBatch. For each owned cell, the
+// values of every field between the min and max level of the cell are
+// accumulated. For reproducible sums, each field is accumulated as a
+// double-double (sum, error) pair using Knuth's algorithm so that the local
+// sums can be combined with the MPI_SUMDD operator.
+template <typename VT, typename ML, typename MS> struct BatchSumFunctor {
+   using value_type = R8[];
+   using size_type  = int;
+
+   size_type value_count; // number of reduction values (nFlds or 2*nFlds)
+   Kokkos::View<BatchField<VT> *, MS> Fields;
+   Kokkos::View<I4 *, ML, MS> MinLevel;
+   Kokkos::View<I4 *, ML, MS> MaxLevel;
+   int nFlds, nLevels, CellStride, LevelStride;
+   bool UseMinLevel, UseMaxLevel, Reproducible;
+
+   KOKKOS_INLINE_FUNCTION void ddAdd(R8 &Sum, R8 &Err, R8 Val,
+                                     R8 ValErr) const {
+      R8 t1 = Val + Sum;
+      R8 e  = t1 - Val;
+      R8 t2 = ((Sum - e) + (Val - (t1 - e))) + ValErr + Err;
+      // The result is t1 + t2, after normalization.
+      Sum = t1 + t2;
+      Err = t2 - ((t1 + t2) - t1);
+   }
+
+   KOKKOS_INLINE_FUNCTION void operator()(int iCell, value_type Sums) const {
+      int kmin = UseMinLevel ? MinLevel(iCell) : 0;
+      int kmax = UseMaxLevel ? MaxLevel(iCell) : nLevels - 1;
+      for (int ifld = 0; ifld < nFlds; ifld++) {
+         const VT *Data = Fields(ifld).Data;
+         for (int k = kmin; k <= kmax; k++) {
+            R8 ai = Data[iCell * CellStride + k * LevelStride];
+            if (Reproducible) {
+               ddAdd(Sums[2 * ifld], Sums[2 * ifld + 1], ai, 0.0);
+            } else {
+               Sums[ifld] += ai;
+            }
+         }
+      }
+   }
+
+   KOKKOS_INLINE_FUNCTION void init(value_type Sums) const {
+      for (int i = 0; i < value_count; i++) {
+         Sums[i] = 0.0;
+      }
+   }
+
+   KOKKOS_INLINE_FUNCTION void join(value_type Dst,
+                                    const value_type Src) const {
+      if (Reproducible) {
+         for (int ifld = 0; ifld < nFlds; ifld++) {
+            ddAdd(Dst[2 * ifld], Dst[2 * ifld + 1], Src[2 * ifld],
+                  Src[2 * ifld + 1]);
+         }
+      } else {
+         for (int i = 0; i < value_count; i++) {
+            Dst[i] += Src[i];
+         }
+      }
+   }
+};
+
+// R4 or R8 1D (cell) or 2D (cell, level) arrays. All arrays must have the
+// same dimensions and layout. The local sums over the first NCellsOwned
+// cells of all arrays are computed in a single kernel in the memory space
+// of the arrays and reduced with a single MPI_Allreduce. For 2D arrays, the
+// levels of each cell can be limited to the range MinLevel(iCell) to
+// MaxLevel(iCell) (0-based, inclusive).
+template <typename T, typename ML, typename MS>
+std::enable_if_t<std::is_floating_point_v<
+                     typename Kokkos::View<T, ML, MS>::value_type> and
+                     (Kokkos::View<T, ML, MS>::rank <= 2),
+                 int>
+globalSumBatch(const std::vector<Kokkos::View<T, ML, MS>> &arrays,
+               const I4 NCellsOwned, const MPI_Comm Comm,
+               std::vector<R8> &GlobalSum,
+               const Kokkos::View<I4 *, ML, MS> *MinLevel = nullptr,
+               const Kokkos::View<I4 *, ML, MS> *MaxLevel = nullptr,
+               const bool Reproducible                   = true) {
+
+   using VT        = typename Kokkos::View<T, ML, MS>::value_type;
+   using ExecSpace = typename MS::execution_space;
+
+   int ifld, ierr;
+   int nFlds = arrays.size();
+   GlobalSum.assign(nFlds, 0.0);
+   if (nFlds == 0) {
+      return 0;
+   }
+   if (Reproducible and !R8SumInitialized) {
+      globalSumInit();
+   }
+
+   // Pass the data pointers of all fields to the kernel
+   Kokkos::View<BatchField<VT> *, MS> Fields("BatchFields", nFlds);
+   auto FieldsH = Kokkos::create_mirror_view(Fields);
+   for (ifld = 0; ifld < nFlds; ifld++) {
+      FieldsH(ifld).Data = arrays[ifld].data();
+   }
+   Kokkos::deep_copy(Fields, FieldsH);
+
+   BatchSumFunctor<VT, ML, MS> Functor;
+   Functor.Fields       = Fields;
+   Functor.nFlds        = nFlds;
+   Functor.Reproducible = Reproducible;
+   Functor.value_count  = Reproducible ? 2 * nFlds : nFlds;
+   Functor.CellStride   = arrays[0].stride(0);
+   Functor.UseMinLevel  = false;
+   Functor.UseMaxLevel  = false;
+   if (arrays[0].rank == 2) {
+      Functor.nLevels     = arrays[0].extent(1);
+      Functor.LevelStride = arrays[0].stride(1);
+      Functor.UseMinLevel = MinLevel != nullptr;
+      Functor.UseMaxLevel = MaxLevel != nullptr;
+      if (MinLevel != nullptr)
+         Functor.MinLevel = *MinLevel;
+      if (MaxLevel != nullptr)
+         Functor.MaxLevel = *MaxLevel;
+   } else {
+      Functor.nLevels     = 1;
+      Functor.LevelStride = 0;
+   }
+
+   std::vector<R8> LocalSum(Functor.value_count, 0.0);
+   Kokkos::parallel_reduce("globalSumBatch",
+                           Kokkos::RangePolicy<ExecSpace>(0, NCellsOwned),
+                           Functor, LocalSum.data());
+
+   if (Reproducible) {
+      std::vector<complex<double>> LocalTmp(nFlds), GlobalTmp(nFlds);
+      for (ifld = 0; ifld < nFlds; ifld++) {
+         LocalTmp[ifld] =
+             complex<double>(LocalSum[2 * ifld], LocalSum[2 * ifld + 1]);
+      }
+      ierr = MPI_Allreduce(LocalTmp.data(), GlobalTmp.data(), nFlds,
+                           MPI_C_DOUBLE_COMPLEX, MPI_SUMDD, Comm);
+      for (ifld = 0; ifld < nFlds; ifld++) {
+         GlobalSum[ifld] = real(GlobalTmp[ifld]);
+      }
+   } else {
+      ierr = MPI_Allreduce(LocalSum.data(), GlobalSum.data(), nFlds,
+                           MPI_DOUBLE, MPI_SUM, Comm);
+   }
+   return ierr;
+}
+
+//////////
+// Global sum reproducible fixed-point
+//////////
+// Each value is represented exactly (or truncated below a fixed resolution)
+// as a fixed-point number with ReproSumNWords signed integer words of
+// ReproSumWordBits bits, scaled by a power of two that depends only on the
+// global maximum magnitude of the field. The words of all values are summed
+// as I8 integers, so the global sum is exact and independent of the order of
+// summation and of the domain decomposition, and the local words of all
+// fields are combined with a single standard MPI_SUM.
+constexpr int ReproSumNWords   = 4;
+constexpr int ReproSumWordBits = 32;
+
+// Normalizes the words of each of nFlds fixed-point sums so that all but the
+// leading word lie in [0, 2^ReproSumWordBits), carrying the excess into the
+// next word. This leaves each sum with a unique representation and makes
+// room in every word for the contributions of other tasks.
+inline void reproSumCarry(std::vector<I8> &Words, const int nFlds) {
+   const I8 Base = I8(1) << ReproSumWordBits;
+   for (int ifld = 0; ifld < nFlds; ifld++) {
+      I8 *W = &Words[ifld * ReproSumNWords];
+      for (int iw = ReproSumNWords - 1; iw > 0; iw--) {
+         I8 Carry = W[iw] / Base;
+         I8 Rem   = W[iw] - Carry * Base;
+         if (Rem < 0) {
+            Rem += Base;
+            Carry -= 1;
+         }
+         W[iw] = Rem;
+         W[iw - 1] += Carry;
+      }
+   }
+}
+
+// Array reduction functor for the maximum magnitude of each field in
+// globalSumRepro, with the same loop over cells and levels as
+// BatchSumFunctor
+template <typename VT, typename ML, typename MS> struct ReproMaxFunctor {
+   using value_type = R8[];
+   using size_type  = int;
+
+   size_type value_count; // number of fields
+   Kokkos::View<BatchField<VT> *, MS> Fields;
+   Kokkos::View<I4 *, ML, MS> MinLevel;
+   Kokkos::View<I4 *, ML, MS> MaxLevel;
+   int nLevels, CellStride, LevelStride;
+   bool UseMinLevel, UseMaxLevel;
+
+   KOKKOS_INLINE_FUNCTION void operator()(int iCell, value_type Maxs) const {
+      int kmin = UseMinLevel ? MinLevel(iCell) : 0;
+      int kmax = UseMaxLevel ? MaxLevel(iCell) : nLevels - 1;
+      for (int ifld = 0; ifld < value_count; ifld++) {
+         const VT *Data = Fields(ifld).Data;
+         for (int k = kmin; k <= kmax; k++) {
+            R8 ai = Data[iCell * CellStride + k * LevelStride];
+            ai    = ai < 0 ? -ai : ai;
+            // the negated test also propagates NaN values
+            if (!(ai <= Maxs[ifld]))
+               Maxs[ifld] = ai;
+         }
+      }
+   }
+
+   KOKKOS_INLINE_FUNCTION void init(value_type Maxs) const {
+      for (int i = 0; i < value_count; i++) {
+         Maxs[i] = 0.0;
+      }
+   }
+
+   KOKKOS_INLINE_FUNCTION void join(value_type Dst,
+                                    const value_type Src) const {
+      for (int i = 0; i < value_count; i++) {
+         if (!(Src[i] <= Dst[i]))
+            Dst[i] = Src[i];
+      }
+   }
+};
+
+// Array reduction functor for the fixed-point words of each field in
+// globalSumRepro. Each value is scaled by the field's Scale so that its
+// magnitude is less than one and is then split into ReproSumNWords integer
+// words. All operations in the split are exact in double precision.
+template <typename VT, typename ML, typename MS> struct ReproSumFunctor {
+   using value_type = I8[];
+   using size_type  = int;
+
+   size_type value_count; // number of words (ReproSumNWords*nFlds)
+   Kokkos::View<BatchField<VT> *, MS> Fields;
+   Kokkos::View<R8 *, MS> Scale;
+   Kokkos::View<I4 *, ML, MS> MinLevel;
+   Kokkos::View<I4 *, ML, MS> MaxLevel;
+   int nFlds, nLevels, CellStride, LevelStride;
+   bool UseMinLevel, UseMaxLevel;
+
+   KOKKOS_INLINE_FUNCTION void operator()(int iCell, value_type Words) const {
+      const R8 WordScale = R8(I8(1) << ReproSumWordBits);
+      int kmin           = UseMinLevel ? MinLevel(iCell) : 0;
+      int kmax           = UseMaxLevel ? MaxLevel(iCell) : nLevels - 1;
+      for (int ifld = 0; ifld < nFlds; ifld++) {
+         const VT *Data    = Fields(ifld).Data;
+         const R8 FldScale = Scale(ifld);
+         I8 *FldWords      = &Words[ifld * ReproSumNWords];
+         for (int k = kmin; k <= kmax; k++) {
+            R8 ai = R8(Data[iCell * CellStride + k * LevelStride]) * FldScale;
+            for (int iw = 0; iw < ReproSumNWords; iw++) {
+               ai *= WordScale;
+               I8 Word = static_cast<I8>(ai); // truncates toward zero
+               ai -= R8(Word);
+               FldWords[iw] += Word;
+            }
+         }
+      }
+   }
+
+   KOKKOS_INLINE_FUNCTION void init(value_type Words) const {
+      for (int i = 0; i < value_count; i++) {
+         Words[i] = 0;
+      }
+   }
+
+   KOKKOS_INLINE_FUNCTION void join(value_type Dst,
+                                    const value_type Src) const {
+      for (int i = 0; i < value_count; i++) {
+         Dst[i] += Src[i];
+      }
+   }
+};
+
+// R4 or R8 1D (cell) or 2D (cell, level) arrays, with the same arguments
+// and cell and level ranges as globalSumBatch. The sums are bit-for-bit
+// identical for any number of tasks and any decomposition of the cells.
+// Values smaller than 2^(-ReproSumNWords*ReproSumWordBits) times the maximum
+// magnitude of a field are truncated. The local sums of each task may have
+// at most 2^31 values per field and the communicator at most 2^31 tasks.
+template <typename T, typename ML, typename MS>
+std::enable_if_t<std::is_floating_point_v<
+                     typename Kokkos::View<T, ML, MS>::value_type> and
+                     (Kokkos::View<T, ML, MS>::rank <= 2),
+                 int>
+globalSumRepro(const std::vector<Kokkos::View<T, ML, MS>> &arrays,
+               const I4 NCellsOwned, const MPI_Comm Comm,
+               std::vector<R8> &GlobalSum,
+               const Kokkos::View<I4 *, ML, MS> *MinLevel = nullptr,
+               const Kokkos::View<I4 *, ML, MS> *MaxLevel = nullptr) {
+
+   using VT        = typename Kokkos::View<T, ML, MS>::value_type;
+   using ExecSpace = typename MS::execution_space;
+
+   int ifld, iw, ierr;
+   int nFlds = arrays.size();
+   GlobalSum.assign(nFlds, 0.0);
+   if (nFlds == 0) {
+      return 0;
+   }
+
+   // Pass the data pointers of all fields to the kernels
+   Kokkos::View<BatchField<VT> *, MS> Fields("ReproFields", nFlds);
+   auto FieldsH = Kokkos::create_mirror_view(Fields);
+   for (ifld = 0; ifld < nFlds; ifld++) {
+      FieldsH(ifld).Data = arrays[ifld].data();
+   }
+   Kokkos::deep_copy(Fields, FieldsH);
+
+   ReproMaxFunctor<VT, ML, MS> MaxFunctor;
+   MaxFunctor.Fields      = Fields;
+   MaxFunctor.value_count = nFlds;
+   MaxFunctor.CellStride  = arrays[0].stride(0);
+   MaxFunctor.UseMinLevel = false;
+   MaxFunctor.UseMaxLevel = false;
+   if (arrays[0].rank == 2) {
+      MaxFunctor.nLevels     = arrays[0].extent(1);
+      MaxFunctor.LevelStride = arrays[0].stride(1);
+      MaxFunctor.UseMinLevel = MinLevel != nullptr;
+      MaxFunctor.UseMaxLevel = MaxLevel != nullptr;
+      if (MinLevel != nullptr)
+         MaxFunctor.MinLevel = *MinLevel;
+      if (MaxLevel != nullptr)
+         MaxFunctor.MaxLevel = *MaxLevel;
+   } else {
+      MaxFunctor.nLevels     = 1;
+      MaxFunctor.LevelStride = 0;
+   }
+
+   // The scale of each field is set from its global maximum magnitude
+   std::vector<R8> LocalMax(nFlds, 0.0), GlobalMax(nFlds, 0.0);
+   Kokkos::parallel_reduce("globalSumReproMax",
+                           Kokkos::RangePolicy<ExecSpace>(0, NCellsOwned),
+                           MaxFunctor, LocalMax.data());
+   ierr = MPI_Allreduce(LocalMax.data(), GlobalMax.data(), nFlds, MPI_DOUBLE,
+                        MPI_MAX, Comm);
+   if (ierr != 0) {
+      return ierr;
+   }
+
+   Kokkos::View<R8 *, MS> Scale("ReproScale", nFlds);
+   auto ScaleH = Kokkos::create_mirror_view(Scale);
+   std::vector<int> MaxExp(nFlds, 0);
+   for (ifld = 0; ifld < nFlds; ifld++) {
+      if (std::isfinite(GlobalMax[ifld])) {
+         // GlobalMax < 2^MaxExp, so all scaled values are less than one
+         std::frexp(GlobalMax[ifld], &MaxExp[ifld]);
+         ScaleH(ifld) = std::ldexp(1.0, -MaxExp[ifld]);
+      } else {
+         // Inf or NaN values cannot be converted and are returned as is
+         ScaleH(ifld) = 0.0;
+      }
+   }
+   Kokkos::deep_copy(Scale, ScaleH);
+
+   ReproSumFunctor<VT, ML, MS> SumFunctor;
+   SumFunctor.Fields      = Fields;
+   SumFunctor.Scale       = Scale;
+   SumFunctor.MinLevel    = MaxFunctor.MinLevel;
+   SumFunctor.MaxLevel    = MaxFunctor.MaxLevel;
+   SumFunctor.nFlds       = nFlds;
+   SumFunctor.value_count = ReproSumNWords * nFlds;
+   SumFunctor.nLevels     = MaxFunctor.nLevels;
+   SumFunctor.CellStride  = MaxFunctor.CellStride;
+   SumFunctor.LevelStride = MaxFunctor.LevelStride;
+   SumFunctor.UseMinLevel = MaxFunctor.UseMinLevel;
+   SumFunctor.UseMaxLevel = MaxFunctor.UseMaxLevel;
+
+   std::vector<I8> LocalWords(SumFunctor.value_count, 0);
+   std::vector<I8> GlobalWords(SumFunctor.value_count, 0);
+   Kokkos::parallel_reduce("globalSumRepro",
+                           Kokkos::RangePolicy<ExecSpace>(0, NCellsOwned),
+                           SumFunctor, LocalWords.data());
+
+   // Normalize the local words so the sum over tasks cannot overflow, then
+   // sum the words of all fields with a single integer allreduce
+   reproSumCarry(LocalWords, nFlds);
+   ierr = MPI_Allreduce(LocalWords.data(), GlobalWords.data(),
+                        SumFunctor.value_count, MPI_INT64_T, MPI_SUM, Comm);
+   reproSumCarry(GlobalWords, nFlds);
+
+   // Convert the normalized words back to R8, starting from the least
+   // significant word, in the same order on every task
+   for (ifld = 0; ifld < nFlds; ifld++) {
+      if (!std::isfinite(GlobalMax[ifld])) {
+         GlobalSum[ifld] = GlobalMax[ifld];
+         continue;
+      }
+      R8 Sum = 0.0;
+      for (iw = ReproSumNWords - 1; iw >= 0; iw--) {
+         Sum += std::ldexp(R8(GlobalWords[ifld * ReproSumNWords + iw]),
+                           MaxExp[ifld] - (iw + 1) * ReproSumWordBits);
+      }
+      GlobalSum[ifld] = Sum;
+   }
+   return ierr;
+}
+
 //////////
 // Global minval
 //////////
@@ -5,12 +5,15 @@
 
 #include "OceanDriver.h"
 #include "DataTypes.h"
+#include "Logging.h"
 #include "OceanState.h"
 #include "OmegaKokkos.h"
 #include "TimeMgr.h"
 
 #include "mpi.h"
 
+#include <unistd.h>
+
 #include <iostream>
 
 int main(int argc, char **argv) {
@@ -19,19 +22,65 @@ int main(int argc, char **argv) {
    int ErrCurr;
    int ErrFinalize;
 
-   MPI_Init(&argc, &argv); // initialize MPI
-   Kokkos::initialize();   // initialize Kokkos
+   // initialize MPI, the mesh file is read in the background during the
+   // initialization if MPI can be called from several threads
+   int ThreadLevel;
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &ThreadLevel);
+   Kokkos::initialize(); // initialize Kokkos
+
+   if (ThreadLevel < MPI_THREAD_MULTIPLE) {
+      int WorldTask;
+      MPI_Comm_rank(MPI_COMM_WORLD, &WorldTask);
+      if (WorldTask == 0)
+         std::cerr << "Warning: MPI_THREAD_MULTIPLE not provided, the mesh "
+                   << "file is read synchronously" << std::endl;
+   }
 
    // Time management objects
    OMEGA::Calendar OmegaCal;
    OMEGA::TimeInstant CurrTime;
    OMEGA::Alarm EndAlarm;
 
-   ErrCurr = OMEGA::ocnInit(MPI_COMM_WORLD, OmegaCal, CurrTime, EndAlarm);
+   // in ensemble mode each member runs in its own communicator from its
+   // own run directory
+   OMEGA::I4 NumMembers = 1;
+   OMEGA::I4 MemberID   = 0;
+   MPI_Comm OcnComm     = MPI_COMM_WORLD;
+
+   ErrCurr = OMEGA::readEnsembleArgs(argc, argv, NumMembers);
+   if (ErrCurr == 0 && NumMembers > 1) {
+      ErrCurr = OMEGA::ocnEnsembleSplit(MPI_COMM_WORLD, NumMembers, MemberID,
+                                        OcnComm);
+      if (ErrCurr == 0) {
+         std::string MemberDir = OMEGA::getEnsembleMemberDir(MemberID);
+         if (chdir(MemberDir.c_str()) != 0) {
+            std::cerr << "Error changing to ensemble member directory "
+                      << MemberDir << std::endl;
+            ErrCurr = 1;
+         }
+      }
+   }
+   if (ErrCurr != 0)
+      MPI_Abort(MPI_COMM_WORLD, ErrCurr);
+
+   ErrCurr = OMEGA::ocnInit(OcnComm, OmegaCal, CurrTime, EndAlarm);
    if (ErrCurr != 0)
       LOG_ERROR("Error initializing OMEGA");
 
-   while (ErrCurr == 0 && !(EndAlarm.isRinging())) {
+   // the optional scaling mode replaces the run interval with a fixed
+   // number of warm-up and timed steps
+   OMEGA::ScalingOptions Scaling;
+   if (ErrCurr == 0)
+      ErrCurr = OMEGA::readScalingOptions(Scaling,
+                                          OMEGA::Config::getOmegaConfig());
+
+   if (ErrCurr == 0 && Scaling.Enabled) {
+      ErrCurr = OMEGA::ocnScalingRun(CurrTime, Scaling);
+      if (ErrCurr != 0)
+         LOG_ERROR("Error in Omega scaling run");
+   }
+
+   while (ErrCurr == 0 && !Scaling.Enabled && !(EndAlarm.isRinging())) {
 
       ErrCurr = OMEGA::ocnRun(CurrTime, EndAlarm);
 
@@ -50,7 +99,12 @@ int main(int argc, char **argv) {
       LOG_ERROR("OMEGA terminating due to error");
    }
 
+   // write any queued log messages
+   OMEGA::finalizeLogging();
+
    Kokkos::finalize();
+   if (OcnComm != MPI_COMM_WORLD)
+      MPI_Comm_free(&OcnComm);
    MPI_Finalize();
 
    if (ErrAll >= 256)
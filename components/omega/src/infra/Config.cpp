@@ -17,46 +17,32 @@
 #include "mpi.h"
 #include "yaml-cpp/yaml.h"
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <string>
 
 namespace OMEGA {
 
 // Declare some of the Config static variables
-const int Config::ReadGroupSize = 20;
-bool Config::NotInitialized     = true;
-int Config::ReadGroupID         = -1;
-int Config::NumReadGroups       = 0;
-MPI_Comm Config::ConfigComm;
 Config Config::ConfigAll;
 
+// Declare the ConfigParams static variables
+bool ConfigParams::Frozen = false;
+std::map<std::string, I4> ConfigParams::ParamIndex;
+std::vector<unsigned char> ConfigParams::ParamTypes;
+std::vector<unsigned char> ConfigParams::BoolValues;
+std::vector<I8> ConfigParams::IntValues;
+std::vector<R8> ConfigParams::RealValues;
+std::vector<std::string> ConfigParams::StrValues;
+
 //------------------------------------------------------------------------------
 // Constructor that creates configuration with a given name and an emtpy
 // YAML node that will be filled later with either a readAll or get call.
 Config::Config(const std::string &InName // [in] name of config, node
 ) {
 
-   // If this is the first Config created, set variables for reading the
-   // input configuration file. In particular, to avoid too many MPI tasks
-   // reading the same input stream, we divide the tasks into groups and
-   // only one group at a time loads the full configuration from a stream
-
-   if (NotInitialized) {
-      // Determine MPI variables
-      MachEnv *DefEnv = MachEnv::getDefault();
-      I4 NumTasks     = DefEnv->getNumTasks();
-      I4 MyTask       = DefEnv->getMyTask();
-      ConfigComm      = DefEnv->getComm();
-
-      // Set number of groups to read and assign tasks to each
-      // group in a round-robin way
-      NumReadGroups = (NumTasks - 1) / ReadGroupSize + 1;
-      ReadGroupID   = MyTask % NumReadGroups;
-
-      NotInitialized = false; // now initialized for future calls
-   }
-
    // Set the name - this is also used as the name of the root YAML node
    // (a map node) in this configuration.
    Name = InName;
@@ -72,34 +58,162 @@ Config::Config(const std::string &InName // [in] name of config, node
 // is created before it can be properly filled.
 Config::Config() {} // end Config constructor
 
+//------------------------------------------------------------------------------
+// Utilities to serialize a YAML node tree into a compact byte buffer and
+// rebuild it from that buffer, so the tree parsed by one task can be sent to
+// other tasks without being parsed again. Each node is written as a type
+// byte followed by its contents: a scalar is its tag and value, a sequence is
+// its length and elements, and a map is its length and key-value pairs with
+// scalar keys. Lengths and string sizes are written as I4 values.
+
+// Kinds of nodes in the serialized buffer
+enum NodeKind : char { NullNode = 0, ScalarNode, SequenceNode, MapNode };
+
+// Appends an I4 value to the buffer
+static void packInt(std::string &Buffer, // [inout] serialized buffer
+                    I4 Value             // [in] value to append
+) {
+   Buffer.append(reinterpret_cast<const char *>(&Value), sizeof(I4));
+}
+
+// Appends a string, preceded by its size, to the buffer
+static void packString(std::string &Buffer,     // [inout] serialized buffer
+                       const std::string &Value // [in] string to append
+) {
+   packInt(Buffer, Value.size());
+   Buffer.append(Value);
+}
+
+// Appends a node and all of its children to the buffer
+static void packNode(std::string &Buffer,     // [inout] serialized buffer
+                     const YAML::Node &InNode // [in] node to serialize
+) {
+   if (InNode.IsScalar()) {
+      Buffer.push_back(ScalarNode);
+      packString(Buffer, InNode.Tag());
+      packString(Buffer, InNode.Scalar());
+   } else if (InNode.IsSequence()) {
+      Buffer.push_back(SequenceNode);
+      packInt(Buffer, InNode.size());
+      for (auto It = InNode.begin(); It != InNode.end(); ++It)
+         packNode(Buffer, *It);
+   } else if (InNode.IsMap()) {
+      Buffer.push_back(MapNode);
+      packInt(Buffer, InNode.size());
+      for (auto It = InNode.begin(); It != InNode.end(); ++It) {
+         packString(Buffer, It->first.Scalar());
+         packNode(Buffer, It->second);
+      }
+   } else {
+      Buffer.push_back(NullNode);
+   }
+}
+
+// Reads an I4 value from the buffer, advancing the position
+static I4 unpackInt(const std::string &Buffer, // [in] serialized buffer
+                    size_t &Pos                // [inout] buffer position
+) {
+   I4 Value;
+   std::memcpy(&Value, Buffer.data() + Pos, sizeof(I4));
+   Pos += sizeof(I4);
+   return Value;
+}
+
+// Reads a string from the buffer, advancing the position
+static std::string unpackString(const std::string &Buffer, // [in] buffer
+                                size_t &Pos // [inout] buffer position
+) {
+   const I4 Size = unpackInt(Buffer, Pos);
+   std::string Value(Buffer, Pos, Size);
+   Pos += Size;
+   return Value;
+}
+
+// Rebuilds a node and all of its children from the buffer, advancing the
+// position
+static YAML::Node unpackNode(const std::string &Buffer, // [in] buffer
+                             size_t &Pos // [inout] buffer position
+) {
+   const char Kind = Buffer[Pos++];
+
+   switch (Kind) {
+   case ScalarNode: {
+      const std::string Tag = unpackString(Buffer, Pos);
+      YAML::Node OutNode(unpackString(Buffer, Pos));
+      OutNode.SetTag(Tag);
+      return OutNode;
+   }
+   case SequenceNode: {
+      YAML::Node OutNode(YAML::NodeType::Sequence);
+      const I4 Size = unpackInt(Buffer, Pos);
+      for (int I = 0; I < Size; ++I)
+         OutNode.push_back(unpackNode(Buffer, Pos));
+      return OutNode;
+   }
+   case MapNode: {
+      YAML::Node OutNode(YAML::NodeType::Map);
+      const I4 Size = unpackInt(Buffer, Pos);
+      for (int I = 0; I < Size; ++I) {
+         const std::string Key = unpackString(Buffer, Pos);
+         OutNode[Key]          = unpackNode(Buffer, Pos);
+      }
+      return OutNode;
+   }
+   default:
+      return YAML::Node(YAML::NodeType::Null);
+   }
+}
+
 //------------------------------------------------------------------------------
 // Reads the full configuration for omega and stores in it a static
 // YAML node for later use.  The file must be in YAML format and must be in
 // the same directory as the executable, though Unix soft links can be used
-// to point to a file in an alternate location.  The full configuration is
-// only read by the master task.  The accessor functions (get/set) will
-// broadcast or communicate the data as needed to/from other MPI tasks.
+// to point to a file in an alternate location.  The file is only read and
+// parsed by the master task, which serializes the parsed tree into a compact
+// buffer and broadcasts it. The other tasks rebuild the tree from memory, so
+// the file is accessed and parsed only once. The parameter registry is then
+// frozen from the full configuration.
 
 int Config::readAll(const std::string ConfigFile // [in] input YAML config file
 ) {
    int Err = 0;
 
-   // Now give the full config the omega name and extract the
-   // top-level omega node from the Root.
-   ConfigAll.Name = "Omega";
+   MachEnv *DefEnv = MachEnv::getDefault();
 
-   for (int ReadGroup = 0; ReadGroup < Config::NumReadGroups; ++ReadGroup) {
+   // Now give the full config the omega name
+   ConfigAll.Name = "Omega";
 
-      // If it is this tasks turn, read the configuration file
-      if (Config::ReadGroupID == ReadGroup) {
-         // Read temporary root node
+   // Read and parse the file on the master task, extracting the top-level
+   // omega node from the root and serializing it
+   std::string Buffer;
+   if (DefEnv->isMasterTask()) {
+      try {
          YAML::Node RootNode = YAML::LoadFile(ConfigFile);
-         // Extract Omega node
-         ConfigAll.Node = RootNode["Omega"];
+         ConfigAll.Node      = RootNode["Omega"];
+         packNode(Buffer, ConfigAll.Node);
+      } catch (const YAML::Exception &Ex) {
+         LOG_ERROR("Config readAll: could not read config file {}: {}",
+                   ConfigFile, Ex.what());
+         Err = -1;
       }
-      MPI_Barrier(ConfigComm);
    }
 
+   Broadcast(Err);
+   if (Err != 0) {
+      LOG_ERROR("Config readAll: error reading config file {}", ConfigFile);
+      return Err;
+   }
+
+   // Distribute the serialized tree and rebuild it on the other tasks
+   Broadcast(Buffer);
+   if (!DefEnv->isMasterTask()) {
+      size_t Pos     = 0;
+      ConfigAll.Node = unpackNode(Buffer, Pos);
+   }
+
+   // Freeze the parameter registry from the new configuration
+   Err = ConfigParams::freeze();
+
    return Err;
 
 } // end Config::readAll
@@ -1074,6 +1188,16 @@ bool Config::existsVar(std::string VarName // [in] name of variable to find
    return result;
 }
 
+// Checks to see if a variable exists and is a map of other variables rather
+// than a list or a single value
+bool Config::isMap(std::string VarName // [in] name of variable to check
+) {
+   bool result = false;
+   if (Node[VarName])
+      result = Node[VarName].IsMap();
+   return result;
+}
+
 //------------------------------------------------------------------------------
 // Write function
 //------------------------------------------------------------------------------
@@ -1098,6 +1222,158 @@ int Config::write(std::string FileName /// name of file for config
    return Err;
 }
 
+//------------------------------------------------------------------------------
+// ConfigParams functions
+//------------------------------------------------------------------------------
+// Builds the parameter registry from the full Omega configuration, replacing
+// any previous contents
+int ConfigParams::freeze() {
+
+   clear();
+   addParams(Config::ConfigAll.Node, "");
+   Frozen = true;
+
+   return 0;
+
+} // end ConfigParams::freeze
+
+//------------------------------------------------------------------------------
+// Adds all scalar parameters in a YAML map node to the registry, recursing
+// into nested groups. Sequences (vectors and lists) are not added and must
+// still be retrieved with Config::get.
+void ConfigParams::addParams(const YAML::Node &InNode,  // [in] node to add
+                             const std::string &Prefix // [in] path of node
+) {
+
+   if (!InNode.IsMap())
+      return;
+
+   for (auto It = InNode.begin(); It != InNode.end(); ++It) {
+      const std::string Key  = It->first.as<std::string>();
+      const std::string Path = Prefix.empty() ? Key : Prefix + ":" + Key;
+      const YAML::Node &Val  = It->second;
+
+      if (Val.IsMap()) {
+         addParams(Val, Path);
+      } else if (Val.IsScalar()) {
+         // YAML scalars are untyped, so record every type the value can be
+         // converted to
+         unsigned char Type = 0;
+         bool BoolVal       = false;
+         I8 IntVal          = 0;
+         R8 RealVal         = 0.0;
+         if (YAML::convert<bool>::decode(Val, BoolVal))
+            Type |= IsBool;
+         if (YAML::convert<I8>::decode(Val, IntVal))
+            Type |= IsInt;
+         if (YAML::convert<R8>::decode(Val, RealVal))
+            Type |= IsReal;
+
+         ParamIndex[Path] = ParamTypes.size();
+         ParamTypes.push_back(Type);
+         BoolValues.push_back(BoolVal ? 1 : 0);
+         IntValues.push_back(IntVal);
+         RealValues.push_back(RealVal);
+         StrValues.push_back(Val.Scalar());
+      }
+   }
+
+} // end ConfigParams::addParams
+
+//------------------------------------------------------------------------------
+// Retrieves the position of a parameter that can be converted to the
+// requested type, with a zero type flag accepting any parameter
+int ConfigParams::findParam(const std::string &Path, // [in] path of parameter
+                            unsigned char Type,      // [in] required type flag
+                            I4 &Index                // [out] parameter position
+) {
+
+   Index = -1;
+
+   if (!Frozen) {
+      LOG_ERROR("ConfigParams: registry must be frozen before retrieving {}",
+                Path);
+      return -1;
+   }
+
+   auto It = ParamIndex.find(Path);
+   if (It == ParamIndex.end()) {
+      LOG_ERROR("ConfigParams: could not find parameter {}", Path);
+      return -1;
+   }
+
+   if ((ParamTypes[It->second] & Type) != Type) {
+      LOG_ERROR("ConfigParams: parameter {} with value {} has the wrong type",
+                Path, StrValues[It->second]);
+      return -1;
+   }
+
+   Index = It->second;
+   return 0;
+
+} // end ConfigParams::findParam
+
+//------------------------------------------------------------------------------
+// Resolves a parameter into a typed handle for each supported type
+int ConfigParams::getHandle(const std::string &Path, ConfigHandle<I4> &Handle) {
+   int Err = findParam(Path, IsInt, Handle.Index);
+   if (Err == 0 and
+       (IntValues[Handle.Index] > std::numeric_limits<I4>::max() or
+        IntValues[Handle.Index] < std::numeric_limits<I4>::min())) {
+      LOG_ERROR("ConfigParams: parameter {} does not fit in an I4", Path);
+      Handle.Index = -1;
+      Err          = -1;
+   }
+   return Err;
+}
+
+int ConfigParams::getHandle(const std::string &Path, ConfigHandle<I8> &Handle) {
+   return findParam(Path, IsInt, Handle.Index);
+}
+
+int ConfigParams::getHandle(const std::string &Path, ConfigHandle<R4> &Handle) {
+   return findParam(Path, IsReal, Handle.Index);
+}
+
+int ConfigParams::getHandle(const std::string &Path, ConfigHandle<R8> &Handle) {
+   return findParam(Path, IsReal, Handle.Index);
+}
+
+int ConfigParams::getHandle(const std::string &Path,
+                            ConfigHandle<bool> &Handle) {
+   return findParam(Path, IsBool, Handle.Index);
+}
+
+int ConfigParams::getHandle(const std::string &Path,
+                            ConfigHandle<std::string> &Handle) {
+   return findParam(Path, 0, Handle.Index);
+}
+
+//------------------------------------------------------------------------------
+// Returns true if the registry has been frozen
+bool ConfigParams::isFrozen() { return Frozen; }
+
+//------------------------------------------------------------------------------
+// Returns true if a parameter with the input path exists
+bool ConfigParams::exists(const std::string &Path // [in] path of parameter
+) {
+   return ParamIndex.find(Path) != ParamIndex.end();
+}
+
+//------------------------------------------------------------------------------
+// Removes all parameters from the registry
+void ConfigParams::clear() {
+
+   ParamIndex.clear();
+   ParamTypes.clear();
+   BoolValues.clear();
+   IntValues.clear();
+   RealValues.clear();
+   StrValues.clear();
+   Frozen = false;
+
+} // end ConfigParams::clear
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
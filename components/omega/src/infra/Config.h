@@ -18,7 +18,9 @@
 #include "mpi.h"
 #include "yaml-cpp/yaml.h"
 
+#include <map>
 #include <string>
+#include <vector>
 
 namespace OMEGA {
 
@@ -42,18 +44,9 @@ class Config {
    /// The YAML node containing the configuration.
    YAML::Node Node;
 
-   /// All MPI tasks must read the initial input file but there may
-   /// be a limit to the number of tasks who can simultaneously read
-   /// so only a subset of tasks reads at the same time
-   static const int ReadGroupSize;
-   static int ReadGroupID;
-   static int NumReadGroups;
-   static MPI_Comm ConfigComm;
-
-   /// We do not use an initialization routine, so we include this
-   /// initialization flag so that the first Config constructed will
-   /// set the master task flag for the config routines.
-   static bool NotInitialized;
+   /// The parameter registry flattens the YAML node of the full
+   /// configuration
+   friend class ConfigParams;
 
  public:
    // Methods
@@ -81,9 +74,9 @@ class Config {
    /// Reads the full configuration for omega and stores in it a static
    /// YAML node for later use.  The file must be in YAML format and must be in
    /// the same directory as the executable, though Unix soft links can be used
-   /// to point to a file in an alternate location.  The full configuration is
-   /// only read by the master task.  The accessor functions (get/set) will
-   /// broadcast or communicate the data as needed to/from other MPI tasks.
+   /// to point to a file in an alternate location.  The file is only read by
+   /// the master task, which broadcasts its contents to all other tasks, and
+   /// the parameter registry (ConfigParams) is then frozen from the result.
    static int readAll(std::string FileName ///< [in] input omega config file
    );
 
@@ -355,6 +348,11 @@ class Config {
    bool existsVar(const std::string VarName ///< [in] name of variable find
    );
 
+   /// Checks to see if a variable exists and is a map of other variables
+   /// (a sub-configuration) rather than a list or a single value
+   bool isMap(const std::string VarName ///< [in] name of variable to check
+   );
+
    // Write function
    // --------------
 
@@ -365,6 +363,140 @@ class Config {
 
 }; // end class Config
 
+/// A typed handle to a parameter in the frozen parameter registry. It only
+/// holds the position of the parameter in the registry, so it is cheap to
+/// copy and its value is retrieved without any search.
+template <class T> class ConfigHandle {
+ public:
+   I4 Index = -1; ///< position of the parameter in the registry
+
+   /// Returns true if the handle refers to a parameter
+   bool isValid() const { return Index >= 0; }
+};
+
+/// The ConfigParams class is a static registry of all scalar parameters in
+/// the full Omega configuration. It is frozen (built) once after the
+/// configuration is read, by flattening the YAML node into typed tables
+/// indexed by the full path of each parameter, eg Tendencies:ViscDel2.
+/// Modules resolve the parameters they need at runtime into handles during
+/// initialization, and retrieving a value from a handle is then a simple
+/// table lookup that never touches yaml-cpp. Values that are needed inside a
+/// device kernel should be retrieved into a local variable (or a plain
+/// struct) that is captured by the kernel. Changes made to the
+/// configuration with set, add or remove after the registry is frozen are
+/// only seen in the registry if it is frozen again.
+class ConfigParams {
+
+ private:
+   /// Flags marking the types a parameter can be converted to
+   enum TypeFlag : unsigned char {
+      IsBool = 1, ///< value is a logical
+      IsInt  = 2, ///< value is an integer
+      IsReal = 4  ///< value is a real number
+   };
+
+   /// True if the registry has been built from the current configuration
+   static bool Frozen;
+
+   /// Position of each parameter in the tables, indexed by full path
+   static std::map<std::string, I4> ParamIndex;
+
+   /// Typed tables of parameter values, each with an entry for every
+   /// parameter that is only meaningful if the matching type flag is set
+   static std::vector<unsigned char> ParamTypes;
+   static std::vector<unsigned char> BoolValues;
+   static std::vector<I8> IntValues;
+   static std::vector<R8> RealValues;
+   static std::vector<std::string> StrValues;
+
+   /// Adds all scalar parameters in a YAML map node to the registry,
+   /// recursing into nested groups
+   static void addParams(const YAML::Node &InNode,  ///< [in] node to add
+                         const std::string &Prefix ///< [in] path of node
+   );
+
+   /// Retrieves the position of a parameter that can be converted to the
+   /// requested type, returning an error if it does not exist or cannot be
+   /// converted.
+   static int findParam(const std::string &Path, ///< [in] path of parameter
+                        unsigned char Type,      ///< [in] required type flag
+                        I4 &Index                ///< [out] parameter position
+   );
+
+ public:
+   /// Builds the registry from the full Omega configuration, replacing any
+   /// previous contents. This is called at the end of Config::readAll and
+   /// can be called again if the configuration is modified after reading.
+   static int freeze();
+
+   /// Returns true if the registry has been frozen
+   static bool isFrozen();
+
+   /// Returns true if a parameter with the input path exists
+   static bool exists(const std::string &Path ///< [in] path of parameter
+   );
+
+   /// Resolves the parameter with the input path into a typed handle.
+   /// Returns a non-zero error code if the registry has not been frozen, the
+   /// parameter does not exist or it cannot be converted to the handle type.
+   static int getHandle(const std::string &Path, ///< [in] path of parameter
+                        ConfigHandle<I4> &Handle ///< [out] parameter handle
+   );
+   static int getHandle(const std::string &Path, ///< [in] path of parameter
+                        ConfigHandle<I8> &Handle ///< [out] parameter handle
+   );
+   static int getHandle(const std::string &Path, ///< [in] path of parameter
+                        ConfigHandle<R4> &Handle ///< [out] parameter handle
+   );
+   static int getHandle(const std::string &Path, ///< [in] path of parameter
+                        ConfigHandle<R8> &Handle ///< [out] parameter handle
+   );
+   static int getHandle(const std::string &Path,   ///< [in] path of parameter
+                        ConfigHandle<bool> &Handle ///< [out] parameter handle
+   );
+   static int
+   getHandle(const std::string &Path,          ///< [in] path of parameter
+             ConfigHandle<std::string> &Handle ///< [out] parameter handle
+   );
+
+   /// Retrieves the value of a parameter from a valid handle
+   static I4 get(const ConfigHandle<I4> &Handle) {
+      return static_cast<I4>(IntValues[Handle.Index]);
+   }
+   static I8 get(const ConfigHandle<I8> &Handle) {
+      return IntValues[Handle.Index];
+   }
+   static R4 get(const ConfigHandle<R4> &Handle) {
+      return static_cast<R4>(RealValues[Handle.Index]);
+   }
+   static R8 get(const ConfigHandle<R8> &Handle) {
+      return RealValues[Handle.Index];
+   }
+   static bool get(const ConfigHandle<bool> &Handle) {
+      return BoolValues[Handle.Index] != 0;
+   }
+   static const std::string &get(const ConfigHandle<std::string> &Handle) {
+      return StrValues[Handle.Index];
+   }
+
+   /// Retrieves the value of a parameter by path, resolving it each time.
+   /// Returns a non-zero error code if the handle could not be resolved.
+   template <class T>
+   static int get(const std::string &Path, ///< [in] path of parameter
+                  T &Value                 ///< [out] value of the parameter
+   ) {
+      ConfigHandle<T> Handle;
+      int Err = getHandle(Path, Handle);
+      if (Err == 0)
+         Value = get(Handle);
+      return Err;
+   }
+
+   /// Removes all parameters from the registry
+   static void clear();
+
+}; // end class ConfigParams
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
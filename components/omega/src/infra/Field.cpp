@@ -26,6 +26,7 @@ namespace OMEGA {
 
 // Initialize static variables
 std::map<std::string, std::shared_ptr<Field>> Field::AllFields;
+std::vector<std::shared_ptr<Field>> Field::FieldsByHandle;
 std::map<std::string, std::shared_ptr<FieldGroup>> FieldGroup::AllGroups;
 
 //------------------------------------------------------------------------------
@@ -53,6 +54,16 @@ bool Field::exists(const std::string &FieldName // [in] name of field
    return (AllFields.find(FieldName) != AllFields.end());
 }
 
+//------------------------------------------------------------------------------
+// Assigns the next handle to a new field and adds it to the list of fields
+// by name and by handle. Handles are not reused after a field is destroyed.
+void Field::addField(const std::shared_ptr<Field> &NewField // [in] field
+) {
+   NewField->Handle = FieldsByHandle.size();
+   FieldsByHandle.push_back(NewField);
+   AllFields[NewField->FldName] = NewField;
+}
+
 //------------------------------------------------------------------------------
 // Creates a field with standard metadata. This is the preferred
 // interface for most fields in Omega. It enforces a list of required
@@ -125,11 +136,14 @@ Field::create(const std::string &FieldName,   // [in] Name of variable/field
    ThisField->DataType = FieldType::Unknown;
    ThisField->MemLoc   = FieldMemLoc::Unknown;
 
+   // Output precision follows the stream unless reduced for this field
+   ThisField->ReducedPrecision = false;
+
    // Initialize Data pointer as null until data is actually attached.
    ThisField->DataArray = nullptr;
 
    // Add to list of fields and return
-   AllFields[FieldName] = ThisField;
+   addField(ThisField);
    return ThisField;
 }
 
@@ -166,12 +180,13 @@ Field::create(const std::string &FieldName // [in] Name of field
    ThisField->DimNames;
 
    // Initialize to Unknown or null - no data is attached
-   ThisField->DataType  = FieldType::Unknown;
-   ThisField->MemLoc    = FieldMemLoc::Unknown;
-   ThisField->DataArray = nullptr;
+   ThisField->DataType         = FieldType::Unknown;
+   ThisField->MemLoc           = FieldMemLoc::Unknown;
+   ThisField->DataArray        = nullptr;
+   ThisField->ReducedPrecision = false;
 
    // Add to list of fields and return
-   AllFields[FieldName] = ThisField;
+   addField(ThisField);
    return ThisField;
 }
 
@@ -186,7 +201,8 @@ int Field::destroy(const std::string &FieldName // [in] Name of Field to remove
    // Check that the group exists
    if (exists(FieldName)) {
 
-      // Erase the group from the list of all groups
+      // Erase the field from the list of all fields and release its handle
+      FieldsByHandle[AllFields[FieldName]->Handle] = nullptr;
       AllFields.erase(FieldName);
 
       // Group does not exist, exit with error
@@ -204,7 +220,10 @@ int Field::destroy(const std::string &FieldName // [in] Name of Field to remove
 // This removes all fields from the map structure and also
 // decrements the reference counter for the shared pointers,
 // removing them if the count has reached 0.
-void Field::clear() { AllFields.clear(); }
+void Field::clear() {
+   AllFields.clear();
+   FieldsByHandle.clear();
+}
 
 //------------------------------------------------------------------------------
 // Retrieve a field pointer by name
@@ -220,6 +239,45 @@ Field::get(const std::string &FieldName // [in] name of field
    }
 }
 
+//------------------------------------------------------------------------------
+// Retrieve a field pointer by handle
+std::shared_ptr<Field>
+Field::get(const FieldHandle InHandle // [in] handle of field
+) {
+
+   if (isValidHandle(InHandle)) {
+      return FieldsByHandle[InHandle];
+   } else {
+      LOG_ERROR("Unable to retrieve Field with handle {}. Field not found.",
+                InHandle);
+      return nullptr;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Get field handle from instance
+FieldHandle Field::getHandle() const { return Handle; }
+
+//------------------------------------------------------------------------------
+// Get field handle by name
+FieldHandle Field::getFieldHandle(const std::string &FieldName // [in] name
+) {
+   auto It = AllFields.find(FieldName);
+   if (It != AllFields.end())
+      return It->second->Handle;
+   else
+      return InvalidFieldHandle;
+}
+
+//------------------------------------------------------------------------------
+// Checks whether a handle refers to an existing field
+bool Field::isValidHandle(const FieldHandle InHandle // [in] field handle
+) {
+   return InHandle >= 0 and
+          InHandle < static_cast<FieldHandle>(FieldsByHandle.size()) and
+          FieldsByHandle[InHandle] != nullptr;
+}
+
 //------------------------------------------------------------------------------
 // Get field name
 std::string Field::getName() const { return FldName; }
@@ -245,6 +303,15 @@ FieldType Field::getFieldType(const std::string &FieldName // [in] name of field
    }
 }
 
+//------------------------------------------------------------------------------
+// Set and query the reduced output precision of the field
+void Field::setReducedPrecision(bool InReduced // [in] new setting
+) {
+   ReducedPrecision = InReduced;
+}
+
+bool Field::isReducedPrecision() const { return ReducedPrecision; }
+
 //------------------------------------------------------------------------------
 // Determine memory location of data from instance
 FieldMemLoc Field::getMemoryLocation() const { return MemLoc; }
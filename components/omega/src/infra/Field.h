@@ -20,10 +20,12 @@
 #include "Dimension.h"
 #include "Logging.h"
 #include <any>
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
 #include <type_traits>
+#include <vector>
 
 namespace OMEGA {
 
@@ -45,6 +47,14 @@ enum class FieldType { Unknown, I4, I8, R4, R8 };
 /// to the CPU-only case where the host and device are identical.
 enum class FieldMemLoc { Unknown, Device, Host, Both };
 
+/// Integer handle for a field, assigned when the field is created. A handle
+/// remains valid until the field is destroyed and is never reused, so it can
+/// be stored to retrieve the field without a lookup by name.
+using FieldHandle = I4;
+
+/// Handle value for a field that does not exist
+static constexpr FieldHandle InvalidFieldHandle{-1};
+
 namespace Impl {
 // determine FieldType from Kokkos array type
 template <class T> constexpr FieldType determineFieldType() {
@@ -88,6 +98,17 @@ class Field {
    /// Store and maintain all defined fields
    static std::map<std::string, std::shared_ptr<Field>> AllFields;
 
+   /// All defined fields indexed by handle, with null entries for fields
+   /// that have been destroyed
+   static std::vector<std::shared_ptr<Field>> FieldsByHandle;
+
+   /// Handle for this field
+   FieldHandle Handle;
+
+   /// Assigns the next handle to a new field and adds it to the field lists
+   static void addField(const std::shared_ptr<Field> &NewField ///< [in] field
+   );
+
    /// Field name
    std::string FldName;
 
@@ -104,6 +125,11 @@ class Field {
    /// Data type for field data
    FieldType DataType;
 
+   /// Flag to write double precision data in single precision in all
+   /// output streams other than restarts, independent of the precision of
+   /// the stream
+   bool ReducedPrecision;
+
    /// Location of data
    FieldMemLoc MemLoc;
 
@@ -112,6 +138,11 @@ class Field {
    /// various types and cast to the appropriate type when needed.
    std::shared_ptr<void> DataArray;
 
+   /// Optional function that returns the data array each time the data is
+   /// requested, for fields whose array changes during the run (eg the
+   /// current time level of a state variable)
+   std::function<std::shared_ptr<void>()> DataProvider;
+
  public:
    //---------------------------------------------------------------------------
    // Initialization
@@ -178,6 +209,25 @@ class Field {
    get(const std::string &FieldName ///< [in] name of field to retrieve
    );
 
+   /// Retrieve pointer to a full field by handle
+   static std::shared_ptr<Field>
+   get(const FieldHandle InHandle ///< [in] handle of field to retrieve
+   );
+
+   //---------------------------------------------------------------------------
+   /// Retrieve the handle of a field instance
+   FieldHandle getHandle() const;
+
+   /// Retrieve the handle of a field by name. Returns InvalidFieldHandle if
+   /// the field does not exist.
+   static FieldHandle
+   getFieldHandle(const std::string &FieldName ///< [in] name of field
+   );
+
+   /// Checks whether a handle refers to a field that exists
+   static bool isValidHandle(const FieldHandle InHandle ///< [in] field handle
+   );
+
    //---------------------------------------------------------------------------
    /// Retrieve field name
    std::string getName() const;
@@ -192,6 +242,13 @@ class Field {
    getFieldType(const std::string &FieldName ///< [in] name of field
    );
 
+   /// Sets whether double precision data is written in single precision
+   void setReducedPrecision(bool InReduced ///< [in] new setting
+   );
+
+   /// Returns true if double precision data is written in single precision
+   bool isReducedPrecision() const;
+
    //---------------------------------------------------------------------------
    // Query location of field data
    /// Determine location of data from instance
@@ -315,7 +372,8 @@ class Field {
       int Err = 0; // initialize return code
 
       // Attach the data array - this is a shallow copy
-      DataArray = std::make_shared<T>(InDataArray);
+      DataArray    = std::make_shared<T>(InDataArray);
+      DataProvider = nullptr;
 
       // Determine type and location
       DataType = Impl::determineFieldType<T>();
@@ -324,6 +382,32 @@ class Field {
       return Err;
    };
 
+   //---------------------------------------------------------------------------
+   /// Attaches a function that returns the data array of an existing Field
+   /// instance. The function is called each time the data is retrieved, so
+   /// the attached array is resolved lazily, eg when a stream is written,
+   /// instead of being re-attached whenever it changes. Attaching a data
+   /// array with attachData replaces the function. The template argument
+   /// must be the array type returned by the function.
+   template <typename T>
+   int attachDataProvider(
+       const std::function<T()> &InProvider ///< [in] returns data array
+   ) {
+      static_assert(isKokkosArray<T>,
+                    "attachDataProvider requires Kokkos array type");
+
+      DataArray    = nullptr;
+      DataProvider = [InProvider]() -> std::shared_ptr<void> {
+         return std::make_shared<T>(InProvider());
+      };
+
+      // Determine type and location
+      DataType = Impl::determineFieldType<T>();
+      MemLoc   = Impl::determineFieldMemLoc<T>();
+
+      return 0;
+   };
+
    //---------------------------------------------------------------------------
    /// Attaches an array of data to an existing Field by name. If a data array
    /// needs to be updated, calling the attach routine with new data
@@ -355,6 +439,31 @@ class Field {
       return Err;
    };
 
+   //---------------------------------------------------------------------------
+   /// Attaches an array of data to an existing Field by handle. This is the
+   /// same as attaching by name but avoids the lookup by name.
+   template <typename T>
+   static int
+   attachFieldData(const FieldHandle InHandle, ///< [in] Handle of Field
+                   const T &InDataArray ///< [in] Array with data to attach
+   ) {
+      static_assert(isKokkosArray<T>,
+                    "attachFieldData requires Kokkos array as input");
+
+      int Err = 0; // initialize return code
+
+      // Check to make sure field exists
+      if (isValidHandle(InHandle)) {
+         Err = FieldsByHandle[InHandle]->attachData<T>(InDataArray);
+      } else {
+         Err = -1;
+         LOG_ERROR("Field: error attaching data to field handle {}. "
+                   "Field not defined",
+                   InHandle);
+      }
+      return Err;
+   };
+
    //---------------------------------------------------------------------------
    /// Retrieves Field data from a Field instance. Because all data
    /// arrays in OMEGA are Kokkos arrays, this is a shallow copy of the
@@ -366,6 +475,11 @@ class Field {
           isKokkosArray<T>,
           "getDataArray requires Kokkos array as its template argument");
 
+      // Resolve the current data array if it is provided by a function
+      if (DataProvider) {
+         DataArray = DataProvider();
+      }
+
       // Check to make sure data is attached
       if (DataArray != nullptr) { // data is attached
 
@@ -412,6 +526,25 @@ class Field {
       return Data;
    };
 
+   //---------------------------------------------------------------------------
+   /// Retrieves Field data array given the field handle. This is the same
+   /// as retrieving the data by name but avoids the lookup by name.
+   template <typename T>
+   static T getFieldDataArray(const FieldHandle InHandle ///< [in] Field handle
+   ) {
+
+      // Check to see if field is defined
+      if (!isValidHandle(InHandle)) { // no field return error
+         LOG_ERROR("Field: Attempted to get data failed, field handle {} "
+                   "does not exist",
+                   InHandle);
+         T Data;
+         return Data;
+      }
+
+      return FieldsByHandle[InHandle]->getDataArray<T>();
+   };
+
    //---------------------------------------------------------------------------
    // Field Group is a friend class so it can access field list
    friend class FieldGroup;
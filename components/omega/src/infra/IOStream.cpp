@@ -14,25 +14,42 @@
 #include "Field.h"
 #include "IO.h"
 #include "Logging.h"
+#include "MachEnv.h"
 #include "OmegaKokkos.h"
 #include "TimeMgr.h"
+#include "Timer.h"
+#include "mpi.h"
+
 #include <algorithm>
 #include <any>
 #include <cctype>
 #include <ctime>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <typeindex>
 #include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace OMEGA {
 
 // Create static class members
 std::map<std::string, std::shared_ptr<IOStream>> IOStream::AllStreams;
+std::future<int> IOStream::PendingWrite;
+std::map<IOStream::DecompKey, int> IOStream::DecompCache;
+std::map<std::string, IOStream::SubfileDim> IOStream::SubfileDims;
+std::set<const Alarm *> IOStream::WriteAlarms;
+bool IOStream::StartupWritePending = false;
 
 //------------------------------------------------------------------------------
 // Initializes all streams defined in the input configuration file. This
@@ -105,8 +122,23 @@ int IOStream::finalize(
       }
    } // end loop over streams
 
-   // Remove all streams
+   // Make sure any asynchronous writes have completed before removing
+   // the streams and their staging buffers
+   int Err1 = waitForPendingWrite();
+   if (Err1 != 0) {
+      LOG_ERROR("Error completing asynchronous stream write at shutdown");
+      ++Err;
+   }
+
+   // Remove all streams and cached decompositions
    AllStreams.clear();
+   WriteAlarms.clear();
+   StartupWritePending = false;
+   Err1 = clearDecomps();
+   if (Err1 != 0) {
+      LOG_ERROR("Error destroying cached decompositions at shutdown");
+      ++Err;
+   }
 
    return Err;
 
@@ -136,6 +168,7 @@ IOStream::get(const std::string &StreamName ///< [in] name of stream to retrieve
 void IOStream::addField(const std::string &FieldName ///< [in] Name of field
 ) {
    this->Contents.insert(FieldName);
+   this->Validated = false;
 } // End addField
 
 //------------------------------------------------------------------------------
@@ -144,6 +177,7 @@ void IOStream::addField(const std::string &FieldName ///< [in] Name of field
 void IOStream::removeField(const std::string &FieldName ///< [in] Name of field
 ) {
    this->Contents.erase(FieldName);
+   this->Validated = false;
 } // End removeField
 
 //------------------------------------------------------------------------------
@@ -169,6 +203,11 @@ bool IOStream::validate() {
          GroupNames.insert(FieldName);
    }
 
+   // Streams with a pointer file or the Restart group carry the restart
+   // state
+   if (UsePointer or GroupNames.count("Restart") > 0)
+      RestartStream = true;
+
    // Now for each group, extract field names and add to contents if it
    // is not there already. Since Contents is a set we can just insert
    // and it will take care of duplicate fields.
@@ -184,22 +223,40 @@ bool IOStream::validate() {
       }
       // Remove group name from contents
       Contents.erase(GrpName);
+
+      // Fields in a group with quantization inherit the number of
+      // significant digits unless it is set explicitly for the field
+      auto DigitsIter = SignificantDigits.find(GrpName);
+      if (DigitsIter != SignificantDigits.end()) {
+         int NumDigits = DigitsIter->second;
+         SignificantDigits.erase(DigitsIter);
+         for (auto IField = FieldList.begin(); IField != FieldList.end();
+              ++IField) {
+            SignificantDigits.try_emplace(*IField, NumDigits);
+         }
+      }
    }
 
    // Loop through all the field names in Contents and check whether they
-   // have been defined as an Field
+   // have been defined as an Field, saving the field handles
+   ContentHandles.clear();
    for (auto IField = Contents.begin(); IField != Contents.end(); ++IField) {
       std::string FieldName = *IField;
 
-      if (not Field::exists(FieldName)) {
+      FieldHandle Handle = Field::getFieldHandle(FieldName);
+      if (Handle == InvalidFieldHandle) {
          LOG_ERROR("Cannot validate stream {}: Field {} has not been defined",
                    Name, FieldName);
          ReturnVal = false;
       }
+      ContentHandles.push_back(Handle);
    }
 
-   if (ReturnVal)
+   // Size the staging pool for the validated contents
+   if (ReturnVal) {
       Validated = true;
+      sizeStagingPool();
+   }
    return ReturnVal;
 
 } // End validate
@@ -257,6 +314,76 @@ int IOStream::read(
 
 } // End read stream
 
+//------------------------------------------------------------------------------
+// Starts reading a single stream on a background thread. Returns an error
+// code for starting the read.
+int IOStream::readAsync(
+    const std::string &StreamName, // [in] Name of stream
+    const Clock &ModelClock        // [in] Model clock for the file name
+) {
+   int Err = 0; // default return code
+
+   // Retrieve stream by name and make sure it exists
+   auto StreamItr = AllStreams.find(StreamName);
+   if (StreamItr == AllStreams.end()) {
+      LOG_ERROR("Unable to read stream {}. Stream not defined", StreamName);
+      Err = 1;
+      return Err;
+   }
+   std::shared_ptr<IOStream> ThisStream = StreamItr->second;
+
+   if (ThisStream->Mode != IO::ModeRead) {
+      LOG_ERROR("IOStream read: cannot read stream defined as output stream");
+      Err = 1;
+      return Err;
+   }
+   if (!ThisStream->validate()) {
+      LOG_ERROR("IOStream read: invalid contents for stream {}", StreamName);
+      Err = 2;
+      return Err;
+   }
+
+   // The background thread only writes host memory, so device fields
+   // cannot be read asynchronously
+   for (FieldHandle Handle : ThisStream->ContentHandles) {
+      std::shared_ptr<Field> ThisField = Field::get(Handle);
+      if (!ThisField->isOnHost()) {
+         LOG_ERROR("Asynchronous read of stream {} requires host fields but "
+                   "Field {} is on the device",
+                   StreamName, ThisField->getName());
+         Err = 3;
+         return Err;
+      }
+   }
+
+   // Only one asynchronous read or write can be in flight
+   Err = waitForPendingWrite();
+   if (Err != 0) {
+      LOG_ERROR("Error completing asynchronous write before reading stream {}",
+                StreamName);
+      return Err;
+   }
+
+   std::string InFileName = ThisStream->getReadFilename(ModelClock);
+
+   // Without thread support in MPI, the stream is read immediately
+   int ThreadLevel;
+   MPI_Query_thread(&ThreadLevel);
+   if (ThreadLevel < MPI_THREAD_MULTIPLE) {
+      Metadata NoMetadata;
+      Err = ThisStream->readFile(InFileName, NoMetadata);
+      return Err;
+   }
+
+   PendingWrite = std::async(std::launch::async, [ThisStream, InFileName]() {
+      Metadata NoMetadata;
+      return ThisStream->readFile(InFileName, NoMetadata);
+   });
+
+   return Err;
+
+} // End readAsync
+
 //------------------------------------------------------------------------------
 // Writes a single stream if it is time. Returns an error code.
 int IOStream::write(
@@ -291,15 +418,33 @@ int IOStream::writeAll(
 
    int Err = 0; // accumulated error for return value
 
+   // Unless a stream still needs its startup write, return without checking
+   // each stream if none of the ringing alarms of the clock is a write alarm
+   if (!StartupWritePending) {
+      bool WriteDue = false;
+      for (const Alarm *RingingAlarm : ModelClock.getRingingAlarms()) {
+         if (WriteAlarms.count(RingingAlarm) > 0) {
+            WriteDue = true;
+            break;
+         }
+      }
+      if (!WriteDue)
+         return Err;
+   }
+
    // Loop over all streams and call write function for any write streams
+   StartupWritePending = false;
    for (auto Iter = AllStreams.begin(); Iter != AllStreams.end(); Iter++) {
 
       std::string StreamName               = Iter->first;
       std::shared_ptr<IOStream> ThisStream = Iter->second;
 
-      int Err1;
+      int Err1 = 0;
       if (ThisStream->Mode == IO::ModeWrite) {
          Err1 = ThisStream->writeStream(ModelClock);
+         // a startup write outside the stream interval is still pending
+         if (ThisStream->OnStartup)
+            StartupWritePending = true;
       }
 
       // check for errors
@@ -321,14 +466,22 @@ IOStream::IOStream() {
    Filename           = "Unknown";
    FilenameIsTemplate = false;
    ExistAction        = IO::IfExists::Fail;
+   FileFormat         = IO::DefaultFileFmt;
    Mode               = IO::Mode::ModeUnknown;
    ReducePrecision    = false;
    OnStartup          = false;
    OnShutdown         = false;
    UsePointer         = false;
    PtrFilename        = " ";
+   RestartStream      = false;
    UseStartEnd        = false;
    Validated          = false;
+   AsyncWrite         = false;
+   ActiveBuffer       = 0;
+   UseChunking        = false;
+   DeflateLevel       = 0;
+   UseShuffle         = true;
+   UseSubfiles        = false;
 }
 
 //------------------------------------------------------------------------------
@@ -415,6 +568,21 @@ int IOStream::create(const std::string &StreamName, //< [in] name of stream
       PrecisionString = "double";
    NewStream->setPrecisionFlag(PrecisionString);
 
+   // Set the file format, which also selects the IO backend (eg ADIOS2
+   // rather than NetCDF). If not present, the default format is used.
+   NewStream->FileFormat = IO::DefaultFileFmt;
+   std::string FormatString;
+   Err = StreamConfig.get("IOFormat", FormatString);
+   if (Err == 0) {
+      NewStream->FileFormat = IO::FileFmtFromString(FormatString);
+      if (NewStream->FileFormat == IO::FmtUnknown) {
+         LOG_ERROR("Unknown IOFormat {} for stream {}", FormatString,
+                   StreamName);
+         Err = 7;
+         return Err;
+      }
+   }
+
    // Set the action to take if a file already exists
    // This is only needed for writes so only perform check for write mode
    NewStream->ExistAction = IO::IfExists::Fail; // default is to fail
@@ -425,6 +593,80 @@ int IOStream::create(const std::string &StreamName, //< [in] name of stream
          NewStream->ExistAction = IO::IfExistsFromString(ExistAct);
    }
 
+   // Set the optional storage options for output files: chunking,
+   // compression and quantization of floating point fields. If not present,
+   // variables are written contiguously without compression.
+   if (NewStream->Mode == IO::ModeWrite) {
+      Err = StreamConfig.get("Chunking", NewStream->UseChunking);
+      if (Err != 0)
+         NewStream->UseChunking = false;
+      Err = StreamConfig.get("DeflateLevel", NewStream->DeflateLevel);
+      if (Err != 0)
+         NewStream->DeflateLevel = 0;
+      if (NewStream->DeflateLevel < 0 or NewStream->DeflateLevel > 9) {
+         LOG_ERROR("Invalid DeflateLevel {} for stream {}, must be 0-9",
+                   NewStream->DeflateLevel, StreamName);
+         Err = 5;
+         return Err;
+      }
+      Err = StreamConfig.get("Shuffle", NewStream->UseShuffle);
+      if (Err != 0)
+         NewStream->UseShuffle = true;
+      if (StreamConfig.existsGroup("SignificantDigits")) {
+         Config DigitsConfig("SignificantDigits");
+         Err = StreamConfig.get(DigitsConfig);
+         if (Err != 0) {
+            LOG_ERROR("Error reading SignificantDigits for stream {}",
+                      StreamName);
+            return Err;
+         }
+         for (auto It = DigitsConfig.begin(); It != DigitsConfig.end(); ++It) {
+            std::string DigitsName = It->first.as<std::string>();
+            I4 NumDigits;
+            Err = DigitsConfig.get(DigitsName, NumDigits);
+            if (Err != 0 or NumDigits < 1) {
+               LOG_ERROR("Invalid SignificantDigits for {} in stream {}",
+                         DigitsName, StreamName);
+               Err = 6;
+               return Err;
+            }
+            NewStream->SignificantDigits[DigitsName] = NumDigits;
+         }
+      }
+      Err = 0;
+   }
+
+   // Set flag for asynchronous writes. If no flag present, the stream is
+   // written synchronously. Asynchronous writes are only supported for output
+   // streams and require a thread-safe MPI library, otherwise we fall back to
+   // synchronous writes.
+   bool AsyncFlag = false;
+   Err            = StreamConfig.get("AsyncWrite", AsyncFlag);
+   if (Err != 0)
+      AsyncFlag = false;
+   if (AsyncFlag and NewStream->Mode == IO::ModeWrite) {
+      Err = NewStream->setAsyncWrite(true);
+      if (Err != 0)
+         LOG_WARN("Asynchronous writes not available for stream {}, using "
+                  "synchronous writes",
+                  StreamName);
+   }
+
+   // Set flag for writing one subfile per node. If no flag present, the
+   // stream is written to a single file. Subfiles are only supported for
+   // output streams.
+   bool SubfileFlag = false;
+   Err              = StreamConfig.get("Subfiling", SubfileFlag);
+   if (Err != 0)
+      SubfileFlag = false;
+   if (SubfileFlag and NewStream->Mode == IO::ModeWrite) {
+      Err = NewStream->setSubfiling(true);
+      if (Err != 0) {
+         LOG_ERROR("Error enabling subfiles for stream {}", StreamName);
+         return Err;
+      }
+   }
+
    // Set alarm based on read/write frequency
    // Use stream name as alarm name
    std::string AlarmName = StreamName;
@@ -620,6 +862,15 @@ int IOStream::create(const std::string &StreamName, //< [in] name of stream
    // the list
    AllStreams[StreamName] = NewStream;
 
+   // Register the write alarm and startup flag so writeAll can return
+   // early when no stream is due
+   if (NewStream->Mode == IO::ModeWrite) {
+      if (HasAlarm)
+         WriteAlarms.insert(&(NewStream->MyAlarm));
+      if (NewStream->OnStartup)
+         StartupWritePending = true;
+   }
+
    return Err;
 
 } // End IOStream create
@@ -648,6 +899,20 @@ int IOStream::defineAllDims(
       I4 Length = IDim->second->getLengthGlobal();
       I4 DimID;
 
+      // Distributed dimensions in node subfiles only hold the entries of
+      // the node
+      if (Mode == IO::ModeWrite and UseSubfiles and
+          IDim->second->isDistributed()) {
+         auto SubIter = SubfileDims.find(DimName);
+         if (SubIter == SubfileDims.end()) {
+            LOG_ERROR("No subfile layout for dimension {} in stream {}",
+                      DimName, Name);
+            Err = 4;
+            return Err;
+         }
+         Length = SubIter->second.Length;
+      }
+
       // For input files, we read the DimID from the file
       if (Mode == IO::ModeRead) {
          // If dimension not found, only generate a warning since there
@@ -698,7 +963,8 @@ int IOStream::defineAllDims(
 
 //------------------------------------------------------------------------------
 // Computes the parallel decomposition (offsets) for a field needed for parallel
-// I/O. Return error code and also Decomp ID and array size for field.
+// I/O or retrieves it from the cache if it was computed for an earlier read or
+// write. Return error code and also Decomp ID and array size for field.
 int IOStream::computeDecomp(
     std::shared_ptr<Field> FieldPtr,       // [in] pointer to Field
     std::map<std::string, int> &AllDimIDs, // [in] dimension IDs
@@ -738,6 +1004,10 @@ int IOStream::computeDecomp(
    std::vector<I4> DimLengthGlob(MaxDims, 1); // lengths padded to MaxDims
    std::vector<I4> DimLengthLoc(MaxDims, 1);  // lengths padded to MaxDims
 
+   // Node subfiles use the length and offsets of distributed dimensions in
+   // the subfile rather than in the global domain
+   bool Subfile = UseSubfiles and Mode == IO::ModeWrite;
+
    for (int IDim = 0; IDim < NDims; ++IDim) {
       I4 StartDim                        = MaxDims - NDims;
       std::string DimName                = DimNames[IDim];
@@ -745,12 +1015,32 @@ int IOStream::computeDecomp(
       DimLengths[IDim]                   = ThisDim->getLengthLocal();
       DimLengthsGlob[IDim]               = ThisDim->getLengthGlobal();
       DimOffsets[StartDim + IDim]        = ThisDim->getOffset();
-      DimLengthLoc[StartDim + IDim]      = DimLengths[IDim];
-      DimLengthGlob[StartDim + IDim]     = DimLengthsGlob[IDim];
+      if (Subfile and ThisDim->isDistributed()) {
+         auto SubIter = SubfileDims.find(DimName);
+         if (SubIter == SubfileDims.end()) {
+            LOG_ERROR("No subfile layout for dimension {} of Field {}",
+                      DimName, FieldName);
+            Err = 2;
+            return Err;
+         }
+         DimLengthsGlob[IDim]        = SubIter->second.Length;
+         DimOffsets[StartDim + IDim] = SubIter->second.Offset;
+      }
+      DimLengthLoc[StartDim + IDim]  = DimLengths[IDim];
+      DimLengthGlob[StartDim + IDim] = DimLengthsGlob[IDim];
       LocalSize *= DimLengths[IDim];
       GlobalSize *= DimLengthsGlob[IDim];
    }
 
+   // Use the cached decomposition if one exists for this data type and
+   // set of dimensions
+   DecompKey Key{Subfile, MyIOType, DimNames, DimLengthsGlob, DimLengths};
+   auto CacheIter = DecompCache.find(Key);
+   if (CacheIter != DecompCache.end()) {
+      DecompID = CacheIter->second;
+      return Err;
+   }
+
    // Create the data decomposition based on dimension information
    // Compute offset index (0-based global index of each element) in
    // linear address space. Needed for the decomposition definition.
@@ -813,12 +1103,14 @@ int IOStream::computeDecomp(
    }
 
    Err = OMEGA::IO::createDecomp(DecompID, MyIOType, NDims, DimLengthsGlob,
-                                 LocalSize, Offset, OMEGA::IO::DefaultRearr);
+                                 LocalSize, Offset, OMEGA::IO::DefaultRearr,
+                                 Subfile);
    if (Err != 0) {
       LOG_ERROR("Error creating decomp for field {} in stream {}", FieldName,
                 Name);
       return Err;
    }
+   DecompCache[Key] = DecompID;
 
    return Err;
 
@@ -899,21 +1191,213 @@ int IOStream::writeFieldMeta(
 } // End writeFieldMeta
 
 //------------------------------------------------------------------------------
-// Write a field's data array, performing any manipulations to reduce
-// precision or move data between host and device
-int IOStream::writeFieldData(
-    std::shared_ptr<Field> FieldPtr,      // [in] field to write
-    int FileID,                           // [in] id assigned to open file
-    int FieldID,                          // [in] id assigned to the field
-    std::map<std::string, int> &AllDimIDs // [in] dimension IDs
+// Quantizes floating point data to the input number of significant decimal
+// digits by rounding away the mantissa bits that are not needed (bit
+// rounding). The trailing zero bits make the data highly compressible. Fill
+// values and non-finite values are left unchanged.
+template <class RealType, class BitsType>
+static void quantizeData(RealType *Data,     // [inout] data to quantize
+                         int Size,           // [in] number of values
+                         RealType FillValue, // [in] missing value to retain
+                         int NumDigits       // [in] significant digits
+) {
+
+   static_assert(sizeof(RealType) == sizeof(BitsType));
+   constexpr int MantBits = std::numeric_limits<RealType>::digits - 1;
+
+   // Bits needed to represent the significant digits plus one for rounding
+   int KeepBits = std::ceil(NumDigits * std::log2(10.0)) + 1;
+   if (KeepBits >= MantBits)
+      return;
+
+   int DropBits  = MantBits - KeepBits;
+   BitsType Half = BitsType(1) << (DropBits - 1);
+   BitsType Mask = ~((BitsType(1) << DropBits) - 1);
+
+   for (int I = 0; I < Size; ++I) {
+      if (Data[I] == FillValue or !std::isfinite(Data[I]))
+         continue;
+      BitsType Bits;
+      std::memcpy(&Bits, &Data[I], sizeof(Bits));
+      Bits = (Bits + Half) & Mask;
+      std::memcpy(&Data[I], &Bits, sizeof(Bits));
+   }
+}
+
+static void quantizeData(R4 *Data, int Size, R4 FillValue, int NumDigits) {
+   quantizeData<R4, uint32_t>(Data, Size, FillValue, NumDigits);
+}
+
+static void quantizeData(R8 *Data, int Size, R8 FillValue, int NumDigits) {
+   quantizeData<R8, uint64_t>(Data, Size, FillValue, NumDigits);
+}
+
+//------------------------------------------------------------------------------
+// Allocates the staging pool and reserves the contiguous staging storage for
+// the largest field of each type so that reads and writes do not allocate
+void IOStream::sizeStagingPool() {
+
+   std::map<FieldType, I4> MaxSizes;
+   I4 MaxReduced = 0;
+   for (FieldHandle Handle : ContentHandles) {
+      std::shared_ptr<Field> ThisField = Field::get(Handle);
+      int NDims                        = ThisField->getNumDims();
+      if (NDims < 1)
+         continue;
+      std::vector<std::string> DimNames(NDims);
+      if (ThisField->getDimNames(DimNames) != 0)
+         continue;
+      I4 LocSize = 1;
+      for (int IDim = 0; IDim < NDims; ++IDim)
+         LocSize *= Dimension::getDimLengthLocal(DimNames[IDim]);
+      I4 &MaxSize = MaxSizes[ThisField->getType()];
+      MaxSize     = std::max(MaxSize, LocSize);
+      if (ThisField->getType() == FieldType::R8 and
+          reducesPrecision(*ThisField))
+         MaxReduced = std::max(MaxReduced, LocSize);
+   }
+
+   // The pool is sized in units of the largest data type
+   size_t PoolSize = 0;
+   for (auto [Type, MaxSize] : MaxSizes)
+      PoolSize = std::max(PoolSize, static_cast<size_t>(MaxSize));
+   if (PoolSize > StagingPool.extent(0))
+      StagingPool = Kokkos::View<R8 *, HostStagingSpace>(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "StagingPool"),
+          PoolSize);
+
+   SyncStaging.DataI4.reserve(MaxSizes[FieldType::I4]);
+   SyncStaging.DataI8.reserve(MaxSizes[FieldType::I8]);
+   SyncStaging.DataR4.reserve(MaxSizes[FieldType::R4]);
+   SyncStaging.DataR8.reserve(MaxSizes[FieldType::R8]);
+   // Reduced precision writes convert double precision fields to single
+   SyncStaging.DataR4.reserve(std::max(MaxSizes[FieldType::R4], MaxReduced));
+
+} // end sizeStagingPool
+
+//------------------------------------------------------------------------------
+// Copies a device array to the host using the staging pool for storage,
+// growing the pool if the array is larger than any field seen so far
+template <class ArrayType>
+IOStream::StagingArray<ArrayType>
+IOStream::stageHostCopy(const ArrayType &DevArray // [in] device array to copy
+) {
+
+   using ValueType = typename ArrayType::non_const_value_type;
+
+   size_t PoolSize =
+       (DevArray.span() * sizeof(ValueType) + sizeof(R8) - 1) / sizeof(R8);
+   if (PoolSize > StagingPool.extent(0))
+      StagingPool = Kokkos::View<R8 *, HostStagingSpace>(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "StagingPool"),
+          PoolSize);
+
+   StagingArray<ArrayType> HostCopy(
+       reinterpret_cast<ValueType *>(StagingPool.data()), DevArray.layout());
+   deepCopy(HostCopy, DevArray);
+
+   return HostCopy;
+
+} // end stageHostCopy
+
+//------------------------------------------------------------------------------
+// Typed access to field data arrays. The array type of a field is resolved
+// once from its data type, rank and memory location, and the staging code is
+// instantiated for every supported array type instead of being written out
+// for each combination.
+
+// Kokkos data type of an array of rank N with value type T, eg T*** for N = 3
+template <class T, int N> struct ArrayDataType {
+   using type = typename ArrayDataType<T, N - 1>::type *;
+};
+template <class T> struct ArrayDataType<T, 0> {
+   using type = T;
+};
+
+// True if an array can be accessed directly from the host
+template <class ArrayType>
+inline constexpr bool isHostAccessible =
+    Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                               typename ArrayType::memory_space>::accessible;
+
+// Calls Func with the data array of a field of value type T and the
+// rank N, on the host or device depending on the field memory location
+template <class T, int N, class F>
+static int visitFieldArrayRank(Field &ThisField, // [in] field to access
+                               F &Func           // [in] function of the array
+) {
+   using DataType = typename ArrayDataType<T, N>::type;
+   if (ThisField.isOnHost())
+      return Func(ThisField.getDataArray<
+                  Kokkos::View<DataType, HostMemLayout, HostMemSpace>>());
+   return Func(
+       ThisField.getDataArray<Kokkos::View<DataType, MemLayout, MemSpace>>());
+}
+
+template <class T, class F, int... N>
+static int visitFieldArrayType(Field &ThisField, // [in] field to access
+                               F &Func, // [in] function of the array
+                               std::integer_sequence<int, N...>) {
+   const int NDims = ThisField.getNumDims();
+   int Err         = 2; // unsupported rank
+   ((NDims == N and (Err = visitFieldArrayRank<T, N>(ThisField, Func), true)) or
+    ...);
+   return Err;
+}
+
+// Calls Func with the typed data array of a field and returns the error code
+// of Func, or 2 for an unsupported rank and 3 for an unknown data type
+template <class F>
+static int visitFieldArray(Field &ThisField, // [in] field to access
+                           F &&Func          // [in] function of the array
+) {
+   using Ranks = std::integer_sequence<int, 1, 2, 3, 4, 5>;
+   switch (ThisField.getType()) {
+   case FieldType::I4:
+      return visitFieldArrayType<I4>(ThisField, Func, Ranks{});
+   case FieldType::I8:
+      return visitFieldArrayType<I8>(ThisField, Func, Ranks{});
+   case FieldType::R4:
+      return visitFieldArrayType<R4>(ThisField, Func, Ranks{});
+   case FieldType::R8:
+      return visitFieldArrayType<R8>(ThisField, Func, Ranks{});
+   default:
+      return 3;
+   }
+}
+
+// Wraps a staging vector as a contiguous host array of the local dimension
+// lengths, in the index order of the IO library (last index fastest)
+template <class T, size_t... I>
+static auto
+wrapStagingVector(std::vector<T> &Vec,                // [in] staging vector
+                  const std::vector<int> &DimLengths, // [in] local lengths
+                  std::index_sequence<I...>) {
+   using DataType = typename ArrayDataType<T, sizeof...(I)>::type;
+   return Kokkos::View<DataType, Kokkos::LayoutRight, Kokkos::HostSpace,
+                       Kokkos::MemoryUnmanaged>(Vec.data(), DimLengths[I]...);
+}
+
+// Restricts an array to its local dimension lengths
+template <class ArrayType, size_t... I>
+static auto localSubview(const ArrayType &Array, // [in] full array
+                         const std::vector<int> &DimLengths, // [in] lengths
+                         std::index_sequence<I...>) {
+   return Kokkos::subview(Array, std::make_pair(0, DimLengths[I])...);
+}
+
+//------------------------------------------------------------------------------
+// Copy a field's data array into contiguous host storage, performing any
+// manipulations to reduce precision or move data between host and device
+int IOStream::stageFieldData(
+    std::shared_ptr<Field> FieldPtr, // [in] field to stage
+    StagedField &Staged              // [out] staged host copy of data
 ) {
 
    int Err = 0;
 
    // Retrieve some basic field information
    std::string FieldName = FieldPtr->getName();
-   bool OnHost           = FieldPtr->isOnHost();
-   FieldType MyType      = FieldPtr->getType();
    int NDims             = FieldPtr->getNumDims();
    if (NDims < 1) {
       LOG_ERROR("Invalid number of dimensions for Field {}", FieldName);
@@ -921,6 +1405,94 @@ int IOStream::writeFieldData(
       return Err;
    }
 
+   // Determine the local dimension lengths and array size. The parallel
+   // decomposition is created later when the data is written since it
+   // requires collective calls to the IO library.
+   std::vector<std::string> DimNames(NDims);
+   Err = FieldPtr->getDimNames(DimNames);
+   if (Err != 0) {
+      LOG_ERROR("Error retrieving dimension names for Field {}", FieldName);
+      return Err;
+   }
+   int LocSize = 1;
+   std::vector<int> DimLengths(NDims);
+   for (int IDim = 0; IDim < NDims; ++IDim) {
+      DimLengths[IDim] = Dimension::getDimLengthLocal(DimNames[IDim]);
+      LocSize *= DimLengths[IDim];
+   }
+
+   // Copy the local part of the array into the contiguous staging vector of
+   // its type, in the index order of the IO library (last index fastest).
+   // Device arrays are first copied to the host through the staging pool.
+   // The staged storage persists between calls so that the vectors for
+   // contiguous storage are only reallocated if the field size changes.
+   Err = visitFieldArray(*FieldPtr, [&](const auto &Data) {
+      using ArrayType = std::decay_t<decltype(Data)>;
+      using T         = typename ArrayType::non_const_value_type;
+      using Dims      = std::make_index_sequence<ArrayType::rank>;
+
+      T &FillVal = Staged.fillValue<T>();
+      if (FieldPtr->getMetadata("FillValue", FillVal) != 0) {
+         LOG_ERROR("Error retrieving FillValue for Field {}", FieldName);
+         return 4;
+      }
+      std::vector<T> &Vec = Staged.data<T>();
+      Vec.resize(LocSize);
+      Staged.DataPtr    = Vec.data();
+      Staged.FillValPtr = &FillVal;
+
+      auto Contig = wrapStagingVector(Vec, DimLengths, Dims{});
+      if constexpr (isHostAccessible<ArrayType>) {
+         Kokkos::deep_copy(Contig, localSubview(Data, DimLengths, Dims{}));
+      } else {
+         auto HostData = stageHostCopy(Data);
+         Kokkos::deep_copy(Contig, localSubview(HostData, DimLengths, Dims{}));
+      }
+
+      // Convert double precision data to single precision if requested
+      if constexpr (std::is_same_v<T, R8>) {
+         if (reducesPrecision(*FieldPtr)) {
+            Staged.FillValR4 = FillVal;
+            Staged.DataR4.assign(Vec.begin(), Vec.end());
+            Staged.DataPtr    = Staged.DataR4.data();
+            Staged.FillValPtr = &Staged.FillValR4;
+         }
+      }
+      return 0;
+   });
+   if (Err == 3)
+      LOG_ERROR("Cannot determine data type for field {}", FieldName);
+
+   // Quantize floating point data if requested for this field
+   auto DigitsIter = SignificantDigits.find(FieldName);
+   if (Err == 0 and DigitsIter != SignificantDigits.end()) {
+      if (Staged.DataPtr == Staged.DataR4.data())
+         quantizeData(Staged.DataR4.data(), LocSize, Staged.FillValR4,
+                      DigitsIter->second);
+      if (Staged.DataPtr == Staged.DataR8.data())
+         quantizeData(Staged.DataR8.data(), LocSize, Staged.FillValR8,
+                      DigitsIter->second);
+   }
+
+   return Err;
+
+} // end stageFieldData
+
+//------------------------------------------------------------------------------
+// Write a staged field data array to an open file
+int IOStream::writeStagedData(
+    std::shared_ptr<Field> FieldPtr,      // [in] field to write
+    const StagedField &Staged,            // [in] staged copy of data
+    int FileID,                           // [in] id assigned to open file
+    int FieldID,                          // [in] id assigned to the field
+    std::map<std::string, int> &AllDimIDs // [in] dimension IDs
+) {
+
+   int Err = 0;
+
+   std::string FieldName = FieldPtr->getName();
+   int NDims             = FieldPtr->getNumDims();
+
    // Create the decomposition needed for parallel I/O
    int MyDecompID;
    int LocSize;
@@ -931,641 +1503,42 @@ int IOStream::writeFieldData(
       return Err;
    }
 
-   // Extract and write the array of data based on the type, dimension and
-   // memory location. The IO routines require a contiguous data pointer on
-   // the host. Kokkos array types do not guarantee contigous memory for
-   // multi-dimensional arrays. Here we create a contiguous space and perform
-   // any other transformations (host-device data transfer, reduce precision).
-   void *DataPtr;
-   void *FillValPtr;
-
-   // Vector for contiguous storage - the appropriate vector will be
-   // selected and resized later.
-   std::vector<I4> DataI4(1);
-   std::vector<I8> DataI8(1);
-   std::vector<R4> DataR4(1);
-   std::vector<R8> DataR8(1);
-   I4 FillValI4;
-   I8 FillValI8;
-   R4 FillValR4;
-   R8 FillValR8;
+   // Write the data
+   Err = OMEGA::IO::writeArray(Staged.DataPtr, LocSize, Staged.FillValPtr,
+                               FileID, MyDecompID, FieldID);
+   if (Err != 0) {
+      LOG_ERROR("Error writing data array for field {} in stream {}", FieldName,
+                Name);
+      return Err;
+   }
 
-   switch (MyType) {
+   return Err;
 
-   // I4 Fields
-   case FieldType::I4:
+} // end writeStagedData
 
-      DataI4.resize(LocSize);
-      DataPtr = DataI4.data();
-      // get fill value
-      Err = FieldPtr->getMetadata("FillValue", FillValI4);
-      if (Err != 0) {
-         LOG_ERROR("Error retrieving FillValue for Field {}", FieldName);
-         Err = 4;
-         return Err;
-      }
-      FillValPtr = &FillValI4;
+//------------------------------------------------------------------------------
+// Write a field's data array, performing any manipulations to reduce
+// precision or move data between host and device
+int IOStream::writeFieldData(
+    std::shared_ptr<Field> FieldPtr,      // [in] field to write
+    int FileID,                           // [in] id assigned to open file
+    int FieldID,                          // [in] id assigned to the field
+    std::map<std::string, int> &AllDimIDs // [in] dimension IDs
+) {
 
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DI4 Data = FieldPtr->getDataArray<HostArray1DI4>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataI4[I] = Data(I);
-            }
-         } else {
-            Array1DI4 DataTmp  = FieldPtr->getDataArray<Array1DI4>();
-            HostArray1DI4 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataI4[I] = Data(I);
-            }
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DI4 Data = FieldPtr->getDataArray<HostArray2DI4>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataI4[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DI4 DataTmp  = FieldPtr->getDataArray<Array2DI4>();
-            HostArray2DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataI4[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DI4 Data = FieldPtr->getDataArray<HostArray3DI4>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataI4[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DI4 DataTmp  = FieldPtr->getDataArray<Array3DI4>();
-            HostArray3DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataI4[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DI4 Data = FieldPtr->getDataArray<HostArray4DI4>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataI4[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DI4 DataTmp  = FieldPtr->getDataArray<Array4DI4>();
-            HostArray4DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataI4[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DI4 Data = FieldPtr->getDataArray<HostArray5DI4>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataI4[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DI4 DataTmp  = FieldPtr->getDataArray<Array5DI4>();
-            HostArray5DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataI4[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         }
-         break;
+   int Err = 0;
 
-      } // end switch NDims
-      break; // end I4 type
+   // Copy the data into the reusable contiguous host storage
+   Err = stageFieldData(FieldPtr, SyncStaging);
+   if (Err != 0) {
+      LOG_ERROR("Error staging data for Field {}", FieldPtr->getName());
+      return Err;
+   }
 
-   // I8 Fields
-   case FieldType::I8:
+   // Write the data
+   Err = writeStagedData(FieldPtr, SyncStaging, FileID, FieldID, AllDimIDs);
 
-      DataI8.resize(LocSize);
-      DataPtr = DataI8.data();
-      // Get fill value
-      Err = FieldPtr->getMetadata("FillValue", FillValI8);
-      if (Err != 0) {
-         LOG_ERROR("Error retrieving FillValue for Field {}", FieldName);
-         Err = 4;
-         return Err;
-      }
-      FillValPtr = &FillValI8;
-
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DI8 Data = FieldPtr->getDataArray<HostArray1DI8>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataI8[I] = Data(I);
-            }
-         } else {
-            Array1DI8 DataTmp  = FieldPtr->getDataArray<Array1DI8>();
-            HostArray1DI8 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataI8[I] = Data(I);
-            }
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DI8 Data = FieldPtr->getDataArray<HostArray2DI8>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataI8[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DI8 DataTmp  = FieldPtr->getDataArray<Array2DI8>();
-            HostArray2DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataI8[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DI8 Data = FieldPtr->getDataArray<HostArray3DI8>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataI8[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DI8 DataTmp  = FieldPtr->getDataArray<Array3DI8>();
-            HostArray3DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataI8[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DI8 Data = FieldPtr->getDataArray<HostArray4DI8>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataI8[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DI8 DataTmp  = FieldPtr->getDataArray<Array4DI8>();
-            HostArray4DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataI8[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DI8 Data = FieldPtr->getDataArray<HostArray5DI8>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataI8[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DI8 DataTmp  = FieldPtr->getDataArray<Array5DI8>();
-            HostArray5DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataI8[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         }
-         break;
-      } // end switch NDims
-      break; // end I8 type
-
-   // R4 Fields
-   case FieldType::R4:
-
-      DataR4.resize(LocSize);
-      DataPtr = DataR4.data();
-      // Get fill value
-      Err = FieldPtr->getMetadata("FillValue", FillValR4);
-      if (Err != 0) {
-         LOG_ERROR("Error retrieving FillValue for Field {}", FieldName);
-         Err = 4;
-         return Err;
-      }
-      FillValPtr = &FillValR4;
-
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DR4 Data = FieldPtr->getDataArray<HostArray1DR4>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataR4[I] = Data(I);
-            }
-         } else {
-            Array1DR4 DataTmp  = FieldPtr->getDataArray<Array1DR4>();
-            HostArray1DR4 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataR4[I] = Data(I);
-            }
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DR4 Data = FieldPtr->getDataArray<HostArray2DR4>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataR4[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DR4 DataTmp  = FieldPtr->getDataArray<Array2DR4>();
-            HostArray2DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataR4[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DR4 Data = FieldPtr->getDataArray<HostArray3DR4>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataR4[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DR4 DataTmp  = FieldPtr->getDataArray<Array3DR4>();
-            HostArray3DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataR4[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DR4 Data = FieldPtr->getDataArray<HostArray4DR4>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataR4[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DR4 DataTmp  = FieldPtr->getDataArray<Array4DR4>();
-            HostArray4DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataR4[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DR4 Data = FieldPtr->getDataArray<HostArray5DR4>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataR4[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DR4 DataTmp  = FieldPtr->getDataArray<Array5DR4>();
-            HostArray5DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataR4[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         }
-         break;
-      } // end switch NDims
-      break; // end R4 type
-
-   // R8 Fields
-   case FieldType::R8:
-
-      // Get fill value
-      Err = FieldPtr->getMetadata("FillValue", FillValR8);
-      if (Err != 0) {
-         LOG_ERROR("Error retrieving FillValue for Field {}", FieldName);
-         Err = 4;
-         return Err;
-      }
-      DataR8.resize(LocSize);
-      if (ReducePrecision) {
-         FillValR4  = FillValR8;
-         FillValPtr = &FillValR4;
-         DataR4.resize(LocSize);
-         DataPtr = DataR4.data();
-      } else {
-         FillValPtr = &FillValR8;
-         DataPtr    = DataR8.data();
-      }
-
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DR8 Data = FieldPtr->getDataArray<HostArray1DR8>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataR8[I] = Data(I);
-            }
-         } else {
-            Array1DR8 DataTmp  = FieldPtr->getDataArray<Array1DR8>();
-            HostArray1DR8 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataR8[I] = Data(I);
-            }
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DR8 Data = FieldPtr->getDataArray<HostArray2DR8>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataR8[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DR8 DataTmp  = FieldPtr->getDataArray<Array2DR8>();
-            HostArray2DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataR8[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DR8 Data = FieldPtr->getDataArray<HostArray3DR8>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataR8[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DR8 DataTmp  = FieldPtr->getDataArray<Array3DR8>();
-            HostArray3DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataR8[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DR8 Data = FieldPtr->getDataArray<HostArray4DR8>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataR8[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DR8 DataTmp  = FieldPtr->getDataArray<Array4DR8>();
-            HostArray4DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataR8[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DR8 Data = FieldPtr->getDataArray<HostArray5DR8>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataR8[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DR8 DataTmp  = FieldPtr->getDataArray<Array5DR8>();
-            HostArray5DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataR8[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         }
-         break;
-      } // end switch NDims
-      if (ReducePrecision) {
-         for (int I = 0; I < LocSize; ++I) {
-            DataR4[I] = DataR8[I];
-         }
-      }
-      break; // end R8 type
-
-   default:
-      LOG_ERROR("Cannot determine data type for field {}", FieldName);
-      Err = 3;
-      break;
-
-   } // end switch data type
-
-   // Write the data
-   Err = OMEGA::IO::writeArray(DataPtr, LocSize, FillValPtr, FileID, MyDecompID,
-                               FieldID);
-   if (Err != 0) {
-      LOG_ERROR("Error writing data array for field {} in stream {}", FieldName,
-                Name);
-      return Err;
-   }
-
-   // Clean up the decomp
-   Err = OMEGA::IO::destroyDecomp(MyDecompID);
-   if (Err != 0) {
-      LOG_ERROR("Error destroying decomp for field {} in stream {}", FieldName,
-                Name);
-      return Err;
-   }
-
-   return Err;
+   return Err;
 
 } // end writeFieldData
 
@@ -1587,8 +1560,6 @@ int IOStream::readFieldData(
    // lower case
    std::string OldFieldName = FieldName;
    OldFieldName[0]          = std::tolower(OldFieldName[0]);
-   bool OnHost              = FieldPtr->isOnHost();
-   FieldType MyType         = FieldPtr->getType();
    int NDims                = FieldPtr->getNumDims();
    if (NDims < 1) {
       LOG_ERROR("Invalid number of dimensions for Field {}", FieldName);
@@ -1607,27 +1578,20 @@ int IOStream::readFieldData(
    }
 
    // The IO routines require a pointer to a contiguous memory on the host
-   // so we first read into a vector. Only one of the vectors below will
-   // be used and resized appropriately.
-   void *DataPtr;
-   std::vector<I4> DataI4(1);
-   std::vector<I8> DataI8(1);
-   std::vector<R4> DataR4(1);
-   std::vector<R8> DataR8(1);
-
-   switch (MyType) {
-   case FieldType::I4:
-      DataI4.resize(LocSize);
-      DataPtr = DataI4.data();
-   case FieldType::I8:
-      DataI8.resize(LocSize);
-      DataPtr = DataI8.data();
-   case FieldType::R4:
-      DataR4.resize(LocSize);
-      DataPtr = DataR4.data();
-   case FieldType::R8:
-      DataR8.resize(LocSize);
-      DataPtr = DataR8.data();
+   // so we first read into a vector. The vectors are part of the reusable
+   // staging storage of the stream and only the vector matching the field
+   // type will be used and resized appropriately.
+   void *DataPtr = nullptr;
+   Err           = visitFieldArray(*FieldPtr, [&](const auto &Data) {
+      using T = typename std::decay_t<decltype(Data)>::non_const_value_type;
+      std::vector<T> &Vec = SyncStaging.data<T>();
+      Vec.resize(LocSize);
+      DataPtr = Vec.data();
+      return 0;
+   });
+   if (Err != 0) {
+      LOG_ERROR("Cannot determine data type for field {}", FieldName);
+      return Err;
    }
 
    // read data into vector
@@ -1646,570 +1610,26 @@ int IOStream::readFieldData(
       }
    }
 
-   // Unpack vector into array based on type, dims and location
-   switch (MyType) {
+   // Unpack vector into the local part of the array, copying device arrays
+   // through the staging pool
+   Err = visitFieldArray(*FieldPtr, [&](auto Data) {
+      using ArrayType = decltype(Data);
+      using T         = typename ArrayType::non_const_value_type;
+      using Dims      = std::make_index_sequence<ArrayType::rank>;
 
-   // I4 Fields
-   case FieldType::I4:
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DI4 Data = FieldPtr->getDataArray<HostArray1DI4>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataI4[I];
-            }
-         } else {
-            Array1DI4 DataTmp  = FieldPtr->getDataArray<Array1DI4>();
-            HostArray1DI4 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataI4[I];
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DI4 Data = FieldPtr->getDataArray<HostArray2DI4>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataI4[VecAdd];
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DI4 DataTmp  = FieldPtr->getDataArray<Array2DI4>();
-            HostArray2DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataI4[VecAdd];
-                  ++VecAdd;
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DI4 Data = FieldPtr->getDataArray<HostArray3DI4>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataI4[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DI4 DataTmp  = FieldPtr->getDataArray<Array3DI4>();
-            HostArray3DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataI4[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DI4 Data = FieldPtr->getDataArray<HostArray4DI4>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataI4[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DI4 DataTmp  = FieldPtr->getDataArray<Array4DI4>();
-            HostArray4DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataI4[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DI4 Data = FieldPtr->getDataArray<HostArray5DI4>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataI4[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DI4 DataTmp  = FieldPtr->getDataArray<Array5DI4>();
-            HostArray5DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataI4[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      } // end switch NDims
-      break; // end I4 fields
-
-   // I8 Fields
-   case FieldType::I8:
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DI8 Data = FieldPtr->getDataArray<HostArray1DI8>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataI8[I];
-            }
-         } else {
-            Array1DI8 DataTmp  = FieldPtr->getDataArray<Array1DI8>();
-            HostArray1DI8 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataI8[I];
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DI8 Data = FieldPtr->getDataArray<HostArray2DI8>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataI8[VecAdd];
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DI8 DataTmp  = FieldPtr->getDataArray<Array2DI8>();
-            HostArray2DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataI8[VecAdd];
-                  ++VecAdd;
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DI8 Data = FieldPtr->getDataArray<HostArray3DI8>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataI8[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DI8 DataTmp  = FieldPtr->getDataArray<Array3DI8>();
-            HostArray3DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataI8[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DI8 Data = FieldPtr->getDataArray<HostArray4DI8>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataI8[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DI8 DataTmp  = FieldPtr->getDataArray<Array4DI8>();
-            HostArray4DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataI8[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DI8 Data = FieldPtr->getDataArray<HostArray5DI8>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataI8[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DI8 DataTmp  = FieldPtr->getDataArray<Array5DI8>();
-            HostArray5DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataI8[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      } // end switch NDims
-      break; // end I8 fields
-
-   // R4 Fields
-   case FieldType::R4:
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DR4 Data = FieldPtr->getDataArray<HostArray1DR4>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataR4[I];
-            }
-         } else {
-            Array1DR4 DataTmp  = FieldPtr->getDataArray<Array1DR4>();
-            HostArray1DR4 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataR4[I];
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DR4 Data = FieldPtr->getDataArray<HostArray2DR4>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataR4[VecAdd];
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DR4 DataTmp  = FieldPtr->getDataArray<Array2DR4>();
-            HostArray2DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataR4[VecAdd];
-                  ++VecAdd;
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DR4 Data = FieldPtr->getDataArray<HostArray3DR4>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataR4[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DR4 DataTmp  = FieldPtr->getDataArray<Array3DR4>();
-            HostArray3DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataR4[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DR4 Data = FieldPtr->getDataArray<HostArray4DR4>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataR4[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DR4 DataTmp  = FieldPtr->getDataArray<Array4DR4>();
-            HostArray4DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataR4[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DR4 Data = FieldPtr->getDataArray<HostArray5DR4>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataR4[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DR4 DataTmp  = FieldPtr->getDataArray<Array5DR4>();
-            HostArray5DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataR4[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      } // end switch NDims
-      break; // end R4 fields
-
-   // R8 Fields
-   case FieldType::R8:
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DR8 Data = FieldPtr->getDataArray<HostArray1DR8>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataR8[I];
-            }
-         } else {
-            Array1DR8 DataTmp  = FieldPtr->getDataArray<Array1DR8>();
-            HostArray1DR8 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataR8[I];
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DR8 Data = FieldPtr->getDataArray<HostArray2DR8>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataR8[VecAdd];
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DR8 DataTmp  = FieldPtr->getDataArray<Array2DR8>();
-            HostArray2DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataR8[VecAdd];
-                  ++VecAdd;
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DR8 Data = FieldPtr->getDataArray<HostArray3DR8>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataR8[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DR8 DataTmp  = FieldPtr->getDataArray<Array3DR8>();
-            HostArray3DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataR8[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DR8 Data = FieldPtr->getDataArray<HostArray4DR8>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataR8[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DR8 DataTmp  = FieldPtr->getDataArray<Array4DR8>();
-            HostArray4DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataR8[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DR8 Data = FieldPtr->getDataArray<HostArray5DR8>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataR8[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DR8 DataTmp  = FieldPtr->getDataArray<Array5DR8>();
-            HostArray5DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataR8[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      } // end switch NDims
-      break; // end R8 fields
-
-   default:
-      LOG_ERROR("Invalid data type while reading field {} for stream {}",
-                FieldName, Name);
-      Err = 3;
-      return Err;
-      break;
-
-   } // end switch data type
-
-   // Clean up the decomp
-   Err = OMEGA::IO::destroyDecomp(DecompID);
+      auto Contig =
+          wrapStagingVector(SyncStaging.data<T>(), DimLengths, Dims{});
+      if constexpr (isHostAccessible<ArrayType>) {
+         Kokkos::deep_copy(localSubview(Data, DimLengths, Dims{}), Contig);
+      } else {
+         auto HostData = stageHostCopy(Data);
+         Kokkos::deep_copy(localSubview(HostData, DimLengths, Dims{}), Contig);
+         deepCopy(Data, HostData);
+      }
+      return 0;
+   });
    if (Err != 0) {
-      LOG_ERROR("Error destroying decomp after reading field {} in stream {}",
+      LOG_ERROR("Invalid data type while reading field {} for stream {}",
                 FieldName, Name);
       return Err;
    }
@@ -2247,6 +1667,24 @@ int IOStream::readStream(
       }
    }
 
+   // Make sure the contents are valid and the field handles are set
+   if (!validate()) {
+      LOG_ERROR("IOStream read: invalid contents for stream {}", Name);
+      Err = 2;
+      return Err;
+   }
+
+   TimerRegion ReadTimer("IOStream");
+
+   // Complete any asynchronous write first, both to keep the collective IO
+   // calls in order and in case this read depends on the written file
+   Err = waitForPendingWrite();
+   if (Err != 0) {
+      LOG_ERROR("Error completing asynchronous write before reading stream {}",
+                Name);
+      return Err;
+   }
+
    // Get current simulation time and time string
    TimeInstant SimTime    = ModelClock.getCurrentTime();
    std::string SimTimeStr = SimTime.getString(5, 0, "_");
@@ -2258,6 +1696,21 @@ int IOStream::readStream(
       MyAlarm.reset(SimTime);
 
    // Create filename
+   std::string InFileName = getReadFilename(ModelClock);
+
+   Err = readFile(InFileName, ReqMetadata);
+
+   // End of routine - return
+   return Err;
+
+} // End read
+
+//------------------------------------------------------------------------------
+// Returns the name of the file to read at the current time of the clock
+std::string IOStream::getReadFilename(
+    const Clock &ModelClock // [in] model clock for sim time
+) {
+
    std::string InFileName;
    // If using pointer files for this stream, read the filename from the pointer
    if (UsePointer) {
@@ -2271,9 +1724,24 @@ int IOStream::readStream(
       InFileName = Filename;
    }
 
+   return InFileName;
+
+} // End getReadFilename
+
+//------------------------------------------------------------------------------
+// Opens and reads the input file for the stream, including any requested
+// global metadata. For asynchronous reads, this is called from a background
+// thread and must not modify any shared state.
+int IOStream::readFile(
+    const std::string &InFileName, // [in] name of file
+    Metadata &ReqMetadata          // [inout] global metadata to extract
+) {
+
+   int Err = 0; // default return code
+
    // Open input file
    int InFileID;
-   Err = OMEGA::IO::openFile(InFileID, InFileName, Mode, IO::FmtDefault,
+   Err = OMEGA::IO::openFile(InFileID, InFileName, Mode, FileFormat,
                              ExistAction);
    if (Err != 0) {
       LOG_ERROR("Error opening file {} for input", InFileName);
@@ -2335,11 +1803,11 @@ int IOStream::readStream(
    }
 
    // For each field in the contents, define field and read field data
-   for (auto IFld = Contents.begin(); IFld != Contents.end(); ++IFld) {
+   for (FieldHandle Handle : ContentHandles) {
 
-      // Retrieve the field name and pointer
-      std::string FieldName            = *IFld;
-      std::shared_ptr<Field> ThisField = Field::get(FieldName);
+      // Retrieve the field pointer and name
+      std::shared_ptr<Field> ThisField = Field::get(Handle);
+      std::string FieldName            = ThisField->getName();
 
       // Extract the data pointer and read the data array
       int FieldID; // not currently used but available if field metadata needed
@@ -2361,10 +1829,9 @@ int IOStream::readStream(
 
    LOG_INFO("Successfully read stream {} from file {}", Name, InFileName);
 
-   // End of routine - return
    return Err;
 
-} // End read
+} // End readFile
 
 //------------------------------------------------------------------------------
 // Writes stream. This is the internal member write function used by the
@@ -2397,6 +1864,15 @@ int IOStream::writeStream(
       }
    }
 
+   // Make sure the contents are valid and the field handles are set
+   if (!validate()) {
+      LOG_ERROR("IOStream write: invalid contents for stream {}", Name);
+      Err = 2;
+      return Err;
+   }
+
+   TimerRegion WriteTimer("IOStream");
+
    // Get current simulation time and time string
    TimeInstant SimTime    = ModelClock.getCurrentTime();
    std::string SimTimeStr = SimTime.getString(4, 0, "_");
@@ -2416,23 +1892,43 @@ int IOStream::writeStream(
       OutFileName = Filename;
    }
 
-   // Open output file
-   int OutFileID;
-   Err = OMEGA::IO::openFile(OutFileID, OutFileName, Mode, IO::FmtDefault,
-                             ExistAction);
-   if (Err != 0) {
-      LOG_ERROR("IOStream::write: error opening file {} for output",
-                OutFileName);
-      return Err;
+   // Asynchronous writes first take a snapshot of all field data in the
+   // staging buffers not used by any outstanding write
+   std::map<std::string, StagedField> *Staged = nullptr;
+   if (AsyncWrite) {
+      Staged = &StagingBuffers[ActiveBuffer];
+      for (FieldHandle Handle : ContentHandles) {
+         std::shared_ptr<Field> ThisField = Field::get(Handle);
+         std::string FieldName            = ThisField->getName();
+         Err = stageFieldData(ThisField, (*Staged)[FieldName]);
+         if (Err != 0) {
+            LOG_ERROR("Error staging data for Field {} in Stream {}", FieldName,
+                      Name);
+            return Err;
+         }
+      }
    }
 
-   // Write Metadata for global metadata (Code and Simulation)
-   // Always add current simulation time to Simulation metadata
-   Err = writeFieldMeta(CodeMeta, OutFileID, IO::GlobalID);
+   // Only one write can be in flight, so complete any outstanding write
+   // before modifying metadata or calling the IO library
+   Err = waitForPendingWrite();
    if (Err != 0) {
-      LOG_ERROR("Error writing Code Metadata to file {}", OutFileName);
+      LOG_ERROR("Error completing asynchronous write before writing stream {}",
+                Name);
       return Err;
    }
+
+   // The layout of node subfiles is computed on the main thread since it
+   // requires communication between the tasks of each node
+   if (UseSubfiles) {
+      Err = computeSubfileDims();
+      if (Err != 0) {
+         LOG_ERROR("Error computing subfile layout for stream {}", Name);
+         return Err;
+      }
+   }
+
+   // Always add current simulation time to Simulation metadata
    std::shared_ptr<Field> SimField = Field::get(SimMeta);
    // Add the simulation time - if it was added previously, remove and
    // re-add the current time
@@ -2443,6 +1939,57 @@ int IOStream::writeStream(
       LOG_ERROR("Error adding current sim time to output {}", OutFileName);
       return Err;
    }
+
+   // For asynchronous writes, write the file from the staged data on a
+   // background thread and return. The next write of this stream will
+   // use the other set of staging buffers.
+   if (AsyncWrite) {
+      PendingWrite =
+          std::async(std::launch::async, [this, OutFileName, Staged]() {
+             return writeFile(OutFileName, Staged);
+          });
+      ActiveBuffer = 1 - ActiveBuffer;
+      return Err;
+   }
+
+   Err = writeFile(OutFileName, Staged);
+
+   // End of routine - return
+   return Err;
+
+} // end writeStream
+
+//------------------------------------------------------------------------------
+// Opens, defines and writes the output file for the stream. Field data is
+// taken from the staging buffers if present, otherwise each field is staged
+// as it is written. For asynchronous writes, this is called from a
+// background thread and must not modify any shared state.
+int IOStream::writeFile(
+    const std::string &OutFileName,            // [in] name of file
+    std::map<std::string, StagedField> *Staged // [in] staged data or nullptr
+) {
+
+   int Err = 0; // default return code
+
+   // Open output file. Node subfiles are only opened by the tasks of the
+   // node.
+   int OutFileID;
+   std::string FileName = OutFileName;
+   if (UseSubfiles)
+      FileName = buildSubfileName(OutFileName, IO::NodeID);
+   Err = OMEGA::IO::openFile(OutFileID, FileName, Mode, FileFormat,
+                             ExistAction, UseSubfiles);
+   if (Err != 0) {
+      LOG_ERROR("IOStream::write: error opening file {} for output", FileName);
+      return Err;
+   }
+
+   // Write Metadata for global metadata (Code and Simulation)
+   Err = writeFieldMeta(CodeMeta, OutFileID, IO::GlobalID);
+   if (Err != 0) {
+      LOG_ERROR("Error writing Code Metadata to file {}", OutFileName);
+      return Err;
+   }
    Err = writeFieldMeta(SimMeta, OutFileID, IO::GlobalID);
    if (Err != 0) {
       LOG_ERROR("Error writing Simulation Metadata to file {}", OutFileName);
@@ -2457,16 +2004,26 @@ int IOStream::writeStream(
       return Err;
    }
 
+   // Node subfiles also contain the global index of their entries
+   std::map<std::string, int> IndexIDs;
+   if (UseSubfiles) {
+      Err = defineSubfileIndex(OutFileID, AllDimIDs, IndexIDs);
+      if (Err != 0) {
+         LOG_ERROR("Error defining subfile index for file {}", FileName);
+         return Err;
+      }
+   }
+
    // Define each field and write field metadata
    std::map<std::string, int> FieldIDs;
    I4 NDims;
    std::vector<std::string> DimNames;
    std::vector<int> FieldDims;
-   for (auto IFld = Contents.begin(); IFld != Contents.end(); ++IFld) {
+   for (FieldHandle Handle : ContentHandles) {
 
       // Retrieve the field pointer
-      std::string FieldName            = *IFld;
-      std::shared_ptr<Field> ThisField = Field::get(FieldName);
+      std::shared_ptr<Field> ThisField = Field::get(Handle);
+      std::string FieldName            = ThisField->getName();
 
       // Retrieve the dimensions for this field and determine dim IDs
       NDims = ThisField->getNumDims();
@@ -2501,6 +2058,14 @@ int IOStream::writeStream(
       }
       FieldIDs[FieldName] = FieldID;
 
+      // Set any chunking and compression for the field
+      Err = defineVarStorage(OutFileID, FieldID, ThisField, DimNames);
+      if (Err != 0) {
+         LOG_ERROR("Error defining storage for field {} in stream {}",
+                   FieldName, Name);
+         return Err;
+      }
+
       // Now we can write the field metadata
       Err = writeFieldMeta(FieldName, OutFileID, FieldID);
       if (Err != 0) {
@@ -2518,29 +2083,50 @@ int IOStream::writeStream(
    }
 
    // Now write data arrays for all fields in contents
-   for (auto IFld = Contents.begin(); IFld != Contents.end(); ++IFld) {
+   for (FieldHandle Handle : ContentHandles) {
 
       // Retrieve the field pointer and FieldID
-      std::string FieldName            = *IFld;
-      std::shared_ptr<Field> ThisField = Field::get(FieldName);
+      std::shared_ptr<Field> ThisField = Field::get(Handle);
+      std::string FieldName            = ThisField->getName();
       int FieldID                      = FieldIDs[FieldName];
 
-      // Extract and write the data array
-      Err = this->writeFieldData(ThisField, OutFileID, FieldID, AllDimIDs);
+      // Write the staged data array or extract and write the data array
+      if (Staged != nullptr) {
+         Err = writeStagedData(ThisField, (*Staged)[FieldName], OutFileID,
+                               FieldID, AllDimIDs);
+      } else {
+         Err = writeFieldData(ThisField, OutFileID, FieldID, AllDimIDs);
+      }
       if (Err != 0) {
          LOG_ERROR("Error writing field data for Field {} in Stream {}",
                    FieldName, Name);
          return Err;
       }
    }
+   if (UseSubfiles) {
+      Err = writeSubfileIndex(OutFileID, IndexIDs);
+      if (Err != 0) {
+         LOG_ERROR("Error writing subfile index for file {}", FileName);
+         return Err;
+      }
+   }
 
    // Close output file
    Err = IO::closeFile(OutFileID);
    if (Err != 0) {
-      LOG_ERROR("Error closing output file {}", OutFileName);
+      LOG_ERROR("Error closing output file {}", FileName);
       return Err;
    }
 
+   // List the subfiles once all have been written
+   if (UseSubfiles) {
+      Err = writeSubfileList(OutFileName);
+      if (Err != 0) {
+         LOG_ERROR("Error writing subfile index file for {}", OutFileName);
+         return Err;
+      }
+   }
+
    // If using pointer files for this stream, write the filename to the pointer
    // after the file is successfully written
    if (UsePointer) {
@@ -2551,7 +2137,6 @@ int IOStream::writeStream(
 
    LOG_INFO("Successfully wrote stream {} to file {}", Name, OutFileName);
 
-   // End of routine - return
    return Err;
 
 } // end writeStream
@@ -2560,12 +2145,165 @@ int IOStream::writeStream(
 // Removes a single IOStream from the list of all streams.
 void IOStream::erase(const std::string &StreamName // Name of IOStream to remove
 ) {
+   // An outstanding write may still be using the stream
+   int Err = waitForPendingWrite();
+   if (Err != 0)
+      LOG_ERROR("Error completing asynchronous write while erasing stream {}",
+                StreamName);
+   auto StreamItr = AllStreams.find(StreamName);
+   if (StreamItr != AllStreams.end())
+      WriteAlarms.erase(&(StreamItr->second->MyAlarm));
    AllStreams.erase(StreamName); // use the map erase function to remove
 } // End erase
 
+//------------------------------------------------------------------------------
+// Waits for any outstanding asynchronous write and returns its error code
+int IOStream::waitForPendingWrite() {
+
+   int Err = 0;
+
+   if (PendingWrite.valid())
+      Err = PendingWrite.get();
+
+   return Err;
+
+} // End waitForPendingWrite
+
+//------------------------------------------------------------------------------
+// Destroys all cached parallel I/O decompositions
+int IOStream::clearDecomps() {
+
+   // An outstanding write may still be using the decompositions
+   int Err = waitForPendingWrite();
+   if (Err != 0)
+      LOG_ERROR("Error completing asynchronous write before clearing decomps");
+
+   // The subfile layouts are also computed from the dimensions
+   SubfileDims.clear();
+
+   for (auto Iter = DecompCache.begin(); Iter != DecompCache.end(); ++Iter) {
+      int DecompID = Iter->second;
+      int Err1     = IO::destroyDecomp(DecompID);
+      if (Err1 != 0) {
+         LOG_ERROR("Error destroying cached decomposition {}", DecompID);
+         ++Err;
+      }
+   }
+   DecompCache.clear();
+
+   return Err;
+
+} // End clearDecomps
+
+//------------------------------------------------------------------------------
+// Enables or disables asynchronous writes for this stream
+int IOStream::setAsyncWrite(bool InAsyncWrite // [in] new setting
+) {
+
+   int Err = 0;
+
+   if (InAsyncWrite) {
+      if (Mode != IO::ModeWrite) {
+         LOG_ERROR("Asynchronous writes requested for input stream {}", Name);
+         Err = 1;
+         return Err;
+      }
+
+      // The background thread calls MPI through the IO library while the
+      // model continues to communicate on the main thread
+      int ThreadLevel;
+      MPI_Query_thread(&ThreadLevel);
+      if (ThreadLevel < MPI_THREAD_MULTIPLE) {
+         LOG_ERROR("Asynchronous writes for stream {} require MPI to be "
+                   "initialized with MPI_THREAD_MULTIPLE",
+                   Name);
+         Err = 2;
+         return Err;
+      }
+   } else {
+      // Complete any outstanding write that may use the staging buffers
+      Err = waitForPendingWrite();
+      if (Err != 0) {
+         LOG_ERROR("Error completing asynchronous write for stream {}", Name);
+         return Err;
+      }
+      StagingBuffers[0].clear();
+      StagingBuffers[1].clear();
+   }
+
+   AsyncWrite = InAsyncWrite;
+
+   return Err;
+
+} // End setAsyncWrite
+
+//------------------------------------------------------------------------------
+// Returns true if the stream is written asynchronously
+bool IOStream::isAsyncWrite() const { return AsyncWrite; }
+
+//------------------------------------------------------------------------------
+// Enables or disables writing this stream as one subfile per node
+int IOStream::setSubfiling(bool InUseSubfiles // [in] new setting
+) {
+
+   int Err = 0;
+
+   if (InUseSubfiles) {
+      if (Mode != IO::ModeWrite) {
+         LOG_ERROR("Subfiles requested for input stream {}", Name);
+         Err = 1;
+         return Err;
+      }
+      Err = IO::initNodeIO();
+      if (Err != 0) {
+         LOG_ERROR("Error initializing node IO for stream {}", Name);
+         return Err;
+      }
+   }
+
+   // Complete any outstanding write that uses the current setting
+   Err = waitForPendingWrite();
+   if (Err != 0) {
+      LOG_ERROR("Error completing asynchronous write for stream {}", Name);
+      return Err;
+   }
+
+   UseSubfiles = InUseSubfiles;
+
+   return Err;
+
+} // End setSubfiling
+
+//------------------------------------------------------------------------------
+// Returns true if the stream is written as one subfile per node
+bool IOStream::isSubfiling() const { return UseSubfiles; }
+
+//------------------------------------------------------------------------------
+// Returns true if the stream reads or writes the restart state
+bool IOStream::isRestart() const { return RestartStream; }
+
+//------------------------------------------------------------------------------
+// Returns the IO data type used for a field of the stream contents
+IO::IODataType
+IOStream::getFieldIOType(const std::string &FieldName // [in] name of field
+) {
+   return getFieldIOType(Field::get(FieldName));
+}
+
 //------------------------------------------------------------------------------
 // Private utility functions for read/write
 //------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Determines whether the double precision data of a field is converted to
+// single precision. Fields with reduced precision are only converted on
+// output so that files written in double precision can still be read, and
+// never by restart streams so that restarts reproduce the state exactly.
+bool IOStream::reducesPrecision(const Field &ThisField // [in] field to check
+) const {
+   return ReducePrecision or (Mode == IO::ModeWrite and !RestartStream and
+                              ThisField.isReducedPrecision());
+}
+
 //------------------------------------------------------------------------------
 // Determines the IO Data type to use for a given field, taking into
 // account the field's type and any reduced precision conversion
@@ -2591,7 +2329,7 @@ IO::IODataType IOStream::getFieldIOType(
       ReturnType = IO::IOTypeR4;
       break;
    case FieldType::R8:
-      if (ReducePrecision) {
+      if (reducesPrecision(*FieldPtr)) {
          ReturnType = IO::IOTypeR4;
       } else {
          ReturnType = IO::IOTypeR8;
@@ -2768,6 +2506,274 @@ std::string IOStream::buildFilename(
 
 } // End buildFilename
 
+//------------------------------------------------------------------------------
+// Computes the layout of all distributed dimensions in node subfiles. The
+// owned entries of each task are stored after those of the lower tasks on
+// the node, in local order, so no data is reordered within a task.
+int IOStream::computeSubfileDims() {
+
+   int Err = 0;
+
+   int NodeTasks;
+   int NodeTask;
+   MPI_Comm_size(IO::NodeComm, &NodeTasks);
+   MPI_Comm_rank(IO::NodeComm, &NodeTask);
+
+   for (auto IDim = Dimension::begin(); IDim != Dimension::end(); ++IDim) {
+      std::string DimName = IDim->first;
+      if (!IDim->second->isDistributed() or
+          SubfileDims.find(DimName) != SubfileDims.end())
+         continue;
+
+      HostArray1DI4 GlobOffset = IDim->second->getOffset();
+      I4 LocLength             = IDim->second->getLengthLocal();
+      I4 NOwned                = 0;
+      for (int I = 0; I < LocLength; ++I) {
+         if (GlobOffset(I) >= 0)
+            ++NOwned;
+      }
+
+      std::vector<I4> AllOwned(NodeTasks);
+      Err = MPI_Allgather(&NOwned, 1, MPI_INT32_T, AllOwned.data(), 1,
+                          MPI_INT32_T, IO::NodeComm);
+      if (Err != MPI_SUCCESS) {
+         LOG_ERROR("Error gathering owned entries of dimension {} on node",
+                   DimName);
+         return Err;
+      }
+
+      SubfileDim NewDim;
+      NewDim.Length = 0;
+      I4 Next       = 0;
+      for (int Task = 0; Task < NodeTasks; ++Task) {
+         if (Task == NodeTask)
+            Next = NewDim.Length;
+         NewDim.Length += AllOwned[Task];
+      }
+      NewDim.Offset = HostArray1DI4("SubfileOffset" + DimName, LocLength);
+      for (int I = 0; I < LocLength; ++I)
+         NewDim.Offset(I) = GlobOffset(I) >= 0 ? Next++ : -1;
+
+      SubfileDims[DimName] = NewDim;
+   }
+
+   return Err;
+
+} // End computeSubfileDims
+
+//------------------------------------------------------------------------------
+// Builds the name of the subfile of a node, eg Output.node0003.nc for node 3
+// of Output.nc. The node index is appended to names without a .nc extension
+// since other dots are common in the time stamps of filenames.
+std::string
+IOStream::buildSubfileName(const std::string &OutFileName, // [in] file name
+                           int Node                        // [in] node index
+) {
+
+   std::string NodeStr = std::to_string(Node);
+   if (NodeStr.size() < 4)
+      NodeStr.insert(0, 4 - NodeStr.size(), '0');
+   std::string Suffix = ".node" + NodeStr;
+
+   const std::string Ext = ".nc";
+   size_t NameLength     = OutFileName.size();
+   if (NameLength > Ext.size() and
+       OutFileName.compare(NameLength - Ext.size(), Ext.size(), Ext) == 0)
+      return OutFileName.substr(0, NameLength - Ext.size()) + Suffix + Ext;
+
+   return OutFileName + Suffix;
+
+} // End buildSubfileName
+
+//------------------------------------------------------------------------------
+// Defines the global index variables of the distributed dimensions in a node
+// subfile (eg NCellsGlobalIndex) and the node and number of subfiles in the
+// global metadata
+int IOStream::defineSubfileIndex(
+    int FileID,                            // [in] id assigned to the file
+    std::map<std::string, int> &AllDimIDs, // [in] dimension IDs
+    std::map<std::string, int> &IndexIDs   // [out] index variable IDs
+) {
+
+   int Err = 0;
+
+   Err = IO::writeMeta("SubfileNode", IO::NodeID, FileID, IO::GlobalID);
+   if (Err != 0)
+      return Err;
+   Err = IO::writeMeta("NumSubfiles", IO::NumNodes, FileID, IO::GlobalID);
+   if (Err != 0)
+      return Err;
+
+   for (auto SubIter = SubfileDims.begin(); SubIter != SubfileDims.end();
+        ++SubIter) {
+      std::string DimName = SubIter->first;
+      auto DimIter        = AllDimIDs.find(DimName);
+      if (DimIter == AllDimIDs.end())
+         continue;
+
+      int DimID = DimIter->second;
+      int VarID;
+      Err = IO::defineVar(FileID, DimName + "GlobalIndex", IO::IOTypeI4, 1,
+                          &DimID, VarID);
+      if (Err != 0) {
+         LOG_ERROR("Error defining global index of dimension {}", DimName);
+         return Err;
+      }
+      Err = IO::writeMeta("long_name",
+                          "0-based global index of each " + DimName +
+                              " entry in this subfile",
+                          FileID, VarID);
+      if (Err != 0)
+         return Err;
+      IndexIDs[DimName] = VarID;
+   }
+
+   return Err;
+
+} // End defineSubfileIndex
+
+//------------------------------------------------------------------------------
+// Writes the global index variables of a node subfile. The global index of
+// each local entry is the offset of the dimension, written with the subfile
+// decomposition of the dimension.
+int IOStream::writeSubfileIndex(
+    int FileID,                          // [in] id assigned to the file
+    std::map<std::string, int> &IndexIDs // [in] index variable IDs
+) {
+
+   int Err      = 0;
+   I4 FillValue = -1;
+
+   for (auto IndexIter = IndexIDs.begin(); IndexIter != IndexIDs.end();
+        ++IndexIter) {
+      std::string DimName                = IndexIter->first;
+      std::shared_ptr<Dimension> ThisDim = Dimension::get(DimName);
+      const SubfileDim &SubDim           = SubfileDims.at(DimName);
+      I4 LocLength                       = ThisDim->getLengthLocal();
+
+      // Use the same cached decomposition as I4 fields on this dimension
+      std::vector<std::string> DimNames{DimName};
+      std::vector<I4> SubLengths{SubDim.Length};
+      std::vector<I4> LocLengths{LocLength};
+      DecompKey Key{true, IO::IOTypeI4, DimNames, SubLengths, LocLengths};
+      int DecompID;
+      auto CacheIter = DecompCache.find(Key);
+      if (CacheIter != DecompCache.end()) {
+         DecompID = CacheIter->second;
+      } else {
+         std::vector<I4> Offset(SubDim.Offset.data(),
+                                SubDim.Offset.data() + LocLength);
+         Err = IO::createDecomp(DecompID, IO::IOTypeI4, 1, SubLengths,
+                                LocLength, Offset, IO::DefaultRearr, true);
+         if (Err != 0) {
+            LOG_ERROR("Error creating subfile decomp for dimension {}",
+                      DimName);
+            return Err;
+         }
+         DecompCache[Key] = DecompID;
+      }
+
+      HostArray1DI4 GlobOffset = ThisDim->getOffset();
+      Err = IO::writeArray(GlobOffset.data(), LocLength, &FillValue, FileID,
+                           DecompID, IndexIter->second);
+      if (Err != 0) {
+         LOG_ERROR("Error writing global index of dimension {}", DimName);
+         return Err;
+      }
+   }
+
+   return Err;
+
+} // End writeSubfileIndex
+
+//------------------------------------------------------------------------------
+// Writes the index file of a stream written to node subfiles. The index file
+// is a YAML file named after the stream file with a .subfiles extension and
+// lists the subfiles and the global length of each distributed dimension so
+// that tools can merge the subfiles into a single file.
+int IOStream::writeSubfileList(const std::string &OutFileName // [in] name
+) {
+
+   int Err = 0;
+
+   if (!MachEnv::getDefault()->isMasterTask())
+      return Err;
+
+   std::string IndexName = OutFileName + ".subfiles";
+   std::ofstream IndexFile(IndexName, std::ios::trunc);
+   if (!IndexFile.is_open()) {
+      LOG_ERROR("Unable to open subfile index file {}", IndexName);
+      Err = 1;
+      return Err;
+   }
+
+   IndexFile << "Subfiles:" << std::endl;
+   IndexFile << "   NumSubfiles: " << IO::NumNodes << std::endl;
+   IndexFile << "   Files:" << std::endl;
+   for (int Node = 0; Node < IO::NumNodes; ++Node)
+      IndexFile << "      - " << buildSubfileName(OutFileName, Node)
+                << std::endl;
+   IndexFile << "   GlobalDims:" << std::endl;
+   for (auto SubIter = SubfileDims.begin(); SubIter != SubfileDims.end();
+        ++SubIter) {
+      IndexFile << "      " << SubIter->first << ": "
+                << Dimension::getDimLengthGlobal(SubIter->first) << std::endl;
+   }
+   IndexFile.close();
+
+   return Err;
+
+} // End writeSubfileList
+
+//------------------------------------------------------------------------------
+// Defines the chunking and compression of a variable in an output file. For
+// chunking, decomposed dimensions are split evenly across all tasks so that
+// each chunk roughly matches the owned portion of a task (eg NCellsOwned x
+// NVertLevels), while other dimensions are stored whole.
+int IOStream::defineVarStorage(
+    int FileID,                              // [in] id assigned to open file
+    int FieldID,                             // [in] id assigned to the field
+    std::shared_ptr<Field> FieldPtr,         // [in] field being defined
+    const std::vector<std::string> &DimNames // [in] field dim names
+) {
+
+   int Err = 0;
+
+   if (UseChunking) {
+      int NumTasks = MachEnv::getDefault()->getNumTasks();
+      if (UseSubfiles)
+         MPI_Comm_size(IO::NodeComm, &NumTasks);
+      std::vector<int> ChunkSizes(DimNames.size());
+      for (int IDim = 0; IDim < DimNames.size(); ++IDim) {
+         I4 Length = Dimension::getDimLengthGlobal(DimNames[IDim]);
+         if (Dimension::isDistributedDim(DimNames[IDim]))
+            Length = (Length + NumTasks - 1) / NumTasks;
+         ChunkSizes[IDim] = std::max(Length, 1);
+      }
+      Err = IO::defineVarChunking(FileID, FieldID, ChunkSizes);
+      if (Err != 0)
+         return Err;
+   }
+
+   if (DeflateLevel > 0) {
+      Err = IO::defineVarDeflate(FileID, FieldID, DeflateLevel, UseShuffle);
+      if (Err != 0)
+         return Err;
+   }
+
+   // Record the quantization of floating point fields in the metadata
+   auto DigitsIter  = SignificantDigits.find(FieldPtr->getName());
+   FieldType MyType = FieldPtr->getType();
+   if (DigitsIter != SignificantDigits.end() and
+       (MyType == FieldType::R4 or MyType == FieldType::R8)) {
+      Err = IO::writeMeta("QuantizeSignificantDigits", DigitsIter->second,
+                          FileID, FieldID);
+   }
+
+   return Err;
+
+} // End defineVarStorage
+
 //------------------------------------------------------------------------------
 // Sets ReducePrecision flag based on an input string, performing string
 // manipulation for case insensitive comparison
@@ -20,10 +20,14 @@
 #include "IO.h"
 #include "Logging.h"
 #include "TimeMgr.h" // need Alarms, TimeInstant
+#include <future>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace OMEGA {
 
@@ -33,11 +37,81 @@ class IOStream {
    /// Store and maintain all defined streams
    static std::map<std::string, std::shared_ptr<IOStream>> AllStreams;
 
+   /// Outstanding asynchronous write or read, if any. Only one write or read
+   /// is in flight at a time across all streams so that the collective PIO
+   /// calls are issued in the same order on every task.
+   static std::future<int> PendingWrite;
+
+   /// Alarms of all write streams, used by writeAll to check the ringing
+   /// alarms of the clock rather than every stream
+   static std::set<const Alarm *> WriteAlarms;
+
+   /// True if a write stream has a startup write that has not been done
+   static bool StartupWritePending;
+
+   /// Parallel I/O decompositions are cached across reads and writes of all
+   /// streams since creating a decomposition requires collective
+   /// communication. A decomposition is identified by whether it is for a
+   /// node subfile, the IO data type, the dimension names (which define the
+   /// offsets) and the global (or subfile) and local dimension lengths.
+   using DecompKey = std::tuple<bool, IO::IODataType, std::vector<std::string>,
+                                std::vector<I4>, std::vector<I4>>;
+   static std::map<DecompKey, int> DecompCache; ///< decomp IDs by key
+
+   /// Layout of a distributed dimension in node subfiles. The owned entries
+   /// of the tasks on a node are stored in task order, so each subfile only
+   /// holds the entries of its node. Computed on the first subfile write.
+   struct SubfileDim {
+      I4 Length;            ///< length of the dimension in this node subfile
+      HostArray1DI4 Offset; ///< subfile index of each local entry, -1 if
+                            ///< not owned
+   };
+   static std::map<std::string, SubfileDim> SubfileDims; ///< by dim name
+
+   /// Contiguous host copy of a field data array, staged for writing. The
+   /// vector matching the field type (and precision) holds the data, and
+   /// DataPtr and FillValPtr point to the data and fill value to write.
+   struct StagedField {
+      std::vector<I4> DataI4;
+      std::vector<I8> DataI8;
+      std::vector<R4> DataR4;
+      std::vector<R8> DataR8;
+      I4 FillValI4     = 0;
+      I8 FillValI8     = 0;
+      R4 FillValR4     = 0;
+      R8 FillValR8     = 0;
+      void *DataPtr    = nullptr;
+      void *FillValPtr = nullptr;
+
+      /// Staging vector and fill value for data type T
+      template <class T> std::vector<T> &data() {
+         if constexpr (std::is_same_v<T, I4>)
+            return DataI4;
+         else if constexpr (std::is_same_v<T, I8>)
+            return DataI8;
+         else if constexpr (std::is_same_v<T, R4>)
+            return DataR4;
+         else
+            return DataR8;
+      }
+      template <class T> T &fillValue() {
+         if constexpr (std::is_same_v<T, I4>)
+            return FillValI4;
+         else if constexpr (std::is_same_v<T, I8>)
+            return FillValI8;
+         else if constexpr (std::is_same_v<T, R4>)
+            return FillValR4;
+         else
+            return FillValR8;
+      }
+   };
+
    /// Private variables specific to a stream
    std::string Name;         ///< name of stream
    std::string Filename;     ///< filename or filename template (with path)
    bool FilenameIsTemplate;  ///< true if the filename is a template
    IO::IfExists ExistAction; ///< action if file exists (write only)
+   IO::FileFmt FileFormat;   ///< file format (and IO library backend)
 
    IO::Mode Mode;        ///< mode (read or write)
    bool ReducePrecision; ///< flag to use 32-bit precision for 64-bit floats
@@ -52,6 +126,11 @@ class IOStream {
    bool UsePointer;         ///< flag for using a pointer file
    std::string PtrFilename; ///< name of pointer file
 
+   /// Restart streams, which use a pointer file or contain the Restart
+   /// group, always write fields with reduced output precision in the
+   /// precision of the stream so that restarts are exact
+   bool RestartStream; ///< flag for a stream of the restart state
+
    /// Use a start and end time to define an interval in which stream is active
    /// The start is inclusive but the end time is not.
    bool UseStartEnd; ///< flag for using start, end times
@@ -64,6 +143,55 @@ class IOStream {
    /// Flag to determine whether the Contents have been validated or not
    bool Validated;
 
+   /// Handles of the fields in Contents, in the same order, set when the
+   /// contents are validated so reads and writes do not look up fields by
+   /// name
+   std::vector<FieldHandle> ContentHandles;
+
+   /// Storage options for NetCDF4/HDF5 output files. Variables can be
+   /// chunked with decomposed dimensions split evenly across tasks (eg
+   /// NCellsOwned x NVertLevels chunks) and compressed with deflate. Floating
+   /// point fields can also be quantized to a number of significant decimal
+   /// digits, discarding the remaining mantissa bits so the data compresses
+   /// much better.
+   bool UseChunking; ///< flag to chunk variables by task decomposition
+   int DeflateLevel; ///< deflate compression level, 0 for no compression
+   bool UseShuffle;  ///< flag to apply the shuffle filter with deflate
+
+   /// Output streams can be written as one subfile per node rather than a
+   /// single file, with the data of each node gathered to one writer on the
+   /// node. Each subfile contains the global index of its entries for every
+   /// distributed dimension and an index file lists the subfiles.
+   bool UseSubfiles; ///< flag to write one subfile per node
+
+   /// Number of significant digits to retain for quantized fields, indexed
+   /// by field (or group) name
+   std::map<std::string, int> SignificantDigits;
+
+   /// Asynchronous writes snapshot all field data into host staging buffers
+   /// and then write the file on a background thread while the model
+   /// continues. Two sets of buffers are kept so that the next snapshot can
+   /// be taken while the previous one is still being written.
+   bool AsyncWrite;  ///< flag to write the stream asynchronously
+   int ActiveBuffer; ///< index of the staging buffers for the next write
+
+   /// Staging buffers for asynchronous writes, indexed by field name
+   std::map<std::string, StagedField> StagingBuffers[2];
+
+   /// Reusable host staging pool for reads and writes. StagingPool provides
+   /// the host storage (pinned on GPUs) for copies of device arrays and
+   /// SyncStaging the contiguous storage passed to the IO library for
+   /// synchronous writes and reads. Both are sized in validate from the
+   /// largest field in the stream and only grow if a larger field is used.
+   Kokkos::View<R8 *, HostStagingSpace> StagingPool;
+   StagedField SyncStaging;
+
+   /// Unmanaged host array in the staging pool matching a device array type
+   template <class ArrayType>
+   using StagingArray =
+       Kokkos::View<typename ArrayType::non_const_data_type, MemLayout,
+                    HostStagingSpace, Kokkos::MemoryUnmanaged>;
+
    //---- Private utility functions to support public interfaces
    /// Creates a new stream and adds to the list of all streams, based on
    /// options in the input model configuration. This routine is called by
@@ -81,8 +209,9 @@ class IOStream {
        std::map<std::string, int> &AllDimIDs ///< [out] dim name, assigned ID
    );
 
-   /// Computes the parallel decomposition (offsets) for a field.
-   /// Needed for parallel I/O
+   /// Computes the parallel decomposition (offsets) for a field or retrieves
+   /// it from the cache if it was previously computed. Needed for parallel
+   /// I/O
    int computeDecomp(
        std::shared_ptr<Field> FieldPtr,       ///< [in] field
        std::map<std::string, int> &AllDimIDs, ///< [in] dimension IDs
@@ -99,6 +228,48 @@ class IOStream {
        bool ForceRead = false ///< [in] Optional: read even if not time
    );
 
+   /// Returns the name of the file to read, from the pointer file, the
+   /// filename template or the filename of the stream
+   std::string
+   getReadFilename(const Clock &ModelClock ///< [in] Model clock for sim time
+   );
+
+   /// Opens and reads the input file for the stream, including any requested
+   /// global metadata
+   int readFile(const std::string &InFileName, ///< [in] name of file
+                Metadata &ReqMetadata ///< [inout] global metadata to extract
+   );
+
+   /// Computes the layout of all distributed dimensions in node subfiles if
+   /// not already computed. Must be called by all tasks.
+   static int computeSubfileDims();
+
+   /// Builds the name of the subfile of a node by inserting the node index
+   /// before the .nc extension of the filename, or appending it
+   static std::string
+   buildSubfileName(const std::string &OutFileName, ///< [in] stream file name
+                    int Node                        ///< [in] node index
+   );
+
+   /// Defines the global index variables of the distributed dimensions in a
+   /// node subfile, returning their IDs by dimension name
+   int defineSubfileIndex(
+       int FileID,                            ///< [in] id assigned to the file
+       std::map<std::string, int> &AllDimIDs, ///< [in] dimension IDs
+       std::map<std::string, int> &IndexIDs   ///< [out] index variable IDs
+   );
+
+   /// Writes the global index variables of a node subfile
+   int writeSubfileIndex(
+       int FileID,                          ///< [in] id assigned to the file
+       std::map<std::string, int> &IndexIDs ///< [in] index variable IDs
+   );
+
+   /// Writes the index file listing the subfiles and the global lengths of
+   /// the distributed dimensions from the master task
+   int writeSubfileList(const std::string &OutFileName ///< [in] file name
+   );
+
    /// Private function that performs most of the stream write - called by the
    /// public write method
    int writeStream(
@@ -113,6 +284,40 @@ class IOStream {
                       int FieldID            ///< [in] id assigned to the field
    );
 
+   /// Opens, defines and writes the output file for the stream using the
+   /// current field metadata. Field data is taken from the input staging
+   /// buffers if present, otherwise each field is staged as it is written.
+   int writeFile(const std::string &OutFileName, ///< [in] name of file
+                 std::map<std::string, StagedField> *Staged ///< [in] buffers
+   );
+
+   /// Allocates the staging pool and reserves the contiguous staging storage
+   /// for the largest field of each type in the stream contents
+   void sizeStagingPool();
+
+   /// Copies a device array to the host using the staging pool for storage.
+   /// The returned array has the layout of the device array and is only
+   /// valid until the next use of the pool.
+   template <class ArrayType>
+   StagingArray<ArrayType>
+   stageHostCopy(const ArrayType &DevArray ///< [in] device array to copy
+   );
+
+   /// Copies a field's data array into contiguous host storage, performing
+   /// any manipulations to reduce precision or move data from the device
+   int stageFieldData(std::shared_ptr<Field> FieldPtr, ///< [in] field to stage
+                      StagedField &Staged ///< [out] staged host copy of data
+   );
+
+   /// Writes a previously staged field data array to an open file
+   int writeStagedData(
+       std::shared_ptr<Field> FieldPtr,      ///< [in] field to write
+       const StagedField &Staged,            ///< [in] staged copy of data
+       int FileID,                           ///< [in] id assigned to open file
+       int FieldID,                          ///< [in] id assigned to the field
+       std::map<std::string, int> &AllDimIDs ///< [in] dimension IDs
+   );
+
    /// Write a field's data array, performing any manipulations to reduce
    /// precision or move data between host and device
    int
@@ -131,6 +336,13 @@ class IOStream {
                  int &FieldID ///< [out] id assigned to the field
    );
 
+   /// Returns true if the double precision data of a field is converted to
+   /// single precision, either for all fields of the stream or for output
+   /// of fields that request reduced precision by streams other than
+   /// restarts
+   bool reducesPrecision(const Field &ThisField ///< [in] field to check
+   ) const;
+
    /// Determines the IO Data type to use for a given field, taking into
    /// account the field's type and any reduced precision conversion
    IO::IODataType getFieldIOType(
@@ -154,6 +366,14 @@ class IOStream {
        const Clock &ModelClock              ///< [in] model clock for sim time
    );
 
+   /// Defines the chunking and compression of a variable in an output file
+   /// based on the stream storage options
+   int defineVarStorage(int FileID,  ///< [in] id assigned to open file
+                        int FieldID, ///< [in] id assigned to the field
+                        std::shared_ptr<Field> FieldPtr, ///< [in] field
+                        const std::vector<std::string> &DimNames ///< [in] dims
+   );
+
    /// Sets ReducePrecision flag based on an input string, performing string
    /// manipulation for case insensitive comparison
    void setPrecisionFlag(
@@ -227,6 +447,16 @@ class IOStream {
                    bool ForceRead = false ///< [in] opt: read even if not time
    );
 
+   //---------------------------------------------------------------------------
+   /// Starts reading a stream on a background thread, regardless of the
+   /// stream alarm, from the file for the current time of the clock. All
+   /// contents must be host fields, which must not be used until the read is
+   /// completed with waitForPendingWrite. The stream is read immediately if
+   /// MPI does not support MPI_THREAD_MULTIPLE. Returns an error code.
+   static int readAsync(const std::string &StreamName, ///< [in] Name of stream
+                        const Clock &ModelClock ///< [in] Model clock for time
+   );
+
    //---------------------------------------------------------------------------
    /// Writes a stream if it is time. Returns an error code.
    static int
@@ -238,10 +468,59 @@ class IOStream {
    //---------------------------------------------------------------------------
    /// Loops through all streams and writes them if it is time. This is
    /// useful if most I/O is consolidated at one point (eg end of step).
+   /// Returns immediately if no write stream alarm is ringing on the clock
+   /// and no startup write is pending.
    static int
    writeAll(const Clock &ModelClock ///< [in] Model clock for time stamps
    );
 
+   //---------------------------------------------------------------------------
+   /// Waits for any outstanding asynchronous stream write or read to
+   /// complete. Returns the error code of that write or read.
+   static int waitForPendingWrite();
+
+   //---------------------------------------------------------------------------
+   /// Destroys all cached parallel I/O decompositions. This must be called
+   /// if the mesh decomposition or any dimension changes so that new
+   /// decompositions are created for later reads and writes. Returns an
+   /// error code.
+   static int clearDecomps();
+
+   //---------------------------------------------------------------------------
+   /// Enables or disables asynchronous writes for this stream. Asynchronous
+   /// writes require MPI to be initialized with MPI_THREAD_MULTIPLE support
+   /// and an error is returned if enabling them for a stream that is not an
+   /// output stream or if that support is not available.
+   int setAsyncWrite(bool InAsyncWrite ///< [in] new setting
+   );
+
+   //---------------------------------------------------------------------------
+   /// Returns true if the stream is written asynchronously
+   bool isAsyncWrite() const;
+
+   //---------------------------------------------------------------------------
+   /// Enables or disables writing this stream as one subfile per node. Must
+   /// be called by all tasks since enabling subfiles initializes the node IO
+   /// system. Returns an error if enabling them for an input stream.
+   int setSubfiling(bool InUseSubfiles ///< [in] new setting
+   );
+
+   //---------------------------------------------------------------------------
+   /// Returns true if the stream is written as one subfile per node
+   bool isSubfiling() const;
+
+   //---------------------------------------------------------------------------
+   /// Returns true if the stream reads or writes the restart state
+   bool isRestart() const;
+
+   //---------------------------------------------------------------------------
+   /// Returns the IO data type used for a field of the stream contents,
+   /// taking into account any reduced precision conversion. The stream
+   /// must have been validated.
+   IO::IODataType
+   getFieldIOType(const std::string &FieldName ///< [in] name of field
+   );
+
    //---------------------------------------------------------------------------
    /// Removes a single IOStream from the list of all streams.
    /// That process also decrements the reference counters for the
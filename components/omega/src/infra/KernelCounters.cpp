@@ -0,0 +1,385 @@
+//===-- infra/KernelCounters.cpp - Omega kernel counters --------*- C++ -*-===//
+//
+// Implementation of the roofline counters of labeled Omega kernels. The Kokkos
+// Tools begin and end parallel_for callbacks fence the device around the
+// launches of annotated kernels and accumulate their time, bytes and flops.
+// The end callback is called when the launch returns on the host, so the
+// fence in it waits for the kernel to complete. Callbacks that were registered
+// before, eg by a Kokkos Tools library loaded through KOKKOS_TOOLS_LIBS, are
+// still called.
+//
+//===----------------------------------------------------------------------===//
+
+#include "KernelCounters.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+// Create static class members
+bool KernelCounters::Enabled       = false;
+bool KernelCounters::Registered    = false;
+bool KernelCounters::PrintEachStep = false;
+R8 KernelCounters::PeakBandwidth   = 0;
+R8 KernelCounters::PeakFlops       = 0;
+I8 KernelCounters::NSteps          = 0;
+std::map<std::string, KernelCounters::KernelData> KernelCounters::AllKernels;
+std::vector<std::string> KernelCounters::KernelOrder;
+std::vector<KernelCounters::KernelData *> KernelCounters::RunningKernels;
+
+//------------------------------------------------------------------------------
+// Kokkos Tools callbacks, which forward to the callbacks registered before
+
+static Kokkos_Profiling_beginFunction PrevBeginFor = nullptr;
+static Kokkos_Profiling_endFunction PrevEndFor     = nullptr;
+
+static void beginForCallback(const char *Label, const uint32_t DevID,
+                             uint64_t *KernelID) {
+   if (PrevBeginFor != nullptr)
+      PrevBeginFor(Label, DevID, KernelID);
+   KernelCounters::beginKernel(Label);
+}
+
+static void endForCallback(const uint64_t KernelID) {
+   KernelCounters::endKernel();
+   if (PrevEndFor != nullptr)
+      PrevEndFor(KernelID);
+}
+
+static void registerCallbacks() {
+   auto Callbacks = Kokkos::Tools::Experimental::get_callbacks();
+   PrevBeginFor   = Callbacks.begin_parallel_for;
+   PrevEndFor     = Callbacks.end_parallel_for;
+   Kokkos::Tools::Experimental::set_begin_parallel_for_callback(
+       beginForCallback);
+   Kokkos::Tools::Experimental::set_end_parallel_for_callback(endForCallback);
+}
+
+static void unregisterCallbacks() {
+   Kokkos::Tools::Experimental::set_begin_parallel_for_callback(PrevBeginFor);
+   Kokkos::Tools::Experimental::set_end_parallel_for_callback(PrevEndFor);
+   PrevBeginFor = nullptr;
+   PrevEndFor   = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// Initialize the counters from the optional KernelCounters config group
+
+int KernelCounters::init() {
+
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("KernelCounters")) {
+      Config CountersConfig("KernelCounters");
+      Err = OmegaConfig->get(CountersConfig);
+      if (Err != 0) {
+         LOG_ERROR("KernelCounters: error reading KernelCounters group from "
+                   "Config");
+         return Err;
+      }
+      if (CountersConfig.existsVar("Enabled")) {
+         Err = CountersConfig.get("Enabled", Enabled);
+         if (Err != 0) {
+            LOG_ERROR("KernelCounters: error reading Enabled from "
+                      "KernelCounters Config");
+            return Err;
+         }
+      }
+      if (CountersConfig.existsVar("PrintEachStep")) {
+         Err = CountersConfig.get("PrintEachStep", PrintEachStep);
+         if (Err != 0) {
+            LOG_ERROR("KernelCounters: error reading PrintEachStep from "
+                      "KernelCounters Config");
+            return Err;
+         }
+      }
+      if (CountersConfig.existsVar("PeakBandwidth")) {
+         Err = CountersConfig.get("PeakBandwidth", PeakBandwidth);
+         if (Err != 0) {
+            LOG_ERROR("KernelCounters: error reading PeakBandwidth from "
+                      "KernelCounters Config");
+            return Err;
+         }
+      }
+      if (CountersConfig.existsVar("PeakFlops")) {
+         Err = CountersConfig.get("PeakFlops", PeakFlops);
+         if (Err != 0) {
+            LOG_ERROR("KernelCounters: error reading PeakFlops from "
+                      "KernelCounters Config");
+            return Err;
+         }
+      }
+   }
+
+   setEnabled(Enabled);
+
+   return Err;
+
+} // end KernelCounters init
+
+//------------------------------------------------------------------------------
+// Annotate a kernel with its estimated cost per iteration
+
+void KernelCounters::annotate(const std::string &Label, // [in] kernel label
+                              R8 BytesPerIter,          // [in] bytes per iter
+                              R8 FlopsPerIter           // [in] flops per iter
+) {
+
+   if (not Enabled)
+      return;
+
+   auto [Iter, New] = AllKernels.try_emplace(Label);
+   if (New)
+      KernelOrder.push_back(Label);
+   Iter->second.BytesPerIter = BytesPerIter;
+   Iter->second.FlopsPerIter = FlopsPerIter;
+
+} // end KernelCounters annotate
+
+//------------------------------------------------------------------------------
+// Record the iterations of the next launch of an annotated kernel
+
+void KernelCounters::setIterations(const std::string &Label, // [in] label
+                                   I8 NIters // [in] number of iterations
+) {
+
+   auto Iter = AllKernels.find(Label);
+   if (Iter != AllKernels.end())
+      Iter->second.Iters = NIters;
+
+} // end KernelCounters setIterations
+
+//------------------------------------------------------------------------------
+// Start and stop timing a launch. Kernels that are not annotated are pushed
+// as null entries so that the launches stay matched.
+
+void KernelCounters::beginKernel(const char *Label // [in] kernel label
+) {
+
+   auto Iter = AllKernels.find(Label);
+   if (Iter == AllKernels.end()) {
+      RunningKernels.push_back(nullptr);
+      return;
+   }
+
+   Kokkos::fence();
+   Iter->second.StartTime = MPI_Wtime();
+   RunningKernels.push_back(&Iter->second);
+
+} // end KernelCounters beginKernel
+
+void KernelCounters::endKernel() {
+
+   if (RunningKernels.empty())
+      return;
+
+   KernelData *Data = RunningKernels.back();
+   RunningKernels.pop_back();
+   if (Data == nullptr)
+      return;
+
+   Kokkos::fence();
+   Data->StepTime += MPI_Wtime() - Data->StartTime;
+   Data->StepBytes += Data->Iters * Data->BytesPerIter;
+   Data->StepFlops += Data->Iters * Data->FlopsPerIter;
+   ++Data->StepCount;
+
+} // end KernelCounters endKernel
+
+//------------------------------------------------------------------------------
+// Complete a time step, folding the counts of the step into the totals
+
+void KernelCounters::endStep() {
+
+   if (not Enabled)
+      return;
+
+   ++NSteps;
+   if (PrintEachStep)
+      printTable(true);
+
+   for (auto &[Label, Data] : AllKernels) {
+      Data.TotalTime += Data.StepTime;
+      Data.TotalBytes += Data.StepBytes;
+      Data.TotalFlops += Data.StepFlops;
+      Data.TotalCount += Data.StepCount;
+      Data.StepTime  = 0;
+      Data.StepBytes = 0;
+      Data.StepFlops = 0;
+      Data.StepCount = 0;
+   }
+
+} // end KernelCounters endStep
+
+//------------------------------------------------------------------------------
+// Retrieve the local counts of a kernel
+
+R8 KernelCounters::getTime(const std::string &Label // [in] kernel label
+) {
+   auto Iter = AllKernels.find(Label);
+   return Iter != AllKernels.end()
+              ? Iter->second.TotalTime + Iter->second.StepTime
+              : 0;
+}
+
+R8 KernelCounters::getBytes(const std::string &Label // [in] kernel label
+) {
+   auto Iter = AllKernels.find(Label);
+   return Iter != AllKernels.end()
+              ? Iter->second.TotalBytes + Iter->second.StepBytes
+              : 0;
+}
+
+R8 KernelCounters::getFlops(const std::string &Label // [in] kernel label
+) {
+   auto Iter = AllKernels.find(Label);
+   return Iter != AllKernels.end()
+              ? Iter->second.TotalFlops + Iter->second.StepFlops
+              : 0;
+}
+
+I8 KernelCounters::getCount(const std::string &Label // [in] kernel label
+) {
+   auto Iter = AllKernels.find(Label);
+   return Iter != AllKernels.end()
+              ? Iter->second.TotalCount + Iter->second.StepCount
+              : 0;
+}
+
+R8 KernelCounters::getTotalTime() {
+   R8 Time = 0;
+   for (const auto &[Label, Data] : AllKernels) {
+      Time += Data.TotalTime + Data.StepTime;
+   }
+   return Time;
+}
+
+//------------------------------------------------------------------------------
+// Write a table of the counters to the log. A kernel is reported as memory
+// bound if its arithmetic intensity is below the ridge point of the roofline,
+// the ratio of the peak flop rate to the peak bandwidth.
+
+void KernelCounters::printTable(bool CurrentStep // [in] step or run summary
+) {
+
+   if (not MachEnv::getDefault()->isMasterTask())
+      return;
+
+   const R8 Giga    = 1.0e9;
+   const R8 PerStep = CurrentStep or NSteps == 0 ? 1.0 : 1.0 / NSteps;
+   const bool HasPeaks = PeakBandwidth > 0 and PeakFlops > 0;
+
+   if (CurrentStep) {
+      LOG_INFO("KernelCounters: step {} (master task)", NSteps);
+   } else {
+      LOG_INFO("KernelCounters: mean per step over {} steps (master task)",
+               NSteps);
+   }
+   LOG_INFO("{:<28} {:>8} {:>12} {:>10} {:>10} {:>8} {:>7} {:>7} {:>8}",
+            "Kernel", "Calls", "Time[ms]", "GB/s", "GFLOP/s", "Flop/B",
+            "%PeakBW", "%PeakFl", "Bound");
+
+   for (const auto &Label : KernelOrder) {
+      const KernelData &Data = AllKernels[Label];
+
+      const R8 Time  = CurrentStep ? Data.StepTime : Data.TotalTime;
+      const R8 Bytes = CurrentStep ? Data.StepBytes : Data.TotalBytes;
+      const R8 Flops = CurrentStep ? Data.StepFlops : Data.TotalFlops;
+      const I8 Count = CurrentStep ? Data.StepCount : Data.TotalCount;
+      if (Count == 0)
+         continue;
+
+      const R8 Bandwidth = Time > 0 ? Bytes / Time / Giga : 0;
+      const R8 FlopRate  = Time > 0 ? Flops / Time / Giga : 0;
+      const R8 Intensity = Bytes > 0 ? Flops / Bytes : 0;
+
+      std::string Bound = "-";
+      R8 FracBW         = 0;
+      R8 FracFlops      = 0;
+      if (HasPeaks) {
+         FracBW    = 100.0 * Bandwidth / PeakBandwidth;
+         FracFlops = 100.0 * FlopRate / PeakFlops;
+         Bound = Intensity < PeakFlops / PeakBandwidth ? "memory" : "compute";
+      }
+
+      LOG_INFO("{:<28} {:>8} {:>12.4f} {:>10.2f} {:>10.2f} {:>8.3f} "
+               "{:>7.1f} {:>7.1f} {:>8}",
+               Label, static_cast<I8>(Count * PerStep + 0.5),
+               1000.0 * Time * PerStep, Bandwidth, FlopRate, Intensity, FracBW,
+               FracFlops, Bound);
+   }
+
+} // end KernelCounters printTable
+
+//------------------------------------------------------------------------------
+// Write the summary of the completed steps
+
+int KernelCounters::print() {
+
+   if (not Enabled)
+      return 0;
+
+   printTable(false);
+
+   return 0;
+
+} // end KernelCounters print
+
+//------------------------------------------------------------------------------
+// Write the summary, unregister the callbacks and remove all data
+
+int KernelCounters::finalize() {
+
+   int Err = print();
+
+   if (Registered) {
+      unregisterCallbacks();
+      Registered = false;
+   }
+   clear();
+
+   return Err;
+
+} // end KernelCounters finalize
+
+void KernelCounters::clear() {
+   AllKernels.clear();
+   KernelOrder.clear();
+   RunningKernels.clear();
+   NSteps = 0;
+}
+
+//------------------------------------------------------------------------------
+// Set the counter options
+
+void KernelCounters::setEnabled(bool InEnabled // [in] new setting
+) {
+   Enabled = InEnabled;
+   if (Enabled and not Registered) {
+      registerCallbacks();
+      Registered = true;
+   } else if (not Enabled and Registered) {
+      unregisterCallbacks();
+      Registered = false;
+   }
+}
+
+void KernelCounters::setPeaks(R8 InPeakBandwidth, // [in] peak bandwidth
+                              R8 InPeakFlops      // [in] peak flop rate
+) {
+   PeakBandwidth = InPeakBandwidth;
+   PeakFlops     = InPeakFlops;
+}
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
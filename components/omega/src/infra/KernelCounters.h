@@ -0,0 +1,160 @@
+#ifndef OMEGA_KERNELCOUNTERS_H
+#define OMEGA_KERNELCOUNTERS_H
+//===-- infra/KernelCounters.h - Omega kernel counters ----------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines roofline counters for labeled Omega kernels
+///
+/// The KernelCounters class measures the achieved memory bandwidth and
+/// floating point rate of labeled kernels, to tell whether a kernel is bound
+/// by memory or by computation. A kernel is counted once it is annotated with
+/// an estimate of the bytes moved and the floating point operations done per
+/// iteration of its loop. The Kokkos Tools parallel_for callbacks fence the
+/// device around every annotated kernel and accumulate its time, and the
+/// labeled parallelFor functions of OmegaKokkos.h record the number of
+/// iterations of each launch. At the end of every time step, and at the end
+/// of the run, the achieved GB/s and GFLOP/s of every kernel are written to
+/// the log, along with their fraction of the configured machine peaks. The
+/// counters are off by default since the fences serialize the kernels.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// The KernelCounters class is a static class that accumulates the time,
+/// bytes and flops of annotated kernels
+class KernelCounters {
+
+ private:
+   /// Annotation and accumulated counts of a kernel
+   struct KernelData {
+      R8 BytesPerIter{0}; ///< estimated bytes moved per iteration
+      R8 FlopsPerIter{0}; ///< estimated flops per iteration
+      I8 Iters{0};        ///< iterations of the next launch
+      R8 StartTime{0};    ///< time the running launch was started
+      R8 StepTime{0};     ///< time in seconds in the current step
+      R8 StepBytes{0};    ///< bytes moved in the current step
+      R8 StepFlops{0};    ///< flops in the current step
+      I8 StepCount{0};    ///< launches in the current step
+      R8 TotalTime{0};    ///< time in seconds in completed steps
+      R8 TotalBytes{0};   ///< bytes moved in completed steps
+      R8 TotalFlops{0};   ///< flops in completed steps
+      I8 TotalCount{0};   ///< launches in completed steps
+   };
+
+   /// Flag to enable or disable the counters
+   static bool Enabled;
+
+   /// True if the Kokkos Tools callbacks are registered
+   static bool Registered;
+
+   /// Flag to write the counters of every step to the log
+   static bool PrintEachStep;
+
+   /// Peak memory bandwidth in GB/s and floating point rate in GFLOP/s of
+   /// the device, zero if unknown
+   static R8 PeakBandwidth;
+   static R8 PeakFlops;
+
+   /// Number of completed steps
+   static I8 NSteps;
+
+   /// Data of the annotated kernels, indexed by label
+   static std::map<std::string, KernelData> AllKernels;
+
+   /// Labels in the order they were annotated
+   static std::vector<std::string> KernelOrder;
+
+   /// Annotated kernels that are running, innermost last
+   static std::vector<KernelData *> RunningKernels;
+
+   /// Writes a table of the counters of all kernels to the log, from the
+   /// current step or from all completed steps averaged per step
+   static void printTable(bool CurrentStep ///< [in] step or run summary
+   );
+
+ public:
+   /// Initializes the counters from the optional KernelCounters group of
+   /// the Omega Config, which can contain the Enabled and PrintEachStep flags
+   /// and the PeakBandwidth (GB/s) and PeakFlops (GFLOP/s) of the device
+   static int init();
+
+   /// Sets the estimated bytes moved and flops per loop iteration of the
+   /// kernel with the input label, which is counted from then on
+   static void annotate(const std::string &Label, ///< [in] kernel label
+                        R8 BytesPerIter,          ///< [in] bytes per iter
+                        R8 FlopsPerIter           ///< [in] flops per iter
+   );
+
+   /// Records the number of iterations of the next launch of the kernel
+   /// with the input label, called by the labeled parallelFor functions
+   static void setIterations(const std::string &Label, ///< [in] kernel label
+                             I8 NIters ///< [in] number of iterations
+   );
+
+   /// Starts timing an annotated kernel, called by the Kokkos Tools callback
+   static void beginKernel(const char *Label ///< [in] kernel label
+   );
+
+   /// Stops timing the innermost running annotated kernel, called by the
+   /// Kokkos Tools callback
+   static void endKernel();
+
+   /// Completes a time step, writing the counters of the step to the log if
+   /// PrintEachStep is set
+   static void endStep();
+
+   /// Returns the local time in seconds, bytes, flops and number of launches
+   /// of the kernel with the input label over completed and current steps,
+   /// or zero if the kernel is not annotated
+   static R8 getTime(const std::string &Label ///< [in] kernel label
+   );
+   static R8 getBytes(const std::string &Label ///< [in] kernel label
+   );
+   static R8 getFlops(const std::string &Label ///< [in] kernel label
+   );
+   static I8 getCount(const std::string &Label ///< [in] kernel label
+   );
+
+   /// Returns the local time in seconds of all annotated kernels over
+   /// completed and current steps
+   static R8 getTotalTime();
+
+   /// Writes the counters of the master task averaged over the completed
+   /// steps to the log
+   static int print();
+
+   /// Writes the summary with print, unregisters the Kokkos Tools callbacks
+   /// and removes all data
+   static int finalize();
+
+   /// Removes all counter data
+   static void clear();
+
+   /// Enables or disables the counters, registering or unregistering the
+   /// Kokkos Tools callbacks
+   static void setEnabled(bool InEnabled ///< [in] new setting
+   );
+
+   /// Sets the peak memory bandwidth in GB/s and floating point rate in
+   /// GFLOP/s that the achieved rates are compared with
+   static void setPeaks(R8 InPeakBandwidth, ///< [in] peak bandwidth
+                        R8 InPeakFlops      ///< [in] peak flop rate
+   );
+
+   /// Returns true if the counters are enabled
+   static bool isEnabled() { return Enabled; }
+
+}; // end class KernelCounters
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_KERNELCOUNTERS_H
@@ -0,0 +1,211 @@
+//===-- infra/KernelScheduler.cpp - Omega concurrent kernels ----*- C++ -*-===//
+//
+// Implementation of the scheduler of independent kernels. Tasks are run in
+// the order they were added, which is a valid order since a task can only
+// depend on tasks added before it. Only the host launches are ordered: the
+// kernels of a task are queued on its instance and the host only waits for
+// an instance before launching a task that depends on a task queued on it.
+// Tasks without dependencies are spread over the instances in turn. The
+// instances are released by a Kokkos finalize hook if finalize is not called.
+//
+//===----------------------------------------------------------------------===//
+
+#include "KernelScheduler.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
+
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace OMEGA {
+
+// Create static class members
+bool KernelScheduler::Enabled  = false;
+I4 KernelScheduler::NInstances = 2;
+std::vector<ExecSpace> KernelScheduler::Instances;
+
+//------------------------------------------------------------------------------
+// Initialize the scheduler from the optional KernelScheduler config group
+
+int KernelScheduler::init() {
+
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("KernelScheduler")) {
+      Config SchedConfig("KernelScheduler");
+      Err = OmegaConfig->get(SchedConfig);
+      if (Err != 0) {
+         LOG_ERROR("KernelScheduler: error reading KernelScheduler group from "
+                   "Config");
+         return Err;
+      }
+      if (SchedConfig.existsVar("Enabled")) {
+         Err = SchedConfig.get("Enabled", Enabled);
+         if (Err != 0) {
+            LOG_ERROR("KernelScheduler: error reading Enabled from "
+                      "KernelScheduler Config");
+            return Err;
+         }
+      }
+      if (SchedConfig.existsVar("NInstances")) {
+         I4 InNInstances = NInstances;
+         Err             = SchedConfig.get("NInstances", InNInstances);
+         if (Err != 0) {
+            LOG_ERROR("KernelScheduler: error reading NInstances from "
+                      "KernelScheduler Config");
+            return Err;
+         }
+         if (InNInstances < 1) {
+            LOG_ERROR("KernelScheduler: NInstances must be at least 1, got {}",
+                      InNInstances);
+            return 1;
+         }
+         setNumInstances(InNInstances);
+      }
+   }
+
+   if (Enabled and !isConcurrent())
+      LOG_INFO("KernelScheduler: enabled but tasks run one after the other "
+               "on the {} execution space",
+               ExecSpace::name());
+
+   return Err;
+
+} // end KernelScheduler init
+
+//------------------------------------------------------------------------------
+// Create and release the partitioned instances
+
+void KernelScheduler::createInstances() {
+
+   if (static_cast<I4>(Instances.size()) == NInstances)
+      return;
+
+   const bool First = Instances.empty();
+   Instances = Kokkos::Experimental::partition_space(
+       ExecSpace(), std::vector<int>(NInstances, 1));
+
+   // Instances must be released before Kokkos is finalized
+   if (First)
+      Kokkos::push_finalize_hook([]() { Instances.clear(); });
+
+} // end KernelScheduler createInstances
+
+int KernelScheduler::finalize() {
+   for (auto &Instance : Instances)
+      Instance.fence();
+   Instances.clear();
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Add and run the tasks
+
+KernelScheduler::TaskID
+KernelScheduler::add(const std::function<void()> &Func, // [in] task to run
+                     const std::vector<TaskID> &Deps    // [in] dependencies
+) {
+
+   const TaskID ID = Tasks.size();
+   for (TaskID Dep : Deps) {
+      if (Dep < 0 or Dep >= ID) {
+         LOG_ERROR("KernelScheduler: task {} depends on task {} that was not "
+                   "added before it, running all tasks in order",
+                   ID, Dep);
+         ValidDeps = false;
+      }
+   }
+   Tasks.push_back({Func, Deps});
+
+   return ID;
+
+} // end KernelScheduler add
+
+void KernelScheduler::run() {
+
+   if (!ValidDeps or !isConcurrent() or Tasks.size() < 2) {
+      for (const Task &T : Tasks)
+         T.Func();
+
+   } else {
+      createInstances();
+
+      // The instances do not wait for kernels launched before on the
+      // default instance
+      ExecSpace().fence();
+
+      const I4 NInst = Instances.size();
+      std::vector<I4> InstanceOf(Tasks.size(), 0);
+      std::vector<bool> Queued(NInst, false);
+      I4 NextInst = 0;
+
+      for (size_t ID = 0; ID < Tasks.size(); ++ID) {
+         const Task &T = Tasks[ID];
+
+         I4 Inst;
+         if (T.Deps.empty()) {
+            Inst     = NextInst;
+            NextInst = (NextInst + 1) % NInst;
+         } else {
+            Inst = InstanceOf[T.Deps[0]];
+         }
+
+         // Wait for the dependencies queued on other instances
+         for (TaskID Dep : T.Deps) {
+            const I4 DepInst = InstanceOf[Dep];
+            if (DepInst != Inst and Queued[DepInst]) {
+               Instances[DepInst].fence();
+               Queued[DepInst] = false;
+            }
+         }
+
+         {
+            ExecInstance Scope(Instances[Inst]);
+            T.Func();
+         }
+         InstanceOf[ID] = Inst;
+         Queued[Inst]   = true;
+      }
+
+      for (I4 Inst = 0; Inst < NInst; ++Inst) {
+         if (Queued[Inst])
+            Instances[Inst].fence();
+      }
+   }
+
+   Tasks.clear();
+   ValidDeps = true;
+
+} // end KernelScheduler run
+
+//------------------------------------------------------------------------------
+// Set and query the scheduler options
+
+void KernelScheduler::setEnabled(bool InEnabled // [in] new setting
+) {
+   Enabled = InEnabled;
+}
+
+void KernelScheduler::setNumInstances(I4 InNInstances // [in] instances
+) {
+   const I4 NewNInstances = InNInstances > 0 ? InNInstances : 1;
+   if (NewNInstances != NInstances)
+      finalize();
+   NInstances = NewNInstances;
+}
+
+bool KernelScheduler::isConcurrent() {
+   // Loops launched on host instances complete before the launch returns,
+   // so host execution spaces would only split their threads
+   constexpr bool OnDevice = !std::is_same_v<ExecSpace, HostExecSpace>;
+   return OnDevice and Enabled and NInstances > 1 and
+          !KernelGraph::isCapturing() and ExecInstance::isDefault();
+}
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
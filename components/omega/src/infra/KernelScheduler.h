@@ -0,0 +1,109 @@
+#ifndef OMEGA_KERNELSCHEDULER_H
+#define OMEGA_KERNELSCHEDULER_H
+//===-- infra/KernelScheduler.h - Omega concurrent kernels ------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines a scheduler running independent Omega kernels concurrently
+///
+/// The KernelScheduler class runs a small set of tasks, each launching one or
+/// more kernels, that only depend on the tasks listed when they are added.
+/// Independent tasks are launched on different instances of the default
+/// execution space, obtained by partitioning it with
+/// Kokkos::Experimental::partition_space, so that their kernels can run at
+/// the same time on a GPU. At the small problem sizes per GPU of strong
+/// scaling runs no single kernel fills the device, and kernels on different
+/// instances share it instead of running one after the other. A task runs on
+/// the instance of its first dependency, after waiting for the instances of
+/// its other dependencies, and all instances are waited for at the end of
+/// run, so the kernels launched after run see the results of all tasks.
+/// Without a device, or when the scheduler is disabled (the default), the
+/// tasks run one after the other in the order they were added.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "OmegaKokkos.h"
+
+#include <functional>
+#include <vector>
+
+namespace OMEGA {
+
+/// The KernelScheduler class holds a set of tasks with their dependencies and
+/// runs them, concurrently if possible. The instances of the execution space
+/// and the options are shared by all schedulers.
+class KernelScheduler {
+
+ public:
+   /// Index of a task in its scheduler
+   using TaskID = I4;
+
+ private:
+   /// Task and the tasks it depends on
+   struct Task {
+      std::function<void()> Func; ///< launches the kernels of the task
+      std::vector<TaskID> Deps;   ///< tasks that must complete first
+   };
+
+   /// Tasks in the order they were added
+   std::vector<Task> Tasks;
+
+   /// False if a task was added with an invalid dependency, in which case
+   /// the tasks are run one after the other
+   bool ValidDeps{true};
+
+   /// Flag to enable or disable concurrent execution
+   static bool Enabled;
+
+   /// Number of execution space instances to run tasks on
+   static I4 NInstances;
+
+   /// Partitioned instances of the execution space, created on first use
+   static std::vector<ExecSpace> Instances;
+
+   /// Creates the partitioned instances if needed
+   static void createInstances();
+
+ public:
+   /// Adds a task that launches its kernels after the tasks in Deps, which
+   /// must have been added before, and returns its ID. The task is only run
+   /// by run. Tasks must not access the arrays they compute on the host.
+   TaskID add(const std::function<void()> &Func, ///< [in] task to run
+              const std::vector<TaskID> &Deps = {} ///< [in] dependencies
+   );
+
+   /// Runs all tasks and waits for their kernels to complete, then removes
+   /// them so that the scheduler can be reused
+   void run();
+
+   /// Initializes the scheduler from the optional KernelScheduler group of
+   /// the Omega Config, which can contain the Enabled flag and the number of
+   /// execution space instances NInstances
+   static int init();
+
+   /// Releases the execution space instances
+   static int finalize();
+
+   /// Enables or disables concurrent execution
+   static void setEnabled(bool InEnabled ///< [in] new setting
+   );
+
+   /// Sets the number of execution space instances, releasing the current
+   /// ones if the number changes
+   static void setNumInstances(I4 InNInstances ///< [in] number of instances
+   );
+
+   /// Returns true if concurrent execution is enabled
+   static bool isEnabled() { return Enabled; }
+
+   /// Returns true if tasks can run concurrently: the scheduler is enabled
+   /// with more than one instance, the loops run on a device and no kernel
+   /// graph is being captured or other instance selected
+   static bool isConcurrent();
+
+}; // end class KernelScheduler
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_KERNELSCHEDULER_H
@@ -0,0 +1,381 @@
+//===-- infra/KernelTuner.cpp - Omega kernel policy autotuner ---*- C++ -*-===//
+//
+// Implementation of the autotuner of the policies of labeled kernels. The
+// candidates of a kernel are tried in turn, each for a number of launches,
+// and the candidate with the fastest launch is kept. The fastest rather than
+// the mean launch is used so that the first launch of a candidate, which can
+// include one-time costs, does not penalize it. The cache file has a header
+// line with the name of the execution space, followed by one line per kernel
+// with the policy, the tile length and the label.
+//
+//===----------------------------------------------------------------------===//
+
+#include "KernelTuner.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+// Create static class members
+bool KernelTuner::Enabled                = false;
+I4 KernelTuner::Trials                   = 3;
+std::vector<I4> KernelTuner::TileLengths = {16, 32, 64, 128};
+std::string KernelTuner::CacheFile       = "";
+std::map<std::string, KernelTuner::KernelData> KernelTuner::AllKernels;
+KernelTuner::KernelData *KernelTuner::Running = nullptr;
+std::string KernelTuner::RunningLabel         = "";
+R8 KernelTuner::StartTime                     = 0;
+
+//------------------------------------------------------------------------------
+// Names of the policies in the log and in the cache file
+
+static const char *policyName(KernelTuner::PolicyKind Policy) {
+   switch (Policy) {
+   case KernelTuner::PolicyKind::Flat:
+      return "Flat";
+   case KernelTuner::PolicyKind::OuterInner:
+      return "OuterInner";
+   default:
+      return "MDRange";
+   }
+}
+
+static bool policyFromName(const std::string &Name,
+                           KernelTuner::PolicyKind &Policy) {
+   if (Name == "MDRange") {
+      Policy = KernelTuner::PolicyKind::MDRange;
+   } else if (Name == "Flat") {
+      Policy = KernelTuner::PolicyKind::Flat;
+   } else if (Name == "OuterInner") {
+      Policy = KernelTuner::PolicyKind::OuterInner;
+   } else {
+      return false;
+   }
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Initialize the tuner from the optional KernelTuner config group
+
+int KernelTuner::init() {
+
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("KernelTuner")) {
+      Config TunerConfig("KernelTuner");
+      Err = OmegaConfig->get(TunerConfig);
+      if (Err != 0) {
+         LOG_ERROR("KernelTuner: error reading KernelTuner group from Config");
+         return Err;
+      }
+      if (TunerConfig.existsVar("Enabled")) {
+         Err = TunerConfig.get("Enabled", Enabled);
+         if (Err != 0) {
+            LOG_ERROR("KernelTuner: error reading Enabled from KernelTuner "
+                      "Config");
+            return Err;
+         }
+      }
+      if (TunerConfig.existsVar("Trials")) {
+         Err = TunerConfig.get("Trials", Trials);
+         if (Err != 0) {
+            LOG_ERROR("KernelTuner: error reading Trials from KernelTuner "
+                      "Config");
+            return Err;
+         }
+      }
+      if (TunerConfig.existsVar("TileLengths")) {
+         Err = TunerConfig.get("TileLengths", TileLengths);
+         if (Err != 0) {
+            LOG_ERROR("KernelTuner: error reading TileLengths from "
+                      "KernelTuner Config");
+            return Err;
+         }
+      }
+      if (TunerConfig.existsVar("CacheFile")) {
+         Err = TunerConfig.get("CacheFile", CacheFile);
+         if (Err != 0) {
+            LOG_ERROR("KernelTuner: error reading CacheFile from KernelTuner "
+                      "Config");
+            return Err;
+         }
+      }
+   }
+
+   if (Trials < 1) {
+      LOG_ERROR("KernelTuner: Trials must be at least 1, got {}", Trials);
+      return 1;
+   }
+
+   if (Enabled and !CacheFile.empty())
+      Err = readCache(CacheFile);
+
+   return Err;
+
+} // end KernelTuner init
+
+//------------------------------------------------------------------------------
+// Candidates of a kernel. The default MDRange tile is tried first, so it is
+// kept if no other candidate is faster.
+
+bool KernelTuner::isValid(const Choice &C, // [in] choice to check
+                          int Rank,        // [in] rank of the loop
+                          bool AllowTeam   // [in] accept OuterInner
+) {
+   switch (C.Policy) {
+   case PolicyKind::Flat:
+      return Rank == 2 or Rank == 3;
+   case PolicyKind::OuterInner:
+      return AllowTeam and (Rank == 2 or Rank == 3);
+   default:
+      return C.TileLength >= 0;
+   }
+}
+
+void KernelTuner::buildCandidates(KernelData &Data, // [inout] kernel data
+                                  int Rank,         // [in] rank of the loop
+                                  bool AllowTeam    // [in] try OuterInner
+) {
+
+   Data.Candidates.clear();
+   Data.Candidates.push_back({PolicyKind::MDRange, 0});
+   for (I4 Length : TileLengths) {
+      if (Length > 0 and Length != OMEGA_TILE_LENGTH)
+         Data.Candidates.push_back({PolicyKind::MDRange, Length});
+   }
+   for (auto Policy : {PolicyKind::Flat, PolicyKind::OuterInner}) {
+      const Choice C{Policy, 0};
+      if (isValid(C, Rank, AllowTeam))
+         Data.Candidates.push_back(C);
+   }
+
+   Data.MinTimes.assign(Data.Candidates.size(), -1);
+   Data.Candidate = 0;
+   Data.Trial     = 0;
+
+} // end KernelTuner buildCandidates
+
+//------------------------------------------------------------------------------
+// Start and complete a launch
+
+KernelTuner::Choice
+KernelTuner::beginLaunch(const std::string &Label, // [in] kernel label
+                         int Rank,                 // [in] rank of the loop
+                         bool AllowTeam            // [in] try OuterInner
+) {
+
+   Running = nullptr;
+   if (not Enabled)
+      return Choice();
+
+   auto [Iter, New] = AllKernels.try_emplace(Label);
+   KernelData &Data = Iter->second;
+
+   if (Data.Tuned) {
+      // A choice read from the cache may not apply to this loop
+      if (isValid(Data.Best, Rank, AllowTeam))
+         return Data.Best;
+      return Choice();
+   }
+
+   if (New or Data.Candidates.empty())
+      buildCandidates(Data, Rank, AllowTeam);
+
+   Kokkos::fence();
+   Running      = &Data;
+   RunningLabel = Label;
+   StartTime    = MPI_Wtime();
+
+   return Data.Candidates[Data.Candidate];
+
+} // end KernelTuner beginLaunch
+
+void KernelTuner::endLaunch() {
+
+   if (Running == nullptr)
+      return;
+
+   Kokkos::fence();
+   const R8 Time    = MPI_Wtime() - StartTime;
+   KernelData &Data = *Running;
+   Running          = nullptr;
+
+   R8 &MinTime = Data.MinTimes[Data.Candidate];
+   if (MinTime < 0 or Time < MinTime)
+      MinTime = Time;
+
+   if (++Data.Trial < Trials)
+      return;
+
+   Data.Trial = 0;
+   if (++Data.Candidate < static_cast<I4>(Data.Candidates.size()))
+      return;
+
+   // All candidates have been tried, keep the fastest
+   I4 Best = 0;
+   for (I4 I = 1; I < static_cast<I4>(Data.MinTimes.size()); ++I) {
+      if (Data.MinTimes[I] < Data.MinTimes[Best])
+         Best = I;
+   }
+   Data.Best  = Data.Candidates[Best];
+   Data.Tuned = true;
+
+   LOG_INFO("KernelTuner: kernel {} uses the {} policy with tile length {} "
+            "({:.3e} s, default {:.3e} s)",
+            RunningLabel, policyName(Data.Best.Policy), Data.Best.TileLength,
+            Data.MinTimes[Best], Data.MinTimes[0]);
+
+} // end KernelTuner endLaunch
+
+//------------------------------------------------------------------------------
+// Retrieve the choice of a kernel
+
+KernelTuner::Choice
+KernelTuner::getBest(const std::string &Label, // [in] kernel label
+                     int Rank,                 // [in] rank of the loop
+                     bool AllowTeam            // [in] accept OuterInner
+) {
+   auto Iter = AllKernels.find(Label);
+   if (Iter != AllKernels.end() and Iter->second.Tuned and
+       isValid(Iter->second.Best, Rank, AllowTeam))
+      return Iter->second.Best;
+   return Choice();
+}
+
+bool KernelTuner::isTuned(const std::string &Label // [in] kernel label
+) {
+   auto Iter = AllKernels.find(Label);
+   return Iter != AllKernels.end() and Iter->second.Tuned;
+}
+
+//------------------------------------------------------------------------------
+// Read and write the cache file
+
+int KernelTuner::readCache(const std::string &FileName // [in] cache file
+) {
+
+   std::ifstream Cache(FileName);
+   if (!Cache.is_open()) {
+      LOG_INFO("KernelTuner: no cache file {}, tuning all kernels", FileName);
+      return 0;
+   }
+
+   std::string Line;
+   std::getline(Cache, Line);
+   const std::string Header =
+       std::string("# KernelTuner ") + ExecSpace::name();
+   if (Line != Header) {
+      LOG_WARN("KernelTuner: cache file {} was not written for the {} "
+               "execution space, tuning all kernels",
+               FileName, ExecSpace::name());
+      return 0;
+   }
+
+   I4 NRead = 0;
+   while (std::getline(Cache, Line)) {
+      if (Line.empty() or Line[0] == '#')
+         continue;
+
+      std::istringstream Fields(Line);
+      std::string PolicyStr;
+      std::string Label;
+      Choice Best;
+      Fields >> PolicyStr >> Best.TileLength;
+      std::getline(Fields >> std::ws, Label);
+      if (Fields.fail() or Label.empty() or !policyFromName(PolicyStr, Best.Policy)) {
+         LOG_ERROR("KernelTuner: invalid line in cache file {}: {}", FileName,
+                   Line);
+         return 1;
+      }
+
+      KernelData &Data = AllKernels[Label];
+      Data.Best        = Best;
+      Data.Tuned       = true;
+      ++NRead;
+   }
+
+   LOG_INFO("KernelTuner: read the policies of {} kernels from {}", NRead,
+            FileName);
+
+   return 0;
+
+} // end KernelTuner readCache
+
+int KernelTuner::writeCache(const std::string &FileName // [in] cache file
+) {
+
+   if (not MachEnv::getDefault()->isMasterTask())
+      return 0;
+
+   std::ofstream Cache(FileName);
+   if (!Cache.is_open()) {
+      LOG_ERROR("KernelTuner: unable to open cache file {}", FileName);
+      return 1;
+   }
+
+   Cache << "# KernelTuner " << ExecSpace::name() << "\n";
+   for (const auto &[Label, Data] : AllKernels) {
+      if (Data.Tuned)
+         Cache << policyName(Data.Best.Policy) << " " << Data.Best.TileLength
+               << " " << Label << "\n";
+   }
+
+   if (Cache.fail()) {
+      LOG_ERROR("KernelTuner: error writing cache file {}", FileName);
+      return 1;
+   }
+
+   return 0;
+
+} // end KernelTuner writeCache
+
+//------------------------------------------------------------------------------
+// Write the cache file and remove all data
+
+int KernelTuner::finalize() {
+
+   int Err = 0;
+   if (Enabled and !CacheFile.empty())
+      Err = writeCache(CacheFile);
+
+   clear();
+
+   return Err;
+
+} // end KernelTuner finalize
+
+void KernelTuner::clear() {
+   AllKernels.clear();
+   Running = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// Set the tuner options
+
+void KernelTuner::setEnabled(bool InEnabled // [in] new setting
+) {
+   Enabled = InEnabled;
+}
+
+void KernelTuner::setCandidates(
+    I4 InTrials,                         // [in] launches per candidate
+    const std::vector<I4> &InTileLengths // [in] tile lengths to try
+) {
+   Trials      = InTrials > 0 ? InTrials : 1;
+   TileLengths = InTileLengths;
+}
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
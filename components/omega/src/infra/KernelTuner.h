@@ -0,0 +1,158 @@
+#ifndef OMEGA_KERNELTUNER_H
+#define OMEGA_KERNELTUNER_H
+//===-- infra/KernelTuner.h - Omega kernel policy autotuner -----*- C++ -*-===//
+//
+/// \file
+/// \brief Defines an autotuner for the policies of labeled Omega kernels
+///
+/// The KernelTuner class selects the execution policy of every labeled
+/// multi-dimensional parallelFor loop from measurements on the machine the
+/// run is on. The first launches of a kernel cycle through a set of
+/// candidates: MDRange policies with different lengths of the tiled index,
+/// a flat RangePolicy over the combined index space and, for the loops
+/// launched with parallelForChunks, the hierarchical TeamPolicy of
+/// parallelForOuterInner. Each candidate is timed over a number of launches,
+/// with a fence before and after each one, and the fastest is used for the
+/// rest of the run. All candidates execute every iteration once with the
+/// same functor, so the choice does not change the results. The choices are
+/// written to a cache file at the end of the run and read back at startup,
+/// so that later runs on the same machine skip the tuning. The tuner is off
+/// by default.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// The KernelTuner class is a static class that tunes and stores the policy
+/// of the labeled kernels
+class KernelTuner {
+
+ public:
+   /// Execution policies that a kernel can be launched with
+   enum class PolicyKind {
+      MDRange,   ///< MDRangePolicy with a tile of the default shape
+      Flat,      ///< RangePolicy over the combined index space
+      OuterInner ///< TeamPolicy of parallelForOuterInner
+   };
+
+   /// Policy of a kernel launch
+   struct Choice {
+      PolicyKind Policy = PolicyKind::MDRange; ///< execution policy
+      I4 TileLength     = 0; ///< tiled index length, 0 for the default tile
+   };
+
+ private:
+   /// Candidates and measurements of a kernel
+   struct KernelData {
+      std::vector<Choice> Candidates; ///< policies tried during tuning
+      std::vector<R8> MinTimes;       ///< fastest launch of each candidate
+      I4 Candidate{0};                ///< candidate of the next launch
+      I4 Trial{0};                    ///< launches of the current candidate
+      bool Tuned{false};              ///< true once Best is chosen
+      Choice Best;                    ///< fastest candidate
+   };
+
+   /// Flag to enable or disable the tuner
+   static bool Enabled;
+
+   /// Number of timed launches of every candidate
+   static I4 Trials;
+
+   /// Lengths of the tiled index of the MDRange candidates
+   static std::vector<I4> TileLengths;
+
+   /// File the choices are read from at startup and written to at the end
+   static std::string CacheFile;
+
+   /// Data of the tuned kernels, indexed by label
+   static std::map<std::string, KernelData> AllKernels;
+
+   /// Kernel whose launch is being timed, its label and its start time
+   static KernelData *Running;
+   static std::string RunningLabel;
+   static R8 StartTime;
+
+   /// Returns true if a choice can be used for a loop of the input rank
+   static bool isValid(const Choice &C, ///< [in] choice to check
+                       int Rank,        ///< [in] rank of the loop
+                       bool AllowTeam   ///< [in] accept OuterInner
+   );
+
+   /// Builds the candidates of a kernel
+   static void buildCandidates(KernelData &Data, ///< [inout] kernel data
+                               int Rank,         ///< [in] rank of the loop
+                               bool AllowTeam    ///< [in] try OuterInner
+   );
+
+ public:
+   /// Initializes the tuner from the optional KernelTuner group of the Omega
+   /// Config, which can contain the Enabled flag, the number of Trials per
+   /// candidate, the TileLengths to try and the CacheFile to use, and reads
+   /// the cache file if it exists
+   static int init();
+
+   /// Returns the policy of the next launch of a kernel and starts timing
+   /// the launch if the kernel is being tuned. Must be followed by endLaunch
+   /// once the kernel has been launched.
+   static Choice beginLaunch(const std::string &Label, ///< [in] kernel label
+                             int Rank,      ///< [in] rank of the loop
+                             bool AllowTeam ///< [in] try OuterInner
+   );
+
+   /// Completes the launch started with beginLaunch, waiting for the kernel
+   /// if it is being timed
+   static void endLaunch();
+
+   /// Returns the tuned policy of a kernel without timing, or the default
+   /// MDRange policy if the kernel is not tuned yet
+   static Choice getBest(const std::string &Label, ///< [in] kernel label
+                         int Rank,                 ///< [in] rank of the loop
+                         bool AllowTeam            ///< [in] accept OuterInner
+   );
+
+   /// Returns true if the policy of a kernel has been chosen
+   static bool isTuned(const std::string &Label ///< [in] kernel label
+   );
+
+   /// Reads the choices from a cache file, ignoring a missing file or a file
+   /// written for another execution space
+   static int readCache(const std::string &FileName ///< [in] cache file
+   );
+
+   /// Writes the choices of all tuned kernels to a cache file from the
+   /// master task
+   static int writeCache(const std::string &FileName ///< [in] cache file
+   );
+
+   /// Writes the cache file if the tuner is enabled and removes all data
+   static int finalize();
+
+   /// Removes all kernel data
+   static void clear();
+
+   /// Enables or disables the tuner
+   static void setEnabled(bool InEnabled ///< [in] new setting
+   );
+
+   /// Sets the number of timed launches per candidate and the lengths of the
+   /// tiled index to try for kernels that are not tuned yet
+   static void
+   setCandidates(I4 InTrials, ///< [in] launches per candidate
+                 const std::vector<I4> &InTileLengths ///< [in] tile lengths
+   );
+
+   /// Returns true if the tuner is enabled
+   static bool isEnabled() { return Enabled; }
+
+}; // end class KernelTuner
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_KERNELTUNER_H
@@ -50,7 +50,8 @@
 
 GENERATE_FORMATTER_ARR(HostArray)
 
-#ifdef OMEGA_TARGET_DEVICE
+// Device arrays are the host arrays in unified memory builds
+#if defined(OMEGA_TARGET_DEVICE) && !defined(OMEGA_UNIFIED_MEMORY)
 GENERATE_FORMATTER_ARR(Array)
 #endif
 
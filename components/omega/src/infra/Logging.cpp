@@ -3,19 +3,28 @@
 /// \file
 /// \brief implements Omega logging functions
 ///
-/// This implements Omega logging initialization.
+/// This implements Omega logging initialization and finalization.
 //
 //===----------------------------------------------------------------------===//
 #include "Logging.h"
 #include "MachEnv.h"
+#include <chrono>
 #include <iostream>
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/null_sink.h>
 
 #define _OMEGA_STRINGIFY(x) #x
 #define _OMEGA_TOSTRING(x)  _OMEGA_STRINGIFY(x)
 
 namespace OMEGA {
 
+// True if this is the master task of the logging environment
+static bool LogMasterTask = false;
+
+// Returns true if this is the master task of the logging environment
+bool isLogMasterTask() { return LogMasterTask; }
+
 // Function to pack log message
 std::string _PackLogMsg(const char *file, int line, const std::string &msg) {
 
@@ -78,6 +87,7 @@ int initLogging(const OMEGA::MachEnv *DefEnv,
 
    OMEGA::I4 TaskId   = DefEnv->getMyTask();
    OMEGA::I4 NumTasks = DefEnv->getNumTasks();
+   LogMasterTask      = DefEnv->isMasterTask();
 
    std::vector<int> Tasks =
        splitTasks(_OMEGA_TOSTRING(OMEGA_LOG_TASKS), NumTasks);
@@ -109,6 +119,7 @@ int initLogging(const OMEGA::MachEnv *DefEnv, std::string const &LogFilePath) {
 
    OMEGA::I4 TaskId   = DefEnv->getMyTask();
    OMEGA::I4 NumTasks = DefEnv->getNumTasks();
+   LogMasterTask      = DefEnv->isMasterTask();
 
    std::vector<int> Tasks =
        splitTasks(_OMEGA_TOSTRING(OMEGA_LOG_TASKS), NumTasks);
@@ -119,17 +130,27 @@ int initLogging(const OMEGA::MachEnv *DefEnv, std::string const &LogFilePath) {
       try {
          std::size_t dotPos = LogFilePath.find_last_of('.');
 
+         std::string TaskLogFilePath = LogFilePath;
          if (Tasks.size() > 1 && dotPos != std::string::npos) {
-            auto NewLogFilePath = LogFilePath.substr(0, dotPos) + "_" +
-                                  std::to_string(TaskId) +
-                                  LogFilePath.substr(dotPos);
-            spdlog::set_default_logger(
-                spdlog::basic_logger_mt("*", NewLogFilePath));
-         } else {
-            spdlog::set_default_logger(
-                spdlog::basic_logger_mt("*", LogFilePath));
+            TaskLogFilePath = LogFilePath.substr(0, dotPos) + "_" +
+                              std::to_string(TaskId) +
+                              LogFilePath.substr(dotPos);
          }
 
+#if defined(OMEGA_LOG_ASYNC)
+         // Messages are queued for a single background thread that writes
+         // them to the file. When the queue is full, the oldest message is
+         // dropped so that logging never blocks the calling task.
+         spdlog::init_thread_pool(OMEGA_LOG_QUEUE_SIZE, 1);
+         spdlog::set_default_logger(
+             spdlog::basic_logger_mt<spdlog::async_factory_nonblock>(
+                 "*", TaskLogFilePath));
+         spdlog::flush_every(std::chrono::seconds(OMEGA_LOG_FLUSH_INTERVAL));
+#else
+         spdlog::set_default_logger(
+             spdlog::basic_logger_mt("*", TaskLogFilePath));
+#endif
+
          spdlog::set_pattern("[%n %l] %v");
          spdlog::set_level(
              static_cast<spdlog::level::level_enum>(SPDLOG_ACTIVE_LEVEL));
@@ -150,4 +171,19 @@ int initLogging(const OMEGA::MachEnv *DefEnv, std::string const &LogFilePath) {
    return RetVal;
 }
 
+// Flushes all log messages and, with asynchronous logging, stops the
+// background thread after it has written all queued messages
+void finalizeLogging() {
+
+   spdlog::apply_all([](std::shared_ptr<spdlog::logger> l) { l->flush(); });
+
+#if defined(OMEGA_LOG_ASYNC)
+   // Shutting down drops all loggers, so a discarding logger is installed
+   // in case of any later messages
+   spdlog::shutdown();
+   spdlog::set_default_logger(spdlog::null_logger_st("*"));
+   spdlog::set_level(spdlog::level::off);
+#endif
+}
+
 } // namespace OMEGA
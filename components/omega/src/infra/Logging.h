@@ -6,7 +6,11 @@
 /// \brief Defines logging macros and spdlog custom formatters
 ///
 /// This header defines macros for logging. In addition, it includes
-/// Omega-specific log formatters.
+/// Omega-specific log formatters. Messages below the compile-time level set
+/// by OMEGA_LOG_LEVEL are removed by spdlog at compile time. If Omega is built
+/// with OMEGA_LOG_ASYNC, messages are passed to a background thread through a
+/// bounded queue of OMEGA_LOG_QUEUE_SIZE messages and written by that thread,
+/// which also flushes the log every OMEGA_LOG_FLUSH_INTERVAL seconds.
 //
 //===----------------------------------------------------------------------===//
 
@@ -70,10 +74,36 @@
                     ##__VA_ARGS__);                              \
    _LOG_FLUSH
 
+/// Logs an info message only on the master task, even if every task logs
+#define LOG_INFO_MASTER(msg, ...)      \
+   do {                                \
+      if (OMEGA::isLogMasterTask()) {  \
+         LOG_INFO(msg, ##__VA_ARGS__); \
+      }                                \
+   } while (0)
+
+/// Logs an info message on the first call and every N-th call after it from
+/// the same location, without evaluating the message arguments otherwise
+#define LOG_INFO_EVERY(N, msg, ...)    \
+   do {                                \
+      static OMEGA::I8 _LogCount = 0;  \
+      if (_LogCount++ % (N) == 0) {    \
+         LOG_INFO(msg, ##__VA_ARGS__); \
+      }                                \
+   } while (0)
+
 #ifndef OMEGA_LOG_TASKS
 #define OMEGA_LOG_TASKS 0
 #endif
 
+#ifndef OMEGA_LOG_QUEUE_SIZE
+#define OMEGA_LOG_QUEUE_SIZE 8192
+#endif
+
+#ifndef OMEGA_LOG_FLUSH_INTERVAL
+#define OMEGA_LOG_FLUSH_INTERVAL 5
+#endif
+
 namespace OMEGA {
 
 class MachEnv;
@@ -86,6 +116,16 @@ int initLogging(const OMEGA::MachEnv *DefEnv,
 int initLogging(const OMEGA::MachEnv *DefEnv,
                 std::string const &LogFilePath = OmegaDefaultLogfile);
 
+/// Returns true if this is the master task of the environment used to
+/// initialize logging
+bool isLogMasterTask();
+
+/// Flushes all log messages. With asynchronous logging, this also waits for
+/// the background thread to write all queued messages and stops it, after
+/// which further messages are discarded, so it must be the last logging call
+/// of a run.
+void finalizeLogging();
+
 std::string _PackLogMsg(const char *file, int line, const std::string &msg);
 
 } // namespace OMEGA
@@ -0,0 +1,385 @@
+//===-- infra/MemoryTracker.cpp - Omega memory accounting -------*- C++ -*-===//
+//
+// Implementation of the accounting of Kokkos allocations by Omega module. The
+// Kokkos Tools allocate and deallocate callbacks record the size of every
+// allocation against the innermost active memory region and the memory space
+// of the allocation. Callbacks that were registered before, eg by a Kokkos
+// Tools library loaded through KOKKOS_TOOLS_LIBS, are still called. The print
+// method reduces the accumulated usage across tasks and writes a summary table
+// to the log.
+//
+//===----------------------------------------------------------------------===//
+
+#include "MemoryTracker.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OMEGA {
+
+// Create static class members
+bool MemoryTracker::Enabled    = true;
+bool MemoryTracker::Registered = false;
+std::map<std::string, MemoryTracker::MemoryData> MemoryTracker::AllUsage;
+std::vector<std::string> MemoryTracker::UsageOrder;
+std::vector<std::string> MemoryTracker::ActiveModules;
+std::unordered_map<const void *, MemoryTracker::LiveAlloc>
+    MemoryTracker::LiveAllocs;
+
+//------------------------------------------------------------------------------
+// Kokkos Tools callbacks, which forward to the callbacks registered before
+
+static Kokkos_Profiling_allocateDataFunction PrevAllocate     = nullptr;
+static Kokkos_Profiling_deallocateDataFunction PrevDeallocate = nullptr;
+
+static void allocateCallback(const Kokkos_Profiling_SpaceHandle Handle,
+                             const char *Label, const void *Ptr,
+                             const uint64_t Size) {
+   MemoryTracker::recordAlloc(Handle.name, Ptr, static_cast<I8>(Size));
+   if (PrevAllocate != nullptr)
+      PrevAllocate(Handle, Label, Ptr, Size);
+}
+
+static void deallocateCallback(const Kokkos_Profiling_SpaceHandle Handle,
+                               const char *Label, const void *Ptr,
+                               const uint64_t Size) {
+   MemoryTracker::recordFree(Ptr);
+   if (PrevDeallocate != nullptr)
+      PrevDeallocate(Handle, Label, Ptr, Size);
+}
+
+static void registerCallbacks() {
+   auto Callbacks = Kokkos::Tools::Experimental::get_callbacks();
+   PrevAllocate   = Callbacks.allocate_data;
+   PrevDeallocate = Callbacks.deallocate_data;
+   Kokkos::Tools::Experimental::set_allocate_data_callback(allocateCallback);
+   Kokkos::Tools::Experimental::set_deallocate_data_callback(
+       deallocateCallback);
+}
+
+static void unregisterCallbacks() {
+   Kokkos::Tools::Experimental::set_allocate_data_callback(PrevAllocate);
+   Kokkos::Tools::Experimental::set_deallocate_data_callback(PrevDeallocate);
+   PrevAllocate   = nullptr;
+   PrevDeallocate = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// Initialize the accounting from the optional MemoryTracker config group
+
+int MemoryTracker::init() {
+
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("MemoryTracker")) {
+      Config TrackerConfig("MemoryTracker");
+      Err = OmegaConfig->get(TrackerConfig);
+      if (Err != 0) {
+         LOG_ERROR("MemoryTracker: error reading MemoryTracker group from "
+                   "Config");
+         return Err;
+      }
+      if (TrackerConfig.existsVar("Enabled")) {
+         Err = TrackerConfig.get("Enabled", Enabled);
+         if (Err != 0) {
+            LOG_ERROR("MemoryTracker: error reading Enabled from "
+                      "MemoryTracker Config");
+            return Err;
+         }
+      }
+   }
+
+   setEnabled(Enabled);
+
+   return Err;
+
+} // end MemoryTracker init
+
+//------------------------------------------------------------------------------
+// Return the data for a Module:Space key, adding it in allocation order
+
+MemoryTracker::MemoryData &
+MemoryTracker::getData(const std::string &Key // [in] Module:Space
+) {
+   auto [Iter, New] = AllUsage.try_emplace(Key);
+   if (New)
+      UsageOrder.push_back(Key);
+   return Iter->second;
+}
+
+//------------------------------------------------------------------------------
+// Start a memory region
+
+int MemoryTracker::start(const std::string &Module // [in] name of module
+) {
+
+   if (not Enabled)
+      return 0;
+
+   if (Module.find(':') != std::string::npos) {
+      LOG_ERROR("MemoryTracker: module name {} must not contain a colon",
+                Module);
+      return -1;
+   }
+
+   ActiveModules.push_back(Module);
+
+   return 0;
+
+} // end MemoryTracker start
+
+//------------------------------------------------------------------------------
+// Stop the innermost memory region
+
+int MemoryTracker::stop(const std::string &Module // [in] name of module
+) {
+
+   if (not Enabled)
+      return 0;
+
+   if (ActiveModules.empty() or ActiveModules.back() != Module) {
+      LOG_ERROR("MemoryTracker: attempt to stop memory region {} which is not "
+                "the innermost active region",
+                Module);
+      return -1;
+   }
+
+   ActiveModules.pop_back();
+
+   return 0;
+
+} // end MemoryTracker stop
+
+//------------------------------------------------------------------------------
+// Record an allocation against the innermost active module
+
+void MemoryTracker::recordAlloc(const std::string &Space, // [in] memory space
+                                const void *Ptr,          // [in] allocation
+                                I8 Bytes                  // [in] size
+) {
+
+   std::string Module = ActiveModules.empty() ? "Other" : ActiveModules.back();
+
+   MemoryData &ModuleData = getData(Module + ":" + Space);
+   MemoryData &TotalData  = getData("Total:" + Space);
+
+   for (MemoryData *Data : {&ModuleData, &TotalData}) {
+      Data->CurBytes += Bytes;
+      Data->PeakBytes = std::max(Data->PeakBytes, Data->CurBytes);
+      ++Data->Count;
+   }
+
+   LiveAllocs[Ptr] = LiveAlloc{&ModuleData, &TotalData, Bytes};
+
+} // end MemoryTracker recordAlloc
+
+//------------------------------------------------------------------------------
+// Record the release of an allocation, allocations made before the callbacks
+// were registered are ignored
+
+void MemoryTracker::recordFree(const void *Ptr // [in] allocation
+) {
+
+   auto Iter = LiveAllocs.find(Ptr);
+   if (Iter == LiveAllocs.end())
+      return;
+
+   const LiveAlloc &Alloc = Iter->second;
+   Alloc.Module->CurBytes -= Alloc.Bytes;
+   Alloc.Total->CurBytes -= Alloc.Bytes;
+   LiveAllocs.erase(Iter);
+
+} // end MemoryTracker recordFree
+
+//------------------------------------------------------------------------------
+// Return the local current and peak bytes of a module over all memory spaces
+
+I8 MemoryTracker::getBytes(const std::string &Module // [in] name of module
+) {
+   I8 Bytes                 = 0;
+   const std::string Prefix = Module + ":";
+   for (const auto &[Key, Data] : AllUsage) {
+      if (Key.compare(0, Prefix.size(), Prefix) == 0)
+         Bytes += Data.CurBytes;
+   }
+   return Bytes;
+}
+
+I8 MemoryTracker::getPeakBytes(const std::string &Module // [in] name of module
+) {
+   I8 Bytes                 = 0;
+   const std::string Prefix = Module + ":";
+   for (const auto &[Key, Data] : AllUsage) {
+      if (Key.compare(0, Prefix.size(), Prefix) == 0)
+         Bytes += Data.PeakBytes;
+   }
+   return Bytes;
+}
+
+//------------------------------------------------------------------------------
+// Reduce the usage across tasks and write a summary to the log. The list of
+// modules and spaces is broadcast from the master task, tasks without an
+// allocation in a module and space contribute zero bytes to its statistics.
+
+int MemoryTracker::print(const std::string &Stage, // [in] stage of the run
+                         const MachEnv *Env // [in] environment to reduce over
+) {
+
+   int Err = 0;
+
+   if (not Enabled)
+      return Err;
+
+   MPI_Comm Comm   = Env->getComm();
+   int MasterTask  = Env->getMasterTask();
+   int NumTasks    = Env->getNumTasks();
+   int MyTask      = Env->getMyTask();
+   bool MasterFlag = Env->isMasterTask();
+
+   // Broadcast the keys of the master task as a newline-separated string,
+   // with the totals of all modules last
+   std::string AllKeys;
+   if (MasterFlag) {
+      std::string TotalKeys;
+      for (const auto &Key : UsageOrder) {
+         if (Key.compare(0, 6, "Total:") == 0)
+            TotalKeys += Key + "\n";
+         else
+            AllKeys += Key + "\n";
+      }
+      AllKeys += TotalKeys;
+   }
+   int KeysLength = AllKeys.size();
+   Err = MPI_Bcast(&KeysLength, 1, MPI_INT, MasterTask, Comm);
+   AllKeys.resize(KeysLength);
+   Err += MPI_Bcast(AllKeys.data(), KeysLength, MPI_CHAR, MasterTask, Comm);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("MemoryTracker: error broadcasting module names");
+      return -1;
+   }
+
+   std::vector<std::string> Keys;
+   std::istringstream KeyStream(AllKeys);
+   std::string Key;
+   while (std::getline(KeyStream, Key)) {
+      Keys.push_back(Key);
+   }
+
+   // Reduce the local current and peak usage in MB of each key, the maximum
+   // is reduced with the task that holds it
+   struct ValueTask {
+      double Value;
+      int Task;
+   };
+   const R8 MB = 1024.0 * 1024.0;
+   int NKeys   = Keys.size();
+   std::vector<R8> LocCur(NKeys, 0);
+   std::vector<ValueTask> LocCurTask(NKeys), LocPeakTask(NKeys);
+   for (int I = 0; I < NKeys; ++I) {
+      auto Iter = AllUsage.find(Keys[I]);
+      R8 Cur    = Iter != AllUsage.end() ? Iter->second.CurBytes / MB : 0;
+      R8 Peak   = Iter != AllUsage.end() ? Iter->second.PeakBytes / MB : 0;
+
+      LocCur[I]      = Cur;
+      LocCurTask[I]  = ValueTask{Cur, MyTask};
+      LocPeakTask[I] = ValueTask{Peak, MyTask};
+   }
+   std::vector<R8> MinCur(NKeys, 0);
+   std::vector<R8> SumCur(NKeys, 0);
+   std::vector<ValueTask> MaxCur(NKeys), MaxPeak(NKeys);
+   Err = MPI_Reduce(LocCur.data(), MinCur.data(), NKeys, MPI_DOUBLE, MPI_MIN,
+                    MasterTask, Comm);
+   Err += MPI_Reduce(LocCur.data(), SumCur.data(), NKeys, MPI_DOUBLE, MPI_SUM,
+                     MasterTask, Comm);
+   Err += MPI_Reduce(LocCurTask.data(), MaxCur.data(), NKeys, MPI_DOUBLE_INT,
+                     MPI_MAXLOC, MasterTask, Comm);
+   Err += MPI_Reduce(LocPeakTask.data(), MaxPeak.data(), NKeys, MPI_DOUBLE_INT,
+                     MPI_MAXLOC, MasterTask, Comm);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("MemoryTracker: error reducing memory data");
+      return -1;
+   }
+
+   // Write the summary table
+   if (MasterFlag) {
+      LOG_INFO("MemoryTracker: Kokkos memory use at {} over {} tasks (MB)",
+               Stage, NumTasks);
+      LOG_INFO("{:<20} {:<12} {:>10} {:>10} {:>10} {:>7} {:>10} {:>7}",
+               "Module", "Space", "Min", "Max", "Mean", "MaxTask", "Peak",
+               "PeakTask");
+      for (int I = 0; I < NKeys; ++I) {
+         std::string::size_type Colon = Keys[I].find(':');
+         LOG_INFO("{:<20} {:<12} {:>10.2f} {:>10.2f} {:>10.2f} {:>7} "
+                  "{:>10.2f} {:>7}",
+                  Keys[I].substr(0, Colon), Keys[I].substr(Colon + 1),
+                  MinCur[I], MaxCur[I].Value, SumCur[I] / NumTasks,
+                  MaxCur[I].Task, MaxPeak[I].Value, MaxPeak[I].Task);
+      }
+   }
+
+   return 0;
+
+} // end MemoryTracker print
+
+//------------------------------------------------------------------------------
+// Unregister the callbacks and remove all data
+
+int MemoryTracker::finalize() {
+
+   if (Registered) {
+      unregisterCallbacks();
+      Registered = false;
+   }
+   clear();
+
+   return 0;
+
+} // end MemoryTracker finalize
+
+void MemoryTracker::clear() {
+   AllUsage.clear();
+   UsageOrder.clear();
+   ActiveModules.clear();
+   LiveAllocs.clear();
+}
+
+//------------------------------------------------------------------------------
+// Enable or disable the accounting
+
+void MemoryTracker::setEnabled(bool InEnabled // [in] new setting
+) {
+   Enabled = InEnabled;
+   if (Enabled and not Registered) {
+      registerCallbacks();
+      Registered = true;
+   } else if (not Enabled and Registered) {
+      unregisterCallbacks();
+      Registered = false;
+   }
+}
+
+bool MemoryTracker::isEnabled() { return Enabled; }
+
+//------------------------------------------------------------------------------
+// Start and stop a memory region with the lifetime of a MemoryRegion
+
+MemoryRegion::MemoryRegion(const std::string &InModule) : Module(InModule) {
+   MemoryTracker::start(Module);
+}
+
+MemoryRegion::~MemoryRegion() { MemoryTracker::stop(Module); }
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
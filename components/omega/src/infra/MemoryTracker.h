@@ -0,0 +1,159 @@
+#ifndef OMEGA_MEMORYTRACKER_H
+#define OMEGA_MEMORYTRACKER_H
+//===-- infra/MemoryTracker.h - Omega memory accounting ---------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the accounting of Kokkos allocations by Omega module
+///
+/// The MemoryTracker class attributes the memory of every Kokkos allocation
+/// to the Omega module that made it. It registers Kokkos Tools allocation
+/// callbacks, so all views are counted without changes to the code that
+/// creates them. A module is made responsible for allocations by starting a
+/// named memory region around its init (or any other code that allocates),
+/// and allocations made outside of any region are attributed to Other. For
+/// every module and memory space (eg Host or Cuda), the bytes currently
+/// allocated and their high-water mark are accumulated, along with the total
+/// of all modules. A summary of the minimum, maximum and mean usage across
+/// tasks is written to the log after initialization and before the modules
+/// are destroyed at the end of a run. A MemoryRegion object can be used to
+/// attribute the allocations of a scope to a module.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "MachEnv.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OMEGA {
+
+/// The MemoryTracker class is a static class that accounts for the Kokkos
+/// allocations of all modules
+class MemoryTracker {
+
+ private:
+   /// Accumulated allocation data for a module in one memory space
+   struct MemoryData {
+      I8 CurBytes{0};  ///< bytes currently allocated
+      I8 PeakBytes{0}; ///< high-water mark of the allocated bytes
+      I8 Count{0};     ///< number of allocations
+   };
+
+   /// An allocation that has not yet been freed
+   struct LiveAlloc {
+      MemoryData *Module; ///< data of the module that made the allocation
+      MemoryData *Total;  ///< data of the total for the memory space
+      I8 Bytes;           ///< size of the allocation
+   };
+
+   /// Flag to enable or disable the accounting
+   static bool Enabled;
+
+   /// True if the Kokkos Tools callbacks are registered
+   static bool Registered;
+
+   /// Allocation data indexed by module and memory space, Module:Space
+   static std::map<std::string, MemoryData> AllUsage;
+
+   /// Module:Space keys in the order they first allocated, used to print the
+   /// summary in allocation order
+   static std::vector<std::string> UsageOrder;
+
+   /// Names of the currently active memory regions, innermost last
+   static std::vector<std::string> ActiveModules;
+
+   /// Allocations that have not been freed, indexed by pointer
+   static std::unordered_map<const void *, LiveAlloc> LiveAllocs;
+
+   /// Returns the data for the input key, adding it if it does not exist
+   static MemoryData &getData(const std::string &Key ///< [in] Module:Space
+   );
+
+ public:
+   /// Initializes the accounting from the optional MemoryTracker group of
+   /// the Omega Config, which can contain the Enabled flag, and registers
+   /// the Kokkos Tools callbacks if enabled
+   static int init();
+
+   /// Attributes subsequent allocations to the module with the input name
+   /// until it is stopped
+   static int start(const std::string &Module ///< [in] name of module
+   );
+
+   /// Stops the memory region of the module with the input name, which must
+   /// be the most recently started active region
+   static int stop(const std::string &Module ///< [in] name of module
+   );
+
+   /// Records an allocation, called by the Kokkos Tools callback
+   static void recordAlloc(const std::string &Space, ///< [in] memory space
+                           const void *Ptr,          ///< [in] allocation
+                           I8 Bytes                  ///< [in] allocation size
+   );
+
+   /// Records the release of an allocation, called by the Kokkos Tools
+   /// callback
+   static void recordFree(const void *Ptr ///< [in] allocation
+   );
+
+   /// Returns the local bytes currently allocated by the input module in
+   /// all memory spaces
+   static I8 getBytes(const std::string &Module ///< [in] name of module
+   );
+
+   /// Returns the local high-water mark of the bytes allocated by the input
+   /// module, summed over memory spaces
+   static I8 getPeakBytes(const std::string &Module ///< [in] name of module
+   );
+
+   /// Reduces the current and peak bytes of each module and memory space
+   /// across the tasks of the input environment and writes a summary table
+   /// with the minimum, maximum and mean usage in MB and the task with the
+   /// maximum usage to the log, labeled with the input stage of the run
+   static int print(const std::string &Stage, ///< [in] stage of the run
+                    const MachEnv *Env = MachEnv::getDefault());
+
+   /// Unregisters the Kokkos Tools callbacks and removes all data
+   static int finalize();
+
+   /// Removes all allocation data
+   static void clear();
+
+   /// Enables or disables the accounting, registering or unregistering the
+   /// Kokkos Tools callbacks
+   static void setEnabled(bool InEnabled ///< [in] new setting
+   );
+
+   /// Returns true if the accounting is enabled
+   static bool isEnabled();
+
+}; // end class MemoryTracker
+
+/// Attributes the allocations of the enclosing scope to a module, starting
+/// the named memory region on construction and stopping it on destruction
+class MemoryRegion {
+
+ private:
+   std::string Module; ///< name of the module
+
+ public:
+   /// Starts the memory region of the named module
+   explicit MemoryRegion(const std::string &InModule ///< [in] name of module
+   );
+
+   /// Stops the memory region
+   ~MemoryRegion();
+
+   // forbid copy and move construction
+   MemoryRegion(const MemoryRegion &) = delete;
+   MemoryRegion(MemoryRegion &&)      = delete;
+
+}; // end class MemoryRegion
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_MEMORYTRACKER_H
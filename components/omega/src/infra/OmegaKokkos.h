@@ -10,6 +10,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "DataTypes.h"
+#include "KernelCounters.h"
+#include "KernelTuner.h"
+#include <Kokkos_Graph.hpp>
+#include <optional>
+#include <string>
+#include <type_traits>
 #include <utility>
 
 namespace OMEGA {
@@ -17,22 +23,225 @@ namespace OMEGA {
 #define OMEGA_SCOPE(a, b) auto &a = b
 
 using ExecSpace     = MemSpace::execution_space;
-using HostExecSpace = HostMemSpace::execution_space;
+using HostExecSpace = Kokkos::DefaultHostExecutionSpace;
 
+// True if host and device arrays are the same arrays in memory shared by
+// host and device (unified memory builds). Device kernels are asynchronous,
+// so host code must call fenceSharedArrays before it reads or writes arrays
+// that the device has been working on.
+inline constexpr bool SharedHostDevice =
+    std::is_same_v<MemSpace, HostMemSpace> and
+    !std::is_same_v<ExecSpace, HostExecSpace>;
+
+// Waits for the device kernels to complete before the host accesses shared
+// arrays, does nothing if host and device arrays are distinct or if the
+// device is the host
+inline void fenceSharedArrays() {
+   if constexpr (SharedHostDevice)
+      Kokkos::fence();
+}
+
+// hierarchical (team) parallelism on the default execution space
+using TeamPolicy = Kokkos::TeamPolicy<ExecSpace>;
+using TeamMember = TeamPolicy::member_type;
+
+// Mirrors of an array in the host or device memory space. The mirror is the
+// input array itself if it is already in that space, which is the case for
+// all arrays in CPU and unified memory builds; the copy then only waits for
+// the kernels working on the array.
 template <typename V>
 auto createHostMirrorCopy(const V &view)
     -> Kokkos::View<typename V::data_type, HostMemLayout, HostMemSpace> {
-   return Kokkos::create_mirror_view_and_copy(HostExecSpace(), view);
+   return Kokkos::create_mirror_view_and_copy(HostMemSpace(), view);
 }
 
 template <typename V>
 auto createDeviceMirrorCopy(const V &view)
     -> Kokkos::View<typename V::data_type, MemLayout, MemSpace> {
-   return Kokkos::create_mirror_view_and_copy(ExecSpace(), view);
+   return Kokkos::create_mirror_view_and_copy(MemSpace(), view);
+}
+
+// Host mirror of an array without copying its contents, allocated only if
+// the array is not already in the host memory space
+template <typename V>
+auto createHostMirror(const V &view)
+    -> Kokkos::View<typename V::data_type, HostMemLayout, HostMemSpace> {
+   return Kokkos::create_mirror_view(HostMemSpace(), view);
 }
 
-// function alias to follow Camel Naming Convention
+// KernelGraph: a sequence of kernels recorded once into a Kokkos graph and
+// then launched as a whole any number of times. While a graph is captured,
+// the kernels of parallelFor, parallelForOuterInner, parallelForPolicy and
+// the device copies of deepCopy are added to the graph in launch order
+// instead of being executed. On devices that support graphs (CUDA and HIP)
+// submitting the graph replaces the host launch of every kernel by a single
+// graph launch. The recorded kernels keep the arrays and scalars they
+// captured, so a graph is only valid while these do not change. Reductions
+// and copies that are not between contiguous device arrays cannot be
+// recorded; they are skipped and make the capture fail.
+class KernelGraph {
+ public:
+   /// Records the kernels launched by Kernels without executing them.
+   /// Returns false if the kernels could not all be recorded, in which case
+   /// the graph is empty and Kernels must be run directly.
+   template <class F> bool capture(const F &Kernels) {
+      Graph.reset();
+      Unsupported = false;
+      auto NewGraph = Kokkos::Experimental::create_graph(
+          ExecSpace(), [&](const auto &Root) {
+             Tail.emplace(Root);
+             Kernels();
+             Tail.reset();
+          });
+      if (Unsupported)
+         return false;
+      Graph.emplace(std::move(NewGraph));
+      return true;
+   }
+
+   /// True if a graph has been captured
+   bool isCaptured() const { return Graph.has_value(); }
+
+   /// Launches the captured kernels
+   void submit() const { Graph->submit(); }
+
+   /// Removes the captured graph
+   void reset() { Graph.reset(); }
+
+   /// True while a graph is being captured
+   static bool isCapturing() { return Tail.has_value(); }
+
+   /// Adds a kernel to the graph being captured
+   template <class P, class F>
+   static void addKernel(const std::string &Label, const P &Policy,
+                         const F &Func) {
+      *Tail = Node(Tail->then_parallel_for(Label, Policy, Func));
+   }
+
+   /// Marks an operation that cannot be recorded in the graph being
+   /// captured
+   static void addUnsupported() { Unsupported = true; }
+
+ private:
+   using Node = Kokkos::Experimental::GraphNodeRef<ExecSpace>;
+
+   std::optional<Kokkos::Experimental::Graph<ExecSpace>> Graph;
+
+   inline static std::optional<Node> Tail; ///< last node of the capture
+   inline static bool Unsupported = false; ///< capture has failed
+};
+
+// ExecInstance: selects the instance of the execution space that the Omega
+// loops, reductions and copies between device arrays are launched on while
+// the ExecInstance is in scope. The default instance is used otherwise.
+// Launches on another instance are asynchronous with respect to the default
+// instance, so the caller must fence the instance before its results are
+// used elsewhere.
+class ExecInstance {
+ public:
+   explicit ExecInstance(const ExecSpace &Space) : Prev(Current) {
+      Current.emplace(Space);
+   }
+   ~ExecInstance() { Current = Prev; }
+
+   ExecInstance(const ExecInstance &)            = delete;
+   ExecInstance &operator=(const ExecInstance &) = delete;
+
+   /// Instance the loops are launched on
+   static ExecSpace get() { return Current ? *Current : ExecSpace(); }
+
+   /// True if no other instance is selected
+   static bool isDefault() { return !Current.has_value(); }
+
+ private:
+   std::optional<ExecSpace> Prev; ///< instance selected before this one
+
+   inline static std::optional<ExecSpace> Current; ///< selected instance
+};
+
+// parallelForPolicy: parallel loop with an explicit execution policy, which is
+// launched or added to the kernel graph being captured
+template <class P, class F>
+inline void parallelForPolicy(const std::string &label, const P &policy,
+                              const F &f) {
+   if (KernelGraph::isCapturing()) {
+      KernelGraph::addKernel(label, policy, f);
+   } else {
+      Kokkos::parallel_for(label, policy, f);
+   }
+}
+
+// Adds the copy of a scalar or of an array with the same contiguous span to
+// a device array to the kernel graph being captured
+template <typename D, typename S> void addCopyKernel(D &dst, const S &src) {
+   using T = typename D::non_const_value_type;
+   using SpaceAccess =
+       Kokkos::SpaceAccessibility<ExecSpace, typename D::memory_space>;
+
+   if constexpr (!SpaceAccess::accessible) {
+      KernelGraph::addUnsupported();
+   } else if constexpr (std::is_arithmetic_v<S>) {
+      T *const Dst   = dst.data();
+      const T Value  = T(src);
+      const auto Num = dst.span();
+      if (!dst.span_is_contiguous()) {
+         KernelGraph::addUnsupported();
+         return;
+      }
+      KernelGraph::addKernel(
+          "graphFill", Kokkos::RangePolicy<ExecSpace>(0, Num),
+          KOKKOS_LAMBDA(size_t I) { Dst[I] = Value; });
+   } else if constexpr (Kokkos::is_view_v<S> &&
+                        std::is_same_v<typename S::array_layout,
+                                       typename D::array_layout> &&
+                        Kokkos::SpaceAccessibility<
+                            ExecSpace, typename S::memory_space>::accessible) {
+      T *const Dst       = dst.data();
+      const T *const Src = src.data();
+      const auto Num     = dst.span();
+      if (!dst.span_is_contiguous() or !src.span_is_contiguous() or
+          src.span() != Num) {
+         KernelGraph::addUnsupported();
+         return;
+      }
+      KernelGraph::addKernel(
+          "graphCopy", Kokkos::RangePolicy<ExecSpace>(0, Num),
+          KOKKOS_LAMBDA(size_t I) { Dst[I] = Src[I]; });
+   } else {
+      KernelGraph::addUnsupported();
+   }
+}
+
+// True if a copy from S can run on the execution space: S is a scalar or an
+// array accessible from the execution space
+template <typename S> constexpr bool isDeviceCopySource() {
+   if constexpr (Kokkos::is_view_v<S>) {
+      return Kokkos::SpaceAccessibility<ExecSpace,
+                                        typename S::memory_space>::accessible;
+   } else {
+      return std::is_arithmetic_v<S>;
+   }
+}
+
+// function alias to follow Camel Naming Convention. While a kernel graph is
+// captured, copies to device arrays are added to the graph. While another
+// instance is selected with an ExecInstance, copies between device arrays
+// are queued on that instance instead of synchronizing the device.
 template <typename D, typename S> void deepCopy(D &dst, const S &src) {
+   if constexpr (Kokkos::is_view_v<D>) {
+      if (KernelGraph::isCapturing()) {
+         addCopyKernel(dst, src);
+         return;
+      }
+      if constexpr (Kokkos::SpaceAccessibility<
+                        ExecSpace, typename D::memory_space>::accessible &&
+                    isDeviceCopySource<S>()) {
+         if (!ExecInstance::isDefault()) {
+            Kokkos::deep_copy(ExecInstance::get(), dst, src);
+            return;
+         }
+      }
+   }
    Kokkos::deep_copy(dst, src);
 }
 
@@ -61,19 +270,143 @@ using Bounds = Kokkos::MDRangePolicy<
 
 #endif
 
-// parallelFor: with label
+// Records the number of iterations of a labeled loop for the kernel counters
+template <int N>
+inline void countIterations(const std::string &label,
+                            const int (&upper_bounds)[N]) {
+   if (KernelCounters::isEnabled() && !label.empty()) {
+      I8 NIters = 1;
+      for (int I = 0; I < N; ++I) {
+         NIters *= upper_bounds[I];
+      }
+      KernelCounters::setIterations(label, NIters);
+   }
+}
+
+// Sets a tile of the default shape with the tiled (fastest) index of length
+// TileLength, or the default tile if TileLength is zero
+template <int N>
+inline void setTunedTile(int (&tile)[N], int TileLength) {
+#if OMEGA_LAYOUT_RIGHT
+   constexpr int Fast = N - 1;
+#else
+   constexpr int Fast = 0;
+#endif
+   for (int I = 0; I < N; ++I) {
+      tile[I] = DefaultTile<N>::value[I];
+   }
+   if (TileLength > 0) {
+      tile[Fast] = TileLength;
+   }
+}
+
+// parallelForFlat: loop over a 2D or 3D index space with a one-dimensional
+// RangePolicy over the combined index, with the fastest index of the memory
+// layout varying fastest
+template <int N, class F>
+inline void parallelForFlat(const std::string &label,
+                            const int (&upper_bounds)[N], const F &f) {
+   static_assert(N == 2 || N == 3,
+                 "parallelForFlat requires a 2D or 3D index space");
+   countIterations(label, upper_bounds);
+
+   int NTotal = 1;
+   for (int I = 0; I < N; ++I) {
+      NTotal *= upper_bounds[I];
+   }
+   const int N1 = upper_bounds[1];
+#if OMEGA_LAYOUT_RIGHT
+   const int NL = upper_bounds[N - 1];
+
+   parallelForPolicy(
+       label, Kokkos::RangePolicy<ExecSpace>(ExecInstance::get(), 0, NTotal),
+       KOKKOS_LAMBDA(int I) {
+          if constexpr (N == 2) {
+             f(I / NL, I % NL);
+          } else {
+             const int IJ = I / NL;
+             f(IJ / N1, IJ % N1, I % NL);
+          }
+       });
+#else
+   const int N0 = upper_bounds[0];
+
+   parallelForPolicy(
+       label, Kokkos::RangePolicy<ExecSpace>(ExecInstance::get(), 0, NTotal),
+       KOKKOS_LAMBDA(int I) {
+          if constexpr (N == 2) {
+             f(I % N0, I / N0);
+          } else {
+             const int JK = I / N0;
+             f(I % N0, JK % N1, JK / N1);
+          }
+       });
+#endif
+}
+
+template <int N, class F>
+inline void parallelForOuterInner(const std::string &label,
+                                  const int (&upper_bounds)[N], const F &f);
+
+// parallelForTuned: launches a labeled loop with the policy chosen by the
+// KernelTuner. While a kernel graph is captured the launch is not timed and
+// the tuned policy, or the default one, is recorded.
+template <int N, class F, class... Args>
+inline void parallelForTuned(const std::string &label,
+                             const int (&upper_bounds)[N], const F &f,
+                             bool AllowTeam) {
+   const bool Timed = !KernelGraph::isCapturing();
+   const KernelTuner::Choice Choice =
+       Timed ? KernelTuner::beginLaunch(label, N, AllowTeam)
+             : KernelTuner::getBest(label, N, AllowTeam);
+
+   if constexpr (N == 2 || N == 3) {
+      if (Choice.Policy == KernelTuner::PolicyKind::Flat) {
+         parallelForFlat(label, upper_bounds, f);
+      } else if (Choice.Policy == KernelTuner::PolicyKind::OuterInner) {
+         parallelForOuterInner(label, upper_bounds, f);
+      }
+   }
+   if (Choice.Policy == KernelTuner::PolicyKind::MDRange) {
+      countIterations(label, upper_bounds);
+      int tile[N];
+      setTunedTile(tile, Choice.TileLength);
+      const int lower_bounds[N] = {0};
+      const auto policy         = Bounds<N, Args...>(
+          ExecInstance::get(), lower_bounds, upper_bounds, tile);
+      parallelForPolicy(label, policy, f);
+   }
+
+   if (Timed) {
+      KernelTuner::endLaunch();
+   }
+}
+
+// parallelFor: with label. Multi-dimensional loops with the default tile are
+// launched with the tuned policy when the KernelTuner is enabled.
 template <int N, class F, class... Args>
 inline void parallelFor(const std::string &label, const int (&upper_bounds)[N],
                         const F &f,
                         const int (&tile)[N] = DefaultTile<N>::value) {
+   if constexpr (N > 1) {
+      if (KernelTuner::isEnabled() && !label.empty() &&
+          &tile[0] == &DefaultTile<N>::value[0]) {
+         parallelForTuned<N, F, Args...>(label, upper_bounds, f, false);
+         return;
+      }
+   }
+
+   countIterations(label, upper_bounds);
    if constexpr (N == 1) {
-      const auto policy = Kokkos::RangePolicy<Args...>(0, upper_bounds[0]);
-      Kokkos::parallel_for(label, policy, f);
+      const auto policy = Kokkos::RangePolicy<ExecSpace, Args...>(
+          ExecInstance::get(), 0, upper_bounds[0]);
+      parallelForPolicy(label, policy, f);
 
    } else {
       const int lower_bounds[N] = {0};
-      const auto policy = Bounds<N, Args...>(lower_bounds, upper_bounds, tile);
-      Kokkos::parallel_for(label, policy, f);
+      const auto policy         = Bounds<N, Args...>(
+          ExecInstance::get(), lower_bounds, upper_bounds, tile);
+      parallelForPolicy(label, policy, f);
    }
 }
 
@@ -84,19 +417,96 @@ inline void parallelFor(const int (&upper_bounds)[N], const F &f,
    parallelFor("", upper_bounds, f, tile);
 }
 
+// parallelFor: with label, launched on an instance of the execution space
+template <int N, class F>
+inline void parallelFor(const ExecSpace &space, const std::string &label,
+                        const int (&upper_bounds)[N], const F &f,
+                        const int (&tile)[N] = DefaultTile<N>::value) {
+   ExecInstance Scope(space);
+   parallelFor(label, upper_bounds, f, tile);
+}
+
+// parallelForOuterInner: hierarchical loop over a 2D or 3D index space. All
+// but the last index are combined into an outer index with one team per outer
+// element, and the last (inner) index is spread over the vector lanes of the
+// team. When the inner index runs over vertical levels or chunks, the
+// connectivity of a mesh element is then read once by all lanes of its team.
+template <int N, class F>
+inline void parallelForOuterInner(const std::string &label,
+                                  const int (&upper_bounds)[N], const F &f) {
+   static_assert(N == 2 || N == 3,
+                 "parallelForOuterInner requires a 2D or 3D index space");
+   countIterations(label, upper_bounds);
+
+   int NOuter = 1;
+   for (int I = 0; I < N - 1; ++I) {
+      NOuter *= upper_bounds[I];
+   }
+   const int NInner  = upper_bounds[N - 1];
+   const int NMiddle = upper_bounds[N - 2];
+
+   // Use the smallest power of two covering the inner range, up to the
+   // maximum vector length of the execution space
+   const int MaxLanes = TeamPolicy::vector_length_max();
+   int NLanes         = 1;
+   while (NLanes < NInner && NLanes < MaxLanes) {
+      NLanes *= 2;
+   }
+
+   parallelForPolicy(
+       label, TeamPolicy(ExecInstance::get(), NOuter, 1, NLanes),
+       KOKKOS_LAMBDA(const TeamMember &Member) {
+          const int IOuter = Member.league_rank();
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(Member, NInner),
+                               [&](int IInner) {
+                                  if constexpr (N == 2) {
+                                     f(IOuter, IInner);
+                                  } else {
+                                     f(IOuter / NMiddle, IOuter % NMiddle,
+                                       IInner);
+                                  }
+                               });
+       });
+}
+
+// parallelForChunks: loop over mesh elements and vertical chunks with either
+// the flat MDRange policy of parallelFor or the hierarchical policy of
+// parallelForOuterInner. Unless OuterInner is set, the KernelTuner can choose
+// between all policies, including the hierarchical one.
+template <int N, class F>
+inline void parallelForChunks(const std::string &label,
+                              const int (&upper_bounds)[N], const F &f,
+                              bool OuterInner) {
+   if (OuterInner) {
+      parallelForOuterInner(label, upper_bounds, f);
+   } else if (KernelTuner::isEnabled() && !label.empty()) {
+      parallelForTuned(label, upper_bounds, f, true);
+   } else {
+      parallelFor(label, upper_bounds, f);
+   }
+}
+
 // parallelReduce: with label
 template <int N, class F, class R, class... Args>
 inline void parallelReduce(const std::string &label,
                            const int (&upper_bounds)[N], const F &f,
                            R &&reducer,
                            const int (&tile)[N] = DefaultTile<N>::value) {
+   // Reductions return their result to the host and cannot be recorded
+   if (KernelGraph::isCapturing()) {
+      KernelGraph::addUnsupported();
+      return;
+   }
+
    if constexpr (N == 1) {
-      const auto policy = Kokkos::RangePolicy<Args...>(0, upper_bounds[0]);
+      const auto policy = Kokkos::RangePolicy<ExecSpace, Args...>(
+          ExecInstance::get(), 0, upper_bounds[0]);
       Kokkos::parallel_reduce(label, policy, f, std::forward<R>(reducer));
 
    } else {
       const int lower_bounds[N] = {0};
-      const auto policy = Bounds<N, Args...>(lower_bounds, upper_bounds, tile);
+      const auto policy         = Bounds<N, Args...>(
+          ExecInstance::get(), lower_bounds, upper_bounds, tile);
       Kokkos::parallel_reduce(label, policy, f, std::forward<R>(reducer));
    }
 }
@@ -109,6 +519,62 @@ inline void parallelReduce(const int (&upper_bounds)[N], const F &f,
    parallelReduce("", upper_bounds, f, std::forward<R>(reducer), tile);
 }
 
+// createFirstTouchArray: allocates an array of the given extents with all
+// entries set to zero. Kokkos zeroes a new allocation with a memset on the
+// host, so on threaded CPU builds all pages of an array would be placed in
+// the memory of the NUMA domain of the thread that allocates it. Instead, the
+// array is allocated without initialization and zeroed with the parallelFor
+// decomposition of the compute kernels, so each page is first touched by the
+// thread that later works on it. Arrays that are not accessible from the
+// default execution space (host arrays in GPU builds) are allocated as usual.
+template <typename V, typename... Extents>
+V createFirstTouchArray(const std::string &Label, const Extents... Dims) {
+   static_assert(V::rank == sizeof...(Extents),
+                 "createFirstTouchArray requires one extent per dimension");
+
+   using SpaceAccess =
+       Kokkos::SpaceAccessibility<ExecSpace, typename V::memory_space>;
+
+   if constexpr (!SpaceAccess::accessible) {
+      return V(Label, Dims...);
+   } else {
+      using T = typename V::non_const_value_type;
+
+      V Array(Kokkos::view_alloc(Kokkos::WithoutInitializing, Label),
+              Dims...);
+      const int N[] = {static_cast<int>(Dims)...};
+
+      if constexpr (V::rank == 1) {
+         parallelFor(
+             {N[0]}, KOKKOS_LAMBDA(int I) { Array(I) = T(0); });
+      } else if constexpr (V::rank == 2) {
+         parallelFor(
+             {N[0], N[1]}, KOKKOS_LAMBDA(int I, int J) { Array(I, J) = T(0); });
+      } else if constexpr (V::rank == 3) {
+         parallelFor(
+             {N[0], N[1], N[2]},
+             KOKKOS_LAMBDA(int I, int J, int K) { Array(I, J, K) = T(0); });
+      } else if constexpr (V::rank == 4) {
+         parallelFor(
+             {N[0], N[1], N[2], N[3]},
+             KOKKOS_LAMBDA(int I, int J, int K, int L) {
+                Array(I, J, K, L) = T(0);
+             });
+      } else {
+         static_assert(V::rank == 5,
+                       "createFirstTouchArray supports ranks 1 to 5");
+         parallelFor(
+             {N[0], N[1], N[2], N[3], N[4]},
+             KOKKOS_LAMBDA(int I, int J, int K, int L, int M) {
+                Array(I, J, K, L, M) = T(0);
+             });
+      }
+      Kokkos::fence();
+
+      return Array;
+   }
+}
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
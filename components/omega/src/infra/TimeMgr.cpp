@@ -549,6 +549,10 @@ TimeFrac::~TimeFrac(void) { // No operation - nothing to clean up
 bool TimeFrac::operator==(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // on a common denominator, the components can be compared directly
+   if (Denom == Time.Denom && isNormalized() && Time.isNormalized())
+      return Whole == Time.Whole && Numer == Time.Numer;
+
    // make local copies; don't change the originals.
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
@@ -573,6 +577,10 @@ bool TimeFrac::operator==(
 bool TimeFrac::operator!=(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // on a common denominator, the components can be compared directly
+   if (Denom == Time.Denom && isNormalized() && Time.isNormalized())
+      return Whole != Time.Whole || Numer != Time.Numer;
+
    // make local copies; don't change the originals.
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
@@ -597,6 +605,10 @@ bool TimeFrac::operator!=(
 bool TimeFrac::operator<(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // on a common denominator, the components can be compared directly
+   if (Denom == Time.Denom && isNormalized() && Time.isNormalized())
+      return Whole < Time.Whole || (Whole == Time.Whole && Numer < Time.Numer);
+
    // make local copies; don't change the originals.
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
@@ -626,6 +638,10 @@ bool TimeFrac::operator<(
 bool TimeFrac::operator>(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // on a common denominator, the components can be compared directly
+   if (Denom == Time.Denom && isNormalized() && Time.isNormalized())
+      return Whole > Time.Whole || (Whole == Time.Whole && Numer > Time.Numer);
+
    // make local copies so we do not change the originals.
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
@@ -657,6 +673,10 @@ bool TimeFrac::operator>(
 bool TimeFrac::operator<=(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // on a common denominator, the components can be compared directly
+   if (Denom == Time.Denom && isNormalized() && Time.isNormalized())
+      return Whole < Time.Whole || (Whole == Time.Whole && Numer <= Time.Numer);
+
    // reuse < and == operators defined above
    return *this < Time || *this == Time;
 
@@ -669,6 +689,10 @@ bool TimeFrac::operator<=(
 bool TimeFrac::operator>=(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
+   // on a common denominator, the components can be compared directly
+   if (Denom == Time.Denom && isNormalized() && Time.isNormalized())
+      return Whole > Time.Whole || (Whole == Time.Whole && Numer >= Time.Numer);
+
    // reuse > and == operators defined above
    return *this > Time || *this == Time;
 
@@ -689,6 +713,19 @@ TimeFrac::operator+(const TimeFrac &Time) const { // [in] TimeFrac to add
 
    TimeFrac Sum;
 
+   // on a common denominator, only a fractional sum that does not cancel
+   // needs to be simplified
+   if (Denom == Time.Denom) {
+      Sum.Whole = Whole + Time.Whole;
+      Sum.Numer = Numer + Time.Numer;
+      Sum.Denom = Denom;
+      if (Sum.Numer == 0)
+         Sum.Denom = 1;
+      else
+         Sum.simplify();
+      return Sum;
+   }
+
    // fractional part addition
    Sum.Denom = TimeFracLCM(Denom, Time.Denom);
    Sum.Numer =
@@ -719,6 +756,19 @@ TimeFrac::operator-(const TimeFrac &Time) const { // [in] TimeFrac to subtract
 
    TimeFrac Diff;
 
+   // on a common denominator, only a fractional difference that does not
+   // cancel needs to be simplified
+   if (Denom == Time.Denom) {
+      Diff.Whole = Whole - Time.Whole;
+      Diff.Numer = Numer - Time.Numer;
+      Diff.Denom = Denom;
+      if (Diff.Numer == 0)
+         Diff.Denom = 1;
+      else
+         Diff.simplify();
+      return Diff;
+   }
+
    // fractional part subtraction
    // must convert to same denominator
    Diff.Denom = TimeFracLCM(Denom, Time.Denom);
@@ -770,6 +820,12 @@ TimeFrac::operator*(const I4 Multiplier) const { // [in] integer multiplier
 
    TimeFrac Product;
 
+   // whole seconds stay whole seconds
+   if (Numer == 0) {
+      Product.Whole = Whole * Multiplier;
+      return Product;
+   }
+
    // fractional part multiplication.
    Product.Numer = Numer * Multiplier;
    Product.Denom = Denom;
@@ -805,6 +861,10 @@ TimeFrac::operator*(const R8 Multiplier) const { // [in] real multiplier
 
    TimeFrac Product; // initialized to zero
 
+   // an integer multiplier does not need the conversion to a fraction
+   if (Multiplier == std::trunc(Multiplier) && fabs(Multiplier) <= INT_MAX)
+      return *this * static_cast<I4>(Multiplier);
+
    // convert real scalar to a base time using conversion in setSeconds
    TimeFrac Mult;
    Mult.setSeconds(Multiplier);
@@ -849,6 +909,12 @@ TimeFrac TimeFrac::operator/(I4 Divisor) const { // [in] integer divisor
    I8 Remainder;
    I8 Denominator;
 
+   // whole seconds that divide evenly stay whole seconds
+   if (Numer == 0 && Whole % Divisor == 0) {
+      Quotient.Whole = Whole / Divisor;
+      return Quotient;
+   }
+
    // Fractional part division. To avoid overflows/underflows with large
    // denominators, we do not just blindly multiply denominator.
    // Instead, divide numerator and add back any remainder.
@@ -4102,6 +4168,12 @@ bool Alarm::isRinging(void) { return Ringing; }
 
 // end TimeInstant::isRinging
 
+//------------------------------------------------------------------------------
+// Alarm::isStopped - Check whether an alarm has been stopped
+// Returns true if the alarm has been stopped and can no longer ring.
+
+bool Alarm::isStopped(void) const { return Stopped; }
+
 //------------------------------------------------------------------------------
 // Alarm::updateStatus - Changes the alarm status based on current time
 // Checks whether the alarm should ring based on the current (or supplied)
@@ -4195,6 +4267,12 @@ I4 Alarm::rename(const std::string NewName ///< [in] new name for alarm
 
 std::string Alarm::getName() const { return Name; }
 
+//------------------------------------------------------------------------------
+// Alarm::getRingTime - retrieves the next ring time of an alarm
+// Returns the time at or after which the alarm next rings.
+
+TimeInstant Alarm::getRingTime() const { return RingTime; }
+
 //------------------------------------------------------------------------------
 // Clock definitions
 //------------------------------------------------------------------------------
@@ -4341,6 +4419,14 @@ I4 Clock::attachAlarm(Alarm *InAlarm // [in] pointer to alarm to attach
    // Now add the pointer to the next available slot in the array
    Alarms[NumAlarms - 1] = InAlarm;
 
+   // Add the alarm to the schedule, or to the ringing list if it is
+   // already ringing
+   if (InAlarm->isRinging()) {
+      RingingAlarms.push_back(InAlarm);
+   } else if (!InAlarm->isStopped()) {
+      AlarmQueue.push(AlarmEvent(InAlarm->getRingTime(), InAlarm));
+   }
+
    return Err;
 
 } // end Clock::attachAlarm
@@ -4362,20 +4448,82 @@ I4 Clock::advance(void) {
    // Advance next time
    NextTime += TimeStep;
 
-   // Update status of all attached alarms
-   I4 Err1{0};
-   for (I4 N = 0; N < NumAlarms; ++N) {
-      Err1 = Alarms[N]->updateStatus(CurrTime);
+   // Update status of the attached alarms that are due
+   Err = updateAlarms();
+   if (Err != 0)
+      LOG_ERROR("TimeMgr: Clock::advance error updating alarms");
+
+   return Err;
+
+} // end Clock::advance
+
+//------------------------------------------------------------------------------
+// Clock::updateAlarms - Updates the schedule and status of attached alarms
+// Alarms in the ringing list that have since been reset are returned to the
+// schedule with their new ring time and stopped alarms are dropped. Then the
+// alarms at the top of the schedule with a ring time at or before the current
+// time are rung. An alarm whose ring time has changed since it was scheduled
+// is scheduled again with its new ring time instead.
+
+I4 Clock::updateAlarms(void) {
+
+   I4 Err{0};
+
+   // Return alarms that are no longer ringing to the schedule
+   I4 NRinging = 0;
+   for (Alarm *ThisAlarm : RingingAlarms) {
+      if (ThisAlarm->isRinging()) {
+         RingingAlarms[NRinging] = ThisAlarm;
+         ++NRinging;
+      } else if (!ThisAlarm->isStopped()) {
+         AlarmQueue.push(AlarmEvent(ThisAlarm->getRingTime(), ThisAlarm));
+      }
+   }
+   RingingAlarms.resize(NRinging);
+
+   // Ring all scheduled alarms that are due
+   while (!AlarmQueue.empty() and AlarmQueue.top().first <= CurrTime) {
+
+      Alarm *ThisAlarm      = AlarmQueue.top().second;
+      TimeInstant SchedTime = AlarmQueue.top().first;
+      AlarmQueue.pop();
+
+      if (ThisAlarm->isStopped())
+         continue;
+
+      // The alarm was reset before it rang, schedule its new ring time
+      if (!(ThisAlarm->getRingTime() == SchedTime)) {
+         AlarmQueue.push(AlarmEvent(ThisAlarm->getRingTime(), ThisAlarm));
+         continue;
+      }
+
+      I4 Err1 = ThisAlarm->updateStatus(CurrTime);
       if (Err1 != 0) {
          ++Err;
-         LOG_ERROR("TimeMgr: Clock::advance error updating alarm # {}", N);
+         LOG_ERROR("TimeMgr: Clock::updateAlarms error updating alarm {}",
+                   ThisAlarm->getName());
          break;
       }
+      RingingAlarms.push_back(ThisAlarm);
    }
 
    return Err;
 
-} // end Clock::advance
+} // end Clock::updateAlarms
+
+//------------------------------------------------------------------------------
+// Clock::getRingingAlarms - Retrieves the alarms that are ringing
+// Returns the list of attached alarms that were ringing at the last advance.
+
+const std::vector<Alarm *> &Clock::getRingingAlarms(void) const {
+   return RingingAlarms;
+}
+
+//------------------------------------------------------------------------------
+// Clock::hasRingingAlarms - Checks whether any attached alarm is ringing
+// Returns true if any attached alarm was ringing at the last advance.
+
+bool Clock::hasRingingAlarms(void) const { return !RingingAlarms.empty(); }
 
 } // namespace OMEGA
 //===-----------------------------------------------------------------------===/
@@ -35,7 +35,10 @@
 
 #include "DataTypes.h"
 
+#include <queue>
 #include <string>
+#include <utility>
+#include <vector>
 
 // Definitions of conversions
 /// Define seconds per day
@@ -102,6 +105,11 @@ const std::string CalendarKindName[NUM_SUPPORTED_CALENDARS] = {
 /// For ease in calendar conversions, a time value of zero (both whole
 /// and numerator) will correspond to the Julian date of zero.
 ///
+/// Time steps are usually a whole number of seconds or a fixed fraction, so
+/// the operands of most operations share a denominator. Comparisons of such
+/// operands only compare the components and sums, differences and integer
+/// products of whole seconds return without computing a GCD or LCM.
+///
 class TimeFrac {
    // private variables
  private:
@@ -109,6 +117,15 @@ class TimeFrac {
    I8 Numer; ///< Integer fractional second (n/d) numerator
    I8 Denom; ///< Integer fractional second (n/d) denominator
 
+   /// Returns true if the fraction is normalized, with a positive
+   /// denominator, a numerator smaller than the denominator in magnitude
+   /// and whole and numerator of the same sign. Two normalized fractions on
+   /// the same denominator compare in the order of their components.
+   bool isNormalized() const {
+      return Denom >= 1 && Numer < Denom && -Numer < Denom &&
+             !(Whole > 0 && Numer < 0) && !(Whole < 0 && Numer > 0);
+   }
+
  public:
    // Accessor methods
 
@@ -775,6 +792,10 @@ class Alarm {
    /// \return true if alarm is ringing, false otherwise
    bool isRinging(void);
 
+   /// Check whether an alarm has been stopped
+   /// \return true if alarm is stopped, false otherwise
+   bool isStopped(void) const;
+
    /// Checks whether the alarm should ring based on the current
    /// (or supplied) time instant (returns error code)
    I4 updateStatus(const TimeInstant CurrentTime ///< [in] current time
@@ -798,6 +819,9 @@ class Alarm {
    /// Get alarm name
    std::string getName(void) const;
 
+   /// Get the time at/after which the alarm next rings
+   TimeInstant getRingTime(void) const;
+
    I4 print(void) const;
 
 }; // end class Alarm
@@ -825,6 +849,28 @@ class Clock {
    std::vector<Alarm *>
        Alarms; ///< pointers to alarms associated with this clock
 
+   /// Entry of the alarm schedule: the ring time at which the alarm was
+   /// scheduled and a pointer to the alarm
+   using AlarmEvent = std::pair<TimeInstant, Alarm *>;
+
+   /// Orders alarm events so that the earliest ring time is at the top
+   struct LaterEvent {
+      bool operator()(const AlarmEvent &A, const AlarmEvent &B) const {
+         return A.first > B.first;
+      }
+   };
+
+   /// Attached alarms that are not ringing, ordered by next ring time
+   std::priority_queue<AlarmEvent, std::vector<AlarmEvent>, LaterEvent>
+       AlarmQueue;
+
+   /// Attached alarms that are currently ringing
+   std::vector<Alarm *> RingingAlarms;
+
+   /// Returns alarms that have been reset to the schedule and rings any
+   /// scheduled alarms that are due at the current time (returns error code)
+   I4 updateAlarms(void);
+
  public:
    // constructors/destructors
 
@@ -871,6 +917,14 @@ class Clock {
    /// alarms. (returns error code)
    I4 advance(void);
 
+   /// Returns the attached alarms that were ringing at the last advance.
+   /// Alarms that have been stopped or reset since then are removed from
+   /// this list at the next advance.
+   const std::vector<Alarm *> &getRingingAlarms(void) const;
+
+   /// Returns true if any attached alarm was ringing at the last advance
+   bool hasRingingAlarms(void) const;
+
 }; // end class Clock
 
 } // namespace OMEGA
@@ -0,0 +1,406 @@
+//===-- infra/Timer.cpp - Omega timers --------------------------*- C++ -*-===//
+//
+// Implementation of the hierarchical timers used to measure the time spent in
+// named regions of Omega. Each region accumulates the wall-clock time between
+// calls to start and stop. Nested regions are identified by the colon-separated
+// path of all enclosing regions. At the end of a run, print reduces the
+// times across tasks and writes a summary table to the log. With
+// OMEGA_USE_GPTL, the regions are forwarded to GPTL, which is initialized and
+// finalized here in standalone builds (OMEGA_GPTL_INIT) and by the E3SM
+// driver otherwise.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Timer.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "mpi.h"
+
+#ifdef OMEGA_USE_GPTL
+#include "gptl.h"
+#endif
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+// Create static class members
+bool Timer::Enabled     = true;
+bool Timer::FenceDevice = false;
+std::map<std::string, Timer::TimerData> Timer::AllTimers;
+std::vector<std::string> Timer::TimerOrder;
+std::vector<std::string> Timer::ActiveTimers;
+
+#ifdef OMEGA_GPTL_INIT
+// True between the GPTL initialization in init and its finalization
+static bool GptlInitialized = false;
+#endif
+
+//------------------------------------------------------------------------------
+// Initialize the timers from the optional Timers config group
+
+int Timer::init() {
+
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("Timers")) {
+      Config TimersConfig("Timers");
+      Err = OmegaConfig->get(TimersConfig);
+      if (Err != 0) {
+         LOG_ERROR("Timer: error reading Timers group from Config");
+         return Err;
+      }
+      if (TimersConfig.existsVar("Enabled")) {
+         Err = TimersConfig.get("Enabled", Enabled);
+         if (Err != 0) {
+            LOG_ERROR("Timer: error reading Enabled from Timers Config");
+            return Err;
+         }
+      }
+      if (TimersConfig.existsVar("FenceDevice")) {
+         Err = TimersConfig.get("FenceDevice", FenceDevice);
+         if (Err != 0) {
+            LOG_ERROR("Timer: error reading FenceDevice from Timers Config");
+            return Err;
+         }
+      }
+   }
+
+#ifdef OMEGA_GPTL_INIT
+   if (Enabled and not GptlInitialized) {
+      Err = GPTLinitialize();
+      if (Err != 0) {
+         LOG_ERROR("Timer: error initializing GPTL");
+         return Err;
+      }
+      GptlInitialized = true;
+   }
+#endif
+
+   return Err;
+
+} // end Timer init
+
+//------------------------------------------------------------------------------
+// Start a region as a child of the currently active region. The region is
+// created the first time it is started.
+
+int Timer::start(const std::string &Name // [in] name of region
+) {
+
+   if (not Enabled)
+      return 0;
+
+   std::string Path =
+       ActiveTimers.empty() ? Name : ActiveTimers.back() + ":" + Name;
+
+   auto [Iter, New] = AllTimers.try_emplace(Path);
+   TimerData &Data  = Iter->second;
+   if (New) {
+      Data.Depth = ActiveTimers.size();
+      TimerOrder.push_back(Path);
+   }
+
+   if (Data.Running) {
+      LOG_ERROR("Timer: attempt to start timer {} which is already running",
+                Path);
+      return -1;
+   }
+
+   if (FenceDevice)
+      Kokkos::fence();
+
+   Data.Running   = true;
+   Data.StartTime = MPI_Wtime();
+   ActiveTimers.push_back(Path);
+
+#ifdef OMEGA_USE_GPTL
+   GPTLstart(Name.c_str());
+#endif
+
+   return 0;
+
+} // end Timer start
+
+//------------------------------------------------------------------------------
+// Stop a region, which must be the innermost active region
+
+int Timer::stop(const std::string &Name // [in] name of region
+) {
+
+   if (not Enabled)
+      return 0;
+
+   if (ActiveTimers.empty()) {
+      LOG_ERROR("Timer: attempt to stop timer {} but no timer is running",
+                Name);
+      return -1;
+   }
+
+   // The innermost path must be the input name or end with ":Name"
+   const std::string &Path  = ActiveTimers.back();
+   const std::string Suffix = ":" + Name;
+
+   bool Match = Path == Name or
+                (Path.size() > Suffix.size() and
+                 Path.compare(Path.size() - Suffix.size(), Suffix.size(),
+                              Suffix) == 0);
+   if (not Match) {
+      LOG_ERROR("Timer: attempt to stop timer {} but innermost running timer "
+                "is {}",
+                Name, Path);
+      return -1;
+   }
+
+   if (FenceDevice)
+      Kokkos::fence();
+
+#ifdef OMEGA_USE_GPTL
+   GPTLstop(Name.c_str());
+#endif
+
+   TimerData &Data = AllTimers[Path];
+   Data.TotalTime += MPI_Wtime() - Data.StartTime;
+   Data.Running = false;
+   ++Data.Count;
+   ActiveTimers.pop_back();
+
+   return 0;
+
+} // end Timer stop
+
+//------------------------------------------------------------------------------
+// Retrieve accumulated local time and count of a region
+
+R8 Timer::getTime(const std::string &Path // [in] path of region
+) {
+   auto Iter = AllTimers.find(Path);
+   return Iter != AllTimers.end() ? Iter->second.TotalTime : 0;
+}
+
+R8 Timer::getNestedTime(const std::string &Path, // [in] path of parent
+                        const std::string &Name  // [in] name of regions
+) {
+
+   const std::string Prefix = Path + ":";
+   const std::string Suffix = ":" + Name;
+   const std::string Inner  = Suffix + ":";
+   R8 Time                  = 0;
+   for (const auto &[RegionPath, Data] : AllTimers) {
+      if (RegionPath.compare(0, Prefix.size(), Prefix) != 0)
+         continue;
+      // The path below the parent must end with the name and must not
+      // contain it as an enclosing region
+      const std::string Rest = ":" + RegionPath.substr(Prefix.size());
+      if (Rest.size() >= Suffix.size() and
+          Rest.compare(Rest.size() - Suffix.size(), Suffix.size(), Suffix) ==
+              0 and
+          Rest.find(Inner) == std::string::npos)
+         Time += Data.TotalTime;
+   }
+   return Time;
+}
+
+I8 Timer::getCount(const std::string &Path // [in] path of region
+) {
+   auto Iter = AllTimers.find(Path);
+   return Iter != AllTimers.end() ? Iter->second.Count : 0;
+}
+
+//------------------------------------------------------------------------------
+// Reduce timing data across tasks. The list of regions is broadcast from the
+// master task, tasks that did not enter a region contribute a zero time to its
+// statistics.
+
+int Timer::reduce(const MachEnv *Env,             // [in] environment
+                  std::vector<std::string> &Paths, // [out] region paths
+                  std::vector<I8> &Counts,         // [out] call counts
+                  std::vector<R8> &MinTimes,       // [out] minimum times
+                  std::vector<R8> &MaxTimes,       // [out] maximum times
+                  std::vector<R8> &MeanTimes       // [out] mean times
+) {
+
+   int Err = 0;
+
+   MPI_Comm Comm   = Env->getComm();
+   int MasterTask  = Env->getMasterTask();
+   int NumTasks    = Env->getNumTasks();
+   bool MasterFlag = Env->isMasterTask();
+
+   // Broadcast the region paths of the master task as a newline-separated
+   // string
+   std::string AllPaths;
+   if (MasterFlag) {
+      for (const auto &Path : TimerOrder) {
+         AllPaths += Path + "\n";
+      }
+   }
+   int PathsLength = AllPaths.size();
+   Err = MPI_Bcast(&PathsLength, 1, MPI_INT, MasterTask, Comm);
+   AllPaths.resize(PathsLength);
+   Err += MPI_Bcast(AllPaths.data(), PathsLength, MPI_CHAR, MasterTask, Comm);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("Timer: error broadcasting timer names");
+      return -1;
+   }
+
+   Paths.clear();
+   std::istringstream PathStream(AllPaths);
+   std::string Path;
+   while (std::getline(PathStream, Path)) {
+      Paths.push_back(Path);
+   }
+
+   // Reduce the local times of each region
+   int NTimers = Paths.size();
+   std::vector<R8> LocTimes(NTimers, 0);
+   Counts.assign(NTimers, 0);
+   for (int I = 0; I < NTimers; ++I) {
+      LocTimes[I] = getTime(Paths[I]);
+      Counts[I]   = getCount(Paths[I]);
+   }
+   MinTimes.assign(NTimers, 0);
+   MaxTimes.assign(NTimers, 0);
+   MeanTimes.assign(NTimers, 0);
+   Err = MPI_Reduce(LocTimes.data(), MinTimes.data(), NTimers, MPI_DOUBLE,
+                    MPI_MIN, MasterTask, Comm);
+   Err += MPI_Reduce(LocTimes.data(), MaxTimes.data(), NTimers, MPI_DOUBLE,
+                     MPI_MAX, MasterTask, Comm);
+   Err += MPI_Reduce(LocTimes.data(), MeanTimes.data(), NTimers, MPI_DOUBLE,
+                     MPI_SUM, MasterTask, Comm);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("Timer: error reducing timer data");
+      return -1;
+   }
+   for (int I = 0; I < NTimers; ++I) {
+      MeanTimes[I] /= NumTasks;
+   }
+
+   return 0;
+
+} // end Timer reduce
+
+//------------------------------------------------------------------------------
+// Write a summary of the times reduced across tasks to the log
+
+int Timer::print(const MachEnv *Env // [in] environment to reduce over
+) {
+
+   int Err = 0;
+
+   if (not Enabled)
+      return Err;
+
+   std::vector<std::string> Paths;
+   std::vector<I8> Counts;
+   std::vector<R8> MinTimes;
+   std::vector<R8> MaxTimes;
+   std::vector<R8> MeanTimes;
+   Err = reduce(Env, Paths, Counts, MinTimes, MaxTimes, MeanTimes);
+   if (Err != 0)
+      return Err;
+
+   // Write the summary table, indenting each region by its nesting depth
+   if (Env->isMasterTask()) {
+      LOG_INFO("Timer summary over {} tasks (times in seconds)",
+               Env->getNumTasks());
+      LOG_INFO("{:<40} {:>10} {:>12} {:>12} {:>12}", "Region", "Calls", "Min",
+               "Max", "Mean");
+      for (int I = 0; I < Paths.size(); ++I) {
+         const TimerData &Data = AllTimers[Paths[I]];
+
+         std::string::size_type NameStart = Paths[I].rfind(':');
+
+         std::string Name  = NameStart == std::string::npos
+                                 ? Paths[I]
+                                 : Paths[I].substr(NameStart + 1);
+         std::string Label = std::string(2 * Data.Depth, ' ') + Name;
+         LOG_INFO("{:<40} {:>10} {:>12.4f} {:>12.4f} {:>12.4f}", Label,
+                  Counts[I], MinTimes[I], MaxTimes[I], MeanTimes[I]);
+      }
+   }
+
+   return 0;
+
+} // end Timer print
+
+//------------------------------------------------------------------------------
+// Stop all running regions, write the summary and remove all timing data
+
+int Timer::finalize(const MachEnv *Env // [in] environment to reduce over
+) {
+
+   if (not Enabled) {
+      clear();
+      return 0;
+   }
+
+   while (not ActiveTimers.empty()) {
+      const std::string &Path = ActiveTimers.back();
+      stop(Path.substr(Path.rfind(':') + 1));
+   }
+
+   int Err = print(Env);
+   clear();
+
+#ifdef OMEGA_GPTL_INIT
+   // Write the GPTL summary across tasks, and the per-task memory usage
+   if (GptlInitialized) {
+      GPTLprint_memusage("Omega finalize");
+      if (GPTLpr_summary_file(Env->getComm(), "omega_timing.summary") != 0) {
+         LOG_ERROR("Timer: error writing GPTL summary");
+         Err = -1;
+      }
+      GPTLfinalize();
+      GptlInitialized = false;
+   }
+#endif
+
+   return Err;
+
+} // end Timer finalize
+
+//------------------------------------------------------------------------------
+// Remove all timing data
+
+void Timer::clear() {
+   AllTimers.clear();
+   TimerOrder.clear();
+   ActiveTimers.clear();
+}
+
+//------------------------------------------------------------------------------
+// Set and query the timer options
+
+void Timer::setEnabled(bool InEnabled // [in] new setting
+) {
+   Enabled = InEnabled;
+}
+
+bool Timer::isEnabled() { return Enabled; }
+
+void Timer::setFenceDevice(bool InFenceDevice // [in] new setting
+) {
+   FenceDevice = InFenceDevice;
+}
+
+bool Timer::isFenceDevice() { return FenceDevice; }
+
+//------------------------------------------------------------------------------
+// Start and stop a region with the lifetime of a TimerRegion
+
+TimerRegion::TimerRegion(const std::string &InName) : Name(InName) {
+   Timer::start(Name);
+}
+
+TimerRegion::~TimerRegion() { Timer::stop(Name); }
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,160 @@
+#ifndef OMEGA_TIMER_H
+#define OMEGA_TIMER_H
+//===-- infra/Timer.h - Omega timers ---------------------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines hierarchical timers for performance measurement
+///
+/// The Timer class accumulates the wall-clock time spent in named regions of
+/// the code. Regions can be nested: a region started while another region is
+/// active is recorded as a child of that region and identified by its path,
+/// the names of all enclosing regions separated by colons (eg
+/// ocnRun:TimeStepper:Tendencies). Because GPU kernels are launched
+/// asynchronously, the device can optionally be fenced at the start and end
+/// of every region so that the time of the kernels launched in a region is
+/// attributed to that region. At the end of a run, the accumulated times are
+/// reduced across all tasks and a summary of the minimum, maximum and mean
+/// time of each region is written to the log. A TimerRegion object can be
+/// used to time a scope, starting the timer on construction and stopping it
+/// when the object goes out of scope. When Omega is built with GPTL, every
+/// region is also started and stopped in GPTL, so the Omega regions appear
+/// in the E3SM timing summaries.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "MachEnv.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// The Timer class is a static class that manages all timer regions
+class Timer {
+
+ private:
+   /// Accumulated timing data for each region
+   struct TimerData {
+      R8 TotalTime{0};     ///< accumulated time in seconds
+      R8 StartTime{0};     ///< time the region was last started
+      I8 Count{0};         ///< number of times the region was stopped
+      I4 Depth{0};         ///< nesting depth of the region
+      bool Running{false}; ///< true if the region is currently active
+   };
+
+   /// Flag to enable or disable all timers
+   static bool Enabled;
+
+   /// Flag to fence the device at the start and end of each region
+   static bool FenceDevice;
+
+   /// Timing data for all regions, indexed by region path
+   static std::map<std::string, TimerData> AllTimers;
+
+   /// Region paths in the order they were first started, used to print the
+   /// summary in calling order
+   static std::vector<std::string> TimerOrder;
+
+   /// Paths of the currently active regions, innermost last
+   static std::vector<std::string> ActiveTimers;
+
+ public:
+   /// Initializes the timers from the optional Timers group of the Omega
+   /// Config, which can contain the Enabled and FenceDevice flags
+   static int init();
+
+   /// Starts the region with the input name as a child of the currently
+   /// active region
+   static int start(const std::string &Name ///< [in] name of region
+   );
+
+   /// Stops the region with the input name, which must be the most recently
+   /// started active region
+   static int stop(const std::string &Name ///< [in] name of region
+   );
+
+   /// Returns the accumulated local time in seconds of the region with the
+   /// input path, or zero if the region does not exist
+   static R8 getTime(const std::string &Path ///< [in] path of region
+   );
+
+   /// Returns the accumulated local time in seconds of all regions with the
+   /// input name nested at any depth within the region with the input path,
+   /// without counting regions nested within another region of that name
+   static R8 getNestedTime(const std::string &Path, ///< [in] path of parent
+                           const std::string &Name  ///< [in] name of regions
+   );
+
+   /// Returns the number of times the region with the input path has been
+   /// stopped, or zero if the region does not exist
+   static I8 getCount(const std::string &Path ///< [in] path of region
+   );
+
+   /// Reduces the accumulated times of the regions of the master task across
+   /// the tasks of the input environment. On the master task, the outputs
+   /// hold the path, local call count and the minimum, maximum and mean time
+   /// of each region in calling order.
+   static int reduce(const MachEnv *Env,             ///< [in] environment
+                     std::vector<std::string> &Paths, ///< [out] region paths
+                     std::vector<I8> &Counts,         ///< [out] call counts
+                     std::vector<R8> &MinTimes,       ///< [out] minimum times
+                     std::vector<R8> &MaxTimes,       ///< [out] maximum times
+                     std::vector<R8> &MeanTimes       ///< [out] mean times
+   );
+
+   /// Reduces the accumulated times across the tasks of the input
+   /// environment with reduce and writes a summary table with the call
+   /// count and the minimum, maximum and mean time of each region to the
+   /// log. The regions of the master task are reported.
+   static int print(const MachEnv *Env = MachEnv::getDefault());
+
+   /// Stops any running regions, writes the summary with print and removes
+   /// all timing data
+   static int finalize(const MachEnv *Env = MachEnv::getDefault());
+
+   /// Removes all timing data
+   static void clear();
+
+   /// Enables or disables all timers
+   static void setEnabled(bool InEnabled ///< [in] new setting
+   );
+
+   /// Returns true if the timers are enabled
+   static bool isEnabled();
+
+   /// Enables or disables device fencing at region boundaries
+   static void setFenceDevice(bool InFenceDevice ///< [in] new setting
+   );
+
+   /// Returns true if the device is fenced at region boundaries
+   static bool isFenceDevice();
+
+}; // end class Timer
+
+/// Times the enclosing scope, starting the named region on construction and
+/// stopping it on destruction
+class TimerRegion {
+
+ private:
+   std::string Name; ///< name of the timed region
+
+ public:
+   /// Starts the named region
+   explicit TimerRegion(const std::string &InName ///< [in] name of region
+   );
+
+   /// Stops the region
+   ~TimerRegion();
+
+   // forbid copy and move construction
+   TimerRegion(const TimerRegion &) = delete;
+   TimerRegion(TimerRegion &&)      = delete;
+
+}; // end class TimerRegion
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_TIMER_H
@@ -1,7 +1,12 @@
 #include "AuxiliaryState.h"
 #include "Config.h"
 #include "Field.h"
+#include "KernelCounters.h"
+#include "KernelScheduler.h"
 #include "Logging.h"
+#include "Timer.h"
+
+#include <algorithm>
 
 namespace OMEGA {
 
@@ -17,7 +22,8 @@ AuxiliaryState::AuxiliaryState(const std::string &Name, const HorzMesh *Mesh,
     : Mesh(Mesh), Name(Name), KineticAux(Name, Mesh, NVertLevels),
       LayerThicknessAux(Name, Mesh, NVertLevels),
       VorticityAux(Name, Mesh, NVertLevels),
-      VelocityDel2Aux(Name, Mesh, NVertLevels) {
+      VelocityDel2Aux(Name, Mesh, NVertLevels),
+      TracerAux(Name, Mesh, NVertLevels, 0) {
 
    GroupName = "AuxiliaryState";
    if (Name != "Default") {
@@ -31,6 +37,8 @@ AuxiliaryState::AuxiliaryState(const std::string &Name, const HorzMesh *Mesh,
    LayerThicknessAux.registerFields(GroupName, AuxMeshName);
    VorticityAux.registerFields(GroupName, AuxMeshName);
    VelocityDel2Aux.registerFields(GroupName, AuxMeshName);
+
+   setComputeHaloDepth(FullHalo);
 }
 
 // Destructor. Unregisters the fields with IOStreams and destroys this auxiliary
@@ -49,65 +57,461 @@ AuxiliaryState::~AuxiliaryState() {
 // Compute the auxiliary variables
 void AuxiliaryState::computeAll(const OceanState *State, int ThickTimeLevel,
                                 int VelTimeLevel) const {
+   TimerRegion AuxTimer("AuxiliaryState");
+
    const Array2DReal &LayerThickCell = State->LayerThickness[ThickTimeLevel];
    const Array2DReal &NormalVelEdge  = State->NormalVelocity[VelTimeLevel];
 
+   LayerThicknessAux.setLayerThickCell(LayerThickCell);
+
+   const int VecWidth = selectVecWidth(LayerThickCell.extent_int(1));
+
+   if (FusedCompute) {
+      OMEGA_DISPATCH_VEC_WIDTH(VecWidth, computeAllFused, LayerThickCell,
+                               NormalVelEdge);
+   } else {
+      OMEGA_DISPATCH_VEC_WIDTH(VecWidth, computeAllChunked, LayerThickCell,
+                               NormalVelEdge);
+   }
+}
+
+// Compute the auxiliary variables with one kernel per mesh element type and
+// stage over vertical chunks of width W
+template <int W>
+void AuxiliaryState::computeAllChunked(const Array2DReal &LayerThickCell,
+                                       const Array2DReal &NormalVelEdge) const {
+
    const int NVertLevels = LayerThickCell.extent_int(1);
-   const int NChunks     = NVertLevels / VecLength;
+   const int NChunks     = numVertChunks(W, NVertLevels);
 
    OMEGA_SCOPE(LocKineticAux, KineticAux);
    OMEGA_SCOPE(LocLayerThicknessAux, LayerThicknessAux);
    OMEGA_SCOPE(LocVorticityAux, VorticityAux);
    OMEGA_SCOPE(LocVelocityDel2Aux, VelocityDel2Aux);
+   OMEGA_SCOPE(MinLevelCell, Mesh->MinLevelCell);
+   OMEGA_SCOPE(MaxLevelCell, Mesh->MaxLevelCell);
+   OMEGA_SCOPE(MinLevelEdge, Mesh->MinLevelEdge);
+   OMEGA_SCOPE(MaxLevelEdge, Mesh->MaxLevelEdge);
+   OMEGA_SCOPE(MinLevelVertex, Mesh->MinLevelVertex);
+   OMEGA_SCOPE(MaxLevelVertex, Mesh->MaxLevelVertex);
+
+   // Estimated array words read or written and flops per level of every
+   // kernel, counting each array value once, for the kernel counters
+   if (KernelCounters::isEnabled()) {
+      const R8 Word = W * sizeof(Real);
+      KernelCounters::annotate("vertexAuxState1", 9 * Word, 15 * W);
+      KernelCounters::annotate("cellAuxState1", 8 * Word, 30 * W);
+      KernelCounters::annotate("edgeAuxState1", 16 * Word, 20 * W);
+      KernelCounters::annotate("vertexAuxState2", 4 * Word, 6 * W);
+      KernelCounters::annotate("cellAuxState2", 7 * Word, 12 * W);
+      KernelCounters::annotate("cellAuxState3", 2 * Word, 2 * W);
+   }
 
-   parallelFor(
-       "vertexAuxState1", {Mesh->NVerticesAll, NChunks},
-       KOKKOS_LAMBDA(int IVertex, int KChunk) {
-          LocVorticityAux.computeVarsOnVertex(IVertex, KChunk, LayerThickCell,
-                                              NormalVelEdge);
-       });
-
-   parallelFor(
-       "cellAuxState1", {Mesh->NCellsAll, NChunks},
-       KOKKOS_LAMBDA(int ICell, int KChunk) {
-          LocKineticAux.computeVarsOnCell(ICell, KChunk, NormalVelEdge);
-       });
+   // The vorticity and kinetic energy kernels only read the state, and the
+   // vertex and cell kernels of the second stage only read the edge
+   // variables, so the kernels of each stage can run concurrently
+   const auto VertexAux1 = KOKKOS_LAMBDA(int IVertex, int KChunk) {
+      if (!isActiveChunk<W>(KChunk, MinLevelVertex(IVertex),
+                            MaxLevelVertex(IVertex)))
+         return;
+      LocVorticityAux.computeVarsOnVertex<W>(IVertex, KChunk, LayerThickCell,
+                                             NormalVelEdge);
+   };
+
+   const auto CellAux1 = KOKKOS_LAMBDA(int ICell, int KChunk) {
+      if (!isActiveChunk<W>(KChunk, MinLevelCell(ICell), MaxLevelCell(ICell)))
+         return;
+      LocKineticAux.computeVarsOnCell<W>(ICell, KChunk, NormalVelEdge);
+   };
 
    const auto &VelocityDivCell = KineticAux.VelocityDivCell;
    const auto &RelVortVertex   = VorticityAux.RelVortVertex;
+   const bool ComputeDel2      = VelocityDel2Aux.Allocated;
+
+   const auto EdgeAux1 = KOKKOS_LAMBDA(int IEdge, int KChunk) {
+      if (!isActiveChunk<W>(KChunk, MinLevelEdge(IEdge), MaxLevelEdge(IEdge)))
+         return;
+      LocVorticityAux.computeVarsOnEdge<W>(IEdge, KChunk);
+      LocLayerThicknessAux.computeVarsOnEdge<W>(IEdge, KChunk, LayerThickCell,
+                                                NormalVelEdge);
+      if (ComputeDel2)
+         LocVelocityDel2Aux.computeVarsOnEdge<W>(IEdge, KChunk, VelocityDivCell,
+                                                 RelVortVertex);
+   };
+
+   const auto VertexAux2 = KOKKOS_LAMBDA(int IVertex, int KChunk) {
+      if (!isActiveChunk<W>(KChunk, MinLevelVertex(IVertex),
+                            MaxLevelVertex(IVertex)))
+         return;
+      LocVelocityDel2Aux.computeVarsOnVertex<W>(IVertex, KChunk);
+   };
+
+   const auto CellAux2 = KOKKOS_LAMBDA(int ICell, int KChunk) {
+      if (!isActiveChunk<W>(KChunk, MinLevelCell(ICell), MaxLevelCell(ICell)))
+         return;
+      LocVelocityDel2Aux.computeVarsOnCell<W>(ICell, KChunk);
+   };
+
+   const auto CellAux3 = KOKKOS_LAMBDA(int ICell, int KChunk) {
+      if (!isActiveChunk<W>(KChunk, MinLevelCell(ICell), MaxLevelCell(ICell)))
+         return;
+      LocLayerThicknessAux.computeVarsOnCells<W>(ICell, KChunk,
+                                                 LayerThickCell);
+   };
+
+   KernelScheduler Sched;
+   const auto Vertex1 = Sched.add([&]() {
+      parallelForChunks("vertexAuxState1", {NVerticesCompute, NChunks},
+                        VertexAux1, OuterInnerLoops);
+   });
+   const auto Cell1 = Sched.add([&]() {
+      parallelForChunks("cellAuxState1", {NCellsCompute, NChunks}, CellAux1,
+                        OuterInnerLoops);
+   });
+   const auto Edge1 = Sched.add(
+       [&]() {
+          parallelForChunks("edgeAuxState1", {NEdgesCompute, NChunks},
+                            EdgeAux1, OuterInnerLoops);
+       },
+       {Vertex1, Cell1});
+   // The second stage only computes the velocity del2 variables
+   if (ComputeDel2) {
+      Sched.add(
+          [&]() {
+             parallelForChunks("vertexAuxState2", {NVerticesCompute, NChunks},
+                               VertexAux2, OuterInnerLoops);
+          },
+          {Edge1});
+      Sched.add(
+          [&]() {
+             parallelForChunks("cellAuxState2", {NCellsCompute, NChunks},
+                               CellAux2, OuterInnerLoops);
+          },
+          {Edge1});
+   }
+   Sched.add([&]() {
+      parallelForChunks("cellAuxState3", {NCellsCompute, NChunks}, CellAux3,
+                        OuterInnerLoops);
+   });
+   Sched.run();
+}
 
-   parallelFor(
-       "edgeAuxState1", {Mesh->NEdgesAll, NChunks},
-       KOKKOS_LAMBDA(int IEdge, int KChunk) {
-          LocVorticityAux.computeVarsOnEdge(IEdge, KChunk);
-          LocLayerThicknessAux.computeVarsOnEdge(IEdge, KChunk, LayerThickCell,
-                                                 NormalVelEdge);
-          LocVelocityDel2Aux.computeVarsOnEdge(IEdge, KChunk, VelocityDivCell,
-                                               RelVortVertex);
-       });
+void AuxiliaryState::computeAll(const OceanState *State, int TimeLevel) const {
+   computeAll(State, TimeLevel, TimeLevel);
+}
 
-   parallelFor(
-       "vertexAuxState2", {Mesh->NVerticesAll, NChunks},
-       KOKKOS_LAMBDA(int IVertex, int KChunk) {
-          LocVelocityDel2Aux.computeVarsOnVertex(IVertex, KChunk);
-       });
+// Restrict the computation to the owned elements and the first HaloDepth halo
+// layers. The variables in the outer halo layers are left unchanged.
+void AuxiliaryState::setComputeHaloDepth(I4 HaloDepth) {
+   const MeshLoopBounds Bounds = Mesh->getLoopBounds(HaloDepth);
+   NCellsCompute               = Bounds.NCells;
+   NEdgesCompute               = Bounds.NEdges;
+   NVerticesCompute            = Bounds.NVertices;
+}
 
-   parallelFor(
-       "cellAuxState2", {Mesh->NCellsAll, NChunks},
-       KOKKOS_LAMBDA(int ICell, int KChunk) {
-          LocVelocityDel2Aux.computeVarsOnCell(ICell, KChunk);
-       });
+// Store or recompute the cheap layer thickness auxiliary variables. Their
+// fields are only registered when they are stored.
+void AuxiliaryState::setRecomputeAuxVars(bool Recompute) {
+
+   if (Recompute == LayerThicknessAux.RecomputeVars)
+      return;
+
+   LayerThicknessAux.unregisterFields();
+   if (Recompute) {
+      for (const auto &Arr :
+           {LayerThicknessAux.MeanLayerThickEdge, LayerThicknessAux.SshCell}) {
+         int Err = FieldGroup::removeFieldFromGroup(Arr.label(), GroupName);
+         if (Err != 0)
+            LOG_ERROR("Error removing field {} from group {}", Arr.label(),
+                      GroupName);
+      }
+   }
+   LayerThicknessAux.setRecompute(Recompute);
+   LayerThicknessAux.registerFields(GroupName, Mesh->MeshName);
+}
+
+// Allocate and compute only the optional variables in the mask. The del2
+// velocity fields are only registered while they are allocated, and the del2
+// tracers are reallocated with the current number of tracers.
+void AuxiliaryState::setNeededAuxVars(I4 Mask) {
+
+   if (Mask == NeededAuxVars)
+      return;
+   NeededAuxVars = Mask;
+
+   const bool NeedVelDel2 = (Mask & AuxVelocityDel2Bit) != 0;
+   if (NeedVelDel2 != VelocityDel2Aux.Allocated) {
+      if (!NeedVelDel2) {
+         for (const auto &Arr :
+              {VelocityDel2Aux.Del2Edge, VelocityDel2Aux.Del2DivCell,
+               VelocityDel2Aux.Del2RelVortVertex}) {
+            int Err = FieldGroup::removeFieldFromGroup(Arr.label(), GroupName);
+            if (Err != 0)
+               LOG_ERROR("Error removing field {} from group {}", Arr.label(),
+                         GroupName);
+         }
+         VelocityDel2Aux.unregisterFields();
+      }
+      VelocityDel2Aux.setAllocated(NeedVelDel2);
+      VelocityDel2Aux.registerFields(GroupName, Mesh->MeshName);
+   }
+
+   const bool NeedTracerDel2 = (Mask & AuxTracerDel2Bit) != 0;
+   const I4 NTracers         = TracerAux.HTracersOnEdge.extent_int(0);
+   if (NTracers > 0 and
+       NeedTracerDel2 != TracerAux.Del2TracersOnCell.is_allocated()) {
+      if (NeedTracerDel2) {
+         const int NVertLevels =
+             LayerThicknessAux.FluxLayerThickEdge.extent_int(1);
+         TracerAux.Del2TracersOnCell = createFirstTouchArray<Array3DAuxReal>(
+             "Del2TracerOnCell" + Name, NTracers, Mesh->NCellsSize,
+             NVertLevels);
+      } else {
+         TracerAux.Del2TracersOnCell = Array3DAuxReal();
+      }
+   }
+}
+
+// Allocate the tracer auxiliary variables. The tracer fields are not
+// registered with IOStreams since the tracer dimension is not defined.
+void AuxiliaryState::initTracerAux(I4 NTracers) {
+
+   if (TracerAux.HTracersOnEdge.extent_int(0) == NTracers)
+      return;
+
+   const int NVertLevels = LayerThicknessAux.FluxLayerThickEdge.extent_int(1);
+   const FluxThickEdgeOption TracersOnEdgeChoice =
+       TracerAux.TracersOnEdgeChoice;
+   const Real Coef3rdOrder = TracerAux.Coef3rdOrder;
+
+   TracerAux = TracerAuxVars(Name, Mesh, NVertLevels, NTracers,
+                             (NeededAuxVars & AuxTracerDel2Bit) != 0);
+   TracerAux.TracersOnEdgeChoice = TracersOnEdgeChoice;
+   TracerAux.Coef3rdOrder        = Coef3rdOrder;
+}
+
+// Allocate the accumulated thickness fluxes
+void AuxiliaryState::initAccumThickFlux() {
+
+   if (AccumThickFluxEdge.is_allocated())
+      return;
+
+   const int NVertLevels = LayerThicknessAux.FluxLayerThickEdge.extent_int(1);
+
+   AccumThickFluxEdge = createFirstTouchArray<Array2DReal>(
+       "AccumThickFluxEdge" + Name, Mesh->NEdgesSize, NVertLevels);
+   AccumStartThickCell = createFirstTouchArray<Array2DReal>(
+       "AccumStartThickCell" + Name, Mesh->NCellsSize, NVertLevels);
+}
+
+// Zero the accumulated fluxes and save the thickness at the start
+void AuxiliaryState::startAccumThickFlux(const OceanState *State,
+                                         int TimeLevel) const {
+
+   deepCopy(AccumThickFluxEdge, 0);
+   deepCopy(AccumStartThickCell, State->LayerThickness[TimeLevel]);
+}
+
+// Accumulate Dt times the thickness flux on all edges, with the same upwind or
+// centered edge thickness as the thickness flux of the tendencies
+void AuxiliaryState::accumulateThickFlux(const OceanState *State,
+                                         int TimeLevel,
+                                         TimeInterval Dt) const {
+
+   const Array2DReal &LayerThickCell = State->LayerThickness[TimeLevel];
+   const Array2DReal &NormalVelEdge  = State->NormalVelocity[TimeLevel];
+   const int NVertLevels             = LayerThickCell.extent_int(1);
+
+   const bool IsUpwind = LayerThicknessAux.FluxThickEdgeChoice == Upwind;
+
+   OMEGA_SCOPE(AccumFlux, AccumThickFluxEdge);
+   OMEGA_SCOPE(CellsOnEdge, Mesh->CellsOnEdge);
+
+   Real DtSeconds;
+   Dt.get(DtSeconds, TimeUnits::Seconds);
 
    parallelFor(
-       "cellAuxState3", {Mesh->NCellsAll, NChunks},
-       KOKKOS_LAMBDA(int ICell, int KChunk) {
-          LocLayerThicknessAux.computeVarsOnCells(ICell, KChunk,
-                                                  LayerThickCell);
+       "accumThickFlux", {Mesh->NEdgesAll, NVertLevels},
+       KOKKOS_LAMBDA(int IEdge, int K) {
+          const Real Thick0 = LayerThickCell(CellsOnEdge(IEdge, 0), K);
+          const Real Thick1 = LayerThickCell(CellsOnEdge(IEdge, 1), K);
+          const Real Vel    = NormalVelEdge(IEdge, K);
+
+          Real ThickEdge = 0.5_Real * (Thick0 + Thick1);
+          if (IsUpwind) {
+             ThickEdge = Vel > 0   ? Thick0
+                         : Vel < 0 ? Thick1
+                                   : Kokkos::max(Thick0, Thick1);
+          }
+          AccumFlux(IEdge, K) += DtSeconds * ThickEdge * Vel;
        });
 }
 
-void AuxiliaryState::computeAll(const OceanState *State, int TimeLevel) const {
-   computeAll(State, TimeLevel, TimeLevel);
+// Compute the tracer auxiliary variables for a batch of tracers. Each kernel
+// iterates over the tracers of the batch together with the mesh elements and
+// vertical chunks, so a tracer group is handled by one launch per variable
+// instead of one launch per tracer.
+void AuxiliaryState::computeTracerAux(const OceanState *State,
+                                      const Array3DReal &TracerArray,
+                                      int ThickTimeLevel, int VelTimeLevel,
+                                      I4 TracerStart,
+                                      I4 NTracersBatch) const {
+   TimerRegion AuxTimer("TracerAuxState");
+
+   const Array2DReal &LayerThickCell = State->LayerThickness[ThickTimeLevel];
+   const Array2DReal &NormalVelEdge  = State->NormalVelocity[VelTimeLevel];
+
+   const int VecWidth = selectVecWidth(LayerThickCell.extent_int(1));
+
+   OMEGA_DISPATCH_VEC_WIDTH(VecWidth, computeTracerAuxChunked, LayerThickCell,
+                            NormalVelEdge, TracerArray, TracerStart,
+                            NTracersBatch);
+}
+
+// Compute the tracer auxiliary variables for a batch of tracers over vertical
+// chunks of width W
+template <int W>
+void AuxiliaryState::computeTracerAuxChunked(const Array2DReal &LayerThickCell,
+                                             const Array2DReal &NormalVelEdge,
+                                             const Array3DReal &TracerArray,
+                                             I4 TracerStart,
+                                             I4 NTracersBatch) const {
+
+   const MeanLayerThickEdgeAccessor MeanLayerThickEdge =
+       LayerThicknessAux.meanLayerThickEdge();
+
+   const int NVertLevels = LayerThickCell.extent_int(1);
+   const int NChunks     = numVertChunks(W, NVertLevels);
+
+   OMEGA_SCOPE(LocTracerAux, TracerAux);
+   OMEGA_SCOPE(MinLevelCell, Mesh->MinLevelCell);
+   OMEGA_SCOPE(MaxLevelCell, Mesh->MaxLevelCell);
+   OMEGA_SCOPE(MinLevelEdge, Mesh->MinLevelEdge);
+   OMEGA_SCOPE(MaxLevelEdge, Mesh->MaxLevelEdge);
+
+   parallelForChunks(
+       "edgeTracerAux", {NTracersBatch, NEdgesCompute, NChunks},
+       KOKKOS_LAMBDA(int LBatch, int IEdge, int KChunk) {
+          if (!isActiveChunk<W>(KChunk, MinLevelEdge(IEdge),
+                                MaxLevelEdge(IEdge)))
+             return;
+          LocTracerAux.computeVarsOnEdge<W>(TracerStart + LBatch, IEdge,
+                                            KChunk, NormalVelEdge,
+                                            LayerThickCell, TracerArray);
+       },
+       OuterInnerLoops);
+
+   // The cell variables are only used by the tracer hyperdiffusion
+   if (!LocTracerAux.Del2TracersOnCell.is_allocated())
+      return;
+
+   parallelForChunks(
+       "cellTracerAux", {NTracersBatch, NCellsCompute, NChunks},
+       KOKKOS_LAMBDA(int LBatch, int ICell, int KChunk) {
+          if (!isActiveChunk<W>(KChunk, MinLevelCell(ICell),
+                                MaxLevelCell(ICell)))
+             return;
+          LocTracerAux.computeVarsOnCells<W>(TracerStart + LBatch, ICell,
+                                             KChunk, MeanLayerThickEdge,
+                                             TracerArray);
+       },
+       OuterInnerLoops);
+}
+
+// Compute the auxiliary variables with fused kernels. The variables that
+// depend only on the state (vertex and cell variables of the first stage) are
+// computed in a single launch, followed by the edge variables and then the
+// vertex and cell variables that depend on the edge results. Each team works
+// on one cell and the vertex with the same index, with its threads spread
+// over the vertical chunks, so the state and mesh connectivity of a cell are
+// read once for all of the first stage variables.
+template <int W>
+void AuxiliaryState::computeAllFused(const Array2DReal &LayerThickCell,
+                                     const Array2DReal &NormalVelEdge) const {
+
+   const int NVertLevels  = LayerThickCell.extent_int(1);
+   const int NChunks      = numVertChunks(W, NVertLevels);
+   const int NCellsAll    = NCellsCompute;
+   const int NVerticesAll = NVerticesCompute;
+   const int NTeams       = std::max(NCellsAll, NVerticesAll);
+
+   OMEGA_SCOPE(LocKineticAux, KineticAux);
+   OMEGA_SCOPE(LocLayerThicknessAux, LayerThicknessAux);
+   OMEGA_SCOPE(LocVorticityAux, VorticityAux);
+   OMEGA_SCOPE(LocVelocityDel2Aux, VelocityDel2Aux);
+   OMEGA_SCOPE(MinLevelCell, Mesh->MinLevelCell);
+   OMEGA_SCOPE(MaxLevelCell, Mesh->MaxLevelCell);
+   OMEGA_SCOPE(MinLevelEdge, Mesh->MinLevelEdge);
+   OMEGA_SCOPE(MaxLevelEdge, Mesh->MaxLevelEdge);
+   OMEGA_SCOPE(MinLevelVertex, Mesh->MinLevelVertex);
+   OMEGA_SCOPE(MaxLevelVertex, Mesh->MaxLevelVertex);
+
+   parallelForPolicy(
+       "fusedAuxState1", TeamPolicy(NTeams, Kokkos::AUTO),
+       KOKKOS_LAMBDA(const TeamMember &Member) {
+          const int I = Member.league_rank();
+          Kokkos::parallel_for(
+              Kokkos::TeamThreadRange(Member, NChunks), [=](int KChunk) {
+                 if (I < NVerticesAll and
+                     isActiveChunk<W>(KChunk, MinLevelVertex(I),
+                                      MaxLevelVertex(I))) {
+                    LocVorticityAux.computeVarsOnVertex<W>(
+                        I, KChunk, LayerThickCell, NormalVelEdge);
+                 }
+                 if (I < NCellsAll and
+                     isActiveChunk<W>(KChunk, MinLevelCell(I),
+                                      MaxLevelCell(I))) {
+                    LocKineticAux.computeVarsOnCell<W>(I, KChunk,
+                                                       NormalVelEdge);
+                    LocLayerThicknessAux.computeVarsOnCells<W>(
+                        I, KChunk, LayerThickCell);
+                 }
+              });
+       });
+
+   const auto &VelocityDivCell = KineticAux.VelocityDivCell;
+   const auto &RelVortVertex   = VorticityAux.RelVortVertex;
+   const bool ComputeDel2      = VelocityDel2Aux.Allocated;
+
+   parallelForChunks(
+       "fusedAuxState2", {NEdgesCompute, NChunks},
+       KOKKOS_LAMBDA(int IEdge, int KChunk) {
+          if (!isActiveChunk<W>(KChunk, MinLevelEdge(IEdge),
+                                MaxLevelEdge(IEdge)))
+             return;
+          LocVorticityAux.computeVarsOnEdge<W>(IEdge, KChunk);
+          LocLayerThicknessAux.computeVarsOnEdge<W>(IEdge, KChunk,
+                                                    LayerThickCell,
+                                                    NormalVelEdge);
+          if (ComputeDel2)
+             LocVelocityDel2Aux.computeVarsOnEdge<W>(IEdge, KChunk,
+                                                     VelocityDivCell,
+                                                     RelVortVertex);
+       },
+       OuterInnerLoops);
+
+   // The third kernel only computes the velocity del2 variables
+   if (!ComputeDel2)
+      return;
+
+   parallelForPolicy(
+       "fusedAuxState3", TeamPolicy(NTeams, Kokkos::AUTO),
+       KOKKOS_LAMBDA(const TeamMember &Member) {
+          const int I = Member.league_rank();
+          Kokkos::parallel_for(
+              Kokkos::TeamThreadRange(Member, NChunks), [=](int KChunk) {
+                 if (I < NVerticesAll and
+                     isActiveChunk<W>(KChunk, MinLevelVertex(I),
+                                      MaxLevelVertex(I))) {
+                    LocVelocityDel2Aux.computeVarsOnVertex<W>(I, KChunk);
+                 }
+                 if (I < NCellsAll and
+                     isActiveChunk<W>(KChunk, MinLevelCell(I),
+                                      MaxLevelCell(I))) {
+                    LocVelocityDel2Aux.computeVarsOnCell<W>(I, KChunk);
+                 }
+              });
+       });
 }
 
 // Create a non-default auxiliary state
@@ -126,6 +530,52 @@ AuxiliaryState *AuxiliaryState::create(const std::string &Name,
    return NewAuxState;
 }
 
+// Create a non-default auxiliary state as a clone of an existing one
+AuxiliaryState *AuxiliaryState::create(const std::string &Name,
+                                       const AuxiliaryState *Source,
+                                       bool CopyData) {
+   if (Source == nullptr) {
+      LOG_ERROR("AuxiliaryState: no source state to create state {} from",
+                Name);
+      return nullptr;
+   }
+
+   const int NVertLevels =
+       Source->LayerThicknessAux.FluxLayerThickEdge.extent_int(1);
+   AuxiliaryState *NewAuxState = create(Name, Source->Mesh, NVertLevels);
+   if (NewAuxState == nullptr)
+      return nullptr;
+
+   // Copy the options and the compute bounds
+   NewAuxState->LayerThicknessAux.FluxThickEdgeChoice =
+       Source->LayerThicknessAux.FluxThickEdgeChoice;
+   NewAuxState->TracerAux.TracersOnEdgeChoice =
+       Source->TracerAux.TracersOnEdgeChoice;
+   NewAuxState->TracerAux.Coef3rdOrder = Source->TracerAux.Coef3rdOrder;
+   NewAuxState->FusedCompute           = Source->FusedCompute;
+   NewAuxState->OuterInnerLoops        = Source->OuterInnerLoops;
+   NewAuxState->setRecomputeAuxVars(Source->LayerThicknessAux.RecomputeVars);
+   NewAuxState->setNeededAuxVars(Source->NeededAuxVars);
+   NewAuxState->NCellsCompute    = Source->NCellsCompute;
+   NewAuxState->NEdgesCompute    = Source->NEdgesCompute;
+   NewAuxState->NVerticesCompute = Source->NVerticesCompute;
+
+   const I4 NTracers = Source->TracerAux.HTracersOnEdge.extent_int(0);
+   if (NTracers > 0)
+      NewAuxState->initTracerAux(NTracers);
+
+   if (Source->AccumThickFluxEdge.is_allocated()) {
+      NewAuxState->initAccumThickFlux();
+      if (CopyData) {
+         deepCopy(NewAuxState->AccumThickFluxEdge, Source->AccumThickFluxEdge);
+         deepCopy(NewAuxState->AccumStartThickCell,
+                  Source->AccumStartThickCell);
+      }
+   }
+
+   return NewAuxState;
+}
+
 // Create the default auxiliary state. Assumes that HorzMesh has been
 // initialized.
 int AuxiliaryState::init() {
@@ -203,6 +653,72 @@ int AuxiliaryState::readConfigOptions(Config *OmegaConfig) {
       return Err;
    }
 
+   // The tracer flux type is optional and defaults to Center
+   if (AdvectConfig.existsVar("FluxTracerType")) {
+      std::string FluxTracerTypeStr;
+      Err = AdvectConfig.get("FluxTracerType", FluxTracerTypeStr);
+      if (Err != 0) {
+         LOG_CRITICAL("AuxiliaryState: error reading FluxTracerType");
+         return Err;
+      }
+
+      if (FluxTracerTypeStr == "Center") {
+         this->TracerAux.TracersOnEdgeChoice = Center;
+      } else if (FluxTracerTypeStr == "Upwind") {
+         this->TracerAux.TracersOnEdgeChoice = Upwind;
+      } else if (FluxTracerTypeStr == "HighOrder") {
+         this->TracerAux.TracersOnEdgeChoice = HighOrder;
+      } else {
+         LOG_CRITICAL("AuxiliaryState: Unknown FluxTracerType requested");
+         Err = -1;
+         return Err;
+      }
+   }
+
+   // The weight of the 3rd-order upwind part of the HighOrder tracer values
+   // is optional and defaults to 0.25
+   if (AdvectConfig.existsVar("Coef3rdOrder")) {
+      Err = AdvectConfig.get("Coef3rdOrder", this->TracerAux.Coef3rdOrder);
+      if (Err != 0) {
+         LOG_CRITICAL("AuxiliaryState: error reading Coef3rdOrder");
+         return Err;
+      }
+   }
+
+   // The AuxiliaryState group is optional, by default each auxiliary
+   // variable stage is computed with a separate kernel
+   if (OmegaConfig->existsGroup("AuxiliaryState")) {
+      Config AuxStateConfig("AuxiliaryState");
+      Err = OmegaConfig->get(AuxStateConfig);
+      if (Err != 0) {
+         LOG_CRITICAL("AuxiliaryState: error reading AuxiliaryState group");
+         return Err;
+      }
+      if (AuxStateConfig.existsVar("FusedCompute")) {
+         Err = AuxStateConfig.get("FusedCompute", this->FusedCompute);
+         if (Err != 0) {
+            LOG_CRITICAL("AuxiliaryState: error reading FusedCompute");
+            return Err;
+         }
+      }
+      if (AuxStateConfig.existsVar("OuterInnerLoops")) {
+         Err = AuxStateConfig.get("OuterInnerLoops", this->OuterInnerLoops);
+         if (Err != 0) {
+            LOG_CRITICAL("AuxiliaryState: error reading OuterInnerLoops");
+            return Err;
+         }
+      }
+      if (AuxStateConfig.existsVar("RecomputeAuxVars")) {
+         bool RecomputeAuxVars = false;
+         Err = AuxStateConfig.get("RecomputeAuxVars", RecomputeAuxVars);
+         if (Err != 0) {
+            LOG_CRITICAL("AuxiliaryState: error reading RecomputeAuxVars");
+            return Err;
+         }
+         setRecomputeAuxVars(RecomputeAuxVars);
+      }
+   }
+
    return Err;
 }
 
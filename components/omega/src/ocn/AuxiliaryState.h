@@ -7,6 +7,7 @@
 #include "OceanState.h"
 #include "auxiliaryVars/KineticAuxVars.h"
 #include "auxiliaryVars/LayerThicknessAuxVars.h"
+#include "auxiliaryVars/TracerAuxVars.h"
 #include "auxiliaryVars/VelocityDel2AuxVars.h"
 #include "auxiliaryVars/VorticityAuxVars.h"
 
@@ -15,6 +16,15 @@
 
 namespace OMEGA {
 
+/// Bits identifying the auxiliary variables that are only allocated and
+/// computed when a consumer needs them, used in the mask of needed variables
+/// declared by the tendencies
+enum AuxVarBit {
+   AuxVelocityDel2Bit = 1 << 0, ///< laplacian of velocity for del4 terms
+   AuxTracerDel2Bit   = 1 << 1, ///< laplacian of tracers for del4 terms
+   AuxAllVarsMask     = AuxVelocityDel2Bit | AuxTracerDel2Bit
+};
+
 /// A class for the ocean auxiliary variables.
 /// The AuxiliaryState class groups together all of the
 /// model auxiliary variables. It handles IO and contains methods that
@@ -34,6 +44,24 @@ class AuxiliaryState {
    VorticityAuxVars VorticityAux;
    VelocityDel2AuxVars VelocityDel2Aux;
 
+   // Tracer auxiliary variables, empty until initTracerAux is called since
+   // the tracers are initialized after the auxiliary state
+   TracerAuxVars TracerAux;
+
+   // Thickness fluxes on edges integrated in time (m2) and the layer
+   // thickness at the start of the integration, used to transport the tracer
+   // groups that are advanced with a longer step than the dynamics. Empty
+   // until initAccumThickFlux is called.
+   Array2DReal AccumThickFluxEdge;
+   Array2DReal AccumStartThickCell;
+
+   // Flag to compute the auxiliary variables with the fused kernels
+   bool FusedCompute = false;
+
+   // Flag to launch the kernels with one team per mesh element and the
+   // vertical chunks of the element over the vector lanes of the team
+   bool OuterInnerLoops = false;
+
    ~AuxiliaryState();
 
    // Methods
@@ -45,6 +73,15 @@ class AuxiliaryState {
    static AuxiliaryState *create(const std::string &Name, const HorzMesh *Mesh,
                                  int NVertLevels);
 
+   /// Create a non-default auxiliary state with the mesh, sizes and options
+   /// of an existing one. The diagnostic variables are not copied since
+   /// computeAll recomputes them from the state, but if CopyData is true the
+   /// accumulated thickness fluxes, which carry information across steps,
+   /// are copied when they are allocated in the source.
+   static AuxiliaryState *create(const std::string &Name,
+                                 const AuxiliaryState *Source,
+                                 bool CopyData = true);
+
    /// Get the default auxiliary state
    static AuxiliaryState *getDefault();
 
@@ -60,13 +97,80 @@ class AuxiliaryState {
    /// Read and set config options
    int readConfigOptions(Config *OmegaConfig);
 
+   /// Restrict the computation of the auxiliary variables to the owned
+   /// elements and the first HaloDepth halo layers, or compute on all
+   /// elements including the full halo if HaloDepth is FullHalo
+   void setComputeHaloDepth(I4 HaloDepth);
+
+   /// Recompute the mean layer thickness on edges and the sea surface height
+   /// inside the kernels that use them instead of storing them, or go back
+   /// to storing them. Their arrays and fields are released or recreated.
+   void setRecomputeAuxVars(bool Recompute);
+
+   /// Allocate and compute only the optional auxiliary variables in the mask
+   /// of AuxVarBit values, releasing the arrays and fields of the others.
+   /// All variables are needed until this is called.
+   void setNeededAuxVars(I4 Mask);
+
+   /// Mask of AuxVarBit values of the optional variables that are computed
+   I4 getNeededAuxVars() const { return NeededAuxVars; }
+
    /// Compute all auxiliary variables based on an ocean state at a given time
    /// level
    void computeAll(const OceanState *State, int ThickTimeLevel,
                    int VelTimeLevel) const;
    void computeAll(const OceanState *State, int TimeLevel) const;
 
+   /// Allocate the tracer auxiliary variables for the input number of
+   /// tracers. Does nothing if they are already allocated with that size.
+   void initTracerAux(I4 NTracers);
+
+   /// Allocate the accumulated thickness fluxes. Does nothing if they are
+   /// already allocated.
+   void initAccumThickFlux();
+
+   /// Start a new accumulation of the thickness fluxes from the layer
+   /// thickness of a state at a time level
+   void startAccumThickFlux(const OceanState *State, int TimeLevel) const;
+
+   /// Add Dt times the thickness flux of a state at a time level, with the
+   /// thickness on edges chosen like the flux thickness of the tendencies, to
+   /// the accumulated thickness fluxes
+   void accumulateThickFlux(const OceanState *State, int TimeLevel,
+                            TimeInterval Dt) const;
+
+   /// Compute the tracer auxiliary variables of the tracers TracerStart to
+   /// TracerStart + NTracersBatch - 1 in the input tracer array, with all
+   /// tracers of the batch handled by the same kernel launch. Assumes the
+   /// layer thickness auxiliary variables of the state at the given time
+   /// levels have already been computed.
+   void computeTracerAux(const OceanState *State,
+                         const Array3DReal &TracerArray, int ThickTimeLevel,
+                         int VelTimeLevel, I4 TracerStart,
+                         I4 NTracersBatch) const;
+
  private:
+   /// Compute all auxiliary variables over vertical chunks of width W with
+   /// one kernel per mesh element type and stage
+   template <int W>
+   void computeAllChunked(const Array2DReal &LayerThickCell,
+                          const Array2DReal &NormalVelEdge) const;
+
+   /// Compute all auxiliary variables over vertical chunks of width W with
+   /// three fused hierarchical kernels instead of one kernel per mesh element
+   /// type and stage
+   template <int W>
+   void computeAllFused(const Array2DReal &LayerThickCell,
+                        const Array2DReal &NormalVelEdge) const;
+
+   /// Compute the tracer auxiliary variables of a batch of tracers over
+   /// vertical chunks of width W
+   template <int W>
+   void computeTracerAuxChunked(const Array2DReal &LayerThickCell,
+                                const Array2DReal &NormalVelEdge,
+                                const Array3DReal &TracerArray, I4 TracerStart,
+                                I4 NTracersBatch) const;
+
    AuxiliaryState(const std::string &Name, const HorzMesh *Mesh,
                   int NVertLevels);
 
@@ -74,6 +178,15 @@ class AuxiliaryState {
    AuxiliaryState(AuxiliaryState &&)      = delete;
 
    const HorzMesh *Mesh;
+
+   // Mask of AuxVarBit values of the optional variables that are computed
+   I4 NeededAuxVars = AuxAllVarsMask;
+
+   // Number of elements on which the variables are computed
+   I4 NCellsCompute;
+   I4 NEdgesCompute;
+   I4 NVerticesCompute;
+
    static AuxiliaryState *DefaultAuxState;
    static std::map<std::string, std::unique_ptr<AuxiliaryState>> AllAuxStates;
 };
@@ -0,0 +1,556 @@
+//===-- ocn/Checkpoint.cpp - fast node-local checkpoints --------*- C++ -*-===//
+//
+// The Checkpoint class writes the owned part of the current time level of
+// the default ocean state and tracers to a binary file per task in a
+// node-local directory, in a background thread, and reloads it on startup
+// when the decomposition is unchanged.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Checkpoint.h"
+#include "Broadcast.h"
+#include "Config.h"
+#include "Decomp.h"
+#include "IOStream.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "Timer.h"
+#include "Tracers.h"
+
+#include "mpi.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace OMEGA {
+
+// Static members
+bool Checkpoint::Enabled        = false;
+bool Checkpoint::RestartEnabled = false;
+std::string Checkpoint::Directory;
+Alarm Checkpoint::CheckpointAlarm;
+std::string Checkpoint::FlushStream;
+I4 Checkpoint::FlushInterval = 1;
+I4 Checkpoint::NumSinceFlush = 0;
+std::future<int> Checkpoint::PendingWrite;
+
+namespace {
+
+// Identifies Omega checkpoint files and their format version
+constexpr I8 CheckpointMagic   = 0x4F4D454741434B50; // "OMEGACKP"
+constexpr I4 CheckpointVersion = 1;
+
+// Maximum length of the time string stored in a checkpoint
+constexpr int MaxTimeLength = 64;
+
+// Header at the start of each checkpoint file. The file is only read back
+// on the node that wrote it so the native binary layout is used.
+struct CheckpointHeader {
+   I8 Magic;                 // identifies a checkpoint file
+   I4 Version;               // format version
+   I4 RealSize;              // size in bytes of the Real type
+   I4 NCellsOwned;           // owned cells of the task
+   I4 NEdgesOwned;           // owned edges of the task
+   I4 NVertLevels;           // vertical levels of the state
+   I4 NTracers;              // number of tracers
+   I8 PayloadSize;           // size in bytes of the data after the header
+   std::uint64_t Checksum;   // checksum of the payload
+   char Time[MaxTimeLength]; // time of the state
+};
+
+// Computes the 64-bit FNV-1a checksum of a byte range
+std::uint64_t computeChecksum(const char *Data, std::size_t Size) {
+   std::uint64_t Hash = 14695981039346656037ULL;
+   for (std::size_t I = 0; I < Size; ++I) {
+      Hash ^= static_cast<unsigned char>(Data[I]);
+      Hash *= 1099511628211ULL;
+   }
+   return Hash;
+}
+
+// Returns the size in bytes of the payload for the input sizes
+I8 payloadSize(const CheckpointHeader &Header) {
+   const I8 NCells = Header.NCellsOwned;
+   const I8 NEdges = Header.NEdgesOwned;
+   const I8 NVert  = Header.NVertLevels;
+   return (NCells + NEdges) * sizeof(I4) +
+          (NCells * NVert + NEdges * NVert + Header.NTracers * NCells * NVert) *
+              sizeof(Real);
+}
+
+// Appends the owned part of a host array of [element, level] to a buffer
+template <class ArrayType>
+void packOwned(char *&Pos, const ArrayType &Arr, I4 NOwned, I4 NVertLevels) {
+   for (int IElem = 0; IElem < NOwned; ++IElem) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         std::memcpy(Pos, &Arr(IElem, K), sizeof(Real));
+         Pos += sizeof(Real);
+      }
+   }
+}
+
+// Extracts the owned part of a host array of [element, level] from a buffer
+template <class ArrayType>
+void unpackOwned(const char *&Pos, const ArrayType &Arr, I4 NOwned,
+                 I4 NVertLevels) {
+   for (int IElem = 0; IElem < NOwned; ++IElem) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         std::memcpy(&Arr(IElem, K), Pos, sizeof(Real));
+         Pos += sizeof(Real);
+      }
+   }
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Reads the options of the optional Checkpoint group of the input
+// configuration and enables fast checkpoints if requested
+int Checkpoint::init(const TimeInstant &StartTime // [in] start of intervals
+) {
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("Checkpoint"))
+      return Err;
+
+   Config CkptConfig("Checkpoint");
+   Err = OmegaConfig->get(CkptConfig);
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error retrieving Checkpoint group from Config");
+      return Err;
+   }
+
+   bool UseCheckpoints = false;
+   if (CkptConfig.existsVar("Enabled")) {
+      Err = CkptConfig.get("Enabled", UseCheckpoints);
+      if (Err != 0) {
+         LOG_ERROR("Checkpoint: error reading Enabled from Config");
+         return Err;
+      }
+   }
+   if (!UseCheckpoints)
+      return Err;
+
+   std::string InDirectory;
+   Err = CkptConfig.get("Directory", InDirectory);
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: Directory missing from Checkpoint Config");
+      return Err;
+   }
+
+   // Checkpoint interval, with the same options as the stream frequency
+   I4 Freq;
+   Err = CkptConfig.get("Freq", Freq);
+   if (Err != 0 or Freq < 1) {
+      LOG_ERROR("Checkpoint: missing or invalid Freq in Checkpoint Config");
+      return 1;
+   }
+
+   std::string FreqUnits;
+   Err = CkptConfig.get("FreqUnits", FreqUnits);
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: FreqUnits missing from Checkpoint Config");
+      return Err;
+   }
+   std::transform(FreqUnits.begin(), FreqUnits.end(), FreqUnits.begin(),
+                  [](unsigned char C) { return std::tolower(C); });
+
+   TimeUnits Units = TimeUnits::None;
+   if (FreqUnits == "years") {
+      Units = TimeUnits::Years;
+   } else if (FreqUnits == "months") {
+      Units = TimeUnits::Months;
+   } else if (FreqUnits == "days") {
+      Units = TimeUnits::Days;
+   } else if (FreqUnits == "hours") {
+      Units = TimeUnits::Hours;
+   } else if (FreqUnits == "minutes") {
+      Units = TimeUnits::Minutes;
+   } else if (FreqUnits == "seconds") {
+      Units = TimeUnits::Seconds;
+   } else {
+      LOG_ERROR("Checkpoint: unknown FreqUnits {}", FreqUnits);
+      return 1;
+   }
+   TimeInterval Interval(Freq, Units);
+
+   // Optional canonical restart stream written every few checkpoints
+   std::string InFlushStream;
+   I4 InFlushInterval = 1;
+   if (CkptConfig.existsVar("FlushStream")) {
+      Err = CkptConfig.get("FlushStream", InFlushStream);
+      if (Err != 0) {
+         LOG_ERROR("Checkpoint: error reading FlushStream from Config");
+         return Err;
+      }
+   }
+   if (CkptConfig.existsVar("FlushInterval")) {
+      Err = CkptConfig.get("FlushInterval", InFlushInterval);
+      if (Err != 0) {
+         LOG_ERROR("Checkpoint: error reading FlushInterval from Config");
+         return Err;
+      }
+   }
+
+   Err = enable(InDirectory, Interval, StartTime, InFlushStream,
+                InFlushInterval);
+   if (Err != 0)
+      return Err;
+
+   // Restart from the fast tier on startup, on by default
+   RestartEnabled = true;
+   if (CkptConfig.existsVar("RestartFromCheckpoint")) {
+      Err = CkptConfig.get("RestartFromCheckpoint", RestartEnabled);
+      if (Err != 0) {
+         LOG_ERROR("Checkpoint: error reading RestartFromCheckpoint");
+         return Err;
+      }
+   }
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Enables fast checkpoints written to a node-local directory at each interval
+int Checkpoint::enable(const std::string &InDirectory,   // [in] ckpt directory
+                       const TimeInterval &Interval,     // [in] between ckpts
+                       const TimeInstant &StartTime,     // [in] start of ckpts
+                       const std::string &InFlushStream, // [in] opt stream
+                       I4 InFlushInterval                // [in] ckpts per flush
+) {
+   if (InFlushInterval < 1) {
+      LOG_ERROR("Checkpoint: FlushInterval must be positive");
+      return 1;
+   }
+
+   // Each node creates the directory, which is local to the node
+   std::error_code ErrCode;
+   std::filesystem::create_directories(InDirectory, ErrCode);
+   if (ErrCode) {
+      LOG_ERROR("Checkpoint: unable to create directory {}: {}", InDirectory,
+                ErrCode.message());
+      return 1;
+   }
+
+   Directory       = InDirectory;
+   CheckpointAlarm = Alarm("Checkpoint", Interval, StartTime);
+   FlushStream     = InFlushStream;
+   FlushInterval   = InFlushInterval;
+   NumSinceFlush   = 0;
+   Enabled         = true;
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Returns the name of the checkpoint file of this task
+std::string Checkpoint::getFilename() {
+   const int MyTask = MachEnv::getDefault()->getMyTask();
+   return Directory + "/omega.ckpt." + std::to_string(MyTask) + ".bin";
+}
+
+//------------------------------------------------------------------------------
+// Writes a checkpoint if the checkpoint interval has ended at the current
+// time of the model clock
+int Checkpoint::write(const Clock &ModelClock // [in] model clock
+) {
+   int Err = 0;
+
+   if (!Enabled)
+      return Err;
+
+   const TimeInstant CurrTime = ModelClock.getCurrentTime();
+   CheckpointAlarm.updateStatus(CurrTime);
+   if (!CheckpointAlarm.isRinging())
+      return Err;
+
+   Err = writeNow(CurrTime);
+   CheckpointAlarm.reset(CurrTime);
+   if (Err != 0)
+      return Err;
+
+   // Write the canonical restart every FlushInterval checkpoints
+   ++NumSinceFlush;
+   if (!FlushStream.empty() and NumSinceFlush >= FlushInterval) {
+      Err = IOStream::write(FlushStream, ModelClock, true);
+      if (Err != 0)
+         LOG_ERROR("Checkpoint: error writing restart stream {}", FlushStream);
+      NumSinceFlush = 0;
+   }
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Takes a checkpoint of the current time level of the default state and
+// tracers and starts writing it in the background
+int Checkpoint::writeNow(const TimeInstant &Time // [in] time of state
+) {
+   int Err = 0;
+
+   TimerRegion CkptTimer("Checkpoint");
+
+   // Only one checkpoint is written at a time
+   Err = waitForPendingWrite();
+   if (Err != 0)
+      LOG_ERROR("Checkpoint: error writing previous checkpoint");
+
+   OceanState *State = OceanState::getDefault();
+   Decomp *DefDecomp = Decomp::getDefault();
+
+   CheckpointHeader Header;
+   std::memset(&Header, 0, sizeof(Header));
+   Header.Magic       = CheckpointMagic;
+   Header.Version     = CheckpointVersion;
+   Header.RealSize    = sizeof(Real);
+   Header.NCellsOwned = State->NCellsOwned;
+   Header.NEdgesOwned = State->NEdgesOwned;
+   Header.NVertLevels = State->NVertLevels;
+   Header.NTracers    = Tracers::getNumTracers();
+   Header.PayloadSize = payloadSize(Header);
+
+   std::string TimeStr = Time.getString(5, 0, "_");
+   if (TimeStr.size() >= MaxTimeLength) {
+      LOG_ERROR("Checkpoint: time string {} too long", TimeStr);
+      return 1;
+   }
+   std::strncpy(Header.Time, TimeStr.c_str(), MaxTimeLength - 1);
+
+   // Copy the current time level to the host
+   HostArray2DReal LayerThickH =
+       createHostMirrorCopy(State->LayerThickness[State->CurLevel]);
+   HostArray2DReal NormalVelH =
+       createHostMirrorCopy(State->NormalVelocity[State->CurLevel]);
+   Array3DReal TracerArray;
+   Err = Tracers::getAll(TracerArray, 0);
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error retrieving tracers");
+      return Err;
+   }
+   HostArray3DReal TracerArrayH = createHostMirrorCopy(TracerArray);
+
+   // Pack the global IDs and the owned data after the header
+   std::vector<char> Buffer(sizeof(Header) + Header.PayloadSize);
+   char *Pos = Buffer.data() + sizeof(Header);
+
+   std::memcpy(Pos, DefDecomp->CellIDH.data(), Header.NCellsOwned * sizeof(I4));
+   Pos += Header.NCellsOwned * sizeof(I4);
+   std::memcpy(Pos, DefDecomp->EdgeIDH.data(), Header.NEdgesOwned * sizeof(I4));
+   Pos += Header.NEdgesOwned * sizeof(I4);
+
+   packOwned(Pos, LayerThickH, Header.NCellsOwned, Header.NVertLevels);
+   packOwned(Pos, NormalVelH, Header.NEdgesOwned, Header.NVertLevels);
+   for (int ITracer = 0; ITracer < Header.NTracers; ++ITracer) {
+      auto TracerH =
+          Kokkos::subview(TracerArrayH, ITracer, Kokkos::ALL, Kokkos::ALL);
+      packOwned(Pos, TracerH, Header.NCellsOwned, Header.NVertLevels);
+   }
+
+   Header.Checksum =
+       computeChecksum(Buffer.data() + sizeof(Header), Header.PayloadSize);
+   std::memcpy(Buffer.data(), &Header, sizeof(Header));
+
+   // Write the file while the model continues
+   PendingWrite = std::async(std::launch::async, writeFile, getFilename(),
+                             std::move(Buffer));
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Writes a checkpoint buffer to a temporary file and renames it to the
+// checkpoint file once complete, so that an interrupted write never replaces
+// the previous checkpoint
+int Checkpoint::writeFile(const std::string Filename,    // [in] ckpt file
+                          const std::vector<char> Buffer // [in] contents
+) {
+   const std::string TmpFilename = Filename + ".tmp";
+
+   std::ofstream OutFile(TmpFilename, std::ios::binary | std::ios::trunc);
+   if (!OutFile)
+      return 1;
+   OutFile.write(Buffer.data(), Buffer.size());
+   OutFile.close();
+   if (!OutFile)
+      return 2;
+
+   std::error_code ErrCode;
+   std::filesystem::rename(TmpFilename, Filename, ErrCode);
+   if (ErrCode)
+      return 3;
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Reloads the current time level of the default state and tracers from the
+// fast tier if the checkpoint of every task is valid
+int Checkpoint::restart(TimeInstant &Time, // [inout] start time of run
+                        bool &Restarted    // [out] state was reloaded
+) {
+   int Err   = 0;
+   Restarted = false;
+
+   if (!Enabled)
+      return Err;
+
+   TimerRegion CkptTimer("Checkpoint");
+
+   // A checkpoint being written by this run must be complete
+   Err = waitForPendingWrite();
+   if (Err != 0)
+      LOG_ERROR("Checkpoint: error writing previous checkpoint");
+
+   MachEnv *DefEnv   = MachEnv::getDefault();
+   OceanState *State = OceanState::getDefault();
+   Decomp *DefDecomp = Decomp::getDefault();
+
+   // Read and check the checkpoint of this task
+   bool Valid = false;
+   CheckpointHeader Header;
+   std::vector<char> Payload;
+   std::string TimeStr;
+
+   std::ifstream InFile(getFilename(), std::ios::binary);
+   if (InFile) {
+      InFile.read(reinterpret_cast<char *>(&Header), sizeof(Header));
+      Valid = InFile and Header.Magic == CheckpointMagic and
+              Header.Version == CheckpointVersion and
+              Header.RealSize == sizeof(Real) and
+              Header.NCellsOwned == State->NCellsOwned and
+              Header.NEdgesOwned == State->NEdgesOwned and
+              Header.NVertLevels == State->NVertLevels and
+              Header.NTracers == Tracers::getNumTracers() and
+              Header.PayloadSize == payloadSize(Header);
+   }
+   if (Valid) {
+      Payload.resize(Header.PayloadSize);
+      InFile.read(Payload.data(), Header.PayloadSize);
+      Valid = InFile and computeChecksum(Payload.data(), Payload.size()) ==
+                             Header.Checksum;
+   }
+   if (Valid) {
+      // The checkpoint must be of the same decomposition
+      const I4 *CellIDs = reinterpret_cast<const I4 *>(Payload.data());
+      const I4 *EdgeIDs = CellIDs + Header.NCellsOwned;
+      Valid             = std::equal(CellIDs, CellIDs + Header.NCellsOwned,
+                                     DefDecomp->CellIDH.data()) and
+              std::equal(EdgeIDs, EdgeIDs + Header.NEdgesOwned,
+                         DefDecomp->EdgeIDH.data());
+      Header.Time[MaxTimeLength - 1] = '\0';
+      TimeStr                        = Header.Time;
+   }
+   InFile.close();
+
+   // All tasks must have a valid checkpoint of the same time
+   std::string MasterTimeStr = TimeStr;
+   Err                       = Broadcast(MasterTimeStr, DefEnv);
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error broadcasting checkpoint time");
+      return Err;
+   }
+   int LocalValid = (Valid and TimeStr == MasterTimeStr) ? 1 : 0;
+   int AllValid   = 0;
+   MPI_Allreduce(&LocalValid, &AllValid, 1, MPI_INT, MPI_MIN,
+                 DefEnv->getComm());
+   if (AllValid == 0) {
+      LOG_INFO("Checkpoint: no valid checkpoint in {}, starting from the "
+               "initial state",
+               Directory);
+      return Err;
+   }
+
+   // Replace the owned part of the current time level
+   HostArray2DReal LayerThickH =
+       createHostMirrorCopy(State->LayerThickness[State->CurLevel]);
+   HostArray2DReal NormalVelH =
+       createHostMirrorCopy(State->NormalVelocity[State->CurLevel]);
+   Array3DReal TracerArray;
+   Err = Tracers::getAll(TracerArray, 0);
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error retrieving tracers");
+      return Err;
+   }
+   HostArray3DReal TracerArrayH = createHostMirrorCopy(TracerArray);
+
+   const char *Pos = Payload.data() +
+                     (Header.NCellsOwned + Header.NEdgesOwned) * sizeof(I4);
+   unpackOwned(Pos, LayerThickH, Header.NCellsOwned, Header.NVertLevels);
+   unpackOwned(Pos, NormalVelH, Header.NEdgesOwned, Header.NVertLevels);
+   for (int ITracer = 0; ITracer < Header.NTracers; ++ITracer) {
+      auto TracerH =
+          Kokkos::subview(TracerArrayH, ITracer, Kokkos::ALL, Kokkos::ALL);
+      unpackOwned(Pos, TracerH, Header.NCellsOwned, Header.NVertLevels);
+   }
+
+   deepCopy(State->LayerThickness[State->CurLevel], LayerThickH);
+   deepCopy(State->NormalVelocity[State->CurLevel], NormalVelH);
+   deepCopy(TracerArray, TracerArrayH);
+
+   // Fill the halos, which are not part of the checkpoint
+   State->exchangeHalo(State->CurLevel);
+   Err = Tracers::exchangeHalo(0);
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error exchanging tracer halo");
+      return Err;
+   }
+
+   Calendar *CalendarPtr;
+   Err = Time.get(CalendarPtr);
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: unable to retrieve calendar of start time");
+      return Err;
+   }
+   Time      = TimeInstant(CalendarPtr, MasterTimeStr);
+   Restarted = true;
+
+   // The next checkpoint is at the first interval after the restart time
+   CheckpointAlarm.updateStatus(Time);
+   if (CheckpointAlarm.isRinging())
+      CheckpointAlarm.reset(Time);
+
+   LOG_INFO("Checkpoint: restarted from checkpoint of {} in {}", MasterTimeStr,
+            Directory);
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Returns true if the optional restart from the fast tier was requested
+bool Checkpoint::isRestartEnabled() { return Enabled and RestartEnabled; }
+
+//------------------------------------------------------------------------------
+// Waits for an outstanding background write to complete
+int Checkpoint::waitForPendingWrite() {
+
+   int Err = 0;
+
+   if (PendingWrite.valid())
+      Err = PendingWrite.get();
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Completes any background write and disables checkpoints
+int Checkpoint::finalize() {
+
+   int Err = waitForPendingWrite();
+   if (Err != 0)
+      LOG_ERROR("Checkpoint: error writing last checkpoint");
+
+   Enabled        = false;
+   RestartEnabled = false;
+
+   return Err;
+}
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,128 @@
+#ifndef OMEGA_CHECKPOINT_H
+#define OMEGA_CHECKPOINT_H
+//===-- ocn/Checkpoint.h - fast node-local checkpoints ----------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines a fast checkpoint tier for restarts
+///
+/// Restart files written through IOStreams are collective NetCDF files on the
+/// parallel file system, which limits how often they can be written. The
+/// Checkpoint class adds a fast tier: at each checkpoint interval, every task
+/// writes the owned part of the current time level of the default
+/// OceanState and Tracers, along with the global IDs of its owned cells and
+/// edges, as a raw binary file in a node-local directory. The data is copied
+/// to the host when the checkpoint is taken and the file is written by a
+/// background thread while the model continues. Every few checkpoints, an
+/// optional restart stream is written so that a canonical NetCDF restart
+/// exists on the parallel file system as well.
+///
+/// On startup, a run on the same decomposition can reload the state from the
+/// fast tier instead of a restart file. The checkpoint is only used if the
+/// file of every task is complete and matches the decomposition, otherwise
+/// the model starts as usual.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "TimeMgr.h"
+
+#include <future>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// The Checkpoint class writes and reads fast node-local checkpoints of the
+/// default ocean state. All members are static since there is one
+/// checkpoint tier for the model.
+class Checkpoint {
+
+ private:
+   static bool Enabled;            ///< fast checkpoints are written
+   static bool RestartEnabled;     ///< restart from the fast tier on startup
+   static std::string Directory;   ///< node-local checkpoint directory
+   static Alarm CheckpointAlarm;   ///< alarm ringing at each checkpoint
+   static std::string FlushStream; ///< NetCDF restart stream, if any
+   static I4 FlushInterval;        ///< checkpoints between stream writes
+   static I4 NumSinceFlush;        ///< checkpoints since last stream write
+
+   /// Outstanding background write of a checkpoint file
+   static std::future<int> PendingWrite;
+
+   /// Returns the name of the checkpoint file of this task
+   static std::string getFilename();
+
+   /// Writes a checkpoint buffer to a temporary file and renames it to the
+   /// checkpoint file once complete. Run by the background thread, it
+   /// returns an error code instead of logging.
+   static int
+   writeFile(const std::string Filename,    ///< [in] checkpoint file
+             const std::vector<char> Buffer ///< [in] file contents
+   );
+
+ public:
+   //---------------------------------------------------------------------------
+   /// Reads the options of the optional Checkpoint group of the input
+   /// configuration and enables fast checkpoints if requested, with the
+   /// checkpoint intervals starting at the input start time. Returns an
+   /// error code.
+   static int init(const TimeInstant &StartTime ///< [in] start of intervals
+   );
+
+   //---------------------------------------------------------------------------
+   /// Enables fast checkpoints written to a node-local directory at each
+   /// interval. If a flush stream is supplied, that stream is also written
+   /// after every FlushInterval checkpoints. Returns an error code.
+   static int
+   enable(const std::string &InDirectory,        ///< [in] checkpoint directory
+          const TimeInterval &Interval,          ///< [in] time between ckpts
+          const TimeInstant &StartTime,          ///< [in] start of intervals
+          const std::string &InFlushStream = "", ///< [in] opt restart stream
+          I4 InFlushInterval               = 1   ///< [in] ckpts between flush
+   );
+
+   //---------------------------------------------------------------------------
+   /// Writes a checkpoint if the checkpoint interval has ended at the
+   /// current time of the model clock and writes the flush stream if it is
+   /// due. Returns an error code.
+   static int write(const Clock &ModelClock ///< [in] model clock
+   );
+
+   //---------------------------------------------------------------------------
+   /// Takes a checkpoint of the current time level of the default state and
+   /// tracers labeled with the input time and starts writing it in the
+   /// background. Any previous write is completed first. Returns an error
+   /// code.
+   static int writeNow(const TimeInstant &Time ///< [in] time of state
+   );
+
+   //---------------------------------------------------------------------------
+   /// Reloads the current time level of the default state and tracers from
+   /// the fast tier if the checkpoint of every task is valid and matches the
+   /// current decomposition. On success, Restarted is true and the input
+   /// time is set to the checkpoint time, with the same calendar. Otherwise
+   /// the state is unchanged. Returns an error code.
+   static int restart(TimeInstant &Time, ///< [inout] start time of run
+                      bool &Restarted    ///< [out] state was reloaded
+   );
+
+   //---------------------------------------------------------------------------
+   /// Returns true if the optional restart from the fast tier was requested
+   static bool isRestartEnabled();
+
+   //---------------------------------------------------------------------------
+   /// Waits for an outstanding background write to complete. Returns the
+   /// error code of that write.
+   static int waitForPendingWrite();
+
+   //---------------------------------------------------------------------------
+   /// Completes any background write and disables checkpoints. Returns an
+   /// error code.
+   static int finalize();
+
+}; // end class Checkpoint
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_CHECKPOINT_H
@@ -0,0 +1,538 @@
+//===-- ocn/CouplerState.cpp - coupler import and export state --*- C++ -*-===//
+//
+// The CouplerState class stages the fields exchanged with the coupler in
+// device arrays, maps coupler memory in place where the device can access
+// it, and converts the imported fluxes to the surface forcing of the model
+// and the model state to the exported fields in fused kernels.
+//
+//===----------------------------------------------------------------------===//
+
+#include "CouplerState.h"
+#include "Config.h"
+#include "Field.h"
+#include "Logging.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "Timer.h"
+#include "Tracers.h"
+
+#include <utility>
+
+namespace OMEGA {
+
+// Static members
+Array1DReal CouplerState::SurfaceTemperatureFlux;
+Array1DReal CouplerState::SurfaceSalinityFlux;
+Array1DReal CouplerState::SurfaceThicknessFlux;
+Array1DReal CouplerState::SurfaceStressNormal;
+
+bool CouplerState::Enabled       = false;
+bool CouplerState::UnifiedMemory = false;
+
+I4 CouplerState::NCellsOwned = 0;
+I4 CouplerState::NCellsSize  = 0;
+I4 CouplerState::NEdgesOwned = 0;
+I4 CouplerState::NEdgesSize  = 0;
+
+HorzMesh *CouplerState::Mesh = nullptr;
+Halo *CouplerState::MeshHalo = nullptr;
+
+Kokkos::Array<Array1DReal, CouplerState::NumImports> CouplerState::Imports;
+Kokkos::Array<Array1DReal, CouplerState::NumExports> CouplerState::Exports;
+std::vector<Array1DReal> CouplerState::ImportStaging;
+std::vector<Array1DReal> CouplerState::ExportStaging;
+std::vector<HostArray1DReal> CouplerState::ImportHost;
+std::vector<HostArray1DReal> CouplerState::ExportHost;
+Array2DReal CouplerState::SurfaceStressCell;
+
+const std::string CouplerState::GroupName = "Coupler";
+
+const std::string CouplerState::ImportNames[NumImports] = {
+    "ShortWave",      "LongWaveDown",   "LongWaveUp",     "SensibleHeat",
+    "LatentHeat",     "Evaporation",    "Rain",           "Snow",
+    "RiverRunoff",    "IceFraction",    "IceHeat",        "IceFreshwater",
+    "IceSalt",        "AtmStressZonal", "AtmStressMerid", "IceStressZonal",
+    "IceStressMerid"};
+
+const std::string CouplerState::ExportNames[NumExports] = {
+    "SST", "SSS", "SSH", "CurrentZonal", "CurrentMerid"};
+
+//------------------------------------------------------------------------------
+// Reads the options of the optional Coupler group of the configuration
+int CouplerState::init() {
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("Coupler"))
+      return Err;
+
+   Config CouplerConfig("Coupler");
+   Err = OmegaConfig->get(CouplerConfig);
+   if (Err != 0) {
+      LOG_ERROR("CouplerState: error retrieving Coupler group from Config");
+      return Err;
+   }
+
+   bool UseCoupler = false;
+   if (CouplerConfig.existsVar("Enabled")) {
+      Err = CouplerConfig.get("Enabled", UseCoupler);
+      if (Err != 0) {
+         LOG_ERROR("CouplerState: error reading Enabled from Config");
+         return Err;
+      }
+   }
+   if (!UseCoupler)
+      return Err;
+
+   bool InUnifiedMemory = false;
+   if (CouplerConfig.existsVar("UnifiedMemory")) {
+      Err = CouplerConfig.get("UnifiedMemory", InUnifiedMemory);
+      if (Err != 0) {
+         LOG_ERROR("CouplerState: error reading UnifiedMemory from Config");
+         return Err;
+      }
+   }
+
+   return enable(InUnifiedMemory);
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Allocates the staging and forcing arrays on the default mesh
+int CouplerState::enable(bool InUnifiedMemory // [in] host memory on device
+) {
+   if (Enabled) {
+      LOG_ERROR("CouplerState: the coupler state is already enabled");
+      return 1;
+   }
+
+   Mesh     = HorzMesh::getDefault();
+   MeshHalo = Halo::getDefault();
+   if (Mesh == nullptr or MeshHalo == nullptr) {
+      LOG_ERROR("CouplerState: the default mesh must be initialized first");
+      return 1;
+   }
+   if (Tracers::IndxTemp == Tracers::IndxInvalid or
+       Tracers::IndxSalt == Tracers::IndxInvalid) {
+      LOG_ERROR("CouplerState: the Temp and Salt tracers must be defined");
+      return 1;
+   }
+
+   UnifiedMemory = InUnifiedMemory;
+   NCellsOwned   = Mesh->NCellsOwned;
+   NCellsSize    = Mesh->NCellsSize;
+   NEdgesOwned   = Mesh->NEdgesOwned;
+   NEdgesSize    = Mesh->NEdgesSize;
+
+   // Every field reads or writes its staging array until coupler memory is
+   // attached to it
+   ImportStaging.resize(NumImports);
+   ImportHost.resize(NumImports);
+   for (int I = 0; I < NumImports; ++I) {
+      ImportStaging[I] = Array1DReal("Import" + ImportNames[I], NCellsSize);
+      Imports[I]       = ImportStaging[I];
+   }
+   ExportStaging.resize(NumExports);
+   ExportHost.resize(NumExports);
+   for (int I = 0; I < NumExports; ++I) {
+      ExportStaging[I] = Array1DReal("Export" + ExportNames[I], NCellsSize);
+      Exports[I]       = ExportStaging[I];
+   }
+
+   SurfaceTemperatureFlux = Array1DReal("SurfaceTemperatureFlux", NCellsSize);
+   SurfaceSalinityFlux    = Array1DReal("SurfaceSalinityFlux", NCellsSize);
+   SurfaceThicknessFlux   = Array1DReal("SurfaceThicknessFlux", NCellsSize);
+   SurfaceStressNormal    = Array1DReal("SurfaceStressNormal", NEdgesSize);
+   SurfaceStressCell      = Array2DReal("SurfaceStressCell", NCellsSize, 2);
+
+   Enabled = true;
+
+   int Err = defineFields();
+   if (Err != 0) {
+      LOG_ERROR("CouplerState: error defining the forcing fields");
+      clear();
+      return Err;
+   }
+
+   return Err;
+
+} // end enable
+
+//------------------------------------------------------------------------------
+// Returns true if the coupler state is enabled
+bool CouplerState::isEnabled() { return Enabled; }
+
+//------------------------------------------------------------------------------
+// Returns true if attached host memory can be used on the device
+bool CouplerState::isDeviceAccessible() {
+   return UnifiedMemory or
+          Kokkos::SpaceAccessibility<ExecSpace, HostMemSpace>::accessible;
+}
+
+//------------------------------------------------------------------------------
+// Attaches coupler memory to an import field
+int CouplerState::attachImport(ImportField Index, // [in] import field
+                               Real *Data,        // [in] coupler memory
+                               I4 Size            // [in] number of entries
+) {
+   if (!Enabled or Index < 0 or Index >= NumImports or Data == nullptr or
+       Size < NCellsOwned) {
+      LOG_ERROR("CouplerState: invalid attachment of import field");
+      return 1;
+   }
+
+   if (isDeviceAccessible()) {
+      Imports[Index]    = Array1DReal(Data, Size);
+      ImportHost[Index] = HostArray1DReal();
+   } else {
+      Imports[Index]    = ImportStaging[Index];
+      ImportHost[Index] = HostArray1DReal(Data, Size);
+   }
+
+   return 0;
+
+} // end attachImport
+
+//------------------------------------------------------------------------------
+// Maps a device array to an import field
+int CouplerState::attachImport(ImportField Index,      // [in] import field
+                               const Array1DReal &Data // [in] device array
+) {
+   if (!Enabled or Index < 0 or Index >= NumImports or
+       Data.extent_int(0) < NCellsOwned) {
+      LOG_ERROR("CouplerState: invalid device array for import field");
+      return 1;
+   }
+
+   Imports[Index]    = Data;
+   ImportHost[Index] = HostArray1DReal();
+
+   return 0;
+
+} // end attachImport
+
+//------------------------------------------------------------------------------
+// Attaches coupler memory to an export field
+int CouplerState::attachExport(ExportField Index, // [in] export field
+                               Real *Data,        // [in] coupler memory
+                               I4 Size            // [in] number of entries
+) {
+   if (!Enabled or Index < 0 or Index >= NumExports or Data == nullptr or
+       Size < NCellsOwned) {
+      LOG_ERROR("CouplerState: invalid attachment of export field");
+      return 1;
+   }
+
+   if (isDeviceAccessible()) {
+      Exports[Index]    = Array1DReal(Data, Size);
+      ExportHost[Index] = HostArray1DReal();
+   } else {
+      Exports[Index]    = ExportStaging[Index];
+      ExportHost[Index] = HostArray1DReal(Data, Size);
+   }
+
+   return 0;
+
+} // end attachExport
+
+//------------------------------------------------------------------------------
+// Maps a device array to an export field
+int CouplerState::attachExport(ExportField Index,      // [in] export field
+                               const Array1DReal &Data // [in] device array
+) {
+   if (!Enabled or Index < 0 or Index >= NumExports or
+       Data.extent_int(0) < NCellsOwned) {
+      LOG_ERROR("CouplerState: invalid device array for export field");
+      return 1;
+   }
+
+   Exports[Index]    = Data;
+   ExportHost[Index] = HostArray1DReal();
+
+   return 0;
+
+} // end attachExport
+
+//------------------------------------------------------------------------------
+// Returns the device array read for an import field
+Array1DReal CouplerState::getImportArray(ImportField Index // [in] import field
+) {
+   return Imports[Index];
+}
+
+//------------------------------------------------------------------------------
+// Returns the device array written for an export field
+Array1DReal CouplerState::getExportArray(ExportField Index // [in] export field
+) {
+   return Exports[Index];
+}
+
+//------------------------------------------------------------------------------
+// Copies the imports that are not mapped to the device and computes the
+// surface forcing
+int CouplerState::importFields() {
+
+   if (!Enabled) {
+      LOG_ERROR("CouplerState: importFields called before enable");
+      return 1;
+   }
+
+   TimerRegion Timer("CouplerImport");
+
+   // Only the owned cells of host imports are copied
+   const auto OwnedCells = std::make_pair(0, NCellsOwned);
+   for (int I = 0; I < NumImports; ++I) {
+      if (ImportHost[I].size() > 0) {
+         auto Dst = Kokkos::subview(ImportStaging[I], OwnedCells);
+         auto Src = Kokkos::subview(ImportHost[I], OwnedCells);
+         deepCopy(Dst, Src);
+      }
+   }
+
+   // Merge the open ocean and ice fluxes with the ice fraction and convert
+   // them to kinematic tracer and thickness fluxes
+   const Kokkos::Array<Array1DReal, NumImports> Imp = Imports;
+
+   const Array1DReal TempFlux   = SurfaceTemperatureFlux;
+   const Array1DReal SaltFlux   = SurfaceSalinityFlux;
+   const Array1DReal ThickFlux  = SurfaceThicknessFlux;
+   const Array2DReal StressCell = SurfaceStressCell;
+
+   constexpr Real InvRhoCp  = 1._Real / (RhoSw * CpSw);
+   constexpr Real InvRhoFw  = 1._Real / RhoFw;
+   constexpr Real SaltScale = 1000._Real / RhoSw;
+
+   parallelFor(
+       {NCellsOwned}, KOKKOS_LAMBDA(int ICell) {
+          const Real IceFrac  = Imp[ImportIceFraction](ICell);
+          const Real OpenFrac = 1._Real - IceFrac;
+
+          const Real HeatOpen =
+              Imp[ImportShortWave](ICell) + Imp[ImportLongWaveDown](ICell) +
+              Imp[ImportLongWaveUp](ICell) + Imp[ImportSensibleHeat](ICell) +
+              Imp[ImportLatentHeat](ICell);
+          const Real FreshOpen = Imp[ImportEvaporation](ICell) +
+                                 Imp[ImportRain](ICell) +
+                                 Imp[ImportSnow](ICell);
+
+          const Real Heat =
+              OpenFrac * HeatOpen + IceFrac * Imp[ImportIceHeat](ICell);
+          const Real Fresh = OpenFrac * FreshOpen +
+                             IceFrac * Imp[ImportIceFreshwater](ICell) +
+                             Imp[ImportRiverRunoff](ICell);
+
+          TempFlux(ICell)  = Heat * InvRhoCp;
+          ThickFlux(ICell) = Fresh * InvRhoFw;
+          SaltFlux(ICell)  = IceFrac * Imp[ImportIceSalt](ICell) * SaltScale;
+
+          StressCell(ICell, 0) = OpenFrac * Imp[ImportAtmStressZonal](ICell) +
+                                 IceFrac * Imp[ImportIceStressZonal](ICell);
+          StressCell(ICell, 1) = OpenFrac * Imp[ImportAtmStressMerid](ICell) +
+                                 IceFrac * Imp[ImportIceStressMerid](ICell);
+       });
+
+   // The stress on the owned edges needs the stress of the neighboring
+   // halo cells
+   int Err = MeshHalo->exchangeFullArrayHalo(SurfaceStressCell, OnCell, 1);
+   if (Err != 0) {
+      LOG_ERROR("CouplerState: error exchanging the surface stress halo");
+      return Err;
+   }
+
+   // Project the stress averaged over the valid cells of each edge onto the
+   // edge normal
+   const Array2DI4 CellsOnEdge  = Mesh->CellsOnEdge;
+   const Array1DR8 AngleEdge    = Mesh->AngleEdge;
+   const Array1DReal NormStress = SurfaceStressNormal;
+   const I4 NCellsAll           = Mesh->NCellsAll;
+
+   parallelFor(
+       {NEdgesOwned}, KOKKOS_LAMBDA(int IEdge) {
+          Real StressZonal = 0;
+          Real StressMerid = 0;
+          Real NValid      = 0;
+          for (int J = 0; J < 2; ++J) {
+             const I4 JCell = CellsOnEdge(IEdge, J);
+             if (JCell >= 0 and JCell < NCellsAll) {
+                StressZonal += StressCell(JCell, 0);
+                StressMerid += StressCell(JCell, 1);
+                NValid += 1;
+             }
+          }
+          const Real Angle = AngleEdge(IEdge);
+          NormStress(IEdge) =
+              NValid > 0 ? (StressZonal * Kokkos::cos(Angle) +
+                            StressMerid * Kokkos::sin(Angle)) /
+                               NValid
+                         : 0;
+       });
+
+   return 0;
+
+} // end importFields
+
+//------------------------------------------------------------------------------
+// Computes the exports from the current state and copies the exports that
+// are not mapped to the coupler memory
+int CouplerState::exportFields() {
+
+   if (!Enabled) {
+      LOG_ERROR("CouplerState: exportFields called before enable");
+      return 1;
+   }
+
+   TimerRegion Timer("CouplerExport");
+
+   OceanState *State = OceanState::getDefault();
+   if (State == nullptr) {
+      LOG_ERROR("CouplerState: the default state must be initialized first");
+      return 1;
+   }
+
+   Array3DReal TracerArray;
+   int Err = Tracers::getAll(TracerArray, 0);
+   if (Err != 0) {
+      LOG_ERROR("CouplerState: error retrieving the current tracers");
+      return Err;
+   }
+
+   const Kokkos::Array<Array1DReal, NumExports> Exp = Exports;
+
+   const Array2DReal LayerThick  = State->LayerThickness[State->CurLevel];
+   const Array2DReal NormalVel   = State->NormalVelocity[State->CurLevel];
+   const Array1DI4 MinLevelCell  = Mesh->MinLevelCell;
+   const Array1DI4 MaxLevelCell  = Mesh->MaxLevelCell;
+   const Array1DR8 BottomDepth   = Mesh->BottomDepth;
+   const Array1DR8 AreaCell      = Mesh->AreaCell;
+   const Array1DI4 OffsetsOnCell = Mesh->OffsetsOnCell;
+   const Array1DI4 EdgesOnCell   = Mesh->EdgesOnCellCSR;
+   const Array1DR8 DvEdge        = Mesh->DvEdge;
+   const Array1DR8 DcEdge        = Mesh->DcEdge;
+   const Array1DR8 AngleEdge     = Mesh->AngleEdge;
+   const I4 IndxTemp             = Tracers::IndxTemp;
+   const I4 IndxSalt             = Tracers::IndxSalt;
+
+   // The surface fields are taken at the first active level of each cell
+   // and the surface current is reconstructed from the normal velocities of
+   // the edges of the cell (Perot et al. 2006)
+   parallelFor(
+       {NCellsOwned}, KOKKOS_LAMBDA(int ICell) {
+          const I4 KTop = MinLevelCell(ICell);
+
+          Real Column = 0;
+          for (int K = KTop; K <= MaxLevelCell(ICell); ++K)
+             Column += LayerThick(ICell, K);
+
+          Real CurrentZonal = 0;
+          Real CurrentMerid = 0;
+          for (int J = OffsetsOnCell(ICell); J < OffsetsOnCell(ICell + 1);
+               ++J) {
+             const I4 JEdge   = EdgesOnCell(J);
+             const Real Angle = AngleEdge(JEdge);
+             const Real Wgt   = 0.5_Real * DvEdge(JEdge) * DcEdge(JEdge) *
+                              NormalVel(JEdge, KTop);
+             CurrentZonal += Wgt * Kokkos::cos(Angle);
+             CurrentMerid += Wgt * Kokkos::sin(Angle);
+          }
+          const Real InvArea = 1._Real / AreaCell(ICell);
+
+          Exp[ExportSST](ICell)          = TracerArray(IndxTemp, ICell, KTop);
+          Exp[ExportSSS](ICell)          = TracerArray(IndxSalt, ICell, KTop);
+          Exp[ExportSSH](ICell)          = Column - BottomDepth(ICell);
+          Exp[ExportCurrentZonal](ICell) = CurrentZonal * InvArea;
+          Exp[ExportCurrentMerid](ICell) = CurrentMerid * InvArea;
+       });
+
+   // Only the owned cells of host exports are copied
+   const auto OwnedCells = std::make_pair(0, NCellsOwned);
+   for (int I = 0; I < NumExports; ++I) {
+      if (ExportHost[I].size() > 0) {
+         auto Dst = Kokkos::subview(ExportHost[I], OwnedCells);
+         auto Src = Kokkos::subview(ExportStaging[I], OwnedCells);
+         deepCopy(Dst, Src);
+      }
+   }
+
+   return 0;
+
+} // end exportFields
+
+//------------------------------------------------------------------------------
+// Defines the forcing fields and adds them to the Coupler field group
+int CouplerState::defineFields() {
+
+   int Err = 0;
+
+   auto ForcingGroup = FieldGroup::create(GroupName);
+   if (ForcingGroup == nullptr)
+      return 1;
+
+   std::vector<std::string> CellDims = {"NCells"};
+   std::vector<std::string> EdgeDims = {"NEdges"};
+
+   auto TempFluxField = Field::create(
+       "SurfaceTemperatureFlux", "Surface flux of potential temperature",
+       "degC m s-1", "", -9.99E+10, 9.99E+10, -9.99E+30, 1, CellDims);
+   auto SaltFluxField = Field::create(
+       "SurfaceSalinityFlux", "Surface flux of absolute salinity",
+       "g kg-1 m s-1", "", -9.99E+10, 9.99E+10, -9.99E+30, 1, CellDims);
+   auto ThickFluxField = Field::create(
+       "SurfaceThicknessFlux", "Surface flux of layer thickness", "m s-1", "",
+       -9.99E+10, 9.99E+10, -9.99E+30, 1, CellDims);
+   auto StressField = Field::create(
+       "SurfaceStressNormal", "Surface stress normal to edge", "N m-2",
+       "surface_downward_stress", -9.99E+10, 9.99E+10, -9.99E+30, 1, EdgeDims);
+   if (TempFluxField == nullptr or SaltFluxField == nullptr or
+       ThickFluxField == nullptr or StressField == nullptr)
+      return 1;
+
+   Err += TempFluxField->attachData<Array1DReal>(SurfaceTemperatureFlux);
+   Err += SaltFluxField->attachData<Array1DReal>(SurfaceSalinityFlux);
+   Err += ThickFluxField->attachData<Array1DReal>(SurfaceThicknessFlux);
+   Err += StressField->attachData<Array1DReal>(SurfaceStressNormal);
+
+   Err += FieldGroup::addFieldToGroup("SurfaceTemperatureFlux", GroupName);
+   Err += FieldGroup::addFieldToGroup("SurfaceSalinityFlux", GroupName);
+   Err += FieldGroup::addFieldToGroup("SurfaceThicknessFlux", GroupName);
+   Err += FieldGroup::addFieldToGroup("SurfaceStressNormal", GroupName);
+
+   return Err;
+
+} // end defineFields
+
+//------------------------------------------------------------------------------
+// Removes the forcing fields and deallocates all arrays
+void CouplerState::clear() {
+
+   if (FieldGroup::exists(GroupName))
+      FieldGroup::destroy(GroupName);
+   for (const std::string &FieldName :
+        {"SurfaceTemperatureFlux", "SurfaceSalinityFlux",
+         "SurfaceThicknessFlux", "SurfaceStressNormal"}) {
+      if (Field::exists(FieldName))
+         Field::destroy(FieldName);
+   }
+
+   for (int I = 0; I < NumImports; ++I)
+      Imports[I] = Array1DReal();
+   for (int I = 0; I < NumExports; ++I)
+      Exports[I] = Array1DReal();
+   ImportStaging.clear();
+   ExportStaging.clear();
+   ImportHost.clear();
+   ExportHost.clear();
+
+   SurfaceTemperatureFlux = Array1DReal();
+   SurfaceSalinityFlux    = Array1DReal();
+   SurfaceThicknessFlux   = Array1DReal();
+   SurfaceStressNormal    = Array1DReal();
+   SurfaceStressCell      = Array2DReal();
+
+   Mesh     = nullptr;
+   MeshHalo = nullptr;
+   Enabled  = false;
+
+} // end clear
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,208 @@
+#ifndef OMEGA_COUPLERSTATE_H
+#define OMEGA_COUPLERSTATE_H
+//===-- ocn/CouplerState.h - coupler import and export state ----*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the import and export state exchanged with a coupler
+///
+/// When Omega runs as a component of E3SM, the coupler supplies surface
+/// fluxes each coupling interval and receives the surface state of the ocean.
+/// The CouplerState class stages this data in preallocated device arrays on
+/// the owned cells of the default mesh. Each coupler field can be attached
+/// as a device array or as host memory. Host memory is mapped without a copy
+/// when it is accessible from the device (unified memory systems or CPU
+/// builds) and is otherwise copied once to or from its staging array. The
+/// imported fluxes are merged with the sea ice fraction and converted to the
+/// tracer, thickness and stress forcing of the model in one kernel, and the
+/// exported fields are computed from the current state in one kernel.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// The CouplerState class holds the fields exchanged with the coupler and
+/// the surface forcing derived from them. All members are static since
+/// there is one coupler interface for the model.
+class CouplerState {
+
+ public:
+   /// Fields imported from the coupler on the owned cells. All fluxes are
+   /// positive into the ocean. Fluxes from the atmosphere are over the open
+   /// ocean and fluxes from sea ice are under the ice.
+   enum ImportField : I4 {
+      ImportShortWave,      ///< net shortwave heat flux (W m-2)
+      ImportLongWaveDown,   ///< downward longwave heat flux (W m-2)
+      ImportLongWaveUp,     ///< upward longwave heat flux (W m-2)
+      ImportSensibleHeat,   ///< sensible heat flux (W m-2)
+      ImportLatentHeat,     ///< latent heat flux (W m-2)
+      ImportEvaporation,    ///< evaporation flux (kg m-2 s-1)
+      ImportRain,           ///< rain flux (kg m-2 s-1)
+      ImportSnow,           ///< snow flux (kg m-2 s-1)
+      ImportRiverRunoff,    ///< river runoff flux (kg m-2 s-1)
+      ImportIceFraction,    ///< sea ice area fraction
+      ImportIceHeat,        ///< heat flux under sea ice (W m-2)
+      ImportIceFreshwater,  ///< freshwater flux under sea ice (kg m-2 s-1)
+      ImportIceSalt,        ///< salt flux under sea ice (kg m-2 s-1)
+      ImportAtmStressZonal, ///< zonal wind stress (N m-2)
+      ImportAtmStressMerid, ///< meridional wind stress (N m-2)
+      ImportIceStressZonal, ///< zonal ice-ocean stress (N m-2)
+      ImportIceStressMerid, ///< meridional ice-ocean stress (N m-2)
+      NumImports
+   };
+
+   /// Fields exported to the coupler on the owned cells
+   enum ExportField : I4 {
+      ExportSST,          ///< sea surface temperature (degC)
+      ExportSSS,          ///< sea surface salinity (g kg-1)
+      ExportSSH,          ///< sea surface height (m)
+      ExportCurrentZonal, ///< zonal surface current (m s-1)
+      ExportCurrentMerid, ///< meridional surface current (m s-1)
+      NumExports
+   };
+
+   // Reference densities and heat capacity for the unit conversions
+   static constexpr Real RhoSw = 1026.0_Real; ///< seawater density (kg m-3)
+   static constexpr Real RhoFw = 1000.0_Real; ///< freshwater density (kg m-3)
+   static constexpr Real CpSw  = 3996.0_Real; ///< seawater heat cap (J/kg/K)
+
+   // Surface forcing on the owned cells and edges, updated by importFields
+
+   static Array1DReal SurfaceTemperatureFlux; ///< temp flux (degC m s-1)
+   static Array1DReal SurfaceSalinityFlux;    ///< salt flux (g kg-1 m s-1)
+   static Array1DReal SurfaceThicknessFlux;   ///< thickness flux (m s-1)
+   static Array1DReal SurfaceStressNormal;    ///< stress normal to edge (N m-2)
+
+   // Methods
+
+   //---------------------------------------------------------------------------
+   /// Reads the options of the optional Coupler group of the input
+   /// configuration and enables the coupler state if requested. Must be
+   /// called after the default mesh, state and tracers are initialized.
+   /// Returns an error code.
+   static int init();
+
+   //---------------------------------------------------------------------------
+   /// Allocates the staging and forcing arrays on the default mesh. If
+   /// UnifiedMemory is true, host memory attached to the coupler fields is
+   /// assumed to be accessible from the device. Returns an error code.
+   static int enable(bool InUnifiedMemory ///< [in] host memory on device
+   );
+
+   //---------------------------------------------------------------------------
+   /// Returns true if the coupler state is enabled
+   static bool isEnabled();
+
+   //---------------------------------------------------------------------------
+   /// Attaches coupler memory of at least NCellsOwned entries to an import
+   /// field, eg the data of a MOAB tag. The memory is read in place if it is
+   /// accessible from the device and is otherwise copied to the staging
+   /// array by importFields. Returns an error code.
+   static int attachImport(ImportField Index, ///< [in] import field
+                           Real *Data,        ///< [in] coupler memory
+                           I4 Size            ///< [in] number of entries
+   );
+
+   /// Maps a device array of at least NCellsOwned entries to an import
+   /// field, which is read in place. Returns an error code.
+   static int attachImport(ImportField Index,      ///< [in] import field
+                           const Array1DReal &Data ///< [in] device array
+   );
+
+   //---------------------------------------------------------------------------
+   /// Attaches coupler memory of at least NCellsOwned entries to an export
+   /// field. The memory is written in place if it is accessible from the
+   /// device and is otherwise copied from the staging array by exportFields.
+   /// Returns an error code.
+   static int attachExport(ExportField Index, ///< [in] export field
+                           Real *Data,        ///< [in] coupler memory
+                           I4 Size            ///< [in] number of entries
+   );
+
+   /// Maps a device array of at least NCellsOwned entries to an export
+   /// field, which is written in place. Returns an error code.
+   static int attachExport(ExportField Index,      ///< [in] export field
+                           const Array1DReal &Data ///< [in] device array
+   );
+
+   //---------------------------------------------------------------------------
+   /// Returns the device array read for an import field, which the coupler
+   /// may also fill directly
+   static Array1DReal getImportArray(ImportField Index ///< [in] import field
+   );
+
+   /// Returns the device array written for an export field
+   static Array1DReal getExportArray(ExportField Index ///< [in] export field
+   );
+
+   //---------------------------------------------------------------------------
+   /// Copies any imports that are not mapped in place to the device, then
+   /// merges and converts the imported fluxes to the surface forcing.
+   /// Returns an error code.
+   static int importFields();
+
+   //---------------------------------------------------------------------------
+   /// Computes the export fields from the current time level of the default
+   /// state and tracers, then copies any exports that are not mapped in
+   /// place to the coupler memory. Returns an error code.
+   static int exportFields();
+
+   //---------------------------------------------------------------------------
+   /// Removes the forcing fields and deallocates all arrays
+   static void clear();
+
+   /// Names of the import and export fields
+   static const std::string ImportNames[NumImports];
+   static const std::string ExportNames[NumExports];
+
+ private:
+   static bool Enabled;       ///< coupler state is allocated
+   static bool UnifiedMemory; ///< attached host memory is device accessible
+
+   static I4 NCellsOwned; ///< Number of cells owned by this task
+   static I4 NCellsSize;  ///< Array size for cell arrays
+   static I4 NEdgesOwned; ///< Number of edges owned by this task
+   static I4 NEdgesSize;  ///< Array size for edge arrays
+
+   static HorzMesh *Mesh; ///< Default mesh
+   static Halo *MeshHalo; ///< Halo of the default mesh
+
+   /// Device arrays read and written by the kernels, either the staging
+   /// arrays or coupler memory mapped in place
+   static Kokkos::Array<Array1DReal, NumImports> Imports;
+   static Kokkos::Array<Array1DReal, NumExports> Exports;
+
+   /// Preallocated staging arrays
+   static std::vector<Array1DReal> ImportStaging;
+   static std::vector<Array1DReal> ExportStaging;
+
+   /// Coupler host memory that is copied to or from the staging arrays,
+   /// empty for fields that are mapped in place
+   static std::vector<HostArray1DReal> ImportHost;
+   static std::vector<HostArray1DReal> ExportHost;
+
+   /// Merged surface stress at cell centers, with the zonal and meridional
+   /// components as the second index
+   static Array2DReal SurfaceStressCell;
+
+   /// Name of the field group of the forcing fields
+   static const std::string GroupName;
+
+   /// Returns true if attached host memory can be used on the device
+   static bool isDeviceAccessible();
+
+   /// Defines the forcing fields and adds them to the Coupler group
+   static int defineFields();
+
+}; // end class CouplerState
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_COUPLERSTATE_H
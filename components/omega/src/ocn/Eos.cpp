@@ -0,0 +1,151 @@
+//===-- ocn/Eos.cpp - equation of state -------------------------*- C++ -*-===//
+//
+// The Eos class reads the equation of state options from the Config and
+// computes the density, specific volume and the thermal expansion and
+// haline contraction coefficients from the temperature and salinity tracers
+// in one fused kernel over all cells and vertical chunks.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Eos.h"
+#include "Config.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
+#include "Tracers.h"
+
+namespace OMEGA {
+
+// Static members
+Array2DReal Eos::Density;
+Array2DReal Eos::SpecVol;
+Array2DReal Eos::ThermalExpansion;
+Array2DReal Eos::HalineContraction;
+
+EosType Eos::EosChoice = EosType::Linear;
+LinearEos Eos::LinEos;
+
+I4 Eos::NCellsAll   = 0;
+I4 Eos::NVertLevels = 0;
+
+//------------------------------------------------------------------------------
+// Reads the Eos options and allocates the arrays on the default mesh
+int Eos::init() {
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("Eos")) {
+      Config EosConfig("Eos");
+      Err = OmegaConfig->get(EosConfig);
+      if (Err != 0) {
+         LOG_ERROR("Eos: error retrieving Eos group from Config");
+         return Err;
+      }
+
+      if (EosConfig.existsVar("EosType")) {
+         std::string EosName;
+         Err = EosConfig.get("EosType", EosName);
+         if (Err != 0) {
+            LOG_ERROR("Eos: error reading EosType from Config");
+            return Err;
+         }
+         EosChoice = getEosType(EosName);
+         if (EosChoice == EosType::Invalid) {
+            LOG_ERROR("Eos: unknown EosType {}", EosName);
+            return 1;
+         }
+      }
+
+      if (EosConfig.existsGroup("Linear")) {
+         Config LinConfig("Linear");
+         Err = EosConfig.get(LinConfig);
+         if (Err != 0) {
+            LOG_ERROR("Eos: error retrieving Linear group from Config");
+            return Err;
+         }
+         for (auto &Coeff : {std::make_pair("RhoRef", &LinEos.RhoRef),
+                             std::make_pair("DRhoDT", &LinEos.DRhoDT),
+                             std::make_pair("DRhoDS", &LinEos.DRhoDS),
+                             std::make_pair("TRef", &LinEos.TRef),
+                             std::make_pair("SRef", &LinEos.SRef)}) {
+            if (LinConfig.existsVar(Coeff.first)) {
+               Err = LinConfig.get(Coeff.first, *Coeff.second);
+               if (Err != 0) {
+                  LOG_ERROR("Eos: error reading {} from Config", Coeff.first);
+                  return Err;
+               }
+            }
+         }
+      }
+   }
+
+   HorzMesh *DefMesh = HorzMesh::getDefault();
+   NCellsAll         = DefMesh->NCellsAll;
+   NVertLevels       = DefMesh->NVertLevels;
+   const I4 NCells   = DefMesh->NCellsSize;
+
+   Density = createFirstTouchArray<Array2DReal>("Density", NCells, NVertLevels);
+   SpecVol = createFirstTouchArray<Array2DReal>("SpecVol", NCells, NVertLevels);
+   ThermalExpansion = createFirstTouchArray<Array2DReal>("ThermalExpansion",
+                                                         NCells, NVertLevels);
+   HalineContraction = createFirstTouchArray<Array2DReal>(
+       "HalineContraction", NCells, NVertLevels);
+
+   return Err;
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Computes all EOS quantities from the temperature and salinity tracers
+void Eos::computeEosArrays(const Array3DReal &TracerArray // [in] tracers
+) {
+
+   OMEGA_SCOPE(LocDensity, Density);
+   OMEGA_SCOPE(LocSpecVol, SpecVol);
+   OMEGA_SCOPE(LocThermalExpansion, ThermalExpansion);
+   OMEGA_SCOPE(LocHalineContraction, HalineContraction);
+
+   const I4 IndxTemp = Tracers::IndxTemp;
+   const I4 IndxSalt = Tracers::IndxSalt;
+   const int NChunks = numVertChunks(VecLength, NVertLevels);
+
+   switch (EosChoice) {
+   case EosType::Linear: {
+      const LinearEos LocLinEos = LinEos;
+      parallelFor(
+          "computeLinearEos", {NCellsAll, NChunks},
+          KOKKOS_LAMBDA(int ICell, int KChunk) {
+             LocLinEos(LocDensity, LocSpecVol, LocThermalExpansion,
+                       LocHalineContraction, ICell, KChunk, TracerArray,
+                       IndxTemp, IndxSalt);
+          });
+      break;
+   }
+   default:
+      LOG_ERROR("Eos: invalid equation of state");
+   }
+
+} // end computeEosArrays
+
+//------------------------------------------------------------------------------
+// Converts a string to an equation of state type
+EosType Eos::getEosType(const std::string &EosName // [in] EOS name
+) {
+   if (EosName == "Linear")
+      return EosType::Linear;
+   return EosType::Invalid;
+} // end getEosType
+
+//------------------------------------------------------------------------------
+// Deallocates the arrays
+void Eos::clear() {
+   Density           = Array2DReal();
+   SpecVol           = Array2DReal();
+   ThermalExpansion  = Array2DReal();
+   HalineContraction = Array2DReal();
+   EosChoice         = EosType::Linear;
+   LinEos            = LinearEos();
+} // end clear
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
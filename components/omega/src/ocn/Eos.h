@@ -0,0 +1,120 @@
+#ifndef OMEGA_EOS_H
+#define OMEGA_EOS_H
+//===-- ocn/Eos.h - equation of state ---------------------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the equation of state of seawater
+///
+/// The Eos class computes the density, specific volume and the thermal
+/// expansion and haline contraction coefficients of seawater from the
+/// temperature and salinity tracers on all cells and levels of the default
+/// mesh. All four quantities are computed in a single kernel so that the
+/// tracers are read once per evaluation. The equation of state is selected
+/// with the optional Eos group of the input configuration; currently only
+/// a linear equation of state is available.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "HorzMesh.h"
+#include "OmegaKokkos.h"
+
+#include <string>
+
+namespace OMEGA {
+
+/// Available equations of state
+enum class EosType {
+   Linear, ///< linear in temperature and salinity
+   Invalid ///< unknown or unsupported
+};
+
+/// Linear equation of state
+///    Rho = RhoRef + DRhoDT * (T - TRef) + DRhoDS * (S - SRef)
+/// The coefficients are members of the functor, so they are passed to the
+/// kernel by value and reside in constant or register memory on devices.
+class LinearEos {
+ public:
+   Real RhoRef = 1000.0_Real; ///< density at the reference point (kg m-3)
+   Real DRhoDT = -0.2_Real;   ///< density change with temp (kg m-3 degC-1)
+   Real DRhoDS = 0.8_Real;    ///< density change with salt (kg m-3 (g/kg)-1)
+   Real TRef   = 5.0_Real;    ///< reference temperature (degC)
+   Real SRef   = 35.0_Real;   ///< reference salinity (g kg-1)
+
+   /// Computes all EOS quantities on a vertical chunk of a cell
+   template <int W = VecLength>
+   KOKKOS_FUNCTION void operator()(const Array2DReal &Density,
+                                   const Array2DReal &SpecVol,
+                                   const Array2DReal &ThermalExpansion,
+                                   const Array2DReal &HalineContraction,
+                                   int ICell, int KChunk,
+                                   const Array3DReal &TracerArray,
+                                   I4 IndxTemp, I4 IndxSalt) const {
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, Density);
+
+      for (int KVec = 0; KVec < KLen; ++KVec) {
+         const int K       = KStart + KVec;
+         const Real Temp   = TracerArray(IndxTemp, ICell, K);
+         const Real Salt   = TracerArray(IndxSalt, ICell, K);
+         const Real Rho    = RhoRef + DRhoDT * (Temp - TRef) +
+                             DRhoDS * (Salt - SRef);
+         const Real InvRho = 1._Real / Rho;
+
+         Density(ICell, K)           = Rho;
+         SpecVol(ICell, K)           = InvRho;
+         ThermalExpansion(ICell, K)  = -DRhoDT * InvRho;
+         HalineContraction(ICell, K) = DRhoDS * InvRho;
+      }
+   }
+};
+
+/// The Eos class holds the selected equation of state and the arrays it
+/// computes. All members are static since there is one equation of state
+/// for the model.
+class Eos {
+
+ public:
+   /// Equation of state quantities on [Cell, Vert] of the default mesh
+   static Array2DReal Density;           ///< in situ density (kg m-3)
+   static Array2DReal SpecVol;           ///< specific volume (m3 kg-1)
+   static Array2DReal ThermalExpansion;  ///< -1/rho drho/dT (degC-1)
+   static Array2DReal HalineContraction; ///< 1/rho drho/dS ((g/kg)-1)
+
+   /// Selected equation of state
+   static EosType EosChoice;
+
+   /// Coefficients of the linear equation of state
+   static LinearEos LinEos;
+
+   //---------------------------------------------------------------------------
+   /// Reads the options of the optional Eos group of the input configuration
+   /// and allocates the arrays on the default mesh. Must be called after the
+   /// default mesh is initialized. Returns an error code.
+   static int init();
+
+   //---------------------------------------------------------------------------
+   /// Computes the density, specific volume, thermal expansion and haline
+   /// contraction on all cells and levels from the temperature and salinity
+   /// of a tracer array with dimensions [Tracer, Cell, Vert]
+   static void computeEosArrays(const Array3DReal &TracerArray ///< [in]
+   );
+
+   //---------------------------------------------------------------------------
+   /// Converts a string to an equation of state type, Invalid if unknown
+   static EosType getEosType(const std::string &EosName ///< [in] EOS name
+   );
+
+   //---------------------------------------------------------------------------
+   /// Deallocates the arrays
+   static void clear();
+
+ private:
+   static I4 NCellsAll;   ///< number of cells to compute
+   static I4 NVertLevels; ///< number of vertical levels
+};
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_EOS_H
@@ -0,0 +1,425 @@
+//===-- ocn/Forcing.cpp - surface forcing from input files ------*- C++ -*-===//
+//
+// The Forcing class reads the surface forcing records through an input
+// IOStream, keeps the two records bracketing the current time on the device
+// and interpolates them to the current time in one kernel. The record after
+// the bracketing records is read ahead on a background thread so that the
+// time loop does not wait for the forcing files.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Forcing.h"
+#include "Config.h"
+#include "Field.h"
+#include "IOStream.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+namespace OMEGA {
+
+// Static members
+bool Forcing::Enabled         = false;
+bool Forcing::Started         = false;
+bool Forcing::Prefetch        = true;
+bool Forcing::PrefetchPending = false;
+
+std::string Forcing::StreamName;
+
+I4 Forcing::NCellsOwned = 0;
+I4 Forcing::NCellsSize  = 0;
+
+TimeInstant Forcing::RecordTime;
+TimeInterval Forcing::RecordInt;
+TimeInstant Forcing::PrevRecordTime;
+TimeInstant Forcing::NextRecordTime;
+
+Kokkos::Array<Array1DReal, Forcing::NumForcing> Forcing::PrevRecord;
+Kokkos::Array<Array1DReal, Forcing::NumForcing> Forcing::NextRecord;
+Kokkos::Array<Array1DReal, Forcing::NumForcing> Forcing::Interpolated;
+std::vector<HostArray1DReal> Forcing::ReadBuffer;
+
+const std::string Forcing::GroupName = "Forcing";
+
+const std::string Forcing::FieldNames[NumForcing] = {
+    "WindStressZonal", "WindStressMeridional", "SurfaceHeatFlux",
+    "SurfaceFreshwaterFlux"};
+
+//------------------------------------------------------------------------------
+// Reads the options of the optional Forcing group of the configuration
+int Forcing::init(const TimeInstant &StartTime // [in] sim start time
+) {
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("Forcing"))
+      return Err;
+
+   Config ForcingConfig("Forcing");
+   Err = OmegaConfig->get(ForcingConfig);
+   if (Err != 0) {
+      LOG_ERROR("Forcing: error retrieving Forcing group from Config");
+      return Err;
+   }
+
+   bool UseForcing = false;
+   if (ForcingConfig.existsVar("Enabled")) {
+      Err = ForcingConfig.get("Enabled", UseForcing);
+      if (Err != 0) {
+         LOG_ERROR("Forcing: error reading Enabled from Config");
+         return Err;
+      }
+   }
+   if (!UseForcing)
+      return Err;
+
+   std::string InStreamName = "Forcing";
+   if (ForcingConfig.existsVar("StreamName")) {
+      Err = ForcingConfig.get("StreamName", InStreamName);
+      if (Err != 0) {
+         LOG_ERROR("Forcing: error reading StreamName from Config");
+         return Err;
+      }
+   }
+
+   std::string RecordTimeStr;
+   I4 RecordFreq = 0;
+   std::string RecordUnits;
+   Err = ForcingConfig.get("RecordTime", RecordTimeStr);
+   Err += ForcingConfig.get("RecordFreq", RecordFreq);
+   Err += ForcingConfig.get("RecordUnits", RecordUnits);
+   if (Err != 0) {
+      LOG_ERROR("Forcing: RecordTime, RecordFreq and RecordUnits are "
+                "required in Config");
+      return Err;
+   }
+
+   bool InPrefetch = true;
+   if (ForcingConfig.existsVar("Prefetch")) {
+      Err = ForcingConfig.get("Prefetch", InPrefetch);
+      if (Err != 0) {
+         LOG_ERROR("Forcing: error reading Prefetch from Config");
+         return Err;
+      }
+   }
+
+   // Records are defined on the calendar of the simulation
+   Calendar *CalPtr = nullptr;
+   Err              = StartTime.get(CalPtr);
+   if (Err != 0) {
+      LOG_ERROR("Forcing: error retrieving the calendar of the start time");
+      return Err;
+   }
+   TimeInstant InRecordTime(CalPtr, RecordTimeStr);
+
+   std::transform(RecordUnits.begin(), RecordUnits.end(), RecordUnits.begin(),
+                  [](unsigned char C) { return std::tolower(C); });
+   TimeUnits Units = TimeUnits::None;
+   if (RecordUnits == "years")
+      Units = TimeUnits::Years;
+   else if (RecordUnits == "months")
+      Units = TimeUnits::Months;
+   else if (RecordUnits == "days")
+      Units = TimeUnits::Days;
+   else if (RecordUnits == "hours")
+      Units = TimeUnits::Hours;
+   else if (RecordUnits == "minutes")
+      Units = TimeUnits::Minutes;
+   else if (RecordUnits == "seconds")
+      Units = TimeUnits::Seconds;
+   if (Units == TimeUnits::None or RecordFreq < 1) {
+      LOG_ERROR("Forcing: invalid record interval {} {}", RecordFreq,
+                RecordUnits);
+      return 1;
+   }
+   TimeInterval InRecordInt(RecordFreq, Units);
+
+   Err = enable(InStreamName, InRecordTime, InRecordInt, InPrefetch);
+   if (Err != 0)
+      return Err;
+
+   return start(StartTime);
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Allocates the forcing arrays on the default mesh and defines the fields
+int Forcing::enable(const std::string &InStreamName, // [in] input stream
+                    const TimeInstant &InRecordTime, // [in] a record time
+                    const TimeInterval &InRecordInt, // [in] record spacing
+                    bool InPrefetch                  // [in] read ahead
+) {
+   if (Enabled) {
+      LOG_ERROR("Forcing: the forcing is already enabled");
+      return 1;
+   }
+
+   HorzMesh *Mesh = HorzMesh::getDefault();
+   if (Mesh == nullptr) {
+      LOG_ERROR("Forcing: the default mesh must be initialized first");
+      return 1;
+   }
+   if (!(InRecordInt > TimeInterval())) {
+      LOG_ERROR("Forcing: the record interval must be positive");
+      return 1;
+   }
+
+   StreamName  = InStreamName;
+   RecordTime  = InRecordTime;
+   RecordInt   = InRecordInt;
+   Prefetch    = InPrefetch;
+   NCellsOwned = Mesh->NCellsOwned;
+   NCellsSize  = Mesh->NCellsSize;
+
+   ReadBuffer.resize(NumForcing);
+   for (int I = 0; I < NumForcing; ++I) {
+      ReadBuffer[I]   = HostArray1DReal("Read" + FieldNames[I], NCellsSize);
+      PrevRecord[I]   = Array1DReal("Prev" + FieldNames[I], NCellsSize);
+      NextRecord[I]   = Array1DReal("Next" + FieldNames[I], NCellsSize);
+      Interpolated[I] = Array1DReal(FieldNames[I], NCellsSize);
+   }
+
+   Enabled = true;
+
+   int Err = defineFields();
+   if (Err != 0) {
+      LOG_ERROR("Forcing: error defining the forcing fields");
+      clear();
+      return Err;
+   }
+
+   return Err;
+
+} // end enable
+
+//------------------------------------------------------------------------------
+// Reads the records bracketing the start time and starts the prefetch
+int Forcing::start(const TimeInstant &SimTime // [in] current sim time
+) {
+   int Err = 0;
+
+   if (!Enabled) {
+      LOG_ERROR("Forcing: start called before enable");
+      return 1;
+   }
+
+   // Find the record interval that contains SimTime, moving from the
+   // reference record by whole record intervals
+   PrevRecordTime = RecordTime;
+   while (PrevRecordTime > SimTime)
+      PrevRecordTime = PrevRecordTime - RecordInt;
+   while (PrevRecordTime + RecordInt <= SimTime)
+      PrevRecordTime = PrevRecordTime + RecordInt;
+   NextRecordTime = PrevRecordTime + RecordInt;
+
+   Err = startRead(PrevRecordTime);
+   if (Err == 0)
+      Err = finishRead(PrevRecord);
+   if (Err == 0)
+      Err = startRead(NextRecordTime);
+   if (Err == 0)
+      Err = finishRead(NextRecord);
+   if (Err == 0 and Prefetch)
+      Err = startRead(NextRecordTime + RecordInt);
+   if (Err != 0) {
+      LOG_ERROR("Forcing: error reading the initial forcing records");
+      return Err;
+   }
+
+   Started = true;
+   interpolate(SimTime);
+
+   return Err;
+
+} // end start
+
+//------------------------------------------------------------------------------
+// Returns true if the forcing is enabled
+bool Forcing::isEnabled() { return Enabled; }
+
+//------------------------------------------------------------------------------
+// Moves to the record interval containing SimTime and interpolates
+int Forcing::update(const TimeInstant &SimTime // [in] current sim time
+) {
+   int Err = 0;
+
+   if (!Started) {
+      LOG_ERROR("Forcing: update called before start");
+      return 1;
+   }
+
+   TimerRegion Timer("Forcing");
+
+   // The next record becomes the previous record and its arrays receive the
+   // record after it, which has normally been prefetched
+   while (SimTime >= NextRecordTime) {
+      std::swap(PrevRecord, NextRecord);
+      PrevRecordTime = NextRecordTime;
+      NextRecordTime = NextRecordTime + RecordInt;
+
+      if (!Prefetch)
+         Err = startRead(NextRecordTime);
+      if (Err == 0)
+         Err = finishRead(NextRecord);
+      if (Err == 0 and Prefetch)
+         Err = startRead(NextRecordTime + RecordInt);
+      if (Err != 0) {
+         LOG_ERROR("Forcing: error reading the forcing record at {}",
+                   NextRecordTime.getString(4, 0, "_"));
+         return Err;
+      }
+   }
+
+   interpolate(SimTime);
+
+   return Err;
+
+} // end update
+
+//------------------------------------------------------------------------------
+// Returns the interpolated forcing of a field
+Array1DReal Forcing::getArray(ForcingField Index // [in] forcing field
+) {
+   return Interpolated[Index];
+}
+
+//------------------------------------------------------------------------------
+// Starts reading a record into the host buffers
+int Forcing::startRead(const TimeInstant &RecTime // [in] record time
+) {
+
+   // The stream builds its filename from the time of the clock
+   Clock RecordClock(RecTime, RecordInt);
+   int Err = IOStream::readAsync(StreamName, RecordClock);
+   if (Err != 0) {
+      LOG_ERROR("Forcing: error reading stream {} for the record at {}",
+                StreamName, RecTime.getString(4, 0, "_"));
+      return Err;
+   }
+   PrefetchPending = true;
+
+   return Err;
+
+} // end startRead
+
+//------------------------------------------------------------------------------
+// Completes the outstanding read and copies the record to the device
+int Forcing::finishRead(
+    Kokkos::Array<Array1DReal, NumForcing> &Record // [out] record
+) {
+
+   int Err         = IOStream::waitForPendingWrite();
+   PrefetchPending = false;
+   if (Err != 0) {
+      LOG_ERROR("Forcing: error completing the read of a forcing record");
+      return Err;
+   }
+
+   // Only the owned cells are read and copied
+   const auto OwnedCells = std::make_pair(0, NCellsOwned);
+   for (int I = 0; I < NumForcing; ++I) {
+      auto Dst = Kokkos::subview(Record[I], OwnedCells);
+      auto Src = Kokkos::subview(ReadBuffer[I], OwnedCells);
+      deepCopy(Dst, Src);
+   }
+
+   return Err;
+
+} // end finishRead
+
+//------------------------------------------------------------------------------
+// Interpolates the bracketing records linearly in time
+void Forcing::interpolate(const TimeInstant &SimTime // [in] sim time
+) {
+
+   R8 RecordSpan = 0;
+   R8 Elapsed    = 0;
+   (NextRecordTime - PrevRecordTime).get(RecordSpan, TimeUnits::Seconds);
+   (SimTime - PrevRecordTime).get(Elapsed, TimeUnits::Seconds);
+
+   const Real NextWgt = Elapsed / RecordSpan;
+   const Real PrevWgt = 1._Real - NextWgt;
+
+   const Kokkos::Array<Array1DReal, NumForcing> Prev = PrevRecord;
+   const Kokkos::Array<Array1DReal, NumForcing> Next = NextRecord;
+   const Kokkos::Array<Array1DReal, NumForcing> Out  = Interpolated;
+
+   parallelFor(
+       {NCellsOwned}, KOKKOS_LAMBDA(int ICell) {
+          for (int I = 0; I < NumForcing; ++I)
+             Out[I](ICell) =
+                 PrevWgt * Prev[I](ICell) + NextWgt * Next[I](ICell);
+       });
+
+} // end interpolate
+
+//------------------------------------------------------------------------------
+// Defines the forcing fields and adds them to the Forcing field group
+int Forcing::defineFields() {
+
+   int Err = 0;
+
+   auto ForcingGroup = FieldGroup::create(GroupName);
+   if (ForcingGroup == nullptr)
+      return 1;
+
+   const std::string Descriptions[NumForcing] = {
+       "Zonal surface wind stress", "Meridional surface wind stress",
+       "Net surface heat flux into the ocean",
+       "Net surface freshwater flux into the ocean"};
+   const std::string Units[NumForcing] = {"N m-2", "N m-2", "W m-2",
+                                          "kg m-2 s-1"};
+
+   std::vector<std::string> CellDims = {"NCells"};
+
+   for (int I = 0; I < NumForcing; ++I) {
+      auto ThisField =
+          Field::create(FieldNames[I], Descriptions[I], Units[I], "",
+                        -9.99E+10, 9.99E+10, -9.99E+30, 1, CellDims);
+      if (ThisField == nullptr)
+         return 1;
+
+      // The stream reads into the host buffers, which can be filled on a
+      // background thread while the model uses the device records
+      Err += ThisField->attachData<HostArray1DReal>(ReadBuffer[I]);
+      Err += FieldGroup::addFieldToGroup(FieldNames[I], GroupName);
+   }
+
+   return Err;
+
+} // end defineFields
+
+//------------------------------------------------------------------------------
+// Completes any prefetch, removes the forcing fields and deallocates arrays
+void Forcing::clear() {
+
+   // An outstanding read still writes the host buffers
+   if (PrefetchPending)
+      IOStream::waitForPendingWrite();
+
+   if (FieldGroup::exists(GroupName))
+      FieldGroup::destroy(GroupName);
+   for (int I = 0; I < NumForcing; ++I) {
+      if (Field::exists(FieldNames[I]))
+         Field::destroy(FieldNames[I]);
+   }
+
+   for (int I = 0; I < NumForcing; ++I) {
+      PrevRecord[I]   = Array1DReal();
+      NextRecord[I]   = Array1DReal();
+      Interpolated[I] = Array1DReal();
+   }
+   ReadBuffer.clear();
+
+   Enabled         = false;
+   Started         = false;
+   PrefetchPending = false;
+
+} // end clear
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,150 @@
+#ifndef OMEGA_FORCING_H
+#define OMEGA_FORCING_H
+//===-- ocn/Forcing.h - surface forcing from input files --------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the surface forcing read from forcing or climatology files
+///
+/// For ocean-only runs, the surface forcing is read from a sequence of
+/// records (eg monthly climatologies or daily reanalysis fluxes) at regular
+/// times, each record in its own file of an input IOStream whose filename
+/// template contains the record time. The Forcing class keeps the two
+/// records that bracket the current time on the device and interpolates
+/// them linearly in time to the owned cells in one kernel for all fields.
+/// While the model steps between two records, the record after them is read
+/// on a background thread into host buffers, so that moving to the next
+/// record interval only copies the prefetched record to the device.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "HorzMesh.h"
+#include "TimeMgr.h"
+
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// The Forcing class holds the forcing records and the forcing interpolated
+/// to the current time. All members are static since there is one forcing
+/// for the model.
+class Forcing {
+
+ public:
+   /// Forcing fields on the owned cells, positive into the ocean
+   enum ForcingField : I4 {
+      ForcingWindStressZonal, ///< zonal wind stress (N m-2)
+      ForcingWindStressMerid, ///< meridional wind stress (N m-2)
+      ForcingHeatFlux,        ///< net surface heat flux (W m-2)
+      ForcingFreshwaterFlux,  ///< net surface freshwater flux (kg m-2 s-1)
+      NumForcing
+   };
+
+   /// Names of the forcing fields, which are the variable names in the
+   /// forcing files
+   static const std::string FieldNames[NumForcing];
+
+   // Methods
+
+   //---------------------------------------------------------------------------
+   /// Reads the options of the optional Forcing group of the input
+   /// configuration and, if forcing is enabled, reads the records that
+   /// bracket the start time. Must be called after the default mesh is
+   /// initialized. Returns an error code.
+   static int init(const TimeInstant &StartTime ///< [in] sim start time
+   );
+
+   //---------------------------------------------------------------------------
+   /// Allocates the forcing arrays on the default mesh and defines the
+   /// forcing fields read by the stream StreamName. Records are at
+   /// RecordTime plus any whole number of RecordIntervals. If Prefetch is
+   /// true, the next record is read asynchronously. Returns an error code.
+   static int enable(const std::string &InStreamName, ///< [in] input stream
+                     const TimeInstant &InRecordTime, ///< [in] a record time
+                     const TimeInterval &InRecordInt, ///< [in] record spacing
+                     bool InPrefetch                  ///< [in] read ahead
+   );
+
+   //---------------------------------------------------------------------------
+   /// Reads the two records that bracket SimTime, interpolates them to
+   /// SimTime and starts the prefetch of the next record. Must be called
+   /// after enable and before update. Returns an error code.
+   static int start(const TimeInstant &SimTime ///< [in] current sim time
+   );
+
+   //---------------------------------------------------------------------------
+   /// Returns true if the forcing is enabled
+   static bool isEnabled();
+
+   //---------------------------------------------------------------------------
+   /// Moves to the record interval containing SimTime if needed, using the
+   /// prefetched records, and interpolates the forcing to SimTime. SimTime
+   /// must not be earlier than the time of the previous call. Returns an
+   /// error code.
+   static int update(const TimeInstant &SimTime ///< [in] current sim time
+   );
+
+   //---------------------------------------------------------------------------
+   /// Returns the forcing of a field interpolated to the time of the last
+   /// update on the owned cells
+   static Array1DReal getArray(ForcingField Index ///< [in] forcing field
+   );
+
+   //---------------------------------------------------------------------------
+   /// Completes any outstanding prefetch, removes the forcing fields and
+   /// deallocates all arrays
+   static void clear();
+
+ private:
+   static bool Enabled;         ///< forcing arrays are allocated
+   static bool Started;         ///< bracketing records have been read
+   static bool Prefetch;        ///< read the next record asynchronously
+   static bool PrefetchPending; ///< a record read is in flight
+
+   static std::string StreamName; ///< name of the input stream
+
+   static I4 NCellsOwned; ///< Number of cells owned by this task
+   static I4 NCellsSize;  ///< Array size for cell arrays
+
+   static TimeInstant RecordTime;     ///< time of a reference record
+   static TimeInterval RecordInt;     ///< time between records
+   static TimeInstant PrevRecordTime; ///< time of the previous record
+   static TimeInstant NextRecordTime; ///< time of the next record
+
+   /// Device arrays of the records before and after the current time and of
+   /// the forcing interpolated between them
+   static Kokkos::Array<Array1DReal, NumForcing> PrevRecord;
+   static Kokkos::Array<Array1DReal, NumForcing> NextRecord;
+   static Kokkos::Array<Array1DReal, NumForcing> Interpolated;
+
+   /// Host buffers attached to the forcing fields, into which the stream
+   /// reads each record
+   static std::vector<HostArray1DReal> ReadBuffer;
+
+   /// Name of the field group of the forcing fields
+   static const std::string GroupName;
+
+   /// Starts reading the record at RecTime into the host buffers
+   static int startRead(const TimeInstant &RecTime ///< [in] record time
+   );
+
+   /// Completes the outstanding read and copies the host buffers to the
+   /// device arrays of a record
+   static int
+   finishRead(Kokkos::Array<Array1DReal, NumForcing> &Record ///< [out] record
+   );
+
+   /// Interpolates the bracketing records to SimTime in one kernel
+   static void interpolate(const TimeInstant &SimTime ///< [in] sim time
+   );
+
+   /// Defines the forcing fields and adds them to the Forcing group
+   static int defineFields();
+
+}; // end class Forcing
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_FORCING_H
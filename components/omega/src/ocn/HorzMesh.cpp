@@ -19,6 +19,13 @@
 #include "MachEnv.h"
 #include "OmegaKokkos.h"
 
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <vector>
+
 namespace OMEGA {
 
 // create the static class members
@@ -30,6 +37,19 @@ std::map<std::string, std::unique_ptr<HorzMesh>> HorzMesh::AllHorzMeshes;
 
 int HorzMesh::init() {
 
+   int Err = startInit();
+   if (Err != 0)
+      return Err;
+
+   return finishInit();
+}
+
+//------------------------------------------------------------------------------
+// Start the initialization of the default mesh, reading the mesh variables in
+// the background. Assumes that Decomp has already been initialized.
+
+int HorzMesh::startInit() {
+
    int Err = 0; // default successful return code
 
    // Retrieve the default decomposition
@@ -51,17 +71,35 @@ int HorzMesh::init() {
    }
 
    // Create the default mesh and set pointer to it
-   HorzMesh::DefaultHorzMesh = create("Default", DefDecomp, NVertLevels);
+   HorzMesh::DefaultHorzMesh = create("Default", DefDecomp, NVertLevels, true);
+   if (HorzMesh::DefaultHorzMesh == nullptr) {
+      LOG_CRITICAL("HorzMesh: error creating default mesh");
+      return 1;
+   }
 
    return Err;
 }
 
+//------------------------------------------------------------------------------
+// Complete the initialization of the default mesh
+
+int HorzMesh::finishInit() {
+
+   if (HorzMesh::DefaultHorzMesh == nullptr) {
+      LOG_CRITICAL("HorzMesh: default mesh initialization was not started");
+      return 1;
+   }
+
+   return HorzMesh::DefaultHorzMesh->waitForRead();
+}
+
 //------------------------------------------------------------------------------
 // Construct a new local mesh given a decomposition
 
 HorzMesh::HorzMesh(const std::string &Name, //< [in] Name for new mesh
                    Decomp *MeshDecomp,      //< [in] Decomp for the new mesh
-                   I4 InNVertLevels         //< [in} num vertical levels
+                   I4 InNVertLevels,        //< [in} num vertical levels
+                   bool AsyncRead           //< [in] read mesh in background
 ) {
 
    MeshName = Name;
@@ -130,24 +168,92 @@ HorzMesh::HorzMesh(const std::string &Name, //< [in] Name for new mesh
    // Create the parallel IO decompositions required to read in mesh variables
    initParallelIO(MeshDecomp);
 
-   // Read x/y/z and lon/lat coordinates for cells, edges, and vertices
-   readCoordinates();
+   // Collect the reads of all mesh variables into one batch so that the
+   // variables are read together, grouped by IO decomposition
+   std::vector<IO::ReadRequest> Reads;
 
-   // Read the cell-centered bottom depth
-   readBottomDepth();
+   // x/y/z and lon/lat coordinates for cells, edges, and vertices
+   readCoordinates(Reads);
 
-   // Read the mesh areas, lengths, and angles
-   readMeasurements();
+   // cell-centered bottom depth
+   readBottomDepth(Reads);
 
-   // Read the edge mesh weights
-   readWeights();
+   // mesh areas, lengths, and angles
+   readMeasurements(Reads);
 
-   // Read the Coriolis parameter at the cells, edges, and vertices
-   readCoriolis();
+   // edge mesh weights
+   readWeights(Reads);
+
+   // Coriolis parameter at the cells, edges, and vertices
+   readCoriolis(Reads);
+
+   // The host arrays have all been allocated above, so the background read
+   // only calls the IO library. The read is done immediately if MPI can not
+   // be called from several threads.
+   int ThreadLevel;
+   MPI_Query_thread(&ThreadLevel);
+   if (AsyncRead and ThreadLevel >= MPI_THREAD_MULTIPLE) {
+      PendingRead = std::async(std::launch::async, [this, Reads]() {
+         return readMeshFile(Reads);
+      });
+   } else {
+      Err = readMeshFile(Reads);
+      completeMesh();
+   }
+
+} // end horizontal mesh constructor
+
+//------------------------------------------------------------------------------
+// Read the batch of mesh variables and close the mesh file
+
+int HorzMesh::readMeshFile(std::vector<IO::ReadRequest> Reads // [in] batch
+) {
+
+   int Err = IO::readArrays(Reads, MeshFileID);
+   if (Err != 0)
+      LOG_CRITICAL("HorzMesh: error reading mesh variables");
+
+   // All mesh variables have been read
+   int Err1 = IO::closeFile(MeshFileID);
+   if (Err1 != 0) {
+      LOG_CRITICAL("HorzMesh: error closing mesh file");
+      Err = Err1;
+   }
 
    // Destroy the parallel IO decompositions
    finalizeParallelIO();
 
+   return Err;
+
+} // end readMeshFile
+
+//------------------------------------------------------------------------------
+// Wait for a background read of the mesh file and complete the mesh
+
+int HorzMesh::waitForRead() {
+
+   int Err = 0;
+
+   if (!PendingRead.valid())
+      return Err;
+
+   Err = PendingRead.get();
+   if (Err != 0) {
+      LOG_CRITICAL("HorzMesh: error reading mesh file in the background");
+      return Err;
+   }
+
+   completeMesh();
+
+   return Err;
+
+} // end waitForRead
+
+//------------------------------------------------------------------------------
+// Copy the mesh variables to the device and compute the dependent quantities
+
+void HorzMesh::completeMesh() {
+
    // Copy host data to device
    copyToDevice();
 
@@ -157,19 +263,32 @@ HorzMesh::HorzMesh(const std::string &Name, //< [in] Name for new mesh
    // Compute EdgeSignOnCells and EdgeSignOnVertex
    computeEdgeSign();
 
+   // Compress the cell connectivity and EdgeSignOnCell into CSR form
+   computeCompressedConnectivity();
+
+   // Set the active vertical levels of cells, edges and vertices
+   computeActiveLevels();
+
    // TODO: implement setMasks during Mesh constructor
    setMasks(NVertLevels);
 
    // set mesh scaling coefficients
    setMeshScaling();
 
-} // end horizontal mesh constructor
+   // Fuse the geometric factors of the stencils into per-neighbor weights
+   computeStencilWeights();
+
+   // Precompute the high-order edge reconstruction stencil
+   computeAdvectionStencil();
+
+} // end completeMesh
 
 /// Creates a new mesh by calling the constructor and puts it in the
 /// AllHorzMeshes map
 HorzMesh *HorzMesh::create(const std::string &Name, //< [in] Name for new mesh
                            Decomp *MeshDecomp, //< [in] Decomp for the new mesh
-                           I4 InNVertLevels    //< [in] num vertical levels
+                           I4 InNVertLevels,   //< [in] num vertical levels
+                           bool AsyncRead      //< [in] read mesh in background
 ) {
    // Check to see if a mesh of the same name already exists and
    // if so, exit with an error
@@ -182,7 +301,8 @@ HorzMesh *HorzMesh::create(const std::string &Name, //< [in] Name for new mesh
 
    // create a new mesh on the heap and put it in a map of
    // unique_ptrs, which will manage its lifetime
-   auto *NewHorzMesh = new HorzMesh(Name, MeshDecomp, InNVertLevels);
+   auto *NewHorzMesh =
+       new HorzMesh(Name, MeshDecomp, InNVertLevels, AsyncRead);
    AllHorzMeshes.emplace(Name, NewHorzMesh);
 
    return NewHorzMesh;
@@ -406,237 +526,140 @@ void HorzMesh::finalizeParallelIO() {
 
 //------------------------------------------------------------------------------
 // Read x/y/z and lon/lat coordinates for cells, edges, and vertices
-void HorzMesh::readCoordinates() {
-
-   I4 Err;
+void HorzMesh::readCoordinates(
+    std::vector<IO::ReadRequest> &Reads // [inout] batch of mesh reads
+) {
 
    // Read mesh cell coordinates
-   int XCellID;
-   XCellH = HostArray1DR8("XCell", NCellsSize);
-   Err    = IO::readArray(XCellH.data(), NCellsAll, "xCell", MeshFileID,
-                          CellDecompR8, XCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading xCell");
+   XCellH = createFirstTouchArray<HostArray1DR8>("XCell", NCellsSize);
+   Reads.push_back({XCellH.data(), NCellsAll, "xCell", CellDecompR8});
 
-   int YCellID;
-   YCellH = HostArray1DR8("YCell", NCellsSize);
-   Err    = IO::readArray(YCellH.data(), NCellsAll, "yCell", MeshFileID,
-                          CellDecompR8, YCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading yCell");
+   YCellH = createFirstTouchArray<HostArray1DR8>("YCell", NCellsSize);
+   Reads.push_back({YCellH.data(), NCellsAll, "yCell", CellDecompR8});
 
-   int ZCellID;
-   ZCellH = HostArray1DR8("ZCell", NCellsSize);
-   Err    = IO::readArray(ZCellH.data(), NCellsAll, "zCell", MeshFileID,
-                          CellDecompR8, ZCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading zCell");
+   ZCellH = createFirstTouchArray<HostArray1DR8>("ZCell", NCellsSize);
+   Reads.push_back({ZCellH.data(), NCellsAll, "zCell", CellDecompR8});
 
-   int LonCellID;
-   LonCellH = HostArray1DR8("LonCell", NCellsSize);
-   Err      = IO::readArray(LonCellH.data(), NCellsAll, "lonCell", MeshFileID,
-                            CellDecompR8, LonCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading lonCell");
+   LonCellH = createFirstTouchArray<HostArray1DR8>("LonCell", NCellsSize);
+   Reads.push_back({LonCellH.data(), NCellsAll, "lonCell", CellDecompR8});
 
-   int LatCellID;
-   LatCellH = HostArray1DR8("LatCell", NCellsSize);
-   Err      = IO::readArray(LatCellH.data(), NCellsAll, "latCell", MeshFileID,
-                            CellDecompR8, LatCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading latCell");
+   LatCellH = createFirstTouchArray<HostArray1DR8>("LatCell", NCellsSize);
+   Reads.push_back({LatCellH.data(), NCellsAll, "latCell", CellDecompR8});
 
    // Read mesh edge coordinateID
-   int XEdgeID;
-   XEdgeH = HostArray1DR8("XEdge", NEdgesSize);
-   Err    = IO::readArray(XEdgeH.data(), NEdgesAll, "xEdge", MeshFileID,
-                          EdgeDecompR8, XEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading xEdge");
+   XEdgeH = createFirstTouchArray<HostArray1DR8>("XEdge", NEdgesSize);
+   Reads.push_back({XEdgeH.data(), NEdgesAll, "xEdge", EdgeDecompR8});
 
-   int YEdgeID;
-   YEdgeH = HostArray1DR8("YEdge", NEdgesSize);
-   Err    = IO::readArray(YEdgeH.data(), NEdgesAll, "yEdge", MeshFileID,
-                          EdgeDecompR8, YEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading yEdge");
+   YEdgeH = createFirstTouchArray<HostArray1DR8>("YEdge", NEdgesSize);
+   Reads.push_back({YEdgeH.data(), NEdgesAll, "yEdge", EdgeDecompR8});
 
-   int ZEdgeID;
-   ZEdgeH = HostArray1DR8("ZEdge", NEdgesSize);
-   Err    = IO::readArray(ZEdgeH.data(), NEdgesAll, "zEdge", MeshFileID,
-                          EdgeDecompR8, ZEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading zEdge");
+   ZEdgeH = createFirstTouchArray<HostArray1DR8>("ZEdge", NEdgesSize);
+   Reads.push_back({ZEdgeH.data(), NEdgesAll, "zEdge", EdgeDecompR8});
 
-   int LonEdgeID;
-   LonEdgeH = HostArray1DR8("LonEdge", NEdgesSize);
-   Err      = IO::readArray(LonEdgeH.data(), NEdgesAll, "lonEdge", MeshFileID,
-                            EdgeDecompR8, LonEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading lonEdge");
+   LonEdgeH = createFirstTouchArray<HostArray1DR8>("LonEdge", NEdgesSize);
+   Reads.push_back({LonEdgeH.data(), NEdgesAll, "lonEdge", EdgeDecompR8});
 
-   int LatEdgeID;
-   LatEdgeH = HostArray1DR8("LatEdge", NEdgesSize);
-   Err      = IO::readArray(LatEdgeH.data(), NEdgesAll, "latEdge", MeshFileID,
-                            EdgeDecompR8, LatEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading latEdge");
+   LatEdgeH = createFirstTouchArray<HostArray1DR8>("LatEdge", NEdgesSize);
+   Reads.push_back({LatEdgeH.data(), NEdgesAll, "latEdge", EdgeDecompR8});
 
    // Read mesh vertex coordinates
-   int XVertexID;
-   XVertexH = HostArray1DR8("XVertex", NVerticesSize);
-   Err = IO::readArray(XVertexH.data(), NVerticesAll, "xVertex", MeshFileID,
-                       VertexDecompR8, XVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading xVertex");
+   XVertexH = createFirstTouchArray<HostArray1DR8>("XVertex", NVerticesSize);
+   Reads.push_back({XVertexH.data(), NVerticesAll, "xVertex", VertexDecompR8});
 
-   int YVertexID;
-   YVertexH = HostArray1DR8("YVertex", NVerticesSize);
-   Err = IO::readArray(YVertexH.data(), NVerticesAll, "yVertex", MeshFileID,
-                       VertexDecompR8, YVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading yVertex");
+   YVertexH = createFirstTouchArray<HostArray1DR8>("YVertex", NVerticesSize);
+   Reads.push_back({YVertexH.data(), NVerticesAll, "yVertex", VertexDecompR8});
 
-   int ZVertexID;
-   ZVertexH = HostArray1DR8("ZVertex", NVerticesSize);
-   Err = IO::readArray(ZVertexH.data(), NVerticesAll, "zVertex", MeshFileID,
-                       VertexDecompR8, ZVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading zVertex");
+   ZVertexH = createFirstTouchArray<HostArray1DR8>("ZVertex", NVerticesSize);
+   Reads.push_back({ZVertexH.data(), NVerticesAll, "zVertex", VertexDecompR8});
 
-   int LonVertexID;
-   LonVertexH = HostArray1DR8("LonVertex", NVerticesSize);
-   Err = IO::readArray(LonVertexH.data(), NVerticesAll, "lonVertex", MeshFileID,
-                       VertexDecompR8, LonVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading lonVertex");
+   LonVertexH =
+       createFirstTouchArray<HostArray1DR8>("LonVertex", NVerticesSize);
+   Reads.push_back({LonVertexH.data(), NVerticesAll, "lonVertex",
+                    VertexDecompR8});
 
-   int LatVertexID;
-   LatVertexH = HostArray1DR8("LatVertex", NVerticesSize);
-   Err = IO::readArray(LatVertexH.data(), NVerticesAll, "latVertex", MeshFileID,
-                       VertexDecompR8, LatVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading latVertex");
+   LatVertexH =
+       createFirstTouchArray<HostArray1DR8>("LatVertex", NVerticesSize);
+   Reads.push_back({LatVertexH.data(), NVerticesAll, "latVertex",
+                    VertexDecompR8});
 
 } // end readCoordinates
 
 //------------------------------------------------------------------------------
 // Read the cell-centered bottom depth
-void HorzMesh::readBottomDepth() {
-
-   I4 Err;
+void HorzMesh::readBottomDepth(
+    std::vector<IO::ReadRequest> &Reads // [inout] batch of mesh reads
+) {
 
-   int BottomDepthID;
-   BottomDepthH = HostArray1DR8("BottomDepth", NCellsSize);
-   Err          = IO::readArray(BottomDepthH.data(), NCellsAll, "bottomDepth",
-                                MeshFileID, CellDecompR8, BottomDepthID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading bottomDepth");
+   BottomDepthH =
+       createFirstTouchArray<HostArray1DR8>("BottomDepth", NCellsSize);
+   Reads.push_back({BottomDepthH.data(), NCellsAll, "bottomDepth",
+                    CellDecompR8});
 
 } // end readDepth
 
 //------------------------------------------------------------------------------
 // Read the mesh areas (cell, triangle, and kite),
 // lengths (between centers and vertices), and edge angles
-void HorzMesh::readMeasurements() {
+void HorzMesh::readMeasurements(
+    std::vector<IO::ReadRequest> &Reads // [inout] batch of mesh reads
+) {
 
-   I4 Err;
+   AreaCellH = createFirstTouchArray<HostArray1DR8>("AreaCell", NCellsSize);
+   Reads.push_back({AreaCellH.data(), NCellsAll, "areaCell", CellDecompR8});
 
-   int AreaCellID;
-   AreaCellH = HostArray1DR8("AreaCell", NCellsSize);
-   Err = IO::readArray(AreaCellH.data(), NCellsAll, "areaCell", MeshFileID,
-                       CellDecompR8, AreaCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading areaCell");
+   AreaTriangleH =
+       createFirstTouchArray<HostArray1DR8>("AreaTriangle", NVerticesSize);
+   Reads.push_back({AreaTriangleH.data(), NVerticesAll, "areaTriangle",
+                    VertexDecompR8});
 
-   int AreaTriangleID;
-   AreaTriangleH = HostArray1DR8("AreaTriangle", NVerticesSize);
-   Err = IO::readArray(AreaTriangleH.data(), NVerticesAll, "areaTriangle",
-                       MeshFileID, VertexDecompR8, AreaTriangleID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading areaTriangle");
+   DvEdgeH = createFirstTouchArray<HostArray1DR8>("DvEdge", NEdgesSize);
+   Reads.push_back({DvEdgeH.data(), NEdgesAll, "dvEdge", EdgeDecompR8});
 
-   int DvEdgeID;
-   DvEdgeH = HostArray1DR8("DvEdge", NEdgesSize);
-   Err     = IO::readArray(DvEdgeH.data(), NEdgesAll, "dvEdge", MeshFileID,
-                           EdgeDecompR8, DvEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading dvEdge");
+   DcEdgeH = createFirstTouchArray<HostArray1DR8>("DcEdge", NEdgesSize);
+   Reads.push_back({DcEdgeH.data(), NEdgesAll, "dcEdge", EdgeDecompR8});
 
-   int DcEdgeID;
-   DcEdgeH = HostArray1DR8("DcEdge", NEdgesSize);
-   Err     = IO::readArray(DcEdgeH.data(), NEdgesAll, "dcEdge", MeshFileID,
-                           EdgeDecompR8, DcEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading dcEdge");
+   AngleEdgeH = createFirstTouchArray<HostArray1DR8>("AngleEdge", NEdgesSize);
+   Reads.push_back({AngleEdgeH.data(), NEdgesAll, "angleEdge", EdgeDecompR8});
 
-   int AngleEdgeID;
-   AngleEdgeH = HostArray1DR8("AngleEdge", NEdgesSize);
-   Err = IO::readArray(AngleEdgeH.data(), NEdgesAll, "angleEdge", MeshFileID,
-                       EdgeDecompR8, AngleEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading angleEdge");
+   MeshDensityH =
+       createFirstTouchArray<HostArray1DR8>("MeshDensity", NCellsSize);
+   Reads.push_back({MeshDensityH.data(), NCellsAll, "meshDensity",
+                    CellDecompR8});
 
-   int MeshDensityID;
-   MeshDensityH = HostArray1DR8("MeshDensity", NCellsSize);
-   Err          = IO::readArray(MeshDensityH.data(), NCellsAll, "meshDensity",
-                                MeshFileID, CellDecompR8, MeshDensityID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading meshDensity");
-
-   int KiteAreasOnVertexID;
-   KiteAreasOnVertexH =
-       HostArray2DR8("KiteAreasOnVertex", NVerticesSize, VertexDegree);
-   Err = IO::readArray(KiteAreasOnVertexH.data(), NVerticesAll * VertexDegree,
-                       "kiteAreasOnVertex", MeshFileID, OnVertexDecompR8,
-                       KiteAreasOnVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading kiteAreasOnVertex");
+   KiteAreasOnVertexH = createFirstTouchArray<HostArray2DR8>(
+       "KiteAreasOnVertex", NVerticesSize, VertexDegree);
+   Reads.push_back({KiteAreasOnVertexH.data(), NVerticesAll * VertexDegree,
+                    "kiteAreasOnVertex", OnVertexDecompR8});
 
 } // end readMeasurements
 
 //------------------------------------------------------------------------------
 // Read the edge weights used in the discrete potential vorticity flux term
-void HorzMesh::readWeights() {
+void HorzMesh::readWeights(
+    std::vector<IO::ReadRequest> &Reads // [inout] batch of mesh reads
+) {
 
-   I4 Err;
-
-   int WeightsOnEdgeID;
-   WeightsOnEdgeH = HostArray2DR8("WeightsOnEdge", NEdgesSize, MaxEdges2);
-   Err            = IO::readArray(WeightsOnEdgeH.data(), NEdgesAll * MaxEdges2,
-                                  "weightsOnEdge", MeshFileID, OnEdgeDecompR8,
-                                  WeightsOnEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading weightsOnEdge");
+   WeightsOnEdgeH = createFirstTouchArray<HostArray2DR8>(
+       "WeightsOnEdge", NEdgesSize, MaxEdges2);
+   Reads.push_back({WeightsOnEdgeH.data(), NEdgesAll * MaxEdges2,
+                    "weightsOnEdge", OnEdgeDecompR8});
 
 } // end readWeights
 
 //------------------------------------------------------------------------------
 // Read the Coriolis parameter at the cells, edges, and vertices
-void HorzMesh::readCoriolis() {
-
-   int Err;
+void HorzMesh::readCoriolis(
+    std::vector<IO::ReadRequest> &Reads // [inout] batch of mesh reads
+) {
 
-   int FCellID;
-   FCellH = HostArray1DR8("FCell", NCellsSize);
-   Err    = IO::readArray(FCellH.data(), NCellsAll, "fCell", MeshFileID,
-                          CellDecompR8, FCellID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading fCell");
+   FCellH = createFirstTouchArray<HostArray1DR8>("FCell", NCellsSize);
+   Reads.push_back({FCellH.data(), NCellsAll, "fCell", CellDecompR8});
 
-   int FVertexID;
-   FVertexH = HostArray1DR8("FVertex", NVerticesSize);
-   Err = IO::readArray(FVertexH.data(), NVerticesAll, "fVertex", MeshFileID,
-                       VertexDecompR8, FVertexID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading fVertex");
+   FVertexH = createFirstTouchArray<HostArray1DR8>("FVertex", NVerticesSize);
+   Reads.push_back({FVertexH.data(), NVerticesAll, "fVertex", VertexDecompR8});
 
-   int FEdgeID;
-   FEdgeH = HostArray1DR8("FEdge", NEdgesSize);
-   Err    = IO::readArray(FEdgeH.data(), NEdgesAll, "fEdge", MeshFileID,
-                          EdgeDecompR8, FEdgeID);
-   if (Err != 0)
-      LOG_CRITICAL("HorzMesh: error reading fEdge");
+   FEdgeH = createFirstTouchArray<HostArray1DR8>("FEdge", NEdgesSize);
+   Reads.push_back({FEdgeH.data(), NEdgesAll, "fEdge", EdgeDecompR8});
 
 } // end readCoriolis
 
@@ -644,7 +667,8 @@ void HorzMesh::readCoriolis() {
 // Compute the sign of edge contributions to a cell/vertex for each edge
 void HorzMesh::computeEdgeSign() {
 
-   EdgeSignOnCell = Array2DR8("EdgeSignOnCell", NCellsSize, MaxEdges);
+   EdgeSignOnCell =
+       createFirstTouchArray<Array2DR8>("EdgeSignOnCell", NCellsSize, MaxEdges);
 
    OMEGA_SCOPE(o_NEdgesOnCell, NEdgesOnCell);
    OMEGA_SCOPE(o_EdgesOnCell, EdgesOnCell);
@@ -667,8 +691,8 @@ void HorzMesh::computeEdgeSign() {
 
    EdgeSignOnCellH = createHostMirrorCopy(EdgeSignOnCell);
 
-   EdgeSignOnVertex =
-       Array2DR8("EdgeSignOnVertex", NVerticesSize, VertexDegree);
+   EdgeSignOnVertex = createFirstTouchArray<Array2DR8>(
+       "EdgeSignOnVertex", NVerticesSize, VertexDegree);
 
    OMEGA_SCOPE(o_VertexDegree, VertexDegree);
    OMEGA_SCOPE(o_EdgesOnVertex, EdgesOnVertex);
@@ -692,34 +716,232 @@ void HorzMesh::computeEdgeSign() {
    EdgeSignOnVertexH = createHostMirrorCopy(EdgeSignOnVertex);
 } // end computeEdgeSign
 
+//------------------------------------------------------------------------------
+// Compress the cell connectivity into CSR form, with the entries of each cell
+// stored contiguously in the order of the dense arrays. The offsets are a
+// prefix sum of NEdgesOnCell over the local cells, computed on the host where
+// the connectivity is already available.
+void HorzMesh::computeCompressedConnectivity() {
+
+   OffsetsOnCellH =
+       createFirstTouchArray<HostArray1DI4>("OffsetsOnCell", NCellsSize + 1);
+
+   OffsetsOnCellH(0) = 0;
+   for (int Cell = 0; Cell < NCellsSize; ++Cell) {
+      const I4 NEntries        = Cell < NCellsAll ? NEdgesOnCellH(Cell) : 0;
+      OffsetsOnCellH(Cell + 1) = OffsetsOnCellH(Cell) + NEntries;
+   }
+   const I4 NTotal = OffsetsOnCellH(NCellsSize);
+
+   CellsOnCellCSRH =
+       createFirstTouchArray<HostArray1DI4>("CellsOnCellCSR", NTotal);
+   EdgesOnCellCSRH =
+       createFirstTouchArray<HostArray1DI4>("EdgesOnCellCSR", NTotal);
+   VerticesOnCellCSRH =
+       createFirstTouchArray<HostArray1DI4>("VerticesOnCellCSR", NTotal);
+   EdgeSignOnCellCSRH =
+       createFirstTouchArray<HostArray1DR8>("EdgeSignOnCellCSR", NTotal);
+
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      const I4 Start = OffsetsOnCellH(Cell);
+      for (int i = 0; i < NEdgesOnCellH(Cell); ++i) {
+         CellsOnCellCSRH(Start + i)    = CellsOnCellH(Cell, i);
+         EdgesOnCellCSRH(Start + i)    = EdgesOnCellH(Cell, i);
+         VerticesOnCellCSRH(Start + i) = VerticesOnCellH(Cell, i);
+         EdgeSignOnCellCSRH(Start + i) = EdgeSignOnCellH(Cell, i);
+      }
+   }
+
+   OffsetsOnCell     = createDeviceMirrorCopy(OffsetsOnCellH);
+   CellsOnCellCSR    = createDeviceMirrorCopy(CellsOnCellCSRH);
+   EdgesOnCellCSR    = createDeviceMirrorCopy(EdgesOnCellCSRH);
+   VerticesOnCellCSR = createDeviceMirrorCopy(VerticesOnCellCSRH);
+   EdgeSignOnCellCSR = createDeviceMirrorCopy(EdgeSignOnCellCSRH);
+
+} // end computeCompressedConnectivity
+
+//------------------------------------------------------------------------------
+// Set the range of active vertical levels of the cells, edges and vertices.
+// All levels are active unless ActiveLevelsFromBottomDepth is set in the
+// Dimension group of the Omega config. In that case the deepest active level
+// of a cell is the last reference level whose top lies above the bottom
+// depth, with the reference levels dividing the maximum bottom depth of the
+// mesh into NVertLevels layers of equal thickness.
+// TODO: read the active levels and reference layers from the mesh file once
+// a vertical coordinate is available
+void HorzMesh::computeActiveLevels() {
+
+   bool FromBottomDepth = false;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("Dimension")) {
+      Config DimConfig("Dimension");
+      I4 Err = OmegaConfig->get(DimConfig);
+      if (Err == 0 and DimConfig.existsVar("ActiveLevelsFromBottomDepth")) {
+         Err = DimConfig.get("ActiveLevelsFromBottomDepth", FromBottomDepth);
+         if (Err != 0)
+            LOG_ERROR("HorzMesh: error reading ActiveLevelsFromBottomDepth");
+      }
+   }
+
+   // Reference layer thickness from the maximum depth over all tasks
+   R8 RefLayerThick = 0;
+   if (FromBottomDepth) {
+      R8 LocMaxDepth = 0;
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+         LocMaxDepth = std::max(LocMaxDepth, BottomDepthH(Cell));
+      }
+      R8 MaxDepth = 0;
+      MPI_Allreduce(&LocMaxDepth, &MaxDepth, 1, MPI_DOUBLE, MPI_MAX,
+                    MachEnv::getDefault()->getComm());
+      RefLayerThick = MaxDepth / NVertLevels;
+   }
+
+   MinLevelCellH =
+       createFirstTouchArray<HostArray1DI4>("MinLevelCell", NCellsSize);
+   MaxLevelCellH =
+       createFirstTouchArray<HostArray1DI4>("MaxLevelCell", NCellsSize);
+
+   for (int Cell = 0; Cell < NCellsSize; ++Cell) {
+      MinLevelCellH(Cell) = 0;
+      if (Cell >= NCellsAll) {
+         MaxLevelCellH(Cell) = -1;
+      } else if (RefLayerThick > 0) {
+         // Every cell has at least one active level
+         const I4 NActive =
+             static_cast<I4>(std::ceil(BottomDepthH(Cell) / RefLayerThick));
+         MaxLevelCellH(Cell) = std::clamp(NActive, 1, NVertLevels) - 1;
+      } else {
+         MaxLevelCellH(Cell) = NVertLevels - 1;
+      }
+   }
+
+   MinLevelEdgeH =
+       createFirstTouchArray<HostArray1DI4>("MinLevelEdge", NEdgesSize);
+   MaxLevelEdgeH =
+       createFirstTouchArray<HostArray1DI4>("MaxLevelEdge", NEdgesSize);
+
+   for (int Edge = 0; Edge < NEdgesSize; ++Edge) {
+      MinLevelEdgeH(Edge) = NVertLevels;
+      MaxLevelEdgeH(Edge) = -1;
+      if (Edge >= NEdgesAll)
+         continue;
+      for (int I = 0; I < MaxCellsOnEdge; ++I) {
+         const I4 Cell = CellsOnEdgeH(Edge, I);
+         if (Cell < 0 or Cell >= NCellsAll)
+            continue;
+         MinLevelEdgeH(Edge) =
+             std::min(MinLevelEdgeH(Edge), MinLevelCellH(Cell));
+         MaxLevelEdgeH(Edge) =
+             std::max(MaxLevelEdgeH(Edge), MaxLevelCellH(Cell));
+      }
+   }
+
+   MinLevelVertexH =
+       createFirstTouchArray<HostArray1DI4>("MinLevelVertex", NVerticesSize);
+   MaxLevelVertexH =
+       createFirstTouchArray<HostArray1DI4>("MaxLevelVertex", NVerticesSize);
+
+   for (int Vertex = 0; Vertex < NVerticesSize; ++Vertex) {
+      MinLevelVertexH(Vertex) = NVertLevels;
+      MaxLevelVertexH(Vertex) = -1;
+      if (Vertex >= NVerticesAll)
+         continue;
+      for (int I = 0; I < VertexDegree; ++I) {
+         const I4 Cell = CellsOnVertexH(Vertex, I);
+         if (Cell < 0 or Cell >= NCellsAll)
+            continue;
+         MinLevelVertexH(Vertex) =
+             std::min(MinLevelVertexH(Vertex), MinLevelCellH(Cell));
+         MaxLevelVertexH(Vertex) =
+             std::max(MaxLevelVertexH(Vertex), MaxLevelCellH(Cell));
+      }
+   }
+
+   MinLevelCell   = createDeviceMirrorCopy(MinLevelCellH);
+   MaxLevelCell   = createDeviceMirrorCopy(MaxLevelCellH);
+   MinLevelEdge   = createDeviceMirrorCopy(MinLevelEdgeH);
+   MaxLevelEdge   = createDeviceMirrorCopy(MaxLevelEdgeH);
+   MinLevelVertex = createDeviceMirrorCopy(MinLevelVertexH);
+   MaxLevelVertex = createDeviceMirrorCopy(MaxLevelVertexH);
+
+} // end computeActiveLevels
+
 //------------------------------------------------------------------------------
 // set computational masks for mesh elements
 // TODO: this is just a placeholder, implement actual masks for edges, cells,
 // and vertices
 void HorzMesh::setMasks(int NVertLevels) {
 
-   EdgeMask = Array2DR8("EdgeMask", NEdgesSize, NVertLevels);
+   EdgeMask =
+       createFirstTouchArray<Array2DR8>("EdgeMask", NEdgesSize, NVertLevels);
 
    OMEGA_SCOPE(O_EdgeMask, EdgeMask);
+   OMEGA_SCOPE(O_CellsOnEdge, CellsOnEdge);
+   OMEGA_SCOPE(O_MinLevelCell, MinLevelCell);
+   OMEGA_SCOPE(O_MaxLevelCell, MaxLevelCell);
+   const I4 O_NCellsAll = NCellsAll;
 
+   // Edges are unmasked at the levels active in all of their valid cells
    parallelFor(
        {NEdgesAll}, KOKKOS_LAMBDA(int Edge) {
+          I4 KMin = 0;
+          I4 KMax = NVertLevels - 1;
+          for (int I = 0; I < 2; ++I) {
+             const I4 Cell = O_CellsOnEdge(Edge, I);
+             if (Cell >= 0 and Cell < O_NCellsAll) {
+                KMin = Kokkos::max(KMin, O_MinLevelCell(Cell));
+                KMax = Kokkos::min(KMax, O_MaxLevelCell(Cell));
+             }
+          }
           for (int K = 0; K < NVertLevels; ++K) {
-             O_EdgeMask(Edge, K) = 1.0;
+             O_EdgeMask(Edge, K) = (K >= KMin and K <= KMax) ? 1.0 : 0.0;
           }
        });
 
    EdgeMaskH = createHostMirrorCopy(EdgeMask);
 
+   // Compact the edges with at least one unmasked level
+   std::vector<I4> Active;
+   Active.reserve(NEdgesAll);
+   for (int Edge = 0; Edge < NEdgesAll; ++Edge) {
+      for (int K = 0; K < NVertLevels; ++K) {
+         if (EdgeMaskH(Edge, K) != 0.0) {
+            Active.push_back(Edge);
+            break;
+         }
+      }
+   }
+
+   ActiveEdgesH = HostArray1DI4("ActiveEdges", Active.size());
+   for (size_t I = 0; I < Active.size(); ++I) {
+      ActiveEdgesH(I) = Active[I];
+   }
+   ActiveEdges = createDeviceMirrorCopy(ActiveEdgesH);
+
 } // end setMasks
 
+//------------------------------------------------------------------------------
+// Count the active edges among the first NEdges edges
+I4 HorzMesh::numActiveEdges(I4 NEdges ///< [in] number of edges
+) const {
+
+   const I4 *Begin = ActiveEdgesH.data();
+   const I4 *End   = Begin + ActiveEdgesH.extent(0);
+
+   return static_cast<I4>(std::lower_bound(Begin, End, NEdges) - Begin);
+
+} // end numActiveEdges
+
 //------------------------------------------------------------------------------
 // Set mesh scaling coefficients for mixing terms in momentum and tracer
 // equations so viscosity and diffusion scale with mesh.
 void HorzMesh::setMeshScaling() {
 
-   MeshScalingDel2 = Array1DR8("MeshScalingDel2", NEdgesSize);
-   MeshScalingDel4 = Array1DR8("MeshScalingDel4", NEdgesSize);
+   MeshScalingDel2 =
+       createFirstTouchArray<Array1DR8>("MeshScalingDel2", NEdgesSize);
+   MeshScalingDel4 =
+       createFirstTouchArray<Array1DR8>("MeshScalingDel4", NEdgesSize);
 
    OMEGA_SCOPE(o_MeshScalingDel2, MeshScalingDel2);
    OMEGA_SCOPE(o_MeshScalingDel4, MeshScalingDel4);
@@ -737,6 +959,213 @@ void HorzMesh::setMeshScaling() {
 
 } // end setMeshScaling
 
+//------------------------------------------------------------------------------
+// Precompute the fused weights of the cell and vertex stencils so that the
+// operators do a single multiply-add per neighbor. The weights are computed
+// on the host from the mesh quantities and the mesh scaling, and must be
+// recomputed if either changes.
+void HorzMesh::computeStencilWeights() {
+
+   const I4 NTotal = OffsetsOnCellH(NCellsSize);
+
+   DivWeightsOnCellCSRH =
+       createFirstTouchArray<HostArray1DR8>("DivWeightsOnCellCSR", NTotal);
+   Del2WeightsOnCellCSRH =
+       createFirstTouchArray<HostArray1DR8>("Del2WeightsOnCellCSR", NTotal);
+   Del4WeightsOnCellCSRH =
+       createFirstTouchArray<HostArray1DR8>("Del4WeightsOnCellCSR", NTotal);
+
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      const R8 InvAreaCell = 1.0 / AreaCellH(Cell);
+      for (int J = OffsetsOnCellH(Cell); J < OffsetsOnCellH(Cell + 1); ++J) {
+         const I4 Edge   = EdgesOnCellCSRH(J);
+         const R8 DivWgt = EdgeSignOnCellCSRH(J) * DvEdgeH(Edge) * InvAreaCell;
+         const R8 InvDc  = 1.0 / DcEdgeH(Edge);
+         DivWeightsOnCellCSRH(J)  = DivWgt;
+         Del2WeightsOnCellCSRH(J) = DivWgt * MeshScalingDel2H(Edge) * InvDc;
+         Del4WeightsOnCellCSRH(J) = DivWgt * MeshScalingDel4H(Edge) * InvDc;
+      }
+   }
+
+   CurlWeightsOnVertexH = createFirstTouchArray<HostArray2DR8>(
+       "CurlWeightsOnVertex", NVerticesSize, VertexDegree);
+
+   for (int Vertex = 0; Vertex < NVerticesAll; ++Vertex) {
+      const R8 InvAreaTriangle = 1.0 / AreaTriangleH(Vertex);
+      for (int J = 0; J < VertexDegree; ++J) {
+         const I4 Edge = EdgesOnVertexH(Vertex, J);
+         CurlWeightsOnVertexH(Vertex, J) =
+             EdgeSignOnVertexH(Vertex, J) * DcEdgeH(Edge) * InvAreaTriangle;
+      }
+   }
+
+   DivWeightsOnCellCSR  = createDeviceMirrorCopy(DivWeightsOnCellCSRH);
+   Del2WeightsOnCellCSR = createDeviceMirrorCopy(Del2WeightsOnCellCSRH);
+   Del4WeightsOnCellCSR = createDeviceMirrorCopy(Del4WeightsOnCellCSRH);
+   CurlWeightsOnVertex  = createDeviceMirrorCopy(CurlWeightsOnVertexH);
+
+} // end computeStencilWeights
+
+//------------------------------------------------------------------------------
+// Precompute the stencil of the high-order reconstruction of a scalar on the
+// edges (Skamarock and Gassmann 2011), as in the MPAS tracer advection. The
+// value on an edge is the mean of the two cells on the edge corrected by the
+// second derivatives along the edge normal in both cells, which are estimated
+// by a least-squares fit of a quadratic to the cell and its neighbors. The
+// neighbor positions are built in the local tangent plane of each cell from
+// DcEdge and AngleEdge, which works for planar periodic and spherical meshes.
+// Edges whose stencil is incomplete (cells on the boundary or at the edge of
+// the halo) or ill-conditioned fall back to the centered value.
+void HorzMesh::computeAdvectionStencil() {
+
+   NAdvCellsForEdgeH =
+       createFirstTouchArray<HostArray1DI4>("NAdvCellsForEdge", NEdgesSize);
+   AdvCellsForEdgeH = createFirstTouchArray<HostArray2DI4>(
+       "AdvCellsForEdge", NEdgesSize, MaxEdges2);
+   AdvCoefsH =
+       createFirstTouchArray<HostArray2DR8>("AdvCoefs", NEdgesSize, MaxEdges2);
+   AdvCoefs3rdH = createFirstTouchArray<HostArray2DR8>(
+       "AdvCoefs3rd", NEdgesSize, MaxEdges2);
+
+   // Weights of the neighbors of a cell in the second derivative of a scalar
+   // along the direction (Tx, Ty), in units of the squared length Scale, such
+   // that the derivative is the sum of the weights times the differences
+   // between the neighbor values and the cell value. Returns false if the
+   // cell has too few valid neighbors for a quadratic fit.
+   constexpr int NCoef = 5;
+   auto derivTwoWeights = [&](I4 Cell, R8 Tx, R8 Ty, R8 Scale,
+                              std::vector<I4> &Neighbors,
+                              std::vector<R8> &Weights) {
+      const I4 NNbr = NEdgesOnCellH(Cell);
+      Neighbors.resize(NNbr);
+      Weights.assign(NNbr, 0.0);
+      if (NNbr < NCoef)
+         return false;
+
+      // Rows of the fit matrix, with the neighbor positions relative to the
+      // cell in units of Scale
+      std::vector<R8> A(NNbr * NCoef);
+      for (int I = 0; I < NNbr; ++I) {
+         const I4 Edge = EdgesOnCellH(Cell, I);
+         const I4 C0   = CellsOnEdgeH(Edge, 0);
+         const I4 C1   = CellsOnEdgeH(Edge, 1);
+         Neighbors[I]  = C0 == Cell ? C1 : C0;
+         if (Neighbors[I] < 0 or Neighbors[I] >= NCellsAll)
+            return false;
+         const R8 Sign = C0 == Cell ? 1.0 : -1.0;
+         const R8 Dist = Sign * DcEdgeH(Edge) / Scale;
+         const R8 X    = Dist * std::cos(AngleEdgeH(Edge));
+         const R8 Y    = Dist * std::sin(AngleEdgeH(Edge));
+         R8 *Row       = &A[I * NCoef];
+         Row[0]        = X;
+         Row[1]        = Y;
+         Row[2]        = X * X;
+         Row[3]        = X * Y;
+         Row[4]        = Y * Y;
+      }
+
+      // Solve the normal equations (A^T A) Z = G for the functional G of the
+      // fit coefficients that gives the second derivative along (Tx, Ty),
+      // with Gaussian elimination and partial pivoting
+      R8 M[NCoef][NCoef + 1] = {};
+      for (int P = 0; P < NCoef; ++P) {
+         for (int Q = 0; Q < NCoef; ++Q) {
+            for (int I = 0; I < NNbr; ++I)
+               M[P][Q] += A[I * NCoef + P] * A[I * NCoef + Q];
+         }
+      }
+      M[2][NCoef] = 2.0 * Tx * Tx;
+      M[3][NCoef] = 2.0 * Tx * Ty;
+      M[4][NCoef] = 2.0 * Ty * Ty;
+      for (int P = 0; P < NCoef; ++P) {
+         int Piv = P;
+         for (int Q = P + 1; Q < NCoef; ++Q) {
+            if (std::abs(M[Q][P]) > std::abs(M[Piv][P]))
+               Piv = Q;
+         }
+         if (std::abs(M[Piv][P]) < 1.0e-10)
+            return false;
+         for (int Q = 0; Q <= NCoef; ++Q)
+            std::swap(M[P][Q], M[Piv][Q]);
+         for (int R = 0; R < NCoef; ++R) {
+            if (R == P)
+               continue;
+            const R8 Fac = M[R][P] / M[P][P];
+            for (int Q = P; Q <= NCoef; ++Q)
+               M[R][Q] -= Fac * M[P][Q];
+         }
+      }
+
+      for (int I = 0; I < NNbr; ++I) {
+         for (int P = 0; P < NCoef; ++P)
+            Weights[I] += A[I * NCoef + P] * M[P][NCoef] / M[P][P];
+      }
+      return true;
+   };
+
+   std::vector<I4> Neighbors0, Neighbors1;
+   std::vector<R8> Weights0, Weights1;
+   for (int Edge = 0; Edge < NEdgesAll; ++Edge) {
+      const I4 Cell0 = CellsOnEdgeH(Edge, 0);
+      const I4 Cell1 = CellsOnEdgeH(Edge, 1);
+      I4 NAdv        = 0;
+
+      // Add coefficients to the stencil entry of a cell. The stencil is the
+      // union of the neighbors of both cells, which holds at most MaxEdges2
+      // cells since each cell on the edge is a neighbor of the other
+      auto addCoefs = [&](I4 Cell, R8 Coef, R8 Coef3rd) {
+         int J = 0;
+         while (J < NAdv and AdvCellsForEdgeH(Edge, J) != Cell)
+            ++J;
+         if (J == NAdv) {
+            AdvCellsForEdgeH(Edge, J) = Cell;
+            AdvCoefsH(Edge, J)        = 0.0;
+            AdvCoefs3rdH(Edge, J)     = 0.0;
+            ++NAdv;
+         }
+         AdvCoefsH(Edge, J) += Coef;
+         AdvCoefs3rdH(Edge, J) += Coef3rd;
+      };
+
+      addCoefs(Cell0, 0.5, 0.0);
+      addCoefs(Cell1, 0.5, 0.0);
+
+      const bool Interior = Cell0 >= 0 and Cell0 < NCellsAll and
+                            Cell1 >= 0 and Cell1 < NCellsAll;
+      const R8 Tx = std::cos(AngleEdgeH(Edge));
+      const R8 Ty = std::sin(AngleEdgeH(Edge));
+      if (Interior and
+          derivTwoWeights(Cell0, Tx, Ty, DcEdgeH(Edge), Neighbors0,
+                          Weights0) and
+          derivTwoWeights(Cell1, Tx, Ty, DcEdgeH(Edge), Neighbors1,
+                          Weights1)) {
+
+         // Edge value = mean - Dc^2/12 (D2_0 + D2_1)
+         //            + Coef3rd sign(u) Dc^2/12 (D2_1 - D2_0)
+         // with the derivatives already in units of Dc^2
+         constexpr R8 Twelfth = 1.0 / 12.0;
+         for (int I = 0; I < static_cast<int>(Neighbors0.size()); ++I) {
+            const R8 W = Twelfth * Weights0[I];
+            addCoefs(Neighbors0[I], -W, -W);
+            addCoefs(Cell0, W, W);
+         }
+         for (int I = 0; I < static_cast<int>(Neighbors1.size()); ++I) {
+            const R8 W = Twelfth * Weights1[I];
+            addCoefs(Neighbors1[I], -W, W);
+            addCoefs(Cell1, W, -W);
+         }
+      }
+
+      NAdvCellsForEdgeH(Edge) = NAdv;
+   }
+
+   NAdvCellsForEdge = createDeviceMirrorCopy(NAdvCellsForEdgeH);
+   AdvCellsForEdge  = createDeviceMirrorCopy(AdvCellsForEdgeH);
+   AdvCoefs         = createDeviceMirrorCopy(AdvCoefsH);
+   AdvCoefs3rd      = createDeviceMirrorCopy(AdvCoefs3rdH);
+
+} // end computeAdvectionStencil
+
 //------------------------------------------------------------------------------
 // Perform copy to device for mesh variables
 void HorzMesh::copyToDevice() {
@@ -777,6 +1206,24 @@ HorzMesh *HorzMesh::get(const std::string Name ///< [in] Name of mesh
    }
 } // end get mesh
 
+//------------------------------------------------------------------------------
+// Get the loop bounds through a halo layer
+MeshLoopBounds HorzMesh::getLoopBounds(I4 HaloDepth ///< [in] num halo layers
+) const {
+
+   const I4 HaloWidth = NCellsHaloH.extent_int(0);
+
+   if (HaloDepth == 0) {
+      return {NCellsOwned, NEdgesOwned, NVerticesOwned};
+   }
+   if (HaloDepth < 0 or HaloDepth >= HaloWidth) {
+      return {NCellsAll, NEdgesAll, NVerticesAll};
+   }
+   return {NCellsHaloH(HaloDepth - 1), NEdgesHaloH(HaloDepth - 1),
+           NVerticesHaloH(HaloDepth - 1)};
+
+} // end getLoopBounds
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
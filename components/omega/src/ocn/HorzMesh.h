@@ -12,11 +12,14 @@
 
 #include "DataTypes.h"
 #include "Decomp.h"
+#include "IO.h"
 #include "MachEnv.h"
 #include "OmegaKokkos.h"
 
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace OMEGA {
 
@@ -26,6 +29,18 @@ namespace OMEGA {
 /// not used to create the domain decomposition from mesh file.
 /// It handles computing any dependent mesh quantities and transfers
 /// the relevant information to the device
+/// Halo depth that selects all halo layers in the loop bounds of a mesh
+constexpr I4 FullHalo = -1;
+
+/// Loop bounds of kernels over the mesh elements, as the number of owned and
+/// halo elements to compute. Since the halo elements are ordered by halo
+/// layer, each bound covers the owned elements and the first halo layers.
+struct MeshLoopBounds {
+   I4 NCells;    ///< number of cells to compute
+   I4 NEdges;    ///< number of edges to compute
+   I4 NVertices; ///< number of vertices to compute
+};
+
 class HorzMesh {
 
  private:
@@ -35,20 +50,40 @@ class HorzMesh {
 
    void createDimensions(Decomp *MeshDecomp);
 
-   void readCoordinates();
+   void readCoordinates(std::vector<IO::ReadRequest> &Reads);
 
-   void readBottomDepth();
+   void readBottomDepth(std::vector<IO::ReadRequest> &Reads);
 
-   void readMeasurements();
+   void readMeasurements(std::vector<IO::ReadRequest> &Reads);
 
-   void readWeights();
+   void readWeights(std::vector<IO::ReadRequest> &Reads);
 
-   void readCoriolis();
+   void readCoriolis(std::vector<IO::ReadRequest> &Reads);
 
    // void computeEdgeSign();
 
+   void computeCompressedConnectivity();
+
+   void computeStencilWeights();
+
+   void computeAdvectionStencil();
+
+   void computeActiveLevels();
+
    void copyToDevice();
 
+   /// Reads the batch of mesh variables, closes the mesh file and destroys
+   /// the IO decompositions. Only fills host arrays, so it can run on a
+   /// background thread.
+   int readMeshFile(std::vector<IO::ReadRequest> Reads);
+
+   /// Copies the mesh variables to the device and computes the dependent
+   /// mesh quantities once the mesh file has been read
+   void completeMesh();
+
+   /// Outstanding background read of the mesh file, if any
+   std::future<int> PendingRead;
+
    // int computeMesh();
    I4 CellDecompR8;
    I4 EdgeDecompR8;
@@ -60,10 +95,13 @@ class HorzMesh {
 
    static std::map<std::string, std::unique_ptr<HorzMesh>> AllHorzMeshes;
 
-   /// Construct a new local mesh for a given decomposition
+   /// Construct a new local mesh for a given decomposition. If AsyncRead is
+   /// true, the mesh variables are read on a background thread and the mesh
+   /// is only complete after waitForRead.
    HorzMesh(const std::string &Name, ///< [in] Name for mesh
             Decomp *Decomp,          ///< [in] Decomposition for mesh
-            I4 InNVertLevels         ///< [in] num vertical levels
+            I4 InNVertLevels,        ///< [in] num vertical levels
+            bool AsyncRead = false   ///< [in] read mesh in the background
    );
 
    // Forbid copy and move construction
@@ -129,6 +167,23 @@ class HorzMesh {
    Array2DI4 VerticesOnCell;      ///< Indx of vertices bordering each cell
    HostArray2DI4 VerticesOnCellH; ///< Indx of vertices bordering each cell
 
+   // Compressed (CSR) cell connectivity. The entries of cell ICell are stored
+   // contiguously from OffsetsOnCell(ICell) to OffsetsOnCell(ICell + 1) - 1,
+   // in the same order as in the dense arrays but without the padding to
+   // MaxEdges. Cells beyond NCellsAll have no entries.
+
+   Array1DI4 OffsetsOnCell;      ///< Start of each cell in the CSR arrays
+   HostArray1DI4 OffsetsOnCellH; ///< Start of each cell in the CSR arrays
+
+   Array1DI4 CellsOnCellCSR;      ///< CSR indx of cells neighboring each cell
+   HostArray1DI4 CellsOnCellCSRH; ///< CSR indx of cells neighboring each cell
+
+   Array1DI4 EdgesOnCellCSR;      ///< CSR indx of edges bordering each cell
+   HostArray1DI4 EdgesOnCellCSRH; ///< CSR indx of edges bordering each cell
+
+   Array1DI4 VerticesOnCellCSR;      ///< CSR indx of vertices of each cell
+   HostArray1DI4 VerticesOnCellCSRH; ///< CSR indx of vertices of each cell
+
    Array2DI4 CellsOnEdge;      ///< Indx of cells straddling each edge
    HostArray2DI4 CellsOnEdgeH; ///< Indx of cells straddling each edge
 
@@ -228,15 +283,44 @@ class HorzMesh {
    Array2DR8 EdgeSignOnCell;      ///< Sign of vector connecting cells
    HostArray2DR8 EdgeSignOnCellH; ///< Sign of vector connecting cells
 
+   Array1DR8 EdgeSignOnCellCSR;      ///< CSR sign of vector connecting cells
+   HostArray1DR8 EdgeSignOnCellCSRH; ///< CSR sign of vector connecting cells
+
    Array2DR8 EdgeSignOnVertex;      ///< Sign of vector connecting vertices
    HostArray2DR8 EdgeSignOnVertexH; ///< Sign of vector connecting vertices
 
+   // Active vertical levels
+   // The first and last (inclusive) active levels of each cell, edge and
+   // vertex. Edges and vertices are active at the levels that are active in
+   // any of their valid cells. Padded entries have no active levels.
+
+   Array1DI4 MinLevelCell;      ///< First active level of each cell
+   HostArray1DI4 MinLevelCellH; ///< First active level of each cell
+   Array1DI4 MaxLevelCell;      ///< Last active level of each cell
+   HostArray1DI4 MaxLevelCellH; ///< Last active level of each cell
+
+   Array1DI4 MinLevelEdge;      ///< First active level of each edge
+   HostArray1DI4 MinLevelEdgeH; ///< First active level of each edge
+   Array1DI4 MaxLevelEdge;      ///< Last active level of each edge
+   HostArray1DI4 MaxLevelEdgeH; ///< Last active level of each edge
+
+   Array1DI4 MinLevelVertex;      ///< First active level of each vertex
+   HostArray1DI4 MinLevelVertexH; ///< First active level of each vertex
+   Array1DI4 MaxLevelVertex;      ///< Last active level of each vertex
+   HostArray1DI4 MaxLevelVertexH; ///< Last active level of each vertex
+
    // Masks
    Array2DR8 EdgeMask;      ///< Mask to determine if computations should be
                             ///  done on edge
    HostArray2DR8 EdgeMaskH; ///< Mask to determine if computations should be
                             ///  done on edge
 
+   // Compacted list of the edges with at least one unmasked level, in
+   // increasing edge order so that the active edges among the first N edges
+   // are the first numActiveEdges(N) entries
+   Array1DI4 ActiveEdges;      ///< Indices of the active edges
+   HostArray1DI4 ActiveEdgesH; ///< Indices of the active edges
+
    // Mesh scaling
    Array1DR8 MeshScalingDel2;      /// Coef to Laplacian mixing terms
    HostArray1DR8 MeshScalingDel2H; /// Coef to Laplacian mixing terms
@@ -244,18 +328,69 @@ class HorzMesh {
    Array1DR8 MeshScalingDel4;      /// Coef to biharmonic mixing terms
    HostArray1DR8 MeshScalingDel4H; /// Coef to biharmonic mixing terms
 
+   // Stencil weights
+   // Geometric factors of the cell and vertex stencils fused into a single
+   // coefficient per neighbor. The cell weights are indexed like the CSR
+   // connectivity, and include the edge sign and the inverse cell area.
+
+   Array1DR8 DivWeightsOnCellCSR;      ///< DvEdge*EdgeSign/AreaCell
+   HostArray1DR8 DivWeightsOnCellCSRH; ///< DvEdge*EdgeSign/AreaCell
+
+   Array1DR8 Del2WeightsOnCellCSR;      ///< Del2 scaled DvEdge/DcEdge weights
+   HostArray1DR8 Del2WeightsOnCellCSRH; ///< Del2 scaled DvEdge/DcEdge weights
+
+   Array1DR8 Del4WeightsOnCellCSR;      ///< Del4 scaled DvEdge/DcEdge weights
+   HostArray1DR8 Del4WeightsOnCellCSRH; ///< Del4 scaled DvEdge/DcEdge weights
+
+   Array2DR8 CurlWeightsOnVertex;      ///< DcEdge*EdgeSign/AreaTriangle
+   HostArray2DR8 CurlWeightsOnVertexH; ///< DcEdge*EdgeSign/AreaTriangle
+
+   // Advection stencil
+   // Cells and coefficients of the high-order reconstruction of a scalar on
+   // each edge, from the cells on the edge and their neighbors. The value on
+   // the edge is the sum over the stencil of (AdvCoefs + Coef3rd * sign(u) *
+   // AdvCoefs3rd) times the cell values: AdvCoefs give the 4th-order centered
+   // reconstruction and AdvCoefs3rd its 3rd-order upwind correction.
+
+   Array1DI4 NAdvCellsForEdge;      ///< Num of cells in the edge stencil
+   HostArray1DI4 NAdvCellsForEdgeH; ///< Num of cells in the edge stencil
+
+   Array2DI4 AdvCellsForEdge;      ///< Indx of cells in the edge stencil
+   HostArray2DI4 AdvCellsForEdgeH; ///< Indx of cells in the edge stencil
+
+   Array2DR8 AdvCoefs;      ///< 4th-order coefficients of the edge stencil
+   HostArray2DR8 AdvCoefsH; ///< 4th-order coefficients of the edge stencil
+
+   Array2DR8 AdvCoefs3rd;      ///< 3rd-order upwind correction coefficients
+   HostArray2DR8 AdvCoefs3rdH; ///< 3rd-order upwind correction coefficients
+
    // Methods
 
    /// Initialize Omega local mesh
    static int init();
 
+   /// Starts the initialization of the default mesh. The mesh variables are
+   /// read on a background thread if MPI supports calls from several
+   /// threads, so that modules that only need the decomposition (eg Halo)
+   /// can be initialized during the read. No other IO may be done and the
+   /// mesh must not be used until finishInit is called.
+   static int startInit();
+
+   /// Completes the initialization of the default mesh started by startInit
+   static int finishInit();
+
    /// Creates a new mesh by calling the constructor and puts it in the
    /// AllHorzMeshes map
    static HorzMesh *create(const std::string &Name, ///< [in] Name for mesh
-                           Decomp *Decomp,  ///< [in] Decomposition for mesh
-                           I4 InNVertLevels ///< [in] num vertival levels
+                           Decomp *Decomp,   ///< [in] Decomposition for mesh
+                           I4 InNVertLevels, ///< [in] num vertival levels
+                           bool AsyncRead = false ///< [in] background read
    );
 
+   /// Waits for a background read of the mesh file and completes the mesh.
+   /// Does nothing if the mesh is already complete. Returns an error code.
+   int waitForRead();
+
    /// Destructor - deallocates all memory and deletes a HorzMesh
    ~HorzMesh();
 
@@ -270,6 +405,17 @@ class HorzMesh {
 
    static HorzMesh *get(std::string name);
 
+   /// Get the loop bounds over the owned elements and the first HaloDepth
+   /// halo layers. A depth of 0 gives the owned elements only, and FullHalo or
+   /// a depth of at least the halo width gives all local elements.
+   MeshLoopBounds getLoopBounds(I4 HaloDepth ///< [in] number of halo layers
+   ) const;
+
+   /// Get the number of active edges among the first NEdges edges, the loop
+   /// bound over ActiveEdges matching a loop bound over edges
+   I4 numActiveEdges(I4 NEdges ///< [in] number of edges
+   ) const;
+
 }; // end class HorzMesh
 
 } // end namespace OMEGA
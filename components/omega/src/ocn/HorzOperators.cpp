@@ -1,24 +1,161 @@
 #include "HorzOperators.h"
 #include "DataTypes.h"
 #include "HorzMesh.h"
+#include "Logging.h"
+
+#include <vector>
 
 namespace OMEGA {
 
 DivergenceOnCell::DivergenceOnCell(HorzMesh const *Mesh)
-    : NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      DvEdge(Mesh->DvEdge), AreaCell(Mesh->AreaCell),
-      EdgeSignOnCell(Mesh->EdgeSignOnCell) {}
+    : OffsetsOnCell(Mesh->OffsetsOnCell), EdgesOnCellCSR(Mesh->EdgesOnCellCSR),
+      DivWeightsOnCellCSR(Mesh->DivWeightsOnCellCSR) {}
 
 GradientOnEdge::GradientOnEdge(HorzMesh const *Mesh)
     : CellsOnEdge(Mesh->CellsOnEdge), DcEdge(Mesh->DcEdge) {}
 
 CurlOnVertex::CurlOnVertex(HorzMesh const *Mesh)
     : VertexDegree(Mesh->VertexDegree), EdgesOnVertex(Mesh->EdgesOnVertex),
-      DcEdge(Mesh->DcEdge), AreaTriangle(Mesh->AreaTriangle),
-      EdgeSignOnVertex(Mesh->EdgeSignOnVertex) {}
+      CurlWeightsOnVertex(Mesh->CurlWeightsOnVertex) {}
 
 TangentialReconOnEdge::TangentialReconOnEdge(HorzMesh const *Mesh)
     : NEdgesOnEdge(Mesh->NEdgesOnEdge), EdgesOnEdge(Mesh->EdgesOnEdge),
       WeightsOnEdge(Mesh->WeightsOnEdge) {}
 
+//------------------------------------------------------------------------------
+// SparseOperator
+
+SparseOperator::SparseOperator(I4 InNCols, const HostArray1DI4 &InOffsetsH,
+                               const HostArray1DI4 &InColsH,
+                               const HostArray1DR8 &InWeightsH)
+    : NRows(InOffsetsH.extent(0) - 1), NCols(InNCols),
+      NEntries(InColsH.extent(0)), OffsetsH(InOffsetsH), ColsH(InColsH),
+      WeightsH(InWeightsH) {
+   Offsets = createDeviceMirrorCopy(OffsetsH);
+   Cols    = createDeviceMirrorCopy(ColsH);
+   Weights = createDeviceMirrorCopy(WeightsH);
+}
+
+namespace {
+
+// Creates an operator with NRows rows from the weights of each row, obtained
+// from RowEntries(IRow, RowCols, RowWeights) for the first NRowsLocal rows.
+// The remaining rows have no entries.
+template <class F>
+SparseOperator assembleOperator(const std::string &Name, I4 NRows,
+                                I4 NRowsLocal, I4 NCols, F RowEntries) {
+
+   HostArray1DI4 OffsetsH(Name + "Offsets", NRows + 1);
+   std::vector<I4> AllCols;
+   std::vector<R8> AllWeights;
+
+   OffsetsH(0) = 0;
+   for (int IRow = 0; IRow < NRows; ++IRow) {
+      if (IRow < NRowsLocal)
+         RowEntries(IRow, AllCols, AllWeights);
+      OffsetsH(IRow + 1) = AllCols.size();
+   }
+
+   HostArray1DI4 ColsH(Name + "Cols", AllCols.size());
+   HostArray1DR8 WeightsH(Name + "Weights", AllCols.size());
+   for (size_t J = 0; J < AllCols.size(); ++J) {
+      ColsH(J)    = AllCols[J];
+      WeightsH(J) = AllWeights[J];
+   }
+
+   return SparseOperator(NCols, OffsetsH, ColsH, WeightsH);
+}
+
+} // namespace
+
+SparseOperator SparseOperator::divergenceOnCell(HorzMesh const *Mesh) {
+   return assembleOperator(
+       "DivergenceOnCell", Mesh->NCellsSize, Mesh->NCellsAll, Mesh->NEdgesSize,
+       [&](int ICell, std::vector<I4> &RowCols, std::vector<R8> &RowWeights) {
+          for (int J = Mesh->OffsetsOnCellH(ICell);
+               J < Mesh->OffsetsOnCellH(ICell + 1); ++J) {
+             RowCols.push_back(Mesh->EdgesOnCellCSRH(J));
+             RowWeights.push_back(-Mesh->DivWeightsOnCellCSRH(J));
+          }
+       });
+}
+
+SparseOperator SparseOperator::gradientOnEdge(HorzMesh const *Mesh) {
+   return assembleOperator(
+       "GradientOnEdge", Mesh->NEdgesSize, Mesh->NEdgesAll, Mesh->NCellsSize,
+       [&](int IEdge, std::vector<I4> &RowCols, std::vector<R8> &RowWeights) {
+          const Real InvDcEdge = 1._Real / Mesh->DcEdgeH(IEdge);
+          RowCols.push_back(Mesh->CellsOnEdgeH(IEdge, 0));
+          RowWeights.push_back(-InvDcEdge);
+          RowCols.push_back(Mesh->CellsOnEdgeH(IEdge, 1));
+          RowWeights.push_back(InvDcEdge);
+       });
+}
+
+SparseOperator SparseOperator::curlOnVertex(HorzMesh const *Mesh) {
+   return assembleOperator(
+       "CurlOnVertex", Mesh->NVerticesSize, Mesh->NVerticesAll,
+       Mesh->NEdgesSize,
+       [&](int IVertex, std::vector<I4> &RowCols, std::vector<R8> &RowWeights) {
+          for (int J = 0; J < Mesh->VertexDegree; ++J) {
+             RowCols.push_back(Mesh->EdgesOnVertexH(IVertex, J));
+             RowWeights.push_back(Mesh->CurlWeightsOnVertexH(IVertex, J));
+          }
+       });
+}
+
+SparseOperator SparseOperator::tangentialReconOnEdge(HorzMesh const *Mesh) {
+   return assembleOperator(
+       "TangentialReconOnEdge", Mesh->NEdgesSize, Mesh->NEdgesAll,
+       Mesh->NEdgesSize,
+       [&](int IEdge, std::vector<I4> &RowCols, std::vector<R8> &RowWeights) {
+          for (int J = 0; J < Mesh->NEdgesOnEdgeH(IEdge); ++J) {
+             RowCols.push_back(Mesh->EdgesOnEdgeH(IEdge, J));
+             RowWeights.push_back(Mesh->WeightsOnEdgeH(IEdge, J));
+          }
+       });
+}
+
+// Row by row product on the host. The weights of a row of the product are
+// accumulated in a dense row, in the order the input rows first appear, so
+// that the result does not depend on the ordering of the columns.
+int SparseOperator::multiply(SparseOperator &Product,
+                             const SparseOperator &B) const {
+
+   if (B.NRows != NCols) {
+      LOG_ERROR("SparseOperator: cannot apply an operator with {} input rows "
+                "to an operator with {} rows",
+                NCols, B.NRows);
+      return 1;
+   }
+
+   std::vector<R8> RowWeights(B.NCols, 0);
+   std::vector<bool> InRow(B.NCols, false);
+
+   Product = assembleOperator(
+       "SparseOperatorProduct", NRows, NRows, B.NCols,
+       [&](int IRow, std::vector<I4> &RowCols, std::vector<R8> &AllWeights) {
+          const size_t RowStart = RowCols.size();
+          for (int J = OffsetsH(IRow); J < OffsetsH(IRow + 1); ++J) {
+             const I4 IMid = ColsH(J);
+             for (int L = B.OffsetsH(IMid); L < B.OffsetsH(IMid + 1); ++L) {
+                const I4 JCol = B.ColsH(L);
+                if (!InRow[JCol]) {
+                   InRow[JCol] = true;
+                   RowCols.push_back(JCol);
+                }
+                RowWeights[JCol] += WeightsH(J) * B.WeightsH(L);
+             }
+          }
+          for (size_t J = RowStart; J < RowCols.size(); ++J) {
+             const I4 JCol = RowCols[J];
+             AllWeights.push_back(RowWeights[JCol]);
+             RowWeights[JCol] = 0;
+             InRow[JCol]      = false;
+          }
+       });
+
+   return 0;
+}
+
 } // namespace OMEGA
@@ -10,50 +10,51 @@ class DivergenceOnCell {
  public:
    DivergenceOnCell(HorzMesh const *Mesh);
 
+   template <int W = VecLength>
    KOKKOS_FUNCTION void operator()(const Array2DReal &DivCell, int ICell,
                                    int KChunk,
                                    const Array2DReal &VecEdge) const {
-      const int KStart       = KChunk * VecLength;
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, DivCell);
 
-      Real DivCellTmp[VecLength] = {0};
+      Real DivCellTmp[W] = {0};
 
-      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
-         const int JEdge = EdgesOnCell(ICell, J);
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
+      for (int J = OffsetsOnCell(ICell); J < OffsetsOnCell(ICell + 1); ++J) {
+         const int JEdge   = EdgesOnCellCSR(J);
+         const Real DivWgt = DivWeightsOnCellCSR(J);
+         for (int KVec = 0; KVec < KLen; ++KVec) {
             const int K = KStart + KVec;
-            DivCellTmp[KVec] -= DvEdge(JEdge) * EdgeSignOnCell(ICell, J) *
-                                VecEdge(JEdge, K) * InvAreaCell;
+            DivCellTmp[KVec] -= DivWgt * VecEdge(JEdge, K);
          }
       }
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
+      for (int KVec = 0; KVec < KLen; ++KVec) {
          const int K       = KStart + KVec;
          DivCell(ICell, K) = DivCellTmp[KVec];
       }
    }
 
  private:
-   Array1DI4 NEdgesOnCell;
-   Array2DI4 EdgesOnCell;
-   Array1DR8 DvEdge;
-   Array1DR8 AreaCell;
-   Array2DR8 EdgeSignOnCell;
+   Array1DI4 OffsetsOnCell;
+   Array1DI4 EdgesOnCellCSR;
+   Array1DR8 DivWeightsOnCellCSR;
 };
 
 class GradientOnEdge {
  public:
    GradientOnEdge(HorzMesh const *Mesh);
 
+   template <int W = VecLength>
    KOKKOS_FUNCTION void operator()(const Array2DReal &GradEdge, int IEdge,
                                    int KChunk,
                                    const Array2DReal &ScalarCell) const {
-      const int KStart     = KChunk * VecLength;
+      const int KStart     = KChunk * W;
+      const int KLen       = chunkLength<W>(KStart, GradEdge);
       const Real InvDcEdge = 1._Real / DcEdge(IEdge);
       const auto JCell0    = CellsOnEdge(IEdge, 0);
       const auto JCell1    = CellsOnEdge(IEdge, 1);
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
+      for (int KVec = 0; KVec < KLen; ++KVec) {
          const int K = KStart + KVec;
          GradEdge(IEdge, K) =
              InvDcEdge * (ScalarCell(JCell1, K) - ScalarCell(JCell0, K));
@@ -69,25 +70,25 @@ class CurlOnVertex {
  public:
    CurlOnVertex(HorzMesh const *Mesh);
 
+   template <int W = VecLength>
    KOKKOS_FUNCTION void operator()(const Array2DReal &CurlVertex, int IVertex,
                                    int KChunk,
                                    const Array2DReal &VecEdge) const {
-      const int KStart           = KChunk * VecLength;
-      const Real InvAreaTriangle = 1._Real / AreaTriangle(IVertex);
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, CurlVertex);
 
-      Real CurlVertexTmp[VecLength] = {0};
+      Real CurlVertexTmp[W] = {0};
 
       for (int J = 0; J < VertexDegree; ++J) {
-         const int JEdge = EdgesOnVertex(IVertex, J);
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const int JEdge    = EdgesOnVertex(IVertex, J);
+         const Real CurlWgt = CurlWeightsOnVertex(IVertex, J);
+         for (int KVec = 0; KVec < KLen; ++KVec) {
             const int K = KStart + KVec;
-            CurlVertexTmp[KVec] += DcEdge(JEdge) *
-                                   EdgeSignOnVertex(IVertex, J) *
-                                   VecEdge(JEdge, K) * InvAreaTriangle;
+            CurlVertexTmp[KVec] += CurlWgt * VecEdge(JEdge, K);
          }
       }
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
+      for (int KVec = 0; KVec < KLen; ++KVec) {
          const int K            = KStart + KVec;
          CurlVertex(IVertex, K) = CurlVertexTmp[KVec];
       }
@@ -96,31 +97,31 @@ class CurlOnVertex {
  private:
    I4 VertexDegree;
    Array2DI4 EdgesOnVertex;
-   Array1DR8 DcEdge;
-   Array1DR8 AreaTriangle;
-   Array2DR8 EdgeSignOnVertex;
+   Array2DR8 CurlWeightsOnVertex;
 };
 
 class TangentialReconOnEdge {
  public:
    TangentialReconOnEdge(HorzMesh const *Mesh);
 
+   template <int W = VecLength>
    KOKKOS_FUNCTION void operator()(const Array2DReal &ReconEdge, int IEdge,
                                    int KChunk,
                                    const Array2DReal &VecEdge) const {
-      const int KStart = KChunk * VecLength;
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, ReconEdge);
 
-      Real ReconEdgeTmp[VecLength] = {0};
+      Real ReconEdgeTmp[W] = {0};
 
       for (int J = 0; J < NEdgesOnEdge(IEdge); ++J) {
          const int JEdge = EdgesOnEdge(IEdge, J);
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
+         for (int KVec = 0; KVec < KLen; ++KVec) {
             const int K = KStart + KVec;
             ReconEdgeTmp[KVec] += WeightsOnEdge(IEdge, J) * VecEdge(JEdge, K);
          }
       }
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
+      for (int KVec = 0; KVec < KLen; ++KVec) {
          const int K         = KStart + KVec;
          ReconEdge(IEdge, K) = ReconEdgeTmp[KVec];
       }
@@ -132,5 +133,72 @@ class TangentialReconOnEdge {
    Array2DR8 WeightsOnEdge;
 };
 
+/// A linear horizontal operator stored as a sparse matrix in compressed row
+/// (CSR) form. Row IRow of the result is the sum, over the entries J from
+/// Offsets(IRow) to Offsets(IRow + 1) - 1, of Weights(J) times row Cols(J) of
+/// the input, on all levels of the vertical chunk. The stencil operators
+/// above can be assembled in this form, so that they share the same kernel,
+/// and operators can be composed by multiplying their matrices.
+class SparseOperator {
+ public:
+   /// Creates an empty operator
+   SparseOperator() = default;
+
+   /// Creates an operator with NCols input rows from the host CSR arrays,
+   /// which are copied to the device
+   SparseOperator(I4 NCols, const HostArray1DI4 &OffsetsH,
+                  const HostArray1DI4 &ColsH, const HostArray1DR8 &WeightsH);
+
+   /// Assembles the stencil operators for all local mesh elements. The
+   /// matrices have a row for each cell, edge or vertex of the arrays of the
+   /// result (NCellsSize, NEdgesSize or NVerticesSize), with no entries
+   /// beyond the local elements.
+   static SparseOperator divergenceOnCell(HorzMesh const *Mesh);
+   static SparseOperator gradientOnEdge(HorzMesh const *Mesh);
+   static SparseOperator curlOnVertex(HorzMesh const *Mesh);
+   static SparseOperator tangentialReconOnEdge(HorzMesh const *Mesh);
+
+   /// Computes the operator that applies B and then this operator. Returns
+   /// an error if the number of rows of B is not the number of columns of
+   /// this operator.
+   int multiply(SparseOperator &Product,  ///< [out] product operator
+                const SparseOperator &B ///< [in] operator applied first
+   ) const;
+
+   template <int W = VecLength>
+   KOKKOS_FUNCTION void operator()(const Array2DReal &Out, int IRow,
+                                   int KChunk, const Array2DReal &In) const {
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, Out);
+
+      Real OutTmp[W] = {0};
+
+      for (int J = Offsets(IRow); J < Offsets(IRow + 1); ++J) {
+         const int JCol  = Cols(J);
+         const Real JWgt = Weights(J);
+         for (int KVec = 0; KVec < KLen; ++KVec) {
+            const int K = KStart + KVec;
+            OutTmp[KVec] += JWgt * In(JCol, K);
+         }
+      }
+
+      for (int KVec = 0; KVec < KLen; ++KVec) {
+         const int K  = KStart + KVec;
+         Out(IRow, K) = OutTmp[KVec];
+      }
+   }
+
+   I4 NRows    = 0; ///< Number of rows of the result
+   I4 NCols    = 0; ///< Number of rows of the input
+   I4 NEntries = 0; ///< Number of nonzero weights
+
+   Array1DI4 Offsets;      ///< Start of each row in Cols and Weights
+   HostArray1DI4 OffsetsH; ///< Start of each row in Cols and Weights
+   Array1DI4 Cols;         ///< Input row of each entry
+   HostArray1DI4 ColsH;    ///< Input row of each entry
+   Array1DR8 Weights;      ///< Weight of each entry
+   HostArray1DR8 WeightsH; ///< Weight of each entry
+};
+
 } // namespace OMEGA
 #endif
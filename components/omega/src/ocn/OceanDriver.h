@@ -12,12 +12,26 @@
 //===----------------------------------------------------------------------===//
 
 #include "Config.h"
+#include "DataTypes.h"
 #include "TimeMgr.h"
 
 #include "mpi.h"
 
+#include <string>
+
 namespace OMEGA {
 
+/// Options of the scaling mode of the standalone driver, read from the
+/// optional Scaling group of the Config
+struct ScalingOptions {
+   bool Enabled   = false; ///< run the scaling mode instead of ocnRun
+   I4 WarmupSteps = 2;     ///< untimed steps before the timed steps
+   I4 TimedSteps  = 10;    ///< steps included in the throughput
+
+   /// Name of the JSON summary written by the master task
+   std::string SummaryFile = "OmegaScaling.json";
+};
+
 /// Read the config file and call all the inidividual initialization routines
 /// for each Omega module
 int ocnInit(MPI_Comm Comm, Calendar &OmegaCal, TimeInstant &StartTime,
@@ -26,6 +40,27 @@ int ocnInit(MPI_Comm Comm, Calendar &OmegaCal, TimeInstant &StartTime,
 /// Advance the model from starting from CurrTime until EndAlarm rings
 int ocnRun(TimeInstant &CurrTime, Alarm &EndAlarm);
 
+/// Read the scaling mode options from the optional Scaling group of Config
+int readScalingOptions(ScalingOptions &Options, Config *OmegaConfig);
+
+/// Advance the model from CurrTime by the warm-up steps and the timed steps
+/// of the scaling mode, independent of the end of the run, then report the
+/// simulated years per day, the timer breakdown of the timed steps and the
+/// memory high-water mark of each task and write them to the summary file
+int ocnScalingRun(TimeInstant &CurrTime, const ScalingOptions &Options);
+
+/// Read the number of ensemble members from the --members command line
+/// argument, one if it is not present
+int readEnsembleArgs(int argc, char **argv, I4 &NumMembers);
+
+/// Split InComm into equal contiguous groups of tasks, one per ensemble
+/// member, and return the member of the local task and its communicator
+int ocnEnsembleSplit(MPI_Comm InComm, I4 NumMembers, I4 &MemberID,
+                     MPI_Comm &MemberComm);
+
+/// Return the run directory of an ensemble member, member001 for the first
+std::string getEnsembleMemberDir(I4 MemberID);
+
 /// Clean up all Omega objects
 int ocnFinalize(const TimeInstant &CurrTime);
 
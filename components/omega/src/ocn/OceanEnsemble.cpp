@@ -0,0 +1,113 @@
+//===-- ocn/OceanEnsemble.cpp - Ensemble mode of the driver -----*- C++ -*-===//
+//
+// The ensemble mode of the standalone driver runs several independent Omega
+// members in one executable. The tasks of the input communicator are split
+// into equal contiguous groups, one per member, and each member runs in its
+// own communicator from its own run directory, so that each member reads
+// its own config file and writes its own log and output files.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "Logging.h"
+#include "OceanDriver.h"
+
+#include "mpi.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Read the number of ensemble members from the command line arguments
+
+int readEnsembleArgs(int argc,      ///< [in] number of arguments
+                     char **argv,   ///< [in] command line arguments
+                     I4 &NumMembers ///< [out] number of ensemble members
+) {
+
+   NumMembers = 1;
+
+   for (int Arg = 1; Arg < argc; ++Arg) {
+      std::string ArgStr(argv[Arg]);
+      if (ArgStr != "--members")
+         continue;
+
+      if (Arg + 1 >= argc) {
+         LOG_CRITICAL("ocnEnsemble: --members requires the number of members");
+         return 1;
+      }
+
+      char *End  = nullptr;
+      long Value = std::strtol(argv[Arg + 1], &End, 10);
+      if (End == argv[Arg + 1] or *End != '\0' or Value < 1) {
+         LOG_CRITICAL("ocnEnsemble: invalid number of members {}",
+                      argv[Arg + 1]);
+         return 1;
+      }
+      NumMembers = static_cast<I4>(Value);
+      ++Arg;
+   }
+
+   return 0;
+
+} // end readEnsembleArgs
+
+//------------------------------------------------------------------------------
+// Split the input communicator into one communicator per ensemble member
+
+int ocnEnsembleSplit(MPI_Comm InComm,     ///< [in] communicator to split
+                     I4 NumMembers,       ///< [in] number of members
+                     I4 &MemberID,        ///< [out] member of local task
+                     MPI_Comm &MemberComm ///< [out] member communicator
+) {
+
+   I4 Err = 0;
+
+   int MyTask   = 0;
+   int NumTasks = 1;
+   MPI_Comm_rank(InComm, &MyTask);
+   MPI_Comm_size(InComm, &NumTasks);
+
+   if (NumMembers < 1 or NumTasks % NumMembers != 0) {
+      LOG_CRITICAL("ocnEnsemble: {} tasks cannot be split evenly into {} "
+                   "ensemble members",
+                   NumTasks, NumMembers);
+      return 1;
+   }
+
+   // members use contiguous blocks of tasks so that the tasks of a member
+   // share nodes where possible
+   I4 TasksPerMember = NumTasks / NumMembers;
+   MemberID          = MyTask / TasksPerMember;
+
+   Err = MPI_Comm_split(InComm, MemberID, MyTask, &MemberComm);
+   if (Err != MPI_SUCCESS) {
+      LOG_CRITICAL("ocnEnsemble: error splitting communicator for member {}",
+                   MemberID);
+      return Err;
+   }
+
+   return 0;
+
+} // end ocnEnsembleSplit
+
+//------------------------------------------------------------------------------
+// Return the run directory of an ensemble member
+
+std::string getEnsembleMemberDir(I4 MemberID ///< [in] ensemble member
+) {
+
+   // member directories are numbered from one as member001, member002, ...
+   char DirName[32];
+   std::snprintf(DirName, sizeof(DirName), "member%03d", MemberID + 1);
+
+   return std::string(DirName);
+
+} // end getEnsembleMemberDir
+
+} // end namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -5,18 +5,31 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "Analysis.h"
 #include "AuxiliaryState.h"
+#include "Checkpoint.h"
+#include "CouplerState.h"
 #include "Decomp.h"
+#include "Eos.h"
 #include "Field.h"
+#include "Forcing.h"
 #include "Halo.h"
 #include "HorzMesh.h"
 #include "IO.h"
+#include "IOStream.h"
+#include "KernelCounters.h"
+#include "KernelScheduler.h"
+#include "KernelTuner.h"
 #include "MachEnv.h"
+#include "MemoryTracker.h"
 #include "OceanDriver.h"
 #include "OceanState.h"
+#include "Telemetry.h"
 #include "TendencyTerms.h"
 #include "TimeMgr.h"
 #include "TimeStepper.h"
+#include "Timer.h"
+#include "Tracers.h"
 
 namespace OMEGA {
 
@@ -28,16 +41,46 @@ int ocnFinalize(const TimeInstant &CurrTime ///< [in] current sim time
 
    // Write restart file if necessary
 
+   // Write the costs of the cells for a rebalanced partition on restart,
+   // from the time stepping work outside of the halo exchanges
+   Decomp *DefDecomp = Decomp::getDefault();
+   if (DefDecomp != nullptr and !DefDecomp->getCostFile().empty()) {
+      const R8 WorkTime = Timer::getTime("ocnRun:TimeStepper") -
+                          Timer::getNestedTime("ocnRun:TimeStepper", "Halo");
+      RetVal += DefDecomp->writeCost(MachEnv::getDefault(), WorkTime);
+   }
+
+   // Write the timing summary, the kernel counters and the memory use before
+   // the modules are destroyed
+   RetVal += Timer::finalize();
+   RetVal += KernelCounters::finalize();
+   RetVal += KernelTuner::finalize();
+   RetVal += KernelScheduler::finalize();
+   RetVal += MemoryTracker::print("finalize");
+
+   // Complete the last fast checkpoint
+   RetVal += Checkpoint::finalize();
+
+   // Release the telemetry reduction operator
+   RetVal += Telemetry::finalize();
+
    // clean up all objects
+   AnalysisMember::clear();
+   Forcing::clear();
+   CouplerState::clear();
+   Eos::clear();
    TimeStepper::clear();
+   Tracers::clear();
    Tendencies::clear();
    AuxiliaryState::clear();
    OceanState::clear();
+   IOStream::clearDecomps();
    Dimension::clear();
    Field::clear();
    HorzMesh::clear();
    Halo::clear();
    Decomp::clear();
+   MemoryTracker::finalize();
    MachEnv::removeAll();
 
    return RetVal;
@@ -7,21 +7,33 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "Analysis.h"
 #include "AuxiliaryState.h"
+#include "Checkpoint.h"
 #include "Config.h"
+#include "CouplerState.h"
 #include "DataTypes.h"
 #include "Decomp.h"
+#include "Eos.h"
 #include "Field.h"
+#include "Forcing.h"
 #include "Halo.h"
 #include "HorzMesh.h"
 #include "IO.h"
+#include "KernelCounters.h"
+#include "KernelScheduler.h"
+#include "KernelTuner.h"
 #include "Logging.h"
 #include "MachEnv.h"
+#include "MemoryTracker.h"
 #include "OceanDriver.h"
 #include "OceanState.h"
+#include "Telemetry.h"
 #include "TendencyTerms.h"
 #include "TimeMgr.h"
 #include "TimeStepper.h"
+#include "Timer.h"
+#include "Tracers.h"
 
 #include "mpi.h"
 
@@ -65,6 +77,47 @@ int ocnInit(MPI_Comm Comm,          ///< [in] ocean MPI communicator
       return Err;
    }
 
+   // enable fast checkpoints and reload the state from the last one if it
+   // matches this decomposition
+   Err = Checkpoint::init(StartTime);
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing checkpoints");
+      return Err;
+   }
+   // enable the optional throughput telemetry log
+   Err = Telemetry::init();
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing telemetry");
+      return Err;
+   }
+
+   if (Checkpoint::isRestartEnabled()) {
+      bool Restarted = false;
+      Err            = Checkpoint::restart(StartTime, Restarted);
+      if (Err != 0) {
+         LOG_CRITICAL("ocnInit: Error restarting from checkpoint");
+         return Err;
+      }
+   }
+
+   // read the surface forcing records that bracket the (restart) start time
+   MemoryTracker::start("Forcing");
+   Err = Forcing::init(StartTime);
+   MemoryTracker::stop("Forcing");
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing surface forcing");
+      return Err;
+   }
+
+   // create the analysis members once all fields are defined
+   MemoryTracker::start("Analysis");
+   Err = AnalysisMember::init(StartTime);
+   MemoryTracker::stop("Analysis");
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing analysis members");
+      return Err;
+   }
+
    return Err;
 } // end ocnInit
 
@@ -169,6 +222,40 @@ int initOmegaModules(MPI_Comm Comm) {
    I4 Err = 0;
 
    // initialize all necessary Omega modules
+   Err = Timer::init();
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing timers");
+      return Err;
+   }
+
+   // attribute the Kokkos allocations of each module to that module
+   Err = MemoryTracker::init();
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing memory tracker");
+      return Err;
+   }
+
+   // measure the bandwidth and flop rate of the annotated kernels
+   Err = KernelCounters::init();
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing kernel counters");
+      return Err;
+   }
+
+   // choose the policies of the labeled kernels, or read them from the cache
+   Err = KernelTuner::init();
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing kernel tuner");
+      return Err;
+   }
+
+   // run independent kernels concurrently on partitioned device instances
+   Err = KernelScheduler::init();
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing kernel scheduler");
+      return Err;
+   }
+
    Err = IO::init(Comm);
    if (Err != 0) {
       LOG_CRITICAL("ocnInit: Error initializing parallel IO");
@@ -181,48 +268,109 @@ int initOmegaModules(MPI_Comm Comm) {
       return Err;
    }
 
+   MemoryTracker::start("Decomp");
    Err = Decomp::init();
+   MemoryTracker::stop("Decomp");
    if (Err != 0) {
       LOG_CRITICAL("ocnInit: Error initializing default decomposition");
       return Err;
    }
 
+   // The mesh variables only depend on the decomposition, so the mesh file
+   // is read in the background while the halo exchange lists are built.
+   // No other IO can be done until the mesh initialization is finished.
+   MemoryTracker::start("HorzMesh");
+   Err = HorzMesh::startInit();
+   MemoryTracker::stop("HorzMesh");
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing default mesh");
+      return Err;
+   }
+
+   MemoryTracker::start("Halo");
    Err = Halo::init();
+   MemoryTracker::stop("Halo");
    if (Err != 0) {
       LOG_CRITICAL("ocnInit: Error initializing default halo");
       return Err;
    }
 
-   Err = HorzMesh::init();
+   MemoryTracker::start("HorzMesh");
+   Err = HorzMesh::finishInit();
+   MemoryTracker::stop("HorzMesh");
    if (Err != 0) {
-      LOG_CRITICAL("ocnInit: Error initializing default mesh");
+      LOG_CRITICAL("ocnInit: Error completing default mesh");
       return Err;
    }
 
+   MemoryTracker::start("AuxiliaryState");
    Err = AuxiliaryState::init();
+   MemoryTracker::stop("AuxiliaryState");
    if (Err != 0) {
       LOG_CRITICAL("ocnInit: Error initializing default aux state");
       return Err;
    }
 
+   MemoryTracker::start("Tendencies");
    Err = Tendencies::init();
+   MemoryTracker::stop("Tendencies");
    if (Err != 0) {
       LOG_CRITICAL("ocnInit: Error initializing default tendencies");
       return Err;
    }
 
+   // Release the auxiliary variables that no enabled tendency term uses
+   AuxiliaryState::getDefault()->setNeededAuxVars(
+       Tendencies::getDefault()->getNeededAuxVars());
+
+   MemoryTracker::start("TimeStepper");
    Err = TimeStepper::init();
+   MemoryTracker::stop("TimeStepper");
    if (Err != 0) {
       LOG_CRITICAL("ocnInit: Error initializing default time stepper");
       return Err;
    }
 
+   // Tracers need the number of time levels of the default time stepper
+   MemoryTracker::start("Tracers");
+   Err = Tracers::init();
+   MemoryTracker::stop("Tracers");
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing tracers");
+      return Err;
+   }
+
+   MemoryTracker::start("OceanState");
    Err = OceanState::init();
+   MemoryTracker::stop("OceanState");
    if (Err != 0) {
       LOG_CRITICAL("ocnInit: Error initializing default state");
       return Err;
    }
 
+   MemoryTracker::start("Eos");
+   Err = Eos::init();
+   MemoryTracker::stop("Eos");
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing equation of state");
+      return Err;
+   }
+
+   // The coupler state exports the surface of the default state and tracers
+   MemoryTracker::start("CouplerState");
+   Err = CouplerState::init();
+   MemoryTracker::stop("CouplerState");
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error initializing coupler state");
+      return Err;
+   }
+
+   Err = MemoryTracker::print("init");
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: Error writing memory use");
+      return Err;
+   }
+
    return Err;
 } // end initOmegaModules
 
@@ -6,8 +6,16 @@
 //===----------------------------------------------------------------------===//
 
 #include "OceanDriver.h"
+#include "Analysis.h"
+#include "Checkpoint.h"
+#include "CouplerState.h"
+#include "Forcing.h"
+#include "KernelCounters.h"
+#include "Logging.h"
 #include "OceanState.h"
+#include "Telemetry.h"
 #include "TimeStepper.h"
+#include "Timer.h"
 
 namespace OMEGA {
 
@@ -29,33 +37,97 @@ int ocnRun(TimeInstant &CurrTime, ///< [inout] current sim time
    Clock OmegaClock(CurrTime, TimeStep);
    Err = OmegaClock.attachAlarm(&EndAlarm);
 
+   // the telemetry alarm continues its interval across coupling intervals
+   Err += Telemetry::attach(OmegaClock);
+
    if (TimeStep == ZeroInterval) {
       LOG_ERROR("ocnRun: TimeStep must be initialized");
       ++Err;
    }
 
+   // Options for the per-step progress message, which can be written every
+   // StepLogInterval steps and only by the master task
+   I4 StepLogInterval     = 1;
+   bool StepLogMasterOnly = true;
+   if (ConfigParams::exists("Logging:StepLogInterval"))
+      Err += ConfigParams::get("Logging:StepLogInterval", StepLogInterval);
+   if (ConfigParams::exists("Logging:StepLogMasterOnly"))
+      Err += ConfigParams::get("Logging:StepLogMasterOnly", StepLogMasterOnly);
+   if (StepLogInterval < 1) {
+      LOG_ERROR("ocnRun: StepLogInterval must be positive");
+      ++Err;
+   }
+
    I8 IStep = 0;
 
+   TimerRegion RunTimer("ocnRun");
+
+   // The coupler updates the imports once per call, before the surface
+   // forcing is needed by the time steps of the coupling interval
+   if (Err == 0 and CouplerState::isEnabled())
+      Err = CouplerState::importFields();
+
    // time loop, integrate until EndAlarm or error encountered
    while (Err == 0 && !(EndAlarm.isRinging())) {
 
+      // adjust an adaptive time step to the CFL number of the current state
+      // and keep the clock in step, without stepping past the end of the run
+      if (DefTimeStepper->isAdaptive()) {
+         bool StepChanged = false;
+         if (IStep % DefTimeStepper->getCFLCheckInterval() == 0)
+            StepChanged = DefTimeStepper->adaptTimeStep(
+                DefOceanState, DefOceanState->CurLevel);
+
+         TimeInterval Remaining =
+             EndAlarm.getRingTime() - OmegaClock.getCurrentTime();
+         if (Remaining > ZeroInterval and
+             Remaining < DefTimeStepper->getTimeStep()) {
+            DefTimeStepper->setTimeStep(Remaining);
+            StepChanged = true;
+         }
+
+         if (StepChanged)
+            Err = OmegaClock.changeTimeStep(DefTimeStepper->getTimeStep());
+      }
+
       // advance clock
       OmegaClock.advance();
       ++IStep;
 
-      // call forcing routines, anything needed pre-timestep
+      // interpolate the surface forcing to the start of the step, anything
+      // else needed pre-timestep
+      TimeInstant SimTime = OmegaClock.getPreviousTime();
+      if (Forcing::isEnabled()) {
+         Err = Forcing::update(SimTime);
+         if (Err != 0) {
+            LOG_ERROR("ocnRun: error updating the surface forcing");
+            break;
+         }
+      }
 
       // do forward time step
-      TimeInstant SimTime = OmegaClock.getPreviousTime();
+      Timer::start("TimeStepper");
       DefTimeStepper->doStep(DefOceanState, SimTime);
+      Timer::stop("TimeStepper");
+      KernelCounters::endStep();
 
       // write restart file/output, anything needed post-timestep
+      Err += AnalysisMember::accumulateAll(OmegaClock);
+      Err += Checkpoint::write(OmegaClock);
 
       CurrTime = OmegaClock.getCurrentTime();
-      LOG_INFO("ocnRun: Time step {} complete, clock time: {}", IStep,
-               CurrTime.getString(4, 4, "-"));
+      Err += Telemetry::write(OmegaClock, IStep);
+      if (IStep % StepLogInterval == 0 and
+          (!StepLogMasterOnly or isLogMasterTask())) {
+         LOG_INFO("ocnRun: Time step {} complete, clock time: {}", IStep,
+                  CurrTime.getString(4, 4, "-"));
+      }
    }
 
+   // Export the surface state at the end of the coupling interval
+   if (Err == 0 and CouplerState::isEnabled())
+      Err = CouplerState::exportFields();
+
    return Err;
 
 } // end ocnRun
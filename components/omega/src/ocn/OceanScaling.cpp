@@ -0,0 +1,298 @@
+//===-- ocn/OceanScaling.cpp - Scaling mode of the driver -------*- C++ -*-===//
+//
+// The scaling mode of the standalone driver advances the model by a fixed
+// number of untimed warm-up steps followed by a fixed number of timed steps,
+// independent of the duration of the run. The throughput of the timed steps
+// is reported in simulated years per day (SYPD), together with the timer
+// breakdown of the timed steps and the memory high-water mark of each task,
+// and a JSON summary is written by the master task for scripted weak and
+// strong scaling studies.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Config.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanDriver.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include "TimeStepper.h"
+#include "Timer.h"
+
+#include "mpi.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Read the scaling options from the optional Scaling config group
+
+int readScalingOptions(ScalingOptions &Options, ///< [out] scaling options
+                       Config *OmegaConfig      ///< [in] Omega config
+) {
+
+   I4 Err = 0;
+
+   if (not OmegaConfig->existsGroup("Scaling"))
+      return Err;
+
+   Config ScalingConfig("Scaling");
+   Err = OmegaConfig->get(ScalingConfig);
+   if (Err != 0) {
+      LOG_CRITICAL("ocnInit: error reading Scaling group from Config");
+      return Err;
+   }
+
+   if (ScalingConfig.existsVar("Enabled")) {
+      Err = ScalingConfig.get("Enabled", Options.Enabled);
+      if (Err != 0) {
+         LOG_CRITICAL("ocnInit: error reading Enabled from Scaling Config");
+         return Err;
+      }
+   }
+   if (ScalingConfig.existsVar("WarmupSteps")) {
+      Err = ScalingConfig.get("WarmupSteps", Options.WarmupSteps);
+      if (Err != 0) {
+         LOG_CRITICAL("ocnInit: error reading WarmupSteps from Scaling Config");
+         return Err;
+      }
+   }
+   if (ScalingConfig.existsVar("TimedSteps")) {
+      Err = ScalingConfig.get("TimedSteps", Options.TimedSteps);
+      if (Err != 0) {
+         LOG_CRITICAL("ocnInit: error reading TimedSteps from Scaling Config");
+         return Err;
+      }
+   }
+   if (ScalingConfig.existsVar("SummaryFile")) {
+      Err = ScalingConfig.get("SummaryFile", Options.SummaryFile);
+      if (Err != 0) {
+         LOG_CRITICAL("ocnInit: error reading SummaryFile from Scaling Config");
+         return Err;
+      }
+   }
+
+   if (Options.WarmupSteps < 0 or Options.TimedSteps < 1) {
+      LOG_CRITICAL("ocnInit: Scaling requires WarmupSteps >= 0 and "
+                   "TimedSteps >= 1, found {} and {}",
+                   Options.WarmupSteps, Options.TimedSteps);
+      return -1;
+   }
+
+   return Err;
+
+} // end readScalingOptions
+
+//------------------------------------------------------------------------------
+// Advance the clock and the default state by one time step, adapting an
+// adaptive time step as in ocnRun
+
+static int scalingStep(Clock &OmegaClock,   ///< [inout] model clock
+                       I8 IStep,            ///< [in] step counter
+                       OceanState *State,   ///< [inout] ocean state
+                       TimeStepper *Stepper ///< [in] time stepper
+) {
+
+   I4 Err = 0;
+
+   if (Stepper->isAdaptive() and
+       IStep % Stepper->getCFLCheckInterval() == 0 and
+       Stepper->adaptTimeStep(State, State->CurLevel))
+      Err = OmegaClock.changeTimeStep(Stepper->getTimeStep());
+
+   OmegaClock.advance();
+
+   TimeInstant SimTime = OmegaClock.getPreviousTime();
+   Timer::start("TimeStepper");
+   Stepper->doStep(State, SimTime);
+   Timer::stop("TimeStepper");
+
+   return Err;
+
+} // end scalingStep
+
+//------------------------------------------------------------------------------
+// Returns the resident set size high-water mark of this task in MB
+
+static R8 getMaxRSS() {
+
+   struct rusage Usage;
+   if (getrusage(RUSAGE_SELF, &Usage) != 0)
+      return 0;
+
+   // ru_maxrss is reported in bytes on macOS and in kilobytes elsewhere
+#ifdef __APPLE__
+   return static_cast<R8>(Usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+   return static_cast<R8>(Usage.ru_maxrss) / 1024.0;
+#endif
+
+} // end getMaxRSS
+
+//------------------------------------------------------------------------------
+// Run the warm-up and timed steps and report the scaling summary
+
+int ocnScalingRun(TimeInstant &CurrTime,        ///< [inout] current sim time
+                  const ScalingOptions &Options ///< [in] scaling options
+) {
+
+   I4 Err = 0;
+
+   MachEnv *DefEnv = MachEnv::getDefault();
+   MPI_Comm Comm   = DefEnv->getComm();
+   I4 NumTasks     = DefEnv->getNumTasks();
+   I4 MasterTask   = DefEnv->getMasterTask();
+
+   OceanState *DefOceanState   = OceanState::getDefault();
+   TimeStepper *DefTimeStepper = TimeStepper::getDefault();
+
+   TimeInterval TimeStep = DefTimeStepper->getTimeStep();
+   TimeInterval ZeroInterval;
+   if (TimeStep == ZeroInterval) {
+      LOG_ERROR("ocnScalingRun: TimeStep must be initialized");
+      return -1;
+   }
+   Clock OmegaClock(CurrTime, TimeStep);
+
+   I8 IStep = 0;
+
+   // warm-up steps are excluded from the timers and the throughput
+   for (I4 I = 0; Err == 0 and I < Options.WarmupSteps; ++I) {
+      Err = scalingStep(OmegaClock, IStep, DefOceanState, DefTimeStepper);
+      ++IStep;
+   }
+   if (Err != 0) {
+      LOG_ERROR("ocnScalingRun: error in warm-up steps");
+      return Err;
+   }
+
+   Kokkos::fence();
+   MPI_Barrier(Comm);
+   Timer::clear();
+
+   TimeInstant TimedStart = OmegaClock.getCurrentTime();
+   R8 StartTime           = MPI_Wtime();
+   {
+      TimerRegion RunTimer("ocnRun");
+      for (I4 I = 0; Err == 0 and I < Options.TimedSteps; ++I) {
+         Err = scalingStep(OmegaClock, IStep, DefOceanState, DefTimeStepper);
+         ++IStep;
+      }
+      Kokkos::fence();
+   }
+   R8 LocWallTime = MPI_Wtime() - StartTime;
+   CurrTime       = OmegaClock.getCurrentTime();
+   if (Err != 0) {
+      LOG_ERROR("ocnScalingRun: error in timed steps");
+      return Err;
+   }
+
+   // the throughput is limited by the slowest task
+   R8 WallTime = 0;
+   MPI_Allreduce(&LocWallTime, &WallTime, 1, MPI_DOUBLE, MPI_MAX, Comm);
+
+   // simulated years per wall-clock day of the timed steps
+   TimeInterval SimInterval = CurrTime - TimedStart;
+   R8 SimSeconds;
+   SimInterval.get(SimSeconds, TimeUnits::Seconds);
+
+   const R8 DaysPerYear = 365.0;
+   R8 SYPD              = 0;
+   if (WallTime > 0)
+      SYPD = SimSeconds / (DaysPerYear * WallTime);
+
+   // memory high-water mark of every task
+   R8 LocMaxRSS = getMaxRSS();
+   std::vector<R8> MaxRSS(NumTasks, 0);
+   Err = MPI_Gather(&LocMaxRSS, 1, MPI_DOUBLE, MaxRSS.data(), 1, MPI_DOUBLE,
+                    MasterTask, Comm);
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("ocnScalingRun: error gathering memory high-water marks");
+      return -1;
+   }
+
+   // timer breakdown of the timed steps
+   std::vector<std::string> Paths;
+   std::vector<I8> Counts;
+   std::vector<R8> MinTimes, MaxTimes, MeanTimes;
+   Err = Timer::reduce(DefEnv, Paths, Counts, MinTimes, MaxTimes, MeanTimes);
+   if (Err != 0) {
+      LOG_ERROR("ocnScalingRun: error reducing timers");
+      return Err;
+   }
+
+   if (not DefEnv->isMasterTask())
+      return 0;
+
+   R8 MinRSS  = MaxRSS[0];
+   R8 PeakRSS = MaxRSS[0];
+   R8 SumRSS  = 0;
+   for (R8 RSS : MaxRSS) {
+      MinRSS  = std::min(MinRSS, RSS);
+      PeakRSS = std::max(PeakRSS, RSS);
+      SumRSS += RSS;
+   }
+
+   LOG_INFO("ocnScalingRun: {} tasks, {} warm-up and {} timed steps",
+            NumTasks, Options.WarmupSteps, Options.TimedSteps);
+   LOG_INFO("ocnScalingRun: wall time {:.4f} s, {:.6f} s per step, "
+            "{:.4f} SYPD",
+            WallTime, WallTime / Options.TimedSteps, SYPD);
+   LOG_INFO("ocnScalingRun: memory high-water mark min {:.1f} MB, "
+            "max {:.1f} MB, mean {:.1f} MB",
+            MinRSS, PeakRSS, SumRSS / NumTasks);
+
+   std::ofstream Out(Options.SummaryFile);
+   if (not Out) {
+      LOG_ERROR("ocnScalingRun: error opening summary file {}",
+                Options.SummaryFile);
+      return -1;
+   }
+
+   Out << std::setprecision(9);
+   Out << "{\n";
+   Out << "  \"ExecSpace\": \"" << Kokkos::DefaultExecutionSpace::name()
+       << "\",\n";
+   Out << "  \"NumTasks\": " << NumTasks << ",\n";
+   Out << "  \"WarmupSteps\": " << Options.WarmupSteps << ",\n";
+   Out << "  \"TimedSteps\": " << Options.TimedSteps << ",\n";
+   Out << "  \"SimulatedTime\": " << SimSeconds << ",\n";
+   Out << "  \"WallTime\": " << WallTime << ",\n";
+   Out << "  \"TimePerStep\": " << WallTime / Options.TimedSteps << ",\n";
+   Out << "  \"SYPD\": " << SYPD << ",\n";
+   Out << "  \"MaxRSS\": {\n";
+   Out << "    \"Min\": " << MinRSS << ",\n";
+   Out << "    \"Max\": " << PeakRSS << ",\n";
+   Out << "    \"Mean\": " << SumRSS / NumTasks << ",\n";
+   Out << "    \"PerTask\": [";
+   for (I4 Task = 0; Task < NumTasks; ++Task) {
+      Out << MaxRSS[Task] << (Task + 1 < NumTasks ? ", " : "");
+   }
+   Out << "]\n";
+   Out << "  },\n";
+   Out << "  \"Timers\": [\n";
+   for (std::size_t I = 0; I < Paths.size(); ++I) {
+      Out << "    {\"Name\": \"" << Paths[I] << "\", \"Calls\": " << Counts[I]
+          << ", \"Min\": " << MinTimes[I] << ", \"Max\": " << MaxTimes[I]
+          << ", \"Mean\": " << MeanTimes[I] << "}"
+          << (I + 1 < Paths.size() ? ",\n" : "\n");
+   }
+   Out << "  ]\n";
+   Out << "}\n";
+
+   LOG_INFO("ocnScalingRun: wrote summary to {}", Options.SummaryFile);
+
+   return 0;
+
+} // end ocnScalingRun
+
+} // end namespace OMEGA
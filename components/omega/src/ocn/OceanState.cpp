@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "OceanState.h"
+#include "Config.h"
 #include "DataTypes.h"
 #include "Decomp.h"
 #include "Field.h"
@@ -23,6 +24,7 @@ namespace OMEGA {
 // create the static class members
 OceanState *OceanState::DefaultOceanState = nullptr;
 std::map<std::string, std::unique_ptr<OceanState>> OceanState::AllOceanStates;
+bool OceanState::DeviceOnlyDefault = false;
 
 //------------------------------------------------------------------------------
 // Initialize the state. Assumes that Decomp has already been initialized.
@@ -44,6 +46,24 @@ int OceanState::init() {
    }
    int NTimeLevels = DefTimeStepper->getNTimeLevels();
 
+   // Read the optional device-only setting
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("State")) {
+      Config StateConfig("State");
+      Err = OmegaConfig->get(StateConfig);
+      if (Err != 0) {
+         LOG_ERROR("OceanState: error reading State group from Config");
+         return Err;
+      }
+      if (StateConfig.existsVar("DeviceOnly")) {
+         Err = StateConfig.get("DeviceOnly", DeviceOnlyDefault);
+         if (Err != 0) {
+            LOG_ERROR("OceanState: error reading DeviceOnly from State Config");
+            return Err;
+         }
+      }
+   }
+
    // Create the default state and set pointer to it
    OceanState::DefaultOceanState =
        create("Default", DefHorzMesh, DefHalo, NVertLevels, NTimeLevels);
@@ -77,23 +97,52 @@ OceanState::OceanState(
    NTimeLevels = NTimeLevels_;
    CurLevel    = std::max(0, NTimeLevels - 2);
    NewLevel    = NTimeLevels - 1;
+   LevelOffset = 0;
+
+   this->Mesh = Mesh;
+
+   LayerThickness.init(NTimeLevels, &LevelOffset);
+   LayerThicknessH.init(NTimeLevels, &LevelOffset);
+   NormalVelocity.init(NTimeLevels, &LevelOffset);
+   NormalVelocityH.init(NTimeLevels, &LevelOffset);
 
    MeshHalo = MeshHalo_;
 
    Name = Name_;
 
-   // Allocate state host arrays
-   for (int I = 0; I < NTimeLevels; I++) {
-      LayerThicknessH[I] = HostArray2DR8("LayerThickness" + std::to_string(I),
-                                         NCellsSize, NVertLevels);
-      NormalVelocityH[I] = HostArray2DR8("NormalVelocity" + std::to_string(I),
-                                         NEdgesSize, NVertLevels);
-   }
+   // Without a device halo exchange the host arrays are needed every step
+   DeviceOnly = DeviceOnlyDefault and MeshHalo->isDeviceExchange();
+   if (DeviceOnlyDefault and !DeviceOnly)
+      LOG_WARN("OceanState: device-only mode requires a device halo "
+               "exchange, allocating host arrays for state {}",
+               Name);
+
+   if (DeviceOnly) {
+
+      // Allocate state device arrays only, the host arrays are allocated
+      // when a time level is copied to the host
+      for (int I = 0; I < NTimeLevels; I++) {
+         LayerThickness[I] = createFirstTouchArray<Array2DReal>(
+             "LayerThickness" + std::to_string(I), NCellsSize, NVertLevels);
+         NormalVelocity[I] = createFirstTouchArray<Array2DReal>(
+             "NormalVelocity" + std::to_string(I), NEdgesSize, NVertLevels);
+      }
 
-   // Create device arrays and copy host data
-   for (int I = 0; I < NTimeLevels; I++) {
-      LayerThickness[I] = createDeviceMirrorCopy(LayerThicknessH[I]);
-      NormalVelocity[I] = createDeviceMirrorCopy(NormalVelocityH[I]);
+   } else {
+
+      // Allocate state host arrays
+      for (int I = 0; I < NTimeLevels; I++) {
+         LayerThicknessH[I] = createFirstTouchArray<HostArray2DR8>(
+             "LayerThickness" + std::to_string(I), NCellsSize, NVertLevels);
+         NormalVelocityH[I] = createFirstTouchArray<HostArray2DR8>(
+             "NormalVelocity" + std::to_string(I), NEdgesSize, NVertLevels);
+      }
+
+      // Create device arrays and copy host data
+      for (int I = 0; I < NTimeLevels; I++) {
+         LayerThickness[I] = createDeviceMirrorCopy(LayerThicknessH[I]);
+         NormalVelocity[I] = createDeviceMirrorCopy(NormalVelocityH[I]);
+      }
    }
 
    // Register fields and metadata for IO
@@ -130,6 +179,68 @@ OceanState::create(const std::string &Name, //< [in] Name for new state
    return NewOceanState;
 } // end state create
 
+/// Create a new state as a clone of an existing state and put it in the
+/// AllOceanStates map
+OceanState *
+OceanState::create(const std::string &Name,  //< [in] Name for new state
+                   const OceanState *Source, //< [in] State to clone
+                   bool CopyData             //< [in] Copy the source data
+) {
+
+   if (Source == nullptr) {
+      LOG_ERROR("OceanState: no source state to create state {} from", Name);
+      return nullptr;
+   }
+
+   OceanState *NewOceanState =
+       create(Name, Source->Mesh, Source->MeshHalo, Source->NVertLevels,
+              Source->NTimeLevels);
+   if (NewOceanState == nullptr)
+      return nullptr;
+
+   if (CopyData) {
+      int Err = NewOceanState->copyFrom(*Source);
+      if (Err != 0) {
+         LOG_ERROR("OceanState: error copying state {} to state {}",
+                   Source->Name, Name);
+         erase(Name);
+         return nullptr;
+      }
+   }
+
+   return NewOceanState;
+} // end state clone
+
+//------------------------------------------------------------------------------
+// Copy all time levels of another state. The levels are copied by time level
+// index, so the copy is independent of the storage slots of the two states.
+int OceanState::copyFrom(const OceanState &Source // [in] State to copy
+) {
+
+   if (Source.NTimeLevels != NTimeLevels or
+       Source.NVertLevels != NVertLevels or
+       Source.NCellsSize != NCellsSize or Source.NEdgesSize != NEdgesSize) {
+      LOG_ERROR("OceanState: cannot copy state {} to state {} with different "
+                "sizes",
+                Source.Name, Name);
+      return 1;
+   }
+
+   for (int Level = 0; Level < NTimeLevels; ++Level) {
+      deepCopy(LayerThickness[Level], Source.LayerThickness[Level]);
+      deepCopy(NormalVelocity[Level], Source.NormalVelocity[Level]);
+
+      if (LayerThicknessH[Level].is_allocated() and
+          Source.LayerThicknessH[Level].is_allocated()) {
+         deepCopy(LayerThicknessH[Level], Source.LayerThicknessH[Level]);
+         deepCopy(NormalVelocityH[Level], Source.NormalVelocityH[Level]);
+      }
+   }
+
+   return 0;
+
+} // end copyFrom
+
 //------------------------------------------------------------------------------
 // Destroys a local mesh and deallocates all arrays
 OceanState::~OceanState() {
@@ -186,13 +297,15 @@ void OceanState::loadStateFromFile(const std::string &StateFileName,
    initParallelIO(CellDecompR8, EdgeDecompR8, MeshDecomp);
 
    // Read layerThickness and normalVelocity
+   allocateHostLevel(CurLevel);
    read(StateFileID, CellDecompR8, EdgeDecompR8);
 
    // Destroy the parallel IO decompositions
    finalizeParallelIO(CellDecompR8, EdgeDecompR8);
 
-   // Sync with device
+   // Sync with device, the host copy is no longer needed in device-only mode
    copyToDevice(CurLevel);
+   releaseHostLevels();
 } // end loadStateFromFile
 
 //------------------------------------------------------------------------------
@@ -295,12 +408,16 @@ void OceanState::defineFields() {
       LOG_ERROR("Error adding {} to field group {}", LayerThicknessFldName,
                 StateGroupName);
 
-   // Associate Field with data
-   Err = NormalVelocityField->attachData<Array2DR8>(NormalVelocity[CurLevel]);
+   // Associate Field with data. The current time level is resolved each time
+   // the field data is requested, so the fields do not need to be updated
+   // when the time levels are rotated.
+   Err = NormalVelocityField->attachDataProvider<Array2DR8>(
+       [this]() { return NormalVelocity[CurLevel]; });
    if (Err != 0)
       LOG_ERROR("Error attaching data array to field {}",
                 NormalVelocityFldName);
-   Err = LayerThicknessField->attachData<Array2DR8>(LayerThickness[CurLevel]);
+   Err = LayerThicknessField->attachDataProvider<Array2DR8>(
+       [this]() { return LayerThickness[CurLevel]; });
    if (Err != 0)
       LOG_ERROR("Error attaching data array to field {}",
                 LayerThicknessFldName);
@@ -353,6 +470,13 @@ void OceanState::read(int StateFileID, I4 CellDecompR8, I4 EdgeDecompR8) {
 // Perform copy to device for state variables
 void OceanState::copyToDevice(int TimeLevel) {
 
+   if (!LayerThicknessH[TimeLevel].is_allocated()) {
+      LOG_ERROR("OceanState: no host arrays to copy for time level {} of "
+                "state {}",
+                TimeLevel, Name);
+      return;
+   }
+
    deepCopy(LayerThickness[TimeLevel], LayerThicknessH[TimeLevel]);
    deepCopy(NormalVelocity[TimeLevel], NormalVelocityH[TimeLevel]);
 
@@ -362,45 +486,113 @@ void OceanState::copyToDevice(int TimeLevel) {
 // Perform copy to host for state variables
 void OceanState::copyToHost(int TimeLevel) {
 
+   allocateHostLevel(TimeLevel);
+
    deepCopy(LayerThicknessH[TimeLevel], LayerThickness[TimeLevel]);
    deepCopy(NormalVelocityH[TimeLevel], NormalVelocity[TimeLevel]);
 
 } // end copyToHost
 
 //------------------------------------------------------------------------------
-// Perform state halo exchange
-void OceanState::exchangeHalo(int TimeLevel) {
+// Allocate the host arrays of a time level on first use. Host arrays are
+// all allocated in the constructor unless the state is device-only. The host
+// arrays are the device arrays when these are accessible from the host.
+void OceanState::allocateHostLevel(int TimeLevel) {
+
+   if (LayerThicknessH[TimeLevel].is_allocated())
+      return;
+
+   releaseHostLevels();
+
+   LayerThicknessH[TimeLevel] = createHostMirror(LayerThickness[TimeLevel]);
+   NormalVelocityH[TimeLevel] = createHostMirror(NormalVelocity[TimeLevel]);
+
+} // end allocateHostLevel
+
+//------------------------------------------------------------------------------
+// Release the host arrays of a device-only state
+void OceanState::releaseHostLevels() {
+
+   if (!DeviceOnly)
+      return;
+
+   for (int I = 0; I < NTimeLevels; I++) {
+      LayerThicknessH[I] = HostArray2DReal();
+      NormalVelocityH[I] = HostArray2DReal();
+   }
+
+} // end releaseHostLevels
+
+//------------------------------------------------------------------------------
+// Query and set the device-only mode
+bool OceanState::isDeviceOnly() const { return DeviceOnly; }
+
+void OceanState::setDeviceOnly(bool InDeviceOnly // [in] new setting
+) {
+   DeviceOnlyDefault = InDeviceOnly;
+}
+
+//------------------------------------------------------------------------------
+// Perform state halo exchange. If the halo supports device exchanges, the
+// device arrays are exchanged directly, otherwise the host copies of the
+// layer thickness and normal velocity are exchanged together as a group with
+// one message per neighbor.
+void OceanState::exchangeHalo(int TimeLevel, I4 HaloDepth) {
+   if (MeshHalo->isDeviceExchange()) {
+      MeshHalo->exchangeFullArrayHalo(LayerThickness[TimeLevel], OnCell,
+                                      HaloDepth);
+      MeshHalo->exchangeFullArrayHalo(NormalVelocity[TimeLevel], OnEdge,
+                                      HaloDepth);
+      return;
+   }
    copyToHost(TimeLevel);
-   MeshHalo->exchangeFullArrayHalo(LayerThicknessH[TimeLevel], OnCell);
-   MeshHalo->exchangeFullArrayHalo(NormalVelocityH[TimeLevel], OnEdge);
+   HaloGroup StateGroup;
+   StateGroup.add(LayerThicknessH[TimeLevel], OnCell);
+   StateGroup.add(NormalVelocityH[TimeLevel], OnEdge);
+   MeshHalo->exchangeGroupHalo(StateGroup, HaloDepth);
    copyToDevice(TimeLevel);
 } // end exchangeHalo
 
+//------------------------------------------------------------------------------
+// Start a split-phase state halo exchange. Both the layer thickness and normal
+// velocity messages are in flight when this returns.
+void OceanState::startExchangeHalo(int TimeLevel, I4 HaloDepth) {
+   if (MeshHalo->isDeviceExchange()) {
+      MeshHalo->startExchange(LayerThickness[TimeLevel], OnCell, HaloDepth);
+      MeshHalo->startExchange(NormalVelocity[TimeLevel], OnEdge, HaloDepth);
+      return;
+   }
+   copyToHost(TimeLevel);
+   MeshHalo->startExchange(LayerThicknessH[TimeLevel], OnCell, HaloDepth);
+   MeshHalo->startExchange(NormalVelocityH[TimeLevel], OnEdge, HaloDepth);
+} // end startExchangeHalo
+
+//------------------------------------------------------------------------------
+// Complete a split-phase state halo exchange
+void OceanState::finishExchangeHalo(int TimeLevel) {
+   if (MeshHalo->isDeviceExchange()) {
+      MeshHalo->finishExchange(LayerThickness[TimeLevel], OnCell);
+      MeshHalo->finishExchange(NormalVelocity[TimeLevel], OnEdge);
+      return;
+   }
+   MeshHalo->finishExchange(LayerThicknessH[TimeLevel], OnCell);
+   MeshHalo->finishExchange(NormalVelocityH[TimeLevel], OnEdge);
+   copyToDevice(TimeLevel);
+} // end finishExchangeHalo
+
 //------------------------------------------------------------------------------
 // Perform time level update
-void OceanState::updateTimeLevels() {
+void OceanState::updateTimeLevels(I4 HaloDepth) {
 
    int NewLevel = NTimeLevels - 1;
 
    // Exchange halo
-   exchangeHalo(NewLevel);
-
-   // Update time levels for layer thickness and normal velocity
-   for (int Level = 0; Level < NTimeLevels - 1; Level++) {
-      std::swap(LayerThickness[Level + 1], LayerThickness[Level]);
-      std::swap(LayerThicknessH[Level + 1], LayerThicknessH[Level]);
-
-      std::swap(NormalVelocity[Level + 1], NormalVelocity[Level]);
-      std::swap(NormalVelocityH[Level + 1], NormalVelocityH[Level]);
-   }
-
-   // Update IOField data associations
-   int Err = 0;
+   exchangeHalo(NewLevel, HaloDepth);
 
-   Err = Field::attachFieldData<Array2DR8>(NormalVelocityFldName,
-                                           NormalVelocity[CurLevel]);
-   Err = Field::attachFieldData<Array2DR8>(LayerThicknessFldName,
-                                           LayerThickness[CurLevel]);
+   // Update time levels for layer thickness and normal velocity. Time level
+   // I + 1 becomes time level I and the oldest level is reused for the new
+   // one, the fields pick up the new current level when they are next read.
+   LevelOffset = (LevelOffset + 1) % NTimeLevels;
 
 } // end updateTimeLevels
 
@@ -20,6 +20,33 @@
 
 namespace OMEGA {
 
+/// A ring buffer of the time levels of one state variable. Time level I is
+/// stored in the slot (I + Offset) modulo the number of time levels, where
+/// Offset is shared by all variables of a state. Rotating the time levels
+/// only increments the shared offset, the arrays are never moved.
+template <class T, int MaxLevels> class TimeLevelArray {
+ public:
+   /// Returns the array of a time level, negative levels count back from the
+   /// last one
+   T &operator[](int Level) { return Slots[slot(Level)]; }
+   const T &operator[](int Level) const { return Slots[slot(Level)]; }
+
+   /// Sets the number of time levels and the shared offset
+   void init(int InNLevels, const I4 *InOffset) {
+      NLevels = InNLevels;
+      Offset  = InOffset;
+   }
+
+ private:
+   int slot(int Level) const {
+      return ((Level + *Offset) % NLevels + NLevels) % NLevels;
+   }
+
+   Kokkos::Array<T, MaxLevels> Slots;
+   int NLevels      = 1;
+   const I4 *Offset = nullptr;
+};
+
 /// A class for the ocean prognostic variable information
 
 /// The OceanState class provides a container for the layer thickness,
@@ -36,8 +63,22 @@ class OceanState {
 
    void defineFields();
 
+   /// Allocate the host arrays of a time level if they are not allocated.
+   /// In device-only mode, the host arrays of all other time levels are
+   /// released first so that at most one time level is mirrored on the host.
+   void allocateHostLevel(int TimeLevel);
+
+   HorzMesh *Mesh;
+
    Halo *MeshHalo;
 
+   /// True if the host arrays are only allocated when needed
+   bool DeviceOnly;
+
+   /// Device-only setting for states created after it is changed, read from
+   /// the optional DeviceOnly entry of the State config group
+   static bool DeviceOnlyDefault;
+
    static OceanState *DefaultOceanState;
 
    static std::map<std::string, std::unique_ptr<OceanState>> AllOceanStates;
@@ -81,16 +122,20 @@ class OceanState {
    I4 CurLevel; ///< Time dimension index for current level
    I4 NewLevel; ///< Time dimension index for new level
 
-   // Prognostic variables
+   I4 LevelOffset; ///< Storage slot of time level 0 in the arrays below
+
+   // Prognostic variables, indexed by time level. In device-only mode the
+   // host arrays are unallocated except for the time level last copied to
+   // or from the host.
 
-   Kokkos::Array<Array2DReal, MaxTimeLevels>
+   TimeLevelArray<Array2DReal, MaxTimeLevels>
        LayerThickness; ///< Device LayerThickness array
-   Kokkos::Array<HostArray2DReal, MaxTimeLevels>
+   TimeLevelArray<HostArray2DReal, MaxTimeLevels>
        LayerThicknessH; ///< Host LayerThickness array
 
-   Kokkos::Array<Array2DReal, MaxTimeLevels>
+   TimeLevelArray<Array2DReal, MaxTimeLevels>
        NormalVelocity; ///< Device NormalVelocity array
-   Kokkos::Array<HostArray2DReal, MaxTimeLevels>
+   TimeLevelArray<HostArray2DReal, MaxTimeLevels>
        NormalVelocityH; ///< Host NormalVelocity array
 
    // Field names
@@ -114,21 +159,62 @@ class OceanState {
           const int NTimeLevels    ///< [in] Number of time levels
    );
 
+   /// Create a new state with the mesh, halo and sizes of an existing
+   /// state and put it in the AllOceanStates map. If CopyData is true, all
+   /// time levels of the source are copied to the new state on the device,
+   /// so that a run can be forked in memory without restart IO.
+   static OceanState *
+   create(const std::string &Name,  ///< [in] Name for new state
+          const OceanState *Source, ///< [in] State to clone
+          bool CopyData = true      ///< [in] Copy the source data
+   );
+
+   /// Copy all time levels of a state with the same sizes into this state.
+   /// The device arrays are copied directly, and the host arrays are copied
+   /// for the time levels that are allocated on the host in both states.
+   int copyFrom(const OceanState &Source ///< [in] State to copy
+   );
+
    /// load state from file
    void loadStateFromFile(const std::string &StateFileName, Decomp *MeshDecomp);
 
-   /// Exchange halo
-   void exchangeHalo(int TimeLevel);
+   /// Exchange halo. If HaloDepth is between 1 and the halo width, only the
+   /// first HaloDepth cell layers (HaloDepth + 1 edge layers) are exchanged.
+   void exchangeHalo(int TimeLevel, I4 HaloDepth = 0);
+
+   /// Start a split-phase halo exchange of the state variables. Computations
+   /// that do not depend on the state halo may be performed before the
+   /// exchange is completed with finishExchangeHalo.
+   void startExchangeHalo(int TimeLevel, I4 HaloDepth = 0);
 
-   /// Swap time levels to update state arrays
-   void updateTimeLevels();
+   /// Complete a halo exchange started with startExchangeHalo
+   void finishExchangeHalo(int TimeLevel);
+
+   /// Rotate time levels to update state arrays, exchanging the halo of the
+   /// new time level to the optional HaloDepth (all layers by default). Only
+   /// the time level offset changes, the fields resolve the current level
+   /// when their data is requested.
+   void updateTimeLevels(I4 HaloDepth = 0);
 
    /// Copy state variables from host to device
    void copyToDevice(int TimeLevel);
 
-   /// Copy state variables from device to host
+   /// Copy state variables from device to host, allocating the host arrays
+   /// of the time level if needed
    void copyToHost(int TimeLevel);
 
+   /// Release the host arrays of all time levels in device-only mode
+   void releaseHostLevels();
+
+   /// Returns true if the host arrays are only allocated when needed
+   bool isDeviceOnly() const;
+
+   /// Sets the device-only mode for states created afterwards. It only
+   /// takes effect for states whose halo exchanges device arrays directly,
+   /// since the host halo exchange needs the host arrays every step.
+   static void setDeviceOnly(bool InDeviceOnly ///< [in] new setting
+   );
+
    /// Destructor - deallocates all memory and deletes an OceanState
    ~OceanState();
 
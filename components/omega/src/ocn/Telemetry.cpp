@@ -0,0 +1,304 @@
+//===-- ocn/Telemetry.cpp - throughput telemetry ----------------*- C++ -*-===//
+//
+// The Telemetry class measures the throughput of the time steps between the
+// rings of an alarm attached to the model clock, reduces the statistics of
+// all tasks with a single MPI_Reduce and appends them to a JSON lines log on
+// the master task.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Telemetry.h"
+#include "Config.h"
+#include "KernelCounters.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "MemoryTracker.h"
+#include "OmegaKokkos.h"
+#include "Timer.h"
+
+#include "mpi.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace OMEGA {
+
+// Static members
+bool Telemetry::Enabled   = false;
+bool Telemetry::Started   = false;
+I4 Telemetry::StepInterval = 100;
+std::string Telemetry::Filename;
+Alarm Telemetry::TelemetryAlarm;
+MPI_Op Telemetry::StatsOp = MPI_OP_NULL;
+TimeInstant Telemetry::RunStartTime;
+TimeInstant Telemetry::IntervalStartTime;
+R8 Telemetry::RunStartWall        = 0;
+R8 Telemetry::IntervalStartWall   = 0;
+R8 Telemetry::LastStepWall        = 0;
+R8 Telemetry::IntervalMaxStep     = 0;
+R8 Telemetry::IntervalStartHalo   = 0;
+R8 Telemetry::IntervalStartKernel = 0;
+I8 Telemetry::IntervalSteps       = 0;
+
+// Statistics of each record, reduced as (min, max, sum) triplets
+enum TelemetryStat {
+   StatStepTime,    ///< mean step time of the interval
+   StatMaxStepTime, ///< longest step of the interval
+   StatHaloFrac,    ///< fraction of the interval in halo exchanges
+   StatKernelTime,  ///< time of the annotated kernels per step
+   StatMemoryMB,    ///< Kokkos memory in use in MB
+   NumStats
+};
+
+//------------------------------------------------------------------------------
+// Reads the options of the optional Telemetry group of the configuration
+int Telemetry::init() {
+   int Err = 0;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("Telemetry"))
+      return Err;
+
+   Config TelemConfig("Telemetry");
+   Err = OmegaConfig->get(TelemConfig);
+   if (Err != 0) {
+      LOG_ERROR("Telemetry: error retrieving Telemetry group from Config");
+      return Err;
+   }
+
+   bool UseTelemetry = false;
+   if (TelemConfig.existsVar("Enabled")) {
+      Err = TelemConfig.get("Enabled", UseTelemetry);
+      if (Err != 0) {
+         LOG_ERROR("Telemetry: error reading Enabled from Config");
+         return Err;
+      }
+   }
+   if (!UseTelemetry)
+      return Err;
+
+   I4 InStepInterval = StepInterval;
+   if (TelemConfig.existsVar("StepInterval")) {
+      Err = TelemConfig.get("StepInterval", InStepInterval);
+      if (Err != 0) {
+         LOG_ERROR("Telemetry: error reading StepInterval from Config");
+         return Err;
+      }
+   }
+
+   std::string InFilename = "OmegaTelemetry.jsonl";
+   if (TelemConfig.existsVar("File")) {
+      Err = TelemConfig.get("File", InFilename);
+      if (Err != 0) {
+         LOG_ERROR("Telemetry: error reading File from Config");
+         return Err;
+      }
+   }
+
+   return enable(InFilename, InStepInterval);
+}
+
+//------------------------------------------------------------------------------
+// Enables the telemetry with a record every InStepInterval steps
+int Telemetry::enable(const std::string &InFilename, // [in] log file
+                      I4 InStepInterval              // [in] steps per record
+) {
+   if (InStepInterval < 1) {
+      LOG_ERROR("Telemetry: StepInterval must be positive");
+      return 1;
+   }
+
+   if (StatsOp == MPI_OP_NULL) {
+      int Err = MPI_Op_create(&reduceStats, 1, &StatsOp);
+      if (Err != MPI_SUCCESS) {
+         LOG_ERROR("Telemetry: error creating the reduction operator");
+         return 1;
+      }
+   }
+
+   Filename     = InFilename;
+   StepInterval = InStepInterval;
+   Started      = false;
+   Enabled      = true;
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Attaches the telemetry alarm to the model clock and starts the first
+// interval on the first call
+int Telemetry::attach(Clock &ModelClock // [inout] model clock
+) {
+   if (!Enabled)
+      return 0;
+
+   if (!Started) {
+      const TimeInstant StartTime = ModelClock.getCurrentTime();
+      TelemetryAlarm =
+          Alarm("Telemetry", ModelClock.getTimeStep() * StepInterval,
+                StartTime);
+
+      RunStartTime        = StartTime;
+      IntervalStartTime   = StartTime;
+      RunStartWall        = MPI_Wtime();
+      IntervalStartWall   = RunStartWall;
+      IntervalMaxStep     = 0;
+      IntervalStartHalo   = Timer::getNestedTime("ocnRun", "Halo");
+      IntervalStartKernel = KernelCounters::getTotalTime();
+      IntervalSteps       = 0;
+      Started             = true;
+   }
+   LastStepWall = MPI_Wtime();
+
+   return ModelClock.attachAlarm(&TelemetryAlarm);
+}
+
+//------------------------------------------------------------------------------
+// Records the end of a time step and writes a record when the alarm rings
+int Telemetry::write(const Clock &ModelClock, // [in] model clock
+                     I8 IStep                 // [in] step counter
+) {
+   int Err = 0;
+
+   if (!Enabled or !Started)
+      return Err;
+
+   // Step times are measured on the host between the ends of consecutive
+   // steps, so a step includes the analysis and output that follow it
+   const R8 Now    = MPI_Wtime();
+   IntervalMaxStep = std::max(IntervalMaxStep, Now - LastStepWall);
+   LastStepWall    = Now;
+   ++IntervalSteps;
+
+   if (!TelemetryAlarm.isRinging())
+      return Err;
+
+   const TimeInstant CurrTime = ModelClock.getCurrentTime();
+   Err                        = writeRecord(CurrTime, IStep);
+   TelemetryAlarm.reset(CurrTime);
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Reduces the statistics of the interval and appends them to the log
+int Telemetry::writeRecord(const TimeInstant &CurrTime, // [in] sim time
+                           I8 IStep                     // [in] step counter
+) {
+   MachEnv *DefEnv = MachEnv::getDefault();
+
+   // The kernels of the interval must be complete for its wall time
+   Kokkos::fence();
+   const R8 Now          = MPI_Wtime();
+   const R8 IntervalWall = Now - IntervalStartWall;
+   const R8 HaloTime     = Timer::getNestedTime("ocnRun", "Halo");
+   const R8 KernelTime   = KernelCounters::getTotalTime();
+   const R8 NSteps       = std::max<I8>(IntervalSteps, 1);
+
+   R8 LocValues[NumStats];
+   LocValues[StatStepTime]    = IntervalWall / NSteps;
+   LocValues[StatMaxStepTime] = IntervalMaxStep;
+   LocValues[StatHaloFrac] =
+       IntervalWall > 0 ? (HaloTime - IntervalStartHalo) / IntervalWall : 0;
+   LocValues[StatKernelTime] = (KernelTime - IntervalStartKernel) / NSteps;
+   LocValues[StatMemoryMB] =
+       static_cast<R8>(MemoryTracker::getBytes("Total")) / (1024.0 * 1024.0);
+
+   R8 LocStats[3 * NumStats];
+   R8 Stats[3 * NumStats];
+   for (int I = 0; I < NumStats; ++I) {
+      LocStats[3 * I]     = LocValues[I];
+      LocStats[3 * I + 1] = LocValues[I];
+      LocStats[3 * I + 2] = LocValues[I];
+   }
+   int Err = MPI_Reduce(LocStats, Stats, 3 * NumStats, MPI_DOUBLE, StatsOp,
+                        DefEnv->getMasterTask(), DefEnv->getComm());
+
+   const TimeInstant StartTime = IntervalStartTime;
+   const I8 Steps              = IntervalSteps;
+   IntervalStartTime           = CurrTime;
+   IntervalStartWall           = Now;
+   IntervalMaxStep             = 0;
+   IntervalStartHalo           = HaloTime;
+   IntervalStartKernel         = KernelTime;
+   IntervalSteps               = 0;
+
+   if (Err != MPI_SUCCESS) {
+      LOG_ERROR("Telemetry: error reducing the statistics");
+      return 1;
+   }
+
+   if (!DefEnv->isMasterTask())
+      return 0;
+
+   // The throughput is limited by the slowest task
+   const R8 DaysPerYear = 365.0;
+   R8 SimSeconds, RunSimSeconds;
+   (CurrTime - StartTime).get(SimSeconds, TimeUnits::Seconds);
+   (CurrTime - RunStartTime).get(RunSimSeconds, TimeUnits::Seconds);
+   const R8 SlowestWall = Stats[3 * StatStepTime + 1] * Steps;
+   const R8 RunWall     = Now - RunStartWall;
+   const R8 SYPD =
+       SlowestWall > 0 ? SimSeconds / (DaysPerYear * SlowestWall) : 0;
+   const R8 RunSYPD =
+       RunWall > 0 ? RunSimSeconds / (DaysPerYear * RunWall) : 0;
+
+   // A failure to write the log is not fatal, since the other tasks are
+   // not aware of it
+   std::ofstream Out(Filename, std::ios::app);
+   if (!Out) {
+      LOG_WARN("Telemetry: unable to open log file {}", Filename);
+      return 0;
+   }
+
+   const I4 NumTasks = DefEnv->getNumTasks();
+   const auto writeStat = [&](const char *Name, TelemetryStat I) {
+      Out << ", \"" << Name << "\": {\"Min\": " << Stats[3 * I]
+          << ", \"Max\": " << Stats[3 * I + 1]
+          << ", \"Mean\": " << Stats[3 * I + 2] / NumTasks << "}";
+   };
+
+   Out << std::setprecision(9);
+   Out << "{\"Step\": " << IStep << ", \"Time\": \""
+       << CurrTime.getString(4, 0, "_") << "\", \"Steps\": " << Steps
+       << ", \"WallTime\": " << SlowestWall << ", \"SYPD\": " << SYPD
+       << ", \"RunSYPD\": " << RunSYPD;
+   writeStat("StepTime", StatStepTime);
+   writeStat("MaxStepTime", StatMaxStepTime);
+   writeStat("HaloFraction", StatHaloFrac);
+   writeStat("KernelTime", StatKernelTime);
+   writeStat("MemoryMB", StatMemoryMB);
+   Out << "}\n";
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Combines (min, max, sum) triplets elementwise
+void Telemetry::reduceStats(void *In, void *InOut, int *Len,
+                            MPI_Datatype * /* Type */) {
+   const R8 *InStats = static_cast<const R8 *>(In);
+   R8 *OutStats      = static_cast<R8 *>(InOut);
+   for (int I = 0; I + 2 < *Len; I += 3) {
+      OutStats[I]     = std::min(OutStats[I], InStats[I]);
+      OutStats[I + 1] = std::max(OutStats[I + 1], InStats[I + 1]);
+      OutStats[I + 2] += InStats[I + 2];
+   }
+}
+
+//------------------------------------------------------------------------------
+// Returns true if the telemetry is enabled
+bool Telemetry::isEnabled() { return Enabled; }
+
+//------------------------------------------------------------------------------
+// Disables the telemetry and releases the reduction operator
+int Telemetry::finalize() {
+   Enabled = false;
+   Started = false;
+   if (StatsOp != MPI_OP_NULL)
+      MPI_Op_free(&StatsOp);
+   return 0;
+}
+
+} // namespace OMEGA
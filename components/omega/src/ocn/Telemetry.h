@@ -0,0 +1,108 @@
+#ifndef OMEGA_TELEMETRY_H
+#define OMEGA_TELEMETRY_H
+//===-- ocn/Telemetry.h - throughput telemetry ------------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines a lightweight throughput log for long runs
+///
+/// The timer and memory summaries are only written at the end of a run, so a
+/// slow node or a stalled file system is only noticed once a job completes
+/// or fails. The Telemetry class writes a record of the recent throughput to
+/// a log file during the run: every StepInterval time steps, an alarm
+/// attached to the model clock rings and the simulated years per day (SYPD)
+/// of the steps since the last record, the minimum, maximum and mean over
+/// the tasks of the mean and longest step times, of the fraction of time
+/// spent in halo exchanges, of the kernel time per step and of the Kokkos
+/// memory in use are gathered with a single reduction. The master task
+/// appends the record to the log as one line of JSON.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "TimeMgr.h"
+
+#include "mpi.h"
+
+#include <string>
+
+namespace OMEGA {
+
+/// The Telemetry class writes periodic throughput records of the model to a
+/// log file. All members are static since there is one log for the model.
+class Telemetry {
+
+ private:
+   static bool Enabled;          ///< telemetry records are written
+   static bool Started;          ///< the intervals have been started
+   static I4 StepInterval;       ///< time steps between records
+   static std::string Filename;  ///< log file written by the master task
+   static Alarm TelemetryAlarm;  ///< alarm ringing at each record
+   static MPI_Op StatsOp;        ///< reduction of (min, max, sum) triplets
+
+   static TimeInstant RunStartTime;      ///< sim time of the first interval
+   static TimeInstant IntervalStartTime; ///< sim time of the interval start
+   static R8 RunStartWall;               ///< wall time of the first interval
+   static R8 IntervalStartWall;          ///< wall time of the interval start
+   static R8 LastStepWall;               ///< wall time of the last step end
+   static R8 IntervalMaxStep;            ///< longest step in the interval
+   static R8 IntervalStartHalo;          ///< halo time at interval start
+   static R8 IntervalStartKernel;        ///< kernel time at interval start
+   static I8 IntervalSteps;              ///< steps in the current interval
+
+   /// Combines arrays of (min, max, sum) triplets, used as MPI operator
+   static void reduceStats(void *In, void *InOut, int *Len,
+                           MPI_Datatype *Type);
+
+   /// Reduces the statistics of the interval that ends at the input time
+   /// and appends the record to the log on the master task. Returns an
+   /// error code.
+   static int writeRecord(const TimeInstant &CurrTime, ///< [in] sim time
+                          I8 IStep                     ///< [in] step counter
+   );
+
+ public:
+   //---------------------------------------------------------------------------
+   /// Reads the options of the optional Telemetry group of the input
+   /// configuration and enables the telemetry if requested. Returns an error
+   /// code.
+   static int init();
+
+   //---------------------------------------------------------------------------
+   /// Enables the telemetry, with a record written to the input file every
+   /// InStepInterval time steps. Returns an error code.
+   static int enable(const std::string &InFilename, ///< [in] log file
+                     I4 InStepInterval              ///< [in] steps per record
+   );
+
+   //---------------------------------------------------------------------------
+   /// Attaches the telemetry alarm to the model clock, ringing every
+   /// StepInterval steps of the clock time step. The first call also starts
+   /// the first interval at the current time of the clock; later calls, eg
+   /// for the next coupling interval, continue the current interval. Returns
+   /// an error code.
+   static int attach(Clock &ModelClock ///< [inout] model clock
+   );
+
+   //---------------------------------------------------------------------------
+   /// Records the end of a time step and writes a record if the telemetry
+   /// alarm is ringing. Must be called by all tasks after every step.
+   /// Returns an error code.
+   static int write(const Clock &ModelClock, ///< [in] model clock
+                    I8 IStep                 ///< [in] step counter
+   );
+
+   //---------------------------------------------------------------------------
+   /// Returns true if the telemetry is enabled
+   static bool isEnabled();
+
+   //---------------------------------------------------------------------------
+   /// Disables the telemetry and releases the reduction operator. Returns
+   /// an error code.
+   static int finalize();
+
+}; // end class Telemetry
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_TELEMETRY_H
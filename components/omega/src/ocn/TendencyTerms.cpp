@@ -13,13 +13,33 @@
 #include "Config.h"
 #include "DataTypes.h"
 #include "HorzMesh.h"
+#include "KernelCounters.h"
+#include "KernelScheduler.h"
 #include "OceanState.h"
+#include "Timer.h"
+#include "Tracers.h"
 
 namespace OMEGA {
 
 Tendencies *Tendencies::DefaultTendencies = nullptr;
 std::map<std::string, std::unique_ptr<Tendencies>> Tendencies::AllTendencies;
 
+// Annotates the tendency kernels for the kernel counters with the estimated
+// array words read or written and flops per level, counting each array value
+// once
+template <int W> static void annotateTendencyKernels() {
+   if (!KernelCounters::isEnabled())
+      return;
+   const R8 Word = W * sizeof(Real);
+   KernelCounters::annotate("thicknessFluxDiv", 13 * Word, 18 * W);
+   KernelCounters::annotate("potentialVortHAdv", 24 * Word, 50 * W);
+   KernelCounters::annotate("keGrad", 4 * Word, 3 * W);
+   KernelCounters::annotate("sshGrad", 4 * Word, 3 * W);
+   KernelCounters::annotate("velocityDiffusion", 6 * Word, 8 * W);
+   KernelCounters::annotate("velocityHyperDiff", 6 * Word, 8 * W);
+   KernelCounters::annotate("tracerTendencies", 14 * Word, 30 * W);
+}
+
 //------------------------------------------------------------------------------
 // Initialize the tendencies. Assumes that HorzMesh as alread been initialized.
 int Tendencies::init() {
@@ -153,9 +173,205 @@ int Tendencies::readTendConfig(Config *TendConfig ///< [in] Tendencies subconfig
       return ViscDel4;
    }
 
+   // The tracer tendency terms are optional and disabled by default
+   if (TendConfig->existsVar("TracerHorzAdvTendencyEnable")) {
+      I4 TrHAdvErr = TendConfig->get("TracerHorzAdvTendencyEnable",
+                                     this->TracerHorzAdv.Enabled);
+      if (TrHAdvErr != 0) {
+         LOG_CRITICAL("Tendencies: error reading TracerHorzAdvTendencyEnable");
+         return TrHAdvErr;
+      }
+   }
+
+   if (TendConfig->existsVar("TracerDiffTendencyEnable")) {
+      I4 TrDiffErr = TendConfig->get("TracerDiffTendencyEnable",
+                                     this->TracerDiffusion.Enabled);
+      if (TrDiffErr != 0) {
+         LOG_CRITICAL("Tendencies: error reading TracerDiffTendencyEnable");
+         return TrDiffErr;
+      }
+   }
+
+   I4 EddyDiff2 = TendConfig->get("EddyDiff2", this->TracerDiffusion.EddyDiff2);
+   if (EddyDiff2 != 0 && this->TracerDiffusion.Enabled) {
+      LOG_CRITICAL("Tendencies: EddyDiff2 not found in TendConfig");
+      return EddyDiff2;
+   }
+
+   if (TendConfig->existsVar("TracerHyperDiffTendencyEnable")) {
+      I4 TrHyperErr = TendConfig->get("TracerHyperDiffTendencyEnable",
+                                      this->TracerHyperDiff.Enabled);
+      if (TrHyperErr != 0) {
+         LOG_CRITICAL("Tendencies: error reading "
+                      "TracerHyperDiffTendencyEnable");
+         return TrHyperErr;
+      }
+   }
+
+   I4 EddyDiff4 = TendConfig->get("EddyDiff4", this->TracerHyperDiff.EddyDiff4);
+   if (EddyDiff4 != 0 && this->TracerHyperDiff.Enabled) {
+      LOG_CRITICAL("Tendencies: EddyDiff4 not found in TendConfig");
+      return EddyDiff4;
+   }
+
+   // Vertical advection is optional and disabled by default, since the
+   // stacked shallow water layers have no vertical transport
+   if (TendConfig->existsVar("VertAdvTendencyEnable")) {
+      bool VertAdvEnabled = false;
+      I4 VertAdvErr = TendConfig->get("VertAdvTendencyEnable", VertAdvEnabled);
+      if (VertAdvErr != 0) {
+         LOG_CRITICAL("Tendencies: error reading VertAdvTendencyEnable");
+         return VertAdvErr;
+      }
+      this->VertVelocity.Enabled    = VertAdvEnabled;
+      this->VelocityVertAdv.Enabled = VertAdvEnabled;
+      this->TracerVertAdv.Enabled   = VertAdvEnabled;
+   }
+
+   if (TendConfig->existsVar("SpecializedTendencies")) {
+      I4 SpecErr =
+          TendConfig->get("SpecializedTendencies", this->SpecializedTend);
+      if (SpecErr != 0) {
+         LOG_CRITICAL("Tendencies: error reading SpecializedTendencies");
+         return SpecErr;
+      }
+   }
+
+   if (TendConfig->existsVar("FusedVelocityTendency")) {
+      I4 FusedErr = TendConfig->get("FusedVelocityTendency",
+                                    this->FusedVelocityTend);
+      if (FusedErr != 0) {
+         LOG_CRITICAL("Tendencies: error reading FusedVelocityTendency");
+         return FusedErr;
+      }
+   }
+
+   if (TendConfig->existsVar("FusedHyperDiffusion")) {
+      I4 FusedHypErr =
+          TendConfig->get("FusedHyperDiffusion", this->FusedHyperDiff);
+      if (FusedHypErr != 0) {
+         LOG_CRITICAL("Tendencies: error reading FusedHyperDiffusion");
+         return FusedHypErr;
+      }
+   }
+
+   if (TendConfig->existsVar("OuterInnerLoops")) {
+      I4 LoopsErr = TendConfig->get("OuterInnerLoops", this->OuterInnerLoops);
+      if (LoopsErr != 0) {
+         LOG_CRITICAL("Tendencies: error reading OuterInnerLoops");
+         return LoopsErr;
+      }
+   }
+
+   if (TendConfig->existsVar("CompactMaskedEdges")) {
+      I4 CompactErr =
+          TendConfig->get("CompactMaskedEdges", this->CompactMaskedEdges);
+      if (CompactErr != 0) {
+         LOG_CRITICAL("Tendencies: error reading CompactMaskedEdges");
+         return CompactErr;
+      }
+   }
+
    return Err;
 }
 
+//------------------------------------------------------------------------------
+// Number of cell halo layers consumed by one tendency evaluation. The thickness
+// flux divergence, potential vorticity, kinetic energy, sea surface height and
+// del2 terms only use values on neighboring cells, edges and vertices of the
+// cell or edge being computed, so one evaluation invalidates one cell layer
+// of the halo. The velocity and tracer del4 terms apply the del2 operator
+// twice and invalidate an additional layer. The HighOrder tracer edge values
+// use the neighbors of both cells of the edge, so the tracer advection also
+// invalidates an additional layer. The terms are added independently, so the
+// depth is the widest of their stencils. Custom tendencies have unknown
+// stencils.
+I4 Tendencies::getStencilHaloDepth(
+    const AuxiliaryState *AuxState ///< [in] Auxiliary state variables
+) const {
+
+   if (CustomThicknessTend or CustomVelocityTend) {
+      return 0;
+   }
+
+   const bool HighOrderTracers =
+       TracerHorzAdv.Enabled and
+       AuxState->TracerAux.TracersOnEdgeChoice == HighOrder;
+
+   I4 Depth = 1;
+   if (VelocityHyperDiff.Enabled or TracerHyperDiff.Enabled or
+       HighOrderTracers) {
+      Depth += 1;
+   }
+
+   return Depth;
+
+} // end getStencilHaloDepth
+
+//------------------------------------------------------------------------------
+// Custom tendencies are set
+bool Tendencies::hasCustomTendencies() const {
+   return CustomThicknessTend or CustomVelocityTend;
+} // end hasCustomTendencies
+
+//------------------------------------------------------------------------------
+// Optional auxiliary variables used by the enabled terms. Only the del4 terms
+// use the laplacian of the velocity and of the tracers, and not when they are
+// fused, since the fused kernels compute the laplacian in scratch memory.
+I4 Tendencies::getNeededAuxVars() const {
+
+   if (CustomThicknessTend or CustomVelocityTend) {
+      return AuxAllVarsMask;
+   }
+
+   I4 Mask = 0;
+   if (VelocityHyperDiff.Enabled and !FusedHyperDiff)
+      Mask |= AuxVelocityDel2Bit;
+   if (TracerHyperDiff.Enabled and !FusedHyperDiff)
+      Mask |= AuxTracerDel2Bit;
+
+   return Mask;
+
+} // end getNeededAuxVars
+
+//------------------------------------------------------------------------------
+// Mask of the enabled tendency terms
+I4 Tendencies::getEnabledTermMask() const {
+
+   I4 Mask = 0;
+   if (ThicknessFluxDiv.Enabled)
+      Mask |= TendThickFluxBit;
+   if (PotientialVortHAdv.Enabled)
+      Mask |= TendPVBit;
+   if (KEGrad.Enabled)
+      Mask |= TendKEGradBit;
+   if (SSHGrad.Enabled)
+      Mask |= TendSSHGradBit;
+   if (VelocityDiffusion.Enabled)
+      Mask |= TendDel2Bit;
+   if (VelocityHyperDiff.Enabled)
+      Mask |= TendDel4Bit;
+   if (VertVelocity.Enabled)
+      Mask |= TendVertAdvBit;
+
+   return Mask;
+
+} // end getEnabledTermMask
+
+//------------------------------------------------------------------------------
+// Width of the vertical chunks used by the tendency kernels
+I4 Tendencies::getVecWidth() const { return VecWidth; }
+
+//------------------------------------------------------------------------------
+// Restrict the computation to the owned elements and the first HaloDepth halo
+// layers. The tendencies in the outer halo layers are left unchanged.
+void Tendencies::setComputeHaloDepth(I4 HaloDepth) {
+   const MeshLoopBounds Bounds = Mesh->getLoopBounds(HaloDepth);
+   NCellsAll                   = Bounds.NCells;
+   NEdgesAll                   = Bounds.NEdges;
+   NActiveEdges                = Mesh->numActiveEdges(NEdgesAll);
+}
+
 //------------------------------------------------------------------------------
 // Construct a new group of tendencies
 Tendencies::Tendencies(const std::string &Name, ///< [in] Name for tendencies
@@ -166,19 +382,48 @@ Tendencies::Tendencies(const std::string &Name, ///< [in] Name for tendencies
                        CustomTendencyType InCustomVelocityTend)
     : ThicknessFluxDiv(Mesh), PotientialVortHAdv(Mesh), KEGrad(Mesh),
       SSHGrad(Mesh), VelocityDiffusion(Mesh), VelocityHyperDiff(Mesh),
+      TracerHorzAdv(Mesh), TracerDiffusion(Mesh), TracerHyperDiff(Mesh),
+      VertVelocity(Mesh), VelocityVertAdv(Mesh), TracerVertAdv(Mesh),
       CustomThicknessTend(InCustomThicknessTend),
       CustomVelocityTend(InCustomVelocityTend) {
 
    // Tendency arrays
-   LayerThicknessTend =
-       Array2DReal("LayerThicknessTend", Mesh->NCellsSize, NVertLevels);
-   NormalVelocityTend =
-       Array2DReal("NormalVelocityTend", Mesh->NEdgesSize, NVertLevels);
+   LayerThicknessTend = createFirstTouchArray<Array2DAuxReal>(
+       "LayerThicknessTend", Mesh->NCellsSize, NVertLevels);
+   NormalVelocityTend = createFirstTouchArray<Array2DAuxReal>(
+       "NormalVelocityTend", Mesh->NEdgesSize, NVertLevels);
+   VertVelocityTop    = createFirstTouchArray<Array2DAuxReal>(
+       "VertVelocityTop", Mesh->NCellsSize, NVertLevels + 1);
+
+   this->Mesh = Mesh;
 
    // Array dimension lengths
    NCellsAll = Mesh->NCellsAll;
    NEdgesAll = Mesh->NEdgesAll;
-   NChunks   = NVertLevels / VecLength;
+   VecWidth  = selectVecWidth(NVertLevels);
+   NChunks   = numVertChunks(VecWidth, NVertLevels);
+
+   // Active vertical levels
+   MinLevelCell = Mesh->MinLevelCell;
+   MaxLevelCell = Mesh->MaxLevelCell;
+   MinLevelEdge = Mesh->MinLevelEdge;
+   MaxLevelEdge = Mesh->MaxLevelEdge;
+
+   // Compacted active edges
+   ActiveEdges  = Mesh->ActiveEdges;
+   NActiveEdges = Mesh->numActiveEdges(NEdgesAll);
+
+   // Tracer terms are only enabled through readTendConfig
+   TracerHorzAdv.Enabled     = false;
+   TracerDiffusion.Enabled   = false;
+   TracerDiffusion.EddyDiff2 = 0;
+   TracerHyperDiff.Enabled   = false;
+   TracerHyperDiff.EddyDiff4 = 0;
+
+   // Vertical advection is only enabled through readTendConfig
+   VertVelocity.Enabled    = false;
+   VelocityVertAdv.Enabled = false;
+   TracerVertAdv.Enabled   = false;
 
 } // end constructor
 
@@ -198,22 +443,56 @@ void Tendencies::computeThicknessTendenciesOnly(
     int VelTimeLevel,               ///< [in] Time level
     TimeInstant Time                ///< [in] Time
 ) {
+   OMEGA_DISPATCH_VEC_WIDTH(VecWidth, computeThicknessTendenciesChunked, State,
+                            AuxState, ThickTimeLevel, VelTimeLevel, Time);
+}
+
+template <int W>
+void Tendencies::computeThicknessTendenciesChunked(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    int ThickTimeLevel,             ///< [in] Time level
+    int VelTimeLevel,               ///< [in] Time level
+    TimeInstant Time                ///< [in] Time
+) {
 
    OMEGA_SCOPE(LocLayerThicknessTend, LayerThicknessTend);
    OMEGA_SCOPE(LocThicknessFluxDiv, ThicknessFluxDiv);
+   OMEGA_SCOPE(LocMinLevelCell, MinLevelCell);
+   OMEGA_SCOPE(LocMaxLevelCell, MaxLevelCell);
    const Array2DReal &NormalVelEdge = State->NormalVelocity[VelTimeLevel];
 
+   annotateTendencyKernels<W>();
    deepCopy(LocLayerThicknessTend, 0);
 
    // Compute thickness flux divergence
-   const Array2DReal &ThickFluxEdge =
-       AuxState->LayerThicknessAux.FluxLayerThickEdge;
+   const auto &ThickFluxEdge = AuxState->LayerThicknessAux.FluxLayerThickEdge;
 
    if (LocThicknessFluxDiv.Enabled) {
+      parallelForChunks(
+          "thicknessFluxDiv", {NCellsAll, NChunks},
+          KOKKOS_LAMBDA(int ICell, int KChunk) {
+             if (!isActiveChunk<W>(KChunk, LocMinLevelCell(ICell),
+                                   LocMaxLevelCell(ICell)))
+                return;
+             LocThicknessFluxDiv.template operator()<W>(
+                 LocLayerThicknessTend, ICell, KChunk, ThickFluxEdge,
+                 NormalVelEdge);
+          },
+          OuterInnerLoops);
+   }
+
+   // Diagnose the vertical velocity from the flux divergence and replace the
+   // divergence with the z-star target thickness tendency. Each thread
+   // sweeps the whole column of a cell.
+   if (VertVelocity.Enabled) {
+      OMEGA_SCOPE(LocVertVelocity, VertVelocity);
+      OMEGA_SCOPE(LocVertVelocityTop, VertVelocityTop);
+      const Array2DReal &LayerThickCell = State->LayerThickness[ThickTimeLevel];
       parallelFor(
-          {NCellsAll, NChunks}, KOKKOS_LAMBDA(int ICell, int KChunk) {
-             LocThicknessFluxDiv(LocLayerThicknessTend, ICell, KChunk,
-                                 ThickFluxEdge, NormalVelEdge);
+          "vertVelocity", {NCellsAll}, KOKKOS_LAMBDA(int ICell) {
+             LocVertVelocity(LocVertVelocityTop, LocLayerThicknessTend, ICell,
+                             LayerThickCell);
           });
    }
 
@@ -233,6 +512,18 @@ void Tendencies::computeVelocityTendenciesOnly(
     int VelTimeLevel,               ///< [in] Time level
     TimeInstant Time                ///< [in] Time
 ) {
+   OMEGA_DISPATCH_VEC_WIDTH(VecWidth, computeVelocityTendenciesChunked, State,
+                            AuxState, ThickTimeLevel, VelTimeLevel, Time);
+}
+
+template <int W>
+void Tendencies::computeVelocityTendenciesChunked(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    int ThickTimeLevel,             ///< [in] Time level
+    int VelTimeLevel,               ///< [in] Time level
+    TimeInstant Time                ///< [in] Time
+) {
 
    OMEGA_SCOPE(LocNormalVelocityTend, NormalVelocityTend);
    OMEGA_SCOPE(LocPotientialVortHAdv, PotientialVortHAdv);
@@ -240,64 +531,127 @@ void Tendencies::computeVelocityTendenciesOnly(
    OMEGA_SCOPE(LocSSHGrad, SSHGrad);
    OMEGA_SCOPE(LocVelocityDiffusion, VelocityDiffusion);
    OMEGA_SCOPE(LocVelocityHyperDiff, VelocityHyperDiff);
+   OMEGA_SCOPE(LocMinLevelEdge, MinLevelEdge);
+   OMEGA_SCOPE(LocMaxLevelEdge, MaxLevelEdge);
+   OMEGA_SCOPE(LocActiveEdges, ActiveEdges);
+
+   // With compacted edges, the loops run over the active edges only and the
+   // tendency of the masked edges is left at zero
+   const bool Compact  = CompactMaskedEdges;
+   const I4 NEdgesLoop = Compact ? NActiveEdges : NEdgesAll;
+
+   annotateTendencyKernels<W>();
+
+   if (FusedVelocityTend) {
+      dispatchVelocityTendenciesFused<W>(
+          State, AuxState, VelTimeLevel, LocPotientialVortHAdv.Enabled,
+          LocKEGrad.Enabled, LocSSHGrad.Enabled, LocVelocityDiffusion.Enabled,
+          LocVelocityHyperDiff.Enabled and !FusedHyperDiff);
+
+      computeVelocityHyperDiffFused<W>(AuxState);
+
+      computeVelocityVertAdv(State, AuxState, VelTimeLevel);
+
+      if (CustomVelocityTend) {
+         CustomVelocityTend(LocNormalVelocityTend, State, AuxState,
+                            ThickTimeLevel, VelTimeLevel, Time);
+      }
+      return;
+   }
 
    deepCopy(LocNormalVelocityTend, 0);
 
    // Compute potential vorticity horizontal advection
-   const Array2DReal &FluxLayerThickEdge =
+   const auto &FluxLayerThickEdge =
        AuxState->LayerThicknessAux.FluxLayerThickEdge;
-   const Array2DReal &NormRVortEdge = AuxState->VorticityAux.NormRelVortEdge;
-   const Array2DReal &NormFEdge     = AuxState->VorticityAux.NormPlanetVortEdge;
-   const Array2DReal &NormVelEdge   = State->NormalVelocity[VelTimeLevel];
+   const auto &NormRVortEdge      = AuxState->VorticityAux.NormRelVortEdge;
+   const auto &NormFEdge          = AuxState->VorticityAux.NormPlanetVortEdge;
+   const Array2DReal &NormVelEdge = State->NormalVelocity[VelTimeLevel];
    if (LocPotientialVortHAdv.Enabled) {
-      parallelFor(
-          {NEdgesAll, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
-             LocPotientialVortHAdv(LocNormalVelocityTend, IEdge, KChunk,
-                                   NormRVortEdge, NormFEdge, FluxLayerThickEdge,
-                                   NormVelEdge);
-          });
+      parallelForChunks(
+          "potentialVortHAdv", {NEdgesLoop, NChunks},
+          KOKKOS_LAMBDA(int ILoop, int KChunk) {
+             const int IEdge = Compact ? LocActiveEdges(ILoop) : ILoop;
+             if (!isActiveChunk<W>(KChunk, LocMinLevelEdge(IEdge),
+                                   LocMaxLevelEdge(IEdge)))
+                return;
+             LocPotientialVortHAdv.template operator()<W>(
+                 LocNormalVelocityTend, IEdge, KChunk, NormRVortEdge,
+                 NormFEdge, FluxLayerThickEdge, NormVelEdge);
+          },
+          OuterInnerLoops);
    }
 
    // Compute kinetic energy gradient
-   const Array2DReal &KECell = AuxState->KineticAux.KineticEnergyCell;
+   const auto &KECell = AuxState->KineticAux.KineticEnergyCell;
    if (LocKEGrad.Enabled) {
-      parallelFor(
-          {NEdgesAll, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
-             LocKEGrad(LocNormalVelocityTend, IEdge, KChunk, KECell);
-          });
+      parallelForChunks(
+          "keGrad", {NEdgesLoop, NChunks},
+          KOKKOS_LAMBDA(int ILoop, int KChunk) {
+             const int IEdge = Compact ? LocActiveEdges(ILoop) : ILoop;
+             if (!isActiveChunk<W>(KChunk, LocMinLevelEdge(IEdge),
+                                   LocMaxLevelEdge(IEdge)))
+                return;
+             LocKEGrad.template operator()<W>(LocNormalVelocityTend, IEdge,
+                                              KChunk, KECell);
+          },
+          OuterInnerLoops);
    }
 
    // Compute sea surface height gradient
-   const Array2DReal &SSHCell = AuxState->LayerThicknessAux.SshCell;
+   const auto SSHCell = AuxState->LayerThicknessAux.sshCell();
    if (LocSSHGrad.Enabled) {
-      parallelFor(
-          {NEdgesAll, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
-             LocSSHGrad(LocNormalVelocityTend, IEdge, KChunk, SSHCell);
-          });
+      parallelForChunks(
+          "sshGrad", {NEdgesLoop, NChunks},
+          KOKKOS_LAMBDA(int ILoop, int KChunk) {
+             const int IEdge = Compact ? LocActiveEdges(ILoop) : ILoop;
+             if (!isActiveChunk<W>(KChunk, LocMinLevelEdge(IEdge),
+                                   LocMaxLevelEdge(IEdge)))
+                return;
+             LocSSHGrad.template operator()<W>(LocNormalVelocityTend, IEdge,
+                                               KChunk, SSHCell);
+          },
+          OuterInnerLoops);
    }
 
    // Compute del2 horizontal diffusion
-   const Array2DReal &DivCell     = AuxState->KineticAux.VelocityDivCell;
-   const Array2DReal &RVortVertex = AuxState->VorticityAux.RelVortVertex;
+   const auto &DivCell     = AuxState->KineticAux.VelocityDivCell;
+   const auto &RVortVertex = AuxState->VorticityAux.RelVortVertex;
    if (LocVelocityDiffusion.Enabled) {
-      parallelFor(
-          {NEdgesAll, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
-             LocVelocityDiffusion(LocNormalVelocityTend, IEdge, KChunk, DivCell,
-                                  RVortVertex);
-          });
+      parallelForChunks(
+          "velocityDiffusion", {NEdgesLoop, NChunks},
+          KOKKOS_LAMBDA(int ILoop, int KChunk) {
+             const int IEdge = Compact ? LocActiveEdges(ILoop) : ILoop;
+             if (!isActiveChunk<W>(KChunk, LocMinLevelEdge(IEdge),
+                                   LocMaxLevelEdge(IEdge)))
+                return;
+             LocVelocityDiffusion.template operator()<W>(
+                 LocNormalVelocityTend, IEdge, KChunk, DivCell, RVortVertex);
+          },
+          OuterInnerLoops);
    }
 
    // Compute del4 horizontal diffusion
-   const Array2DReal &Del2DivCell = AuxState->VelocityDel2Aux.Del2DivCell;
-   const Array2DReal &Del2RVortVertex =
-       AuxState->VelocityDel2Aux.Del2RelVortVertex;
-   if (LocVelocityHyperDiff.Enabled) {
-      parallelFor(
-          {NEdgesAll, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
-             LocVelocityHyperDiff(LocNormalVelocityTend, IEdge, KChunk,
-                                  Del2DivCell, Del2RVortVertex);
-          });
+   const auto &Del2DivCell     = AuxState->VelocityDel2Aux.Del2DivCell;
+   const auto &Del2RVortVertex = AuxState->VelocityDel2Aux.Del2RelVortVertex;
+   if (LocVelocityHyperDiff.Enabled and !FusedHyperDiff) {
+      parallelForChunks(
+          "velocityHyperDiff", {NEdgesLoop, NChunks},
+          KOKKOS_LAMBDA(int ILoop, int KChunk) {
+             const int IEdge = Compact ? LocActiveEdges(ILoop) : ILoop;
+             if (!isActiveChunk<W>(KChunk, LocMinLevelEdge(IEdge),
+                                   LocMaxLevelEdge(IEdge)))
+                return;
+             LocVelocityHyperDiff.template operator()<W>(
+                 LocNormalVelocityTend, IEdge, KChunk, Del2DivCell,
+                 Del2RVortVertex);
+          },
+          OuterInnerLoops);
    }
+   computeVelocityHyperDiffFused<W>(AuxState);
+
+   // Compute vertical advection
+   computeVelocityVertAdv(State, AuxState, VelTimeLevel);
 
    if (CustomVelocityTend) {
       CustomVelocityTend(LocNormalVelocityTend, State, AuxState, ThickTimeLevel,
@@ -306,6 +660,195 @@ void Tendencies::computeVelocityTendenciesOnly(
 
 } // end velocity tendency compute
 
+//------------------------------------------------------------------------------
+// Add the vertical advection of normal velocity, with each thread sweeping the
+// whole column of an edge
+void Tendencies::computeVelocityVertAdv(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    int VelTimeLevel                ///< [in] Time level
+) {
+
+   if (!VelocityVertAdv.Enabled)
+      return;
+
+   OMEGA_SCOPE(LocNormalVelocityTend, NormalVelocityTend);
+   OMEGA_SCOPE(LocVelocityVertAdv, VelocityVertAdv);
+   OMEGA_SCOPE(LocVertVelocityTop, VertVelocityTop);
+   const Array2DReal &NormVelEdge = State->NormalVelocity[VelTimeLevel];
+   const auto MeanLayerThickEdge =
+       AuxState->LayerThicknessAux.meanLayerThickEdge();
+   OMEGA_SCOPE(LocActiveEdges, ActiveEdges);
+   const bool Compact  = CompactMaskedEdges;
+   const I4 NEdgesLoop = Compact ? NActiveEdges : NEdgesAll;
+
+   parallelFor(
+       "velocityVertAdv", {NEdgesLoop}, KOKKOS_LAMBDA(int ILoop) {
+          const int IEdge = Compact ? LocActiveEdges(ILoop) : ILoop;
+          LocVelocityVertAdv(LocNormalVelocityTend, IEdge, LocVertVelocityTop,
+                             NormVelEdge, MeanLayerThickEdge);
+       });
+
+} // end velocity vertical advection
+
+//------------------------------------------------------------------------------
+// Add the del4 diffusion of normal velocity with the fused kernel if
+// FusedHyperDiff is set. Each team computes the laplacian of the velocity on
+// the edges of the two cells of an edge in scratch memory, so the laplacians
+// of the auxiliary state are neither computed nor stored.
+template <int W>
+void Tendencies::computeVelocityHyperDiffFused(
+    const AuxiliaryState *AuxState ///< [in] Auxilary state variables
+) {
+
+   if (!FusedHyperDiff or !VelocityHyperDiff.Enabled)
+      return;
+
+   OMEGA_SCOPE(LocNormalVelocityTend, NormalVelocityTend);
+   OMEGA_SCOPE(LocVelocityHyperDiff, VelocityHyperDiff);
+   OMEGA_SCOPE(LocVelocityDel2Aux, AuxState->VelocityDel2Aux);
+   OMEGA_SCOPE(LocActiveEdges, ActiveEdges);
+   OMEGA_SCOPE(LocNChunks, NChunks);
+   const auto &DivCell     = AuxState->KineticAux.VelocityDivCell;
+   const auto &RVortVertex = AuxState->VorticityAux.RelVortVertex;
+   const bool Compact      = CompactMaskedEdges;
+   const I4 NEdgesLoop     = Compact ? NActiveEdges : NEdgesAll;
+
+   const I4 NSlots = 2 * Mesh->MaxEdges;
+   const size_t ScratchBytes =
+       PatchScratchArray::shmem_size(NSlots, NChunks * W);
+
+   parallelForPolicy(
+       "fusedVelocityHyperDiff",
+       TeamPolicy(ExecInstance::get(), NEdgesLoop, Kokkos::AUTO)
+           .set_scratch_size(0, Kokkos::PerTeam(ScratchBytes)),
+       KOKKOS_LAMBDA(const TeamMember &Member) {
+          const int ILoop = Member.league_rank();
+          const int IEdge = Compact ? LocActiveEdges(ILoop) : ILoop;
+          const PatchScratchArray Del2Patch(Member.team_scratch(0), NSlots,
+                                            LocNChunks * W);
+          LocVelocityHyperDiff.template computeOnPatch<W>(
+              Member, Del2Patch, LocNormalVelocityTend, IEdge, LocNChunks,
+              LocVelocityDel2Aux, DivCell, RVortVertex);
+       });
+
+} // end fused velocity hyperdiffusion
+
+//------------------------------------------------------------------------------
+// Compute the normal velocity tendencies with one kernel that zeroes the
+// tendency of each edge and vertical chunk and then accumulates every enabled
+// term, so the tendency array is traversed once instead of once per term.
+// Disabled terms are removed at compile time. The terms are accumulated in the
+// same order as in the unfused path, giving identical results.
+template <int W, bool PVEnabled, bool KEEnabled, bool SSHEnabled,
+          bool Del2Enabled, bool Del4Enabled>
+void Tendencies::computeVelocityTendenciesFused(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    int VelTimeLevel                ///< [in] Time level
+) {
+
+   OMEGA_SCOPE(LocNormalVelocityTend, NormalVelocityTend);
+   OMEGA_SCOPE(LocPotientialVortHAdv, PotientialVortHAdv);
+   OMEGA_SCOPE(LocKEGrad, KEGrad);
+   OMEGA_SCOPE(LocSSHGrad, SSHGrad);
+   OMEGA_SCOPE(LocVelocityDiffusion, VelocityDiffusion);
+   OMEGA_SCOPE(LocVelocityHyperDiff, VelocityHyperDiff);
+   OMEGA_SCOPE(LocMinLevelEdge, MinLevelEdge);
+   OMEGA_SCOPE(LocMaxLevelEdge, MaxLevelEdge);
+
+   const auto &FluxLayerThickEdge =
+       AuxState->LayerThicknessAux.FluxLayerThickEdge;
+   const auto &NormRVortEdge      = AuxState->VorticityAux.NormRelVortEdge;
+   const auto &NormFEdge          = AuxState->VorticityAux.NormPlanetVortEdge;
+   const Array2DReal &NormVelEdge = State->NormalVelocity[VelTimeLevel];
+   const auto &KECell             = AuxState->KineticAux.KineticEnergyCell;
+   const auto SSHCell             = AuxState->LayerThicknessAux.sshCell();
+   const auto &DivCell            = AuxState->KineticAux.VelocityDivCell;
+   const auto &RVortVertex        = AuxState->VorticityAux.RelVortVertex;
+   const auto &Del2DivCell        = AuxState->VelocityDel2Aux.Del2DivCell;
+   const auto &Del2RVortVertex = AuxState->VelocityDel2Aux.Del2RelVortVertex;
+
+   // With compacted edges, the masked edges are zeroed beforehand and the
+   // kernel only runs over the active edges
+   OMEGA_SCOPE(LocActiveEdges, ActiveEdges);
+   const bool Compact  = CompactMaskedEdges;
+   const I4 NEdgesLoop = Compact ? NActiveEdges : NEdgesAll;
+   if (Compact) {
+      deepCopy(LocNormalVelocityTend, 0);
+   }
+
+   parallelForChunks(
+       "fusedVelocityTend", {NEdgesLoop, NChunks},
+       KOKKOS_LAMBDA(int ILoop, int KChunk) {
+          const int IEdge = Compact ? LocActiveEdges(ILoop) : ILoop;
+          const I4 KStart = KChunk * W;
+          const I4 KLen   = chunkLength<W>(KStart, LocNormalVelocityTend);
+          for (int KVec = 0; KVec < KLen; ++KVec) {
+             LocNormalVelocityTend(IEdge, KStart + KVec) = 0;
+          }
+          if (!isActiveChunk<W>(KChunk, LocMinLevelEdge(IEdge),
+                                LocMaxLevelEdge(IEdge)))
+             return;
+
+          if constexpr (PVEnabled) {
+             LocPotientialVortHAdv.template operator()<W>(
+                 LocNormalVelocityTend, IEdge, KChunk, NormRVortEdge,
+                 NormFEdge, FluxLayerThickEdge, NormVelEdge);
+          }
+          if constexpr (KEEnabled) {
+             LocKEGrad.template operator()<W>(LocNormalVelocityTend, IEdge,
+                                              KChunk, KECell);
+          }
+          if constexpr (SSHEnabled) {
+             LocSSHGrad.template operator()<W>(LocNormalVelocityTend, IEdge,
+                                               KChunk, SSHCell);
+          }
+          if constexpr (Del2Enabled) {
+             LocVelocityDiffusion.template operator()<W>(
+                 LocNormalVelocityTend, IEdge, KChunk, DivCell, RVortVertex);
+          }
+          if constexpr (Del4Enabled) {
+             LocVelocityHyperDiff.template operator()<W>(
+                 LocNormalVelocityTend, IEdge, KChunk, Del2DivCell,
+                 Del2RVortVertex);
+          }
+       },
+       OuterInnerLoops);
+
+} // end fused velocity tendency compute
+
+//------------------------------------------------------------------------------
+// Recursively convert the runtime enabled flags into template parameters.
+// Once all flags have been converted, call the fused kernel.
+template <int W, bool... Flags>
+void Tendencies::dispatchVelocityTendenciesFused(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    int VelTimeLevel                ///< [in] Time level
+) {
+   computeVelocityTendenciesFused<W, Flags...>(State, AuxState, VelTimeLevel);
+}
+
+template <int W, bool... Flags, class... BoolTypes>
+void Tendencies::dispatchVelocityTendenciesFused(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    int VelTimeLevel,               ///< [in] Time level
+    bool Enabled,                   ///< [in] Flag of the next term
+    BoolTypes... RestEnabled        ///< [in] Flags of the remaining terms
+) {
+   if (Enabled) {
+      dispatchVelocityTendenciesFused<W, Flags..., true>(State, AuxState,
+                                                         VelTimeLevel,
+                                                         RestEnabled...);
+   } else {
+      dispatchVelocityTendenciesFused<W, Flags..., false>(State, AuxState,
+                                                          VelTimeLevel,
+                                                          RestEnabled...);
+   }
+}
+
 void Tendencies::computeThicknessTendencies(
     const OceanState *State,        ///< [in] State variables
     const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
@@ -313,20 +856,40 @@ void Tendencies::computeThicknessTendencies(
     int VelTimeLevel,               ///< [in] Time level
     TimeInstant Time                ///< [in] Time
 ) {
-   // only need LayerThicknessAux on edge
+   OMEGA_DISPATCH_VEC_WIDTH(VecWidth, computeLayerThickAuxChunked, State,
+                            AuxState, ThickTimeLevel, VelTimeLevel);
+
+   computeThicknessTendenciesOnly(State, AuxState, ThickTimeLevel, VelTimeLevel,
+                                  Time);
+}
+
+// Compute the layer thickness auxiliary variables on edges, which are the only
+// auxiliary variables needed by the thickness tendencies
+template <int W>
+void Tendencies::computeLayerThickAuxChunked(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    int ThickTimeLevel,             ///< [in] Time level
+    int VelTimeLevel                ///< [in] Time level
+) {
    OMEGA_SCOPE(LayerThicknessAux, AuxState->LayerThicknessAux);
    OMEGA_SCOPE(LayerThickCell, State->LayerThickness[ThickTimeLevel]);
    OMEGA_SCOPE(NormalVelEdge, State->NormalVelocity[VelTimeLevel]);
+   OMEGA_SCOPE(LocMinLevelEdge, MinLevelEdge);
+   OMEGA_SCOPE(LocMaxLevelEdge, MaxLevelEdge);
 
-   parallelFor(
+   AuxState->LayerThicknessAux.setLayerThickCell(LayerThickCell);
+
+   parallelForChunks(
        "computeLayerThickAux", {NEdgesAll, NChunks},
        KOKKOS_LAMBDA(int IEdge, int KChunk) {
-          LayerThicknessAux.computeVarsOnEdge(IEdge, KChunk, LayerThickCell,
-                                              NormalVelEdge);
-       });
-
-   computeThicknessTendenciesOnly(State, AuxState, ThickTimeLevel, VelTimeLevel,
-                                  Time);
+          if (!isActiveChunk<W>(KChunk, LocMinLevelEdge(IEdge),
+                                LocMaxLevelEdge(IEdge)))
+             return;
+          LayerThicknessAux.computeVarsOnEdge<W>(IEdge, KChunk, LayerThickCell,
+                                                 NormalVelEdge);
+       },
+       OuterInnerLoops);
 }
 
 void Tendencies::computeVelocityTendencies(
@@ -351,18 +914,358 @@ void Tendencies::computeAllTendencies(
     TimeInstant Time                ///< [in] Time
 ) {
 
-   AuxState->computeAll(State, ThickTimeLevel, VelTimeLevel);
-   computeThicknessTendenciesOnly(State, AuxState, ThickTimeLevel, VelTimeLevel,
-                                  Time);
-   computeVelocityTendenciesOnly(State, AuxState, ThickTimeLevel, VelTimeLevel,
-                                 Time);
+   TimerRegion TendTimer("Tendencies");
+
+   OMEGA_DISPATCH_VEC_WIDTH(VecWidth, computeAllTendenciesChunked, State,
+                            AuxState, ThickTimeLevel, VelTimeLevel, Time);
 
 } // end all tendency compute
 
+template <int W>
+void Tendencies::computeAllTendenciesChunked(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    int ThickTimeLevel,             ///< [in] Time level
+    int VelTimeLevel,               ///< [in] Time level
+    TimeInstant Time                ///< [in] Time
+) {
+
+   // Use the specialized kernels if the enabled terms match one of the
+   // common configurations, which all include the thickness flux divergence
+   // and the kinetic energy and sea surface height gradients. Other
+   // configurations use the general path with runtime Enabled checks.
+   constexpr I4 BaseTerms = TendThickFluxBit | TendKEGradBit | TendSSHGradBit;
+
+   // The fused del4 diffusion is added with its own kernel, after the
+   // specialized kernels without the del4 term
+   I4 TermMask = getEnabledTermMask();
+   if (FusedHyperDiff)
+      TermMask &= ~TendDel4Bit;
+
+   if (SpecializedTend) {
+      switch (TermMask) {
+      case BaseTerms | TendPVBit | TendDel2Bit | TendDel4Bit:
+         computeAllTendenciesSpecialized<W, BaseTerms | TendPVBit |
+                                                TendDel2Bit | TendDel4Bit>(
+             State, AuxState, ThickTimeLevel, VelTimeLevel, Time);
+         return;
+      case BaseTerms | TendPVBit | TendDel2Bit:
+         computeAllTendenciesSpecialized<W,
+                                         BaseTerms | TendPVBit | TendDel2Bit>(
+             State, AuxState, ThickTimeLevel, VelTimeLevel, Time);
+         return;
+      case BaseTerms | TendPVBit | TendDel4Bit:
+         computeAllTendenciesSpecialized<W,
+                                         BaseTerms | TendPVBit | TendDel4Bit>(
+             State, AuxState, ThickTimeLevel, VelTimeLevel, Time);
+         return;
+      case BaseTerms | TendPVBit:
+         computeAllTendenciesSpecialized<W, BaseTerms | TendPVBit>(
+             State, AuxState, ThickTimeLevel, VelTimeLevel, Time);
+         return;
+      case BaseTerms | TendDel2Bit | TendDel4Bit:
+         computeAllTendenciesSpecialized<W, BaseTerms | TendDel2Bit |
+                                                TendDel4Bit>(
+             State, AuxState, ThickTimeLevel, VelTimeLevel, Time);
+         return;
+      case BaseTerms | TendDel2Bit:
+         computeAllTendenciesSpecialized<W, BaseTerms | TendDel2Bit>(
+             State, AuxState, ThickTimeLevel, VelTimeLevel, Time);
+         return;
+      case BaseTerms | TendDel4Bit:
+         computeAllTendenciesSpecialized<W, BaseTerms | TendDel4Bit>(
+             State, AuxState, ThickTimeLevel, VelTimeLevel, Time);
+         return;
+      case BaseTerms:
+         computeAllTendenciesSpecialized<W, BaseTerms>(
+             State, AuxState, ThickTimeLevel, VelTimeLevel, Time);
+         return;
+      default:
+         break;
+      }
+   }
+
+   AuxState->computeAll(State, ThickTimeLevel, VelTimeLevel);
+
+   // The thickness and velocity tendencies only read the state and the
+   // auxiliary variables and can run concurrently, unless the vertical
+   // advection of velocity reads the vertical velocity diagnosed with the
+   // thickness tendency or custom terms are added
+   const bool Coupled =
+       VelocityVertAdv.Enabled or CustomThicknessTend or CustomVelocityTend;
+
+   KernelScheduler Sched;
+   std::vector<KernelScheduler::TaskID> VelDeps;
+   const auto ThickTask = Sched.add([&]() {
+      computeThicknessTendenciesChunked<W>(State, AuxState, ThickTimeLevel,
+                                           VelTimeLevel, Time);
+   });
+   if (Coupled)
+      VelDeps.push_back(ThickTask);
+   Sched.add(
+       [&]() {
+          computeVelocityTendenciesChunked<W>(State, AuxState, ThickTimeLevel,
+                                              VelTimeLevel, Time);
+       },
+       VelDeps);
+   Sched.run();
+
+} // end chunked all tendency compute
+
+//------------------------------------------------------------------------------
+// Compute the tendencies of a batch of thickness-weighted tracers. The kernel
+// iterates over the tracers of the batch together with the cells and vertical
+// chunks, zeroes the tendency of each tracer, cell and chunk and accumulates
+// all enabled tracer terms, so a whole tracer group is handled by a single
+// launch instead of one launch per tracer and term.
+void Tendencies::computeTracerTendencies(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    const Array3DReal &TracerArray, ///< [in] Tracer array
+    int ThickTimeLevel,             ///< [in] Time level
+    int VelTimeLevel,               ///< [in] Time level
+    TimeInstant Time,               ///< [in] Time
+    I4 TracerStart,                 ///< [in] First tracer of the batch
+    I4 NTracersBatch                ///< [in] Number of tracers in the batch
+) {
+
+   TimerRegion TendTimer("TracerTendencies");
+
+   // Allocate the tendency array on first use, the tracers are initialized
+   // after the tendencies
+   if (TracerTend.extent_int(0) != TracerArray.extent_int(0)) {
+      TracerTend = createFirstTouchArray<Array3DAuxReal>(
+          "TracerTend", TracerArray.extent_int(0), TracerArray.extent_int(1),
+          TracerArray.extent_int(2));
+   }
+
+   AuxState->computeTracerAux(State, TracerArray, ThickTimeLevel, VelTimeLevel,
+                              TracerStart, NTracersBatch);
+
+   OMEGA_DISPATCH_VEC_WIDTH(VecWidth, computeTracerTendenciesChunked, State,
+                            AuxState, TracerArray, VelTimeLevel, TracerStart,
+                            NTracersBatch);
+
+} // end tracer tendency compute
+
+template <int W>
+void Tendencies::computeTracerTendenciesChunked(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    const Array3DReal &TracerArray, ///< [in] Tracer array
+    int VelTimeLevel,               ///< [in] Time level
+    I4 TracerStart,                 ///< [in] First tracer of the batch
+    I4 NTracersBatch                ///< [in] Number of tracers in the batch
+) {
+
+   OMEGA_SCOPE(LocTracerTend, TracerTend);
+   OMEGA_SCOPE(LocTracerHorzAdv, TracerHorzAdv);
+   OMEGA_SCOPE(LocTracerDiffusion, TracerDiffusion);
+   OMEGA_SCOPE(LocTracerHyperDiff, TracerHyperDiff);
+   OMEGA_SCOPE(LocMinLevelCell, MinLevelCell);
+   OMEGA_SCOPE(LocMaxLevelCell, MaxLevelCell);
+
+   const Array2DReal &NormVelEdge = State->NormalVelocity[VelTimeLevel];
+   const auto MeanLayerThickEdge =
+       AuxState->LayerThicknessAux.meanLayerThickEdge();
+   const auto &HTracersOnEdge    = AuxState->TracerAux.HTracersOnEdge;
+   const auto &Del2TracersOnCell = AuxState->TracerAux.Del2TracersOnCell;
+
+   const bool HAdvEnabled = LocTracerHorzAdv.Enabled;
+   const bool Del2Enabled = LocTracerDiffusion.Enabled;
+   const bool Del4Enabled = LocTracerHyperDiff.Enabled and !FusedHyperDiff;
+
+   annotateTendencyKernels<W>();
+
+   parallelForChunks(
+       "tracerTendencies", {NTracersBatch, NCellsAll, NChunks},
+       KOKKOS_LAMBDA(int LBatch, int ICell, int KChunk) {
+          const I4 L      = TracerStart + LBatch;
+          const I4 KStart = KChunk * W;
+          const I4 KLen   = chunkLength<W>(KStart, LocTracerTend);
+          for (int KVec = 0; KVec < KLen; ++KVec) {
+             LocTracerTend(L, ICell, KStart + KVec) = 0;
+          }
+          if (!isActiveChunk<W>(KChunk, LocMinLevelCell(ICell),
+                                LocMaxLevelCell(ICell)))
+             return;
+          if (HAdvEnabled) {
+             LocTracerHorzAdv.template operator()<W>(
+                 LocTracerTend, L, ICell, KChunk, NormVelEdge, HTracersOnEdge);
+          }
+          if (Del2Enabled) {
+             LocTracerDiffusion.template operator()<W>(
+                 LocTracerTend, L, ICell, KChunk, TracerArray,
+                 MeanLayerThickEdge);
+          }
+          if (Del4Enabled) {
+             LocTracerHyperDiff.template operator()<W>(
+                 LocTracerTend, L, ICell, KChunk, Del2TracersOnCell);
+          }
+       },
+       OuterInnerLoops);
+
+   // The fused del4 diffusion is added with a team per tracer and cell that
+   // computes the laplacian of the tracer on the cell and its neighbors in
+   // scratch memory
+   if (FusedHyperDiff and LocTracerHyperDiff.Enabled) {
+      OMEGA_SCOPE(LocTracerAux, AuxState->TracerAux);
+      OMEGA_SCOPE(LocNCellsAll, NCellsAll);
+      OMEGA_SCOPE(LocNChunks, NChunks);
+      const I4 NSlots = Mesh->MaxEdges + 1;
+      const size_t ScratchBytes =
+          PatchScratchArray::shmem_size(NSlots, NChunks * W);
+      parallelForPolicy(
+          "fusedTracerHyperDiff",
+          TeamPolicy(ExecInstance::get(), NTracersBatch * NCellsAll,
+                     Kokkos::AUTO)
+              .set_scratch_size(0, Kokkos::PerTeam(ScratchBytes)),
+          KOKKOS_LAMBDA(const TeamMember &Member) {
+             const I4 L     = TracerStart + Member.league_rank() / LocNCellsAll;
+             const I4 ICell = Member.league_rank() % LocNCellsAll;
+             const PatchScratchArray Del2Patch(Member.team_scratch(0), NSlots,
+                                               LocNChunks * W);
+             LocTracerHyperDiff.template computeOnPatch<W>(
+                 Member, Del2Patch, LocTracerTend, L, ICell, LocNChunks,
+                 LocTracerAux, MeanLayerThickEdge, TracerArray);
+          });
+   }
+
+   // Vertical advection sweeps whole columns, so it is added with a second
+   // kernel over cells with the tracers of the batch as the fastest index
+   if (TracerVertAdv.Enabled) {
+      OMEGA_SCOPE(LocTracerVertAdv, TracerVertAdv);
+      OMEGA_SCOPE(LocVertVelocityTop, VertVelocityTop);
+      parallelFor(
+          "tracerVertAdv", {NCellsAll, NTracersBatch},
+          KOKKOS_LAMBDA(int ICell, int LBatch) {
+             LocTracerVertAdv(LocTracerTend, TracerStart + LBatch, ICell,
+                              LocVertVelocityTop, TracerArray);
+          });
+   }
+
+} // end chunked tracer tendency compute
+
+void Tendencies::computeTracerTendencies(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    const Array3DReal &TracerArray, ///< [in] Tracer array
+    int ThickTimeLevel,             ///< [in] Time level
+    int VelTimeLevel,               ///< [in] Time level
+    TimeInstant Time                ///< [in] Time
+) {
+   if (StepTracerRanges.empty()) {
+      computeTracerTendencies(State, AuxState, TracerArray, ThickTimeLevel,
+                              VelTimeLevel, Time, 0, TracerArray.extent_int(0));
+      return;
+   }
+
+   for (const auto &[TracerStart, NTracersBatch] : StepTracerRanges) {
+      computeTracerTendencies(State, AuxState, TracerArray, ThickTimeLevel,
+                              VelTimeLevel, Time, TracerStart, NTracersBatch);
+   }
+}
+
+int Tendencies::computeTracerTendencies(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    const Array3DReal &TracerArray, ///< [in] Tracer array
+    const std::string &GroupName,   ///< [in] Tracer group name
+    int ThickTimeLevel,             ///< [in] Time level
+    int VelTimeLevel,               ///< [in] Time level
+    TimeInstant Time                ///< [in] Time
+) {
+   std::pair<I4, I4> GroupRange;
+   I4 Err = Tracers::getGroupRange(GroupRange, GroupName);
+   if (Err != 0) {
+      LOG_ERROR("Tendencies: tracer group {} not found", GroupName);
+      return Err;
+   }
+
+   computeTracerTendencies(State, AuxState, TracerArray, ThickTimeLevel,
+                           VelTimeLevel, Time, GroupRange.first,
+                           GroupRange.second);
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Compute the auxiliary state and all tendencies with kernels specialized for
+// the enabled terms in TermMask. The thickness tendency kernel zeroes each
+// cell and vertical chunk before adding the flux divergence, and the velocity
+// tendencies use the fused kernel with the corresponding terms enabled.
+template <int W, I4 TermMask>
+void Tendencies::computeAllTendenciesSpecialized(
+    const OceanState *State,        ///< [in] State variables
+    const AuxiliaryState *AuxState, ///< [in] Auxilary state variables
+    int ThickTimeLevel,             ///< [in] Time level
+    int VelTimeLevel,               ///< [in] Time level
+    TimeInstant Time                ///< [in] Time
+) {
+
+   AuxState->computeAll(State, ThickTimeLevel, VelTimeLevel);
+
+   OMEGA_SCOPE(LocLayerThicknessTend, LayerThicknessTend);
+   OMEGA_SCOPE(LocNormalVelocityTend, NormalVelocityTend);
+   OMEGA_SCOPE(LocThicknessFluxDiv, ThicknessFluxDiv);
+   OMEGA_SCOPE(LocMinLevelCell, MinLevelCell);
+   OMEGA_SCOPE(LocMaxLevelCell, MaxLevelCell);
+   const Array2DReal &NormalVelEdge = State->NormalVelocity[VelTimeLevel];
+   const auto &ThickFluxEdge = AuxState->LayerThicknessAux.FluxLayerThickEdge;
+
+   const auto ThicknessTend = KOKKOS_LAMBDA(int ICell, int KChunk) {
+      const I4 KStart = KChunk * W;
+      const I4 KLen   = chunkLength<W>(KStart, LocLayerThicknessTend);
+      for (int KVec = 0; KVec < KLen; ++KVec) {
+         LocLayerThicknessTend(ICell, KStart + KVec) = 0;
+      }
+      if (!isActiveChunk<W>(KChunk, LocMinLevelCell(ICell),
+                            LocMaxLevelCell(ICell)))
+         return;
+      LocThicknessFluxDiv.template operator()<W>(
+          LocLayerThicknessTend, ICell, KChunk, ThickFluxEdge, NormalVelEdge);
+   };
+
+   // The thickness and velocity tendencies are independent unless custom
+   // terms are added
+   KernelScheduler Sched;
+   std::vector<KernelScheduler::TaskID> VelDeps;
+   const auto ThickTask = Sched.add([&]() {
+      if constexpr ((TermMask & TendThickFluxBit) != 0) {
+         parallelForChunks("specializedThicknessTend", {NCellsAll, NChunks},
+                           ThicknessTend, OuterInnerLoops);
+      } else {
+         deepCopy(LocLayerThicknessTend, 0);
+      }
+
+      if (CustomThicknessTend) {
+         CustomThicknessTend(LocLayerThicknessTend, State, AuxState,
+                             ThickTimeLevel, VelTimeLevel, Time);
+      }
+   });
+   if (CustomThicknessTend or CustomVelocityTend)
+      VelDeps.push_back(ThickTask);
+   Sched.add(
+       [&]() {
+          computeVelocityTendenciesFused<
+              W, (TermMask & TendPVBit) != 0, (TermMask & TendKEGradBit) != 0,
+              (TermMask & TendSSHGradBit) != 0, (TermMask & TendDel2Bit) != 0,
+              (TermMask & TendDel4Bit) != 0>(State, AuxState, VelTimeLevel);
+          computeVelocityHyperDiffFused<W>(AuxState);
+
+          if (CustomVelocityTend) {
+             CustomVelocityTend(LocNormalVelocityTend, State, AuxState,
+                                ThickTimeLevel, VelTimeLevel, Time);
+          }
+       },
+       VelDeps);
+   Sched.run();
+
+} // end specialized all tendency compute
+
 ThicknessFluxDivOnCell::ThicknessFluxDivOnCell(const HorzMesh *Mesh)
-    : NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      DvEdge(Mesh->DvEdge), AreaCell(Mesh->AreaCell),
-      EdgeSignOnCell(Mesh->EdgeSignOnCell) {}
+    : OffsetsOnCell(Mesh->OffsetsOnCell), EdgesOnCellCSR(Mesh->EdgesOnCellCSR),
+      DivWeightsOnCellCSR(Mesh->DivWeightsOnCellCSR) {}
 
 PotentialVortHAdvOnEdge::PotentialVortHAdvOnEdge(const HorzMesh *Mesh)
     : NEdgesOnEdge(Mesh->NEdgesOnEdge), EdgesOnEdge(Mesh->EdgesOnEdge),
@@ -382,24 +1285,42 @@ VelocityDiffusionOnEdge::VelocityDiffusionOnEdge(const HorzMesh *Mesh)
 VelocityHyperDiffOnEdge::VelocityHyperDiffOnEdge(const HorzMesh *Mesh)
     : CellsOnEdge(Mesh->CellsOnEdge), VerticesOnEdge(Mesh->VerticesOnEdge),
       DcEdge(Mesh->DcEdge), DvEdge(Mesh->DvEdge),
-      MeshScalingDel4(Mesh->MeshScalingDel4), EdgeMask(Mesh->EdgeMask) {}
+      MeshScalingDel4(Mesh->MeshScalingDel4), EdgeMask(Mesh->EdgeMask),
+      OffsetsOnCell(Mesh->OffsetsOnCell), EdgesOnCellCSR(Mesh->EdgesOnCellCSR),
+      DivWeightsOnCellCSR(Mesh->DivWeightsOnCellCSR),
+      EdgesOnVertex(Mesh->EdgesOnVertex),
+      CurlWeightsOnVertex(Mesh->CurlWeightsOnVertex),
+      MinLevelCell(Mesh->MinLevelCell), MaxLevelCell(Mesh->MaxLevelCell),
+      MinLevelEdge(Mesh->MinLevelEdge), MaxLevelEdge(Mesh->MaxLevelEdge),
+      MinLevelVertex(Mesh->MinLevelVertex),
+      MaxLevelVertex(Mesh->MaxLevelVertex), VertexDegree(Mesh->VertexDegree),
+      NEdgesAll(Mesh->NEdgesAll), NVerticesAll(Mesh->NVerticesAll) {}
 
 TracerHorzAdvOnCell::TracerHorzAdvOnCell(const HorzMesh *Mesh)
-    : NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      CellsOnEdge(Mesh->CellsOnEdge), EdgeSignOnCell(Mesh->EdgeSignOnCell),
-      DvEdge(Mesh->DvEdge), AreaCell(Mesh->AreaCell) {}
+    : OffsetsOnCell(Mesh->OffsetsOnCell), EdgesOnCellCSR(Mesh->EdgesOnCellCSR),
+      DivWeightsOnCellCSR(Mesh->DivWeightsOnCellCSR) {}
 
 TracerDiffOnCell::TracerDiffOnCell(const HorzMesh *Mesh)
-    : NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      CellsOnEdge(Mesh->CellsOnEdge), EdgeSignOnCell(Mesh->EdgeSignOnCell),
-      DvEdge(Mesh->DvEdge), DcEdge(Mesh->DcEdge), AreaCell(Mesh->AreaCell),
-      MeshScalingDel2(Mesh->MeshScalingDel2) {}
+    : OffsetsOnCell(Mesh->OffsetsOnCell), EdgesOnCellCSR(Mesh->EdgesOnCellCSR),
+      CellsOnEdge(Mesh->CellsOnEdge),
+      Del2WeightsOnCellCSR(Mesh->Del2WeightsOnCellCSR) {}
 
 TracerHyperDiffOnCell::TracerHyperDiffOnCell(const HorzMesh *Mesh)
-    : NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      CellsOnEdge(Mesh->CellsOnEdge), EdgeSignOnCell(Mesh->EdgeSignOnCell),
-      DvEdge(Mesh->DvEdge), DcEdge(Mesh->DcEdge), AreaCell(Mesh->AreaCell),
-      MeshScalingDel4(Mesh->MeshScalingDel4) {}
+    : OffsetsOnCell(Mesh->OffsetsOnCell), EdgesOnCellCSR(Mesh->EdgesOnCellCSR),
+      CellsOnEdge(Mesh->CellsOnEdge),
+      Del4WeightsOnCellCSR(Mesh->Del4WeightsOnCellCSR),
+      MinLevelCell(Mesh->MinLevelCell), MaxLevelCell(Mesh->MaxLevelCell),
+      NCellsAll(Mesh->NCellsAll) {}
+
+VertVelocityOnCell::VertVelocityOnCell(const HorzMesh *Mesh)
+    : MinLevelCell(Mesh->MinLevelCell), MaxLevelCell(Mesh->MaxLevelCell) {}
+
+VelocityVertAdvOnEdge::VelocityVertAdvOnEdge(const HorzMesh *Mesh)
+    : CellsOnEdge(Mesh->CellsOnEdge), MinLevelEdge(Mesh->MinLevelEdge),
+      MaxLevelEdge(Mesh->MaxLevelEdge) {}
+
+TracerVertAdvOnCell::TracerVertAdvOnCell(const HorzMesh *Mesh)
+    : MinLevelCell(Mesh->MinLevelCell), MaxLevelCell(Mesh->MaxLevelCell) {}
 
 } // end namespace OMEGA
 
@@ -6,7 +6,9 @@
 /// \brief Contains functors for calculating tendency terms
 ///
 /// This header defines functors to be called by the time-stepping scheme
-/// to calculate tendencies used to update state variables.
+/// to calculate tendencies used to update state variables. The functors are
+/// templated on the width of the vertical chunks they operate on, which is
+/// selected at run time by the Tendencies class.
 //
 //===----------------------------------------------------------------------===//
 
@@ -15,13 +17,33 @@
 #include "HorzMesh.h"
 #include "MachEnv.h"
 #include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "Pack.h"
 #include "TimeMgr.h"
 
 #include <functional>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace OMEGA {
 
+/// Team scratch array of the fused hyperdiffusion, holding the laplacian on
+/// the elements of a mesh patch with dimensions [patch element, level]
+using PatchScratchArray =
+    Kokkos::View<AuxReal **, Kokkos::LayoutRight,
+                 ExecSpace::scratch_memory_space,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+/// Rounds the lanes of a pack to AuxReal, like storing it in an auxiliary
+/// variable and loading it back
+template <int W>
+KOKKOS_INLINE_FUNCTION RealPack<W> roundToAux(RealPack<W> Val) {
+   for (int KVec = 0; KVec < W; ++KVec)
+      Val.V[KVec] = static_cast<AuxReal>(Val.V[KVec]);
+   return Val;
+}
+
 /// Divergence of thickness flux at cell centers, for updating layer thickness
 /// arrays
 class ThicknessFluxDivOnCell {
@@ -33,37 +55,32 @@ class ThicknessFluxDivOnCell {
 
    /// The functor takes cell index, vertical chunk index, and thickness flux
    /// array as inputs, outputs the tendency array
-   KOKKOS_FUNCTION void operator()(const Array2DReal &Tend, I4 ICell, I4 KChunk,
-                                   const Array2DR8 &ThicknessFlux,
+   template <int W = VecLength>
+   KOKKOS_FUNCTION void operator()(const Array2DAuxReal &Tend, I4 ICell,
+                                   I4 KChunk,
+                                   const Array2DAuxReal &ThicknessFlux,
                                    const Array2DReal &NormalVelEdge) const {
 
-      const I4 KStart        = KChunk * VecLength;
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
+      const I4 KStart = KChunk * W;
+      const I4 KLen   = chunkLength<W>(KStart, Tend);
 
-      Real DivTmp[VecLength] = {0};
+      RealPack<W> DivTmp;
 
-      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
-         const I4 JEdge = EdgesOnCell(ICell, J);
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const I4 K = KStart + KVec;
-            DivTmp[KVec] -= DvEdge(JEdge) * EdgeSignOnCell(ICell, J) *
-                            ThicknessFlux(JEdge, K) * NormalVelEdge(JEdge, K) *
-                            InvAreaCell;
-         }
+      for (int J = OffsetsOnCell(ICell); J < OffsetsOnCell(ICell + 1); ++J) {
+         const I4 JEdge    = EdgesOnCellCSR(J);
+         const Real DivWgt = DivWeightsOnCellCSR(J);
+         DivTmp -= DivWgt * loadPack<W>(ThicknessFlux, KStart, KLen, JEdge) *
+                   loadPack<W>(NormalVelEdge, KStart, KLen, JEdge);
       }
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const I4 K = KStart + KVec;
-         Tend(ICell, K) -= DivTmp[KVec];
-      }
+      storePack(Tend, loadPack<W>(Tend, KStart, KLen, ICell) - DivTmp, KStart,
+                KLen, ICell);
    }
 
  private:
-   Array1DI4 NEdgesOnCell;
-   Array2DI4 EdgesOnCell;
-   Array1DR8 DvEdge;
-   Array1DR8 AreaCell;
-   Array2DR8 EdgeSignOnCell;
+   Array1DI4 OffsetsOnCell;
+   Array1DI4 EdgesOnCellCSR;
+   Array1DR8 DivWeightsOnCellCSR;
 };
 
 /// Horizontal advection of potential vorticity defined on edges, for
@@ -79,33 +96,38 @@ class PotentialVortHAdvOnEdge {
    /// normalized relative vorticity, normalized planetary vorticity, layer
    /// thickness on edges, and normal velocity on edges as inputs,
    /// outputs the tendency array
-   KOKKOS_FUNCTION void operator()(const Array2DReal &Tend, I4 IEdge, I4 KChunk,
-                                   const Array2DR8 &NormRVortEdge,
-                                   const Array2DR8 &NormFEdge,
-                                   const Array2DR8 &FluxLayerThickEdge,
+   template <int W = VecLength>
+   KOKKOS_FUNCTION void operator()(const Array2DAuxReal &Tend, I4 IEdge,
+                                   I4 KChunk,
+                                   const Array2DAuxReal &NormRVortEdge,
+                                   const Array2DAuxReal &NormFEdge,
+                                   const Array2DAuxReal &FluxLayerThickEdge,
                                    const Array2DR8 &NormVelEdge) const {
 
-      const I4 KStart         = KChunk * VecLength;
-      Real VortTmp[VecLength] = {0};
+      const I4 KStart = KChunk * W;
+      const I4 KLen   = chunkLength<W>(KStart, Tend);
+      RealPack<W> VortTmp;
+
+      const RealPack<W> VortEdge =
+          loadPack<W>(NormRVortEdge, KStart, KLen, IEdge) +
+          loadPack<W>(NormFEdge, KStart, KLen, IEdge);
 
       for (int J = 0; J < NEdgesOnEdge(IEdge); ++J) {
-         I4 JEdge = EdgesOnEdge(IEdge, J);
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const I4 K    = KStart + KVec;
-            Real NormVort = (NormRVortEdge(IEdge, K) + NormFEdge(IEdge, K) +
-                             NormRVortEdge(JEdge, K) + NormFEdge(JEdge, K)) *
-                            0.5_Real;
-
-            VortTmp[KVec] += WeightsOnEdge(IEdge, J) *
-                             FluxLayerThickEdge(JEdge, K) *
-                             NormVelEdge(JEdge, K) * NormVort;
-         }
-      }
+         const I4 JEdge    = EdgesOnEdge(IEdge, J);
+         const Real Weight = WeightsOnEdge(IEdge, J);
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const I4 K = KStart + KVec;
-         Tend(IEdge, K) += VortTmp[KVec];
+         const RealPack<W> NormVort =
+             (VortEdge + loadPack<W>(NormRVortEdge, KStart, KLen, JEdge) +
+              loadPack<W>(NormFEdge, KStart, KLen, JEdge)) *
+             0.5_Real;
+
+         VortTmp += Weight *
+                    loadPack<W>(FluxLayerThickEdge, KStart, KLen, JEdge) *
+                    loadPack<W>(NormVelEdge, KStart, KLen, JEdge) * NormVort;
       }
+
+      storePack(Tend, loadPack<W>(Tend, KStart, KLen, IEdge) + VortTmp, KStart,
+                KLen, IEdge);
    }
 
  private:
@@ -124,18 +146,23 @@ class KEGradOnEdge {
 
    /// The functor takes edge index, vertical chunk index, and kinetic energy
    /// array as inputs, outputs the tendency array
-   KOKKOS_FUNCTION void operator()(const Array2DReal &Tend, I4 IEdge, I4 KChunk,
-                                   const Array2DR8 &KECell) const {
+   template <int W = VecLength>
+   KOKKOS_FUNCTION void operator()(const Array2DAuxReal &Tend, I4 IEdge,
+                                   I4 KChunk,
+                                   const Array2DAuxReal &KECell) const {
 
-      const I4 KStart      = KChunk * VecLength;
+      const I4 KStart      = KChunk * W;
+      const I4 KLen        = chunkLength<W>(KStart, Tend);
       const I4 JCell0      = CellsOnEdge(IEdge, 0);
       const I4 JCell1      = CellsOnEdge(IEdge, 1);
       const Real InvDcEdge = 1._Real / DcEdge(IEdge);
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const I4 K = KStart + KVec;
-         Tend(IEdge, K) -= (KECell(JCell1, K) - KECell(JCell0, K)) * InvDcEdge;
-      }
+      const RealPack<W> KEGrad = (loadPack<W>(KECell, KStart, KLen, JCell1) -
+                                  loadPack<W>(KECell, KStart, KLen, JCell0)) *
+                                 InvDcEdge;
+
+      storePack(Tend, loadPack<W>(Tend, KStart, KLen, IEdge) - KEGrad, KStart,
+                KLen, IEdge);
    }
 
  private:
@@ -149,28 +176,37 @@ class SSHGradOnEdge {
  public:
    bool Enabled;
 
+   /// Gravitational acceleration (m/s^2)
+   R8 Grav = 9.80665_Real;
+
    /// constructor declaration
    SSHGradOnEdge(const HorzMesh *Mesh);
 
    /// The functor takes edge index, vertical chunk index, and array of
-   /// layer thickness/SSH, outputs tendency array
-   KOKKOS_FUNCTION void operator()(const Array2DReal &Tend, I4 IEdge, I4 KChunk,
-                                   const Array2DReal &SshCell) const {
+   /// layer thickness/SSH, outputs tendency array. The SSH can be the stored
+   /// array or its accessor from the layer thickness auxiliary variables.
+   template <int W = VecLength, class SshArrayType>
+   KOKKOS_FUNCTION void operator()(const Array2DAuxReal &Tend, I4 IEdge,
+                                   I4 KChunk,
+                                   const SshArrayType &SshCell) const {
 
-      const I4 KStart      = KChunk * VecLength;
+      const I4 KStart      = KChunk * W;
+      const I4 KLen        = chunkLength<W>(KStart, Tend);
       const I4 ICell0      = CellsOnEdge(IEdge, 0);
       const I4 ICell1      = CellsOnEdge(IEdge, 1);
       const Real InvDcEdge = 1._Real / DcEdge(IEdge);
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const I4 K = KStart + KVec;
-         Tend(IEdge, K) -=
-             Grav * (SshCell(ICell1, K) - SshCell(ICell0, K)) * InvDcEdge;
-      }
+      const Real GravInvDc = Grav * InvDcEdge;
+
+      const RealPack<W> SshGrad = (loadPack<W>(SshCell, KStart, KLen, ICell1) -
+                                   loadPack<W>(SshCell, KStart, KLen, ICell0)) *
+                                  GravInvDc;
+
+      storePack(Tend, loadPack<W>(Tend, KStart, KLen, IEdge) - SshGrad, KStart,
+                KLen, IEdge);
    }
 
  private:
-   R8 Grav = 9.80665_Real;
    Array2DI4 CellsOnEdge;
    Array1DR8 DcEdge;
 };
@@ -188,11 +224,13 @@ class VelocityDiffusionOnEdge {
    /// The functor takes edge index, vertical chunk index, and arrays for
    /// divergence of horizontal velocity (defined at cell centers) and relative
    /// vorticity (defined at vertices), outputs tendency array
-   KOKKOS_FUNCTION void operator()(const Array2DReal &Tend, I4 IEdge, I4 KChunk,
-                                   const Array2DR8 &DivCell,
-                                   const Array2DR8 &RVortVertex) const {
+   template <int W = VecLength>
+   KOKKOS_FUNCTION void operator()(const Array2DAuxReal &Tend, I4 IEdge,
+                                   I4 KChunk, const Array2DAuxReal &DivCell,
+                                   const Array2DAuxReal &RVortVertex) const {
 
-      const I4 KStart = KChunk * VecLength;
+      const I4 KStart = KChunk * W;
+      const I4 KLen   = chunkLength<W>(KStart, Tend);
       const I4 ICell0 = CellsOnEdge(IEdge, 0);
       const I4 ICell1 = CellsOnEdge(IEdge, 1);
 
@@ -202,16 +240,20 @@ class VelocityDiffusionOnEdge {
       const Real DcEdgeInv = 1._Real / DcEdge(IEdge);
       const Real DvEdgeInv = 1._Real / DvEdge(IEdge);
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const I4 K = KStart + KVec;
-         const Real Del2U =
-             ((DivCell(ICell1, K) - DivCell(ICell0, K)) * DcEdgeInv -
-              (RVortVertex(IVertex1, K) - RVortVertex(IVertex0, K)) *
-                  DvEdgeInv);
+      const Real Coeff = ViscDel2 * MeshScalingDel2(IEdge);
 
-         Tend(IEdge, K) +=
-             EdgeMask(IEdge, K) * ViscDel2 * MeshScalingDel2(IEdge) * Del2U;
-      }
+      const RealPack<W> Del2U =
+          (loadPack<W>(DivCell, KStart, KLen, ICell1) -
+           loadPack<W>(DivCell, KStart, KLen, ICell0)) *
+              DcEdgeInv -
+          (loadPack<W>(RVortVertex, KStart, KLen, IVertex1) -
+           loadPack<W>(RVortVertex, KStart, KLen, IVertex0)) *
+              DvEdgeInv;
+
+      storePack(Tend,
+                loadPack<W>(Tend, KStart, KLen, IEdge) +
+                    Coeff * loadPack<W>(EdgeMask, KStart, KLen, IEdge) * Del2U,
+                KStart, KLen, IEdge);
    }
 
  private:
@@ -236,11 +278,14 @@ class VelocityHyperDiffOnEdge {
    /// The functor takes the edge index, vertical chunk index, and arrays for
    /// the laplacian of divergence of horizontal velocity and the laplacian of
    /// the relative vorticity, outputs tendency array
-   KOKKOS_FUNCTION void operator()(const Array2DReal &Tend, I4 IEdge, I4 KChunk,
-                                   const Array2DR8 &Del2DivCell,
-                                   const Array2DR8 &Del2RVortVertex) const {
-
-      const I4 KStart = KChunk * VecLength;
+   template <int W = VecLength>
+   KOKKOS_FUNCTION void
+   operator()(const Array2DAuxReal &Tend, I4 IEdge, I4 KChunk,
+              const Array2DAuxReal &Del2DivCell,
+              const Array2DAuxReal &Del2RVortVertex) const {
+
+      const I4 KStart = KChunk * W;
+      const I4 KLen   = chunkLength<W>(KStart, Tend);
       const I4 ICell0 = CellsOnEdge(IEdge, 0);
       const I4 ICell1 = CellsOnEdge(IEdge, 1);
 
@@ -250,16 +295,143 @@ class VelocityHyperDiffOnEdge {
       const Real DcEdgeInv = 1._Real / DcEdge(IEdge);
       const Real DvEdgeInv = 1._Real / DvEdge(IEdge);
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const I4 K = KStart + KVec;
-         const Real Del2U =
-             ((Del2DivCell(ICell1, K) - Del2DivCell(ICell0, K)) * DcEdgeInv -
-              (Del2RVortVertex(IVertex1, K) - Del2RVortVertex(IVertex0, K)) *
-                  DvEdgeInv);
+      const Real Coeff = ViscDel4 * MeshScalingDel4(IEdge);
 
-         Tend(IEdge, K) -=
-             EdgeMask(IEdge, K) * ViscDel4 * MeshScalingDel4(IEdge) * Del2U;
-      }
+      const RealPack<W> Del2U =
+          (loadPack<W>(Del2DivCell, KStart, KLen, ICell1) -
+           loadPack<W>(Del2DivCell, KStart, KLen, ICell0)) *
+              DcEdgeInv -
+          (loadPack<W>(Del2RVortVertex, KStart, KLen, IVertex1) -
+           loadPack<W>(Del2RVortVertex, KStart, KLen, IVertex0)) *
+              DvEdgeInv;
+
+      storePack(Tend,
+                loadPack<W>(Tend, KStart, KLen, IEdge) -
+                    Coeff * loadPack<W>(EdgeMask, KStart, KLen, IEdge) * Del2U,
+                KStart, KLen, IEdge);
+   }
+
+   /// Fused variant for one edge, called by all threads of a team. Instead of
+   /// reading the laplacians precomputed by the auxiliary state, the team
+   /// computes the laplacian of the velocity on the edges of the two cells of
+   /// the edge into Del2Patch, with at least 2 * MaxEdges rows and
+   /// NChunks * W columns, and then applies the second laplacian. The
+   /// operations are the same as those of the auxiliary variables and of the
+   /// unfused functor.
+   template <int W = VecLength>
+   KOKKOS_FUNCTION void
+   computeOnPatch(const TeamMember &Member, const PatchScratchArray &Del2Patch,
+                  const Array2DAuxReal &Tend, I4 IEdge, I4 NChunks,
+                  const VelocityDel2AuxVars &Del2Aux,
+                  const Array2DAuxReal &VelocityDivCell,
+                  const Array2DAuxReal &RelVortVertex) const {
+
+      const I4 ICell0  = CellsOnEdge(IEdge, 0);
+      const I4 ICell1  = CellsOnEdge(IEdge, 1);
+      const I4 Start0  = OffsetsOnCell(ICell0);
+      const I4 Start1  = OffsetsOnCell(ICell1);
+      const I4 NEdges0 = OffsetsOnCell(ICell0 + 1) - Start0;
+      const I4 NEdges1 = OffsetsOnCell(ICell1 + 1) - Start1;
+      const I4 NSlots  = NEdges0 + NEdges1;
+
+      // The patch holds the edges of the first cell followed by the edges of
+      // the second cell
+      const auto SlotEdge = [&](I4 Slot) -> I4 {
+         return Slot < NEdges0 ? EdgesOnCellCSR(Start0 + Slot)
+                               : EdgesOnCellCSR(Start1 + Slot - NEdges0);
+      };
+
+      // Laplacian of the velocity on an edge, zero on the inactive chunks and
+      // on the boundary dummy edge like the stored auxiliary variable
+      const auto Del2OnEdge = [&](I4 JEdge, I4 KChunk) {
+         const I4 KStart = KChunk * W;
+         const I4 KLen   = chunkLength<W>(KStart, Tend);
+         RealPack<W> Del2;
+         if (JEdge < NEdgesAll &&
+             isActiveChunk<W>(KChunk, MinLevelEdge(JEdge), MaxLevelEdge(JEdge)))
+            Del2 = Del2Aux.del2OnEdge<W>(JEdge, KStart, KLen, VelocityDivCell,
+                                         RelVortVertex);
+         return Del2;
+      };
+
+      Kokkos::parallel_for(
+          Kokkos::TeamThreadRange(Member, NSlots * NChunks), [&](I4 I) {
+             const I4 Slot   = I / NChunks;
+             const I4 KChunk = I % NChunks;
+             const I4 KStart = KChunk * W;
+             const I4 KLen   = chunkLength<W>(KStart, Tend);
+             storePack(Del2Patch, Del2OnEdge(SlotEdge(Slot), KChunk), KStart,
+                       KLen, Slot);
+          });
+      Member.team_barrier();
+
+      const I4 IVertex0 = VerticesOnEdge(IEdge, 0);
+      const I4 IVertex1 = VerticesOnEdge(IEdge, 1);
+
+      const Real DcEdgeInv = 1._Real / DcEdge(IEdge);
+      const Real DvEdgeInv = 1._Real / DvEdge(IEdge);
+
+      const Real Coeff = ViscDel4 * MeshScalingDel4(IEdge);
+
+      Kokkos::parallel_for(
+          Kokkos::TeamThreadRange(Member, NChunks), [&](I4 KChunk) {
+             if (!isActiveChunk<W>(KChunk, MinLevelEdge(IEdge),
+                                   MaxLevelEdge(IEdge)))
+                return;
+             const I4 KStart = KChunk * W;
+             const I4 KLen   = chunkLength<W>(KStart, Tend);
+
+             // Laplacian of the divergence at a cell from its edges, stored
+             // from slot SlotStart of the patch
+             const auto Del2Div = [&](I4 ICell, I4 Start, I4 SlotStart,
+                                      I4 NEdges) {
+                RealPack<W> Del2DivTmp;
+                if (!isActiveChunk<W>(KChunk, MinLevelCell(ICell),
+                                      MaxLevelCell(ICell)))
+                   return Del2DivTmp;
+                for (int J = 0; J < NEdges; ++J) {
+                   Del2DivTmp -=
+                       DivWeightsOnCellCSR(Start + J) *
+                       loadPack<W>(Del2Patch, KStart, KLen, SlotStart + J);
+                }
+                return roundToAux<W>(Del2DivTmp);
+             };
+
+             // Laplacian of the vorticity at a vertex. The edges of a vertex
+             // of the edge are edges of its cells, except next to a boundary
+             // where a missing edge is computed directly.
+             const auto Del2Vort = [&](I4 IVertex) {
+                RealPack<W> Del2VortTmp;
+                if (IVertex >= NVerticesAll ||
+                    !isActiveChunk<W>(KChunk, MinLevelVertex(IVertex),
+                                      MaxLevelVertex(IVertex)))
+                   return Del2VortTmp;
+                for (int J = 0; J < VertexDegree; ++J) {
+                   const I4 JEdge = EdgesOnVertex(IVertex, J);
+                   I4 Slot        = 0;
+                   while (Slot < NSlots && SlotEdge(Slot) != JEdge)
+                      ++Slot;
+                   const RealPack<W> Del2 =
+                       Slot < NSlots
+                           ? loadPack<W>(Del2Patch, KStart, KLen, Slot)
+                           : roundToAux<W>(Del2OnEdge(JEdge, KChunk));
+                   Del2VortTmp += CurlWeightsOnVertex(IVertex, J) * Del2;
+                }
+                return roundToAux<W>(Del2VortTmp);
+             };
+
+             const RealPack<W> Del2U =
+                 (Del2Div(ICell1, Start1, NEdges0, NEdges1) -
+                  Del2Div(ICell0, Start0, 0, NEdges0)) *
+                     DcEdgeInv -
+                 (Del2Vort(IVertex1) - Del2Vort(IVertex0)) * DvEdgeInv;
+
+             storePack(Tend,
+                       loadPack<W>(Tend, KStart, KLen, IEdge) -
+                           Coeff * loadPack<W>(EdgeMask, KStart, KLen, IEdge) *
+                               Del2U,
+                       KStart, KLen, IEdge);
+          });
    }
 
  private:
@@ -269,6 +441,22 @@ class VelocityHyperDiffOnEdge {
    Array1DR8 DvEdge;
    Array1DR8 MeshScalingDel4;
    Array2DR8 EdgeMask;
+
+   // Connectivity and active levels used by the fused variant
+   Array1DI4 OffsetsOnCell;
+   Array1DI4 EdgesOnCellCSR;
+   Array1DR8 DivWeightsOnCellCSR;
+   Array2DI4 EdgesOnVertex;
+   Array2DR8 CurlWeightsOnVertex;
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
+   Array1DI4 MinLevelEdge;
+   Array1DI4 MaxLevelEdge;
+   Array1DI4 MinLevelVertex;
+   Array1DI4 MaxLevelVertex;
+   I4 VertexDegree;
+   I4 NEdgesAll;
+   I4 NVerticesAll;
 };
 
 // Tracer horizontal advection term
@@ -278,38 +466,33 @@ class TracerHorzAdvOnCell {
 
    TracerHorzAdvOnCell(const HorzMesh *Mesh);
 
-   KOKKOS_FUNCTION void operator()(const Array3DReal &Tend, I4 L, I4 ICell,
+   template <int W = VecLength>
+   KOKKOS_FUNCTION void operator()(const Array3DAuxReal &Tend, I4 L, I4 ICell,
                                    I4 KChunk, const Array2DR8 &NormVelEdge,
-                                   const Array3DR8 &HTracersOnEdge) const {
+                                   const Array3DAuxReal &HTracersOnEdge) const {
 
-      const I4 KStart        = KChunk * VecLength;
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
+      const I4 KStart = KChunk * W;
+      const I4 KLen   = chunkLength<W>(KStart, Tend);
 
-      Real HAdvTmp[VecLength] = {0};
+      RealPack<W> HAdvTmp;
 
-      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
-         const I4 JEdge = EdgesOnCell(ICell, J);
+      for (int J = OffsetsOnCell(ICell); J < OffsetsOnCell(ICell + 1); ++J) {
+         const I4 JEdge    = EdgesOnCellCSR(J);
+         const Real DivWgt = DivWeightsOnCellCSR(J);
 
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const I4 K = KStart + KVec;
-            HAdvTmp[KVec] -= DvEdge(JEdge) * EdgeSignOnCell(ICell, J) *
-                             HTracersOnEdge(L, JEdge, K) *
-                             NormVelEdge(JEdge, K) * InvAreaCell;
-         }
-      }
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const I4 K = KStart + KVec;
-         Tend(L, ICell, K) -= HAdvTmp[KVec];
+         HAdvTmp -= DivWgt *
+                    loadPack<W>(HTracersOnEdge, KStart, KLen, L, JEdge) *
+                    loadPack<W>(NormVelEdge, KStart, KLen, JEdge);
       }
+
+      storePack(Tend, loadPack<W>(Tend, KStart, KLen, L, ICell) - HAdvTmp,
+                KStart, KLen, L, ICell);
    }
 
  private:
-   Array1DI4 NEdgesOnCell;
-   Array2DI4 EdgesOnCell;
-   Array2DI4 CellsOnEdge;
-   Array2DR8 EdgeSignOnCell;
-   Array1DR8 DvEdge;
-   Array1DR8 AreaCell;
+   Array1DI4 OffsetsOnCell;
+   Array1DI4 EdgesOnCellCSR;
+   Array1DR8 DivWeightsOnCellCSR;
 };
 
 // Tracer horizontal diffusion term
@@ -321,48 +504,47 @@ class TracerDiffOnCell {
 
    TracerDiffOnCell(const HorzMesh *Mesh);
 
-   KOKKOS_FUNCTION void operator()(const Array3DReal &Tend, I4 L, I4 ICell,
-                                   I4 KChunk, const Array3DR8 &TracerCell,
-                                   const Array2DR8 &MeanLayerThickEdge) const {
+   /// The tracer array can be the array of all tracers or any array indexed
+   /// like it, eg the strided group arrays of a left-layout build, and the
+   /// mean edge thickness can be the stored array or its accessor
+   template <int W = VecLength, class TracerArrayType, class ThickArrayType>
+   KOKKOS_FUNCTION void
+   operator()(const Array3DAuxReal &Tend, I4 L, I4 ICell, I4 KChunk,
+              const TracerArrayType &TracerCell,
+              const ThickArrayType &MeanLayerThickEdge) const {
 
-      const I4 KStart        = KChunk * VecLength;
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
+      const I4 KStart = KChunk * W;
+      const I4 KLen   = chunkLength<W>(KStart, Tend);
 
-      Real DiffTmp[VecLength] = {0};
+      RealPack<W> DiffTmp;
 
-      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
-         const I4 JEdge = EdgesOnCell(ICell, J);
+      for (int J = OffsetsOnCell(ICell); J < OffsetsOnCell(ICell + 1); ++J) {
+         const I4 JEdge = EdgesOnCellCSR(J);
 
          const I4 JCell0 = CellsOnEdge(JEdge, 0);
          const I4 JCell1 = CellsOnEdge(JEdge, 1);
 
-         const Real RTemp =
-             MeshScalingDel2(JEdge) * DvEdge(JEdge) / DcEdge(JEdge);
+         const Real Del2Wgt = Del2WeightsOnCellCSR(J);
 
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const I4 K = KStart + KVec;
-            const Real TracerGrad =
-                (TracerCell(L, JCell1, K) - TracerCell(L, JCell0, K));
+         const RealPack<W> TracerGrad =
+             loadPack<W>(TracerCell, KStart, KLen, L, JCell1) -
+             loadPack<W>(TracerCell, KStart, KLen, L, JCell0);
 
-            DiffTmp[KVec] -= EdgeSignOnCell(ICell, J) * RTemp *
-                             MeanLayerThickEdge(JEdge, K) * TracerGrad;
-         }
-      }
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const I4 K = KStart + KVec;
-         Tend(L, ICell, K) += EddyDiff2 * DiffTmp[KVec] * InvAreaCell;
+         DiffTmp -= Del2Wgt *
+                    loadPack<W>(MeanLayerThickEdge, KStart, KLen, JEdge) *
+                    TracerGrad;
       }
+
+      storePack(Tend,
+                loadPack<W>(Tend, KStart, KLen, L, ICell) + EddyDiff2 * DiffTmp,
+                KStart, KLen, L, ICell);
    }
 
  private:
-   Array1DI4 NEdgesOnCell;
-   Array2DI4 EdgesOnCell;
+   Array1DI4 OffsetsOnCell;
+   Array1DI4 EdgesOnCellCSR;
    Array2DI4 CellsOnEdge;
-   Array2DR8 EdgeSignOnCell;
-   Array1DR8 DvEdge;
-   Array1DR8 DcEdge;
-   Array1DR8 AreaCell;
-   Array1DR8 MeshScalingDel2;
+   Array1DR8 Del2WeightsOnCellCSR;
 };
 
 // Tracer biharmonic horizontal mixing term
@@ -374,47 +556,276 @@ class TracerHyperDiffOnCell {
 
    TracerHyperDiffOnCell(const HorzMesh *Mesh);
 
-   KOKKOS_FUNCTION void operator()(const Array3DReal &Tend, I4 L, I4 ICell,
+   template <int W = VecLength>
+   KOKKOS_FUNCTION void operator()(const Array3DAuxReal &Tend, I4 L, I4 ICell,
                                    I4 KChunk,
-                                   const Array3DR8 &TrDel2Cell) const {
+                                   const Array3DAuxReal &TrDel2Cell) const {
 
-      const I4 KStart        = KChunk * VecLength;
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
+      const I4 KStart = KChunk * W;
+      const I4 KLen   = chunkLength<W>(KStart, Tend);
 
-      Real HypTmp[VecLength] = {0};
+      RealPack<W> HypTmp;
 
-      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
-         const I4 JEdge = EdgesOnCell(ICell, J);
+      for (int J = OffsetsOnCell(ICell); J < OffsetsOnCell(ICell + 1); ++J) {
+         const I4 JEdge = EdgesOnCellCSR(J);
 
          const I4 JCell0 = CellsOnEdge(JEdge, 0);
          const I4 JCell1 = CellsOnEdge(JEdge, 1);
 
-         const Real RTemp =
-             MeshScalingDel4(JEdge) * DvEdge(JEdge) / DcEdge(JEdge);
+         const Real Del4Wgt = Del4WeightsOnCellCSR(J);
 
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const I4 K = KStart + KVec;
-            const Real Del2TrGrad =
-                (TrDel2Cell(L, JCell1, K) - TrDel2Cell(L, JCell0, K));
+         HypTmp -= Del4Wgt * (loadPack<W>(TrDel2Cell, KStart, KLen, L, JCell1) -
+                              loadPack<W>(TrDel2Cell, KStart, KLen, L, JCell0));
+      }
 
-            HypTmp[KVec] -= EdgeSignOnCell(ICell, J) * RTemp * Del2TrGrad;
-         }
+      storePack(Tend,
+                loadPack<W>(Tend, KStart, KLen, L, ICell) - EddyDiff4 * HypTmp,
+                KStart, KLen, L, ICell);
+   }
+
+   /// Fused variant for one tracer and cell, called by all threads of a team.
+   /// Instead of reading the laplacian precomputed by the auxiliary state,
+   /// the team computes the laplacian of the tracer on the cell and on its
+   /// neighbors across each of its edges into Del2Patch, with at least
+   /// MaxEdges + 1 rows and NChunks * W columns, and then applies the second
+   /// laplacian. The operations are the same as those of the auxiliary
+   /// variables and of the unfused functor.
+   template <int W = VecLength, class ThickArrayType>
+   KOKKOS_FUNCTION void
+   computeOnPatch(const TeamMember &Member, const PatchScratchArray &Del2Patch,
+                  const Array3DAuxReal &Tend, I4 L, I4 ICell, I4 NChunks,
+                  const TracerAuxVars &TracerAux,
+                  const ThickArrayType &MeanLayerThickEdge,
+                  const Array3DReal &TrCell) const {
+
+      const I4 Start  = OffsetsOnCell(ICell);
+      const I4 NEdges = OffsetsOnCell(ICell + 1) - Start;
+
+      // The patch holds the cell followed by its neighbors across its edges
+      const auto SlotCell = [&](I4 Slot) -> I4 {
+         if (Slot == 0)
+            return ICell;
+         const I4 JEdge = EdgesOnCellCSR(Start + Slot - 1);
+         return CellsOnEdge(JEdge, 0) == ICell ? CellsOnEdge(JEdge, 1)
+                                               : CellsOnEdge(JEdge, 0);
+      };
+
+      // The laplacian is zero on the inactive chunks and on the boundary
+      // dummy cell like the stored auxiliary variable
+      Kokkos::parallel_for(
+          Kokkos::TeamThreadRange(Member, (NEdges + 1) * NChunks), [&](I4 I) {
+             const I4 Slot   = I / NChunks;
+             const I4 KChunk = I % NChunks;
+             const I4 KStart = KChunk * W;
+             const I4 KLen   = chunkLength<W>(KStart, Tend);
+             const I4 JCell  = SlotCell(Slot);
+             RealPack<W> Del2;
+             if (JCell < NCellsAll &&
+                 isActiveChunk<W>(KChunk, MinLevelCell(JCell),
+                                  MaxLevelCell(JCell)))
+                Del2 = TracerAux.del2OnCell<W>(
+                    L, JCell, KStart, KLen, MeanLayerThickEdge, TrCell);
+             storePack(Del2Patch, Del2, KStart, KLen, Slot);
+          });
+      Member.team_barrier();
+
+      Kokkos::parallel_for(
+          Kokkos::TeamThreadRange(Member, NChunks), [&](I4 KChunk) {
+             if (!isActiveChunk<W>(KChunk, MinLevelCell(ICell),
+                                   MaxLevelCell(ICell)))
+                return;
+             const I4 KStart = KChunk * W;
+             const I4 KLen   = chunkLength<W>(KStart, Tend);
+
+             const RealPack<W> Del2Self =
+                 loadPack<W>(Del2Patch, KStart, KLen, 0);
+
+             RealPack<W> HypTmp;
+
+             for (int J = 0; J < NEdges; ++J) {
+                const I4 JEdge = EdgesOnCellCSR(Start + J);
+
+                const RealPack<W> Del2Nbr =
+                    loadPack<W>(Del2Patch, KStart, KLen, J + 1);
+                const bool First = CellsOnEdge(JEdge, 0) == ICell;
+
+                const Real Del4Wgt = Del4WeightsOnCellCSR(Start + J);
+
+                HypTmp -= Del4Wgt * (First ? Del2Nbr - Del2Self
+                                           : Del2Self - Del2Nbr);
+             }
+
+             storePack(Tend,
+                       loadPack<W>(Tend, KStart, KLen, L, ICell) -
+                           EddyDiff4 * HypTmp,
+                       KStart, KLen, L, ICell);
+          });
+   }
+
+ private:
+   Array1DI4 OffsetsOnCell;
+   Array1DI4 EdgesOnCellCSR;
+   Array2DI4 CellsOnEdge;
+   Array1DR8 Del4WeightsOnCellCSR;
+
+   // Active levels used by the fused variant
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
+   I4 NCellsAll;
+};
+
+/// Vertical velocity through the top of each layer for a z-star vertical
+/// coordinate, diagnosed from the divergence of the thickness flux. The
+/// change of the column thickness is distributed over the layers in
+/// proportion to their thickness, which gives the z-star target thickness
+/// tendency, and the vertical velocity is the residual of the layer
+/// continuity equation integrated upward from the bottom of the column.
+class VertVelocityOnCell {
+ public:
+   bool Enabled;
+
+   VertVelocityOnCell(const HorzMesh *Mesh);
+
+   /// The functor sweeps the whole column of a cell. On input ThickTend holds
+   /// the thickness flux divergence of each layer and on output the target
+   /// thickness tendency. VertVelTop has one more level than ThickTend, with
+   /// zero velocity at the surface and at the sea floor.
+   KOKKOS_FUNCTION void operator()(const Array2DAuxReal &VertVelTop,
+                                   const Array2DAuxReal &ThickTend, I4 ICell,
+                                   const Array2DReal &LayerThickCell) const {
+
+      const I4 KMin        = MinLevelCell(ICell);
+      const I4 KMax        = MaxLevelCell(ICell);
+      const I4 NInterfaces = VertVelTop.extent_int(1);
+
+      Real ColThick = 0;
+      Real ColDiv   = 0;
+      for (int K = KMin; K <= KMax; ++K) {
+         ColThick += LayerThickCell(ICell, K);
+         ColDiv += ThickTend(ICell, K);
+      }
+      const Real ColRate = ColThick > 0 ? ColDiv / ColThick : 0;
+
+      for (int K = 0; K < KMin; ++K) {
+         VertVelTop(ICell, K) = 0;
+      }
+      for (int K = KMax + 1; K < NInterfaces; ++K) {
+         VertVelTop(ICell, K) = 0;
+      }
+
+      Real VertVel = 0;
+      for (int K = KMax; K >= KMin; --K) {
+         const Real TargetTend = ColRate * LayerThickCell(ICell, K);
+         VertVel += ThickTend(ICell, K) - TargetTend;
+         VertVelTop(ICell, K) = VertVel;
+         ThickTend(ICell, K)  = TargetTend;
+      }
+
+      // the surface value is the round-off residual of the column sum
+      if (KMax >= KMin) {
+         VertVelTop(ICell, KMin) = 0;
       }
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const I4 K = KStart + KVec;
-         Tend(L, ICell, K) -= EddyDiff4 * HypTmp[KVec] * InvAreaCell;
+   }
+
+ private:
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
+};
+
+/// Vertical advection of normal velocity, for momentum equation. The
+/// vertical velocity at an edge is the mean of the vertical velocities of
+/// the cells on the edge.
+class VelocityVertAdvOnEdge {
+ public:
+   bool Enabled;
+
+   VelocityVertAdvOnEdge(const HorzMesh *Mesh);
+
+   /// The functor sweeps the whole column of an edge and adds the vertical
+   /// advection to the tendency array. The mean edge thickness can be the
+   /// stored array or its accessor.
+   template <class ThickArrayType>
+   KOKKOS_FUNCTION void
+   operator()(const Array2DAuxReal &Tend, I4 IEdge,
+              const Array2DAuxReal &VertVelTop,
+              const Array2DReal &NormalVelEdge,
+              const ThickArrayType &MeanLayerThickEdge) const {
+
+      const I4 KMin   = MinLevelEdge(IEdge);
+      const I4 KMax   = MaxLevelEdge(IEdge);
+      const I4 JCell0 = CellsOnEdge(IEdge, 0);
+      const I4 JCell1 = CellsOnEdge(IEdge, 1);
+
+      // w du/dz at the top and bottom interfaces of each layer
+      Real WDuTop = 0;
+      for (int K = KMin; K <= KMax; ++K) {
+         Real WDuBot = 0;
+         if (K < KMax) {
+            const Real VertVelEdge =
+                0.5_Real * (VertVelTop(JCell0, K + 1) +
+                            VertVelTop(JCell1, K + 1));
+            WDuBot = VertVelEdge *
+                     (NormalVelEdge(IEdge, K) - NormalVelEdge(IEdge, K + 1));
+         }
+         Tend(IEdge, K) -=
+             0.5_Real * (WDuTop + WDuBot) / MeanLayerThickEdge(IEdge, K);
+         WDuTop = WDuBot;
       }
    }
 
  private:
-   Array1DI4 NEdgesOnCell;
-   Array2DI4 EdgesOnCell;
    Array2DI4 CellsOnEdge;
-   Array2DR8 EdgeSignOnCell;
-   Array1DR8 DvEdge;
-   Array1DR8 DcEdge;
-   Array1DR8 AreaCell;
-   Array1DR8 MeshScalingDel4;
+   Array1DI4 MinLevelEdge;
+   Array1DI4 MaxLevelEdge;
+};
+
+/// Vertical advection of thickness-weighted tracers with the tracers at the
+/// layer interfaces interpolated as the mean of the adjacent layers
+class TracerVertAdvOnCell {
+ public:
+   bool Enabled;
+
+   TracerVertAdvOnCell(const HorzMesh *Mesh);
+
+   /// The functor sweeps the whole column of a cell for tracer L and adds the
+   /// vertical flux divergence to the tendency array. The tracer array can
+   /// be any array indexed like the array of all tracers.
+   template <class TracerArrayType>
+   KOKKOS_FUNCTION void operator()(const Array3DAuxReal &Tend, I4 L, I4 ICell,
+                                   const Array2DAuxReal &VertVelTop,
+                                   const TracerArrayType &TracerCell) const {
+
+      const I4 KMin = MinLevelCell(ICell);
+      const I4 KMax = MaxLevelCell(ICell);
+
+      // tracer fluxes through the top and bottom interfaces of each layer
+      Real FluxTop = 0;
+      for (int K = KMin; K <= KMax; ++K) {
+         Real FluxBot = 0;
+         if (K < KMax) {
+            FluxBot = VertVelTop(ICell, K + 1) * 0.5_Real *
+                      (TracerCell(L, ICell, K) + TracerCell(L, ICell, K + 1));
+         }
+         Tend(L, ICell, K) -= FluxTop - FluxBot;
+         FluxTop = FluxBot;
+      }
+   }
+
+ private:
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
+};
+
+/// Bits identifying each tendency term in a mask of enabled terms, used to
+/// select tendency kernels specialized at compile time for the enabled terms
+enum TendencyTermBit {
+   TendThickFluxBit = 1 << 0, ///< thickness flux divergence
+   TendPVBit        = 1 << 1, ///< potential vorticity horizontal advection
+   TendKEGradBit    = 1 << 2, ///< kinetic energy gradient
+   TendSSHGradBit   = 1 << 3, ///< sea surface height gradient
+   TendDel2Bit      = 1 << 4, ///< del2 velocity diffusion
+   TendDel4Bit      = 1 << 5, ///< del4 velocity hyperdiffusion
+   TendVertAdvBit   = 1 << 6  ///< vertical velocity and advection
 };
 
 /// A class that can be used to calculate the thickness and
@@ -422,11 +833,21 @@ class TracerHyperDiffOnCell {
 class Tendencies {
  public:
    using CustomTendencyType =
-       std::function<void(Array2DReal, const OceanState *,
+       std::function<void(Array2DAuxReal, const OceanState *,
                           const AuxiliaryState *, int, int, TimeInstant)>;
    // Arrays for accumulating tendencies
-   Array2DReal LayerThicknessTend;
-   Array2DReal NormalVelocityTend;
+   Array2DAuxReal LayerThicknessTend;
+   Array2DAuxReal NormalVelocityTend;
+
+   // Array for the tendencies of the thickness-weighted tracers, allocated
+   // by computeTracerTendencies with the size of the input tracer array
+   Array3DAuxReal TracerTend;
+
+   // Ranges (first tracer, number of tracers) of the tracers whose
+   // tendencies are computed when all tracers of an array are requested, or
+   // empty for all tracers. The tendencies of the other tracers stay zero,
+   // so the time steppers hold their thickness-weighted values.
+   std::vector<std::pair<I4, I4>> StepTracerRanges;
 
    // Instances of tendency terms
    ThicknessFluxDivOnCell ThicknessFluxDiv;
@@ -435,6 +856,39 @@ class Tendencies {
    SSHGradOnEdge SSHGrad;
    VelocityDiffusionOnEdge VelocityDiffusion;
    VelocityHyperDiffOnEdge VelocityHyperDiff;
+   TracerHorzAdvOnCell TracerHorzAdv;
+   TracerDiffOnCell TracerDiffusion;
+   TracerHyperDiffOnCell TracerHyperDiff;
+   VertVelocityOnCell VertVelocity;
+   VelocityVertAdvOnEdge VelocityVertAdv;
+   TracerVertAdvOnCell TracerVertAdv;
+
+   // Vertical velocity through the top of each layer, with dimensions
+   // [Cell, NVertLevels + 1], diagnosed with the thickness tendencies when
+   // vertical advection is enabled and used by the velocity and tracer
+   // vertical advection
+   Array2DAuxReal VertVelocityTop;
+
+   // Flag to compute all enabled velocity tendency terms in a single kernel
+   bool FusedVelocityTend = false;
+
+   // Flag to compute the del4 diffusion of the velocity and of the tracers
+   // with team kernels that compute the intermediate laplacian on mesh
+   // patches in scratch memory, instead of storing it in the auxiliary state
+   bool FusedHyperDiff = false;
+
+   // Flag to use kernels specialized for the enabled terms in
+   // computeAllTendencies when the terms match a common configuration
+   bool SpecializedTend = true;
+
+   // Flag to launch the kernels with one team per mesh element and the
+   // vertical chunks of the element over the vector lanes of the team
+   bool OuterInnerLoops = false;
+
+   // Flag to compute the velocity tendencies only on the edges with at least
+   // one unmasked level, iterating over the compacted ActiveEdges list of the
+   // mesh. The tendency of the other edges is zero.
+   bool CompactMaskedEdges = false;
 
    // Methods to compute tendency groups
    void computeThicknessTendencies(const OceanState *State,
@@ -449,6 +903,34 @@ class Tendencies {
                              const AuxiliaryState *AuxState, int ThickTimeLevel,
                              int VelTimeLevel, TimeInstant Time);
 
+   // Compute the tracer auxiliary variables and the tendencies of the
+   // thickness-weighted tracers TracerStart to TracerStart + NTracersBatch - 1
+   // of the input tracer array. All tracers of the batch are computed by the
+   // same kernel launches. Assumes the layer thickness auxiliary variables of
+   // the state have already been computed, for example by
+   // computeAllTendencies or computeThicknessTendencies.
+   void computeTracerTendencies(const OceanState *State,
+                                const AuxiliaryState *AuxState,
+                                const Array3DReal &TracerArray,
+                                int ThickTimeLevel, int VelTimeLevel,
+                                TimeInstant Time, I4 TracerStart,
+                                I4 NTracersBatch);
+   // Compute the tendencies of all tracers in the input array as one batch,
+   // or of the tracers in StepTracerRanges with one batch per range
+   void computeTracerTendencies(const OceanState *State,
+                                const AuxiliaryState *AuxState,
+                                const Array3DReal &TracerArray,
+                                int ThickTimeLevel, int VelTimeLevel,
+                                TimeInstant Time);
+   // Compute the tendencies of the tracers in the named tracer group as one
+   // batch
+   int computeTracerTendencies(const OceanState *State,
+                               const AuxiliaryState *AuxState,
+                               const Array3DReal &TracerArray,
+                               const std::string &GroupName,
+                               int ThickTimeLevel, int VelTimeLevel,
+                               TimeInstant Time);
+
    void computeThicknessTendenciesOnly(const OceanState *State,
                                        const AuxiliaryState *AuxState,
                                        int ThickTimeLevel, int VelTimeLevel,
@@ -458,6 +940,36 @@ class Tendencies {
                                       int ThickTimeLevel, int VelTimeLevel,
                                       TimeInstant Time);
 
+   // Compute the velocity tendency terms with a single kernel over vertical
+   // chunks of width W. The remaining template parameters select the enabled
+   // terms at compile time, in the order potential vorticity, kinetic energy
+   // gradient, SSH gradient, del2 and del4 diffusion.
+   template <int W, bool PVEnabled, bool KEEnabled, bool SSHEnabled,
+             bool Del2Enabled, bool Del4Enabled>
+   void computeVelocityTendenciesFused(const OceanState *State,
+                                       const AuxiliaryState *AuxState,
+                                       int VelTimeLevel);
+
+   // Compute the auxiliary state and all tendencies over vertical chunks of
+   // width W with the terms in the mask of TendencyTermBit values enabled at
+   // compile time. Terms that are not in the mask are compiled out.
+   template <int W, I4 TermMask>
+   void computeAllTendenciesSpecialized(const OceanState *State,
+                                        const AuxiliaryState *AuxState,
+                                        int ThickTimeLevel, int VelTimeLevel,
+                                        TimeInstant Time);
+
+   // Mask of TendencyTermBit values for the currently enabled terms
+   I4 getEnabledTermMask() const;
+
+   // Width of the vertical chunks used by the tendency kernels
+   I4 getVecWidth() const;
+
+   // Restrict the computation of the tendencies to the owned elements and
+   // the first HaloDepth halo layers, or compute on all elements including
+   // the full halo if HaloDepth is FullHalo
+   void setComputeHaloDepth(I4 HaloDepth);
+
    // Create a non-default group of tendencies
    template <class... ArgTypes>
    static Tendencies *create(const std::string &Name, ArgTypes &&...Args) {
@@ -503,6 +1015,22 @@ class Tendencies {
    // read and set config options
    int readTendConfig(Config *TendConfig);
 
+   // Number of cell halo layers in which the state becomes invalid with one
+   // evaluation of the tendencies, determined by the widest stencil among the
+   // enabled terms and the tracer edge reconstruction of AuxState. Returns 0
+   // if the depth is unknown (custom tendencies), in which case the full halo
+   // should be exchanged.
+   I4 getStencilHaloDepth(const AuxiliaryState *AuxState) const;
+
+   // True if custom tendencies are set. They receive the time of each
+   // evaluation, unlike the other terms, which only depend on the state.
+   bool hasCustomTendencies() const;
+
+   // Mask of AuxVarBit values of the optional auxiliary variables used by the
+   // enabled terms. All variables are needed with custom tendencies, whose
+   // inputs are unknown.
+   I4 getNeededAuxVars() const;
+
  private:
    // Construct a new tendency object
    Tendencies(const std::string &Name, ///< [in] Name for tendencies
@@ -522,11 +1050,81 @@ class Tendencies {
    Tendencies(const Tendencies &) = delete;
    Tendencies(Tendencies &&)      = delete;
 
-   // Mesh sizes
+   // Implementations of the public compute methods for vertical chunks of
+   // width W, called with the runtime chunk width VecWidth
+   template <int W>
+   void computeThicknessTendenciesChunked(const OceanState *State,
+                                          const AuxiliaryState *AuxState,
+                                          int ThickTimeLevel, int VelTimeLevel,
+                                          TimeInstant Time);
+   template <int W>
+   void computeVelocityTendenciesChunked(const OceanState *State,
+                                         const AuxiliaryState *AuxState,
+                                         int ThickTimeLevel, int VelTimeLevel,
+                                         TimeInstant Time);
+   template <int W>
+   void computeAllTendenciesChunked(const OceanState *State,
+                                    const AuxiliaryState *AuxState,
+                                    int ThickTimeLevel, int VelTimeLevel,
+                                    TimeInstant Time);
+   template <int W>
+   void computeTracerTendenciesChunked(const OceanState *State,
+                                       const AuxiliaryState *AuxState,
+                                       const Array3DReal &TracerArray,
+                                       int VelTimeLevel, I4 TracerStart,
+                                       I4 NTracersBatch);
+   template <int W>
+   void computeLayerThickAuxChunked(const OceanState *State,
+                                    const AuxiliaryState *AuxState,
+                                    int ThickTimeLevel, int VelTimeLevel);
+
+   // Convert the runtime enabled flags of the velocity tendency terms, one
+   // at a time, into template parameters and call the fused kernel
+   template <int W, bool... Flags>
+   void dispatchVelocityTendenciesFused(const OceanState *State,
+                                        const AuxiliaryState *AuxState,
+                                        int VelTimeLevel);
+   template <int W, bool... Flags, class... BoolTypes>
+   void dispatchVelocityTendenciesFused(const OceanState *State,
+                                        const AuxiliaryState *AuxState,
+                                        int VelTimeLevel, bool Enabled,
+                                        BoolTypes... RestEnabled);
+
+   // Add the del4 diffusion of the normal velocity with the fused kernel
+   // over vertical chunks of width W if FusedHyperDiff is set
+   template <int W>
+   void computeVelocityHyperDiffFused(const AuxiliaryState *AuxState);
+
+   // Add the vertical advection to the normal velocity tendencies, using the
+   // vertical velocity from the last thickness tendency computation
+   void computeVelocityVertAdv(const OceanState *State,
+                               const AuxiliaryState *AuxState,
+                               int VelTimeLevel);
+
+   // Horizontal mesh
+   const HorzMesh *Mesh;
+
+   // Mesh sizes, the number of cells and edges on which the tendencies are
+   // computed is reduced by setComputeHaloDepth
    I4 NCellsAll; ///< Number of cells including full halo
    I4 NEdgesAll; ///< Number of edges including full halo
    I4 NChunks;   ///< Number of vertical level chunks
 
+   // Compacted list of the active edges and their number among the first
+   // NEdgesAll edges, used when CompactMaskedEdges is set
+   Array1DI4 ActiveEdges;
+   I4 NActiveEdges;
+
+   // Active vertical levels of the cells and edges, used to skip the
+   // vertical chunks below the sea floor
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
+   Array1DI4 MinLevelEdge;
+   Array1DI4 MaxLevelEdge;
+
+   // Width of the vertical chunks, selected from the number of levels
+   I4 VecWidth;
+
    // Pointer to default tendencies
    static Tendencies *DefaultTendencies;
 
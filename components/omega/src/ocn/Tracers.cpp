@@ -11,8 +11,11 @@
 #include "Decomp.h"
 #include "IO.h"
 #include "Logging.h"
+#include "OmegaKokkos.h"
 #include "TimeStepper.h"
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 
 namespace OMEGA {
@@ -20,8 +23,10 @@ namespace OMEGA {
 // Initialize static member variables
 std::vector<Array3DReal> Tracers::TracerArrays;
 std::vector<HostArray3DReal> Tracers::TracerArraysH;
+bool Tracers::DeviceOnly = false;
 
 std::map<std::string, std::pair<I4, I4>> Tracers::TracerGroups;
+std::set<std::string> Tracers::ReducedGroups;
 std::map<std::string, I4> Tracers::TracerIndexes;
 std::map<I4, std::string> Tracers::TracerNames;
 std::vector<std::string> Tracers::TracerDimNames = {"NCells", "NVertLevels"};
@@ -69,8 +74,23 @@ I4 Tracers::init() {
 
    CurTimeIndex = 0;
 
-   // load Tracers configs
+   // The host arrays are allocated on demand if the state is device-only,
+   // which requires a device halo exchange
    Config *OmegaConfig = Config::getOmegaConfig();
+   DeviceOnly          = false;
+   if (OmegaConfig->existsGroup("State")) {
+      Config StateConfig("State");
+      Err = OmegaConfig->get(StateConfig);
+      if (Err == 0 and StateConfig.existsVar("DeviceOnly"))
+         Err = StateConfig.get("DeviceOnly", DeviceOnly);
+      if (Err != 0) {
+         LOG_ERROR("Tracers: error reading DeviceOnly from State Config");
+         return -3;
+      }
+   }
+   DeviceOnly = DeviceOnly and MeshHalo->isDeviceExchange();
+
+   // load Tracers configs
    Config TracersConfig("Tracers");
    Err = OmegaConfig->get(TracersConfig);
    if (Err != 0) {
@@ -95,12 +115,16 @@ I4 Tracers::init() {
       }
 
       std::vector<std::string> _TracerNames;
-      I4 TracerNamesErr = TracersConfig.get(GroupName, _TracerNames);
+      bool Reduced      = false;
+      I4 TracerNamesErr = readGroupConfig(TracersConfig, GroupName,
+                                          _TracerNames, Reduced);
       if (TracerNamesErr != 0) {
          LOG_ERROR("Tracers: {} group tracers not found in TracersConfig",
                    GroupName);
          return -5;
       }
+      if (Reduced)
+         ReducedGroups.insert(GroupName);
 
       for (auto _TracerName : _TracerNames) {
          TracerIndexes[_TracerName] = TracerIndex;
@@ -121,12 +145,11 @@ I4 Tracers::init() {
 
    // Allocate tracers data array and assign to tracers arrays
    for (I4 TimeIndex = 0; TimeIndex < NTimeLevels; ++TimeIndex) {
-      TracerArrays[TimeIndex] =
-          Array3DReal("TracerTime" + std::to_string(TimeIndex), NumTracers,
-                      NCellsSize, NVertLevels);
-      TracerArraysH[TimeIndex] =
-          HostArray3DReal("TracerHTime" + std::to_string(TimeIndex), NumTracers,
-                          NCellsSize, NVertLevels);
+      TracerArrays[TimeIndex] = createFirstTouchArray<Array3DReal>(
+          "TracerTime" + std::to_string(TimeIndex), NumTracers, NCellsSize,
+          NVertLevels);
+      if (!DeviceOnly)
+         allocateHostLevel(TimeIndex);
    }
 
    // Define tracers
@@ -145,7 +168,8 @@ I4 Tracers::init() {
       auto TracerFieldGroup            = FieldGroup::get(TracerFieldGroupName);
 
       std::vector<std::string> _TracerNames;
-      TracersConfig.get(GroupName, _TracerNames);
+      bool Reduced = false;
+      readGroupConfig(TracersConfig, GroupName, _TracerNames, Reduced);
 
       for (auto _TracerName : _TracerNames) {
          std::string TracerFieldName = _TracerName;
@@ -161,11 +185,16 @@ I4 Tracers::init() {
          // Associate Field with data
          I4 TracerIndex                     = TracerIndexes[_TracerName];
          std::shared_ptr<Field> TracerField = Field::get(TracerFieldName);
-
-         // Create a 2D subview by fixing the first dimension (TracerIndex)
-         Array2DReal TracerSubview = Kokkos::subview(
-             TracerArrays[CurTimeIndex], TracerIndex, Kokkos::ALL, Kokkos::ALL);
-         Err = TracerField->attachData<Array2DReal>(TracerSubview);
+         TracerField->setReducedPrecision(Reduced);
+
+         // Provide a 2D subview of the current time level by fixing the
+         // first dimension (TracerIndex). The subview is created when the
+         // field data is requested, so the field follows the time levels.
+         Err = TracerField->attachDataProvider<Array2DReal>([TracerIndex]() {
+            return Array2DReal(Kokkos::subview(TracerArrays[CurTimeIndex],
+                                               TracerIndex, Kokkos::ALL,
+                                               Kokkos::ALL));
+         });
          if (Err != 0) {
             LOG_ERROR("Error attaching data array to field {}",
                       TracerFieldName);
@@ -177,6 +206,48 @@ I4 Tracers::init() {
    return 0;
 }
 
+//---------------------------------------------------------------------------
+// Read the tracer names and output precision of a group. The group is
+// either a list of tracer names or a group with the list of Tracers and an
+// optional OutputPrecision (single or double, the default).
+//---------------------------------------------------------------------------
+I4 Tracers::readGroupConfig(Config &TracersConfig,
+                            const std::string &GroupName,
+                            std::vector<std::string> &GroupTracers,
+                            bool &Reduced) {
+
+   Reduced = false;
+   // A list is tested before querying it as a group, since a lookup by name
+   // would turn the list into a map
+   if (!TracersConfig.isMap(GroupName))
+      return TracersConfig.get(GroupName, GroupTracers);
+
+   Config GroupConfig(GroupName);
+   I4 Err = TracersConfig.get(GroupConfig);
+   if (Err == 0)
+      Err = GroupConfig.get("Tracers", GroupTracers);
+   if (Err != 0)
+      return Err;
+
+   if (GroupConfig.existsVar("OutputPrecision")) {
+      std::string Precision;
+      Err = GroupConfig.get("OutputPrecision", Precision);
+      if (Err != 0)
+         return Err;
+      std::transform(Precision.begin(), Precision.end(), Precision.begin(),
+                     [](unsigned char c) { return std::tolower(c); });
+      if (Precision == "single") {
+         Reduced = true;
+      } else if (Precision != "double") {
+         LOG_ERROR("Tracers: unknown output precision {} for group {}",
+                   Precision, GroupName);
+         return -1;
+      }
+   }
+
+   return 0;
+}
+
 //---------------------------------------------------------------------------
 // Define tracers
 //---------------------------------------------------------------------------
@@ -229,6 +300,7 @@ I4 Tracers::clear() {
    TracerArraysH.clear();
 
    TracerGroups.clear();
+   ReducedGroups.clear();
    TracerIndexes.clear();
    TracerNames.clear();
 
@@ -322,12 +394,38 @@ I4 Tracers::getByName(Array2DReal &TracerArray, const I4 TimeLevel,
    return 0;
 }
 
+I4 Tracers::getGroup(TracerGroupArray &GroupArray, const I4 TimeLevel,
+                     const std::string &GroupName) {
+   // Check if time level is valid
+   if (TimeLevel > 0 || (TimeLevel + NTimeLevels) <= 0) {
+      LOG_ERROR("Tracers: Time level {} is out of range", TimeLevel);
+      return -1;
+   }
+
+   // Check if group exists
+   auto It = TracerGroups.find(GroupName);
+   if (It == TracerGroups.end()) {
+      LOG_ERROR("Tracers: Tracer group '{}' does not exist", GroupName);
+      return -2;
+   }
+
+   auto [StartIndex, GroupLength] = It->second;
+
+   I4 TimeIndex = (TimeLevel + CurTimeIndex + NTimeLevels) % NTimeLevels;
+   GroupArray   = Kokkos::subview(
+       TracerArrays[TimeIndex],
+       std::make_pair(StartIndex, StartIndex + GroupLength), Kokkos::ALL,
+       Kokkos::ALL);
+   return 0;
+}
+
 I4 Tracers::getAllHost(HostArray3DReal &TracerArrayH, const I4 TimeLevel) {
 
    I4 Err = 0;
 
    if (TimeLevel <= 0 && (TimeLevel + NTimeLevels) > 0) {
       I4 TimeIndex = (TimeLevel + CurTimeIndex + NTimeLevels) % NTimeLevels;
+      allocateHostLevel(TimeIndex);
       TracerArrayH = TracerArraysH[TimeIndex];
    } else {
       LOG_ERROR("Tracers: Time level {} is out of range", TimeLevel);
@@ -351,6 +449,7 @@ I4 Tracers::getHostByIndex(HostArray2DReal &TracerArrayH, const I4 TimeLevel,
    }
 
    I4 TimeIndex = (TimeLevel + CurTimeIndex + NTimeLevels) % NTimeLevels;
+   allocateHostLevel(TimeIndex);
    TracerArrayH = Kokkos::subview(TracerArraysH[TimeIndex], TracerIndex,
                                   Kokkos::ALL, Kokkos::ALL);
    return 0;
@@ -373,6 +472,32 @@ I4 Tracers::getHostByName(HostArray2DReal &TracerArrayH, const I4 TimeLevel,
    return 0;
 }
 
+I4 Tracers::getHostGroup(HostTracerGroupArray &GroupArrayH,
+                         const I4 TimeLevel, const std::string &GroupName) {
+   // Check if time level is valid
+   if (TimeLevel > 0 || (TimeLevel + NTimeLevels) <= 0) {
+      LOG_ERROR("Tracers: Time level {} is out of range", TimeLevel);
+      return -1;
+   }
+
+   // Check if group exists
+   auto It = TracerGroups.find(GroupName);
+   if (It == TracerGroups.end()) {
+      LOG_ERROR("Tracers: Tracer group '{}' does not exist", GroupName);
+      return -2;
+   }
+
+   auto [StartIndex, GroupLength] = It->second;
+
+   I4 TimeIndex = (TimeLevel + CurTimeIndex + NTimeLevels) % NTimeLevels;
+   allocateHostLevel(TimeIndex);
+   GroupArrayH = Kokkos::subview(
+       TracerArraysH[TimeIndex],
+       std::make_pair(StartIndex, StartIndex + GroupLength), Kokkos::ALL,
+       Kokkos::ALL);
+   return 0;
+}
+
 //---------------------------------------------------------------------------
 // get Fields
 //---------------------------------------------------------------------------
@@ -420,6 +545,10 @@ I4 Tracers::getGroupRange(std::pair<I4, I4> &GroupRange,
    return -1;
 }
 
+bool Tracers::isReducedPrecision(const std::string &GroupName) {
+   return ReducedGroups.find(GroupName) != ReducedGroups.end();
+}
+
 bool Tracers::isGroupMemberByIndex(const I4 TracerIndex,
                                    const std::string GroupName) {
    auto it = TracerGroups.find(GroupName);
@@ -457,6 +586,10 @@ I4 Tracers::copyToDevice(const I4 TimeLevel) {
    }
 
    I4 TimeIndex = (TimeLevel + CurTimeIndex + NTimeLevels) % NTimeLevels;
+   if (!TracerArraysH[TimeIndex].is_allocated()) {
+      LOG_ERROR("Tracers: no host array to copy for time level {}", TimeLevel);
+      return -2;
+   }
    deepCopy(TracerArrays[TimeIndex], TracerArraysH[TimeIndex]);
 
    return 0;
@@ -471,21 +604,61 @@ I4 Tracers::copyToHost(const I4 TimeLevel) {
    }
 
    I4 TimeIndex = (TimeLevel + CurTimeIndex + NTimeLevels) % NTimeLevels;
+   allocateHostLevel(TimeIndex);
    deepCopy(TracerArraysH[TimeIndex], TracerArrays[TimeIndex]);
 
    return 0;
 }
 
+//---------------------------------------------------------------------------
+// host array allocation
+// the host arrays of all time levels are allocated at initialization unless
+// the tracers are device-only. The host arrays are the device arrays when
+// these are accessible from the host (CPU and unified memory builds)
+//---------------------------------------------------------------------------
+void Tracers::allocateHostLevel(const I4 TimeIndex) {
+
+   if (TracerArraysH[TimeIndex].is_allocated())
+      return;
+
+   releaseHostLevels();
+
+   TracerArraysH[TimeIndex] = createHostMirror(TracerArrays[TimeIndex]);
+}
+
+void Tracers::releaseHostLevels() {
+
+   if (!DeviceOnly)
+      return;
+
+   for (auto &TracerArrayH : TracerArraysH) {
+      TracerArrayH = HostArray3DReal();
+   }
+}
+
+bool Tracers::isDeviceOnly() { return DeviceOnly; }
+
 //---------------------------------------------------------------------------
 // halo exchange
 // TimeLevel == [0:current, -1:previous, -2:two times ago, ...]
 //---------------------------------------------------------------------------
-I4 Tracers::exchangeHalo(const I4 TimeLevel) {
+I4 Tracers::exchangeHalo(const I4 TimeLevel, const I4 HaloDepth) {
+   I4 TimeIndex = (TimeLevel + CurTimeIndex + NTimeLevels) % NTimeLevels;
+
+   // exchange device arrays directly when supported by the halo
+   if (MeshHalo->isDeviceExchange()) {
+      int Err = MeshHalo->exchangeFullArrayHalo(TracerArrays[TimeIndex],
+                                                OnCell, HaloDepth);
+      if (Err != 0)
+         return -1;
+      return 0;
+   }
+
    // TODO: copy only halo cells
    copyToHost(TimeLevel);
 
-   I4 TimeIndex = (TimeLevel + CurTimeIndex + NTimeLevels) % NTimeLevels;
-   int Err = MeshHalo->exchangeFullArrayHalo(TracerArraysH[TimeIndex], OnCell);
+   int Err = MeshHalo->exchangeFullArrayHalo(TracerArraysH[TimeIndex], OnCell,
+                                             HaloDepth);
    if (Err != 0)
       return -1;
 
@@ -496,31 +669,61 @@ I4 Tracers::exchangeHalo(const I4 TimeLevel) {
 }
 
 //---------------------------------------------------------------------------
-//  update time level
+// in-memory snapshots of all time levels, ordered by time level
 //---------------------------------------------------------------------------
-I4 Tracers::updateTimeLevels() {
+I4 Tracers::createSnapshot(std::vector<Array3DReal> &Snapshot) {
 
-   // Exchange halo
-   exchangeHalo(0);
+   Snapshot.resize(NTimeLevels);
 
-   CurTimeIndex = (CurTimeIndex + 1) % NTimeLevels;
+   for (I4 Level = 0; Level < NTimeLevels; ++Level) {
+      I4 TimeIndex = (CurTimeIndex - Level + NTimeLevels) % NTimeLevels;
+      Snapshot[Level] = createFirstTouchArray<Array3DReal>(
+          "TracerSnapshot" + std::to_string(Level), NumTracers, NCellsSize,
+          NVertLevels);
+      deepCopy(Snapshot[Level], TracerArrays[TimeIndex]);
+   }
 
-   // Update TracerField data associations
-   for (const auto &TracerPair : TracerIndexes) {
-      auto TracerFieldName = TracerPair.first;
-      auto TracerIndex     = TracerPair.second;
+   return 0;
+}
 
-      std::shared_ptr<Field> TracerField = Field::get(TracerFieldName);
+I4 Tracers::restoreSnapshot(const std::vector<Array3DReal> &Snapshot) {
 
-      Array2DReal TracerSubview = Kokkos::subview(
-          TracerArrays[CurTimeIndex], TracerIndex, Kokkos::ALL, Kokkos::ALL);
-      I4 Err = TracerField->attachData<Array2DReal>(TracerSubview);
-      if (Err != 0) {
-         LOG_ERROR("Error attaching data array to field {}", TracerFieldName);
-         return Err;
+   if (static_cast<I4>(Snapshot.size()) != NTimeLevels) {
+      LOG_ERROR("Tracers: snapshot has {} time levels instead of {}",
+                Snapshot.size(), NTimeLevels);
+      return -1;
+   }
+
+   for (I4 Level = 0; Level < NTimeLevels; ++Level) {
+      if (Snapshot[Level].extent_int(0) != NumTracers ||
+          Snapshot[Level].extent_int(1) != NCellsSize ||
+          Snapshot[Level].extent_int(2) != NVertLevels) {
+         LOG_ERROR("Tracers: snapshot time level {} has the wrong size",
+                   -Level);
+         return -2;
       }
    }
 
+   for (I4 Level = 0; Level < NTimeLevels; ++Level) {
+      I4 TimeIndex = (CurTimeIndex - Level + NTimeLevels) % NTimeLevels;
+      deepCopy(TracerArrays[TimeIndex], Snapshot[Level]);
+   }
+
+   return 0;
+}
+
+//---------------------------------------------------------------------------
+//  update time level
+//---------------------------------------------------------------------------
+I4 Tracers::updateTimeLevels(const I4 HaloDepth) {
+
+   // Exchange the halo of the new time level, which becomes the current one
+   exchangeHalo(1, HaloDepth);
+
+   // The tracer fields resolve the current time level when their data is
+   // requested, so only the time index needs to be incremented
+   CurTimeIndex = (CurTimeIndex + 1) % NTimeLevels;
+
    return 0;
 }
 
@@ -10,13 +10,34 @@
 /// because once tracers are created, they never change.
 //===----------------------------------------------------------------------===//
 
+#include "Config.h"
 #include "DataTypes.h"
 #include "Decomp.h"
 #include "Field.h"
 #include "Halo.h"
 
+#include <set>
+#include <type_traits>
+
 namespace OMEGA {
 
+/// Layout of the array of the tracers of one group. The tracer arrays have
+/// dimensions [Tracer, Cell, Vert] in the memory layout of the build, which
+/// is selected for the backend. With the right layout the levels of each
+/// tracer are contiguous and a group is one contiguous block of the tracer
+/// array. With the left layout the tracer index is the fastest, so the
+/// tracers of all groups are interleaved and a group array is strided.
+template <class ML>
+using TracerGroupLayout =
+    std::conditional_t<std::is_same_v<ML, Kokkos::LayoutRight>, ML,
+                       Kokkos::LayoutStride>;
+
+/// Device and host arrays of the tracers of one group
+using TracerGroupArray =
+    Kokkos::View<Real ***, TracerGroupLayout<MemLayout>, MemSpace>;
+using HostTracerGroupArray =
+    Kokkos::View<Real ***, TracerGroupLayout<HostMemLayout>, HostMemSpace>;
+
 /// The Tracers class provides a container for tracer arrays and methods
 class Tracers {
 
@@ -42,11 +63,20 @@ class Tracers {
    static std::vector<HostArray3DReal>
        TracerArraysH; ///< TimeLevels -> [Tracer, Cell, Vert]
 
+   // In device-only mode, the host arrays are only allocated for the time
+   // level last copied to or requested on the host
+   static bool DeviceOnly;
+
    // maps for managing tracer groups
    // Key of this map is a group name and
    // Value is a pair of GroupStartIndex and GroupLength
    static std::map<std::string, std::pair<I4, I4>> TracerGroups;
 
+   // names of the groups with single precision output requested in the
+   // config. Their tracers are stored and computed in the working precision
+   // and written in single precision by all output streams except restarts.
+   static std::set<std::string> ReducedGroups;
+
    // maps for matching tracer names with indices (both directions)
    static std::map<std::string, I4> TracerIndexes;
    static std::map<I4, std::string> TracerNames;
@@ -62,6 +92,21 @@ class Tracers {
    // if it is over max index
    static I4 CurTimeIndex; ///< Time dimension array index for current level
 
+   // allocates the host array of a time index if it is not allocated,
+   // releasing the other host arrays in device-only mode
+   static void allocateHostLevel(const I4 TimeIndex ///< [in] time index
+   );
+
+   // reads the tracer names and the output precision of a group, which is
+   // either a list of tracer names or a group with Tracers and
+   // OutputPrecision
+   static I4
+   readGroupConfig(Config &TracersConfig,        ///< [in] Tracers config
+                   const std::string &GroupName, ///< [in] group name
+                   std::vector<std::string> &GroupTracers, ///< [out] names
+                   bool &Reduced ///< [out] true for single precision
+   );
+
    // locally defines all tracers but do not allocates memory
    static I4
    define(const std::string &Name,        ///< [in] Name of tracer
@@ -122,6 +167,13 @@ class Tracers {
              const std::string &TracerName ///< [in] global tracer name
    );
 
+   // get a device array for the tracers of a group
+   static I4
+   getGroup(TracerGroupArray &GroupArray, ///< [out] group device array
+            const I4 TimeLevel,           ///< [in] time level index
+            const std::string &GroupName  ///< [in] group name
+   );
+
    // get a host array for all tracers
    static I4
    getAllHost(HostArray3DReal &TracerArrayH, ///< [out] tracer host array
@@ -142,6 +194,13 @@ class Tracers {
                  const std::string &TracerName  ///< [in] global tracer name
    );
 
+   // get a host array for the tracers of a group
+   static I4
+   getHostGroup(HostTracerGroupArray &GroupArrayH, ///< [out] group host array
+                const I4 TimeLevel,                ///< [in] time level index
+                const std::string &GroupName       ///< [in] group name
+   );
+
    // get a field by tracer index. If not found, returns nullptr
    static std::shared_ptr<Field>
    getFieldByIndex(const I4 TracerIndex ///< [in] global tracer index
@@ -164,6 +223,11 @@ class Tracers {
                            const std::string &GroupName   ///< [in] group name
    );
 
+   // check if the tracers of a group are written in single precision
+   static bool
+   isReducedPrecision(const std::string &GroupName ///< [in] group name
+   );
+
    // check if a tracer is a member of group by tracer index
    static bool
    isGroupMemberByIndex(const I4 TracerIndex,       ///< [in] tracer index
@@ -180,12 +244,14 @@ class Tracers {
    // Halo exchange and update time level
    //---------------------------------------------------------------------------
 
-   /// Exchange halo
-   static I4 exchangeHalo(const I4 TimeLevel ///< [in] tracer time level
+   /// Exchange halo, by default all halo layers are exchanged
+   static I4 exchangeHalo(const I4 TimeLevel,    ///< [in] tracer time level
+                          const I4 HaloDepth = 0 ///< [in] halo layers
    );
 
-   /// increment time levels
-   static I4 updateTimeLevels();
+   /// increment time levels after exchanging the halo of the new time level
+   static I4 updateTimeLevels(const I4 HaloDepth = 0 ///< [in] halo layers
+   );
 
    //---------------------------------------------------------------------------
    // Device-Host data movement
@@ -199,6 +265,28 @@ class Tracers {
    static I4 copyToHost(const I4 TimeLevel ///< [in] tracer time level
    );
 
+   /// Release the host arrays of all time levels in device-only mode
+   static void releaseHostLevels();
+
+   /// Returns true if the host arrays are only allocated when needed
+   static bool isDeviceOnly();
+
+   //---------------------------------------------------------------------------
+   // In-memory snapshots
+   //---------------------------------------------------------------------------
+
+   /// Copy all time levels of the tracers to new device arrays. Element K of
+   /// the snapshot holds time level -K, so that a snapshot can be restored
+   /// independent of the current time index.
+   static I4
+   createSnapshot(std::vector<Array3DReal> &Snapshot ///< [out] tracer copies
+   );
+
+   /// Copy the time levels of a snapshot back to the tracer device arrays
+   static I4 restoreSnapshot(
+       const std::vector<Array3DReal> &Snapshot ///< [in] tracer copies
+   );
+
    //---------------------------------------------------------------------------
    // Forbid copy and move construction
    //---------------------------------------------------------------------------
@@ -0,0 +1,118 @@
+//===-- ocn/VertSolvers.cpp - vertical column solvers -----------*- C++ -*-===//
+//
+// The batched tridiagonal solver factors the matrices of all columns once
+// and then applies the factorization to one or more right-hand sides per
+// column. Each column is solved sequentially in the vertical with the Thomas
+// algorithm while columns (and tracers) are distributed across threads.
+//
+//===----------------------------------------------------------------------===//
+
+#include "VertSolvers.h"
+#include "DataTypes.h"
+#include "OmegaKokkos.h"
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Construct a solver and allocate the arrays of the factored systems
+
+TridiagonalSolver::TridiagonalSolver(
+    const std::string &Name,     // [in] name for arrays
+    I4 InNColumns,               // [in] number of columns
+    I4 NVertLevels,              // [in] max levels per column
+    const Array1DI4 &InMinLevel, // [in] first active level
+    const Array1DI4 &InMaxLevel  // [in] last active level
+    )
+    : NColumns(InNColumns), MinLevel(InMinLevel), MaxLevel(InMaxLevel),
+      Lower(createFirstTouchArray<Array2DReal>(Name + "Lower", InNColumns,
+                                               NVertLevels)),
+      UpperMod(createFirstTouchArray<Array2DReal>(Name + "UpperMod",
+                                                  InNColumns, NVertLevels)),
+      InvPivot(createFirstTouchArray<Array2DReal>(Name + "InvPivot",
+                                                  InNColumns, NVertLevels)) {}
+
+//------------------------------------------------------------------------------
+// Factor the matrices of all columns
+
+void TridiagonalSolver::factor(const Array2DReal &InLower, // [in] sub-diagonal
+                               const Array2DReal &Diag,    // [in] diagonal
+                               const Array2DReal &Upper // [in] super-diagonal
+) {
+
+   OMEGA_SCOPE(LocMinLevel, MinLevel);
+   OMEGA_SCOPE(LocMaxLevel, MaxLevel);
+   OMEGA_SCOPE(LocLower, Lower);
+   OMEGA_SCOPE(LocUpperMod, UpperMod);
+   OMEGA_SCOPE(LocInvPivot, InvPivot);
+
+   parallelFor(
+       "TridiagFactor", {NColumns}, KOKKOS_LAMBDA(int IColumn) {
+          const int KMin = LocMinLevel(IColumn);
+          const int KMax = LocMaxLevel(IColumn);
+          if (KMax < KMin)
+             return;
+
+          Real InvPiv                = 1._Real / Diag(IColumn, KMin);
+          LocLower(IColumn, KMin)    = 0;
+          LocInvPivot(IColumn, KMin) = InvPiv;
+          LocUpperMod(IColumn, KMin) = Upper(IColumn, KMin) * InvPiv;
+
+          for (int K = KMin + 1; K <= KMax; ++K) {
+             const Real LowerK = InLower(IColumn, K);
+             InvPiv = 1._Real / (Diag(IColumn, K) -
+                                 LowerK * LocUpperMod(IColumn, K - 1));
+             LocLower(IColumn, K)    = LowerK;
+             LocInvPivot(IColumn, K) = InvPiv;
+             LocUpperMod(IColumn, K) = Upper(IColumn, K) * InvPiv;
+          }
+
+          // the last level has no super-diagonal
+          LocUpperMod(IColumn, KMax) = 0;
+       });
+
+} // end factor
+
+//------------------------------------------------------------------------------
+// Solve the factored systems for one right-hand side per column
+
+void TridiagonalSolver::solve(
+    const Array2DReal &Rhs // [inout] right-hand side/solution
+) const {
+
+   const TridiagonalSolver Solver = *this;
+
+   parallelFor(
+       "TridiagSolve", {NColumns}, KOKKOS_LAMBDA(int IColumn) {
+          auto RhsColumn = Kokkos::subview(Rhs, IColumn, Kokkos::ALL);
+          Solver.solveColumn(RhsColumn, IColumn);
+       });
+
+} // end solve
+
+//------------------------------------------------------------------------------
+// Solve the factored systems for a range of tracers. All tracers of a column
+// share the same factorization, so the tracers and columns are flattened
+// into a single parallel dimension.
+
+void TridiagonalSolver::solve(
+    const Array3DReal &Rhs,              // [inout] tracers
+    const std::pair<I4, I4> &TracerRange // [in] tracers to solve
+) const {
+
+   const TridiagonalSolver Solver = *this;
+   const I4 TracerStart           = TracerRange.first;
+   const I4 NTracersSolve         = TracerRange.second;
+
+   parallelFor(
+       "TridiagSolveTracers", {NTracersSolve, NColumns},
+       KOKKOS_LAMBDA(int L, int IColumn) {
+          auto RhsColumn =
+              Kokkos::subview(Rhs, TracerStart + L, IColumn, Kokkos::ALL);
+          Solver.solveColumn(RhsColumn, IColumn);
+       });
+
+} // end solve
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,94 @@
+#ifndef OMEGA_VERTSOLVERS_H
+#define OMEGA_VERTSOLVERS_H
+//===-- ocn/VertSolvers.h - vertical column solvers -------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines batched solvers for vertical column systems
+///
+/// The TridiagonalSolver solves the tridiagonal systems that arise from
+/// implicit vertical mixing in every column of a set of cells, edges or
+/// vertices. Each column k of the system is
+///    Lower(k) x(k-1) + Diag(k) x(k) + Upper(k) x(k+1) = Rhs(k)
+/// over the active levels MinLevel <= k <= MaxLevel of that column, with the
+/// Lower entry at MinLevel and the Upper entry at MaxLevel ignored. The
+/// matrices are factored once and the factorization is then applied to any
+/// number of right-hand sides, including all tracers of a tracer group.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "OmegaKokkos.h"
+
+#include <string>
+#include <utility>
+
+namespace OMEGA {
+
+class TridiagonalSolver {
+ public:
+   /// Creates a solver for NColumns columns of up to NVertLevels levels with
+   /// the active levels of each column given by MinLevel and MaxLevel
+   TridiagonalSolver(const std::string &Name,     ///< [in] name for arrays
+                     I4 InNColumns,               ///< [in] number of columns
+                     I4 NVertLevels,              ///< [in] max levels per col
+                     const Array1DI4 &InMinLevel, ///< [in] first active level
+                     const Array1DI4 &InMaxLevel  ///< [in] last active level
+   );
+
+   /// Factors the matrices of all columns with the Thomas algorithm. The
+   /// arrays have dimensions [Column, Vert]. Factoring without pivoting is
+   /// stable for the diagonally dominant systems of implicit mixing.
+   void factor(const Array2DReal &InLower, ///< [in] sub-diagonal
+               const Array2DReal &Diag,    ///< [in] diagonal
+               const Array2DReal &Upper    ///< [in] super-diagonal
+   );
+
+   /// Solves the factored systems for one right-hand side per column. The
+   /// solution overwrites Rhs, which has dimensions [Column, Vert].
+   void solve(const Array2DReal &Rhs ///< [inout] right-hand side/solution
+   ) const;
+
+   /// Solves the factored systems for the tracers in TracerRange, given as
+   /// (first tracer, number of tracers) like the Tracers group ranges. The
+   /// solution overwrites Rhs, which has dimensions [Tracer, Column, Vert].
+   void solve(const Array3DReal &Rhs,              ///< [inout] tracers
+              const std::pair<I4, I4> &TracerRange ///< [in] tracers to solve
+   ) const;
+
+   /// Solves one column of the factored systems in place. This can be called
+   /// from inside kernels that compute the right-hand side of a column.
+   template <class RhsColumn>
+   KOKKOS_FUNCTION void solveColumn(const RhsColumn &Rhs, int IColumn) const {
+      const int KMin = MinLevel(IColumn);
+      const int KMax = MaxLevel(IColumn);
+      if (KMax < KMin)
+         return;
+
+      // forward substitution
+      Rhs(KMin) *= InvPivot(IColumn, KMin);
+      for (int K = KMin + 1; K <= KMax; ++K) {
+         Rhs(K) = (Rhs(K) - Lower(IColumn, K) * Rhs(K - 1)) *
+                  InvPivot(IColumn, K);
+      }
+
+      // back substitution
+      for (int K = KMax - 1; K >= KMin; --K) {
+         Rhs(K) -= UpperMod(IColumn, K) * Rhs(K + 1);
+      }
+   }
+
+ private:
+   I4 NColumns; ///< number of columns
+
+   Array1DI4 MinLevel; ///< first active level of each column
+   Array1DI4 MaxLevel; ///< last active level of each column
+
+   Array2DReal Lower;    ///< sub-diagonal of the factored systems
+   Array2DReal UpperMod; ///< super-diagonal divided by the pivots
+   Array2DReal InvPivot; ///< inverse of the pivots
+};
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
+#endif // OMEGA_VERTSOLVERS_H
@@ -8,12 +8,12 @@ namespace OMEGA {
 
 KineticAuxVars::KineticAuxVars(const std::string &AuxStateSuffix,
                                const HorzMesh *Mesh, int NVertLevels)
-    : KineticEnergyCell("KineticEnergyCell" + AuxStateSuffix, Mesh->NCellsSize,
-                        NVertLevels),
-      VelocityDivCell("VelocityDivCell" + AuxStateSuffix, Mesh->NCellsSize,
-                      NVertLevels),
-      NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      EdgeSignOnCell(Mesh->EdgeSignOnCell), DcEdge(Mesh->DcEdge),
+    : KineticEnergyCell(createFirstTouchArray<Array2DAuxReal>(
+          "KineticEnergyCell" + AuxStateSuffix, Mesh->NCellsSize, NVertLevels)),
+      VelocityDivCell(createFirstTouchArray<Array2DAuxReal>(
+          "VelocityDivCell" + AuxStateSuffix, Mesh->NCellsSize, NVertLevels)),
+      OffsetsOnCell(Mesh->OffsetsOnCell), EdgesOnCellCSR(Mesh->EdgesOnCellCSR),
+      DivWeightsOnCellCSR(Mesh->DivWeightsOnCellCSR), DcEdge(Mesh->DcEdge),
       DvEdge(Mesh->DvEdge), AreaCell(Mesh->AreaCell) {}
 
 void KineticAuxVars::registerFields(
@@ -73,11 +73,11 @@ void KineticAuxVars::registerFields(
                 AuxGroupName);
 
    // Attach data
-   Err = KineticEnergyCellField->attachData<Array2DReal>(KineticEnergyCell);
+   Err = KineticEnergyCellField->attachData<Array2DAuxReal>(KineticEnergyCell);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", KineticEnergyCell.label());
 
-   Err = VelocityDivCellField->attachData<Array2DReal>(VelocityDivCell);
+   Err = VelocityDivCellField->attachData<Array2DAuxReal>(VelocityDivCell);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", VelocityDivCell.label());
 }
@@ -4,6 +4,7 @@
 #include "DataTypes.h"
 #include "HorzMesh.h"
 #include "OmegaKokkos.h"
+#include "Pack.h"
 
 #include <string>
 
@@ -11,39 +12,37 @@ namespace OMEGA {
 
 class KineticAuxVars {
  public:
-   Array2DReal KineticEnergyCell;
-   Array2DReal VelocityDivCell;
+   Array2DAuxReal KineticEnergyCell;
+   Array2DAuxReal VelocityDivCell;
 
    KineticAuxVars(const std::string &AuxStateSuffix, const HorzMesh *Mesh,
                   int NVertLevels);
 
+   template <int W = VecLength>
    KOKKOS_FUNCTION void
    computeVarsOnCell(int ICell, int KChunk,
                      const Array2DReal &NormalVelEdge) const {
       const Real InvAreaCell = 1._Real / AreaCell(ICell);
-      const int KStart       = KChunk * VecLength;
+      const int KStart       = KChunk * W;
+      const int KLen         = chunkLength<W>(KStart, KineticEnergyCell);
 
-      Real KineticEnergyCellTmp[VecLength] = {0};
-      Real VelocityDivCellTmp[VecLength]   = {0};
+      RealPack<W> KineticEnergyCellTmp;
+      RealPack<W> VelocityDivCellTmp;
 
-      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
-         const int JEdge     = EdgesOnCell(ICell, J);
+      for (int J = OffsetsOnCell(ICell); J < OffsetsOnCell(ICell + 1); ++J) {
+         const int JEdge     = EdgesOnCellCSR(J);
          const Real AreaEdge = 0.5_Real * DvEdge(JEdge) * DcEdge(JEdge);
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K = KStart + KVec;
-            KineticEnergyCellTmp[KVec] += AreaEdge * 0.5_Real * InvAreaCell *
-                                          NormalVelEdge(JEdge, K) *
-                                          NormalVelEdge(JEdge, K);
-            VelocityDivCellTmp[KVec] -= DvEdge(JEdge) * InvAreaCell *
-                                        EdgeSignOnCell(ICell, J) *
-                                        NormalVelEdge(JEdge, K);
-         }
-      }
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K                 = KStart + KVec;
-         KineticEnergyCell(ICell, K) = KineticEnergyCellTmp[KVec];
-         VelocityDivCell(ICell, K)   = VelocityDivCellTmp[KVec];
+         const Real KEWgt    = AreaEdge * 0.5_Real * InvAreaCell;
+         const Real DivWgt   = DivWeightsOnCellCSR(J);
+
+         const RealPack<W> NormalVel =
+             loadPack<W>(NormalVelEdge, KStart, KLen, JEdge);
+         KineticEnergyCellTmp += KEWgt * NormalVel * NormalVel;
+         VelocityDivCellTmp -= DivWgt * NormalVel;
       }
+
+      storePack(KineticEnergyCell, KineticEnergyCellTmp, KStart, KLen, ICell);
+      storePack(VelocityDivCell, VelocityDivCellTmp, KStart, KLen, ICell);
    }
 
    void registerFields(const std::string &AuxGroupName,
@@ -51,9 +50,9 @@ class KineticAuxVars {
    void unregisterFields() const;
 
  private:
-   Array1DI4 NEdgesOnCell;
-   Array2DI4 EdgesOnCell;
-   Array2DR8 EdgeSignOnCell;
+   Array1DI4 OffsetsOnCell;
+   Array1DI4 EdgesOnCellCSR;
+   Array1DR8 DivWeightsOnCellCSR;
    Array1DR8 DcEdge;
    Array1DR8 DvEdge;
    Array1DR8 AreaCell;
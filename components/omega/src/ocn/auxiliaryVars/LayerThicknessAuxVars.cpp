@@ -9,12 +9,34 @@ namespace OMEGA {
 LayerThicknessAuxVars::LayerThicknessAuxVars(const std::string &AuxStateSuffix,
                                              const HorzMesh *Mesh,
                                              int NVertLevels)
-    : FluxLayerThickEdge("FluxLayerThickEdge" + AuxStateSuffix,
-                         Mesh->NEdgesSize, NVertLevels),
-      MeanLayerThickEdge("MeanLayerThickEdge" + AuxStateSuffix,
-                         Mesh->NEdgesSize, NVertLevels),
-      SshCell("SshCell" + AuxStateSuffix, Mesh->NCellsSize, NVertLevels),
-      CellsOnEdge(Mesh->CellsOnEdge), BottomDepth(Mesh->BottomDepth) {}
+    : FluxLayerThickEdge(createFirstTouchArray<Array2DAuxReal>(
+          "FluxLayerThickEdge" + AuxStateSuffix, Mesh->NEdgesSize,
+          NVertLevels)),
+      MeanLayerThickEdge(createFirstTouchArray<Array2DAuxReal>(
+          "MeanLayerThickEdge" + AuxStateSuffix, Mesh->NEdgesSize,
+          NVertLevels)),
+      SshCell(createFirstTouchArray<Array2DAuxReal>(
+          "SshCell" + AuxStateSuffix, Mesh->NCellsSize, NVertLevels)),
+      CellsOnEdge(Mesh->CellsOnEdge), BottomDepth(Mesh->BottomDepth),
+      AuxStateSuffix(AuxStateSuffix), NEdgesSize(Mesh->NEdgesSize),
+      NCellsSize(Mesh->NCellsSize), NVertLevels(NVertLevels) {}
+
+void LayerThicknessAuxVars::setRecompute(bool Recompute) {
+
+   if (Recompute == RecomputeVars)
+      return;
+   RecomputeVars = Recompute;
+
+   if (RecomputeVars) {
+      MeanLayerThickEdge = Array2DAuxReal();
+      SshCell            = Array2DAuxReal();
+   } else {
+      MeanLayerThickEdge = createFirstTouchArray<Array2DAuxReal>(
+          "MeanLayerThickEdge" + AuxStateSuffix, NEdgesSize, NVertLevels);
+      SshCell = createFirstTouchArray<Array2DAuxReal>(
+          "SshCell" + AuxStateSuffix, NCellsSize, NVertLevels);
+   }
+}
 
 void LayerThicknessAuxVars::registerFields(const std::string &AuxGroupName,
                                            const std::string &MeshName) const {
@@ -49,6 +71,20 @@ void LayerThicknessAuxVars::registerFields(const std::string &AuxGroupName,
        DimNames                                  // dimension names
    );
 
+   Err = FieldGroup::addFieldToGroup(FluxLayerThickEdge.label(), AuxGroupName);
+   if (Err != 0)
+      LOG_ERROR("Error adding field {} to group {}", FluxLayerThickEdge.label(),
+                AuxGroupName);
+
+   Err = FluxLayerThickEdgeField->attachData<Array2DAuxReal>(
+       FluxLayerThickEdge);
+   if (Err != 0)
+      LOG_ERROR("Error attaching data to field {}", FluxLayerThickEdge.label());
+
+   // The recomputed variables are not stored and have no fields
+   if (RecomputeVars)
+      return;
+
    // Mean layer thickness on edges
    auto MeanLayerThickEdgeField = Field::create(
        MeanLayerThickEdge.label(),                           // field name
@@ -78,11 +114,6 @@ void LayerThicknessAuxVars::registerFields(const std::string &AuxGroupName,
    );
 
    // Add fields to Aux field group
-   Err = FieldGroup::addFieldToGroup(FluxLayerThickEdge.label(), AuxGroupName);
-   if (Err != 0)
-      LOG_ERROR("Error adding field {} to group {}", FluxLayerThickEdge.label(),
-                AuxGroupName);
-
    Err = FieldGroup::addFieldToGroup(MeanLayerThickEdge.label(), AuxGroupName);
    if (Err != 0)
       LOG_ERROR("Error adding field {} to group {}", MeanLayerThickEdge.label(),
@@ -94,15 +125,12 @@ void LayerThicknessAuxVars::registerFields(const std::string &AuxGroupName,
                 AuxGroupName);
 
    // Attach field data
-   Err = FluxLayerThickEdgeField->attachData<Array2DReal>(FluxLayerThickEdge);
-   if (Err != 0)
-      LOG_ERROR("Error attaching data to field {}", FluxLayerThickEdge.label());
-
-   Err = MeanLayerThickEdgeField->attachData<Array2DReal>(MeanLayerThickEdge);
+   Err = MeanLayerThickEdgeField->attachData<Array2DAuxReal>(
+       MeanLayerThickEdge);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", MeanLayerThickEdge.label());
 
-   Err = SshCellField->attachData<Array2DReal>(SshCell);
+   Err = SshCellField->attachData<Array2DAuxReal>(SshCell);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", SshCell.label());
 }
@@ -115,6 +143,9 @@ void LayerThicknessAuxVars::unregisterFields() const {
    if (Err != 0)
       LOG_ERROR("Error destroying field {}", FluxLayerThickEdge.label());
 
+   if (RecomputeVars)
+      return;
+
    Err = Field::destroy(MeanLayerThickEdge.label());
    if (Err != 0)
       LOG_ERROR("Error destroying field {}", MeanLayerThickEdge.label());
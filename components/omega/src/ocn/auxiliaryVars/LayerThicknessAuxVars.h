@@ -4,72 +4,139 @@
 #include "DataTypes.h"
 #include "HorzMesh.h"
 #include "OmegaKokkos.h"
+#include "Pack.h"
 
 #include <string>
 
 namespace OMEGA {
 
-enum FluxThickEdgeOption { Center, Upwind };
+enum FluxThickEdgeOption { Center, Upwind, HighOrder };
+
+/// Read access to the mean layer thickness on edges. Reads the stored
+/// MeanLayerThickEdge, or if it is recomputed on the fly, averages the
+/// thickness of the two cells on the edge, rounded like the stored values.
+class MeanLayerThickEdgeAccessor {
+ public:
+   bool Recompute;
+   Array2DAuxReal Stored;
+   Array2DReal LayerThickCell;
+   Array2DI4 CellsOnEdge;
+
+   KOKKOS_FUNCTION AuxReal operator()(int IEdge, int K) const {
+      if (Recompute)
+         return static_cast<AuxReal>(
+             0.5_Real * (LayerThickCell(CellsOnEdge(IEdge, 0), K) +
+                         LayerThickCell(CellsOnEdge(IEdge, 1), K)));
+      return Stored(IEdge, K);
+   }
+};
+
+/// Read access to the sea surface height at cell centers, either stored or
+/// recomputed on the fly from the layer thickness and bottom depth
+class SshCellAccessor {
+ public:
+   bool Recompute;
+   Array2DAuxReal Stored;
+   Array2DReal LayerThickCell;
+   Array1DReal BottomDepth;
+
+   KOKKOS_FUNCTION AuxReal operator()(int ICell, int K) const {
+      if (Recompute)
+         return static_cast<AuxReal>(LayerThickCell(ICell, K) -
+                                     BottomDepth(ICell));
+      return Stored(ICell, K);
+   }
+};
 
 class LayerThicknessAuxVars {
  public:
-   Array2DReal FluxLayerThickEdge;
-   Array2DReal MeanLayerThickEdge;
-   Array2DReal SshCell;
+   Array2DAuxReal FluxLayerThickEdge;
+   Array2DAuxReal MeanLayerThickEdge;
+   Array2DAuxReal SshCell;
 
    FluxThickEdgeOption FluxThickEdgeChoice;
 
+   /// If true, MeanLayerThickEdge and SshCell are not allocated and their
+   /// accessors recompute them from the layer thickness inside the consuming
+   /// kernels. Set with setRecompute.
+   bool RecomputeVars = false;
+
    LayerThicknessAuxVars(const std::string &AuxStateSuffix,
                          const HorzMesh *Mesh, int NVertLevels);
 
+   /// Switch between storing and recomputing the cheap variables, allocating
+   /// or releasing their arrays. The fields must not be registered.
+   void setRecompute(bool Recompute);
+
+   /// Record the layer thickness the variables are computed from, which the
+   /// accessors read when the variables are recomputed on the fly. The
+   /// thickness must not change until the variables are computed again.
+   void setLayerThickCell(const Array2DReal &LayerThickCell) const {
+      RecomputeLayerThickCell = LayerThickCell;
+   }
+
+   /// Accessors for the mean layer thickness on edges and the sea surface
+   /// height, to be passed to the kernels in place of the arrays
+   MeanLayerThickEdgeAccessor meanLayerThickEdge() const {
+      return {RecomputeVars, MeanLayerThickEdge, RecomputeLayerThickCell,
+              CellsOnEdge};
+   }
+   SshCellAccessor sshCell() const {
+      return {RecomputeVars, SshCell, RecomputeLayerThickCell, BottomDepth};
+   }
+
+   template <int W = VecLength>
    KOKKOS_FUNCTION void
    computeVarsOnEdge(int IEdge, int KChunk, const Array2DReal &LayerThickCell,
                      const Array2DReal &NormalVelEdge) const {
-      const int KStart = KChunk * VecLength;
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, FluxLayerThickEdge);
       const int JCell0 = CellsOnEdge(IEdge, 0);
       const int JCell1 = CellsOnEdge(IEdge, 1);
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K = KStart + KVec;
-         MeanLayerThickEdge(IEdge, K) =
-             0.5_Real * (LayerThickCell(JCell0, K) + LayerThickCell(JCell1, K));
-      }
+      const RealPack<W> Thick0 =
+          loadPack<W>(LayerThickCell, KStart, KLen, JCell0);
+      const RealPack<W> Thick1 =
+          loadPack<W>(LayerThickCell, KStart, KLen, JCell1);
+      const RealPack<W> MeanThick = 0.5_Real * (Thick0 + Thick1);
+
+      if (!RecomputeVars)
+         storePack(MeanLayerThickEdge, MeanThick, KStart, KLen, IEdge);
 
       switch (FluxThickEdgeChoice) {
+      // HighOrder is only available for the tracers
       case Center:
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K = KStart + KVec;
-            FluxLayerThickEdge(IEdge, K) =
-                0.5_Real *
-                (LayerThickCell(JCell0, K) + LayerThickCell(JCell1, K));
-         }
+      case HighOrder:
+         storePack(FluxLayerThickEdge, MeanThick, KStart, KLen, IEdge);
          break;
-      case Upwind:
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K = KStart + KVec;
-            if (NormalVelEdge(IEdge, K) > 0) {
-               FluxLayerThickEdge(IEdge, K) = LayerThickCell(JCell0, K);
-            } else if (NormalVelEdge(IEdge, K) < 0) {
-               FluxLayerThickEdge(IEdge, K) = LayerThickCell(JCell1, K);
-            } else {
-               FluxLayerThickEdge(IEdge, K) = Kokkos::max(
-                   LayerThickCell(JCell0, K), LayerThickCell(JCell1, K));
-            }
-         }
+      case Upwind: {
+         const RealPack<W> NormalVel =
+             loadPack<W>(NormalVelEdge, KStart, KLen, IEdge);
+         storePack(FluxLayerThickEdge,
+                   select(NormalVel > 0._Real, Thick0,
+                          select(NormalVel < 0._Real, Thick1,
+                                 max(Thick0, Thick1))),
+                   KStart, KLen, IEdge);
          break;
       }
+      }
    }
 
+   template <int W = VecLength>
    KOKKOS_FUNCTION void
    computeVarsOnCells(int ICell, int KChunk,
                       const Array2DReal &LayerThickCell) const {
 
+      if (RecomputeVars)
+         return;
+
       // Temporary for stacked shallow water
-      const int KStart = KChunk * VecLength;
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K       = KStart + KVec;
-         SshCell(ICell, K) = LayerThickCell(ICell, K) - BottomDepth(ICell);
-      }
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, SshCell);
+      storePack(SshCell,
+                loadPack<W>(LayerThickCell, KStart, KLen, ICell) -
+                    BottomDepth(ICell),
+                KStart, KLen, ICell);
 
       /*
       Real TotalThickness = 0.0;
@@ -88,6 +155,12 @@ class LayerThicknessAuxVars {
  private:
    Array2DI4 CellsOnEdge;
    Array1DReal BottomDepth;
+   mutable Array2DReal RecomputeLayerThickCell;
+
+   std::string AuxStateSuffix;
+   I4 NEdgesSize;
+   I4 NCellsSize;
+   I4 NVertLevels;
 };
 
 } // namespace OMEGA
@@ -7,14 +7,21 @@ namespace OMEGA {
 
 TracerAuxVars::TracerAuxVars(const std::string &AuxStateSuffix,
                              const HorzMesh *Mesh, const I4 NVertLevels,
-                             const I4 NTracers)
-    : HTracersOnEdge("ThickTracersOnEdge" + AuxStateSuffix, NTracers,
-                     Mesh->NEdgesSize, NVertLevels),
-      Del2TracersOnCell("Del2TracerOnCell" + AuxStateSuffix, NTracers,
-                        Mesh->NCellsSize, NVertLevels),
-      NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      CellsOnEdge(Mesh->CellsOnEdge), EdgeSignOnCell(Mesh->EdgeSignOnCell),
-      DcEdge(Mesh->DcEdge), DvEdge(Mesh->DvEdge), AreaCell(Mesh->AreaCell) {}
+                             const I4 NTracers, const bool AllocDel2)
+    : HTracersOnEdge(createFirstTouchArray<Array3DAuxReal>(
+          "ThickTracersOnEdge" + AuxStateSuffix, NTracers, Mesh->NEdgesSize,
+          NVertLevels)),
+      Del2TracersOnCell(AllocDel2 ? createFirstTouchArray<Array3DAuxReal>(
+                                        "Del2TracerOnCell" + AuxStateSuffix,
+                                        NTracers, Mesh->NCellsSize, NVertLevels)
+                                  : Array3DAuxReal()),
+      OffsetsOnCell(Mesh->OffsetsOnCell), EdgesOnCellCSR(Mesh->EdgesOnCellCSR),
+      CellsOnEdge(Mesh->CellsOnEdge),
+      EdgeSignOnCellCSR(Mesh->EdgeSignOnCellCSR), DcEdge(Mesh->DcEdge),
+      DvEdge(Mesh->DvEdge), AreaCell(Mesh->AreaCell),
+      NAdvCellsForEdge(Mesh->NAdvCellsForEdge),
+      AdvCellsForEdge(Mesh->AdvCellsForEdge), AdvCoefs(Mesh->AdvCoefs),
+      AdvCoefs3rd(Mesh->AdvCoefs3rd) {}
 
 void TracerAuxVars::registerFields(const std::string &AuxGroupName,
                                    const std::string &MeshName) const {
@@ -76,11 +83,11 @@ void TracerAuxVars::registerFields(const std::string &AuxGroupName,
                 AuxGroupName);
 
    // Attach data to fields
-   Err = HTracersEdgeField->attachData<Array3DReal>(HTracersOnEdge);
+   Err = HTracersEdgeField->attachData<Array3DAuxReal>(HTracersOnEdge);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", HTracersOnEdge.label());
 
-   Err = Del2TracersCellField->attachData<Array3DReal>(Del2TracersOnCell);
+   Err = Del2TracersCellField->attachData<Array3DAuxReal>(Del2TracersOnCell);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", Del2TracersOnCell.label());
 }
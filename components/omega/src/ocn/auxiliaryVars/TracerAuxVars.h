@@ -5,6 +5,7 @@
 #include "Field.h"
 #include "HorzMesh.h"
 #include "OmegaKokkos.h"
+#include "Pack.h"
 #include "auxiliaryVars/LayerThicknessAuxVars.h"
 
 #include <string>
@@ -13,79 +14,125 @@ namespace OMEGA {
 
 class TracerAuxVars {
  public:
-   Array3DReal HTracersOnEdge;
-   Array3DReal Del2TracersOnCell;
+   Array3DAuxReal HTracersOnEdge;
+   Array3DAuxReal Del2TracersOnCell;
 
    FluxThickEdgeOption TracersOnEdgeChoice = Center;
 
+   /// Weight of the 3rd-order upwind correction of the HighOrder option: 0
+   /// gives the 4th-order centered and 1 the 3rd-order upwind reconstruction
+   Real Coef3rdOrder = 0.25_Real;
+
+   /// Del2TracersOnCell is only allocated if AllocDel2 is true, since only
+   /// the tracer hyperdiffusion uses it
    TracerAuxVars(const std::string &AuxStateSuffix, const HorzMesh *Mesh,
-                 const I4 NVertLevels, const I4 NTracers);
+                 const I4 NVertLevels, const I4 NTracers,
+                 const bool AllocDel2 = true);
 
+   template <int W = VecLength>
    KOKKOS_FUNCTION void computeVarsOnEdge(int L, int IEdge, int KChunk,
                                           const Array2DReal &NormalVelEdge,
                                           const Array2DReal &HCell,
                                           const Array3DReal &TrCell) const {
-      const int KStart = KChunk * VecLength;
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, HTracersOnEdge);
       const int JCell0 = CellsOnEdge(IEdge, 0);
       const int JCell1 = CellsOnEdge(IEdge, 1);
 
+      const RealPack<W> HTr0 = loadPack<W>(HCell, KStart, KLen, JCell0) *
+                               loadPack<W>(TrCell, KStart, KLen, L, JCell0);
+      const RealPack<W> HTr1 = loadPack<W>(HCell, KStart, KLen, JCell1) *
+                               loadPack<W>(TrCell, KStart, KLen, L, JCell1);
+
       switch (TracersOnEdgeChoice) {
       case Center:
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K = KStart + KVec;
-            HTracersOnEdge(L, IEdge, K) =
-                0.5_Real * (HCell(JCell0, K) * TrCell(L, JCell0, K) +
-                            HCell(JCell1, K) * TrCell(L, JCell1, K));
-         }
+         storePack(HTracersOnEdge, 0.5_Real * (HTr0 + HTr1), KStart, KLen, L,
+                   IEdge);
+         break;
+      case Upwind: {
+         const RealPack<W> NormalVel =
+             loadPack<W>(NormalVelEdge, KStart, KLen, IEdge);
+         storePack(HTracersOnEdge,
+                   select(NormalVel > 0._Real, HTr0,
+                          select(NormalVel < 0._Real, HTr1, max(HTr0, HTr1))),
+                   KStart, KLen, L, IEdge);
          break;
-      case Upwind:
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K = KStart + KVec;
-            if (NormalVelEdge(IEdge, K) > 0) {
-               HTracersOnEdge(L, IEdge, K) =
-                   HCell(JCell0, K) * TrCell(L, JCell0, K);
-            } else if (NormalVelEdge(IEdge, K) < 0) {
-               HTracersOnEdge(L, IEdge, K) =
-                   HCell(JCell1, K) * TrCell(L, JCell1, K);
-            } else {
-               HTracersOnEdge(L, IEdge, K) =
-                   Kokkos::max(HCell(JCell0, K) * TrCell(L, JCell0, K),
-                               HCell(JCell1, K) * TrCell(L, JCell1, K));
-            }
+      }
+      case HighOrder: {
+         // Reconstruct the tracer on the edge from the precomputed stencil,
+         // blending the 4th-order centered value with its 3rd-order upwind
+         // correction, and weight it by the mean thickness on the edge
+         const RealPack<W> NormalVel =
+             loadPack<W>(NormalVelEdge, KStart, KLen, IEdge);
+         const RealPack<W> Sign =
+             select(NormalVel > 0._Real, RealPack<W>(1._Real),
+                    select(NormalVel < 0._Real, RealPack<W>(-1._Real),
+                           RealPack<W>(0._Real)));
+         RealPack<W> TrEdge;
+         for (int J = 0; J < NAdvCellsForEdge(IEdge); ++J) {
+            const int JCell     = AdvCellsForEdge(IEdge, J);
+            const Real Coef    = AdvCoefs(IEdge, J);
+            const Real Coef3rd = Coef3rdOrder * AdvCoefs3rd(IEdge, J);
+            TrEdge += (Coef + Coef3rd * Sign) *
+                      loadPack<W>(TrCell, KStart, KLen, L, JCell);
          }
+         const RealPack<W> MeanThick =
+             0.5_Real * (loadPack<W>(HCell, KStart, KLen, JCell0) +
+                         loadPack<W>(HCell, KStart, KLen, JCell1));
+         storePack(HTracersOnEdge, MeanThick * TrEdge, KStart, KLen, L, IEdge);
          break;
       }
+      }
    }
 
+   /// The mean edge thickness can be the stored array or its accessor from
+   /// the layer thickness auxiliary variables
+   template <int W = VecLength, class ThickArrayType>
    KOKKOS_FUNCTION void
    computeVarsOnCells(int L, int ICell, int KChunk,
-                      const Array2DReal &LayerThickEdgeMean,
+                      const ThickArrayType &LayerThickEdgeMean,
                       const Array3DReal &TrCell) const {
 
-      const int KStart       = KChunk * VecLength;
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, Del2TracersOnCell);
+
+      storePack(Del2TracersOnCell,
+                del2OnCell<W>(L, ICell, KStart, KLen, LayerThickEdgeMean,
+                              TrCell),
+                KStart, KLen, L, ICell);
+   }
+
+   /// Laplacian of a tracer on a cell for the KLen levels from KStart,
+   /// without storing it. Also used by the fused hyperdiffusion of the
+   /// tendencies, which keeps it in team scratch memory.
+   template <int W = VecLength, class ThickArrayType>
+   KOKKOS_FUNCTION RealPack<W>
+   del2OnCell(int L, int ICell, int KStart, int KLen,
+              const ThickArrayType &LayerThickEdgeMean,
+              const Array3DReal &TrCell) const {
+
       const Real InvAreaCell = 1._Real / AreaCell(ICell);
 
-      Real Del2TrCellTmp[VecLength] = {0};
+      RealPack<W> Del2TrCellTmp;
 
-      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
-         const int JEdge = EdgesOnCell(ICell, J);
+      for (int J = OffsetsOnCell(ICell); J < OffsetsOnCell(ICell + 1); ++J) {
+         const int JEdge = EdgesOnCellCSR(J);
 
          const int JCell0 = CellsOnEdge(JEdge, 0);
          const int JCell1 = CellsOnEdge(JEdge, 1);
 
          const Real DvDcEdge = DvEdge(JEdge) / DcEdge(JEdge);
-
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K           = KStart + KVec;
-            const Real TracerGrad = TrCell(L, JCell1, K) - TrCell(L, JCell0, K);
-            Del2TrCellTmp[KVec] -= EdgeSignOnCell(ICell, J) * DvDcEdge *
-                                   LayerThickEdgeMean(JEdge, K) * TracerGrad;
-         }
-      }
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K                    = KStart + KVec;
-         Del2TracersOnCell(L, ICell, K) = Del2TrCellTmp[KVec] * InvAreaCell;
+         const Real Del2Wgt  = EdgeSignOnCellCSR(J) * DvDcEdge;
+
+         const RealPack<W> TracerGrad =
+             loadPack<W>(TrCell, KStart, KLen, L, JCell1) -
+             loadPack<W>(TrCell, KStart, KLen, L, JCell0);
+         Del2TrCellTmp -= Del2Wgt *
+                          loadPack<W>(LayerThickEdgeMean, KStart, KLen, JEdge) *
+                          TracerGrad;
       }
+
+      return Del2TrCellTmp * InvAreaCell;
    }
 
    void registerFields(const std::string &AuxGroupName,
@@ -93,13 +140,17 @@ class TracerAuxVars {
    void unregisterFields() const;
 
  private:
-   Array1DI4 NEdgesOnCell;
-   Array2DI4 EdgesOnCell;
+   Array1DI4 OffsetsOnCell;
+   Array1DI4 EdgesOnCellCSR;
    Array2DI4 CellsOnEdge;
-   Array2DR8 EdgeSignOnCell;
+   Array1DR8 EdgeSignOnCellCSR;
    Array1DR8 DcEdge;
    Array1DR8 DvEdge;
    Array1DR8 AreaCell;
+   Array1DI4 NAdvCellsForEdge;
+   Array2DI4 AdvCellsForEdge;
+   Array2DR8 AdvCoefs;
+   Array2DR8 AdvCoefs3rd;
 };
 
 } // namespace OMEGA
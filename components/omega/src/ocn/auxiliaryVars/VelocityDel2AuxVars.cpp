@@ -8,22 +8,49 @@ namespace OMEGA {
 
 VelocityDel2AuxVars::VelocityDel2AuxVars(const std::string &AuxStateSuffix,
                                          const HorzMesh *Mesh, int NVertLevels)
-    : Del2Edge("VelDel2Edge" + AuxStateSuffix, Mesh->NEdgesSize, NVertLevels),
-      Del2DivCell("VelDel2DivCell" + AuxStateSuffix, Mesh->NCellsSize,
-                  NVertLevels),
-      Del2RelVortVertex("VelDel2RelVortVertex" + AuxStateSuffix,
-                        Mesh->NVerticesSize, NVertLevels),
-      NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      EdgeSignOnCell(Mesh->EdgeSignOnCell), DcEdge(Mesh->DcEdge),
-      DvEdge(Mesh->DvEdge), AreaCell(Mesh->AreaCell),
-      EdgesOnVertex(Mesh->EdgesOnVertex), CellsOnEdge(Mesh->CellsOnEdge),
-      VerticesOnEdge(Mesh->VerticesOnEdge),
-      EdgeSignOnVertex(Mesh->EdgeSignOnVertex),
-      AreaTriangle(Mesh->AreaTriangle), VertexDegree(Mesh->VertexDegree) {}
+    : Del2Edge(createFirstTouchArray<Array2DAuxReal>(
+          "VelDel2Edge" + AuxStateSuffix, Mesh->NEdgesSize, NVertLevels)),
+      Del2DivCell(createFirstTouchArray<Array2DAuxReal>(
+          "VelDel2DivCell" + AuxStateSuffix, Mesh->NCellsSize, NVertLevels)),
+      Del2RelVortVertex(createFirstTouchArray<Array2DAuxReal>(
+          "VelDel2RelVortVertex" + AuxStateSuffix, Mesh->NVerticesSize,
+          NVertLevels)),
+      OffsetsOnCell(Mesh->OffsetsOnCell), EdgesOnCellCSR(Mesh->EdgesOnCellCSR),
+      DivWeightsOnCellCSR(Mesh->DivWeightsOnCellCSR), DcEdge(Mesh->DcEdge),
+      DvEdge(Mesh->DvEdge), EdgesOnVertex(Mesh->EdgesOnVertex),
+      CellsOnEdge(Mesh->CellsOnEdge), VerticesOnEdge(Mesh->VerticesOnEdge),
+      CurlWeightsOnVertex(Mesh->CurlWeightsOnVertex),
+      VertexDegree(Mesh->VertexDegree), AuxStateSuffix(AuxStateSuffix),
+      NEdgesSize(Mesh->NEdgesSize), NCellsSize(Mesh->NCellsSize),
+      NVerticesSize(Mesh->NVerticesSize), NVertLevels(NVertLevels) {}
+
+void VelocityDel2AuxVars::setAllocated(bool Allocate) {
+
+   if (Allocate == Allocated)
+      return;
+   Allocated = Allocate;
+
+   if (Allocated) {
+      Del2Edge = createFirstTouchArray<Array2DAuxReal>(
+          "VelDel2Edge" + AuxStateSuffix, NEdgesSize, NVertLevels);
+      Del2DivCell = createFirstTouchArray<Array2DAuxReal>(
+          "VelDel2DivCell" + AuxStateSuffix, NCellsSize, NVertLevels);
+      Del2RelVortVertex = createFirstTouchArray<Array2DAuxReal>(
+          "VelDel2RelVortVertex" + AuxStateSuffix, NVerticesSize, NVertLevels);
+   } else {
+      Del2Edge          = Array2DAuxReal();
+      Del2DivCell       = Array2DAuxReal();
+      Del2RelVortVertex = Array2DAuxReal();
+   }
+}
 
 void VelocityDel2AuxVars::registerFields(const std::string &AuxGroupName,
                                          const std::string &MeshName) const {
 
+   // There is nothing to register if the arrays are not allocated
+   if (!Allocated)
+      return;
+
    int Err = 0; // Error flag for some calls
 
    // Create/define fields
@@ -98,20 +125,23 @@ void VelocityDel2AuxVars::registerFields(const std::string &AuxGroupName,
                 AuxGroupName);
 
    // Attach data to fields
-   Err = Del2EdgeField->attachData<Array2DReal>(Del2Edge);
+   Err = Del2EdgeField->attachData<Array2DAuxReal>(Del2Edge);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", Del2Edge.label());
 
-   Err = Del2DivCellField->attachData<Array2DReal>(Del2DivCell);
+   Err = Del2DivCellField->attachData<Array2DAuxReal>(Del2DivCell);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", Del2DivCell.label());
 
-   Err = Del2RelVortVertexField->attachData<Array2DReal>(Del2RelVortVertex);
+   Err = Del2RelVortVertexField->attachData<Array2DAuxReal>(Del2RelVortVertex);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", Del2RelVortVertex.label());
 }
 
 void VelocityDel2AuxVars::unregisterFields() const {
+   if (!Allocated)
+      return;
+
    int Err = 0;
 
    Err = Field::destroy(Del2Edge.label());
@@ -4,6 +4,7 @@
 #include "DataTypes.h"
 #include "HorzMesh.h"
 #include "OmegaKokkos.h"
+#include "Pack.h"
 
 #include <string>
 
@@ -11,18 +12,42 @@ namespace OMEGA {
 
 class VelocityDel2AuxVars {
  public:
-   Array2DReal Del2Edge;
-   Array2DReal Del2DivCell;
-   Array2DReal Del2RelVortVertex;
+   Array2DAuxReal Del2Edge;
+   Array2DAuxReal Del2DivCell;
+   Array2DAuxReal Del2RelVortVertex;
+
+   /// If false, the arrays are not allocated and the variables are not
+   /// computed since no tendency term uses them. Set with setAllocated.
+   bool Allocated = true;
 
    VelocityDel2AuxVars(const std::string &AuxStateSuffix, const HorzMesh *Mesh,
                        int NVertLevels);
 
+   /// Allocate or release the arrays. The fields must not be registered.
+   void setAllocated(bool Allocate);
+
+   template <int W = VecLength>
    KOKKOS_FUNCTION void
-   computeVarsOnEdge(int IEdge, int KChunk, const Array2DReal &VelocityDivCell,
-                     const Array2DReal &RelVortVertex) const {
-      const int KStart = KChunk * VecLength;
+   computeVarsOnEdge(int IEdge, int KChunk,
+                     const Array2DAuxReal &VelocityDivCell,
+                     const Array2DAuxReal &RelVortVertex) const {
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, Del2Edge);
+
+      storePack(Del2Edge,
+                del2OnEdge<W>(IEdge, KStart, KLen, VelocityDivCell,
+                              RelVortVertex),
+                KStart, KLen, IEdge);
+   }
 
+   /// Laplacian of the normal velocity on an edge for the KLen levels from
+   /// KStart, without storing it. Also used by the fused hyperdiffusion of
+   /// the tendencies, which keeps it in team scratch memory.
+   template <int W = VecLength>
+   KOKKOS_FUNCTION RealPack<W>
+   del2OnEdge(int IEdge, int KStart, int KLen,
+              const Array2DAuxReal &VelocityDivCell,
+              const Array2DAuxReal &RelVortVertex) const {
       const int JCell0   = CellsOnEdge(IEdge, 0);
       const int JCell1   = CellsOnEdge(IEdge, 1);
       const int JVertex0 = VerticesOnEdge(IEdge, 0);
@@ -32,60 +57,49 @@ class VelocityDel2AuxVars {
       const Real InvDvEdge =
           1._Real / Kokkos::max(DvEdge(IEdge), 0.25_Real * DcEdge(IEdge));
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K = KStart + KVec;
-         const Real GradDiv =
-             (VelocityDivCell(JCell1, K) - VelocityDivCell(JCell0, K)) *
-             InvDcEdge;
-         const Real CurlVort =
-             -(RelVortVertex(JVertex1, K) - RelVortVertex(JVertex0, K)) *
-             InvDvEdge;
-         Del2Edge(IEdge, K) = GradDiv + CurlVort;
-      }
+      const RealPack<W> GradDiv =
+          (loadPack<W>(VelocityDivCell, KStart, KLen, JCell1) -
+           loadPack<W>(VelocityDivCell, KStart, KLen, JCell0)) *
+          InvDcEdge;
+      const RealPack<W> CurlVort =
+          -(loadPack<W>(RelVortVertex, KStart, KLen, JVertex1) -
+            loadPack<W>(RelVortVertex, KStart, KLen, JVertex0)) *
+          InvDvEdge;
+
+      return GradDiv + CurlVort;
    }
 
+   template <int W = VecLength>
    KOKKOS_FUNCTION void computeVarsOnCell(int ICell, int KChunk) const {
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
-      const int KStart       = KChunk * VecLength;
-
-      Real Del2DivCellTmp[VecLength] = {0};
-
-      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
-         const int JEdge     = EdgesOnCell(ICell, J);
-         const Real AreaEdge = 0.5_Real * DvEdge(JEdge) * DcEdge(JEdge);
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K = KStart + KVec;
-            Del2DivCellTmp[KVec] -= DvEdge(JEdge) * InvAreaCell *
-                                    EdgeSignOnCell(ICell, J) *
-                                    Del2Edge(JEdge, K);
-         }
-      }
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K           = KStart + KVec;
-         Del2DivCell(ICell, K) = Del2DivCellTmp[KVec];
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, Del2DivCell);
+
+      RealPack<W> Del2DivCellTmp;
+
+      for (int J = OffsetsOnCell(ICell); J < OffsetsOnCell(ICell + 1); ++J) {
+         const int JEdge   = EdgesOnCellCSR(J);
+         const Real DivWgt = DivWeightsOnCellCSR(J);
+         Del2DivCellTmp -= DivWgt * loadPack<W>(Del2Edge, KStart, KLen, JEdge);
       }
+
+      storePack(Del2DivCell, Del2DivCellTmp, KStart, KLen, ICell);
    }
 
+   template <int W = VecLength>
    KOKKOS_FUNCTION void computeVarsOnVertex(int IVertex, int KChunk) const {
-      const int KStart           = KChunk * VecLength;
-      const Real InvAreaTriangle = 1._Real / AreaTriangle(IVertex);
+      const int KStart = KChunk * W;
+      const int KLen   = chunkLength<W>(KStart, Del2RelVortVertex);
 
-      Real Del2RelVortVertexTmp[VecLength] = {0};
+      RealPack<W> Del2RelVortVertexTmp;
 
       for (int J = 0; J < VertexDegree; ++J) {
-         const int JEdge = EdgesOnVertex(IVertex, J);
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K = KStart + KVec;
-            Del2RelVortVertexTmp[KVec] += InvAreaTriangle * DcEdge(JEdge) *
-                                          EdgeSignOnVertex(IVertex, J) *
-                                          Del2Edge(JEdge, K);
-         }
+         const int JEdge    = EdgesOnVertex(IVertex, J);
+         const Real CurlWgt = CurlWeightsOnVertex(IVertex, J);
+         Del2RelVortVertexTmp +=
+             CurlWgt * loadPack<W>(Del2Edge, KStart, KLen, JEdge);
       }
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K                   = KStart + KVec;
-         Del2RelVortVertex(IVertex, K) = Del2RelVortVertexTmp[KVec];
-      }
+      storePack(Del2RelVortVertex, Del2RelVortVertexTmp, KStart, KLen, IVertex);
    }
 
    void registerFields(const std::string &AuxGroupName,
@@ -93,18 +107,22 @@ class VelocityDel2AuxVars {
    void unregisterFields() const;
 
  private:
-   Array1DI4 NEdgesOnCell;
-   Array2DI4 EdgesOnCell;
-   Array2DR8 EdgeSignOnCell;
+   Array1DI4 OffsetsOnCell;
+   Array1DI4 EdgesOnCellCSR;
+   Array1DR8 DivWeightsOnCellCSR;
    Array1DR8 DcEdge;
    Array1DR8 DvEdge;
-   Array1DR8 AreaCell;
    Array2DI4 EdgesOnVertex;
    Array2DI4 CellsOnEdge;
    Array2DI4 VerticesOnEdge;
-   Array2DR8 EdgeSignOnVertex;
-   Array1DR8 AreaTriangle;
+   Array2DR8 CurlWeightsOnVertex;
    I4 VertexDegree;
+
+   std::string AuxStateSuffix;
+   I4 NEdgesSize;
+   I4 NCellsSize;
+   I4 NVerticesSize;
+   I4 NVertLevels;
 };
 
 } // namespace OMEGA
@@ -8,19 +8,22 @@ namespace OMEGA {
 
 VorticityAuxVars::VorticityAuxVars(const std::string &AuxStateSuffix,
                                    const HorzMesh *Mesh, int NVertLevels)
-    : RelVortVertex("RelVortVertex" + AuxStateSuffix, Mesh->NVerticesSize,
-                    NVertLevels),
-      NormRelVortVertex("NormRelVortVertex" + AuxStateSuffix,
-                        Mesh->NVerticesSize, NVertLevels),
-      NormPlanetVortVertex("NormPlanetVortVertex" + AuxStateSuffix,
-                           Mesh->NVerticesSize, NVertLevels),
-      NormRelVortEdge("NormRelVortEdge" + AuxStateSuffix, Mesh->NEdgesSize,
-                      NVertLevels),
-      NormPlanetVortEdge("NormPlanetVortEdge" + AuxStateSuffix,
-                         Mesh->NEdgesSize, NVertLevels),
+    : RelVortVertex(createFirstTouchArray<Array2DAuxReal>(
+          "RelVortVertex" + AuxStateSuffix, Mesh->NVerticesSize, NVertLevels)),
+      NormRelVortVertex(createFirstTouchArray<Array2DAuxReal>(
+          "NormRelVortVertex" + AuxStateSuffix, Mesh->NVerticesSize,
+          NVertLevels)),
+      NormPlanetVortVertex(createFirstTouchArray<Array2DAuxReal>(
+          "NormPlanetVortVertex" + AuxStateSuffix, Mesh->NVerticesSize,
+          NVertLevels)),
+      NormRelVortEdge(createFirstTouchArray<Array2DAuxReal>(
+          "NormRelVortEdge" + AuxStateSuffix, Mesh->NEdgesSize, NVertLevels)),
+      NormPlanetVortEdge(createFirstTouchArray<Array2DAuxReal>(
+          "NormPlanetVortEdge" + AuxStateSuffix, Mesh->NEdgesSize,
+          NVertLevels)),
       VertexDegree(Mesh->VertexDegree), CellsOnVertex(Mesh->CellsOnVertex),
       EdgesOnVertex(Mesh->EdgesOnVertex),
-      EdgeSignOnVertex(Mesh->EdgeSignOnVertex), DcEdge(Mesh->DcEdge),
+      CurlWeightsOnVertex(Mesh->CurlWeightsOnVertex),
       KiteAreasOnVertex(Mesh->KiteAreasOnVertex),
       AreaTriangle(Mesh->AreaTriangle), FVertex(Mesh->FVertex),
       VerticesOnEdge(Mesh->VerticesOnEdge) {}
@@ -141,25 +144,26 @@ void VorticityAuxVars::registerFields(const std::string &AuxGroupName,
                 AuxGroupName);
 
    // Attach data to fields
-   Err = RelVortVertexField->attachData<Array2DReal>(RelVortVertex);
+   Err = RelVortVertexField->attachData<Array2DAuxReal>(RelVortVertex);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", RelVortVertex.label());
 
-   Err = NormRelVortVertexField->attachData<Array2DReal>(NormRelVortVertex);
+   Err = NormRelVortVertexField->attachData<Array2DAuxReal>(NormRelVortVertex);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", NormRelVortVertex.label());
 
-   Err =
-       NormPlanetVortVertexField->attachData<Array2DReal>(NormPlanetVortVertex);
+   Err = NormPlanetVortVertexField->attachData<Array2DAuxReal>(
+       NormPlanetVortVertex);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}",
                 NormPlanetVortVertex.label());
 
-   Err = NormRelVortEdgeField->attachData<Array2DReal>(NormRelVortEdge);
+   Err = NormRelVortEdgeField->attachData<Array2DAuxReal>(NormRelVortEdge);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", NormRelVortEdge.label());
 
-   Err = NormPlanetVortEdgeField->attachData<Array2DReal>(NormPlanetVortEdge);
+   Err = NormPlanetVortEdgeField->attachData<Array2DAuxReal>(
+       NormPlanetVortEdge);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", NormPlanetVortEdge.label());
 }
@@ -4,6 +4,7 @@
 #include "DataTypes.h"
 #include "HorzMesh.h"
 #include "OmegaKokkos.h"
+#include "Pack.h"
 
 #include <string>
 
@@ -11,68 +12,70 @@ namespace OMEGA {
 
 class VorticityAuxVars {
  public:
-   Array2DReal RelVortVertex;
-   Array2DReal NormRelVortVertex;
-   Array2DReal NormPlanetVortVertex;
+   Array2DAuxReal RelVortVertex;
+   Array2DAuxReal NormRelVortVertex;
+   Array2DAuxReal NormPlanetVortVertex;
 
-   Array2DReal NormRelVortEdge;
-   Array2DReal NormPlanetVortEdge;
+   Array2DAuxReal NormRelVortEdge;
+   Array2DAuxReal NormPlanetVortEdge;
 
    VorticityAuxVars(const std::string &AuxStateSuffix, const HorzMesh *Mesh,
                     int NVertLevels);
 
+   template <int W = VecLength>
    KOKKOS_FUNCTION void
    computeVarsOnVertex(int IVertex, int KChunk,
                        const Array2DReal &LayerThickCell,
                        const Array2DReal &NormalVelEdge) const {
-      const int KStart           = KChunk * VecLength;
+      const int KStart           = KChunk * W;
+      const int KLen             = chunkLength<W>(KStart, RelVortVertex);
       const Real InvAreaTriangle = 1._Real / AreaTriangle(IVertex);
 
-      Real LayerThickVertex[VecLength] = {0};
-      Real RelVortVertexTmp[VecLength] = {0};
+      RealPack<W> LayerThickVertex;
+      RealPack<W> RelVortVertexTmp;
 
       for (int J = 0; J < VertexDegree; ++J) {
-         const int JCell = CellsOnVertex(IVertex, J);
-         const int JEdge = EdgesOnVertex(IVertex, J);
-
-         for (int KVec = 0; KVec < VecLength; ++KVec) {
-            const int K = KStart + KVec;
-            LayerThickVertex[KVec] += InvAreaTriangle *
-                                      KiteAreasOnVertex(IVertex, J) *
-                                      LayerThickCell(JCell, K);
-            RelVortVertexTmp[KVec] += InvAreaTriangle * DcEdge(JEdge) *
-                                      EdgeSignOnVertex(IVertex, J) *
-                                      NormalVelEdge(JEdge, K);
-         }
+         const int JCell    = CellsOnVertex(IVertex, J);
+         const int JEdge    = EdgesOnVertex(IVertex, J);
+         const Real KiteWgt = InvAreaTriangle * KiteAreasOnVertex(IVertex, J);
+         const Real CurlWgt = CurlWeightsOnVertex(IVertex, J);
+
+         LayerThickVertex +=
+             KiteWgt * loadPack<W>(LayerThickCell, KStart, KLen, JCell);
+         RelVortVertexTmp +=
+             CurlWgt * loadPack<W>(NormalVelEdge, KStart, KLen, JEdge);
       }
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K                    = KStart + KVec;
-         const Real InvLayerThickVertex = 1._Real / LayerThickVertex[KVec];
+      // Lanes past the last level hold a zero thickness, so their inverse is
+      // not finite, but they are never stored
+      const RealPack<W> InvLayerThickVertex = 1._Real / LayerThickVertex;
+      const Real FVert                      = FVertex(IVertex);
 
-         RelVortVertex(IVertex, K) = RelVortVertexTmp[KVec];
-         NormRelVortVertex(IVertex, K) =
-             RelVortVertexTmp[KVec] * InvLayerThickVertex;
-         NormPlanetVortVertex(IVertex, K) =
-             FVertex(IVertex) * InvLayerThickVertex;
-      }
+      storePack(RelVortVertex, RelVortVertexTmp, KStart, KLen, IVertex);
+      storePack(NormRelVortVertex, RelVortVertexTmp * InvLayerThickVertex,
+                KStart, KLen, IVertex);
+      storePack(NormPlanetVortVertex, FVert * InvLayerThickVertex, KStart,
+                KLen, IVertex);
    }
 
+   template <int W = VecLength>
    KOKKOS_FUNCTION void computeVarsOnEdge(int IEdge, int KChunk) const {
-      const int KStart   = KChunk * VecLength;
+      const int KStart   = KChunk * W;
+      const int KLen     = chunkLength<W>(KStart, NormRelVortEdge);
       const int JVertex0 = VerticesOnEdge(IEdge, 0);
       const int JVertex1 = VerticesOnEdge(IEdge, 1);
 
-      for (int KVec = 0; KVec < VecLength; ++KVec) {
-         const int K = KStart + KVec;
-         NormRelVortEdge(IEdge, K) =
-             0.5_Real *
-             (NormRelVortVertex(JVertex0, K) + NormRelVortVertex(JVertex1, K));
-
-         NormPlanetVortEdge(IEdge, K) =
-             0.5_Real * (NormPlanetVortVertex(JVertex0, K) +
-                         NormPlanetVortVertex(JVertex1, K));
-      }
+      storePack(NormRelVortEdge,
+                0.5_Real *
+                    (loadPack<W>(NormRelVortVertex, KStart, KLen, JVertex0) +
+                     loadPack<W>(NormRelVortVertex, KStart, KLen, JVertex1)),
+                KStart, KLen, IEdge);
+
+      storePack(NormPlanetVortEdge,
+                0.5_Real *
+                    (loadPack<W>(NormPlanetVortVertex, KStart, KLen, JVertex0) +
+                     loadPack<W>(NormPlanetVortVertex, KStart, KLen, JVertex1)),
+                KStart, KLen, IEdge);
    }
 
    void registerFields(const std::string &AuxGroupName,
@@ -83,8 +86,7 @@ class VorticityAuxVars {
    I4 VertexDegree;
    Array2DI4 CellsOnVertex;
    Array2DI4 EdgesOnVertex;
-   Array2DR8 EdgeSignOnVertex;
-   Array1DR8 DcEdge;
+   Array2DR8 CurlWeightsOnVertex;
    Array2DR8 KiteAreasOnVertex;
    Array1DR8 AreaTriangle;
    Array2DI4 VerticesOnEdge;
@@ -1,4 +1,5 @@
 #include "ForwardBackwardStepper.h"
+#include "Tracers.h"
 
 namespace OMEGA {
 
@@ -17,9 +18,22 @@ void ForwardBackwardStepper::doStep(OceanState *State, TimeInstant Time) const {
    const int CurLevel  = 0;
    const int NextLevel = 1;
 
+   Array3DReal TracersCur;
+   Array3DReal TracersNext;
+   const bool AdvanceTracers = getTracerArrays(TracersCur, TracersNext);
+
    // R_h^{n} = RHS_h(u^{n}, h^{n}, t^{n})
    Tend->computeThicknessTendencies(State, AuxState, CurLevel, CurLevel, Time);
 
+   if (AdvanceTracers) {
+      // R_phi^{n} = RHS_phi(u^{n}, h^{n}, phi^{n}, t^{n})
+      Tend->computeTracerTendencies(State, AuxState, TracersCur, CurLevel,
+                                    CurLevel, Time);
+
+      // phi^{n+1} = (h^{n} * phi^{n} + dt * R_phi^{n}) / h^{n+1}
+      updateTracersByTend(TracersNext, State, CurLevel, TracersCur, TimeStep);
+   }
+
    // h^{n+1} = h^{n} + R_h^{n}
    updateThicknessByTend(State, NextLevel, State, CurLevel, TimeStep);
 
@@ -30,8 +44,13 @@ void ForwardBackwardStepper::doStep(OceanState *State, TimeInstant Time) const {
    updateVelocityByTend(State, NextLevel, State, CurLevel, TimeStep);
 
    // Update time levels (New -> Old) of prognostic variables with halo
-   // exchanges
-   State->updateTimeLevels();
+   // exchanges. The next step evaluates the thickness tendencies and then the
+   // velocity tendencies using the updated thickness, so the halo must be
+   // valid for two tendency evaluations.
+   State->updateTimeLevels(getRequiredHaloDepth(2));
+   if (AdvanceTracers) {
+      updateTracerTimeLevels(State, getRequiredHaloDepth(2));
+   }
 }
 
 } // namespace OMEGA
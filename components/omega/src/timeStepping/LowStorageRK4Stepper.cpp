@@ -0,0 +1,106 @@
+#include "LowStorageRK4Stepper.h"
+#include "Tracers.h"
+
+namespace OMEGA {
+
+// Constructor. Construct a low-storage fourth order Runge Kutta stepper from
+// name, tendencies, auxiliary state, mesh, and halo
+LowStorageRK4Stepper::LowStorageRK4Stepper(const std::string &Name,
+                                           Tendencies *Tend,
+                                           AuxiliaryState *AuxState,
+                                           HorzMesh *Mesh, Halo *MeshHalo)
+    : TimeStepper(Name, TimeStepperType::LowStorageRK4, 2, Tend, AuxState,
+                  Mesh, MeshHalo) {
+
+   // Coefficients of the five-stage fourth order scheme of Carpenter and
+   // Kennedy (1994), solution 3
+   RKA[0] = 0;
+   RKA[1] = -567301805773. / 1357537059087;
+   RKA[2] = -2404267990393. / 2016746695238;
+   RKA[3] = -3550918686646. / 2091501179385;
+   RKA[4] = -1275806237668. / 842570457699;
+
+   RKB[0] = 1432997174477. / 9575080441755;
+   RKB[1] = 5161836677717. / 13612068292357;
+   RKB[2] = 1720146321549. / 2090206949498;
+   RKB[3] = 3134564353537. / 4481467310338;
+   RKB[4] = 2277821191437. / 14882151754819;
+
+   RKC[0] = 0;
+   RKC[1] = 1432997174477. / 9575080441755;
+   RKC[2] = 2526269341429. / 6820363962896;
+   RKC[3] = 2006345519317. / 3224310063776;
+   RKC[4] = 2802321613138. / 2924317926251;
+}
+
+// Recompute the stage time offsets if the time step has changed
+void LowStorageRK4Stepper::updateStageIntervals() const {
+   if (StageTimeStep == TimeStep)
+      return;
+
+   StageTimeStep = TimeStep;
+   for (int Stage = 0; Stage < NStages; ++Stage)
+      RKCDt[Stage] = RKC[Stage] * TimeStep;
+}
+
+// Advance the state by one step of the low-storage Runge Kutta scheme
+void LowStorageRK4Stepper::doStep(OceanState *State, TimeInstant Time) const {
+
+   updateStageIntervals();
+
+   const int CurLevel  = 0;
+   const int NextLevel = 1;
+
+   // The state and the accumulator are exchanged together every two stages
+   // and at the end of the step, each exchange must be deep enough for two
+   // stages
+   const I4 HaloDepth = getRequiredHaloDepth(2);
+
+   // Every stage does:
+   // R^{(s)} = RHS(q, t^{n} + RKC[stage] * dt)
+   // dq = RKA[stage] * dq + dt * R^{(s)}
+   // q = q + RKB[stage] * dq
+   // where q is kept in the current level and dq in the next level. The last
+   // stage writes the new state into the next level in place of dq. The
+   // tracers, if initialized, follow the same scheme in thickness-weighted
+   // form with their increments kept in the next tracer time level.
+   Array3DReal TracersCur;
+   Array3DReal TracersNext;
+   const bool AdvanceTracers = getTracerArrays(TracersCur, TracersNext);
+
+   for (int Stage = 0; Stage < NStages; ++Stage) {
+      const TimeInstant StageTime = Time + RKCDt[Stage];
+
+      if (Stage == 2 || Stage == 4) {
+         State->exchangeHalo(CurLevel, HaloDepth);
+         State->exchangeHalo(NextLevel, HaloDepth);
+         if (AdvanceTracers) {
+            Tracers::exchangeHalo(CurLevel, HaloDepth);
+            Tracers::exchangeHalo(NextLevel, HaloDepth);
+         }
+      }
+
+      Tend->computeAllTendencies(State, AuxState, CurLevel, CurLevel,
+                                 StageTime);
+      if (AdvanceTracers) {
+         Tend->computeTracerTendencies(State, AuxState, TracersCur, CurLevel,
+                                       CurLevel, StageTime);
+      }
+
+      const int OutLevel = Stage < NStages - 1 ? CurLevel : NextLevel;
+      const Array3DReal &TracersOut =
+          Stage < NStages - 1 ? TracersCur : TracersNext;
+      updateStateByTend(State, OutLevel, State, CurLevel, State, NextLevel,
+                        RKA[Stage], RKB[Stage], TimeStep, TracersOut,
+                        TracersCur, TracersNext);
+   }
+
+   // Update time levels (New -> Old) of prognostic variables with halo
+   // exchanges
+   State->updateTimeLevels(HaloDepth);
+   if (AdvanceTracers) {
+      updateTracerTimeLevels(State, HaloDepth);
+   }
+}
+
+} // namespace OMEGA
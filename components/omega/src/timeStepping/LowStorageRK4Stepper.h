@@ -0,0 +1,51 @@
+#ifndef OMEGA_TSLSRK4_H
+#define OMEGA_TSLSRK4_H
+//===-- timeStepping/LowStorageRK4Stepper.h - low-storage Runge Kutta time
+// stepper --------------------*- C++
+//-*-===//
+//
+/// \file
+/// \brief Contains the class for a low-storage fourth order Runge Kutta scheme
+///
+/// The five-stage, fourth order 2N-storage scheme of Carpenter and Kennedy
+/// (1994) only needs two registers per prognostic variable. The state is
+/// advanced in place in the current time level, while the next time level
+/// holds the accumulated stage increments, so no provisional state is needed.
+//===----------------------------------------------------------------------===//
+
+#include "TimeStepper.h"
+
+namespace OMEGA {
+
+class LowStorageRK4Stepper : public TimeStepper {
+ public:
+   // Constructor. Construct a low-storage fourth order Runge Kutta stepper
+   // from name, tendencies, auxiliary state, mesh, and halo
+   LowStorageRK4Stepper(const std::string &Name, Tendencies *Tend,
+                        AuxiliaryState *AuxState, HorzMesh *Mesh,
+                        Halo *MeshHalo);
+
+   // Advance the state by one step of the low-storage Runge Kutta scheme
+   void doStep(OceanState *State, TimeInstant Time) const override;
+
+ private:
+   // Number of stages
+   static constexpr int NStages = 5;
+
+   // Runge-Kutta coefficients
+   Real RKA[NStages];
+   Real RKB[NStages];
+   Real RKC[NStages];
+
+   // Stage time offsets, the products of RKC with the time step. Multiplying
+   // a time interval by a real number converts the number to a fraction, so
+   // the offsets are only recomputed when the time step changes.
+   mutable TimeInterval StageTimeStep;
+   mutable TimeInterval RKCDt[NStages];
+
+   // Recompute the stage time offsets if the time step has changed
+   void updateStageIntervals() const;
+};
+
+} // namespace OMEGA
+#endif
@@ -1,4 +1,5 @@
 #include "RungeKutta2Stepper.h"
+#include "Tracers.h"
 
 namespace OMEGA {
 
@@ -17,23 +18,44 @@ void RungeKutta2Stepper::doStep(OceanState *State, TimeInstant Time) const {
    const int CurLevel  = 0;
    const int NextLevel = 1;
 
-   // q = (h,u)
-   // R_q^{n} = RHS_q(u^{n}, h^{n}, t^{n})
+   // The tracers are advanced with the state in thickness-weighted form if
+   // they have been initialized, otherwise the tracer arrays are empty and
+   // only the layer thickness and normal velocity are updated
+   Array3DReal TracersCur;
+   Array3DReal TracersNext;
+   const bool AdvanceTracers = getTracerArrays(TracersCur, TracersNext);
+
+   // q = (h,u,h*phi)
+   // R_q^{n} = RHS_q(u^{n}, h^{n}, phi^{n}, t^{n})
    Tend->computeAllTendencies(State, AuxState, CurLevel, CurLevel, Time);
+   if (AdvanceTracers) {
+      Tend->computeTracerTendencies(State, AuxState, TracersCur, CurLevel,
+                                    CurLevel, Time);
+   }
 
    // q^{n+0.5} = q^{n} + 0.5*dt*R_q^{n}
-   updateStateByTend(State, NextLevel, State, CurLevel, 0.5 * TimeStep);
-
-   // R_q^{n+0.5} = RHS_q(u^{n+0.5}, h^{n+0.5}, t^{n+0.5})
-   Tend->computeAllTendencies(State, AuxState, NextLevel, NextLevel,
-                              Time + 0.5 * TimeStep);
+   const TimeInterval HalfTimeStep = TimeStep / 2;
+   updateStateByTendFused(State, NextLevel, TracersNext, State, CurLevel,
+                          TracersCur, Tend->TracerTend, HalfTimeStep);
+
+   // R_q^{n+0.5} = RHS_q(u^{n+0.5}, h^{n+0.5}, phi^{n+0.5}, t^{n+0.5})
+   const TimeInstant HalfTime = Time + HalfTimeStep;
+   Tend->computeAllTendencies(State, AuxState, NextLevel, NextLevel, HalfTime);
+   if (AdvanceTracers) {
+      Tend->computeTracerTendencies(State, AuxState, TracersNext, NextLevel,
+                                    NextLevel, HalfTime);
+   }
 
    // q^{n+1} = q^{n} + dt*R_q^{n+0.5}
-   updateStateByTend(State, NextLevel, State, CurLevel, TimeStep);
+   updateStateByTendFused(State, NextLevel, TracersNext, State, CurLevel,
+                          TracersCur, Tend->TracerTend, TimeStep);
 
    // Update time levels (New -> Old) of prognostic variables with halo
    // exchanges
    State->updateTimeLevels();
+   if (AdvanceTracers) {
+      updateTracerTimeLevels(State, 0);
+   }
 }
 
 } // namespace OMEGA
@@ -1,4 +1,5 @@
 #include "RungeKutta4Stepper.h"
+#include "Tracers.h"
 
 namespace OMEGA {
 
@@ -31,45 +32,154 @@ RungeKutta4Stepper::RungeKutta4Stepper(const std::string &Name,
    RKC[3] = 1;
 }
 
+// Recompute the products of the coefficients with the time step if the time
+// step has changed
+void RungeKutta4Stepper::updateStageIntervals() const {
+   if (StageTimeStep == TimeStep)
+      return;
+
+   StageTimeStep = TimeStep;
+   for (int Stage = 0; Stage < NStages; ++Stage) {
+      RKADt[Stage] = RKA[Stage] * TimeStep;
+      RKBDt[Stage] = RKB[Stage] * TimeStep;
+      RKCDt[Stage] = RKC[Stage] * TimeStep;
+   }
+}
+
 // Advance the state by one step of the fourth-order Runge Kutta scheme
 void RungeKutta4Stepper::doStep(OceanState *State, TimeInstant Time) const {
 
+   updateStageIntervals();
+
    const int CurLevel  = 0;
    const int NextLevel = 1;
 
-   for (int Stage = 0; Stage < NStages; ++Stage) {
-      const TimeInstant StageTime = Time + RKC[Stage] * TimeStep;
-      // first stage does:
-      // R^{(0)} = RHS(q^{n}, t^{n})
-      // q^{n+1} = q^{n} + dt * RKB[0] * dt * R^{(0)}
+   // The provisional state is exchanged at stage 2 and the full state at the
+   // end of the step, each exchange must be deep enough for two stages. In
+   // the communication-avoiding mode only the full state is exchanged, deep
+   // enough for all four stages, and each stage is computed on a halo that is
+   // narrower by the stencil depth of the tendencies.
+   const I4 WideHaloDepth = getCommAvoidingHaloDepth(NStages);
+   const bool AvoidComm   = WideHaloDepth > 0;
+   const I4 StencilDepth  = Tend->getStencilHaloDepth(AuxState);
+   const I4 HaloDepth     = AvoidComm ? WideHaloDepth : getRequiredHaloDepth(2);
+
+   // The tracers are advanced in thickness-weighted form with the same stages
+   // if they have been initialized, otherwise all tracer arrays are empty
+   Array3DReal TracersCur;
+   Array3DReal TracersNext;
+   const bool AdvanceTracers = getTracerArrays(TracersCur, TracersNext);
+   if (AdvanceTracers &&
+       ProvisTracers.extent_int(0) != TracersCur.extent_int(0)) {
+      ProvisTracers = createFirstTouchArray<Array3DReal>(
+          "ProvisTracers", TracersCur.extent_int(0), TracersCur.extent_int(1),
+          TracersCur.extent_int(2));
+   }
+   const Array3DReal StageTracers =
+       AdvanceTracers ? ProvisTracers : Array3DReal();
+   const Array3DAuxReal &TracerTend = Tend->TracerTend;
+
+   // Sets the halo of a stage in the communication-avoiding mode and, for
+   // every stage but the first, computes the provisional state
+   // q^{provis} = q^{n} + RKA[stage] * dt * R^{(s-1)}
+   auto startStage = [&](int Stage) {
+      if (AvoidComm) {
+         setComputeHaloDepth(WideHaloDepth - Stage * StencilDepth);
+      }
+      if (Stage == 3) {
+         // The stage 2 accumulation into q^{n+1} is deferred and fused with
+         // the provisional state update, which reads the same tendencies
+         updateStateByTendFused(ProvisState, CurLevel, StageTracers, State,
+                                CurLevel, TracersCur, TracerTend,
+                                RKADt[Stage], State, NextLevel, TracersNext,
+                                RKBDt[Stage - 1]);
+      } else if (Stage > 0) {
+         updateStateByTendFused(ProvisState, CurLevel, StageTracers, State,
+                                CurLevel, TracersCur, TracerTend,
+                                RKADt[Stage]);
+      }
+   };
+
+   // The accumulation of the stage 1 tendency into q^{n+1} does not depend
+   // on the provisional state, so it is overlapped with the provisional state
+   // halo exchange of stage 2
+   auto accumulateStage1 = [&]() {
+      updateStateByTendFused(State, NextLevel, TracersNext, State, NextLevel,
+                             TracersNext, TracerTend, RKBDt[1]);
+   };
+
+   // Computes the tendencies of a stage, R^{(s)} = RHS(q^{provis}, t^{n} +
+   // RKC[stage] * dt) with q^{provis} = q^{n} for the first stage, and
+   // accumulates them into q^{n+1} += RKB[stage] * dt * R^{(s)} for the first
+   // and last stages. The stage 1 and 2 accumulations are deferred to the
+   // following stage (see above).
+   auto finishStage = [&](int Stage) {
+      const TimeInstant StageTime = Time + RKCDt[Stage];
+      OceanState *StageState      = Stage == 0 ? State : ProvisState;
+      const Array3DReal &StageTracersIn =
+          Stage == 0 ? TracersCur : ProvisTracers;
+
+      Tend->computeAllTendencies(StageState, AuxState, CurLevel, CurLevel,
+                                 StageTime);
+      if (AdvanceTracers) {
+         Tend->computeTracerTendencies(StageState, AuxState, StageTracersIn,
+                                       CurLevel, CurLevel, StageTime);
+      }
+
       if (Stage == 0) {
-         Tend->computeAllTendencies(State, AuxState, CurLevel, CurLevel,
-                                    StageTime);
-         updateStateByTend(State, NextLevel, State, CurLevel,
-                           RKB[Stage] * TimeStep);
-      } else {
-         // every other stage does:
-         // q^{provis} = q^{n} + RKA[stage] * dt * R^{(s-1)}
-         // R^{(s)} = RHS(q^{provis}, t^{n} + RKC[stage] * dt)
-         // q^{n+1} += RKB[stage] * dt * R^{(s)}
-         updateStateByTend(ProvisState, CurLevel, State, CurLevel,
-                           RKA[Stage] * TimeStep);
-
-         // TODO(mwarusz) this depends on halo width actually
-         if (Stage == 2) {
-            ProvisState->exchangeHalo(CurLevel);
-         }
-
-         Tend->computeAllTendencies(ProvisState, AuxState, CurLevel, CurLevel,
-                                    StageTime);
-         updateStateByTend(State, NextLevel, State, NextLevel,
-                           RKB[Stage] * TimeStep);
+         updateStateByTendFused(State, NextLevel, TracersNext, State, CurLevel,
+                                TracersCur, TracerTend, RKBDt[Stage]);
+      } else if (Stage == NStages - 1) {
+         updateStateByTendFused(State, NextLevel, TracersNext, State,
+                                NextLevel, TracersNext, TracerTend,
+                                RKBDt[Stage]);
       }
+   };
+
+   // The stages are split into the kernels before, during and after the
+   // provisional state halo exchange of stage 2. Each segment is launched as
+   // one kernel graph in the kernel graph mode.
+   auto stagesBeforeExchange = [&]() {
+      for (int Stage = 0; Stage < 2; ++Stage) {
+         startStage(Stage);
+         finishStage(Stage);
+      }
+      startStage(2);
+   };
+   auto stagesAfterExchange = [&]() {
+      finishStage(2);
+      startStage(3);
+      finishStage(3);
+   };
+
+   if (AvoidComm) {
+      // The halo is wide enough for the whole step, so all stages are
+      // computed without an exchange
+      runKernels(3, State, TracersCur, [&]() {
+         stagesBeforeExchange();
+         accumulateStage1();
+         stagesAfterExchange();
+      });
+      setComputeHaloDepth(FullHalo);
+   } else {
+      // The provisional state halo is refreshed once every two stages, to
+      // the depth needed by the tendency stencils for two stages
+      runKernels(0, State, TracersCur, stagesBeforeExchange);
+      ProvisState->startExchangeHalo(CurLevel, HaloDepth);
+      runKernels(1, State, TracersCur, accumulateStage1);
+      ProvisState->finishExchangeHalo(CurLevel);
+      if (AdvanceTracers) {
+         MeshHalo->exchangeFullArrayHalo(ProvisTracers, OnCell, HaloDepth);
+      }
+      runKernels(2, State, TracersCur, stagesAfterExchange);
    }
 
    // Update time levels (New -> Old) of prognostic variables with halo
    // exchanges
-   State->updateTimeLevels();
+   State->updateTimeLevels(HaloDepth);
+   if (AdvanceTracers) {
+      updateTracerTimeLevels(State, HaloDepth);
+   }
 }
 
 } // namespace OMEGA
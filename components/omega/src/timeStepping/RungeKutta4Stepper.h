@@ -29,10 +29,25 @@ class RungeKutta4Stepper : public TimeStepper {
    // Provisional state
    OceanState *ProvisState;
 
+   // Provisional tracers, allocated on the first step that advances tracers
+   // since the tracers are initialized after the time stepper
+   mutable Array3DReal ProvisTracers;
+
    // Runge-Kutta coefficients
    Real RKA[NStages];
    Real RKB[NStages];
    Real RKC[NStages];
+
+   // Products of the coefficients with the time step. Multiplying a time
+   // interval by a real number converts the number to a fraction, so the
+   // products are only recomputed when the time step changes.
+   mutable TimeInterval StageTimeStep;
+   mutable TimeInterval RKADt[NStages];
+   mutable TimeInterval RKBDt[NStages];
+   mutable TimeInterval RKCDt[NStages];
+
+   // Recompute the products if the time step has changed
+   void updateStageIntervals() const;
 };
 
 } // namespace OMEGA
@@ -0,0 +1,382 @@
+#include "SplitExplicitStepper.h"
+#include "Config.h"
+#include "Timer.h"
+#include "Tracers.h"
+
+#include <algorithm>
+
+namespace OMEGA {
+
+// Constructor. Construct a split-explicit stepper from
+// name, tendencies, auxiliary state, mesh, and halo
+SplitExplicitStepper::SplitExplicitStepper(const std::string &Name,
+                                           Tendencies *Tend,
+                                           AuxiliaryState *AuxState,
+                                           HorzMesh *Mesh, Halo *MeshHalo)
+    : TimeStepper(Name, TimeStepperType::SplitExplicit, 2, Tend, AuxState,
+                  Mesh, MeshHalo) {
+
+   auto NVertLevels = Tend->LayerThicknessTend.extent_int(1);
+
+   ProvisState =
+       OceanState::create("Provis" + Name, Mesh, MeshHalo, NVertLevels, 1);
+
+   HaloWidth = Mesh->NCellsHaloH.extent_int(0);
+
+   const I4 NCells = Mesh->NCellsSize;
+   const I4 NEdges = Mesh->NEdgesSize;
+
+   SshCur  = createFirstTouchArray<Array1DReal>("SshCur", NCells);
+   SshEval = createFirstTouchArray<Array1DReal>("SshEval", NCells);
+   SshBtr  = createFirstTouchArray<Array1DReal>("SshBtr", NCells);
+
+   NormalVelBtrCur =
+       createFirstTouchArray<Array1DReal>("NormalVelBtrCur", NEdges);
+   ThickEdgeCur = createFirstTouchArray<Array1DReal>("ThickEdgeCur", NEdges);
+   MeanVelTend  = createFirstTouchArray<Array1DReal>("MeanVelTend", NEdges);
+   BtrForcing   = createFirstTouchArray<Array1DReal>("BtrForcing", NEdges);
+   NormalVelBtr = createFirstTouchArray<Array1DReal>("NormalVelBtr", NEdges);
+   BtrFlux      = createFirstTouchArray<Array1DReal>("BtrFlux", NEdges);
+   BtrFluxAvg   = createFirstTouchArray<Array1DReal>("BtrFluxAvg", NEdges);
+
+   // Retrieve the optional split-explicit options from the TimeIntegration
+   // group of the Config, the defaults are used otherwise
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("TimeIntegration")) {
+      Config TimeIntConfig("TimeIntegration");
+      OmegaConfig->get(TimeIntConfig);
+      if (TimeIntConfig.existsVar("BarotropicSubcycles")) {
+         I4 InNSubcycles;
+         if (TimeIntConfig.get("BarotropicSubcycles", InNSubcycles) == 0) {
+            setNBarotropicSubcycles(InNSubcycles);
+         } else {
+            LOG_ERROR("SplitExplicitStepper: error reading "
+                      "BarotropicSubcycles from TimeIntegration Config");
+         }
+      }
+      if (TimeIntConfig.existsVar("BaroclinicIterations")) {
+         I4 InNIterations;
+         if (TimeIntConfig.get("BaroclinicIterations", InNIterations) == 0) {
+            setNBaroclinicIterations(InNIterations);
+         } else {
+            LOG_ERROR("SplitExplicitStepper: error reading "
+                      "BaroclinicIterations from TimeIntegration Config");
+         }
+      }
+   }
+}
+
+// Set the number of barotropic subcycles per time step
+void SplitExplicitStepper::setNBarotropicSubcycles(I4 InNSubcycles) {
+   if (InNSubcycles < 1) {
+      LOG_ERROR("SplitExplicitStepper: number of barotropic subcycles must be "
+                "positive but got {}, keeping {}",
+                InNSubcycles, NBarotropicSubcycles);
+      return;
+   }
+   NBarotropicSubcycles = InNSubcycles;
+}
+
+// Set the number of baroclinic iterations per time step
+void SplitExplicitStepper::setNBaroclinicIterations(I4 InNIterations) {
+   if (InNIterations < 1) {
+      LOG_ERROR("SplitExplicitStepper: number of baroclinic iterations must be "
+                "positive but got {}, keeping {}",
+                InNIterations, NBaroclinicIterations);
+      return;
+   }
+   NBaroclinicIterations = InNIterations;
+}
+
+// Compute the barotropic forcing from the velocity tendencies of the state at
+// EvalLevel. The forcing is the thickness-weighted vertical mean of the
+// velocity tendency with the barotropic pressure gradient of the evaluated
+// state removed, because that part is integrated by the subcycles. The
+// tendencies must have been computed for the same state, so that the layer
+// thickness on edges in the auxiliary state is the one of the evaluated state.
+void SplitExplicitStepper::computeBarotropicForcing(const OceanState *EvalState,
+                                                    int EvalLevel,
+                                                    bool FirstIter) const {
+
+   const auto &LayerThickCell = EvalState->LayerThickness[EvalLevel];
+   const auto &NormalVelEdge  = EvalState->NormalVelocity[EvalLevel];
+   const auto &NormalVelTend  = Tend->NormalVelocityTend;
+   const auto &ThickEdge      = AuxState->LayerThicknessAux.FluxLayerThickEdge;
+   const int NVertLevels      = NormalVelTend.extent_int(1);
+
+   const auto &BottomDepth = Mesh->BottomDepth;
+   const auto &CellsOnEdge = Mesh->CellsOnEdge;
+   const auto &DcEdge      = Mesh->DcEdge;
+
+   OMEGA_SCOPE(LocSshCur, SshCur);
+   OMEGA_SCOPE(LocSshEval, SshEval);
+   OMEGA_SCOPE(LocNormalVelBtrCur, NormalVelBtrCur);
+   OMEGA_SCOPE(LocThickEdgeCur, ThickEdgeCur);
+   OMEGA_SCOPE(LocMeanVelTend, MeanVelTend);
+   OMEGA_SCOPE(LocBtrForcing, BtrForcing);
+
+   const Real Grav = Tend->SSHGrad.Enabled ? Tend->SSHGrad.Grav : 0;
+
+   // Sea surface height from the total thickness of each column
+   parallelFor(
+       "computeSshEval", {Mesh->NCellsAll}, KOKKOS_LAMBDA(int ICell) {
+          Real ColThick = 0;
+          for (int K = 0; K < NVertLevels; ++K) {
+             ColThick += LayerThickCell(ICell, K);
+          }
+          LocSshEval(ICell) = ColThick - BottomDepth(ICell);
+          if (FirstIter) {
+             LocSshCur(ICell) = LocSshEval(ICell);
+          }
+       });
+
+   parallelFor(
+       "computeBtrForcing", {Mesh->NEdgesAll}, KOKKOS_LAMBDA(int IEdge) {
+          Real ColThick = 0;
+          Real VelSum   = 0;
+          Real TendSum  = 0;
+          for (int K = 0; K < NVertLevels; ++K) {
+             ColThick += ThickEdge(IEdge, K);
+             VelSum += ThickEdge(IEdge, K) * NormalVelEdge(IEdge, K);
+             TendSum += ThickEdge(IEdge, K) * NormalVelTend(IEdge, K);
+          }
+          const Real InvColThick = ColThick > 0 ? 1._Real / ColThick : 0;
+
+          const I4 ICell0 = CellsOnEdge(IEdge, 0);
+          const I4 ICell1 = CellsOnEdge(IEdge, 1);
+          const Real SshGrad =
+              Grav * (LocSshEval(ICell1) - LocSshEval(ICell0)) / DcEdge(IEdge);
+
+          LocMeanVelTend(IEdge) = TendSum * InvColThick;
+          LocBtrForcing(IEdge)  = LocMeanVelTend(IEdge) + SshGrad;
+          if (FirstIter) {
+             LocNormalVelBtrCur(IEdge) = VelSum * InvColThick;
+             LocThickEdgeCur(IEdge)    = ColThick;
+          }
+       });
+
+   // The tendencies are only valid in the inner halo layers, so the forcing
+   // is made valid in the full halo for the subcycles
+   Array1DReal LocForcing = BtrForcing;
+   MeshHalo->exchangeFullArrayHalo(LocForcing, OnEdge);
+}
+
+// Subcycle the barotropic system with the forward-backward scheme, starting
+// from the barotropic state at the old time:
+//    u_btr^{m+1} = u_btr^{m} + dt_btr * (G - g grad(ssh^{m}))
+//    ssh^{m+1}   = ssh^{m} - dt_btr * div(H^{m} u_btr^{m+1})
+// where G is the barotropic forcing and H the total column thickness on
+// edges. The thickness flux is averaged over the subcycles to transport the
+// layer thickness consistently with the barotropic sea surface height. Each
+// subcycle invalidates one cell halo layer, so the barotropic variables are
+// exchanged once every HaloWidth subcycles, only to the depth needed until
+// the next exchange.
+void SplitExplicitStepper::subcycleBarotropic() const {
+
+   TimerRegion BtrTimer("BarotropicSubcycle");
+
+   const auto &BottomDepth         = Mesh->BottomDepth;
+   const auto &CellsOnEdge         = Mesh->CellsOnEdge;
+   const auto &DcEdge              = Mesh->DcEdge;
+   const auto &OffsetsOnCell       = Mesh->OffsetsOnCell;
+   const auto &EdgesOnCellCSR      = Mesh->EdgesOnCellCSR;
+   const auto &DivWeightsOnCellCSR = Mesh->DivWeightsOnCellCSR;
+
+   OMEGA_SCOPE(LocBtrForcing, BtrForcing);
+   OMEGA_SCOPE(LocSshBtr, SshBtr);
+   OMEGA_SCOPE(LocNormalVelBtr, NormalVelBtr);
+   OMEGA_SCOPE(LocBtrFlux, BtrFlux);
+   OMEGA_SCOPE(LocBtrFluxAvg, BtrFluxAvg);
+
+   const Real Grav = Tend->SSHGrad.Enabled ? Tend->SSHGrad.Grav : 0;
+   const bool ThickFluxEnabled = Tend->ThicknessFluxDiv.Enabled;
+
+   Real TimeStepSeconds;
+   TimeStep.get(TimeStepSeconds, TimeUnits::Seconds);
+   const Real BtrTimeStep  = TimeStepSeconds / NBarotropicSubcycles;
+   const Real InvNSubcycle = 1._Real / NBarotropicSubcycles;
+
+   deepCopy(SshBtr, SshCur);
+   deepCopy(NormalVelBtr, NormalVelBtrCur);
+   deepCopy(BtrFluxAvg, 0);
+
+   for (int Subcycle = 0; Subcycle < NBarotropicSubcycles; ++Subcycle) {
+
+      if (Subcycle % HaloWidth == 0) {
+         exchangeBarotropicHalo(
+             std::min(HaloWidth, NBarotropicSubcycles - Subcycle));
+      }
+
+      parallelFor(
+          "btrVelocityUpdate", {Mesh->NEdgesAll}, KOKKOS_LAMBDA(int IEdge) {
+             const I4 ICell0 = CellsOnEdge(IEdge, 0);
+             const I4 ICell1 = CellsOnEdge(IEdge, 1);
+
+             const Real SshGrad = Grav *
+                                  (LocSshBtr(ICell1) - LocSshBtr(ICell0)) /
+                                  DcEdge(IEdge);
+             const Real NormalVel =
+                 LocNormalVelBtr(IEdge) +
+                 BtrTimeStep * (LocBtrForcing(IEdge) - SshGrad);
+
+             const Real ColThickEdge =
+                 0.5_Real * (LocSshBtr(ICell0) + BottomDepth(ICell0) +
+                             LocSshBtr(ICell1) + BottomDepth(ICell1));
+
+             LocNormalVelBtr(IEdge) = NormalVel;
+             LocBtrFlux(IEdge)      = ColThickEdge * NormalVel;
+             LocBtrFluxAvg(IEdge) += InvNSubcycle * LocBtrFlux(IEdge);
+          });
+
+      if (ThickFluxEnabled) {
+         parallelFor(
+             "btrSshUpdate", {Mesh->NCellsAll}, KOKKOS_LAMBDA(int ICell) {
+                Real FluxSum = 0;
+                const I4 JEnd = OffsetsOnCell(ICell + 1);
+                for (int J = OffsetsOnCell(ICell); J < JEnd; ++J) {
+                   const I4 JEdge = EdgesOnCellCSR(J);
+                   FluxSum += DivWeightsOnCellCSR(J) * LocBtrFlux(JEdge);
+                }
+                LocSshBtr(ICell) += BtrTimeStep * FluxSum;
+             });
+      }
+   }
+}
+
+// Exchange the halo of the subcycled sea surface height and barotropic
+// velocity, in a single message per neighbor when exchanging host copies
+void SplitExplicitStepper::exchangeBarotropicHalo(I4 HaloDepth) const {
+   Array1DReal LocSshBtr       = SshBtr;
+   Array1DReal LocNormalVelBtr = NormalVelBtr;
+   if (MeshHalo->isDeviceExchange()) {
+      MeshHalo->exchangeFullArrayHalo(LocSshBtr, OnCell, HaloDepth);
+      MeshHalo->exchangeFullArrayHalo(LocNormalVelBtr, OnEdge, HaloDepth);
+      return;
+   }
+   HaloGroup BtrGroup;
+   BtrGroup.add(LocSshBtr, OnCell);
+   BtrGroup.add(LocNormalVelBtr, OnEdge);
+   MeshHalo->exchangeGroupHalo(BtrGroup, HaloDepth);
+}
+
+// Advance the state by one step of the split-explicit scheme
+void SplitExplicitStepper::doStep(OceanState *State, TimeInstant Time) const {
+
+   const int CurLevel  = 0;
+   const int NextLevel = 1;
+
+   const auto &LayerThickCur  = State->LayerThickness[CurLevel];
+   const auto &LayerThickNext = State->LayerThickness[NextLevel];
+   const auto &NormalVelCur   = State->NormalVelocity[CurLevel];
+   const auto &NormalVelNext  = State->NormalVelocity[NextLevel];
+   const auto &TransportVel   = ProvisState->NormalVelocity[0];
+   const auto &NormalVelTend  = Tend->NormalVelocityTend;
+   const int NVertLevels      = NormalVelTend.extent_int(1);
+
+   OMEGA_SCOPE(LocNormalVelBtrCur, NormalVelBtrCur);
+   OMEGA_SCOPE(LocThickEdgeCur, ThickEdgeCur);
+   OMEGA_SCOPE(LocMeanVelTend, MeanVelTend);
+   OMEGA_SCOPE(LocNormalVelBtr, NormalVelBtr);
+   OMEGA_SCOPE(LocBtrFluxAvg, BtrFluxAvg);
+
+   Real TimeStepSeconds;
+   TimeStep.get(TimeStepSeconds, TimeUnits::Seconds);
+
+   // The layer thickness is always transported from the old time
+   deepCopy(ProvisState->LayerThickness[0], LayerThickCur);
+
+   Array3DReal TracersCur;
+   Array3DReal TracersNext;
+   const bool AdvanceTracers = getTracerArrays(TracersCur, TracersNext);
+
+   // The midpoint time is computed once per step
+   const TimeInstant MidTime = Time + TimeStep / 2;
+
+   for (int Iter = 0; Iter < NBaroclinicIterations; ++Iter) {
+
+      // The first iteration evaluates the tendencies at the old time, the
+      // following ones at the midpoint state stored in the next time level
+      const bool FirstIter       = Iter == 0;
+      const int EvalLevel        = FirstIter ? CurLevel : NextLevel;
+      const TimeInstant EvalTime = FirstIter ? Time : MidTime;
+
+      // R^{*} = RHS(q^{*}, t^{*})
+      Tend->computeAllTendencies(State, AuxState, EvalLevel, EvalLevel,
+                                 EvalTime);
+
+      // G = <R_u^{*}> + g grad(ssh^{*}), where <> is the vertical mean
+      computeBarotropicForcing(State, EvalLevel, FirstIter);
+
+      // Subcycle (ssh, u_btr) from t^{n} to t^{n+1} with forcing G
+      subcycleBarotropic();
+
+      // The baroclinic velocity u' = u - u_btr is advanced with the
+      // baroclinic part of the tendency and recombined with the final
+      // barotropic velocity:
+      //    u^{n+1} = u'^{n} + dt * (R_u^{*} - <R_u^{*}>) + u_btr^{n+1}
+      // The thickness is transported by the time mean of the baroclinic
+      // velocity plus the subcycle-averaged barotropic flux distributed over
+      // the layers in proportion to their thickness on edges.
+      parallelFor(
+          "splitVelocityUpdate", {Mesh->NEdgesAll, NVertLevels},
+          KOKKOS_LAMBDA(int IEdge, int K) {
+             const Real VelBclCur =
+                 NormalVelCur(IEdge, K) - LocNormalVelBtrCur(IEdge);
+             const Real VelBclNext =
+                 VelBclCur + TimeStepSeconds * (NormalVelTend(IEdge, K) -
+                                                LocMeanVelTend(IEdge));
+             const Real VelBtrTransport =
+                 LocThickEdgeCur(IEdge) > 0
+                     ? LocBtrFluxAvg(IEdge) / LocThickEdgeCur(IEdge)
+                     : 0;
+
+             NormalVelNext(IEdge, K) = VelBclNext + LocNormalVelBtr(IEdge);
+             TransportVel(IEdge, K) =
+                 0.5_Real * (VelBclCur + VelBclNext) + VelBtrTransport;
+          });
+
+      // h^{n+1} = h^{n} + dt * R_h(h^{n}, u_transport)
+      Tend->computeThicknessTendencies(ProvisState, AuxState, 0, 0, MidTime);
+      updateThicknessByTend(State, NextLevel, State, CurLevel, TimeStep);
+
+      // The tracers are transported once, on the last iteration, by the same
+      // thickness flux as the layer thickness:
+      //    phi^{n+1} = (h^{n} * phi^{n} + dt * R_phi(h^{n}, u_transport))
+      //                / h^{n+1}
+      if (AdvanceTracers && Iter == NBaroclinicIterations - 1) {
+         Tend->computeTracerTendencies(ProvisState, AuxState, TracersCur, 0, 0,
+                                       MidTime);
+         updateTracersByTend(TracersNext, State, CurLevel, TracersCur,
+                             TimeStep);
+      }
+
+      // q^{*} = (q^{n} + q^{n+1}) / 2 for the next iteration
+      if (Iter < NBaroclinicIterations - 1) {
+         parallelFor(
+             "splitThickMidpoint", {Mesh->NCellsAll, NVertLevels},
+             KOKKOS_LAMBDA(int ICell, int K) {
+                LayerThickNext(ICell, K) =
+                    0.5_Real *
+                    (LayerThickCur(ICell, K) + LayerThickNext(ICell, K));
+             });
+         parallelFor(
+             "splitVelMidpoint", {Mesh->NEdgesAll, NVertLevels},
+             KOKKOS_LAMBDA(int IEdge, int K) {
+                NormalVelNext(IEdge, K) =
+                    0.5_Real *
+                    (NormalVelCur(IEdge, K) + NormalVelNext(IEdge, K));
+             });
+      }
+   }
+
+   // Update time levels (New -> Old) of prognostic variables with halo
+   // exchanges. Each iteration evaluates the full and the thickness
+   // tendencies once without an exchange of the state in between.
+   const I4 HaloDepth = getRequiredHaloDepth(2 * NBaroclinicIterations);
+   State->updateTimeLevels(HaloDepth);
+   if (AdvanceTracers) {
+      updateTracerTimeLevels(State, HaloDepth);
+   }
+}
+
+} // namespace OMEGA
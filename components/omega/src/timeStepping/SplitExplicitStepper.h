@@ -0,0 +1,89 @@
+#ifndef OMEGA_TSSE_H
+#define OMEGA_TSSE_H
+//===-- timeStepping/SplitExplicitStepper.h - split-explicit time stepper
+//--------------------*- C++
+//-*-===//
+//
+/// \file
+/// \brief Contains the class for the split-explicit time stepping scheme
+///
+/// The split-explicit scheme separates the fast external gravity wave from
+/// the rest of the dynamics. The full (baroclinic) tendencies are evaluated
+/// once per iteration at the large time step, while a two-dimensional
+/// barotropic system for the sea surface height and the vertically averaged
+/// normal velocity is subcycled with a forward-backward scheme at a small
+/// time step. The time step of the full state is then limited by the
+/// internal dynamics rather than by the external gravity wave.
+//===----------------------------------------------------------------------===//
+
+#include "TimeStepper.h"
+
+namespace OMEGA {
+
+class SplitExplicitStepper : public TimeStepper {
+ public:
+   // Constructor. Construct a split-explicit stepper from
+   // name, tendencies, auxiliary state, mesh, and halo
+   SplitExplicitStepper(const std::string &Name, Tendencies *Tend,
+                        AuxiliaryState *AuxState, HorzMesh *Mesh,
+                        Halo *MeshHalo);
+
+   // Advance the state by one step of the split-explicit scheme
+   void doStep(OceanState *State, TimeInstant Time) const override;
+
+   // Set the number of barotropic subcycles per time step
+   void setNBarotropicSubcycles(I4 InNSubcycles);
+
+   // Set the number of baroclinic iterations per time step
+   void setNBaroclinicIterations(I4 InNIterations);
+
+ private:
+   // Number of barotropic subcycles per time step
+   I4 NBarotropicSubcycles = 20;
+
+   // Number of baroclinic iterations per time step. The first iteration
+   // evaluates the tendencies at the old time, the following ones at the
+   // midpoint of the old and predicted states.
+   I4 NBaroclinicIterations = 2;
+
+   // Number of cell halo layers, the barotropic variables are exchanged once
+   // every HaloWidth subcycles
+   I4 HaloWidth;
+
+   // Provisional state holding the old layer thickness and the velocity that
+   // transports it over the time step
+   OceanState *ProvisState;
+
+   // Barotropic variables on cells: sea surface height at the old time, of
+   // the state at which the tendencies are evaluated and of the subcycles
+   Array1DReal SshCur;
+   Array1DReal SshEval;
+   Array1DReal SshBtr;
+
+   // Barotropic variables on edges: old barotropic velocity and total
+   // thickness, thickness-weighted vertical mean of the velocity tendency,
+   // barotropic forcing, subcycled barotropic velocity and its thickness flux,
+   // and the thickness flux averaged over all subcycles
+   Array1DReal NormalVelBtrCur;
+   Array1DReal ThickEdgeCur;
+   Array1DReal MeanVelTend;
+   Array1DReal BtrForcing;
+   Array1DReal NormalVelBtr;
+   Array1DReal BtrFlux;
+   Array1DReal BtrFluxAvg;
+
+   // Compute the barotropic forcing from the velocity tendencies of the
+   // state at the input time level. On the first iteration, the barotropic
+   // state at the old time is also saved.
+   void computeBarotropicForcing(const OceanState *EvalState, int EvalLevel,
+                                 bool FirstIter) const;
+
+   // Subcycle the barotropic system from the old time over the time step
+   void subcycleBarotropic() const;
+
+   // Exchange the halo of the subcycled barotropic variables
+   void exchangeBarotropicHalo(I4 HaloDepth) const;
+};
+
+} // namespace OMEGA
+#endif
@@ -4,8 +4,16 @@
 #include "TimeStepper.h"
 #include "Config.h"
 #include "ForwardBackwardStepper.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "LowStorageRK4Stepper.h"
 #include "RungeKutta2Stepper.h"
 #include "RungeKutta4Stepper.h"
+#include "SplitExplicitStepper.h"
+#include "Tracers.h"
+
+#include <algorithm>
+#include <cmath>
 
 namespace OMEGA {
 
@@ -26,9 +34,14 @@ TimeStepperType getTimeStepperFromStr(const std::string &InString) {
       TimeStepperChoice = TimeStepperType::RungeKutta4;
    } else if (InString == "RungeKutta2") {
       TimeStepperChoice = TimeStepperType::RungeKutta2;
+   } else if (InString == "SplitExplicit") {
+      TimeStepperChoice = TimeStepperType::SplitExplicit;
+   } else if (InString == "LowStorageRK4") {
+      TimeStepperChoice = TimeStepperType::LowStorageRK4;
    } else {
       LOG_CRITICAL("TimeStepper should be one of 'Forward-Backward', "
-                   "'RungeKutta4' or 'RungeKutta2' but got {}:",
+                   "'RungeKutta4', 'RungeKutta2', 'SplitExplicit' or "
+                   "'LowStorageRK4' but got {}:",
                    InString);
    }
 
@@ -42,7 +55,8 @@ TimeStepper::TimeStepper(const std::string &Name, TimeStepperType Type,
                          AuxiliaryState *AuxState, HorzMesh *Mesh,
                          Halo *MeshHalo)
     : Name(Name), Type(Type), NTimeLevels(NTimeLevels), Tend(Tend),
-      AuxState(AuxState), Mesh(Mesh), MeshHalo(MeshHalo) {}
+      AuxState(AuxState), Mesh(Mesh), MeshHalo(MeshHalo),
+      UpdateBounds(Mesh->getLoopBounds(FullHalo)) {}
 
 // Create a time stepper from name, type, tendencies, auxiliary state, mesh and
 // halo
@@ -72,6 +86,14 @@ TimeStepper *TimeStepper::create(const std::string &Name, TimeStepperType Type,
       NewTimeStepper =
           new RungeKutta2Stepper(Name, Tend, AuxState, Mesh, MeshHalo);
       break;
+   case TimeStepperType::SplitExplicit:
+      NewTimeStepper =
+          new SplitExplicitStepper(Name, Tend, AuxState, Mesh, MeshHalo);
+      break;
+   case TimeStepperType::LowStorageRK4:
+      NewTimeStepper =
+          new LowStorageRK4Stepper(Name, Tend, AuxState, Mesh, MeshHalo);
+      break;
    }
 
    AllTimeSteppers.emplace(Name, NewTimeStepper);
@@ -118,6 +140,88 @@ int TimeStepper::init() {
        "Default", TimeStepperChoice, DefTend, DefAuxState, DefMesh, DefHalo);
    DefaultTimeStepper->setTimeStep(TimeStep);
 
+   // Optional adaptive time step
+   bool AdaptiveTimeStep = false;
+   if (TimeIntConfig.existsVar("AdaptiveTimeStep")) {
+      Err = TimeIntConfig.get("AdaptiveTimeStep", AdaptiveTimeStep);
+      if (Err != 0) {
+         LOG_ERROR("TimeStepper: error reading AdaptiveTimeStep");
+         return Err;
+      }
+   }
+
+   if (AdaptiveTimeStep) {
+      R8 TargetCFL       = 0.5;
+      I4 CheckInterval   = 1;
+      std::string MinStr = "0000_00:00:01";
+      std::string MaxStr = TimeStepStr;
+
+      if (TimeIntConfig.existsVar("TargetCFL"))
+         Err += TimeIntConfig.get("TargetCFL", TargetCFL);
+      if (TimeIntConfig.existsVar("CFLCheckInterval"))
+         Err += TimeIntConfig.get("CFLCheckInterval", CheckInterval);
+      if (TimeIntConfig.existsVar("MinTimeStep"))
+         Err += TimeIntConfig.get("MinTimeStep", MinStr);
+      if (TimeIntConfig.existsVar("MaxTimeStep"))
+         Err += TimeIntConfig.get("MaxTimeStep", MaxStr);
+      if (Err != 0) {
+         LOG_ERROR("TimeStepper: error reading adaptive time step options");
+         return Err;
+      }
+
+      TimeInterval MinStep(MinStr);
+      TimeInterval MaxStep(MaxStr);
+      if (TargetCFL <= 0 or CheckInterval < 1 or MaxStep < MinStep) {
+         LOG_ERROR("TimeStepper: invalid adaptive time step options, "
+                   "TargetCFL {} CFLCheckInterval {} MinTimeStep {} "
+                   "MaxTimeStep {}",
+                   TargetCFL, CheckInterval, MinStr, MaxStr);
+         return -1;
+      }
+
+      DefaultTimeStepper->setAdaptiveTimeStep(TargetCFL, MinStep, MaxStep,
+                                              CheckInterval);
+   }
+
+   // Optional communication-avoiding mode, which needs a halo wide enough
+   // for all the tendency evaluations of a step
+   bool CommAvoidingHalo = false;
+   if (TimeIntConfig.existsVar("CommAvoidingHalo")) {
+      Err = TimeIntConfig.get("CommAvoidingHalo", CommAvoidingHalo);
+      if (Err != 0) {
+         LOG_ERROR("TimeStepper: error reading CommAvoidingHalo");
+         return Err;
+      }
+   }
+   DefaultTimeStepper->setCommAvoiding(CommAvoidingHalo);
+
+   // Optional kernel graph mode
+   bool UseKernelGraph = false;
+   if (TimeIntConfig.existsVar("KernelGraph")) {
+      Err = TimeIntConfig.get("KernelGraph", UseKernelGraph);
+      if (Err != 0) {
+         LOG_ERROR("TimeStepper: error reading KernelGraph");
+         return Err;
+      }
+   }
+   DefaultTimeStepper->setKernelGraph(UseKernelGraph);
+
+   // Optional tracer groups advanced with a longer step than the dynamics
+   if (TimeIntConfig.existsVar("SlowTracerGroups")) {
+      std::vector<std::string> SlowGroups;
+      I4 SlowSteps = 1;
+      Err += TimeIntConfig.get("SlowTracerGroups", SlowGroups);
+      if (TimeIntConfig.existsVar("SlowTracerSteps"))
+         Err += TimeIntConfig.get("SlowTracerSteps", SlowSteps);
+      if (Err != 0 or SlowSteps < 1) {
+         LOG_ERROR("TimeStepper: invalid slow tracer options, "
+                   "SlowTracerSteps {}",
+                   SlowSteps);
+         return -1;
+      }
+      DefaultTimeStepper->setSlowTracerGroups(SlowGroups, SlowSteps);
+   }
+
    return Err;
 }
 
@@ -161,9 +265,402 @@ void TimeStepper::setTimeStep(const TimeInterval &TimeStepIn) {
    TimeStep = TimeStepIn;
 }
 
+// Enable adaptive time stepping
+void TimeStepper::setAdaptiveTimeStep(R8 TargetCFLIn,
+                                      const TimeInterval &MinStep,
+                                      const TimeInterval &MaxStep,
+                                      I4 CheckInterval) {
+   AdaptiveTimeStep = true;
+   TargetCFL        = TargetCFLIn;
+   MinTimeStep      = MinStep;
+   MaxTimeStep      = MaxStep;
+   CFLCheckInterval = CheckInterval;
+}
+
+bool TimeStepper::isAdaptive() const { return AdaptiveTimeStep; }
+
+I4 TimeStepper::getCFLCheckInterval() const { return CFLCheckInterval; }
+
+// Maximum horizontal CFL number of a state. The largest |u| / dcEdge is
+// reduced on the device over the owned edges and then across all tasks with a
+// single MPI reduction.
+R8 TimeStepper::computeMaxCFL(const OceanState *State, int TimeLevel) const {
+
+   OMEGA_SCOPE(NormalVelocity, State->NormalVelocity[TimeLevel]);
+   OMEGA_SCOPE(DcEdge, Mesh->DcEdge);
+
+   Real LocalRate = 0;
+   parallelReduce(
+       "maxCFL", {Mesh->NEdgesOwned, State->NVertLevels},
+       KOKKOS_LAMBDA(int IEdge, int K, Real &Accum) {
+          const Real Rate = Kokkos::fabs(NormalVelocity(IEdge, K)) /
+                            DcEdge(IEdge);
+          Accum = Kokkos::max(Accum, Rate);
+       },
+       Kokkos::Max<Real>(LocalRate));
+
+   R8 LocalRateR8  = LocalRate;
+   R8 GlobalRateR8 = 0;
+   MPI_Allreduce(&LocalRateR8, &GlobalRateR8, 1, MPI_DOUBLE, MPI_MAX,
+                 MachEnv::getDefault()->getComm());
+
+   return GlobalRateR8 * TimeStep.getSeconds();
+}
+
+// Adjust an adaptive time step to the CFL number of a state
+bool TimeStepper::adaptTimeStep(const OceanState *State, int TimeLevel) {
+
+   if (!AdaptiveTimeStep)
+      return false;
+
+   const R8 OldStep = TimeStep.getSeconds();
+   const R8 MinStep = MinTimeStep.getSeconds();
+   const R8 MaxStep = MaxTimeStep.getSeconds();
+   const R8 MaxCFL  = computeMaxCFL(State, TimeLevel);
+
+   // A quiescent state allows the largest step, otherwise scale the step to
+   // reach the target CFL number
+   R8 NewStep = MaxStep;
+   if (MaxCFL > 0)
+      NewStep = OldStep * TargetCFL / MaxCFL;
+   NewStep = std::min(NewStep, MaxGrowthFactor * OldStep);
+
+   // Whole seconds keep the clock on round times for the alarms
+   if (NewStep > 1)
+      NewStep = std::floor(NewStep);
+   NewStep = std::clamp(NewStep, MinStep, MaxStep);
+
+   if (MaxCFL * NewStep / OldStep > TargetCFL and NewStep == MinStep)
+      LOG_WARN("TimeStepper: CFL number {} exceeds the target at the minimum "
+               "time step",
+               MaxCFL * NewStep / OldStep);
+
+   if (NewStep == OldStep)
+      return false;
+
+   LOG_INFO("TimeStepper: max CFL number {}, time step changed from {} s to "
+            "{} s",
+            MaxCFL, OldStep, NewStep);
+   TimeStep = TimeInterval(NewStep, TimeUnits::Seconds);
+
+   return true;
+}
+
 // Get time stepper name
 std::string TimeStepper::getName() const { return Name; }
 
+// Get number of halo layers needed for NEvals tendency evaluations. Each
+// evaluation invalidates the outermost layers of the halo to the depth of the
+// widest enabled tendency stencil.
+I4 TimeStepper::getRequiredHaloDepth(int NEvals) const {
+   I4 StencilDepth = Tend->getStencilHaloDepth(AuxState);
+   if (StencilDepth <= 0) {
+      return 0;
+   }
+   return NEvals * StencilDepth;
+}
+
+// Enable or disable the communication-avoiding mode
+void TimeStepper::setCommAvoiding(bool Enable) {
+
+   CommAvoiding = Enable;
+   if (!CommAvoiding or Type != TimeStepperType::RungeKutta4)
+      return;
+
+   const I4 HaloWidth = Mesh->NCellsHaloH.extent_int(0);
+   const I4 Depth     = getRequiredHaloDepth(4);
+   if (Depth <= 0 or Depth > HaloWidth) {
+      LOG_WARN("TimeStepper: the communication-avoiding mode needs a halo "
+               "width of {} for the enabled tendencies, but the halo width is "
+               "{}; the halo will be exchanged at every other stage",
+               Depth, HaloWidth);
+   }
+}
+
+// Enable or disable the kernel graph mode
+void TimeStepper::setKernelGraph(bool Enable) {
+   UseKernelGraph = Enable;
+   StepGraphs.clear();
+   if (UseKernelGraph and Type != TimeStepperType::RungeKutta4) {
+      LOG_WARN("TimeStepper: the kernel graph mode is only supported by the "
+               "RungeKutta4 time stepper and is ignored");
+   }
+   // A replayed graph would pass the stage times of the step in which it was
+   // recorded to the custom tendencies
+   if (UseKernelGraph and Tend->hasCustomTendencies()) {
+      LOG_WARN("TimeStepper: the kernel graph mode does not support custom "
+               "tendencies and is disabled");
+      UseKernelGraph = false;
+   }
+}
+
+bool TimeStepper::usesKernelGraph() const { return UseKernelGraph; }
+
+// Run the kernels of a step segment, directly or through a kernel graph. The
+// recorded kernels hold the arrays of the time levels of the state and the
+// tracers at the time of recording, which alternate from step to step, and
+// coefficients that depend on the time step, so the graphs are kept for each
+// time level and discarded when the time step changes. The stage times are
+// only used by custom tendencies, for which the mode is not enabled.
+void TimeStepper::runKernels(int Segment, const OceanState *State,
+                             const Array3DReal &Tracers,
+                             const std::function<void()> &Kernels) const {
+   if (!UseKernelGraph) {
+      Kernels();
+      return;
+   }
+
+   if (!(GraphTimeStep == TimeStep) or StepGraphs.size() >= MaxStepGraphs) {
+      StepGraphs.clear();
+      GraphTimeStep = TimeStep;
+   }
+
+   const auto Key = std::make_tuple(
+       Segment, static_cast<const void *>(State->LayerThickness[0].data()),
+       static_cast<const void *>(Tracers.data()));
+   KernelGraph &Graph = StepGraphs[Key];
+   if (!Graph.isCaptured() and !Graph.capture(Kernels)) {
+      LOG_WARN("TimeStepper: the kernels of step segment {} could not be "
+               "recorded in a kernel graph, the kernel graph mode is "
+               "disabled",
+               Segment);
+      UseKernelGraph = false;
+      StepGraphs.clear();
+      Kernels();
+      return;
+   }
+
+   Graph.submit();
+}
+
+// Set the tracer groups advanced with a longer step. The tracer indices are
+// found when the tracers are first advanced, since the tracers are
+// initialized after the time stepper.
+void TimeStepper::setSlowTracerGroups(
+    const std::vector<std::string> &GroupNames, I4 NSteps) {
+
+   SlowTracerGroups    = GroupNames;
+   SlowTracerSteps     = std::max(NSteps, 1);
+   SlowTracersInit     = false;
+   SlowTracerIndices   = Array1DI4();
+   SlowTracerStepCount = 0;
+   Tend->StepTracerRanges.clear();
+
+   if (SlowTracerSteps == 1)
+      SlowTracerGroups.clear();
+}
+
+I4 TimeStepper::getSlowTracerSteps() const {
+   return SlowTracerIndices.size() > 0 ? SlowTracerSteps : 1;
+}
+
+// Get the halo depth of the communication-avoiding mode. Each stage is
+// computed on a halo that is narrower by the stencil depth, so the depth for
+// NEvals evaluations must fit in the halo.
+I4 TimeStepper::getCommAvoidingHaloDepth(int NEvals) const {
+   if (!CommAvoiding)
+      return 0;
+
+   const I4 HaloWidth = Mesh->NCellsHaloH.extent_int(0);
+   const I4 Depth     = getRequiredHaloDepth(NEvals);
+   if (Depth <= 0 or Depth > HaloWidth)
+      return 0;
+
+   return Depth;
+}
+
+// Restrict the tendency and auxiliary state computations to a halo depth
+void TimeStepper::setComputeHaloDepth(I4 HaloDepth) const {
+   Tend->setComputeHaloDepth(HaloDepth);
+   AuxState->setComputeHaloDepth(HaloDepth);
+   UpdateBounds = Mesh->getLoopBounds(HaloDepth);
+}
+
+// Get the current and next tracer time levels. Tracers are only advanced if
+// they have been initialized on a mesh with the cell dimension of this time
+// stepper.
+bool TimeStepper::getTracerArrays(Array3DReal &TracersCur,
+                                  Array3DReal &TracersNext) const {
+
+   TracersCur  = Array3DReal();
+   TracersNext = Array3DReal();
+
+   const I4 NTracers = Tracers::getNumTracers();
+   if (NTracers <= 0)
+      return false;
+
+   Tracers::getAll(TracersCur, 0);
+   Tracers::getAll(TracersNext, 1);
+   if (TracersCur.extent_int(1) != Mesh->NCellsSize) {
+      TracersCur  = Array3DReal();
+      TracersNext = Array3DReal();
+      return false;
+   }
+
+   AuxState->initTracerAux(NTracers);
+
+   if (!SlowTracersInit)
+      initSlowTracers(NTracers);
+
+   return true;
+}
+
+// Find the tracers of the slow tracer groups. The tendencies are computed for
+// the ranges of the remaining tracers, so the tendencies of the slow tracers
+// stay zero and the state updates hold their thickness-weighted values.
+void TimeStepper::initSlowTracers(I4 NTracers) const {
+
+   SlowTracersInit = true;
+   if (SlowTracerGroups.empty())
+      return;
+
+   std::vector<bool> IsSlow(NTracers, false);
+   for (const std::string &GroupName : SlowTracerGroups) {
+      std::pair<I4, I4> GroupRange;
+      if (Tracers::getGroupRange(GroupRange, GroupName) != 0) {
+         LOG_ERROR("TimeStepper: slow tracer group {} not found, its tracers "
+                   "are advanced with the dynamics",
+                   GroupName);
+         continue;
+      }
+      auto [StartIndex, GroupLength] = GroupRange;
+      for (I4 L = StartIndex; L < StartIndex + GroupLength; ++L)
+         IsSlow[L] = true;
+   }
+
+   std::vector<I4> SlowIndices;
+   std::vector<std::pair<I4, I4>> StepRanges;
+   for (I4 L = 0; L < NTracers; ++L) {
+      if (IsSlow[L]) {
+         SlowIndices.push_back(L);
+      } else if (L > 0 and !IsSlow[L - 1]) {
+         ++StepRanges.back().second;
+      } else {
+         StepRanges.emplace_back(L, 1);
+      }
+   }
+   if (SlowIndices.empty())
+      return;
+
+   // An empty list of ranges selects all tracers, so a range without
+   // tracers is used if all tracers are slow
+   if (StepRanges.empty())
+      StepRanges.emplace_back(0, 0);
+   Tend->StepTracerRanges = StepRanges;
+
+   HostArray1DI4 SlowIndicesH("SlowTracerIndicesH", SlowIndices.size());
+   for (size_t I = 0; I < SlowIndices.size(); ++I)
+      SlowIndicesH(I) = SlowIndices[I];
+   SlowTracerIndices = createDeviceMirrorCopy(SlowIndicesH);
+
+   AuxState->initAccumThickFlux();
+   SlowTracerStepCount = 0;
+
+   LOG_INFO("TimeStepper: {} tracers advanced every {} steps",
+            SlowIndices.size(), SlowTracerSteps);
+}
+
+// Update the tracer time levels, accumulating the thickness fluxes of the
+// step for the slow tracers. The state time levels have already been
+// updated, so the state at the start of the step is the previous time level.
+void TimeStepper::updateTracerTimeLevels(OceanState *State,
+                                         I4 HaloDepth) const {
+
+   if (SlowTracerIndices.size() > 0) {
+      if (SlowTracerStepCount == 0)
+         AuxState->startAccumThickFlux(State, -1);
+      AuxState->accumulateThickFlux(State, -1, TimeStep);
+
+      if (++SlowTracerStepCount == SlowTracerSteps) {
+         Array3DReal TracersCur;
+         Array3DReal TracersNext;
+         Tracers::getAll(TracersCur, 0);
+         Tracers::getAll(TracersNext, 1);
+         transportSlowTracers(State, TracersCur, TracersNext);
+         SlowTracerStepCount = 0;
+      }
+   }
+
+   Tracers::updateTimeLevels(HaloDepth);
+}
+
+// Transport the slow tracers over their step. The thickness-weighted tracers
+// were held since the start of the step, so the tracers at the start are
+// recovered with the thickness saved at the start. The thickness-weighted
+// tracers are then updated with the divergence of the accumulated thickness
+// fluxes times the edge tracers and divided by the thickness consistent with
+// those fluxes, which keeps uniform tracers uniform.
+void TimeStepper::transportSlowTracers(const OceanState *State,
+                                       const Array3DReal &TracersCur,
+                                       const Array3DReal &TracersNext) const {
+
+   const Array2DReal &LayerThickCell = State->LayerThickness[0];
+   const Array2DReal &StartThickCell = AuxState->AccumStartThickCell;
+   const Array2DReal &AccumFluxEdge  = AuxState->AccumThickFluxEdge;
+   const int NVertLevels             = LayerThickCell.extent_int(1);
+   const I4 NSlow                    = SlowTracerIndices.extent_int(0);
+
+   const bool IsUpwind = AuxState->TracerAux.TracersOnEdgeChoice == Upwind;
+
+   OMEGA_SCOPE(SlowIndices, SlowTracerIndices);
+   OMEGA_SCOPE(OffsetsOnCell, Mesh->OffsetsOnCell);
+   OMEGA_SCOPE(EdgesOnCellCSR, Mesh->EdgesOnCellCSR);
+   OMEGA_SCOPE(DivWeightsOnCellCSR, Mesh->DivWeightsOnCellCSR);
+   OMEGA_SCOPE(CellsOnEdge, Mesh->CellsOnEdge);
+
+   parallelFor(
+       "transportSlowTracers", {Mesh->NCellsOwned, NVertLevels},
+       KOKKOS_LAMBDA(int ICell, int K) {
+          const int JStart = OffsetsOnCell(ICell);
+          const int JEnd   = OffsetsOnCell(ICell + 1);
+
+          Real ThickDiv = 0;
+          for (int J = JStart; J < JEnd; ++J) {
+             ThickDiv +=
+                 DivWeightsOnCellCSR(J) * AccumFluxEdge(EdgesOnCellCSR(J), K);
+          }
+          const Real NewThick = StartThickCell(ICell, K) + ThickDiv;
+
+          for (int M = 0; M < NSlow; ++M) {
+             const I4 L = SlowIndices(M);
+
+             Real TrDiv = 0;
+             for (int J = JStart; J < JEnd; ++J) {
+                const I4 JEdge  = EdgesOnCellCSR(J);
+                const I4 JCell0 = CellsOnEdge(JEdge, 0);
+                const I4 JCell1 = CellsOnEdge(JEdge, 1);
+                const Real Flux = AccumFluxEdge(JEdge, K);
+
+                const Real Tr0 = LayerThickCell(JCell0, K) *
+                                 TracersNext(L, JCell0, K) /
+                                 StartThickCell(JCell0, K);
+                const Real Tr1 = LayerThickCell(JCell1, K) *
+                                 TracersNext(L, JCell1, K) /
+                                 StartThickCell(JCell1, K);
+
+                Real TrEdge = 0.5_Real * (Tr0 + Tr1);
+                if (IsUpwind and Flux != 0)
+                   TrEdge = Flux > 0 ? Tr0 : Tr1;
+                TrDiv += DivWeightsOnCellCSR(J) * Flux * TrEdge;
+             }
+
+             TracersCur(L, ICell, K) =
+                 (LayerThickCell(ICell, K) * TracersNext(L, ICell, K) +
+                  TrDiv) /
+                 NewThick;
+          }
+       });
+
+   parallelFor(
+       "copySlowTracers", {Mesh->NCellsOwned, NVertLevels},
+       KOKKOS_LAMBDA(int ICell, int K) {
+          for (int M = 0; M < NSlow; ++M) {
+             const I4 L               = SlowIndices(M);
+             TracersNext(L, ICell, K) = TracersCur(L, ICell, K);
+          }
+       });
+}
+
 // Get time stepper type
 TimeStepperType TimeStepper::getType() const { return Type; }
 
@@ -185,7 +682,7 @@ void TimeStepper::updateThicknessByTend(OceanState *State1, int TimeLevel1,
    Coeff.get(CoeffSeconds, TimeUnits::Seconds);
 
    parallelFor(
-       "updateThickByTend", {Mesh->NCellsAll, NVertLevels},
+       "updateThickByTend", {UpdateBounds.NCells, NVertLevels},
        KOKKOS_LAMBDA(int ICell, int K) {
           LayerThick1(ICell, K) =
               LayerThick2(ICell, K) + CoeffSeconds * LayerThickTend(ICell, K);
@@ -207,7 +704,7 @@ void TimeStepper::updateVelocityByTend(OceanState *State1, int TimeLevel1,
    Coeff.get(CoeffSeconds, TimeUnits::Seconds);
 
    parallelFor(
-       "updateVelByTend", {Mesh->NEdgesAll, NVertLevels},
+       "updateVelByTend", {UpdateBounds.NEdges, NVertLevels},
        KOKKOS_LAMBDA(int IEdge, int K) {
           NormalVel1(IEdge, K) =
               NormalVel2(IEdge, K) + CoeffSeconds * NormalVelTend(IEdge, K);
@@ -218,8 +715,188 @@ void TimeStepper::updateVelocityByTend(OceanState *State1, int TimeLevel1,
 void TimeStepper::updateStateByTend(OceanState *State1, int TimeLevel1,
                                     OceanState *State2, int TimeLevel2,
                                     TimeInterval Coeff) const {
-   updateThicknessByTend(State1, TimeLevel1, State2, TimeLevel2, Coeff);
-   updateVelocityByTend(State1, TimeLevel1, State2, TimeLevel2, Coeff);
+   updateStateByTendFused(State1, TimeLevel1, Array3DReal(), State2,
+                          TimeLevel2, Array3DReal(), Array3DAuxReal(), Coeff);
+}
+
+// Tracers1 = (h2 * Tracers2 + Coeff * TracerTend) / (h2 + Coeff * R_h), where
+// h2 is the layer thickness of State2(TimeLevel2) and R_h its tendency
+void TimeStepper::updateTracersByTend(const Array3DReal &Tracers1,
+                                      OceanState *State2, int TimeLevel2,
+                                      const Array3DReal &Tracers2,
+                                      TimeInterval Coeff) const {
+
+   const auto &LayerThick2    = State2->LayerThickness[TimeLevel2];
+   const auto &LayerThickTend = Tend->LayerThicknessTend;
+   const auto &TracerTend     = Tend->TracerTend;
+   const int NVertLevels      = LayerThickTend.extent_int(1);
+   const int NTracers         = Tracers1.extent_int(0);
+
+   Real CoeffSeconds;
+   Coeff.get(CoeffSeconds, TimeUnits::Seconds);
+
+   parallelFor(
+       "updateTracersByTend", {UpdateBounds.NCells, NVertLevels},
+       KOKKOS_LAMBDA(int ICell, int K) {
+          const Real OldThick = LayerThick2(ICell, K);
+          const Real NewThick =
+              OldThick + CoeffSeconds * LayerThickTend(ICell, K);
+          for (int L = 0; L < NTracers; ++L) {
+             Tracers1(L, ICell, K) = (OldThick * Tracers2(L, ICell, K) +
+                                      CoeffSeconds * TracerTend(L, ICell, K)) /
+                                     NewThick;
+          }
+       });
+}
+
+// State1(TimeLevel1) = State2(TimeLevel2) + Coeff * Tend and optionally
+// Accum(AccumLevel) += AccumCoeff * Tend for thickness, velocity and tracers.
+// Cells and edges are updated by the same kernel over the larger of the two
+// index spaces.
+void TimeStepper::updateStateByTendFused(
+    OceanState *State1, int TimeLevel1, const Array3DReal &Tracers1,
+    OceanState *State2, int TimeLevel2, const Array3DReal &Tracers2,
+    const Array3DAuxReal &TracerTend, TimeInterval Coeff, OceanState *Accum,
+    int AccumLevel, const Array3DReal &TracersAccum,
+    TimeInterval AccumCoeff) const {
+
+   const auto &LayerThick1    = State1->LayerThickness[TimeLevel1];
+   const auto &LayerThick2    = State2->LayerThickness[TimeLevel2];
+   const auto &NormalVel1     = State1->NormalVelocity[TimeLevel1];
+   const auto &NormalVel2     = State2->NormalVelocity[TimeLevel2];
+   const auto &LayerThickTend = Tend->LayerThicknessTend;
+   const auto &NormalVelTend  = Tend->NormalVelocityTend;
+   const int NVertLevels      = LayerThickTend.extent_int(1);
+   const I4 NCellsAll         = UpdateBounds.NCells;
+   const I4 NEdgesAll         = UpdateBounds.NEdges;
+
+   const bool UseAccum = Accum != nullptr;
+   Array2DReal LayerThickAccum;
+   Array2DReal NormalVelAccum;
+   if (UseAccum) {
+      LayerThickAccum = Accum->LayerThickness[AccumLevel];
+      NormalVelAccum  = Accum->NormalVelocity[AccumLevel];
+   }
+
+   const int NTracers =
+       Tracers1.size() > 0 && TracerTend.size() > 0 ? Tracers1.extent_int(0)
+                                                    : 0;
+   const bool UseTracersAccum = UseAccum && TracersAccum.size() > 0;
+
+   Real CoeffSeconds;
+   Coeff.get(CoeffSeconds, TimeUnits::Seconds);
+   Real AccumCoeffSeconds = 0;
+   if (UseAccum) {
+      AccumCoeff.get(AccumCoeffSeconds, TimeUnits::Seconds);
+   }
+
+   parallelFor(
+       "updateStateByTendFused", {std::max(NCellsAll, NEdgesAll), NVertLevels},
+       KOKKOS_LAMBDA(int I, int K) {
+          if (I < NCellsAll) {
+             const Real ThickTend = LayerThickTend(I, K);
+             const Real NewThick =
+                 LayerThick2(I, K) + CoeffSeconds * ThickTend;
+
+             // Tracers are updated in thickness-weighted form before the
+             // thicknesses are overwritten
+             for (int L = 0; L < NTracers; ++L) {
+                Tracers1(L, I, K) = (LayerThick2(I, K) * Tracers2(L, I, K) +
+                                     CoeffSeconds * TracerTend(L, I, K)) /
+                                    NewThick;
+             }
+
+             if (UseAccum) {
+                const Real OldThickAccum = LayerThickAccum(I, K);
+                const Real NewThickAccum =
+                    OldThickAccum + AccumCoeffSeconds * ThickTend;
+                if (UseTracersAccum) {
+                   for (int L = 0; L < NTracers; ++L) {
+                      TracersAccum(L, I, K) =
+                          (OldThickAccum * TracersAccum(L, I, K) +
+                           AccumCoeffSeconds * TracerTend(L, I, K)) /
+                          NewThickAccum;
+                   }
+                }
+                LayerThickAccum(I, K) = NewThickAccum;
+             }
+
+             LayerThick1(I, K) = NewThick;
+          }
+          if (I < NEdgesAll) {
+             const Real VelTend = NormalVelTend(I, K);
+             if (UseAccum) {
+                NormalVelAccum(I, K) += AccumCoeffSeconds * VelTend;
+             }
+             NormalVel1(I, K) = NormalVel2(I, K) + CoeffSeconds * VelTend;
+          }
+       });
+}
+
+// Accum(AccumLevel) = AccumCoeff * Accum(AccumLevel) + Coeff * Tend
+// State1(TimeLevel1) = State2(TimeLevel2) + StateCoeff * Accum(AccumLevel)
+void TimeStepper::updateStateByTend(
+    OceanState *State1, int TimeLevel1, OceanState *State2, int TimeLevel2,
+    OceanState *Accum, int AccumLevel, Real AccumCoeff, Real StateCoeff,
+    TimeInterval Coeff, const Array3DReal &Tracers1,
+    const Array3DReal &Tracers2, const Array3DReal &TracersAccum) const {
+
+   const auto &LayerThick1     = State1->LayerThickness[TimeLevel1];
+   const auto &LayerThick2     = State2->LayerThickness[TimeLevel2];
+   const auto &LayerThickAccum = Accum->LayerThickness[AccumLevel];
+   const auto &LayerThickTend  = Tend->LayerThicknessTend;
+   const auto &NormalVel1      = State1->NormalVelocity[TimeLevel1];
+   const auto &NormalVel2      = State2->NormalVelocity[TimeLevel2];
+   const auto &NormalVelAccum  = Accum->NormalVelocity[AccumLevel];
+   const auto &NormalVelTend   = Tend->NormalVelocityTend;
+   const int NVertLevels       = LayerThickTend.extent_int(1);
+   const auto &TracerTend      = Tend->TracerTend;
+
+   const int NTracers = Tracers1.size() > 0 && TracersAccum.size() > 0
+                            ? Tracers1.extent_int(0)
+                            : 0;
+
+   Real CoeffSeconds;
+   Coeff.get(CoeffSeconds, TimeUnits::Seconds);
+
+   // The accumulator is read before any output is written, so it can share
+   // storage with either state
+   parallelFor(
+       "updateThickByTendAccum", {UpdateBounds.NCells, NVertLevels},
+       KOKKOS_LAMBDA(int ICell, int K) {
+          const Real NewAccum =
+              (AccumCoeff != 0 ? AccumCoeff * LayerThickAccum(ICell, K) : 0) +
+              CoeffSeconds * LayerThickTend(ICell, K);
+          const Real OldThick = LayerThick2(ICell, K);
+          const Real NewThick = OldThick + StateCoeff * NewAccum;
+
+          // The tracer accumulator holds thickness-weighted increments
+          for (int L = 0; L < NTracers; ++L) {
+             const Real NewTrAccum =
+                 (AccumCoeff != 0 ? AccumCoeff * TracersAccum(L, ICell, K)
+                                  : 0) +
+                 CoeffSeconds * TracerTend(L, ICell, K);
+             const Real NewTr =
+                 (OldThick * Tracers2(L, ICell, K) + StateCoeff * NewTrAccum) /
+                 NewThick;
+             TracersAccum(L, ICell, K) = NewTrAccum;
+             Tracers1(L, ICell, K)     = NewTr;
+          }
+
+          LayerThickAccum(ICell, K) = NewAccum;
+          LayerThick1(ICell, K)     = NewThick;
+       });
+
+   parallelFor(
+       "updateVelByTendAccum", {UpdateBounds.NEdges, NVertLevels},
+       KOKKOS_LAMBDA(int IEdge, int K) {
+          const Real NewAccum =
+              (AccumCoeff != 0 ? AccumCoeff * NormalVelAccum(IEdge, K) : 0) +
+              CoeffSeconds * NormalVelTend(IEdge, K);
+          const Real NewVel = NormalVel2(IEdge, K) + StateCoeff * NewAccum;
+          NormalVelAccum(IEdge, K) = NewAccum;
+          NormalVel1(IEdge, K)     = NewVel;
+       });
 }
 
 } // namespace OMEGA
@@ -16,12 +16,16 @@
 #include "Halo.h"
 #include "HorzMesh.h"
 #include "OceanState.h"
+#include "OmegaKokkos.h"
 #include "TendencyTerms.h"
 #include "TimeMgr.h"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace OMEGA {
 
@@ -31,6 +35,8 @@ enum class TimeStepperType {
    ForwardBackward,
    RungeKutta4,
    RungeKutta2,
+   SplitExplicit,
+   LowStorageRK4,
    Invalid
 };
 
@@ -88,6 +94,65 @@ class TimeStepper {
    /// Set time step
    void setTimeStep(const TimeInterval &TimeStepIn);
 
+   /// Enable adaptive time stepping. Every CheckInterval steps the time step
+   /// is set so that the maximum horizontal CFL number approaches TargetCFL,
+   /// within MinStep and MaxStep.
+   void setAdaptiveTimeStep(R8 TargetCFL, const TimeInterval &MinStep,
+                            const TimeInterval &MaxStep, I4 CheckInterval);
+
+   /// True if the time step is adapted to the CFL number
+   bool isAdaptive() const;
+
+   /// Number of steps between two adjustments of an adaptive time step
+   I4 getCFLCheckInterval() const;
+
+   /// Maximum horizontal CFL number |u| dt / dcEdge over the owned edges of
+   /// all tasks for the current time step
+   R8 computeMaxCFL(const OceanState *State, int TimeLevel) const;
+
+   /// Adjust an adaptive time step to the CFL number of a state. The step
+   /// grows by at most MaxGrowthFactor per adjustment and is rounded down to
+   /// whole seconds when larger than a second. Returns true if the time step
+   /// changed.
+   bool adaptTimeStep(const OceanState *State, int TimeLevel);
+
+   /// Number of cell halo layers that must be exchanged so that NEvals
+   /// successive tendency evaluations give correct results in the owned
+   /// elements, 0 if the full halo is needed
+   I4 getRequiredHaloDepth(int NEvals) const;
+
+   /// Enable or disable the communication-avoiding mode, in which steppers
+   /// that support it exchange the halo once per step and compute each stage
+   /// redundantly on the halo layers that are still valid
+   void setCommAvoiding(bool Enable);
+
+   /// Halo depth exchanged once per step in the communication-avoiding mode
+   /// for NEvals tendency evaluations, 0 if the mode is disabled or the halo
+   /// is not wide enough
+   I4 getCommAvoidingHaloDepth(int NEvals) const;
+
+   /// Enable or disable the kernel graph mode, in which steppers that support
+   /// it record the kernels between two halo exchanges into kernel graphs at
+   /// the first steps and launch the graphs at the following steps. Enabling
+   /// the mode discards the recorded graphs, so it must be enabled again
+   /// after the tendency or auxiliary state options are changed. The mode is
+   /// not enabled with custom tendencies, which depend on the stage times.
+   void setKernelGraph(bool Enable);
+
+   /// True if the kernel graph mode is enabled
+   bool usesKernelGraph() const;
+
+   /// Advance the tracers of the groups GroupNames with a step NSteps times
+   /// longer than the dynamics step. Their thickness-weighted values are
+   /// held during the dynamics steps and they are then transported at once
+   /// with the thickness fluxes accumulated over the NSteps steps.
+   void setSlowTracerGroups(const std::vector<std::string> &GroupNames,
+                            I4 NSteps);
+
+   /// Number of dynamics steps per step of the slow tracer groups, 1 if all
+   /// tracers are advanced with the dynamics
+   I4 getSlowTracerSteps() const;
+
    // these should be protected, they are public only because of CUDA
    // limitations
 
@@ -108,6 +173,43 @@ class TimeStepper {
                              OceanState *State2, int TimeLevel2,
                              TimeInterval Coeff) const;
 
+   // Tracers1 = (LayerThickness2(TimeLevel2) * Tracers2 + Coeff * TracerTend)
+   // / (LayerThickness2(TimeLevel2) + Coeff * LayerThicknessTend), the tracers
+   // consistent with a thickness update by updateThicknessByTend with the
+   // same arguments. The layer thickness itself is not modified.
+   void updateTracersByTend(const Array3DReal &Tracers1, OceanState *State2,
+                            int TimeLevel2, const Array3DReal &Tracers2,
+                            TimeInterval Coeff) const;
+
+   // State1(TimeLevel1) = State2(TimeLevel2) + Coeff * Tend for the layer
+   // thickness, the normal velocity and the thickness-weighted tracers, in a
+   // single kernel. TracerTend is the tendency of the thickness-weighted
+   // tracers, tracers are skipped if the tracer arrays are empty. If Accum is
+   // given, the tendencies are also accumulated in the same pass as
+   // Accum(AccumLevel) += AccumCoeff * Tend, with the tracers of the
+   // accumulated state in TracersAccum.
+   void updateStateByTendFused(
+       OceanState *State1, int TimeLevel1, const Array3DReal &Tracers1,
+       OceanState *State2, int TimeLevel2, const Array3DReal &Tracers2,
+       const Array3DAuxReal &TracerTend, TimeInterval Coeff,
+       OceanState *Accum = nullptr, int AccumLevel = 0,
+       const Array3DReal &TracersAccum = Array3DReal(),
+       TimeInterval AccumCoeff = TimeInterval()) const;
+
+   // Low-storage update, fused in a single pass for each variable:
+   // Accum(AccumLevel) = AccumCoeff * Accum(AccumLevel) + Coeff * Tend
+   // State1(TimeLevel1) = State2(TimeLevel2) + StateCoeff * Accum(AccumLevel)
+   // The accumulator may be a time level of State1 or State2. If AccumCoeff is
+   // zero the previous accumulator contents are ignored. If tracer arrays are
+   // given, TracersAccum accumulates the thickness-weighted tracer increments
+   // and the tracers are updated in thickness-weighted form.
+   void updateStateByTend(
+       OceanState *State1, int TimeLevel1, OceanState *State2, int TimeLevel2,
+       OceanState *Accum, int AccumLevel, Real AccumCoeff, Real StateCoeff,
+       TimeInterval Coeff, const Array3DReal &Tracers1 = Array3DReal(),
+       const Array3DReal &Tracers2     = Array3DReal(),
+       const Array3DReal &TracersAccum = Array3DReal()) const;
+
  protected:
    // Name of time stepper
    std::string Name;
@@ -121,6 +223,38 @@ class TimeStepper {
    // Time step
    TimeInterval TimeStep;
 
+   // Adaptive time step controller: target CFL number, bounds of the time
+   // step and number of steps between adjustments
+   bool AdaptiveTimeStep = false;
+   R8 TargetCFL          = 0.5;
+   TimeInterval MinTimeStep;
+   TimeInterval MaxTimeStep;
+   I4 CFLCheckInterval = 1;
+
+   // Flag for the communication-avoiding wide halo mode
+   bool CommAvoiding = false;
+
+   // Flag for the kernel graph mode, the graphs recorded for each segment of
+   // a step and time level of the state and tracers, and the time step with
+   // which they were recorded
+   mutable bool UseKernelGraph = false;
+   mutable std::map<std::tuple<int, const void *, const void *>, KernelGraph>
+       StepGraphs;
+   mutable TimeInterval GraphTimeStep;
+   static constexpr size_t MaxStepGraphs = 16;
+
+   // Tracer groups advanced with a step SlowTracerSteps times longer than
+   // the dynamics step, the indices of their tracers once the tracers are
+   // initialized and the number of dynamics steps since their last step
+   std::vector<std::string> SlowTracerGroups;
+   I4 SlowTracerSteps = 1;
+   mutable bool SlowTracersInit = false;
+   mutable Array1DI4 SlowTracerIndices;
+   mutable I4 SlowTracerStepCount = 0;
+
+   // Largest ratio of a new adaptive time step to the previous one
+   static constexpr R8 MaxGrowthFactor = 1.5;
+
    // Pointers to objects needed by every time stepper
    Tendencies *Tend;
    AuxiliaryState *AuxState;
@@ -131,6 +265,46 @@ class TimeStepper {
                Tendencies *Tend, AuxiliaryState *AuxState, HorzMesh *Mesh,
                Halo *MeshHalo);
 
+   // Get the current and next time levels of the tracer arrays and make sure
+   // the tracer auxiliary variables are allocated. Returns false and empty
+   // arrays if there are no tracers to advance on the mesh of this time
+   // stepper.
+   bool getTracerArrays(Array3DReal &TracersCur,
+                        Array3DReal &TracersNext) const;
+
+   // Update the tracer time levels at the end of a step, after the state
+   // time levels have been updated, with a halo exchange to HaloDepth. The
+   // slow tracer groups are transported first at the end of each of their
+   // steps.
+   void updateTracerTimeLevels(OceanState *State, I4 HaloDepth) const;
+
+   // Restrict the tendency, auxiliary state and state update computations
+   // to the first HaloDepth halo layers, or restore the full halo if
+   // HaloDepth is FullHalo
+   void setComputeHaloDepth(I4 HaloDepth) const;
+
+   // Loop bounds of the state update kernels
+   mutable MeshLoopBounds UpdateBounds;
+
+   // Run the kernels of the segment Segment of a step, which must not
+   // contain halo exchanges or reductions. In the kernel graph mode the
+   // kernels are recorded into a graph the first time the segment is run
+   // for the current time levels of State and Tracers, and the graph is
+   // launched instead at the following steps.
+   void runKernels(int Segment, const OceanState *State,
+                   const Array3DReal &Tracers,
+                   const std::function<void()> &Kernels) const;
+
+   // Find the tracers of the slow tracer groups and compute the tendencies
+   // of the other tracers only
+   void initSlowTracers(I4 NTracers) const;
+
+   // Transport the slow tracers of TracersNext with the accumulated thickness
+   // fluxes, using TracersCur as temporary storage
+   void transportSlowTracers(const OceanState *State,
+                             const Array3DReal &TracersCur,
+                             const Array3DReal &TracersNext) const;
+
    TimeStepper(const TimeStepper &) = delete;
    TimeStepper(TimeStepper &&)      = delete;
 
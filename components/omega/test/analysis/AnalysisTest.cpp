@@ -0,0 +1,200 @@
+//===-- Test driver for OMEGA analysis members -------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA in-situ analysis members
+///
+/// This driver tests the accumulation of field statistics by analysis
+/// members. A test field is set to a known value at each step of a clock
+/// and the mean, variance, minimum, maximum and time integral over an
+/// interval of four steps are compared with the exact values, as well as
+/// the restart of the statistics after the end of the interval. It outputs
+/// a PASS for each test that gives the expected result.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Analysis.h"
+#include "DataTypes.h"
+#include "Field.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include "mpi.h"
+
+#include <cmath>
+
+using namespace OMEGA;
+
+constexpr int NCells  = 7;
+constexpr int NLevels = 5;
+
+// Sets the test field to the value Offset + 10 * ICell + K
+void setTestField(const Array2DReal &Data, Real Offset) {
+   parallelFor(
+       {NCells, NLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          Data(ICell, K) = Offset + 10 * ICell + K;
+       });
+}
+
+// Counts the elements of a statistic that differ from the reference value
+// Offset + 10 * ICell + K
+int checkStat(const std::string &StatName, R8 Offset, bool AddBase, R8 Scale) {
+   Array2DR8 Stat     = Field::getFieldDataArray<Array2DR8>(StatName);
+   HostArray2DR8 Host = createHostMirrorCopy(Stat);
+
+   int Count = 0;
+   for (int ICell = 0; ICell < NCells; ++ICell) {
+      for (int K = 0; K < NLevels; ++K) {
+         R8 Ref = Offset;
+         if (AddBase)
+            Ref += 10 * ICell + K;
+         Ref *= Scale;
+         if (std::abs(Host(ICell, K) - Ref) > 1.0e-10 * (1.0 + std::abs(Ref)))
+            ++Count;
+      }
+   }
+   return Count;
+}
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   // initialize environments
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+      initLogging(DefEnv);
+      Field::init();
+
+      // Define a test field
+      std::vector<std::string> DimNames = {"NCells", "NVertLayers"};
+      auto TestField = Field::create("TestField", "Analysis test field", "m",
+                                     "", 0.0, 1000.0, -9.99e30, 2, DimNames);
+      Array2DReal TestData("TestData", NCells, NLevels);
+      TestField->attachData<Array2DReal>(TestData);
+
+      // Clock with 15 minute steps and an analysis interval of one hour
+      Calendar TestCalendar("TestCalendar", CalendarNoLeap);
+      TimeInstant StartTime(&TestCalendar, 1, 1, 1, 0, 0, 0);
+      TimeInterval TimeStep(15, TimeUnits::Minutes);
+      TimeInterval Interval(1, TimeUnits::Hours);
+      Clock TestClock(StartTime, TimeStep);
+      const R8 StepSeconds = TimeStep.getSeconds();
+
+      AnalysisMember *Member = AnalysisMember::create(
+          "TestHourly", Interval, StartTime, {"TestField"},
+          {AnalysisStat::Mean, AnalysisStat::Variance, AnalysisStat::Min,
+           AnalysisStat::Max, AnalysisStat::Integral});
+
+      if (Member != nullptr and Field::exists("TestHourly_Mean_TestField") and
+          FieldGroup::isFieldInGroup("TestHourly_Max_TestField", "TestHourly"))
+         LOG_INFO("AnalysisTest: create member PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("AnalysisTest: create member FAIL");
+      }
+
+      // Creating a member of an undefined field must fail
+      AnalysisMember *BadMember = AnalysisMember::create(
+          "TestBad", Interval, StartTime, {"NoSuchField"},
+          {AnalysisStat::Mean});
+      if (BadMember == nullptr)
+         LOG_INFO("AnalysisTest: undefined field PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("AnalysisTest: undefined field FAIL");
+      }
+
+      // Accumulate the values 1 to 4 added to the base field over the first
+      // interval
+      int Err = 0;
+      for (int Step = 1; Step <= 4; ++Step) {
+         TestClock.advance();
+         setTestField(TestData, Step);
+         Err += Member->accumulate(TestClock);
+      }
+
+      if (Err == 0 and Member->getNumSamples() == 4)
+         LOG_INFO("AnalysisTest: accumulate PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("AnalysisTest: accumulate FAIL");
+      }
+
+      // The mean of 1 to 4 is 2.5 and the variance is 1.25
+      int Count = 0;
+      Count += checkStat("TestHourly_Mean_TestField", 2.5, true, 1.0);
+      Count += checkStat("TestHourly_Variance_TestField", 1.25, false, 1.0);
+      Count += checkStat("TestHourly_Min_TestField", 1.0, true, 1.0);
+      Count += checkStat("TestHourly_Max_TestField", 4.0, true, 1.0);
+      if (Count == 0)
+         LOG_INFO("AnalysisTest: interval statistics PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("AnalysisTest: interval statistics FAIL");
+      }
+
+      // The integral is the sum of the values times the step length, with
+      // the base field added at each of the four steps
+      Array2DR8 Integral =
+          Field::getFieldDataArray<Array2DR8>("TestHourly_Integral_TestField");
+      HostArray2DR8 IntegralHost = createHostMirrorCopy(Integral);
+      Count                      = 0;
+      for (int ICell = 0; ICell < NCells; ++ICell) {
+         for (int K = 0; K < NLevels; ++K) {
+            const R8 Ref = StepSeconds * (10.0 + 4.0 * (10 * ICell + K));
+            if (std::abs(IntegralHost(ICell, K) - Ref) > 1.0e-10 * Ref)
+               ++Count;
+         }
+      }
+      if (Count == 0)
+         LOG_INFO("AnalysisTest: interval integral PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("AnalysisTest: interval integral FAIL");
+      }
+
+      // The next step starts a new interval
+      TestClock.advance();
+      setTestField(TestData, 5);
+      Err = Member->accumulate(TestClock);
+
+      Count = 0;
+      Count += checkStat("TestHourly_Mean_TestField", 5.0, true, 1.0);
+      Count += checkStat("TestHourly_Max_TestField", 5.0, true, 1.0);
+      Count += checkStat("TestHourly_Integral_TestField", 5.0, true,
+                         StepSeconds);
+      if (Err == 0 and Count == 0 and Member->getNumSamples() == 1)
+         LOG_INFO("AnalysisTest: new interval PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("AnalysisTest: new interval FAIL");
+      }
+
+      // Removing the member removes its statistics fields
+      AnalysisMember::clear();
+      if (!Field::exists("TestHourly_Mean_TestField") and
+          !FieldGroup::exists("TestHourly"))
+         LOG_INFO("AnalysisTest: clear PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("AnalysisTest: clear FAIL");
+      }
+
+      Field::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
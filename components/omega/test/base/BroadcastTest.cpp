@@ -14,6 +14,7 @@
 #include "mpi.h"
 
 #include <iostream>
+#include <vector>
 
 template <class MyType>
 void TestBroadcast(OMEGA::MachEnv *Env, std::string TypeName, int *RetVal) {
@@ -131,6 +132,79 @@ void TestBroadcast(OMEGA::MachEnv *Env, std::string TypeName, int *RetVal) {
    }
 }
 
+//------------------------------------------------------------------------------
+// Tests the broadcasts of structs, host arrays and buffers larger than one
+// broadcast chunk
+struct TestTable {
+   OMEGA::I4 NumEntries;
+   OMEGA::R8 Coeffs[16];
+};
+
+void TestLargeBroadcast(OMEGA::MachEnv *Env, int *RetVal) {
+
+   const int MyTask   = Env->getMyTask();
+   const int RootTask = 2;
+
+   // struct broadcast
+   TestTable Table;
+   Table.NumEntries = (MyTask == RootTask) ? 16 : -1;
+   for (int I = 0; I < 16; ++I)
+      Table.Coeffs[I] = (MyTask == RootTask) ? 0.5 * I : -1.0;
+
+   OMEGA::Broadcast(Table, Env, RootTask);
+
+   bool Match = (Table.NumEntries == 16);
+   for (int I = 0; I < 16; ++I)
+      Match = Match && (Table.Coeffs[I] == 0.5 * I);
+   if (Match) {
+      std::cout << "struct broadcast: PASS" << std::endl;
+   } else {
+      std::cout << "struct broadcast: FAIL" << std::endl;
+      *RetVal += 1;
+   }
+
+   // buffer of several chunks with a partial last chunk
+   std::size_t NumBytes = 3 * OMEGA::BcastChunkBytes + 123;
+   std::vector<char> Buffer(NumBytes);
+   for (std::size_t I = 0; I < NumBytes; ++I)
+      Buffer[I] = (MyTask == RootTask) ? static_cast<char>(I % 127) : 0;
+
+   OMEGA::broadcastBuffer(Buffer.data(), NumBytes, Env, RootTask);
+
+   Match = true;
+   for (std::size_t I = 0; I < NumBytes; ++I)
+      Match = Match && (Buffer[I] == static_cast<char>(I % 127));
+   if (Match) {
+      std::cout << "chunked buffer broadcast: PASS" << std::endl;
+   } else {
+      std::cout << "chunked buffer broadcast: FAIL" << std::endl;
+      *RetVal += 1;
+   }
+
+   // host array broadcast
+   OMEGA::HostArray2DR8 Array("BcastArray", 100, 60);
+   for (int I = 0; I < 100; ++I) {
+      for (int K = 0; K < 60; ++K) {
+         Array(I, K) = (MyTask == RootTask) ? I * 60 + K : -1.0;
+      }
+   }
+
+   OMEGA::Broadcast(Array, RootTask);
+
+   Match = true;
+   for (int I = 0; I < 100; ++I) {
+      for (int K = 0; K < 60; ++K) {
+         Match = Match && (Array(I, K) == I * 60 + K);
+      }
+   }
+   if (Match) {
+      std::cout << "host array broadcast: PASS" << std::endl;
+   } else {
+      std::cout << "host array broadcast: FAIL" << std::endl;
+      *RetVal += 1;
+   }
+}
+
 //------------------------------------------------------------------------------
 // The test driver for MachEnv. This tests the values stored in the Default
 // Environment and three other based on the three subsetting options.  All
@@ -142,6 +216,7 @@ int main(int argc, char *argv[]) {
 
    // Initialize the global MPI environment
    MPI_Init(&argc, &argv);
+   Kokkos::initialize();
 
    // Create reference values based on MPI_COMM_WORLD
    int WorldSize;
@@ -184,6 +259,9 @@ int main(int argc, char *argv[]) {
    // string Broadcast tests
    TestBroadcast<std::string>(DefEnv, "string", &RetVal);
 
+   // struct, host array and chunked buffer Broadcast tests
+   TestLargeBroadcast(DefEnv, &RetVal);
+
    // Initialize general subset environment
    int InclSize     = 4;
    int InclTasks[4] = {1, 2, 5, 7};
@@ -229,6 +307,7 @@ int main(int argc, char *argv[]) {
    OMEGA::MachEnv::removeEnv("Subset");
 
    // MPI_Status status;
+   Kokkos::finalize();
    MPI_Finalize();
 
    if (RetVal >= 256)
@@ -19,7 +19,12 @@
 #include "MachEnv.h"
 #include "mpi.h"
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <set>
+#include <string>
 
 //------------------------------------------------------------------------------
 // The initialization routine for Decomp testing. It calls various
@@ -148,6 +153,228 @@ int main(int argc, char *argv[]) {
                   RefSumVertices);
       }
 
+      // Test a decomposition created with the distributed ParMETIS method.
+      // The owned cells must again account for all cells and every halo
+      // cell must be owned by a remote task.
+      OMEGA::Decomp *ParDecomp = OMEGA::Decomp::create(
+          "ParMetis", DefEnv, NumTasks, OMEGA::PartMethodParMetisKWay,
+          DefDecomp->HaloWidth, "OmegaMesh.nc");
+      OMEGA::HostArray1DI4 ParCellIDH  = ParDecomp->CellIDH;
+      OMEGA::HostArray2DI4 ParCellLocH = ParDecomp->CellLocH;
+      LocSumCells                      = 0;
+      for (int n = 0; n < ParDecomp->NCellsOwned; ++n)
+         LocSumCells += ParCellIDH(n);
+      Err =
+          MPI_Allreduce(&LocSumCells, &SumCells, 1, MPI_INT32_T, MPI_SUM, Comm);
+      OMEGA::I4 NHaloErr = 0;
+      for (int n = ParDecomp->NCellsOwned; n < ParDecomp->NCellsAll; ++n) {
+         if (ParCellLocH(n, 0) == MyTask or ParCellLocH(n, 0) < 0 or
+             ParCellLocH(n, 0) >= NumTasks)
+            ++NHaloErr;
+      }
+
+      if (SumCells == RefSumCells and NHaloErr == 0) {
+         LOG_INFO("DecompTest: ParMETIS decomp test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: ParMETIS decomp test FAIL {} {} {}", SumCells,
+                  RefSumCells, NHaloErr);
+      }
+
+      // Test the remaining partition methods. For each, the owned cells
+      // must account for all cells.
+      const OMEGA::PartMethod Methods[3] = {OMEGA::PartMethodMetisRB,
+                                            OMEGA::PartMethodSFCHilbert,
+                                            OMEGA::PartMethodSFCMorton};
+      const std::string MethodNames[3]   = {"MetisRB", "SFCHilbert",
+                                            "SFCMorton"};
+      for (int IMethod = 0; IMethod < 3; ++IMethod) {
+         OMEGA::Decomp *MethodDecomp = OMEGA::Decomp::create(
+             MethodNames[IMethod], DefEnv, NumTasks, Methods[IMethod],
+             DefDecomp->HaloWidth, "OmegaMesh.nc");
+         LocSumCells = 0;
+         for (int n = 0; n < MethodDecomp->NCellsOwned; ++n)
+            LocSumCells += MethodDecomp->CellIDH(n);
+         Err = MPI_Allreduce(&LocSumCells, &SumCells, 1, MPI_INT32_T,
+                             MPI_SUM, Comm);
+
+         if (SumCells == RefSumCells and
+             OMEGA::getPartMethodFromStr(MethodNames[IMethod]) ==
+                 Methods[IMethod]) {
+            LOG_INFO("DecompTest: {} decomp test PASS", MethodNames[IMethod]);
+         } else {
+            RetVal += 1;
+            LOG_INFO("DecompTest: {} decomp test FAIL {} {}",
+                     MethodNames[IMethod], SumCells, RefSumCells);
+         }
+         OMEGA::Decomp::erase(MethodNames[IMethod]);
+      }
+
+      // Test the locality reordering of local cells. The reordered
+      // decomposition must contain the same owned cells and halo layers as
+      // the default decomposition, the owned cells must be located at their
+      // new local address and all cell neighbors must be consistent.
+      OMEGA::Decomp *ReorderDecomp = OMEGA::Decomp::create(
+          "Reorder", DefEnv, NumTasks, OMEGA::PartMethodMetisKWay,
+          DefDecomp->HaloWidth, "OmegaMesh.nc", "", true);
+      OMEGA::I4 NReorderErr = 0;
+      if (ReorderDecomp->NCellsOwned != DefDecomp->NCellsOwned or
+          ReorderDecomp->NCellsAll != DefDecomp->NCellsAll) {
+         ++NReorderErr;
+      } else {
+         OMEGA::I4 LayerStart = 0;
+         for (int Halo = -1; Halo < DefDecomp->HaloWidth; ++Halo) {
+            OMEGA::I4 LayerEnd = Halo < 0 ? DefDecomp->NCellsOwned
+                                          : DefDecomp->NCellsHaloH(Halo);
+            std::set<OMEGA::I4> DefLayer;
+            std::set<OMEGA::I4> ReorderLayer;
+            for (int n = LayerStart; n < LayerEnd; ++n) {
+               DefLayer.insert(DefDecomp->CellIDH(n));
+               ReorderLayer.insert(ReorderDecomp->CellIDH(n));
+            }
+            if (DefLayer != ReorderLayer)
+               ++NReorderErr;
+            LayerStart = LayerEnd;
+         }
+         for (int n = 0; n < ReorderDecomp->NCellsOwned; ++n) {
+            if (ReorderDecomp->CellLocH(n, 0) != MyTask or
+                ReorderDecomp->CellLocH(n, 1) != n)
+               ++NReorderErr;
+         }
+         std::map<OMEGA::I4, OMEGA::I4> DefLocal;
+         for (int n = 0; n < DefDecomp->NCellsAll; ++n)
+            DefLocal[DefDecomp->CellIDH(n)] = n;
+         for (int n = 0; n < ReorderDecomp->NCellsOwned; ++n) {
+            OMEGA::I4 DefCell = DefLocal[ReorderDecomp->CellIDH(n)];
+            for (int Edge = 0; Edge < ReorderDecomp->MaxEdges; ++Edge) {
+               OMEGA::I4 Nbr    = ReorderDecomp->CellsOnCellH(n, Edge);
+               OMEGA::I4 DefNbr = DefDecomp->CellsOnCellH(DefCell, Edge);
+               OMEGA::I4 NbrID  = Nbr < ReorderDecomp->NCellsAll
+                                      ? ReorderDecomp->CellIDH(Nbr)
+                                      : 0;
+               OMEGA::I4 DefID  = DefNbr < DefDecomp->NCellsAll
+                                      ? DefDecomp->CellIDH(DefNbr)
+                                      : 0;
+               if (NbrID != DefID)
+                  ++NReorderErr;
+            }
+         }
+      }
+
+      if (NReorderErr == 0) {
+         LOG_INFO("DecompTest: local reordering test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: local reordering test FAIL {}", NReorderErr);
+      }
+      OMEGA::Decomp::erase("Reorder");
+
+      // Test writing and reading partition files in both the Omega NetCDF
+      // and MPAS text formats. The first decomposition computes and writes
+      // the partition and the second reads it. The cell arrays of both
+      // decompositions must be identical.
+      const std::string PartFiles[2] = {"DecompTestPart.nc",
+                                        "DecompTestPart.info.part"};
+      for (int IFile = 0; IFile < 2; ++IFile) {
+         const std::string &PartFile = PartFiles[IFile];
+         if (IsMaster)
+            std::remove(PartFile.c_str());
+         MPI_Barrier(Comm);
+
+         OMEGA::Decomp *WriteDecomp = OMEGA::Decomp::create(
+             "PartWrite", DefEnv, NumTasks, OMEGA::PartMethodMetisKWay,
+             DefDecomp->HaloWidth, "OmegaMesh.nc", PartFile);
+         OMEGA::Decomp *ReadDecomp = OMEGA::Decomp::create(
+             "PartRead", DefEnv, NumTasks, OMEGA::PartMethodMetisKWay,
+             DefDecomp->HaloWidth, "OmegaMesh.nc", PartFile);
+
+         OMEGA::I4 NPartErr = 0;
+         if (WriteDecomp->NCellsOwned != ReadDecomp->NCellsOwned or
+             WriteDecomp->NCellsAll != ReadDecomp->NCellsAll) {
+            ++NPartErr;
+         } else {
+            for (int n = 0; n < WriteDecomp->NCellsAll; ++n) {
+               if (WriteDecomp->CellIDH(n) != ReadDecomp->CellIDH(n) or
+                   WriteDecomp->CellLocH(n, 0) != ReadDecomp->CellLocH(n, 0) or
+                   WriteDecomp->CellLocH(n, 1) != ReadDecomp->CellLocH(n, 1))
+                  ++NPartErr;
+            }
+         }
+
+         if (NPartErr == 0) {
+            LOG_INFO("DecompTest: partition file {} test PASS", PartFile);
+         } else {
+            RetVal += 1;
+            LOG_INFO("DecompTest: partition file {} test FAIL", PartFile);
+         }
+
+         OMEGA::Decomp::erase("PartWrite");
+         OMEGA::Decomp::erase("PartRead");
+      }
+
+      // Test partitions weighted by the active levels of each cell with the
+      // METIS and space-filling curve methods. The owned cells must account
+      // for all cells and the active levels of the owned cells must sum to
+      // the same total for both. The costs fit to work times proportional to
+      // the levels are then written to a cost file and used to rebalance.
+      const std::string CostFile = "DecompTestCost.txt";
+      if (IsMaster)
+         std::remove(CostFile.c_str());
+      MPI_Barrier(Comm);
+
+      OMEGA::PartWeights Weights;
+      Weights.ByLevels    = true;
+      Weights.Edges       = true;
+      Weights.NVertLevels = 60;
+      Weights.CostFile    = CostFile;
+      OMEGA::I8 SumLevels[2];
+      OMEGA::I4 SumWgtCells[2];
+      const OMEGA::PartMethod WgtMethods[2] = {OMEGA::PartMethodMetisKWay,
+                                               OMEGA::PartMethodSFCHilbert};
+      for (int IMethod = 0; IMethod < 2; ++IMethod) {
+         OMEGA::Decomp *WgtDecomp = OMEGA::Decomp::create(
+             "Weighted", DefEnv, NumTasks, WgtMethods[IMethod],
+             DefDecomp->HaloWidth, "OmegaMesh.nc", "", false, Weights);
+         LocSumCells = 0;
+         for (int n = 0; n < WgtDecomp->NCellsOwned; ++n)
+            LocSumCells += WgtDecomp->CellIDH(n);
+         Err = MPI_Allreduce(&LocSumCells, &SumWgtCells[IMethod], 1,
+                             MPI_INT32_T, MPI_SUM, Comm);
+         Err += MPI_Allreduce(&WgtDecomp->NLevelsOwned, &SumLevels[IMethod], 1,
+                              MPI_INT64_T, MPI_SUM, Comm);
+         if (IMethod == 0)
+            Err += WgtDecomp->writeCost(DefEnv,
+                                        1.0e-6 * WgtDecomp->NLevelsOwned);
+         OMEGA::Decomp::erase("Weighted");
+      }
+      MPI_Barrier(Comm);
+
+      OMEGA::Decomp *CostDecomp = OMEGA::Decomp::create(
+          "Rebalanced", DefEnv, NumTasks, OMEGA::PartMethodMetisKWay,
+          DefDecomp->HaloWidth, "OmegaMesh.nc", "", false, Weights);
+      OMEGA::I8 SumCostLevels = 0;
+      Err += MPI_Allreduce(&CostDecomp->NLevelsOwned, &SumCostLevels, 1,
+                           MPI_INT64_T, MPI_SUM, Comm);
+      int CostFileExists = 0;
+      if (IsMaster)
+         CostFileExists = std::ifstream(CostFile).good();
+      MPI_Bcast(&CostFileExists, 1, MPI_INT, 0, Comm);
+
+      if (Err == 0 and SumWgtCells[0] == RefSumCells and
+          SumWgtCells[1] == RefSumCells and SumLevels[0] > 0 and
+          SumLevels[0] == SumLevels[1] and SumCostLevels == SumLevels[0] and
+          CostFileExists) {
+         LOG_INFO("DecompTest: weighted decomp test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: weighted decomp test FAIL {} {} {} {}",
+                  SumWgtCells[0], SumWgtCells[1], SumLevels[0], SumLevels[1]);
+      }
+      OMEGA::Decomp::erase("Rebalanced");
+      MPI_Barrier(Comm);
+      if (IsMaster)
+         std::remove(CostFile.c_str());
+
       // Clean up
       OMEGA::Decomp::clear();
       OMEGA::MachEnv::removeAll();
@@ -93,6 +93,125 @@ void haloExchangeTest(
 
 } // end haloExchangeTest
 
+//------------------------------------------------------------------------------
+// This function template tests the halo exchange of a device array. The input
+// host arrays are the same as in haloExchangeTest. TestArray is copied to a
+// device array, the device array is exchanged and then copied back to the host
+// where it is compared to InitArray. Depending on the Halo setting, the device
+// array is exchanged either directly from device buffers or through a host
+// copy.
+
+template <typename T>
+void deviceHaloExchangeTest(
+    OMEGA::Halo *MyHalo,
+    T InitArray,  /// Host array initialized based on global IDs
+    T TestArray,  /// Host array only initialized in owned elements
+    const char *Label,                          /// Unique label for test
+    OMEGA::I4 &TotErr,                          /// Integer to track errors
+    OMEGA::MeshElement ThisElem = OMEGA::OnCell /// index space, cell by default
+) {
+
+   OMEGA::I4 IErr{0}; // error code
+
+   // Copy test array to device and perform halo exchange
+   auto TestArrayDevice = OMEGA::createDeviceMirrorCopy(TestArray);
+   IErr = MyHalo->exchangeFullArrayHalo(TestArrayDevice, ThisElem);
+   if (IErr != 0) {
+      LOG_ERROR("HaloTest: Error during {} halo exchange", Label);
+      LOG_INFO("HaloTest: {} exchange test FAIL", Label);
+      TotErr += -1;
+      return;
+   }
+
+   // Copy result back to host and compare
+   auto TestArrayHost = OMEGA::createHostMirrorCopy(TestArrayDevice);
+
+   Kokkos::View<typename T::value_type *, typename T::array_layout,
+                typename T::memory_space>
+       CollapsedInit(InitArray.data(), InitArray.size());
+   Kokkos::View<typename T::value_type *, typename T::array_layout,
+                typename T::memory_space>
+       CollapsedTest(TestArrayHost.data(), TestArrayHost.size());
+
+   for (int N = 0; N < InitArray.size(); ++N) {
+      if (CollapsedInit(N) != CollapsedTest(N)) {
+         IErr = -1;
+         break;
+      }
+   }
+
+   if (IErr == 0) {
+      LOG_INFO("HaloTest: {} exchange test PASS", Label);
+   } else {
+      LOG_INFO("HaloTest: {} exchange test FAIL", Label);
+      TotErr += -1;
+   }
+
+   return;
+
+} // end deviceHaloExchangeTest
+
+//------------------------------------------------------------------------------
+// This function template tests the split-phase halo exchange by starting
+// exchanges of a cell array and an edge array at the same time and then
+// finishing them in reverse order. The input arrays are as described for
+// haloExchangeTest.
+
+template <typename TC, typename TE>
+void splitHaloExchangeTest(
+    OMEGA::Halo *MyHalo,
+    TC InitCell,       /// Cell array initialized based on global IDs
+    TC &TestCell,      /// Cell array only initialized in owned elements
+    TE InitEdge,       /// Edge array initialized based on global IDs
+    TE &TestEdge,      /// Edge array only initialized in owned elements
+    const char *Label, /// Unique label for test
+    OMEGA::I4 &TotErr  /// Integer to track errors
+) {
+
+   OMEGA::I4 IErr{0}; // error code
+
+   IErr += MyHalo->startExchange(TestCell, OMEGA::OnCell);
+   IErr += MyHalo->startExchange(TestEdge, OMEGA::OnEdge);
+   IErr += MyHalo->finishExchange(TestEdge, OMEGA::OnEdge);
+   IErr += MyHalo->finishExchange(TestCell, OMEGA::OnCell);
+   if (IErr != 0) {
+      LOG_ERROR("HaloTest: Error during {} halo exchange", Label);
+      LOG_INFO("HaloTest: {} exchange test FAIL", Label);
+      TotErr += -1;
+      return;
+   }
+
+   Kokkos::View<typename TC::value_type *, typename TC::array_layout,
+                typename TC::memory_space>
+       CollapsedInitCell(InitCell.data(), InitCell.size());
+   Kokkos::View<typename TC::value_type *, typename TC::array_layout,
+                typename TC::memory_space>
+       CollapsedTestCell(TestCell.data(), TestCell.size());
+   for (int N = 0; N < InitCell.size(); ++N) {
+      if (CollapsedInitCell(N) != CollapsedTestCell(N)) {
+         IErr = -1;
+         break;
+      }
+   }
+
+   for (int N = 0; N < InitEdge.size(); ++N) {
+      if (InitEdge(N) != TestEdge(N)) {
+         IErr = -1;
+         break;
+      }
+   }
+
+   if (IErr == 0) {
+      LOG_INFO("HaloTest: {} exchange test PASS", Label);
+   } else {
+      LOG_INFO("HaloTest: {} exchange test FAIL", Label);
+      TotErr += -1;
+   }
+
+   return;
+
+} // end splitHaloExchangeTest
+
 //------------------------------------------------------------------------------
 // Initialization routine for Halo tests. Calls all the init routines needed
 // to create the default Halo.
@@ -356,6 +475,167 @@ int main(int argc, char *argv[]) {
       haloExchangeTest(DefHalo, Init3DR4, Test3DR4, "3DR4", TotErr);
       haloExchangeTest(DefHalo, Init3DR8, Test3DR8, "3DR8", TotErr);
 
+      // Run device array tests for Real arrays, first exchanging through
+      // host copies and then directly from device buffers
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         Test1DR8(ICell) = -1;
+         for (int K = 0; K < N2; ++K) {
+            Test2DR8(ICell, K) = -1;
+         }
+         for (int K = 0; K < N3; ++K) {
+            for (int J = 0; J < N2; ++J) {
+               Test3DR8(K, ICell, J) = -1;
+            }
+         }
+      }
+
+      bool SaveDeviceExchange = DefHalo->isDeviceExchange();
+      for (bool DeviceExchange : {false, true}) {
+         DefHalo->setDeviceExchange(DeviceExchange);
+         const char *Suffix = DeviceExchange ? "direct" : "host copy";
+         std::string Label1D = std::string("Device 1DR8 ") + Suffix;
+         std::string Label2D = std::string("Device 2DR8 ") + Suffix;
+         std::string Label3D = std::string("Device 3DR8 ") + Suffix;
+         deviceHaloExchangeTest(DefHalo, Init1DR8, Test1DR8, Label1D.c_str(),
+                                TotErr);
+         deviceHaloExchangeTest(DefHalo, Init2DR8, Test2DR8, Label2D.c_str(),
+                                TotErr);
+         deviceHaloExchangeTest(DefHalo, Init3DR8, Test3DR8, Label3D.c_str(),
+                                TotErr);
+      }
+      DefHalo->setDeviceExchange(SaveDeviceExchange);
+
+      // Run split-phase test with a cell and an edge exchange in flight at
+      // the same time
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         for (int K = 0; K < N2; ++K) {
+            Test2DR8(ICell, K) = -1;
+         }
+      }
+      for (int IEdge = DefDecomp->NEdgesOwned; IEdge < DefDecomp->NEdgesAll;
+           ++IEdge) {
+         Test1DI4Edge(IEdge) = -1;
+      }
+      splitHaloExchangeTest(DefHalo, Init2DR8, Test2DR8, Init1DI4Edge,
+                            Test1DI4Edge, "Split-phase 2DR8 Cell 1DI4 Edge",
+                            TotErr);
+
+      // Run aggregated group exchange test with arrays of different types
+      // and dimensions on cells and edges
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         Test1DI4Cell(ICell) = -1;
+         for (int K = 0; K < N2; ++K) {
+            Test2DR8(ICell, K) = -1;
+         }
+         for (int K = 0; K < N3; ++K) {
+            for (int J = 0; J < N2; ++J) {
+               Test3DR4(K, ICell, J) = -1;
+            }
+         }
+      }
+      for (int IEdge = DefDecomp->NEdgesOwned; IEdge < DefDecomp->NEdgesAll;
+           ++IEdge) {
+         Test1DI4Edge(IEdge) = -1;
+      }
+
+      OMEGA::HaloGroup TestGroup;
+      TestGroup.add(Test1DI4Cell, OMEGA::OnCell);
+      TestGroup.add(Test2DR8, OMEGA::OnCell);
+      TestGroup.add(Test1DI4Edge, OMEGA::OnEdge);
+      TestGroup.add(Test3DR4, OMEGA::OnCell);
+
+      IErr = DefHalo->exchangeGroupHalo(TestGroup);
+      bool GroupPass = (IErr == 0);
+      for (int ICell = 0; ICell < NumAll and GroupPass; ++ICell) {
+         GroupPass = Test1DI4Cell(ICell) == Init1DI4Cell(ICell);
+         for (int K = 0; K < N2 and GroupPass; ++K) {
+            GroupPass = Test2DR8(ICell, K) == Init2DR8(ICell, K);
+         }
+         for (int K = 0; K < N3 and GroupPass; ++K) {
+            for (int J = 0; J < N2 and GroupPass; ++J) {
+               GroupPass = Test3DR4(K, ICell, J) == Init3DR4(K, ICell, J);
+            }
+         }
+      }
+      for (int IEdge = 0; IEdge < DefDecomp->NEdgesAll and GroupPass;
+           ++IEdge) {
+         GroupPass = Test1DI4Edge(IEdge) == Init1DI4Edge(IEdge);
+      }
+      if (GroupPass) {
+         LOG_INFO("HaloTest: Group exchange test PASS");
+      } else {
+         LOG_INFO("HaloTest: Group exchange test FAIL");
+         TotErr += -1;
+      }
+
+      // Run tests with persistent MPI requests, repeating each exchange so
+      // that the cached requests and buffers are reused
+      DefHalo->setPersistentComm(true);
+      for (int IRep = 0; IRep < 2; ++IRep) {
+         for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+            for (int K = 0; K < N2; ++K) {
+               Test2DR8(ICell, K) = -1;
+            }
+         }
+         for (int IEdge = DefDecomp->NEdgesOwned;
+              IEdge < DefDecomp->NEdgesAll; ++IEdge) {
+            Test1DI4Edge(IEdge) = -1;
+         }
+         haloExchangeTest(DefHalo, Init2DR8, Test2DR8, "Persistent 2DR8",
+                          TotErr);
+         haloExchangeTest(DefHalo, Init1DI4Edge, Test1DI4Edge,
+                          "Persistent 1DI4 Edge", TotErr, OMEGA::OnEdge);
+      }
+      DefHalo->setPersistentComm(false);
+
+      // Run tests with the neighborhood collective backend
+      IErr = DefHalo->setNeighborCollective(true);
+      if (IErr != 0) {
+         LOG_ERROR("HaloTest: error enabling neighborhood collective");
+         TotErr += -1;
+      }
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         for (int K = 0; K < N2; ++K) {
+            Test2DR8(ICell, K) = -1;
+         }
+      }
+      for (int IEdge = DefDecomp->NEdgesOwned; IEdge < DefDecomp->NEdgesAll;
+           ++IEdge) {
+         Test1DI4Edge(IEdge) = -1;
+      }
+      haloExchangeTest(DefHalo, Init2DR8, Test2DR8, "Neighbor collective 2DR8",
+                       TotErr);
+      haloExchangeTest(DefHalo, Init1DI4Edge, Test1DI4Edge,
+                       "Neighbor collective 1DI4 Edge", TotErr, OMEGA::OnEdge);
+      DefHalo->setNeighborCollective(false);
+
+      // Run partial-depth test exchanging only the first cell halo layer,
+      // the first layer must match the initial array and the remaining
+      // halo layers must be unchanged
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         for (int K = 0; K < N2; ++K) {
+            Test2DR8(ICell, K) = -1;
+         }
+      }
+      IErr = DefHalo->exchangeFullArrayHalo(Test2DR8, OMEGA::OnCell, 1);
+      OMEGA::I4 NumLayer1 = DefDecomp->NCellsHaloH(0);
+      bool PartialPass    = (IErr == 0);
+      for (int ICell = 0; ICell < NumAll and PartialPass; ++ICell) {
+         for (int K = 0; K < N2 and PartialPass; ++K) {
+            if (ICell < NumLayer1) {
+               PartialPass = Test2DR8(ICell, K) == Init2DR8(ICell, K);
+            } else {
+               PartialPass = Test2DR8(ICell, K) == -1;
+            }
+         }
+      }
+      if (PartialPass) {
+         LOG_INFO("HaloTest: Partial depth exchange test PASS");
+      } else {
+         LOG_INFO("HaloTest: Partial depth exchange test FAIL");
+         TotErr += -1;
+      }
+
       // Initialize and run 4D tests
       for (int L = 0; L < N4; ++L) {
          for (int K = 0; K < N3; ++K) {
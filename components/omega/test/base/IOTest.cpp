@@ -18,6 +18,7 @@
 #include "mpi.h"
 
 #include <iostream>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // The initialization routine for IO testing. It calls various
@@ -744,6 +745,15 @@ int main(int argc, char *argv[]) {
       OMEGA::HostArray2DR4 NewR4Vrtx("NewR4Vrtx", NVerticesSize, NVertLevels);
       OMEGA::HostArray2DR8 NewR8Vrtx("NewR8Vrtx", NVerticesSize, NVertLevels);
 
+      OMEGA::HostArray2DI4 BatchI4Vrtx("BatchI4Vrtx", NVerticesSize,
+                                       NVertLevels);
+      OMEGA::HostArray2DI8 BatchI8Vrtx("BatchI8Vrtx", NVerticesSize,
+                                       NVertLevels);
+      OMEGA::HostArray2DR4 BatchR4Vrtx("BatchR4Vrtx", NVerticesSize,
+                                       NVertLevels);
+      OMEGA::HostArray2DR8 BatchR8Vrtx("BatchR8Vrtx", NVerticesSize,
+                                       NVertLevels);
+
       Err = OMEGA::IO::readArray(NewI4Cell.data(), NCellsSize * NVertLevels,
                                  "CellI4", InFileID, DecompCellI4, VarIDCellI4);
       if (Err != 0) {
@@ -819,6 +829,29 @@ int main(int argc, char *argv[]) {
          LOG_ERROR("IOTest: error writing R8 array on vertices FAIL");
       }
 
+      // Read the same vertex arrays again as a single batch
+      std::vector<OMEGA::IO::ReadRequest> VrtxReads{
+          {BatchI4Vrtx.data(), NVerticesSize * NVertLevels, "VrtxI4",
+           DecompVrtxI4},
+          {BatchI8Vrtx.data(), NVerticesSize * NVertLevels, "VrtxI8",
+           DecompVrtxI8},
+          {BatchR4Vrtx.data(), NVerticesSize * NVertLevels, "VrtxR4",
+           DecompVrtxR4},
+          {BatchR8Vrtx.data(), NVerticesSize * NVertLevels, "VrtxR8",
+           DecompVrtxR8}};
+      Err = OMEGA::IO::readArrays(VrtxReads, InFileID);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("IOTest: error reading batch of vertex arrays FAIL");
+      }
+      for (const OMEGA::IO::ReadRequest &Req : VrtxReads) {
+         if (Req.VarID < 0) {
+            RetVal += 1;
+            LOG_ERROR("IOTest: batched read missing ID for {} FAIL",
+                      Req.VarName);
+         }
+      }
+
       // Check that arrays match the reference cases that were written
       // Only check the owned values - these would need to be followed by
       // a halo update.
@@ -946,6 +979,47 @@ int main(int argc, char *argv[]) {
          LOG_INFO("IOTest: read/write array R8 on Vertices test FAIL");
       }
 
+      Err1 = 0;
+      Err2 = 0;
+      Err3 = 0;
+      Err4 = 0;
+      for (int Vrtx = 0; Vrtx < NVerticesOwned; ++Vrtx) {
+         for (int k = 0; k < NVertLevels; ++k) {
+            if (BatchI4Vrtx(Vrtx, k) != RefI4Vrtx(Vrtx, k))
+               Err1++;
+            if (BatchI8Vrtx(Vrtx, k) != RefI8Vrtx(Vrtx, k))
+               Err2++;
+            if (BatchR4Vrtx(Vrtx, k) != RefR4Vrtx(Vrtx, k))
+               Err3++;
+            if (BatchR8Vrtx(Vrtx, k) != RefR8Vrtx(Vrtx, k))
+               Err4++;
+         }
+      }
+      if (Err1 == 0) {
+         LOG_INFO("IOTest: batched read array I4 on Vertices test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("IOTest: batched read array I4 on Vertices test FAIL");
+      }
+      if (Err2 == 0) {
+         LOG_INFO("IOTest: batched read array I8 on Vertices test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("IOTest: batched read array I8 on Vertices test FAIL");
+      }
+      if (Err3 == 0) {
+         LOG_INFO("IOTest: batched read array R4 on Vertices test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("IOTest: batched read array R4 on Vertices test FAIL");
+      }
+      if (Err4 == 0) {
+         LOG_INFO("IOTest: batched read array R8 on Vertices test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("IOTest: batched read array R8 on Vertices test FAIL");
+      }
+
       // Read array attributes
       OMEGA::I4 VarMetaI4New;
       OMEGA::I8 VarMetaI8New;
@@ -16,6 +16,7 @@
 #include "Logging.h"
 #include "mpi.h"
 
+#include <algorithm>
 #include <iostream>
 
 //------------------------------------------------------------------------------
@@ -498,6 +499,37 @@ int main(int argc, char *argv[]) {
    }
 #endif
 
+   //---------------------------------------------------------------------------
+   // Test selection of the vertical chunk width and the tail chunk
+
+   {
+      const int NVertLevels = 60;
+      const int Width       = OMEGA::selectVecWidth(NVertLevels);
+      const int NChunks     = OMEGA::numVertChunks(Width, NVertLevels);
+
+      // The width is one of the instantiated widths, does not exceed the
+      // maximum width and the chunks cover all levels exactly once
+      bool WidthValid = (Width == 1 or Width == 4 or Width == 8 or
+                         Width == 16 or Width == 32) and
+                        Width <= std::max(OMEGA::MaxVecWidth, 1);
+      bool CoverValid = (NChunks - 1) * Width < NVertLevels and
+                        NChunks * Width >= NVertLevels;
+
+      // A width of 8 on 60 levels has seven full chunks and a tail of four,
+      // and a single level never uses a width larger than one
+      bool TailValid = OMEGA::numVertChunks(8, NVertLevels) == 8 and
+                       OMEGA::chunkLength<8>(56, NVertLevels) == 4 and
+                       OMEGA::chunkLength<8>(48, NVertLevels) == 8 and
+                       OMEGA::selectVecWidth(1) == 1;
+
+      if (WidthValid and CoverValid and TailValid)
+         std::cout << "vertical chunk width test: PASS" << std::endl;
+      else {
+         RetVal += 1;
+         std::cout << "vertical chunk width test: FAIL" << std::endl;
+      }
+   }
+
    // finalize and clean up environments (test both removal functions)
    OMEGA::MachEnv::removeEnv("Contig");
    OMEGA::MachEnv::removeAll();
@@ -0,0 +1,173 @@
+//===-- Test driver for OMEGA packs ------------------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA packs of vertical levels
+///
+/// This driver tests the Pack type used in the vertical chunk loops of
+/// Omega kernels. It tests the element-wise arithmetic, comparison and
+/// selection of packs and the loading and storing of full and tail chunks,
+/// on the host and in a device kernel, and outputs a PASS for each test
+/// that gives the expected result.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include <iostream>
+
+#include "DataTypes.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "Pack.h"
+#include "mpi.h"
+
+using namespace OMEGA;
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   // initialize environments
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      constexpr int W = 4;
+
+      // Test element-wise arithmetic
+      RealPack<W> A;
+      RealPack<W> B(2._Real);
+      for (int I = 0; I < W; ++I)
+         A[I] = I + 1;
+
+      RealPack<W> C = (A + B) * A - A / B;
+      C += 1._Real;
+      C -= -A;
+
+      int icount = 0;
+      for (int I = 0; I < W; ++I) {
+         const Real Ai  = I + 1;
+         const Real Ref = (Ai + 2._Real) * Ai - Ai / 2._Real + 1._Real + Ai;
+         if (C[I] != Ref)
+            ++icount;
+      }
+
+      if (icount == 0)
+         std::cout << "Pack arithmetic: PASS" << std::endl;
+      else {
+         RetVal += 1;
+         std::cout << "Pack arithmetic: FAIL" << std::endl;
+      }
+
+      // Test comparison, selection and maximum
+      RealPack<W> Vel;
+      Vel[0] = 1._Real;
+      Vel[1] = -1._Real;
+      Vel[2] = 0._Real;
+      Vel[3] = 0._Real;
+      RealPack<W> H0;
+      RealPack<W> H1;
+      H0[2] = 3._Real;
+      H1[2] = 1._Real;
+      H0[3] = 1._Real;
+      H1[3] = 3._Real;
+      for (int I = 0; I < 2; ++I) {
+         H0[I] = 5._Real;
+         H1[I] = 7._Real;
+      }
+
+      const RealPack<W> Upwind = select(
+          Vel > 0._Real, H0, select(Vel < 0._Real, H1, max(H0, H1)));
+
+      if (Upwind[0] == 5._Real and Upwind[1] == 7._Real and
+          Upwind[2] == 3._Real and Upwind[3] == 3._Real)
+         std::cout << "Pack select: PASS" << std::endl;
+      else {
+         RetVal += 1;
+         std::cout << "Pack select: FAIL" << std::endl;
+      }
+
+      // Test loads and stores of full and tail chunks on the host with a
+      // number of levels that is not a multiple of the pack width
+      const int NCells  = 3;
+      const int NLevels = 2 * W + 1;
+
+      HostArray2DReal InArr("InArr", NCells, NLevels);
+      HostArray2DReal OutArr("OutArr", NCells, NLevels);
+      for (int ICell = 0; ICell < NCells; ++ICell) {
+         for (int K = 0; K < NLevels; ++K) {
+            InArr(ICell, K)  = ICell * NLevels + K;
+            OutArr(ICell, K) = -1._Real;
+         }
+      }
+
+      icount = 0;
+      for (int ICell = 0; ICell < NCells; ++ICell) {
+         for (int KChunk = 0; KChunk < numVertChunks(W, NLevels); ++KChunk) {
+            const int KStart = KChunk * W;
+            const int KLen   = chunkLength<W>(KStart, InArr);
+
+            const RealPack<W> Val = loadPack<W>(InArr, KStart, KLen, ICell);
+
+            // lanes past the last level are zero
+            for (int KVec = KLen; KVec < W; ++KVec) {
+               if (Val[KVec] != 0._Real)
+                  ++icount;
+            }
+
+            storePack(OutArr, 2._Real * Val, KStart, KLen, ICell);
+         }
+      }
+
+      for (int ICell = 0; ICell < NCells; ++ICell) {
+         for (int K = 0; K < NLevels; ++K) {
+            if (OutArr(ICell, K) != 2._Real * InArr(ICell, K))
+               ++icount;
+         }
+      }
+
+      if (icount == 0)
+         std::cout << "Pack host load and store: PASS" << std::endl;
+      else {
+         RetVal += 1;
+         std::cout << "Pack host load and store: FAIL" << std::endl;
+      }
+
+      // Test loads and stores in a device kernel using the default width
+      Array2DReal InDev     = createDeviceMirrorCopy(InArr);
+      Array2DAuxReal OutDev = Array2DAuxReal("OutDev", NCells, NLevels);
+      const int NChunks     = numVertChunks(VecLength, NLevels);
+
+      parallelFor(
+          {NCells, NChunks}, KOKKOS_LAMBDA(int ICell, int KChunk) {
+             const int KStart = KChunk * VecLength;
+             const int KLen   = chunkLength<VecLength>(KStart, OutDev);
+
+             const RealPack<VecLength> Val =
+                 loadPack<VecLength>(InDev, KStart, KLen, ICell);
+             storePack(OutDev, Val + 1._Real, KStart, KLen, ICell);
+          });
+
+      auto OutHost = createHostMirrorCopy(OutDev);
+
+      icount = 0;
+      for (int ICell = 0; ICell < NCells; ++ICell) {
+         for (int K = 0; K < NLevels; ++K) {
+            const AuxReal Ref = InArr(ICell, K) + 1._Real;
+            if (OutHost(ICell, K) != Ref)
+               ++icount;
+         }
+      }
+
+      if (icount == 0)
+         std::cout << "Pack device load and store: PASS" << std::endl;
+      else {
+         RetVal += 1;
+         std::cout << "Pack device load and store: FAIL" << std::endl;
+      }
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
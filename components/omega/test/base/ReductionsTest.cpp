@@ -6,7 +6,9 @@
 //
 //===-----------------------------------------------------------------------===/
 
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include <mpi.h>
 
@@ -367,6 +369,130 @@ int main(int argc, char *argv[]) {
          RetVal += 1;
       printf("Global sum device A1DR4: %s (exp,act=%.10f,%.10f)\n", res, expR4,
              MyResR4);
+
+      // test SUM of device array over an index range
+      std::vector<I4> DevRange{2, 7};
+      err   = globalSum(DevArr1DI4, Comm, &MyResI4, &DevRange);
+      expI4 = (2 + 3 + 4 + 5 + 6) * MySize;
+      res   = "FAIL";
+      if (err == 0 && MyResI4 == expI4)
+         res = "PASS";
+      else
+         RetVal += 1;
+      printf("Global sum device A1DI4 range: %s (exp,act=%d,%d)\n", res, expI4,
+             MyResI4);
+
+      // test batched SUM of R8 arrays on device
+      const int NBatch = 3;
+      std::vector<Array2DR8> DevBatch;
+      for (int n = 0; n < NBatch; n++) {
+         Array2DR8 DevArr2DR8("DevArr2DR8", NumCells, NumVertLvls);
+         parallelFor(
+             {NumCells, NumVertLvls}, KOKKOS_LAMBDA(int i, int j) {
+                DevArr2DR8(i, j) = (n + 1) * (i * NumVertLvls + j) + 0.25;
+             });
+         DevBatch.push_back(DevArr2DR8);
+      }
+      Kokkos::fence();
+
+      // Only the first NCellsOwned cells contribute to the batched sum
+      I4 NCellsOwned = NumCells - 2;
+      std::vector<R8> BatchSums;
+      std::vector<R8> BatchNonRep;
+      err  = globalSumBatch(DevBatch, NCellsOwned, Comm, BatchSums);
+      err += globalSumBatch(DevBatch, NCellsOwned, Comm, BatchNonRep, nullptr,
+                            nullptr, false);
+      res = "PASS";
+      if (err != 0)
+         res = "FAIL";
+      std::vector<I4> OwnedRange{0, NCellsOwned * NumVertLvls};
+      for (int n = 0; n < NBatch; n++) {
+         R8 Single = 0.0;
+         err       = globalSum(DevBatch[n], Comm, &Single, &OwnedRange);
+         if (err != 0 || BatchSums[n] != Single || BatchNonRep[n] != Single)
+            res = "FAIL";
+      }
+      if (strcmp(res, "FAIL") == 0)
+         RetVal += 1;
+      printf("Global sum batch device A2DR8: %s\n", res);
+
+      // test batched SUM restricted to a range of levels in each cell
+      Array1DI4 MinLevel("MinLevel", NumCells);
+      Array1DI4 MaxLevel("MaxLevel", NumCells);
+      parallelFor(
+          {NumCells}, KOKKOS_LAMBDA(int i) {
+             MinLevel(i) = i % 3;
+             MaxLevel(i) = NumVertLvls - 1 - i % 4;
+          });
+      Kokkos::fence();
+      err = globalSumBatch(DevBatch, NCellsOwned, Comm, BatchSums, &MinLevel,
+                           &MaxLevel);
+      res = "PASS";
+      if (err != 0)
+         res = "FAIL";
+      for (int n = 0; n < NBatch; n++) {
+         R8 Expected = 0.0;
+         for (i = 0; i < NCellsOwned; i++) {
+            for (j = i % 3; j <= NumVertLvls - 1 - i % 4; j++) {
+               Expected += (n + 1) * (i * NumVertLvls + j) + 0.25;
+            }
+         }
+         Expected *= MySize;
+         if (BatchSums[n] != Expected)
+            res = "FAIL";
+      }
+      if (strcmp(res, "FAIL") == 0)
+         RetVal += 1;
+      printf("Global sum batch device A2DR8 levels: %s\n", res);
+
+      // test reproducible fixed-point SUM of in-order and permuted arrays,
+      // including a field whose large values cancel
+      Array2DR8 DevCancel("DevCancel", NumCells, NumVertLvls);
+      parallelFor(
+          {NumCells, NumVertLvls}, KOKKOS_LAMBDA(int i, int j) {
+             if (j == 0)
+                DevCancel(i, j) = (i % 2 == 0) ? 1.0e20 : -1.0e20;
+             else
+                DevCancel(i, j) = 1.0;
+          });
+      const int NRepro                = NBatch + 1;
+      std::vector<Array2DR8> DevRepro = DevBatch;
+      DevRepro.push_back(DevCancel);
+      std::vector<Array2DR8> DevReproRev;
+      for (int n = 0; n < NRepro; n++) {
+         Array2DR8 Orig = DevRepro[n];
+         Array2DR8 DevRev("DevRev", NumCells, NumVertLvls);
+         parallelFor(
+             {NCellsOwned, NumVertLvls}, KOKKOS_LAMBDA(int i, int j) {
+                DevRev(i, j) = Orig(NCellsOwned - 1 - i, j);
+             });
+         DevReproRev.push_back(DevRev);
+      }
+      Kokkos::fence();
+
+      std::vector<R8> ReproSums;
+      std::vector<R8> ReproSumsRev;
+      err  = globalSumRepro(DevRepro, NCellsOwned, Comm, ReproSums);
+      err += globalSumRepro(DevReproRev, NCellsOwned, Comm, ReproSumsRev);
+      err += globalSumBatch(DevBatch, NCellsOwned, Comm, BatchSums);
+      res = "PASS";
+      if (err != 0)
+         res = "FAIL";
+      for (int n = 0; n < NRepro; n++) {
+         if (ReproSums[n] != ReproSumsRev[n])
+            res = "FAIL";
+      }
+      for (int n = 0; n < NBatch; n++) {
+         if (ReproSums[n] != BatchSums[n])
+            res = "FAIL";
+      }
+      R8 ExpCancel = NCellsOwned * (NumVertLvls - 1) * MySize;
+      if (ReproSums[NBatch] != ExpCancel)
+         res = "FAIL";
+      if (strcmp(res, "FAIL") == 0)
+         RetVal += 1;
+      printf("Global sum repro device A2DR8: %s (exp,act=%.1f,%.1f)\n", res,
+             ExpCancel, ReproSums[NBatch]);
    }
    Kokkos::finalize();
    MPI_Finalize();
@@ -1066,6 +1066,67 @@ int main(int argc, char *argv[]) {
       LOG_INFO("ConfigTest {}: Get string list full config - FAIL", MyTask);
    }
 
+   // Test retrieval of values through handles of the parameter registry,
+   // which is frozen by readAll
+   OMEGA::ConfigHandle<OMEGA::I4> HmixI4Handle;
+   OMEGA::ConfigHandle<OMEGA::I8> VmixI8Handle;
+   OMEGA::ConfigHandle<OMEGA::R8> HmixDel2R8Handle;
+   OMEGA::ConfigHandle<bool> HmixDel2OnHandle;
+   OMEGA::ConfigHandle<std::string> HmixDel2StrHandle;
+   Err1 = OMEGA::ConfigParams::getHandle("Hmix:HmixI4", HmixI4Handle);
+   Err2 = OMEGA::ConfigParams::getHandle("Vmix:VmixI8", VmixI8Handle);
+   Err3 = OMEGA::ConfigParams::getHandle("Hmix:HmixDel2:HmixDel2R8",
+                                         HmixDel2R8Handle);
+   Err3 += OMEGA::ConfigParams::getHandle("Hmix:HmixDel2:HmixDel2On",
+                                          HmixDel2OnHandle);
+   Err3 += OMEGA::ConfigParams::getHandle("Hmix:HmixDel2:HmixDel2Str",
+                                          HmixDel2StrHandle);
+   RefTest =
+       (Err1 == 0 && Err2 == 0 && Err3 == 0 &&
+        OMEGA::ConfigParams::isFrozen() &&
+        OMEGA::ConfigParams::get(HmixI4Handle) == NewHmixI4 &&
+        OMEGA::ConfigParams::get(VmixI8Handle) == NewVmixI8 &&
+        OMEGA::ConfigParams::get(HmixDel2R8Handle) == NewHmixDel2R8 &&
+        OMEGA::ConfigParams::get(HmixDel2OnHandle) == NewHmixDel2On &&
+        OMEGA::ConfigParams::get(HmixDel2StrHandle) == NewHmixDel2Str);
+   if (RefTest) {
+      LOG_INFO("ConfigTest {}: retrieve from parameter handles PASS", MyTask);
+   } else {
+      RetVal += 1;
+      LOG_INFO("ConfigTest {}: retrieve from parameter handles FAIL", MyTask);
+   }
+
+   // Retrieval by path, including conversion of an integer to a real
+   OMEGA::R4 ParamR4;
+   OMEGA::R8 ParamI4AsR8;
+   Err1    = OMEGA::ConfigParams::get("Hmix:HmixR4", ParamR4);
+   Err2    = OMEGA::ConfigParams::get("Hmix:HmixI4", ParamI4AsR8);
+   RefTest = (Err1 == 0 && Err2 == 0 && ParamR4 == NewHmixR4 &&
+              ParamI4AsR8 == NewHmixI4);
+   if (RefTest) {
+      LOG_INFO("ConfigTest {}: retrieve parameters by path PASS", MyTask);
+   } else {
+      RetVal += 1;
+      LOG_INFO("ConfigTest {}: retrieve parameters by path FAIL", MyTask);
+   }
+
+   // Missing parameters, groups and mismatched types are errors
+   OMEGA::ConfigHandle<OMEGA::R8> BadHandle;
+   OMEGA::ConfigHandle<OMEGA::I4> BadIntHandle;
+   Err1    = OMEGA::ConfigParams::getHandle("Hmix:junk", BadHandle);
+   Err2    = OMEGA::ConfigParams::getHandle("Hmix:HmixStr", BadHandle);
+   Err3    = OMEGA::ConfigParams::getHandle("Hmix:HmixR8", BadIntHandle);
+   RefTest = (Err1 != 0 && Err2 != 0 && Err3 != 0 &&
+              OMEGA::ConfigParams::getHandle("Hmix:HmixDel2", BadHandle) != 0 &&
+              !BadHandle.isValid() && !BadIntHandle.isValid() &&
+              !OMEGA::ConfigParams::exists("Hmix:junk"));
+   if (RefTest) {
+      LOG_INFO("ConfigTest {}: parameter handle error modes PASS", MyTask);
+   } else {
+      RetVal += 1;
+      LOG_INFO("ConfigTest {}: parameter handle error modes FAIL", MyTask);
+   }
+
    // Test retrieval of values using an iterator
    Err1      = 0;
    RefTest   = true;
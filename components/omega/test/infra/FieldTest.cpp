@@ -757,6 +757,19 @@ int main(int argc, char **argv) {
       Array4DI8 Data4DI8 = Test4DI8->getDataArray<Array4DI8>();
       Array5DR4 Data5DR4 = Test5DR4->getDataArray<Array5DR4>();
 
+      // Retrieve fields and data by handle
+      FieldHandle Handle2DR8 = Field::getFieldHandle("Test2DR8");
+      TstEval<FieldHandle>("Get handle by name", Handle2DR8,
+                           Field::get("Test2DR8")->getHandle(), Err);
+      TstEval<std::string>("Get field by handle",
+                           Field::get(Handle2DR8)->getName(), "Test2DR8", Err);
+      Array2DR8 Data2DR8Hdl = Field::getFieldDataArray<Array2DR8>(Handle2DR8);
+      TstEval<bool>("Get data by handle",
+                    Data2DR8Hdl.data() == Data2DR8.data(), true, Err);
+      TstEval<FieldHandle>("Get handle of missing field",
+                           Field::getFieldHandle("Missing"),
+                           InvalidFieldHandle, Err);
+
       // Test values for correctness
       // Host arrays vertical vector
       int DataCount1 = 0;
@@ -926,6 +939,9 @@ int main(int argc, char **argv) {
       TstEval<bool>("Destroy field 1DI4H", FieldExists, ShouldExist, Err);
       FieldExists = Field::exists("Test1DI4");
       TstEval<bool>("Destroy field 1DI4", FieldExists, ShouldExist, Err);
+      FieldExists = Field::isValidHandle(Test1DI4->getHandle());
+      TstEval<bool>("Destroy field handle 1DI4", FieldExists, ShouldExist,
+                    Err);
 
       // Clear all fields and check a couple for successful removal
       Field::clear();
@@ -185,8 +185,10 @@ int main(int argc, char **argv) {
    int Err1   = 0;
    int ErrRef = 0;
 
-   // Initialize the global MPI and Kokkos environments
-   MPI_Init(&argc, &argv);
+   // Initialize the global MPI and Kokkos environments. Request a
+   // thread-safe MPI so that asynchronous writes can be tested.
+   int ThreadLevel;
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &ThreadLevel);
    Kokkos::initialize();
    {
 
@@ -234,6 +236,26 @@ int main(int argc, char **argv) {
              Test(Cell, K) = Salt(Cell, K);
           });
 
+      // Write the restart and history streams asynchronously if the MPI
+      // library supports it. The restart read below then checks the data
+      // written from the staging buffers.
+      if (ThreadLevel >= MPI_THREAD_MULTIPLE) {
+         Err1 = IOStream::get("RestartWrite")->setAsyncWrite(true);
+         TestEval("Enable async restart write", Err1, ErrRef, Err);
+         Err1 = IOStream::get("History")->setAsyncWrite(true);
+         TestEval("Enable async history write", Err1, ErrRef, Err);
+      } else {
+         LOG_INFO("MPI_THREAD_MULTIPLE not available, skipping async writes");
+      }
+
+      // Write the history stream as one subfile per node. Subfiles are not
+      // supported for input streams.
+      Err1 = IOStream::get("History")->setSubfiling(true);
+      TestEval("Enable history subfiles", Err1, ErrRef, Err);
+      bool SubfileReadErr =
+          IOStream::get("RestartRead")->setSubfiling(true) != 0;
+      TestEval("Reject input stream subfiles", SubfileReadErr, true, Err);
+
       // Create a stop alarm at 1 year for time stepping
       TimeInstant StopTime(&CalGreg, 0002, 1, 1, 0, 0, 0.0);
       Alarm StopAlarm("Stop Time", StopTime);
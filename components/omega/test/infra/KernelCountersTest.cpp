@@ -0,0 +1,114 @@
+//===-- Test driver for OMEGA KernelCounters class --------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA KernelCounters class
+///
+/// This driver tests the roofline counters of annotated kernels, including
+/// the iteration counts of labeled parallelFor loops, the kernels that are
+/// not annotated, the accumulation over steps and the summary table.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "KernelCounters.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <string>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// The test driver for KernelCounters
+
+int main(int argc, char *argv[]) {
+
+   int Err = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+      initLogging(DefEnv);
+
+      KernelCounters::setEnabled(true);
+      KernelCounters::setPeaks(100.0, 1000.0);
+
+      const I4 NCells    = 1000;
+      const I4 NLevels   = 16;
+      const R8 BytesIter = 3 * sizeof(Real);
+      const R8 FlopsIter = 2;
+      KernelCounters::annotate("testKernel", BytesIter, FlopsIter);
+
+      Array2DReal A("A", NCells, NLevels);
+      Array2DReal B("B", NCells, NLevels);
+      Array2DReal C("C", NCells, NLevels);
+      deepCopy(B, 1);
+      deepCopy(C, 2);
+
+      // Annotated kernels are counted with the iterations of every launch
+      for (int Step = 0; Step < 2; ++Step) {
+         parallelFor(
+             "testKernel", {NCells, NLevels}, KOKKOS_LAMBDA(int I, int K) {
+                A(I, K) = 2 * B(I, K) + C(I, K);
+             });
+         parallelFor(
+             "otherKernel", {NCells, NLevels},
+             KOKKOS_LAMBDA(int I, int K) { A(I, K) = B(I, K); });
+         KernelCounters::endStep();
+      }
+
+      const R8 Iters = 2.0 * NCells * NLevels;
+      if (KernelCounters::getCount("testKernel") == 2 and
+          KernelCounters::getBytes("testKernel") == Iters * BytesIter and
+          KernelCounters::getFlops("testKernel") == Iters * FlopsIter and
+          KernelCounters::getTime("testKernel") > 0) {
+         LOG_INFO("KernelCountersTest: annotated kernel PASS");
+      } else {
+         LOG_ERROR("KernelCountersTest: annotated kernel FAIL");
+         ++Err;
+      }
+
+      // Kernels that are not annotated are not counted
+      if (KernelCounters::getCount("otherKernel") == 0) {
+         LOG_INFO("KernelCountersTest: unannotated kernel PASS");
+      } else {
+         LOG_ERROR("KernelCountersTest: unannotated kernel FAIL");
+         ++Err;
+      }
+
+      // Write the summary, and remove all data
+      if (KernelCounters::finalize() == 0 and
+          KernelCounters::getCount("testKernel") == 0) {
+         LOG_INFO("KernelCountersTest: finalize PASS");
+      } else {
+         LOG_ERROR("KernelCountersTest: finalize FAIL");
+         ++Err;
+      }
+
+      // Launches after the counters are disabled are not counted
+      KernelCounters::setEnabled(false);
+      KernelCounters::annotate("testKernel", BytesIter, FlopsIter);
+      parallelFor(
+          "testKernel", {NCells, NLevels},
+          KOKKOS_LAMBDA(int I, int K) { A(I, K) = B(I, K); });
+      if (KernelCounters::getCount("testKernel") == 0) {
+         LOG_INFO("KernelCountersTest: disabled PASS");
+      } else {
+         LOG_ERROR("KernelCountersTest: disabled FAIL");
+         ++Err;
+      }
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (Err >= 256)
+      Err = 255;
+
+   return Err;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
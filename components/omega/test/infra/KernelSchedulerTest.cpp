@@ -0,0 +1,166 @@
+//===-- Test driver for OMEGA KernelScheduler class -------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA KernelScheduler class
+///
+/// This driver tests the concurrent execution of independent kernels. It
+/// checks that tasks see the results of the tasks they depend on and of the
+/// kernels launched before the scheduler, that the kernels launched after
+/// the scheduler see the results of all tasks, and that loops and copies can
+/// be launched on an explicit execution space instance.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "KernelScheduler.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <vector>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// Runs a small dependency graph of kernels and returns the number of wrong
+// values. Two independent tasks fill A and B from an array set beforehand, a
+// third task combines them into C and a fourth independent task zeroes D.
+
+I4 runGraph(I4 NCells, I4 NLevels, Real Scale) {
+
+   Array2DReal Init("Init", NCells, NLevels);
+   Array2DReal A("A", NCells, NLevels);
+   Array2DReal B("B", NCells, NLevels);
+   Array2DReal C("C", NCells, NLevels);
+   Array2DReal D("D", NCells, NLevels);
+
+   deepCopy(D, 1);
+   parallelFor(
+       "initGraph", {NCells, NLevels},
+       KOKKOS_LAMBDA(int I, int K) { Init(I, K) = Scale * (I + K); });
+
+   // Device lambdas cannot be defined inside the host lambdas of the tasks
+   const auto KernelA =
+       KOKKOS_LAMBDA(int I, int K) { A(I, K) = Init(I, K) + 1; };
+   const auto KernelB =
+       KOKKOS_LAMBDA(int I, int K) { B(I, K) = 2 * Init(I, K); };
+   const auto KernelC =
+       KOKKOS_LAMBDA(int I, int K) { C(I, K) = A(I, K) + B(I, K); };
+
+   KernelScheduler Sched;
+   const auto TaskA = Sched.add(
+       [&]() { parallelFor("taskA", {NCells, NLevels}, KernelA); });
+   const auto TaskB = Sched.add(
+       [&]() { parallelFor("taskB", {NCells, NLevels}, KernelB); });
+   Sched.add([&]() { parallelFor("taskC", {NCells, NLevels}, KernelC); },
+             {TaskA, TaskB});
+   Sched.add([&]() { deepCopy(D, 0); });
+   Sched.run();
+
+   I4 NWrong = 0;
+   parallelReduce(
+       "checkGraph", {NCells, NLevels},
+       KOKKOS_LAMBDA(int I, int K, I4 &Accum) {
+          const Real Ref = Scale * (I + K);
+          if (C(I, K) != 3 * Ref + 1 or D(I, K) != 0)
+             ++Accum;
+       },
+       NWrong);
+
+   return NWrong;
+
+} // end runGraph
+
+//------------------------------------------------------------------------------
+// The test driver for KernelScheduler
+
+int main(int argc, char *argv[]) {
+
+   int Err = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+      initLogging(DefEnv);
+
+      const I4 NCells  = 2000;
+      const I4 NLevels = 32;
+
+      // Tasks run one after the other while the scheduler is disabled
+      KernelScheduler::setEnabled(false);
+      if (runGraph(NCells, NLevels, 1) == 0) {
+         LOG_INFO("KernelSchedulerTest: disabled PASS");
+      } else {
+         LOG_ERROR("KernelSchedulerTest: disabled FAIL");
+         ++Err;
+      }
+
+      // The results do not depend on the number of instances
+      KernelScheduler::setEnabled(true);
+      I4 NWrong = 0;
+      for (I4 NInstances : {2, 3}) {
+         KernelScheduler::setNumInstances(NInstances);
+         for (int Step = 0; Step < 5; ++Step)
+            NWrong += runGraph(NCells, NLevels, Step);
+      }
+      if (NWrong == 0) {
+         LOG_INFO("KernelSchedulerTest: concurrent PASS");
+      } else {
+         LOG_ERROR("KernelSchedulerTest: concurrent FAIL");
+         ++Err;
+      }
+
+      // A task depending on a task added after it makes the tasks run in
+      // order
+      KernelScheduler Sched;
+      Array1DI4 Order("Order", 2);
+      const auto Increment = KOKKOS_LAMBDA(int I) { Order(I) += 1; };
+      Sched.add([&]() { deepCopy(Order, 1); }, {1});
+      Sched.add([&]() { parallelFor({2}, Increment); });
+      Sched.run();
+      auto OrderH = createHostMirrorCopy(Order);
+      if (OrderH(0) == 2 and OrderH(1) == 2) {
+         LOG_INFO("KernelSchedulerTest: invalid dependency PASS");
+      } else {
+         LOG_ERROR("KernelSchedulerTest: invalid dependency FAIL");
+         ++Err;
+      }
+
+      // Loops and copies launched on an explicit instance
+      Array1DReal X("X", NCells);
+      const ExecSpace Space = ExecSpace();
+      deepCopy(X, 0);
+      parallelFor(
+          Space, "instanceLoop", {NCells},
+          KOKKOS_LAMBDA(int I) { X(I) = I; });
+      Space.fence();
+      I4 NWrongX = 0;
+      parallelReduce(
+          "checkInstance", {NCells},
+          KOKKOS_LAMBDA(int I, I4 &Accum) {
+             if (X(I) != I)
+                ++Accum;
+          },
+          NWrongX);
+      if (NWrongX == 0 and ExecInstance::isDefault()) {
+         LOG_INFO("KernelSchedulerTest: instance loop PASS");
+      } else {
+         LOG_ERROR("KernelSchedulerTest: instance loop FAIL");
+         ++Err;
+      }
+
+      Err += KernelScheduler::finalize();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (Err >= 256)
+      Err = 255;
+
+   return Err;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
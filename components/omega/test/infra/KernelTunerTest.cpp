@@ -0,0 +1,156 @@
+//===-- Test driver for OMEGA KernelTuner class -----------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA KernelTuner class
+///
+/// This driver tests the autotuning of the policies of labeled kernels. It
+/// checks that the loops give the same results with every candidate policy,
+/// that the kernels are tuned after all candidates are tried, and that the
+/// choices are written to and read back from the cache file.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "KernelTuner.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <cstdio>
+#include <string>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// The test driver for KernelTuner
+
+int main(int argc, char *argv[]) {
+
+   int Err = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+      initLogging(DefEnv);
+
+      KernelTuner::setEnabled(true);
+      KernelTuner::setCandidates(2, {8, 16});
+
+      const I4 NCells   = 1000;
+      const I4 NChunks  = 4;
+      const I4 NLevels  = 16;
+      const I4 NLaunch  = 20;
+      const I4 NTracers = 3;
+
+      Array2DReal A("A", NCells, NLevels);
+      Array2DReal B("B", NCells, NLevels);
+      Array3DReal T("T", NTracers, NCells, NChunks);
+      deepCopy(B, 1);
+
+      // Every launch gives the same results whatever candidate is used
+      I4 NWrong = 0;
+      for (int Launch = 0; Launch < NLaunch; ++Launch) {
+         const Real Scale = Launch;
+         parallelFor(
+             "tunedKernel", {NCells, NLevels},
+             KOKKOS_LAMBDA(int I, int K) { A(I, K) = Scale * B(I, K) + K; });
+         parallelForChunks(
+             "tunedChunks", {NTracers, NCells, NChunks},
+             KOKKOS_LAMBDA(int L, int I, int KChunk) {
+                T(L, I, KChunk) = Scale + L * NCells + I + KChunk;
+             },
+             false);
+
+         I4 LaunchWrong = 0;
+         parallelReduce(
+             "checkTuned", {NCells, NLevels},
+             KOKKOS_LAMBDA(int I, int K, I4 &Accum) {
+                if (A(I, K) != Scale + K)
+                   ++Accum;
+             },
+             LaunchWrong);
+         NWrong += LaunchWrong;
+
+         parallelReduce(
+             "checkChunks", {NTracers, NCells, NChunks},
+             KOKKOS_LAMBDA(int L, int I, int KChunk, I4 &Accum) {
+                if (T(L, I, KChunk) != Scale + L * NCells + I + KChunk)
+                   ++Accum;
+             },
+             LaunchWrong);
+         NWrong += LaunchWrong;
+      }
+
+      if (NWrong == 0) {
+         LOG_INFO("KernelTunerTest: candidate results PASS");
+      } else {
+         LOG_ERROR("KernelTunerTest: candidate results FAIL");
+         ++Err;
+      }
+
+      // Both kernels are tuned after all candidates have been tried, and
+      // only the chunked kernel can use the hierarchical policy
+      const KernelTuner::Choice BestKernel =
+          KernelTuner::getBest("tunedKernel", 2, false);
+      const KernelTuner::Choice BestChunks =
+          KernelTuner::getBest("tunedChunks", 3, true);
+      if (KernelTuner::isTuned("tunedKernel") and
+          KernelTuner::isTuned("tunedChunks") and
+          BestKernel.Policy != KernelTuner::PolicyKind::OuterInner) {
+         LOG_INFO("KernelTunerTest: tuning PASS");
+      } else {
+         LOG_ERROR("KernelTunerTest: tuning FAIL");
+         ++Err;
+      }
+
+      // The choices are read back from the cache file
+      const std::string CacheFile = "KernelTunerTest.cache";
+      int CacheErr                = KernelTuner::writeCache(CacheFile);
+      MPI_Barrier(DefEnv->getComm());
+      KernelTuner::clear();
+      CacheErr += KernelTuner::readCache(CacheFile);
+      const KernelTuner::Choice ReadKernel =
+          KernelTuner::getBest("tunedKernel", 2, false);
+      const KernelTuner::Choice ReadChunks =
+          KernelTuner::getBest("tunedChunks", 3, true);
+      if (CacheErr == 0 and KernelTuner::isTuned("tunedKernel") and
+          ReadKernel.Policy == BestKernel.Policy and
+          ReadKernel.TileLength == BestKernel.TileLength and
+          ReadChunks.Policy == BestChunks.Policy and
+          ReadChunks.TileLength == BestChunks.TileLength) {
+         LOG_INFO("KernelTunerTest: cache file PASS");
+      } else {
+         LOG_ERROR("KernelTunerTest: cache file FAIL");
+         ++Err;
+      }
+      MPI_Barrier(DefEnv->getComm());
+      if (DefEnv->isMasterTask())
+         std::remove(CacheFile.c_str());
+
+      // Kernels are not tuned while the tuner is disabled
+      KernelTuner::clear();
+      KernelTuner::setEnabled(false);
+      parallelFor(
+          "tunedKernel", {NCells, NLevels},
+          KOKKOS_LAMBDA(int I, int K) { A(I, K) = B(I, K); });
+      if (!KernelTuner::isTuned("tunedKernel") and
+          KernelTuner::finalize() == 0) {
+         LOG_INFO("KernelTunerTest: disabled PASS");
+      } else {
+         LOG_ERROR("KernelTunerTest: disabled FAIL");
+         ++Err;
+      }
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (Err >= 256)
+      Err = 255;
+
+   return Err;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
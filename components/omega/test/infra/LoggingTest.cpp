@@ -238,6 +238,48 @@ int testKokkosDataTypes(bool LogEnabled) {
    return RetVal;
 }
 
+// Counts the evaluations of log message arguments
+int NumEvaluations = 0;
+
+int countEvaluation() { return ++NumEvaluations; }
+
+int testRateLimitedLogs(bool LogEnabled) {
+
+   int RetVal = 0;
+
+   // Messages are written on the first call and every third call after it,
+   // and their arguments are only evaluated when written
+   NumEvaluations = 0;
+   for (int I = 0; I < 5; ++I) {
+      LOG_INFO_EVERY(3, "Rate limited message {} {}", I, countEvaluation());
+   }
+
+   if (NumEvaluations == 2) {
+      std::cout << "Rate limited log count: PASS" << std::endl;
+   } else {
+      std::cout << "Rate limited log count: FAIL" << std::endl;
+      RetVal += 1;
+   }
+
+   if (LogEnabled && OMEGA_LOG_LEVEL <= 2)
+      RetVal += outputTestResult("Rate limited log message",
+                                 "Rate limited message 3 2", EndsWith);
+
+   // Master-only messages are only evaluated on the master task
+   NumEvaluations = 0;
+   LOG_INFO_MASTER("Master task message {}", countEvaluation());
+
+   const int ExpectedEvaluations = isLogMasterTask() ? 1 : 0;
+   if (NumEvaluations == ExpectedEvaluations) {
+      std::cout << "Master task log: PASS" << std::endl;
+   } else {
+      std::cout << "Master task log: FAIL" << std::endl;
+      RetVal += 1;
+   }
+
+   return RetVal;
+}
+
 int main(int argc, char **argv) {
 
    int RetVal = 0;
@@ -270,6 +312,14 @@ int main(int argc, char **argv) {
 
       RetVal += testDefaultLogLevel(LogEnabled);
       RetVal += testKokkosDataTypes(LogEnabled);
+      RetVal += testRateLimitedLogs(LogEnabled);
+
+      if (isLogMasterTask() != DefEnv->isMasterTask()) {
+         std::cout << "Log master task: FAIL" << std::endl;
+         RetVal += 1;
+      }
+
+      finalizeLogging();
 
    } catch (const std::exception &Ex) {
       std::cout << Ex.what() << ": FAIL" << std::endl;
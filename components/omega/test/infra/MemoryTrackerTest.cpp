@@ -0,0 +1,131 @@
+//===-- Test driver for OMEGA MemoryTracker class ---------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA MemoryTracker class
+///
+/// This driver tests the accounting of Kokkos allocations by module,
+/// including nested memory regions, unattributed allocations, the release of
+/// allocations, the high-water mark and the summary across tasks.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "MemoryTracker.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <string>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// Check that a byte count matches the requested size, allowing for any
+// padding Kokkos adds to an allocation
+
+bool isNear(I8 Bytes, I8 Expected) {
+   return Bytes >= Expected and Bytes < Expected + 1024;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for MemoryTracker
+
+int main(int argc, char *argv[]) {
+
+   int Err = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+      initLogging(DefEnv);
+
+      MemoryTracker::setEnabled(true);
+
+      const I4 NSize    = 1000;
+      const I8 OneBytes = NSize * sizeof(Real);
+
+      // Allocations are attributed to the innermost active region
+      Array1DReal Persistent;
+      {
+         MemoryRegion OuterMemory("Outer");
+         Persistent = Array1DReal("Persistent", NSize);
+         {
+            MemoryRegion InnerMemory("Inner");
+            Array1DReal Temporary("Temporary", 2 * NSize);
+         }
+      }
+
+      if (isNear(MemoryTracker::getBytes("Outer"), OneBytes) and
+          isNear(MemoryTracker::getPeakBytes("Outer"), OneBytes)) {
+         LOG_INFO("MemoryTrackerTest: module attribution PASS");
+      } else {
+         LOG_ERROR("MemoryTrackerTest: module attribution FAIL");
+         ++Err;
+      }
+
+      // Freed allocations leave the high-water mark unchanged
+      if (MemoryTracker::getBytes("Inner") == 0 and
+          isNear(MemoryTracker::getPeakBytes("Inner"), 2 * OneBytes)) {
+         LOG_INFO("MemoryTrackerTest: release and high-water mark PASS");
+      } else {
+         LOG_ERROR("MemoryTrackerTest: release and high-water mark FAIL");
+         ++Err;
+      }
+
+      // Allocations outside of any region are attributed to Other
+      Array1DReal Unattributed("Unattributed", NSize);
+      if (isNear(MemoryTracker::getBytes("Other"), OneBytes) and
+          MemoryTracker::getBytes("Total") >= 2 * OneBytes and
+          MemoryTracker::getPeakBytes("Total") >= 3 * OneBytes) {
+         LOG_INFO("MemoryTrackerTest: unattributed and total PASS");
+      } else {
+         LOG_ERROR("MemoryTrackerTest: unattributed and total FAIL");
+         ++Err;
+      }
+
+      // Stopping a region that is not the innermost active region is an
+      // error
+      MemoryTracker::start("Outer");
+      MemoryTracker::start("Inner");
+      int StopErr = MemoryTracker::stop("Outer");
+      StopErr += MemoryTracker::stop("Inner");
+      StopErr += MemoryTracker::stop("Outer");
+      if (StopErr == -1) {
+         LOG_INFO("MemoryTrackerTest: mismatched stop PASS");
+      } else {
+         LOG_ERROR("MemoryTrackerTest: mismatched stop FAIL");
+         ++Err;
+      }
+
+      // Reduce across tasks and write the summary
+      if (MemoryTracker::print("test", DefEnv) == 0) {
+         LOG_INFO("MemoryTrackerTest: summary PASS");
+      } else {
+         LOG_ERROR("MemoryTrackerTest: summary FAIL");
+         ++Err;
+      }
+
+      // Arrays released after finalize are no longer tracked
+      MemoryTracker::finalize();
+      Persistent   = Array1DReal();
+      Unattributed = Array1DReal();
+      if (MemoryTracker::getPeakBytes("Total") == 0) {
+         LOG_INFO("MemoryTrackerTest: finalize PASS");
+      } else {
+         LOG_ERROR("MemoryTrackerTest: finalize FAIL");
+         ++Err;
+      }
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (Err >= 256)
+      Err = 255;
+
+   return Err;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
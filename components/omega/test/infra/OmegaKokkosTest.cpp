@@ -122,6 +122,44 @@ int main(int argc, char **argv) {
                       << Gbytes * nrepeat / time << " GB/s )" << std::endl;
          }
 
+         // Record a fill and an update into a kernel graph, which must not
+         // execute them until the graph is submitted
+         Array1DR8 z("z", N);
+         deepCopy(z, 5);
+         KernelGraph Graph;
+         bool Captured = Graph.capture([&]() {
+            deepCopy(z, 1);
+            parallelFor(
+                {N}, KOKKOS_LAMBDA(int j) { z(j) += 2 * y(j); });
+         });
+         auto zH = createHostMirrorCopy(z);
+         if (!Captured or zH(0) != 5 or zH(N - 1) != 5) {
+            std::cout << "  FAIL: kernel graph capture" << std::endl;
+            RetVal += 1;
+         }
+
+         // Each submit launches the whole sequence again
+         for (int repeat = 0; repeat < 3; repeat++) {
+            Graph.submit();
+         }
+         zH = createHostMirrorCopy(z);
+         if (zH(0) != 3 or zH(N - 1) != 3) {
+            std::cout << "  FAIL: kernel graph submit" << std::endl;
+            RetVal += 1;
+         }
+
+         // Reductions cannot be recorded
+         double Sum = 0;
+         Captured   = Graph.capture([&]() {
+            parallelReduce(
+                {N}, KOKKOS_LAMBDA(int j, double &Accum) { Accum += y(j); },
+                Sum);
+         });
+         if (Captured or Graph.isCaptured() or Sum != 0) {
+            std::cout << "  FAIL: kernel graph reduction" << std::endl;
+            RetVal += 1;
+         }
+
          std::cout << "OmegaKokkos test: PASS" << std::endl;
       }
       Kokkos::finalize();
@@ -501,6 +501,43 @@ int testTimeFrac(void) {
       LOG_ERROR("TimeMgrTest/TimeFrac: convert: FAIL");
    }
 
+   // Test operations on a common denominator, which do not simplify the
+   // operands, against the same operations on different denominators
+
+   OMEGA::TimeFrac QuarterTF(1, 1, 4);
+   OMEGA::TimeFrac ThreeQuarterTF(0, 3, 4);
+   OMEGA::TimeFrac HalfTF(0, 1, 2);
+   OMEGA::TimeFrac SumTF  = QuarterTF + ThreeQuarterTF;
+   OMEGA::TimeFrac DiffTF = ThreeQuarterTF - QuarterTF;
+   Err1                   = SumTF.get(WTst, NTst, DTst);
+
+   if (Err1 == 0 && WTst == 2 && NTst == 0 && DTst == 1 &&
+       DiffTF == OMEGA::TimeFrac(0, -1, 2) && QuarterTF > ThreeQuarterTF &&
+       ThreeQuarterTF < QuarterTF && ThreeQuarterTF >= HalfTF &&
+       HalfTF <= ThreeQuarterTF && QuarterTF - HalfTF == ThreeQuarterTF &&
+       Tst2TF == OMEGA::TimeFrac(3, 2, 3) && Tst2TF > QuarterTF) {
+      LOG_INFO("TimeMgrTest/TimeFrac: common denominator operations: PASS");
+   } else {
+      ++ErrAll;
+      LOG_ERROR("TimeMgrTest/TimeFrac: common denominator operations: FAIL");
+   }
+
+   // Test integer and integer-valued real multiples of whole seconds
+
+   OMEGA::TimeFrac StepTF(600, 0, 1);
+   Err1 = (StepTF * 3).get(WTst, NTst, DTst);
+   Err2 = (StepTF * 0.5).get(WRef, NRef, DRef);
+
+   if (Err1 == 0 && Err2 == 0 && WTst == 1800 && NTst == 0 && DTst == 1 &&
+       WRef == 300 && NRef == 0 && DRef == 1 &&
+       StepTF * 2.0 == StepTF * 2 && StepTF / 4 == OMEGA::TimeFrac(150, 0, 1) &&
+       StepTF / 7 == OMEGA::TimeFrac(85, 5, 7)) {
+      LOG_INFO("TimeMgrTest/TimeFrac: whole second multiples: PASS");
+   } else {
+      ++ErrAll;
+      LOG_ERROR("TimeMgrTest/TimeFrac: whole second multiples: FAIL");
+   }
+
    return ErrAll;
 
 } // end testTimeFrac
@@ -4337,6 +4374,37 @@ int testClock(void) {
          FirstStep = false;
    }
 
+   // Test the list of ringing alarms, which are only checked when due
+
+   OMEGA::Clock SchedClock(Time0, TimeStep);
+   OMEGA::TimeInterval Interval3Hour(3, OMEGA::TimeUnits::Hours);
+   OMEGA::TimeInstant Time2Hour(&CalGreg, 2000, 1, 1, 2, 0, 0.0);
+   OMEGA::Alarm AlarmEvery3Hour("Every 3 Hours", Interval3Hour, Time0);
+   OMEGA::Alarm Alarm2Hour("2 Hours", Time2Hour);
+
+   Err1 = SchedClock.attachAlarm(&AlarmEvery3Hour);
+   Err2 = SchedClock.attachAlarm(&Alarm2Hour);
+
+   OMEGA::I4 NRingingStep[6];
+   for (int Step = 0; Step < 6; ++Step) {
+      Err3 += SchedClock.advance();
+      NRingingStep[Step] = SchedClock.getRingingAlarms().size();
+      if (AlarmEvery3Hour.isRinging())
+         AlarmEvery3Hour.reset(SchedClock.getCurrentTime());
+      if (Step == 3)
+         Alarm2Hour.stop();
+   }
+
+   if (Err1 == 0 && Err2 == 0 && Err3 == 0 && NRingingStep[0] == 0 &&
+       NRingingStep[1] == 1 && NRingingStep[2] == 2 && NRingingStep[3] == 1 &&
+       NRingingStep[4] == 0 && NRingingStep[5] == 1 &&
+       SchedClock.hasRingingAlarms()) {
+      LOG_INFO("TimeMgrTest/Clock: ringing alarm list: PASS");
+   } else {
+      ++ErrAll;
+      LOG_ERROR("TimeMgrTest/Clock: ringing alarm list: FAIL");
+   }
+
    return ErrAll;
 
 } // end testClock
@@ -0,0 +1,176 @@
+//===-- Test driver for OMEGA Timer class ------------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA Timer class
+///
+/// This driver tests the hierarchical timers, including nesting of regions,
+/// accumulation over multiple calls, error checking of mismatched stop calls
+/// and the reduction and summary across tasks.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Timer.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <string>
+#include <vector>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// Spin until at least the requested number of seconds has elapsed
+
+void spinWait(R8 Seconds) {
+   R8 StartTime = MPI_Wtime();
+   while (MPI_Wtime() - StartTime < Seconds) {
+   }
+}
+
+//------------------------------------------------------------------------------
+// The test driver for Timer
+
+int main(int argc, char *argv[]) {
+
+   int Err = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+      initLogging(DefEnv);
+
+      Timer::setFenceDevice(true);
+
+      // Time nested regions over several calls
+      const int NCalls = 3;
+      for (int I = 0; I < NCalls; ++I) {
+         TimerRegion OuterTimer("Outer");
+         spinWait(0.01);
+         {
+            TimerRegion InnerTimer("Inner");
+            spinWait(0.01);
+         }
+      }
+
+      // A region with the same name at the top level is distinct from the
+      // nested region
+      Timer::start("Inner");
+      Timer::stop("Inner");
+
+      if (Timer::getCount("Outer") == NCalls and
+          Timer::getCount("Outer:Inner") == NCalls and
+          Timer::getCount("Inner") == 1) {
+         LOG_INFO("TimerTest: call counts PASS");
+      } else {
+         LOG_ERROR("TimerTest: call counts FAIL");
+         ++Err;
+      }
+
+      R8 OuterTime = Timer::getTime("Outer");
+      R8 InnerTime = Timer::getTime("Outer:Inner");
+      if (InnerTime >= NCalls * 0.01 and
+          OuterTime >= InnerTime + NCalls * 0.01) {
+         LOG_INFO("TimerTest: accumulated times PASS");
+      } else {
+         LOG_ERROR("TimerTest: accumulated times FAIL");
+         ++Err;
+      }
+
+      // Stopping a region that is not the innermost running region is an
+      // error and leaves the running regions unchanged
+      Timer::start("Outer");
+      Timer::start("Inner");
+      int StopErr = Timer::stop("Outer");
+      StopErr += Timer::stop("Inner");
+      StopErr += Timer::stop("Outer");
+      if (StopErr == -1 and Timer::getCount("Outer") == NCalls + 1) {
+         LOG_INFO("TimerTest: mismatched stop PASS");
+      } else {
+         LOG_ERROR("TimerTest: mismatched stop FAIL");
+         ++Err;
+      }
+
+      // Disabled timers do not accumulate
+      Timer::setEnabled(false);
+      Timer::start("Disabled");
+      Timer::stop("Disabled");
+      Timer::setEnabled(true);
+      if (Timer::getCount("Disabled") == 0) {
+         LOG_INFO("TimerTest: disabled timers PASS");
+      } else {
+         LOG_ERROR("TimerTest: disabled timers FAIL");
+         ++Err;
+      }
+
+      // Reduce across tasks, every task entered the same regions so the
+      // minimum cannot exceed the mean or the mean the maximum
+      std::vector<std::string> Paths;
+      std::vector<I8> Counts;
+      std::vector<R8> MinTimes, MaxTimes, MeanTimes;
+      int ReduceErr =
+          Timer::reduce(DefEnv, Paths, Counts, MinTimes, MaxTimes, MeanTimes);
+      bool ReduceOK = ReduceErr == 0 and Paths.size() == 3 and
+                      Paths[0] == "Outer" and Counts[0] == NCalls + 1;
+      if (DefEnv->isMasterTask()) {
+         for (int I = 0; ReduceOK and I < Paths.size(); ++I) {
+            ReduceOK = MinTimes[I] <= MeanTimes[I] * (1 + 1e-12) and
+                       MeanTimes[I] <= MaxTimes[I] * (1 + 1e-12);
+         }
+      }
+      if (ReduceOK) {
+         LOG_INFO("TimerTest: reduce PASS");
+      } else {
+         LOG_ERROR("TimerTest: reduce FAIL");
+         ++Err;
+      }
+
+      // Reduce across tasks and write the summary
+      if (Timer::print(DefEnv) == 0) {
+         LOG_INFO("TimerTest: summary PASS");
+      } else {
+         LOG_ERROR("TimerTest: summary FAIL");
+         ++Err;
+      }
+
+      // Nested regions of the same name are summed at any depth, but not
+      // within another region of that name
+      {
+         TimerRegion OuterTimer("Outer");
+         TimerRegion MiddleTimer("Middle");
+         TimerRegion InnerTimer("Inner");
+         TimerRegion InnerInnerTimer("Inner");
+      }
+      R8 NestedTime = Timer::getNestedTime("Outer", "Inner");
+      R8 RefNested =
+          Timer::getTime("Outer:Inner") + Timer::getTime("Outer:Middle:Inner");
+      if (NestedTime == RefNested and
+          Timer::getNestedTime("Outer", "Missing") == 0) {
+         LOG_INFO("TimerTest: nested time PASS");
+      } else {
+         LOG_ERROR("TimerTest: nested time FAIL");
+         ++Err;
+      }
+
+      Timer::clear();
+      if (Timer::getCount("Outer") == 0) {
+         LOG_INFO("TimerTest: clear PASS");
+      } else {
+         LOG_ERROR("TimerTest: clear FAIL");
+         ++Err;
+      }
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (Err >= 256)
+      Err = 255;
+
+   return Err;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -258,6 +258,88 @@ int testAuxState() {
       LOG_ERROR("AuxStateTest: NormPlanetVortEdge FAIL");
    }
 
+   // recompute with the fused kernels and check that the results are
+   // identical to the unfused computation
+   auto RefVelDivCell =
+       createHostMirrorCopy(DefAuxState->KineticAux.VelocityDivCell);
+   auto RefNormPlanetVortEdge =
+       createHostMirrorCopy(DefAuxState->VorticityAux.NormPlanetVortEdge);
+   auto RefDel2DivCell =
+       createHostMirrorCopy(DefAuxState->VelocityDel2Aux.Del2DivCell);
+   auto RefDel2RelVortVertex =
+       createHostMirrorCopy(DefAuxState->VelocityDel2Aux.Del2RelVortVertex);
+
+   deepCopy(DefAuxState->KineticAux.VelocityDivCell, NAN);
+   deepCopy(DefAuxState->VorticityAux.NormPlanetVortEdge, NAN);
+   deepCopy(DefAuxState->VelocityDel2Aux.Del2DivCell, NAN);
+   deepCopy(DefAuxState->VelocityDel2Aux.Del2RelVortVertex, NAN);
+
+   DefAuxState->FusedCompute = true;
+   DefAuxState->computeAll(State, 0);
+   DefAuxState->FusedCompute = false;
+
+   auto VelDivCellH =
+       createHostMirrorCopy(DefAuxState->KineticAux.VelocityDivCell);
+   auto NormPlanetVortEdgeH =
+       createHostMirrorCopy(DefAuxState->VorticityAux.NormPlanetVortEdge);
+   auto Del2DivCellH =
+       createHostMirrorCopy(DefAuxState->VelocityDel2Aux.Del2DivCell);
+   auto Del2RelVortVertexH =
+       createHostMirrorCopy(DefAuxState->VelocityDel2Aux.Del2RelVortVertex);
+
+   int NVertLevels = VelDivCellH.extent_int(1);
+   bool FusedPass  = true;
+   for (int K = 0; K < NVertLevels; ++K) {
+      for (int ICell = 0; ICell < NCellsOwned; ++ICell) {
+         FusedPass = FusedPass and
+                     VelDivCellH(ICell, K) == RefVelDivCell(ICell, K) and
+                     Del2DivCellH(ICell, K) == RefDel2DivCell(ICell, K);
+      }
+      for (int IEdge = 0; IEdge < NEdgesOwned; ++IEdge) {
+         FusedPass = FusedPass and NormPlanetVortEdgeH(IEdge, K) ==
+                                       RefNormPlanetVortEdge(IEdge, K);
+      }
+      for (int IVertex = 0; IVertex < NVerticesOwned; ++IVertex) {
+         FusedPass = FusedPass and Del2RelVortVertexH(IVertex, K) ==
+                                       RefDel2RelVortVertex(IVertex, K);
+      }
+   }
+   if (FusedPass) {
+      LOG_INFO("AuxStateTest: Fused computeAll PASS");
+   } else {
+      Err++;
+      LOG_ERROR("AuxStateTest: Fused computeAll FAIL");
+   }
+
+   // release the velocity del2 variables, check that the other variables do
+   // not change, and allocate them again
+   const std::string Del2Label =
+       DefAuxState->VelocityDel2Aux.Del2DivCell.label();
+   deepCopy(DefAuxState->KineticAux.VelocityDivCell, NAN);
+   DefAuxState->setNeededAuxVars(0);
+   const bool Released =
+       !DefAuxState->VelocityDel2Aux.Del2Edge.is_allocated() and
+       !Field::exists(Del2Label);
+   DefAuxState->computeAll(State, 0);
+   VelDivCellH = createHostMirrorCopy(DefAuxState->KineticAux.VelocityDivCell);
+   bool NeededPass = Released;
+   for (int K = 0; K < NVertLevels; ++K) {
+      for (int ICell = 0; ICell < NCellsOwned; ++ICell) {
+         NeededPass =
+             NeededPass and VelDivCellH(ICell, K) == RefVelDivCell(ICell, K);
+      }
+   }
+   DefAuxState->setNeededAuxVars(AuxAllVarsMask);
+   NeededPass = NeededPass and
+                DefAuxState->VelocityDel2Aux.Del2Edge.is_allocated() and
+                Field::exists(Del2Label);
+   if (NeededPass) {
+      LOG_INFO("AuxStateTest: setNeededAuxVars PASS");
+   } else {
+      Err++;
+      LOG_ERROR("AuxStateTest: setNeededAuxVars FAIL");
+   }
+
    AuxiliaryState::clear();
 
    return Err;
@@ -0,0 +1,291 @@
+//===-- Test driver for OMEGA fast checkpoints -------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA fast node-local checkpoints
+///
+/// This driver tests the fast checkpoint tier. The default state and tracers
+/// are set to values that depend on the global cell and edge IDs, a
+/// checkpoint is written at the end of a checkpoint interval and the state
+/// is cleared and reloaded from the checkpoint, including the halos. It also
+/// tests that a checkpoint that is missing on one task is not used. It
+/// outputs a PASS for each test that gives the expected result.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Checkpoint.h"
+
+#include "Config.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Dimension.h"
+#include "Field.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include "TimeStepper.h"
+#include "Tracers.h"
+#include "mpi.h"
+
+#include <filesystem>
+
+using namespace OMEGA;
+
+// Directory of the test checkpoints
+const std::string TestDirectory = "CheckpointTestDir";
+
+//------------------------------------------------------------------------------
+// The initialization routine for Checkpoint testing. It calls the init
+// routines of the modules needed by the default state and tracers.
+int initCheckpointTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefault();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   initLogging(DefEnv);
+
+   Config("Omega");
+   Err = Config::readAll("omega.yml");
+   if (Err != 0) {
+      LOG_CRITICAL("Checkpoint: Error reading config file");
+      return Err;
+   }
+
+   Err = IO::init(DefComm);
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error initializing parallel IO");
+      return Err;
+   }
+
+   Err = Field::init();
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error initializing fields");
+      return Err;
+   }
+
+   Err = Decomp::init();
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error initializing default decomposition");
+      return Err;
+   }
+
+   Err = Halo::init();
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error initializing default halo");
+      return Err;
+   }
+
+   Err = HorzMesh::init();
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error initializing default mesh");
+      return Err;
+   }
+
+   Err = TimeStepper::init();
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error initializing default time stepper");
+      return Err;
+   }
+
+   Err = Tracers::init();
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error initializing tracers");
+      return Err;
+   }
+
+   Err = OceanState::init();
+   if (Err != 0) {
+      LOG_ERROR("Checkpoint: error initializing default state");
+      return Err;
+   }
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Sets the current time level of the default state and tracers to values
+// that depend on the global IDs, or to zero
+void setState(bool Zero) {
+   OceanState *State = OceanState::getDefault();
+   Decomp *DefDecomp = Decomp::getDefault();
+
+   const Array2DReal LayerThick = State->LayerThickness[State->CurLevel];
+   const Array2DReal NormalVel  = State->NormalVelocity[State->CurLevel];
+   Array3DReal TracerArray;
+   Tracers::getAll(TracerArray, 0);
+
+   const Array1DI4 CellID = DefDecomp->CellID;
+   const Array1DI4 EdgeID = DefDecomp->EdgeID;
+   const int NTracers     = Tracers::getNumTracers();
+   const Real Scale       = Zero ? 0._Real : 1._Real;
+
+   parallelFor(
+       {State->NCellsAll, State->NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          LayerThick(ICell, K) = Scale * (CellID(ICell) * 100 + K);
+          for (int ITracer = 0; ITracer < NTracers; ++ITracer)
+             TracerArray(ITracer, ICell, K) =
+                 Scale * ((ITracer + 1) * 1000000 + CellID(ICell) * 100 + K);
+       });
+   parallelFor(
+       {State->NEdgesAll, State->NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+          NormalVel(IEdge, K) = Scale * (EdgeID(IEdge) * 100 + K + 0.5_Real);
+       });
+}
+
+//------------------------------------------------------------------------------
+// Counts the entries of the current time level of the default state and
+// tracers, including the halos, that differ from the values set by setState
+int checkState() {
+   OceanState *State = OceanState::getDefault();
+   Decomp *DefDecomp = Decomp::getDefault();
+
+   HostArray2DReal LayerThickH =
+       createHostMirrorCopy(State->LayerThickness[State->CurLevel]);
+   HostArray2DReal NormalVelH =
+       createHostMirrorCopy(State->NormalVelocity[State->CurLevel]);
+   Array3DReal TracerArray;
+   Tracers::getAll(TracerArray, 0);
+   HostArray3DReal TracerArrayH = createHostMirrorCopy(TracerArray);
+
+   int Count = 0;
+   for (int ICell = 0; ICell < State->NCellsAll; ++ICell) {
+      const I4 ID = DefDecomp->CellIDH(ICell);
+      for (int K = 0; K < State->NVertLevels; ++K) {
+         if (LayerThickH(ICell, K) != Real(ID * 100 + K))
+            ++Count;
+         for (int ITracer = 0; ITracer < Tracers::getNumTracers(); ++ITracer) {
+            if (TracerArrayH(ITracer, ICell, K) !=
+                Real((ITracer + 1) * 1000000 + ID * 100 + K))
+               ++Count;
+         }
+      }
+   }
+   for (int IEdge = 0; IEdge < State->NEdgesAll; ++IEdge) {
+      const I4 ID = DefDecomp->EdgeIDH(IEdge);
+      for (int K = 0; K < State->NVertLevels; ++K) {
+         if (NormalVelH(IEdge, K) != ID * 100 + K + 0.5_Real)
+            ++Count;
+      }
+   }
+
+   return Count;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for fast checkpoints
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      int Err = initCheckpointTest();
+      if (Err != 0)
+         LOG_CRITICAL("Checkpoint: Error initializing");
+
+      MachEnv *DefEnv = MachEnv::getDefault();
+      MPI_Comm Comm   = DefEnv->getComm();
+
+      // Checkpoints every hour of a clock with 30 minute steps
+      Calendar TestCalendar("TestCalendar", CalendarNoLeap);
+      TimeInstant StartTime(&TestCalendar, 1, 1, 1, 0, 0, 0);
+      TimeInterval TimeStep(30, TimeUnits::Minutes);
+      TimeInterval Interval(1, TimeUnits::Hours);
+      Clock TestClock(StartTime, TimeStep);
+
+      Err = Checkpoint::enable(TestDirectory, Interval, StartTime);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("Checkpoint: enable FAIL");
+      }
+
+      // Only the second step ends a checkpoint interval
+      setState(false);
+      for (int Step = 0; Step < 2; ++Step) {
+         TestClock.advance();
+         Err += Checkpoint::write(TestClock);
+      }
+      Err += Checkpoint::waitForPendingWrite();
+
+      if (Err == 0 and std::filesystem::exists(
+                           TestDirectory + "/omega.ckpt." +
+                           std::to_string(DefEnv->getMyTask()) + ".bin"))
+         LOG_INFO("Checkpoint: write PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("Checkpoint: write FAIL");
+      }
+
+      // Clear the state and reload it from the checkpoint
+      setState(true);
+      TimeInstant RestartTime = StartTime;
+      bool Restarted          = false;
+      Err = Checkpoint::restart(RestartTime, Restarted);
+
+      const TimeInstant CkptTime = StartTime + Interval;
+      if (Err == 0 and Restarted and RestartTime == CkptTime and
+          checkState() == 0)
+         LOG_INFO("Checkpoint: restart PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("Checkpoint: restart FAIL");
+      }
+
+      // A checkpoint missing on one task must not be used
+      MPI_Barrier(Comm);
+      if (DefEnv->isMasterTask())
+         std::filesystem::remove(TestDirectory + "/omega.ckpt." +
+                                 std::to_string(DefEnv->getMyTask()) +
+                                 ".bin");
+      MPI_Barrier(Comm);
+
+      setState(true);
+      RestartTime = StartTime;
+      Err         = Checkpoint::restart(RestartTime, Restarted);
+      if (Err == 0 and !Restarted and RestartTime == StartTime)
+         LOG_INFO("Checkpoint: incomplete checkpoint PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("Checkpoint: incomplete checkpoint FAIL");
+      }
+
+      Err = Checkpoint::finalize();
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("Checkpoint: finalize FAIL");
+      }
+
+      MPI_Barrier(Comm);
+      if (DefEnv->isMasterTask())
+         std::filesystem::remove_all(TestDirectory);
+
+      OceanState::clear();
+      Tracers::clear();
+      TimeStepper::clear();
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      FieldGroup::clear();
+      Field::clear();
+      Dimension::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,337 @@
+//===-- Test driver for OMEGA coupler state ----------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA coupler import and export state
+///
+/// This driver tests the exchange of surface fields with a coupler. Constant
+/// fluxes are imported from host memory and from a device array and the
+/// merged tracer, thickness and stress forcing is compared with the exact
+/// values. The surface temperature, salinity, height and currents are then
+/// exported from a known state to host memory and device arrays. It outputs
+/// a PASS for each test that gives the expected result.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "CouplerState.h"
+
+#include "Config.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Dimension.h"
+#include "Field.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "TimeStepper.h"
+#include "Tracers.h"
+#include "mpi.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// The initialization routine for coupler state testing. It calls the init
+// routines of the modules needed by the default state and tracers.
+int initCouplerStateTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefault();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   initLogging(DefEnv);
+
+   Config("Omega");
+   Err = Config::readAll("omega.yml");
+   if (Err != 0) {
+      LOG_CRITICAL("CouplerStateTest: Error reading config file");
+      return Err;
+   }
+
+   Err = IO::init(DefComm);
+   if (Err != 0) {
+      LOG_ERROR("CouplerStateTest: error initializing parallel IO");
+      return Err;
+   }
+
+   Err = Field::init();
+   if (Err != 0) {
+      LOG_ERROR("CouplerStateTest: error initializing fields");
+      return Err;
+   }
+
+   Err = Decomp::init();
+   if (Err != 0) {
+      LOG_ERROR("CouplerStateTest: error initializing default decomposition");
+      return Err;
+   }
+
+   Err = Halo::init();
+   if (Err != 0) {
+      LOG_ERROR("CouplerStateTest: error initializing default halo");
+      return Err;
+   }
+
+   Err = HorzMesh::init();
+   if (Err != 0) {
+      LOG_ERROR("CouplerStateTest: error initializing default mesh");
+      return Err;
+   }
+
+   Err = TimeStepper::init();
+   if (Err != 0) {
+      LOG_ERROR("CouplerStateTest: error initializing default time stepper");
+      return Err;
+   }
+
+   Err = Tracers::init();
+   if (Err != 0) {
+      LOG_ERROR("CouplerStateTest: error initializing tracers");
+      return Err;
+   }
+
+   Err = OceanState::init();
+   if (Err != 0) {
+      LOG_ERROR("CouplerStateTest: error initializing default state");
+      return Err;
+   }
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Counts the owned entries of a device array that differ from a reference
+int checkArray(const Array1DReal &Array, I4 NOwned, Real Ref) {
+   HostArray1DReal ArrayH = createHostMirrorCopy(Array);
+   int Count              = 0;
+   for (int I = 0; I < NOwned; ++I) {
+      if (std::abs(ArrayH(I) - Ref) > 1.0e-6_Real * std::abs(Ref))
+         ++Count;
+   }
+   return Count;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for the coupler state
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      int Err = initCouplerStateTest();
+      if (Err != 0)
+         LOG_CRITICAL("CouplerStateTest: Error initializing");
+
+      HorzMesh *Mesh    = HorzMesh::getDefault();
+      OceanState *State = OceanState::getDefault();
+      const I4 NCells   = Mesh->NCellsOwned;
+      const I4 NEdges   = Mesh->NEdgesOwned;
+
+      Err = CouplerState::enable(false);
+      if (Err == 0 and CouplerState::isEnabled() and
+          FieldGroup::isFieldInGroup("SurfaceStressNormal", "Coupler"))
+         LOG_INFO("CouplerStateTest: enable PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("CouplerStateTest: enable FAIL");
+      }
+
+      // Import constant fluxes from host memory, except for the ice fraction
+      // which is mapped from a device array
+      const Real ImportValues[CouplerState::NumImports] = {
+          200.0,   // ShortWave
+          300.0,   // LongWaveDown
+          -350.0,  // LongWaveUp
+          -20.0,   // SensibleHeat
+          -30.0,   // LatentHeat
+          -2.0e-5, // Evaporation
+          4.0e-5,  // Rain
+          1.0e-5,  // Snow
+          1.0e-5,  // RiverRunoff
+          0.0,     // IceFraction
+          -40.0,   // IceHeat
+          2.0e-5,  // IceFreshwater
+          4.0e-6,  // IceSalt
+          0.1,     // AtmStressZonal
+          0.0,     // AtmStressMerid
+          0.2,     // IceStressZonal
+          0.0};    // IceStressMerid
+
+      std::vector<std::vector<Real>> ImportData(CouplerState::NumImports);
+      for (int I = 0; I < CouplerState::NumImports; ++I) {
+         if (I == CouplerState::ImportIceFraction)
+            continue;
+         ImportData[I].assign(NCells, ImportValues[I]);
+         Err += CouplerState::attachImport(CouplerState::ImportField(I),
+                                           ImportData[I].data(), NCells);
+      }
+      Array1DReal IceFraction("IceFraction", NCells);
+      deepCopy(IceFraction, 0.25_Real);
+      Err += CouplerState::attachImport(CouplerState::ImportIceFraction,
+                                        IceFraction);
+
+      // Attaching memory smaller than the owned cells must fail
+      std::vector<Real> Small(NCells);
+      const int SmallErr = CouplerState::attachImport(
+          CouplerState::ImportRain, Small.data(), NCells - 1);
+
+      if (Err == 0 and SmallErr != 0)
+         LOG_INFO("CouplerStateTest: attach imports PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("CouplerStateTest: attach imports FAIL");
+      }
+
+      Err = CouplerState::importFields();
+
+      // Merged heat flux is 0.75 * 100 - 0.25 * 40 W m-2, freshwater flux is
+      // 0.75 * 3e-5 + 0.25 * 2e-5 + 1e-5 kg m-2 s-1 and the salt flux is
+      // 0.25 * 4e-6 kg m-2 s-1
+      const Real RefTempFlux =
+          65.0_Real / (CouplerState::RhoSw * CouplerState::CpSw);
+      const Real RefThickFlux = 3.75e-5_Real / CouplerState::RhoFw;
+      const Real RefSaltFlux  = 1.0e-6_Real * 1000.0_Real / CouplerState::RhoSw;
+
+      int Count = 0;
+      Count += checkArray(CouplerState::SurfaceTemperatureFlux, NCells,
+                          RefTempFlux);
+      Count += checkArray(CouplerState::SurfaceThicknessFlux, NCells,
+                          RefThickFlux);
+      Count +=
+          checkArray(CouplerState::SurfaceSalinityFlux, NCells, RefSaltFlux);
+      if (Err == 0 and Count == 0)
+         LOG_INFO("CouplerStateTest: import fluxes PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("CouplerStateTest: import fluxes FAIL");
+      }
+
+      // The merged stress is a uniform zonal stress of 0.125 N m-2
+      HostArray1DReal StressH =
+          createHostMirrorCopy(CouplerState::SurfaceStressNormal);
+      Count = 0;
+      for (int IEdge = 0; IEdge < NEdges; ++IEdge) {
+         const Real Ref = 0.125_Real * std::cos(Mesh->AngleEdgeH(IEdge));
+         if (std::abs(StressH(IEdge) - Ref) > 1.0e-6_Real)
+            ++Count;
+      }
+      if (Count == 0)
+         LOG_INFO("CouplerStateTest: import stress PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("CouplerStateTest: import stress FAIL");
+      }
+
+      // Set layers 10 m thick, tracers that depend on the layer and a uniform
+      // zonal velocity
+      const Real U0 = 0.5_Real;
+      deepCopy(State->LayerThickness[State->CurLevel], 10.0_Real);
+      Array3DReal TracerArray;
+      Tracers::getAll(TracerArray, 0);
+      const I4 IndxTemp = Tracers::IndxTemp;
+      const I4 IndxSalt = Tracers::IndxSalt;
+      const I4 NLevels  = Mesh->NVertLevels;
+      parallelFor(
+          {Mesh->NCellsAll, NLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+             TracerArray(IndxTemp, ICell, K) = 20.0_Real - K;
+             TracerArray(IndxSalt, ICell, K) = 35.0_Real + K;
+          });
+      const Array2DReal NormalVel = State->NormalVelocity[State->CurLevel];
+      const Array1DR8 AngleEdge   = Mesh->AngleEdge;
+      parallelFor(
+          {Mesh->NEdgesAll, NLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+             NormalVel(IEdge, K) = U0 * Kokkos::cos(Real(AngleEdge(IEdge)));
+          });
+
+      // Export the temperature and salinity to host memory and the height
+      // to a device array
+      std::vector<Real> SST(NCells), SSS(NCells);
+      Array1DReal SSH("SSH", NCells);
+      Err = CouplerState::attachExport(CouplerState::ExportSST, SST.data(),
+                                       NCells);
+      Err += CouplerState::attachExport(CouplerState::ExportSSS, SSS.data(),
+                                        NCells);
+      Err += CouplerState::attachExport(CouplerState::ExportSSH, SSH);
+      Err += CouplerState::exportFields();
+
+      HostArray1DReal SSHH = createHostMirrorCopy(SSH);
+      Count                = 0;
+      for (int ICell = 0; ICell < NCells; ++ICell) {
+         const I4 KTop = Mesh->MinLevelCellH(ICell);
+         const I4 KBot = Mesh->MaxLevelCellH(ICell);
+         const Real RefSSH =
+             10.0_Real * (KBot - KTop + 1) - Mesh->BottomDepthH(ICell);
+         if (SST[ICell] != 20.0_Real - KTop or SSS[ICell] != 35.0_Real + KTop or
+             std::abs(SSHH(ICell) - RefSSH) > 1.0e-6_Real * std::abs(RefSSH))
+            ++Count;
+      }
+      if (Err == 0 and Count == 0)
+         LOG_INFO("CouplerStateTest: export state PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("CouplerStateTest: export state FAIL");
+      }
+
+      // The reconstructed current is close to the uniform zonal velocity
+      // away from the poles, where a zonal flow is not uniform on the mesh
+      HostArray1DReal ZonalH = createHostMirrorCopy(
+          CouplerState::getExportArray(CouplerState::ExportCurrentZonal));
+      HostArray1DReal MeridH = createHostMirrorCopy(
+          CouplerState::getExportArray(CouplerState::ExportCurrentMerid));
+      Count = 0;
+      for (int ICell = 0; ICell < NCells; ++ICell) {
+         if (std::abs(Mesh->LatCellH(ICell)) > M_PI / 3)
+            continue;
+         if (std::abs(ZonalH(ICell) - U0) > 0.1_Real * U0 or
+             std::abs(MeridH(ICell)) > 0.1_Real * U0)
+            ++Count;
+      }
+      if (Count == 0)
+         LOG_INFO("CouplerStateTest: export currents PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("CouplerStateTest: export currents FAIL");
+      }
+
+      // Clearing the state removes the forcing fields
+      CouplerState::clear();
+      if (!CouplerState::isEnabled() and
+          !Field::exists("SurfaceTemperatureFlux") and
+          !FieldGroup::exists("Coupler"))
+         LOG_INFO("CouplerStateTest: clear PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("CouplerStateTest: clear FAIL");
+      }
+
+      OceanState::clear();
+      Tracers::clear();
+      TimeStepper::clear();
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      FieldGroup::clear();
+      Field::clear();
+      Dimension::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,218 @@
+//===-- Test driver for OMEGA equation of state ------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA equation of state
+///
+/// This driver tests the linear equation of state. Temperature and salinity
+/// tracers are set from analytic profiles, the density, specific volume,
+/// thermal expansion and haline contraction are computed in the fused EOS
+/// kernel, and the results are compared with the exact values. It outputs
+/// a PASS for each test that gives the expected result.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Eos.h"
+
+#include "Config.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Dimension.h"
+#include "Field.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "TimeStepper.h"
+#include "Tracers.h"
+#include "mpi.h"
+
+#include <cmath>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// The initialization routine for EOS testing. It calls the init routines of
+// the modules needed by the default mesh and tracers.
+int initEosTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefault();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   initLogging(DefEnv);
+
+   Config("Omega");
+   Err = Config::readAll("omega.yml");
+   if (Err != 0) {
+      LOG_CRITICAL("EosTest: Error reading config file");
+      return Err;
+   }
+
+   Err = IO::init(DefComm);
+   if (Err != 0) {
+      LOG_ERROR("EosTest: error initializing parallel IO");
+      return Err;
+   }
+
+   Err = Field::init();
+   if (Err != 0) {
+      LOG_ERROR("EosTest: error initializing fields");
+      return Err;
+   }
+
+   Err = Decomp::init();
+   if (Err != 0) {
+      LOG_ERROR("EosTest: error initializing default decomposition");
+      return Err;
+   }
+
+   Err = Halo::init();
+   if (Err != 0) {
+      LOG_ERROR("EosTest: error initializing default halo");
+      return Err;
+   }
+
+   Err = HorzMesh::init();
+   if (Err != 0) {
+      LOG_ERROR("EosTest: error initializing default mesh");
+      return Err;
+   }
+
+   Err = TimeStepper::init();
+   if (Err != 0) {
+      LOG_ERROR("EosTest: error initializing default time stepper");
+      return Err;
+   }
+
+   Err = Tracers::init();
+   if (Err != 0) {
+      LOG_ERROR("EosTest: error initializing tracers");
+      return Err;
+   }
+
+   Err = Eos::init();
+   if (Err != 0) {
+      LOG_ERROR("EosTest: error initializing equation of state");
+      return Err;
+   }
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for the equation of state
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      int Err = initEosTest();
+      if (Err != 0)
+         LOG_CRITICAL("EosTest: Error initializing");
+
+      HorzMesh *Mesh       = HorzMesh::getDefault();
+      const I4 NCells      = Mesh->NCellsAll;
+      const I4 NVertLevels = Mesh->NVertLevels;
+
+      // Linear coefficients that differ from the defaults
+      Eos::EosChoice     = EosType::Linear;
+      Eos::LinEos.RhoRef = 1025.0_Real;
+      Eos::LinEos.DRhoDT = -0.15_Real;
+      Eos::LinEos.DRhoDS = 0.75_Real;
+      Eos::LinEos.TRef   = 10.0_Real;
+      Eos::LinEos.SRef   = 34.0_Real;
+
+      // Temperature and salinity profiles varying with cell and level
+      Array3DReal TracerArray;
+      Err = Tracers::getAll(TracerArray, 0);
+      if (Err != 0)
+         LOG_ERROR("EosTest: error retrieving tracer array");
+
+      const I4 IndxTemp = Tracers::IndxTemp;
+      const I4 IndxSalt = Tracers::IndxSalt;
+      parallelFor(
+          {NCells, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+             TracerArray(IndxTemp, ICell, K) = 25.0_Real - 0.3_Real * K;
+             TracerArray(IndxSalt, ICell, K) =
+                 33.0_Real + 0.001_Real * (ICell % 100) + 0.02_Real * K;
+          });
+
+      Eos::computeEosArrays(TracerArray);
+
+      auto DensityH           = createHostMirrorCopy(Eos::Density);
+      auto SpecVolH           = createHostMirrorCopy(Eos::SpecVol);
+      auto ThermalExpansionH  = createHostMirrorCopy(Eos::ThermalExpansion);
+      auto HalineContractionH = createHostMirrorCopy(Eos::HalineContraction);
+
+      const Real RTol = 1.e-6_Real;
+      int DensityErr  = 0;
+      int DerivErr    = 0;
+      for (int ICell = 0; ICell < NCells; ++ICell) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            const Real Temp = 25.0_Real - 0.3_Real * K;
+            const Real Salt =
+                33.0_Real + 0.001_Real * (ICell % 100) + 0.02_Real * K;
+            const Real Rho = 1025.0_Real - 0.15_Real * (Temp - 10.0_Real) +
+                             0.75_Real * (Salt - 34.0_Real);
+
+            if (std::abs(DensityH(ICell, K) - Rho) > RTol * Rho or
+                std::abs(SpecVolH(ICell, K) * Rho - 1.0_Real) > RTol)
+               ++DensityErr;
+            if (std::abs(ThermalExpansionH(ICell, K) * Rho - 0.15_Real) >
+                    RTol or
+                std::abs(HalineContractionH(ICell, K) * Rho - 0.75_Real) >
+                    RTol)
+               ++DerivErr;
+         }
+      }
+
+      if (DensityErr == 0)
+         LOG_INFO("EosTest: linear density and specific volume PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("EosTest: linear density and specific volume FAIL");
+      }
+      if (DerivErr == 0)
+         LOG_INFO("EosTest: linear expansion coefficients PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("EosTest: linear expansion coefficients FAIL");
+      }
+
+      // EOS names
+      if (Eos::getEosType("Linear") == EosType::Linear and
+          Eos::getEosType("Unknown") == EosType::Invalid)
+         LOG_INFO("EosTest: EOS type names PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("EosTest: EOS type names FAIL");
+      }
+
+      Eos::clear();
+      Tracers::clear();
+      TimeStepper::clear();
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      FieldGroup::clear();
+      Field::clear();
+      Dimension::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,265 @@
+//===-- Test driver for OMEGA surface forcing --------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA surface forcing
+///
+/// This driver tests the time interpolation of surface forcing records read
+/// from files. Daily records with known constant values are first written
+/// through an output stream. The forcing is then started between the first
+/// two records and updated across one and then two record intervals, which
+/// uses the prefetched records, and the interpolated forcing is compared
+/// with the exact values. It outputs a PASS for each test that gives the
+/// expected result.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Forcing.h"
+
+#include "Config.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Dimension.h"
+#include "Field.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "IOStream.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include "mpi.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace OMEGA;
+
+// Names of the streams used to write and read the forcing records
+const std::string WriteStreamName = "ForcingTestWrite";
+const std::string ReadStreamName  = "ForcingTestRead";
+
+//------------------------------------------------------------------------------
+// The initialization routine for forcing testing. It calls the init routines
+// of the modules needed by the default mesh and adds the forcing streams to
+// the configuration.
+int initForcingTest() {
+
+   int Err = 0;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefault();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   initLogging(DefEnv);
+
+   Config("Omega");
+   Err = Config::readAll("omega.yml");
+   if (Err != 0) {
+      LOG_CRITICAL("ForcingTest: Error reading config file");
+      return Err;
+   }
+
+   Err = IO::init(DefComm);
+   if (Err != 0) {
+      LOG_ERROR("ForcingTest: error initializing parallel IO");
+      return Err;
+   }
+
+   Err = Field::init();
+   if (Err != 0) {
+      LOG_ERROR("ForcingTest: error initializing fields");
+      return Err;
+   }
+
+   Err = Decomp::init();
+   if (Err != 0) {
+      LOG_ERROR("ForcingTest: error initializing default decomposition");
+      return Err;
+   }
+
+   Err = Halo::init();
+   if (Err != 0) {
+      LOG_ERROR("ForcingTest: error initializing default halo");
+      return Err;
+   }
+
+   Err = HorzMesh::init();
+   if (Err != 0) {
+      LOG_ERROR("ForcingTest: error initializing default mesh");
+      return Err;
+   }
+
+   // Both streams use one file per daily record
+   Config *OmegaConfig = Config::getOmegaConfig();
+   Config StreamsConfig("IOStreams");
+   Err = OmegaConfig->get(StreamsConfig);
+   if (Err != 0) {
+      LOG_ERROR("ForcingTest: error retrieving the streams configuration");
+      return Err;
+   }
+   for (const std::string &StreamName : {WriteStreamName, ReadStreamName}) {
+      const bool IsWrite = StreamName == WriteStreamName;
+      Config StreamConfig(StreamName);
+      Err += StreamConfig.add("UsePointerFile", false);
+      Err += StreamConfig.add("Filename", std::string("forcingTest.$Y-$M-$D"));
+      Err += StreamConfig.add("Mode", std::string(IsWrite ? "write" : "read"));
+      Err += StreamConfig.add("IfExists", std::string("replace"));
+      Err += StreamConfig.add("Precision", std::string("double"));
+      Err += StreamConfig.add("Freq", 1);
+      Err += StreamConfig.add("FreqUnits",
+                              std::string(IsWrite ? "years" : "OnStartup"));
+      Err += StreamConfig.add("UseStartEnd", false);
+      Err += StreamConfig.add("Contents", std::vector<std::string>{"Forcing"});
+      Err += StreamsConfig.add(StreamConfig);
+   }
+   if (Err != 0) {
+      LOG_ERROR("ForcingTest: error adding the forcing streams");
+      return Err;
+   }
+
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// Value of a forcing field in the record of a given day
+Real recordValue(int IField, int Day) { return 10._Real * (IField + 1) + Day; }
+
+//------------------------------------------------------------------------------
+// Counts the owned entries of the interpolated forcing that differ from the
+// value interpolated to a fractional day
+int checkForcing(I4 NOwned, Real Day) {
+   int Count = 0;
+   for (int I = 0; I < Forcing::NumForcing; ++I) {
+      const Real Ref = recordValue(I, 0) + Day;
+      HostArray1DReal ArrayH =
+          createHostMirrorCopy(Forcing::getArray(Forcing::ForcingField(I)));
+      for (int ICell = 0; ICell < NOwned; ++ICell) {
+         if (std::abs(ArrayH(ICell) - Ref) > 1.0e-10_Real * std::abs(Ref))
+            ++Count;
+      }
+   }
+   return Count;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for the surface forcing
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   // Request a thread-safe MPI so that the prefetch is asynchronous
+   int ThreadLevel;
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &ThreadLevel);
+   Kokkos::initialize();
+   {
+      int Err = initForcingTest();
+      if (Err != 0)
+         LOG_CRITICAL("ForcingTest: Error initializing");
+
+      HorzMesh *Mesh  = HorzMesh::getDefault();
+      const I4 NCells = Mesh->NCellsOwned;
+
+      Calendar CalNoLeap("No Leap", OMEGA::CalendarNoLeap);
+      TimeInstant StartTime(&CalNoLeap, 1, 1, 1, 0, 0, 0.0);
+      TimeInterval RecordInt(1, TimeUnits::Days);
+      Clock ModelClock(StartTime, RecordInt);
+
+      Err = IOStream::init(ModelClock);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("ForcingTest: IOStream init FAIL");
+      }
+
+      Err = Forcing::enable(ReadStreamName, StartTime, RecordInt, true);
+      if (Err == 0 and Forcing::isEnabled() and
+          FieldGroup::isFieldInGroup("SurfaceHeatFlux", "Forcing"))
+         LOG_INFO("ForcingTest: enable PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("ForcingTest: enable FAIL");
+      }
+
+      // Write the records for the first days through the host arrays of the
+      // forcing fields
+      const int NumRecords = 6;
+      Err                  = 0;
+      for (int Day = 0; Day < NumRecords; ++Day) {
+         for (int I = 0; I < Forcing::NumForcing; ++I) {
+            HostArray1DReal Data =
+                Field::get(Forcing::FieldNames[I])
+                    ->getDataArray<HostArray1DReal>();
+            for (int ICell = 0; ICell < Data.extent_int(0); ++ICell)
+               Data(ICell) = recordValue(I, Day);
+         }
+         Clock RecordClock(StartTime + RecordInt * Day, RecordInt);
+         Err += IOStream::write(WriteStreamName, RecordClock, true);
+      }
+      if (Err == 0)
+         LOG_INFO("ForcingTest: write records PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("ForcingTest: write records FAIL");
+      }
+
+      // Start a quarter of a day after the first record
+      TimeInstant SimTime = StartTime + TimeInterval(6, TimeUnits::Hours);
+      Err                 = Forcing::start(SimTime);
+      if (Err == 0 and checkForcing(NCells, 0.25_Real) == 0)
+         LOG_INFO("ForcingTest: start PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("ForcingTest: start FAIL");
+      }
+
+      // Move to the next record interval, which uses the prefetched record
+      SimTime = StartTime + TimeInterval(36, TimeUnits::Hours);
+      Err     = Forcing::update(SimTime);
+      if (Err == 0 and checkForcing(NCells, 1.5_Real) == 0)
+         LOG_INFO("ForcingTest: update one record PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("ForcingTest: update one record FAIL");
+      }
+
+      // Move across two record intervals to a record time
+      SimTime = StartTime + RecordInt * 3;
+      Err     = Forcing::update(SimTime);
+      if (Err == 0 and checkForcing(NCells, 3.0_Real) == 0)
+         LOG_INFO("ForcingTest: update two records PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("ForcingTest: update two records FAIL");
+      }
+
+      // Clearing the forcing removes the forcing fields
+      Forcing::clear();
+      if (!Forcing::isEnabled() and !Field::exists("SurfaceHeatFlux") and
+          !FieldGroup::exists("Forcing"))
+         LOG_INFO("ForcingTest: clear PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("ForcingTest: clear FAIL");
+      }
+
+      IOStream::clearDecomps();
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      FieldGroup::clear();
+      Field::clear();
+      Dimension::clear();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -21,6 +21,7 @@
 #include "mpi.h"
 
 #include <iostream>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // The initialization routine for Mesh testing. It calls various
@@ -136,6 +137,23 @@ OMEGA::R8 coriolis(OMEGA::R8 lat) {
    return f;
 }
 
+//------------------------------------------------------------------------------
+// Counts the entries that differ between two host arrays of the same shape
+template <class ArrayType>
+int countDiffs(const ArrayType &Ref, const ArrayType &Test) {
+
+   if (Ref.size() != Test.size())
+      return 1;
+
+   int Count = 0;
+   for (size_t I = 0; I < Ref.size(); ++I) {
+      if (Ref.data()[I] != Test.data()[I])
+         ++Count;
+   }
+
+   return Count;
+}
+
 //------------------------------------------------------------------------------
 // The test driver for Mesh-> This tests the decomposition of a sample
 // horizontal domain and verifies the mesh is read in correctly.
@@ -144,8 +162,10 @@ int main(int argc, char *argv[]) {
 
    int RetVal = 0;
 
-   // Initialize the global MPI environment
-   MPI_Init(&argc, &argv);
+   // Initialize the global MPI environment. The mesh file is only read in
+   // the background if MPI can be called from several threads.
+   int ThreadLevel;
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &ThreadLevel);
    Kokkos::initialize();
    {
 
@@ -650,6 +670,149 @@ int main(int argc, char *argv[]) {
          LOG_INFO("HorzMeshTest: edgeSignOnCell test FAIL");
       }
 
+      // Test compressed cell connectivity
+      // Check that the CSR arrays hold the dense entries of each cell
+      count = 0;
+      if (Mesh->OffsetsOnCellH(0) != 0)
+         count++;
+      for (int Cell = 0; Cell < DefDecomp->NCellsAll; Cell++) {
+         int Start = Mesh->OffsetsOnCellH(Cell);
+         if (Mesh->OffsetsOnCellH(Cell + 1) - Start !=
+             Mesh->NEdgesOnCellH(Cell)) {
+            count++;
+            continue;
+         }
+         for (int i = 0; i < Mesh->NEdgesOnCellH(Cell); i++) {
+            if (Mesh->CellsOnCellCSRH(Start + i) !=
+                    Mesh->CellsOnCellH(Cell, i) or
+                Mesh->EdgesOnCellCSRH(Start + i) !=
+                    Mesh->EdgesOnCellH(Cell, i) or
+                Mesh->VerticesOnCellCSRH(Start + i) !=
+                    Mesh->VerticesOnCellH(Cell, i) or
+                Mesh->EdgeSignOnCellCSRH(Start + i) !=
+                    Mesh->EdgeSignOnCellH(Cell, i)) {
+               count++;
+            }
+         }
+      }
+
+      if (count == 0) {
+         LOG_INFO("HorzMeshTest: compressed connectivity test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("HorzMeshTest: compressed connectivity test FAIL");
+      }
+
+      // Test stencil weights
+      // Check that the fused weights match the product of their factors
+      count = 0;
+      for (int Cell = 0; Cell < DefDecomp->NCellsAll; Cell++) {
+         for (int J = Mesh->OffsetsOnCellH(Cell);
+              J < Mesh->OffsetsOnCellH(Cell + 1); J++) {
+            int Edge = Mesh->EdgesOnCellCSRH(J);
+            OMEGA::R8 DivWgt = Mesh->EdgeSignOnCellCSRH(J) *
+                               Mesh->DvEdgeH(Edge) / Mesh->AreaCellH(Cell);
+            OMEGA::R8 Del2Wgt =
+                DivWgt * Mesh->MeshScalingDel2H(Edge) / Mesh->DcEdgeH(Edge);
+            if (abs(Mesh->DivWeightsOnCellCSRH(J) - DivWgt) >
+                    tol * abs(DivWgt) or
+                abs(Mesh->Del2WeightsOnCellCSRH(J) - Del2Wgt) >
+                    tol * abs(Del2Wgt)) {
+               count++;
+            }
+         }
+      }
+      for (int Vertex = 0; Vertex < DefDecomp->NVerticesAll; Vertex++) {
+         for (int J = 0; J < Mesh->VertexDegree; J++) {
+            int Edge = Mesh->EdgesOnVertexH(Vertex, J);
+            if (Edge >= DefDecomp->NEdgesAll)
+               continue;
+            OMEGA::R8 CurlWgt = Mesh->EdgeSignOnVertexH(Vertex, J) *
+                                Mesh->DcEdgeH(Edge) /
+                                Mesh->AreaTriangleH(Vertex);
+            if (abs(Mesh->CurlWeightsOnVertexH(Vertex, J) - CurlWgt) >
+                tol * abs(CurlWgt)) {
+               count++;
+            }
+         }
+      }
+
+      if (count == 0) {
+         LOG_INFO("HorzMeshTest: stencil weights test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("HorzMeshTest: stencil weights test FAIL");
+      }
+
+      // Test advection stencil
+      // Check that the reconstruction is exact for uniform fields, so the
+      // centered coefficients sum to one and the upwind corrections to zero,
+      // and that the stencil includes both cells on the edge
+      count = 0;
+      for (int Edge = 0; Edge < DefDecomp->NEdgesAll; Edge++) {
+         int NAdv = Mesh->NAdvCellsForEdgeH(Edge);
+         if (NAdv < 2 or NAdv > Mesh->MaxEdges2) {
+            count++;
+            continue;
+         }
+         OMEGA::R8 SumCoefs    = 0;
+         OMEGA::R8 SumCoefs3rd = 0;
+         for (int J = 0; J < NAdv; J++) {
+            SumCoefs += Mesh->AdvCoefsH(Edge, J);
+            SumCoefs3rd += Mesh->AdvCoefs3rdH(Edge, J);
+         }
+         if (Mesh->AdvCellsForEdgeH(Edge, 0) != Mesh->CellsOnEdgeH(Edge, 0) or
+             Mesh->AdvCellsForEdgeH(Edge, 1) != Mesh->CellsOnEdgeH(Edge, 1) or
+             abs(SumCoefs - 1.0) > tol or abs(SumCoefs3rd) > tol) {
+            count++;
+         }
+      }
+
+      if (count == 0) {
+         LOG_INFO("HorzMeshTest: advection stencil test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("HorzMeshTest: advection stencil test FAIL");
+      }
+
+      // Test active levels
+      // Check that all levels are active by default and that the edge and
+      // vertex ranges cover the ranges of their cells
+      count = 0;
+      for (int Cell = 0; Cell < DefDecomp->NCellsAll; Cell++) {
+         if (Mesh->MinLevelCellH(Cell) != 0 or
+             Mesh->MaxLevelCellH(Cell) != Mesh->NVertLevels - 1) {
+            count++;
+         }
+      }
+      for (int Edge = 0; Edge < DefDecomp->NEdgesAll; Edge++) {
+         for (int i = 0; i < 2; i++) {
+            int Cell = Mesh->CellsOnEdgeH(Edge, i);
+            if (Cell < DefDecomp->NCellsAll and
+                (Mesh->MinLevelEdgeH(Edge) > Mesh->MinLevelCellH(Cell) or
+                 Mesh->MaxLevelEdgeH(Edge) < Mesh->MaxLevelCellH(Cell))) {
+               count++;
+            }
+         }
+      }
+      for (int Vertex = 0; Vertex < DefDecomp->NVerticesAll; Vertex++) {
+         for (int i = 0; i < Mesh->VertexDegree; i++) {
+            int Cell = Mesh->CellsOnVertexH(Vertex, i);
+            if (Cell < DefDecomp->NCellsAll and
+                (Mesh->MinLevelVertexH(Vertex) > Mesh->MinLevelCellH(Cell) or
+                 Mesh->MaxLevelVertexH(Vertex) < Mesh->MaxLevelCellH(Cell))) {
+               count++;
+            }
+         }
+      }
+
+      if (count == 0) {
+         LOG_INFO("HorzMeshTest: active levels test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("HorzMeshTest: active levels test FAIL");
+      }
+
       // Test edgeSignOnVertex
       // Check that the sign corresponds with convention
       // Tests that the edge sign vlues were calculated correctly
@@ -772,8 +935,61 @@ int main(int argc, char *argv[]) {
          RetVal += 1;
          LOG_INFO("HorzMeshTest: vertex halo exhange FAIL");
       }
+
+      // Test the split initialization, which reads the mesh file in the
+      // background while the default halo is built. The host arrays of the
+      // synchronous mesh are kept to compare with the new default mesh.
+      if (ThreadLevel < MPI_THREAD_MULTIPLE)
+         LOG_WARN("HorzMeshTest: MPI_THREAD_MULTIPLE not provided, the "
+                  "mesh file is read synchronously in startInit");
+
+      auto getArrays1D = [](OMEGA::HorzMesh *M) {
+         return std::vector<OMEGA::HostArray1DR8>{
+             M->XCellH,     M->YCellH,      M->ZCellH,        M->LonCellH,
+             M->LatCellH,   M->XEdgeH,      M->YEdgeH,        M->ZEdgeH,
+             M->LonEdgeH,   M->LatEdgeH,    M->XVertexH,      M->YVertexH,
+             M->ZVertexH,   M->LonVertexH,  M->LatVertexH,    M->BottomDepthH,
+             M->AreaCellH,  M->DcEdgeH,     M->AreaTriangleH, M->DvEdgeH,
+             M->AngleEdgeH, M->FCellH,      M->FEdgeH,        M->FVertexH};
+      };
+      auto getArrays2D = [](OMEGA::HorzMesh *M) {
+         return std::vector<OMEGA::HostArray2DR8>{M->KiteAreasOnVertexH,
+                                                  M->WeightsOnEdgeH};
+      };
+      const auto SyncArrays1D = getArrays1D(Mesh);
+      const auto SyncArrays2D = getArrays2D(Mesh);
+
+      OMEGA::HorzMesh::clear();
+      OMEGA::Halo::clear();
+      OMEGA::Dimension::clear();
+
+      Err = OMEGA::HorzMesh::startInit();
+      if (Err == 0)
+         Err = OMEGA::Halo::init();
+      if (Err == 0)
+         Err = OMEGA::HorzMesh::finishInit();
+
+      count = 0;
+      if (Err == 0) {
+         Mesh                     = OMEGA::HorzMesh::getDefault();
+         const auto AsyncArrays1D = getArrays1D(Mesh);
+         const auto AsyncArrays2D = getArrays2D(Mesh);
+         for (size_t I = 0; I < SyncArrays1D.size(); ++I)
+            count += countDiffs(SyncArrays1D[I], AsyncArrays1D[I]);
+         for (size_t I = 0; I < SyncArrays2D.size(); ++I)
+            count += countDiffs(SyncArrays2D[I], AsyncArrays2D[I]);
+      }
+
+      if (Err == 0 and count == 0) {
+         LOG_INFO("HorzMeshTest: background mesh read PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("HorzMeshTest: background mesh read FAIL");
+      }
+
       // Finalize Omega objects
       OMEGA::HorzMesh::clear();
+      OMEGA::Halo::clear();
       OMEGA::Dimension::clear();
       OMEGA::Decomp::clear();
       OMEGA::MachEnv::removeAll();
@@ -358,6 +358,142 @@ int testRecon(Real RTol) {
    return Err;
 }
 
+// Checks that the sparse form of an operator gives the values of its stencil
+// form on the first NRows rows, up to roundoff
+int checkSparse(const std::string &Name, const Array2DReal &SparseVal,
+                const Array2DReal &StencilVal, int NRows, int NVertLevels,
+                Real RTol) {
+   Real MaxDiff;
+   parallelReduce(
+       {NRows, NVertLevels},
+       KOKKOS_LAMBDA(int I, int K, Real &Accum) {
+          Accum = Kokkos::max(Kokkos::abs(SparseVal(I, K) - StencilVal(I, K)),
+                              Accum);
+       },
+       Kokkos::Max<Real>(MaxDiff));
+   Real MaxRef;
+   parallelReduce(
+       {NRows, NVertLevels},
+       KOKKOS_LAMBDA(int I, int K, Real &Accum) {
+          Accum = Kokkos::max(Kokkos::abs(StencilVal(I, K)), Accum);
+       },
+       Kokkos::Max<Real>(MaxRef));
+
+   if (MaxDiff > RTol * MaxRef) {
+      LOG_ERROR("OperatorsTest: Sparse {} FAIL, max difference {} for max "
+                "value {}",
+                Name, MaxDiff, MaxRef);
+      return 1;
+   }
+   return 0;
+}
+
+int testSparse(Real RTol) {
+   int Err = 0;
+   TestSetup Setup;
+
+   const auto &Mesh      = HorzMesh::getDefault();
+   const int NVertLevels = 16;
+   const int NChunks     = numVertChunks(VecLength, NVertLevels);
+
+   // Prepare operator inputs
+   Array2DReal ScalarCell("ScalarCell", Mesh->NCellsSize, NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real Coord1, Real Coord2) {
+          return Setup.exactScalar(Coord1, Coord2);
+       },
+       ScalarCell, Geom, Mesh, OnCell, NVertLevels);
+   Array2DReal VecEdge("VecEdge", Mesh->NEdgesSize, NVertLevels);
+   Err += setVectorEdge(
+       KOKKOS_LAMBDA(Real(&VecField)[2], Real X, Real Y) {
+          VecField[0] = Setup.exactVecX(X, Y);
+          VecField[1] = Setup.exactVecY(X, Y);
+       },
+       VecEdge, EdgeComponent::Normal, Geom, Mesh, NVertLevels);
+
+   DivergenceOnCell DivergenceCell(Mesh);
+   GradientOnEdge GradientEdge(Mesh);
+   CurlOnVertex CurlVertex(Mesh);
+   TangentialReconOnEdge TanReconEdge(Mesh);
+
+   SparseOperator SparseDiv   = SparseOperator::divergenceOnCell(Mesh);
+   SparseOperator SparseGrad  = SparseOperator::gradientOnEdge(Mesh);
+   SparseOperator SparseCurl  = SparseOperator::curlOnVertex(Mesh);
+   SparseOperator SparseRecon = SparseOperator::tangentialReconOnEdge(Mesh);
+
+   // Divergence
+   Array2DReal DivCell("DivCell", Mesh->NCellsOwned, NVertLevels);
+   Array2DReal SparseDivCell("SparseDivCell", Mesh->NCellsOwned, NVertLevels);
+   parallelFor(
+       {Mesh->NCellsOwned, NChunks}, KOKKOS_LAMBDA(int ICell, int KChunk) {
+          DivergenceCell(DivCell, ICell, KChunk, VecEdge);
+          SparseDiv(SparseDivCell, ICell, KChunk, VecEdge);
+       });
+   Err += checkSparse("Divergence", SparseDivCell, DivCell, Mesh->NCellsOwned,
+                      NVertLevels, RTol);
+
+   // Gradient, on all edges for the Laplacian below
+   Array2DReal GradEdge("GradEdge", Mesh->NEdgesSize, NVertLevels);
+   Array2DReal SparseGradEdge("SparseGradEdge", Mesh->NEdgesSize, NVertLevels);
+   parallelFor(
+       {Mesh->NEdgesAll, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
+          GradientEdge(GradEdge, IEdge, KChunk, ScalarCell);
+          SparseGrad(SparseGradEdge, IEdge, KChunk, ScalarCell);
+       });
+   Err += checkSparse("Gradient", SparseGradEdge, GradEdge, Mesh->NEdgesOwned,
+                      NVertLevels, RTol);
+
+   // Curl
+   Array2DReal CurlVert("CurlVert", Mesh->NVerticesOwned, NVertLevels);
+   Array2DReal SparseCurlVert("SparseCurlVert", Mesh->NVerticesOwned,
+                              NVertLevels);
+   parallelFor(
+       {Mesh->NVerticesOwned, NChunks}, KOKKOS_LAMBDA(int IVertex, int KChunk) {
+          CurlVertex(CurlVert, IVertex, KChunk, VecEdge);
+          SparseCurl(SparseCurlVert, IVertex, KChunk, VecEdge);
+       });
+   Err += checkSparse("Curl", SparseCurlVert, CurlVert, Mesh->NVerticesOwned,
+                      NVertLevels, RTol);
+
+   // Tangential reconstruction
+   Array2DReal ReconEdge("ReconEdge", Mesh->NEdgesOwned, NVertLevels);
+   Array2DReal SparseReconEdge("SparseReconEdge", Mesh->NEdgesOwned,
+                               NVertLevels);
+   parallelFor(
+       {Mesh->NEdgesOwned, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
+          TanReconEdge(ReconEdge, IEdge, KChunk, VecEdge);
+          SparseRecon(SparseReconEdge, IEdge, KChunk, VecEdge);
+       });
+   Err += checkSparse("Recon", SparseReconEdge, ReconEdge, Mesh->NEdgesOwned,
+                      NVertLevels, RTol);
+
+   // Laplacian as the product of the divergence and gradient matrices
+   SparseOperator SparseLap;
+   Err += SparseDiv.multiply(SparseLap, SparseGrad);
+   Array2DReal DivGradCell("DivGradCell", Mesh->NCellsOwned, NVertLevels);
+   Array2DReal SparseLapCell("SparseLapCell", Mesh->NCellsOwned, NVertLevels);
+   parallelFor(
+       {Mesh->NCellsOwned, NChunks}, KOKKOS_LAMBDA(int ICell, int KChunk) {
+          DivergenceCell(DivGradCell, ICell, KChunk, GradEdge);
+          SparseLap(SparseLapCell, ICell, KChunk, ScalarCell);
+       });
+   Err += checkSparse("Laplacian", SparseLapCell, DivGradCell,
+                      Mesh->NCellsOwned, NVertLevels, RTol);
+
+   // Operators with mismatched sizes cannot be multiplied
+   SparseOperator SparseBad;
+   if (SparseGrad.multiply(SparseBad, SparseCurl) == 0) {
+      LOG_ERROR("OperatorsTest: Sparse product of mismatched operators FAIL");
+      ++Err;
+   }
+
+   if (Err == 0) {
+      LOG_INFO("OperatorsTest: Sparse PASS");
+   }
+
+   return Err;
+}
+
 //------------------------------------------------------------------------------
 // The initialization routine for Operators testing
 int initOperatorsTest(const std::string &MeshFile) {
@@ -425,6 +561,7 @@ int operatorsTest(const std::string &MeshFile = DefaultMeshFile) {
    Err += testGradient(RTol);
    Err += testCurl(RTol);
    Err += testRecon(RTol);
+   Err += testSparse(RTol);
 
    if (Err == 0) {
       LOG_INFO("OperatorsTest: Successful completion");
@@ -279,6 +279,24 @@ int main(int argc, char *argv[]) {
             LOG_INFO("State: time level update FAIL");
          }
 
+         // Test that the state fields refer to the current time level
+         // after the update without being re-attached
+         auto LayerThicknessFld =
+             OMEGA::Field::getFieldDataArray<OMEGA::Array2DR8>(
+                 DefState->LayerThicknessFldName);
+         auto NormalVelocityFld =
+             OMEGA::Field::getFieldDataArray<OMEGA::Array2DR8>(
+                 DefState->NormalVelocityFldName);
+         if (LayerThicknessFld.data() ==
+                 DefState->LayerThickness[CurLevel].data() and
+             NormalVelocityFld.data() ==
+                 DefState->NormalVelocity[CurLevel].data()) {
+            LOG_INFO("State: field data after time level update PASS");
+         } else {
+            RetVal += 1;
+            LOG_INFO("State: field data after time level update FAIL");
+         }
+
          // Test time level update on device
          int count1;
          auto LayerThickness_def  = DefState->LayerThickness[NewLevel];
@@ -339,9 +357,92 @@ int main(int argc, char *argv[]) {
             LOG_INFO("State: time level update (GPU) FAIL");
          }
 
+         // Test that a clone of the updated default state matches it at
+         // every time level, and that the clone is independent of it
+         OMEGA::OceanState *CloneState =
+             OMEGA::OceanState::create("Clone", DefState);
+
+         int CloneCount = 0;
+         for (int Level = 0; Level < NTimeLevels; Level++) {
+            int ThickCount;
+            LayerThickness_def       = DefState->LayerThickness[Level];
+            auto LayerThickness_copy = CloneState->LayerThickness[Level];
+            OMEGA::parallelReduce(
+                "reduce", {DefState->NCellsAll, DefState->NVertLevels},
+                KOKKOS_LAMBDA(int Cell, int Level, int &Accum) {
+                   if (LayerThickness_def(Cell, Level) !=
+                       LayerThickness_copy(Cell, Level)) {
+                      Accum++;
+                   }
+                },
+                ThickCount);
+
+            int VelCount;
+            NormalVelocity_def       = DefState->NormalVelocity[Level];
+            auto NormalVelocity_copy = CloneState->NormalVelocity[Level];
+            OMEGA::parallelReduce(
+                "reduce", {DefState->NEdgesAll, DefState->NVertLevels},
+                KOKKOS_LAMBDA(int Edge, int Level, int &Accum) {
+                   if (NormalVelocity_def(Edge, Level) !=
+                       NormalVelocity_copy(Edge, Level)) {
+                      Accum++;
+                   }
+                },
+                VelCount);
+
+            CloneCount += ThickCount + VelCount;
+         }
+
+         OMEGA::deepCopy(CloneState->NormalVelocity[CurLevel], -1.0);
+         DefState->copyToHost(CurLevel);
+         if (DefState->NormalVelocityH[CurLevel](0, 0) == -1.0)
+            CloneCount++;
+
+         if (CloneState != nullptr and CloneCount == 0) {
+            LOG_INFO("State: state clone PASS");
+         } else {
+            RetVal += 1;
+            LOG_INFO("State: state clone FAIL");
+         }
+
          OMEGA::OceanState::clear();
       }
 
+      // Test that a device-only state only allocates the host arrays of the
+      // time level copied to the host
+      DefHalo->setDeviceExchange(true);
+      OMEGA::OceanState::setDeviceOnly(true);
+      OMEGA::OceanState *DevState = OMEGA::OceanState::create(
+          "DeviceOnly", DefHorzMesh, DefHalo, NVertLevels, NTimeLevels);
+
+      int NHostLevels = 0;
+      for (int Level = 0; Level < NTimeLevels; Level++) {
+         if (DevState->LayerThicknessH[Level].is_allocated() or
+             DevState->NormalVelocityH[Level].is_allocated())
+            NHostLevels++;
+      }
+      int NHostInit = NHostLevels;
+
+      DevState->copyToHost(0);
+      DevState->copyToHost(1);
+      NHostLevels = 0;
+      for (int Level = 0; Level < NTimeLevels; Level++) {
+         if (DevState->LayerThicknessH[Level].is_allocated())
+            NHostLevels++;
+      }
+
+      if (DevState->isDeviceOnly() and NHostInit == 0 and NHostLevels == 1 and
+          DevState->NormalVelocityH[1].is_allocated()) {
+         LOG_INFO("State: device-only host allocation PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("State: device-only host allocation FAIL");
+      }
+
+      OMEGA::OceanState::erase("DeviceOnly");
+      OMEGA::OceanState::setDeviceOnly(false);
+      DefHalo->setDeviceExchange(false);
+
       // Finalize Omega objects
       OMEGA::TimeStepper::clear();
       OMEGA::HorzMesh::clear();
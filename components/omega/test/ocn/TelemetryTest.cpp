@@ -0,0 +1,141 @@
+//===-- Test driver for OMEGA throughput telemetry ---------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA throughput telemetry log
+///
+/// This driver tests the telemetry log. The telemetry is enabled with a
+/// record every two steps of a test clock, the clock is advanced for five
+/// steps and the log is checked for the expected number of records, and for
+/// an interval that continues when the alarm is attached to a second clock.
+/// It outputs a PASS for each test that gives the expected result.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Telemetry.h"
+
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "TimeMgr.h"
+#include "mpi.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace OMEGA;
+
+// Log file of the test
+const std::string TestFile = "TelemetryTest.jsonl";
+
+//------------------------------------------------------------------------------
+// Returns the number of records in the log, with the step of the last
+// record in LastStep
+int countRecords(I8 &LastStep) {
+   int NumRecords = 0;
+   std::ifstream In(TestFile);
+   std::string Line;
+   while (std::getline(In, Line)) {
+      if (Line.empty())
+         continue;
+      ++NumRecords;
+      const std::string Key = "{\"Step\": ";
+      if (Line.compare(0, Key.size(), Key) == 0)
+         LastStep = std::stoll(Line.substr(Key.size()));
+   }
+   return NumRecords;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for the telemetry log
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+      MPI_Comm Comm   = DefEnv->getComm();
+      initLogging(DefEnv);
+
+      if (DefEnv->isMasterTask())
+         std::filesystem::remove(TestFile);
+      MPI_Barrier(Comm);
+
+      Calendar TestCalendar("TestCalendar", CalendarNoLeap);
+      TimeInstant StartTime(&TestCalendar, 1, 1, 1, 0, 0, 0);
+      TimeInterval TimeStep(30, TimeUnits::Minutes);
+
+      // A step interval must be positive
+      if (Telemetry::enable(TestFile, 0) != 0 and !Telemetry::isEnabled())
+         LOG_INFO("Telemetry: invalid interval PASS");
+      else {
+         RetVal += 1;
+         LOG_ERROR("Telemetry: invalid interval FAIL");
+      }
+
+      int Err = Telemetry::enable(TestFile, 2);
+
+      // Records are written after the second and fourth steps
+      Clock TestClock(StartTime, TimeStep);
+      Err += Telemetry::attach(TestClock);
+      I8 IStep = 0;
+      for (int Step = 0; Step < 5; ++Step) {
+         TestClock.advance();
+         ++IStep;
+         Err += Telemetry::write(TestClock, IStep);
+      }
+
+      I8 LastStep = 0;
+      if (DefEnv->isMasterTask()) {
+         if (Err == 0 and countRecords(LastStep) == 2 and LastStep == 4)
+            LOG_INFO("Telemetry: write PASS");
+         else {
+            RetVal += 1;
+            LOG_ERROR("Telemetry: write FAIL");
+         }
+      }
+
+      // The interval continues on a new clock, so the next record is
+      // written after the first step of the second clock
+      Clock NextClock(TestClock.getCurrentTime(), TimeStep);
+      Err += Telemetry::attach(NextClock);
+      NextClock.advance();
+      ++IStep;
+      Err += Telemetry::write(NextClock, IStep);
+
+      if (DefEnv->isMasterTask()) {
+         if (Err == 0 and countRecords(LastStep) == 3 and LastStep == 6)
+            LOG_INFO("Telemetry: continued interval PASS");
+         else {
+            RetVal += 1;
+            LOG_ERROR("Telemetry: continued interval FAIL");
+         }
+      }
+
+      Err = Telemetry::finalize();
+      if (Err != 0 or Telemetry::isEnabled()) {
+         RetVal += 1;
+         LOG_ERROR("Telemetry: finalize FAIL");
+      }
+
+      MPI_Barrier(Comm);
+      if (DefEnv->isMasterTask())
+         std::filesystem::remove(TestFile);
+
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
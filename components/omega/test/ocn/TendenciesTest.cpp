@@ -219,6 +219,195 @@ int testTendencies() {
       LOG_ERROR("TendenciesTest: NormVelTendSum FAIL");
    }
 
+   // recompute all tendencies with the general kernels and check that the
+   // results of the specialized kernels are identical
+   auto SpecThickTend = createHostMirrorCopy(DefTendencies->LayerThicknessTend);
+   auto SpecNormVelTend =
+       createHostMirrorCopy(DefTendencies->NormalVelocityTend);
+   deepCopy(DefTendencies->LayerThicknessTend, NAN);
+   deepCopy(DefTendencies->NormalVelocityTend, NAN);
+
+   DefTendencies->SpecializedTend = false;
+   DefTendencies->computeAllTendencies(State, AuxState, ThickTimeLevel,
+                                       VelTimeLevel, Time);
+   DefTendencies->SpecializedTend = true;
+
+   auto GenThickTend = createHostMirrorCopy(DefTendencies->LayerThicknessTend);
+   auto GenNormVelTend =
+       createHostMirrorCopy(DefTendencies->NormalVelocityTend);
+   bool SpecPass = true;
+   for (int K = 0; K < GenThickTend.extent_int(1); ++K) {
+      for (int ICell = 0; ICell < NCellsOwned; ++ICell) {
+         SpecPass =
+             SpecPass and GenThickTend(ICell, K) == SpecThickTend(ICell, K);
+      }
+      for (int IEdge = 0; IEdge < NEdgesOwned; ++IEdge) {
+         SpecPass =
+             SpecPass and GenNormVelTend(IEdge, K) == SpecNormVelTend(IEdge, K);
+      }
+   }
+   if (SpecPass) {
+      LOG_INFO("TendenciesTest: Specialized tendencies PASS");
+   } else {
+      Err++;
+      LOG_ERROR("TendenciesTest: Specialized tendencies FAIL");
+   }
+
+   // recompute the velocity tendencies with the fused kernel and check
+   // that the results are identical
+   auto RefNormVelTend =
+       createHostMirrorCopy(DefTendencies->NormalVelocityTend);
+   deepCopy(DefTendencies->NormalVelocityTend, NAN);
+
+   DefTendencies->FusedVelocityTend = true;
+   DefTendencies->computeVelocityTendencies(State, AuxState, ThickTimeLevel,
+                                            VelTimeLevel, Time);
+   DefTendencies->FusedVelocityTend = false;
+
+   auto NormVelTendH = createHostMirrorCopy(DefTendencies->NormalVelocityTend);
+   bool FusedPass    = true;
+   for (int IEdge = 0; IEdge < NEdgesOwned; ++IEdge) {
+      for (int K = 0; K < NormVelTendH.extent_int(1); ++K) {
+         FusedPass =
+             FusedPass and NormVelTendH(IEdge, K) == RefNormVelTend(IEdge, K);
+      }
+   }
+   if (FusedPass) {
+      LOG_INFO("TendenciesTest: Fused velocity tendencies PASS");
+   } else {
+      Err++;
+      LOG_ERROR("TendenciesTest: Fused velocity tendencies FAIL");
+   }
+
+   // recompute the velocity tendencies with the fused hyperdiffusion, with
+   // and without the fused tendency kernel, and check that the results are
+   // identical
+   bool FusedHypPass = true;
+   for (bool Fused : {false, true}) {
+      deepCopy(DefTendencies->NormalVelocityTend, NAN);
+
+      DefTendencies->FusedHyperDiff    = true;
+      DefTendencies->FusedVelocityTend = Fused;
+      DefTendencies->computeVelocityTendencies(State, AuxState, ThickTimeLevel,
+                                               VelTimeLevel, Time);
+      DefTendencies->FusedHyperDiff    = false;
+      DefTendencies->FusedVelocityTend = false;
+
+      auto HypNormVelTend =
+          createHostMirrorCopy(DefTendencies->NormalVelocityTend);
+      for (int IEdge = 0; IEdge < NEdgesOwned; ++IEdge) {
+         for (int K = 0; K < HypNormVelTend.extent_int(1); ++K) {
+            FusedHypPass = FusedHypPass and
+                           HypNormVelTend(IEdge, K) == RefNormVelTend(IEdge, K);
+         }
+      }
+   }
+   if (FusedHypPass) {
+      LOG_INFO("TendenciesTest: Fused hyperdiffusion tendencies PASS");
+   } else {
+      Err++;
+      LOG_ERROR("TendenciesTest: Fused hyperdiffusion tendencies FAIL");
+   }
+
+   // recompute all tendencies with the outer-inner team loops and check
+   // that the results are identical
+   deepCopy(DefTendencies->LayerThicknessTend, NAN);
+   deepCopy(DefTendencies->NormalVelocityTend, NAN);
+
+   DefTendencies->OuterInnerLoops = true;
+   DefTendencies->computeAllTendencies(State, AuxState, ThickTimeLevel,
+                                       VelTimeLevel, Time);
+   DefTendencies->OuterInnerLoops = false;
+
+   auto TeamThickTend = createHostMirrorCopy(DefTendencies->LayerThicknessTend);
+   auto TeamNormVelTend =
+       createHostMirrorCopy(DefTendencies->NormalVelocityTend);
+   bool TeamPass = true;
+   for (int K = 0; K < TeamThickTend.extent_int(1); ++K) {
+      for (int ICell = 0; ICell < NCellsOwned; ++ICell) {
+         TeamPass =
+             TeamPass and TeamThickTend(ICell, K) == SpecThickTend(ICell, K);
+      }
+      for (int IEdge = 0; IEdge < NEdgesOwned; ++IEdge) {
+         TeamPass = TeamPass and
+                    TeamNormVelTend(IEdge, K) == SpecNormVelTend(IEdge, K);
+      }
+   }
+   if (TeamPass) {
+      LOG_INFO("TendenciesTest: Outer-inner loop tendencies PASS");
+   } else {
+      Err++;
+      LOG_ERROR("TendenciesTest: Outer-inner loop tendencies FAIL");
+   }
+
+   // recompute all tendencies with the cheap auxiliary variables computed
+   // inside the tendency kernels and check that the results are identical
+   deepCopy(DefTendencies->LayerThicknessTend, NAN);
+   deepCopy(DefTendencies->NormalVelocityTend, NAN);
+
+   AuxiliaryState::getDefault()->setRecomputeAuxVars(true);
+   DefTendencies->computeAllTendencies(State, AuxState, ThickTimeLevel,
+                                       VelTimeLevel, Time);
+   AuxiliaryState::getDefault()->setRecomputeAuxVars(false);
+
+   auto RecompThickTend =
+       createHostMirrorCopy(DefTendencies->LayerThicknessTend);
+   auto RecompNormVelTend =
+       createHostMirrorCopy(DefTendencies->NormalVelocityTend);
+   bool RecompPass = true;
+   for (int K = 0; K < RecompThickTend.extent_int(1); ++K) {
+      for (int ICell = 0; ICell < NCellsOwned; ++ICell) {
+         RecompPass = RecompPass and
+                      RecompThickTend(ICell, K) == SpecThickTend(ICell, K);
+      }
+      for (int IEdge = 0; IEdge < NEdgesOwned; ++IEdge) {
+         RecompPass = RecompPass and
+                      RecompNormVelTend(IEdge, K) == SpecNormVelTend(IEdge, K);
+      }
+   }
+   if (RecompPass) {
+      LOG_INFO("TendenciesTest: Recomputed aux vars tendencies PASS");
+   } else {
+      Err++;
+      LOG_ERROR("TendenciesTest: Recomputed aux vars tendencies FAIL");
+   }
+
+   // recompute the velocity tendencies over the compacted active edges, with
+   // and without the fused kernel, and check that the results are identical
+   // on the active edges and zero on the masked edges
+   const auto &EdgeMaskH = Mesh->EdgeMaskH;
+   bool CompactPass      = true;
+   for (bool Fused : {false, true}) {
+      deepCopy(DefTendencies->NormalVelocityTend, NAN);
+
+      DefTendencies->CompactMaskedEdges = true;
+      DefTendencies->FusedVelocityTend  = Fused;
+      DefTendencies->computeVelocityTendencies(State, AuxState, ThickTimeLevel,
+                                               VelTimeLevel, Time);
+      DefTendencies->CompactMaskedEdges = false;
+      DefTendencies->FusedVelocityTend  = false;
+
+      auto CompactNormVelTend =
+          createHostMirrorCopy(DefTendencies->NormalVelocityTend);
+      for (int IEdge = 0; IEdge < NEdgesOwned; ++IEdge) {
+         bool Active = false;
+         for (int K = 0; K < EdgeMaskH.extent_int(1); ++K) {
+            Active = Active or EdgeMaskH(IEdge, K) != 0.0;
+         }
+         for (int K = 0; K < CompactNormVelTend.extent_int(1); ++K) {
+            const Real Expected = Active ? RefNormVelTend(IEdge, K) : 0;
+            CompactPass =
+                CompactPass and CompactNormVelTend(IEdge, K) == Expected;
+         }
+      }
+   }
+   if (CompactPass) {
+      LOG_INFO("TendenciesTest: Compacted edge tendencies PASS");
+   } else {
+      Err++;
+      LOG_ERROR("TendenciesTest: Compacted edge tendencies FAIL");
+   }
+
    Tendencies::clear();
 
    return Err;
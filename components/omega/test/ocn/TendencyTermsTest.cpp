@@ -871,6 +871,147 @@ int testTracerHyperDiffOnCell(int NVertLevels, int NTracers, Real RTol) {
    return Err;
 } // end testTracerHyperDiffOnCell
 
+int testVertAdv(int NVertLevels, int NTracers) {
+
+   I4 Err = 0;
+
+   const auto Mesh           = HorzMesh::getDefault();
+   const auto &MinLevelCell  = Mesh->MinLevelCell;
+   const auto &MaxLevelCell  = Mesh->MaxLevelCell;
+   const auto &MinLevelEdge  = Mesh->MinLevelEdge;
+   const auto &MaxLevelEdge  = Mesh->MaxLevelEdge;
+   const Real Tol            = sizeof(AuxReal) == 4 ? 1e-4 : 1e-10;
+   const Real TracerConstant = 2;
+
+   // Set input arrays, with a thickness flux divergence that varies in the
+   // vertical so that there is transport between layers
+   Array2DReal LayerThickCell("LayerThickCell", Mesh->NCellsSize, NVertLevels);
+   Array2DAuxReal HorzThickTend("HorzThickTend", Mesh->NCellsSize,
+                                NVertLevels);
+   Array2DAuxReal ThickTend("ThickTend", Mesh->NCellsSize, NVertLevels);
+   Array2DAuxReal VertVelTop("VertVelTop", Mesh->NCellsSize, NVertLevels + 1);
+   parallelFor(
+       {Mesh->NCellsAll, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          LayerThickCell(ICell, K) = 1._Real + 0.1_Real * K;
+          HorzThickTend(ICell, K)  = 0.1_Real * Kokkos::sin(Real(ICell + K));
+          ThickTend(ICell, K)      = HorzThickTend(ICell, K);
+       });
+
+   VertVelocityOnCell VertVelOnC(Mesh);
+   parallelFor(
+       {Mesh->NCellsAll}, KOKKOS_LAMBDA(int ICell) {
+          VertVelOnC(VertVelTop, ThickTend, ICell, LayerThickCell);
+       });
+
+   // The target tendency must conserve the column thickness change, be
+   // proportional to the layer thickness and satisfy the layer continuity
+   // equation with zero vertical velocity at the surface and sea floor
+   I4 NVertVelErr = 0;
+   parallelReduce(
+       {Mesh->NCellsOwned}, KOKKOS_LAMBDA(int ICell, I4 &Accum) {
+          const I4 KMin = MinLevelCell(ICell);
+          const I4 KMax = MaxLevelCell(ICell);
+          if (VertVelTop(ICell, KMin) != 0 or VertVelTop(ICell, KMax + 1) != 0)
+             ++Accum;
+          Real SumHorz   = 0;
+          Real SumTarget = 0;
+          for (int K = KMin; K <= KMax; ++K) {
+             SumHorz += HorzThickTend(ICell, K);
+             SumTarget += ThickTend(ICell, K);
+             const Real Continuity = HorzThickTend(ICell, K) -
+                                     VertVelTop(ICell, K) +
+                                     VertVelTop(ICell, K + 1);
+             if (Kokkos::fabs(Continuity - ThickTend(ICell, K)) > Tol)
+                ++Accum;
+             const Real Ratio = ThickTend(ICell, KMin) /
+                                LayerThickCell(ICell, KMin) *
+                                LayerThickCell(ICell, K);
+             if (Kokkos::fabs(Ratio - ThickTend(ICell, K)) > Tol)
+                ++Accum;
+          }
+          if (Kokkos::fabs(SumTarget - SumHorz) > Tol * NVertLevels)
+             ++Accum;
+       },
+       NVertVelErr);
+
+   if (NVertVelErr != 0) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: VertVelocity FAIL");
+   }
+
+   // Vertical advection of a constant tracer must balance the difference
+   // between the horizontal and target thickness tendencies
+   Array3DReal TracerCell("TracerCell", NTracers, Mesh->NCellsSize,
+                          NVertLevels);
+   deepCopy(TracerCell, TracerConstant);
+   Array3DAuxReal TracerTend("TracerTend", NTracers, Mesh->NCellsSize,
+                             NVertLevels);
+
+   TracerVertAdvOnCell TrVertAdvOnC(Mesh);
+   parallelFor(
+       {Mesh->NCellsOwned, NTracers}, KOKKOS_LAMBDA(int ICell, int L) {
+          TrVertAdvOnC(TracerTend, L, ICell, VertVelTop, TracerCell);
+       });
+
+   I4 NTrVertAdvErr = 0;
+   parallelReduce(
+       {NTracers, Mesh->NCellsOwned},
+       KOKKOS_LAMBDA(int L, int ICell, I4 &Accum) {
+          for (int K = MinLevelCell(ICell); K <= MaxLevelCell(ICell); ++K) {
+             const Real Expected = TracerConstant * (ThickTend(ICell, K) -
+                                                     HorzThickTend(ICell, K));
+             if (Kokkos::fabs(TracerTend(L, ICell, K) - Expected) > Tol)
+                ++Accum;
+          }
+       },
+       NTrVertAdvErr);
+
+   if (NTrVertAdvErr != 0) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: TracerVertAdv FAIL");
+   }
+
+   // Vertical advection of a velocity that is uniform in the vertical must
+   // vanish
+   Array2DReal NormalVelEdge("NormalVelEdge", Mesh->NEdgesSize, NVertLevels);
+   Array2DAuxReal MeanThickEdge("MeanThickEdge", Mesh->NEdgesSize,
+                                NVertLevels);
+   Array2DAuxReal VelTend("VelTend", Mesh->NEdgesSize, NVertLevels);
+   parallelFor(
+       {Mesh->NEdgesSize, NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+          NormalVelEdge(IEdge, K) = Kokkos::cos(Real(IEdge));
+          MeanThickEdge(IEdge, K) = 1._Real + 0.1_Real * K;
+       });
+
+   VelocityVertAdvOnEdge VelVertAdvOnE(Mesh);
+   parallelFor(
+       {Mesh->NEdgesOwned}, KOKKOS_LAMBDA(int IEdge) {
+          VelVertAdvOnE(VelTend, IEdge, VertVelTop, NormalVelEdge,
+                        MeanThickEdge);
+       });
+
+   I4 NVelVertAdvErr = 0;
+   parallelReduce(
+       {Mesh->NEdgesOwned}, KOKKOS_LAMBDA(int IEdge, I4 &Accum) {
+          for (int K = MinLevelEdge(IEdge); K <= MaxLevelEdge(IEdge); ++K) {
+             if (Kokkos::fabs(VelTend(IEdge, K)) > Tol)
+                ++Accum;
+          }
+       },
+       NVelVertAdvErr);
+
+   if (NVelVertAdvErr != 0) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: VelocityVertAdv FAIL");
+   }
+
+   if (Err == 0) {
+      LOG_INFO("TendencyTermsTest: VertAdv PASS");
+   }
+
+   return Err;
+} // end testVertAdv
+
 int initTendTest(const std::string &mesh) {
 
    I4 Err = 0;
@@ -958,6 +1099,8 @@ int tendencyTermsTest(const std::string &mesh = DefaultMeshFile) {
 
    Err += testTracerHyperDiffOnCell(NVertLevels, NTracers, RTol);
 
+   Err += testVertAdv(NVertLevels, NTracers);
+
    if (Err == 0) {
       LOG_INFO("TendencyTermsTest: Successful completion");
    }
@@ -17,9 +17,11 @@
 #include "Halo.h"
 #include "HorzMesh.h"
 #include "IO.h"
+#include "IOStream.h"
 #include "Logging.h"
 #include "MachEnv.h"
 #include "OmegaKokkos.h"
+#include "TimeMgr.h"
 #include "TimeStepper.h"
 #include "mpi.h"
 
@@ -93,6 +95,27 @@ I4 initTracersTest() {
    return 0;
 }
 
+//------------------------------------------------------------------------------
+// Adds a write stream of the input contents to the streams configuration
+I4 addTestStream(Config &StreamsConfig,         ///< [inout] streams config
+                 const std::string &StreamName, ///< [in] name of stream
+                 const std::string &Contents    ///< [in] group to write
+) {
+   I4 Err = 0;
+   Config StreamConfig(StreamName);
+   Err += StreamConfig.add("UsePointerFile", false);
+   Err += StreamConfig.add("Filename", "tracersTest." + StreamName + ".nc");
+   Err += StreamConfig.add("Mode", std::string("write"));
+   Err += StreamConfig.add("IfExists", std::string("replace"));
+   Err += StreamConfig.add("Precision", std::string("double"));
+   Err += StreamConfig.add("Freq", 1);
+   Err += StreamConfig.add("FreqUnits", std::string("years"));
+   Err += StreamConfig.add("UseStartEnd", false);
+   Err += StreamConfig.add("Contents", std::vector<std::string>{Contents});
+   Err += StreamsConfig.add(StreamConfig);
+   return Err;
+}
+
 //------------------------------------------------------------------------------
 // The test driver for Tracers infrastructure
 //
@@ -181,6 +204,14 @@ int main(int argc, char *argv[]) {
             LOG_ERROR("Tracers: {} tracers retrieval FAIL", GroupName);
          }
 
+         // The groups of the default config use double precision output
+         if (!Tracers::isReducedPrecision(GroupName)) {
+            LOG_INFO("Tracers: {} group precision PASS", GroupName);
+         } else {
+            RetVal += 1;
+            LOG_ERROR("Tracers: {} group precision FAIL", GroupName);
+         }
+
          // Check if tracer index is a member of the Group
          for (I4 TracerIndex = StartIndex;
               TracerIndex < StartIndex + GroupLength; ++TracerIndex) {
@@ -288,6 +319,52 @@ int main(int argc, char *argv[]) {
 
       deepCopy(RefArray, RefArray);
 
+      // The group arrays select the tracers of each group from the current
+      // time level, as one contiguous block with the right layout
+      for (std::string GroupName : GroupNames) {
+         std::pair<I4, I4> GroupRange;
+         Tracers::getGroupRange(GroupRange, GroupName);
+         const I4 StartIndex  = GroupRange.first;
+         const I4 GroupLength = GroupRange.second;
+
+         TracerGroupArray GroupArray;
+         Err = Tracers::getGroup(GroupArray, 0, GroupName);
+
+         bool Contiguous = true;
+         if constexpr (std::is_same_v<MemLayout, Kokkos::LayoutRight>)
+            Contiguous = GroupArray.span_is_contiguous();
+
+         count = -1;
+
+         parallelReduce(
+             "reduceGroup", {GroupLength, NCellsOwned, NVertLevels},
+             KOKKOS_LAMBDA(I4 L, I4 Cell, I4 Vert, I4 & Accum) {
+                if (std::abs(GroupArray(L, Cell, Vert) -
+                             (RefReal + StartIndex + L + Cell + Vert)) > 1e-9) {
+                   Accum++;
+                }
+             },
+             count);
+
+         if (Err == 0 and GroupArray.extent_int(0) == GroupLength and
+             Contiguous and count == 0) {
+            LOG_INFO("Tracers: getGroup returns the {} tracers PASS",
+                     GroupName);
+         } else {
+            RetVal += 1;
+            LOG_ERROR("Tracers: getGroup returns the {} tracers FAIL",
+                      GroupName);
+         }
+      }
+
+      TracerGroupArray NoGroupArray;
+      if (Tracers::getGroup(NoGroupArray, 0, "NoSuchGroup") != 0) {
+         LOG_INFO("Tracers: getGroup rejects an unknown group PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("Tracers: getGroup rejects an unknown group FAIL");
+      }
+
       // Reference field data of all tracers
       std::vector<Array2DReal> RefFieldDataArray;
 
@@ -496,6 +573,72 @@ int main(int argc, char *argv[]) {
                    "data FAIL");
       }
 
+      // Reinitialize the tracers with the Debug group given in the group form
+      // with single output precision
+      Tracers::clear();
+      FieldGroup::clear();
+      Field::clear();
+
+      Config *OmegaConfig = Config::getOmegaConfig();
+      Config TracersConfig("Tracers");
+      Err = OmegaConfig->get(TracersConfig);
+      std::vector<std::string> DebugNames;
+      Err += TracersConfig.get("Debug", DebugNames);
+      Err += TracersConfig.remove("Debug");
+      Config DebugConfig("Debug");
+      Err += DebugConfig.add("Tracers", DebugNames);
+      Err += DebugConfig.add("OutputPrecision", std::string("single"));
+      Err += TracersConfig.add(DebugConfig);
+      Err += Tracers::init();
+
+      if (Err == 0 and Tracers::isReducedPrecision("Debug") and
+          !Tracers::isReducedPrecision("Base")) {
+         LOG_INFO("Tracers: single output precision group PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("Tracers: single output precision group FAIL");
+      }
+
+      // A history stream writes the Debug tracers in single precision while
+      // a restart stream, which contains the Restart group, writes them in
+      // the double precision of the stream
+      auto RestartGroup = FieldGroup::create("Restart");
+      for (const std::string &Name : DebugNames)
+         Err += RestartGroup->addField(Name);
+
+      Config StreamsConfig("IOStreams");
+      Err += OmegaConfig->get(StreamsConfig);
+      Err += addTestStream(StreamsConfig, "TracersHistory", "Debug");
+      Err += addTestStream(StreamsConfig, "TracersRestart", "Restart");
+
+      Calendar TestCalendar("TestCalendar", CalendarNoLeap);
+      TimeInstant StartTime(&TestCalendar, 1, 1, 1, 0, 0, 0);
+      TimeInterval TimeStep(1, TimeUnits::Hours);
+      Clock TestClock(StartTime, TimeStep);
+      Err += IOStream::init(TestClock);
+
+      auto HistStream    = IOStream::get("TracersHistory");
+      auto RestartStream = IOStream::get("TracersRestart");
+      if (Err == 0 and HistStream and RestartStream and
+          HistStream->validate() and RestartStream->validate()) {
+         Err += IOStream::write("TracersHistory", TestClock, true);
+         Err += IOStream::write("TracersRestart", TestClock, true);
+         Err += IOStream::waitForPendingWrite();
+      } else {
+         Err += 1;
+      }
+
+      if (Err == 0 and !HistStream->isRestart() and
+          RestartStream->isRestart() and
+          HistStream->getFieldIOType(DebugNames[0]) == IO::IOTypeR4 and
+          RestartStream->getFieldIOType(DebugNames[0]) == IO::IOTypeR8) {
+         LOG_INFO("Tracers: single output precision streams PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("Tracers: single output precision streams FAIL");
+      }
+
+      IOStream::finalize(TestClock);
       Tracers::clear();
       TimeStepper::clear();
       HorzMesh::clear();
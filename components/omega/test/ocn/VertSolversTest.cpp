@@ -0,0 +1,148 @@
+//===-- Test driver for OMEGA vertical solvers -------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA vertical column solvers
+///
+/// This driver tests the batched tridiagonal solver. Diagonally dominant
+/// systems with a known solution are built for columns of varying depth,
+/// the right-hand sides are computed from the exact solution, and the
+/// solutions of the single and tracer-batched solves are compared to the
+/// exact solution.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "DataTypes.h"
+#include "OmegaKokkos.h"
+#include "VertSolvers.h"
+#include "mpi.h"
+
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+using namespace OMEGA;
+
+// exact solution of column ICol, tracer L at level K
+KOKKOS_INLINE_FUNCTION Real exactSolution(int L, int ICol, int K) {
+   return 1._Real + 0.1_Real * L + 0.01_Real * ICol + 0.5_Real * K;
+}
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      const int NColumns    = 1000;
+      const int NVertLevels = 60;
+      const int NTracers    = 4;
+
+      // tolerance relative to solution values of order ten
+      const Real Tol = std::is_same_v<Real, R4> ? 1.e-4 : 1.e-10;
+
+      // columns of varying depth, including a single-level column and
+      // an inactive column
+      Array1DI4 MinLevel("MinLevel", NColumns);
+      Array1DI4 MaxLevel("MaxLevel", NColumns);
+      parallelFor(
+          {NColumns}, KOKKOS_LAMBDA(int ICol) {
+             MinLevel(ICol) = ICol % 3;
+             MaxLevel(ICol) = NVertLevels - 1 - ICol % 17;
+             if (ICol == 1)
+                MaxLevel(ICol) = MinLevel(ICol);
+             if (ICol == 2)
+                MaxLevel(ICol) = -1;
+          });
+
+      // diagonally dominant matrices like those of implicit mixing
+      Array2DReal Lower("Lower", NColumns, NVertLevels);
+      Array2DReal Diag("Diag", NColumns, NVertLevels);
+      Array2DReal Upper("Upper", NColumns, NVertLevels);
+      parallelFor(
+          {NColumns, NVertLevels}, KOKKOS_LAMBDA(int ICol, int K) {
+             Lower(ICol, K) = -0.3_Real - 0.001_Real * K;
+             Upper(ICol, K) = -0.2_Real - 0.002_Real * ICol / NColumns;
+             Diag(ICol, K)  = 1._Real + 0.5_Real + 0.003_Real * K;
+          });
+
+      // right-hand sides from the exact solution
+      Array3DReal Rhs("Rhs", NTracers, NColumns, NVertLevels);
+      parallelFor(
+          {NTracers, NColumns, NVertLevels},
+          KOKKOS_LAMBDA(int L, int ICol, int K) {
+             const int KMin = MinLevel(ICol);
+             const int KMax = MaxLevel(ICol);
+             if (K < KMin or K > KMax)
+                return;
+             Real Val = Diag(ICol, K) * exactSolution(L, ICol, K);
+             if (K > KMin)
+                Val += Lower(ICol, K) * exactSolution(L, ICol, K - 1);
+             if (K < KMax)
+                Val += Upper(ICol, K) * exactSolution(L, ICol, K + 1);
+             Rhs(L, ICol, K) = Val;
+          });
+
+      Array2DReal Rhs0("Rhs0", NColumns, NVertLevels);
+      deepCopy(Rhs0, Kokkos::subview(Rhs, 0, Kokkos::ALL, Kokkos::ALL));
+
+      TridiagonalSolver Solver("TestSolver", NColumns, NVertLevels, MinLevel,
+                               MaxLevel);
+      Solver.factor(Lower, Diag, Upper);
+
+      // single right-hand side per column
+      Solver.solve(Rhs0);
+
+      Real MaxErr = 0;
+      parallelReduce(
+          {NColumns, NVertLevels},
+          KOKKOS_LAMBDA(int ICol, int K, Real &Accum) {
+             if (K < MinLevel(ICol) or K > MaxLevel(ICol))
+                return;
+             Real Err = Kokkos::fabs(Rhs0(ICol, K) - exactSolution(0, ICol, K));
+             Accum    = Kokkos::max(Accum, Err);
+          },
+          Kokkos::Max<Real>(MaxErr));
+
+      if (MaxErr < Tol) {
+         std::cout << "TridiagonalSolver single solve: PASS" << std::endl;
+      } else {
+         RetVal += 1;
+         std::cout << "TridiagonalSolver single solve: FAIL " << MaxErr
+                   << std::endl;
+      }
+
+      // all tracers but the first, as for a tracer group
+      Solver.solve(Rhs, std::pair<I4, I4>(1, NTracers - 1));
+
+      MaxErr = 0;
+      parallelReduce(
+          {NTracers - 1, NColumns, NVertLevels},
+          KOKKOS_LAMBDA(int L, int ICol, int K, Real &Accum) {
+             if (K < MinLevel(ICol) or K > MaxLevel(ICol))
+                return;
+             Real Err = Kokkos::fabs(Rhs(L + 1, ICol, K) -
+                                     exactSolution(L + 1, ICol, K));
+             Accum    = Kokkos::max(Accum, Err);
+          },
+          Kokkos::Max<Real>(MaxErr));
+
+      if (MaxErr < Tol) {
+         std::cout << "TridiagonalSolver tracer solve: PASS" << std::endl;
+      } else {
+         RetVal += 1;
+         std::cout << "TridiagonalSolver tracer solve: FAIL " << MaxErr
+                   << std::endl;
+      }
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -51,7 +51,7 @@ struct DecayVelocityTendency {
    // the solution is exponential decay
    Real exactSolution(Real Time) { return std::exp(-Coeff * Time); }
 
-   void operator()(Array2DReal NormalVelTend, const OceanState *State,
+   void operator()(Array2DAuxReal NormalVelTend, const OceanState *State,
                    const AuxiliaryState *AuxState, int ThickTimeLevel,
                    int VelTimeLevel, TimeInstant Time) const {
 
@@ -327,6 +327,546 @@ int testTimeStepper(const std::string &Name, TimeStepperType Type,
    return Err;
 }
 
+// Check the fused update of thickness, velocity and thickness-weighted
+// tracers, with accumulation, against the values computed by hand
+int testFusedUpdate() {
+   int Err = 0;
+
+   auto *DefMesh        = HorzMesh::getDefault();
+   auto *DefHalo        = Halo::getDefault();
+   auto *TestAuxState   = AuxiliaryState::get("TestAuxState");
+   auto *TestTendencies = Tendencies::get("TestTendencies");
+   auto *State          = OceanState::get("TestState");
+
+   auto *TestTimeStepper = TimeStepper::create(
+       "TestTimeStepper", TimeStepperType::RungeKutta2, TestTendencies,
+       TestAuxState, DefMesh, DefHalo);
+
+   const int NTracers = 2;
+   Array3DReal Tracers1("Tracers1", NTracers, DefMesh->NCellsSize, NVertLevels);
+   Array3DReal Tracers2("Tracers2", NTracers, DefMesh->NCellsSize, NVertLevels);
+   Array3DReal TracersAccum("TracersAccum", NTracers, DefMesh->NCellsSize,
+                            NVertLevels);
+   Array3DAuxReal TracerTend("TracerTend", NTracers, DefMesh->NCellsSize,
+                             NVertLevels);
+
+   // h^{0} = 1, u^{0} = 1, C^{0} = 2, accumulated h = 2, u = 3, C = 1 and
+   // tendencies R_h = 1, R_u = -1, R_hC = 4
+   deepCopy(State->LayerThickness[0], 1);
+   deepCopy(State->NormalVelocity[0], 1);
+   deepCopy(State->LayerThickness[1], 2);
+   deepCopy(State->NormalVelocity[1], 3);
+   deepCopy(Tracers2, 2);
+   deepCopy(TracersAccum, 1);
+   deepCopy(TestTendencies->LayerThicknessTend, 1);
+   deepCopy(TestTendencies->NormalVelocityTend, -1);
+   deepCopy(TracerTend, 4);
+
+   // Provisional values with coefficient 1/2 are computed in place of the
+   // inputs, the accumulation uses coefficient 1
+   TestTimeStepper->updateStateByTendFused(
+       State, 0, Tracers1, State, 0, Tracers2, TracerTend,
+       TimeInterval(0.5, TimeUnits::Seconds), State, 1, TracersAccum,
+       TimeInterval(1.0, TimeUnits::Seconds));
+
+   auto LayerThickH   = createHostMirrorCopy(State->LayerThickness[0]);
+   auto NormalVelH    = createHostMirrorCopy(State->NormalVelocity[0]);
+   auto ThickAccumH   = createHostMirrorCopy(State->LayerThickness[1]);
+   auto VelAccumH     = createHostMirrorCopy(State->NormalVelocity[1]);
+   auto Tracers1H     = createHostMirrorCopy(Tracers1);
+   auto TracersAccumH = createHostMirrorCopy(TracersAccum);
+
+   // h = 1.5, u = 0.5, C = (1*2 + 2)/1.5, accumulated h = 3, u = 2,
+   // C = (2*1 + 4)/3
+   const Real Tol = 1e-5;
+   for (int ICell = 0; ICell < DefMesh->NCellsOwned; ++ICell) {
+      if (std::abs(LayerThickH(ICell, 0) - 1.5) > Tol ||
+          std::abs(ThickAccumH(ICell, 0) - 3) > Tol ||
+          std::abs(Tracers1H(1, ICell, 0) - 4. / 1.5) > Tol ||
+          std::abs(TracersAccumH(1, ICell, 0) - 2) > Tol) {
+         Err++;
+         break;
+      }
+   }
+   for (int IEdge = 0; IEdge < DefMesh->NEdgesOwned; ++IEdge) {
+      if (std::abs(NormalVelH(IEdge, 0) - 0.5) > Tol ||
+          std::abs(VelAccumH(IEdge, 0) - 2) > Tol) {
+         Err++;
+         break;
+      }
+   }
+   if (Err != 0) {
+      LOG_ERROR("TimeStepperTest: fused state update FAIL");
+   }
+
+   TimeStepper::erase("TestTimeStepper");
+
+   return Err;
+}
+
+// Check that the thickness-weighted tracer update keeps a uniform tracer
+// uniform when the tracers are advected by the same flux as the thickness
+int testTracerConsistency() {
+   int Err = 0;
+
+   auto *DefMesh        = HorzMesh::getDefault();
+   auto *DefHalo        = Halo::getDefault();
+   auto *TestAuxState   = AuxiliaryState::get("TestAuxState");
+   auto *TestTendencies = Tendencies::get("TestTendencies");
+   auto *State          = OceanState::get("TestState");
+
+   auto *TestTimeStepper = TimeStepper::create(
+       "TestTimeStepper", TimeStepperType::ForwardBackward, TestTendencies,
+       TestAuxState, DefMesh, DefHalo);
+
+   const int NTracers = 3;
+   Array3DReal TracersCur("TracersCur", NTracers, DefMesh->NCellsSize,
+                          NVertLevels);
+   Array3DReal TracersNext("TracersNext", NTracers, DefMesh->NCellsSize,
+                           NVertLevels);
+   TestAuxState->initTracerAux(NTracers);
+   TestAuxState->LayerThicknessAux.FluxThickEdgeChoice = Center;
+   TestAuxState->TracerAux.TracersOnEdgeChoice         = Center;
+
+   // h = 1, u = 1 and a uniform tracer C = 2
+   deepCopy(State->LayerThickness[0], 1);
+   deepCopy(State->NormalVelocity[0], 1);
+   deepCopy(TracersCur, 2);
+
+   TestTendencies->ThicknessFluxDiv.Enabled = true;
+   TestTendencies->TracerHorzAdv.Enabled    = true;
+
+   Calendar TestCalendar("TracerCalendar", CalendarNoCalendar);
+   const TimeInstant Time(&TestCalendar, 0, 0, 0, 0, 0, 0);
+   const TimeInterval TimeStep(100, TimeUnits::Seconds);
+
+   TestTendencies->computeThicknessTendencies(State, TestAuxState, 0, 0, Time);
+   TestTendencies->computeTracerTendencies(State, TestAuxState, TracersCur, 0,
+                                           0, Time);
+   TestTimeStepper->updateTracersByTend(TracersNext, State, 0, TracersCur,
+                                        TimeStep);
+
+   TestTendencies->ThicknessFluxDiv.Enabled = false;
+   TestTendencies->TracerHorzAdv.Enabled    = false;
+
+   auto TracersNextH = createHostMirrorCopy(TracersNext);
+
+   const Real Tol = 1e-5;
+   for (int L = 0; L < NTracers; ++L) {
+      for (int ICell = 0; ICell < DefMesh->NCellsOwned; ++ICell) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            if (std::abs(TracersNextH(L, ICell, K) - 2) > Tol) {
+               Err++;
+            }
+         }
+      }
+   }
+   if (Err != 0) {
+      LOG_ERROR("TimeStepperTest: tracer consistency FAIL");
+   }
+
+   TimeStepper::erase("TestTimeStepper");
+
+   return Err;
+}
+
+// Check that the thickness fluxes of the slow tracer groups are accumulated
+// over the steps and restarted with the thickness of the state
+int testAccumThickFlux() {
+   int Err = 0;
+
+   auto *DefMesh      = HorzMesh::getDefault();
+   auto *TestAuxState = AuxiliaryState::get("TestAuxState");
+   auto *State        = OceanState::get("TestState");
+
+   TestAuxState->initAccumThickFlux();
+   TestAuxState->LayerThicknessAux.FluxThickEdgeChoice = Center;
+
+   // h = 2 and u = 0.5 so each step adds dt to the accumulated flux
+   deepCopy(State->LayerThickness[0], 2);
+   deepCopy(State->NormalVelocity[0], 0.5);
+
+   const TimeInterval TimeStep(100, TimeUnits::Seconds);
+   const int NSteps = 3;
+   TestAuxState->startAccumThickFlux(State, 0);
+   for (int Step = 0; Step < NSteps; ++Step)
+      TestAuxState->accumulateThickFlux(State, 0, TimeStep);
+
+   auto AccumFluxH  = createHostMirrorCopy(TestAuxState->AccumThickFluxEdge);
+   auto StartThickH = createHostMirrorCopy(TestAuxState->AccumStartThickCell);
+
+   const Real Tol = 1e-10;
+   for (int IEdge = 0; IEdge < DefMesh->NEdgesOwned; ++IEdge) {
+      if (std::abs(AccumFluxH(IEdge, 0) - 100. * NSteps) > Tol)
+         Err++;
+   }
+   for (int ICell = 0; ICell < DefMesh->NCellsOwned; ++ICell) {
+      if (std::abs(StartThickH(ICell, 0) - 2) > Tol)
+         Err++;
+   }
+
+   // Restarting the accumulation zeroes the fluxes
+   TestAuxState->startAccumThickFlux(State, 0);
+   AccumFluxH = createHostMirrorCopy(TestAuxState->AccumThickFluxEdge);
+   for (int IEdge = 0; IEdge < DefMesh->NEdgesOwned; ++IEdge) {
+      if (AccumFluxH(IEdge, 0) != 0)
+         Err++;
+   }
+
+   if (Err == 0) {
+      LOG_INFO("TimeStepperTest: accumulated thickness flux PASS");
+   } else {
+      LOG_ERROR("TimeStepperTest: accumulated thickness flux FAIL");
+   }
+
+   return Err;
+}
+
+// Check that the adaptive time step reaches the target CFL number and grows
+// by at most the growth factor for a quiescent state
+int testAdaptiveTimeStep() {
+   int Err = 0;
+
+   auto *DefMesh        = HorzMesh::getDefault();
+   auto *DefHalo        = Halo::getDefault();
+   auto *TestAuxState   = AuxiliaryState::get("TestAuxState");
+   auto *TestTendencies = Tendencies::get("TestTendencies");
+   auto *State          = OceanState::get("TestState");
+
+   auto *TestTimeStepper = TimeStepper::create(
+       "TestTimeStepper", TimeStepperType::ForwardBackward, TestTendencies,
+       TestAuxState, DefMesh, DefHalo);
+   TestTimeStepper->setTimeStep(TimeInterval(100, TimeUnits::Seconds));
+   TestTimeStepper->setAdaptiveTimeStep(
+       0.5, TimeInterval(1, TimeUnits::Seconds),
+       TimeInterval(10000, TimeUnits::Seconds), 1);
+
+   // Smallest edge distance over all tasks
+   R8 LocalMinDc = DefMesh->DcEdgeH(0);
+   for (int IEdge = 1; IEdge < DefMesh->NEdgesOwned; ++IEdge) {
+      LocalMinDc = std::min(LocalMinDc, DefMesh->DcEdgeH(IEdge));
+   }
+   R8 MinDc;
+   MPI_Allreduce(&LocalMinDc, &MinDc, 1, MPI_DOUBLE, MPI_MIN,
+                 MachEnv::getDefault()->getComm());
+
+   // A uniform velocity with a CFL number of 10 at the initial step should
+   // reduce the step to 5 s
+   deepCopy(State->NormalVelocity[0], MinDc / 10);
+   const R8 MaxCFL = TestTimeStepper->computeMaxCFL(State, 0);
+   if (std::abs(MaxCFL - 10) > 1e-6) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: adaptive max CFL {} FAIL", MaxCFL);
+   }
+
+   TestTimeStepper->adaptTimeStep(State, 0);
+   if (TestTimeStepper->getTimeStep() != TimeInterval(5, TimeUnits::Seconds)) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: adaptive time step reduction FAIL");
+   }
+
+   // At rest the step grows by the growth factor, 7.5 s rounded down
+   deepCopy(State->NormalVelocity[0], 0);
+   TestTimeStepper->adaptTimeStep(State, 0);
+   if (TestTimeStepper->getTimeStep() != TimeInterval(7, TimeUnits::Seconds)) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: adaptive time step growth FAIL");
+   }
+
+   TimeStepper::erase("TestTimeStepper");
+
+   return Err;
+}
+
+// Check the halo depth of the communication-avoiding mode and the halo sizes
+// used to restrict the computations to the valid halo layers
+int testCommAvoidingHalo() {
+   int Err = 0;
+
+   auto *DefMesh        = HorzMesh::getDefault();
+   auto *DefHalo        = Halo::getDefault();
+   auto *TestAuxState   = AuxiliaryState::get("TestAuxState");
+   auto *TestTendencies = Tendencies::get("TestTendencies");
+
+   const I4 HaloWidth = DefMesh->NCellsHaloH.extent_int(0);
+
+   // Custom tendencies have an unknown stencil, so the mode is never used.
+   // The depth does not depend on the time stepper type, so the steppers here
+   // are not Runge Kutta steppers to avoid creating provisional states.
+   auto *TestTimeStepper = TimeStepper::create(
+       "TestTimeStepper", TimeStepperType::ForwardBackward, TestTendencies,
+       TestAuxState, DefMesh, DefHalo);
+   TestTimeStepper->setCommAvoiding(true);
+   if (TestTimeStepper->getCommAvoidingHaloDepth(1) != 0) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: comm-avoiding depth with custom "
+                "tendencies FAIL");
+   }
+   TimeStepper::erase("TestTimeStepper");
+
+   // The thickness flux divergence alone invalidates one halo layer per
+   // evaluation
+   Config Options;
+   auto *HaloTendencies =
+       Tendencies::create("HaloTendencies", DefMesh, NVertLevels, &Options);
+   HaloTendencies->ThicknessFluxDiv.Enabled   = true;
+   HaloTendencies->PotientialVortHAdv.Enabled = false;
+   HaloTendencies->KEGrad.Enabled             = false;
+   HaloTendencies->SSHGrad.Enabled            = false;
+   HaloTendencies->VelocityDiffusion.Enabled  = false;
+   HaloTendencies->VelocityHyperDiff.Enabled  = false;
+
+   TestTimeStepper = TimeStepper::create(
+       "TestTimeStepper", TimeStepperType::ForwardBackward, HaloTendencies,
+       TestAuxState, DefMesh, DefHalo);
+   if (TestTimeStepper->getCommAvoidingHaloDepth(HaloWidth) != 0) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: comm-avoiding depth when disabled FAIL");
+   }
+   TestTimeStepper->setCommAvoiding(true);
+   if (TestTimeStepper->getCommAvoidingHaloDepth(HaloWidth) != HaloWidth or
+       TestTimeStepper->getCommAvoidingHaloDepth(HaloWidth + 1) != 0) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: comm-avoiding depth FAIL");
+   }
+   TimeStepper::erase("TestTimeStepper");
+   Tendencies::erase("HaloTendencies");
+
+   // Loop bounds cover the owned elements, the first halo layers or all
+   // elements
+   MeshLoopBounds Bounds = DefMesh->getLoopBounds(0);
+   if (Bounds.NCells != DefMesh->NCellsOwned or
+       Bounds.NEdges != DefMesh->NEdgesOwned or
+       Bounds.NVertices != DefMesh->NVerticesOwned) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: loop bounds of owned elements FAIL");
+   }
+   Bounds = DefMesh->getLoopBounds(1);
+   if (Bounds.NCells != DefMesh->NCellsHaloH(0) or
+       Bounds.NEdges != DefMesh->NEdgesHaloH(0) or
+       Bounds.NVertices != DefMesh->NVerticesHaloH(0)) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: loop bounds of first halo layer FAIL");
+   }
+   Bounds = DefMesh->getLoopBounds(FullHalo);
+   if (Bounds.NCells != DefMesh->NCellsAll or
+       Bounds.NEdges != DefMesh->NEdgesAll or
+       Bounds.NVertices != DefMesh->NVerticesAll) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: loop bounds of full halo FAIL");
+   }
+
+   if (Err == 0) {
+      LOG_INFO("TimeStepperTest: CommAvoidingHalo PASS");
+   }
+
+   return Err;
+}
+
+// Check that the stencil depth accounts for the HighOrder tracer edge
+// reconstruction, and that the tracer tendencies on the owned cells are the
+// full-halo tendencies when the tracers are only valid to that depth, as
+// after the partial-depth exchanges and in the communication-avoiding mode
+int testHighOrderHaloDepth() {
+   int Err = 0;
+
+   auto *DefMesh      = HorzMesh::getDefault();
+   auto *DefHalo      = Halo::getDefault();
+   auto *TestAuxState = AuxiliaryState::get("TestAuxState");
+   auto *State        = OceanState::get("TestState");
+
+   const I4 HaloWidth = DefMesh->NCellsHaloH.extent_int(0);
+
+   Config Options;
+   auto *AdvTendencies =
+       Tendencies::create("AdvTendencies", DefMesh, NVertLevels, &Options);
+   AdvTendencies->ThicknessFluxDiv.Enabled   = true;
+   AdvTendencies->PotientialVortHAdv.Enabled = false;
+   AdvTendencies->KEGrad.Enabled             = false;
+   AdvTendencies->SSHGrad.Enabled            = false;
+   AdvTendencies->VelocityDiffusion.Enabled  = false;
+   AdvTendencies->VelocityHyperDiff.Enabled  = false;
+   AdvTendencies->TracerHorzAdv.Enabled      = true;
+   AdvTendencies->TracerDiffusion.Enabled    = false;
+   AdvTendencies->TracerHyperDiff.Enabled    = false;
+   AdvTendencies->TracerVertAdv.Enabled      = false;
+
+   const FluxThickEdgeOption OldChoice =
+       TestAuxState->TracerAux.TracersOnEdgeChoice;
+
+   TestAuxState->TracerAux.TracersOnEdgeChoice = Center;
+   if (AdvTendencies->getStencilHaloDepth(TestAuxState) != 1) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: centered tracer stencil depth FAIL");
+   }
+
+   TestAuxState->TracerAux.TracersOnEdgeChoice = HighOrder;
+   const I4 Depth = AdvTendencies->getStencilHaloDepth(TestAuxState);
+   if (Depth != 2) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: HighOrder tracer stencil depth FAIL");
+   }
+
+   auto *TestTimeStepper = TimeStepper::create(
+       "TestTimeStepper", TimeStepperType::RungeKutta4, AdvTendencies,
+       TestAuxState, DefMesh, DefHalo);
+   TestTimeStepper->setCommAvoiding(true);
+   if (TestTimeStepper->getCommAvoidingHaloDepth(2) !=
+       (2 * Depth <= HaloWidth ? 2 * Depth : 0)) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: HighOrder comm-avoiding depth FAIL");
+   }
+   TimeStepper::erase("TestTimeStepper");
+
+   // A smooth tracer and velocities of both signs, so that the upwind
+   // correction of the reconstruction is used
+   const I4 NTracers = 1;
+   Array3DReal TracerArray("TracerArray", NTracers, DefMesh->NCellsSize,
+                           NVertLevels);
+   Err += initState();
+   auto TracersH   = createHostMirrorCopy(TracerArray);
+   auto NormalVelH = createHostMirrorCopy(State->NormalVelocity[0]);
+   for (int ICell = 0; ICell < DefMesh->NCellsAll; ++ICell) {
+      TracersH(0, ICell, 0) = std::sin(1e-5 * DefMesh->XCellH(ICell)) +
+                              std::cos(1e-5 * DefMesh->YCellH(ICell));
+   }
+   for (int IEdge = 0; IEdge < DefMesh->NEdgesAll; ++IEdge) {
+      NormalVelH(IEdge, 0) = std::sin(3e-5 * DefMesh->XEdgeH(IEdge));
+   }
+   deepCopy(State->NormalVelocity[0], NormalVelH);
+
+   Calendar TestCalendar("TestCalendar", CalendarNoCalendar);
+   const TimeInstant Time(&TestCalendar, 0, 0, 0, 0, 0, 0);
+   TestAuxState->initTracerAux(NTracers);
+
+   auto computeTracerTend = [&]() {
+      deepCopy(TracerArray, TracersH);
+      TestAuxState->computeAll(State, 0);
+      AdvTendencies->computeTracerTendencies(State, TestAuxState, TracerArray,
+                                             0, 0, Time);
+      return createHostMirrorCopy(AdvTendencies->TracerTend);
+   };
+
+   const auto FullTendH = computeTracerTend();
+
+   // Corrupt the tracers beyond the halo layers needed by one evaluation
+   if (Depth <= HaloWidth) {
+      for (int ICell = DefMesh->NCellsHaloH(Depth - 1);
+           ICell < DefMesh->NCellsAll; ++ICell) {
+         TracersH(0, ICell, 0) = 1e6;
+      }
+      const auto PartialTendH = computeTracerTend();
+
+      for (int ICell = 0; ICell < DefMesh->NCellsOwned; ++ICell) {
+         if (PartialTendH(0, ICell, 0) != FullTendH(0, ICell, 0)) {
+            Err++;
+            LOG_ERROR("TimeStepperTest: HighOrder tracer tendency with the "
+                      "partial halo FAIL");
+            break;
+         }
+      }
+   }
+
+   TestAuxState->TracerAux.TracersOnEdgeChoice = OldChoice;
+   Tendencies::erase("AdvTendencies");
+
+   if (Err == 0) {
+      LOG_INFO("TimeStepperTest: HighOrderHaloDepth PASS");
+   }
+
+   return Err;
+}
+
+// Check that the kernel graph mode is refused with custom tendencies and
+// that its steps give the same state as the direct launches
+int testKernelGraph() {
+   int Err = 0;
+
+   auto *DefMesh        = HorzMesh::getDefault();
+   auto *DefHalo        = Halo::getDefault();
+   auto *TestAuxState   = AuxiliaryState::get("TestAuxState");
+   auto *TestTendencies = Tendencies::get("TestTendencies");
+   auto *State          = OceanState::get("TestState");
+
+   // The custom tendencies receive the stage times, which a replayed graph
+   // would freeze at the step it was recorded in
+   auto *TestTimeStepper = TimeStepper::create(
+       "TestTimeStepper", TimeStepperType::RungeKutta4, TestTendencies,
+       TestAuxState, DefMesh, DefHalo);
+   TestTimeStepper->setKernelGraph(true);
+   if (TestTimeStepper->usesKernelGraph()) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: kernel graph with custom tendencies FAIL");
+   }
+   TimeStepper::erase("TestTimeStepper");
+
+   // Tendencies of the state only, with enough steps to replay the graphs of
+   // both time levels
+   Config Options;
+   auto *GraphTendencies =
+       Tendencies::create("GraphTendencies", DefMesh, NVertLevels, &Options);
+   GraphTendencies->ThicknessFluxDiv.Enabled   = true;
+   GraphTendencies->PotientialVortHAdv.Enabled = true;
+   GraphTendencies->KEGrad.Enabled             = true;
+   GraphTendencies->SSHGrad.Enabled            = false;
+   GraphTendencies->VelocityDiffusion.Enabled  = false;
+   GraphTendencies->VelocityHyperDiff.Enabled  = false;
+
+   TestTimeStepper = TimeStepper::create(
+       "TestTimeStepper", TimeStepperType::RungeKutta4, GraphTendencies,
+       TestAuxState, DefMesh, DefHalo);
+   TestTimeStepper->setTimeStep(TimeInterval(0.1, TimeUnits::Seconds));
+
+   Calendar TestCalendar("TestCalendar", CalendarNoCalendar);
+   const TimeInstant TimeStart(&TestCalendar, 0, 0, 0, 0, 0, 0);
+   const TimeInterval TimeStep = TestTimeStepper->getTimeStep();
+   const int NSteps            = 5;
+
+   Err += initState();
+   for (int Step = 0; Step < NSteps; ++Step) {
+      TestTimeStepper->doStep(State, TimeStart + Step * TimeStep);
+   }
+   auto DirectThickH = createHostMirrorCopy(State->LayerThickness[0]);
+   auto DirectVelH   = createHostMirrorCopy(State->NormalVelocity[0]);
+
+   TestTimeStepper->setKernelGraph(true);
+   Err += initState();
+   for (int Step = 0; Step < NSteps; ++Step) {
+      TestTimeStepper->doStep(State, TimeStart + Step * TimeStep);
+   }
+   if (!TestTimeStepper->usesKernelGraph()) {
+      Err++;
+      LOG_ERROR("TimeStepperTest: kernel graph recording FAIL");
+   }
+   auto GraphThickH = createHostMirrorCopy(State->LayerThickness[0]);
+   auto GraphVelH   = createHostMirrorCopy(State->NormalVelocity[0]);
+
+   const Real Tol = 1e-10;
+   for (int ICell = 0; ICell < DefMesh->NCellsOwned; ++ICell) {
+      if (std::abs(GraphThickH(ICell, 0) - DirectThickH(ICell, 0)) > Tol) {
+         Err++;
+         LOG_ERROR("TimeStepperTest: kernel graph thickness FAIL");
+         break;
+      }
+   }
+   for (int IEdge = 0; IEdge < DefMesh->NEdgesOwned; ++IEdge) {
+      if (std::abs(GraphVelH(IEdge, 0) - DirectVelH(IEdge, 0)) > Tol) {
+         Err++;
+         LOG_ERROR("TimeStepperTest: kernel graph velocity FAIL");
+         break;
+      }
+   }
+
+   TimeStepper::erase("TestTimeStepper");
+   Tendencies::erase("GraphTendencies");
+
+   if (Err == 0) {
+      LOG_INFO("TimeStepperTest: KernelGraph PASS");
+   }
+
+   return Err;
+}
+
 int timeStepperTest(const std::string &MeshFile = "OmegaMesh.nc") {
 
    int Err = initTimeStepperTest(MeshFile);
@@ -352,6 +892,32 @@ int timeStepperTest(const std::string &MeshFile = "OmegaMesh.nc") {
    Err += testTimeStepper("RungeKutta2", TimeStepperType::RungeKutta2,
                           ExpectedOrder, ATol);
 
+   // With two baroclinic iterations the split-explicit scheme reduces to the
+   // midpoint method when the barotropic pressure gradient is disabled
+   ExpectedOrder = 2;
+   ATol          = 0.1;
+   Err += testTimeStepper("SplitExplicit", TimeStepperType::SplitExplicit,
+                          ExpectedOrder, ATol);
+
+   ExpectedOrder = 4;
+   ATol          = 0.1;
+   Err += testTimeStepper("LowStorageRK4", TimeStepperType::LowStorageRK4,
+                          ExpectedOrder, ATol);
+
+   Err += testFusedUpdate();
+
+   Err += testTracerConsistency();
+
+   Err += testAccumThickFlux();
+
+   Err += testAdaptiveTimeStep();
+
+   Err += testCommAvoidingHalo();
+
+   Err += testHighOrderHaloDepth();
+
+   Err += testKernelGraph();
+
    if (Err == 0) {
       LOG_INFO("TimeStepperTest: Successful completion");
    }
@@ -0,0 +1,111 @@
+/**
+ * @file  shr_philox.h
+ *
+ * @brief Counter-based Philox4x32-10 random number generator.
+ *
+ * Philox (Salmon, Moraes, Dror and Shaw, "Parallel random numbers: as easy
+ * as 1, 2, 3", SC11) is a keyed bijection of a 128-bit counter. Random
+ * numbers are a pure function of (key, counter), so there is no generator
+ * state to seed, store or advance: each (column, level, step, ...) tuple
+ * can be mapped to its own counter, and its stream evaluated independently
+ * in any order, including from inside a device kernel.
+ *
+ * Unlike dSFMT.h, this file is header-only. Define SHR_PHILOX_INLINE before
+ * including it to qualify the functions for device code, e.g.
+ *
+ *   #define SHR_PHILOX_INLINE YAKL_INLINE
+ *   #include "shr_philox.h"
+ *
+ * The output is identical on all architectures.
+ */
+
+#ifndef SHR_PHILOX_H
+#define SHR_PHILOX_H
+
+#include <stdint.h>
+
+#ifndef SHR_PHILOX_INLINE
+#define SHR_PHILOX_INLINE static inline
+#endif
+
+/** 128-bit counter, and 64-bit key of the generator */
+typedef struct {
+    uint32_t v[4];
+} shr_philox4x32_ctr_t;
+
+typedef struct {
+    uint32_t v[2];
+} shr_philox4x32_key_t;
+
+#define SHR_PHILOX_M0 0xD2511F53U
+#define SHR_PHILOX_M1 0xCD9E8D57U
+#define SHR_PHILOX_W0 0x9E3779B9U
+#define SHR_PHILOX_W1 0xBB67AE85U
+
+/** one Philox round, with the key of that round */
+SHR_PHILOX_INLINE shr_philox4x32_ctr_t
+shr_philox4x32_round(shr_philox4x32_ctr_t ctr, shr_philox4x32_key_t key) {
+    uint64_t p0 = (uint64_t)SHR_PHILOX_M0 * ctr.v[0];
+    uint64_t p1 = (uint64_t)SHR_PHILOX_M1 * ctr.v[2];
+    shr_philox4x32_ctr_t out;
+    out.v[0] = (uint32_t)(p1 >> 32) ^ ctr.v[1] ^ key.v[0];
+    out.v[1] = (uint32_t)p1;
+    out.v[2] = (uint32_t)(p0 >> 32) ^ ctr.v[3] ^ key.v[1];
+    out.v[3] = (uint32_t)p0;
+    return out;
+}
+
+/** Philox4x32 with the recommended 10 rounds: four random 32-bit integers
+ * per counter */
+SHR_PHILOX_INLINE shr_philox4x32_ctr_t
+shr_philox4x32_10(shr_philox4x32_ctr_t ctr, shr_philox4x32_key_t key) {
+    int i;
+    for (i = 0; i < 10; i++) {
+	if (i > 0) {
+	    key.v[0] += SHR_PHILOX_W0;
+	    key.v[1] += SHR_PHILOX_W1;
+	}
+	ctr = shr_philox4x32_round(ctr, key);
+    }
+    return ctr;
+}
+
+/** uniform double in the open interval (0,1) from a 32-bit integer */
+SHR_PHILOX_INLINE double shr_philox_u01(uint32_t x) {
+    return ((double)x + 0.5) * (1.0 / 4294967296.0);
+}
+
+/**
+ * Four uniform doubles in (0,1) for the stream identified by a 64-bit seed
+ * and a 4-component counter. Callers give each independent random number
+ * (or group of four) a distinct counter, typically built from the global
+ * column, level and time step indices.
+ */
+SHR_PHILOX_INLINE void shr_philox_uniform4(uint64_t seed, uint32_t c0,
+					   uint32_t c1, uint32_t c2,
+					   uint32_t c3, double ran[4]) {
+    shr_philox4x32_ctr_t ctr;
+    shr_philox4x32_key_t key;
+    int i;
+    ctr.v[0] = c0;
+    ctr.v[1] = c1;
+    ctr.v[2] = c2;
+    ctr.v[3] = c3;
+    key.v[0] = (uint32_t)seed;
+    key.v[1] = (uint32_t)(seed >> 32);
+    ctr = shr_philox4x32_10(ctr, key);
+    for (i = 0; i < 4; i++) {
+	ran[i] = shr_philox_u01(ctr.v[i]);
+    }
+}
+
+/** A single uniform double in (0,1): the first of shr_philox_uniform4 */
+SHR_PHILOX_INLINE double shr_philox_uniform(uint64_t seed, uint32_t c0,
+					    uint32_t c1, uint32_t c2,
+					    uint32_t c3) {
+    double ran[4];
+    shr_philox_uniform4(seed, c0, c1, c2, c3, ran);
+    return ran[0];
+}
+
+#endif /* SHR_PHILOX_H */
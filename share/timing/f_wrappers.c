@@ -28,6 +28,9 @@
 #define gptlstamp GPTLSTAMP
 #define gptlstart GPTLSTART
 #define gptlstart_handle GPTLSTART_HANDLE
+#define gptlinit_handle GPTLINIT_HANDLE
+#define gptlstart_ihandle GPTLSTART_IHANDLE
+#define gptlstop_ihandle GPTLSTOP_IHANDLE
 #define gptlstop GPTLSTOP
 #define gptlstop_handle GPTLSTOP_HANDLE
 #define gptlstartstop_vals GPTLSTARTSTOP_VALS
@@ -64,6 +67,9 @@
 #define gptlstamp                   FCI_GLOBAL(gptlstamp,GPTLSTAMP)
 #define gptlstart                   FCI_GLOBAL(gptlstart,GPTLSTART)
 #define gptlstart_handle            FCI_GLOBAL(gptlstart_handle,GPTLSTART_HANDLE)
+#define gptlinit_handle             FCI_GLOBAL(gptlinit_handle,GPTLINIT_HANDLE)
+#define gptlstart_ihandle           FCI_GLOBAL(gptlstart_ihandle,GPTLSTART_IHANDLE)
+#define gptlstop_ihandle            FCI_GLOBAL(gptlstop_ihandle,GPTLSTOP_IHANDLE)
 #define gptlstop                    FCI_GLOBAL(gptlstop,GPTLSTOP)
 #define gptlstop_handle             FCI_GLOBAL(gptlstop_handle,GPTLSTOP_HANDLE)
 #define gptlstartstop_vals          FCI_GLOBAL(gptlstartstop_vals,GPTLSTARTSTOP_VALS)
@@ -100,6 +106,9 @@
 #define gptlstamp gptlstamp_
 #define gptlstart gptlstart_
 #define gptlstart_handle gptlstart_handle_
+#define gptlinit_handle gptlinit_handle_
+#define gptlstart_ihandle gptlstart_ihandle_
+#define gptlstop_ihandle gptlstop_ihandle_
 #define gptlstop gptlstop_
 #define gptlstop_handle gptlstop_handle_
 #define gptlstartstop_vals gptlstartstop_vals_
@@ -136,6 +145,9 @@
 #define gptlstamp gptlstamp__
 #define gptlstart gptlstart__
 #define gptlstart_handle gptlstart_handle__
+#define gptlinit_handle gptlinit_handle__
+#define gptlstart_ihandle gptlstart_ihandle__
+#define gptlstop_ihandle gptlstop_ihandle__
 #define gptlstop gptlstop__
 #define gptlstop_handle gptlstop_handle__
 #define gptlstartstop_vals gptlstartstop_vals__
@@ -176,6 +188,9 @@ int gptlreset (void);
 int gptlstamp (double *wall, double *usr, double *sys);
 int gptlstart (char *name, int nc1);
 int gptlstart_handle (char *name, void **, int nc1);
+int gptlinit_handle (char *name, int *handle, int nc1);
+int gptlstart_ihandle (int *handle);
+int gptlstop_ihandle (int *handle);
 int gptlstop (char *name, int nc1);
 int gptlstop_handle (char *name, void **, int nc1);
 int gptlstartstop_vals (char *name, double *val, int *cnt, int nc1);
@@ -379,6 +394,30 @@ int gptlstart_handle (char *name, void **handle, int nc1)
   return GPTLstartf_handle (name, nc1, handle);
 }
 
+int gptlinit_handle (char *name, int *handle, int nc1)
+{
+  char cname[MAX_CHARS+1];
+  int numchars;
+
+  if (*handle > 0)
+    return 0;
+
+  numchars = MIN (nc1, MAX_CHARS);
+  strncpy (cname, name, numchars);
+  cname[numchars] = '\0';
+  return GPTLinit_handle (cname, handle);
+}
+
+int gptlstart_ihandle (int *handle)
+{
+  return GPTLstart_ihandle (*handle);
+}
+
+int gptlstop_ihandle (int *handle)
+{
+  return GPTLstop_ihandle (*handle);
+}
+
 int gptlstop (char *name, int nc1)
 {
   /*  char cname[MAX_CHARS+1];*/
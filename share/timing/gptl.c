@@ -241,6 +241,17 @@ static unsigned inline long long nanotime (void); /* read counter (assembler) */
 static float get_clockfreq (void);                /* cycles/sec */
 #endif
 
+/*
+** Integer handles (GPTLinit_handle). A handle is the 1-based index of a timer
+** name in handlenames, and is the same for all threads so it can be cached in
+** a static variable. Each thread resolves a handle to its own timer in its
+** row of handletimers the first time it starts the timer, so the start and
+** stop calls that follow need neither a hash lookup nor a lock.
+*/
+static char handlenames[MAX_HANDLES][MAX_CHARS+1];
+static int nhandles = 0;
+static Timer ***handletimers = 0;   /* per-thread timer of each handle */
+
 #define DEFAULT_TABLE_SIZE 2048
 static int tablesize = DEFAULT_TABLE_SIZE;  /* per-thread size of hash table (settable parameter) */
 static char *outdir = 0;      /* dir to write output files to (currently unused) */
@@ -478,6 +489,7 @@ int GPTLinitialize (void)
   hashtable     = (Hashentry **) GPTLallocate (maxthreads * sizeof (Hashentry *));
   prefix_len    = (int *)        GPTLallocate (maxthreads * sizeof (int));
   prefix        = (char **)      GPTLallocate (maxthreads * sizeof (char *));
+  handletimers  = (Timer ***)    GPTLallocate (maxthreads * sizeof (Timer **));
 
   /* Initialize array values */
 
@@ -509,6 +521,10 @@ int GPTLinitialize (void)
     prefix_len[t] = 0;
     prefix[t] = (char *) GPTLallocate ((MAX_CHARS+1) * sizeof (char));
     prefix[t][0] = '\0';
+
+    handletimers[t] = (Timer **) GPTLallocate (MAX_HANDLES * sizeof (Timer *));
+    for (i = 0; i < MAX_HANDLES; i++)
+      handletimers[t][i] = 0;
   }
 
   prefix_len_nt = 0;
@@ -577,6 +593,7 @@ int GPTLfinalize (void)
     hashtable[t] = NULL;
     free (callstack[t]);
     free (prefix[t]);
+    free (handletimers[t]);
     for (ptr = timers[t]; ptr; ptr = ptrnext) {
       ptrnext = ptr->next;
       if (ptr->nparent > 0) {
@@ -599,6 +616,7 @@ int GPTLfinalize (void)
   free (prefix_len);
   free (prefix);
   free (prefix_nt);
+  free (handletimers);
 
   threadfinalize ();
 
@@ -606,9 +624,11 @@ int GPTLfinalize (void)
   GPTL_PAPIfinalize (maxthreads);
 #endif
 
-  /* Reset initial values */
+  /* Reset initial values. The handle names are kept, so handles cached by
+  ** the caller remain valid if GPTL is initialized again. */
 
   timers = 0;
+  handletimers = 0;
   last = 0;
   max_depth = 0;
   max_name_len = 0;
@@ -1183,6 +1203,128 @@ int GPTLstart_handle (const char *name,  /* timer name */
   return (0);
 }
 
+/*
+** GPTLinit_handle: register a timer name and return its integer handle. If
+**   *handle is already positive it is assumed to be a handle returned earlier
+**   and the call returns immediately, so callers can cache the handle in a
+**   static variable (initialized to 0) and call this before each start.
+**   The same name always gets the same handle, on all threads. This can be
+**   called before GPTLinitialize.
+**
+** Input arguments:
+**   name: timer name
+**
+** Input/output arguments:
+**   handle: 0 (or negative) on first call, handle of the timer on output
+**
+** Return value: 0 (success) or GPTLerror (failure)
+*/
+
+int GPTLinit_handle (const char *name,  /* timer name */
+		     int *handle)       /* handle (output if input value is <= 0) */
+{
+  int h;                                 /* handle index */
+  int found = -1;                        /* index of name in handlenames */
+  int numchars;                          /* number of characters to copy */
+  static const char *thisfunc = "GPTLinit_handle";
+
+  if (*handle > 0)
+    return 0;
+
+  numchars = MIN (strlen (name), MAX_CHARS);
+
+  /* Registration is rare, so a critical region is cheap enough here */
+#if ( defined THREADED_OMP )
+#pragma omp critical (gptl_init_handle)
+#elif ( defined THREADED_PTHREADS )
+  if (lock_mutex () < 0)
+    return GPTLerror ("%s: mutex lock failure\n", thisfunc);
+#endif
+  {
+    for (h = 0; h < nhandles; h++) {
+      if (STRNMATCH (handlenames[h], name, numchars) && handlenames[h][numchars] == '\0') {
+	found = h;
+	break;
+      }
+    }
+    if (found < 0 && nhandles < MAX_HANDLES) {
+      strncpy (handlenames[nhandles], name, numchars);
+      handlenames[nhandles][numchars] = '\0';
+      found = nhandles++;
+    }
+  }
+#if ( defined THREADED_PTHREADS )
+  if (unlock_mutex () < 0)
+    return GPTLerror ("%s: mutex unlock failure\n", thisfunc);
+#endif
+
+  if (found < 0)
+    return GPTLerror ("%s: too many handles (MAX_HANDLES=%d) for timer %s\n",
+		      thisfunc, MAX_HANDLES, name);
+
+  *handle = found + 1;
+  return 0;
+}
+
+/*
+** GPTLstart_ihandle: start a timer from an integer handle of GPTLinit_handle
+**
+** Input arguments:
+**   handle: handle of the timer
+**
+** Return value: 0 (success) or GPTLerror (failure)
+*/
+
+int GPTLstart_ihandle (const int handle)
+{
+  int t;                                 /* thread index (of this thread) */
+  static const char *thisfunc = "GPTLstart_ihandle";
+
+  if (disabled)
+    return 0;
+
+  if ( ! initialized)
+    return 0;
+
+  if (handle < 1 || handle > nhandles)
+    return GPTLerror ("%s: bad handle %d\n", thisfunc, handle);
+
+  if ((t = get_thread_num ()) < 0)
+    return GPTLerror ("%s: bad return from get_thread_num\n", thisfunc);
+
+  /* The first start on each thread looks up the timer and caches it */
+  return GPTLstart_handle (handlenames[handle-1], (void **) &handletimers[t][handle-1]);
+}
+
+/*
+** GPTLstop_ihandle: stop a timer from an integer handle of GPTLinit_handle
+**
+** Input arguments:
+**   handle: handle of the timer
+**
+** Return value: 0 (success) or GPTLerror (failure)
+*/
+
+int GPTLstop_ihandle (const int handle)
+{
+  int t;                                 /* thread index (of this thread) */
+  static const char *thisfunc = "GPTLstop_ihandle";
+
+  if (disabled)
+    return 0;
+
+  if ( ! initialized)
+    return 0;
+
+  if (handle < 1 || handle > nhandles)
+    return GPTLerror ("%s: bad handle %d\n", thisfunc, handle);
+
+  if ((t = get_thread_num ()) < 0)
+    return GPTLerror ("%s: bad return from get_thread_num\n", thisfunc);
+
+  return GPTLstop_handle (handlenames[handle-1], (void **) &handletimers[t][handle-1]);
+}
+
 /*
 ** GPTLstartf: start a timer when the timer name may not be null terminated
 **
@@ -135,6 +135,9 @@ extern int GPTLprefix_setf (const char *, const int);
 extern int GPTLprefix_unset (void);
 extern int GPTLstart (const char *);
 extern int GPTLstart_handle (const char *, void **);
+extern int GPTLinit_handle (const char *, int *);
+extern int GPTLstart_ihandle (const int);
+extern int GPTLstop_ihandle (const int);
 extern int GPTLstartf (const char *, const int);
 extern int GPTLstartf_handle (const char *, const int, void **);
 extern int GPTLstop (const char *);
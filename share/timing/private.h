@@ -36,6 +36,9 @@
 /* longest timer name allowed (probably safe to just change) */
 #define MAX_CHARS 127
 
+/* max number of timer names registered with GPTLinit_handle */
+#define MAX_HANDLES 1024
+
 /*
 ** max allowable number of PAPI counters, or derived events. For convenience,
 ** set to max (# derived events, # papi counters required) so "avail" lists